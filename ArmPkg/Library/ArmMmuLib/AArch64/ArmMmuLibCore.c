@@ -22,6 +22,13 @@
 #include <Library/HobLib.h>
 #include "ArmMmuLibInternal.h"
 
+//
+// Above this number of consecutive leaf entries updated in a live table, a
+// single invalidation of the whole TLB is cheaper than invalidating the entries
+// by VA one by one.
+//
+#define MAX_TLBI_BY_VA_ENTRIES  64
+
 STATIC  ARM_REPLACE_LIVE_TRANSLATION_ENTRY  mReplaceLiveEntryFunc = ArmReplaceLiveTranslationEntry;
 
 STATIC
@@ -139,6 +146,45 @@ ReplaceTableEntry (
   }
 }
 
+/**
+  Perform the TLB maintenance for a run of consecutive leaf entries that were
+  written in a live translation table with the MMU enabled.
+
+  @param[in]  FirstEntry    The first entry of the run.
+  @param[in]  EntryCount    The number of entries in the run.
+  @param[in]  FirstAddress  The virtual address mapped by FirstEntry.
+  @param[in]  BlockMask     The mask of the block size mapped by each entry.
+
+**/
+STATIC
+VOID
+FlushLeafEntries (
+  IN  UINT64  *FirstEntry,
+  IN  UINTN   EntryCount,
+  IN  UINT64  FirstAddress,
+  IN  UINT64  BlockMask
+  )
+{
+  UINTN  Index;
+
+  if (EntryCount > MAX_TLBI_BY_VA_ENTRIES) {
+    //
+    // Make the entry updates visible to the table walker before the TLB is
+    // invalidated.
+    //
+    ArmDataSynchronizationBarrier ();
+    ArmInvalidateTlb ();
+    return;
+  }
+
+  for (Index = 0; Index < EntryCount; Index++) {
+    ArmUpdateTranslationTableEntry (
+      &FirstEntry[Index],
+      (VOID *)(UINTN)(FirstAddress + Index * (BlockMask + 1))
+      );
+  }
+}
+
 STATIC
 VOID
 FreePageTablesRecursive (
@@ -217,12 +263,27 @@ UpdateRegionMappingRecursive (
   VOID        *TranslationTable;
   EFI_STATUS  Status;
   BOOLEAN     NextTableIsLive;
+  BOOLEAN     DeferTlbMaintenance;
+  UINT64      *RunEntry;
+  UINT64      RunStart;
+  UINTN       RunCount;
 
   ASSERT (((RegionStart | RegionEnd) & EFI_PAGE_MASK) == 0);
 
   BlockShift = (Level + 1) * BITS_PER_LEVEL + MIN_T0SZ;
   BlockMask  = MAX_UINT64 >> BlockShift;
 
+  //
+  // Updating a leaf entry only changes its attributes, so there is no need
+  // for break-before-make. When the table is live and the MMU is on, write the
+  // consecutive leaf entries first and perform the TLB maintenance for all of
+  // them at once, rather than with a full set of barriers for each entry.
+  //
+  DeferTlbMaintenance = TableIsLive && ArmMmuEnabled ();
+  RunEntry            = NULL;
+  RunStart            = 0;
+  RunCount            = 0;
+
   DEBUG ((
     DEBUG_VERBOSE,
     "%a(%d): %llx - %llx set %lx clr %lx\n",
@@ -257,6 +318,11 @@ UpdateRegionMappingRecursive (
     {
       ASSERT (Level < 3);
 
+      if (RunCount > 0) {
+        FlushLeafEntries (RunEntry, RunCount, RunStart, BlockMask);
+        RunCount = 0;
+      }
+
       if (!IsTableEntry (*Entry, Level)) {
         //
         // If the region we are trying to map is already covered by a block
@@ -361,10 +427,35 @@ UpdateRegionMappingRecursive (
       EntryValue |= (Level == 3) ? TT_TYPE_BLOCK_ENTRY_LEVEL3
                                  : TT_TYPE_BLOCK_ENTRY;
 
-      ReplaceTableEntry (Entry, EntryValue, RegionStart, BlockMask, FALSE);
+      if (EntryValue == *Entry) {
+        continue;
+      }
+
+      if (!DeferTlbMaintenance) {
+        ReplaceTableEntry (Entry, EntryValue, RegionStart, BlockMask, FALSE);
+        continue;
+      }
+
+      *Entry = EntryValue;
+
+      if ((RunCount > 0) && (Entry == RunEntry + RunCount)) {
+        RunCount++;
+      } else {
+        if (RunCount > 0) {
+          FlushLeafEntries (RunEntry, RunCount, RunStart, BlockMask);
+        }
+
+        RunEntry = Entry;
+        RunStart = RegionStart;
+        RunCount = 1;
+      }
     }
   }
 
+  if (RunCount > 0) {
+    FlushLeafEntries (RunEntry, RunCount, RunStart, BlockMask);
+  }
+
   return EFI_SUCCESS;
 }
 
@@ -0,0 +1,269 @@
+## @file
+# Expand the tokenized DEBUG() records sent by BaseDebugLibSerialPortTokenized.
+#
+# Each record carries the CRC32 of its format string. The format strings are
+# taken from the build output, so the log must be decoded against the same
+# build that produced it. Bytes outside of records are copied unchanged.
+#
+# Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+# SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+'''
+DecodeTokenizedDebugLog
+'''
+from __future__ import print_function
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+#
+# Globals for help information
+#
+__prog__        = 'DecodeTokenizedDebugLog'
+__copyright__   = 'Copyright (c) 2024, Intel Corporation. All rights reserved.'
+__description__ = 'Expand the tokenized DEBUG() records of a serial log captured from a BaseDebugLibSerialPortTokenized build.\n'
+
+RECORD_SYNC        = 0xFE
+RECORD_HEADER_SIZE = 7
+
+WarningStrings = [
+    'Success',
+    'Warning Unknown Glyph',
+    'Warning Delete Failure',
+    'Warning Write Failure',
+    'Warning Buffer Too Small',
+    'Warning Stale Data',
+    'Warning File System',
+    'Warning Reset Required',
+    ]
+
+ErrorStrings = [
+    'Load Error',
+    'Invalid Parameter',
+    'Unsupported',
+    'Bad Buffer Size',
+    'Buffer Too Small',
+    'Not Ready',
+    'Device Error',
+    'Write Protected',
+    'Out of Resources',
+    'Volume Corrupt',
+    'Volume Full',
+    'No Media',
+    'Media changed',
+    'Not Found',
+    'Access Denied',
+    'No Response',
+    'No mapping',
+    'Time out',
+    'Not started',
+    'Already started',
+    'Aborted',
+    'ICMP Error',
+    'TFTP Error',
+    'Protocol Error',
+    'Incompatible Version',
+    'Security Violation',
+    'CRC Error',
+    'End of Media',
+    'Reserved (29)',
+    'Reserved (30)',
+    'End of File',
+    'Invalid Language',
+    'Compromised Data',
+    'IP Address Conflict',
+    'HTTP Error',
+    ]
+
+#
+# Null-terminated printable strings, as the compiler places them in the image.
+#
+StringPattern = re.compile (rb'[\t\n\r\x20-\x7e]+(?=\x00)')
+
+class FormatTable (object):
+    def __init__ (self, Paths):
+        self.Strings  = set ()
+        self.Table    = {}
+        self.Suffixes = False
+        for Path in Paths:
+            if os.path.isfile (Path):
+                Files = [Path]
+            else:
+                Files = []
+                for Root, Dirs, Names in os.walk (Path):
+                    Files += [os.path.join (Root, Name) for Name in Names if Name.lower ().endswith (('.efi', '.dll', '.debug', '.te'))]
+            for File in Files:
+                with open (File, 'rb') as Image:
+                    self.Strings.update (Match.group () for Match in StringPattern.finditer (Image.read ()))
+        for String in self.Strings:
+            self.Table.setdefault (zlib.crc32 (String) & 0xFFFFFFFF, String.decode ('ascii'))
+
+    def Lookup (self, FormatId):
+        #
+        # A linker that merges string tails stores a format string that ends
+        # another string only as that string's suffix. Index every suffix the
+        # first time a format is not found.
+        #
+        if FormatId not in self.Table and not self.Suffixes:
+            self.Suffixes = True
+            for String in self.Strings:
+                for Start in range (1, len (String)):
+                    self.Table.setdefault (zlib.crc32 (String[Start:]) & 0xFFFFFFFF, String[Start:].decode ('ascii'))
+        return self.Table.get (FormatId)
+
+class ArgumentReader (object):
+    def __init__ (self, Data):
+        self.Data   = Data
+        self.Offset = 0
+
+    def Read (self, Size):
+        if self.Offset + Size > len (self.Data):
+            raise IndexError
+        Value = self.Data[self.Offset:self.Offset + Size]
+        self.Offset += Size
+        return Value
+
+    def Integer (self, Size):
+        return int.from_bytes (self.Read (Size), 'little')
+
+    def String (self):
+        return self.Read (self.Integer (1)).decode ('ascii', 'replace')
+
+def FormatInteger (Value, Conversion, Long, Flags, Width, Precision):
+    if not Long:
+        Value &= 0xFFFFFFFF
+        if Conversion == 'd' and Value & 0x80000000:
+            Value -= 0x100000000
+    elif Conversion == 'd' and Value & (1 << 63):
+        Value -= 1 << 64
+    if Conversion in 'xX':
+        Digits = '{0:X}'.format (Value) if Conversion == 'X' else '{0:x}'.format (Value)
+        Sign   = ''
+    else:
+        Digits = '{0:,}'.format (abs (Value)) if ',' in Flags else str (abs (Value))
+        Sign   = '-' if Value < 0 else ('+' if '+' in Flags else (' ' if ' ' in Flags else ''))
+    if Precision is not None:
+        Digits = Digits.rjust (Precision, '0')
+    if Width is not None and ('-' not in Flags) and ('0' in Flags or Conversion == 'X'):
+        Digits = Digits.rjust (Width - len (Sign), '0')
+    return Sign + Digits
+
+def FormatStatus (Value):
+    if Value & (1 << 63):
+        Index = Value & ~(1 << 63)
+        if 0 < Index <= len (ErrorStrings):
+            return ErrorStrings[Index - 1]
+        return '{0:08X}'.format (Value)
+    if Value < len (WarningStrings):
+        return WarningStrings[Value]
+    return '{0:08X}'.format (Value)
+
+def FormatGuid (Data):
+    Data1, Data2, Data3 = struct.unpack ('<IHH', Data[:8])
+    return '{0:08x}-{1:04x}-{2:04x}-{3}-{4}'.format (Data1, Data2, Data3, Data[8:10].hex (), Data[10:16].hex ())
+
+ConversionPattern = re.compile (r'%([-+ ,0lL.*0-9]*)(.?)', re.DOTALL)
+
+def ExpandRecord (Format, Arguments):
+    Reader = ArgumentReader (Arguments)
+    Output = []
+    Last   = 0
+    for Match in ConversionPattern.finditer (Format):
+        Output.append (Format[Last:Match.start ()])
+        Last       = Match.end ()
+        Flags      = Match.group (1)
+        Conversion = Match.group (2)
+        Width      = None
+        Precision  = None
+        try:
+            #
+            # Width and precision, fixed or passed as arguments.
+            #
+            Sizes = re.match (r'([-+ ,0lL]*)(\*|[0-9]*)(?:\.(\*|[0-9]*))?', Flags.replace ('l', '').replace ('L', ''))
+            if Sizes.group (2) == '*':
+                Width = Reader.Integer (8)
+            elif Sizes.group (2):
+                Width = int (Sizes.group (2))
+            if Sizes.group (3) == '*':
+                Precision = Reader.Integer (8)
+            elif Sizes.group (3):
+                Precision = int (Sizes.group (3))
+            Long = 'l' in Flags or 'L' in Flags
+            if Conversion != '' and Conversion in 'duxX':
+                Text = FormatInteger (Reader.Integer (8 if Long else 4), Conversion, Long, Flags, Width, Precision)
+            elif Conversion == 'p':
+                Text = '{0:X}'.format (Reader.Integer (8))
+            elif Conversion in ('a', 's', 'S'):
+                Text = Reader.String ()
+                if Precision is not None:
+                    Text = Text[:Precision]
+            elif Conversion == 'c':
+                Text = chr (Reader.Integer (2))
+            elif Conversion == 'g':
+                Text = FormatGuid (Reader.Read (16))
+            elif Conversion == 't':
+                Year, Month, Day, Hour, Minute = struct.unpack ('<HBBBB', Reader.Read (6))
+                Text = '{0:02d}/{1:02d}/{2:04d}  {3:02d}:{4:02d}'.format (Month, Day, Year, Hour, Minute)
+            elif Conversion == 'r':
+                Text = FormatStatus (Reader.Integer (8))
+            elif Conversion == '':
+                Text = ''
+            else:
+                Text = Conversion
+        except IndexError:
+            Output.append ('<truncated>\n')
+            return ''.join (Output)
+        if Width is not None and len (Text) < Width:
+            Text = Text.ljust (Width) if '-' in Flags else Text.rjust (Width)
+        Output.append (Text)
+    Output.append (Format[Last:])
+    return ''.join (Output)
+
+def Decode (Log, Table, Output):
+    Offset = 0
+    while Offset < len (Log):
+        Sync = Log.find (bytes ([RECORD_SYNC]), Offset)
+        if Sync < 0:
+            Output.write (Log[Offset:])
+            break
+        Output.write (Log[Offset:Sync])
+        if Sync + RECORD_HEADER_SIZE > len (Log):
+            break
+        FormatId, Size = struct.unpack ('<IH', Log[Sync + 1:Sync + RECORD_HEADER_SIZE])
+        Arguments      = Log[Sync + RECORD_HEADER_SIZE:Sync + RECORD_HEADER_SIZE + Size]
+        Format         = Table.Lookup (FormatId)
+        if Format is not None:
+            Text = ExpandRecord (Format, Arguments)
+        else:
+            Text = '<unknown format {0:08X}: {1}>\n'.format (FormatId, Arguments.hex ())
+        Output.write (Text.encode ('ascii', 'replace'))
+        Offset = Sync + RECORD_HEADER_SIZE + Size
+
+if __name__ == '__main__':
+    #
+    # Create command line argument parser object
+    #
+    parser = argparse.ArgumentParser (prog = __prog__,
+                                      description = __description__ + __copyright__,
+                                      conflict_handler = 'resolve')
+    parser.add_argument ("-b", "--build", dest = 'Build', action = 'append', required = True,
+                         help = "Build output directory or image to read format strings from. Can be given more than once.")
+    parser.add_argument ("-o", "--output", dest = 'OutputFile', type = argparse.FileType ('wb'),
+                         help = "Output filename for the decoded log. Standard output is used if not given.")
+    parser.add_argument ("InputFile", nargs = '?', type = argparse.FileType ('rb'),
+                         help = "Captured serial log. Standard input is used if not given.")
+
+    #
+    # Parse command line arguments
+    #
+    args = parser.parse_args ()
+
+    InputFile  = args.InputFile  or sys.stdin.buffer
+    OutputFile = args.OutputFile or sys.stdout.buffer
+
+    Decode (InputFile.read (), FormatTable (args.Build), OutputFile)
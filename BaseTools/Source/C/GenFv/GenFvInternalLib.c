@@ -58,6 +58,13 @@ BOOLEAN VtfFileFlag = FALSE;
 
 EFI_GUID  mEfiFirmwareVolumeTopFileGuid       = EFI_FFS_VOLUME_TOP_FILE_GUID;
 EFI_GUID  mFileGuidArray [MAX_NUMBER_OF_FILES_IN_FV];
+
+//
+// The FFS files are read once, when the FV size is calculated, and handed
+// over to AddFile () when they are placed in the FV image.
+//
+UINT8     *mFfsFileBuffer [MAX_NUMBER_OF_FILES_IN_FV];
+UINTN     mFfsFileSize [MAX_NUMBER_OF_FILES_IN_FV];
 EFI_GUID  mZeroGuid                           = {0x0, 0x0, 0x0, {0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0}};
 EFI_GUID  mDefaultCapsuleGuid                 = {0x3B6686BD, 0x0D76, 0x4030, { 0xB7, 0x0E, 0xB5, 0x51, 0x9E, 0x2F, 0xC5, 0xA0 }};
 EFI_GUID  mEfiFfsSectionAlignmentPaddingGuid  = EFI_FFS_SECTION_ALIGNMENT_PADDING_GUID;
@@ -1173,6 +1180,16 @@ Returns:
     return EFI_INVALID_PARAMETER;
   }
 
+  //
+  // Take over the file contents read by CalculateFvSize ().
+  //
+  if (mFfsFileBuffer[Index] != NULL) {
+    FileBuffer = mFfsFileBuffer[Index];
+    FileSize   = mFfsFileSize[Index];
+    mFfsFileBuffer[Index] = NULL;
+    goto FileRead;
+  }
+
   //
   // Read the file to add
   //
@@ -1214,6 +1231,7 @@ Returns:
     return EFI_ABORTED;
   }
 
+FileRead:
   //
   // For None PI Ffs file, directly add them into FvImage.
   //
@@ -3031,6 +3049,13 @@ Finish:
     free (FvExtHeader);
   }
 
+  for (Index = 0; Index < MAX_NUMBER_OF_FILES_IN_FV; Index++) {
+    if (mFfsFileBuffer[Index] != NULL) {
+      free (mFfsFileBuffer[Index]);
+      mFfsFileBuffer[Index] = NULL;
+    }
+  }
+
   if (FvMapName != NULL) {
     free (FvMapName);
   }
@@ -3154,6 +3179,7 @@ Returns:
   EFI_FFS_FILE_HEADER FfsHeader;
   UINTN               VtfFileSize;
   UINTN               MaxPadFileSize;
+  UINT8               *FfsFileBuffer;
 
   FvExtendHeaderSize = 0;
   MaxPadFileSize = 0;
@@ -3228,14 +3254,35 @@ Returns:
       FfsHeaderSize = sizeof(EFI_FFS_FILE_HEADER);
     }
     //
-    // Read Ffs File header
+    // Read the whole Ffs File, AddFile () uses it later on
     //
-    fread (&FfsHeader, sizeof (UINT8), sizeof (EFI_FFS_FILE_HEADER), fpin);
+    FfsFileBuffer = malloc (FfsFileSize);
+    if (FfsFileBuffer == NULL) {
+      fclose (fpin);
+      Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
+      return EFI_OUT_OF_RESOURCES;
+    }
+    if (fread (FfsFileBuffer, sizeof (UINT8), FfsFileSize, fpin) != FfsFileSize) {
+      free (FfsFileBuffer);
+      fclose (fpin);
+      Error (NULL, 0, 0004, "Error reading file", FvInfoPtr->FvFiles[Index]);
+      return EFI_ABORTED;
+    }
     //
     // close file
     //
     fclose (fpin);
 
+    free (mFfsFileBuffer[Index]);
+    mFfsFileBuffer[Index] = FfsFileBuffer;
+    mFfsFileSize[Index]   = FfsFileSize;
+
+    //
+    // Get Ffs File header
+    //
+    memset (&FfsHeader, 0, sizeof (EFI_FFS_FILE_HEADER));
+    memcpy (&FfsHeader, FfsFileBuffer, MIN (FfsFileSize, sizeof (EFI_FFS_FILE_HEADER)));
+
     if (FvInfoPtr->IsPiFvImage) {
         //
         // Check whether this ffs file is vtf file
@@ -102,6 +102,12 @@ STATIC UINT32   mGOTShindex = 0;
 STATIC UINT32   *mGOTCoffEntries = NULL;
 STATIC UINT32   mGOTMaxCoffEntries = 0;
 STATIC UINT32   mGOTNumCoffEntries = 0;
+STATIC UINT8    *mGOTCoffEntryMap = NULL;
+
+//
+// Section holding the symbol names.
+//
+STATIC Elf_Shdr *mStrtabShdr = NULL;
 
 //
 // Coff information
@@ -353,7 +359,10 @@ GetSymName (
     return NULL;
   }
 
-  StrtabShdr = FindStrtabShdr();
+  if (mStrtabShdr == NULL) {
+    mStrtabShdr = FindStrtabShdr();
+  }
+  StrtabShdr = mStrtabShdr;
   if (StrtabShdr == NULL) {
     return NULL;
   }
@@ -440,8 +449,9 @@ FindElfGOTSectionFromGOTEntryElfRva (
 //
 // Stores locations of GOT entries in COFF image.
 //   Returns TRUE if GOT entry is new.
-//   Simple implementation as number of GOT
-//   entries is expected to be low.
+//   The entries already seen are marked in a
+//   bitmap of the section hosting the GOT, as
+//   large modules have thousands of GOT entries.
 //
 
 STATIC
@@ -450,14 +460,23 @@ AccumulateCoffGOTEntries (
   UINT32 GOTCoffEntry
   )
 {
-  UINT32 i;
-  if (mGOTCoffEntries != NULL) {
-    for (i = 0; i < mGOTNumCoffEntries; i++) {
-      if (mGOTCoffEntries[i] == GOTCoffEntry) {
-        return FALSE;
-      }
+  UINT32 Bit;
+
+  assert (mGOTShdr != NULL);
+  if (mGOTCoffEntryMap == NULL) {
+    mGOTCoffEntryMap = (UINT8*)calloc((size_t)(mGOTShdr->sh_size / 8) + 1, 1);
+    if (mGOTCoffEntryMap == NULL) {
+      Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
     }
+    assert (mGOTCoffEntryMap != NULL);
+  }
+  Bit = GOTCoffEntry - mCoffSectionsOffset[mGOTShindex];
+  assert (Bit < mGOTShdr->sh_size);
+  if ((mGOTCoffEntryMap[Bit / 8] & (1 << (Bit % 8))) != 0) {
+    return FALSE;
   }
+  mGOTCoffEntryMap[Bit / 8] |= (UINT8)(1 << (Bit % 8));
+
   if (mGOTCoffEntries == NULL) {
     mGOTCoffEntries = (UINT32*)malloc(5 * sizeof *mGOTCoffEntries);
     if (mGOTCoffEntries == NULL) {
@@ -528,6 +547,8 @@ EmitGOTRelocations (
   mGOTCoffEntries = NULL;
   mGOTMaxCoffEntries = 0;
   mGOTNumCoffEntries = 0;
+  free(mGOTCoffEntryMap);
+  mGOTCoffEntryMap = NULL;
 }
 //
 // RISC-V 64 specific Elf WriteSection function.
@@ -1904,6 +1925,20 @@ WriteRelocations64 (
   EFI_IMAGE_OPTIONAL_HEADER_UNION  *NtHdr;
   EFI_IMAGE_DATA_DIRECTORY         *Dir;
   UINT32 RiscVRelType;
+  UINT32                           FixupCount;
+
+  //
+  // Each relocation produces at most one fixup, plus the GOT entries.
+  //   Reserve the space for all of them at once.
+  //
+  FixupCount = mGOTNumCoffEntries;
+  for (Index = 0; Index < mEhdr->e_shnum; Index++) {
+    Elf_Shdr *RelShdr = GetShdrByIndex(Index);
+    if (((RelShdr->sh_type == SHT_REL) || (RelShdr->sh_type == SHT_RELA)) && (RelShdr->sh_entsize != 0)) {
+      FixupCount += (UINT32) (RelShdr->sh_size / RelShdr->sh_entsize);
+    }
+  }
+  CoffReserveFixups (FixupCount);
 
   for (Index = 0; Index < mEhdr->e_shnum; Index++) {
     Elf_Shdr *RelShdr = GetShdrByIndex(Index);
@@ -39,6 +39,12 @@ UINT8 *mCoffFile = NULL;
 EFI_IMAGE_BASE_RELOCATION *mCoffBaseRel;
 UINT16                    *mCoffEntryRel;
 
+//
+// End of the allocated and zeroed part of the Coff file the relocation
+// blocks are written to.
+//
+STATIC UINT32 mCoffFixupLimit;
+
 //
 // Current offset in coff file.
 //
@@ -92,18 +98,24 @@ CoffAddFixup(
         CoffAddFixupEntry (0);
     }
 
-    mCoffFile = realloc (
-      mCoffFile,
-      mCoffOffset + sizeof(EFI_IMAGE_BASE_RELOCATION) + 2 * MAX_COFF_ALIGNMENT
-      );
-    if (mCoffFile == NULL) {
-      Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
+    //
+    // Grow the file unless the space was reserved by CoffReserveFixups().
+    //
+    if (mCoffOffset + sizeof(EFI_IMAGE_BASE_RELOCATION) + 2 * MAX_COFF_ALIGNMENT > mCoffFixupLimit) {
+      mCoffFile = realloc (
+        mCoffFile,
+        mCoffOffset + sizeof(EFI_IMAGE_BASE_RELOCATION) + 2 * MAX_COFF_ALIGNMENT
+        );
+      if (mCoffFile == NULL) {
+        Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
+      }
+      assert (mCoffFile != NULL);
+      memset (
+        mCoffFile + mCoffOffset, 0,
+        sizeof(EFI_IMAGE_BASE_RELOCATION) + 2 * MAX_COFF_ALIGNMENT
+        );
+      mCoffFixupLimit = mCoffOffset + sizeof(EFI_IMAGE_BASE_RELOCATION) + 2 * MAX_COFF_ALIGNMENT;
     }
-    assert (mCoffFile != NULL);
-    memset (
-      mCoffFile + mCoffOffset, 0,
-      sizeof(EFI_IMAGE_BASE_RELOCATION) + 2 * MAX_COFF_ALIGNMENT
-      );
 
     mCoffBaseRel = (EFI_IMAGE_BASE_RELOCATION*)(mCoffFile + mCoffOffset);
     mCoffBaseRel->VirtualAddress = Offset & ~0xfff;
@@ -119,6 +131,41 @@ CoffAddFixup(
   CoffAddFixupEntry((UINT16) ((Type << 12) | (Offset & 0xfff)));
 }
 
+//
+// Allocate the space for Count fixups at once, rather than growing
+//   the file for each relocation block. Must be called before the
+//   first fixup is added.
+//
+VOID
+CoffReserveFixups (
+  UINT32 Count
+  )
+{
+  UINT64 Size;
+
+  if (mCoffBaseRel != NULL) {
+    return;
+  }
+
+  //
+  // Each fixup may start a block and end the previous one with a null
+  //   entry and a pad, and the end of the table is padded to the Coff
+  //   alignment.
+  //
+  Size = (UINT64) Count * (sizeof(EFI_IMAGE_BASE_RELOCATION) + 3 * sizeof (UINT16)) + 2 * MAX_COFF_ALIGNMENT;
+  if (mCoffOffset + Size > 0xFFFFFFFF) {
+    return;
+  }
+
+  mCoffFile = realloc (mCoffFile, mCoffOffset + (size_t) Size);
+  if (mCoffFile == NULL) {
+    Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
+  }
+  assert (mCoffFile != NULL);
+  memset (mCoffFile + mCoffOffset, 0, (size_t) Size);
+  mCoffFixupLimit = mCoffOffset + (UINT32) Size;
+}
+
 VOID
 CreateSectionHeader (
   const CHAR8 *Name,
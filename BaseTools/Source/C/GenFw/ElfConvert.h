@@ -105,6 +105,11 @@ CoffAddFixup (
   UINT8  Type
   );
 
+VOID
+CoffReserveFixups (
+  UINT32 Count
+  );
+
 VOID
 CoffAddFixupEntry (
   UINT16 Val
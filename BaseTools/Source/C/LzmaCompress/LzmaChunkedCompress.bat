@@ -0,0 +1,26 @@
+@REM @file
+@REM This script will exec LzmaCompress tool with --chunk-size option that
+@REM splits the input into independently decodable chunks.
+@REM
+@REM Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+@REM SPDX-License-Identifier: BSD-2-Clause-Patent
+@REM
+
+@echo off
+@setlocal
+
+:Begin
+if "%1"=="" goto End
+if "%1"=="-e" (
+  set FLAG=--chunk-size 1048576
+)
+if "%1"=="-d" (
+  set FLAG=--chunk-size 1048576
+)
+set ARGS=%ARGS% %1
+shift
+goto Begin
+
+:End
+LzmaCompress %ARGS% %FLAG%
+@echo on
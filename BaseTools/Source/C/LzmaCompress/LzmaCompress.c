@@ -19,14 +19,72 @@
 #include "Sdk/C/Alloc.h"
 #include "Sdk/C/7zFile.h"
 #include "Sdk/C/7zVersion.h"
+#ifdef _WIN32
+#include "Sdk/C/Threads.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
 #include "Sdk/C/LzmaDec.h"
 #include "Sdk/C/LzmaEnc.h"
 #include "Sdk/C/Bra.h"
 #include "CommonLib.h"
 #include "ParseInf.h"
+#include <Common/PiFirmwareFile.h>
 
 #define LZMA_HEADER_SIZE (LZMA_PROPS_SIZE + 8)
 
+//
+// Chunked section format, see MdeModulePkg/Include/Guid/ChunkedSection.h.
+// The data starts with a header, followed by one LZMA GUIDed section per
+// chunk of the input, each aligned on a 4-byte boundary. The chunks can be
+// decoded independently of each other.
+//
+#define CHUNKED_SECTION_SIGNATURE  0x4B4E4843  // 'C', 'H', 'N', 'K'
+
+typedef struct {
+  UINT32  Signature;
+  UINT32  ChunkCount;
+  UINT64  DecodedSize;
+} CHUNKED_SECTION_HEADER;
+
+//
+// The chunks of a chunked section are encoded in parallel. Each thread owns
+// an LZMA encoder, whose match finder takes about 10 times the dictionary
+// size, so the number of threads picked by default is capped.
+//
+#define MAX_ENCODE_THREADS          64
+#define DEFAULT_MAX_ENCODE_THREADS  8
+
+typedef struct {
+  Byte    *InBuffer;
+  size_t  InSize;
+  Byte    *OutBuffer;
+  size_t  OutSize;
+  SRes    Res;
+} ENCODE_CHUNK;
+
+typedef struct {
+  ENCODE_CHUNK   *Chunks;
+  UINT32         ChunkCount;
+  UINT32         First;
+  UINT32         Stride;
+  CLzmaEncProps  *Props;
+#ifdef _WIN32
+  CThread        Thread;
+#else
+  pthread_t      Thread;
+#endif
+} ENCODE_WORKER;
+
+static EFI_GUID mLzmaCustomDecompressGuid = {
+  0xEE4E5898, 0x3914, 0x4259, { 0x9D, 0x6E, 0xDC, 0x7B, 0xD7, 0x94, 0x03, 0xCF }
+};
+
+static EFI_GUID mLzmaF86CustomDecompressGuid = {
+  0xD42AE6BD, 0x1352, 0x4BFB, { 0x90, 0x9A, 0xCA, 0x72, 0xA6, 0xEA, 0xE8, 0x89 }
+};
+
 typedef enum {
   NoConverter,
   X86Converter,
@@ -44,6 +102,8 @@ static CONVERTER_TYPE mConType = NoConverter;
 
 UINT64 mDictionarySize = 28;
 UINT64 mCompressionMode = 2;
+UINT64 mChunkSize = 0;
+UINT64 mThreadCount = 0;
 
 #define UTILITY_NAME "LzmaCompress"
 #define UTILITY_MAJOR_VERSION 0
@@ -60,9 +120,15 @@ void PrintHelp(char *buffer)
              "  -d: decode file\n"
              "  -o FileName, --output FileName: specify the output filename\n"
              "  --f86: enable converter for x86 code\n"
+             "  --chunk-size Size: encode to, or decode from, the chunked section\n"
+             "                     format, with Size bytes of input per chunk\n"
              "  -v, --verbose: increase output messages\n"
              "  -q, --quiet: reduce output messages\n"
              "  --debug [0-9]: set debug level\n"
+             "  --threads Count: encode the chunks of a chunked section with Count\n"
+             "                   threads - [0, 64], default: 0 (one per processor)\n"
+             "  --level Level: set compression level - [0, 9], default: 5. -a and d\n"
+             "                 override the settings it selects when given after it\n"
              "  -a: set compression mode 0 = fast, 1 = normal, default: 1 (normal)\n"
              "  d: sets Dictionary size - [0, 27], default: 24 (16MB)\n"
              "  --version: display the program version and exit\n"
@@ -94,40 +160,24 @@ void PrintVersion(char *buffer)
   sprintf (buffer, "%s Version %d.%d %s ", UTILITY_NAME, UTILITY_MAJOR_VERSION, UTILITY_MINOR_VERSION, __BUILD_VERSION);
 }
 
-static SRes Encode(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 fileSize, CLzmaEncProps *props)
+static SRes EncodeBuffer(Byte *inBuffer, size_t inSize, CLzmaEncProps *props, Byte **outBuffer, size_t *outSize)
 {
   SRes res;
-  size_t inSize = (size_t)fileSize;
-  Byte *inBuffer = 0;
-  Byte *outBuffer = 0;
   Byte *filteredStream = 0;
-  size_t outSize;
-
-  if (inSize != 0) {
-    inBuffer = (Byte *)MyAlloc(inSize);
-    if (inBuffer == 0)
-      return SZ_ERROR_MEM;
-  } else {
-    return SZ_ERROR_INPUT_EOF;
-  }
-
-  if (SeqInStream_Read(inStream, inBuffer, inSize) != SZ_OK) {
-    res = SZ_ERROR_READ;
-    goto Done;
-  }
+  size_t outSizeProcessed;
+  size_t outPropsSize = LZMA_PROPS_SIZE;
 
   // we allocate 105% of original size + 64KB for output buffer
-  outSize = (size_t)fileSize / 20 * 21 + (1 << 16);
-  outBuffer = (Byte *)MyAlloc(outSize);
-  if (outBuffer == 0) {
-    res = SZ_ERROR_MEM;
-    goto Done;
+  *outSize = inSize / 20 * 21 + (1 << 16);
+  *outBuffer = (Byte *)MyAlloc(*outSize);
+  if (*outBuffer == 0) {
+    return SZ_ERROR_MEM;
   }
 
   {
     int i;
     for (i = 0; i < 8; i++)
-      outBuffer[i + LZMA_PROPS_SIZE] = (Byte)(fileSize >> (8 * i));
+      (*outBuffer)[i + LZMA_PROPS_SIZE] = (Byte)((UInt64)inSize >> (8 * i));
   }
 
   if (mConType != NoConverter)
@@ -148,45 +198,381 @@ static SRes Encode(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 file
     }
   }
 
-  {
-    size_t outSizeProcessed = outSize - LZMA_HEADER_SIZE;
-    size_t outPropsSize = LZMA_PROPS_SIZE;
+  outSizeProcessed = *outSize - LZMA_HEADER_SIZE;
+  res = LzmaEncode(*outBuffer + LZMA_HEADER_SIZE, &outSizeProcessed,
+      mConType != NoConverter ? filteredStream : inBuffer, inSize,
+      props, *outBuffer, &outPropsSize, 0,
+      NULL, &g_Alloc, &g_Alloc);
 
-    res = LzmaEncode(outBuffer + LZMA_HEADER_SIZE, &outSizeProcessed,
-        mConType != NoConverter ? filteredStream : inBuffer, inSize,
-        props, outBuffer, &outPropsSize, 0,
-        NULL, &g_Alloc, &g_Alloc);
+  if (res == SZ_OK)
+    *outSize = LZMA_HEADER_SIZE + outSizeProcessed;
 
-    if (res != SZ_OK)
-      goto Done;
+Done:
+  MyFree(filteredStream);
+  if (res != SZ_OK) {
+    MyFree(*outBuffer);
+    *outBuffer = 0;
+  }
+
+  return res;
+}
+
+static UINT64 GetProcessorCount(void)
+{
+#ifdef _WIN32
+  SYSTEM_INFO info;
+
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors;
+#else
+  long count;
 
-    outSize = LZMA_HEADER_SIZE + outSizeProcessed;
+  count = sysconf(_SC_NPROCESSORS_ONLN);
+  return (count > 0) ? (UINT64)count : 1;
+#endif
+}
+
+#ifdef _WIN32
+static THREAD_FUNC_DECL EncodeChunkWorker(void *context)
+#else
+static void *EncodeChunkWorker(void *context)
+#endif
+{
+  ENCODE_WORKER *worker;
+  ENCODE_CHUNK *chunk;
+  UINT32 index;
+
+  worker = (ENCODE_WORKER *)context;
+  for (index = worker->First; index < worker->ChunkCount; index += worker->Stride) {
+    chunk = &worker->Chunks[index];
+    chunk->Res = EncodeBuffer(chunk->InBuffer, chunk->InSize, worker->Props, &chunk->OutBuffer, &chunk->OutSize);
   }
 
-  if (outStream->Write(outStream, outBuffer, outSize) != outSize)
+  return 0;
+}
+
+static BoolInt StartWorker(ENCODE_WORKER *worker)
+{
+#ifdef _WIN32
+  return Thread_Create(&worker->Thread, EncodeChunkWorker, worker) == 0;
+#else
+  return pthread_create(&worker->Thread, NULL, EncodeChunkWorker, worker) == 0;
+#endif
+}
+
+static void WaitWorker(ENCODE_WORKER *worker)
+{
+#ifdef _WIN32
+  Thread_Wait(&worker->Thread);
+  Thread_Close(&worker->Thread);
+#else
+  pthread_join(worker->Thread, NULL);
+#endif
+}
+
+//
+// Encode all chunks of the input, spreading them over the worker threads.
+// The output does not depend on the number of threads.
+//
+static SRes EncodeChunks(ENCODE_CHUNK *chunks, UINT32 chunkCount, CLzmaEncProps *props)
+{
+  ENCODE_WORKER workers[MAX_ENCODE_THREADS];
+  UINT64 threadCount;
+  UINT32 started;
+  UINT32 index;
+
+  threadCount = mThreadCount;
+  if (threadCount == 0) {
+    threadCount = GetProcessorCount();
+    if (threadCount > DEFAULT_MAX_ENCODE_THREADS)
+      threadCount = DEFAULT_MAX_ENCODE_THREADS;
+  }
+  if (threadCount > chunkCount)
+    threadCount = chunkCount;
+
+  for (index = 0; index < threadCount; index++) {
+    workers[index].Chunks = chunks;
+    workers[index].ChunkCount = chunkCount;
+    workers[index].First = index;
+    workers[index].Stride = (UINT32)threadCount;
+    workers[index].Props = props;
+  }
+
+  for (started = 1; started < threadCount; started++) {
+    if (!StartWorker(&workers[started]))
+      break;
+  }
+
+  //
+  // The calling thread is the first worker, and also takes over the chunks
+  // of the threads that could not be started.
+  //
+  EncodeChunkWorker(&workers[0]);
+  for (index = started; index < threadCount; index++)
+    EncodeChunkWorker(&workers[index]);
+  for (index = 1; index < started; index++)
+    WaitWorker(&workers[index]);
+
+  for (index = 0; index < chunkCount; index++) {
+    if (chunks[index].Res != SZ_OK)
+      return chunks[index].Res;
+  }
+
+  return SZ_OK;
+}
+
+static SRes EncodeChunked(ISeqOutStream *outStream, Byte *inBuffer, size_t inSize, CLzmaEncProps *props)
+{
+  SRes res;
+  CHUNKED_SECTION_HEADER header;
+  EFI_GUID_DEFINED_SECTION section;
+  EFI_GUID_DEFINED_SECTION2 section2;
+  EFI_GUID *sectionGuid;
+  Byte *headerBuffer;
+  size_t sectionHeaderSize;
+  size_t sectionSize;
+  size_t chunkOffset;
+  ENCODE_CHUNK *chunks;
+  UINT32 index;
+  Byte *outBuffer;
+  size_t outSize;
+  static const Byte padding[3] = { 0 };
+
+  sectionGuid = (mConType == X86Converter) ? &mLzmaF86CustomDecompressGuid : &mLzmaCustomDecompressGuid;
+
+  header.Signature = CHUNKED_SECTION_SIGNATURE;
+  header.ChunkCount = (UINT32)((inSize + mChunkSize - 1) / mChunkSize);
+  header.DecodedSize = inSize;
+
+  chunks = (ENCODE_CHUNK *)MyAlloc(header.ChunkCount * sizeof (ENCODE_CHUNK));
+  if (chunks == 0)
+    return SZ_ERROR_MEM;
+
+  memset(chunks, 0, header.ChunkCount * sizeof (ENCODE_CHUNK));
+  for (index = 0, chunkOffset = 0; index < header.ChunkCount; index++, chunkOffset += (size_t)mChunkSize) {
+    chunks[index].InBuffer = inBuffer + chunkOffset;
+    chunks[index].InSize = inSize - chunkOffset;
+    if (chunks[index].InSize > mChunkSize)
+      chunks[index].InSize = (size_t)mChunkSize;
+  }
+
+  res = EncodeChunks(chunks, header.ChunkCount, props);
+  if (res != SZ_OK)
+    goto Done;
+
+  if (outStream->Write(outStream, &header, sizeof (header)) != sizeof (header)) {
     res = SZ_ERROR_WRITE;
+    goto Done;
+  }
+
+  for (index = 0; index < header.ChunkCount; index++) {
+    outBuffer = chunks[index].OutBuffer;
+    outSize = chunks[index].OutSize;
+
+    //
+    // Wrap each chunk into a GUIDed section of its own.
+    //
+    sectionHeaderSize = sizeof (EFI_GUID_DEFINED_SECTION);
+    sectionSize = sectionHeaderSize + outSize;
+    if (sectionSize >= MAX_SECTION_SIZE) {
+      sectionHeaderSize = sizeof (EFI_GUID_DEFINED_SECTION2);
+      sectionSize = sectionHeaderSize + outSize;
+      memset(&section2, 0, sizeof (section2));
+      memset(section2.CommonHeader.Size, 0xff, sizeof (section2.CommonHeader.Size));
+      section2.CommonHeader.Type = EFI_SECTION_GUID_DEFINED;
+      section2.CommonHeader.ExtendedSize = (UINT32)sectionSize;
+      section2.SectionDefinitionGuid = *sectionGuid;
+      section2.DataOffset = (UINT16)sectionHeaderSize;
+      section2.Attributes = EFI_GUIDED_SECTION_PROCESSING_REQUIRED;
+      headerBuffer = (Byte *)&section2;
+    } else {
+      memset(&section, 0, sizeof (section));
+      section.CommonHeader.Size[0] = (UINT8)(sectionSize & 0xff);
+      section.CommonHeader.Size[1] = (UINT8)((sectionSize >> 8) & 0xff);
+      section.CommonHeader.Size[2] = (UINT8)((sectionSize >> 16) & 0xff);
+      section.CommonHeader.Type = EFI_SECTION_GUID_DEFINED;
+      section.SectionDefinitionGuid = *sectionGuid;
+      section.DataOffset = (UINT16)sectionHeaderSize;
+      section.Attributes = EFI_GUIDED_SECTION_PROCESSING_REQUIRED;
+      headerBuffer = (Byte *)&section;
+    }
+
+    if ((outStream->Write(outStream, headerBuffer, sectionHeaderSize) != sectionHeaderSize) ||
+        (outStream->Write(outStream, outBuffer, outSize) != outSize) ||
+        (outStream->Write(outStream, padding, (4 - (sectionSize & 3)) & 3) != ((4 - (sectionSize & 3)) & 3))) {
+      res = SZ_ERROR_WRITE;
+      break;
+    }
+  }
 
 Done:
-  MyFree(outBuffer);
-  MyFree(inBuffer);
-  MyFree(filteredStream);
+  for (index = 0; index < header.ChunkCount; index++)
+    MyFree(chunks[index].OutBuffer);
+  MyFree(chunks);
 
   return res;
 }
 
-static SRes Decode(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 fileSize)
+static SRes Encode(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 fileSize, CLzmaEncProps *props)
 {
   SRes res;
   size_t inSize = (size_t)fileSize;
   Byte *inBuffer = 0;
   Byte *outBuffer = 0;
-  size_t outSize = 0;
+  size_t outSize;
+
+  if (inSize != 0) {
+    inBuffer = (Byte *)MyAlloc(inSize);
+    if (inBuffer == 0)
+      return SZ_ERROR_MEM;
+  } else {
+    return SZ_ERROR_INPUT_EOF;
+  }
+
+  if (SeqInStream_Read(inStream, inBuffer, inSize) != SZ_OK) {
+    res = SZ_ERROR_READ;
+    goto Done;
+  }
+
+  if (mChunkSize != 0) {
+    res = EncodeChunked(outStream, inBuffer, inSize, props);
+    goto Done;
+  }
+
+  res = EncodeBuffer(inBuffer, inSize, props, &outBuffer, &outSize);
+  if (res != SZ_OK)
+    goto Done;
+
+  if (outStream->Write(outStream, outBuffer, outSize) != outSize)
+    res = SZ_ERROR_WRITE;
+
+Done:
+  MyFree(outBuffer);
+  MyFree(inBuffer);
+
+  return res;
+}
+
+static SRes DecodeBuffer(Byte *inBuffer, size_t inSize, Byte **outBuffer, size_t *outSize)
+{
+  SRes res;
   size_t inSizePure;
   ELzmaStatus status;
   UInt64 outSize64 = 0;
 
   int i;
 
+  *outBuffer = 0;
+  *outSize = 0;
+
+  if (inSize < LZMA_HEADER_SIZE)
+    return SZ_ERROR_INPUT_EOF;
+
+  for (i = 0; i < 8; i++)
+    outSize64 += ((UInt64)inBuffer[LZMA_PROPS_SIZE + i]) << (i * 8);
+
+  *outSize = (size_t)outSize64;
+  if (*outSize == 0)
+    return SZ_OK;
+
+  *outBuffer = (Byte *)MyAlloc(*outSize);
+  if (*outBuffer == 0)
+    return SZ_ERROR_MEM;
+
+  inSizePure = inSize - LZMA_HEADER_SIZE;
+  res = LzmaDecode(*outBuffer, outSize, inBuffer + LZMA_HEADER_SIZE, &inSizePure,
+      inBuffer, LZMA_PROPS_SIZE, LZMA_FINISH_END, &status, &g_Alloc);
+
+  if (res != SZ_OK) {
+    MyFree(*outBuffer);
+    *outBuffer = 0;
+    return res;
+  }
+
+  if (mConType == X86Converter)
+  {
+    UInt32 x86State;
+    x86_Convert_Init(x86State);
+    x86_Convert(*outBuffer, (SizeT) *outSize, 0, &x86State, 0);
+  }
+
+  return SZ_OK;
+}
+
+static SRes DecodeChunked(ISeqOutStream *outStream, Byte *inBuffer, size_t inSize)
+{
+  SRes res;
+  CHUNKED_SECTION_HEADER *header;
+  EFI_GUID_DEFINED_SECTION *section;
+  size_t sectionSize;
+  size_t dataOffset;
+  size_t offset;
+  size_t decodedSize;
+  UINT32 index;
+  Byte *outBuffer;
+  size_t outSize;
+
+  if (inSize < sizeof (CHUNKED_SECTION_HEADER))
+    return SZ_ERROR_INPUT_EOF;
+
+  header = (CHUNKED_SECTION_HEADER *)inBuffer;
+  if (header->Signature != CHUNKED_SECTION_SIGNATURE)
+    return SZ_ERROR_DATA;
+
+  decodedSize = 0;
+  offset = sizeof (CHUNKED_SECTION_HEADER);
+  for (index = 0; index < header->ChunkCount; index++) {
+    offset = (offset + 3) & ~(size_t)3;
+    if (offset > inSize || inSize - offset < sizeof (EFI_GUID_DEFINED_SECTION))
+      return SZ_ERROR_INPUT_EOF;
+
+    section = (EFI_GUID_DEFINED_SECTION *)(inBuffer + offset);
+    if (section->CommonHeader.Type != EFI_SECTION_GUID_DEFINED)
+      return SZ_ERROR_DATA;
+
+    sectionSize = section->CommonHeader.Size[0] |
+                  (section->CommonHeader.Size[1] << 8) |
+                  (section->CommonHeader.Size[2] << 16);
+    if (sectionSize == 0xffffff) {
+      if (inSize - offset < sizeof (EFI_GUID_DEFINED_SECTION2))
+        return SZ_ERROR_INPUT_EOF;
+      sectionSize = ((EFI_GUID_DEFINED_SECTION2 *)section)->CommonHeader.ExtendedSize;
+      dataOffset = ((EFI_GUID_DEFINED_SECTION2 *)section)->DataOffset;
+    } else {
+      dataOffset = section->DataOffset;
+    }
+
+    if (sectionSize > inSize - offset || dataOffset > sectionSize)
+      return SZ_ERROR_INPUT_EOF;
+
+    res = DecodeBuffer(inBuffer + offset + dataOffset, sectionSize - dataOffset, &outBuffer, &outSize);
+    if (res != SZ_OK)
+      return res;
+
+    if (outStream->Write(outStream, outBuffer, outSize) != outSize) {
+      MyFree(outBuffer);
+      return SZ_ERROR_WRITE;
+    }
+
+    MyFree(outBuffer);
+    decodedSize += outSize;
+    offset += sectionSize;
+  }
+
+  if (decodedSize != header->DecodedSize)
+    return SZ_ERROR_DATA;
+
+  return SZ_OK;
+}
+
+static SRes Decode(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 fileSize)
+{
+  SRes res;
+  size_t inSize = (size_t)fileSize;
+  Byte *inBuffer = 0;
+  Byte *outBuffer = 0;
+  size_t outSize = 0;
+
   if (inSize < LZMA_HEADER_SIZE)
     return SZ_ERROR_INPUT_EOF;
 
@@ -199,35 +585,15 @@ static SRes Decode(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 file
     goto Done;
   }
 
-  for (i = 0; i < 8; i++)
-    outSize64 += ((UInt64)inBuffer[LZMA_PROPS_SIZE + i]) << (i * 8);
-
-  outSize = (size_t)outSize64;
-  if (outSize != 0) {
-    outBuffer = (Byte *)MyAlloc(outSize);
-    if (outBuffer == 0) {
-      res = SZ_ERROR_MEM;
-      goto Done;
-    }
-  } else {
-    res = SZ_OK;
+  if (mChunkSize != 0) {
+    res = DecodeChunked(outStream, inBuffer, inSize);
     goto Done;
   }
 
-  inSizePure = inSize - LZMA_HEADER_SIZE;
-  res = LzmaDecode(outBuffer, &outSize, inBuffer + LZMA_HEADER_SIZE, &inSizePure,
-      inBuffer, LZMA_PROPS_SIZE, LZMA_FINISH_END, &status, &g_Alloc);
-
+  res = DecodeBuffer(inBuffer, inSize, &outBuffer, &outSize);
   if (res != SZ_OK)
     goto Done;
 
-  if (mConType == X86Converter)
-  {
-    UInt32 x86State;
-    x86_Convert_Init(x86State);
-    x86_Convert(outBuffer, (SizeT) outSize, 0, &x86State, 0);
-  }
-
   if (outStream->Write(outStream, outBuffer, outSize) != outSize)
     res = SZ_ERROR_WRITE;
 
@@ -272,6 +638,38 @@ int main2(int numArgs, const char *args[], char *rs)
       modeWasSet = True;
     } else if (strcmp(args[param], "--f86") == 0) {
       mConType = X86Converter;
+    } else if (strcmp(args[param], "--chunk-size") == 0) {
+      if (numArgs < (param + 2)) {
+        return PrintUserError(rs);
+      }
+      if ((AsciiStringToUint64(args[param + 1], FALSE, &mChunkSize) != EFI_SUCCESS) ||
+          (mChunkSize == 0) || (mChunkSize > MAX_SECTION_SIZE)) {
+        return PrintError(rs, kInvalidParamValMessage);
+      }
+      param++;
+    } else if (strcmp(args[param], "--threads") == 0) {
+      if (numArgs < (param + 2)) {
+        return PrintUserError(rs);
+      }
+      if ((AsciiStringToUint64(args[param + 1], FALSE, &mThreadCount) != EFI_SUCCESS) ||
+          (mThreadCount > MAX_ENCODE_THREADS)) {
+        return PrintError(rs, kInvalidParamValMessage);
+      }
+      param++;
+    } else if (strcmp(args[param], "--level") == 0) {
+      UINT64 level;
+
+      if (numArgs < (param + 2)) {
+        return PrintUserError(rs);
+      }
+      if ((AsciiStringToUint64(args[param + 1], FALSE, &level) != EFI_SUCCESS) ||
+          (level > 9)) {
+        return PrintError(rs, kInvalidParamValMessage);
+      }
+      LzmaEncProps_Init(&props);
+      props.level = (int)level;
+      LzmaEncProps_Normalize(&props);
+      param++;
     } else if (strcmp(args[param], "-o") == 0 ||
                strcmp(args[param], "--output") == 0) {
       if (numArgs < (param + 2)) {
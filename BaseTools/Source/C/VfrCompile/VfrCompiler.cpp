@@ -10,6 +10,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include "stdio.h"
 #include "stdlib.h"
 #include "string.h"
+#include "time.h"
 #include "VfrCompiler.h"
 #include "CommonLib.h"
 #include "EfiUtilityMsgs.h"
@@ -58,6 +59,7 @@ CVfrCompiler::OptionInitialization (
 {
   INT32         Index;
   EFI_STATUS    Status;
+  UINT64        LogLevel;
 
   Status = EFI_SUCCESS;
   SetUtilityName ((CHAR8*) PROGRAM_NAME);
@@ -163,6 +165,18 @@ CVfrCompiler::OptionInitialization (
       mOptions.AutoDefault = TRUE;
     } else if (stricmp(Argv[Index], "-d") == 0 ||stricmp(Argv[Index], "--checkdefault") == 0) {
       mOptions.CheckDefault = TRUE;
+    } else if (stricmp(Argv[Index], "--debug") == 0) {
+      Index++;
+      if ((Index >= Argc) || (Argv[Index][0] == '-')) {
+        DebugError (NULL, 0, 1001, "Missing option", "--debug missing debug level");
+        goto Fail;
+      }
+      Status = AsciiStringToUint64 (Argv[Index], FALSE, &LogLevel);
+      if (EFI_ERROR (Status) || (LogLevel > 9)) {
+        DebugError (NULL, 0, 1003, "Invalid option value", "Debug Level range is 0-9, current input level is %s", Argv[Index]);
+        goto Fail;
+      }
+      SetPrintLevel (LogLevel);
     } else {
       DebugError (NULL, 0, 1000, "Unknown option", "unrecognized option %s", Argv[Index]);
       goto Fail;
@@ -567,6 +581,8 @@ CVfrCompiler::Usage (
     "                 treat warning as an error",
     "  -a  --autodefaut    generate default value for question opcode if some default is missing",
     "  -d  --checkdefault  check the default information in a question opcode",
+    "  --debug LEVEL  enable debug messages at the debug level 0-9,",
+    "                 level 9 prints the time spent in each compile phase",
     NULL
     };
   for (Index = 0; Help[Index] != NULL; Index++) {
@@ -904,6 +920,28 @@ Err1:
   fclose (pInFile);
 }
 
+/**
+  Print the processor time spent in a compile phase at debug level 9.
+
+  @param Phase     The name of the phase.
+  @param Start     The clock at the start of the phase, updated to the clock
+                   at the start of the next phase.
+
+**/
+static
+VOID
+PhaseDone (
+  IN     CONST CHAR8 *Phase,
+  IN OUT clock_t     *Start
+  )
+{
+  clock_t End;
+
+  End = clock ();
+  DebugMsg (NULL, 0, 9, (CHAR8 *) Phase, (CHAR8 *) "%lu ms", (unsigned long) ((End - *Start) * 1000 / CLOCKS_PER_SEC));
+  *Start = End;
+}
+
 int
 main (
   IN int             Argc,
@@ -911,16 +949,24 @@ main (
   )
 {
   COMPILER_RUN_STATUS  Status;
+  clock_t              Start;
 
   SetPrintLevel(WARNING_LOG_LEVEL);
   CVfrCompiler         Compiler(Argc, Argv);
 
+  Start = clock ();
   Compiler.PreProcess();
+  PhaseDone ("PreProcess", &Start);
   Compiler.Compile();
+  PhaseDone ("Compile", &Start);
   Compiler.AdjustBin();
+  PhaseDone ("AdjustBin", &Start);
   Compiler.GenBinary();
+  PhaseDone ("GenBinary", &Start);
   Compiler.GenCFile();
+  PhaseDone ("GenCFile", &Start);
   Compiler.GenRecordListFile ();
+  PhaseDone ("GenRecordListFile", &Start);
 
   Status = Compiler.RunStatus ();
   if ((Status == STATUS_DEAD) || (Status == STATUS_FAILED)) {
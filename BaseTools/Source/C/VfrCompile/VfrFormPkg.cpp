@@ -8,6 +8,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 **/
 
 #include "stdio.h"
+#include "stdlib.h"
 #include "assert.h"
 #include "VfrFormPkg.h"
 
@@ -1024,6 +1025,12 @@ CIfrRecordInfoDB::CIfrRecordInfoDB (
   mRecordCount       = EFI_IFR_RECORDINFO_IDX_START;
   mIfrRecordListHead = NULL;
   mIfrRecordListTail = NULL;
+  mRecordArray       = NULL;
+  mRecordArrayCount  = 0;
+  mRecordArrayMax    = 0;
+  mRecordArrayValid  = TRUE;
+  mLineIndex         = NULL;
+  mLineIndexCount    = 0;
   mAllDefaultTypeCount = 0;
   for (UINT8 i = 0; i < EFI_HII_MAX_SUPPORT_DEFAULT_TYPE; i++) {
     mAllDefaultIdArray[i] = 0xffff;
@@ -1041,6 +1048,148 @@ CIfrRecordInfoDB::~CIfrRecordInfoDB (
     mIfrRecordListHead = mIfrRecordListHead->mNext;
     delete pNode;
   }
+
+  if (mRecordArray != NULL) {
+    delete[] mRecordArray;
+  }
+
+  if (mLineIndex != NULL) {
+    delete[] mLineIndex;
+  }
+}
+
+BOOLEAN
+CIfrRecordInfoDB::ReserveRecordArray (
+  IN UINT32 Count
+  )
+{
+  SIfrRecord **NewArray;
+  UINT32     NewMax;
+
+  if (Count <= mRecordArrayMax) {
+    return TRUE;
+  }
+
+  NewMax = (mRecordArrayMax == 0) ? 1024 : mRecordArrayMax;
+  while (NewMax < Count) {
+    NewMax *= 2;
+  }
+
+  if ((NewArray = new SIfrRecord *[NewMax]) == NULL) {
+    return FALSE;
+  }
+
+  if (mRecordArray != NULL) {
+    memcpy (NewArray, mRecordArray, mRecordArrayCount * sizeof (SIfrRecord *));
+    delete[] mRecordArray;
+  }
+  mRecordArray    = NewArray;
+  mRecordArrayMax = NewMax;
+
+  return TRUE;
+}
+
+BOOLEAN
+CIfrRecordInfoDB::BuildRecordArray (
+  VOID
+  )
+{
+  SIfrRecord *pNode;
+  UINT32     Count;
+
+  if (mRecordArrayValid) {
+    return TRUE;
+  }
+
+  for (Count = 0, pNode = mIfrRecordListHead; pNode != NULL; pNode = pNode->mNext) {
+    Count++;
+  }
+
+  mRecordArrayCount = 0;
+  if (!ReserveRecordArray (Count)) {
+    return FALSE;
+  }
+
+  for (pNode = mIfrRecordListHead; pNode != NULL; pNode = pNode->mNext) {
+    mRecordArray[mRecordArrayCount++] = pNode;
+  }
+  mRecordArrayValid = TRUE;
+
+  return TRUE;
+}
+
+static
+int
+CompareRecordLineIndex (
+  IN CONST VOID *Left,
+  IN CONST VOID *Right
+  )
+{
+  CONST SIfrRecordLineIndex *L = (CONST SIfrRecordLineIndex *) Left;
+  CONST SIfrRecordLineIndex *R = (CONST SIfrRecordLineIndex *) Right;
+
+  if (L->mRecord->mLineNo != R->mRecord->mLineNo) {
+    return (L->mRecord->mLineNo < R->mRecord->mLineNo) ? -1 : 1;
+  }
+
+  //
+  // Keep the list order of the records on the same line.
+  //
+  return (L->mPosition < R->mPosition) ? -1 : (L->mPosition > R->mPosition);
+}
+
+BOOLEAN
+CIfrRecordInfoDB::BuildLineIndex (
+  VOID
+  )
+{
+  SIfrRecord *pNode;
+  UINT32     Count;
+
+  if (mLineIndex != NULL) {
+    return TRUE;
+  }
+
+  for (Count = 0, pNode = mIfrRecordListHead; pNode != NULL; pNode = pNode->mNext) {
+    Count++;
+  }
+
+  if ((Count == 0) || ((mLineIndex = new SIfrRecordLineIndex[Count]) == NULL)) {
+    return FALSE;
+  }
+
+  for (Count = 0, pNode = mIfrRecordListHead; pNode != NULL; pNode = pNode->mNext, Count++) {
+    mLineIndex[Count].mRecord   = pNode;
+    mLineIndex[Count].mPosition = Count;
+  }
+  mLineIndexCount = Count;
+
+  qsort (mLineIndex, mLineIndexCount, sizeof (SIfrRecordLineIndex), CompareRecordLineIndex);
+
+  return TRUE;
+}
+
+/**
+  Drop the indexes of the record list after it is changed.
+
+  @param ListReordered     Whether records were moved in the list, otherwise
+                           a record was only appended or updated.
+
+**/
+VOID
+CIfrRecordInfoDB::InvalidateRecordIndex (
+  IN BOOLEAN ListReordered
+  )
+{
+  if (ListReordered) {
+    mRecordArrayValid = FALSE;
+  }
+
+  if (mLineIndex != NULL) {
+    delete[] mLineIndex;
+    mLineIndex      = NULL;
+    mLineIndexCount = 0;
+  }
 }
 
 SIfrRecord *
@@ -1055,6 +1204,14 @@ CIfrRecordInfoDB::GetRecordInfoFromIdx (
     return NULL;
   }
 
+  if (BuildRecordArray ()) {
+    if ((RecordIdx <= EFI_IFR_RECORDINFO_IDX_START) ||
+        (RecordIdx - EFI_IFR_RECORDINFO_IDX_START > mRecordArrayCount)) {
+      return NULL;
+    }
+    return mRecordArray[RecordIdx - EFI_IFR_RECORDINFO_IDX_START - 1];
+  }
+
   for (Idx = (EFI_IFR_RECORDINFO_IDX_START + 1), pNode = mIfrRecordListHead;
        (Idx != RecordIdx) && (pNode != NULL);
        Idx++, pNode = pNode->mNext)
@@ -1090,6 +1247,15 @@ CIfrRecordInfoDB::IfrRecordRegister (
   }
   mRecordCount++;
 
+  if (mRecordArrayValid) {
+    if (ReserveRecordArray (mRecordArrayCount + 1)) {
+      mRecordArray[mRecordArrayCount++] = pNew;
+    } else {
+      mRecordArrayValid = FALSE;
+    }
+  }
+  InvalidateRecordIndex (FALSE);
+
   return mRecordCount;
 }
 
@@ -1124,6 +1290,7 @@ CIfrRecordInfoDB::IfrRecordInfoUpdate (
   pNode->mBinBufLen = BinBufLen;
   pNode->mIfrBinBuf = BinBuf;
 
+  InvalidateRecordIndex (FALSE);
 }
 
 VOID
@@ -1168,6 +1335,24 @@ CIfrRecordInfoDB::IfrRecordOutput (
   return;
 }
 
+static
+VOID
+IfrRecordPrint (
+  IN FILE       *File,
+  IN SIfrRecord *pNode
+  )
+{
+  UINT8      Index;
+
+  fprintf (File, ">%08X: ", pNode->mOffset);
+  if (pNode->mIfrBinBuf != NULL) {
+    for (Index = 0; Index < pNode->mBinBufLen; Index++) {
+      fprintf (File, "%02X ", (UINT8)(pNode->mIfrBinBuf[Index]));
+    }
+  }
+  fprintf (File, "\n");
+}
+
 VOID
 CIfrRecordInfoDB::IfrRecordOutput (
   IN FILE   *File,
@@ -1175,8 +1360,10 @@ CIfrRecordInfoDB::IfrRecordOutput (
   )
 {
   SIfrRecord *pNode;
-  UINT8      Index;
   UINT32     TotalSize;
+  UINT32     Low;
+  UINT32     High;
+  UINT32     Mid;
 
   if (mSwitch == FALSE) {
     return;
@@ -1186,18 +1373,34 @@ CIfrRecordInfoDB::IfrRecordOutput (
     return;
   }
 
+  //
+  // The listing file asks for the records of every source line, look them up
+  // in the line index instead of walking the whole list for each line.
+  //
+  if ((LineNo != 0) && BuildLineIndex ()) {
+    Low  = 0;
+    High = mLineIndexCount;
+    while (Low < High) {
+      Mid = Low + (High - Low) / 2;
+      if (mLineIndex[Mid].mRecord->mLineNo < LineNo) {
+        Low = Mid + 1;
+      } else {
+        High = Mid;
+      }
+    }
+
+    for (; (Low < mLineIndexCount) && (mLineIndex[Low].mRecord->mLineNo == LineNo); Low++) {
+      IfrRecordPrint (File, mLineIndex[Low].mRecord);
+    }
+    return;
+  }
+
   TotalSize = 0;
 
   for (pNode = mIfrRecordListHead; pNode != NULL; pNode = pNode->mNext) {
     if (pNode->mLineNo == LineNo || LineNo == 0) {
-      fprintf (File, ">%08X: ", pNode->mOffset);
+      IfrRecordPrint (File, pNode);
       TotalSize += pNode->mBinBufLen;
-      if (pNode->mIfrBinBuf != NULL) {
-        for (Index = 0; Index < pNode->mBinBufLen; Index++) {
-          fprintf (File, "%02X ", (UINT8)(pNode->mIfrBinBuf[Index]));
-        }
-      }
-      fprintf (File, "\n");
     }
   }
 
@@ -1345,6 +1548,8 @@ CIfrRecordInfoDB::IfrAdjustDynamicOpcodeInRecords (
     return FALSE;
   }
 
+  InvalidateRecordIndex (TRUE);
+
   //
   // Adjust the node. pPreNode save the Node before mIfrRecordListTail
   //
@@ -1438,6 +1643,11 @@ CIfrRecordInfoDB::IfrRecordAdjust (
   Status = VFR_RETURN_SUCCESS;
   pNode = mIfrRecordListHead;
   preNode = pNode;
+
+  //
+  // Records are moved in the list below.
+  //
+  InvalidateRecordIndex (TRUE);
   QuestionScope = 0;
   while (pNode != NULL) {
     OpHead = (EFI_IFR_OP_HEADER *) pNode->mIfrBinBuf;
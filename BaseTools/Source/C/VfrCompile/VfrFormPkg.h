@@ -179,6 +179,15 @@ struct SIfrRecord {
   ~SIfrRecord (VOID);
 };
 
+//
+// Entry of the index used to list the records of one source line; Position is
+// the position of the record in the record list.
+//
+struct SIfrRecordLineIndex {
+  SIfrRecord *mRecord;
+  UINT32     mPosition;
+};
+
 
 #define EFI_IFR_RECORDINFO_IDX_INVALUD 0xFFFFFF
 #define EFI_IFR_RECORDINFO_IDX_START   0x0
@@ -206,6 +215,25 @@ private:
   UINT8      mAllDefaultTypeCount;
   UINT16     mAllDefaultIdArray[EFI_HII_MAX_SUPPORT_DEFAULT_TYPE];
 
+  //
+  // Records in list order, so that a record index does not need a walk of the
+  // list. It is rebuilt from the list after the records are moved around.
+  //
+  SIfrRecord **mRecordArray;
+  UINT32     mRecordArrayCount;
+  UINT32     mRecordArrayMax;
+  BOOLEAN    mRecordArrayValid;
+
+  //
+  // Records sorted by line number, built when the listing file is generated.
+  //
+  SIfrRecordLineIndex *mLineIndex;
+  UINT32     mLineIndexCount;
+
+  BOOLEAN          ReserveRecordArray (IN UINT32);
+  BOOLEAN          BuildRecordArray (VOID);
+  BOOLEAN          BuildLineIndex (VOID);
+  VOID             InvalidateRecordIndex (IN BOOLEAN);
   SIfrRecord * GetRecordInfoFromIdx (IN UINT32);
   BOOLEAN          CheckQuestionOpCode (IN UINT8);
   BOOLEAN          CheckIdOpCode (IN UINT8);
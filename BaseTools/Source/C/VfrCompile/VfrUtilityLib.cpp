@@ -131,6 +131,7 @@ SConfigItem::SConfigItem (
   mGuid          = NULL;
   mId            = NULL;
   mInfoStrList = NULL;
+  mOffsetMap   = NULL;
   mNext        = NULL;
 
   if (Name != NULL) {
@@ -166,6 +167,7 @@ SConfigItem::SConfigItem (
   mGuid        = NULL;
   mId          = NULL;
   mInfoStrList = NULL;
+  mOffsetMap   = NULL;
   mNext        = NULL;
 
   if (Name != NULL) {
@@ -198,6 +200,7 @@ SConfigItem::~SConfigItem (
   ARRAY_SAFE_FREE (mName);
   ARRAY_SAFE_FREE (mGuid);
   ARRAY_SAFE_FREE (mId);
+  ARRAY_SAFE_FREE (mOffsetMap);
   while (mInfoStrList != NULL) {
     Info = mInfoStrList;
     mInfoStrList = mInfoStrList->mNext;
@@ -320,17 +323,38 @@ CVfrBufferConfig::Write (
       }
       mItemListPos = pItem;
     } else {
-      // tranverse the list to find out if there's already the value for the same offset
-      for (pInfo = mItemListPos->mInfoStrList; pInfo != NULL; pInfo = pInfo->mNext) {
-        if (pInfo->mOffset == Offset) {
+      //
+      // Find out if there's already the value for the same offset. A varstore
+      // gets a value for each of its questions, so keep a bitmap of the offsets
+      // rather than traverse the list every time.
+      //
+      if (mItemListPos->mOffsetMap == NULL) {
+        if ((mItemListPos->mOffsetMap = new UINT8[0x10000 / 8]) != NULL) {
+          memset (mItemListPos->mOffsetMap, 0, 0x10000 / 8);
+          for (pInfo = mItemListPos->mInfoStrList; pInfo != NULL; pInfo = pInfo->mNext) {
+            mItemListPos->mOffsetMap[pInfo->mOffset / 8] |= (UINT8) (1 << (pInfo->mOffset % 8));
+          }
+        }
+      }
+      if (mItemListPos->mOffsetMap != NULL) {
+        if ((mItemListPos->mOffsetMap[Offset / 8] & (1 << (Offset % 8))) != 0) {
           return 0;
         }
+      } else {
+        for (pInfo = mItemListPos->mInfoStrList; pInfo != NULL; pInfo = pInfo->mNext) {
+          if (pInfo->mOffset == Offset) {
+            return 0;
+          }
+        }
       }
       if((pInfo = new SConfigInfo (Type, Offset, Width, Value)) == NULL) {
         return 2;
       }
       pInfo->mNext = mItemListPos->mInfoStrList;
       mItemListPos->mInfoStrList = pInfo;
+      if (mItemListPos->mOffsetMap != NULL) {
+        mItemListPos->mOffsetMap[Offset / 8] |= (UINT8) (1 << (Offset % 8));
+      }
     }
     break;
 
@@ -61,6 +61,7 @@ struct SConfigItem {
   EFI_GUID      *mGuid;         // varstore guid, varstore name + guid deside one varstore
   CHAR8         *mId;           // default ID
   SConfigInfo   *mInfoStrList;  // list of Offset/Value in the varstore
+  UINT8         *mOffsetMap;    // bitmap of the offsets in mInfoStrList, built on first lookup
   SConfigItem   *mNext;
 
 public:
@@ -206,6 +206,7 @@ class AutoGenWorkerInProcess(mp.Process):
             GlobalData.gDatabasePath = self.data_pipe.Get("DatabasePath")
 
             GlobalData.gUseHashCache = self.data_pipe.Get("UseHashCache")
+            GlobalData.gMetaFileCacheDir = self.data_pipe.Get("MetaFileCacheDir")
             GlobalData.gBinCacheSource = self.data_pipe.Get("BinCacheSource")
             GlobalData.gBinCacheDest = self.data_pipe.Get("BinCacheDest")
             GlobalData.gPlatformHashFile = self.data_pipe.Get("PlatformHashFile")
@@ -164,6 +164,8 @@ class MemoryDataPipe(DataPipe):
 
         self.DataContainer = {"UseHashCache":GlobalData.gUseHashCache}
 
+        self.DataContainer = {"MetaFileCacheDir":GlobalData.gMetaFileCacheDir}
+
         self.DataContainer = {"BinCacheSource":GlobalData.gBinCacheSource}
 
         self.DataContainer = {"BinCacheDest":GlobalData.gBinCacheDest}
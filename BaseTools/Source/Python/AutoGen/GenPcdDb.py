@@ -1550,6 +1550,15 @@ def CreatePcdDatabasePhaseSpecificAutoGen (Platform, DynamicPcdList, Phase):
         Dict['EXMAP_TABLE_EMPTY']    = 'FALSE'
         Dict['EXMAPPING_TABLE_SIZE'] = str(NumberOfExTokens) + 'U'
         Dict['EX_TOKEN_NUMBER']      = str(NumberOfExTokens) + 'U'
+        #
+        # Sort the ExMap table by token space GUID index and token number, so that
+        # the PCD driver and PEIM can binary search it.
+        #
+        ExMapTable = sorted(zip(Dict['EXMAPPING_TABLE_GUID_INDEX'], Dict['EXMAPPING_TABLE_EXTOKEN'], Dict['EXMAPPING_TABLE_LOCAL_TOKEN']),
+                            key=lambda Item: (GetIntegerValue(Item[0]), GetIntegerValue(Item[1])))
+        Dict['EXMAPPING_TABLE_GUID_INDEX'] = [Item[0] for Item in ExMapTable]
+        Dict['EXMAPPING_TABLE_EXTOKEN'] = [Item[1] for Item in ExMapTable]
+        Dict['EXMAPPING_TABLE_LOCAL_TOKEN'] = [Item[2] for Item in ExMapTable]
     else:
         Dict['EXMAPPING_TABLE_EXTOKEN'].append('0U')
         Dict['EXMAPPING_TABLE_LOCAL_TOKEN'].append('0U')
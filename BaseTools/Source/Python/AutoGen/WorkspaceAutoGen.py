@@ -108,6 +108,7 @@ class WorkspaceAutoGen(AutoGen):
         #
         # Mark now build in AutoGen Phase
         #
+        self.PreParseMetaFiles()
         #
         # Collect Platform Guids to support Guid name in Fdfparser.
         #
@@ -158,6 +159,17 @@ class WorkspaceAutoGen(AutoGen):
                             ExtraData="Build target [%s] is not supported by the platform. [Valid target: %s]"
                                       % (self.BuildTarget, " ".join(self.Platform.BuildTargets)))
 
+    #
+    # Parse the modules and libraries of the active architectures in parallel
+    #
+    def PreParseMetaFiles(self):
+        FileList = []
+        for Arch in self.ArchList:
+            Platform = self.BuildDatabase[self.MetaFile, Arch, self.BuildTarget, self.ToolChain]
+            FileList.extend(Platform.Modules)
+            FileList.extend(Platform.LibraryInstances)
+        self.BuildDatabase.WorkspaceDb.PreParse(list(OrderedDict.fromkeys(FileList)), GlobalData.gMetaFileParseProcessNumber)
+
     def CollectPlatformGuids(self):
         oriInfList = []
         pkgSet = set()
@@ -103,6 +103,10 @@ gPcdSkuOverrides={}
 gConditionalPcds = []
 
 gUseHashCache = None
+# Directory of the parsed INF and DEC files kept across builds, None if disabled
+gMetaFileCacheDir = None
+# Number of processes parsing the INF and DEC files before AutoGen
+gMetaFileParseProcessNumber = 1
 gBinCacheDest = None
 gBinCacheSource = None
 gPlatformHash = None
@@ -12,6 +12,7 @@
 from __future__ import absolute_import
 import Common.LongFilePathOs as os
 import subprocess
+import threading
 from io import BytesIO
 from struct import *
 from . import FfsFileStatement
@@ -58,6 +59,12 @@ class FV (object):
         self.FvExtEntryTypeValue = []
         self.FvExtEntryType = []
         self.FvExtEntryData = []
+        #
+        # An FV generated without a base address is cached in ImageBinDict, and
+        # may be requested by several threads at once. The lock makes the later
+        # requests wait for the first one to generate it.
+        #
+        self.GenerationLock = threading.RLock()
     ## AddToBuffer()
     #
     #   Generate Fv and add it to the Buffer
@@ -72,6 +79,12 @@ class FV (object):
     #   @retval string      Generated FV file path
     #
     def AddToBuffer (self, Buffer, BaseAddress=None, BlockSize= None, BlockNum=None, ErasePloarity='1',  MacroDict = None, Flag=False):
+        if BaseAddress is not None:
+            return self._AddToBuffer(Buffer, BaseAddress, BlockSize, BlockNum, ErasePloarity, MacroDict, Flag)
+        with self.GenerationLock:
+            return self._AddToBuffer(Buffer, BaseAddress, BlockSize, BlockNum, ErasePloarity, MacroDict, Flag)
+
+    def _AddToBuffer (self, Buffer, BaseAddress, BlockSize, BlockNum, ErasePloarity, MacroDict, Flag):
         if BaseAddress is None and self.UiFvName.upper() + 'fv' in GenFdsGlobalVariable.ImageBinDict:
             return GenFdsGlobalVariable.ImageBinDict[self.UiFvName.upper() + 'fv']
         if MacroDict is None:
@@ -94,7 +107,8 @@ class FV (object):
                                 GenFdsGlobalVariable.ErrorLogger("Capsule %s in FD region can't contain a FV %s in FD region." % (self.CapsuleName, self.UiFvName.upper()))
         if not Flag:
             GenFdsGlobalVariable.InfLogger( "\nGenerating %s FV" %self.UiFvName)
-        GenFdsGlobalVariable.LargeFileInFvFlags.append(False)
+        LargeFileInFvFlags = GenFdsGlobalVariable.GetLargeFileInFvFlags()
+        LargeFileInFvFlags.append(False)
         FFSGuid = None
 
         if self.FvBaseAddress is not None:
@@ -152,7 +166,7 @@ class FV (object):
             OrigFvInfo = None
             if os.path.exists (FvInfoFileName):
                 OrigFvInfo = open(FvInfoFileName, 'r').read()
-            if GenFdsGlobalVariable.LargeFileInFvFlags[-1]:
+            if LargeFileInFvFlags[-1]:
                 FFSGuid = GenFdsGlobalVariable.EFI_FIRMWARE_FILE_SYSTEM3_GUID
             GenFdsGlobalVariable.GenerateFirmwareVolume(
                                     FvOutputFile,
@@ -184,7 +198,7 @@ class FV (object):
                     for FfsFile in self.FfsList:
                         FileName = FfsFile.GenFfs(MacroDict, FvChildAddr, BaseAddress, IsMakefile=Flag, FvName=self.UiFvName)
 
-                    if GenFdsGlobalVariable.LargeFileInFvFlags[-1]:
+                    if LargeFileInFvFlags[-1]:
                         FFSGuid = GenFdsGlobalVariable.EFI_FIRMWARE_FILE_SYSTEM3_GUID;
                     #Update GenFv again
                     GenFdsGlobalVariable.GenerateFirmwareVolume(
@@ -226,7 +240,7 @@ class FV (object):
                         self.FvAlignment = str (FvAlignmentValue)
                     FvFileObj.close()
                     GenFdsGlobalVariable.ImageBinDict[self.UiFvName.upper() + 'fv'] = FvOutputFile
-                    GenFdsGlobalVariable.LargeFileInFvFlags.pop()
+                    LargeFileInFvFlags.pop()
                 else:
                     GenFdsGlobalVariable.ErrorLogger("Invalid FV file %s." % self.UiFvName)
             else:
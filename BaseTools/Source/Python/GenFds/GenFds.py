@@ -18,6 +18,8 @@ from glob import glob
 from struct import unpack
 from linecache import getlines
 from io import BytesIO
+from concurrent.futures import ThreadPoolExecutor
+import threading
 
 import Common.LongFilePathOs as os
 from Common.TargetTxtClassObject import TargetTxtDict,gDefaultTargetTxtFile
@@ -95,7 +97,7 @@ def resetFdsGlobalVariable():
     GenFdsGlobalVariable.ModuleFile = ''
     GenFdsGlobalVariable.EnableGenfdsMultiThread = True
 
-    GenFdsGlobalVariable.LargeFileInFvFlags = []
+    GenFdsGlobalVariable.ThreadState = threading.local()
     GenFdsGlobalVariable.EFI_FIRMWARE_FILE_SYSTEM3_GUID = '5473C07A-3DCB-4dca-BD6F-1E9689E7349A'
     GenFdsGlobalVariable.LARGE_FILE_SIZE = 0x1000000
 
@@ -506,8 +508,16 @@ class GenFds(object):
                 FdObj.GenFd()
                 return
         elif GenFds.OnlyGenerateThisFd is None and GenFds.OnlyGenerateThisFv is None:
-            for FdObj in GenFdsGlobalVariable.FdfParser.Profile.FdDict.values():
-                FdObj.GenFd()
+            #
+            # Generate the FVs that do not depend on the FD layout in the
+            # background, while the FDs are generated.
+            #
+            with ThreadPoolExecutor() as Executor:
+                Futures = [Executor.submit(GenFds.GenFvInBackground, FvObj) for FvObj in GenFds.GetBackgroundFvList()]
+                for FdObj in GenFdsGlobalVariable.FdfParser.Profile.FdDict.values():
+                    FdObj.GenFd()
+                for Future in Futures:
+                    Future.result()
 
         GenFdsGlobalVariable.VerboseLogger("\n Generate other FV images! ")
         if GenFds.OnlyGenerateThisFv is not None and GenFds.OnlyGenerateThisFv.upper() in GenFdsGlobalVariable.FdfParser.Profile.FvDict:
@@ -534,6 +544,92 @@ class GenFds(object):
                 for OptRomObj in GenFdsGlobalVariable.FdfParser.Profile.OptRomDict.values():
                     OptRomObj.AddToBuffer(None)
 
+    ## GenFvInBackground()
+    #
+    #   @param  FvObj               The FV to generate
+    #
+    @staticmethod
+    def GenFvInBackground(FvObj):
+        Buffer = BytesIO()
+        FvObj.AddToBuffer(Buffer)
+        Buffer.close()
+
+    ## GetChildFvNames()
+    #
+    #   Collect the names of the FVs included by an FFS file statement or a section
+    #
+    #   @param  Obj                 The FFS file statement or section
+    #   @param  Names               The set the FV names are added to
+    #
+    @staticmethod
+    def GetChildFvNames(Obj, Names):
+        FvName = getattr(Obj, 'FvName', None)
+        if FvName:
+            Names.add(FvName.upper())
+        for Section in getattr(Obj, 'SectionList', None) or []:
+            GenFds.GetChildFvNames(Section, Names)
+
+    ## GetBackgroundFvList()
+    #
+    #   Get the FVs that can be generated in parallel with the FDs. Those are the
+    #   FVs that neither are, nor contain, an FV placed in an FD region, and whose
+    #   INF and FILE statements appear in no other FV, as the FFS files of those
+    #   would be written by both.
+    #
+    #   @retval list                The FV objects
+    #
+    @staticmethod
+    def GetBackgroundFvList():
+        Profile = GenFdsGlobalVariable.FdfParser.Profile
+        if not GenFdsGlobalVariable.EnableGenfdsMultiThread:
+            return []
+
+        #
+        # The macros defined in an FD apply to the FVs generated for it.
+        #
+        RegionFvSet = set()
+        for FdObj in Profile.FdDict.values():
+            if FdObj.DefineVarDict:
+                return []
+            for RegionObj in FdObj.RegionList:
+                if RegionObj.RegionType == BINARY_FILE_TYPE_FV:
+                    RegionFvSet.update(RegionData.upper() for RegionData in RegionObj.RegionDataList)
+
+        ChildFvDict = {}
+        StatementFvDict = {}
+        for FvName, FvObj in Profile.FvDict.items():
+            ChildFvDict[FvName] = set()
+            for FfsObj in FvObj.FfsList:
+                GenFds.GetChildFvNames(FfsObj, ChildFvDict[FvName])
+                if getattr(FfsObj, 'InfFileName', None):
+                    Statement = os.path.normcase(os.path.normpath(FfsObj.InfFileName))
+                elif getattr(FfsObj, 'NameGuid', None):
+                    Statement = FfsObj.NameGuid.upper()
+                else:
+                    continue
+                StatementFvDict.setdefault(Statement, set()).add(FvName)
+
+        SharedFvSet = set()
+        for FvNameSet in StatementFvDict.values():
+            if len(FvNameSet) > 1:
+                SharedFvSet.update(FvNameSet)
+
+        EligibleDict = {}
+        def IsEligible(FvName, Visiting):
+            if FvName in EligibleDict:
+                return EligibleDict[FvName]
+            if FvName in Visiting or FvName not in ChildFvDict:
+                return False
+            Visiting.add(FvName)
+            Eligible = FvName not in RegionFvSet and FvName not in SharedFvSet
+            for ChildFvName in ChildFvDict[FvName]:
+                Eligible = IsEligible(ChildFvName, Visiting) and Eligible
+            Visiting.discard(FvName)
+            EligibleDict[FvName] = Eligible
+            return Eligible
+
+        return [FvObj for FvName, FvObj in Profile.FvDict.items() if IsEligible(FvName, set())]
+
     @staticmethod
     def GenFfsMakefile(OutputDir, FdfParserObject, WorkSpace, ArchList, GlobalData):
         GenFdsGlobalVariable.SetEnv(FdfParserObject, WorkSpace, ArchList, GlobalData)
@@ -14,6 +14,7 @@ from __future__ import absolute_import
 
 import Common.LongFilePathOs as os
 import sys
+import threading
 from sys import stdout
 from subprocess import PIPE,Popen
 from struct import Struct
@@ -82,8 +83,10 @@ class GenFdsGlobalVariable:
     # and EFI_FIRMWARE_FILE_SYSTEM3_GUID is passed to C GenFv.
     # At the end of generation of FV, pop the flag.
     # List is used as a stack to handle nested FV generation.
+    # Each thread has a stack of its own, as independent FVs may be generated
+    # in parallel, see GetLargeFileInFvFlags().
     #
-    LargeFileInFvFlags = []
+    ThreadState = threading.local()
     EFI_FIRMWARE_FILE_SYSTEM3_GUID = '5473C07A-3DCB-4dca-BD6F-1E9689E7349A'
     LARGE_FILE_SIZE = 0x1000000
 
@@ -92,6 +95,16 @@ class GenFdsGlobalVariable:
     # FvName, FdName, CapName in FDF, Image file name
     ImageBinDict = {}
 
+    ## GetLargeFileInFvFlags
+    #
+    #   @retval list    The LargeFileInFvFlags stack of the calling thread
+    #
+    @staticmethod
+    def GetLargeFileInFvFlags():
+        if not hasattr(GenFdsGlobalVariable.ThreadState, 'LargeFileInFvFlags'):
+            GenFdsGlobalVariable.ThreadState.LargeFileInFvFlags = []
+        return GenFdsGlobalVariable.ThreadState.LargeFileInFvFlags
+
     ## LoadBuildRule
     #
     @staticmethod
@@ -517,9 +530,10 @@ class GenFdsGlobalVariable:
             elif GenFdsGlobalVariable.NeedsUpdate(Output, list(Input) + [CommandFile]):
                 GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "%s needs update because of newer %s" % (Output, Input))
                 GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate section")
+                LargeFileInFvFlags = GenFdsGlobalVariable.GetLargeFileInFvFlags()
                 if (os.path.getsize(Output) >= GenFdsGlobalVariable.LARGE_FILE_SIZE and
-                    GenFdsGlobalVariable.LargeFileInFvFlags):
-                    GenFdsGlobalVariable.LargeFileInFvFlags[-1] = True
+                    LargeFileInFvFlags):
+                    LargeFileInFvFlags[-1] = True
 
     @staticmethod
     def GetAlignment (AlignString):
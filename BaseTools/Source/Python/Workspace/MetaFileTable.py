@@ -10,9 +10,15 @@
 #
 from __future__ import absolute_import
 import uuid
+import hashlib
+import pickle
+import tempfile
+import os
 
 import Common.EdkLogger as EdkLogger
+import Common.GlobalData as GlobalData
 from Common.BuildToolError import FORMAT_INVALID
+from Common.BuildVersion import gBUILD_VERSION
 
 from CommonDataClass.DataClass import MODEL_FILE_DSC, MODEL_FILE_DEC, MODEL_FILE_INF, \
                                       MODEL_FILE_OTHERS
@@ -23,6 +29,13 @@ class MetaFileTable():
     _ID_STEP_ = 1
     _ID_MAX_ = 99999999
 
+    # The content of the table only depends on the meta-file, and can be
+    # kept in GlobalData.gMetaFileCacheDir across builds
+    _CACHEABLE_ = False
+    # Index of the BelongsToItem column, rebased with the ID when loaded
+    _BELONGS_TO_INDEX_ = 7
+    _ParserDigest = None
+
     ## Constructor
     def __init__(self, DB, MetaFile, FileType, Temporary, FromItem=None):
         self.MetaFile = MetaFile
@@ -45,6 +58,86 @@ class MetaFileTable():
         else:
             self.TableName = "_%s_%s" % (FileType, len(DB.TblFile))
 
+        self._CacheFile = None
+        self._FileDigest = None
+        if self._CACHEABLE_ and not Temporary and GlobalData.gMetaFileCacheDir:
+            self.LoadCache()
+
+    ## Get the digest of the tool and of the parser sources
+    #
+    # A cached table is only valid for the parser that produced it.
+    #
+    @staticmethod
+    def _GetParserDigest():
+        if MetaFileTable._ParserDigest is None:
+            Md5 = hashlib.md5(gBUILD_VERSION.encode('utf-8'))
+            for Name in ('MetaFileParser.py', 'MetaFileTable.py'):
+                try:
+                    with open(os.path.join(os.path.dirname(__file__), Name), 'rb') as File:
+                        Md5.update(File.read())
+                except Exception:
+                    pass
+            MetaFileTable._ParserDigest = Md5.hexdigest()
+        return MetaFileTable._ParserDigest
+
+    ## Fill the table from the cache if the meta-file did not change since it was saved
+    def LoadCache(self):
+        try:
+            with open(str(self.MetaFile), 'rb') as File:
+                Md5 = hashlib.md5(File.read())
+            Md5.update(self._GetParserDigest().encode('utf-8'))
+            self._FileDigest = Md5.hexdigest()
+            self._CacheFile = os.path.join(
+                                GlobalData.gMetaFileCacheDir,
+                                hashlib.md5(os.path.normcase(self.MetaFile.Path).encode('utf-8')).hexdigest()
+                                )
+            if not os.path.exists(self._CacheFile):
+                return
+            with open(self._CacheFile, 'rb') as File:
+                Digest, Content = pickle.load(File)
+        except Exception as Exc:
+            EdkLogger.debug(EdkLogger.DEBUG_5, str(Exc))
+            return
+        # The usage check is done while parsing
+        if Digest != self._FileDigest or (GlobalData.gOptions and GlobalData.gOptions.CheckUsage):
+            return
+
+        # The IDs saved are relative to the table
+        Base = self.ID
+        for Row in Content:
+            if Row[0] >= 0:
+                Row[0] += Base
+                self.ID = max(self.ID, Row[0])
+            if Row[self._BELONGS_TO_INDEX_] >= 0:
+                Row[self._BELONGS_TO_INDEX_] += Base
+        self.CurrentContent = Content
+
+    ## Save the table to the cache
+    def SaveCache(self):
+        if not self._CacheFile:
+            return
+        Base = self.FileId * 10**8
+        Content = []
+        for Row in self.CurrentContent:
+            Row = list(Row)
+            if Row[0] >= 0:
+                Row[0] -= Base
+            if Row[self._BELONGS_TO_INDEX_] >= 0:
+                Row[self._BELONGS_TO_INDEX_] -= Base
+            Content.append(Row)
+        #
+        # Several AutoGen processes may parse the same file, so the cache file
+        # is replaced at once with a complete one.
+        #
+        try:
+            os.makedirs(GlobalData.gMetaFileCacheDir, exist_ok=True)
+            Fd, TempFile = tempfile.mkstemp(dir=GlobalData.gMetaFileCacheDir)
+            with os.fdopen(Fd, 'wb') as File:
+                pickle.dump((self._FileDigest, Content), File, pickle.HIGHEST_PROTOCOL)
+            os.replace(TempFile, self._CacheFile)
+        except Exception as Exc:
+            EdkLogger.debug(EdkLogger.DEBUG_5, str(Exc))
+
     def IsIntegrity(self):
         Result = False
         try:
@@ -60,12 +153,15 @@ class MetaFileTable():
 
     def SetEndFlag(self):
         self.CurrentContent.append(self._DUMMY_)
+        if self._CACHEABLE_:
+            self.SaveCache()
 
     def GetAll(self):
         return [item for item in self.CurrentContent if item[0] >= 0 and item[-1]>=0]
 
 ## Python class representation of table storing module data
 class ModuleTable(MetaFileTable):
+    _CACHEABLE_ = True
     _COLUMN_ = '''
         ID REAL PRIMARY KEY,
         Model INTEGER NOT NULL,
@@ -159,6 +255,7 @@ class ModuleTable(MetaFileTable):
 
 ## Python class representation of table storing package data
 class PackageTable(MetaFileTable):
+    _CACHEABLE_ = True
     _COLUMN_ = '''
         ID REAL PRIMARY KEY,
         Model INTEGER NOT NULL,
@@ -14,6 +14,8 @@ from Common.StringUtils import *
 from Common.DataType import *
 from Common.Misc import *
 from types import *
+from Common.MultipleWorkspace import MultipleWorkspace as mws
+import multiprocessing
 
 from .MetaDataTable import *
 from .MetaFileTable import *
@@ -23,6 +25,26 @@ from Workspace.DecBuildData import DecBuildData
 from Workspace.DscBuildData import DscBuildData
 from Workspace.InfBuildData import InfBuildData
 
+## Initialize a process parsing meta-files for WorkspaceDatabase.PreParse()
+def _InitPreParseWorker(Workspace, PackagesPath, GlobalDefines, MetaFileCacheDir):
+    # The errors are reported when the main process parses the file again
+    EdkLogger.SetLevel(EdkLogger.SILENT)
+    mws.setWs(Workspace, PackagesPath)
+    GlobalData.gWorkspace = Workspace
+    GlobalData.gGlobalDefines = GlobalDefines
+    GlobalData.gMetaFileCacheDir = MetaFileCacheDir
+
+## Parse a meta-file in a worker process, the result is saved in the cache
+def _PreParseMetaFile(Args):
+    File, Root, FileType = Args
+    try:
+        MetaFile = PathClass(File, Root)
+        Table = MetaFileStorage(BuildDB, MetaFile, FileType)
+        if not Table.IsIntegrity():
+            WorkspaceDatabase.BuildObjectFactory._FILE_PARSER_[FileType](MetaFile, FileType, None, Table).Start()
+    except BaseException:
+        pass
+
 ## Database
 #
 #   This class defined the build database for all modules, packages and platform.
@@ -147,6 +169,9 @@ class WorkspaceDatabase(object):
     # @param GlobalMacros       Global macros used for replacement during file parsing
     # @param RenewDb=False      Create new database file if it's already there
     #
+    # Below this number of files, starting the processes costs more than parsing
+    _PRE_PARSE_MIN_FILES_ = 16
+
     def __init__(self):
         self.DB = dict()
         # create table for internal uses
@@ -159,6 +184,52 @@ class WorkspaceDatabase(object):
         self.TransformObject = WorkspaceDatabase.TransformObjectFactory(self)
 
 
+    ## Parse meta-files in parallel
+    #
+    #   The INF files are parsed by worker processes, then the DEC files they
+    #   depend on. The results are passed through the meta-file cache, so
+    #   nothing is done if it is disabled.
+    #
+    #   @param  FileList            The INF files to parse
+    #   @param  ProcessNumber       The number of processes to use
+    #
+    def PreParse(self, FileList, ProcessNumber):
+        if not GlobalData.gMetaFileCacheDir or ProcessNumber < 2 or \
+           (GlobalData.gOptions and GlobalData.gOptions.CheckUsage):
+            return
+
+        for FileType in (MODEL_FILE_INF, MODEL_FILE_DEC):
+            TableList = [MetaFileStorage(self, File, FileType) for File in FileList]
+            ParseList = [Table for Table in TableList if not Table.IsIntegrity()]
+            if len(ParseList) >= self._PRE_PARSE_MIN_FILES_:
+                EdkLogger.verbose("Parsing %d meta-files in %d processes" % (len(ParseList), ProcessNumber))
+                Pool = multiprocessing.Pool(
+                         min(ProcessNumber, len(ParseList)),
+                         _InitPreParseWorker,
+                         (GlobalData.gWorkspace, os.pathsep.join(mws.PACKAGES_PATH or []),
+                          GlobalData.gGlobalDefines, GlobalData.gMetaFileCacheDir)
+                         )
+                try:
+                    Pool.map(_PreParseMetaFile, [(Table.MetaFile.File, Table.MetaFile.Root, FileType) for Table in ParseList])
+                finally:
+                    Pool.close()
+                    Pool.join()
+                for Table in ParseList:
+                    if not Table.CurrentContent:
+                        Table.LoadCache()
+
+            if FileType == MODEL_FILE_DEC:
+                break
+            PackageSet = set()
+            for Table in TableList:
+                if Table.IsIntegrity():
+                    PackageSet.update(Record[0] for Record in Table.Query(MODEL_META_DATA_PACKAGE))
+            FileList = []
+            for Package in PackageSet:
+                File = PathClass(NormPath(Package), GlobalData.gWorkspace)
+                if File.Validate('.dec')[0] == 0:
+                    FileList.append(File)
+
     ## Summarize all packages in the database
     def GetPackageList(self, Platform, Arch, TargetName, ToolChainTag):
         self.Platform = Platform
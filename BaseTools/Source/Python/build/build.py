@@ -797,6 +797,8 @@ class Build():
         GlobalData.gDatabasePath = os.path.normpath(os.path.join(GlobalData.gConfDirectory, GlobalData.gDatabasePath))
         if not os.path.exists(os.path.join(GlobalData.gConfDirectory, '.cache')):
             os.makedirs(os.path.join(GlobalData.gConfDirectory, '.cache'))
+        if not BuildOptions.NoMetaFileCache:
+            GlobalData.gMetaFileCacheDir = os.path.join(GlobalData.gConfDirectory, '.cache', 'MetaFile')
         self.Db = BuildDB
         self.BuildDatabase = self.Db.BuildObject
         self.Platform = None
@@ -1014,6 +1016,7 @@ class Build():
         self.ToolChainFamily = ToolChainFamily
 
         self.ThreadNumber   = ThreadNum()
+        GlobalData.gMetaFileParseProcessNumber = self.ThreadNumber
     ## Initialize build configuration
     #
     #   This method will parse DSC file and merge the configurations from
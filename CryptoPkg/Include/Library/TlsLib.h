@@ -90,6 +90,20 @@ TlsNew (
   IN     VOID  *TlsCtx
   );
 
+/**
+  Release a TLS/SSL session reference returned by TlsGetSession().
+
+  If Session is NULL, nothing is done.
+
+  @param[in]  Session    Pointer to the session object to be released.
+
+**/
+VOID
+EFIAPI
+TlsFreeSession (
+  IN     VOID  *Session
+  );
+
 /**
   Checks if the TLS handshake was done.
 
@@ -458,6 +472,29 @@ TlsSetSessionId (
   IN     UINT16  SessionIdLen
   );
 
+/**
+  Sets a previously established TLS/SSL session to be resumed during TLS/SSL connect.
+
+  This function offers a session returned by TlsGetSession() for a new connection
+  to the same server, so that the server may resume it instead of running a full
+  handshake. It must be called before the handshake is started. The TLS object
+  takes its own reference to the session.
+
+  @param[in]  Tls             Pointer to the TLS object.
+  @param[in]  Session         Pointer to the session returned by TlsGetSession().
+
+  @retval  EFI_SUCCESS           The session was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_UNSUPPORTED       The session cannot be used by this TLS object.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsSetSession (
+  IN     VOID  *Tls,
+  IN     VOID  *Session
+  );
+
 /**
   Adds the CA to the cert store when requesting Server or Client authentication.
 
@@ -751,6 +788,25 @@ TlsGetSessionId (
   IN OUT UINT16  *SessionIdLen
   );
 
+/**
+  Gets the TLS/SSL session of the specified TLS connection for later resumption.
+
+  This function returns a reference to the session negotiated by the specified
+  TLS connection, including any session ticket received from the server, if that
+  session can be resumed. The reference must be released with TlsFreeSession().
+
+  @param[in]  Tls    Pointer to the TLS object.
+
+  @return  Pointer to the session object.
+           If the connection has no resumable session, TlsGetSession() returns NULL.
+
+**/
+VOID *
+EFIAPI
+TlsGetSession (
+  IN     VOID  *Tls
+  );
+
 /**
   Gets the client random data used in the specified TLS connection.
 
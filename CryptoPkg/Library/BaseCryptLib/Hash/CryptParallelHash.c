@@ -11,14 +11,68 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define PARALLELHASH_CUSTOMIZATION  "ParallelHash"
 
-UINTN      mBlockNum;
-UINTN      mBlockSize;
-UINTN      mLastBlockSize;
-UINT8      *mInput;
-UINTN      mBlockResultSize;
-UINT8      *mBlockHashResult;
-BOOLEAN    *mBlockIsCompleted;
-SPIN_LOCK  *mSpinLockList;
+UINTN                mBlockNum;
+UINTN                mBlockSize;
+UINTN                mLastBlockSize;
+UINT8                *mInput;
+CONST VOID           **mBlockList;
+CONST UINTN          *mBlockListSize;
+PARALLEL_BLOCK_HASH  mBlockHashFunc;
+UINTN                mBlockResultSize;
+UINT8                *mBlockHashResult;
+BOOLEAN              *mBlockIsCompleted;
+SPIN_LOCK            *mSpinLockList;
+
+/**
+  Computes the CSHAKE-256 digest of one ParallelHash256 block.
+
+  @param[in]   Data        Pointer to the buffer containing the data to be hashed.
+  @param[in]   DataSize    Size of Data buffer in bytes.
+  @param[out]  HashValue   Pointer to a buffer that receives the digest value.
+
+  @retval TRUE   Digest computation succeeded.
+  @retval FALSE  Digest computation failed.
+**/
+BOOLEAN
+EFIAPI
+ParallelHashCShake256Block (
+  IN   CONST VOID  *Data,
+  IN   UINTN       DataSize,
+  OUT  UINT8       *HashValue
+  )
+{
+  return CShake256HashAll (Data, DataSize, mBlockResultSize, NULL, 0, NULL, 0, HashValue);
+}
+
+/**
+  Compute the digest of one block and store it in the block result list.
+
+  The block is either taken from the list of buffers, or it is a BlockSize
+  sized slice of the contiguous input.
+
+  @param[in] Index  Index of the block.
+
+  @retval TRUE   Digest computation succeeded.
+  @retval FALSE  Digest computation failed.
+**/
+BOOLEAN
+HashBlock (
+  IN UINTN  Index
+  )
+{
+  CONST VOID  *Data;
+  UINTN       DataSize;
+
+  if (mBlockList != NULL) {
+    Data     = mBlockList[Index];
+    DataSize = mBlockListSize[Index];
+  } else {
+    Data     = mInput + Index * mBlockSize;
+    DataSize = (Index == (mBlockNum - 1)) ? mLastBlockSize : mBlockSize;
+  }
+
+  return mBlockHashFunc (Data, DataSize, mBlockHashResult + Index * mBlockResultSize);
+}
 
 /**
   Complete computation of digest of each block.
@@ -33,8 +87,7 @@ ParallelHashApExecute (
   IN VOID  *ProcedureArgument
   )
 {
-  UINTN    Index;
-  BOOLEAN  Status;
+  UINTN  Index;
 
   for (Index = 0; Index < mBlockNum; Index++) {
     if (AcquireSpinLockOrFail (&mSpinLockList[Index])) {
@@ -47,19 +100,9 @@ ParallelHashApExecute (
       }
 
       //
-      // Calculate CShake256 for this block.
+      // Calculate digest for this block.
       //
-      Status = CShake256HashAll (
-                 mInput + Index * mBlockSize,
-                 (Index == (mBlockNum - 1)) ? mLastBlockSize : mBlockSize,
-                 mBlockResultSize,
-                 NULL,
-                 0,
-                 NULL,
-                 0,
-                 mBlockHashResult + Index * mBlockResultSize
-                 );
-      if (!EFI_ERROR (Status)) {
+      if (HashBlock (Index)) {
         mBlockIsCompleted[Index] = TRUE;
       }
 
@@ -68,6 +111,122 @@ ParallelHashApExecute (
   }
 }
 
+/**
+  Compute the digests of all mBlockNum blocks on the BSP and all APs.
+
+  The caller sets up the block layout, mBlockHashFunc, mBlockResultSize and the
+  mBlockHashResult buffer, which receives the digests in block order.
+
+  @retval TRUE   All block digests were computed.
+  @retval FALSE  Out of resources.
+**/
+BOOLEAN
+HashAllBlocks (
+  VOID
+  )
+{
+  UINTN    Index;
+  BOOLEAN  AllCompleted;
+  BOOLEAN  ReturnValue;
+
+  mBlockIsCompleted = AllocateZeroPool (mBlockNum * sizeof (BOOLEAN));
+  mSpinLockList     = AllocatePool (mBlockNum * sizeof (SPIN_LOCK));
+  if ((mBlockIsCompleted == NULL) || (mSpinLockList == NULL)) {
+    ReturnValue = FALSE;
+    goto Exit;
+  }
+
+  //
+  // Initialize SpinLock for each result block.
+  //
+  for (Index = 0; Index < mBlockNum; Index++) {
+    InitializeSpinLock (&mSpinLockList[Index]);
+  }
+
+  //
+  // Dispatch blocklist to each AP.
+  //
+  DispatchBlockToAp ();
+
+  //
+  // Wait until all block hash completed.
+  //
+  do {
+    AllCompleted = TRUE;
+    for (Index = 0; Index < mBlockNum; Index++) {
+      if (AcquireSpinLockOrFail (&mSpinLockList[Index])) {
+        if (!mBlockIsCompleted[Index]) {
+          AllCompleted = FALSE;
+          if (HashBlock (Index)) {
+            mBlockIsCompleted[Index] = TRUE;
+          }
+
+          ReleaseSpinLock (&mSpinLockList[Index]);
+          break;
+        }
+
+        ReleaseSpinLock (&mSpinLockList[Index]);
+      } else {
+        AllCompleted = FALSE;
+        break;
+      }
+    }
+  } while (!AllCompleted);
+
+  ReturnValue = TRUE;
+
+Exit:
+  if (mSpinLockList != NULL) {
+    FreePool ((VOID *)mSpinLockList);
+    mSpinLockList = NULL;
+  }
+
+  if (mBlockIsCompleted != NULL) {
+    FreePool (mBlockIsCompleted);
+    mBlockIsCompleted = NULL;
+  }
+
+  return ReturnValue;
+}
+
+/**
+  Retrieve the one-shot hash function and digest size for a hash NID.
+
+  @param[in]   HashNid      The CRYPTO_NID_SHAxxx hash algorithm.
+  @param[out]  HashFunc     The SHA-2 HashAll function of the algorithm.
+  @param[out]  DigestSize   The digest size of the algorithm in bytes.
+
+  @retval TRUE   The algorithm is supported.
+  @retval FALSE  The algorithm is not supported.
+**/
+BOOLEAN
+GetParallelBlockHash (
+  IN  UINTN                HashNid,
+  OUT PARALLEL_BLOCK_HASH  *HashFunc,
+  OUT UINTN                *DigestSize
+  )
+{
+  switch (HashNid) {
+    case CRYPTO_NID_SHA256:
+      *HashFunc   = Sha256HashAll;
+      *DigestSize = SHA256_DIGEST_SIZE;
+      return TRUE;
+
+    case CRYPTO_NID_SHA384:
+      *HashFunc   = Sha384HashAll;
+      *DigestSize = SHA384_DIGEST_SIZE;
+      return TRUE;
+
+    case CRYPTO_NID_SHA512:
+      *HashFunc   = Sha512HashAll;
+      *DigestSize = SHA512_DIGEST_SIZE;
+      return TRUE;
+
+    default:
+      return FALSE;
+  }
+}
+
 /**
   Parallel hash function ParallelHash256, as defined in NIST's Special Publication 800-185,
   published December 2016.
@@ -103,10 +262,8 @@ ParallelHash256HashAll (
   UINTN    EncSizeN;
   UINT8    EncBufL[sizeof (UINTN)+1];
   UINTN    EncSizeL;
-  UINTN    Index;
   UINT8    *CombinedInput;
   UINTN    CombinedInputSize;
-  BOOLEAN  AllCompleted;
   UINTN    Offset;
   BOOLEAN  ReturnValue;
 
@@ -142,15 +299,12 @@ ParallelHash256HashAll (
   EncSizeL = RightEncode (EncBufL, OutputByteLen * CHAR_BIT);
 
   //
-  // Allocate buffer for combined input (newX), Block completed flag and SpinLock.
+  // Allocate buffer for combined input (newX).
   //
   CombinedInputSize = EncSizeB + EncSizeN + EncSizeL + mBlockNum * mBlockResultSize;
   CombinedInput     = AllocateZeroPool (CombinedInputSize);
-  mBlockIsCompleted = AllocateZeroPool (mBlockNum * sizeof (BOOLEAN));
-  mSpinLockList     = AllocatePool (mBlockNum * sizeof (SPIN_LOCK));
-  if ((CombinedInput == NULL) || (mBlockIsCompleted == NULL) || (mSpinLockList == NULL)) {
-    ReturnValue = FALSE;
-    goto Exit;
+  if (CombinedInput == NULL) {
+    return FALSE;
   }
 
   //
@@ -164,54 +318,18 @@ ParallelHash256HashAll (
   mBlockHashResult = CombinedInput + EncSizeB;
   mInput           = (UINT8 *)Input;
   mLastBlockSize   = InputByteLen % mBlockSize == 0 ? mBlockSize : InputByteLen % mBlockSize;
+  mBlockList       = NULL;
+  mBlockListSize   = NULL;
+  mBlockHashFunc   = ParallelHashCShake256Block;
 
   //
-  // Initialize SpinLock for each result block.
+  // Hash each block on the BSP and the APs.
   //
-  for (Index = 0; Index < mBlockNum; Index++) {
-    InitializeSpinLock (&mSpinLockList[Index]);
+  ReturnValue = HashAllBlocks ();
+  if (!ReturnValue) {
+    goto Exit;
   }
 
-  //
-  // Dispatch blocklist to each AP.
-  //
-  DispatchBlockToAp ();
-
-  //
-  // Wait until all block hash completed.
-  //
-  do {
-    AllCompleted = TRUE;
-    for (Index = 0; Index < mBlockNum; Index++) {
-      if (AcquireSpinLockOrFail (&mSpinLockList[Index])) {
-        if (!mBlockIsCompleted[Index]) {
-          AllCompleted = FALSE;
-          ReturnValue  = CShake256HashAll (
-                           mInput + Index * mBlockSize,
-                           (Index == (mBlockNum - 1)) ? mLastBlockSize : mBlockSize,
-                           mBlockResultSize,
-                           NULL,
-                           0,
-                           NULL,
-                           0,
-                           mBlockHashResult + Index * mBlockResultSize
-                           );
-          if (ReturnValue) {
-            mBlockIsCompleted[Index] = TRUE;
-          }
-
-          ReleaseSpinLock (&mSpinLockList[Index]);
-          break;
-        }
-
-        ReleaseSpinLock (&mSpinLockList[Index]);
-      } else {
-        AllCompleted = FALSE;
-        break;
-      }
-    }
-  } while (!AllCompleted);
-
   //
   // Fill LeftEncode(n).
   //
@@ -237,18 +355,144 @@ ParallelHash256HashAll (
 
 Exit:
   ZeroMem (CombinedInput, CombinedInputSize);
+  FreePool (CombinedInput);
 
-  if (CombinedInput != NULL) {
-    FreePool (CombinedInput);
+  return ReturnValue;
+}
+
+/**
+  Computes the SHA-2 digests of multiple data buffers, distributing the buffers
+  across the available processors.
+
+  Each digest is the ordinary SHA-256, SHA-384 or SHA-512 digest of its buffer,
+  as returned by Sha256HashAll(), Sha384HashAll() or Sha512HashAll().
+
+  @param[in]   HashNid       The hash algorithm, CRYPTO_NID_SHA256, CRYPTO_NID_SHA384
+                             or CRYPTO_NID_SHA512.
+  @param[in]   BufferCount   The number(>0) of data buffers.
+  @param[in]   Buffers       Array of BufferCount pointers to the data buffers.
+  @param[in]   BufferSizes   Array of BufferCount data buffer sizes in bytes.
+  @param[out]  HashValues    Pointer to a buffer that receives BufferCount digests,
+                             one after the other in the order of Buffers.
+
+  @retval TRUE   All digests were computed.
+  @retval FALSE  The digests could not be computed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+ParallelMultiHashAll (
+  IN  UINTN        HashNid,
+  IN  UINTN        BufferCount,
+  IN  CONST VOID   **Buffers,
+  IN  CONST UINTN  *BufferSizes,
+  OUT UINT8        *HashValues
+  )
+{
+  UINTN  Index;
+
+  if ((BufferCount == 0) || (Buffers == NULL) || (BufferSizes == NULL) || (HashValues == NULL)) {
+    return FALSE;
   }
 
-  if (mSpinLockList != NULL) {
-    FreePool ((VOID *)mSpinLockList);
+  for (Index = 0; Index < BufferCount; Index++) {
+    if ((Buffers[Index] == NULL) && (BufferSizes[Index] != 0)) {
+      return FALSE;
+    }
   }
 
-  if (mBlockIsCompleted != NULL) {
-    FreePool (mBlockIsCompleted);
+  if (!GetParallelBlockHash (HashNid, &mBlockHashFunc, &mBlockResultSize)) {
+    return FALSE;
+  }
+
+  mBlockNum        = BufferCount;
+  mBlockList       = Buffers;
+  mBlockListSize   = BufferSizes;
+  mBlockHashResult = HashValues;
+
+  return HashAllBlocks ();
+}
+
+/**
+  Computes a SHA-2 tree digest of a large data buffer, hashing the blocks of the
+  buffer on all available processors.
+
+  The input is split into BlockSize sized blocks, the last block may be shorter.
+  Each block is hashed with the selected algorithm, and the tree digest is the digest,
+  with the same algorithm, of the concatenation of all block digests in order,
+  followed by InputByteLen and BlockSize each encoded as a little endian UINT64.
+  The tree digest is not the same as the ordinary digest of the input.
+
+  @param[in]   HashNid        The hash algorithm, CRYPTO_NID_SHA256, CRYPTO_NID_SHA384
+                              or CRYPTO_NID_SHA512.
+  @param[in]   Input          Pointer to the input data.
+  @param[in]   InputByteLen   The number(>0) of input bytes.
+  @param[in]   BlockSize      The size(>0) of each block in bytes.
+  @param[out]  HashValue      Pointer to a buffer that receives the tree digest.
+
+  @retval TRUE   The tree digest was computed.
+  @retval FALSE  The tree digest could not be computed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+ParallelTreeHashAll (
+  IN  UINTN       HashNid,
+  IN  CONST VOID  *Input,
+  IN  UINTN       InputByteLen,
+  IN  UINTN       BlockSize,
+  OUT UINT8       *HashValue
+  )
+{
+  PARALLEL_BLOCK_HASH  HashFunc;
+  UINTN                DigestSize;
+  UINTN                BlockNum;
+  UINT8                *CombinedInput;
+  UINTN                CombinedInputSize;
+  UINT64               Length;
+  BOOLEAN              ReturnValue;
+
+  if ((Input == NULL) || (HashValue == NULL) || (InputByteLen == 0) || (BlockSize == 0)) {
+    return FALSE;
+  }
+
+  if (!GetParallelBlockHash (HashNid, &HashFunc, &DigestSize)) {
+    return FALSE;
   }
 
+  BlockNum = InputByteLen % BlockSize == 0 ? InputByteLen / BlockSize : InputByteLen / BlockSize + 1;
+
+  //
+  // Allocate buffer for the block digests and the encoded lengths.
+  //
+  CombinedInputSize = BlockNum * DigestSize + 2 * sizeof (UINT64);
+  CombinedInput     = AllocateZeroPool (CombinedInputSize);
+  if (CombinedInput == NULL) {
+    return FALSE;
+  }
+
+  mBlockNum        = BlockNum;
+  mBlockSize       = BlockSize;
+  mLastBlockSize   = InputByteLen % BlockSize == 0 ? BlockSize : InputByteLen % BlockSize;
+  mInput           = (UINT8 *)Input;
+  mBlockList       = NULL;
+  mBlockListSize   = NULL;
+  mBlockHashFunc   = HashFunc;
+  mBlockResultSize = DigestSize;
+  mBlockHashResult = CombinedInput;
+
+  ReturnValue = HashAllBlocks ();
+  if (ReturnValue) {
+    Length = InputByteLen;
+    CopyMem (CombinedInput + BlockNum * DigestSize, &Length, sizeof (Length));
+    Length = BlockSize;
+    CopyMem (CombinedInput + BlockNum * DigestSize + sizeof (Length), &Length, sizeof (Length));
+    ReturnValue = HashFunc (CombinedInput, CombinedInputSize, HashValue);
+  }
+
+  FreePool (CombinedInput);
+
   return ReturnValue;
 }
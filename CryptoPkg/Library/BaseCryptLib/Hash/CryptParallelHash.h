@@ -202,6 +202,24 @@ CShake256HashAll (
   OUT  UINT8       *HashValue
   );
 
+/**
+  Computes the digest of one block of data.
+
+  @param[in]   Data        Pointer to the buffer containing the data to be hashed.
+  @param[in]   DataSize    Size of Data buffer in bytes.
+  @param[out]  HashValue   Pointer to a buffer that receives the digest value.
+
+  @retval TRUE   Digest computation succeeded.
+  @retval FALSE  Digest computation failed.
+**/
+typedef
+BOOLEAN
+(EFIAPI *PARALLEL_BLOCK_HASH)(
+  IN   CONST VOID  *Data,
+  IN   UINTN       DataSize,
+  OUT  UINT8       *HashValue
+  );
+
 /**
   Complete computation of digest of each block.
 
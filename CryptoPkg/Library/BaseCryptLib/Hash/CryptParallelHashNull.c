@@ -38,3 +38,69 @@ ParallelHash256HashAll (
   ASSERT (FALSE);
   return FALSE;
 }
+
+/**
+  Computes the SHA-2 digests of multiple data buffers, distributing the buffers
+  across the available processors.
+
+  Each digest is the ordinary SHA-256, SHA-384 or SHA-512 digest of its buffer,
+  as returned by Sha256HashAll(), Sha384HashAll() or Sha512HashAll().
+
+  @param[in]   HashNid       The hash algorithm, CRYPTO_NID_SHA256, CRYPTO_NID_SHA384
+                             or CRYPTO_NID_SHA512.
+  @param[in]   BufferCount   The number(>0) of data buffers.
+  @param[in]   Buffers       Array of BufferCount pointers to the data buffers.
+  @param[in]   BufferSizes   Array of BufferCount data buffer sizes in bytes.
+  @param[out]  HashValues    Pointer to a buffer that receives BufferCount digests,
+                             one after the other in the order of Buffers.
+
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+ParallelMultiHashAll (
+  IN  UINTN        HashNid,
+  IN  UINTN        BufferCount,
+  IN  CONST VOID   **Buffers,
+  IN  CONST UINTN  *BufferSizes,
+  OUT UINT8        *HashValues
+  )
+{
+  ASSERT (FALSE);
+  return FALSE;
+}
+
+/**
+  Computes a SHA-2 tree digest of a large data buffer, hashing the blocks of the
+  buffer on all available processors.
+
+  The input is split into BlockSize sized blocks, the last block may be shorter.
+  Each block is hashed with the selected algorithm, and the tree digest is the digest,
+  with the same algorithm, of the concatenation of all block digests in order,
+  followed by InputByteLen and BlockSize each encoded as a little endian UINT64.
+  The tree digest is not the same as the ordinary digest of the input.
+
+  @param[in]   HashNid        The hash algorithm, CRYPTO_NID_SHA256, CRYPTO_NID_SHA384
+                              or CRYPTO_NID_SHA512.
+  @param[in]   Input          Pointer to the input data.
+  @param[in]   InputByteLen   The number(>0) of input bytes.
+  @param[in]   BlockSize      The size(>0) of each block in bytes.
+  @param[out]  HashValue      Pointer to a buffer that receives the tree digest.
+
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+ParallelTreeHashAll (
+  IN  UINTN       HashNid,
+  IN  CONST VOID  *Input,
+  IN  UINTN       InputByteLen,
+  IN  UINTN       BlockSize,
+  OUT UINT8       *HashValue
+  )
+{
+  ASSERT (FALSE);
+  return FALSE;
+}
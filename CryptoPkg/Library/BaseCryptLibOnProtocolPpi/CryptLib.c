@@ -902,6 +902,74 @@ ParallelHash256HashAll (
   CALL_CRYPTO_SERVICE (ParallelHash256HashAll, (Input, InputByteLen, BlockSize, Output, OutputByteLen, Customization, CustomByteLen), FALSE);
 }
 
+/**
+  Computes the SHA-2 digests of multiple data buffers, distributing the buffers
+  across the available processors.
+
+  Each digest is the ordinary SHA-256, SHA-384 or SHA-512 digest of its buffer,
+  as returned by Sha256HashAll(), Sha384HashAll() or Sha512HashAll().
+
+  @param[in]   HashNid       The hash algorithm, CRYPTO_NID_SHA256, CRYPTO_NID_SHA384
+                             or CRYPTO_NID_SHA512.
+  @param[in]   BufferCount   The number(>0) of data buffers.
+  @param[in]   Buffers       Array of BufferCount pointers to the data buffers.
+  @param[in]   BufferSizes   Array of BufferCount data buffer sizes in bytes.
+  @param[out]  HashValues    Pointer to a buffer that receives BufferCount digests,
+                             one after the other in the order of Buffers.
+
+  @retval TRUE   All digests were computed.
+  @retval FALSE  The digests could not be computed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+ParallelMultiHashAll (
+  IN  UINTN        HashNid,
+  IN  UINTN        BufferCount,
+  IN  CONST VOID   **Buffers,
+  IN  CONST UINTN  *BufferSizes,
+  OUT UINT8        *HashValues
+  )
+{
+  CALL_CRYPTO_SERVICE (ParallelMultiHashAll, (HashNid, BufferCount, Buffers, BufferSizes, HashValues), FALSE);
+}
+
+/**
+  Computes a SHA-2 tree digest of a large data buffer, hashing the blocks of the
+  buffer on all available processors.
+
+  The input is split into BlockSize sized blocks, the last block may be shorter.
+  Each block is hashed with the selected algorithm, and the tree digest is the digest,
+  with the same algorithm, of the concatenation of all block digests in order,
+  followed by InputByteLen and BlockSize each encoded as a little endian UINT64.
+  The tree digest is not the same as the ordinary digest of the input.
+
+  @param[in]   HashNid        The hash algorithm, CRYPTO_NID_SHA256, CRYPTO_NID_SHA384
+                              or CRYPTO_NID_SHA512.
+  @param[in]   Input          Pointer to the input data.
+  @param[in]   InputByteLen   The number(>0) of input bytes.
+  @param[in]   BlockSize      The size(>0) of each block in bytes.
+  @param[out]  HashValue      Pointer to a buffer that receives the tree digest.
+
+  @retval TRUE   The tree digest was computed.
+  @retval FALSE  The tree digest could not be computed.
+  @retval FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+ParallelTreeHashAll (
+  IN  UINTN       HashNid,
+  IN  CONST VOID  *Input,
+  IN  UINTN       InputByteLen,
+  IN  UINTN       BlockSize,
+  OUT UINT8       *HashValue
+  )
+{
+  CALL_CRYPTO_SERVICE (ParallelTreeHashAll, (HashNid, Input, InputByteLen, BlockSize, HashValue), FALSE);
+}
+
 /**
   Retrieves the size, in bytes, of the context buffer required for SM3 hash operations.
 
@@ -3753,6 +3821,23 @@ TlsFree (
   CALL_VOID_CRYPTO_SERVICE (TlsFree, (Tls));
 }
 
+/**
+  Release a TLS/SSL session reference returned by TlsGetSession().
+
+  If Session is NULL, nothing is done.
+
+  @param[in]  Session    Pointer to the session object to be released.
+
+**/
+VOID
+EFIAPI
+TlsFreeSession (
+  IN     VOID  *Session
+  )
+{
+  CALL_VOID_CRYPTO_SERVICE (TlsFreeSession, (Session));
+}
+
 /**
   Create a new TLS object for a connection.
 
@@ -4191,6 +4276,32 @@ TlsSetSessionId (
   CALL_CRYPTO_SERVICE (TlsSetSessionId, (Tls, SessionId, SessionIdLen), EFI_UNSUPPORTED);
 }
 
+/**
+  Sets a previously established TLS/SSL session to be resumed during TLS/SSL connect.
+
+  This function offers a session returned by TlsGetSession() for a new connection
+  to the same server, so that the server may resume it instead of running a full
+  handshake. It must be called before the handshake is started. The TLS object
+  takes its own reference to the session.
+
+  @param[in]  Tls             Pointer to the TLS object.
+  @param[in]  Session         Pointer to the session returned by TlsGetSession().
+
+  @retval  EFI_SUCCESS           The session was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_UNSUPPORTED       The session cannot be used by this TLS object.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsSetSession (
+  IN     VOID  *Tls,
+  IN     VOID  *Session
+  )
+{
+  CALL_CRYPTO_SERVICE (TlsSetSession, (Tls, Session), EFI_UNSUPPORTED);
+}
+
 /**
   Adds the CA to the cert store when requesting Server or Client authentication.
 
@@ -4523,6 +4634,28 @@ TlsGetSessionId (
   CALL_CRYPTO_SERVICE (TlsGetSessionId, (Tls, SessionId, SessionIdLen), EFI_UNSUPPORTED);
 }
 
+/**
+  Gets the TLS/SSL session of the specified TLS connection for later resumption.
+
+  This function returns a reference to the session negotiated by the specified
+  TLS connection, including any session ticket received from the server, if that
+  session can be resumed. The reference must be released with TlsFreeSession().
+
+  @param[in]  Tls    Pointer to the TLS object.
+
+  @return  Pointer to the session object.
+           If the connection has no resumable session, TlsGetSession() returns NULL.
+
+**/
+VOID *
+EFIAPI
+TlsGetSession (
+  IN     VOID  *Tls
+  )
+{
+  CALL_CRYPTO_SERVICE (TlsGetSession, (Tls), NULL);
+}
+
 /**
   Gets the client random data used in the specified TLS connection.
 
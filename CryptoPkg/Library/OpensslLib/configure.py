@@ -352,6 +352,7 @@ def main():
             inf = 'OpensslLibAccel.inf'
             hdr = 'configuration-noec.h'
         sources = {}
+        cryptosources = {}
         defines = {}
         for asm in [ 'UEFI-IA32-MSFT', 'UEFI-IA32-GCC',
                      'UEFI-X64-MSFT', 'UEFI-X64-GCC',
@@ -370,6 +371,7 @@ def main():
             sources[archcc] = list(map(lambda x: f'{x} | {cc}', filter(is_asm, srclist)))
             update_MSFT_asm_format(archcc, sources[archcc])
             sources[arch] = list(filter(lambda x: not is_asm(x), srclist))
+            cryptosources[arch] = list(filter(lambda x: not is_asm(x), libcrypto_sources(cfg, archcc)))
             defines[arch] = cfg['unified_info']['defines']['libcrypto']
             defines[arch] = list(filter(asm_filter_fn, defines[arch]))
 
@@ -380,6 +382,16 @@ def main():
         aarch64accel = sources['AARCH64'] + sources['AARCH64-GCC']
         update_inf(inf, aarch64accel, 'AARCH64', defines['AARCH64'])
 
+        if not ec:
+            # libssl only adds C sources, the asm files are shared
+            inf = 'OpensslLibCryptoAccel.inf'
+            ia32accel = cryptosources['IA32'] + sources['IA32-MSFT'] + sources['IA32-GCC']
+            x64accel = cryptosources['X64'] + sources['X64-MSFT'] + sources['X64-GCC']
+            update_inf(inf, ia32accel, 'IA32', defines['IA32'])
+            update_inf(inf, x64accel, 'X64', defines['X64'])
+            aarch64accel = cryptosources['AARCH64'] + sources['AARCH64-GCC']
+            update_inf(inf, aarch64accel, 'AARCH64', defines['AARCH64'])
+
     # noaccel - ec enabled
     openssl_configure(openssldir, 'UEFI', ec = True);
     cfg = get_configdata(openssldir)
@@ -595,6 +595,44 @@ TlsSetSessionId (
   return EFI_SUCCESS;
 }
 
+/**
+  Sets a previously established TLS/SSL session to be resumed during TLS/SSL connect.
+
+  This function offers a session returned by TlsGetSession() for a new connection
+  to the same server, so that the server may resume it instead of running a full
+  handshake. It must be called before the handshake is started. The TLS object
+  takes its own reference to the session.
+
+  @param[in]  Tls             Pointer to the TLS object.
+  @param[in]  Session         Pointer to the session returned by TlsGetSession().
+
+  @retval  EFI_SUCCESS           The session was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_UNSUPPORTED       The session cannot be used by this TLS object.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsSetSession (
+  IN     VOID  *Tls,
+  IN     VOID  *Session
+  )
+{
+  TLS_CONNECTION  *TlsConn;
+
+  TlsConn = (TLS_CONNECTION *)Tls;
+
+  if ((TlsConn == NULL) || (TlsConn->Ssl == NULL) || (Session == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (SSL_set_session (TlsConn->Ssl, (SSL_SESSION *)Session) != 1) {
+    return EFI_UNSUPPORTED;
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Adds the CA to the cert store when requesting Server or Client authentication.
 
@@ -1308,6 +1346,43 @@ TlsGetSessionId (
   return EFI_SUCCESS;
 }
 
+/**
+  Gets the TLS/SSL session of the specified TLS connection for later resumption.
+
+  This function returns a reference to the session negotiated by the specified
+  TLS connection, including any session ticket received from the server, if that
+  session can be resumed. The reference must be released with TlsFreeSession().
+
+  @param[in]  Tls    Pointer to the TLS object.
+
+  @return  Pointer to the session object.
+           If the connection has no resumable session, TlsGetSession() returns NULL.
+
+**/
+VOID *
+EFIAPI
+TlsGetSession (
+  IN     VOID  *Tls
+  )
+{
+  TLS_CONNECTION  *TlsConn;
+  SSL_SESSION     *Session;
+
+  TlsConn = (TLS_CONNECTION *)Tls;
+
+  if ((TlsConn == NULL) || (TlsConn->Ssl == NULL)) {
+    return NULL;
+  }
+
+  Session = SSL_get1_session (TlsConn->Ssl);
+  if ((Session != NULL) && (SSL_SESSION_is_resumable (Session) != 1)) {
+    SSL_SESSION_free (Session);
+    Session = NULL;
+  }
+
+  return Session;
+}
+
 /**
   Gets the client random data used in the specified TLS connection.
 
@@ -181,6 +181,33 @@ TlsSetSessionId (
   return EFI_UNSUPPORTED;
 }
 
+/**
+  Sets a previously established TLS/SSL session to be resumed during TLS/SSL connect.
+
+  This function offers a session returned by TlsGetSession() for a new connection
+  to the same server, so that the server may resume it instead of running a full
+  handshake. It must be called before the handshake is started. The TLS object
+  takes its own reference to the session.
+
+  @param[in]  Tls             Pointer to the TLS object.
+  @param[in]  Session         Pointer to the session returned by TlsGetSession().
+
+  @retval  EFI_SUCCESS           The session was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_UNSUPPORTED       The session cannot be used by this TLS object.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsSetSession (
+  IN     VOID  *Tls,
+  IN     VOID  *Session
+  )
+{
+  ASSERT (FALSE);
+  return EFI_UNSUPPORTED;
+}
+
 /**
   Adds the CA to the cert store when requesting Server or Client authentication.
 
@@ -526,6 +553,29 @@ TlsGetSessionId (
   return EFI_UNSUPPORTED;
 }
 
+/**
+  Gets the TLS/SSL session of the specified TLS connection for later resumption.
+
+  This function returns a reference to the session negotiated by the specified
+  TLS connection, including any session ticket received from the server, if that
+  session can be resumed. The reference must be released with TlsFreeSession().
+
+  @param[in]  Tls    Pointer to the TLS object.
+
+  @return  Pointer to the session object.
+           If the connection has no resumable session, TlsGetSession() returns NULL.
+
+**/
+VOID *
+EFIAPI
+TlsGetSession (
+  IN     VOID  *Tls
+  )
+{
+  ASSERT (FALSE);
+  return NULL;
+}
+
 /**
   Gets the client random data used in the specified TLS connection.
 
@@ -86,6 +86,23 @@ TlsFree (
   ASSERT (FALSE);
 }
 
+/**
+  Release a TLS/SSL session reference returned by TlsGetSession().
+
+  If Session is NULL, nothing is done.
+
+  @param[in]  Session    Pointer to the session object to be released.
+
+**/
+VOID
+EFIAPI
+TlsFreeSession (
+  IN     VOID  *Session
+  )
+{
+  ASSERT (FALSE);
+}
+
 /**
   Create a new TLS object for a connection.
 
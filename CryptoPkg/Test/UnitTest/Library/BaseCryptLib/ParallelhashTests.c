@@ -135,11 +135,93 @@ TestVerifyParallelHash256HashAll (
   return EFI_SUCCESS;
 }
 
+UNIT_TEST_STATUS
+EFIAPI
+TestVerifyParallelMultiHashAll (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  BOOLEAN     Status;
+  CONST VOID  *Buffers[3];
+  UINTN       BufferSizes[3];
+  UINT8       Output[3 * SHA384_DIGEST_SIZE];
+  UINT8       Expected[SHA384_DIGEST_SIZE];
+  UINTN       Index;
+
+  Buffers[0]     = InputSample1;
+  BufferSizes[0] = InputSample1ByteLen;
+  Buffers[1]     = InputSample3;
+  BufferSizes[1] = InputSample3ByteLen;
+  Buffers[2]     = InputSample3 + BlockSizeSample3;
+  BufferSizes[2] = BlockSizeSample3;
+
+  //
+  // Each digest must match the ordinary SHA-384 digest of its buffer.
+  //
+  Status = ParallelMultiHashAll (CRYPTO_NID_SHA384, ARRAY_SIZE (Buffers), Buffers, BufferSizes, Output);
+  UT_ASSERT_TRUE (Status);
+
+  for (Index = 0; Index < ARRAY_SIZE (Buffers); Index++) {
+    Status = Sha384HashAll (Buffers[Index], BufferSizes[Index], Expected);
+    UT_ASSERT_TRUE (Status);
+    UT_ASSERT_MEM_EQUAL (Output + Index * SHA384_DIGEST_SIZE, Expected, SHA384_DIGEST_SIZE);
+  }
+
+  return EFI_SUCCESS;
+}
+
+UNIT_TEST_STATUS
+EFIAPI
+TestVerifyParallelTreeHashAll (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  BOOLEAN  Status;
+  UINT8    Output[SHA256_DIGEST_SIZE];
+  UINT8    Expected[SHA256_DIGEST_SIZE];
+  UINT8    Leaves[7 * SHA256_DIGEST_SIZE + 2 * sizeof (UINT64)];
+  UINT64   Length;
+  UINTN    Index;
+
+  //
+  // 72 bytes in blocks of 11 bytes: six full blocks and one of 6 bytes.
+  //
+  for (Index = 0; Index < 7; Index++) {
+    Status = Sha256HashAll (
+               InputSample3 + Index * 11,
+               (Index == 6) ? 6 : 11,
+               Leaves + Index * SHA256_DIGEST_SIZE
+               );
+    UT_ASSERT_TRUE (Status);
+  }
+
+  Length = InputSample3ByteLen;
+  CopyMem (Leaves + 7 * SHA256_DIGEST_SIZE, &Length, sizeof (Length));
+  Length = 11;
+  CopyMem (Leaves + 7 * SHA256_DIGEST_SIZE + sizeof (Length), &Length, sizeof (Length));
+  Status = Sha256HashAll (Leaves, sizeof (Leaves), Expected);
+  UT_ASSERT_TRUE (Status);
+
+  Status = ParallelTreeHashAll (CRYPTO_NID_SHA256, InputSample3, InputSample3ByteLen, 11, Output);
+  UT_ASSERT_TRUE (Status);
+  UT_ASSERT_MEM_EQUAL (Output, Expected, SHA256_DIGEST_SIZE);
+
+  //
+  // Unsupported algorithm.
+  //
+  Status = ParallelTreeHashAll (CRYPTO_NID_NULL, InputSample3, InputSample3ByteLen, 11, Output);
+  UT_ASSERT_FALSE (Status);
+
+  return EFI_SUCCESS;
+}
+
 TEST_DESC  mParallelhashTest[] = {
   //
   // -----Description------------------------------Class----------------------Function-----------------Pre---Post--Context
   //
   { "TestVerifyParallelHash256HashAll()", "CryptoPkg.BaseCryptLib.ParallelHash256HashAll", TestVerifyParallelHash256HashAll, NULL, NULL, NULL },
+  { "TestVerifyParallelMultiHashAll()",   "CryptoPkg.BaseCryptLib.ParallelMultiHashAll",   TestVerifyParallelMultiHashAll,   NULL, NULL, NULL },
+  { "TestVerifyParallelTreeHashAll()",    "CryptoPkg.BaseCryptLib.ParallelTreeHashAll",    TestVerifyParallelTreeHashAll,    NULL, NULL, NULL },
 };
 
 UINTN  mParallelhashTestNum = ARRAY_SIZE (mParallelhashTest);
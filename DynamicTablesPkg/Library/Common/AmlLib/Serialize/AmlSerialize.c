@@ -190,29 +190,17 @@ AmlSerializeTree (
     return EFI_INVALID_PARAMETER;
   }
 
-  // Compute the total size of the AML blob.
-  Status = AmlComputeSize (
-             (CONST AML_NODE_HEADER *)RootNode,
-             &TableSize
-             );
-  if (EFI_ERROR (Status)) {
-    ASSERT (0);
-    return Status;
-  }
-
-  // Add the size of the ACPI header.
-  TableSize += (UINT32)sizeof (EFI_ACPI_DESCRIPTION_HEADER);
-
-  // Check the size against the SDT header.
   // The Length field in the SDT Header is updated if the tree has
-  // been modified.
-  if (TableSize != RootNode->SdtHeader->Length) {
+  // been modified, so the size of the table is known without walking
+  // the tree. Whether the nodes add up to it is checked while writing.
+  TableSize = RootNode->SdtHeader->Length;
+  if (TableSize < sizeof (EFI_ACPI_DESCRIPTION_HEADER)) {
     ASSERT (0);
     return EFI_INVALID_PARAMETER;
   }
 
   // Buffer is not big enough, or NULL.
-  if ((TableSize < *BufferSize) || (Buffer == NULL)) {
+  if ((*BufferSize < TableSize) || (Buffer == NULL)) {
     *BufferSize = TableSize;
     return EFI_SUCCESS;
   }
@@ -252,6 +240,13 @@ AmlSerializeTree (
     return Status;
   }
 
+  // A tree larger than the SDT header Length overflows the stream above,
+  // a smaller one leaves the end of the table unwritten.
+  if (AmlStreamGetIndex (&FStream) != TableSize) {
+    ASSERT (0);
+    return EFI_INVALID_PARAMETER;
+  }
+
   // Update the checksum.
   return AcpiPlatformChecksum ((EFI_ACPI_DESCRIPTION_HEADER *)Buffer);
 }
@@ -9,6 +9,7 @@
 
 #include <Library/BaseLib.h>
 #include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
 #include <Library/UefiDriverEntryPoint.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/HobLib.h>
@@ -20,7 +21,207 @@
 
 #include <Protocol/FdtClient.h>
 
-STATIC VOID  *mDeviceTreeBase;
+//
+// Finding a node by compatible string or by phandle means walking the whole
+// device tree, and drivers look up dozens of nodes that way. The lookups are
+// served from sorted indexes built with a single walk of the tree instead.
+// Updating the tree may move nodes and properties around, so the indexes are
+// discarded when that happens, and built again on the next lookup.
+//
+typedef struct {
+  CONST CHAR8    *Compatible;
+  INT32          Node;
+} COMPATIBLE_INDEX_ENTRY;
+
+typedef struct {
+  UINT32    Phandle;
+  INT32     Node;
+} PHANDLE_INDEX_ENTRY;
+
+STATIC VOID                    *mDeviceTreeBase;
+STATIC BOOLEAN                 mIndexValid;
+STATIC COMPATIBLE_INDEX_ENTRY  *mCompatibleIndex;
+STATIC UINTN                   mCompatibleIndexCount;
+STATIC PHANDLE_INDEX_ENTRY     *mPhandleIndex;
+STATIC UINTN                   mPhandleIndexCount;
+
+STATIC
+BOOLEAN
+IsNodeEnabled (
+  INT32  Node
+  );
+
+STATIC
+VOID
+InvalidateIndex (
+  VOID
+  )
+{
+  if (mCompatibleIndex != NULL) {
+    FreePool (mCompatibleIndex);
+    mCompatibleIndex = NULL;
+  }
+
+  if (mPhandleIndex != NULL) {
+    FreePool (mPhandleIndex);
+    mPhandleIndex = NULL;
+  }
+
+  mCompatibleIndexCount = 0;
+  mPhandleIndexCount    = 0;
+  mIndexValid           = FALSE;
+}
+
+STATIC
+INTN
+EFIAPI
+CompareCompatibleIndexEntry (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  CONST COMPATIBLE_INDEX_ENTRY  *Entry1;
+  CONST COMPATIBLE_INDEX_ENTRY  *Entry2;
+  INTN                          Result;
+
+  Entry1 = Buffer1;
+  Entry2 = Buffer2;
+
+  Result = AsciiStrCmp (Entry1->Compatible, Entry2->Compatible);
+  if (Result != 0) {
+    return Result;
+  }
+
+  return (Entry1->Node < Entry2->Node) ? -1 : (Entry1->Node > Entry2->Node);
+}
+
+STATIC
+INTN
+EFIAPI
+ComparePhandleIndexEntry (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  CONST PHANDLE_INDEX_ENTRY  *Entry1;
+  CONST PHANDLE_INDEX_ENTRY  *Entry2;
+
+  Entry1 = Buffer1;
+  Entry2 = Buffer2;
+
+  return (Entry1->Phandle < Entry2->Phandle) ? -1 : (Entry1->Phandle > Entry2->Phandle);
+}
+
+/**
+  Walk the device tree and index the compatible strings of the enabled nodes
+  and the phandles of all nodes.
+
+  If the indexes cannot be allocated, mIndexValid is left FALSE and the
+  lookups fall back to walking the tree.
+**/
+STATIC
+VOID
+BuildIndex (
+  VOID
+  )
+{
+  INT32                   Node;
+  CONST CHAR8             *Type;
+  CONST CHAR8             *Compatible;
+  INT32                   Len;
+  UINT32                  Phandle;
+  UINTN                   CompatibleCount;
+  UINTN                   PhandleCount;
+  BOOLEAN                 Fill;
+  COMPATIBLE_INDEX_ENTRY  CompatibleScratch;
+  PHANDLE_INDEX_ENTRY     PhandleScratch;
+
+  InvalidateIndex ();
+
+  //
+  // The first pass counts the entries, the second one fills them in.
+  //
+  for (Fill = FALSE; ; Fill = TRUE) {
+    CompatibleCount = 0;
+    PhandleCount    = 0;
+
+    //
+    // Starting from -1 includes the root node, like fdt_next_node () does.
+    //
+    for (Node = fdt_next_node (mDeviceTreeBase, -1, NULL);
+         Node >= 0;
+         Node = fdt_next_node (mDeviceTreeBase, Node, NULL))
+    {
+      Phandle = fdt_get_phandle (mDeviceTreeBase, Node);
+      if ((Phandle != 0) && (Phandle != MAX_UINT32)) {
+        if (Fill) {
+          mPhandleIndex[PhandleCount].Phandle = Phandle;
+          mPhandleIndex[PhandleCount].Node    = Node;
+        }
+
+        PhandleCount++;
+      }
+
+      if (!IsNodeEnabled (Node)) {
+        continue;
+      }
+
+      Type = fdt_getprop (mDeviceTreeBase, Node, "compatible", &Len);
+      if (Type == NULL) {
+        continue;
+      }
+
+      for (Compatible = Type; Compatible < Type + Len && *Compatible;
+           Compatible += 1 + AsciiStrLen (Compatible))
+      {
+        if (Fill) {
+          mCompatibleIndex[CompatibleCount].Compatible = Compatible;
+          mCompatibleIndex[CompatibleCount].Node       = Node;
+        }
+
+        CompatibleCount++;
+      }
+    }
+
+    if (Fill) {
+      break;
+    }
+
+    mCompatibleIndex = AllocatePool (MAX (CompatibleCount, 1) * sizeof (COMPATIBLE_INDEX_ENTRY));
+    mPhandleIndex    = AllocatePool (MAX (PhandleCount, 1) * sizeof (PHANDLE_INDEX_ENTRY));
+    if ((mCompatibleIndex == NULL) || (mPhandleIndex == NULL)) {
+      InvalidateIndex ();
+      return;
+    }
+  }
+
+  QuickSort (
+    mCompatibleIndex,
+    CompatibleCount,
+    sizeof (COMPATIBLE_INDEX_ENTRY),
+    CompareCompatibleIndexEntry,
+    &CompatibleScratch
+    );
+  QuickSort (
+    mPhandleIndex,
+    PhandleCount,
+    sizeof (PHANDLE_INDEX_ENTRY),
+    ComparePhandleIndexEntry,
+    &PhandleScratch
+    );
+
+  mCompatibleIndexCount = CompatibleCount;
+  mPhandleIndexCount    = PhandleCount;
+  mIndexValid           = TRUE;
+
+  DEBUG ((
+    DEBUG_VERBOSE,
+    "%a: %Lu compatible strings, %Lu phandles\n",
+    __func__,
+    (UINT64)CompatibleCount,
+    (UINT64)PhandleCount
+    ));
+}
 
 STATIC
 EFI_STATUS
@@ -70,6 +271,8 @@ SetNodeProperty (
     return EFI_DEVICE_ERROR;
   }
 
+  InvalidateIndex ();
+
   return EFI_SUCCESS;
 }
 
@@ -116,10 +319,42 @@ FindNextCompatibleNode (
   INT32        Prev, Next;
   CONST CHAR8  *Type, *Compatible;
   INT32        Len;
+  UINTN        Low, High, Mid;
+  INTN         Result;
 
   ASSERT (mDeviceTreeBase != NULL);
   ASSERT (Node != NULL);
 
+  if (!mIndexValid) {
+    BuildIndex ();
+  }
+
+  if (mIndexValid) {
+    //
+    // Find the first entry for CompatibleString past PrevNode.
+    //
+    Low  = 0;
+    High = mCompatibleIndexCount;
+    while (Low < High) {
+      Mid    = Low + (High - Low) / 2;
+      Result = AsciiStrCmp (mCompatibleIndex[Mid].Compatible, CompatibleString);
+      if ((Result < 0) || ((Result == 0) && (mCompatibleIndex[Mid].Node <= PrevNode))) {
+        Low = Mid + 1;
+      } else {
+        High = Mid;
+      }
+    }
+
+    if ((Low < mCompatibleIndexCount) &&
+        (AsciiStrCmp (mCompatibleIndex[Low].Compatible, CompatibleString) == 0))
+    {
+      *Node = mCompatibleIndex[Low].Node;
+      return EFI_SUCCESS;
+    }
+
+    return EFI_NOT_FOUND;
+  }
+
   for (Prev = PrevNode; ; Prev = Next) {
     Next = fdt_next_node (mDeviceTreeBase, Prev, NULL);
     if (Next < 0) {
@@ -343,6 +578,7 @@ GetOrInsertChosenNode (
   NewNode = fdt_path_offset (mDeviceTreeBase, "/chosen");
   if (NewNode < 0) {
     NewNode = fdt_add_subnode (mDeviceTreeBase, 0, "/chosen");
+    InvalidateIndex ();
   }
 
   if (NewNode < 0) {
@@ -354,6 +590,54 @@ GetOrInsertChosenNode (
   return EFI_SUCCESS;
 }
 
+STATIC
+EFI_STATUS
+EFIAPI
+FindNodeByPhandle (
+  IN  FDT_CLIENT_PROTOCOL  *This,
+  IN  UINT32               Phandle,
+  OUT INT32                *Node
+  )
+{
+  UINTN  Low, High, Mid;
+  INT32  NewNode;
+
+  ASSERT (mDeviceTreeBase != NULL);
+  ASSERT (Node != NULL);
+
+  if (!mIndexValid) {
+    BuildIndex ();
+  }
+
+  if (!mIndexValid) {
+    NewNode = fdt_node_offset_by_phandle (mDeviceTreeBase, Phandle);
+    if (NewNode < 0) {
+      return EFI_NOT_FOUND;
+    }
+
+    *Node = NewNode;
+    return EFI_SUCCESS;
+  }
+
+  Low  = 0;
+  High = mPhandleIndexCount;
+  while (Low < High) {
+    Mid = Low + (High - Low) / 2;
+    if (mPhandleIndex[Mid].Phandle < Phandle) {
+      Low = Mid + 1;
+    } else {
+      High = Mid;
+    }
+  }
+
+  if ((Low < mPhandleIndexCount) && (mPhandleIndex[Low].Phandle == Phandle)) {
+    *Node = mPhandleIndex[Low].Node;
+    return EFI_SUCCESS;
+  }
+
+  return EFI_NOT_FOUND;
+}
+
 STATIC FDT_CLIENT_PROTOCOL  mFdtClientProtocol = {
   GetNodeProperty,
   SetNodeProperty,
@@ -364,6 +648,7 @@ STATIC FDT_CLIENT_PROTOCOL  mFdtClientProtocol = {
   FindMemoryNodeReg,
   FindNextMemoryNodeReg,
   GetOrInsertChosenNode,
+  FindNodeByPhandle,
 };
 
 STATIC
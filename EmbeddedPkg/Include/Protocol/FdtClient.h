@@ -109,6 +109,18 @@ EFI_STATUS
   OUT INT32                   *Node
   );
 
+//
+// Phandle is the value of the 'phandle' property, or of a phandle cell in a
+// property referencing the node, converted to CPU byte order.
+//
+typedef
+EFI_STATUS
+(EFIAPI *FDT_CLIENT_FIND_NODE_BY_PHANDLE)(
+  IN  FDT_CLIENT_PROTOCOL     *This,
+  IN  UINT32                  Phandle,
+  OUT INT32                   *Node
+  );
+
 struct _FDT_CLIENT_PROTOCOL {
   FDT_CLIENT_GET_NODE_PROPERTY                GetNodeProperty;
   FDT_CLIENT_SET_NODE_PROPERTY                SetNodeProperty;
@@ -122,6 +134,8 @@ struct _FDT_CLIENT_PROTOCOL {
   FDT_CLIENT_FIND_NEXT_MEMORY_NODE_REG        FindNextMemoryNodeReg;
 
   FDT_CLIENT_GET_OR_INSERT_CHOSEN_NODE        GetOrInsertChosenNode;
+
+  FDT_CLIENT_FIND_NODE_BY_PHANDLE             FindNodeByPhandle;
 };
 
 extern EFI_GUID  gFdtClientProtocolGuid;
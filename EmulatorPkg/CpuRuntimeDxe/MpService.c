@@ -37,6 +37,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include "CpuDriver.h"
 
+//
+// Number of times an AP polls for a new procedure without sleeping after it
+// finished one
+//
+#define AP_BUSY_POLL_COUNT  100000
+
 MP_SYSTEM_DATA             gMPSystem;
 EMU_THREAD_THUNK_PROTOCOL  *gThread = NULL;
 EFI_EVENT                  gReadToBootEvent;
@@ -1225,9 +1231,11 @@ CpuDriverApIdolLoop (
   VOID                  *Parameter;
   UINTN                 ProcessorNumber;
   PROCESSOR_DATA_BLOCK  *ProcessorData;
+  UINTN                 IdlePolls;
 
   ProcessorNumber = (UINTN)Context;
   ProcessorData   = &gMPSystem.ProcessorData[ProcessorNumber];
+  IdlePolls       = AP_BUSY_POLL_COUNT;
 
   ProcessorData->Info.ProcessorId = gThread->Self ();
 
@@ -1254,11 +1262,22 @@ CpuDriverApIdolLoop (
       gThread->MutexLock (ProcessorData->StateLock);
       ProcessorData->State = CPU_STATE_FINISHED;
       gThread->MutexUnlock (ProcessorData->StateLock);
+
+      IdlePolls = 0;
     }
 
-    // Poll 5 times a seconds, 200ms
-    // Don't want to burn too many system resources doing nothing.
-    gEmuThunk->Sleep (200 * 1000);
+    //
+    // Parallel code usually hands out work again right after the previous
+    // procedure finished, so keep polling without sleeping for a while.
+    // After that poll every 200us, as a sleeping thread needs a full host
+    // scheduler round trip to pick up new work.
+    //
+    if (IdlePolls < AP_BUSY_POLL_COUNT) {
+      IdlePolls++;
+      CpuPause ();
+    } else {
+      gEmuThunk->Sleep (200 * 1000);
+    }
   }
 
   return 0;
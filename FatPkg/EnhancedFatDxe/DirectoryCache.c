@@ -37,6 +37,7 @@ FatFreeODir (
     FatFreeDirEnt (DirEnt);
   }
 
+  FatFreeHashTable (ODir);
   FreePool (ODir);
 }
 
@@ -63,6 +64,10 @@ FatAllocateODir (
     ODir->Signature = FAT_ODIR_SIGNATURE;
     InitializeListHead (&ODir->ChildList);
     ODir->CurrentCursor = &ODir->ChildList;
+    if (EFI_ERROR (FatCreateHashTable (ODir))) {
+      FreePool (ODir);
+      ODir = NULL;
+    }
   }
 
   return ODir;
@@ -72,6 +77,8 @@ FatAllocateODir (
 
   Discard the directory structure when an OFile will be freed.
   Volume will cache this directory if the OFile does not represent a deleted file.
+  Up to PcdFatDirectoryCacheCount directories are cached, and the least recently
+  used one is replaced when the cache is full.
 
   @param  OFile                 - The OFile whose directory structure is to be discarded.
 
@@ -93,7 +100,7 @@ FatDiscardODir (
     //
     ODir->DirCacheTag = OFile->FileCluster;
     InsertHeadList (&Volume->DirCacheList, &ODir->DirCacheLink);
-    if (Volume->DirCacheCount == FAT_MAX_DIR_CACHE_COUNT) {
+    if (Volume->DirCacheCount >= PcdGet32 (PcdFatDirectoryCacheCount)) {
       //
       // Replace the least recent used directory
       //
@@ -149,6 +156,7 @@ FatRequestODir (
     if (CurrentODir->DirCacheTag == DirCacheTag) {
       RemoveEntryList (&CurrentODir->DirCacheLink);
       Volume->DirCacheCount--;
+      Volume->DirCacheHits++;
       ODir = CurrentODir;
       break;
     }
@@ -158,6 +166,7 @@ FatRequestODir (
     //
     // This directory is not cached, then allocate a new one
     //
+    Volume->DirCacheMisses++;
     ODir = FatAllocateODir (OFile);
   }
 
@@ -178,6 +187,13 @@ FatCleanupODirCache (
 {
   FAT_ODIR  *ODir;
 
+  DEBUG ((
+    DEBUG_INFO,
+    "FatCleanupODirCache: %Lu directory cache hits, %Lu misses\n",
+    (UINT64)Volume->DirCacheHits,
+    (UINT64)Volume->DirCacheMisses
+    ));
+
   while (Volume->DirCacheCount > 0) {
     ODir = ODIR_FROM_DIRCACHELINK (Volume->DirCacheList.BackLink);
     RemoveEntryList (&ODir->DirCacheLink);
@@ -352,10 +352,94 @@ FatExchangeCachePage (
   return EFI_SUCCESS;
 }
 
+/**
+
+  Load a run of consecutive cache pages from the disk with a single request.
+
+  The first page is the one described by CacheTag; the following pages are read
+  ahead into the neighbouring groups. The run is clipped so that it does not wrap
+  around the cache, does not pass the limit of the cache range, and stops before
+  any group which holds dirty data or already caches the page it would receive.
+
+  @param  Volume                - FAT file system volume.
+  @param  DataType              - Indicate the cache type.
+  @param  CacheTag              - The Cache Tag for the first cache page.
+  @param  PageCount             - The requested number of pages.
+
+  @retval EFI_SUCCESS           - The cache pages are loaded successfully.
+  @return Others                - An error occurred when reading the cache pages.
+
+**/
+STATIC
+EFI_STATUS
+FatReadCachePages (
+  IN FAT_VOLUME       *Volume,
+  IN CACHE_DATA_TYPE  DataType,
+  IN CACHE_TAG        *CacheTag,
+  IN UINTN            PageCount
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Index;
+  UINTN       GroupNo;
+  UINTN       PageNo;
+  UINTN       PageSize;
+  UINTN       ReadSize;
+  UINT64      EntryPos;
+  UINT64      MaxSize;
+  DISK_CACHE  *DiskCache;
+  CACHE_TAG   *Tag;
+  UINT8       PageAlignment;
+
+  DiskCache     = &Volume->DiskCache[DataType];
+  PageNo        = CacheTag->PageNo;
+  GroupNo       = PageNo & DiskCache->GroupMask;
+  PageAlignment = DiskCache->PageAlignment;
+  PageSize      = (UINTN)1 << PageAlignment;
+  EntryPos      = DiskCache->BaseAddress + LShiftU64 (PageNo, PageAlignment);
+
+  if (PageCount > DiskCache->GroupMask + 1 - GroupNo) {
+    PageCount = DiskCache->GroupMask + 1 - GroupNo;
+  }
+
+  for (Index = 1; Index < PageCount; Index++) {
+    Tag = &DiskCache->CacheTag[GroupNo + Index];
+    if ((Tag->RealSize > 0) && (Tag->Dirty || (Tag->PageNo == PageNo + Index))) {
+      break;
+    }
+  }
+
+  ReadSize = Index << PageAlignment;
+  MaxSize  = DiskCache->LimitAddress - EntryPos;
+  if (MaxSize < ReadSize) {
+    ReadSize = (UINTN)MaxSize;
+  }
+
+  Status = FatDiskIo (Volume, ReadDisk, EntryPos, ReadSize, DiskCache->CacheBase + (GroupNo << PageAlignment), NULL);
+  if (EFI_ERROR (Status)) {
+    CacheTag->RealSize = 0;
+    return Status;
+  }
+
+  for (Index = 0; ReadSize > 0; Index++) {
+    Tag         = &DiskCache->CacheTag[GroupNo + Index];
+    Tag->PageNo = PageNo + Index;
+    ClearCacheTagDirtyState (Tag);
+    Tag->RealSize = ReadSize < PageSize ? ReadSize : PageSize;
+    ReadSize     -= Tag->RealSize;
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
 
   Get one cache page by specified PageNo.
 
+  A cache miss which directly follows the previously accessed page is taken as
+  sequential access, and doubles the number of pages read ahead on the miss, up
+  to FAT_CACHE_READ_AHEAD_MAX_PAGES. Any other miss resets the read-ahead window.
+
   @param  Volume                - FAT file system volume.
   @param  CacheDataType         - The cache type: CACHE_FAT or CACHE_DATA.
   @param  PageNo                - PageNo to match with the cache.
@@ -376,6 +460,12 @@ FatGetCachePage (
 {
   EFI_STATUS  Status;
   UINTN       OldPageNo;
+  DISK_CACHE  *DiskCache;
+  BOOLEAN     Sequential;
+
+  DiskCache             = &Volume->DiskCache[CacheDataType];
+  Sequential            = (BOOLEAN)(PageNo == DiskCache->LastPageNo + 1);
+  DiskCache->LastPageNo = PageNo;
 
   OldPageNo = CacheTag->PageNo;
   if ((CacheTag->RealSize > 0) && (OldPageNo == PageNo)) {
@@ -396,10 +486,20 @@ FatGetCachePage (
   }
 
   //
-  // Load new data from disk;
+  // Load new data from disk, reading ahead when the access is sequential
   //
+  if (!Sequential) {
+    DiskCache->ReadAheadPages = 1;
+  } else if (DiskCache->ReadAheadPages < FAT_CACHE_READ_AHEAD_MAX_PAGES) {
+    DiskCache->ReadAheadPages <<= 1;
+  }
+
   CacheTag->PageNo = PageNo;
-  Status           = FatExchangeCachePage (Volume, CacheDataType, ReadDisk, CacheTag, NULL);
+  if (DiskCache->ReadAheadPages > 1) {
+    Status = FatReadCachePages (Volume, CacheDataType, CacheTag, DiskCache->ReadAheadPages);
+  } else {
+    Status = FatExchangeCachePage (Volume, CacheDataType, ReadDisk, CacheTag, NULL);
+  }
 
   return Status;
 }
@@ -460,6 +560,54 @@ FatAccessUnalignedCachePage (
   return Status;
 }
 
+/**
+
+  Write the dirty Data cache pages in a range of pages back to the disk.
+
+  A non-blocking read of the range only completes after FatAccessCache() has
+  returned, so the dirty pages cannot be copied over the data read from the
+  disk as FatFlushDataCacheRange() does for a blocking read; the disk must
+  hold them before the read is queued.
+
+  @param  Volume                - FAT file system volume.
+  @param  StartPageNo           - First PageNo to be checked in the cache.
+  @param  EndPageNo             - Last PageNo to be checked in the cache.
+
+  @retval EFI_SUCCESS           - No page of the range is dirty any more.
+  @return Others                - An error occurred when writing a page back.
+
+**/
+STATIC
+EFI_STATUS
+FatWriteBackDataCacheRange (
+  IN FAT_VOLUME  *Volume,
+  IN UINTN       StartPageNo,
+  IN UINTN       EndPageNo
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       PageNo;
+  DISK_CACHE  *DiskCache;
+  CACHE_TAG   *CacheTag;
+
+  DiskCache = &Volume->DiskCache[CacheData];
+  if (!DiskCache->Dirty) {
+    return EFI_SUCCESS;
+  }
+
+  for (PageNo = StartPageNo; PageNo < EndPageNo; PageNo++) {
+    CacheTag = &DiskCache->CacheTag[PageNo & DiskCache->GroupMask];
+    if ((CacheTag->RealSize > 0) && (CacheTag->PageNo == PageNo) && CacheTag->Dirty) {
+      Status = FatExchangeCachePage (Volume, CacheData, WriteDisk, CacheTag, NULL);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
 
   Read BufferSize bytes from the position of Offset into Buffer,
@@ -550,6 +698,13 @@ FatAccessCache (
     //
     ASSERT (CacheDataType == CacheData);
 
+    if ((Task != NULL) && (IoMode == ReadDisk)) {
+      Status = FatWriteBackDataCacheRange (Volume, PageNo, OverRunPageNo);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+    }
+
     EntryPos    = Volume->RootPos + LShiftU64 (PageNo, PageAlignment);
     AlignedSize = AlignedPageCount << PageAlignment;
     Status      = FatDiskIo (Volume, IoMode, EntryPos, AlignedSize, Buffer, Task);
@@ -562,8 +717,9 @@ FatAccessCache (
     // to be updated.
     //
     FatFlushDataCacheRange (Volume, IoMode, PageNo, OverRunPageNo, Buffer);
-    Buffer     += AlignedSize;
-    BufferSize -= AlignedSize;
+    DiskCache->LastPageNo = OverRunPageNo - 1;
+    Buffer               += AlignedSize;
+    BufferSize           -= AlignedSize;
   }
 
   //
@@ -670,14 +826,16 @@ FatInitializeDiskCache (
     DiskCache[CacheData].PageAlignment = FAT_DATACACHE_PAGE_MAX_ALIGNMENT;
   }
 
-  DiskCache[CacheData].GroupMask    = FAT_DATACACHE_GROUP_COUNT - 1;
-  DiskCache[CacheData].BaseAddress  = Volume->RootPos;
-  DiskCache[CacheData].LimitAddress = Volume->VolumeSize;
-  DiskCache[CacheFat].GroupMask     = FatCacheGroupCount - 1;
-  DiskCache[CacheFat].BaseAddress   = Volume->FatPos;
-  DiskCache[CacheFat].LimitAddress  = Volume->FatPos + Volume->FatSize;
-  FatCacheSize                      = FatCacheGroupCount << DiskCache[CacheFat].PageAlignment;
-  DataCacheSize                     = FAT_DATACACHE_GROUP_COUNT << DiskCache[CacheData].PageAlignment;
+  DiskCache[CacheData].GroupMask      = FAT_DATACACHE_GROUP_COUNT - 1;
+  DiskCache[CacheData].BaseAddress    = Volume->RootPos;
+  DiskCache[CacheData].LimitAddress   = Volume->VolumeSize;
+  DiskCache[CacheData].ReadAheadPages = 1;
+  DiskCache[CacheFat].GroupMask       = FatCacheGroupCount - 1;
+  DiskCache[CacheFat].BaseAddress     = Volume->FatPos;
+  DiskCache[CacheFat].LimitAddress    = Volume->FatPos + Volume->FatSize;
+  DiskCache[CacheFat].ReadAheadPages  = 1;
+  FatCacheSize                        = FatCacheGroupCount << DiskCache[CacheFat].PageAlignment;
+  DataCacheSize                       = FAT_DATACACHE_GROUP_COUNT << DiskCache[CacheData].PageAlignment;
   //
   // Allocate the Fat Cache buffer
   //
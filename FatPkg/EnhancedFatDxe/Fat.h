@@ -84,6 +84,13 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define FAT_FATCACHE_GROUP_MIN_COUNT      1
 #define FAT_FATCACHE_GROUP_MAX_COUNT      16
 
+//
+// Upper bound of the adaptive read-ahead window, in cache pages. The window
+// starts at one page and doubles on every cache miss that continues a
+// sequential access pattern.
+//
+#define FAT_CACHE_READ_AHEAD_MAX_PAGES  16
+
 // For cache block bits, use a UINT64
 typedef UINT64 DIRTY_BLOCKS;
 #define BITS_PER_BYTE         8
@@ -116,8 +123,13 @@ STATIC_ASSERT ((((1 << FAT_DATACACHE_PAGE_MAX_ALIGNMENT) / (1 << MIN_BLOCK_ALIGN
 #define LC_ISO_639_2_ENTRY_SIZE  3
 #define MAX_LANG_CODE_SIZE       100
 
-#define FAT_MAX_DIR_CACHE_COUNT  8
 #define FAT_MAX_DIRENTRY_COUNT   0xFFFF
+
+//
+// Initial and maximum number of entries in the extent map of an OFile
+//
+#define FAT_EXTENT_MAP_MIN_COUNT  16
+#define FAT_EXTENT_MAP_MAX_COUNT  4096
 typedef CHAR8 LC_ISO_639_2;
 
 //
@@ -170,14 +182,18 @@ typedef struct {
   BOOLEAN      Dirty;
   UINT8        PageAlignment;
   UINTN        GroupMask;
+  UINTN        LastPageNo;
+  UINTN        ReadAheadPages;
   CACHE_TAG    CacheTag[FAT_DATACACHE_GROUP_COUNT];
 } DISK_CACHE;
 
 //
-// Hash table size
+// Hash table size. The tables of a directory start small and double
+// whenever the average chain grows longer than HASH_TABLE_LOAD_FACTOR.
 //
-#define HASH_TABLE_SIZE  0x400
-#define HASH_TABLE_MASK  (HASH_TABLE_SIZE - 1)
+#define HASH_TABLE_MIN_SIZE     0x40
+#define HASH_TABLE_MAX_SIZE     0x4000
+#define HASH_TABLE_LOAD_FACTOR  2
 
 //
 // The directory entry for opened directory
@@ -210,8 +226,10 @@ struct _FAT_ODIR {
   BOOLEAN       EndOfDir;                     // Indicate whether we have reached the end of the directory
   LIST_ENTRY    DirCacheLink;                 // Linked in Volume->DirCacheList when discarded
   UINTN         DirCacheTag;                  // The identification of the directory when in directory cache
-  FAT_DIRENT    *LongNameHashTable[HASH_TABLE_SIZE];
-  FAT_DIRENT    *ShortNameHashTable[HASH_TABLE_SIZE];
+  FAT_DIRENT    **LongNameHashTable;          // Long name hash table, HashTableMask + 1 entries
+  FAT_DIRENT    **ShortNameHashTable;         // Short name hash table, HashTableMask + 1 entries
+  UINT32        HashTableMask;                // Mask applied to the hash values
+  UINTN         HashEntryCount;               // Number of directory entries in the hash tables
 };
 
 typedef struct {
@@ -243,6 +261,15 @@ typedef struct {
   LIST_ENTRY            Link;
 } FAT_SUBTASK;
 
+//
+// A run of consecutive clusters of a file
+//
+typedef struct {
+  UINTN    FileCluster;           // Index of the first cluster of the run in the file
+  UINTN    Cluster;               // First disk cluster of the run
+  UINTN    Length;                // Number of clusters in the run
+} FAT_EXTENT;
+
 //
 // FAT_OFILE - Each opened file
 //
@@ -286,6 +313,14 @@ struct _FAT_OFILE {
   UINT64        PosDisk;        // on the disk
   UINTN         PosRem;         // remaining in this disk run
   //
+  // The cluster runs of the file, built lazily from the FAT
+  // as the file is accessed
+  //
+  FAT_EXTENT    *Extents;
+  UINTN         ExtentCount;
+  UINTN         ExtentMax;
+  BOOLEAN       ExtentMapComplete; // the map holds the whole cluster chain
+  //
   // The opened parent, full path length and currently opened child files
   //
   FAT_OFILE     *Parent;
@@ -349,6 +384,8 @@ struct _FAT_VOLUME {
   FAT_INFO_SECTOR                    FatInfoSector;  // Free cluster info
   UINTN                              FreeInfoPos;    // Pos with the free cluster info
   BOOLEAN                            FreeInfoValid;  // If free cluster info is valid
+  UINT8                              *FreeBitmap;    // One bit per cluster, set if free
+  BOOLEAN                            FreeBitmapValid;
   //
   // Unpacked Fat BPB info
   //
@@ -383,6 +420,8 @@ struct _FAT_VOLUME {
   //
   LIST_ENTRY                         DirCacheList;
   UINTN                              DirCacheCount;
+  UINTN                              DirCacheHits;
+  UINTN                              DirCacheMisses;
 
   //
   // Disk Cache for this volume
@@ -975,6 +1014,18 @@ FatComputeFreeInfo (
   IN FAT_VOLUME  *Volume
   );
 
+/**
+
+  Free the extent map of the open file.
+
+  @param  OFile                 - The open file.
+
+**/
+VOID
+FatFreeExtentMap (
+  IN FAT_OFILE  *OFile
+  );
+
 //
 // Init.c
 //
@@ -1783,6 +1834,33 @@ FatSetVolumeEntry (
 // Hash.c
 //
 
+/**
+
+  Allocate the initial hash tables of the directory.
+
+  @param  ODir                  - The directory.
+
+  @retval EFI_SUCCESS           - The hash tables are allocated successfully.
+  @retval EFI_OUT_OF_RESOURCES  - Not enough memory to allocate the hash tables.
+
+**/
+EFI_STATUS
+FatCreateHashTable (
+  IN FAT_ODIR  *ODir
+  );
+
+/**
+
+  Free the hash tables of the directory.
+
+  @param  ODir                  - The directory.
+
+**/
+VOID
+FatFreeHashTable (
+  IN FAT_ODIR  *ODir
+  );
+
 /**
 
   Search the long name hash table for the directory entry.
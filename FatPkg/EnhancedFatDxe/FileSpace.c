@@ -167,6 +167,17 @@ FatSetFatEntry (
     }
   }
 
+  //
+  // Keep the free cluster bitmap in sync with the FAT
+  //
+  if (Volume->FreeBitmapValid && (Index <= Volume->MaxCluster + 1)) {
+    if (Value == FAT_CLUSTER_FREE) {
+      Volume->FreeBitmap[Index / 8] |= (UINT8)(1 << (Index % 8));
+    } else {
+      Volume->FreeBitmap[Index / 8] &= (UINT8)~(1 << (Index % 8));
+    }
+  }
+
   //
   // Make sure the entry is in memory
   //
@@ -259,10 +270,57 @@ FatFreeClusters (
   return EFI_SUCCESS;
 }
 
+/**
+
+  Find the first free cluster at or after Start in the free cluster bitmap.
+
+  @param  Volume                - FAT file system volume.
+  @param  Start                 - The cluster to start the search from.
+
+  @return The index of the free cluster, or a value larger than the maximum
+          cluster number if there is no free cluster left.
+
+**/
+STATIC
+UINTN
+FatFindFreeCluster (
+  IN FAT_VOLUME  *Volume,
+  IN UINTN       Start
+  )
+{
+  UINTN  Cluster;
+  UINTN  Limit;
+
+  Cluster = Start;
+  Limit   = Volume->MaxCluster + 1;
+  while (Cluster <= Limit) {
+    //
+    // Skip over whole bytes of allocated clusters
+    //
+    if (((Cluster % 8) == 0) && (Volume->FreeBitmap[Cluster / 8] == 0)) {
+      Cluster += 8;
+      continue;
+    }
+
+    if ((Volume->FreeBitmap[Cluster / 8] & (1 << (Cluster % 8))) != 0) {
+      break;
+    }
+
+    Cluster++;
+  }
+
+  return Cluster;
+}
+
 /**
 
   Allocate a free cluster and return the cluster index.
 
+  The search is done in the free cluster bitmap if one was built by
+  FatComputeFreeInfo(); otherwise the FAT entries are read one by one.
+  On FAT12 and FAT16 volumes the FAT is small, so the bitmap is built
+  on the first allocation.
+
   @param  Volume                - FAT file system volume.
 
   @return The index of the free cluster
@@ -283,6 +341,20 @@ FatAllocateCluster (
     return (UINTN)FAT_CLUSTER_LAST;
   }
 
+  if (!Volume->FreeInfoValid && (Volume->FatType != Fat32)) {
+    FatComputeFreeInfo (Volume);
+  }
+
+  if (Volume->FreeBitmapValid) {
+    Cluster = FatFindFreeCluster (Volume, Volume->FatInfoSector.FreeInfo.NextCluster);
+    if (Cluster > Volume->MaxCluster + 1) {
+      return (UINTN)FAT_CLUSTER_LAST;
+    }
+
+    Volume->FatInfoSector.FreeInfo.NextCluster = (UINT32)(Cluster + 1);
+    return Cluster;
+  }
+
   for ( ; ;) {
     //
     // If the end of the list, return no available cluster
@@ -399,6 +471,12 @@ FatShrinkEof (
     OFile->FileCluster = FAT_CLUSTER_FREE;
   }
 
+  //
+  // The tail of the cluster chain is released, rebuild the extent map on demand
+  //
+  OFile->ExtentCount       = 0;
+  OFile->ExtentMapComplete = FALSE;
+
   //
   // Set CurrentCluster == FileCluster
   // to force a recalculation of Position related stuffs
@@ -489,9 +567,11 @@ FatGrowEof (
     }
 
     //
-    // Loop until we've allocated enough space
+    // Loop until we've allocated enough space. The new clusters are
+    // appended to the extent map when it is next extended.
     //
-    LastCluster = OFile->FileLastCluster;
+    LastCluster              = OFile->FileLastCluster;
+    OFile->ExtentMapComplete = FALSE;
 
     while (CurSize < NewSize) {
       NewCluster = FatAllocateCluster (Volume);
@@ -545,11 +625,203 @@ Done:
   return Status;
 }
 
+/**
+
+  Extend the extent map of the open file until it covers the cluster with
+  index ClusterIndex in the file, or until the end of the cluster chain.
+
+  @param  OFile                 - The open file.
+  @param  ClusterIndex          - The index of the cluster in the file to be covered.
+
+  @retval EFI_SUCCESS           - The extent map is extended successfully.
+  @retval EFI_OUT_OF_RESOURCES  - The extent map cannot grow any further.
+  @retval EFI_VOLUME_CORRUPTED  - Cluster chain corrupt.
+
+**/
+STATIC
+EFI_STATUS
+FatExtendExtentMap (
+  IN FAT_OFILE  *OFile,
+  IN UINTN      ClusterIndex
+  )
+{
+  FAT_VOLUME  *Volume;
+  FAT_EXTENT  *Extent;
+  FAT_EXTENT  *Extents;
+  UINTN       FileCluster;
+  UINTN       Cluster;
+  UINTN       NewMax;
+
+  Volume = OFile->Volume;
+  Extent = NULL;
+  if (OFile->ExtentCount == 0) {
+    FileCluster = 0;
+    Cluster     = OFile->FileCluster;
+  } else {
+    Extent      = &OFile->Extents[OFile->ExtentCount - 1];
+    FileCluster = Extent->FileCluster + Extent->Length;
+    Cluster     = FatGetFatEntry (Volume, Extent->Cluster + Extent->Length - 1);
+  }
+
+  while (!OFile->ExtentMapComplete && (FileCluster <= ClusterIndex)) {
+    if (FAT_END_OF_FAT_CHAIN (Cluster) || ((Extent == NULL) && (Cluster == FAT_CLUSTER_FREE))) {
+      OFile->ExtentMapComplete = TRUE;
+      break;
+    }
+
+    if ((Cluster < FAT_MIN_CLUSTER) || (Cluster > Volume->MaxCluster + 1)) {
+      DEBUG ((DEBUG_INIT | DEBUG_ERROR, "FatExtendExtentMap: cluster chain corrupt\n"));
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    if ((Extent != NULL) && (Cluster == Extent->Cluster + Extent->Length)) {
+      Extent->Length++;
+    } else {
+      if (OFile->ExtentCount == OFile->ExtentMax) {
+        if (OFile->ExtentMax >= FAT_EXTENT_MAP_MAX_COUNT) {
+          return EFI_OUT_OF_RESOURCES;
+        }
+
+        NewMax  = (OFile->ExtentMax == 0) ? FAT_EXTENT_MAP_MIN_COUNT : OFile->ExtentMax * 2;
+        Extents = ReallocatePool (
+                    OFile->ExtentMax * sizeof (FAT_EXTENT),
+                    NewMax * sizeof (FAT_EXTENT),
+                    OFile->Extents
+                    );
+        if (Extents == NULL) {
+          return EFI_OUT_OF_RESOURCES;
+        }
+
+        OFile->Extents   = Extents;
+        OFile->ExtentMax = NewMax;
+      }
+
+      Extent              = &OFile->Extents[OFile->ExtentCount++];
+      Extent->FileCluster = FileCluster;
+      Extent->Cluster     = Cluster;
+      Extent->Length      = 1;
+    }
+
+    FileCluster++;
+    Cluster = FatGetFatEntry (Volume, Cluster);
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+
+  Seek OFile to requested position with the extent map of the file, and
+  calculate the number of consecutive bytes from the position on the disk.
+
+  @param  OFile                 - The open file.
+  @param  Position              - The file's position which will be accessed.
+  @param  PosLimit              - The maximum length current reading/writing may access
+  @param  Run                   - The number of consecutive bytes from the position.
+
+  @retval EFI_SUCCESS           - The position is found in the extent map.
+  @retval EFI_NOT_FOUND         - The extent map cannot cover the position.
+  @retval EFI_VOLUME_CORRUPTED  - Cluster chain corrupt.
+
+**/
+STATIC
+EFI_STATUS
+FatLookupExtentMap (
+  IN  FAT_OFILE  *OFile,
+  IN  UINTN      Position,
+  IN  UINTN      PosLimit,
+  OUT UINTN      *Run
+  )
+{
+  FAT_VOLUME  *Volume;
+  FAT_EXTENT  *Extent;
+  EFI_STATUS  Status;
+  UINTN       ClusterIndex;
+  UINTN       Cluster;
+  UINTN       Low;
+  UINTN       High;
+  UINTN       Middle;
+
+  Volume       = OFile->Volume;
+  ClusterIndex = Position >> Volume->ClusterAlignment;
+
+  //
+  // Map all the clusters the access may touch, so that the run is not
+  // clipped at the end of the map
+  //
+  Status = FatExtendExtentMap (OFile, (Position + MAX (PosLimit, 1) - 1) >> Volume->ClusterAlignment);
+  if (EFI_ERROR (Status) && (Status != EFI_OUT_OF_RESOURCES)) {
+    return Status;
+  }
+
+  //
+  // Binary search the extent holding the position
+  //
+  Low  = 0;
+  High = OFile->ExtentCount;
+  while (Low < High) {
+    Middle = (Low + High) / 2;
+    Extent = &OFile->Extents[Middle];
+    if (Extent->FileCluster + Extent->Length <= ClusterIndex) {
+      Low = Middle + 1;
+    } else {
+      High = Middle;
+    }
+  }
+
+  if (Low == OFile->ExtentCount) {
+    if (OFile->ExtentMapComplete) {
+      DEBUG ((DEBUG_INIT | DEBUG_ERROR, "FatLookupExtentMap: cluster chain shorter than file\n"));
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    return EFI_NOT_FOUND;
+  }
+
+  Extent  = &OFile->Extents[Low];
+  Cluster = Extent->Cluster + ClusterIndex - Extent->FileCluster;
+
+  OFile->PosDisk = Volume->FirstClusterPos +
+                   LShiftU64 (Cluster - FAT_MIN_CLUSTER, Volume->ClusterAlignment) +
+                   (Position & (Volume->ClusterSize - 1));
+  OFile->FileCurrentCluster = Cluster;
+  OFile->Position           = ClusterIndex << Volume->ClusterAlignment;
+
+  *Run = ((Extent->FileCluster + Extent->Length) << Volume->ClusterAlignment) - Position;
+  return EFI_SUCCESS;
+}
+
+/**
+
+  Free the extent map of the open file.
+
+  @param  OFile                 - The open file.
+
+**/
+VOID
+FatFreeExtentMap (
+  IN FAT_OFILE  *OFile
+  )
+{
+  if (OFile->Extents != NULL) {
+    FreePool (OFile->Extents);
+    OFile->Extents = NULL;
+  }
+
+  OFile->ExtentCount       = 0;
+  OFile->ExtentMax         = 0;
+  OFile->ExtentMapComplete = FALSE;
+}
+
 /**
 
   Seek OFile to requested position, and calculate the number of
   consecutive clusters from the position in the file
 
+  The position is looked up in the extent map of the file, which is extended
+  from the FAT as needed; the cluster chain is only walked directly when the
+  extent map cannot grow any further.
+
   @param  OFile                 - The open file.
   @param  Position              - The file's position which will be accessed.
   @param  PosLimit              - The maximum length current reading/writing may access
@@ -566,6 +838,7 @@ FatOFilePosition (
   )
 {
   FAT_VOLUME  *Volume;
+  EFI_STATUS  Status;
   UINTN       ClusterSize;
   UINTN       Cluster;
   UINTN       StartPos;
@@ -585,7 +858,20 @@ FatOFilePosition (
     Run            = OFile->FileSize - Position;
   } else {
     //
-    // Run the file's cluster chain to find the current position
+    // Look the position up in the extent map of the file first
+    //
+    Status = FatLookupExtentMap (OFile, Position, PosLimit, &Run);
+    if (Status != EFI_NOT_FOUND) {
+      if (!EFI_ERROR (Status)) {
+        OFile->PosRem = Run;
+      }
+
+      return Status;
+    }
+
+    //
+    // The extent map cannot grow to cover the position, so
+    // run the file's cluster chain to find the current position
     // If possible, run from the current cluster rather than
     // start from beginning
     // Assumption: OFile->Position is always consistent with
@@ -722,11 +1008,25 @@ FatComputeFreeInfo (
   )
 {
   UINTN  Index;
+  UINTN  BitmapSize;
 
   //
   // If we don't have valid info, compute it now
   //
   if (!Volume->FreeInfoValid) {
+    //
+    // Record the free clusters in the bitmap while scanning the FAT
+    //
+    BitmapSize = (Volume->MaxCluster + 2) / 8 + 1;
+    if (Volume->FreeBitmap == NULL) {
+      Volume->FreeBitmap = AllocatePool (BitmapSize);
+    }
+
+    if (Volume->FreeBitmap != NULL) {
+      ZeroMem (Volume->FreeBitmap, BitmapSize);
+    }
+
+    Volume->FreeBitmapValid                     = FALSE;
     Volume->FreeInfoValid                       = TRUE;
     Volume->FatInfoSector.FreeInfo.ClusterCount = 0;
     for (Index = Volume->MaxCluster + 1; Index >= FAT_MIN_CLUSTER; Index--) {
@@ -737,9 +1037,14 @@ FatComputeFreeInfo (
       if (FatGetFatEntry (Volume, Index) == FAT_CLUSTER_FREE) {
         Volume->FatInfoSector.FreeInfo.ClusterCount += 1;
         Volume->FatInfoSector.FreeInfo.NextCluster   = (UINT32)Index;
+        if (Volume->FreeBitmap != NULL) {
+          Volume->FreeBitmap[Index / 8] |= (UINT8)(1 << (Index % 8));
+        }
       }
     }
 
+    Volume->FreeBitmapValid = (BOOLEAN)((Volume->FreeBitmap != NULL) && !Volume->DiskError);
+
     Volume->FatInfoSector.Signature          = FAT_INFO_SIGNATURE;
     Volume->FatInfoSector.InfoBeginSignature = FAT_INFO_BEGIN_SIGNATURE;
     Volume->FatInfoSector.InfoEndSignature   = FAT_INFO_END_SIGNATURE;
@@ -34,7 +34,7 @@ FatHashLongName (
     );
   FatStrUpr (UpCasedLongFileName);
   gBS->CalculateCrc32 (UpCasedLongFileName, StrSize (UpCasedLongFileName), &HashValue);
-  return (HashValue & HASH_TABLE_MASK);
+  return HashValue;
 }
 
 /**
@@ -55,7 +55,129 @@ FatHashShortName (
   UINT32  HashValue;
 
   gBS->CalculateCrc32 (ShortNameString, FAT_NAME_LEN, &HashValue);
-  return (HashValue & HASH_TABLE_MASK);
+  return HashValue;
+}
+
+/**
+
+  Allocate the hash tables with Size entries each. The long name and the
+  short name tables share one allocation.
+
+  @param  Size                  - The number of entries of each hash table.
+  @param  ShortNameHashTable    - The returned short name hash table.
+
+  @return The long name hash table, or NULL if there is not enough memory.
+
+**/
+STATIC
+FAT_DIRENT **
+FatAllocateHashTable (
+  IN  UINTN       Size,
+  OUT FAT_DIRENT  ***ShortNameHashTable
+  )
+{
+  FAT_DIRENT  **LongNameHashTable;
+
+  LongNameHashTable = AllocateZeroPool (2 * Size * sizeof (FAT_DIRENT *));
+  if (LongNameHashTable != NULL) {
+    *ShortNameHashTable = LongNameHashTable + Size;
+  }
+
+  return LongNameHashTable;
+}
+
+/**
+
+  Allocate the initial hash tables of the directory.
+
+  @param  ODir                  - The directory.
+
+  @retval EFI_SUCCESS           - The hash tables are allocated successfully.
+  @retval EFI_OUT_OF_RESOURCES  - Not enough memory to allocate the hash tables.
+
+**/
+EFI_STATUS
+FatCreateHashTable (
+  IN FAT_ODIR  *ODir
+  )
+{
+  ODir->LongNameHashTable = FatAllocateHashTable (HASH_TABLE_MIN_SIZE, &ODir->ShortNameHashTable);
+  if (ODir->LongNameHashTable == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  ODir->HashTableMask  = HASH_TABLE_MIN_SIZE - 1;
+  ODir->HashEntryCount = 0;
+  return EFI_SUCCESS;
+}
+
+/**
+
+  Free the hash tables of the directory.
+
+  @param  ODir                  - The directory.
+
+**/
+VOID
+FatFreeHashTable (
+  IN FAT_ODIR  *ODir
+  )
+{
+  if (ODir->LongNameHashTable != NULL) {
+    FreePool (ODir->LongNameHashTable);
+    ODir->LongNameHashTable  = NULL;
+    ODir->ShortNameHashTable = NULL;
+  }
+}
+
+/**
+
+  Double the size of the hash tables of the directory and rehash all the
+  directory entries. The current tables are kept if there is not enough memory.
+
+  @param  ODir                  - The directory.
+
+**/
+STATIC
+VOID
+FatGrowHashTable (
+  IN FAT_ODIR  *ODir
+  )
+{
+  FAT_DIRENT  **LongNameHashTable;
+  FAT_DIRENT  **ShortNameHashTable;
+  FAT_DIRENT  *DirEnt;
+  FAT_DIRENT  *NextDirEnt;
+  UINT32      NewMask;
+  UINT32      HashTableIndex;
+  UINTN       Index;
+
+  NewMask           = (ODir->HashTableMask << 1) | 1;
+  LongNameHashTable = FatAllocateHashTable ((UINTN)NewMask + 1, &ShortNameHashTable);
+  if (LongNameHashTable == NULL) {
+    return;
+  }
+
+  for (Index = 0; Index <= ODir->HashTableMask; Index++) {
+    for (DirEnt = ODir->ShortNameHashTable[Index]; DirEnt != NULL; DirEnt = NextDirEnt) {
+      NextDirEnt                         = DirEnt->ShortNameForwardLink;
+      HashTableIndex                     = FatHashShortName (DirEnt->Entry.FileName) & NewMask;
+      DirEnt->ShortNameForwardLink       = ShortNameHashTable[HashTableIndex];
+      ShortNameHashTable[HashTableIndex] = DirEnt;
+    }
+
+    for (DirEnt = ODir->LongNameHashTable[Index]; DirEnt != NULL; DirEnt = NextDirEnt) {
+      NextDirEnt                        = DirEnt->LongNameForwardLink;
+      HashTableIndex                    = FatHashLongName (DirEnt->FileString) & NewMask;
+      DirEnt->LongNameForwardLink       = LongNameHashTable[HashTableIndex];
+      LongNameHashTable[HashTableIndex] = DirEnt;
+    }
+  }
+
+  FreePool (ODir->LongNameHashTable);
+  ODir->LongNameHashTable  = LongNameHashTable;
+  ODir->ShortNameHashTable = ShortNameHashTable;
+  ODir->HashTableMask      = NewMask;
 }
 
 /**
@@ -76,7 +198,7 @@ FatLongNameHashSearch (
 {
   FAT_DIRENT  **PreviousHashNode;
 
-  for (PreviousHashNode   = &ODir->LongNameHashTable[FatHashLongName (LongNameString)];
+  for (PreviousHashNode   = &ODir->LongNameHashTable[FatHashLongName (LongNameString) & ODir->HashTableMask];
        *PreviousHashNode != NULL;
        PreviousHashNode   = &(*PreviousHashNode)->LongNameForwardLink
        )
@@ -107,7 +229,7 @@ FatShortNameHashSearch (
 {
   FAT_DIRENT  **PreviousHashNode;
 
-  for (PreviousHashNode   = &ODir->ShortNameHashTable[FatHashShortName (ShortNameString)];
+  for (PreviousHashNode   = &ODir->ShortNameHashTable[FatHashShortName (ShortNameString) & ODir->HashTableMask];
        *PreviousHashNode != NULL;
        PreviousHashNode   = &(*PreviousHashNode)->ShortNameForwardLink
        )
@@ -137,17 +259,27 @@ FatInsertToHashTable (
   FAT_DIRENT  **HashTable;
   UINT32      HashTableIndex;
 
+  //
+  // Grow the hash tables once the chains get too long
+  //
+  ODir->HashEntryCount++;
+  if ((ODir->HashEntryCount > HASH_TABLE_LOAD_FACTOR * ((UINTN)ODir->HashTableMask + 1)) &&
+      (ODir->HashTableMask < HASH_TABLE_MAX_SIZE - 1))
+  {
+    FatGrowHashTable (ODir);
+  }
+
   //
   // Insert hash table index for short name
   //
-  HashTableIndex               = FatHashShortName (DirEnt->Entry.FileName);
+  HashTableIndex               = FatHashShortName (DirEnt->Entry.FileName) & ODir->HashTableMask;
   HashTable                    = ODir->ShortNameHashTable;
   DirEnt->ShortNameForwardLink = HashTable[HashTableIndex];
   HashTable[HashTableIndex]    = DirEnt;
   //
   // Insert hash table index for long name
   //
-  HashTableIndex              = FatHashLongName (DirEnt->FileString);
+  HashTableIndex              = FatHashLongName (DirEnt->FileString) & ODir->HashTableMask;
   HashTable                   = ODir->LongNameHashTable;
   DirEnt->LongNameForwardLink = HashTable[HashTableIndex];
   HashTable[HashTableIndex]   = DirEnt;
@@ -169,4 +301,5 @@ FatDeleteFromHashTable (
 {
   *FatShortNameHashSearch (ODir, DirEnt->Entry.FileName) = DirEnt->ShortNameForwardLink;
   *FatLongNameHashSearch (ODir, DirEnt->FileString)      = DirEnt->LongNameForwardLink;
+  ODir->HashEntryCount--;
 }
@@ -468,6 +468,10 @@ FatFreeVolume (
     FreePool (Volume->CacheBuffer);
   }
 
+  if (Volume->FreeBitmap != NULL) {
+    FreePool (Volume->FreeBitmap);
+  }
+
   //
   // Free directory cache
   //
@@ -82,7 +82,9 @@ const FIRMWARE_MANAGEMENT_PRIVATE_DATA  mFirmwareManagementPrivateDataTemplate =
   NULL,             // LastAttemptStatusVariableName
   NULL,             // LastAttemptVersionVariableName
   NULL,             // FmpStateVariableName
-  TRUE              // DependenciesSatisfied
+  TRUE,             // DependenciesSatisfied
+  0,                // AuthenticatedKeyOffset
+  0                 // AuthenticatedKeyLength
 };
 
 ///
@@ -783,6 +785,7 @@ CheckTheImageInternal (
   UINTN                             PublicKeyDataLength;
   UINT8                             *PublicKeyDataXdr;
   UINT8                             *PublicKeyDataXdrEnd;
+  UINT8                             *AuthenticatedKeyData;
   EFI_FIRMWARE_IMAGE_DEP            *Dependencies;
   UINT32                            DependenciesSize;
 
@@ -866,10 +869,30 @@ CheckTheImageInternal (
     Status                 = EFI_ABORTED;
     LocalLastAttemptStatus = LAST_ATTEMPT_STATUS_DRIVER_ERROR_INVALID_CERTIFICATE;
   } else {
+    //
+    // Each authentication attempt copies and hashes the whole image, so try
+    // the key that authenticated the last image first. The CheckImage() and
+    // SetImage() calls of one update then do not retry the keys that failed.
+    //
+    AuthenticatedKeyData = NULL;
+    Status               = EFI_SECURITY_VIOLATION;
+    if ((Private->AuthenticatedKeyLength != 0) &&
+        (Private->AuthenticatedKeyLength <= (UINTN)(PublicKeyDataXdrEnd - PublicKeyDataXdr)) &&
+        (Private->AuthenticatedKeyOffset <= (UINTN)(PublicKeyDataXdrEnd - PublicKeyDataXdr) - Private->AuthenticatedKeyLength))
+    {
+      AuthenticatedKeyData = PublicKeyDataXdr + Private->AuthenticatedKeyOffset;
+      Status               = AuthenticateFmpImage (
+                               (EFI_FIRMWARE_IMAGE_AUTHENTICATION *)Image,
+                               ImageSize,
+                               AuthenticatedKeyData,
+                               Private->AuthenticatedKeyLength
+                               );
+    }
+
     //
     // Try each key from PcdFmpDevicePkcs7CertBufferXdr
     //
-    for (Index = 1; PublicKeyDataXdr < PublicKeyDataXdrEnd; Index++) {
+    for (Index = 1; EFI_ERROR (Status) && (PublicKeyDataXdr < PublicKeyDataXdrEnd); Index++) {
       Index++;
       DEBUG (
         (DEBUG_INFO,
@@ -910,14 +933,18 @@ CheckTheImageInternal (
       }
 
       PublicKeyData = PublicKeyDataXdr;
-      Status        = AuthenticateFmpImage (
-                        (EFI_FIRMWARE_IMAGE_AUTHENTICATION *)Image,
-                        ImageSize,
-                        PublicKeyData,
-                        PublicKeyDataLength
-                        );
-      if (!EFI_ERROR (Status)) {
-        break;
+      if (PublicKeyData != AuthenticatedKeyData) {
+        Status = AuthenticateFmpImage (
+                   (EFI_FIRMWARE_IMAGE_AUTHENTICATION *)Image,
+                   ImageSize,
+                   PublicKeyData,
+                   PublicKeyDataLength
+                   );
+        if (!EFI_ERROR (Status)) {
+          Private->AuthenticatedKeyOffset = (UINTN)((UINT8 *)PublicKeyData - (UINT8 *)PcdGetPtr (PcdFmpDevicePkcs7CertBufferXdr));
+          Private->AuthenticatedKeyLength = PublicKeyDataLength;
+          break;
+        }
       }
 
       PublicKeyDataXdr += PublicKeyDataLength;
@@ -72,6 +72,13 @@ typedef struct {
   CHAR16                              *LastAttemptVersionVariableName;
   CHAR16                              *FmpStateVariableName;
   BOOLEAN                             DependenciesSatisfied;
+  //
+  // Offset and length in PcdFmpDevicePkcs7CertBufferXdr of the key that
+  // authenticated the last image. The length is 0 if no image was
+  // authenticated yet.
+  //
+  UINTN                               AuthenticatedKeyOffset;
+  UINTN                               AuthenticatedKeyLength;
 } FIRMWARE_MANAGEMENT_PRIVATE_DATA;
 
 ///
@@ -243,6 +243,72 @@ EFI_PEI_NOTIFY_DESCRIPTOR  mFspsWrapperEndOfPeiNotifyDesc = {
   FspsWrapperEndOfPeiNotify
 };
 
+/**
+  Check the FSP-S output, process the FSP HOBs and install FspSiliconInitDonePpi
+  once FSP-S silicon initialization, including its multi-phase, is complete.
+
+  @param[in] FspHobListPtr  Pointer to the FSP HOB list.
+
+  @retval EFI_STATUS        Status returned by PeiServicesInstallPpi ()
+**/
+STATIC
+EFI_STATUS
+FspsWrapperSiliconInitDone (
+  IN VOID  *FspHobListPtr
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = TestFspSiliconInitApiOutput ((VOID *)NULL);
+  if (RETURN_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "ERROR - TestFspSiliconInitApiOutput () fail, Status = %r\n", Status));
+  }
+
+  PostFspsHobProcess (FspHobListPtr);
+
+  //
+  // Install FspSiliconInitDonePpi so that any other driver can consume this info.
+  //
+  Status = PeiServicesInstallPpi (&mPeiFspSiliconInitDonePpi);
+  ASSERT_EFI_ERROR (Status);
+
+  return Status;
+}
+
+/**
+  This function runs the FSP-S multi-phase once the PPI named by
+  PcdFspsMultiPhaseTriggerPpiGuid is installed.
+
+  @param[in] PeiServices    Pointer to PEI Services Table.
+  @param[in] NotifyDesc     Pointer to the descriptor for the Notification event that
+                            caused this function to execute.
+  @param[in] Ppi            Pointer to the PPI data associated with this function.
+
+  @retval EFI_STATUS        Status returned by PeiServicesInstallPpi ()
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+FspsMultiPhaseTriggerNotify (
+  IN EFI_PEI_SERVICES           **PeiServices,
+  IN EFI_PEI_NOTIFY_DESCRIPTOR  *NotifyDesc,
+  IN VOID                       *Ppi
+  )
+{
+  EFI_HOB_GUID_TYPE  *GuidHob;
+  VOID               *FspHobListPtr;
+
+  DEBUG ((DEBUG_INFO, "FspsMultiPhaseTriggerNotify enter\n"));
+
+  GuidHob = GetFirstGuidHob (&gFspHobGuid);
+  ASSERT (GuidHob != NULL);
+  FspHobListPtr = *(VOID **)GET_GUID_HOB_DATA (GuidHob);
+
+  FspWrapperMultiPhaseHandler (&FspHobListPtr, FspMultiPhaseSiInitApiIndex);    // FspS MultiPhase
+
+  return FspsWrapperSiliconInitDone (FspHobListPtr);
+}
+
 /**
   This function is called after PEI core discover memory and finish migration.
 
@@ -289,9 +355,11 @@ PeiMemoryDiscoveredNotify (
   UINT64             TimeStampCounterStart;
   EFI_STATUS         Status;
   VOID               *FspHobListPtr;
-  EFI_HOB_GUID_TYPE  *GuidHob;
-  FSPS_UPD_COMMON    *FspsUpdDataPtr;
-  UINTN              *SourceData;
+  EFI_HOB_GUID_TYPE          *GuidHob;
+  FSPS_UPD_COMMON            *FspsUpdDataPtr;
+  UINTN                      *SourceData;
+  EFI_GUID                   *TriggerPpiGuid;
+  EFI_PEI_NOTIFY_DESCRIPTOR  *TriggerNotifyDesc;
 
   DEBUG ((DEBUG_INFO, "PeiMemoryDiscoveredNotify enter\n"));
   FspsUpdDataPtr = NULL;
@@ -352,27 +420,41 @@ PeiMemoryDiscoveredNotify (
   }
 
   //
-  // See if MultiPhase process is required or not
+  // If the platform asked for it, return to the PEI dispatcher before the
+  // multi-phase, so that PEIMs which do not depend on FspSiliconInitDonePpi,
+  // such as TPM initialization, run while FSP-S is only partially done.
   //
-  FspWrapperMultiPhaseHandler (&FspHobListPtr, FspMultiPhaseSiInitApiIndex);    // FspS MultiPhase
-
-  PERF_END_EX (&gFspApiPerformanceGuid, "EventRec", NULL, 0, FSP_STATUS_CODE_SILICON_INIT | FSP_STATUS_CODE_COMMON_CODE | FSP_STATUS_CODE_API_EXIT);
-  DEBUG ((DEBUG_INFO, "Total time spent executing FspSiliconInitApi: %d millisecond\n", DivU64x32 (GetTimeInNanoSecond (AsmReadTsc () - TimeStampCounterStart), 1000000)));
+  TriggerPpiGuid = PcdGetPtr (PcdFspsMultiPhaseTriggerPpiGuid);
+  if (!IsZeroGuid (TriggerPpiGuid)) {
+    PERF_END_EX (&gFspApiPerformanceGuid, "EventRec", NULL, 0, FSP_STATUS_CODE_SILICON_INIT | FSP_STATUS_CODE_COMMON_CODE | FSP_STATUS_CODE_API_EXIT);
+    DEBUG ((DEBUG_INFO, "Total time spent executing FspSiliconInitApi: %d millisecond\n", DivU64x32 (GetTimeInNanoSecond (AsmReadTsc () - TimeStampCounterStart), 1000000)));
+
+    TriggerNotifyDesc = AllocatePool (sizeof (EFI_PEI_NOTIFY_DESCRIPTOR));
+    ASSERT (TriggerNotifyDesc != NULL);
+    if (TriggerNotifyDesc == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    TriggerNotifyDesc->Flags  = EFI_PEI_PPI_DESCRIPTOR_NOTIFY_CALLBACK | EFI_PEI_PPI_DESCRIPTOR_TERMINATE_LIST;
+    TriggerNotifyDesc->Guid   = TriggerPpiGuid;
+    TriggerNotifyDesc->Notify = FspsMultiPhaseTriggerNotify;
+
+    DEBUG ((DEBUG_INFO, "FSP-S MultiPhase deferred until %g is installed\n", TriggerPpiGuid));
+    Status = PeiServicesNotifyPpi (TriggerNotifyDesc);
+    ASSERT_EFI_ERROR (Status);
 
-  Status = TestFspSiliconInitApiOutput ((VOID *)NULL);
-  if (RETURN_ERROR (Status)) {
-    DEBUG ((DEBUG_ERROR, "ERROR - TestFspSiliconInitApiOutput () fail, Status = %r\n", Status));
+    return Status;
   }
 
-  PostFspsHobProcess (FspHobListPtr);
-
   //
-  // Install FspSiliconInitDonePpi so that any other driver can consume this info.
+  // See if MultiPhase process is required or not
   //
-  Status = PeiServicesInstallPpi (&mPeiFspSiliconInitDonePpi);
-  ASSERT_EFI_ERROR (Status);
+  FspWrapperMultiPhaseHandler (&FspHobListPtr, FspMultiPhaseSiInitApiIndex);    // FspS MultiPhase
 
-  return Status;
+  PERF_END_EX (&gFspApiPerformanceGuid, "EventRec", NULL, 0, FSP_STATUS_CODE_SILICON_INIT | FSP_STATUS_CODE_COMMON_CODE | FSP_STATUS_CODE_API_EXIT);
+  DEBUG ((DEBUG_INFO, "Total time spent executing FspSiliconInitApi: %d millisecond\n", DivU64x32 (GetTimeInNanoSecond (AsmReadTsc () - TimeStampCounterStart), 1000000)));
+
+  return FspsWrapperSiliconInitDone (FspHobListPtr);
 }
 
 /**
@@ -0,0 +1,337 @@
+/** @file
+  A shell application that measures the decode time of compressed sections.
+
+  Each input file holds a single EFI_SECTION_COMPRESSION section or an
+  EFI_SECTION_GUID_DEFINED section produced by one of the GUIDed compression
+  tools (LZMA, LZMA F86, Brotli, Zstd, ...). The section is decoded repeatedly
+  and the average decode time, the compression ratio and the scratch buffer
+  requirement are reported, so the available decompressors can be compared on
+  the same payload.
+
+  Usage: DecompressBenchmark [-n Iterations] SectionFile [SectionFile ...]
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Pi/PiFirmwareFile.h>
+#include <Protocol/ShellParameters.h>
+#include <Protocol/Shell.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/ExtractGuidedSectionLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/TimerLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiDecompressLib.h>
+#include <Library/UefiLib.h>
+
+#define DEFAULT_ITERATIONS  100
+
+/**
+  Read a file into a newly allocated buffer through the shell protocol.
+
+  @param[in]  FileName    The file to be read.
+  @param[out] BufferSize  The file buffer size.
+  @param[out] Buffer      The file buffer.
+
+  @retval EFI_SUCCESS    Read file successfully.
+  @retval EFI_NOT_FOUND  Shell protocol or file not found.
+  @retval others         Read file failed.
+**/
+EFI_STATUS
+ReadFileToBuffer (
+  IN  CHAR16  *FileName,
+  OUT UINTN   *BufferSize,
+  OUT VOID    **Buffer
+  )
+{
+  EFI_STATUS          Status;
+  EFI_SHELL_PROTOCOL  *ShellProtocol;
+  SHELL_FILE_HANDLE   Handle;
+  UINT64              FileSize;
+  UINTN               TempBufferSize;
+  VOID                *TempBuffer;
+
+  Status = gBS->LocateProtocol (&gEfiShellProtocolGuid, NULL, (VOID **)&ShellProtocol);
+  if (EFI_ERROR (Status)) {
+    return EFI_NOT_FOUND;
+  }
+
+  Status = ShellProtocol->OpenFileByName (FileName, &Handle, EFI_FILE_MODE_READ);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = ShellProtocol->GetFileSize (Handle, &FileSize);
+  if (EFI_ERROR (Status)) {
+    ShellProtocol->CloseFile (Handle);
+    return Status;
+  }
+
+  TempBufferSize = (UINTN)FileSize;
+  TempBuffer     = AllocatePool (TempBufferSize);
+  if (TempBuffer == NULL) {
+    ShellProtocol->CloseFile (Handle);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = ShellProtocol->ReadFile (Handle, &TempBufferSize, TempBuffer);
+  ShellProtocol->CloseFile (Handle);
+  if (EFI_ERROR (Status)) {
+    FreePool (TempBuffer);
+    return Status;
+  }
+
+  *BufferSize = TempBufferSize;
+  *Buffer     = TempBuffer;
+  return EFI_SUCCESS;
+}
+
+/**
+  Return the number of nanoseconds between two performance counter values.
+
+  @param[in] Start  The counter value at the start of the measurement.
+  @param[in] End    The counter value at the end of the measurement.
+
+  @return The elapsed time in nanoseconds.
+**/
+UINT64
+ElapsedNanoSeconds (
+  IN UINT64  Start,
+  IN UINT64  End
+  )
+{
+  UINT64  StartValue;
+  UINT64  EndValue;
+
+  GetPerformanceCounterProperties (&StartValue, &EndValue);
+  if (EndValue < StartValue) {
+    return GetTimeInNanoSecond (Start - End);
+  }
+
+  return GetTimeInNanoSecond (End - Start);
+}
+
+/**
+  Decode one compressed section repeatedly and print the results.
+
+  @param[in] FileName     The name of the file holding the section.
+  @param[in] Section      The section to be decoded.
+  @param[in] SectionSize  The size of the file holding the section.
+  @param[in] Iterations   The number of times the section is decoded.
+
+  @retval EFI_SUCCESS            The section was decoded and measured.
+  @retval EFI_UNSUPPORTED        The section type or its GUID is not supported.
+  @retval EFI_OUT_OF_RESOURCES   The output or scratch buffer could not be allocated.
+  @retval others                 The section failed to decode.
+**/
+EFI_STATUS
+BenchmarkSection (
+  IN CHAR16                    *FileName,
+  IN EFI_COMMON_SECTION_HEADER *Section,
+  IN UINTN                     SectionSize,
+  IN UINTN                     Iterations
+  )
+{
+  EFI_STATUS  Status;
+  UINT32      OutputSize;
+  UINT32      ScratchSize;
+  UINT16      SectionAttribute;
+  UINT32      AuthenticationStatus;
+  VOID        *OutputBuffer;
+  VOID        *ScratchBuffer;
+  VOID        *Output;
+  VOID        *Source;
+  UINT32      SourceSize;
+  UINTN       HeaderSize;
+  EFI_GUID    *Algorithm;
+  UINT64      Start;
+  UINT64      Total;
+  UINT64      Best;
+  UINT64      Elapsed;
+  UINTN       Index;
+
+  if ((SectionSize < sizeof (EFI_COMMON_SECTION_HEADER)) ||
+      (IS_SECTION2 (Section) && ((SectionSize < sizeof (EFI_COMMON_SECTION_HEADER2)) || (SectionSize < SECTION2_SIZE (Section)))) ||
+      (!IS_SECTION2 (Section) && (SectionSize < SECTION_SIZE (Section))))
+  {
+    Print (L"%s: file is smaller than the section it holds\n", FileName);
+    return EFI_VOLUME_CORRUPTED;
+  }
+
+  Algorithm  = NULL;
+  SourceSize = 0;
+  Source     = NULL;
+  if (Section->Type == EFI_SECTION_COMPRESSION) {
+    if (IS_SECTION2 (Section)) {
+      HeaderSize = sizeof (EFI_COMPRESSION_SECTION2);
+    } else {
+      HeaderSize = sizeof (EFI_COMPRESSION_SECTION);
+    }
+
+    Source     = (UINT8 *)Section + HeaderSize;
+    SourceSize = (UINT32)(SectionSize - HeaderSize);
+    Status     = UefiDecompressGetInfo (Source, SourceSize, &OutputSize, &ScratchSize);
+  } else if (Section->Type == EFI_SECTION_GUID_DEFINED) {
+    Status = ExtractGuidedSectionGetInfo (Section, &OutputSize, &ScratchSize, &SectionAttribute);
+    if (IS_SECTION2 (Section)) {
+      Algorithm = &((EFI_GUID_DEFINED_SECTION2 *)Section)->SectionDefinitionGuid;
+    } else {
+      Algorithm = &((EFI_GUID_DEFINED_SECTION *)Section)->SectionDefinitionGuid;
+    }
+  } else {
+    Print (L"%s: section type 0x%x is not a compressed section\n", FileName, Section->Type);
+    return EFI_UNSUPPORTED;
+  }
+
+  if (EFI_ERROR (Status)) {
+    Print (L"%s: no decompressor for this section - %r\n", FileName, Status);
+    return Status;
+  }
+
+  OutputBuffer  = AllocatePool (MAX (OutputSize, 1));
+  ScratchBuffer = AllocatePool (MAX (ScratchSize, 1));
+  if ((OutputBuffer == NULL) || (ScratchBuffer == NULL)) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Done;
+  }
+
+  Total = 0;
+  Best  = MAX_UINT64;
+  for (Index = 0; Index < Iterations; Index++) {
+    Start = GetPerformanceCounter ();
+    if (Algorithm == NULL) {
+      Status = UefiDecompress (Source, OutputBuffer, ScratchBuffer);
+    } else {
+      //
+      // The handler decodes into *Output, or returns a pointer into the
+      // input section when no processing is required.
+      //
+      Output = OutputBuffer;
+      Status = ExtractGuidedSectionDecode (Section, &Output, ScratchBuffer, &AuthenticationStatus);
+    }
+
+    Elapsed = ElapsedNanoSeconds (Start, GetPerformanceCounter ());
+    if (EFI_ERROR (Status)) {
+      Print (L"%s: decode failed - %r\n", FileName, Status);
+      goto Done;
+    }
+
+    Total += Elapsed;
+    Best   = MIN (Best, Elapsed);
+  }
+
+  if (Algorithm == NULL) {
+    Print (L"%s: EFI_SECTION_COMPRESSION\n", FileName);
+  } else {
+    Print (L"%s: %g\n", FileName, Algorithm);
+  }
+
+  Print (
+    L"  Compressed %u bytes, decompressed %u bytes, ratio %u.%02u%%, scratch %u bytes\n",
+    (UINT32)SectionSize,
+    OutputSize,
+    (UINT32)DivU64x32 (MultU64x32 (SectionSize, 10000), MAX (OutputSize, 1)) / 100,
+    (UINT32)DivU64x32 (MultU64x32 (SectionSize, 10000), MAX (OutputSize, 1)) % 100,
+    ScratchSize
+    );
+  Print (
+    L"  %u iterations, average %lu us, best %lu us, %lu MB/s\n",
+    Iterations,
+    DivU64x64Remainder (Total, MultU64x32 (Iterations, 1000), NULL),
+    DivU64x32 (Best, 1000),
+    DivU64x64Remainder (MultU64x32 (OutputSize, 1000), MAX (Best, 1), NULL)
+    );
+
+Done:
+  if (OutputBuffer != NULL) {
+    FreePool (OutputBuffer);
+  }
+
+  if (ScratchBuffer != NULL) {
+    FreePool (ScratchBuffer);
+  }
+
+  return Status;
+}
+
+/**
+  The entry point of the decompress benchmark application.
+
+  @param[in] ImageHandle  The image handle of the application.
+  @param[in] SystemTable  A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS            All sections were decoded and measured.
+  @retval EFI_INVALID_PARAMETER  The command line is invalid.
+  @retval others                 A section failed to load or decode.
+**/
+EFI_STATUS
+EFIAPI
+DecompressBenchmarkMain (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS                     Status;
+  EFI_SHELL_PARAMETERS_PROTOCOL  *ShellParameters;
+  UINTN                          Iterations;
+  UINTN                          Index;
+  UINTN                          FileSize;
+  VOID                           *FileBuffer;
+  BOOLEAN                        Measured;
+
+  Status = gBS->HandleProtocol (
+                  ImageHandle,
+                  &gEfiShellParametersProtocolGuid,
+                  (VOID **)&ShellParameters
+                  );
+  if (EFI_ERROR (Status)) {
+    Print (L"DecompressBenchmark must be run from the UEFI Shell\n");
+    return Status;
+  }
+
+  Iterations = DEFAULT_ITERATIONS;
+  Measured   = FALSE;
+  for (Index = 1; Index < ShellParameters->Argc; Index++) {
+    if (StrCmp (ShellParameters->Argv[Index], L"-n") == 0) {
+      if (Index + 1 >= ShellParameters->Argc) {
+        Status = EFI_INVALID_PARAMETER;
+        break;
+      }
+
+      Index++;
+      Iterations = StrDecimalToUintn (ShellParameters->Argv[Index]);
+      if (Iterations == 0) {
+        Status = EFI_INVALID_PARAMETER;
+        break;
+      }
+
+      continue;
+    }
+
+    Status = ReadFileToBuffer (ShellParameters->Argv[Index], &FileSize, &FileBuffer);
+    if (EFI_ERROR (Status)) {
+      Print (L"%s: cannot read file - %r\n", ShellParameters->Argv[Index], Status);
+      break;
+    }
+
+    Status = BenchmarkSection (ShellParameters->Argv[Index], FileBuffer, FileSize, Iterations);
+    FreePool (FileBuffer);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    Measured = TRUE;
+  }
+
+  if ((Status == EFI_INVALID_PARAMETER) || (!EFI_ERROR (Status) && !Measured)) {
+    Print (L"Usage: DecompressBenchmark [-n Iterations] SectionFile [SectionFile ...]\n");
+    return EFI_INVALID_PARAMETER;
+  }
+
+  return Status;
+}
@@ -638,6 +638,105 @@ DumpMemoryProfileMemoryRange (
   return (VOID *)Descriptor;
 }
 
+/**
+  Find the driver whose image contains an address.
+
+  @param[in] Context            Pointer to memory profile context.
+  @param[in] Address            Address to look up.
+
+  @return Pointer to the memory profile driver info, or NULL if not found.
+
+**/
+MEMORY_PROFILE_DRIVER_INFO *
+GetDriverInfoByAddress (
+  IN MEMORY_PROFILE_CONTEXT  *Context,
+  IN PHYSICAL_ADDRESS        Address
+  )
+{
+  MEMORY_PROFILE_DRIVER_INFO  *DriverInfo;
+  MEMORY_PROFILE_ALLOC_INFO   *AllocInfo;
+  UINTN                       DriverIndex;
+  UINTN                       AllocIndex;
+
+  DriverInfo = (MEMORY_PROFILE_DRIVER_INFO *)((UINTN)Context + Context->Header.Length);
+  for (DriverIndex = 0; DriverIndex < Context->ImageCount; DriverIndex++) {
+    if (DriverInfo->Header.Signature != MEMORY_PROFILE_DRIVER_INFO_SIGNATURE) {
+      return NULL;
+    }
+
+    if ((Address >= DriverInfo->ImageBase) &&
+        (Address < (DriverInfo->ImageBase + DriverInfo->ImageSize)))
+    {
+      return DriverInfo;
+    }
+
+    AllocInfo = (MEMORY_PROFILE_ALLOC_INFO *)((UINTN)DriverInfo + DriverInfo->Header.Length);
+    for (AllocIndex = 0; AllocIndex < DriverInfo->AllocRecordCount; AllocIndex++) {
+      AllocInfo = (MEMORY_PROFILE_ALLOC_INFO *)((UINTN)AllocInfo + AllocInfo->Header.Length);
+    }
+
+    DriverInfo = (MEMORY_PROFILE_DRIVER_INFO *)AllocInfo;
+  }
+
+  return NULL;
+}
+
+/**
+  Dump the memory profile call sites recorded in sampling mode.
+
+  The sampled counts and sizes are scaled by the sampling rate to estimate
+  the totals of each call site.
+
+  @param[in] Context            Pointer to memory profile context.
+  @param[in] CallSite           Pointer to the first memory profile call site.
+  @param[in] ProfileEnd         End of the memory profile.
+
+**/
+VOID
+DumpMemoryProfileCallSites (
+  IN MEMORY_PROFILE_CONTEXT    *Context,
+  IN MEMORY_PROFILE_CALL_SITE  *CallSite,
+  IN UINTN                     ProfileEnd
+  )
+{
+  MEMORY_PROFILE_DRIVER_INFO  *DriverInfo;
+  CHAR8                       *NameString;
+  PHYSICAL_ADDRESS            Offset;
+
+  Print (L"\nSampled Call Sites (estimated, 1 in %d allocations sampled):\n", CallSite->SampleRate);
+  Print (L"  AllocCount          AllocSize          CurrentSize            PeakSize         Offset      MemoryType                  Driver\n");
+  Print (L"==================  ==================  ==================  ==================  ==========  ==========================  ================\n");
+  while (((UINTN)CallSite + sizeof (*CallSite) <= ProfileEnd) &&
+         (CallSite->Header.Signature == MEMORY_PROFILE_CALL_SITE_SIGNATURE))
+  {
+    DriverInfo = NULL;
+    if (Context != NULL) {
+      DriverInfo = GetDriverInfoByAddress (Context, CallSite->CallerAddress);
+    }
+
+    if (DriverInfo != NULL) {
+      NameString = GetDriverNameString (DriverInfo);
+      Offset     = CallSite->CallerAddress - DriverInfo->ImageBase;
+    } else {
+      NameString = "Unknown";
+      Offset     = CallSite->CallerAddress;
+    }
+
+    Print (
+      L"0x%016lx  0x%016lx  0x%016lx  0x%016lx  0x%08lx  %-26a  %a\n",
+      MultU64x32 (CallSite->AllocCount, CallSite->SampleRate),
+      MultU64x32 (CallSite->AllocSize, CallSite->SampleRate),
+      MultU64x32 (CallSite->CurrentSize, CallSite->SampleRate),
+      MultU64x32 (CallSite->PeakSize, CallSite->SampleRate),
+      Offset,
+      ProfileMemoryTypeToStr (CallSite->MemoryType),
+      NameString
+      );
+
+    CallSite = (MEMORY_PROFILE_CALL_SITE *)((UINTN)CallSite + CallSite->Header.Length);
+  }
+}
+
 /**
   Scan memory profile by Signature.
 
@@ -698,12 +797,18 @@ DumpMemoryProfile (
   MEMORY_PROFILE_CONTEXT       *Context;
   MEMORY_PROFILE_FREE_MEMORY   *FreeMemory;
   MEMORY_PROFILE_MEMORY_RANGE  *MemoryRange;
+  MEMORY_PROFILE_CALL_SITE     *CallSite;
 
   Context = (MEMORY_PROFILE_CONTEXT *)ScanMemoryProfileBySignature (ProfileBuffer, ProfileSize, MEMORY_PROFILE_CONTEXT_SIGNATURE);
   if (Context != NULL) {
     DumpMemoryProfileContext (Context, IsForSmm);
   }
 
+  CallSite = (MEMORY_PROFILE_CALL_SITE *)ScanMemoryProfileBySignature (ProfileBuffer, ProfileSize, MEMORY_PROFILE_CALL_SITE_SIGNATURE);
+  if (CallSite != NULL) {
+    DumpMemoryProfileCallSites (Context, CallSite, (UINTN)(ProfileBuffer + ProfileSize));
+  }
+
   FreeMemory = (MEMORY_PROFILE_FREE_MEMORY *)ScanMemoryProfileBySignature (ProfileBuffer, ProfileSize, MEMORY_PROFILE_FREE_MEMORY_SIGNATURE);
   if (FreeMemory != NULL) {
     DumpMemoryProfileFreeMemory (FreeMemory);
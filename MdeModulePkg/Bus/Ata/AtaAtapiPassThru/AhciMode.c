@@ -2850,6 +2850,83 @@ AhciPuisEnable (
   return Status;
 }
 
+/**
+  Bring up a single implemented AHCI port.
+
+  Programs the received FIS and command list base addresses, powers up and
+  spins up the device, and enables FIS receive so that the port can start
+  detecting the presence of a device.
+
+  @param[in]  PciIo             The PCI IO protocol instance.
+  @param[in]  AhciRegisters     The pointer to the EFI_AHCI_REGISTERS.
+  @param[in]  IdeInit           The IDE controller init protocol instance.
+  @param[in]  Capability        The HBA capability register value.
+  @param[in]  Port              The number of port.
+
+**/
+VOID
+AhciInitializePort (
+  IN  EFI_PCI_IO_PROTOCOL               *PciIo,
+  IN  EFI_AHCI_REGISTERS                *AhciRegisters,
+  IN  EFI_IDE_CONTROLLER_INIT_PROTOCOL  *IdeInit,
+  IN  UINT32                            Capability,
+  IN  UINT8                             Port
+  )
+{
+  DATA_64  Data64;
+  UINT32   Offset;
+  UINT32   Data;
+
+  IdeInit->NotifyPhase (IdeInit, EfiIdeBeforeChannelEnumeration, Port);
+
+  //
+  // Initialize FIS Base Address Register and Command List Base Address Register for use.
+  //
+  Data64.Uint64 = (UINTN)(AhciRegisters->AhciRFisPciAddr) + sizeof (EFI_AHCI_RECEIVED_FIS) * Port;
+  Offset        = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_FB;
+  AhciWriteReg (PciIo, Offset, Data64.Uint32.Lower32);
+  Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_FBU;
+  AhciWriteReg (PciIo, Offset, Data64.Uint32.Upper32);
+
+  Data64.Uint64 = (UINTN)(AhciRegisters->AhciCmdListPciAddr);
+  Offset        = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_CLB;
+  AhciWriteReg (PciIo, Offset, Data64.Uint32.Lower32);
+  Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_CLBU;
+  AhciWriteReg (PciIo, Offset, Data64.Uint32.Upper32);
+
+  Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_CMD;
+  Data   = AhciReadReg (PciIo, Offset);
+  if ((Data & EFI_AHCI_PORT_CMD_CPD) != 0) {
+    AhciOrReg (PciIo, Offset, EFI_AHCI_PORT_CMD_POD);
+  }
+
+  if ((Capability & EFI_AHCI_CAP_SSS) != 0) {
+    AhciOrReg (PciIo, Offset, EFI_AHCI_PORT_CMD_SUD);
+  }
+
+  //
+  // Disable aggressive power management.
+  //
+  Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_SCTL;
+  AhciOrReg (PciIo, Offset, EFI_AHCI_PORT_SCTL_IPM_INIT);
+  //
+  // Disable the reporting of the corresponding interrupt to system software.
+  //
+  Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_IE;
+  AhciAndReg (PciIo, Offset, 0);
+
+  //
+  // Now inform the IDE Controller Init Module.
+  //
+  IdeInit->NotifyPhase (IdeInit, EfiIdeBusBeforeDevicePresenceDetection, Port);
+
+  //
+  // Enable FIS Receive DMA engine for the first D2H FIS.
+  //
+  Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_CMD;
+  AhciOrReg (PciIo, Offset, EFI_AHCI_PORT_CMD_FRE);
+}
+
 /**
   Initialize ATA host controller at AHCI mode.
 
@@ -2874,7 +2951,7 @@ AhciModeInitialization (
   EFI_AHCI_REGISTERS  *AhciRegisters;
 
   UINT8                    Port;
-  DATA_64                  Data64;
+  UINT8                    PortCount;
   UINT32                   Offset;
   UINT32                   Data;
   EFI_IDENTIFY_DATA        Buffer;
@@ -2883,6 +2960,7 @@ AhciModeInitialization (
   EFI_ATA_TRANSFER_MODE    TransferMode;
   UINT32                   PhyDetectDelay;
   UINT32                   Value;
+  BOOLEAN                  ParallelInit;
 
   if (Instance == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -2949,6 +3027,22 @@ AhciModeInitialization (
     return EFI_OUT_OF_RESOURCES;
   }
 
+  //
+  // Bring up all implemented ports first, so that link training and drive
+  // spin-up overlap instead of being paid for one port after another.
+  //
+  ParallelInit   = PcdGetBool (PcdAhciParallelPortInit);
+  PhyDetectDelay = EFI_AHCI_BUS_PHY_DETECT_TIMEOUT;
+  if (ParallelInit) {
+    PortCount = MaxPortNumber;
+    for (Port = 0; (Port < EFI_AHCI_MAX_PORTS) && (PortCount > 0); Port++) {
+      if ((PortImplementBitMap & (((UINT32)BIT0) << Port)) != 0) {
+        AhciInitializePort (PciIo, AhciRegisters, IdeInit, Capability, Port);
+        PortCount--;
+      }
+    }
+  }
+
   for (Port = 0; Port < EFI_AHCI_MAX_PORTS; Port++) {
     if ((PortImplementBitMap & (((UINT32)BIT0) << Port)) != 0) {
       //
@@ -2962,71 +3056,32 @@ AhciModeInitialization (
         return EFI_SUCCESS;
       }
 
-      IdeInit->NotifyPhase (IdeInit, EfiIdeBeforeChannelEnumeration, Port);
-
-      //
-      // Initialize FIS Base Address Register and Command List Base Address Register for use.
-      //
-      Data64.Uint64 = (UINTN)(AhciRegisters->AhciRFisPciAddr) + sizeof (EFI_AHCI_RECEIVED_FIS) * Port;
-      Offset        = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_FB;
-      AhciWriteReg (PciIo, Offset, Data64.Uint32.Lower32);
-      Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_FBU;
-      AhciWriteReg (PciIo, Offset, Data64.Uint32.Upper32);
-
-      Data64.Uint64 = (UINTN)(AhciRegisters->AhciCmdListPciAddr);
-      Offset        = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_CLB;
-      AhciWriteReg (PciIo, Offset, Data64.Uint32.Lower32);
-      Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_CLBU;
-      AhciWriteReg (PciIo, Offset, Data64.Uint32.Upper32);
-
-      Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_CMD;
-      Data   = AhciReadReg (PciIo, Offset);
-      if ((Data & EFI_AHCI_PORT_CMD_CPD) != 0) {
-        AhciOrReg (PciIo, Offset, EFI_AHCI_PORT_CMD_POD);
-      }
-
-      if ((Capability & EFI_AHCI_CAP_SSS) != 0) {
-        AhciOrReg (PciIo, Offset, EFI_AHCI_PORT_CMD_SUD);
+      if (!ParallelInit) {
+        AhciInitializePort (PciIo, AhciRegisters, IdeInit, Capability, Port);
+        PhyDetectDelay = EFI_AHCI_BUS_PHY_DETECT_TIMEOUT;
       }
 
       //
-      // Disable aggressive power management.
+      // Wait for the Phy to detect the presence of a device. When the ports
+      // are brought up in parallel, the detection timeout is shared by all of
+      // them since their links have been training concurrently.
       //
-      Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_SCTL;
-      AhciOrReg (PciIo, Offset, EFI_AHCI_PORT_SCTL_IPM_INIT);
-      //
-      // Disable the reporting of the corresponding interrupt to system software.
-      //
-      Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_IE;
-      AhciAndReg (PciIo, Offset, 0);
-
-      //
-      // Now inform the IDE Controller Init Module.
-      //
-      IdeInit->NotifyPhase (IdeInit, EfiIdeBusBeforeDevicePresenceDetection, Port);
-
-      //
-      // Enable FIS Receive DMA engine for the first D2H FIS.
-      //
-      Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_CMD;
-      AhciOrReg (PciIo, Offset, EFI_AHCI_PORT_CMD_FRE);
-
-      //
-      // Wait for the Phy to detect the presence of a device.
-      //
-      PhyDetectDelay = EFI_AHCI_BUS_PHY_DETECT_TIMEOUT;
-      Offset         = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_SSTS;
-      do {
+      Offset = EFI_AHCI_PORT_START + Port * EFI_AHCI_PORT_REG_WIDTH + EFI_AHCI_PORT_SSTS;
+      while (TRUE) {
         Data = AhciReadReg (PciIo, Offset) & EFI_AHCI_PORT_SSTS_DET_MASK;
         if ((Data == EFI_AHCI_PORT_SSTS_DET_PCE) || (Data == EFI_AHCI_PORT_SSTS_DET)) {
           break;
         }
 
+        if (PhyDetectDelay == 0) {
+          break;
+        }
+
         MicroSecondDelay (1000);
         PhyDetectDelay--;
-      } while (PhyDetectDelay > 0);
+      }
 
-      if (PhyDetectDelay == 0) {
+      if ((Data != EFI_AHCI_PORT_SSTS_DET_PCE) && (Data != EFI_AHCI_PORT_SSTS_DET)) {
         //
         // No device detected at this port.
         // Clear PxCMD.SUD for those ports at which there are no device present.
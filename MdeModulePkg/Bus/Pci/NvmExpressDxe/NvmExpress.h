@@ -42,6 +42,7 @@
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiDriverEntryPoint.h>
 #include <Library/ReportStatusCodeLib.h>
+#include <Library/PcdLib.h>
 
 #include <Guid/NVMeEventGroup.h>
 
@@ -68,17 +69,57 @@ extern EFI_DRIVER_SUPPORTED_EFI_VERSION_PROTOCOL  gNvmExpressDriverSupportedEfiV
 #define NVME_CCQ_SIZE  1                                // Number of I/O completion queue entries, which is 0-based
 
 //
-// Number of asynchronous I/O submission queue entries, which is 0-based.
-// The asynchronous I/O submission queue size is 4kB in total.
+// Maximum number of asynchronous I/O queue pairs, set by PcdNvmeAsyncIoQueueCount.
 //
-#define NVME_ASYNC_CSQ_SIZE  63
+#define NVME_MAX_ASYNC_QUEUES  8
 //
-// Number of asynchronous I/O completion queue entries, which is 0-based.
-// The asynchronous I/O completion queue size is 4kB in total.
+// Maximum number of entries of each asynchronous I/O submission and completion
+// queue, set by PcdNvmeAsyncIoQueueSize.
 //
-#define NVME_ASYNC_CCQ_SIZE  255
+#define NVME_MAX_ASYNC_QUEUE_SIZE  1024
 
-#define NVME_MAX_QUEUES  3                              // Number of queues supported by the driver
+#define NVME_ASYNC_QUEUE_ID  2                          // Queue ID of the first asynchronous I/O queue pair
+
+//
+// Number of queues supported by the driver: the admin queue, the blocking
+// I/O queue and the asynchronous I/O queues.
+//
+#define NVME_MAX_QUEUES  (NVME_ASYNC_QUEUE_ID + NVME_MAX_ASYNC_QUEUES)
+
+//
+// Pages taken by an I/O submission or completion queue of QueueSize (0-based) entries.
+//
+#define NVME_SQ_PAGES(QueueSize)  EFI_SIZE_TO_PAGES (((UINTN)(QueueSize) + 1) * sizeof (NVME_SQ))
+#define NVME_CQ_PAGES(QueueSize)  EFI_SIZE_TO_PAGES (((UINTN)(QueueSize) + 1) * sizeof (NVME_CQ))
+
+//
+// Pages taken by the admin queues, the blocking I/O queues and AsyncQueueCount
+// asynchronous I/O queue pairs of AsyncQueueSize (0-based) entries each.
+//
+#define NVME_QUEUE_BUFFER_PAGES(AsyncQueueCount, AsyncQueueSize) \
+  (4 + (AsyncQueueCount) * (NVME_SQ_PAGES (AsyncQueueSize) + NVME_CQ_PAGES (AsyncQueueSize)))
+
+#define NVME_FEATURE_NUMBER_OF_QUEUES  0x07             // Feature Identifier of the Number of Queues feature
+
+//
+// SGL Support (SGLS) field of the Identify Controller data, bits 1:0.
+//
+#define NVME_SGLS_SUPPORT_MASK             0x3
+#define NVME_SGLS_SUPPORTED                0x1          // SGLs supported, no alignment or granularity requirement
+#define NVME_SGLS_SUPPORTED_DWORD_ALIGNED  0x2          // SGLs supported, data blocks must be dword aligned
+
+#define NVME_PSDT_SGL_MPTR_CONTIGUOUS   0x1             // PSDT value: SGL for data, MPTR points to a contiguous buffer
+#define NVME_SGL_DATA_BLOCK_DESCRIPTOR  0x00            // SGL descriptor type Data Block, subtype Address
+
+//
+// SGL descriptor, which takes the place of the two PRP entries of a command.
+//
+typedef struct {
+  UINT64    Address;
+  UINT32    Length;
+  UINT8     Rsvd[3];
+  UINT8     Identifier;                                 // Descriptor type in bits 7:4, subtype in bits 3:0
+} NVME_SGL_DESCRIPTOR;
 
 //
 // FormatNVM Admin Command LBA Format (LBAF) Mask
@@ -145,16 +186,17 @@ struct _NVME_CONTROLLER_PRIVATE_DATA {
   NVME_ADMIN_CONTROLLER_DATA            *ControllerData;
 
   //
-  // 6 x 4kB aligned buffers will be carved out of this buffer.
+  // BufferPages x 4kB aligned buffers will be carved out of this buffer.
   // 1st 4kB boundary is the start of the admin submission queue.
   // 2nd 4kB boundary is the start of the admin completion queue.
   // 3rd 4kB boundary is the start of I/O submission queue #1.
   // 4th 4kB boundary is the start of I/O completion queue #1.
-  // 5th 4kB boundary is the start of I/O submission queue #2.
-  // 6th 4kB boundary is the start of I/O completion queue #2.
+  // Then follow the submission and completion queues of each
+  // asynchronous I/O queue pair, starting with I/O queue #2.
   //
   UINT8          *Buffer;
   UINT8          *BufferPciAddr;
+  UINTN          BufferPages;
 
   //
   // Pointers to 4kB aligned submission & completion queues.
@@ -169,7 +211,24 @@ struct _NVME_CONTROLLER_PRIVATE_DATA {
   //
   NVME_SQTDBL    SqTdbl[NVME_MAX_QUEUES];
   NVME_CQHDBL    CqHdbl[NVME_MAX_QUEUES];
-  UINT16         AsyncSqHead;
+  UINT16         AsyncSqHead[NVME_MAX_QUEUES];
+
+  //
+  // Number of asynchronous I/O queue pairs, their number of entries (0-based),
+  // and the index of the pair the next asynchronous command is submitted to.
+  //
+  UINT16         AsyncQueueCount;
+  UINT16         AsyncQueueSize;
+  UINT16         NextAsyncQueue;
+
+  //
+  // PRP lists reused by the blocking commands, grown on demand.
+  //
+  VOID                    *PrpListPool;
+  EFI_PHYSICAL_ADDRESS    PrpListPoolPciAddr;
+  VOID                    *PrpListPoolMapping;
+  UINTN                   PrpListPoolPages;
+  BOOLEAN                 PrpListPoolBusy;
 
   //
   // Flag to indicate internal IO queue creation.
@@ -329,6 +388,7 @@ typedef struct {
   LIST_ENTRY                                  Link;
 
   EFI_NVM_EXPRESS_PASS_THRU_COMMAND_PACKET    *Packet;
+  UINT16                                      QueueId;
   UINT16                                      CommandId;
   VOID                                        *MapPrpList;
   UINTN                                       PrpListNo;
@@ -637,6 +697,17 @@ NvmExpressPassThru (
   IN     EFI_EVENT                                 Event OPTIONAL
   );
 
+/**
+  Free the PRP list pool of the controller.
+
+  @param[in]     Private             The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+
+**/
+VOID
+NvmeFreePrpListPool (
+  IN NVME_CONTROLLER_PRIVATE_DATA  *Private
+  );
+
 /**
   Used to retrieve the next namespace ID for this NVM Express controller.
 
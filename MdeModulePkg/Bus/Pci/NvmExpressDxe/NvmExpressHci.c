@@ -564,6 +564,69 @@ NvmeIdentifyNamespace (
   return Status;
 }
 
+/**
+  Negotiate the number of I/O queues with the controller.
+
+  The blocking I/O queue pair and Private->AsyncQueueCount asynchronous I/O
+  queue pairs are requested. Private->AsyncQueueCount is lowered to what the
+  controller grants.
+
+  @param  Private          The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+
+  @return EFI_SUCCESS      Successfully set the number of io queues.
+  @return EFI_DEVICE_ERROR Fail to set the number of io queues.
+
+**/
+EFI_STATUS
+NvmeSetNumberOfQueues (
+  IN NVME_CONTROLLER_PRIVATE_DATA  *Private
+  )
+{
+  EFI_NVM_EXPRESS_PASS_THRU_COMMAND_PACKET  CommandPacket;
+  EFI_NVM_EXPRESS_COMMAND                   Command;
+  EFI_NVM_EXPRESS_COMPLETION                Completion;
+  EFI_STATUS                                Status;
+  UINT32                                    Granted;
+
+  ZeroMem (&CommandPacket, sizeof (EFI_NVM_EXPRESS_PASS_THRU_COMMAND_PACKET));
+  ZeroMem (&Command, sizeof (EFI_NVM_EXPRESS_COMMAND));
+  ZeroMem (&Completion, sizeof (EFI_NVM_EXPRESS_COMPLETION));
+
+  CommandPacket.NvmeCmd        = &Command;
+  CommandPacket.NvmeCompletion = &Completion;
+  CommandPacket.CommandTimeout = NVME_GENERIC_TIMEOUT;
+  CommandPacket.QueueType      = NVME_ADMIN_QUEUE;
+
+  //
+  // Both NSQR and NCQR are 0-based, so the blocking I/O queue pair makes
+  // the requested value equal to the number of asynchronous queue pairs.
+  //
+  Command.Cdw0.Opcode = NVME_ADMIN_SET_FEATURES_CMD;
+  Command.Cdw10       = NVME_FEATURE_NUMBER_OF_QUEUES;
+  Command.Cdw11       = Private->AsyncQueueCount | ((UINT32)Private->AsyncQueueCount << 16);
+  Command.Flags       = CDW10_VALID | CDW11_VALID;
+
+  Status = Private->Passthru.PassThru (
+                               &Private->Passthru,
+                               NVME_CONTROLLER_ID,
+                               &CommandPacket,
+                               NULL
+                               );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  // NSQA and NCQA are 0-based as well.
+  //
+  Granted = MIN (Completion.DW0 & 0xFFFF, Completion.DW0 >> 16);
+  if (Granted < Private->AsyncQueueCount) {
+    Private->AsyncQueueCount = (UINT16)MAX (Granted, 1);
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Create io completion queue.
 
@@ -589,7 +652,7 @@ NvmeCreateIoCompletionQueue (
   Status                 = EFI_SUCCESS;
   Private->CreateIoQueue = TRUE;
 
-  for (Index = 1; Index < NVME_MAX_QUEUES; Index++) {
+  for (Index = 1; Index < NVME_ASYNC_QUEUE_ID + Private->AsyncQueueCount; Index++) {
     ZeroMem (&CommandPacket, sizeof (EFI_NVM_EXPRESS_PASS_THRU_COMMAND_PACKET));
     ZeroMem (&Command, sizeof (EFI_NVM_EXPRESS_COMMAND));
     ZeroMem (&Completion, sizeof (EFI_NVM_EXPRESS_COMPLETION));
@@ -598,22 +661,18 @@ NvmeCreateIoCompletionQueue (
     CommandPacket.NvmeCmd        = &Command;
     CommandPacket.NvmeCompletion = &Completion;
 
-    Command.Cdw0.Opcode          = NVME_ADMIN_CRIOCQ_CMD;
-    CommandPacket.TransferBuffer = Private->CqBufferPciAddr[Index];
-    CommandPacket.TransferLength = EFI_PAGE_SIZE;
-    CommandPacket.CommandTimeout = NVME_GENERIC_TIMEOUT;
-    CommandPacket.QueueType      = NVME_ADMIN_QUEUE;
-
     if (Index == 1) {
       QueueSize = NVME_CCQ_SIZE;
     } else {
-      if (Private->Cap.Mqes > NVME_ASYNC_CCQ_SIZE) {
-        QueueSize = NVME_ASYNC_CCQ_SIZE;
-      } else {
-        QueueSize = Private->Cap.Mqes;
-      }
+      QueueSize = Private->AsyncQueueSize;
     }
 
+    Command.Cdw0.Opcode          = NVME_ADMIN_CRIOCQ_CMD;
+    CommandPacket.TransferBuffer = Private->CqBufferPciAddr[Index];
+    CommandPacket.TransferLength = EFI_PAGES_TO_SIZE (NVME_CQ_PAGES (QueueSize));
+    CommandPacket.CommandTimeout = NVME_GENERIC_TIMEOUT;
+    CommandPacket.QueueType      = NVME_ADMIN_QUEUE;
+
     CrIoCq.Qid   = Index;
     CrIoCq.Qsize = QueueSize;
     CrIoCq.Pc    = 1;
@@ -661,7 +720,7 @@ NvmeCreateIoSubmissionQueue (
   Status                 = EFI_SUCCESS;
   Private->CreateIoQueue = TRUE;
 
-  for (Index = 1; Index < NVME_MAX_QUEUES; Index++) {
+  for (Index = 1; Index < NVME_ASYNC_QUEUE_ID + Private->AsyncQueueCount; Index++) {
     ZeroMem (&CommandPacket, sizeof (EFI_NVM_EXPRESS_PASS_THRU_COMMAND_PACKET));
     ZeroMem (&Command, sizeof (EFI_NVM_EXPRESS_COMMAND));
     ZeroMem (&Completion, sizeof (EFI_NVM_EXPRESS_COMPLETION));
@@ -670,22 +729,18 @@ NvmeCreateIoSubmissionQueue (
     CommandPacket.NvmeCmd        = &Command;
     CommandPacket.NvmeCompletion = &Completion;
 
-    Command.Cdw0.Opcode          = NVME_ADMIN_CRIOSQ_CMD;
-    CommandPacket.TransferBuffer = Private->SqBufferPciAddr[Index];
-    CommandPacket.TransferLength = EFI_PAGE_SIZE;
-    CommandPacket.CommandTimeout = NVME_GENERIC_TIMEOUT;
-    CommandPacket.QueueType      = NVME_ADMIN_QUEUE;
-
     if (Index == 1) {
       QueueSize = NVME_CSQ_SIZE;
     } else {
-      if (Private->Cap.Mqes > NVME_ASYNC_CSQ_SIZE) {
-        QueueSize = NVME_ASYNC_CSQ_SIZE;
-      } else {
-        QueueSize = Private->Cap.Mqes;
-      }
+      QueueSize = Private->AsyncQueueSize;
     }
 
+    Command.Cdw0.Opcode          = NVME_ADMIN_CRIOSQ_CMD;
+    CommandPacket.TransferBuffer = Private->SqBufferPciAddr[Index];
+    CommandPacket.TransferLength = EFI_PAGES_TO_SIZE (NVME_SQ_PAGES (QueueSize));
+    CommandPacket.CommandTimeout = NVME_GENERIC_TIMEOUT;
+    CommandPacket.QueueType      = NVME_ADMIN_QUEUE;
+
     CrIoSq.Qid   = Index;
     CrIoSq.Qsize = QueueSize;
     CrIoSq.Pc    = 1;
@@ -732,6 +787,8 @@ NvmeControllerInit (
   NVME_ACQ             Acq;
   UINT8                Sn[21];
   UINT8                Mn[41];
+  UINT16               Index;
+  UINTN                Offset;
 
   //
   // Enable this controller.
@@ -777,19 +834,22 @@ NvmeControllerInit (
   //
   ASSERT ((Private->Cap.Mpsmin + 12) <= EFI_PAGE_SHIFT);
 
-  Private->Cid[0]        = 0;
-  Private->Cid[1]        = 0;
-  Private->Cid[2]        = 0;
-  Private->Pt[0]         = 0;
-  Private->Pt[1]         = 0;
-  Private->Pt[2]         = 0;
-  Private->SqTdbl[0].Sqt = 0;
-  Private->SqTdbl[1].Sqt = 0;
-  Private->SqTdbl[2].Sqt = 0;
-  Private->CqHdbl[0].Cqh = 0;
-  Private->CqHdbl[1].Cqh = 0;
-  Private->CqHdbl[2].Cqh = 0;
-  Private->AsyncSqHead   = 0;
+  //
+  // The asynchronous I/O queues cannot be deeper than the controller allows.
+  //
+  if (Private->AsyncQueueSize > Private->Cap.Mqes) {
+    Private->AsyncQueueSize = Private->Cap.Mqes;
+  }
+
+  for (Index = 0; Index < NVME_MAX_QUEUES; Index++) {
+    Private->Cid[Index]         = 0;
+    Private->Pt[Index]          = 0;
+    Private->SqTdbl[Index].Sqt  = 0;
+    Private->CqHdbl[Index].Cqh  = 0;
+    Private->AsyncSqHead[Index] = 0;
+  }
+
+  Private->NextAsyncQueue = 0;
 
   Status = NvmeDisableController (Private);
 
@@ -818,7 +878,7 @@ NvmeControllerInit (
   //
   // Address of I/O submission & completion queue.
   //
-  ZeroMem (Private->Buffer, EFI_PAGES_TO_SIZE (6));
+  ZeroMem (Private->Buffer, EFI_PAGES_TO_SIZE (Private->BufferPages));
   Private->SqBuffer[0]        = (NVME_SQ *)(UINTN)(Private->Buffer);
   Private->SqBufferPciAddr[0] = (NVME_SQ *)(UINTN)(Private->BufferPciAddr);
   Private->CqBuffer[0]        = (NVME_CQ *)(UINTN)(Private->Buffer + 1 * EFI_PAGE_SIZE);
@@ -827,10 +887,18 @@ NvmeControllerInit (
   Private->SqBufferPciAddr[1] = (NVME_SQ *)(UINTN)(Private->BufferPciAddr + 2 * EFI_PAGE_SIZE);
   Private->CqBuffer[1]        = (NVME_CQ *)(UINTN)(Private->Buffer + 3 * EFI_PAGE_SIZE);
   Private->CqBufferPciAddr[1] = (NVME_CQ *)(UINTN)(Private->BufferPciAddr + 3 * EFI_PAGE_SIZE);
-  Private->SqBuffer[2]        = (NVME_SQ *)(UINTN)(Private->Buffer + 4 * EFI_PAGE_SIZE);
-  Private->SqBufferPciAddr[2] = (NVME_SQ *)(UINTN)(Private->BufferPciAddr + 4 * EFI_PAGE_SIZE);
-  Private->CqBuffer[2]        = (NVME_CQ *)(UINTN)(Private->Buffer + 5 * EFI_PAGE_SIZE);
-  Private->CqBufferPciAddr[2] = (NVME_CQ *)(UINTN)(Private->BufferPciAddr + 5 * EFI_PAGE_SIZE);
+
+  Offset = 4 * EFI_PAGE_SIZE;
+  for (Index = NVME_ASYNC_QUEUE_ID; Index < NVME_ASYNC_QUEUE_ID + Private->AsyncQueueCount; Index++) {
+    Private->SqBuffer[Index]        = (NVME_SQ *)(UINTN)(Private->Buffer + Offset);
+    Private->SqBufferPciAddr[Index] = (NVME_SQ *)(UINTN)(Private->BufferPciAddr + Offset);
+    Offset                         += EFI_PAGES_TO_SIZE (NVME_SQ_PAGES (Private->AsyncQueueSize));
+    Private->CqBuffer[Index]        = (NVME_CQ *)(UINTN)(Private->Buffer + Offset);
+    Private->CqBufferPciAddr[Index] = (NVME_CQ *)(UINTN)(Private->BufferPciAddr + Offset);
+    Offset                         += EFI_PAGES_TO_SIZE (NVME_CQ_PAGES (Private->AsyncQueueSize));
+  }
+
+  ASSERT (Offset <= EFI_PAGES_TO_SIZE (Private->BufferPages));
 
   DEBUG ((DEBUG_INFO, "Private->Buffer = [%016X]\n", (UINT64)(UINTN)Private->Buffer));
   DEBUG ((DEBUG_INFO, "Admin     Submission Queue size (Aqa.Asqs) = [%08X]\n", Aqa.Asqs));
@@ -839,8 +907,12 @@ NvmeControllerInit (
   DEBUG ((DEBUG_INFO, "Admin     Completion Queue (CqBuffer[0]) = [%016X]\n", Private->CqBuffer[0]));
   DEBUG ((DEBUG_INFO, "Sync  I/O Submission Queue (SqBuffer[1]) = [%016X]\n", Private->SqBuffer[1]));
   DEBUG ((DEBUG_INFO, "Sync  I/O Completion Queue (CqBuffer[1]) = [%016X]\n", Private->CqBuffer[1]));
-  DEBUG ((DEBUG_INFO, "Async I/O Submission Queue (SqBuffer[2]) = [%016X]\n", Private->SqBuffer[2]));
-  DEBUG ((DEBUG_INFO, "Async I/O Completion Queue (CqBuffer[2]) = [%016X]\n", Private->CqBuffer[2]));
+  for (Index = NVME_ASYNC_QUEUE_ID; Index < NVME_ASYNC_QUEUE_ID + Private->AsyncQueueCount; Index++) {
+    DEBUG ((DEBUG_INFO, "Async I/O Submission Queue (SqBuffer[%d]) = [%016X]\n", Index, Private->SqBuffer[Index]));
+    DEBUG ((DEBUG_INFO, "Async I/O Completion Queue (CqBuffer[%d]) = [%016X]\n", Index, Private->CqBuffer[Index]));
+  }
+
+  DEBUG ((DEBUG_INFO, "Async I/O Queue size = [%08X]\n", Private->AsyncQueueSize));
 
   //
   // Program admin queue attributes.
@@ -919,8 +991,21 @@ NvmeControllerInit (
   DEBUG ((DEBUG_INFO, "    NN        : 0x%x\n", Private->ControllerData->Nn));
 
   //
-  // Create two I/O completion queues.
-  // One for blocking I/O, one for non-blocking I/O.
+  // Ask for one I/O queue pair for blocking I/O and the configured number of
+  // pairs for non-blocking I/O. Controllers rejecting the request still get
+  // the single non-blocking pair the driver always used.
+  //
+  Status = NvmeSetNumberOfQueues (Private);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "NvmeControllerInit: failed to set number of queues (%r)\n", Status));
+    Private->AsyncQueueCount = 1;
+  }
+
+  DEBUG ((DEBUG_INFO, "NvmeControllerInit: %d async I/O queue pair(s)\n", Private->AsyncQueueCount));
+
+  //
+  // Create the I/O completion queues.
+  // One for blocking I/O, the others for non-blocking I/O.
   //
   Status = NvmeCreateIoCompletionQueue (Private);
   if (EFI_ERROR (Status)) {
@@ -928,8 +1013,8 @@ NvmeControllerInit (
   }
 
   //
-  // Create two I/O Submission queues.
-  // One for blocking I/O, one for non-blocking I/O.
+  // Create the I/O Submission queues.
+  // One for blocking I/O, the others for non-blocking I/O.
   //
   Status = NvmeCreateIoSubmissionQueue (Private);
 
@@ -195,6 +195,105 @@ NvmeDumpStatus (
   }
 }
 
+/**
+  Calculate the number of PRP lists needed to describe the given pages.
+
+  @param[in]     Pages               The number of pages to be transfered.
+  @param[out]    Remainder           The number of PRP entries used in the last PRP list.
+
+  @retval The number of PRP lists.
+
+**/
+UINTN
+NvmeGetPrpListNo (
+  IN  UINTN   Pages,
+  OUT UINT64  *Remainder
+  )
+{
+  UINTN  PrpEntryNo;
+  UINTN  PrpListNo;
+
+  //
+  // The number of Prp Entry in a memory page.
+  //
+  PrpEntryNo = EFI_PAGE_SIZE / sizeof (UINT64);
+
+  //
+  // Calculate total PrpList number.
+  //
+  PrpListNo = (UINTN)DivU64x64Remainder ((UINT64)Pages, (UINT64)PrpEntryNo - 1, Remainder);
+  if (PrpListNo == 0) {
+    PrpListNo = 1;
+  } else if ((*Remainder != 0) && (*Remainder != 1)) {
+    PrpListNo += 1;
+  } else if (*Remainder == 1) {
+    *Remainder = PrpEntryNo;
+  } else if (*Remainder == 0) {
+    *Remainder = PrpEntryNo - 1;
+  }
+
+  return PrpListNo;
+}
+
+/**
+  Fill the PRP lists for data transfer which is larger than 2 memory pages.
+
+  @param[in]     PrpListHost         The host base address of PRP lists.
+  @param[in]     PrpListPhyAddr      The device address of PRP lists.
+  @param[in]     PhysicalAddr        The physical base address of data buffer.
+  @param[in]     PrpListNo           The number of PRP lists.
+  @param[in]     Remainder           The number of PRP entries used in the last PRP list.
+
+**/
+VOID
+NvmeFillPrpList (
+  IN VOID                  *PrpListHost,
+  IN EFI_PHYSICAL_ADDRESS  PrpListPhyAddr,
+  IN EFI_PHYSICAL_ADDRESS  PhysicalAddr,
+  IN UINTN                 PrpListNo,
+  IN UINT64                Remainder
+  )
+{
+  UINTN   PrpEntryNo;
+  UINT64  PrpListBase;
+  UINTN   PrpListIndex;
+  UINTN   PrpEntryIndex;
+
+  PrpEntryNo = EFI_PAGE_SIZE / sizeof (UINT64);
+
+  //
+  // Fill all PRP lists except of last one.
+  //
+  ZeroMem (PrpListHost, EFI_PAGES_TO_SIZE (PrpListNo));
+  for (PrpListIndex = 0; PrpListIndex < PrpListNo - 1; ++PrpListIndex) {
+    PrpListBase = (UINT64)(UINTN)PrpListHost + PrpListIndex * EFI_PAGE_SIZE;
+
+    for (PrpEntryIndex = 0; PrpEntryIndex < PrpEntryNo; ++PrpEntryIndex) {
+      if (PrpEntryIndex != PrpEntryNo - 1) {
+        //
+        // Fill all PRP entries except of last one.
+        //
+        *((UINT64 *)(UINTN)PrpListBase + PrpEntryIndex) = PhysicalAddr;
+        PhysicalAddr                                   += EFI_PAGE_SIZE;
+      } else {
+        //
+        // Fill last PRP entries with next PRP List pointer.
+        //
+        *((UINT64 *)(UINTN)PrpListBase + PrpEntryIndex) = PrpListPhyAddr + (PrpListIndex + 1) * EFI_PAGE_SIZE;
+      }
+    }
+  }
+
+  //
+  // Fill last PRP list.
+  //
+  PrpListBase = (UINT64)(UINTN)PrpListHost + PrpListIndex * EFI_PAGE_SIZE;
+  for (PrpEntryIndex = 0; PrpEntryIndex < Remainder; ++PrpEntryIndex) {
+    *((UINT64 *)(UINTN)PrpListBase + PrpEntryIndex) = PhysicalAddr;
+    PhysicalAddr                                   += EFI_PAGE_SIZE;
+  }
+}
+
 /**
   Create PRP lists for data transfer which is larger than 2 memory pages.
   Note here we calcuate the number of required PRP lists and allocate them at one time.
@@ -219,33 +318,12 @@ NvmeCreatePrpList (
   OUT VOID                     **Mapping
   )
 {
-  UINTN                 PrpEntryNo;
-  UINT64                PrpListBase;
-  UINTN                 PrpListIndex;
-  UINTN                 PrpEntryIndex;
   UINT64                Remainder;
   EFI_PHYSICAL_ADDRESS  PrpListPhyAddr;
   UINTN                 Bytes;
   EFI_STATUS            Status;
 
-  //
-  // The number of Prp Entry in a memory page.
-  //
-  PrpEntryNo = EFI_PAGE_SIZE / sizeof (UINT64);
-
-  //
-  // Calculate total PrpList number.
-  //
-  *PrpListNo = (UINTN)DivU64x64Remainder ((UINT64)Pages, (UINT64)PrpEntryNo - 1, &Remainder);
-  if (*PrpListNo == 0) {
-    *PrpListNo = 1;
-  } else if ((Remainder != 0) && (Remainder != 1)) {
-    *PrpListNo += 1;
-  } else if (Remainder == 1) {
-    Remainder = PrpEntryNo;
-  } else if (Remainder == 0) {
-    Remainder = PrpEntryNo - 1;
-  }
+  *PrpListNo = NvmeGetPrpListNo (Pages, &Remainder);
 
   Status = PciIo->AllocateBuffer (
                     PciIo,
@@ -275,43 +353,157 @@ NvmeCreatePrpList (
     goto EXIT;
   }
 
-  //
-  // Fill all PRP lists except of last one.
-  //
-  ZeroMem (*PrpListHost, Bytes);
-  for (PrpListIndex = 0; PrpListIndex < *PrpListNo - 1; ++PrpListIndex) {
-    PrpListBase = *(UINT64 *)PrpListHost + PrpListIndex * EFI_PAGE_SIZE;
+  NvmeFillPrpList (*PrpListHost, PrpListPhyAddr, PhysicalAddr, *PrpListNo, Remainder);
 
-    for (PrpEntryIndex = 0; PrpEntryIndex < PrpEntryNo; ++PrpEntryIndex) {
-      if (PrpEntryIndex != PrpEntryNo - 1) {
-        //
-        // Fill all PRP entries except of last one.
-        //
-        *((UINT64 *)(UINTN)PrpListBase + PrpEntryIndex) = PhysicalAddr;
-        PhysicalAddr                                   += EFI_PAGE_SIZE;
-      } else {
-        //
-        // Fill last PRP entries with next PRP List pointer.
-        //
-        *((UINT64 *)(UINTN)PrpListBase + PrpEntryIndex) = PrpListPhyAddr + (PrpListIndex + 1) * EFI_PAGE_SIZE;
+  return (VOID *)(UINTN)PrpListPhyAddr;
+
+EXIT:
+  PciIo->FreeBuffer (PciIo, *PrpListNo, *PrpListHost);
+  *PrpListHost = NULL;
+  return NULL;
+}
+
+/**
+  Build the PRP lists for a blocking command in the PRP list pool of the
+  controller, growing the pool if it is too small.
+
+  The pool stays allocated and mapped until the controller is stopped, so
+  that blocking commands don't allocate and map PRP lists one at a time.
+
+  @param[in]     Private             The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+  @param[in]     PhysicalAddr        The physical base address of data buffer.
+  @param[in]     Pages               The number of pages to be transfered.
+
+  @retval The pointer to the first PRP List of the PRP lists, or NULL if the
+          pool cannot be used.
+
+**/
+VOID *
+NvmeCreatePooledPrpList (
+  IN NVME_CONTROLLER_PRIVATE_DATA  *Private,
+  IN EFI_PHYSICAL_ADDRESS          PhysicalAddr,
+  IN UINTN                         Pages
+  )
+{
+  EFI_PCI_IO_PROTOCOL  *PciIo;
+  UINTN                PrpListNo;
+  UINT64               Remainder;
+  UINTN                Bytes;
+  EFI_STATUS           Status;
+
+  if (Private->PrpListPoolBusy) {
+    return NULL;
+  }
+
+  PciIo     = Private->PciIo;
+  PrpListNo = NvmeGetPrpListNo (Pages, &Remainder);
+
+  if (PrpListNo > Private->PrpListPoolPages) {
+    NvmeFreePrpListPool (Private);
+
+    Status = PciIo->AllocateBuffer (
+                      PciIo,
+                      AllocateAnyPages,
+                      EfiBootServicesData,
+                      PrpListNo,
+                      &Private->PrpListPool,
+                      0
+                      );
+    if (EFI_ERROR (Status)) {
+      Private->PrpListPool = NULL;
+      return NULL;
+    }
+
+    Private->PrpListPoolPages = PrpListNo;
+
+    Bytes  = EFI_PAGES_TO_SIZE (PrpListNo);
+    Status = PciIo->Map (
+                      PciIo,
+                      EfiPciIoOperationBusMasterCommonBuffer,
+                      Private->PrpListPool,
+                      &Bytes,
+                      &Private->PrpListPoolPciAddr,
+                      &Private->PrpListPoolMapping
+                      );
+    if (EFI_ERROR (Status) || (Bytes != EFI_PAGES_TO_SIZE (PrpListNo))) {
+      if (!EFI_ERROR (Status)) {
+        PciIo->Unmap (PciIo, Private->PrpListPoolMapping);
       }
+
+      Private->PrpListPoolMapping = NULL;
+      NvmeFreePrpListPool (Private);
+      return NULL;
     }
   }
 
+  NvmeFillPrpList (Private->PrpListPool, Private->PrpListPoolPciAddr, PhysicalAddr, PrpListNo, Remainder);
+  Private->PrpListPoolBusy = TRUE;
+
+  return (VOID *)(UINTN)Private->PrpListPoolPciAddr;
+}
+
+/**
+  Free the PRP list pool of the controller.
+
+  @param[in]     Private             The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+
+**/
+VOID
+NvmeFreePrpListPool (
+  IN NVME_CONTROLLER_PRIVATE_DATA  *Private
+  )
+{
+  if (Private->PrpListPoolMapping != NULL) {
+    Private->PciIo->Unmap (Private->PciIo, Private->PrpListPoolMapping);
+    Private->PrpListPoolMapping = NULL;
+  }
+
+  if (Private->PrpListPool != NULL) {
+    Private->PciIo->FreeBuffer (Private->PciIo, Private->PrpListPoolPages, Private->PrpListPool);
+    Private->PrpListPool = NULL;
+  }
+
+  Private->PrpListPoolPages = 0;
+}
+
+/**
+  Check whether the data of a command can be described by a single SGL Data
+  Block descriptor instead of PRP entries.
+
+  @param[in]     Private             The pointer to the NVME_CONTROLLER_PRIVATE_DATA data structure.
+  @param[in]     Packet              A pointer to the NVM Express Command Packet.
+  @param[in]     DataAddr            The device address of the data buffer.
+
+  @retval TRUE   A SGL can be used.
+  @retval FALSE  PRP entries must be used.
+
+**/
+BOOLEAN
+NvmeSglUsable (
+  IN NVME_CONTROLLER_PRIVATE_DATA              *Private,
+  IN EFI_NVM_EXPRESS_PASS_THRU_COMMAND_PACKET  *Packet,
+  IN UINT64                                    DataAddr
+  )
+{
+  UINT32  SglSupport;
+
   //
-  // Fill last PRP list.
+  // SGLs are only supported for the I/O commands of the NVM command set.
   //
-  PrpListBase = *(UINT64 *)PrpListHost + PrpListIndex * EFI_PAGE_SIZE;
-  for (PrpEntryIndex = 0; PrpEntryIndex < Remainder; ++PrpEntryIndex) {
-    *((UINT64 *)(UINTN)PrpListBase + PrpEntryIndex) = PhysicalAddr;
-    PhysicalAddr                                   += EFI_PAGE_SIZE;
+  if ((Packet->QueueType != NVME_IO_QUEUE) || (Private->ControllerData == NULL)) {
+    return FALSE;
   }
 
-  return (VOID *)(UINTN)PrpListPhyAddr;
+  SglSupport = Private->ControllerData->Sgls & NVME_SGLS_SUPPORT_MASK;
+  if (SglSupport == NVME_SGLS_SUPPORTED) {
+    return TRUE;
+  }
 
-EXIT:
-  PciIo->FreeBuffer (PciIo, *PrpListNo, *PrpListHost);
-  return NULL;
+  if (SglSupport == NVME_SGLS_SUPPORTED_DWORD_ALIGNED) {
+    return (BOOLEAN)(((DataAddr & 0x3) == 0) && ((Packet->TransferLength & 0x3) == 0));
+  }
+
+  return FALSE;
 }
 
 /**
@@ -463,7 +655,10 @@ NvmExpressPassThru (
   volatile NVME_CQ               *Cq;
   UINT16                         QueueId;
   UINT16                         QueueSize;
+  UINT16                         Index;
   UINT32                         Bytes;
+  BOOLEAN                        PrpListPooled;
+  NVME_SGL_DESCRIPTOR            *Sgl;
   UINT16                         Offset;
   EFI_EVENT                      TimerEvent;
   EFI_PCI_IO_PROTOCOL_OPERATION  Flag;
@@ -553,7 +748,9 @@ NvmExpressPassThru (
   Prp         = NULL;
   TimerEvent  = NULL;
   Status      = EFI_SUCCESS;
-  QueueSize   = MIN (NVME_ASYNC_CSQ_SIZE, Private->Cap.Mqes) + 1;
+
+  PrpListPooled = FALSE;
+  QueueSize   = Private->AsyncQueueSize + 1;
 
   if (Packet->QueueType == NVME_ADMIN_QUEUE) {
     QueueId = 0;
@@ -561,16 +758,24 @@ NvmExpressPassThru (
     if (Event == NULL) {
       QueueId = 1;
     } else {
-      QueueId = 2;
-
       //
-      // Submission queue full check.
+      // Pick the asynchronous I/O queue pairs in round-robin order, skipping
+      // the ones whose submission queue is full.
       //
-      if ((Private->SqTdbl[QueueId].Sqt + 1) % QueueSize ==
-          Private->AsyncSqHead)
-      {
+      for (Index = 0; Index < Private->AsyncQueueCount; Index++) {
+        QueueId = (UINT16)(NVME_ASYNC_QUEUE_ID + (Private->NextAsyncQueue + Index) % Private->AsyncQueueCount);
+        if ((Private->SqTdbl[QueueId].Sqt + 1) % QueueSize !=
+            Private->AsyncSqHead[QueueId])
+        {
+          break;
+        }
+      }
+
+      if (Index == Private->AsyncQueueCount) {
         return EFI_NOT_READY;
       }
+
+      Private->NextAsyncQueue = (UINT16)((QueueId - NVME_ASYNC_QUEUE_ID + 1) % Private->AsyncQueueCount);
     }
   }
 
@@ -670,20 +875,39 @@ NvmExpressPassThru (
 
   //
   // If the buffer size spans more than two memory pages (page size as defined in CC.Mps),
-  // then build a PRP list in the second PRP submission queue entry.
+  // then describe it with a single SGL Data Block descriptor when the controller
+  // supports SGLs, or build a PRP list in the second PRP submission queue entry.
   //
   Offset = ((UINT16)Sq->Prp[0]) & (EFI_PAGE_SIZE - 1);
   Bytes  = Packet->TransferLength;
 
-  if ((Offset + Bytes) > (EFI_PAGE_SIZE * 2)) {
+  if (((Offset + Bytes) > (EFI_PAGE_SIZE * 2)) && (MapData != NULL) &&
+      NvmeSglUsable (Private, Packet, Sq->Prp[0]))
+  {
+    //
+    // The mapped data address is already in place of the descriptor address.
     //
-    // Create PrpList for remaining data buffer.
+    Sgl             = (NVME_SGL_DESCRIPTOR *)Sq->Prp;
+    Sgl->Length     = Bytes;
+    Sgl->Identifier = NVME_SGL_DATA_BLOCK_DESCRIPTOR;
+    Sq->Psdt        = NVME_PSDT_SGL_MPTR_CONTIGUOUS;
+  } else if ((Offset + Bytes) > (EFI_PAGE_SIZE * 2)) {
+    //
+    // Create PrpList for remaining data buffer. Blocking commands use the PRP
+    // list pool of the controller when it is free.
     //
     PhyAddr = (Sq->Prp[0] + EFI_PAGE_SIZE) & ~(EFI_PAGE_SIZE - 1);
-    Prp     = NvmeCreatePrpList (PciIo, PhyAddr, EFI_SIZE_TO_PAGES (Offset + Bytes) - 1, &PrpListHost, &PrpListNo, &MapPrpList);
+    if ((Event == NULL) || (QueueId == 0)) {
+      Prp           = NvmeCreatePooledPrpList (Private, PhyAddr, EFI_SIZE_TO_PAGES (Offset + Bytes) - 1);
+      PrpListPooled = (BOOLEAN)(Prp != NULL);
+    }
+
     if (Prp == NULL) {
-      Status = EFI_OUT_OF_RESOURCES;
-      goto EXIT;
+      Prp = NvmeCreatePrpList (PciIo, PhyAddr, EFI_SIZE_TO_PAGES (Offset + Bytes) - 1, &PrpListHost, &PrpListNo, &MapPrpList);
+      if (Prp == NULL) {
+        Status = EFI_OUT_OF_RESOURCES;
+        goto EXIT;
+      }
     }
 
     Sq->Prp[1] = (UINT64)(UINTN)Prp;
@@ -760,6 +984,7 @@ NvmExpressPassThru (
 
     AsyncRequest->Signature   = NVME_PASS_THRU_ASYNC_REQ_SIG;
     AsyncRequest->Packet      = Packet;
+    AsyncRequest->QueueId     = QueueId;
     AsyncRequest->CommandId   = Sq->Cid;
     AsyncRequest->CallerEvent = Event;
     AsyncRequest->MapData     = MapData;
@@ -914,10 +1139,14 @@ EXIT:
              );
   }
 
-  if (Prp != NULL) {
+  if (PrpListHost != NULL) {
     PciIo->FreeBuffer (PciIo, PrpListNo, PrpListHost);
   }
 
+  if (PrpListPooled) {
+    Private->PrpListPoolBusy = FALSE;
+  }
+
   if (TimerEvent != NULL) {
     gBS->CloseEvent (TimerEvent);
   }
@@ -549,7 +549,9 @@ NvmeCreateDeviceInstance (
   Private->CqHdbl[0].Cqh = 0;
   Private->CqHdbl[1].Cqh = 0;
   Private->CqHdbl[2].Cqh = 0;
-  Private->AsyncSqHead   = 0;
+
+  Private->AsyncSqHead[2]  = 0;
+  Private->AsyncQueueCount = 1;
 
   Private->ControllerData = (NVME_ADMIN_CONTROLLER_DATA *)AllocateZeroPool (sizeof (NVME_ADMIN_CONTROLLER_DATA));
 
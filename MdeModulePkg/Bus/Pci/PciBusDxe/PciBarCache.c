@@ -0,0 +1,310 @@
+/** @file
+  PCI BAR sizing cache for PCI Bus module.
+
+  Sizing a BAR takes a read, two writes and a read-back of configuration
+  space. When PcdPciBarProbeCache is TRUE, the read-back values of every
+  function are kept in a non-volatile variable. A function found at the same
+  location with the same vendor, device, subsystem, revision and class codes
+  on the next boot reuses them and only has its BARs read.
+
+Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "PciBus.h"
+
+//
+// Results stored by the previous boot, and which of them have been matched
+// against a function found by this enumeration.
+//
+PCI_BAR_CACHE_ENTRY  *mPciBarCache;
+BOOLEAN              *mPciBarCacheUsed;
+UINTN                mPciBarCacheCount;
+
+//
+// Results of this enumeration.
+//
+PCI_BAR_CACHE_ENTRY  *mPciBarCacheNew;
+UINTN                mPciBarCacheNewCount;
+BOOLEAN              mPciBarCacheChanged;
+
+/**
+  Check whether a configuration space offset is one of the type 0 header BARs.
+
+  @param Offset   Configuration space offset.
+
+  @retval TRUE    Offset is a BAR.
+  @retval FALSE   Offset is not a BAR.
+
+**/
+BOOLEAN
+PciBarCacheIsBarOffset (
+  IN UINTN  Offset
+  )
+{
+  return (BOOLEAN)((Offset >= PCI_BASE_ADDRESSREG_OFFSET) &&
+                   (Offset < PCI_BASE_ADDRESSREG_OFFSET + PCI_MAX_BAR * sizeof (UINT32)) &&
+                   ((Offset & (sizeof (UINT32) - 1)) == 0));
+}
+
+/**
+  Load the BAR sizing results recorded by the previous boot.
+
+  Does nothing unless PcdPciBarProbeCache is TRUE.
+
+**/
+VOID
+PciBarCacheLoad (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Size;
+
+  if (!PcdGetBool (PcdPciBarProbeCache)) {
+    return;
+  }
+
+  mPciBarCacheNew = AllocateZeroPool (PCI_BAR_CACHE_MAX_ENTRIES * sizeof (PCI_BAR_CACHE_ENTRY));
+  if (mPciBarCacheNew == NULL) {
+    return;
+  }
+
+  mPciBarCacheNewCount = 0;
+  mPciBarCacheChanged  = FALSE;
+  mPciBarCache         = NULL;
+  mPciBarCacheUsed     = NULL;
+  mPciBarCacheCount    = 0;
+
+  Status = GetVariable2 (PCI_BAR_CACHE_VARIABLE_NAME, &gEfiCallerIdGuid, (VOID **)&mPciBarCache, &Size);
+  if (!EFI_ERROR (Status) &&
+      (Size != 0) &&
+      (Size <= PCI_BAR_CACHE_MAX_ENTRIES * sizeof (PCI_BAR_CACHE_ENTRY)) &&
+      ((Size % sizeof (PCI_BAR_CACHE_ENTRY)) == 0))
+  {
+    mPciBarCacheUsed = AllocateZeroPool (Size / sizeof (PCI_BAR_CACHE_ENTRY) * sizeof (BOOLEAN));
+    if (mPciBarCacheUsed != NULL) {
+      mPciBarCacheCount = Size / sizeof (PCI_BAR_CACHE_ENTRY);
+      return;
+    }
+  }
+
+  if (mPciBarCache != NULL) {
+    FreePool (mPciBarCache);
+    mPciBarCache = NULL;
+  }
+
+  //
+  // Nothing usable is stored, so whatever this enumeration finds is new.
+  //
+  mPciBarCacheChanged = TRUE;
+}
+
+/**
+  Store the BAR sizing results of this enumeration for the next boot and
+  release the cache.
+
+  @param Commit   TRUE to write the results if they differ from the stored
+                  ones, FALSE to only release the cache.
+
+**/
+VOID
+PciBarCacheComplete (
+  IN BOOLEAN  Commit
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Index;
+
+  if (mPciBarCacheNew == NULL) {
+    return;
+  }
+
+  if (Commit && mPciBarCacheChanged) {
+    //
+    // Keep the results of functions this enumeration did not see, they may
+    // belong to another host bridge.
+    //
+    for (Index = 0; Index < mPciBarCacheCount && mPciBarCacheNewCount < PCI_BAR_CACHE_MAX_ENTRIES; Index++) {
+      if (!mPciBarCacheUsed[Index]) {
+        CopyMem (&mPciBarCacheNew[mPciBarCacheNewCount], &mPciBarCache[Index], sizeof (PCI_BAR_CACHE_ENTRY));
+        mPciBarCacheNewCount++;
+      }
+    }
+
+    Status = gRT->SetVariable (
+                    PCI_BAR_CACHE_VARIABLE_NAME,
+                    &gEfiCallerIdGuid,
+                    EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS,
+                    mPciBarCacheNewCount * sizeof (PCI_BAR_CACHE_ENTRY),
+                    mPciBarCacheNew
+                    );
+    DEBUG ((DEBUG_INFO, "PciBus: Saved BAR sizing of %d functions - %r\n", mPciBarCacheNewCount, Status));
+  }
+
+  if (mPciBarCache != NULL) {
+    FreePool (mPciBarCache);
+    FreePool (mPciBarCacheUsed);
+  }
+
+  FreePool (mPciBarCacheNew);
+  mPciBarCache         = NULL;
+  mPciBarCacheUsed     = NULL;
+  mPciBarCacheCount    = 0;
+  mPciBarCacheNew      = NULL;
+  mPciBarCacheNewCount = 0;
+}
+
+/**
+  Start recording the BAR sizing of a PCI function, and look it up in the
+  results of the previous boot.
+
+  @param PciIoDevice   PCI function whose BARs are about to be parsed.
+
+**/
+VOID
+PciBarCacheBegin (
+  IN PCI_IO_DEVICE  *PciIoDevice
+  )
+{
+  PCI_BAR_CACHE_ENTRY  Key;
+  PCI_BAR_CACHE_ENTRY  *Entry;
+  UINTN                Index;
+
+  PciIoDevice->BarCacheEntry = NULL;
+  PciIoDevice->BarCacheHit   = FALSE;
+
+  //
+  // Resizable BARs change size during enumeration, always probe them.
+  //
+  if ((mPciBarCacheNew == NULL) || (PciIoDevice->ResizableBarOffset != 0)) {
+    return;
+  }
+
+  ZeroMem (&Key, sizeof (Key));
+  Key.Segment           = (UINT16)PciIoDevice->PciRootBridgeIo->SegmentNumber;
+  Key.Bus               = PciIoDevice->BusNumber;
+  Key.Device            = PciIoDevice->DeviceNumber;
+  Key.Function          = PciIoDevice->FunctionNumber;
+  Key.RevisionId        = PciIoDevice->Pci.Hdr.RevisionID;
+  Key.VendorId          = PciIoDevice->Pci.Hdr.VendorId;
+  Key.DeviceId          = PciIoDevice->Pci.Hdr.DeviceId;
+  Key.SubsystemVendorId = PciIoDevice->Pci.Device.SubsystemVendorID;
+  Key.SubsystemId       = PciIoDevice->Pci.Device.SubsystemID;
+  CopyMem (Key.ClassCode, PciIoDevice->Pci.Hdr.ClassCode, sizeof (Key.ClassCode));
+
+  //
+  // A function is gathered again when its bus is re-enumerated, reuse its entry.
+  //
+  for (Index = 0; Index < mPciBarCacheNewCount; Index++) {
+    if ((mPciBarCacheNew[Index].Segment == Key.Segment) &&
+        (mPciBarCacheNew[Index].Bus == Key.Bus) &&
+        (mPciBarCacheNew[Index].Device == Key.Device) &&
+        (mPciBarCacheNew[Index].Function == Key.Function))
+    {
+      break;
+    }
+  }
+
+  if (Index == mPciBarCacheNewCount) {
+    if (mPciBarCacheNewCount == PCI_BAR_CACHE_MAX_ENTRIES) {
+      return;
+    }
+
+    mPciBarCacheNewCount++;
+  }
+
+  Entry = &mPciBarCacheNew[Index];
+  CopyMem (Entry, &Key, sizeof (Key));
+
+  for (Index = 0; Index < mPciBarCacheCount; Index++) {
+    if ((mPciBarCache[Index].Segment != Key.Segment) ||
+        (mPciBarCache[Index].Bus != Key.Bus) ||
+        (mPciBarCache[Index].Device != Key.Device) ||
+        (mPciBarCache[Index].Function != Key.Function))
+    {
+      continue;
+    }
+
+    //
+    // Whatever was stored for this location is superseded by this boot.
+    //
+    mPciBarCacheUsed[Index] = TRUE;
+    if (CompareMem (&mPciBarCache[Index], &Key, OFFSET_OF (PCI_BAR_CACHE_ENTRY, BarValue)) == 0) {
+      CopyMem (Entry->BarValue, mPciBarCache[Index].BarValue, sizeof (Entry->BarValue));
+      PciIoDevice->BarCacheHit = TRUE;
+    }
+
+    break;
+  }
+
+  if (!PciIoDevice->BarCacheHit) {
+    mPciBarCacheChanged = TRUE;
+  }
+
+  PciIoDevice->BarCacheEntry = Entry;
+}
+
+/**
+  Stop recording the BAR sizing of a PCI function.
+
+  @param PciIoDevice   PCI function whose BARs have been parsed.
+
+**/
+VOID
+PciBarCacheEnd (
+  IN PCI_IO_DEVICE  *PciIoDevice
+  )
+{
+  PciIoDevice->BarCacheEntry = NULL;
+  PciIoDevice->BarCacheHit   = FALSE;
+}
+
+/**
+  Get the sizing value of a BAR from the previous boot.
+
+  @param PciIoDevice   PCI function the BAR belongs to.
+  @param Offset        Configuration space offset of the BAR.
+  @param Value         Value the BAR read back after writing all ones to it.
+
+  @retval TRUE    Value is returned from the cache, the BAR need not be probed.
+  @retval FALSE   The BAR must be probed.
+
+**/
+BOOLEAN
+PciBarCacheLookup (
+  IN  PCI_IO_DEVICE  *PciIoDevice,
+  IN  UINTN          Offset,
+  OUT UINT32         *Value
+  )
+{
+  if ((PciIoDevice->BarCacheEntry == NULL) || !PciIoDevice->BarCacheHit || !PciBarCacheIsBarOffset (Offset)) {
+    return FALSE;
+  }
+
+  *Value = PciIoDevice->BarCacheEntry->BarValue[(Offset - PCI_BASE_ADDRESSREG_OFFSET) / sizeof (UINT32)];
+  return TRUE;
+}
+
+/**
+  Record the sizing value of a probed BAR.
+
+  @param PciIoDevice   PCI function the BAR belongs to.
+  @param Offset        Configuration space offset of the BAR.
+  @param Value         Value the BAR read back after writing all ones to it.
+
+**/
+VOID
+PciBarCacheUpdate (
+  IN PCI_IO_DEVICE  *PciIoDevice,
+  IN UINTN          Offset,
+  IN UINT32         Value
+  )
+{
+  if ((PciIoDevice->BarCacheEntry == NULL) || !PciBarCacheIsBarOffset (Offset)) {
+    return;
+  }
+
+  PciIoDevice->BarCacheEntry->BarValue[(Offset - PCI_BASE_ADDRESSREG_OFFSET) / sizeof (UINT32)] = Value;
+}
@@ -0,0 +1,117 @@
+/** @file
+  PCI BAR sizing cache functions declaration for PCI Bus module.
+
+Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _EFI_PCI_BAR_CACHE_H_
+#define _EFI_PCI_BAR_CACHE_H_
+
+#define PCI_BAR_CACHE_VARIABLE_NAME  L"PciBarCache"
+#define PCI_BAR_CACHE_MAX_ENTRIES    128
+
+//
+// Sizing result of one PCI function. The identity fields must all match the
+// function found at the same location before the cached values are used.
+//
+typedef struct {
+  UINT16    Segment;
+  UINT8     Bus;
+  UINT8     Device;
+  UINT8     Function;
+  UINT8     RevisionId;
+  UINT8     ClassCode[3];
+  UINT8     Reserved[3];
+  UINT16    VendorId;
+  UINT16    DeviceId;
+  UINT16    SubsystemVendorId;
+  UINT16    SubsystemId;
+  //
+  // Value read back from each BAR after writing all ones to it
+  //
+  UINT32    BarValue[PCI_MAX_BAR];
+} PCI_BAR_CACHE_ENTRY;
+
+/**
+  Load the BAR sizing results recorded by the previous boot.
+
+  Does nothing unless PcdPciBarProbeCache is TRUE.
+
+**/
+VOID
+PciBarCacheLoad (
+  VOID
+  );
+
+/**
+  Store the BAR sizing results of this enumeration for the next boot and
+  release the cache.
+
+  @param Commit   TRUE to write the results if they differ from the stored
+                  ones, FALSE to only release the cache.
+
+**/
+VOID
+PciBarCacheComplete (
+  IN BOOLEAN  Commit
+  );
+
+/**
+  Start recording the BAR sizing of a PCI function, and look it up in the
+  results of the previous boot.
+
+  @param PciIoDevice   PCI function whose BARs are about to be parsed.
+
+**/
+VOID
+PciBarCacheBegin (
+  IN PCI_IO_DEVICE  *PciIoDevice
+  );
+
+/**
+  Stop recording the BAR sizing of a PCI function.
+
+  @param PciIoDevice   PCI function whose BARs have been parsed.
+
+**/
+VOID
+PciBarCacheEnd (
+  IN PCI_IO_DEVICE  *PciIoDevice
+  );
+
+/**
+  Get the sizing value of a BAR from the previous boot.
+
+  @param PciIoDevice   PCI function the BAR belongs to.
+  @param Offset        Configuration space offset of the BAR.
+  @param Value         Value the BAR read back after writing all ones to it.
+
+  @retval TRUE    Value is returned from the cache, the BAR need not be probed.
+  @retval FALSE   The BAR must be probed.
+
+**/
+BOOLEAN
+PciBarCacheLookup (
+  IN  PCI_IO_DEVICE  *PciIoDevice,
+  IN  UINTN          Offset,
+  OUT UINT32         *Value
+  );
+
+/**
+  Record the sizing value of a probed BAR.
+
+  @param PciIoDevice   PCI function the BAR belongs to.
+  @param Offset        Configuration space offset of the BAR.
+  @param Value         Value the BAR read back after writing all ones to it.
+
+**/
+VOID
+PciBarCacheUpdate (
+  IN PCI_IO_DEVICE  *PciIoDevice,
+  IN UINTN          Offset,
+  IN UINT32         Value
+  );
+
+#endif
@@ -36,6 +36,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/ReportStatusCodeLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiRuntimeServicesTableLib.h>
 #include <Library/DevicePathLib.h>
 #include <Library/PcdLib.h>
 
@@ -79,6 +80,7 @@ typedef enum {
 #include "PciPowerManagement.h"
 #include "PciHotPlugSupport.h"
 #include "PciLib.h"
+#include "PciBarCache.h"
 
 #define VGABASE1   0x3B0
 #define VGALIMIT1  0x3BB
@@ -243,6 +245,12 @@ struct _PCI_IO_DEVICE {
   //
   BOOLEAN                                      BusOverride;
 
+  //
+  // TRUE if the EFI drivers in the OptionRom are dispatched on the first
+  // GetDriver() call rather than during enumeration
+  //
+  BOOLEAN                                      OpRomDispatchDeferred;
+
   //
   // A list tracking reserved resource on a bridge device
   //
@@ -282,6 +290,12 @@ struct _PCI_IO_DEVICE {
   UINT16                                       BridgeIoAlignment;
   UINT32                                       ResizableBarOffset;
   UINT32                                       ResizableBarNumber;
+
+  //
+  // BAR sizing cache entry of this function while its BARs are parsed
+  //
+  PCI_BAR_CACHE_ENTRY                          *BarCacheEntry;
+  BOOLEAN                                      BarCacheHit;
 };
 
 #define PCI_IO_DEVICE_FROM_PCI_IO_THIS(a) \
@@ -262,3 +262,65 @@ LocatePciExpressCapabilityRegBlock (
 
   return EFI_NOT_FOUND;
 }
+
+/**
+  Locate the PciExpress capability register blocks of several capability IDs
+  with a single walk of the extended capability list.
+
+  @param PciIoDevice       A pointer to the PCI_IO_DEVICE.
+  @param CapIds            The capability IDs to look for.
+  @param Offsets           Returns the offset of the first register block of
+                           each capability ID, or 0 if it is not found.
+  @param Count             The number of entries in CapIds and Offsets.
+
+**/
+VOID
+LocatePciExpressCapabilityRegBlocks (
+  IN     PCI_IO_DEVICE  *PciIoDevice,
+  IN     CONST UINT16   *CapIds,
+  OUT    UINT32         *Offsets,
+  IN     UINTN          Count
+  )
+{
+  EFI_STATUS  Status;
+  UINT32      CapabilityPtr;
+  UINT32      CapabilityEntry;
+  UINT16      CapabilityID;
+  UINTN       Index;
+  UINTN       Remaining;
+
+  ZeroMem (Offsets, Count * sizeof (*Offsets));
+
+  if (!PciIoDevice->IsPciExp) {
+    return;
+  }
+
+  Remaining     = Count;
+  CapabilityPtr = EFI_PCIE_CAPABILITY_BASE_OFFSET;
+  while ((CapabilityPtr != 0) && (Remaining != 0)) {
+    //
+    // Mask it to DWORD alignment per PCI spec
+    //
+    CapabilityPtr &= 0xFFC;
+    Status         = PciIoDevice->PciIo.Pci.Read (
+                                              &PciIoDevice->PciIo,
+                                              EfiPciIoWidthUint32,
+                                              CapabilityPtr,
+                                              1,
+                                              &CapabilityEntry
+                                              );
+    if (EFI_ERROR (Status) || (CapabilityEntry == MAX_UINT32)) {
+      break;
+    }
+
+    CapabilityID = (UINT16)CapabilityEntry;
+    for (Index = 0; Index < Count; Index++) {
+      if ((Offsets[Index] == 0) && (CapIds[Index] == CapabilityID)) {
+        Offsets[Index] = CapabilityPtr;
+        Remaining--;
+      }
+    }
+
+    CapabilityPtr = (CapabilityEntry >> 20) & 0xFFF;
+  }
+}
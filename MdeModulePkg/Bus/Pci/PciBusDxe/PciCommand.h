@@ -131,6 +131,25 @@ LocatePciExpressCapabilityRegBlock (
   OUT UINT32            *NextRegBlock OPTIONAL
   );
 
+/**
+  Locate the PciExpress capability register blocks of several capability IDs
+  with a single walk of the extended capability list.
+
+  @param PciIoDevice       A pointer to the PCI_IO_DEVICE.
+  @param CapIds            The capability IDs to look for.
+  @param Offsets           Returns the offset of the first register block of
+                           each capability ID, or 0 if it is not found.
+  @param Count             The number of entries in CapIds and Offsets.
+
+**/
+VOID
+LocatePciExpressCapabilityRegBlocks (
+  IN     PCI_IO_DEVICE  *PciIoDevice,
+  IN     CONST UINT16   *CapIds,
+  OUT    UINT32         *Offsets,
+  IN     UINTN          Count
+  );
+
 /**
   Macro that reads command register.
 
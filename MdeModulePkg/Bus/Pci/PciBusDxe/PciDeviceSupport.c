@@ -328,11 +328,20 @@ RegisterPciDevice (
     // The OpRom is got from platform in the above code
     // or loaded from device in the previous round of bus enumeration
     //
-    if (HasEfiImage) {
+    if (HasEfiImage && !PcdGetBool (PcdPciDeferOptionRomDispatch)) {
       ProcessOpRomImage (PciIoDevice);
     }
   }
 
+  //
+  // When OpRom dispatch is deferred, GetDriver() loads and starts the EFI
+  // OpRom the first time the device is connected.
+  //
+  if (HasEfiImage && PcdGetBool (PcdPciDeferOptionRomDispatch) && IsListEmpty (&PciIoDevice->OptionRomDriverList)) {
+    PciIoDevice->OpRomDispatchDeferred = TRUE;
+    PciIoDevice->BusOverride           = TRUE;
+  }
+
   if (PciIoDevice->BusOverride) {
     //
     // Install Bus Specific Driver Override Protocol
@@ -106,6 +106,14 @@ GetDriver (
   Override    = NULL;
   PciIoDevice = PCI_IO_DEVICE_FROM_PCI_DRIVER_OVERRIDE_THIS (This);
   ReturnNext  = (BOOLEAN)(*DriverImageHandle == NULL);
+
+  //
+  // The device is being connected, dispatch the OpRom drivers left for now.
+  //
+  if (PciIoDevice->OpRomDispatchDeferred) {
+    PciIoDevice->OpRomDispatchDeferred = FALSE;
+    ProcessOpRomImage (PciIoDevice);
+  }
   for ( Link = GetFirstNode (&PciIoDevice->OptionRomDriverList)
         ; !IsNull (&PciIoDevice->OptionRomDriverList, Link)
         ; Link = GetNextNode (&PciIoDevice->OptionRomDriverList, Link)
@@ -57,7 +57,9 @@ PciEnumerator (
   //
   // Start the bus allocation phase
   //
+  PciBarCacheLoad ();
   Status = PciHostBridgeEnumerator (PciResAlloc);
+  PciBarCacheComplete ((BOOLEAN)!EFI_ERROR (Status));
 
   if (EFI_ERROR (Status)) {
     return Status;
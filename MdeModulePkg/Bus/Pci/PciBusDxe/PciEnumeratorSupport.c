@@ -18,6 +18,22 @@ extern EDKII_DEVICE_SECURITY_PROTOCOL  *mDeviceSecurityProtocol;
 #define SQUAD_ALIGN  0xFFFFFFFFFFFFFFFDULL
 #define DQUAD_ALIGN  0xFFFFFFFFFFFFFFFCULL
 
+//
+// Extended capabilities looked up by CreatePciIoDevice(), indexed by the
+// EXTENDED_CAP_* values below
+//
+#define EXTENDED_CAP_ARI            0
+#define EXTENDED_CAP_SRIOV          1
+#define EXTENDED_CAP_MRIOV          2
+#define EXTENDED_CAP_RESIZABLE_BAR  3
+
+STATIC CONST UINT16  mExtendedCapIds[] = {
+  EFI_PCIE_CAPABILITY_ID_ARI,
+  EFI_PCIE_CAPABILITY_ID_SRIOV,
+  EFI_PCIE_CAPABILITY_ID_MRIOV,
+  PCI_EXPRESS_EXTENDED_CAPABILITY_RESIZABLE_BAR_ID
+};
+
 /**
   This routine is used to check whether the pci device is present.
 
@@ -77,6 +93,65 @@ PciDevicePresent (
   return EFI_NOT_FOUND;
 }
 
+/**
+  Check whether Device 0 is the only device that can be present on the
+  secondary bus of a bridge.
+
+  The secondary bus of a PCI Express Root Port or Switch Downstream Port is
+  its link, and the component on the other end is always Device 0. The only
+  exception is an ARI device below a port with ARI Forwarding enabled, whose
+  functions 8 and above decode as the higher device numbers.
+
+  @param Bridge   Bridge whose secondary bus is scanned.
+
+  @retval TRUE    Device numbers other than 0 need not be scanned.
+  @retval FALSE   All device numbers must be scanned.
+
+**/
+BOOLEAN
+PciBridgeHasSingleDevice (
+  IN PCI_IO_DEVICE  *Bridge
+  )
+{
+  EFI_STATUS                    Status;
+  PCI_REG_PCIE_CAPABILITY       Capability;
+  PCI_REG_PCIE_DEVICE_CONTROL2  DeviceControl2;
+
+  if (!Bridge->IsPciExp) {
+    return FALSE;
+  }
+
+  Status = Bridge->PciIo.Pci.Read (
+                               &Bridge->PciIo,
+                               EfiPciIoWidthUint16,
+                               Bridge->PciExpressCapabilityOffset + OFFSET_OF (PCI_CAPABILITY_PCIEXP, Capability),
+                               1,
+                               &Capability
+                               );
+  if (EFI_ERROR (Status)) {
+    return FALSE;
+  }
+
+  if ((Capability.Bits.DevicePortType != PCIE_DEVICE_PORT_TYPE_ROOT_PORT) &&
+      (Capability.Bits.DevicePortType != PCIE_DEVICE_PORT_TYPE_DOWNSTREAM_PORT))
+  {
+    return FALSE;
+  }
+
+  Status = Bridge->PciIo.Pci.Read (
+                               &Bridge->PciIo,
+                               EfiPciIoWidthUint16,
+                               Bridge->PciExpressCapabilityOffset + OFFSET_OF (PCI_CAPABILITY_PCIEXP, DeviceControl2),
+                               1,
+                               &DeviceControl2
+                               );
+  if (EFI_ERROR (Status)) {
+    return FALSE;
+  }
+
+  return (BOOLEAN)(DeviceControl2.Bits.AriForwarding == 0);
+}
+
 /**
   Collect all the resource information under this root bridge.
 
@@ -108,6 +183,10 @@ PciPciDeviceInfoCollector (
   SecBus = 0;
 
   for (Device = 0; Device <= PCI_MAX_DEVICE; Device++) {
+    if ((Device != 0) && PciBridgeHasSingleDevice (Bridge)) {
+      break;
+    }
+
     for (Func = 0; Func <= PCI_MAX_FUNC; Func++) {
       //
       // Check to see whether PCI device is present
@@ -491,10 +570,13 @@ GatherDeviceInfo (
   //
   // Start to parse the bars
   //
+  PciBarCacheBegin (PciIoDevice);
   for (Offset = 0x10, BarIndex = 0; Offset <= 0x24 && BarIndex < PCI_MAX_BAR; BarIndex++) {
     Offset = PciParseBar (PciIoDevice, Offset, BarIndex);
   }
 
+  PciBarCacheEnd (PciIoDevice);
+
   //
   // Parse the SR-IOV VF bars
   //
@@ -876,22 +958,29 @@ BarExisted (
   PciIo->Pci.Read (PciIo, EfiPciIoWidthUint32, (UINT8)Offset, 1, &OriginalValue);
 
   //
-  // Raise TPL to high level to disable timer interrupt while the BAR is probed
+  // Reuse the sizing result of the previous boot if the function is unchanged
   //
-  OldTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  if (!PciBarCacheLookup (PciIoDevice, Offset, &Value)) {
+    //
+    // Raise TPL to high level to disable timer interrupt while the BAR is probed
+    //
+    OldTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
 
-  PciIo->Pci.Write (PciIo, EfiPciIoWidthUint32, (UINT8)Offset, 1, &gAllOne);
-  PciIo->Pci.Read (PciIo, EfiPciIoWidthUint32, (UINT8)Offset, 1, &Value);
+    PciIo->Pci.Write (PciIo, EfiPciIoWidthUint32, (UINT8)Offset, 1, &gAllOne);
+    PciIo->Pci.Read (PciIo, EfiPciIoWidthUint32, (UINT8)Offset, 1, &Value);
 
-  //
-  // Write back the original value
-  //
-  PciIo->Pci.Write (PciIo, EfiPciIoWidthUint32, (UINT8)Offset, 1, &OriginalValue);
+    //
+    // Write back the original value
+    //
+    PciIo->Pci.Write (PciIo, EfiPciIoWidthUint32, (UINT8)Offset, 1, &OriginalValue);
 
-  //
-  // Restore TPL to its original level
-  //
-  gBS->RestoreTPL (OldTpl);
+    //
+    // Restore TPL to its original level
+    //
+    gBS->RestoreTPL (OldTpl);
+
+    PciBarCacheUpdate (PciIoDevice, Offset, Value);
+  }
 
   if (BarLengthValue != NULL) {
     *BarLengthValue = Value;
@@ -2179,6 +2268,7 @@ CreatePciIoDevice (
   PCI_IO_DEVICE        *PciIoDevice;
   EFI_PCI_IO_PROTOCOL  *PciIo;
   EFI_STATUS           Status;
+  UINT32               ExtendedCapOffsets[ARRAY_SIZE (mExtendedCapIds)];
 
   PciIoDevice = AllocateZeroPool (sizeof (PCI_IO_DEVICE));
   if (PciIoDevice == NULL) {
@@ -2256,6 +2346,22 @@ CreatePciIoDevice (
     return NULL;
   }
 
+  //
+  // Find the extended capabilities that are looked at below with a single
+  // walk of the extended capability list
+  //
+  ZeroMem (ExtendedCapOffsets, sizeof (ExtendedCapOffsets));
+  if (PcdGetBool (PcdAriSupport) || PcdGetBool (PcdSrIovSupport) ||
+      PcdGetBool (PcdMrIovSupport) || PcdGetBool (PcdPcieResizableBarSupport))
+  {
+    LocatePciExpressCapabilityRegBlocks (
+      PciIoDevice,
+      mExtendedCapIds,
+      ExtendedCapOffsets,
+      ARRAY_SIZE (mExtendedCapIds)
+      );
+  }
+
   //
   // Check if device's parent is not Root Bridge
   //
@@ -2263,13 +2369,8 @@ CreatePciIoDevice (
     //
     // Check if the device is an ARI device.
     //
-    Status = LocatePciExpressCapabilityRegBlock (
-               PciIoDevice,
-               EFI_PCIE_CAPABILITY_ID_ARI,
-               &PciIoDevice->AriCapabilityOffset,
-               NULL
-               );
-    if (!EFI_ERROR (Status)) {
+    PciIoDevice->AriCapabilityOffset = ExtendedCapOffsets[EXTENDED_CAP_ARI];
+    if (PciIoDevice->AriCapabilityOffset != 0) {
       //
       // We need to enable ARI feature before calculate BusReservation,
       // because FirstVFOffset and VFStride may change after that.
@@ -2328,13 +2429,8 @@ CreatePciIoDevice (
   //
 
   if (PcdGetBool (PcdSrIovSupport)) {
-    Status = LocatePciExpressCapabilityRegBlock (
-               PciIoDevice,
-               EFI_PCIE_CAPABILITY_ID_SRIOV,
-               &PciIoDevice->SrIovCapabilityOffset,
-               NULL
-               );
-    if (!EFI_ERROR (Status)) {
+    PciIoDevice->SrIovCapabilityOffset = ExtendedCapOffsets[EXTENDED_CAP_SRIOV];
+    if (PciIoDevice->SrIovCapabilityOffset != 0) {
       UINT32  SupportedPageSize;
       UINT16  VFStride;
       UINT16  FirstVFOffset;
@@ -2450,26 +2546,16 @@ CreatePciIoDevice (
   }
 
   if (PcdGetBool (PcdMrIovSupport)) {
-    Status = LocatePciExpressCapabilityRegBlock (
-               PciIoDevice,
-               EFI_PCIE_CAPABILITY_ID_MRIOV,
-               &PciIoDevice->MrIovCapabilityOffset,
-               NULL
-               );
-    if (!EFI_ERROR (Status)) {
+    PciIoDevice->MrIovCapabilityOffset = ExtendedCapOffsets[EXTENDED_CAP_MRIOV];
+    if (PciIoDevice->MrIovCapabilityOffset != 0) {
       DEBUG ((DEBUG_INFO, " MR-IOV: CapOffset = 0x%x\n", PciIoDevice->MrIovCapabilityOffset));
     }
   }
 
   PciIoDevice->ResizableBarOffset = 0;
   if (PcdGetBool (PcdPcieResizableBarSupport)) {
-    Status = LocatePciExpressCapabilityRegBlock (
-               PciIoDevice,
-               PCI_EXPRESS_EXTENDED_CAPABILITY_RESIZABLE_BAR_ID,
-               &PciIoDevice->ResizableBarOffset,
-               NULL
-               );
-    if (!EFI_ERROR (Status)) {
+    PciIoDevice->ResizableBarOffset = ExtendedCapOffsets[EXTENDED_CAP_RESIZABLE_BAR];
+    if (PciIoDevice->ResizableBarOffset != 0) {
       PCI_EXPRESS_EXTENDED_CAPABILITIES_RESIZABLE_BAR_CONTROL  ResizableBarControl;
       UINT32                                                   Offset;
       Offset = PciIoDevice->ResizableBarOffset + sizeof (PCI_EXPRESS_EXTENDED_CAPABILITIES_HEADER)
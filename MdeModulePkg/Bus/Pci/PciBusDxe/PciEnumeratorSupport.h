@@ -31,6 +31,26 @@ PciDevicePresent (
   IN  UINT8                            Func
   );
 
+/**
+  Check whether Device 0 is the only device that can be present on the
+  secondary bus of a bridge.
+
+  The secondary bus of a PCI Express Root Port or Switch Downstream Port is
+  its link, and the component on the other end is always Device 0. The only
+  exception is an ARI device below a port with ARI Forwarding enabled, whose
+  functions 8 and above decode as the higher device numbers.
+
+  @param Bridge   Bridge whose secondary bus is scanned.
+
+  @retval TRUE    Device numbers other than 0 need not be scanned.
+  @retval FALSE   All device numbers must be scanned.
+
+**/
+BOOLEAN
+PciBridgeHasSingleDevice (
+  IN PCI_IO_DEVICE  *Bridge
+  );
+
 /**
   Collect all the resource information under this root bridge.
 
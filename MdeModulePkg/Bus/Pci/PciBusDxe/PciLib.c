@@ -1120,6 +1120,10 @@ PciScanBus (
   IsAriEnabled    = FALSE;
 
   for (Device = 0; Device <= PCI_MAX_DEVICE; Device++) {
+    if ((Device != 0) && PciBridgeHasSingleDevice (Bridge)) {
+      break;
+    }
+
     if (!IsAriEnabled) {
       TempReservedBusNum = 0;
     }
@@ -425,7 +425,7 @@ LoadOpRomImage (
   //
   // Allocate memory for Rom header and PCIR
   //
-  RomHeader = AllocatePool (sizeof (PCI_EXPANSION_ROM_HEADER));
+  RomHeader = AllocatePool (PCI_ROM_HEADER_READ_SIZE);
   if (RomHeader == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
@@ -451,9 +451,9 @@ LoadOpRomImage (
   do {
     PciDevice->PciRootBridgeIo->Mem.Read (
                                       PciDevice->PciRootBridgeIo,
-                                      EfiPciWidthUint8,
+                                      EfiPciWidthUint32,
                                       RomBarOffset,
-                                      sizeof (PCI_EXPANSION_ROM_HEADER),
+                                      PCI_ROM_HEADER_READ_SIZE / sizeof (UINT32),
                                       (UINT8 *)RomHeader
                                       );
 
@@ -482,9 +482,9 @@ LoadOpRomImage (
 
     PciDevice->PciRootBridgeIo->Mem.Read (
                                       PciDevice->PciRootBridgeIo,
-                                      EfiPciWidthUint8,
+                                      EfiPciWidthUint32,
                                       RomBarOffset + OffsetPcir,
-                                      sizeof (PCI_DATA_STRUCTURE),
+                                      sizeof (PCI_DATA_STRUCTURE) / sizeof (UINT32),
                                       (UINT8 *)RomPcir
                                       );
     //
@@ -9,6 +9,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #ifndef _EFI_PCI_OPTION_ROM_SUPPORT_H_
 #define _EFI_PCI_OPTION_ROM_SUPPORT_H_
 
+//
+// Every access through the expansion ROM BAR is a slow MMIO read, so the
+// image header is fetched in DWORDs, padded up from its 0x1A bytes.
+//
+#define PCI_ROM_HEADER_READ_SIZE  ALIGN_VALUE (sizeof (PCI_EXPANSION_ROM_HEADER), sizeof (UINT32))
+
 /**
   Initialize a PCI LoadFile2 instance.
 
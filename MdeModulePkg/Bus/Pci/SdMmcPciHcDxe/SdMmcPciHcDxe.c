@@ -845,6 +845,10 @@ SdMmcPciHcDriverBindingStart (
 
 Done:
   if (EFI_ERROR (Status)) {
+    if (Private != NULL) {
+      SdMmcFreeAdmaDescCache (Private);
+    }
+
     if ((Private != NULL) && (Private->PciAttributes != 0)) {
       //
       // Restore original PCI attributes
@@ -967,6 +971,8 @@ SdMmcPciHcDriverBindingStop (
     SdMmcFreeTrb (Trb);
   }
 
+  SdMmcFreeAdmaDescCache (Private);
+
   //
   // Uninstall Block I/O protocol from the device handle
   //
@@ -121,6 +121,15 @@ typedef struct {
   // value stored in Capabilities Register 1.
   //
   UINT32                           BaseClkFreq[SD_MMC_HC_MAX_SLOT];
+
+  //
+  // The largest ADMA descriptor table released by the TRBs of each slot. It
+  // stays mapped and is reused by the next TRB of the slot that fits in it.
+  //
+  VOID                             *AdmaDescCache[SD_MMC_HC_MAX_SLOT];
+  UINT32                           AdmaDescCachePages[SD_MMC_HC_MAX_SLOT];
+  EFI_PHYSICAL_ADDRESS             AdmaDescCachePhy[SD_MMC_HC_MAX_SLOT];
+  VOID                             *AdmaDescCacheMap[SD_MMC_HC_MAX_SLOT];
 } SD_MMC_HC_PRIVATE_DATA;
 
 typedef struct {
@@ -689,6 +698,17 @@ SdMmcFreeTrb (
   IN SD_MMC_HC_TRB  *Trb
   );
 
+/**
+  Free the ADMA descriptor tables cached for the slots of the host controller.
+
+  @param[in] Private        A pointer to the SD_MMC_HC_PRIVATE_DATA instance.
+
+**/
+VOID
+SdMmcFreeAdmaDescCache (
+  IN SD_MMC_HC_PRIVATE_DATA  *Private
+  );
+
 /**
   Check if the env is ready for execute specified TRB.
 
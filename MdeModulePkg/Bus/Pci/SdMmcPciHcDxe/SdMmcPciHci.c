@@ -1479,9 +1479,11 @@ BuildAdmaDescTable (
   EFI_PCI_IO_PROTOCOL   *PciIo;
   EFI_STATUS            Status;
   UINTN                 Bytes;
-  UINT32                AdmaMaxDataPerLine;
-  UINT32                DescSize;
-  VOID                  *AdmaDesc;
+  UINT32                  AdmaMaxDataPerLine;
+  UINT32                  DescSize;
+  VOID                    *AdmaDesc;
+  SD_MMC_HC_PRIVATE_DATA  *Private;
+  EFI_TPL                 OldTpl;
 
   AdmaMaxDataPerLine = ADMA_MAX_DATA_PER_LINE_16B;
   DescSize           = sizeof (SD_MMC_HC_ADMA_32_DESC_LINE);
@@ -1538,61 +1540,88 @@ BuildAdmaDescTable (
   Entries        = DivU64x32 ((DataLen + AdmaMaxDataPerLine - 1), AdmaMaxDataPerLine);
   TableSize      = (UINTN)MultU64x32 (Entries, DescSize);
   Trb->AdmaPages = (UINT32)EFI_SIZE_TO_PAGES (TableSize);
-  Status         = PciIo->AllocateBuffer (
-                            PciIo,
-                            AllocateAnyPages,
-                            EfiBootServicesData,
-                            EFI_SIZE_TO_PAGES (TableSize),
-                            (VOID **)&AdmaDesc,
-                            0
-                            );
-  if (EFI_ERROR (Status)) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  ZeroMem (AdmaDesc, TableSize);
-  Bytes  = TableSize;
-  Status = PciIo->Map (
-                    PciIo,
-                    EfiPciIoOperationBusMasterCommonBuffer,
-                    AdmaDesc,
-                    &Bytes,
-                    &Trb->AdmaDescPhy,
-                    &Trb->AdmaMap
-                    );
-
-  if (EFI_ERROR (Status) || (Bytes != TableSize)) {
-    //
-    // Map error or unable to map the whole RFis buffer into a contiguous region.
-    //
-    PciIo->FreeBuffer (
-             PciIo,
-             EFI_SIZE_TO_PAGES (TableSize),
-             AdmaDesc
-             );
-    return EFI_OUT_OF_RESOURCES;
-  }
 
-  if ((Trb->Mode == SdMmcAdma32bMode) &&
-      ((UINT64)(UINTN)Trb->AdmaDescPhy > 0x100000000ul))
+  //
+  // Take the descriptor table cached for the slot if it is large enough.
+  //
+  Private = Trb->Private;
+  OldTpl  = gBS->RaiseTPL (TPL_NOTIFY);
+  if ((Private->AdmaDescCache[Trb->Slot] != NULL) &&
+      (Private->AdmaDescCachePages[Trb->Slot] >= Trb->AdmaPages) &&
+      ((Trb->Mode != SdMmcAdma32bMode) || ((UINT64)Private->AdmaDescCachePhy[Trb->Slot] <= 0x100000000ul)))
   {
+    AdmaDesc         = Private->AdmaDescCache[Trb->Slot];
+    Trb->AdmaPages   = Private->AdmaDescCachePages[Trb->Slot];
+    Trb->AdmaDescPhy = Private->AdmaDescCachePhy[Trb->Slot];
+    Trb->AdmaMap     = Private->AdmaDescCacheMap[Trb->Slot];
+
+    Private->AdmaDescCache[Trb->Slot]    = NULL;
+    Private->AdmaDescCacheMap[Trb->Slot] = NULL;
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  if (AdmaDesc == NULL) {
+    Status = PciIo->AllocateBuffer (
+                      PciIo,
+                      AllocateAnyPages,
+                      EfiBootServicesData,
+                      Trb->AdmaPages,
+                      (VOID **)&AdmaDesc,
+                      0
+                      );
+    if (EFI_ERROR (Status)) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
     //
-    // The ADMA doesn't support 64bit addressing.
+    // Map the whole pages so that the table can be reused for larger transfers.
     //
-    PciIo->Unmap (
-             PciIo,
-             Trb->AdmaMap
-             );
-    Trb->AdmaMap = NULL;
+    Bytes  = EFI_PAGES_TO_SIZE (Trb->AdmaPages);
+    Status = PciIo->Map (
+                      PciIo,
+                      EfiPciIoOperationBusMasterCommonBuffer,
+                      AdmaDesc,
+                      &Bytes,
+                      &Trb->AdmaDescPhy,
+                      &Trb->AdmaMap
+                      );
+
+    if (EFI_ERROR (Status) || (Bytes != EFI_PAGES_TO_SIZE (Trb->AdmaPages))) {
+      //
+      // Map error or unable to map the whole RFis buffer into a contiguous region.
+      //
+      PciIo->FreeBuffer (
+               PciIo,
+               Trb->AdmaPages,
+               AdmaDesc
+               );
+      return EFI_OUT_OF_RESOURCES;
+    }
 
-    PciIo->FreeBuffer (
-             PciIo,
-             EFI_SIZE_TO_PAGES (TableSize),
-             AdmaDesc
-             );
-    return EFI_DEVICE_ERROR;
+    if ((Trb->Mode == SdMmcAdma32bMode) &&
+        ((UINT64)(UINTN)Trb->AdmaDescPhy > 0x100000000ul))
+    {
+      //
+      // The ADMA doesn't support 64bit addressing.
+      //
+      PciIo->Unmap (
+               PciIo,
+               Trb->AdmaMap
+               );
+      Trb->AdmaMap = NULL;
+
+      PciIo->FreeBuffer (
+               PciIo,
+               Trb->AdmaPages,
+               AdmaDesc
+               );
+      return EFI_DEVICE_ERROR;
+    }
   }
 
+  ZeroMem (AdmaDesc, TableSize);
+
   Remaining = DataLen;
   Address   = Data;
   if (Trb->Mode == SdMmcAdma32bMode) {
@@ -1960,38 +1989,62 @@ SdMmcFreeTrb (
   IN SD_MMC_HC_TRB  *Trb
   )
 {
-  EFI_PCI_IO_PROTOCOL  *PciIo;
-
-  PciIo = Trb->Private->PciIo;
+  EFI_PCI_IO_PROTOCOL     *PciIo;
+  SD_MMC_HC_PRIVATE_DATA  *Private;
+  VOID                    *TrbAdmaDesc;
+  VOID                    *AdmaDesc;
+  VOID                    *AdmaMap;
+  UINT32                  AdmaPages;
+  EFI_TPL                 OldTpl;
+
+  Private = Trb->Private;
+  PciIo   = Private->PciIo;
 
-  if (Trb->AdmaMap != NULL) {
-    PciIo->Unmap (
-             PciIo,
-             Trb->AdmaMap
-             );
+  if (Trb->Adma32Desc != NULL) {
+    TrbAdmaDesc = Trb->Adma32Desc;
+  } else if (Trb->Adma64V3Desc != NULL) {
+    TrbAdmaDesc = Trb->Adma64V3Desc;
+  } else {
+    TrbAdmaDesc = Trb->Adma64V4Desc;
   }
 
-  if (Trb->Adma32Desc != NULL) {
-    PciIo->FreeBuffer (
-             PciIo,
-             Trb->AdmaPages,
-             Trb->Adma32Desc
-             );
+  AdmaDesc  = TrbAdmaDesc;
+  AdmaMap   = Trb->AdmaMap;
+  AdmaPages = Trb->AdmaPages;
+  if (AdmaDesc != NULL) {
+    //
+    // Keep the largest descriptor table of the slot mapped for the next TRBs,
+    // and free the other one.
+    //
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    if ((Private->AdmaDescCache[Trb->Slot] == NULL) ||
+        (Private->AdmaDescCachePages[Trb->Slot] < AdmaPages))
+    {
+      AdmaDesc  = Private->AdmaDescCache[Trb->Slot];
+      AdmaMap   = Private->AdmaDescCacheMap[Trb->Slot];
+      AdmaPages = Private->AdmaDescCachePages[Trb->Slot];
+
+      Private->AdmaDescCache[Trb->Slot]      = TrbAdmaDesc;
+      Private->AdmaDescCacheMap[Trb->Slot]   = Trb->AdmaMap;
+      Private->AdmaDescCachePages[Trb->Slot] = Trb->AdmaPages;
+      Private->AdmaDescCachePhy[Trb->Slot]   = Trb->AdmaDescPhy;
+    }
+
+    gBS->RestoreTPL (OldTpl);
   }
 
-  if (Trb->Adma64V3Desc != NULL) {
-    PciIo->FreeBuffer (
+  if (AdmaMap != NULL) {
+    PciIo->Unmap (
              PciIo,
-             Trb->AdmaPages,
-             Trb->Adma64V3Desc
+             AdmaMap
              );
   }
 
-  if (Trb->Adma64V4Desc != NULL) {
+  if (AdmaDesc != NULL) {
     PciIo->FreeBuffer (
              PciIo,
-             Trb->AdmaPages,
-             Trb->Adma64V4Desc
+             AdmaPages,
+             AdmaDesc
              );
   }
 
@@ -2006,6 +2059,40 @@ SdMmcFreeTrb (
   return;
 }
 
+/**
+  Free the ADMA descriptor tables cached for the slots of the host controller.
+
+  @param[in] Private        A pointer to the SD_MMC_HC_PRIVATE_DATA instance.
+
+**/
+VOID
+SdMmcFreeAdmaDescCache (
+  IN SD_MMC_HC_PRIVATE_DATA  *Private
+  )
+{
+  EFI_PCI_IO_PROTOCOL  *PciIo;
+  UINT8                Slot;
+
+  PciIo = Private->PciIo;
+  for (Slot = 0; Slot < SD_MMC_HC_MAX_SLOT; Slot++) {
+    if (Private->AdmaDescCache[Slot] == NULL) {
+      continue;
+    }
+
+    PciIo->Unmap (
+             PciIo,
+             Private->AdmaDescCacheMap[Slot]
+             );
+    PciIo->FreeBuffer (
+             PciIo,
+             Private->AdmaDescCachePages[Slot],
+             Private->AdmaDescCache[Slot]
+             );
+    Private->AdmaDescCache[Slot]    = NULL;
+    Private->AdmaDescCacheMap[Slot] = NULL;
+  }
+}
+
 /**
   Check if the env is ready for execute specified TRB.
 
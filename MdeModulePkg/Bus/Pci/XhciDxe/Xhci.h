@@ -54,6 +54,16 @@ typedef struct _USB_DEV_CONTEXT    USB_DEV_CONTEXT;
 //
 #define XHC_1_MILLISECOND  (1000)
 //
+// Polling interval bounds of a synchronous transfer, set by experience.
+// The event ring is polled at XHC_POLL_MIN_INTERVAL for the first
+// XHC_POLL_FAST_COUNT polls, then the interval doubles on every poll
+// that finds the transfer still pending, up to XHC_POLL_MAX_INTERVAL.
+// The unit is microsecond.
+//
+#define XHC_POLL_MIN_INTERVAL  XHC_1_MICROSECOND
+#define XHC_POLL_MAX_INTERVAL  (32 * XHC_1_MICROSECOND)
+#define XHC_POLL_FAST_COUNT    64
+//
 // XHC generic timeout experience values.
 // The unit is millisecond, setting it as 10s.
 //
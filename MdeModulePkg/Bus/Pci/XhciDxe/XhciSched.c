@@ -1280,6 +1280,11 @@ EXIT:
 /**
   Execute the transfer by polling the URB. This is a synchronous operation.
 
+  Short transfers complete within the first few microseconds and are polled
+  at the minimum interval. Longer ones back off gradually, so that a large
+  bulk transfer does not keep walking the event ring and reading the
+  operational and runtime registers every microsecond.
+
   @param  Xhc               The XHCI Instance.
   @param  CmdTransfer       The executed URB is for cmd transfer or not.
   @param  Urb               The URB to execute.
@@ -1307,10 +1312,14 @@ XhcExecTransfer (
   UINT64      TicksDelta;
   UINT64      CurrentTick;
   BOOLEAN     IndefiniteTimeout;
+  UINTN       PollInterval;
+  UINTN       PollCount;
 
   Status            = EFI_SUCCESS;
   Finished          = FALSE;
   IndefiniteTimeout = FALSE;
+  PollInterval      = XHC_POLL_MIN_INTERVAL;
+  PollCount         = 0;
 
   if (CmdTransfer) {
     SlotId = 0;
@@ -1345,14 +1354,23 @@ XhcExecTransfer (
       break;
     }
 
-    gBS->Stall (XHC_1_MICROSECOND);
+    gBS->Stall (PollInterval);
     TicksDelta = XhcGetElapsedTicks (&CurrentTick);
     // Ensure that ElapsedTicks is always incremented to avoid indefinite hangs
     if (TicksDelta == 0) {
-      TicksDelta = XhcConvertTimeToTicks (XHC_MICROSECOND_TO_NANOSECOND (XHC_1_MICROSECOND));
+      TicksDelta = XhcConvertTimeToTicks (XHC_MICROSECOND_TO_NANOSECOND (PollInterval));
     }
 
     ElapsedTicks += TicksDelta;
+
+    //
+    // Back off once the transfer has been pending for a while.
+    //
+    if (PollCount < XHC_POLL_FAST_COUNT) {
+      PollCount++;
+    } else if (PollInterval < XHC_POLL_MAX_INTERVAL) {
+      PollInterval *= 2;
+    }
   } while (IndefiniteTimeout || ElapsedTicks < TimeoutTicks);
 
   if (!Finished) {
@@ -307,16 +307,19 @@ SCSIBusDriverBindingStart (
   EFI_STATUS                       PassThruStatus;
   SCSI_BUS_DEVICE                  *ScsiBusDev;
   SCSI_TARGET_ID                   ScsiTargetId;
+  SCSI_TARGET_ID                   AbsentTargetId;
+  BOOLEAN                          SkipAbsentTarget;
   EFI_DEVICE_PATH_PROTOCOL         *ParentDevicePath;
   EFI_SCSI_PASS_THRU_PROTOCOL      *ScsiInterface;
   EFI_EXT_SCSI_PASS_THRU_PROTOCOL  *ExtScsiInterface;
   EFI_SCSI_BUS_PROTOCOL            *BusIdentify;
 
-  TargetId        = NULL;
-  ScanOtherPuns   = TRUE;
-  FromFirstTarget = FALSE;
-  ExtScsiSupport  = FALSE;
-  PassThruStatus  = EFI_SUCCESS;
+  TargetId         = NULL;
+  ScanOtherPuns    = TRUE;
+  FromFirstTarget  = FALSE;
+  ExtScsiSupport   = FALSE;
+  PassThruStatus   = EFI_SUCCESS;
+  SkipAbsentTarget = FALSE;
 
   TargetId = &ScsiTargetId.ScsiId.ExtScsi[0];
   SetMem (TargetId, TARGET_MAX_BYTES, 0xFF);
@@ -528,6 +531,14 @@ SCSIBusDriverBindingStart (
       }
     }
 
+    //
+    // A target that does not answer selection at LUN 0 has no logical units,
+    // so do not spend a command timeout on each of its remaining LUNs.
+    //
+    if (SkipAbsentTarget && (CompareMem (&ScsiTargetId, &AbsentTargetId, TARGET_MAX_BYTES) == 0)) {
+      continue;
+    }
+
     //
     // Scan for the scsi device, if it attaches to the scsi bus,
     // then create handle and install scsi i/o protocol.
@@ -536,6 +547,11 @@ SCSIBusDriverBindingStart (
     if (Status == EFI_OUT_OF_RESOURCES) {
       goto ErrorExit;
     }
+
+    if ((Status == EFI_NO_RESPONSE) && (Lun == 0)) {
+      CopyMem (&AbsentTargetId, &ScsiTargetId, TARGET_MAX_BYTES);
+      SkipAbsentTarget = TRUE;
+    }
   }
 
   return EFI_SUCCESS;
@@ -1106,6 +1122,7 @@ ScsiExecuteSCSICommand (
   @retval EFI_SUCCESS           Successfully to discover the device and attach
                                 ScsiIoProtocol to it.
   @retval EFI_NOT_FOUND         Fail to discover the device.
+  @retval EFI_NO_RESPONSE       The target did not respond to selection.
   @retval EFI_OUT_OF_RESOURCES  Fail to allocate memory resources.
 
 **/
@@ -1279,6 +1296,7 @@ ErrorExit:
 
   @retval EFI_SUCCESS           Find SCSI Device and verify it.
   @retval EFI_NOT_FOUND         Unable to find SCSI Device.
+  @retval EFI_NO_RESPONSE       The target did not respond to selection.
   @retval EFI_OUT_OF_RESOURCES  Fail to allocate memory resources.
 
 **/
@@ -1357,6 +1375,15 @@ DiscoverScsiDevice (
       Status = EFI_NOT_FOUND;
       goto Done;
     }
+
+    //
+    // Selection timeout means there is no target at this address at all,
+    // retrying cannot succeed.
+    //
+    if (HostAdapterStatus == EFI_SCSI_IO_STATUS_HOST_ADAPTER_SELECTION_TIMEOUT) {
+      Status = EFI_NO_RESPONSE;
+      goto Done;
+    }
   }
 
   if (Index == MaxRetry) {
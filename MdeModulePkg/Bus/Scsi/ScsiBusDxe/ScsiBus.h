@@ -456,6 +456,7 @@ ScsiExecuteSCSICommand (
   @retval EFI_SUCCESS           Successfully to discover the device and attach
                                 ScsiIoProtocol to it.
   @retval EFI_NOT_FOUND         Fail to discover the device.
+  @retval EFI_NO_RESPONSE       The target did not respond to selection.
   @retval EFI_OUT_OF_RESOURCES  Fail to allocate memory resources.
 
 **/
@@ -476,6 +477,7 @@ ScsiScanCreateDevice (
 
   @retval EFI_SUCCESS           Find SCSI Device and verify it.
   @retval EFI_NOT_FOUND         Unable to find SCSI Device.
+  @retval EFI_NO_RESPONSE       The target did not respond to selection.
   @retval EFI_OUT_OF_RESOURCES  Fail to allocate memory resources.
 
 **/
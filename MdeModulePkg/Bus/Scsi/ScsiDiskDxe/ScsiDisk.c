@@ -2674,6 +2674,12 @@ ScsiDiskInquiryDevice (
               (BlockLimits->OptimalTransferLengthGranularity2 << 8) |
               BlockLimits->OptimalTransferLengthGranularity1;
 
+            ScsiDiskDevice->MaxTransferBlocks =
+              (BlockLimits->MaximumTransferLength4 << 24) |
+              (BlockLimits->MaximumTransferLength3 << 16) |
+              (BlockLimits->MaximumTransferLength2 << 8)  |
+              BlockLimits->MaximumTransferLength1;
+
             ScsiDiskDevice->UnmapInfo.MaxLbaCnt =
               (BlockLimits->MaximumUnmapLbaCount4 << 24) |
               (BlockLimits->MaximumUnmapLbaCount3 << 16) |
@@ -3486,6 +3492,14 @@ ScsiDiskReadSectors (
     MaxBlock = 0xFFFFFFFF;
   }
 
+  //
+  // Honor the device's own maximum transfer length so that oversized
+  // requests are not failed and retried at half size.
+  //
+  if ((ScsiDiskDevice->MaxTransferBlocks != 0) && (ScsiDiskDevice->MaxTransferBlocks < MaxBlock)) {
+    MaxBlock = ScsiDiskDevice->MaxTransferBlocks;
+  }
+
   PtrBuffer = Buffer;
 
   while (BlocksRemaining > 0) {
@@ -3651,6 +3665,14 @@ ScsiDiskWriteSectors (
     MaxBlock = 0xFFFFFFFF;
   }
 
+  //
+  // Honor the device's own maximum transfer length so that oversized
+  // requests are not failed and retried at half size.
+  //
+  if ((ScsiDiskDevice->MaxTransferBlocks != 0) && (ScsiDiskDevice->MaxTransferBlocks < MaxBlock)) {
+    MaxBlock = ScsiDiskDevice->MaxTransferBlocks;
+  }
+
   PtrBuffer = Buffer;
 
   while (BlocksRemaining > 0) {
@@ -3835,6 +3857,14 @@ ScsiDiskAsyncReadSectors (
     MaxBlock = 0xFFFFFFFF;
   }
 
+  //
+  // Honor the device's own maximum transfer length so that oversized
+  // requests are not failed and retried at half size.
+  //
+  if ((ScsiDiskDevice->MaxTransferBlocks != 0) && (ScsiDiskDevice->MaxTransferBlocks < MaxBlock)) {
+    MaxBlock = ScsiDiskDevice->MaxTransferBlocks;
+  }
+
   PtrBuffer = Buffer;
 
   while (BlocksRemaining > 0) {
@@ -4053,6 +4083,14 @@ ScsiDiskAsyncWriteSectors (
     MaxBlock = 0xFFFFFFFF;
   }
 
+  //
+  // Honor the device's own maximum transfer length so that oversized
+  // requests are not failed and retried at half size.
+  //
+  if ((ScsiDiskDevice->MaxTransferBlocks != 0) && (ScsiDiskDevice->MaxTransferBlocks < MaxBlock)) {
+    MaxBlock = ScsiDiskDevice->MaxTransferBlocks;
+  }
+
   PtrBuffer = Buffer;
 
   while (BlocksRemaining > 0) {
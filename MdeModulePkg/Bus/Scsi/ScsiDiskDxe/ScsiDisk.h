@@ -85,6 +85,12 @@ typedef struct {
   SCSI_UNMAP_PARAM_INFO                    UnmapInfo;
   BOOLEAN                                  BlockLimitsVpdSupported;
 
+  //
+  // Maximum transfer length in blocks reported by the Block Limits VPD page,
+  // 0 if the device does not report a limit.
+  //
+  UINT32                                   MaxTransferBlocks;
+
   //
   // The flag indicates if 16-byte command can be used
   //
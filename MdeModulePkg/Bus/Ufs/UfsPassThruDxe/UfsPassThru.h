@@ -75,6 +75,13 @@ typedef struct _UFS_PASS_THRU_PRIVATE_DATA {
   //
   EFI_EVENT                             TimerEvent;
   LIST_ENTRY                            Queue;
+
+  //
+  // Slots of the transfer request list owned by a request, from the time the
+  // slot is found available until the request is stopped. The doorbell alone
+  // does not tell, as it is cleared before an async request is completed.
+  //
+  UINT32                                SlotsInUse;
 } UFS_PASS_THRU_PRIVATE_DATA;
 
 #define UFS_PASS_THRU_TRANS_REQ_SIG  SIGNATURE_32 ('U', 'F', 'S', 'T')
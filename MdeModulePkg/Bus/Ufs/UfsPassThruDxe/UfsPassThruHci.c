@@ -724,6 +724,7 @@ UfsFindAvailableSlotInTrl (
   UINT8       Index;
   UINT32      Data;
   EFI_STATUS  Status;
+  EFI_TPL     OldTpl;
 
   ASSERT ((Private != NULL) && (Slot != NULL));
 
@@ -734,16 +735,41 @@ UfsFindAvailableSlotInTrl (
 
   Nutrs = (UINT8)((Private->UfsHcInfo.Capabilities & UFS_HC_CAP_NUTRS) + 1);
 
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  Data  |= Private->SlotsInUse;
   for (Index = 0; Index < Nutrs; Index++) {
     if ((Data & (BIT0 << Index)) == 0) {
+      Private->SlotsInUse |= BIT0 << Index;
+      gBS->RestoreTPL (OldTpl);
       *Slot = Index;
       return EFI_SUCCESS;
     }
   }
 
+  gBS->RestoreTPL (OldTpl);
   return EFI_NOT_READY;
 }
 
+/**
+  Release a slot found by UfsFindAvailableSlotInTrl() that is not used anymore.
+
+  @param[in]  Private       The pointer to the UFS_PASS_THRU_PRIVATE_DATA data structure.
+  @param[in]  Slot          The slot to be released.
+
+**/
+VOID
+UfsReleaseSlotInTrl (
+  IN  UFS_PASS_THRU_PRIVATE_DATA  *Private,
+  IN  UINT8                       Slot
+  )
+{
+  EFI_TPL  OldTpl;
+
+  OldTpl               = gBS->RaiseTPL (TPL_NOTIFY);
+  Private->SlotsInUse &= ~(BIT0 << Slot);
+  gBS->RestoreTPL (OldTpl);
+}
+
 /**
   Start specified slot in transfer list of a UFS device.
 
@@ -796,6 +822,8 @@ UfsStopExecCmd (
   UINT32      Data;
   EFI_STATUS  Status;
 
+  UfsReleaseSlotInTrl (Private, Slot);
+
   Status = UfsMmioRead32 (Private, UFS_HC_UTRLDBR_OFFSET, &Data);
   if (EFI_ERROR (Status)) {
     return Status;
@@ -924,6 +952,7 @@ UfsSendDmRequestRetry (
   Status = UfsCreateDMCommandDesc (Private, Packet, Trd, &CmdDescHost, &CmdDescMapping);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "Failed to create DM command descriptor\n"));
+    UfsReleaseSlotInTrl (Private, Slot);
     return Status;
   }
 
@@ -940,7 +969,7 @@ UfsSendDmRequestRetry (
   //
   // Wait for the completion of the transfer request.
   //
-  Status = UfsWaitMemSet (Private, UFS_HC_UTRLDBR_OFFSET, BIT0, 0, Packet->Timeout);
+  Status = UfsWaitMemSet (Private, UFS_HC_UTRLDBR_OFFSET, BIT0 << Slot, 0, Packet->Timeout);
   if (EFI_ERROR (Status)) {
     goto Exit;
   }
@@ -1275,6 +1304,7 @@ UfsExecNopCmds (
   Trd    = ((UTP_TRD *)Private->UtpTrlBase) + Slot;
   Status = UfsCreateNopCommandDesc (Private, Trd, &CmdDescHost, &CmdDescMapping);
   if (EFI_ERROR (Status)) {
+    UfsReleaseSlotInTrl (Private, Slot);
     return Status;
   }
 
@@ -1519,6 +1549,7 @@ UfsExecScsiCmds (
   //
   Status = UfsFindAvailableSlotInTrl (Private, &TransReq->Slot);
   if (EFI_ERROR (Status)) {
+    FreePool (TransReq);
     return Status;
   }
 
@@ -1536,6 +1567,8 @@ UfsExecScsiCmds (
              &TransReq->CmdDescMapping
              );
   if (EFI_ERROR (Status)) {
+    UfsReleaseSlotInTrl (Private, TransReq->Slot);
+    FreePool (TransReq);
     return Status;
   }
 
@@ -1543,6 +1576,7 @@ UfsExecScsiCmds (
 
   Status = UfsPrepareDataTransferBuffer (Private, TransReq);
   if (EFI_ERROR (Status)) {
+    UfsReleaseSlotInTrl (Private, TransReq->Slot);
     goto Exit1;
   }
 
@@ -2297,9 +2331,12 @@ ProcessAsyncTaskList (
   SlotsMap = 0;
 
   //
-  // Check the entries in the async I/O queue are done or not.
+  // Check the entries in the async I/O queue are done or not. The doorbell is
+  // read once for all of them.
   //
   if (!IsListEmpty (&Private->Queue)) {
+    Status = UfsMmioRead32 (Private, UFS_HC_UTRLDBR_OFFSET, &Value);
+
     BASE_LIST_FOR_EACH_SAFE (Entry, NextEntry, &Private->Queue) {
       TransReq = UFS_PASS_THRU_TRANS_REQ_FROM_THIS (Entry);
       Packet   = TransReq->Packet;
@@ -2310,7 +2347,6 @@ ProcessAsyncTaskList (
 
       SlotsMap |= BIT0 << TransReq->Slot;
 
-      Status = UfsMmioRead32 (Private, UFS_HC_UTRLDBR_OFFSET, &Value);
       if (EFI_ERROR (Status)) {
         //
         // TODO: Should find/add a proper host adapter return status for this
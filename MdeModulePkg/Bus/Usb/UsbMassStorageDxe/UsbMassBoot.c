@@ -910,7 +910,7 @@ UsbBootReadWriteBlocks16 (
   UINT32      Timeout;
 
   BlockSize = UsbMass->BlockIoMedia.BlockSize;
-  CountMax  = USB_BOOT_MAX_CARRY_SIZE / BlockSize;
+  CountMax  = USB_BOOT_MAX_CARRY_SIZE16 / BlockSize;
   Status    = EFI_SUCCESS;
 
   while (TotalBlock > 0) {
@@ -63,6 +63,13 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 //
 #define USB_BOOT_MAX_CARRY_SIZE  SIZE_64KB
 
+//
+// Max carried size of a 16 byte CDB READ/WRITE. Only large devices that
+// support the 16 byte CDB use it, and they handle bigger transfers well,
+// so fewer CBW/CSW round trips are needed per request.
+//
+#define USB_BOOT_MAX_CARRY_SIZE16  SIZE_1MB
+
 //
 // Retry mass command times, set by experience
 //
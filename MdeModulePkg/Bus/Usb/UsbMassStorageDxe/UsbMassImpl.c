@@ -323,6 +323,158 @@ UsbMassFlushBlocks (
   return EFI_SUCCESS;
 }
 
+/**
+  Reset the block device.
+
+  This function implements EFI_BLOCK_IO2_PROTOCOL.Reset().
+
+  @param  This                   Indicates a pointer to the calling context.
+  @param  ExtendedVerification   Indicates that the driver may perform a more exhaustive
+                                 verification operation of the device during reset.
+
+  @retval EFI_SUCCESS            The block device was reset.
+  @retval EFI_DEVICE_ERROR       The block device is not functioning correctly and could not be reset.
+
+**/
+EFI_STATUS
+EFIAPI
+UsbMassResetEx (
+  IN EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN BOOLEAN                 ExtendedVerification
+  )
+{
+  USB_MASS_DEVICE  *UsbMass;
+
+  UsbMass = USB_MASS_DEVICE_FROM_BLOCK_IO2 (This);
+  return UsbMassReset (&UsbMass->BlockIo, ExtendedVerification);
+}
+
+/**
+  Reads the requested number of blocks from the device.
+
+  This function implements EFI_BLOCK_IO2_PROTOCOL.ReadBlocksEx(). The USB I/O
+  bulk transfers are synchronous, so the request is always completed before
+  this function returns; Token->Event is signaled if it is not NULL.
+
+  @param  This                   Indicates a pointer to the calling context.
+  @param  MediaId                The media ID that the read request is for.
+  @param  Lba                    The starting logical block address to read from on the device.
+  @param  Token                  A pointer to the token associated with the transaction.
+  @param  BufferSize             The size of the Buffer in bytes.
+                                 This must be a multiple of the intrinsic block size of the device.
+  @param  Buffer                 A pointer to the destination buffer for the data.
+
+  @retval EFI_SUCCESS            The data was read correctly from the device.
+  @retval EFI_DEVICE_ERROR       The device reported an error while attempting to perform the read operation.
+  @retval EFI_NO_MEDIA           There is no media in the device.
+  @retval EFI_MEDIA_CHANGED      The MediaId is not for the current media.
+  @retval EFI_BAD_BUFFER_SIZE    The BufferSize parameter is not a multiple of the intrinsic block size of the device.
+  @retval EFI_INVALID_PARAMETER  The read request contains LBAs that are not valid,
+                                 or the buffer is not on proper alignment.
+
+**/
+EFI_STATUS
+EFIAPI
+UsbMassReadBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN     UINT32                  MediaId,
+  IN     EFI_LBA                 Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token,
+  IN     UINTN                   BufferSize,
+  OUT    VOID                    *Buffer
+  )
+{
+  USB_MASS_DEVICE  *UsbMass;
+  EFI_STATUS       Status;
+
+  UsbMass = USB_MASS_DEVICE_FROM_BLOCK_IO2 (This);
+  Status  = UsbMassReadBlocks (&UsbMass->BlockIo, MediaId, Lba, BufferSize, Buffer);
+  if (!EFI_ERROR (Status) && (Token != NULL) && (Token->Event != NULL)) {
+    Token->TransactionStatus = EFI_SUCCESS;
+    gBS->SignalEvent (Token->Event);
+  }
+
+  return Status;
+}
+
+/**
+  Writes a specified number of blocks to the device.
+
+  This function implements EFI_BLOCK_IO2_PROTOCOL.WriteBlocksEx(). The USB I/O
+  bulk transfers are synchronous, so the request is always completed before
+  this function returns; Token->Event is signaled if it is not NULL.
+
+  @param  This                   Indicates a pointer to the calling context.
+  @param  MediaId                The media ID that the write request is for.
+  @param  Lba                    The starting logical block address to be written.
+  @param  Token                  A pointer to the token associated with the transaction.
+  @param  BufferSize             The size of the Buffer in bytes.
+                                 This must be a multiple of the intrinsic block size of the device.
+  @param  Buffer                 Pointer to the source buffer for the data.
+
+  @retval EFI_SUCCESS            The data were written correctly to the device.
+  @retval EFI_WRITE_PROTECTED    The device cannot be written to.
+  @retval EFI_NO_MEDIA           There is no media in the device.
+  @retval EFI_MEDIA_CHANGED      The MediaId is not for the current media.
+  @retval EFI_DEVICE_ERROR       The device reported an error while attempting to perform the write operation.
+  @retval EFI_BAD_BUFFER_SIZE    The BufferSize parameter is not a multiple of the intrinsic
+                                 block size of the device.
+  @retval EFI_INVALID_PARAMETER  The write request contains LBAs that are not valid,
+                                 or the buffer is not on proper alignment.
+
+**/
+EFI_STATUS
+EFIAPI
+UsbMassWriteBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN     UINT32                  MediaId,
+  IN     EFI_LBA                 Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token,
+  IN     UINTN                   BufferSize,
+  IN     VOID                    *Buffer
+  )
+{
+  USB_MASS_DEVICE  *UsbMass;
+  EFI_STATUS       Status;
+
+  UsbMass = USB_MASS_DEVICE_FROM_BLOCK_IO2 (This);
+  Status  = UsbMassWriteBlocks (&UsbMass->BlockIo, MediaId, Lba, BufferSize, Buffer);
+  if (!EFI_ERROR (Status) && (Token != NULL) && (Token->Event != NULL)) {
+    Token->TransactionStatus = EFI_SUCCESS;
+    gBS->SignalEvent (Token->Event);
+  }
+
+  return Status;
+}
+
+/**
+  Flushes all modified data to a physical block device.
+
+  This function implements EFI_BLOCK_IO2_PROTOCOL.FlushBlocksEx().
+  USB mass storage device doesn't support write cache,
+  so only the token is signaled.
+
+  @param  This                   Indicates a pointer to the calling context.
+  @param  Token                  A pointer to the token associated with the transaction.
+
+  @retval EFI_SUCCESS            All outstanding data were written correctly to the device.
+
+**/
+EFI_STATUS
+EFIAPI
+UsbMassFlushBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token
+  )
+{
+  if ((Token != NULL) && (Token->Event != NULL)) {
+    Token->TransactionStatus = EFI_SUCCESS;
+    gBS->SignalEvent (Token->Event);
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Initialize the media parameter data for EFI_BLOCK_IO_MEDIA of Block I/O Protocol.
 
@@ -496,17 +648,22 @@ UsbMassInitMultiLun (
     UsbMass = AllocateZeroPool (sizeof (USB_MASS_DEVICE));
     ASSERT (UsbMass != NULL);
 
-    UsbMass->Signature           = USB_MASS_SIGNATURE;
-    UsbMass->UsbIo               = UsbIo;
-    UsbMass->BlockIo.Media       = &UsbMass->BlockIoMedia;
-    UsbMass->BlockIo.Reset       = UsbMassReset;
-    UsbMass->BlockIo.ReadBlocks  = UsbMassReadBlocks;
-    UsbMass->BlockIo.WriteBlocks = UsbMassWriteBlocks;
-    UsbMass->BlockIo.FlushBlocks = UsbMassFlushBlocks;
-    UsbMass->OpticalStorage      = FALSE;
-    UsbMass->Transport           = Transport;
-    UsbMass->Context             = Context;
-    UsbMass->Lun                 = Index;
+    UsbMass->Signature              = USB_MASS_SIGNATURE;
+    UsbMass->UsbIo                  = UsbIo;
+    UsbMass->BlockIo.Media          = &UsbMass->BlockIoMedia;
+    UsbMass->BlockIo.Reset          = UsbMassReset;
+    UsbMass->BlockIo.ReadBlocks     = UsbMassReadBlocks;
+    UsbMass->BlockIo.WriteBlocks    = UsbMassWriteBlocks;
+    UsbMass->BlockIo.FlushBlocks    = UsbMassFlushBlocks;
+    UsbMass->BlockIo2.Media         = &UsbMass->BlockIoMedia;
+    UsbMass->BlockIo2.Reset         = UsbMassResetEx;
+    UsbMass->BlockIo2.ReadBlocksEx  = UsbMassReadBlocksEx;
+    UsbMass->BlockIo2.WriteBlocksEx = UsbMassWriteBlocksEx;
+    UsbMass->BlockIo2.FlushBlocksEx = UsbMassFlushBlocksEx;
+    UsbMass->OpticalStorage         = FALSE;
+    UsbMass->Transport              = Transport;
+    UsbMass->Context                = Context;
+    UsbMass->Lun                    = Index;
 
     //
     // Initialize the media parameter data for EFI_BLOCK_IO_MEDIA of Block I/O Protocol.
@@ -547,6 +704,8 @@ UsbMassInitMultiLun (
                     UsbMass->DevicePath,
                     &gEfiBlockIoProtocolGuid,
                     &UsbMass->BlockIo,
+                    &gEfiBlockIo2ProtocolGuid,
+                    &UsbMass->BlockIo2,
                     &gEfiDiskInfoProtocolGuid,
                     &UsbMass->DiskInfo,
                     NULL
@@ -579,6 +738,8 @@ UsbMassInitMultiLun (
              UsbMass->DevicePath,
              &gEfiBlockIoProtocolGuid,
              &UsbMass->BlockIo,
+             &gEfiBlockIo2ProtocolGuid,
+             &UsbMass->BlockIo2,
              &gEfiDiskInfoProtocolGuid,
              &UsbMass->DiskInfo,
              NULL
@@ -637,17 +798,22 @@ UsbMassInitNonLun (
     goto ON_ERROR;
   }
 
-  UsbMass->Signature           = USB_MASS_SIGNATURE;
-  UsbMass->Controller          = Controller;
-  UsbMass->UsbIo               = UsbIo;
-  UsbMass->BlockIo.Media       = &UsbMass->BlockIoMedia;
-  UsbMass->BlockIo.Reset       = UsbMassReset;
-  UsbMass->BlockIo.ReadBlocks  = UsbMassReadBlocks;
-  UsbMass->BlockIo.WriteBlocks = UsbMassWriteBlocks;
-  UsbMass->BlockIo.FlushBlocks = UsbMassFlushBlocks;
-  UsbMass->OpticalStorage      = FALSE;
-  UsbMass->Transport           = Transport;
-  UsbMass->Context             = Context;
+  UsbMass->Signature              = USB_MASS_SIGNATURE;
+  UsbMass->Controller             = Controller;
+  UsbMass->UsbIo                  = UsbIo;
+  UsbMass->BlockIo.Media          = &UsbMass->BlockIoMedia;
+  UsbMass->BlockIo.Reset          = UsbMassReset;
+  UsbMass->BlockIo.ReadBlocks     = UsbMassReadBlocks;
+  UsbMass->BlockIo.WriteBlocks    = UsbMassWriteBlocks;
+  UsbMass->BlockIo.FlushBlocks    = UsbMassFlushBlocks;
+  UsbMass->BlockIo2.Media         = &UsbMass->BlockIoMedia;
+  UsbMass->BlockIo2.Reset         = UsbMassResetEx;
+  UsbMass->BlockIo2.ReadBlocksEx  = UsbMassReadBlocksEx;
+  UsbMass->BlockIo2.WriteBlocksEx = UsbMassWriteBlocksEx;
+  UsbMass->BlockIo2.FlushBlocksEx = UsbMassFlushBlocksEx;
+  UsbMass->OpticalStorage         = FALSE;
+  UsbMass->Transport              = Transport;
+  UsbMass->Context                = Context;
 
   //
   // Initialize the media parameter data for EFI_BLOCK_IO_MEDIA of Block I/O Protocol.
@@ -664,6 +830,8 @@ UsbMassInitNonLun (
                   &Controller,
                   &gEfiBlockIoProtocolGuid,
                   &UsbMass->BlockIo,
+                  &gEfiBlockIo2ProtocolGuid,
+                  &UsbMass->BlockIo2,
                   &gEfiDiskInfoProtocolGuid,
                   &UsbMass->DiskInfo,
                   NULL
@@ -973,6 +1141,8 @@ USBMassDriverBindingStop (
                     Controller,
                     &gEfiBlockIoProtocolGuid,
                     &UsbMass->BlockIo,
+                    &gEfiBlockIo2ProtocolGuid,
+                    &UsbMass->BlockIo2,
                     &gEfiDiskInfoProtocolGuid,
                     &UsbMass->DiskInfo,
                     NULL
@@ -1032,6 +1202,8 @@ USBMassDriverBindingStop (
                     UsbMass->DevicePath,
                     &gEfiBlockIoProtocolGuid,
                     &UsbMass->BlockIo,
+                    &gEfiBlockIo2ProtocolGuid,
+                    &UsbMass->BlockIo2,
                     &gEfiDiskInfoProtocolGuid,
                     &UsbMass->DiskInfo,
                     NULL
@@ -0,0 +1,365 @@
+/** @file
+  DXE Dispatcher order cache.
+
+  The order in which the DXE Dispatcher started drivers is recorded and saved
+  in a non-volatile variable. On the next boot the recorded order is replayed:
+  as long as the next driver of the recorded order can be scheduled, it is
+  placed on the mScheduledQueue directly, so the mDiscoveredList does not have
+  to be searched and every dependency expression does not have to be
+  evaluated again on every pass of the DXE Dispatcher.
+
+  Each replayed driver still has its dependency expression evaluated once
+  before it is scheduled, so the replay can never start a driver before its
+  dependencies are satisfied. The first time the recorded order does not hold,
+  the DXE Dispatcher falls back to its normal search of the mDiscoveredList.
+
+  The recorded order is only available once the variable services are, so the
+  drivers dispatched before the Variable Architectural Protocol is produced are
+  always dispatched by the normal search.
+
+Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DxeMain.h"
+
+extern LIST_ENTRY  mDiscoveredList;
+
+//
+// The order of the drivers dispatched during this boot
+//
+EDKII_DXE_DISPATCH_ORDER_ENTRY  *mDispatchOrderRecord        = NULL;
+UINTN                           mDispatchOrderRecordCount    = 0;
+UINTN                           mDispatchOrderRecordCapacity = 0;
+
+//
+// The order read from the variable, or last saved to it
+//
+EDKII_DXE_DISPATCH_ORDER  *mDispatchOrderSaved      = NULL;
+BOOLEAN                   mDispatchOrderLoaded      = FALSE;
+BOOLEAN                   mDispatchOrderReplay      = FALSE;
+UINTN                     mDispatchOrderReplayIndex = 0;
+
+/**
+  Fold the file name of a driver into 32 bits.
+
+  @param  DriverEntry   The driver.
+
+  @return The file name hash of the driver.
+
+**/
+STATIC
+UINT32
+CoreGetDispatchOrderFileNameHash (
+  IN EFI_CORE_DRIVER_ENTRY  *DriverEntry
+  )
+{
+  return ReadUnaligned32 ((UINT32 *)&DriverEntry->FileName) ^
+         ReadUnaligned32 ((UINT32 *)&DriverEntry->FileName + 1) ^
+         ReadUnaligned32 ((UINT32 *)&DriverEntry->FileName + 2) ^
+         ReadUnaligned32 ((UINT32 *)&DriverEntry->FileName + 3);
+}
+
+/**
+  Compute the CRC32 of the dependency expression of a driver.
+
+  @param  DriverEntry   The driver.
+
+  @return The CRC32 of the dependency expression, or 0 if the driver has none.
+
+**/
+STATIC
+UINT32
+CoreGetDispatchOrderDepexCrc (
+  IN EFI_CORE_DRIVER_ENTRY  *DriverEntry
+  )
+{
+  if ((DriverEntry->Depex == NULL) || (DriverEntry->DepexSize == 0)) {
+    return 0;
+  }
+
+  return CalculateCrc32 (DriverEntry->Depex, DriverEntry->DepexSize);
+}
+
+/**
+  Find the driver in the mDiscoveredList that a dispatch order entry refers to.
+
+  @param  OrderEntry    The dispatch order entry.
+  @param  DepexChanged  Returns TRUE if a driver with the same file name hash
+                        was found, but its dependency expression has changed.
+
+  @return The driver, or NULL if it has not been discovered yet.
+
+**/
+STATIC
+EFI_CORE_DRIVER_ENTRY *
+CoreFindDispatchOrderDriver (
+  IN  EDKII_DXE_DISPATCH_ORDER_ENTRY  *OrderEntry,
+  OUT BOOLEAN                         *DepexChanged
+  )
+{
+  LIST_ENTRY             *Link;
+  EFI_CORE_DRIVER_ENTRY  *DriverEntry;
+
+  *DepexChanged = FALSE;
+  for (Link = mDiscoveredList.ForwardLink; Link != &mDiscoveredList; Link = Link->ForwardLink) {
+    DriverEntry = CR (Link, EFI_CORE_DRIVER_ENTRY, Link, EFI_CORE_DRIVER_ENTRY_SIGNATURE);
+    if (DriverEntry->IsFvImage) {
+      continue;
+    }
+
+    if (CoreGetDispatchOrderFileNameHash (DriverEntry) == OrderEntry->FileNameHash) {
+      if (CoreGetDispatchOrderDepexCrc (DriverEntry) == OrderEntry->DepexCrc) {
+        return DriverEntry;
+      }
+
+      *DepexChanged = TRUE;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Read the dispatch order recorded during the previous boot.
+
+**/
+STATIC
+VOID
+CoreLoadDispatchOrder (
+  VOID
+  )
+{
+  EFI_STATUS                Status;
+  VOID                      *Interface;
+  UINTN                     Size;
+  EDKII_DXE_DISPATCH_ORDER  *Order;
+
+  Status = CoreLocateProtocol (&gEfiVariableArchProtocolGuid, NULL, &Interface);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  mDispatchOrderLoaded = TRUE;
+
+  Size   = 0;
+  Status = gDxeCoreRT->GetVariable (
+                         EDKII_DXE_DISPATCH_ORDER_VARIABLE_NAME,
+                         &gEdkiiDxeDispatchOrderVariableGuid,
+                         NULL,
+                         &Size,
+                         NULL
+                         );
+  if ((Status != EFI_BUFFER_TOO_SMALL) || (Size < sizeof (EDKII_DXE_DISPATCH_ORDER))) {
+    return;
+  }
+
+  Order = AllocatePool (Size);
+  if (Order == NULL) {
+    return;
+  }
+
+  Status = gDxeCoreRT->GetVariable (
+                         EDKII_DXE_DISPATCH_ORDER_VARIABLE_NAME,
+                         &gEdkiiDxeDispatchOrderVariableGuid,
+                         NULL,
+                         &Size,
+                         Order
+                         );
+  if (EFI_ERROR (Status) ||
+      (Order->Signature != EDKII_DXE_DISPATCH_ORDER_SIGNATURE) ||
+      (Order->Count > (Size - sizeof (EDKII_DXE_DISPATCH_ORDER)) / sizeof (EDKII_DXE_DISPATCH_ORDER_ENTRY)) ||
+      (Size != sizeof (EDKII_DXE_DISPATCH_ORDER) + Order->Count * sizeof (EDKII_DXE_DISPATCH_ORDER_ENTRY)))
+  {
+    FreePool (Order);
+    return;
+  }
+
+  mDispatchOrderSaved  = Order;
+  mDispatchOrderReplay = TRUE;
+}
+
+/**
+  Record that the DXE Dispatcher has started a driver.
+
+  @param  DriverEntry   The driver that has been started.
+
+**/
+VOID
+CoreRecordDispatchedDriver (
+  IN EFI_CORE_DRIVER_ENTRY  *DriverEntry
+  )
+{
+  EDKII_DXE_DISPATCH_ORDER_ENTRY  *Record;
+  UINTN                           Capacity;
+
+  if (!FeaturePcdGet (PcdDxeDispatchOrderCache)) {
+    return;
+  }
+
+  if (mDispatchOrderRecordCount == mDispatchOrderRecordCapacity) {
+    Capacity = MAX (mDispatchOrderRecordCapacity * 2, 64);
+    Record   = ReallocatePool (
+                 mDispatchOrderRecordCapacity * sizeof (EDKII_DXE_DISPATCH_ORDER_ENTRY),
+                 Capacity * sizeof (EDKII_DXE_DISPATCH_ORDER_ENTRY),
+                 mDispatchOrderRecord
+                 );
+    if (Record == NULL) {
+      return;
+    }
+
+    mDispatchOrderRecord         = Record;
+    mDispatchOrderRecordCapacity = Capacity;
+  }
+
+  mDispatchOrderRecord[mDispatchOrderRecordCount].FileNameHash = CoreGetDispatchOrderFileNameHash (DriverEntry);
+  mDispatchOrderRecord[mDispatchOrderRecordCount].DepexCrc     = CoreGetDispatchOrderDepexCrc (DriverEntry);
+  mDispatchOrderRecordCount++;
+}
+
+/**
+  Place the next drivers of the recorded dispatch order on the
+  mScheduledQueue.
+
+  @retval TRUE   One or more drivers were placed on the mScheduledQueue.
+  @retval FALSE  The next driver of the recorded dispatch order cannot be
+                 scheduled yet, so the mDiscoveredList has to be searched.
+
+**/
+BOOLEAN
+CoreReplayDispatchOrder (
+  VOID
+  )
+{
+  EDKII_DXE_DISPATCH_ORDER_ENTRY  *Entries;
+  EFI_CORE_DRIVER_ENTRY           *DriverEntry;
+  BOOLEAN                         DepexChanged;
+  BOOLEAN                         ReadyToRun;
+
+  if (!FeaturePcdGet (PcdDxeDispatchOrderCache)) {
+    return FALSE;
+  }
+
+  if (!mDispatchOrderLoaded) {
+    CoreLoadDispatchOrder ();
+  }
+
+  if (!mDispatchOrderReplay) {
+    return FALSE;
+  }
+
+  Entries    = (EDKII_DXE_DISPATCH_ORDER_ENTRY *)(mDispatchOrderSaved + 1);
+  ReadyToRun = FALSE;
+  while (mDispatchOrderReplayIndex < mDispatchOrderSaved->Count) {
+    DriverEntry = CoreFindDispatchOrderDriver (&Entries[mDispatchOrderReplayIndex], &DepexChanged);
+    if (DriverEntry == NULL) {
+      if (DepexChanged) {
+        //
+        // The firmware has changed since the order was recorded, stop the replay.
+        //
+        DEBUG ((DEBUG_DISPATCH, "DXE dispatch order cache is stale, stop the replay\n"));
+        mDispatchOrderReplay = FALSE;
+      }
+
+      break;
+    }
+
+    if (!DriverEntry->Dependent || DriverEntry->Before || DriverEntry->After) {
+      //
+      // The driver is already scheduled or started, or it is scheduled together
+      // with the driver it has a BEFORE or AFTER dependency on.
+      //
+      mDispatchOrderReplayIndex++;
+      continue;
+    }
+
+    if (DriverEntry->DepexProtocolError || !CoreIsSchedulable (DriverEntry)) {
+      break;
+    }
+
+    CoreInsertOnScheduledQueueWhileProcessingBeforeAndAfter (DriverEntry);
+    mDispatchOrderReplayIndex++;
+    ReadyToRun = TRUE;
+  }
+
+  if (mDispatchOrderReplayIndex == mDispatchOrderSaved->Count) {
+    mDispatchOrderReplay = FALSE;
+  }
+
+  return ReadyToRun;
+}
+
+/**
+  Save the order in which the DXE Dispatcher has started drivers, if it is
+  different from the order recorded during the previous boot.
+
+**/
+VOID
+CoreSaveDispatchOrder (
+  VOID
+  )
+{
+  EFI_STATUS                Status;
+  VOID                      *Interface;
+  UINTN                     Size;
+  EDKII_DXE_DISPATCH_ORDER  *Order;
+
+  if (!FeaturePcdGet (PcdDxeDispatchOrderCache) || (mDispatchOrderRecordCount == 0)) {
+    return;
+  }
+
+  Status = CoreLocateProtocol (&gEfiVariableWriteArchProtocolGuid, NULL, &Interface);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  //
+  // The DXE Dispatcher runs more than once per boot. Do not write the variable
+  // while the drivers started so far match the beginning of the saved order.
+  //
+  if ((mDispatchOrderSaved != NULL) &&
+      (mDispatchOrderRecordCount <= mDispatchOrderSaved->Count) &&
+      (CompareMem (
+         mDispatchOrderSaved + 1,
+         mDispatchOrderRecord,
+         mDispatchOrderRecordCount * sizeof (EDKII_DXE_DISPATCH_ORDER_ENTRY)
+         ) == 0))
+  {
+    return;
+  }
+
+  Size  = sizeof (EDKII_DXE_DISPATCH_ORDER) + mDispatchOrderRecordCount * sizeof (EDKII_DXE_DISPATCH_ORDER_ENTRY);
+  Order = AllocatePool (Size);
+  if (Order == NULL) {
+    return;
+  }
+
+  Order->Signature = EDKII_DXE_DISPATCH_ORDER_SIGNATURE;
+  Order->Count     = (UINT32)mDispatchOrderRecordCount;
+  CopyMem (Order + 1, mDispatchOrderRecord, mDispatchOrderRecordCount * sizeof (EDKII_DXE_DISPATCH_ORDER_ENTRY));
+
+  Status = gDxeCoreRT->SetVariable (
+                         EDKII_DXE_DISPATCH_ORDER_VARIABLE_NAME,
+                         &gEdkiiDxeDispatchOrderVariableGuid,
+                         EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS,
+                         Size,
+                         Order
+                         );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_DISPATCH, "Failed to save the DXE dispatch order - %r\n", Status));
+    FreePool (Order);
+    return;
+  }
+
+  //
+  // The replay of the old order is over by now, so it can be replaced with the
+  // order that has just been saved.
+  //
+  if (mDispatchOrderSaved != NULL) {
+    FreePool (mDispatchOrderSaved);
+  }
+
+  mDispatchOrderSaved  = Order;
+  mDispatchOrderReplay = FALSE;
+}
@@ -515,6 +515,8 @@ CoreDispatcher (
           );
         ASSERT (DriverEntry->ImageHandle != NULL);
 
+        CoreRecordDispatchedDriver (DriverEntry);
+
         Status = CoreStartImage (DriverEntry->ImageHandle, NULL, NULL);
 
         REPORT_STATUS_CODE_WITH_EXTENDED_DATA (
@@ -537,6 +539,15 @@ CoreDispatcher (
       CoreSignalEvent (DxeDispatchEvent);
     }
 
+    //
+    // Follow the dispatch order recorded during the previous boot while it
+    // holds, so the DriverList does not have to be searched.
+    //
+    if (CoreReplayDispatchOrder ()) {
+      ReadyToRun = TRUE;
+      continue;
+    }
+
     //
     // Search DriverList for items to place on Scheduled Queue
     //
@@ -564,6 +575,14 @@ CoreDispatcher (
         }
       }
     }
+
+    //
+    // Before giving up, wait for the work that drivers run on APs. Its
+    // completion may make more drivers ready to run.
+    //
+    if (!ReadyToRun && CoreJoinParallelWork ()) {
+      ReadyToRun = TRUE;
+    }
   } while (ReadyToRun);
 
   //
@@ -571,6 +590,8 @@ CoreDispatcher (
   //
   CoreCloseEvent (DxeDispatchEvent);
 
+  CoreSaveDispatchOrder ();
+
   gDispatcherRunning = FALSE;
 
   PERF_FUNCTION_END ();
@@ -0,0 +1,332 @@
+/** @file
+  DXE Core support for running driver initialization work on APs.
+
+  Procedures queued through the EDKII_PARALLEL_DISPATCH_PROTOCOL are started
+  on idle APs through the MP Services Protocol as soon as it is available. The
+  DXE Dispatcher calls CoreJoinParallelWork () before it returns, which runs the
+  procedures that could not be started on an AP on the BSP and waits for the
+  others to complete.
+
+Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DxeMain.h"
+
+#define PARALLEL_WORK_SIGNATURE  SIGNATURE_32('p','w','r','k')
+
+typedef struct {
+  UINTN               Signature;
+  LIST_ENTRY          Link;
+  EFI_AP_PROCEDURE    Procedure;
+  VOID                *Argument;
+  EFI_EVENT           CompletionEvent;
+  EFI_EVENT           WaitEvent;
+  UINTN               ProcessorNumber;
+} PARALLEL_WORK_ENTRY;
+
+//
+// State of a processor for running parallel work
+//
+#define PARALLEL_WORK_AP_IDLE      0
+#define PARALLEL_WORK_AP_BUSY      1
+#define PARALLEL_WORK_AP_UNUSABLE  2
+
+//
+// mParallelWorkPending - Work that has not been started yet
+// mParallelWorkRunning - Work that is running on an AP
+//
+LIST_ENTRY  mParallelWorkPending = INITIALIZE_LIST_HEAD_VARIABLE (mParallelWorkPending);
+LIST_ENTRY  mParallelWorkRunning = INITIALIZE_LIST_HEAD_VARIABLE (mParallelWorkRunning);
+EFI_LOCK    mParallelWorkLock    = EFI_INITIALIZE_LOCK_VARIABLE (TPL_CALLBACK);
+
+UINT8  *mParallelWorkApState   = NULL;
+UINTN  mParallelWorkProcessors = 0;
+
+EDKII_PARALLEL_DISPATCH_PROTOCOL  gParallelDispatch = {
+  CoreQueueParallelProcedure
+};
+
+/**
+  Return the state array of the processors, creating it the first time the MP
+  Services Protocol is found.
+
+  @retval TRUE   Work can be started on APs.
+  @retval FALSE  The MP Services Protocol is not available, or there are no APs.
+
+**/
+STATIC
+BOOLEAN
+CoreInitializeParallelWorkProcessors (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       NumberOfProcessors;
+  UINTN       NumberOfEnabledProcessors;
+  UINTN       BspNumber;
+
+  if (mParallelWorkApState != NULL) {
+    return TRUE;
+  }
+
+  if (gMpService == NULL) {
+    return FALSE;
+  }
+
+  Status = gMpService->GetNumberOfProcessors (gMpService, &NumberOfProcessors, &NumberOfEnabledProcessors);
+  if (EFI_ERROR (Status) || (NumberOfEnabledProcessors < 2)) {
+    return FALSE;
+  }
+
+  Status = gMpService->WhoAmI (gMpService, &BspNumber);
+  if (EFI_ERROR (Status)) {
+    return FALSE;
+  }
+
+  mParallelWorkApState = AllocateZeroPool (NumberOfProcessors);
+  if (mParallelWorkApState == NULL) {
+    return FALSE;
+  }
+
+  mParallelWorkProcessors         = NumberOfProcessors;
+  mParallelWorkApState[BspNumber] = PARALLEL_WORK_AP_UNUSABLE;
+  return TRUE;
+}
+
+/**
+  Notification function signaled by the MP Services Protocol when a procedure
+  completes on an AP.
+
+  @param  Event           The event that is signaled.
+  @param  Context         The PARALLEL_WORK_ENTRY of the procedure.
+
+**/
+VOID
+EFIAPI
+CoreParallelWorkDone (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  );
+
+/**
+  Start pending work on idle APs.
+
+**/
+STATIC
+VOID
+CoreStartParallelWork (
+  VOID
+  )
+{
+  EFI_STATUS           Status;
+  PARALLEL_WORK_ENTRY  *Entry;
+  UINTN                Index;
+
+  ASSERT_LOCKED (&mParallelWorkLock);
+
+  if (!CoreInitializeParallelWorkProcessors ()) {
+    return;
+  }
+
+  Index = 0;
+  while (!IsListEmpty (&mParallelWorkPending)) {
+    Entry = CR (mParallelWorkPending.ForwardLink, PARALLEL_WORK_ENTRY, Link, PARALLEL_WORK_SIGNATURE);
+
+    //
+    // Find an idle AP
+    //
+    while ((Index < mParallelWorkProcessors) && (mParallelWorkApState[Index] != PARALLEL_WORK_AP_IDLE)) {
+      Index++;
+    }
+
+    if (Index == mParallelWorkProcessors) {
+      return;
+    }
+
+    if (Entry->WaitEvent == NULL) {
+      Status = CoreCreateEvent (
+                 EVT_NOTIFY_SIGNAL,
+                 TPL_CALLBACK,
+                 CoreParallelWorkDone,
+                 Entry,
+                 &Entry->WaitEvent
+                 );
+      if (EFI_ERROR (Status)) {
+        return;
+      }
+    }
+
+    Status = gMpService->StartupThisAP (
+                           gMpService,
+                           Entry->Procedure,
+                           Index,
+                           Entry->WaitEvent,
+                           0,
+                           Entry->Argument,
+                           NULL
+                           );
+    if (EFI_ERROR (Status)) {
+      //
+      // The AP is disabled or in use by someone else, do not try it again
+      //
+      mParallelWorkApState[Index] = PARALLEL_WORK_AP_UNUSABLE;
+      continue;
+    }
+
+    mParallelWorkApState[Index] = PARALLEL_WORK_AP_BUSY;
+    Entry->ProcessorNumber      = Index;
+    RemoveEntryList (&Entry->Link);
+    InsertTailList (&mParallelWorkRunning, &Entry->Link);
+  }
+}
+
+/**
+  Signal the completion event of a work entry and free it.
+
+  @param  Entry           The work entry that has completed.
+
+**/
+STATIC
+VOID
+CoreCompleteParallelWork (
+  IN PARALLEL_WORK_ENTRY  *Entry
+  )
+{
+  if (Entry->WaitEvent != NULL) {
+    CoreCloseEvent (Entry->WaitEvent);
+  }
+
+  if (Entry->CompletionEvent != NULL) {
+    CoreSignalEvent (Entry->CompletionEvent);
+  }
+
+  CoreFreePool (Entry);
+}
+
+/**
+  Notification function signaled by the MP Services Protocol when a procedure
+  completes on an AP.
+
+  @param  Event           The event that is signaled.
+  @param  Context         The PARALLEL_WORK_ENTRY of the procedure.
+
+**/
+VOID
+EFIAPI
+CoreParallelWorkDone (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  PARALLEL_WORK_ENTRY  *Entry;
+
+  Entry = Context;
+  ASSERT (Entry->Signature == PARALLEL_WORK_SIGNATURE);
+
+  CoreAcquireLock (&mParallelWorkLock);
+
+  RemoveEntryList (&Entry->Link);
+  mParallelWorkApState[Entry->ProcessorNumber] = PARALLEL_WORK_AP_IDLE;
+  CoreCompleteParallelWork (Entry);
+
+  CoreStartParallelWork ();
+
+  CoreReleaseLock (&mParallelWorkLock);
+}
+
+/**
+  Queue a procedure to run in parallel with the DXE Dispatcher.
+
+  @param  This            The EDKII_PARALLEL_DISPATCH_PROTOCOL instance.
+  @param  Procedure       The procedure to run.
+  @param  Argument        The argument passed to Procedure.
+  @param  CompletionEvent Optional event that is signaled on the BSP once
+                          Procedure has returned.
+
+  @retval EFI_SUCCESS            The procedure was queued.
+  @retval EFI_INVALID_PARAMETER  Procedure is NULL.
+  @retval EFI_OUT_OF_RESOURCES   There are not enough resources to queue the
+                                 procedure.
+
+**/
+EFI_STATUS
+EFIAPI
+CoreQueueParallelProcedure (
+  IN EDKII_PARALLEL_DISPATCH_PROTOCOL  *This,
+  IN EFI_AP_PROCEDURE                  Procedure,
+  IN VOID                              *Argument OPTIONAL,
+  IN EFI_EVENT                         CompletionEvent OPTIONAL
+  )
+{
+  PARALLEL_WORK_ENTRY  *Entry;
+
+  if (Procedure == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Entry = AllocateZeroPool (sizeof (PARALLEL_WORK_ENTRY));
+  if (Entry == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Entry->Signature       = PARALLEL_WORK_SIGNATURE;
+  Entry->Procedure       = Procedure;
+  Entry->Argument        = Argument;
+  Entry->CompletionEvent = CompletionEvent;
+
+  CoreAcquireLock (&mParallelWorkLock);
+  InsertTailList (&mParallelWorkPending, &Entry->Link);
+  CoreStartParallelWork ();
+  CoreReleaseLock (&mParallelWorkLock);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Wait for all queued parallel work to complete. Work that could not be
+  started on an AP is run on the BSP.
+
+  @retval TRUE   Some work was completed, so more drivers may have become
+                 ready to be dispatched.
+  @retval FALSE  There was no queued work.
+
+**/
+BOOLEAN
+CoreJoinParallelWork (
+  VOID
+  )
+{
+  PARALLEL_WORK_ENTRY  *Entry;
+  BOOLEAN              Joined;
+
+  Joined = FALSE;
+
+  CoreAcquireLock (&mParallelWorkLock);
+  CoreStartParallelWork ();
+  while (!IsListEmpty (&mParallelWorkPending)) {
+    Entry = CR (mParallelWorkPending.ForwardLink, PARALLEL_WORK_ENTRY, Link, PARALLEL_WORK_SIGNATURE);
+    RemoveEntryList (&Entry->Link);
+    CoreReleaseLock (&mParallelWorkLock);
+
+    Entry->Procedure (Entry->Argument);
+
+    CoreAcquireLock (&mParallelWorkLock);
+    CoreCompleteParallelWork (Entry);
+    Joined = TRUE;
+  }
+
+  CoreReleaseLock (&mParallelWorkLock);
+
+  //
+  // The running work is removed from the list by CoreParallelWorkDone (),
+  // which is dispatched while this loop waits at a lower TPL
+  //
+  while (!IsListEmpty (&mParallelWorkRunning) && (gEfiCurrentTpl < TPL_CALLBACK)) {
+    Joined = TRUE;
+    CoreSignalEvent (gIdleLoopEvent);
+  }
+
+  return Joined;
+}
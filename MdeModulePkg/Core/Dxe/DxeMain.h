@@ -45,6 +45,10 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Protocol/HiiPackageList.h>
 #include <Protocol/SmmBase2.h>
 #include <Protocol/PeCoffImageEmulator.h>
+#include <Protocol/MemoryMapGeneration.h>
+#include <Protocol/TimerDeadline.h>
+#include <Protocol/ParallelDispatch.h>
+#include <Protocol/MpService.h>
 #include <Guid/MemoryTypeInformation.h>
 #include <Guid/FirmwareFileSystem2.h>
 #include <Guid/FirmwareFileSystem3.h>
@@ -62,6 +66,10 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Guid/VectorHandoffTable.h>
 #include <Ppi/VectorHandoffInfo.h>
 #include <Guid/MemoryProfile.h>
+#include <Guid/DxeDispatchOrder.h>
+#include <Guid/FvFileTable.h>
+#include <Guid/DxeCoreTrace.h>
+#include <Guid/HobIndex.h>
 
 #include <Library/DxeCoreEntryPoint.h>
 #include <Library/DebugLib.h>
@@ -85,6 +93,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/DebugAgentLib.h>
 #include <Library/CpuExceptionHandlerLib.h>
 #include <Library/OrderedCollectionLib.h>
+#include <Library/TimerLib.h>
+#include <Library/SynchronizationLib.h>
 
 //
 // attributes for reserved memory before it is promoted to system memory
@@ -167,7 +177,8 @@ typedef struct {
 // The data structure of GCD memory map entry
 //
 #define EFI_GCD_MAP_SIGNATURE  SIGNATURE_32('g','c','d','m')
-typedef struct {
+typedef struct _EFI_GCD_MAP_ENTRY EFI_GCD_MAP_ENTRY;
+struct _EFI_GCD_MAP_ENTRY {
   UINTN                   Signature;
   LIST_ENTRY              Link;
   EFI_PHYSICAL_ADDRESS    BaseAddress;
@@ -178,7 +189,13 @@ typedef struct {
   EFI_GCD_IO_TYPE         GcdIoType;
   EFI_HANDLE              ImageHandle;
   EFI_HANDLE              DeviceHandle;
-} EFI_GCD_MAP_ENTRY;
+  ///
+  /// Search tree of the map, a treap ordered by BaseAddress
+  ///
+  EFI_GCD_MAP_ENTRY       *Left;
+  EFI_GCD_MAP_ENTRY       *Right;
+  UINT32                  Priority;
+};
 
 #define LOADED_IMAGE_PRIVATE_DATA_SIGNATURE  SIGNATURE_32('l','d','r','i')
 
@@ -241,6 +258,12 @@ extern BOOLEAN  gMemoryMapTerminated;
 
 extern EFI_DECOMPRESS_PROTOCOL  gEfiDecompress;
 
+extern EDKII_MEMORY_MAP_GENERATION_PROTOCOL  gMemoryMapGeneration;
+
+extern EDKII_PARALLEL_DISPATCH_PROTOCOL  gParallelDispatch;
+
+extern EFI_EVENT  gIdleLoopEvent;
+
 extern EFI_RUNTIME_ARCH_PROTOCOL         *gRuntime;
 extern EFI_CPU_ARCH_PROTOCOL             *gCpu;
 extern EFI_WATCHDOG_TIMER_ARCH_PROTOCOL  *gWatchdogTimer;
@@ -250,6 +273,8 @@ extern EFI_SECURITY_ARCH_PROTOCOL        *gSecurity;
 extern EFI_SECURITY2_ARCH_PROTOCOL       *gSecurity2;
 extern EFI_BDS_ARCH_PROTOCOL             *gBds;
 extern EFI_SMM_BASE2_PROTOCOL            *gSmmBase2;
+extern EDKII_TIMER_DEADLINE_PROTOCOL     *gTimerDeadline;
+extern EFI_MP_SERVICES_PROTOCOL          *gMpService;
 
 extern EFI_TPL  gEfiCurrentTpl;
 
@@ -1188,6 +1213,29 @@ CoreFreePages (
   IN UINTN                 NumberOfPages
   );
 
+/**
+  Record that the output of CoreGetMemoryMap() may have changed.
+
+**/
+VOID
+CoreUpdateMemoryMapGeneration (
+  VOID
+  );
+
+/**
+  Return the current generation number of the UEFI memory map.
+
+  @param[in] This  The EDKII_MEMORY_MAP_GENERATION_PROTOCOL instance.
+
+  @return The current generation number of the memory map.
+
+**/
+UINT64
+EFIAPI
+CoreGetMemoryMapGeneration (
+  IN EDKII_MEMORY_MAP_GENERATION_PROTOCOL  *This
+  );
+
 /**
   This function returns a copy of the current memory map. The map is an array of
   memory descriptors, each of which describes a contiguous block of memory.
@@ -1897,6 +1945,95 @@ CoreGetIoSpaceMap (
   OUT EFI_GCD_IO_SPACE_DESCRIPTOR  **IoSpaceMap
   );
 
+/**
+  Queue a procedure to run in parallel with the DXE Dispatcher.
+
+  @param  This            The EDKII_PARALLEL_DISPATCH_PROTOCOL instance.
+  @param  Procedure       The procedure to run.
+  @param  Argument        The argument passed to Procedure.
+  @param  CompletionEvent Optional event that is signaled on the BSP once
+                          Procedure has returned.
+
+  @retval EFI_SUCCESS            The procedure was queued.
+  @retval EFI_INVALID_PARAMETER  Procedure is NULL.
+  @retval EFI_OUT_OF_RESOURCES   There are not enough resources to queue the
+                                 procedure.
+
+**/
+EFI_STATUS
+EFIAPI
+CoreQueueParallelProcedure (
+  IN EDKII_PARALLEL_DISPATCH_PROTOCOL  *This,
+  IN EFI_AP_PROCEDURE                  Procedure,
+  IN VOID                              *Argument OPTIONAL,
+  IN EFI_EVENT                         CompletionEvent OPTIONAL
+  );
+
+/**
+  Wait for all queued parallel work to complete. Work that could not be
+  started on an AP is run on the BSP.
+
+  @retval TRUE   Some work was completed, so more drivers may have become
+                 ready to be dispatched.
+  @retval FALSE  There was no queued work.
+
+**/
+BOOLEAN
+CoreJoinParallelWork (
+  VOID
+  );
+
+/**
+  Insert InsertedDriverEntry onto the mScheduledQueue. To do this you
+  must add any driver with a before dependency on InsertedDriverEntry first.
+  You do this by recursively calling this routine. After all the Befores are
+  processed you can add InsertedDriverEntry to the mScheduledQueue.
+  Then you can add any driver with an After dependency on InsertedDriverEntry
+  by recursively calling this routine.
+
+  @param  InsertedDriverEntry   The driver to insert on the ScheduledLink Queue
+
+**/
+VOID
+CoreInsertOnScheduledQueueWhileProcessingBeforeAndAfter (
+  IN  EFI_CORE_DRIVER_ENTRY  *InsertedDriverEntry
+  );
+
+/**
+  Record that the DXE Dispatcher has started a driver.
+
+  @param  DriverEntry   The driver that has been started.
+
+**/
+VOID
+CoreRecordDispatchedDriver (
+  IN EFI_CORE_DRIVER_ENTRY  *DriverEntry
+  );
+
+/**
+  Place the next drivers of the dispatch order recorded during the previous
+  boot on the mScheduledQueue.
+
+  @retval TRUE   One or more drivers were placed on the mScheduledQueue.
+  @retval FALSE  The next driver of the recorded dispatch order cannot be
+                 scheduled yet, so the mDiscoveredList has to be searched.
+
+**/
+BOOLEAN
+CoreReplayDispatchOrder (
+  VOID
+  );
+
+/**
+  Save the order in which the DXE Dispatcher has started drivers, if it is
+  different from the order recorded during the previous boot.
+
+**/
+VOID
+CoreSaveDispatchOrder (
+  VOID
+  );
+
 /**
   This is the main Dispatcher for DXE and it exits when there are no more
   drivers to run. Drain the mScheduledQueue and load and start a PE
@@ -1975,6 +2112,77 @@ FwVolDriverInit (
   IN EFI_SYSTEM_TABLE  *SystemTable
   );
 
+/**
+  Locates a section in a given FFS File and returns a reference to it in the
+  section stream cached for the file, instead of a copy.
+
+  The section must not be modified, and the reference must be released with
+  ReleaseSectionReference() once the section is not used anymore.
+
+  @param  This                       Indicates the calling context.
+  @param  NameGuid                   Pointer to an EFI_GUID, which is the
+                                     filename.
+  @param  SectionType                Indicates the section type to return.
+  @param  SectionInstance            Indicates which instance of sections with a
+                                     type of SectionType to return.
+  @param  Buffer                     On return, the section contents, not
+                                     including the section header.
+  @param  BufferSize                 On return, the size of the contents.
+  @param  AuthenticationStatus       On return, the authentication status, as
+                                     returned by FvReadFileSection().
+  @param  ReferenceHandle            On return, the handle to pass to
+                                     ReleaseSectionReference().
+
+  @retval EFI_SUCCESS                The reference was returned.
+  @retval EFI_UNSUPPORTED            The FV is not produced by the DXE Core.
+  @retval EFI_INVALID_PARAMETER      NameGuid is NULL.
+  @retval others                     The errors returned by FvReadFileSection()
+                                     when the section is not found.
+
+**/
+EFI_STATUS
+FvReadFileSectionReference (
+  IN  CONST EFI_FIRMWARE_VOLUME2_PROTOCOL  *This,
+  IN  CONST EFI_GUID                       *NameGuid,
+  IN  EFI_SECTION_TYPE                     SectionType,
+  IN  UINTN                                SectionInstance,
+  OUT VOID                                 **Buffer,
+  OUT UINTN                                *BufferSize,
+  OUT UINT32                               *AuthenticationStatus,
+  OUT UINTN                                *ReferenceHandle
+  );
+
+/**
+  Locate the PE32 section of a file in a memory mapped FV, so that the image
+  can be executed in place.
+
+  Only a PE32 section stored directly in the file is returned, not one in an
+  encapsulation section. The file must have been read already, so that later
+  reads of the file are served from the cached copy and not from the image
+  executed in place. The section of a file is returned once only, since
+  executing the image modifies it.
+
+  @param  This               The EFI_FIRMWARE_VOLUME2_PROTOCOL instance.
+  @param  NameGuid           The name of the file.
+  @param  Pe32Data           On return, the PE32 image in the FV.
+  @param  Pe32Size           On return, the size of the PE32 image.
+
+  @retval EFI_SUCCESS           The PE32 image was found.
+  @retval EFI_UNSUPPORTED       The FV is not produced by the DXE Core, or is
+                                not memory mapped.
+  @retval EFI_NOT_READY         The file has not been read yet.
+  @retval EFI_ALREADY_STARTED   The PE32 image of the file was returned before.
+  @retval EFI_NOT_FOUND         The file or its PE32 section was not found.
+
+**/
+EFI_STATUS
+FvLocateImageInPlace (
+  IN  CONST EFI_FIRMWARE_VOLUME2_PROTOCOL  *This,
+  IN  CONST EFI_GUID                       *NameGuid,
+  OUT VOID                                 **Pe32Data,
+  OUT UINTN                                *Pe32Size
+  );
+
 /**
   Entry point of the section extraction code. Initializes an instance of the
   section extraction interface and installs it on a new handle.
@@ -2322,6 +2530,65 @@ GetSection (
   IN BOOLEAN           IsFfs3Fv
   );
 
+/**
+  Retrieves a reference to the requested section of a section stream, instead
+  of a copy of it.
+
+  The section must not be modified. It stays valid until the reference is
+  released with ReleaseSectionReference(), even if the stream is closed.
+
+  @param  SectionStreamHandle   The section stream from which to extract the
+                                requested section.
+  @param  SectionType           A pointer to the type of section to search for,
+                                or NULL for the whole section stream.
+  @param  SectionDefinitionGuid If the section type is EFI_SECTION_GUID_DEFINED,
+                                then SectionDefinitionGuid indicates which of
+                                these types of sections to search for.
+  @param  SectionInstance       Indicates which instance of the requested
+                                section to return.
+  @param  Buffer                On return, the contents of the section.
+  @param  BufferSize            On return, the size of the contents.
+  @param  AuthenticationStatus  On return, the authentication status of the
+                                section, as returned by GetSection().
+  @param  ReferenceHandle       On return, the handle to pass to
+                                ReleaseSectionReference().
+  @param  IsFfs3Fv              Indicates the FV format.
+
+  @retval EFI_SUCCESS           The reference was returned.
+  @retval EFI_INVALID_PARAMETER The SectionStreamHandle does not exist.
+  @retval others                The errors returned by GetSection() when the
+                                section is not found.
+
+**/
+EFI_STATUS
+GetSectionReference (
+  IN  UINTN             SectionStreamHandle,
+  IN  EFI_SECTION_TYPE  *SectionType,
+  IN  EFI_GUID          *SectionDefinitionGuid,
+  IN  UINTN             SectionInstance,
+  OUT VOID              **Buffer,
+  OUT UINTN             *BufferSize,
+  OUT UINT32            *AuthenticationStatus,
+  OUT UINTN             *ReferenceHandle,
+  IN  BOOLEAN           IsFfs3Fv
+  );
+
+/**
+  Release a reference returned by GetSectionReference().
+
+  @param  ReferenceHandle        The reference handle returned by
+                                 GetSectionReference().
+
+  @retval EFI_SUCCESS            The reference was released.
+  @retval EFI_INVALID_PARAMETER  ReferenceHandle does not refer to a referenced
+                                 stream.
+
+**/
+EFI_STATUS
+ReleaseSectionReference (
+  IN UINTN  ReferenceHandle
+  );
+
 /**
   SEP member function.  Deletes an existing section stream
 
@@ -2791,6 +3058,32 @@ MergeMemoryMap (
   IN UINTN                      DescriptorSize
   );
 
+/**
+  Allocate the DXE Core trace and stall tables that are enabled, install them
+  in the EFI System Table and route the traced boot services through their
+  wrappers.
+
+**/
+VOID
+CoreInitializeTraceTable (
+  VOID
+  );
+
+/**
+  Build the index of the HOB list and install it in the EFI System Table.
+
+  This must be called after memory services are available and the HOB list
+  has been relocated. Nothing is done if PcdDxeCoreHobIndex is FALSE, or if
+  the index cannot be allocated.
+
+  @param  HobStart  The HOB list.
+
+**/
+VOID
+CoreInitializeHobIndex (
+  IN VOID  *HobStart
+  );
+
 /**
   Initializes "handle" support.
 
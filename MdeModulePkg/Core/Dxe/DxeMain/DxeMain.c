@@ -27,7 +27,9 @@ EFI_WATCHDOG_TIMER_ARCH_PROTOCOL  *gWatchdogTimer = NULL;
 //
 // DXE Core globals for optional protocol dependencies
 //
-EFI_SMM_BASE2_PROTOCOL  *gSmmBase2 = NULL;
+EFI_SMM_BASE2_PROTOCOL         *gSmmBase2      = NULL;
+EDKII_TIMER_DEADLINE_PROTOCOL  *gTimerDeadline = NULL;
+EFI_MP_SERVICES_PROTOCOL       *gMpService     = NULL;
 
 //
 // DXE Core Global used to update core loaded image protocol handle
@@ -359,12 +361,22 @@ DxeMain (
   Status = CoreInstallConfigurationTable (&gEfiHobListGuid, HobStart);
   ASSERT_EFI_ERROR (Status);
 
+  //
+  // Install the index of the HOB list, if it is enabled
+  //
+  CoreInitializeHobIndex (HobStart);
+
   //
   // Install Memory Type Information Table into the EFI System Tables's Configuration Table
   //
   Status = CoreInstallConfigurationTable (&gEfiMemoryTypeInformationGuid, &gMemoryTypeInformation);
   ASSERT_EFI_ERROR (Status);
 
+  //
+  // Start tracing the boot services called by drivers, if it is enabled
+  //
+  CoreInitializeTraceTable ();
+
   //
   // If Loading modules At fixed address feature is enabled, install Load moduels at fixed address
   // Configuration Table so that user could easily to retrieve the top address to load Dxe and PEI
@@ -509,6 +521,19 @@ DxeMain (
              );
   ASSERT_EFI_ERROR (Status);
 
+  //
+  // Publish the memory map generation and parallel dispatch protocols
+  //
+  Status = CoreInstallMultipleProtocolInterfaces (
+             &mDecompressHandle,
+             &gEdkiiMemoryMapGenerationProtocolGuid,
+             &gMemoryMapGeneration,
+             &gEdkiiParallelDispatchProtocolGuid,
+             &gParallelDispatch,
+             NULL
+             );
+  ASSERT_EFI_ERROR (Status);
+
   //
   // Register for the GUIDs of the Architectural Protocols, so the rest of the
   // EFI Boot Services and EFI Runtime Services tables can be filled in.
@@ -1,7 +1,7 @@
 /** @file
   UEFI Event support functions implemented in this file.
 
-Copyright (c) 2006 - 2017, Intel Corporation. All rights reserved.<BR>
+Copyright (c) 2006 - 2024, Intel Corporation. All rights reserved.<BR>
 (C) Copyright 2015 Hewlett Packard Enterprise Development LP<BR>
 SPDX-License-Identifier: BSD-2-Clause-Patent
 
@@ -31,9 +31,11 @@ LIST_ENTRY  gEventQueue[TPL_HIGH_LEVEL + 1];
 UINTN  gEventPending = 0;
 
 ///
-/// gEventSignalQueue - A list of events to signal based on EventGroup type
+/// gEventGroupList - A list of EVENT_GROUP_ENTRY, each holding the events to
+/// signal for one EventGroup. Signal events created without an EventGroup are
+/// kept in the entry of the zero GUID.
 ///
-LIST_ENTRY  gEventSignalQueue = INITIALIZE_LIST_HEAD_VARIABLE (gEventSignalQueue);
+LIST_ENTRY  gEventGroupList = INITIALIZE_LIST_HEAD_VARIABLE (gEventGroupList);
 
 ///
 /// Enumerate the valid types
@@ -228,6 +230,97 @@ CoreNotifyEvent (
   gEventPending |= (UINTN)(1 << Event->NotifyTpl);
 }
 
+/**
+  Finds the entry of an event group.
+  The gEventQueueLock must be owned
+
+  @param  EventGroup             The GUID of the event group
+
+  @return The event group entry, or NULL if no signal event was ever created
+          in the group.
+
+**/
+STATIC
+EVENT_GROUP_ENTRY *
+CoreFindEventGroupEntry (
+  IN CONST EFI_GUID  *EventGroup
+  )
+{
+  LIST_ENTRY         *Link;
+  EVENT_GROUP_ENTRY  *GroupEntry;
+
+  ASSERT_LOCKED (&gEventQueueLock);
+
+  for (Link = gEventGroupList.ForwardLink; Link != &gEventGroupList; Link = Link->ForwardLink) {
+    GroupEntry = CR (Link, EVENT_GROUP_ENTRY, Link, EVENT_GROUP_ENTRY_SIGNATURE);
+    if (CompareGuid (&GroupEntry->EventGroup, EventGroup)) {
+      return GroupEntry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Creates the entry of an event group if it does not exist yet.
+
+  Event group entries are never freed, like the protocol entries of the
+  protocol database.
+
+  @param  EventGroup             The GUID of the event group
+
+  @retval EFI_SUCCESS            The event group entry exists
+  @retval EFI_OUT_OF_RESOURCES   The event group entry could not be allocated
+
+**/
+STATIC
+EFI_STATUS
+CoreCreateEventGroupEntry (
+  IN CONST EFI_GUID  *EventGroup
+  )
+{
+  EVENT_GROUP_ENTRY  *GroupEntry;
+  EVENT_GROUP_ENTRY  *NewGroupEntry;
+
+  CoreAcquireEventLock ();
+  GroupEntry = CoreFindEventGroupEntry (EventGroup);
+  CoreReleaseEventLock ();
+
+  if (GroupEntry != NULL) {
+    return EFI_SUCCESS;
+  }
+
+  //
+  // Pool memory cannot be allocated with the event lock held
+  //
+  NewGroupEntry = AllocatePool (sizeof (EVENT_GROUP_ENTRY));
+  if (NewGroupEntry == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  NewGroupEntry->Signature = EVENT_GROUP_ENTRY_SIGNATURE;
+  CopyGuid (&NewGroupEntry->EventGroup, EventGroup);
+  InitializeListHead (&NewGroupEntry->Events);
+
+  //
+  // Another caller at a higher TPL may have created the entry meanwhile
+  //
+  CoreAcquireEventLock ();
+  GroupEntry = CoreFindEventGroupEntry (EventGroup);
+  if (GroupEntry == NULL) {
+    InsertTailList (&gEventGroupList, &NewGroupEntry->Link);
+    NewGroupEntry = NULL;
+  }
+
+  CoreReleaseEventLock ();
+
+  if (NewGroupEntry != NULL) {
+    FreePool (NewGroupEntry);
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Signals all events in the EventGroup.
 
@@ -239,16 +332,21 @@ CoreNotifySignalList (
   IN EFI_GUID  *EventGroup
   )
 {
-  LIST_ENTRY  *Link;
-  LIST_ENTRY  *Head;
-  IEVENT      *Event;
+  LIST_ENTRY         *Link;
+  LIST_ENTRY         *Head;
+  IEVENT             *Event;
+  EVENT_GROUP_ENTRY  *GroupEntry;
 
   CoreAcquireEventLock ();
 
-  Head = &gEventSignalQueue;
-  for (Link = Head->ForwardLink; Link != Head; Link = Link->ForwardLink) {
-    Event = CR (Link, IEVENT, SignalLink, EVENT_SIGNATURE);
-    if (CompareGuid (&Event->EventGroup, EventGroup)) {
+  //
+  // Only the members of the group are walked, not all signal events
+  //
+  GroupEntry = CoreFindEventGroupEntry (EventGroup);
+  if (GroupEntry != NULL) {
+    Head = &GroupEntry->Events;
+    for (Link = Head->ForwardLink; Link != Head; Link = Link->ForwardLink) {
+      Event = CR (Link, IEVENT, SignalLink, EVENT_SIGNATURE);
       CoreNotifyEvent (Event);
     }
   }
@@ -364,9 +462,10 @@ CoreCreateEventInternal (
   OUT EFI_EVENT        *Event
   )
 {
-  EFI_STATUS  Status;
-  IEVENT      *IEvent;
-  INTN        Index;
+  EFI_STATUS         Status;
+  IEVENT             *IEvent;
+  INTN               Index;
+  EVENT_GROUP_ENTRY  *GroupEntry;
 
   if (Event == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -461,6 +560,14 @@ CoreCreateEventInternal (
     IEvent->ExFlag |= EVT_EXFLAG_EVENT_GROUP;
   }
 
+  if ((Type & EVT_NOTIFY_SIGNAL) != 0x00000000) {
+    Status = CoreCreateEventGroupEntry (&IEvent->EventGroup);
+    if (EFI_ERROR (Status)) {
+      FreePool (IEvent);
+      return Status;
+    }
+  }
+
   *Event = IEvent;
 
   if ((Type & EVT_RUNTIME) != 0) {
@@ -489,7 +596,9 @@ CoreCreateEventInternal (
     //
     // The Event's NotifyFunction must be queued whenever the event is signaled
     //
-    InsertHeadList (&gEventSignalQueue, &IEvent->SignalLink);
+    GroupEntry = CoreFindEventGroupEntry (&IEvent->EventGroup);
+    ASSERT (GroupEntry != NULL);
+    InsertHeadList (&GroupEntry->Events, &IEvent->SignalLink);
   }
 
   CoreReleaseEventLock ();
@@ -60,6 +60,21 @@ typedef struct {
   TIMER_EVENT_INFO           Timer;
 } IEVENT;
 
+#define EVENT_GROUP_ENTRY_SIGNATURE  SIGNATURE_32('e','v','g','p')
+
+///
+/// EVENT_GROUP_ENTRY - The signal events of one event group
+///
+typedef struct {
+  UINTN         Signature;
+  /// Link Entry inserted to gEventGroupList
+  LIST_ENTRY    Link;
+  /// GUID of the event group
+  EFI_GUID      EventGroup;
+  /// The SignalLink of all signal events in the group
+  LIST_ENTRY    Events;
+} EVENT_GROUP_ENTRY;
+
 //
 // Internal prototypes
 //
@@ -9,13 +9,29 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include "DxeMain.h"
 #include "Event.h"
 
+//
+// The timer database is a hierarchical timer wheel. Time is divided in slots
+// of 2^TIMER_WHEEL_SLOT_SHIFT 100ns units. Level 0 of the wheel holds the
+// timers that expire within the next TIMER_WHEEL_SIZE slots, one list per
+// slot, and each following level covers TIMER_WHEEL_SIZE times the range of
+// the level below. When the slots of a level wrap around, the timers of the
+// next slot of the level above are moved down ("cascaded") the wheel.
+//
+#define TIMER_WHEEL_SLOT_SHIFT  14
+#define TIMER_WHEEL_BITS        6
+#define TIMER_WHEEL_SIZE        (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_MASK        (TIMER_WHEEL_SIZE - 1)
+#define TIMER_WHEEL_LEVELS      4
+
 //
 // Internal data
 //
 
-LIST_ENTRY  mEfiTimerList       = INITIALIZE_LIST_HEAD_VARIABLE (mEfiTimerList);
-EFI_LOCK    mEfiTimerLock       = EFI_INITIALIZE_LOCK_VARIABLE (TPL_HIGH_LEVEL - 1);
-EFI_EVENT   mEfiCheckTimerEvent = NULL;
+LIST_ENTRY  mEfiTimerWheel[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SIZE];
+UINT64      mEfiTimerWheelSlot   = 0;
+UINT64      mEfiTimerNextTrigger = MAX_UINT64;
+EFI_LOCK    mEfiTimerLock        = EFI_INITIALIZE_LOCK_VARIABLE (TPL_HIGH_LEVEL - 1);
+EFI_EVENT   mEfiCheckTimerEvent  = NULL;
 
 EFI_LOCK  mEfiSystemTimeLock = EFI_INITIALIZE_LOCK_VARIABLE (TPL_HIGH_LEVEL);
 UINT64    mEfiSystemTime     = 0;
@@ -36,29 +52,231 @@ CoreInsertEventTimer (
   IN IEVENT  *Event
   )
 {
-  UINT64      TriggerTime;
-  LIST_ENTRY  *Link;
-  IEVENT      *Event2;
+  UINT64  Slot;
+  UINT64  Delta;
+  UINTN   Level;
+  UINTN   Index;
 
   ASSERT_LOCKED (&mEfiTimerLock);
 
   //
-  // Get the timer's trigger time
+  // Get the slot of the timer's trigger time. Timers that are already
+  // due go to the slot that is processed next.
   //
-  TriggerTime = Event->Timer.TriggerTime;
+  Slot = RShiftU64 (Event->Timer.TriggerTime, TIMER_WHEEL_SLOT_SHIFT);
+  if (Slot < mEfiTimerWheelSlot) {
+    Slot = mEfiTimerWheelSlot;
+  }
 
   //
-  // Insert the timer into the timer database in assending sorted order
+  // Select the level whose range covers the distance to the trigger time.
+  // Timers beyond the range of the top level are parked in its last slot,
+  // and placed again when that slot is cascaded.
   //
-  for (Link = mEfiTimerList.ForwardLink; Link != &mEfiTimerList; Link = Link->ForwardLink) {
-    Event2 = CR (Link, IEVENT, Timer.Link, EVENT_SIGNATURE);
+  Delta = Slot - mEfiTimerWheelSlot;
+  for (Level = 0; Level < TIMER_WHEEL_LEVELS - 1; Level++) {
+    if (Delta < LShiftU64 (TIMER_WHEEL_SIZE, Level * TIMER_WHEEL_BITS)) {
+      break;
+    }
+  }
+
+  if (Delta >= LShiftU64 (TIMER_WHEEL_SIZE, Level * TIMER_WHEEL_BITS)) {
+    Slot = mEfiTimerWheelSlot + LShiftU64 (TIMER_WHEEL_SIZE, Level * TIMER_WHEEL_BITS) - 1;
+  }
+
+  Index = (UINTN)RShiftU64 (Slot, Level * TIMER_WHEEL_BITS) & TIMER_WHEEL_MASK;
+  InsertTailList (&mEfiTimerWheel[Level][Index], &Event->Timer.Link);
 
-    if (Event2->Timer.TriggerTime > TriggerTime) {
+  if (Event->Timer.TriggerTime < mEfiTimerNextTrigger) {
+    mEfiTimerNextTrigger = Event->Timer.TriggerTime;
+  }
+}
+
+/**
+  Removes the timer event from the timer database.
+
+  @param  Event                  Points to the internal structure of timer event
+                                 to be removed
+
+**/
+STATIC
+VOID
+CoreRemoveEventTimer (
+  IN IEVENT  *Event
+  )
+{
+  ASSERT_LOCKED (&mEfiTimerLock);
+
+  RemoveEntryList (&Event->Timer.Link);
+  Event->Timer.Link.ForwardLink = NULL;
+}
+
+/**
+  Checks whether a level of the timer wheel holds no timers.
+
+  @param  Level                  The level of the timer wheel.
+
+  @retval TRUE                   All slots of the level are empty.
+  @retval FALSE                  At least one timer is queued in the level.
+
+**/
+STATIC
+BOOLEAN
+CoreIsTimerWheelLevelEmpty (
+  IN UINTN  Level
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < TIMER_WHEEL_SIZE; Index++) {
+    if (!IsListEmpty (&mEfiTimerWheel[Level][Index])) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Moves the timers of the current slot of a level down the timer wheel.
+
+  @param  Level                  The level of the timer wheel to cascade.
+
+**/
+STATIC
+VOID
+CoreCascadeTimerWheel (
+  IN UINTN  Level
+  )
+{
+  LIST_ENTRY  *Head;
+  IEVENT      *Event;
+
+  Head = &mEfiTimerWheel[Level][(UINTN)RShiftU64 (mEfiTimerWheelSlot, Level * TIMER_WHEEL_BITS) & TIMER_WHEEL_MASK];
+  while (!IsListEmpty (Head)) {
+    Event = CR (Head->ForwardLink, IEVENT, Timer.Link, EVENT_SIGNATURE);
+    RemoveEntryList (&Event->Timer.Link);
+    CoreInsertEventTimer (Event);
+  }
+}
+
+/**
+  Advances the timer wheel towards the slot of the current system time.
+
+  Slots are skipped as long as they and all slots of the levels below
+  them are empty, so the cost does not depend on how long it has been
+  since the timers were last checked.
+
+  @param  NowSlot                The slot of the current system time.
+
+**/
+STATIC
+VOID
+CoreAdvanceTimerWheel (
+  IN UINT64  NowSlot
+  )
+{
+  UINTN   Level;
+  UINT64  NextSlot;
+
+  //
+  // Find the lowest level that holds timers
+  //
+  for (Level = 0; Level < TIMER_WHEEL_LEVELS; Level++) {
+    if (!CoreIsTimerWheelLevelEmpty (Level)) {
+      break;
+    }
+  }
+
+  if (Level == TIMER_WHEEL_LEVELS) {
+    mEfiTimerWheelSlot = NowSlot;
+    return;
+  }
+
+  //
+  // Move to the next slot of that level, or to the current slot if that
+  // comes first. The levels below are empty, so nothing is missed.
+  //
+  NextSlot = LShiftU64 (RShiftU64 (mEfiTimerWheelSlot, Level * TIMER_WHEEL_BITS) + 1, Level * TIMER_WHEEL_BITS);
+  if (NextSlot > NowSlot) {
+    mEfiTimerWheelSlot = NowSlot;
+    return;
+  }
+
+  mEfiTimerWheelSlot = NextSlot;
+
+  //
+  // Cascade the levels whose slot boundary has been reached
+  //
+  for (Level = 1; Level < TIMER_WHEEL_LEVELS; Level++) {
+    if ((RShiftU64 (mEfiTimerWheelSlot, (Level - 1) * TIMER_WHEEL_BITS) & TIMER_WHEEL_MASK) != 0) {
       break;
     }
+
+    CoreCascadeTimerWheel (Level);
+  }
+}
+
+/**
+  Recomputes the earliest time at which a queued timer may expire.
+
+  The result is exact for the current slot and a lower bound for the
+  others, which is sufficient to know when the timers must be checked.
+
+**/
+STATIC
+VOID
+CoreUpdateNextTimerTrigger (
+  VOID
+  )
+{
+  UINT64      NextTrigger;
+  UINT64      Slot;
+  UINTN       Level;
+  UINTN       Offset;
+  LIST_ENTRY  *Head;
+  LIST_ENTRY  *Link;
+  IEVENT      *Event;
+
+  NextTrigger = MAX_UINT64;
+
+  Head = &mEfiTimerWheel[0][(UINTN)mEfiTimerWheelSlot & TIMER_WHEEL_MASK];
+  for (Link = Head->ForwardLink; Link != Head; Link = Link->ForwardLink) {
+    Event = CR (Link, IEVENT, Timer.Link, EVENT_SIGNATURE);
+    if (Event->Timer.TriggerTime < NextTrigger) {
+      NextTrigger = Event->Timer.TriggerTime;
+    }
   }
 
-  InsertTailList (Link, &Event->Timer.Link);
+  for (Level = 0; Level < TIMER_WHEEL_LEVELS; Level++) {
+    for (Offset = 1; Offset < TIMER_WHEEL_SIZE; Offset++) {
+      Slot = RShiftU64 (mEfiTimerWheelSlot, Level * TIMER_WHEEL_BITS) + Offset;
+      if (!IsListEmpty (&mEfiTimerWheel[Level][(UINTN)Slot & TIMER_WHEEL_MASK])) {
+        Slot = LShiftU64 (Slot, Level * TIMER_WHEEL_BITS + TIMER_WHEEL_SLOT_SHIFT);
+        if (Slot < NextTrigger) {
+          NextTrigger = Slot;
+        }
+
+        break;
+      }
+    }
+
+    //
+    // The current slot of the upper levels holds the timers that are a full
+    // turn of the level away
+    //
+    if (Level != 0) {
+      Slot = RShiftU64 (mEfiTimerWheelSlot, Level * TIMER_WHEEL_BITS) + TIMER_WHEEL_SIZE;
+      if (!IsListEmpty (&mEfiTimerWheel[Level][(UINTN)Slot & TIMER_WHEEL_MASK])) {
+        Slot = LShiftU64 (Slot, Level * TIMER_WHEEL_BITS + TIMER_WHEEL_SLOT_SHIFT);
+        if (Slot < NextTrigger) {
+          NextTrigger = Slot;
+        }
+      }
+    }
+  }
+
+  mEfiTimerNextTrigger = NextTrigger;
 }
 
 /**
@@ -73,16 +291,66 @@ CoreCurrentSystemTime (
   )
 {
   UINT64  SystemTime;
+  UINT64  ElapsedTime;
 
   CoreAcquireLock (&mEfiSystemTimeLock);
   SystemTime = mEfiSystemTime;
+
+  //
+  // Without periodic ticks the time since the last tick can be long,
+  // so account for it
+  //
+  if ((gTimerDeadline != NULL) &&
+      !EFI_ERROR (gTimerDeadline->GetElapsedTime (gTimerDeadline, &ElapsedTime)))
+  {
+    SystemTime += ElapsedTime;
+  }
+
   CoreReleaseLock (&mEfiSystemTimeLock);
 
   return SystemTime;
 }
 
 /**
-  Checks the sorted timer list against the current system time.
+  Tells the timer driver when the next timer may expire, if it supports
+  programming a deadline instead of raising periodic ticks.
+
+**/
+STATIC
+VOID
+CoreProgramTimerDeadline (
+  VOID
+  )
+{
+  UINT64  Deadline;
+
+  ASSERT_LOCKED (&mEfiTimerLock);
+
+  if (gTimerDeadline == NULL) {
+    return;
+  }
+
+  //
+  // The deadline is relative to the last tick, hold the system time lock
+  // so that no tick comes in between
+  //
+  CoreAcquireLock (&mEfiSystemTimeLock);
+
+  if (mEfiTimerNextTrigger == MAX_UINT64) {
+    Deadline = MAX_UINT64;
+  } else if (mEfiTimerNextTrigger > mEfiSystemTime) {
+    Deadline = mEfiTimerNextTrigger - mEfiSystemTime;
+  } else {
+    Deadline = 0;
+  }
+
+  gTimerDeadline->SetDeadline (gTimerDeadline, Deadline);
+
+  CoreReleaseLock (&mEfiSystemTimeLock);
+}
+
+/**
+  Checks the timer database against the current system time.
   Signals any expired event timer.
 
   @param  CheckEvent             Not used
@@ -96,61 +364,87 @@ CoreCheckTimers (
   IN VOID       *Context
   )
 {
-  UINT64  SystemTime;
-  IEVENT  *Event;
+  UINT64      SystemTime;
+  UINT64      NowSlot;
+  LIST_ENTRY  *Head;
+  LIST_ENTRY  Pending;
+  IEVENT      *Event;
 
   //
   // Check the timer database for expired timers
   //
   CoreAcquireLock (&mEfiTimerLock);
   SystemTime = CoreCurrentSystemTime ();
+  NowSlot    = RShiftU64 (SystemTime, TIMER_WHEEL_SLOT_SHIFT);
 
-  while (!IsListEmpty (&mEfiTimerList)) {
-    Event = CR (mEfiTimerList.ForwardLink, IEVENT, Timer.Link, EVENT_SIGNATURE);
-
+  while (TRUE) {
     //
-    // If this timer is not expired, then we're done
+    // Take the timers of the current slot. Timers that are re-armed below
+    // are queued again and are not looked at in this pass.
     //
-    if (Event->Timer.TriggerTime > SystemTime) {
-      break;
+    Head = &mEfiTimerWheel[0][(UINTN)mEfiTimerWheelSlot & TIMER_WHEEL_MASK];
+    InitializeListHead (&Pending);
+    while (!IsListEmpty (Head)) {
+      Event = CR (Head->ForwardLink, IEVENT, Timer.Link, EVENT_SIGNATURE);
+      RemoveEntryList (&Event->Timer.Link);
+      InsertTailList (&Pending, &Event->Timer.Link);
     }
 
-    //
-    // Remove this timer from the timer queue
-    //
-
-    RemoveEntryList (&Event->Timer.Link);
-    Event->Timer.Link.ForwardLink = NULL;
+    while (!IsListEmpty (&Pending)) {
+      Event = CR (Pending.ForwardLink, IEVENT, Timer.Link, EVENT_SIGNATURE);
 
-    //
-    // Signal it
-    //
-    CoreSignalEvent (Event);
-
-    //
-    // If this is a periodic timer, set it
-    //
-    if (Event->Timer.Period != 0) {
       //
-      // Compute the timers new trigger time
+      // Remove this timer from the timer queue
       //
-      Event->Timer.TriggerTime = Event->Timer.TriggerTime + Event->Timer.Period;
+      CoreRemoveEventTimer (Event);
 
       //
-      // If that's before now, then reset the timer to start from now
+      // If this timer is not expired, then put it back
       //
-      if (Event->Timer.TriggerTime <= SystemTime) {
-        Event->Timer.TriggerTime = SystemTime;
-        CoreSignalEvent (mEfiCheckTimerEvent);
+      if (Event->Timer.TriggerTime > SystemTime) {
+        CoreInsertEventTimer (Event);
+        continue;
       }
 
       //
-      // Add the timer
+      // Signal it
+      //
+      CoreSignalEvent (Event);
+
       //
-      CoreInsertEventTimer (Event);
+      // If this is a periodic timer, set it
+      //
+      if (Event->Timer.Period != 0) {
+        //
+        // Compute the timers new trigger time
+        //
+        Event->Timer.TriggerTime = Event->Timer.TriggerTime + Event->Timer.Period;
+
+        //
+        // If that's before now, then reset the timer to start from now
+        //
+        if (Event->Timer.TriggerTime <= SystemTime) {
+          Event->Timer.TriggerTime = SystemTime;
+          CoreSignalEvent (mEfiCheckTimerEvent);
+        }
+
+        //
+        // Add the timer
+        //
+        CoreInsertEventTimer (Event);
+      }
     }
+
+    if (mEfiTimerWheelSlot >= NowSlot) {
+      break;
+    }
+
+    CoreAdvanceTimerWheel (NowSlot);
   }
 
+  CoreUpdateNextTimerTrigger ();
+  CoreProgramTimerDeadline ();
+
   CoreReleaseLock (&mEfiTimerLock);
 }
 
@@ -164,6 +458,14 @@ CoreInitializeTimer (
   )
 {
   EFI_STATUS  Status;
+  UINTN       Level;
+  UINTN       Index;
+
+  for (Level = 0; Level < TIMER_WHEEL_LEVELS; Level++) {
+    for (Index = 0; Index < TIMER_WHEEL_SIZE; Index++) {
+      InitializeListHead (&mEfiTimerWheel[Level][Index]);
+    }
+  }
 
   Status = CoreCreateEventInternal (
              EVT_NOTIFY_SIGNAL,
@@ -189,8 +491,6 @@ CoreTimerTick (
   IN UINT64  Duration
   )
 {
-  IEVENT  *Event;
-
   //
   // Check runtiem flag in case there are ticks while exiting boot services
   //
@@ -202,15 +502,11 @@ CoreTimerTick (
   mEfiSystemTime += Duration;
 
   //
-  // If the head of the list is expired, fire the timer event
+  // If the earliest timer may have expired, fire the timer event
   // to process it
   //
-  if (!IsListEmpty (&mEfiTimerList)) {
-    Event = CR (mEfiTimerList.ForwardLink, IEVENT, Timer.Link, EVENT_SIGNATURE);
-
-    if (Event->Timer.TriggerTime <= mEfiSystemTime) {
-      CoreSignalEvent (mEfiCheckTimerEvent);
-    }
+  if (mEfiTimerNextTrigger <= mEfiSystemTime) {
+    CoreSignalEvent (mEfiCheckTimerEvent);
   }
 
   CoreReleaseLock (&mEfiSystemTimeLock);
@@ -261,8 +557,7 @@ CoreSetTimer (
   // If the timer is queued to the timer database, remove it
   //
   if (Event->Timer.Link.ForwardLink != NULL) {
-    RemoveEntryList (&Event->Timer.Link);
-    Event->Timer.Link.ForwardLink = NULL;
+    CoreRemoveEventTimer (Event);
   }
 
   Event->Timer.TriggerTime = 0;
@@ -279,6 +574,9 @@ CoreSetTimer (
 
     Event->Timer.TriggerTime = CoreCurrentSystemTime () + TriggerTime;
     CoreInsertEventTimer (Event);
+    if (Event->Timer.TriggerTime == mEfiTimerNextTrigger) {
+      CoreProgramTimerDeadline ();
+    }
 
     if (TriggerTime == 0) {
       CoreSignalEvent (mEfiCheckTimerEvent);
@@ -38,9 +38,12 @@ FV_DEVICE  mFvDevice = {
   NULL,
   NULL,
   { NULL,                 NULL},
+  NULL,
+  0,
   0,
   0,
   FALSE,
+  FALSE,
   FALSE
 };
 
@@ -281,6 +284,11 @@ FreeFvDeviceResource (
     FfsFileEntry = (FFS_FILE_LIST_ENTRY *)NextEntry;
   }
 
+  if (FvDevice->FfsFileHashTable != NULL) {
+    CoreFreePool (FvDevice->FfsFileHashTable);
+    FvDevice->FfsFileHashTable = NULL;
+  }
+
   if (!FvDevice->IsMemoryMapped) {
     //
     // Free the cached FV buffer.
@@ -296,6 +304,161 @@ FreeFvDeviceResource (
   return;
 }
 
+/**
+  Returns the FfsFileHashTable bucket that holds the file entries of a file name.
+
+  @param  FvDevice       The FV_DEVICE that contains the file.
+  @param  NameGuid       The name of the file.
+
+  @return The list head of the bucket.
+
+**/
+LIST_ENTRY *
+FvGetFileHashBucket (
+  IN FV_DEVICE       *FvDevice,
+  IN CONST EFI_GUID  *NameGuid
+  )
+{
+  UINT32  Hash;
+
+  ASSERT (FvDevice->FfsFileHashTable != NULL);
+
+  //
+  // File names are random enough that folding the four 32-bit words
+  // gives an even distribution over the buckets.
+  //
+  Hash  = ReadUnaligned32 ((UINT32 *)NameGuid);
+  Hash ^= ReadUnaligned32 ((UINT32 *)NameGuid + 1);
+  Hash ^= ReadUnaligned32 ((UINT32 *)NameGuid + 2);
+  Hash ^= ReadUnaligned32 ((UINT32 *)NameGuid + 3);
+
+  return &FvDevice->FfsFileHashTable[Hash % FvDevice->FfsFileHashBuckets];
+}
+
+/**
+  Index the file list of an FV by file name, so that FvReadFile() does not
+  have to walk the whole file list. Pad files are not indexed, just like
+  FvGetNextFile() skips them.
+
+  If there is not enough memory for the index, FvReadFile() falls back to
+  walking the file list.
+
+  @param  FvDevice              A pointer to the FvDevice whose file list is
+                                indexed.
+
+**/
+VOID
+FvBuildFileHashTable (
+  IN OUT FV_DEVICE  *FvDevice
+  )
+{
+  LIST_ENTRY           *Link;
+  FFS_FILE_LIST_ENTRY  *FfsFileEntry;
+  UINTN                FileCount;
+  UINTN                Index;
+
+  FileCount = 0;
+  for (Link = FvDevice->FfsFileListHeader.ForwardLink; Link != &FvDevice->FfsFileListHeader; Link = Link->ForwardLink) {
+    FileCount++;
+  }
+
+  if (FileCount == 0) {
+    return;
+  }
+
+  //
+  // One bucket per file keeps the expected chain length below two.
+  //
+  FvDevice->FfsFileHashTable = AllocatePool (FileCount * sizeof (LIST_ENTRY));
+  if (FvDevice->FfsFileHashTable == NULL) {
+    return;
+  }
+
+  FvDevice->FfsFileHashBuckets = FileCount;
+  for (Index = 0; Index < FileCount; Index++) {
+    InitializeListHead (&FvDevice->FfsFileHashTable[Index]);
+  }
+
+  for (Link = FvDevice->FfsFileListHeader.ForwardLink; Link != &FvDevice->FfsFileListHeader; Link = Link->ForwardLink) {
+    FfsFileEntry = (FFS_FILE_LIST_ENTRY *)Link;
+    if (FfsFileEntry->FfsHeader->Type == EFI_FV_FILETYPE_FFS_PAD) {
+      InitializeListHead (&FfsFileEntry->HashLink);
+      continue;
+    }
+
+    InsertTailList (FvGetFileHashBucket (FvDevice, &FfsFileEntry->FfsHeader->Name), &FfsFileEntry->HashLink);
+  }
+}
+
+/**
+  Build the file list of a memory mapped FV from the file table that the PEI
+  Core saved in a HOB for it, instead of walking the file headers of the FV.
+  The PEI Core only puts files that passed its checks into the table.
+
+  @param  FvDevice              A pointer to the FvDevice whose file list is
+                                built.
+
+  @retval EFI_SUCCESS           The file list has been built.
+  @retval EFI_NOT_FOUND         There is no usable file table for the FV.
+  @retval EFI_OUT_OF_RESOURCES  No enough buffer could be allocated.
+
+**/
+EFI_STATUS
+FvBuildFileListFromTable (
+  IN OUT FV_DEVICE  *FvDevice
+  )
+{
+  EFI_HOB_GUID_TYPE          *GuidHob;
+  EDKII_FV_FILE_TABLE        *FileTable;
+  EDKII_FV_FILE_TABLE_ENTRY  *Entry;
+  FFS_FILE_LIST_ENTRY        *FfsFileEntry;
+  UINTN                      Index;
+
+  for (GuidHob = GetFirstGuidHob (&gEdkiiFvFileTableHobGuid);
+       GuidHob != NULL;
+       GuidHob = GetNextGuidHob (&gEdkiiFvFileTableHobGuid, GET_NEXT_HOB (GuidHob)))
+  {
+    FileTable = GET_GUID_HOB_DATA (GuidHob);
+    if ((FileTable->FvBase == (EFI_PHYSICAL_ADDRESS)(UINTN)FvDevice->CachedFv) &&
+        (FileTable->FvLength == FvDevice->FwVolHeader->FvLength))
+    {
+      break;
+    }
+  }
+
+  if (GuidHob == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  if (GET_GUID_HOB_DATA_SIZE (GuidHob) < sizeof (EDKII_FV_FILE_TABLE) + FileTable->FileCount * sizeof (EDKII_FV_FILE_TABLE_ENTRY)) {
+    return EFI_NOT_FOUND;
+  }
+
+  Entry = (EDKII_FV_FILE_TABLE_ENTRY *)(FileTable + 1);
+  for (Index = 0; Index < FileTable->FileCount; Index++) {
+    if (Entry[Index].Offset > FileTable->FvLength - sizeof (EFI_FFS_FILE_HEADER)) {
+      //
+      // Ignore the table and walk the file headers instead.
+      //
+      DEBUG ((DEBUG_WARN, "Ignore the invalid file table of FV 0x%p\n", FvDevice->CachedFv));
+      return EFI_NOT_FOUND;
+    }
+  }
+
+  for (Index = 0; Index < FileTable->FileCount; Index++, Entry++) {
+    FfsFileEntry = AllocateZeroPool (sizeof (FFS_FILE_LIST_ENTRY));
+    if (FfsFileEntry == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    FfsFileEntry->FfsHeader       = (EFI_FFS_FILE_HEADER *)(FvDevice->CachedFv + Entry->Offset);
+    FfsFileEntry->MappedFfsHeader = FfsFileEntry->FfsHeader;
+    InsertTailList (&FvDevice->FfsFileListHeader, &FfsFileEntry->Link);
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Check if an FV is consistent and allocate cache for it.
 
@@ -330,6 +493,7 @@ FvCheck (
   BOOLEAN                             FileCached;
   UINTN                               WholeFileSize;
   EFI_FFS_FILE_HEADER                 *CacheFfsHeader;
+  EFI_GCD_MEMORY_SPACE_DESCRIPTOR     Descriptor;
 
   FileCached     = FALSE;
   CacheFfsHeader = NULL;
@@ -355,6 +519,21 @@ FvCheck (
     // Don't cache memory mapped FV really.
     //
     FvDevice->CachedFv = (UINT8 *)(UINTN)PhysicalAddress;
+
+    //
+    // A copy of a file in an FV that is in system memory already is neither
+    // faster to read nor more stable than the file itself. The images executed
+    // in place need their file to be cached, though.
+    //
+    if (!FeaturePcdGet (PcdDxeImageExecuteInPlace)) {
+      Status = CoreGetMemorySpaceDescriptor (PhysicalAddress, &Descriptor);
+      if (!EFI_ERROR (Status) &&
+          (Descriptor.GcdMemoryType == EfiGcdMemoryTypeSystemMemory) &&
+          (PhysicalAddress + Size <= Descriptor.BaseAddress + Descriptor.Length))
+      {
+        FvDevice->IsInMemory = TRUE;
+      }
+    }
   } else {
     FvDevice->IsMemoryMapped = FALSE;
     FvDevice->CachedFv       = AllocatePool (Size);
@@ -421,6 +600,18 @@ FvCheck (
   Status = EFI_SUCCESS;
   InitializeListHead (&FvDevice->FfsFileListHeader);
 
+  if (FvDevice->IsMemoryMapped) {
+    //
+    // The PEI Core may have checked the files of the FV already.
+    //
+    Status = FvBuildFileListFromTable (FvDevice);
+    if (Status != EFI_NOT_FOUND) {
+      goto Done;
+    }
+
+    Status = EFI_SUCCESS;
+  }
+
   //
   // Build FFS list
   //
@@ -480,7 +671,7 @@ FvCheck (
 
     CacheFfsHeader = FfsHeader;
     if ((CacheFfsHeader->Attributes & FFS_ATTRIB_CHECKSUM) == FFS_ATTRIB_CHECKSUM) {
-      if (FvDevice->IsMemoryMapped) {
+      if (FvDevice->IsMemoryMapped && !FvDevice->IsInMemory) {
         //
         // Memory mapped FV has not been cached.
         // Here is to cache FFS file to memory buffer for following checksum calculating.
@@ -536,6 +727,10 @@ FvCheck (
       FfsFileEntry->FfsHeader  = CacheFfsHeader;
       FfsFileEntry->FileCached = FileCached;
       FileCached               = FALSE;
+      if (FvDevice->IsMemoryMapped) {
+        FfsFileEntry->MappedFfsHeader = FfsHeader;
+      }
+
       InsertTailList (&FvDevice->FfsFileListHeader, &FfsFileEntry->Link);
     }
 
@@ -559,6 +754,8 @@ Done:
     }
 
     FreeFvDeviceResource (FvDevice);
+  } else {
+    FvBuildFileHashTable (FvDevice);
   }
 
   return Status;
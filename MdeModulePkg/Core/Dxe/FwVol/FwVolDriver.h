@@ -17,9 +17,16 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 //
 typedef struct {
   LIST_ENTRY             Link;
+  LIST_ENTRY             HashLink;
   EFI_FFS_FILE_HEADER    *FfsHeader;
   UINTN                  StreamHandle;
   BOOLEAN                FileCached;
+  //
+  // The file in a memory mapped FV, or NULL. FfsHeader points to a copy of
+  // the file once it is cached.
+  //
+  EFI_FFS_FILE_HEADER    *MappedFfsHeader;
+  BOOLEAN                ExecutedInPlace;
 } FFS_FILE_LIST_ENTRY;
 
 typedef struct {
@@ -36,10 +43,22 @@ typedef struct {
 
   LIST_ENTRY                            FfsFileListHeader;
 
+  //
+  // Index of the FfsFileListHeader entries by file name.
+  // FfsFileHashTable is NULL if the index could not be built.
+  //
+  LIST_ENTRY                            *FfsFileHashTable;
+  UINTN                                 FfsFileHashBuckets;
+
   UINT32                                AuthenticationStatus;
   UINT8                                 ErasePolarity;
   BOOLEAN                               IsFfs3Fv;
   BOOLEAN                               IsMemoryMapped;
+  //
+  // The memory mapped FV lies in system memory, for example because it was
+  // decompressed in PEI. Its files are read in place instead of being cached.
+  //
+  BOOLEAN                               IsInMemory;
 } FV_DEVICE;
 
 #define FV_DEVICE_FROM_THIS(a)  CR(a, FV_DEVICE, Fv, FV2_DEVICE_SIGNATURE)
@@ -301,6 +320,21 @@ FvSetVolumeInfo (
   IN CONST  VOID                           *Buffer
   );
 
+/**
+  Returns the FfsFileHashTable bucket that holds the file entries of a file name.
+
+  @param  FvDevice       The FV_DEVICE that contains the file.
+  @param  NameGuid       The name of the file.
+
+  @return The list head of the bucket.
+
+**/
+LIST_ENTRY *
+FvGetFileHashBucket (
+  IN FV_DEVICE       *FvDevice,
+  IN CONST EFI_GUID  *NameGuid
+  );
+
 /**
   Check if a block of buffer is erased.
 
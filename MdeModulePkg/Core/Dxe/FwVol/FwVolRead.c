@@ -285,6 +285,10 @@ FvReadFile (
   EFI_FFS_FILE_HEADER     *FfsHeader;
   UINTN                   InputBufferSize;
   UINTN                   WholeFileSize;
+  EFI_FV_ATTRIBUTES       FvAttributes;
+  LIST_ENTRY              *Bucket;
+  LIST_ENTRY              *Link;
+  FFS_FILE_LIST_ENTRY     *FfsFileEntry;
 
   if (NameGuid == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -292,31 +296,62 @@ FvReadFile (
 
   FvDevice = FV_DEVICE_FROM_THIS (This);
 
-  //
-  // Keep looking until we find the matching NameGuid.
-  // The Key is really a FfsFileEntry
-  //
-  FvDevice->LastKey = 0;
-  do {
-    LocalFoundType = 0;
-    Status         = FvGetNextFile (
-                       This,
-                       &FvDevice->LastKey,
-                       &LocalFoundType,
-                       &SearchNameGuid,
-                       &LocalAttributes,
-                       &FileSize
-                       );
-    if (EFI_ERROR (Status)) {
+  if (FvDevice->FfsFileHashTable != NULL) {
+    //
+    // Look the file up in the file name index.
+    //
+    Status = FvGetVolumeAttributes (This, &FvAttributes);
+    if (EFI_ERROR (Status) || ((FvAttributes & EFI_FV2_READ_STATUS) == 0)) {
+      return EFI_NOT_FOUND;
+    }
+
+    FvDevice->LastKey = NULL;
+    Bucket            = FvGetFileHashBucket (FvDevice, NameGuid);
+    for (Link = Bucket->ForwardLink; Link != Bucket; Link = Link->ForwardLink) {
+      FfsFileEntry = BASE_CR (Link, FFS_FILE_LIST_ENTRY, HashLink);
+      if (CompareGuid (&FfsFileEntry->FfsHeader->Name, NameGuid)) {
+        FvDevice->LastKey = FfsFileEntry;
+        break;
+      }
+    }
+
+    if (FvDevice->LastKey == NULL) {
       return EFI_NOT_FOUND;
     }
-  } while (!CompareGuid (&SearchNameGuid, NameGuid));
+
+    FfsHeader = FvDevice->LastKey->FfsHeader;
+    if (IS_FFS_FILE2 (FfsHeader)) {
+      FileSize = FFS_FILE2_SIZE (FfsHeader) - sizeof (EFI_FFS_FILE_HEADER2);
+    } else {
+      FileSize = FFS_FILE_SIZE (FfsHeader) - sizeof (EFI_FFS_FILE_HEADER);
+    }
+  } else {
+    //
+    // Keep looking until we find the matching NameGuid.
+    // The Key is really a FfsFileEntry
+    //
+    FvDevice->LastKey = 0;
+    do {
+      LocalFoundType = 0;
+      Status         = FvGetNextFile (
+                         This,
+                         &FvDevice->LastKey,
+                         &LocalFoundType,
+                         &SearchNameGuid,
+                         &LocalAttributes,
+                         &FileSize
+                         );
+      if (EFI_ERROR (Status)) {
+        return EFI_NOT_FOUND;
+      }
+    } while (!CompareGuid (&SearchNameGuid, NameGuid));
+  }
 
   //
   // Get a pointer to the header
   //
   FfsHeader = FvDevice->LastKey->FfsHeader;
-  if (FvDevice->IsMemoryMapped) {
+  if (FvDevice->IsMemoryMapped && !FvDevice->IsInMemory) {
     //
     // Memory mapped FV has not been cached, so here is to cache by file.
     //
@@ -400,42 +435,31 @@ FvReadFile (
 }
 
 /**
-  Locates a section in a given FFS File and
-  copies it to the supplied buffer (not including section header).
+  Open the section stream of a file, or return the one opened before.
+
+  The section stream is cached in the FFS_FILE_LIST_ENTRY of the file, and is
+  only closed when the FV is, so that the section extraction code can keep the
+  extracted encapsulations.
 
   @param  This                       Indicates the calling context.
   @param  NameGuid                   Pointer to an EFI_GUID, which is the
                                      filename.
-  @param  SectionType                Indicates the section type to return.
-  @param  SectionInstance            Indicates which instance of sections with a
-                                     type of SectionType to return.
-  @param  Buffer                     Buffer is a pointer to pointer to a buffer
-                                     in which the file or section contents or are
-                                     returned.
-  @param  BufferSize                 BufferSize is a pointer to caller allocated
-                                     UINTN.
-  @param  AuthenticationStatus       AuthenticationStatus is a pointer to a
-                                     caller allocated UINT32 in which the
-                                     authentication status is returned.
+  @param  StreamHandle               On return, the section stream handle.
+  @param  AuthenticationStatus       On return, the authentication status of
+                                     the file.
 
-  @retval EFI_SUCCESS                Successfully read the file section into
-                                     buffer.
-  @retval EFI_WARN_BUFFER_TOO_SMALL  Buffer too small.
-  @retval EFI_NOT_FOUND              Section not found.
-  @retval EFI_DEVICE_ERROR           Device error.
-  @retval EFI_ACCESS_DENIED          Could not read.
-  @retval EFI_INVALID_PARAMETER      Invalid parameter.
+  @retval EFI_SUCCESS                The section stream was returned.
+  @retval EFI_NOT_FOUND              The file was not found, or has no sections.
+  @retval others                     The file could not be read, or its section
+                                     stream could not be opened.
 
 **/
+STATIC
 EFI_STATUS
-EFIAPI
-FvReadFileSection (
+FvGetFileSectionStream (
   IN CONST  EFI_FIRMWARE_VOLUME2_PROTOCOL  *This,
   IN CONST  EFI_GUID                       *NameGuid,
-  IN        EFI_SECTION_TYPE               SectionType,
-  IN        UINTN                          SectionInstance,
-  IN OUT    VOID                           **Buffer,
-  IN OUT    UINTN                          *BufferSize,
+  OUT       UINTN                          *StreamHandle,
   OUT       UINT32                         *AuthenticationStatus
   )
 {
@@ -447,10 +471,6 @@ FvReadFileSection (
   UINT8                   *FileBuffer;
   FFS_FILE_LIST_ENTRY     *FfsEntry;
 
-  if ((NameGuid == NULL) || (Buffer == NULL)) {
-    return EFI_INVALID_PARAMETER;
-  }
-
   FvDevice = FV_DEVICE_FROM_THIS (This);
 
   //
@@ -484,8 +504,7 @@ FvReadFileSection (
   // Check to see that the file actually HAS sections before we go any further.
   //
   if (FileType == EFI_FV_FILETYPE_RAW) {
-    Status = EFI_NOT_FOUND;
-    goto Done;
+    return EFI_NOT_FOUND;
   }
 
   //
@@ -498,15 +517,74 @@ FvReadFileSection (
                &FfsEntry->StreamHandle
                );
     if (EFI_ERROR (Status)) {
-      goto Done;
+      return Status;
     }
   }
 
+  *StreamHandle = FfsEntry->StreamHandle;
+  return EFI_SUCCESS;
+}
+
+/**
+  Locates a section in a given FFS File and
+  copies it to the supplied buffer (not including section header).
+
+  @param  This                       Indicates the calling context.
+  @param  NameGuid                   Pointer to an EFI_GUID, which is the
+                                     filename.
+  @param  SectionType                Indicates the section type to return.
+  @param  SectionInstance            Indicates which instance of sections with a
+                                     type of SectionType to return.
+  @param  Buffer                     Buffer is a pointer to pointer to a buffer
+                                     in which the file or section contents or are
+                                     returned.
+  @param  BufferSize                 BufferSize is a pointer to caller allocated
+                                     UINTN.
+  @param  AuthenticationStatus       AuthenticationStatus is a pointer to a
+                                     caller allocated UINT32 in which the
+                                     authentication status is returned.
+
+  @retval EFI_SUCCESS                Successfully read the file section into
+                                     buffer.
+  @retval EFI_WARN_BUFFER_TOO_SMALL  Buffer too small.
+  @retval EFI_NOT_FOUND              Section not found.
+  @retval EFI_DEVICE_ERROR           Device error.
+  @retval EFI_ACCESS_DENIED          Could not read.
+  @retval EFI_INVALID_PARAMETER      Invalid parameter.
+
+**/
+EFI_STATUS
+EFIAPI
+FvReadFileSection (
+  IN CONST  EFI_FIRMWARE_VOLUME2_PROTOCOL  *This,
+  IN CONST  EFI_GUID                       *NameGuid,
+  IN        EFI_SECTION_TYPE               SectionType,
+  IN        UINTN                          SectionInstance,
+  IN OUT    VOID                           **Buffer,
+  IN OUT    UINTN                          *BufferSize,
+  OUT       UINT32                         *AuthenticationStatus
+  )
+{
+  EFI_STATUS  Status;
+  FV_DEVICE   *FvDevice;
+  UINTN       StreamHandle;
+
+  if ((NameGuid == NULL) || (Buffer == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  FvDevice = FV_DEVICE_FROM_THIS (This);
+
+  Status = FvGetFileSectionStream (This, NameGuid, &StreamHandle, AuthenticationStatus);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
   //
   // If SectionType == 0 We need the whole section stream
   //
   Status = GetSection (
-             FfsEntry->StreamHandle,
+             StreamHandle,
              (SectionType == 0) ? NULL : &SectionType,
              NULL,
              (SectionType == 0) ? 0 : SectionInstance,
@@ -527,6 +605,204 @@ FvReadFileSection (
   // Close of stream defered to close of FfsHeader list to allow SEP to cache data
   //
 
-Done:
   return Status;
 }
+
+/**
+  Locates a section in a given FFS File and returns a reference to it in the
+  section stream cached for the file, instead of a copy.
+
+  The section must not be modified, and the reference must be released with
+  ReleaseSectionReference() once the section is not used anymore.
+
+  @param  This                       Indicates the calling context.
+  @param  NameGuid                   Pointer to an EFI_GUID, which is the
+                                     filename.
+  @param  SectionType                Indicates the section type to return.
+  @param  SectionInstance            Indicates which instance of sections with a
+                                     type of SectionType to return.
+  @param  Buffer                     On return, the section contents, not
+                                     including the section header.
+  @param  BufferSize                 On return, the size of the contents.
+  @param  AuthenticationStatus       On return, the authentication status, as
+                                     returned by FvReadFileSection().
+  @param  ReferenceHandle            On return, the handle to pass to
+                                     ReleaseSectionReference().
+
+  @retval EFI_SUCCESS                The reference was returned.
+  @retval EFI_UNSUPPORTED            The FV is not produced by the DXE Core.
+  @retval EFI_INVALID_PARAMETER      NameGuid is NULL.
+  @retval others                     The errors returned by FvReadFileSection()
+                                     when the section is not found.
+
+**/
+EFI_STATUS
+FvReadFileSectionReference (
+  IN  CONST EFI_FIRMWARE_VOLUME2_PROTOCOL  *This,
+  IN  CONST EFI_GUID                       *NameGuid,
+  IN  EFI_SECTION_TYPE                     SectionType,
+  IN  UINTN                                SectionInstance,
+  OUT VOID                                 **Buffer,
+  OUT UINTN                                *BufferSize,
+  OUT UINT32                               *AuthenticationStatus,
+  OUT UINTN                                *ReferenceHandle
+  )
+{
+  EFI_STATUS  Status;
+  FV_DEVICE   *FvDevice;
+  UINTN       StreamHandle;
+
+  if (This->ReadSection != FvReadFileSection) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (NameGuid == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  FvDevice = FV_DEVICE_FROM_THIS (This);
+
+  Status = FvGetFileSectionStream (This, NameGuid, &StreamHandle, AuthenticationStatus);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = GetSectionReference (
+             StreamHandle,
+             (SectionType == 0) ? NULL : &SectionType,
+             NULL,
+             (SectionType == 0) ? 0 : SectionInstance,
+             Buffer,
+             BufferSize,
+             AuthenticationStatus,
+             ReferenceHandle,
+             FvDevice->IsFfs3Fv
+             );
+
+  if (!EFI_ERROR (Status)) {
+    *AuthenticationStatus |= FvDevice->AuthenticationStatus;
+  }
+
+  return Status;
+}
+
+/**
+  Locate the PE32 section of a file in a memory mapped FV, so that the image
+  can be executed in place.
+
+  Only a PE32 section stored directly in the file is returned, not one in an
+  encapsulation section. The file must have been read already, so that later
+  reads of the file are served from the cached copy and not from the image
+  executed in place. The section of a file is returned once only, since
+  executing the image modifies it.
+
+  @param  This               The EFI_FIRMWARE_VOLUME2_PROTOCOL instance.
+  @param  NameGuid           The name of the file.
+  @param  Pe32Data           On return, the PE32 image in the FV.
+  @param  Pe32Size           On return, the size of the PE32 image.
+
+  @retval EFI_SUCCESS           The PE32 image was found.
+  @retval EFI_UNSUPPORTED       The FV is not produced by the DXE Core, or is
+                                not memory mapped.
+  @retval EFI_NOT_READY         The file has not been read yet.
+  @retval EFI_ALREADY_STARTED   The PE32 image of the file was returned before.
+  @retval EFI_NOT_FOUND         The file or its PE32 section was not found.
+
+**/
+EFI_STATUS
+FvLocateImageInPlace (
+  IN  CONST EFI_FIRMWARE_VOLUME2_PROTOCOL  *This,
+  IN  CONST EFI_GUID                       *NameGuid,
+  OUT VOID                                 **Pe32Data,
+  OUT UINTN                                *Pe32Size
+  )
+{
+  FV_DEVICE                  *FvDevice;
+  FFS_FILE_LIST_ENTRY        *FfsFileEntry;
+  FFS_FILE_LIST_ENTRY        *Entry;
+  LIST_ENTRY                 *Bucket;
+  LIST_ENTRY                 *Link;
+  EFI_FFS_FILE_HEADER        *FfsHeader;
+  EFI_COMMON_SECTION_HEADER  *Section;
+  UINT8                      *EndOfFile;
+  UINTN                      SectionHeaderSize;
+  UINTN                      SectionSize;
+
+  if (This->ReadFile != FvReadFile) {
+    return EFI_UNSUPPORTED;
+  }
+
+  FvDevice = FV_DEVICE_FROM_THIS (This);
+  if (!FvDevice->IsMemoryMapped) {
+    return EFI_UNSUPPORTED;
+  }
+
+  FfsFileEntry = NULL;
+  if (FvDevice->FfsFileHashTable != NULL) {
+    Bucket = FvGetFileHashBucket (FvDevice, NameGuid);
+    for (Link = Bucket->ForwardLink; Link != Bucket; Link = Link->ForwardLink) {
+      Entry = BASE_CR (Link, FFS_FILE_LIST_ENTRY, HashLink);
+      if (CompareGuid (&Entry->FfsHeader->Name, NameGuid)) {
+        FfsFileEntry = Entry;
+        break;
+      }
+    }
+  } else {
+    for (Link = FvDevice->FfsFileListHeader.ForwardLink; Link != &FvDevice->FfsFileListHeader; Link = Link->ForwardLink) {
+      Entry = (FFS_FILE_LIST_ENTRY *)Link;
+      if (CompareGuid (&Entry->FfsHeader->Name, NameGuid)) {
+        FfsFileEntry = Entry;
+        break;
+      }
+    }
+  }
+
+  if ((FfsFileEntry == NULL) || (FfsFileEntry->MappedFfsHeader == NULL)) {
+    return EFI_NOT_FOUND;
+  }
+
+  if (!FfsFileEntry->FileCached) {
+    return EFI_NOT_READY;
+  }
+
+  if (FfsFileEntry->ExecutedInPlace) {
+    return EFI_ALREADY_STARTED;
+  }
+
+  FfsHeader = FfsFileEntry->MappedFfsHeader;
+  if (IS_FFS_FILE2 (FfsHeader)) {
+    Section   = (EFI_COMMON_SECTION_HEADER *)((UINT8 *)FfsHeader + sizeof (EFI_FFS_FILE_HEADER2));
+    EndOfFile = (UINT8 *)FfsHeader + FFS_FILE2_SIZE (FfsHeader);
+  } else {
+    Section   = (EFI_COMMON_SECTION_HEADER *)((UINT8 *)FfsHeader + sizeof (EFI_FFS_FILE_HEADER));
+    EndOfFile = (UINT8 *)FfsHeader + FFS_FILE_SIZE (FfsHeader);
+  }
+
+  while ((UINT8 *)Section + sizeof (EFI_COMMON_SECTION_HEADER) <= EndOfFile) {
+    if (IS_SECTION2 (Section)) {
+      SectionHeaderSize = sizeof (EFI_COMMON_SECTION_HEADER2);
+      SectionSize       = SECTION2_SIZE (Section);
+    } else {
+      SectionHeaderSize = sizeof (EFI_COMMON_SECTION_HEADER);
+      SectionSize       = SECTION_SIZE (Section);
+    }
+
+    if ((SectionSize < SectionHeaderSize) || (SectionSize > (UINTN)(EndOfFile - (UINT8 *)Section))) {
+      break;
+    }
+
+    if (Section->Type == EFI_SECTION_PE32) {
+      *Pe32Data                     = (UINT8 *)Section + SectionHeaderSize;
+      *Pe32Size                     = SectionSize - SectionHeaderSize;
+      FfsFileEntry->ExecutedInPlace = TRUE;
+      return EFI_SUCCESS;
+    }
+
+    //
+    // Sections are 4-byte aligned in the file.
+    //
+    Section = (EFI_COMMON_SECTION_HEADER *)((UINT8 *)Section + ALIGN_VALUE (SectionSize, 4));
+  }
+
+  return EFI_NOT_FOUND;
+}
@@ -45,6 +45,13 @@ EFI_LOCK    mGcdIoSpaceLock     = EFI_INITIALIZE_LOCK_VARIABLE (TPL_NOTIFY);
 LIST_ENTRY  mGcdMemorySpaceMap  = INITIALIZE_LIST_HEAD_VARIABLE (mGcdMemorySpaceMap);
 LIST_ENTRY  mGcdIoSpaceMap      = INITIALIZE_LIST_HEAD_VARIABLE (mGcdIoSpaceMap);
 
+//
+// Roots of the search trees that index the entries of the GCD maps by address
+//
+EFI_GCD_MAP_ENTRY  *mGcdMemorySpaceTree = NULL;
+EFI_GCD_MAP_ENTRY  *mGcdIoSpaceTree     = NULL;
+UINT32             mGcdMapTreeSeed      = 0x2545F491;
+
 EFI_GCD_MAP_ENTRY  mGcdMemorySpaceMapEntryTemplate = {
   EFI_GCD_MAP_SIGNATURE,
   {
@@ -58,7 +65,10 @@ EFI_GCD_MAP_ENTRY  mGcdMemorySpaceMapEntryTemplate = {
   EfiGcdMemoryTypeNonExistent,
   (EFI_GCD_IO_TYPE)0,
   NULL,
-  NULL
+  NULL,
+  NULL,
+  NULL,
+  0
 };
 
 EFI_GCD_MAP_ENTRY  mGcdIoSpaceMapEntryTemplate = {
@@ -74,7 +84,10 @@ EFI_GCD_MAP_ENTRY  mGcdIoSpaceMapEntryTemplate = {
   (EFI_GCD_MEMORY_TYPE)0,
   EfiGcdIoTypeNonExistent,
   NULL,
-  NULL
+  NULL,
+  NULL,
+  NULL,
+  0
 };
 
 GCD_ATTRIBUTE_CONVERSION_ENTRY  mAttributeConversionTable[] = {
@@ -414,6 +427,155 @@ CoreAllocateGcdMapEntry (
   return EFI_SUCCESS;
 }
 
+/**
+  Return the root of the search tree that indexes a GCD map.
+
+  @param  Map                    The GCD memory or I/O space map.
+
+  @return A pointer to the root of the search tree.
+
+**/
+STATIC
+EFI_GCD_MAP_ENTRY **
+CoreGetGcdMapTree (
+  IN LIST_ENTRY  *Map
+  )
+{
+  if (Map == &mGcdMemorySpaceMap) {
+    return &mGcdMemorySpaceTree;
+  }
+
+  ASSERT (Map == &mGcdIoSpaceMap);
+  return &mGcdIoSpaceTree;
+}
+
+/**
+  Insert an entry into the search tree of a GCD map.
+
+  The tree is a treap: it is ordered by BaseAddress and every node has a
+  larger random priority than its children, which keeps the expected depth
+  logarithmic regardless of the order in which the entries are inserted.
+
+  @param  Root                   The root of the (sub)tree to insert Entry into.
+  @param  Entry                  The entry to insert.
+
+**/
+STATIC
+VOID
+CoreInsertGcdMapTree (
+  IN OUT EFI_GCD_MAP_ENTRY  **Root,
+  IN     EFI_GCD_MAP_ENTRY  *Entry
+  )
+{
+  EFI_GCD_MAP_ENTRY  *Node;
+  EFI_GCD_MAP_ENTRY  *Child;
+
+  Node = *Root;
+  if (Node == NULL) {
+    *Root = Entry;
+    return;
+  }
+
+  if (Entry->BaseAddress < Node->BaseAddress) {
+    CoreInsertGcdMapTree (&Node->Left, Entry);
+    Child = Node->Left;
+    if (Child->Priority > Node->Priority) {
+      Node->Left   = Child->Right;
+      Child->Right = Node;
+      *Root        = Child;
+    }
+  } else {
+    CoreInsertGcdMapTree (&Node->Right, Entry);
+    Child = Node->Right;
+    if (Child->Priority > Node->Priority) {
+      Node->Right = Child->Left;
+      Child->Left = Node;
+      *Root       = Child;
+    }
+  }
+}
+
+/**
+  Add an entry to the search tree of a GCD map.
+
+  @param  Map                    The GCD map that Entry belongs to.
+  @param  Entry                  The entry to add.
+
+**/
+STATIC
+VOID
+CoreAddGcdMapTreeEntry (
+  IN LIST_ENTRY         *Map,
+  IN EFI_GCD_MAP_ENTRY  *Entry
+  )
+{
+  //
+  // Advance the xorshift generator used for the priorities
+  //
+  mGcdMapTreeSeed ^= mGcdMapTreeSeed << 13;
+  mGcdMapTreeSeed ^= mGcdMapTreeSeed >> 17;
+  mGcdMapTreeSeed ^= mGcdMapTreeSeed << 5;
+
+  Entry->Left     = NULL;
+  Entry->Right    = NULL;
+  Entry->Priority = mGcdMapTreeSeed;
+  CoreInsertGcdMapTree (CoreGetGcdMapTree (Map), Entry);
+}
+
+/**
+  Remove an entry from the search tree of a GCD map.
+
+  The BaseAddress of Entry must not have been changed since it was added.
+
+  @param  Map                    The GCD map that Entry belongs to.
+  @param  Entry                  The entry to remove.
+
+**/
+STATIC
+VOID
+CoreRemoveGcdMapTreeEntry (
+  IN LIST_ENTRY         *Map,
+  IN EFI_GCD_MAP_ENTRY  *Entry
+  )
+{
+  EFI_GCD_MAP_ENTRY  **Link;
+  EFI_GCD_MAP_ENTRY  *Child;
+
+  Link = CoreGetGcdMapTree (Map);
+  while (*Link != Entry) {
+    ASSERT (*Link != NULL);
+    if (Entry->BaseAddress < (*Link)->BaseAddress) {
+      Link = &(*Link)->Left;
+    } else {
+      Link = &(*Link)->Right;
+    }
+  }
+
+  //
+  // Rotate Entry down until it has at most one child, then unlink it
+  //
+  while ((Entry->Left != NULL) && (Entry->Right != NULL)) {
+    if (Entry->Left->Priority > Entry->Right->Priority) {
+      Child        = Entry->Left;
+      Entry->Left  = Child->Right;
+      Child->Right = Entry;
+      *Link        = Child;
+      Link         = &Child->Right;
+    } else {
+      Child        = Entry->Right;
+      Entry->Right = Child->Left;
+      Child->Left  = Entry;
+      *Link        = Child;
+      Link         = &Child->Left;
+    }
+  }
+
+  *Link = (Entry->Left != NULL) ? Entry->Left : Entry->Right;
+
+  Entry->Left  = NULL;
+  Entry->Right = NULL;
+}
+
 /**
   Internal function.  Inserts a new descriptor into a sorted list
 
@@ -424,6 +586,7 @@ CoreAllocateGcdMapEntry (
   @param  Length                 The length of the new range in bytes
   @param  TopEntry               Top pad entry to insert if needed.
   @param  BottomEntry            Bottom pad entry to insert if needed.
+  @param  Map                    The GCD map that Entry belongs to.
 
   @retval EFI_SUCCESS            The new range was inserted into the linked list
 
@@ -435,7 +598,8 @@ CoreInsertGcdMapEntry (
   IN EFI_PHYSICAL_ADDRESS  BaseAddress,
   IN UINT64                Length,
   IN EFI_GCD_MAP_ENTRY     *TopEntry,
-  IN EFI_GCD_MAP_ENTRY     *BottomEntry
+  IN EFI_GCD_MAP_ENTRY     *BottomEntry,
+  IN LIST_ENTRY            *Map
   )
 {
   ASSERT (Length != 0);
@@ -447,6 +611,7 @@ CoreInsertGcdMapEntry (
     Entry->BaseAddress      = BaseAddress;
     BottomEntry->EndAddress = BaseAddress - 1;
     InsertTailList (Link, &BottomEntry->Link);
+    CoreAddGcdMapTreeEntry (Map, BottomEntry);
   }
 
   if ((BaseAddress + Length - 1) < Entry->EndAddress) {
@@ -456,6 +621,7 @@ CoreInsertGcdMapEntry (
     TopEntry->BaseAddress = BaseAddress + Length;
     Entry->EndAddress     = BaseAddress + Length - 1;
     InsertHeadList (Link, &TopEntry->Link);
+    CoreAddGcdMapTreeEntry (Map, TopEntry);
   }
 
   return EFI_SUCCESS;
@@ -527,6 +693,8 @@ CoreMergeGcdMapEntry (
     return EFI_UNSUPPORTED;
   }
 
+  CoreRemoveGcdMapTreeEntry (Map, AdjacentEntry);
+
   if (Forward) {
     Entry->EndAddress = AdjacentEntry->EndAddress;
   } else {
@@ -607,13 +775,33 @@ CoreSearchGcdMapEntry (
 {
   LIST_ENTRY         *Link;
   EFI_GCD_MAP_ENTRY  *Entry;
+  EFI_GCD_MAP_ENTRY  *Node;
 
   ASSERT (Length != 0);
 
   *StartLink = NULL;
   *EndLink   = NULL;
 
-  Link = Map->ForwardLink;
+  //
+  // Use the search tree to find the last entry that starts at or below
+  // BaseAddress, and scan the list from there
+  //
+  Entry = NULL;
+  Node  = *CoreGetGcdMapTree (Map);
+  while (Node != NULL) {
+    if (BaseAddress < Node->BaseAddress) {
+      Node = Node->Left;
+    } else {
+      Entry = Node;
+      Node  = Node->Right;
+    }
+  }
+
+  if (Entry == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  Link = &Entry->Link;
   while (Link != Map) {
     Entry = CR (Link, EFI_GCD_MAP_ENTRY, Link, EFI_GCD_MAP_SIGNATURE);
     if ((BaseAddress >= Entry->BaseAddress) && (BaseAddress <= Entry->EndAddress)) {
@@ -935,7 +1123,7 @@ CoreConvertSpace (
   Link = StartLink;
   while (Link != EndLink->ForwardLink) {
     Entry = CR (Link, EFI_GCD_MAP_ENTRY, Link, EFI_GCD_MAP_SIGNATURE);
-    CoreInsertGcdMapEntry (Link, Entry, BaseAddress, Length, TopEntry, BottomEntry);
+    CoreInsertGcdMapEntry (Link, Entry, BaseAddress, Length, TopEntry, BottomEntry, Map);
     switch (Operation) {
       //
       // Add operations
@@ -1018,6 +1206,7 @@ Done:
   DEBUG ((DEBUG_GCD, "  Status = %r\n", Status));
 
   if ((Operation & GCD_MEMORY_SPACE_OPERATION) != 0) {
+    CoreUpdateMemoryMapGeneration ();
     CoreReleaseGcdMemoryLock ();
     CoreDumpGcdMemorySpaceMap (FALSE);
   }
@@ -1337,7 +1526,7 @@ CoreAllocateSpace (
   Link = StartLink;
   while (Link != EndLink->ForwardLink) {
     Entry = CR (Link, EFI_GCD_MAP_ENTRY, Link, EFI_GCD_MAP_SIGNATURE);
-    CoreInsertGcdMapEntry (Link, Entry, *BaseAddress, Length, TopEntry, BottomEntry);
+    CoreInsertGcdMapEntry (Link, Entry, *BaseAddress, Length, TopEntry, BottomEntry, Map);
     Entry->ImageHandle  = ImageHandle;
     Entry->DeviceHandle = DeviceHandle;
     Link                = Link->ForwardLink;
@@ -1357,6 +1546,7 @@ Done:
   DEBUG ((DEBUG_GCD, "\n"));
 
   if ((Operation & GCD_MEMORY_SPACE_OPERATION) != 0) {
+    CoreUpdateMemoryMapGeneration ();
     CoreReleaseGcdMemoryLock ();
     CoreDumpGcdMemorySpaceMap (FALSE);
   }
@@ -2621,6 +2811,7 @@ CoreInitializeGcdServices (
   Entry->EndAddress = LShiftU64 (1, SizeOfMemorySpace) - 1;
 
   InsertHeadList (&mGcdMemorySpaceMap, &Entry->Link);
+  CoreAddGcdMapTreeEntry (&mGcdMemorySpaceMap, Entry);
 
   CoreDumpGcdMemorySpaceMap (TRUE);
 
@@ -2633,6 +2824,7 @@ CoreInitializeGcdServices (
   Entry->EndAddress = LShiftU64 (1, SizeOfIoSpace) - 1;
 
   InsertHeadList (&mGcdIoSpaceMap, &Entry->Link);
+  CoreAddGcdMapTreeEntry (&mGcdIoSpaceMap, Entry);
 
   CoreDumpGcdIoSpaceMap (TRUE);
 
@@ -14,12 +14,16 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 // gHandleList           - A list of all the handles in the system
 // gProtocolDatabaseLock - Lock to protect the mProtocolDatabase
 // gHandleDatabaseKey    -  The Key to show that the handle has been created/modified
+// mProtocolHashTable    - GUID-keyed index of mProtocolDatabase, one list per bucket
+// mProtocolHashBuckets  - Number of buckets in mProtocolHashTable (0: index disabled)
 //
 LIST_ENTRY          mProtocolDatabase     = INITIALIZE_LIST_HEAD_VARIABLE (mProtocolDatabase);
 LIST_ENTRY          gHandleList           = INITIALIZE_LIST_HEAD_VARIABLE (gHandleList);
 EFI_LOCK            gProtocolDatabaseLock = EFI_INITIALIZE_LOCK_VARIABLE (TPL_NOTIFY);
 UINT64              gHandleDatabaseKey    = 0;
 ORDERED_COLLECTION  *gOrderedHandleList   = NULL;
+LIST_ENTRY          *mProtocolHashTable   = NULL;
+UINT32              mProtocolHashBuckets  = 0;
 
 /**
   Acquire lock on gProtocolDatabaseLock.
@@ -79,6 +83,36 @@ PointerCompare (
   return 1;
 }
 
+/**
+  Returns the mProtocolHashTable bucket that holds the protocol entry of a GUID.
+
+  @param  Protocol               The ID of the protocol
+
+  @return The list head of the bucket.
+
+**/
+STATIC
+LIST_ENTRY *
+CoreGetProtocolHashBucket (
+  IN EFI_GUID  *Protocol
+  )
+{
+  UINT32  Hash;
+
+  ASSERT (mProtocolHashTable != NULL);
+
+  //
+  // Protocol GUIDs are random enough that folding the four 32-bit words
+  // gives an even distribution over the buckets.
+  //
+  Hash  = ReadUnaligned32 ((UINT32 *)Protocol);
+  Hash ^= ReadUnaligned32 ((UINT32 *)Protocol + 1);
+  Hash ^= ReadUnaligned32 ((UINT32 *)Protocol + 2);
+  Hash ^= ReadUnaligned32 ((UINT32 *)Protocol + 3);
+
+  return &mProtocolHashTable[Hash % mProtocolHashBuckets];
+}
+
 /**
   Initializes "handle" support.
 
@@ -90,12 +124,38 @@ CoreInitializeHandleServices (
   VOID
   )
 {
+  LIST_ENTRY      *Link;
+  PROTOCOL_ENTRY  *ProtEntry;
+  UINT32          Index;
+
   gOrderedHandleList = OrderedCollectionInit (PointerCompare, PointerCompare);
 
   if (gOrderedHandleList == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
 
+  //
+  // Build the GUID-keyed index of the protocol database. If it cannot be
+  // allocated, CoreFindProtocolEntry() falls back to the linear search.
+  //
+  if (PcdGet32 (PcdProtocolDatabaseHashBuckets) != 0) {
+    mProtocolHashTable = AllocatePool (PcdGet32 (PcdProtocolDatabaseHashBuckets) * sizeof (LIST_ENTRY));
+    if (mProtocolHashTable != NULL) {
+      mProtocolHashBuckets = PcdGet32 (PcdProtocolDatabaseHashBuckets);
+      for (Index = 0; Index < mProtocolHashBuckets; Index++) {
+        InitializeListHead (&mProtocolHashTable[Index]);
+      }
+
+      for (Link = mProtocolDatabase.ForwardLink;
+           Link != &mProtocolDatabase;
+           Link = Link->ForwardLink)
+      {
+        ProtEntry = CR (Link, PROTOCOL_ENTRY, AllEntries, PROTOCOL_ENTRY_SIGNATURE);
+        InsertTailList (CoreGetProtocolHashBucket (&ProtEntry->ProtocolID), &ProtEntry->HashLink);
+      }
+    }
+  }
+
   return EFI_SUCCESS;
 }
 
@@ -147,28 +207,46 @@ CoreFindProtocolEntry (
   )
 {
   LIST_ENTRY      *Link;
+  LIST_ENTRY      *Bucket;
   PROTOCOL_ENTRY  *Item;
   PROTOCOL_ENTRY  *ProtEntry;
 
   ASSERT_LOCKED (&gProtocolDatabaseLock);
 
-  //
-  // Search the database for the matching GUID
-  //
-
   ProtEntry = NULL;
-  for (Link = mProtocolDatabase.ForwardLink;
-       Link != &mProtocolDatabase;
-       Link = Link->ForwardLink)
-  {
-    Item = CR (Link, PROTOCOL_ENTRY, AllEntries, PROTOCOL_ENTRY_SIGNATURE);
-    if (CompareGuid (&Item->ProtocolID, Protocol)) {
-      //
-      // This is the protocol entry
-      //
+  Bucket    = NULL;
+  if (mProtocolHashTable != NULL) {
+    //
+    // Search only the hash bucket of the GUID
+    //
+    Bucket = CoreGetProtocolHashBucket (Protocol);
+    for (Link = Bucket->ForwardLink; Link != Bucket; Link = Link->ForwardLink) {
+      Item = CR (Link, PROTOCOL_ENTRY, HashLink, PROTOCOL_ENTRY_SIGNATURE);
+      if (CompareGuid (&Item->ProtocolID, Protocol)) {
+        //
+        // This is the protocol entry
+        //
+        ProtEntry = Item;
+        break;
+      }
+    }
+  } else {
+    //
+    // Search the database for the matching GUID
+    //
+    for (Link = mProtocolDatabase.ForwardLink;
+         Link != &mProtocolDatabase;
+         Link = Link->ForwardLink)
+    {
+      Item = CR (Link, PROTOCOL_ENTRY, AllEntries, PROTOCOL_ENTRY_SIGNATURE);
+      if (CompareGuid (&Item->ProtocolID, Protocol)) {
+        //
+        // This is the protocol entry
+        //
 
-      ProtEntry = Item;
-      break;
+        ProtEntry = Item;
+        break;
+      }
     }
   }
 
@@ -192,6 +270,9 @@ CoreFindProtocolEntry (
       // Add it to protocol database
       //
       InsertTailList (&mProtocolDatabase, &ProtEntry->AllEntries);
+      if (Bucket != NULL) {
+        InsertTailList (Bucket, &ProtEntry->HashLink);
+      }
     }
   }
 
@@ -296,7 +377,7 @@ IsDevicePathInstalled (
     //
     // Check if DevicePath is same as this interface
     //
-    Size = GetDevicePathSize (Prot->Interface);
+    Size = Prot->DevicePathSize;
     ASSERT (Size >= END_DEVICE_PATH_LENGTH);
     if ((Size == SourceSize) && (CompareMem (DevicePath, Prot->Interface, Size - END_DEVICE_PATH_LENGTH) == 0)) {
       Found = TRUE;
@@ -552,6 +633,14 @@ CoreInstallProtocolInterfaceNotify (
   Prot->Protocol  = ProtEntry;
   Prot->Interface = Interface;
 
+  //
+  // Device paths are not changed once installed, so their size is computed
+  // once here instead of on every device path lookup
+  //
+  if (CompareGuid (Protocol, &gEfiDevicePathProtocolGuid)) {
+    Prot->DevicePathSize = GetDevicePathSize (Interface);
+  }
+
   //
   // Initalize OpenProtocol Data base
   //
@@ -563,6 +652,7 @@ CoreInstallProtocolInterfaceNotify (
   // protocol list for this handle
   //
   InsertHeadList (&Handle->Protocols, &Prot->Link);
+  ZeroMem (Handle->ProtocolCache, sizeof (Handle->ProtocolCache));
 
   //
   // Add this protocol interface to the tail of the
@@ -767,6 +857,7 @@ CoreDisconnectControllersUsingProtocolInterface (
       {
         Link = RemoveEntryList (&OpenData->Link);
         Prot->OpenListCount--;
+        Prot->LastOpen = NULL;
         CoreFreePool (OpenData);
       } else {
         Link = Link->ForwardLink;
@@ -873,6 +964,7 @@ CoreUninstallProtocolInterface (
     // Remove the protocol interface from the handle
     //
     RemoveEntryList (&Prot->Link);
+    ZeroMem (Handle->ProtocolCache, sizeof (Handle->ProtocolCache));
 
     //
     // Free the memory
@@ -1003,9 +1095,30 @@ CoreGetProtocolInterface (
   PROTOCOL_INTERFACE  *Prot;
   IHANDLE             *Handle;
   LIST_ENTRY          *Link;
+  UINTN               Index;
 
   Handle = (IHANDLE *)UserHandle;
 
+  //
+  // Check the most recently used protocol interfaces of the handle first
+  //
+  for (Index = 0; Index < HANDLE_PROTOCOL_CACHE_SIZE; Index++) {
+    Prot = Handle->ProtocolCache[Index];
+    if (Prot == NULL) {
+      break;
+    }
+
+    ASSERT (Prot->Signature == PROTOCOL_INTERFACE_SIGNATURE);
+    if (CompareGuid (&Prot->Protocol->ProtocolID, Protocol)) {
+      if (Index != 0) {
+        Handle->ProtocolCache[Index] = Handle->ProtocolCache[0];
+        Handle->ProtocolCache[0]     = Prot;
+      }
+
+      return Prot;
+    }
+  }
+
   //
   // Look at each protocol interface for a match
   //
@@ -1013,6 +1126,12 @@ CoreGetProtocolInterface (
     Prot      = CR (Link, PROTOCOL_INTERFACE, Link, PROTOCOL_INTERFACE_SIGNATURE);
     ProtEntry = Prot->Protocol;
     if (CompareGuid (&ProtEntry->ProtocolID, Protocol)) {
+      CopyMem (
+        &Handle->ProtocolCache[1],
+        &Handle->ProtocolCache[0],
+        (HANDLE_PROTOCOL_CACHE_SIZE - 1) * sizeof (Handle->ProtocolCache[0])
+        );
+      Handle->ProtocolCache[0] = Prot;
       return Prot;
     }
   }
@@ -1181,6 +1300,25 @@ CoreOpenProtocol (
 
   Status = EFI_SUCCESS;
 
+  //
+  // BY_HANDLE_PROTOCOL and GET_PROTOCOL opens never conflict with other
+  // agents, so an exact match of the last such open only needs its
+  // OpenCount incremented and the OpenList does not have to be scanned.
+  //
+  if (((Attributes == EFI_OPEN_PROTOCOL_BY_HANDLE_PROTOCOL) ||
+       (Attributes == EFI_OPEN_PROTOCOL_GET_PROTOCOL)) &&
+      (Prot->LastOpen != NULL))
+  {
+    OpenData = CR (Prot->LastOpen, OPEN_PROTOCOL_DATA, Link, OPEN_PROTOCOL_DATA_SIGNATURE);
+    if ((OpenData->AgentHandle == ImageHandle) &&
+        (OpenData->Attributes == Attributes) &&
+        (OpenData->ControllerHandle == ControllerHandle))
+    {
+      OpenData->OpenCount++;
+      goto Done;
+    }
+  }
+
   ByDriver  = FALSE;
   Exclusive = FALSE;
   for ( Link = Prot->OpenList.ForwardLink; Link != &Prot->OpenList; Link = Link->ForwardLink) {
@@ -1200,6 +1338,12 @@ CoreOpenProtocol (
       Exclusive = TRUE;
     } else if (ExactMatch) {
       OpenData->OpenCount++;
+      if ((Attributes == EFI_OPEN_PROTOCOL_BY_HANDLE_PROTOCOL) ||
+          (Attributes == EFI_OPEN_PROTOCOL_GET_PROTOCOL))
+      {
+        Prot->LastOpen = &OpenData->Link;
+      }
+
       Status = EFI_SUCCESS;
       goto Done;
     }
@@ -1275,6 +1419,12 @@ CoreOpenProtocol (
     OpenData->OpenCount        = 1;
     InsertTailList (&Prot->OpenList, &OpenData->Link);
     Prot->OpenListCount++;
+    if ((Attributes == EFI_OPEN_PROTOCOL_BY_HANDLE_PROTOCOL) ||
+        (Attributes == EFI_OPEN_PROTOCOL_GET_PROTOCOL))
+    {
+      Prot->LastOpen = &OpenData->Link;
+    }
+
     Status = EFI_SUCCESS;
   }
 
@@ -1403,6 +1553,7 @@ CoreCloseProtocol (
     if ((OpenData->AgentHandle == AgentHandle) && (OpenData->ControllerHandle == ControllerHandle)) {
       RemoveEntryList (&OpenData->Link);
       ProtocolInterface->OpenListCount--;
+      ProtocolInterface->LastOpen = NULL;
       CoreFreePool (OpenData);
       Status = EFI_SUCCESS;
     }
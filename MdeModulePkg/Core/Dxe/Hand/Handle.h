@@ -11,18 +11,27 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define EFI_HANDLE_SIGNATURE  SIGNATURE_32('h','n','d','l')
 
+///
+/// Number of PROTOCOL_INTERFACE's remembered per handle by CoreGetProtocolInterface()
+///
+#define HANDLE_PROTOCOL_CACHE_SIZE  2
+
+typedef struct _PROTOCOL_INTERFACE PROTOCOL_INTERFACE;
+
 ///
 /// IHANDLE - contains a list of protocol handles
 ///
 typedef struct {
-  UINTN         Signature;
+  UINTN                 Signature;
   /// All handles list of IHANDLE
-  LIST_ENTRY    AllHandles;
+  LIST_ENTRY            AllHandles;
   /// List of PROTOCOL_INTERFACE's for this handle
-  LIST_ENTRY    Protocols;
-  UINTN         LocateRequest;
+  LIST_ENTRY            Protocols;
+  UINTN                 LocateRequest;
   /// The Handle Database Key value when this handle was last created or modified
-  UINT64        Key;
+  UINT64                Key;
+  /// Most recently used PROTOCOL_INTERFACE's of this handle, most recent first
+  PROTOCOL_INTERFACE    *ProtocolCache[HANDLE_PROTOCOL_CACHE_SIZE];
 } IHANDLE;
 
 #define ASSERT_IS_HANDLE(a)  ASSERT((a)->Signature == EFI_HANDLE_SIGNATURE)
@@ -38,6 +47,8 @@ typedef struct {
   UINTN         Signature;
   /// Link Entry inserted to mProtocolDatabase
   LIST_ENTRY    AllEntries;
+  /// Link Entry inserted to the mProtocolHashTable bucket of ProtocolID
+  LIST_ENTRY    HashLink;
   /// ID of the protocol
   EFI_GUID      ProtocolID;
   /// All protocol interfaces
@@ -52,7 +63,7 @@ typedef struct {
 /// PROTOCOL_INTERFACE - each protocol installed on a handle is tracked
 /// with a protocol interface structure
 ///
-typedef struct {
+struct _PROTOCOL_INTERFACE {
   UINTN             Signature;
   /// Link on IHANDLE.Protocols
   LIST_ENTRY        Link;
@@ -64,10 +75,14 @@ typedef struct {
   PROTOCOL_ENTRY    *Protocol;
   /// The interface value
   VOID              *Interface;
+  /// GetDevicePathSize() of Interface when the protocol is the Device Path Protocol
+  UINTN             DevicePathSize;
   /// OPEN_PROTOCOL_DATA list
   LIST_ENTRY        OpenList;
   UINTN             OpenListCount;
-} PROTOCOL_INTERFACE;
+  /// Link of the OPEN_PROTOCOL_DATA last matched by a BY_HANDLE_PROTOCOL or GET_PROTOCOL open
+  LIST_ENTRY        *LastOpen;
+};
 
 #define OPEN_PROTOCOL_DATA_SIGNATURE  SIGNATURE_32('p','o','d','l')
 
@@ -454,11 +454,12 @@ CoreLocateDevicePath (
   INTN                      SourceSize;
   INTN                      Size;
   INTN                      BestMatch;
-  UINTN                     HandleCount;
-  UINTN                     Index;
-  EFI_STATUS                Status;
-  EFI_HANDLE                *Handles;
-  EFI_HANDLE                Handle;
+  LIST_ENTRY                *Link;
+  LIST_ENTRY                *ProtLink;
+  PROTOCOL_ENTRY            *DevicePathEntry;
+  PROTOCOL_ENTRY            *ProtEntry;
+  PROTOCOL_INTERFACE        *Prot;
+  PROTOCOL_INTERFACE        *HandleProt;
   EFI_HANDLE                BestDevice;
   EFI_DEVICE_PATH_PROTOCOL  *SourcePath;
   EFI_DEVICE_PATH_PROTOCOL  *TmpDevicePath;
@@ -471,7 +472,6 @@ CoreLocateDevicePath (
     return EFI_INVALID_PARAMETER;
   }
 
-  Handles       = NULL;
   BestDevice    = NULL;
   SourcePath    = *DevicePath;
   TmpDevicePath = SourcePath;
@@ -489,31 +489,44 @@ CoreLocateDevicePath (
 
   SourceSize = (UINTN)TmpDevicePath - (UINTN)SourcePath;
 
+  BestMatch = -1;
+
+  CoreAcquireProtocolLock ();
+
   //
-  // Get a list of all handles that support the requested protocol
+  // Walk the installed device paths, whose sizes are kept in the handle
+  // database, and only check the handles whose device path is a prefix of
+  // SourcePath for the requested protocol
   //
-  Status = CoreLocateHandleBuffer (ByProtocol, Protocol, NULL, &HandleCount, &Handles);
-  if (EFI_ERROR (Status) || (HandleCount == 0)) {
-    return EFI_NOT_FOUND;
-  }
+  DevicePathEntry = CoreFindProtocolEntry (&gEfiDevicePathProtocolGuid, FALSE);
+  ProtEntry       = CoreFindProtocolEntry (Protocol, FALSE);
+  if ((DevicePathEntry != NULL) && (ProtEntry != NULL)) {
+    for (Link = DevicePathEntry->Protocols.ForwardLink; Link != &DevicePathEntry->Protocols; Link = Link->ForwardLink) {
+      Prot = CR (Link, PROTOCOL_INTERFACE, ByProtocol, PROTOCOL_INTERFACE_SIGNATURE);
 
-  BestMatch = -1;
-  for (Index = 0; Index < HandleCount; Index += 1) {
-    Handle = Handles[Index];
-    Status = CoreHandleProtocol (Handle, &gEfiDevicePathProtocolGuid, (VOID **)&TmpDevicePath);
-    if (EFI_ERROR (Status)) {
       //
-      // If this handle doesn't support device path, then skip it
+      // Check if DevicePath is first part of SourcePath
       //
-      continue;
-    }
+      Size = (INTN)Prot->DevicePathSize - sizeof (EFI_DEVICE_PATH_PROTOCOL);
+      ASSERT (Size >= 0);
+      if ((Size > SourceSize) || (CompareMem (SourcePath, Prot->Interface, (UINTN)Size) != 0)) {
+        continue;
+      }
+
+      //
+      // Check if the handle supports the requested protocol
+      //
+      for (ProtLink = Prot->Handle->Protocols.ForwardLink; ProtLink != &Prot->Handle->Protocols; ProtLink = ProtLink->ForwardLink) {
+        HandleProt = CR (ProtLink, PROTOCOL_INTERFACE, Link, PROTOCOL_INTERFACE_SIGNATURE);
+        if (HandleProt->Protocol == ProtEntry) {
+          break;
+        }
+      }
+
+      if (ProtLink == &Prot->Handle->Protocols) {
+        continue;
+      }
 
-    //
-    // Check if DevicePath is first part of SourcePath
-    //
-    Size = GetDevicePathSize (TmpDevicePath) - sizeof (EFI_DEVICE_PATH_PROTOCOL);
-    ASSERT (Size >= 0);
-    if ((Size <= SourceSize) && (CompareMem (SourcePath, TmpDevicePath, (UINTN)Size) == 0)) {
       //
       // If the size is equal to the best match, then we
       // have a duplicate device path for 2 different device
@@ -526,12 +539,12 @@ CoreLocateDevicePath (
       //
       if (Size > BestMatch) {
         BestMatch  = Size;
-        BestDevice = Handle;
+        BestDevice = Prot->Handle;
       }
     }
   }
 
-  CoreFreePool (Handles);
+  CoreReleaseProtocolLock ();
 
   //
   // If there wasn't any match, then no parts of the device path was found.
@@ -236,6 +236,9 @@ CoreReinstallProtocolInterface (
   // Update the interface on the protocol
   //
   Prot->Interface = NewInterface;
+  if (CompareGuid (Protocol, &gEfiDevicePathProtocolGuid)) {
+    Prot->DevicePathSize = GetDevicePathSize (NewInterface);
+  }
 
   //
   // Add this protocol interface to the tail of the
@@ -550,6 +550,188 @@ CoreIsImageTypeSupported (
          EFI_IMAGE_MACHINE_CROSS_TYPE_SUPPORTED (Image->ImageContext.Machine);
 }
 
+/**
+  Locate the PE32 image of a file in a memory mapped FV, so that it may be
+  executed in place.
+
+  @param  DeviceHandle            The handle of the FV.
+  @param  FilePath                The remaining device path of the file in the
+                                  FV.
+  @param  FHand                   The image file handle. InPlaceImage is set if
+                                  the PE32 image was found.
+
+**/
+STATIC
+VOID
+CoreLocateImageInPlace (
+  IN     EFI_HANDLE                DeviceHandle,
+  IN     EFI_DEVICE_PATH_PROTOCOL  *FilePath,
+  IN OUT IMAGE_FILE_HANDLE         *FHand
+  )
+{
+  EFI_STATUS                     Status;
+  EFI_FIRMWARE_VOLUME2_PROTOCOL  *Fv;
+  EFI_GUID                       *NameGuid;
+
+  Status = CoreHandleProtocol (DeviceHandle, &gEfiFirmwareVolume2ProtocolGuid, (VOID **)&Fv);
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  NameGuid = EfiGetNameGuidFromFwVolDevicePathNode ((CONST MEDIA_FW_VOL_FILEPATH_DEVICE_PATH *)FilePath);
+  if (NameGuid == NULL) {
+    return;
+  }
+
+  Status = FvLocateImageInPlace (Fv, NameGuid, &FHand->InPlaceImage, &FHand->InPlaceImageSize);
+  if (EFI_ERROR (Status)) {
+    FHand->InPlaceImage     = NULL;
+    FHand->InPlaceImageSize = 0;
+  }
+}
+
+/**
+  Get a reference to the PE32 image of a file in an FV produced by the DXE
+  Core, instead of a copy of it.
+
+  @param  DeviceHandle            The handle of the FV.
+  @param  FilePath                The remaining device path of the file in the
+                                  FV.
+  @param  FHand                   The image file handle. Source and
+                                  ReferenceHandle are set if the PE32 image was
+                                  found.
+  @param  AuthenticationStatus    On return, the authentication status of the
+                                  PE32 section.
+
+  @retval TRUE                    The reference was returned.
+  @retval FALSE                   The image has to be read through the FV
+                                  protocol.
+
+**/
+STATIC
+BOOLEAN
+CoreReadImageReference (
+  IN     EFI_HANDLE                DeviceHandle,
+  IN     EFI_DEVICE_PATH_PROTOCOL  *FilePath,
+  IN OUT IMAGE_FILE_HANDLE         *FHand,
+  OUT    UINT32                    *AuthenticationStatus
+  )
+{
+  EFI_STATUS                     Status;
+  EFI_FIRMWARE_VOLUME2_PROTOCOL  *Fv;
+  EFI_GUID                       *NameGuid;
+
+  //
+  // Same as GetFileBufferByFilePath(), only a file right in the FV is read.
+  //
+  NameGuid = EfiGetNameGuidFromFwVolDevicePathNode ((CONST MEDIA_FW_VOL_FILEPATH_DEVICE_PATH *)FilePath);
+  if ((NameGuid == NULL) || !IsDevicePathEnd (NextDevicePathNode (FilePath))) {
+    return FALSE;
+  }
+
+  Status = CoreHandleProtocol (DeviceHandle, &gEfiFirmwareVolume2ProtocolGuid, (VOID **)&Fv);
+  if (EFI_ERROR (Status)) {
+    return FALSE;
+  }
+
+  Status = FvReadFileSectionReference (
+             Fv,
+             NameGuid,
+             EFI_SECTION_PE32,
+             0,
+             &FHand->Source,
+             &FHand->SourceSize,
+             AuthenticationStatus,
+             &FHand->ReferenceHandle
+             );
+  if (EFI_ERROR (Status)) {
+    FHand->Source          = NULL;
+    FHand->SourceSize      = 0;
+    FHand->ReferenceHandle = 0;
+    *AuthenticationStatus  = 0;
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+  Check if an image can be executed in place in its memory mapped FV.
+
+  GenFv links the images of an FV that has a base address at their address in
+  the FV. When the platform puts such an FV in memory at its base address, the
+  images need neither to be copied nor to be relocated.
+
+  @param  FHand                   The image file handle.
+  @param  Image                   The image, whose ImageContext has been
+                                  filled in by PeCoffLoaderGetImageInfo().
+
+  @retval TRUE                    The image can be executed in place.
+  @retval FALSE                   The image has to be loaded.
+
+**/
+STATIC
+BOOLEAN
+CoreImageCanExecuteInPlace (
+  IN IMAGE_FILE_HANDLE          *FHand,
+  IN LOADED_IMAGE_PRIVATE_DATA  *Image
+  )
+{
+  EFI_STATUS                       Status;
+  PE_COFF_LOADER_IMAGE_CONTEXT     *ImageContext;
+  EFI_GCD_MEMORY_SPACE_DESCRIPTOR  Descriptor;
+
+  if ((FHand->InPlaceImage == NULL) || (FHand->InPlaceImageSize != FHand->SourceSize)) {
+    return FALSE;
+  }
+
+  //
+  // Runtime drivers have to be in runtime memory, and emulated images are
+  // loaded by their emulator.
+  //
+  ImageContext = &Image->ImageContext;
+  if (ImageContext->IsTeImage ||
+      (ImageContext->ImageType != EFI_IMAGE_SUBSYSTEM_EFI_BOOT_SERVICE_DRIVER) ||
+      !EFI_IMAGE_MACHINE_TYPE_SUPPORTED (ImageContext->Machine) ||
+      (Image->PeCoffEmu != NULL))
+  {
+    return FALSE;
+  }
+
+  //
+  // The image must be linked at its address in the FV, and all of it,
+  // including the zero-filled ends of its sections, must be in the PE32
+  // section.
+  //
+  if ((ImageContext->ImageAddress != (EFI_PHYSICAL_ADDRESS)(UINTN)FHand->InPlaceImage) ||
+      ((ImageContext->ImageAddress & (ImageContext->SectionAlignment - 1)) != 0) ||
+      (ImageContext->ImageSize > FHand->InPlaceImageSize))
+  {
+    return FALSE;
+  }
+
+  //
+  // The FV is not in code memory, so it could be made non-executable by the
+  // DXE NX memory protection policy.
+  //
+  if (PcdGet64 (PcdDxeNxMemoryProtectionPolicy) != 0) {
+    return FALSE;
+  }
+
+  //
+  // The data sections of the image are written, the FV must be in RAM.
+  //
+  Status = CoreGetMemorySpaceDescriptor (ImageContext->ImageAddress, &Descriptor);
+  if (EFI_ERROR (Status) ||
+      (Descriptor.GcdMemoryType != EfiGcdMemoryTypeSystemMemory) ||
+      (ImageContext->ImageAddress + ImageContext->ImageSize > Descriptor.BaseAddress + Descriptor.Length))
+  {
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
 /**
   Loads, relocates, and invokes a PE/COFF image
 
@@ -581,9 +763,11 @@ CoreLoadPeImage (
   IN  UINT32                    Attribute
   )
 {
-  EFI_STATUS  Status;
-  BOOLEAN     DstBufAlocated;
-  UINTN       Size;
+  EFI_STATUS         Status;
+  BOOLEAN            DstBufAlocated;
+  BOOLEAN            InPlace;
+  UINTN              Size;
+  IMAGE_FILE_HANDLE  *FHand;
 
   ZeroMem (&Image->ImageContext, sizeof (Image->ImageContext));
 
@@ -638,7 +822,27 @@ CoreLoadPeImage (
   // Allocate memory of the correct memory type aligned on the required image boundary
   //
   DstBufAlocated = FALSE;
-  if (DstBuffer == 0) {
+  InPlace        = FALSE;
+  if ((DstBuffer == 0) && CoreImageCanExecuteInPlace ((IMAGE_FILE_HANDLE *)Pe32Handle, Image)) {
+    //
+    // Read the image from the FV, so that PeCoffLoaderLoadImage() copies each
+    // section onto itself, which CopyMem() skips. The image is linked at that
+    // address, so PeCoffLoaderRelocateImage() has nothing to fix up either.
+    // The copy of the image read for the authentication is not needed anymore.
+    //
+    FHand = (IMAGE_FILE_HANDLE *)Pe32Handle;
+    if (FHand->FreeBuffer) {
+      CoreFreePool (FHand->Source);
+      FHand->FreeBuffer = FALSE;
+    }
+
+    FHand->Source        = FHand->InPlaceImage;
+    FHand->SourceSize    = FHand->InPlaceImageSize;
+    Image->NumberOfPages = 0;
+    InPlace              = TRUE;
+
+    DEBUG ((DEBUG_INFO | DEBUG_LOAD, "Executing image in place at 0x%11p\n", FHand->InPlaceImage));
+  } else if (DstBuffer == 0) {
     //
     // Allocate Destination Buffer as caller did not pass it in
     //
@@ -732,7 +936,11 @@ CoreLoadPeImage (
     Image->ImageContext.ImageAddress = DstBuffer;
   }
 
-  Image->ImageBasePage = Image->ImageContext.ImageAddress;
+  //
+  // The pages of an image executed in place belong to its FV, and are not
+  // freed when the image is unloaded.
+  //
+  Image->ImageBasePage = InPlace ? 0 : Image->ImageContext.ImageAddress;
   if (!Image->ImageContext.IsTeImage) {
     Image->ImageContext.ImageAddress =
       (Image->ImageContext.ImageAddress + Image->ImageContext.SectionAlignment - 1) &
@@ -1243,24 +1451,33 @@ CoreLoadImageCommon (
     }
 
     //
-    // Get the source file buffer by its device path.
+    // Get the source file buffer by its device path. The PE32 section of a
+    // file in an FV produced by the DXE Core is not copied, the image is read
+    // from the section stream of the file that the FV caches.
     //
-    FHand.Source = GetFileBufferByFilePath (
-                     BootPolicy,
-                     FilePath,
-                     &FHand.SourceSize,
-                     &AuthenticationStatus
-                     );
+    if (!ImageIsFromFv || !CoreReadImageReference (DeviceHandle, HandleFilePath, &FHand, &AuthenticationStatus)) {
+      FHand.Source = GetFileBufferByFilePath (
+                       BootPolicy,
+                       FilePath,
+                       &FHand.SourceSize,
+                       &AuthenticationStatus
+                       );
+      FHand.FreeBuffer = (BOOLEAN)(FHand.Source != NULL);
+    }
+
     if (FHand.Source == NULL) {
       Status = EFI_NOT_FOUND;
     } else {
-      FHand.FreeBuffer = TRUE;
       if (ImageIsFromLoadFile) {
         //
         // LoadFile () may cause the device path of the Handle be updated.
         //
         OriginalFilePath = AppendDevicePath (DevicePathFromHandle (DeviceHandle), Node);
       }
+
+      if (ImageIsFromFv && FeaturePcdGet (PcdDxeImageExecuteInPlace)) {
+        CoreLocateImageInPlace (DeviceHandle, HandleFilePath, &FHand);
+      }
     }
   }
 
@@ -1476,6 +1693,10 @@ Done:
     CoreFreePool (FHand.Source);
   }
 
+  if (FHand.ReferenceHandle != 0) {
+    ReleaseSectionReference (FHand.ReferenceHandle);
+  }
+
   if (OriginalFilePath != InputFilePath) {
     CoreFreePool (OriginalFilePath);
   }
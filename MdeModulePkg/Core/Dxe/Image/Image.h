@@ -18,6 +18,16 @@ typedef struct {
   BOOLEAN    FreeBuffer;
   VOID       *Source;
   UINTN      SourceSize;
+  //
+  // The PE32 image in a memory mapped FV, if it may be executed in place.
+  //
+  VOID       *InPlaceImage;
+  UINTN      InPlaceImageSize;
+  //
+  // The section reference to release, if Source refers to the section stream
+  // of the file instead of a copy of it.
+  //
+  UINTN      ReferenceHandle;
 } IMAGE_FILE_HANDLE;
 
 #endif
@@ -16,6 +16,14 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 //
 GLOBAL_REMOVE_IF_UNREFERENCED BOOLEAN  mOnGuarding = FALSE;
 
+//
+// State of the pool guard sampling, and the number of guarded pools not
+// freed yet.
+//
+GLOBAL_REMOVE_IF_UNREFERENCED UINT32  mPoolGuardSampleSeed      = 0;
+GLOBAL_REMOVE_IF_UNREFERENCED UINT32  mPoolGuardSampleCountdown = 0;
+GLOBAL_REMOVE_IF_UNREFERENCED UINTN   mPoolGuardSampledCount    = 0;
+
 //
 // Pointer to table tracking the Guarded memory with bitmap, in which  '1'
 // is used to indicate memory guarded. '0' might be free memory or Guard
@@ -645,6 +653,71 @@ IsPoolTypeToGuard (
            );
 }
 
+/**
+  Get the number of guarded type pool allocations until the next sampled one.
+
+  @param[in]  SampleRate      The average number of allocations per sample.
+
+  @return A random number between 1 and 2 * SampleRate - 1.
+**/
+STATIC
+UINT32
+GetPoolGuardSampleInterval (
+  IN UINT32  SampleRate
+  )
+{
+  //
+  // xorshift32
+  //
+  mPoolGuardSampleSeed ^= mPoolGuardSampleSeed << 13;
+  mPoolGuardSampleSeed ^= mPoolGuardSampleSeed >> 17;
+  mPoolGuardSampleSeed ^= mPoolGuardSampleSeed << 5;
+
+  return 1 + mPoolGuardSampleSeed % (2 * MIN (SampleRate, MAX_INT32) - 1);
+}
+
+/**
+  Check to see if a pool allocation of a type to guard should get Guard pages.
+
+  If PcdHeapGuardPoolSampleRate is N above 1, one in N of these allocations is
+  picked at random on average, and only while fewer than
+  PcdHeapGuardPoolSampleSlots guarded pools are not freed yet. Every one of
+  them is guarded otherwise.
+
+  @return TRUE  The pool allocation should be guarded.
+  @return FALSE The pool allocation should not be guarded.
+**/
+BOOLEAN
+IsPoolSampledToGuard (
+  VOID
+  )
+{
+  UINT32  SampleRate;
+  UINT32  SampleSlots;
+
+  SampleRate = PcdGet32 (PcdHeapGuardPoolSampleRate);
+  if (SampleRate <= 1) {
+    return TRUE;
+  }
+
+  if (mPoolGuardSampleSeed == 0) {
+    //
+    // Pick different allocations in every boot.
+    //
+    mPoolGuardSampleSeed      = (UINT32)GetPerformanceCounter () | 1;
+    mPoolGuardSampleCountdown = GetPoolGuardSampleInterval (SampleRate);
+  }
+
+  if (--mPoolGuardSampleCountdown != 0) {
+    return FALSE;
+  }
+
+  mPoolGuardSampleCountdown = GetPoolGuardSampleInterval (SampleRate);
+
+  SampleSlots = PcdGet32 (PcdHeapGuardPoolSampleSlots);
+  return (SampleSlots == 0) || (mPoolGuardSampledCount < SampleSlots);
+}
+
 /**
   Check to see if the page at the given address should be guarded or not.
 
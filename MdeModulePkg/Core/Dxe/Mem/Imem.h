@@ -25,6 +25,12 @@ typedef struct {
 
   UINT64             VirtualStart;
   UINT64             Attribute;
+
+  ///
+  /// Link on the address ordered list of EfiConventionalMemory entries, or
+  /// a NULL ForwardLink if the entry is not on that list.
+  ///
+  LIST_ENTRY         FreeLink;
 } MEMORY_MAP;
 
 //
@@ -35,6 +35,29 @@ typedef struct {
   LIST_ENTRY                   Link;
 } MEMORY_PROFILE_ALLOC_INFO_DATA;
 
+//
+// In sampling mode, the call sites are hashed by caller address and the
+// sampled allocations not freed yet by buffer address.
+//
+#define MEMORY_PROFILE_CALL_SITE_HASH_BITS  6
+#define MEMORY_PROFILE_SAMPLE_HASH_BITS     8
+
+typedef struct {
+  UINT32                      Signature;
+  MEMORY_PROFILE_CALL_SITE    CallSite;
+  LIST_ENTRY                  Link;
+} MEMORY_PROFILE_CALL_SITE_DATA;
+
+#define MEMORY_PROFILE_SAMPLE_SIGNATURE  SIGNATURE_32 ('M','P','S','P')
+
+typedef struct {
+  UINT32                           Signature;
+  PHYSICAL_ADDRESS                 Buffer;
+  UINT64                           Size;
+  MEMORY_PROFILE_CALL_SITE_DATA    *CallSiteData;
+  LIST_ENTRY                       Link;
+} MEMORY_PROFILE_SAMPLE_DATA;
+
 GLOBAL_REMOVE_IF_UNREFERENCED LIST_ENTRY                   mImageQueue           = INITIALIZE_LIST_HEAD_VARIABLE (mImageQueue);
 GLOBAL_REMOVE_IF_UNREFERENCED MEMORY_PROFILE_CONTEXT_DATA  mMemoryProfileContext = {
   MEMORY_PROFILE_CONTEXT_SIGNATURE,
@@ -62,6 +85,12 @@ GLOBAL_REMOVE_IF_UNREFERENCED BOOLEAN                   mMemoryProfileRecordingE
 GLOBAL_REMOVE_IF_UNREFERENCED EFI_DEVICE_PATH_PROTOCOL  *mMemoryProfileDriverPath;
 GLOBAL_REMOVE_IF_UNREFERENCED UINTN                     mMemoryProfileDriverPathSize;
 
+GLOBAL_REMOVE_IF_UNREFERENCED UINT32      mMemoryProfileSampleRate;
+GLOBAL_REMOVE_IF_UNREFERENCED UINT32      mMemoryProfileSampleCountdown;
+GLOBAL_REMOVE_IF_UNREFERENCED UINTN       mMemoryProfileCallSiteCount;
+GLOBAL_REMOVE_IF_UNREFERENCED LIST_ENTRY  mMemoryProfileCallSiteHash[1 << MEMORY_PROFILE_CALL_SITE_HASH_BITS];
+GLOBAL_REMOVE_IF_UNREFERENCED LIST_ENTRY  mMemoryProfileSampleHash[1 << MEMORY_PROFILE_SAMPLE_HASH_BITS];
+
 /**
   Get memory profile data.
 
@@ -594,6 +623,7 @@ MemoryProfileInit (
   )
 {
   MEMORY_PROFILE_CONTEXT_DATA  *ContextData;
+  UINTN                        Index;
 
   if (!IS_UEFI_MEMORY_PROFILE_ENABLED) {
     return;
@@ -604,6 +634,18 @@ MemoryProfileInit (
     return;
   }
 
+  mMemoryProfileSampleRate      = PcdGet32 (PcdMemoryProfileSampleRate);
+  mMemoryProfileSampleCountdown = mMemoryProfileSampleRate;
+  if (mMemoryProfileSampleRate != 0) {
+    for (Index = 0; Index < ARRAY_SIZE (mMemoryProfileCallSiteHash); Index++) {
+      InitializeListHead (&mMemoryProfileCallSiteHash[Index]);
+    }
+
+    for (Index = 0; Index < ARRAY_SIZE (mMemoryProfileSampleHash); Index++) {
+      InitializeListHead (&mMemoryProfileSampleHash[Index]);
+    }
+  }
+
   mMemoryProfileGettingStatus = FALSE;
   if ((PcdGet8 (PcdMemoryProfilePropertyMask) & BIT7) != 0) {
     mMemoryProfileRecordingEnable = MEMORY_PROFILE_RECORDING_DISABLE;
@@ -1330,6 +1372,315 @@ CoreUpdateProfileFree (
   } while (TRUE);
 }
 
+/**
+  Hash an address into one of the (1 << Bits) lists of a sampling mode hash.
+
+  @param Address        Caller or buffer address.
+  @param Bits           Number of bits of the hash.
+
+  @return Index of the list.
+
+**/
+UINTN
+GetMemoryProfileHashIndex (
+  IN PHYSICAL_ADDRESS  Address,
+  IN UINTN             Bits
+  )
+{
+  UINT32  Value;
+
+  //
+  // Multiplicative hash, the low bits of code and buffer addresses are mostly
+  // alignment and must not select the list on their own.
+  //
+  Value = (UINT32)Address ^ (UINT32)RShiftU64 (Address, 32);
+  return (UINTN)((UINT32)(Value * 0x9E3779B9U) >> (32 - Bits));
+}
+
+/**
+  Get the call site of a caller address and memory type, and create it if it
+  does not exist yet.
+
+  @param CallerAddress  Address of caller who call Allocate.
+  @param MemoryType     Memory type.
+
+  @return Pointer to the call site, or NULL if it could not be created.
+
+**/
+MEMORY_PROFILE_CALL_SITE_DATA *
+GetMemoryProfileCallSite (
+  IN PHYSICAL_ADDRESS  CallerAddress,
+  IN EFI_MEMORY_TYPE   MemoryType
+  )
+{
+  EFI_STATUS                     Status;
+  LIST_ENTRY                     *CallSiteList;
+  LIST_ENTRY                     *CallSiteLink;
+  MEMORY_PROFILE_CALL_SITE_DATA  *CallSiteData;
+  MEMORY_PROFILE_CALL_SITE       *CallSite;
+
+  CallSiteList = &mMemoryProfileCallSiteHash[GetMemoryProfileHashIndex (CallerAddress, MEMORY_PROFILE_CALL_SITE_HASH_BITS)];
+  for (CallSiteLink = CallSiteList->ForwardLink;
+       CallSiteLink != CallSiteList;
+       CallSiteLink = CallSiteLink->ForwardLink)
+  {
+    CallSiteData = CR (
+                     CallSiteLink,
+                     MEMORY_PROFILE_CALL_SITE_DATA,
+                     Link,
+                     MEMORY_PROFILE_CALL_SITE_SIGNATURE
+                     );
+    if ((CallSiteData->CallSite.CallerAddress == CallerAddress) &&
+        (CallSiteData->CallSite.MemoryType == MemoryType))
+    {
+      return CallSiteData;
+    }
+  }
+
+  //
+  // Use CoreInternalAllocatePool() that will not update profile for this AllocatePool action.
+  //
+  CallSiteData = NULL;
+  Status       = CoreInternalAllocatePool (
+                   EfiBootServicesData,
+                   sizeof (*CallSiteData),
+                   (VOID **)&CallSiteData
+                   );
+  if (EFI_ERROR (Status)) {
+    return NULL;
+  }
+
+  ASSERT (CallSiteData != NULL);
+
+  ZeroMem (CallSiteData, sizeof (*CallSiteData));
+  CallSite                   = &CallSiteData->CallSite;
+  CallSiteData->Signature    = MEMORY_PROFILE_CALL_SITE_SIGNATURE;
+  CallSite->Header.Signature = MEMORY_PROFILE_CALL_SITE_SIGNATURE;
+  CallSite->Header.Length    = (UINT16)sizeof (MEMORY_PROFILE_CALL_SITE);
+  CallSite->Header.Revision  = MEMORY_PROFILE_CALL_SITE_REVISION;
+  CallSite->CallerAddress    = CallerAddress;
+  CallSite->SampleRate       = mMemoryProfileSampleRate;
+  CallSite->MemoryType       = MemoryType;
+
+  InsertTailList (CallSiteList, &CallSiteData->Link);
+  mMemoryProfileCallSiteCount++;
+
+  return CallSiteData;
+}
+
+/**
+  Update memory profile Allocate information in sampling mode.
+
+  Only one in mMemoryProfileSampleRate allocations is recorded, and it is only
+  accumulated into its call site. The sampled buffer is remembered so that its
+  free can be matched without searching the drivers.
+
+  @param CallerAddress  Address of caller who call Allocate.
+  @param MemoryType     Memory type.
+  @param Size           Buffer size.
+  @param Buffer         Buffer address.
+
+  @return EFI_SUCCESS           Memory profile is updated, or the allocation is not sampled.
+  @return EFI_UNSUPPORTED       Memory profile for the image is not required.
+  @return EFI_OUT_OF_RESOURCES  No enough resource to update memory profile for allocate action.
+
+**/
+EFI_STATUS
+CoreUpdateProfileSampleAllocate (
+  IN PHYSICAL_ADDRESS  CallerAddress,
+  IN EFI_MEMORY_TYPE   MemoryType,
+  IN UINTN             Size,
+  IN VOID              *Buffer
+  )
+{
+  EFI_STATUS                     Status;
+  MEMORY_PROFILE_CONTEXT_DATA    *ContextData;
+  MEMORY_PROFILE_CALL_SITE_DATA  *CallSiteData;
+  MEMORY_PROFILE_CALL_SITE       *CallSite;
+  MEMORY_PROFILE_SAMPLE_DATA     *SampleData;
+
+  ContextData = GetMemoryProfileContext ();
+  if (ContextData == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // SequenceCount still counts every allocation, sampled or not.
+  //
+  ContextData->Context.SequenceCount++;
+
+  if (--mMemoryProfileSampleCountdown != 0) {
+    return EFI_SUCCESS;
+  }
+
+  mMemoryProfileSampleCountdown = mMemoryProfileSampleRate;
+
+  if (GetMemoryProfileDriverInfoFromAddress (ContextData, CallerAddress) == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  CallSiteData = GetMemoryProfileCallSite (CallerAddress, MemoryType);
+  if (CallSiteData == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Use CoreInternalAllocatePool() that will not update profile for this AllocatePool action.
+  //
+  SampleData = NULL;
+  Status     = CoreInternalAllocatePool (
+                 EfiBootServicesData,
+                 sizeof (*SampleData),
+                 (VOID **)&SampleData
+                 );
+  if (EFI_ERROR (Status)) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  ASSERT (SampleData != NULL);
+
+  SampleData->Signature    = MEMORY_PROFILE_SAMPLE_SIGNATURE;
+  SampleData->Buffer       = (PHYSICAL_ADDRESS)(UINTN)Buffer;
+  SampleData->Size         = Size;
+  SampleData->CallSiteData = CallSiteData;
+  InsertTailList (
+    &mMemoryProfileSampleHash[GetMemoryProfileHashIndex (SampleData->Buffer, MEMORY_PROFILE_SAMPLE_HASH_BITS)],
+    &SampleData->Link
+    );
+
+  CallSite = &CallSiteData->CallSite;
+  CallSite->AllocCount++;
+  CallSite->AllocSize   += Size;
+  CallSite->CurrentSize += Size;
+  if (CallSite->PeakSize < CallSite->CurrentSize) {
+    CallSite->PeakSize = CallSite->CurrentSize;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Update memory profile Free information in sampling mode.
+
+  Only frees of sampled buffers update the profile. Pages freed from the
+  start of a sampled buffer are taken off it; pages freed from its middle or
+  end are not matched, and stay accounted until the rest is freed.
+
+  @param BasicAction    This Free basic action.
+  @param Size           Buffer size.
+  @param Buffer         Buffer address.
+
+  @return EFI_SUCCESS           Memory profile is updated.
+  @return EFI_NOT_FOUND         The buffer was not sampled.
+
+**/
+EFI_STATUS
+CoreUpdateProfileSampleFree (
+  IN MEMORY_PROFILE_ACTION  BasicAction,
+  IN UINTN                  Size,
+  IN VOID                   *Buffer
+  )
+{
+  LIST_ENTRY                  *SampleList;
+  LIST_ENTRY                  *SampleLink;
+  MEMORY_PROFILE_SAMPLE_DATA  *SampleData;
+  MEMORY_PROFILE_CALL_SITE    *CallSite;
+
+  SampleList = &mMemoryProfileSampleHash[GetMemoryProfileHashIndex ((PHYSICAL_ADDRESS)(UINTN)Buffer, MEMORY_PROFILE_SAMPLE_HASH_BITS)];
+  for (SampleLink = SampleList->ForwardLink;
+       SampleLink != SampleList;
+       SampleLink = SampleLink->ForwardLink)
+  {
+    SampleData = CR (
+                   SampleLink,
+                   MEMORY_PROFILE_SAMPLE_DATA,
+                   Link,
+                   MEMORY_PROFILE_SAMPLE_SIGNATURE
+                   );
+    if (SampleData->Buffer == (PHYSICAL_ADDRESS)(UINTN)Buffer) {
+      break;
+    }
+  }
+
+  if (SampleLink == SampleList) {
+    return EFI_NOT_FOUND;
+  }
+
+  CallSite = &SampleData->CallSiteData->CallSite;
+  RemoveEntryList (&SampleData->Link);
+
+  if ((BasicAction == MemoryProfileActionFreePages) && (Size < SampleData->Size)) {
+    CallSite->CurrentSize -= Size;
+    SampleData->Buffer    += Size;
+    SampleData->Size      -= Size;
+    InsertTailList (
+      &mMemoryProfileSampleHash[GetMemoryProfileHashIndex (SampleData->Buffer, MEMORY_PROFILE_SAMPLE_HASH_BITS)],
+      &SampleData->Link
+      );
+    return EFI_SUCCESS;
+  }
+
+  CallSite->CurrentSize -= SampleData->Size;
+  CallSite->FreeCount++;
+
+  //
+  // Use CoreInternalFreePool() that will not update profile for this FreePool action.
+  //
+  CoreInternalFreePool (SampleData, NULL);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Update memory profile information in sampling mode.
+
+  @param CallerAddress  Address of caller who call Allocate or Free.
+  @param Action         This Allocate or Free action.
+  @param MemoryType     Memory type.
+  @param Size           Buffer size.
+  @param Buffer         Buffer address.
+
+  @return EFI_SUCCESS           Memory profile is updated, or the action is not sampled.
+  @return EFI_UNSUPPORTED       Memory profile for the image is not required.
+  @return EFI_OUT_OF_RESOURCES  No enough resource to update memory profile for allocate action.
+  @return EFI_NOT_FOUND         The buffer of the free action was not sampled.
+
+**/
+EFI_STATUS
+CoreUpdateProfileSample (
+  IN PHYSICAL_ADDRESS       CallerAddress,
+  IN MEMORY_PROFILE_ACTION  Action,
+  IN EFI_MEMORY_TYPE        MemoryType,
+  IN UINTN                  Size,
+  IN VOID                   *Buffer
+  )
+{
+  MEMORY_PROFILE_ACTION  BasicAction;
+
+  BasicAction = Action & MEMORY_PROFILE_ACTION_BASIC_MASK;
+
+  //
+  // The extended actions of the memory allocation libraries describe buffers
+  // that are also reported with their basic action, only sample the latter.
+  //
+  if (Action != BasicAction) {
+    return EFI_SUCCESS;
+  }
+
+  switch (BasicAction) {
+    case MemoryProfileActionAllocatePages:
+    case MemoryProfileActionAllocatePool:
+      return CoreUpdateProfileSampleAllocate (CallerAddress, MemoryType, Size, Buffer);
+    case MemoryProfileActionFreePages:
+      return CoreUpdateProfileSampleFree (BasicAction, Size, Buffer);
+    case MemoryProfileActionFreePool:
+      return CoreUpdateProfileSampleFree (BasicAction, 0, Buffer);
+    default:
+      ASSERT (FALSE);
+      return EFI_UNSUPPORTED;
+  }
+}
+
 /**
   Update memory profile information.
 
@@ -1402,6 +1753,12 @@ CoreUpdateProfile (
   }
 
   CoreAcquireMemoryProfileLock ();
+  if (mMemoryProfileSampleRate != 0) {
+    Status = CoreUpdateProfileSample (CallerAddress, Action, MemoryType, Size, Buffer);
+    CoreReleaseMemoryProfileLock ();
+    return Status;
+  }
+
   switch (BasicAction) {
     case MemoryProfileActionAllocatePages:
       Status = CoreUpdateProfileAllocate (CallerAddress, Action, MemoryType, Size, Buffer, ActionString);
@@ -1483,6 +1840,8 @@ MemoryProfileGetDataSize (
     }
   }
 
+  TotalSize += mMemoryProfileCallSiteCount * sizeof (MEMORY_PROFILE_CALL_SITE);
+
   return TotalSize;
 }
 
@@ -1503,12 +1862,16 @@ MemoryProfileCopyData (
   MEMORY_PROFILE_CONTEXT_DATA      *ContextData;
   MEMORY_PROFILE_DRIVER_INFO_DATA  *DriverInfoData;
   MEMORY_PROFILE_ALLOC_INFO_DATA   *AllocInfoData;
+  MEMORY_PROFILE_CALL_SITE         *CallSite;
+  MEMORY_PROFILE_CALL_SITE_DATA    *CallSiteData;
   LIST_ENTRY                       *DriverInfoList;
   LIST_ENTRY                       *DriverLink;
   LIST_ENTRY                       *AllocInfoList;
   LIST_ENTRY                       *AllocLink;
+  LIST_ENTRY                       *CallSiteLink;
   UINTN                            PdbSize;
   UINTN                            ActionStringSize;
+  UINTN                            Index;
 
   ContextData = GetMemoryProfileContext ();
   if (ContextData == NULL) {
@@ -1560,6 +1923,27 @@ MemoryProfileCopyData (
 
     DriverInfo = (MEMORY_PROFILE_DRIVER_INFO *)AllocInfo;
   }
+
+  if (mMemoryProfileCallSiteCount == 0) {
+    return;
+  }
+
+  CallSite = (MEMORY_PROFILE_CALL_SITE *)DriverInfo;
+  for (Index = 0; Index < ARRAY_SIZE (mMemoryProfileCallSiteHash); Index++) {
+    for (CallSiteLink = mMemoryProfileCallSiteHash[Index].ForwardLink;
+         CallSiteLink != &mMemoryProfileCallSiteHash[Index];
+         CallSiteLink = CallSiteLink->ForwardLink)
+    {
+      CallSiteData = CR (
+                       CallSiteLink,
+                       MEMORY_PROFILE_CALL_SITE_DATA,
+                       Link,
+                       MEMORY_PROFILE_CALL_SITE_SIGNATURE
+                       );
+      CopyMem (CallSite, &CallSiteData->CallSite, sizeof (MEMORY_PROFILE_CALL_SITE));
+      CallSite++;
+    }
+  }
 }
 
 /**
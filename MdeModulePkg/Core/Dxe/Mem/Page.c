@@ -29,6 +29,21 @@ typedef struct {
 //
 UINTN  mMemoryMapKey = 0;
 
+//
+// mMemoryMapGeneration - Changes whenever the output of CoreGetMemoryMap() may change
+// mMemoryMapCache      - Copy of the map built by CoreGetMemoryMap() for mMemoryMapCacheGeneration
+//
+UINT64                 mMemoryMapGeneration        = 1;
+UINT64                 mMemoryMapCacheGeneration   = 0;
+EFI_MEMORY_DESCRIPTOR  *mMemoryMapCache            = NULL;
+UINTN                  mMemoryMapCacheSize         = 0;
+UINTN                  mMemoryMapCacheBufferSize   = 0;
+UINTN                  mMemoryMapCacheRequiredSize = 0;
+
+EDKII_MEMORY_MAP_GENERATION_PROTOCOL  gMemoryMapGeneration = {
+  CoreGetMemoryMapGeneration
+};
+
 #define MAX_MAP_DEPTH  6
 
 ///
@@ -45,6 +60,12 @@ UINTN       mFreeMapStack = 0;
 ///
 LIST_ENTRY  mFreeMemoryMapEntryList           = INITIALIZE_LIST_HEAD_VARIABLE (mFreeMemoryMapEntryList);
 BOOLEAN     mMemoryTypeInformationInitialized = FALSE;
+///
+/// This list links the EfiConventionalMemory entries of gMemoryMap in
+/// ascending address order, so free pages can be searched without walking
+/// the whole memory map.
+///
+LIST_ENTRY  mFreeMemoryMap = INITIALIZE_LIST_HEAD_VARIABLE (mFreeMemoryMap);
 
 EFI_MEMORY_TYPE_STATISTICS  mMemoryTypeStatistics[EfiMaxMemoryType + 1] = {
   { 0, MAX_ALLOC_ADDRESS, 0, 0, EfiMaxMemoryType, TRUE,  FALSE },  // EfiReservedMemoryType
@@ -95,6 +116,35 @@ EFI_MEMORY_TYPE_INFORMATION  gMemoryTypeInformation[EfiMaxMemoryType + 1] = {
 //
 GLOBAL_REMOVE_IF_UNREFERENCED   BOOLEAN  gLoadFixedAddressCodeMemoryReady = FALSE;
 
+/**
+  Record that the output of CoreGetMemoryMap() may have changed.
+
+**/
+VOID
+CoreUpdateMemoryMapGeneration (
+  VOID
+  )
+{
+  mMemoryMapGeneration++;
+}
+
+/**
+  Return the current generation number of the UEFI memory map.
+
+  @param[in] This  The EDKII_MEMORY_MAP_GENERATION_PROTOCOL instance.
+
+  @return The current generation number of the memory map.
+
+**/
+UINT64
+EFIAPI
+CoreGetMemoryMapGeneration (
+  IN EDKII_MEMORY_MAP_GENERATION_PROTOCOL  *This
+  )
+{
+  return mMemoryMapGeneration;
+}
+
 /**
   Enter critical section by gaining lock on gMemoryLock.
 
@@ -119,6 +169,41 @@ CoreReleaseMemoryLock (
   CoreReleaseLock (&gMemoryLock);
 }
 
+/**
+  Internal function.  Adds a descriptor entry that has just been inserted
+  to gMemoryMap to the address ordered list of free descriptors, if it
+  describes EfiConventionalMemory.
+
+  @param  Entry                  The entry to add
+
+**/
+STATIC
+VOID
+InsertFreeMemoryMapEntry (
+  IN OUT MEMORY_MAP  *Entry
+  )
+{
+  LIST_ENTRY  *Link;
+  MEMORY_MAP  *Entry2;
+
+  if (Entry->Type != EfiConventionalMemory) {
+    Entry->FreeLink.ForwardLink = NULL;
+    return;
+  }
+
+  //
+  // Pages are allocated top down, so most insertions happen near the tail
+  //
+  for (Link = mFreeMemoryMap.BackLink; Link != &mFreeMemoryMap; Link = Link->BackLink) {
+    Entry2 = CR (Link, MEMORY_MAP, FreeLink, MEMORY_MAP_SIGNATURE);
+    if (Entry2->Start < Entry->Start) {
+      break;
+    }
+  }
+
+  InsertHeadList (Link, &Entry->FreeLink);
+}
+
 /**
   Internal function.  Removes a descriptor entry.
 
@@ -133,6 +218,11 @@ RemoveMemoryMapEntry (
   RemoveEntryList (&Entry->Link);
   Entry->Link.ForwardLink = NULL;
 
+  if (Entry->FreeLink.ForwardLink != NULL) {
+    RemoveEntryList (&Entry->FreeLink);
+    Entry->FreeLink.ForwardLink = NULL;
+  }
+
   if (Entry->FromPages) {
     //
     // Insert the free memory map descriptor to the end of mFreeMemoryMapEntryList
@@ -190,6 +280,7 @@ CoreAddRange (
   // Memory map being altered so updated key
   //
   mMemoryMapKey += 1;
+  CoreUpdateMemoryMapGeneration ();
 
   //
   // UEFI 2.0 added an event group for notificaiton on memory map changes.
@@ -244,6 +335,7 @@ CoreAddRange (
   mMapStack[mMapDepth].VirtualStart = 0;
   mMapStack[mMapDepth].Attribute    = Attribute;
   InsertTailList (&gMemoryMap, &mMapStack[mMapDepth].Link);
+  InsertFreeMemoryMapEntry (&mMapStack[mMapDepth]);
 
   mMapDepth += 1;
   ASSERT (mMapDepth < MAX_MAP_DEPTH);
@@ -356,6 +448,15 @@ CoreFreeMemoryMapStack (
       CopyMem (Entry, &mMapStack[mMapDepth], sizeof (MEMORY_MAP));
       Entry->FromPages = TRUE;
 
+      //
+      // Take over the position of the temporary descriptor in mFreeMemoryMap
+      //
+      if (mMapStack[mMapDepth].FreeLink.ForwardLink != NULL) {
+        InsertHeadList (&mMapStack[mMapDepth].FreeLink, &Entry->FreeLink);
+        RemoveEntryList (&mMapStack[mMapDepth].FreeLink);
+        mMapStack[mMapDepth].FreeLink.ForwardLink = NULL;
+      }
+
       //
       // Find insertion location
       //
@@ -631,6 +732,7 @@ CoreSetMemoryTypeInformationRange (
     }
   }
 
+  CoreUpdateMemoryMapGeneration ();
   mMemoryTypeInformationInitialized = TRUE;
 }
 
@@ -805,6 +907,7 @@ CoreAddMemoryDescriptor (
     }
   }
 
+  CoreUpdateMemoryMapGeneration ();
   mMemoryTypeInformationInitialized = TRUE;
 }
 
@@ -991,6 +1094,7 @@ CoreConvertPagesEx (
 
       Entry = &mMapStack[mMapDepth];
       InsertTailList (&gMemoryMap, &Entry->Link);
+      InsertFreeMemoryMapEntry (Entry);
 
       mMapDepth += 1;
       ASSERT (mMapDepth < MAX_MAP_DEPTH);
@@ -1173,15 +1277,13 @@ CoreFindFreePagesI (
   NumberOfBytes = LShiftU64 (NumberOfPages, EFI_PAGE_SHIFT);
   Target        = 0;
 
-  for (Link = gMemoryMap.ForwardLink; Link != &gMemoryMap; Link = Link->ForwardLink) {
-    Entry = CR (Link, MEMORY_MAP, Link, MEMORY_MAP_SIGNATURE);
-
-    //
-    // If it's not a free entry, don't bother with it
-    //
-    if (Entry->Type != EfiConventionalMemory) {
-      continue;
-    }
+  //
+  // Walk the free entries from the highest address down. The first range
+  // that satisfies the request is the highest one, so the search stops there.
+  //
+  for (Link = mFreeMemoryMap.BackLink; Link != &mFreeMemoryMap; Link = Link->BackLink) {
+    Entry = CR (Link, MEMORY_MAP, FreeLink, MEMORY_MAP_SIGNATURE);
+    ASSERT (Entry->Type == EfiConventionalMemory);
 
     //
     // Don't allocate out of Special-Purpose memory.
@@ -1194,12 +1296,17 @@ CoreFindFreePagesI (
     DescEnd   = Entry->End;
 
     //
-    // If desc is past max allowed address or below min allowed address, skip it
+    // If desc is past max allowed address, skip it. If it's below min allowed
+    // address, so are all the remaining ones.
     //
-    if ((DescStart >= MaxAddress) || (DescEnd < MinAddress)) {
+    if (DescStart >= MaxAddress) {
       continue;
     }
 
+    if (DescEnd < MinAddress) {
+      break;
+    }
+
     //
     // If desc ends past max allowed address, clip the end
     //
@@ -1229,22 +1336,21 @@ CoreFindFreePagesI (
       }
 
       //
-      // If this is the best match so far remember it
+      // This is the best match
       //
-      if (DescEnd > Target) {
-        if (NeedGuard) {
-          DescEnd = AdjustMemoryS (
-                      DescEnd + 1 - DescNumberOfBytes,
-                      DescNumberOfBytes,
-                      NumberOfBytes
-                      );
-          if (DescEnd == 0) {
-            continue;
-          }
+      if (NeedGuard) {
+        DescEnd = AdjustMemoryS (
+                    DescEnd + 1 - DescNumberOfBytes,
+                    DescNumberOfBytes,
+                    NumberOfBytes
+                    );
+        if (DescEnd == 0) {
+          continue;
         }
-
-        Target = DescEnd;
       }
+
+      Target = DescEnd;
+      break;
     }
   }
 
@@ -1905,24 +2011,33 @@ CoreGetMemoryMap (
     return EFI_INVALID_PARAMETER;
   }
 
-  CoreAcquireGcdMemoryLock ();
-
   //
-  // Count the number of Reserved and runtime MMIO entries
-  // And, count the number of Persistent entries.
+  // Grow the buffer of the cached map if the last map did not fit in it.
+  // That allocation changes the memory map, so it is only done when the
+  // caller asks for the size of the map and has no MapKey to use yet.
   //
-  NumberOfEntries = 0;
-  for (Link = mGcdMemorySpaceMap.ForwardLink; Link != &mGcdMemorySpaceMap; Link = Link->ForwardLink) {
-    GcdMapEntry = CR (Link, EFI_GCD_MAP_ENTRY, Link, EFI_GCD_MAP_SIGNATURE);
-    if ((GcdMapEntry->GcdMemoryType == EfiGcdMemoryTypePersistent) ||
-        (GcdMapEntry->GcdMemoryType == EfiGcdMemoryTypeReserved) ||
-        ((GcdMapEntry->GcdMemoryType == EfiGcdMemoryTypeMemoryMappedIo) &&
-         ((GcdMapEntry->Attributes & EFI_MEMORY_RUNTIME) == EFI_MEMORY_RUNTIME)))
-    {
-      NumberOfEntries++;
+  if (((*MemoryMapSize == 0) || (MemoryMap == NULL)) &&
+      (mMemoryMapCacheBufferSize < mMemoryMapCacheRequiredSize) &&
+      !gMemoryMapTerminated && (gEfiCurrentTpl <= TPL_NOTIFY))
+  {
+    if (mMemoryMapCache != NULL) {
+      CoreInternalFreePool (mMemoryMapCache, NULL);
+      mMemoryMapCache           = NULL;
+      mMemoryMapCacheBufferSize = 0;
+    }
+
+    //
+    // Leave room for the descriptors added by this and a few more allocations
+    //
+    BufferSize = mMemoryMapCacheRequiredSize + mMemoryMapCacheRequiredSize / 4;
+    Status     = CoreInternalAllocatePool (EfiBootServicesData, BufferSize, (VOID **)&mMemoryMapCache);
+    if (!EFI_ERROR (Status)) {
+      mMemoryMapCacheBufferSize = BufferSize;
     }
   }
 
+  CoreAcquireGcdMemoryLock ();
+
   Size = sizeof (EFI_MEMORY_DESCRIPTOR);
 
   //
@@ -1942,6 +2057,40 @@ CoreGetMemoryMap (
 
   CoreAcquireMemoryLock ();
 
+  //
+  // If neither the memory map nor the GCD map changed since the cached map
+  // was built, simply return a copy of it
+  //
+  if ((mMemoryMapCache != NULL) && (mMemoryMapCacheGeneration == mMemoryMapGeneration)) {
+    BufferSize = mMemoryMapCacheSize;
+    if (*MemoryMapSize < BufferSize) {
+      Status = EFI_BUFFER_TOO_SMALL;
+    } else if (MemoryMap == NULL) {
+      Status = EFI_INVALID_PARAMETER;
+    } else {
+      CopyMem (MemoryMap, mMemoryMapCache, BufferSize);
+      Status = EFI_SUCCESS;
+    }
+
+    goto Done;
+  }
+
+  //
+  // Count the number of Reserved and runtime MMIO entries
+  // And, count the number of Persistent entries.
+  //
+  NumberOfEntries = 0;
+  for (Link = mGcdMemorySpaceMap.ForwardLink; Link != &mGcdMemorySpaceMap; Link = Link->ForwardLink) {
+    GcdMapEntry = CR (Link, EFI_GCD_MAP_ENTRY, Link, EFI_GCD_MAP_SIGNATURE);
+    if ((GcdMapEntry->GcdMemoryType == EfiGcdMemoryTypePersistent) ||
+        (GcdMapEntry->GcdMemoryType == EfiGcdMemoryTypeReserved) ||
+        ((GcdMapEntry->GcdMemoryType == EfiGcdMemoryTypeMemoryMappedIo) &&
+         ((GcdMapEntry->Attributes & EFI_MEMORY_RUNTIME) == EFI_MEMORY_RUNTIME)))
+    {
+      NumberOfEntries++;
+    }
+  }
+
   //
   // Compute the buffer size needed to fit the entire map
   //
@@ -1950,6 +2099,8 @@ CoreGetMemoryMap (
     BufferSize += Size;
   }
 
+  mMemoryMapCacheRequiredSize = BufferSize;
+
   if (*MemoryMapSize < BufferSize) {
     Status = EFI_BUFFER_TOO_SMALL;
     goto Done;
@@ -2157,6 +2308,15 @@ CoreGetMemoryMap (
   MergeMemoryMap (MemoryMapStart, &BufferSize, Size);
   MemoryMapEnd = (EFI_MEMORY_DESCRIPTOR *)((UINT8 *)MemoryMapStart + BufferSize);
 
+  //
+  // Keep a copy of the map for the following calls, if it fits in the cache
+  //
+  if (BufferSize <= mMemoryMapCacheBufferSize) {
+    CopyMem (mMemoryMapCache, MemoryMapStart, BufferSize);
+    mMemoryMapCacheSize       = BufferSize;
+    mMemoryMapCacheGeneration = mMemoryMapGeneration;
+  }
+
   Status = EFI_SUCCESS;
 
 Done:
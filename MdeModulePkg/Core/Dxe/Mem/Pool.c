@@ -59,6 +59,50 @@ STATIC CONST UINT16  mPoolSizeTable[] = {
 
 #define MAX_POOL_SIZE  (MAX_ADDRESS - POOL_OVERHEAD)
 
+//
+// Small allocations may be served from slabs: granularity sized blocks of
+// pages that are cut into equally sized objects. A slab starts with a single
+// POOL_SLAB header, and each object only carries a POOL_SLAB_OBJECT header.
+//
+// The first character of the object signatures is odd, so they never match
+// the 8-byte aligned POOL_HEAD.Size (or the POOL_HEAD.Type on IA32) found at
+// the same offset in front of a regular pool buffer.
+//
+#define POOL_SLAB_SIGNATURE              SIGNATURE_32('p','s','l','b')
+#define POOL_SLAB_OBJECT_SIGNATURE       SIGNATURE_32('s','l','b','0')
+#define POOL_SLAB_OBJECT_FREE_SIGNATURE  SIGNATURE_32('s','l','b','f')
+
+typedef struct {
+  UINT32    Signature;
+  /// Offset of this object from the start of its POOL_SLAB
+  UINT32    Offset;
+} POOL_SLAB_OBJECT;
+
+typedef struct {
+  UINT32              Signature;
+  UINT32              Class;
+  EFI_MEMORY_TYPE     Type;
+  UINT32              FreeCount;
+  UINT32              ObjectCount;
+  UINTN               NoPages;
+  /// Singly linked list of free objects, chained through their data area
+  POOL_SLAB_OBJECT    *FreeList;
+  /// Link on POOL.SlabList[Class] while the slab has free objects
+  LIST_ENTRY          Link;
+} POOL_SLAB;
+
+#define POOL_SLAB_NEXT_FREE(a)  (*(POOL_SLAB_OBJECT **)((a) + 1))
+
+//
+// Object sizes of the slab classes, including the POOL_SLAB_OBJECT header
+//
+STATIC CONST UINT16  mPoolSlabSizeTable[] = {
+  16, 32, 48, 64, 96, 128, 192, 256, 384, 512
+};
+
+#define MAX_POOL_SLAB_CLASS        (ARRAY_SIZE (mPoolSlabSizeTable))
+#define MAX_POOL_SLAB_OBJECT_SIZE  (mPoolSlabSizeTable[MAX_POOL_SLAB_CLASS - 1])
+
 //
 // Globals
 //
@@ -69,6 +113,7 @@ typedef struct {
   UINTN              Used;
   EFI_MEMORY_TYPE    MemoryType;
   LIST_ENTRY         FreeList[MAX_POOL_LIST];
+  LIST_ENTRY         SlabList[MAX_POOL_SLAB_CLASS];
   LIST_ENTRY         Link;
 } POOL;
 
@@ -107,6 +152,31 @@ GetPoolIndexFromSize (
   return MAX_POOL_LIST;
 }
 
+/**
+  Get the slab class from the specified object size.
+
+  @param  Size          The object size, including the POOL_SLAB_OBJECT header.
+
+  @return               The index of the slab size table.
+
+**/
+STATIC
+UINTN
+GetPoolSlabClassFromSize (
+  UINTN  Size
+  )
+{
+  UINTN  Class;
+
+  for (Class = 0; Class < MAX_POOL_SLAB_CLASS; Class++) {
+    if (mPoolSlabSizeTable[Class] >= Size) {
+      return Class;
+    }
+  }
+
+  return MAX_POOL_SLAB_CLASS;
+}
+
 /**
   Called to initialize the pool.
 
@@ -126,6 +196,10 @@ CoreInitializePool (
     for (Index = 0; Index < MAX_POOL_LIST; Index++) {
       InitializeListHead (&mPoolHead[Type].FreeList[Index]);
     }
+
+    for (Index = 0; Index < MAX_POOL_SLAB_CLASS; Index++) {
+      InitializeListHead (&mPoolHead[Type].SlabList[Index]);
+    }
   }
 }
 
@@ -175,6 +249,10 @@ LookupPoolHead (
       InitializeListHead (&Pool->FreeList[Index]);
     }
 
+    for (Index = 0; Index < MAX_POOL_SLAB_CLASS; Index++) {
+      InitializeListHead (&Pool->SlabList[Index]);
+    }
+
     InsertHeadList (&mPoolHeadList, &Pool->Link);
 
     return Pool;
@@ -242,6 +320,8 @@ CoreInternalAllocatePool (
     return EFI_OUT_OF_RESOURCES;
   }
 
+  NeedGuard = NeedGuard && IsPoolSampledToGuard ();
+
   *Buffer = CoreAllocatePoolI (PoolType, Size, NeedGuard);
   CoreReleaseLock (&mPoolMemoryLock);
   return (*Buffer != NULL) ? EFI_SUCCESS : EFI_OUT_OF_RESOURCES;
@@ -336,6 +416,105 @@ CoreAllocatePoolPagesI (
   return Buffer;
 }
 
+/**
+  Internal function to allocate pool from a slab of a particular type.
+  Caller must have the memory lock held
+
+  @param  Pool                   The pool head of the memory type
+  @param  Size                   The amount of pool to allocate, aligned and
+                                 not including any header
+  @param  Granularity            The size of a slab
+
+  @return The allocate pool, or NULL
+
+**/
+STATIC
+VOID *
+CoreAllocatePoolSlab (
+  IN POOL   *Pool,
+  IN UINTN  Size,
+  IN UINTN  Granularity
+  )
+{
+  POOL_SLAB         *Slab;
+  POOL_SLAB_OBJECT  *Object;
+  UINTN             Class;
+  UINTN             ObjectSize;
+  UINTN             Offset;
+
+  Class = GetPoolSlabClassFromSize (Size + sizeof (POOL_SLAB_OBJECT));
+  ASSERT (Class < MAX_POOL_SLAB_CLASS);
+  ObjectSize = mPoolSlabSizeTable[Class];
+
+  //
+  // If there's no slab with a free object in the class, carve up a new one
+  //
+  if (IsListEmpty (&Pool->SlabList[Class])) {
+    Slab = CoreAllocatePoolPagesI (
+             Pool->MemoryType,
+             EFI_SIZE_TO_PAGES (Granularity),
+             Granularity,
+             FALSE
+             );
+    if (Slab == NULL) {
+      DEBUG ((DEBUG_ERROR | DEBUG_POOL, "AllocatePool: failed to allocate %ld bytes\n", (UINT64)Size));
+      return NULL;
+    }
+
+    Slab->Signature   = POOL_SLAB_SIGNATURE;
+    Slab->Class       = (UINT32)Class;
+    Slab->Type        = Pool->MemoryType;
+    Slab->ObjectCount = 0;
+    Slab->NoPages     = EFI_SIZE_TO_PAGES (Granularity);
+    Slab->FreeList    = NULL;
+    for (Offset = ALIGN_VARIABLE (sizeof (POOL_SLAB));
+         Offset + ObjectSize <= Granularity;
+         Offset += ObjectSize)
+    {
+      Object                       = (POOL_SLAB_OBJECT *)((UINT8 *)Slab + Offset);
+      Object->Signature            = POOL_SLAB_OBJECT_FREE_SIGNATURE;
+      Object->Offset               = (UINT32)Offset;
+      POOL_SLAB_NEXT_FREE (Object) = Slab->FreeList;
+      Slab->FreeList               = Object;
+      Slab->ObjectCount++;
+    }
+
+    Slab->FreeCount = Slab->ObjectCount;
+    InsertHeadList (&Pool->SlabList[Class], &Slab->Link);
+  }
+
+  Slab = CR (Pool->SlabList[Class].ForwardLink, POOL_SLAB, Link, POOL_SLAB_SIGNATURE);
+  ASSERT (Slab->FreeCount > 0);
+
+  Object = Slab->FreeList;
+  ASSERT (Object->Signature == POOL_SLAB_OBJECT_FREE_SIGNATURE);
+  Slab->FreeList = POOL_SLAB_NEXT_FREE (Object);
+  Slab->FreeCount--;
+
+  //
+  // Full slabs are taken off the list until one of their objects is freed
+  //
+  if (Slab->FreeCount == 0) {
+    RemoveEntryList (&Slab->Link);
+  }
+
+  Object->Signature = POOL_SLAB_OBJECT_SIGNATURE;
+  Pool->Used       += ObjectSize;
+
+  DEBUG_CLEAR_MEMORY (Object + 1, ObjectSize - sizeof (POOL_SLAB_OBJECT));
+
+  DEBUG ((
+    DEBUG_POOL,
+    "AllocatePoolI: Type %x, Addr %p (len %lx) %,ld\n",
+    Pool->MemoryType,
+    Object + 1,
+    (UINT64)(ObjectSize - sizeof (POOL_SLAB_OBJECT)),
+    (UINT64)Pool->Used
+    ));
+
+  return Object + 1;
+}
+
 /**
   Internal function to allocate pool of a particular type.
   Caller must have the memory lock held
@@ -406,13 +585,24 @@ CoreAllocatePoolI (
   //
   Size = ALIGN_VARIABLE (Size);
 
-  Size += POOL_OVERHEAD;
-  Index = SIZE_TO_LIST (Size);
-  Pool  = LookupPoolHead (PoolType);
+  Pool = LookupPoolHead (PoolType);
   if (Pool == NULL) {
     return NULL;
   }
 
+  //
+  // Serve small allocations from the slabs of the size class, if enabled
+  //
+  if (!NeedGuard && !PageAsPool &&
+      (Size <= PcdGet32 (PcdDxePoolSlabMaxSize)) &&
+      (Size + sizeof (POOL_SLAB_OBJECT) <= MAX_POOL_SLAB_OBJECT_SIZE))
+  {
+    return CoreAllocatePoolSlab (Pool, Size, Granularity);
+  }
+
+  Size += POOL_OVERHEAD;
+  Index = SIZE_TO_LIST (Size);
+
   Head = NULL;
 
   //
@@ -429,6 +619,9 @@ CoreAllocatePoolI (
     Head     = CoreAllocatePoolPagesI (PoolType, NoPages, Granularity, NeedGuard);
     if (NeedGuard) {
       Head = AdjustPoolHeadA ((EFI_PHYSICAL_ADDRESS)(UINTN)Head, NoPages, Size);
+      if (Head != NULL) {
+        mPoolGuardSampledCount++;
+      }
     }
 
     goto Done;
@@ -676,6 +869,83 @@ CoreFreePoolPagesWithGuard (
   }
 }
 
+/**
+  Internal function to free a pool entry allocated from a slab.
+  Caller must have the memory lock held
+
+  @param  Object                 The header of the slab object to free
+  @param  PoolType               Pointer to pool type
+
+  @retval EFI_INVALID_PARAMETER  Object not valid
+  @retval EFI_SUCCESS            Object successfully freed.
+
+**/
+STATIC
+EFI_STATUS
+CoreFreePoolSlab (
+  IN  POOL_SLAB_OBJECT  *Object,
+  OUT EFI_MEMORY_TYPE   *PoolType OPTIONAL
+  )
+{
+  POOL       *Pool;
+  POOL_SLAB  *Slab;
+  UINTN      ObjectSize;
+
+  Slab = (POOL_SLAB *)((UINT8 *)Object - Object->Offset);
+  if ((Slab->Signature != POOL_SLAB_SIGNATURE) || (Slab->Class >= MAX_POOL_SLAB_CLASS)) {
+    ASSERT (Slab->Signature == POOL_SLAB_SIGNATURE);
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Pool = LookupPoolHead (Slab->Type);
+  if (Pool == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  ObjectSize  = mPoolSlabSizeTable[Slab->Class];
+  Pool->Used -= ObjectSize;
+  DEBUG ((DEBUG_POOL, "FreePool: %p (len %lx) %,ld\n", Object + 1, (UINT64)(ObjectSize - sizeof (POOL_SLAB_OBJECT)), (UINT64)Pool->Used));
+
+  if (PoolType != NULL) {
+    *PoolType = Slab->Type;
+  }
+
+  DEBUG_CLEAR_MEMORY (Object + 1, ObjectSize - sizeof (POOL_SLAB_OBJECT));
+
+  //
+  // Return the object to its slab, and put the slab back on the list if it
+  // was full
+  //
+  Object->Signature            = POOL_SLAB_OBJECT_FREE_SIGNATURE;
+  POOL_SLAB_NEXT_FREE (Object) = Slab->FreeList;
+  Slab->FreeList               = Object;
+  Slab->FreeCount++;
+  if (Slab->FreeCount == 1) {
+    InsertHeadList (&Pool->SlabList[Slab->Class], &Slab->Link);
+  }
+
+  //
+  // Release an empty slab, unless it's the last one of the class. The slabs
+  // of OS/OEM specific memory types are always released, so that the pool
+  // head can be freed once all of its allocations are gone.
+  //
+  if ((Slab->FreeCount == Slab->ObjectCount) &&
+      ((Pool->SlabList[Slab->Class].ForwardLink != Pool->SlabList[Slab->Class].BackLink) ||
+       ((UINT32)Pool->MemoryType >= MEMORY_TYPE_OEM_RESERVED_MIN)))
+  {
+    RemoveEntryList (&Slab->Link);
+    Slab->Signature = 0;
+    CoreFreePoolPagesI (Pool->MemoryType, (EFI_PHYSICAL_ADDRESS)(UINTN)Slab, Slab->NoPages);
+  }
+
+  if (((UINT32)Pool->MemoryType >= MEMORY_TYPE_OEM_RESERVED_MIN) && (Pool->Used == 0)) {
+    RemoveEntryList (&Pool->Link);
+    CoreFreePoolI (Pool, NULL);
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Internal function to free a pool entry.
   Caller must have the memory lock held
@@ -709,6 +979,14 @@ CoreFreePoolI (
   BOOLEAN    PageAsPool;
 
   ASSERT (Buffer != NULL);
+  //
+  // Slab objects are recognized by the signature in front of the buffer
+  //
+  if (((POOL_SLAB_OBJECT *)Buffer - 1)->Signature == POOL_SLAB_OBJECT_SIGNATURE) {
+    ASSERT_LOCKED (&mPoolMemoryLock);
+    return CoreFreePoolSlab ((POOL_SLAB_OBJECT *)Buffer - 1, PoolType);
+  }
+
   //
   // Get the head & tail of the pool entry
   //
@@ -800,6 +1078,7 @@ CoreFreePoolI (
         (EFI_PHYSICAL_ADDRESS)(UINTN)Head,
         NoPages
         );
+      mPoolGuardSampledCount--;
     } else {
       CoreFreePoolPagesI (
         Pool->MemoryType,
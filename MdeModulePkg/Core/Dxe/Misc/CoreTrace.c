@@ -0,0 +1,441 @@
+/** @file
+  DXE Core boot service trace and Stall() accounting.
+
+  If PcdDxeCoreTraceBufferSize is not zero, the ConnectController(),
+  LocateProtocol(), AllocatePages(), FreePages() and Stall() entries of the
+  Boot Services Table are replaced by wrappers that time every call made by a
+  driver and record it in the DXE Core trace configuration table.
+
+  If PcdDxeCoreStallAccountingEntries is not zero, the Stall() wrapper also
+  adds the requested and the elapsed time of every call to the entry of its
+  call site in the DXE Core stall configuration table, so that fixed delays
+  can be found even when the trace is disabled or full.
+
+  Calls the DXE Core makes internally are not recorded.
+
+Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DxeMain.h"
+
+EDKII_DXE_CORE_TRACE_TABLE   *mCoreTraceTable   = NULL;
+EDKII_DXE_CORE_TRACE_RECORD  *mCoreTraceRecords = NULL;
+EDKII_DXE_CORE_STALL_TABLE   *mCoreStallTable   = NULL;
+EDKII_DXE_CORE_STALL_ENTRY   *mCoreStallEntries = NULL;
+
+/**
+  Return the current time in nanoseconds for a trace record.
+
+  @return The current time in nanoseconds.
+
+**/
+STATIC
+UINT64
+CoreTraceGetTime (
+  VOID
+  )
+{
+  return GetTimeInNanoSecond (GetPerformanceCounter ());
+}
+
+/**
+  Add a record to the trace table. The record is dropped, but still counted,
+  if the table is full.
+
+  @param  Service     The traced service, EDKII_DXE_CORE_TRACE_*.
+  @param  StartTime   The time at which the service was entered.
+  @param  Caller      The return address of the caller of the service.
+  @param  Argument    The service specific argument.
+  @param  Guid        The service specific GUID, or NULL.
+
+**/
+STATIC
+VOID
+CoreTraceRecord (
+  IN UINT32          Service,
+  IN UINT64          StartTime,
+  IN VOID            *Caller,
+  IN UINT64          Argument,
+  IN CONST EFI_GUID  *Guid OPTIONAL
+  )
+{
+  UINT64                       EndTime;
+  UINT32                       Index;
+  EDKII_DXE_CORE_TRACE_RECORD  *Record;
+
+  EndTime = CoreTraceGetTime ();
+  Index   = InterlockedIncrement (&mCoreTraceTable->RecordCount) - 1;
+  if (Index >= mCoreTraceTable->MaxRecords) {
+    return;
+  }
+
+  Record            = &mCoreTraceRecords[Index];
+  Record->StartTime = StartTime;
+  Record->EndTime   = EndTime;
+  Record->Caller    = (UINT64)(UINTN)Caller;
+  Record->Argument  = Argument;
+  Record->Service   = Service;
+  Record->CpuIndex  = 0;
+  if (Guid != NULL) {
+    CopyGuid (&Record->Guid, Guid);
+  } else {
+    ZeroMem (&Record->Guid, sizeof (Record->Guid));
+  }
+}
+
+/**
+  Add a Stall() call to the entry of its call site. A new entry is taken for
+  a call site that is not in the table yet.
+
+  @param  Caller          The return address of the caller of Stall().
+  @param  Microseconds    The requested stall time.
+  @param  Elapsed         The time spent in Stall(), in nanoseconds.
+
+**/
+STATIC
+VOID
+CoreStallAccount (
+  IN VOID    *Caller,
+  IN UINTN   Microseconds,
+  IN UINT64  Elapsed
+  )
+{
+  EFI_TPL                     OldTpl;
+  UINT32                      Index;
+  EDKII_DXE_CORE_STALL_ENTRY  *Entry;
+
+  //
+  // Stall() may be called at any TPL, keep the table consistent.
+  //
+  OldTpl = CoreRaiseTpl (TPL_HIGH_LEVEL);
+
+  Entry = NULL;
+  for (Index = 0; Index < mCoreStallTable->EntryCount; Index++) {
+    if (mCoreStallEntries[Index].Caller == (UINT64)(UINTN)Caller) {
+      Entry = &mCoreStallEntries[Index];
+      break;
+    }
+  }
+
+  if ((Entry == NULL) && (mCoreStallTable->EntryCount < mCoreStallTable->MaxEntries)) {
+    Entry         = &mCoreStallEntries[mCoreStallTable->EntryCount++];
+    Entry->Caller = (UINT64)(UINTN)Caller;
+  }
+
+  if (Entry != NULL) {
+    Entry->Count++;
+    Entry->RequestedMicroseconds += Microseconds;
+    Entry->ElapsedNanoseconds    += Elapsed;
+  } else {
+    mCoreStallTable->DroppedCount++;
+  }
+
+  CoreRestoreTpl (OldTpl);
+}
+
+/**
+  Traced ConnectController() boot service.
+
+  @param  ControllerHandle      The handle of the controller to which driver(s)
+                                are to be connected.
+  @param  DriverImageHandle     A pointer to an ordered list handles that
+                                support the EFI_DRIVER_BINDING_PROTOCOL.
+  @param  RemainingDevicePath   A pointer to the device path that specifies a
+                                child of the controller specified by
+                                ControllerHandle.
+  @param  Recursive             Whether the function would be called
+                                recursively or not.
+
+  @return The status returned by CoreConnectController().
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+CoreTraceConnectController (
+  IN  EFI_HANDLE                ControllerHandle,
+  IN  EFI_HANDLE                *DriverImageHandle    OPTIONAL,
+  IN  EFI_DEVICE_PATH_PROTOCOL  *RemainingDevicePath  OPTIONAL,
+  IN  BOOLEAN                   Recursive
+  )
+{
+  UINT64      StartTime;
+  EFI_STATUS  Status;
+
+  StartTime = CoreTraceGetTime ();
+  Status    = CoreConnectController (ControllerHandle, DriverImageHandle, RemainingDevicePath, Recursive);
+  CoreTraceRecord (
+    EDKII_DXE_CORE_TRACE_CONNECT_CONTROLLER,
+    StartTime,
+    RETURN_ADDRESS (0),
+    (UINT64)(UINTN)ControllerHandle,
+    NULL
+    );
+  return Status;
+}
+
+/**
+  Traced LocateProtocol() boot service.
+
+  @param  Protocol              The protocol to search for
+  @param  Registration          Optional Registration Key returned from
+                                RegisterProtocolNotify()
+  @param  Interface             Return the Protocol interface (instance).
+
+  @return The status returned by CoreLocateProtocol().
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+CoreTraceLocateProtocol (
+  IN  EFI_GUID  *Protocol,
+  IN  VOID      *Registration OPTIONAL,
+  OUT VOID      **Interface
+  )
+{
+  UINT64      StartTime;
+  EFI_STATUS  Status;
+
+  StartTime = CoreTraceGetTime ();
+  Status    = CoreLocateProtocol (Protocol, Registration, Interface);
+  CoreTraceRecord (
+    EDKII_DXE_CORE_TRACE_LOCATE_PROTOCOL,
+    StartTime,
+    RETURN_ADDRESS (0),
+    0,
+    Protocol
+    );
+  return Status;
+}
+
+/**
+  Traced AllocatePages() boot service.
+
+  @param  Type                   The type of allocation to perform.
+  @param  MemoryType             The type of memory to turn the allocated pages
+                                 into.
+  @param  NumberOfPages          The number of pages to allocate.
+  @param  Memory                 A pointer to receive the base allocated memory
+                                 address.
+
+  @return The status returned by CoreAllocatePages().
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+CoreTraceAllocatePages (
+  IN EFI_ALLOCATE_TYPE         Type,
+  IN EFI_MEMORY_TYPE           MemoryType,
+  IN UINTN                     NumberOfPages,
+  IN OUT EFI_PHYSICAL_ADDRESS  *Memory
+  )
+{
+  UINT64      StartTime;
+  EFI_STATUS  Status;
+
+  StartTime = CoreTraceGetTime ();
+  Status    = CoreAllocatePages (Type, MemoryType, NumberOfPages, Memory);
+  CoreTraceRecord (
+    EDKII_DXE_CORE_TRACE_ALLOCATE_PAGES,
+    StartTime,
+    RETURN_ADDRESS (0),
+    NumberOfPages,
+    NULL
+    );
+  return Status;
+}
+
+/**
+  Traced FreePages() boot service.
+
+  @param  Memory                 Base address of memory being freed.
+  @param  NumberOfPages          The number of pages to free.
+
+  @return The status returned by CoreFreePages().
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+CoreTraceFreePages (
+  IN EFI_PHYSICAL_ADDRESS  Memory,
+  IN UINTN                 NumberOfPages
+  )
+{
+  UINT64      StartTime;
+  EFI_STATUS  Status;
+
+  StartTime = CoreTraceGetTime ();
+  Status    = CoreFreePages (Memory, NumberOfPages);
+  CoreTraceRecord (
+    EDKII_DXE_CORE_TRACE_FREE_PAGES,
+    StartTime,
+    RETURN_ADDRESS (0),
+    NumberOfPages,
+    NULL
+    );
+  return Status;
+}
+
+/**
+  Traced and accounted Stall() boot service.
+
+  @param  Microseconds           The number of microseconds to stall execution.
+
+  @return The status returned by CoreStall().
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+CoreTraceStall (
+  IN UINTN  Microseconds
+  )
+{
+  UINT64      StartTime;
+  EFI_STATUS  Status;
+
+  StartTime = CoreTraceGetTime ();
+  Status    = CoreStall (Microseconds);
+  if (mCoreStallTable != NULL) {
+    CoreStallAccount (RETURN_ADDRESS (0), Microseconds, CoreTraceGetTime () - StartTime);
+  }
+
+  if (mCoreTraceTable != NULL) {
+    CoreTraceRecord (
+      EDKII_DXE_CORE_TRACE_STALL,
+      StartTime,
+      RETURN_ADDRESS (0),
+      Microseconds,
+      NULL
+      );
+  }
+
+  return Status;
+}
+
+/**
+  Allocate a zeroed DXE Core trace configuration table.
+
+  @param  Size    The size of the table in bytes.
+
+  @return The table, or NULL if it cannot be allocated.
+
+**/
+STATIC
+VOID *
+CoreTraceAllocateTable (
+  IN UINTN  Size
+  )
+{
+  EFI_STATUS            Status;
+  EFI_PHYSICAL_ADDRESS  Memory;
+
+  Status = CoreAllocatePages (
+             AllocateAnyPages,
+             EfiBootServicesData,
+             EFI_SIZE_TO_PAGES (Size),
+             &Memory
+             );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: cannot allocate %d bytes - %r\n", __func__, Size, Status));
+    return NULL;
+  }
+
+  ZeroMem ((VOID *)(UINTN)Memory, Size);
+  return (VOID *)(UINTN)Memory;
+}
+
+/**
+  Install a DXE Core trace configuration table, or free it if it cannot be
+  installed.
+
+  @param  Guid    The GUID of the table.
+  @param  Table   The table.
+  @param  Size    The size of the table in bytes.
+
+  @retval TRUE    The table is installed.
+  @retval FALSE   The table was freed.
+
+**/
+STATIC
+BOOLEAN
+CoreTraceInstallTable (
+  IN EFI_GUID  *Guid,
+  IN VOID      *Table,
+  IN UINTN     Size
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = CoreInstallConfigurationTable (Guid, Table);
+  if (EFI_ERROR (Status)) {
+    CoreFreePages ((EFI_PHYSICAL_ADDRESS)(UINTN)Table, EFI_SIZE_TO_PAGES (Size));
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+  Allocate the DXE Core trace and stall tables that are enabled, install them
+  in the EFI System Table and route the traced boot services through their
+  wrappers.
+
+  This must be called after memory services are available and before the
+  Boot Services Table CRC is first calculated. Nothing is done for a table
+  whose PCD is zero, or that cannot be allocated.
+
+**/
+VOID
+CoreInitializeTraceTable (
+  VOID
+  )
+{
+  UINTN   Size;
+  UINT32  Entries;
+
+  Size = PcdGet32 (PcdDxeCoreTraceBufferSize);
+  if (Size >= sizeof (EDKII_DXE_CORE_TRACE_TABLE) + sizeof (EDKII_DXE_CORE_TRACE_RECORD)) {
+    mCoreTraceTable = CoreTraceAllocateTable (Size);
+    if (mCoreTraceTable != NULL) {
+      mCoreTraceRecords           = (EDKII_DXE_CORE_TRACE_RECORD *)(mCoreTraceTable + 1);
+      mCoreTraceTable->Signature  = EDKII_DXE_CORE_TRACE_SIGNATURE;
+      mCoreTraceTable->MaxRecords = (UINT32)((Size - sizeof (EDKII_DXE_CORE_TRACE_TABLE)) / sizeof (EDKII_DXE_CORE_TRACE_RECORD));
+      if (!CoreTraceInstallTable (&gEdkiiDxeCoreTraceTableGuid, mCoreTraceTable, Size)) {
+        mCoreTraceTable   = NULL;
+        mCoreTraceRecords = NULL;
+      }
+    }
+  }
+
+  Entries = PcdGet32 (PcdDxeCoreStallAccountingEntries);
+  if (Entries != 0) {
+    Size            = sizeof (EDKII_DXE_CORE_STALL_TABLE) + Entries * sizeof (EDKII_DXE_CORE_STALL_ENTRY);
+    mCoreStallTable = CoreTraceAllocateTable (Size);
+    if (mCoreStallTable != NULL) {
+      mCoreStallEntries           = (EDKII_DXE_CORE_STALL_ENTRY *)(mCoreStallTable + 1);
+      mCoreStallTable->Signature  = EDKII_DXE_CORE_STALL_SIGNATURE;
+      mCoreStallTable->MaxEntries = Entries;
+      if (!CoreTraceInstallTable (&gEdkiiDxeCoreStallTableGuid, mCoreStallTable, Size)) {
+        mCoreStallTable   = NULL;
+        mCoreStallEntries = NULL;
+      }
+    }
+  }
+
+  if (mCoreTraceTable != NULL) {
+    gBS->ConnectController = CoreTraceConnectController;
+    gBS->LocateProtocol    = CoreTraceLocateProtocol;
+    gBS->AllocatePages     = CoreTraceAllocatePages;
+    gBS->FreePages         = CoreTraceFreePages;
+  }
+
+  if ((mCoreTraceTable != NULL) || (mCoreStallTable != NULL)) {
+    gBS->Stall = CoreTraceStall;
+  }
+}
@@ -0,0 +1,169 @@
+/** @file
+  DXE Core index of the HOB list.
+
+  If PcdDxeCoreHobIndex is TRUE, the DXE Core groups the HOBs by type, and the
+  GUID extension HOBs by GUID, and installs the result in the EFI System Table,
+  so that DxeIndexedHobLib can find a HOB without walking the HOB list. The HOB
+  list does not grow after the DXE Core has started, so the index is built
+  once.
+
+Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DxeMain.h"
+
+/**
+  Compare two HOBs by type, GUID for GUID extension HOBs, and address.
+
+  @param  Buffer1   Pointer to the pointer to the first HOB.
+  @param  Buffer2   Pointer to the pointer to the second HOB.
+
+  @retval <0        The first HOB sorts before the second one.
+  @retval 0         The HOBs are the same.
+  @retval >0        The first HOB sorts after the second one.
+
+**/
+STATIC
+INTN
+EFIAPI
+CoreCompareIndexedHobs (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  EFI_PEI_HOB_POINTERS  Hob1;
+  EFI_PEI_HOB_POINTERS  Hob2;
+  INTN                  Result;
+
+  Hob1.Raw = *(UINT8 **)Buffer1;
+  Hob2.Raw = *(UINT8 **)Buffer2;
+
+  if (Hob1.Header->HobType != Hob2.Header->HobType) {
+    return (Hob1.Header->HobType < Hob2.Header->HobType) ? -1 : 1;
+  }
+
+  if (Hob1.Header->HobType == EFI_HOB_TYPE_GUID_EXTENSION) {
+    Result = CompareMem (&Hob1.Guid->Name, &Hob2.Guid->Name, sizeof (EFI_GUID));
+    if (Result != 0) {
+      return Result;
+    }
+  }
+
+  if (Hob1.Raw == Hob2.Raw) {
+    return 0;
+  }
+
+  return (Hob1.Raw < Hob2.Raw) ? -1 : 1;
+}
+
+/**
+  Build the index of the HOB list and install it in the EFI System Table.
+
+  This must be called after memory services are available and the HOB list
+  has been relocated. Nothing is done if PcdDxeCoreHobIndex is FALSE, or if
+  the index cannot be allocated.
+
+  @param  HobStart  The HOB list.
+
+**/
+VOID
+CoreInitializeHobIndex (
+  IN VOID  *HobStart
+  )
+{
+  EFI_STATUS             Status;
+  EFI_PEI_HOB_POINTERS   Hob;
+  EFI_PEI_HOB_POINTERS   Previous;
+  UINTN                  HobCount;
+  UINTN                  EntryCount;
+  UINTN                  Index;
+  VOID                   *HobListEnd;
+  VOID                   **Hobs;
+  VOID                   *SortBuffer;
+  EDKII_HOB_INDEX_TABLE  *Table;
+  EDKII_HOB_INDEX_ENTRY  *Entry;
+
+  if (!FeaturePcdGet (PcdDxeCoreHobIndex)) {
+    return;
+  }
+
+  HobCount = 0;
+  for (Hob.Raw = HobStart; !END_OF_HOB_LIST (Hob); Hob.Raw = GET_NEXT_HOB (Hob)) {
+    HobCount++;
+  }
+
+  HobListEnd = Hob.Raw;
+
+  Hobs = AllocatePool (MAX (HobCount, 1) * sizeof (VOID *));
+  if (Hobs == NULL) {
+    return;
+  }
+
+  Index = 0;
+  for (Hob.Raw = HobStart; !END_OF_HOB_LIST (Hob); Hob.Raw = GET_NEXT_HOB (Hob)) {
+    Hobs[Index++] = Hob.Raw;
+  }
+
+  QuickSort (Hobs, HobCount, sizeof (VOID *), CoreCompareIndexedHobs, &SortBuffer);
+
+  //
+  // One entry per HOB type, and per GUID for the GUID extension HOBs.
+  //
+  EntryCount = 0;
+  for (Index = 0; Index < HobCount; Index++) {
+    Hob.Raw = Hobs[Index];
+    if (Index != 0) {
+      Previous.Raw = Hobs[Index - 1];
+      if ((Previous.Header->HobType == Hob.Header->HobType) &&
+          ((Hob.Header->HobType != EFI_HOB_TYPE_GUID_EXTENSION) ||
+           CompareGuid (&Previous.Guid->Name, &Hob.Guid->Name)))
+      {
+        continue;
+      }
+    }
+
+    EntryCount++;
+  }
+
+  Table = AllocateZeroPool (sizeof (EDKII_HOB_INDEX_TABLE) + EntryCount * sizeof (EDKII_HOB_INDEX_ENTRY));
+  if (Table == NULL) {
+    FreePool (Hobs);
+    return;
+  }
+
+  Table->Signature  = EDKII_HOB_INDEX_SIGNATURE;
+  Table->EntryCount = (UINT32)EntryCount;
+  Table->HobList    = HobStart;
+  Table->HobListEnd = HobListEnd;
+  Table->Entries    = (EDKII_HOB_INDEX_ENTRY *)(Table + 1);
+  Table->Hobs       = Hobs;
+
+  Entry = NULL;
+  for (Index = 0; Index < HobCount; Index++) {
+    Hob.Raw = Hobs[Index];
+    if ((Entry == NULL) ||
+        (Entry->HobType != Hob.Header->HobType) ||
+        ((Hob.Header->HobType == EFI_HOB_TYPE_GUID_EXTENSION) && !CompareGuid (&Entry->Name, &Hob.Guid->Name)))
+    {
+      Entry           = (Entry == NULL) ? Table->Entries : Entry + 1;
+      Entry->HobType  = Hob.Header->HobType;
+      Entry->FirstHob = (UINT32)Index;
+      if (Hob.Header->HobType == EFI_HOB_TYPE_GUID_EXTENSION) {
+        CopyGuid (&Entry->Name, &Hob.Guid->Name);
+      }
+    }
+
+    Entry->HobCount++;
+  }
+
+  Status = CoreInstallConfigurationTable (&gEdkiiHobIndexTableGuid, Table);
+  if (EFI_ERROR (Status)) {
+    FreePool (Table);
+    FreePool (Hobs);
+    return;
+  }
+
+  DEBUG ((DEBUG_INFO, "HOB index: %d HOBs in %d entries\n", HobCount, EntryCount));
+}
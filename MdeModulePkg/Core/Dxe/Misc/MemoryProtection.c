@@ -17,6 +17,11 @@
   enqueues the protection request. Once the CpuArch is installed, the
   DxeCore dequeues the protection request and applies policy.
 
+  The sections of the images are applied in the order of their addresses, and
+  adjacent sections that get the same attributes are applied with a single
+  call, so that the images loaded before the CpuArch protocol do not cost one
+  call, and one page split, per section.
+
   Once the image is unloaded, the protection is removed automatically.
 
 Copyright (c) 2017 - 2018, Intel Corporation. All rights reserved.<BR>
@@ -61,6 +66,17 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define PREVIOUS_MEMORY_DESCRIPTOR(MemoryDescriptor, Size) \
   ((EFI_MEMORY_DESCRIPTOR *)((UINT8 *)(MemoryDescriptor) - (Size)))
 
+//
+// A range of consecutive image sections that get the same attributes. The
+// range is applied once the next section does not extend it.
+//
+typedef struct {
+  EFI_PHYSICAL_ADDRESS    BaseAddress;
+  UINT64                  Length;
+  UINT64                  Attributes;
+  EFI_PHYSICAL_ADDRESS    DescriptorEnd;
+} UEFI_IMAGE_PROTECTION_RANGE;
+
 UINT32  mImageProtectionPolicy;
 
 extern LIST_ENTRY  mGcdMemorySpaceMap;
@@ -206,80 +222,203 @@ SetUefiImageMemoryAttributes (
   gCpu->SetMemoryAttributes (gCpu, BaseAddress, Length, FinalAttributes);
 }
 
-/**
-  Set UEFI image protection attributes.
-
-  @param[in]  ImageRecord    A UEFI image record
-**/
-VOID
-SetUefiImageProtectionAttributes (
-  IN IMAGE_PROPERTIES_RECORD  *ImageRecord
-  )
-{
-  IMAGE_PROPERTIES_RECORD_CODE_SECTION  *ImageRecordCodeSection;
-  LIST_ENTRY                            *ImageRecordCodeSectionLink;
-  LIST_ENTRY                            *ImageRecordCodeSectionEndLink;
-  LIST_ENTRY                            *ImageRecordCodeSectionList;
-  UINT64                                CurrentBase;
-  UINT64                                ImageEnd;
-
-  ImageRecordCodeSectionList = &ImageRecord->CodeSegmentList;
-
-  CurrentBase = ImageRecord->ImageBase;
-  ImageEnd    = ImageRecord->ImageBase + ImageRecord->ImageSize;
-
-  ImageRecordCodeSectionLink    = ImageRecordCodeSectionList->ForwardLink;
-  ImageRecordCodeSectionEndLink = ImageRecordCodeSectionList;
-  while (ImageRecordCodeSectionLink != ImageRecordCodeSectionEndLink) {
-    ImageRecordCodeSection = CR (
-                               ImageRecordCodeSectionLink,
-                               IMAGE_PROPERTIES_RECORD_CODE_SECTION,
-                               Link,
-                               IMAGE_PROPERTIES_RECORD_CODE_SECTION_SIGNATURE
-                               );
-    ImageRecordCodeSectionLink = ImageRecordCodeSectionLink->ForwardLink;
-
-    ASSERT (CurrentBase <= ImageRecordCodeSection->CodeSegmentBase);
-    if (CurrentBase < ImageRecordCodeSection->CodeSegmentBase) {
-      //
-      // DATA
-      //
-      SetUefiImageMemoryAttributes (
-        CurrentBase,
-        ImageRecordCodeSection->CodeSegmentBase - CurrentBase,
-        EFI_MEMORY_XP
-        );
-    }
-
-    //
-    // CODE
-    //
-    SetUefiImageMemoryAttributes (
-      ImageRecordCodeSection->CodeSegmentBase,
-      ImageRecordCodeSection->CodeSegmentSize,
-      EFI_MEMORY_RO
-      );
-    CurrentBase = ImageRecordCodeSection->CodeSegmentBase + ImageRecordCodeSection->CodeSegmentSize;
-  }
-
-  //
-  // Last DATA
-  //
-  ASSERT (CurrentBase <= ImageEnd);
-  if (CurrentBase < ImageEnd) {
-    //
-    // DATA
-    //
-    SetUefiImageMemoryAttributes (
-      CurrentBase,
-      ImageEnd - CurrentBase,
-      EFI_MEMORY_XP
-      );
-  }
-
-  return;
-}
-
+/**
+  Apply the pending range of image sections, if any.
+
+  @param[in, out]  Pending    The pending range. It is empty on return.
+**/
+STATIC
+VOID
+FlushUefiImageProtectionRange (
+  IN OUT UEFI_IMAGE_PROTECTION_RANGE  *Pending
+  )
+{
+  if (Pending->Length != 0) {
+    SetUefiImageMemoryAttributes (Pending->BaseAddress, Pending->Length, Pending->Attributes);
+    Pending->Length = 0;
+  }
+}
+
+/**
+  Add an image section to the pending range.
+
+  The section extends the pending range if it follows it, gets the same
+  attributes, and is in the same GCD memory space descriptor, so that the
+  cache attributes of the range stay the same. Otherwise the pending range is
+  applied and the section becomes the pending range.
+
+  @param[in, out]  Pending       The pending range.
+  @param[in]       BaseAddress   The start address of the section.
+  @param[in]       Length        The length of the section.
+  @param[in]       Attributes    The attributes of the section.
+**/
+STATIC
+VOID
+AddUefiImageProtectionRange (
+  IN OUT UEFI_IMAGE_PROTECTION_RANGE  *Pending,
+  IN     EFI_PHYSICAL_ADDRESS         BaseAddress,
+  IN     UINT64                       Length,
+  IN     UINT64                       Attributes
+  )
+{
+  EFI_STATUS                       Status;
+  EFI_GCD_MEMORY_SPACE_DESCRIPTOR  Descriptor;
+
+  if ((Pending->Length != 0) &&
+      (Pending->BaseAddress + Pending->Length == BaseAddress) &&
+      (Pending->Attributes == Attributes) &&
+      (BaseAddress + Length <= Pending->DescriptorEnd))
+  {
+    Pending->Length += Length;
+    return;
+  }
+
+  FlushUefiImageProtectionRange (Pending);
+
+  Status = CoreGetMemorySpaceDescriptor (BaseAddress, &Descriptor);
+  ASSERT_EFI_ERROR (Status);
+  if (EFI_ERROR (Status)) {
+    Descriptor.BaseAddress = BaseAddress;
+    Descriptor.Length      = Length;
+  }
+
+  Pending->BaseAddress   = BaseAddress;
+  Pending->Length        = Length;
+  Pending->Attributes    = Attributes;
+  Pending->DescriptorEnd = Descriptor.BaseAddress + Descriptor.Length;
+}
+
+/**
+  Add the sections of a UEFI image to the pending range, in the order of
+  their addresses.
+
+  @param[in]       ImageRecord    A UEFI image record
+  @param[in, out]  Pending        The pending range.
+**/
+STATIC
+VOID
+AddUefiImageProtectionRanges (
+  IN     IMAGE_PROPERTIES_RECORD      *ImageRecord,
+  IN OUT UEFI_IMAGE_PROTECTION_RANGE  *Pending
+  )
+{
+  IMAGE_PROPERTIES_RECORD_CODE_SECTION  *ImageRecordCodeSection;
+  LIST_ENTRY                            *ImageRecordCodeSectionLink;
+  LIST_ENTRY                            *ImageRecordCodeSectionEndLink;
+  LIST_ENTRY                            *ImageRecordCodeSectionList;
+  UINT64                                CurrentBase;
+  UINT64                                ImageEnd;
+
+  ImageRecordCodeSectionList = &ImageRecord->CodeSegmentList;
+
+  CurrentBase = ImageRecord->ImageBase;
+  ImageEnd    = ImageRecord->ImageBase + ImageRecord->ImageSize;
+
+  ImageRecordCodeSectionLink    = ImageRecordCodeSectionList->ForwardLink;
+  ImageRecordCodeSectionEndLink = ImageRecordCodeSectionList;
+  while (ImageRecordCodeSectionLink != ImageRecordCodeSectionEndLink) {
+    ImageRecordCodeSection = CR (
+                               ImageRecordCodeSectionLink,
+                               IMAGE_PROPERTIES_RECORD_CODE_SECTION,
+                               Link,
+                               IMAGE_PROPERTIES_RECORD_CODE_SECTION_SIGNATURE
+                               );
+    ImageRecordCodeSectionLink = ImageRecordCodeSectionLink->ForwardLink;
+
+    ASSERT (CurrentBase <= ImageRecordCodeSection->CodeSegmentBase);
+    if (CurrentBase < ImageRecordCodeSection->CodeSegmentBase) {
+      //
+      // DATA
+      //
+      AddUefiImageProtectionRange (
+        Pending,
+        CurrentBase,
+        ImageRecordCodeSection->CodeSegmentBase - CurrentBase,
+        EFI_MEMORY_XP
+        );
+    }
+
+    //
+    // CODE
+    //
+    AddUefiImageProtectionRange (
+      Pending,
+      ImageRecordCodeSection->CodeSegmentBase,
+      ImageRecordCodeSection->CodeSegmentSize,
+      EFI_MEMORY_RO
+      );
+    CurrentBase = ImageRecordCodeSection->CodeSegmentBase + ImageRecordCodeSection->CodeSegmentSize;
+  }
+
+  //
+  // Last DATA
+  //
+  ASSERT (CurrentBase <= ImageEnd);
+  if (CurrentBase < ImageEnd) {
+    //
+    // DATA
+    //
+    AddUefiImageProtectionRange (
+      Pending,
+      CurrentBase,
+      ImageEnd - CurrentBase,
+      EFI_MEMORY_XP
+      );
+  }
+}
+
+/**
+  Set UEFI image protection attributes.
+
+  @param[in]  ImageRecord    A UEFI image record
+**/
+VOID
+SetUefiImageProtectionAttributes (
+  IN IMAGE_PROPERTIES_RECORD  *ImageRecord
+  )
+{
+  UEFI_IMAGE_PROTECTION_RANGE  Pending;
+
+  Pending.Length = 0;
+  AddUefiImageProtectionRanges (ImageRecord, &Pending);
+  FlushUefiImageProtectionRange (&Pending);
+}
+
+/**
+  Compare the base addresses of two UEFI image records.
+
+  @param[in]  Buffer1   Pointer to the first IMAGE_PROPERTIES_RECORD pointer.
+  @param[in]  Buffer2   Pointer to the second IMAGE_PROPERTIES_RECORD pointer.
+
+  @retval 0     The images start at the same address.
+  @retval <0    The first image starts below the second one.
+  @retval >0    The first image starts above the second one.
+**/
+STATIC
+INTN
+EFIAPI
+CompareImageRecordBase (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  CONST IMAGE_PROPERTIES_RECORD  *ImageRecord1;
+  CONST IMAGE_PROPERTIES_RECORD  *ImageRecord2;
+
+  ImageRecord1 = *(IMAGE_PROPERTIES_RECORD *CONST *)Buffer1;
+  ImageRecord2 = *(IMAGE_PROPERTIES_RECORD *CONST *)Buffer2;
+
+  if (ImageRecord1->ImageBase < ImageRecord2->ImageBase) {
+    return -1;
+  }
+
+  if (ImageRecord1->ImageBase > ImageRecord2->ImageBase) {
+    return 1;
+  }
+
+  return 0;
+}
+
 /**
   Return the section alignment requirement for the PE image section type.
 
@@ -321,13 +460,16 @@ GetMemoryProtectionSectionAlignment (
 }
 
 /**
-  Protect UEFI PE/COFF image.
+  Create the image record of a UEFI PE/COFF image to protect.
 
   @param[in]  LoadedImage              The loaded image protocol
   @param[in]  LoadedImageDevicePath    The loaded image device path protocol
+
+  @return The image record, or NULL if the image is not to be protected.
 **/
-VOID
-ProtectUefiImage (
+STATIC
+IMAGE_PROPERTIES_RECORD *
+CreateUefiImageProtectionRecord (
   IN EFI_LOADED_IMAGE_PROTOCOL  *LoadedImage,
   IN EFI_DEVICE_PATH_PROTOCOL   *LoadedImageDevicePath
   )
@@ -340,24 +482,20 @@ ProtectUefiImage (
   DEBUG ((DEBUG_INFO, "ProtectUefiImageCommon - 0x%x\n", LoadedImage));
   DEBUG ((DEBUG_INFO, "  - 0x%016lx - 0x%016lx\n", (EFI_PHYSICAL_ADDRESS)(UINTN)LoadedImage->ImageBase, LoadedImage->ImageSize));
 
-  if (gCpu == NULL) {
-    return;
-  }
-
   ProtectionPolicy = GetUefiImageProtectionPolicy (LoadedImage, LoadedImageDevicePath);
   switch (ProtectionPolicy) {
     case DO_NOT_PROTECT:
-      return;
+      return NULL;
     case PROTECT_IF_ALIGNED_ELSE_ALLOW:
       break;
     default:
       ASSERT (FALSE);
-      return;
+      return NULL;
   }
 
   ImageRecord = AllocateZeroPool (sizeof (*ImageRecord));
   if (ImageRecord == NULL) {
-    return;
+    return NULL;
   }
 
   RequiredAlignment = GetMemoryProtectionSectionAlignment (LoadedImage->ImageCodeType);
@@ -372,7 +510,33 @@ ProtectUefiImage (
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a failed to create image properties record\n", __func__));
     FreePool (ImageRecord);
-    goto Finish;
+    return NULL;
+  }
+
+  return ImageRecord;
+}
+
+/**
+  Protect UEFI PE/COFF image.
+
+  @param[in]  LoadedImage              The loaded image protocol
+  @param[in]  LoadedImageDevicePath    The loaded image device path protocol
+**/
+VOID
+ProtectUefiImage (
+  IN EFI_LOADED_IMAGE_PROTOCOL  *LoadedImage,
+  IN EFI_DEVICE_PATH_PROTOCOL   *LoadedImageDevicePath
+  )
+{
+  IMAGE_PROPERTIES_RECORD  *ImageRecord;
+
+  if (gCpu == NULL) {
+    return;
+  }
+
+  ImageRecord = CreateUefiImageProtectionRecord (LoadedImage, LoadedImageDevicePath);
+  if (ImageRecord == NULL) {
+    return;
   }
 
   //
@@ -384,9 +548,89 @@ ProtectUefiImage (
   // Record the image record in the list so we can undo the protections later
   //
   InsertTailList (&mProtectedImageRecordList, &ImageRecord->Link);
+}
 
-Finish:
-  return;
+/**
+  Protect all the UEFI PE/COFF images loaded so far.
+
+  The image records are sorted by address, so that the sections of all the
+  images are applied in a single ascending pass and the sections of adjacent
+  images are merged where they get the same attributes.
+
+  @param[in]  HandleBuffer    The handles of the loaded images.
+  @param[in]  NoHandles       The number of handles in HandleBuffer.
+**/
+STATIC
+VOID
+ProtectLoadedUefiImages (
+  IN EFI_HANDLE  *HandleBuffer,
+  IN UINTN       NoHandles
+  )
+{
+  EFI_STATUS                   Status;
+  EFI_LOADED_IMAGE_PROTOCOL    *LoadedImage;
+  EFI_DEVICE_PATH_PROTOCOL     *LoadedImageDevicePath;
+  IMAGE_PROPERTIES_RECORD      **ImageRecords;
+  IMAGE_PROPERTIES_RECORD      *ImageRecord;
+  UINTN                        ImageCount;
+  UINTN                        Index;
+  UEFI_IMAGE_PROTECTION_RANGE  Pending;
+
+  ImageRecords = AllocatePool (NoHandles * sizeof (*ImageRecords));
+  ImageCount   = 0;
+
+  for (Index = 0; Index < NoHandles; Index++) {
+    Status = gBS->HandleProtocol (
+                    HandleBuffer[Index],
+                    &gEfiLoadedImageProtocolGuid,
+                    (VOID **)&LoadedImage
+                    );
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    Status = gBS->HandleProtocol (
+                    HandleBuffer[Index],
+                    &gEfiLoadedImageDevicePathProtocolGuid,
+                    (VOID **)&LoadedImageDevicePath
+                    );
+    if (EFI_ERROR (Status)) {
+      LoadedImageDevicePath = NULL;
+    }
+
+    //
+    // Without the buffer to sort the records, protect the images one by one.
+    //
+    if (ImageRecords == NULL) {
+      ProtectUefiImage (LoadedImage, LoadedImageDevicePath);
+      continue;
+    }
+
+    ImageRecord = CreateUefiImageProtectionRecord (LoadedImage, LoadedImageDevicePath);
+    if (ImageRecord != NULL) {
+      ImageRecords[ImageCount++] = ImageRecord;
+    }
+  }
+
+  if (ImageRecords == NULL) {
+    return;
+  }
+
+  QuickSort (ImageRecords, ImageCount, sizeof (*ImageRecords), CompareImageRecordBase, &ImageRecord);
+
+  Pending.Length = 0;
+  for (Index = 0; Index < ImageCount; Index++) {
+    AddUefiImageProtectionRanges (ImageRecords[Index], &Pending);
+
+    //
+    // Record the image record in the list so we can undo the protections later
+    //
+    InsertTailList (&mProtectedImageRecordList, &ImageRecords[Index]->Link);
+  }
+
+  FlushUefiImageProtectionRange (&Pending);
+
+  FreePool (ImageRecords);
 }
 
 /**
@@ -775,12 +1019,9 @@ MemoryProtectionCpuArchProtocolNotify (
   IN VOID       *Context
   )
 {
-  EFI_STATUS                 Status;
-  EFI_LOADED_IMAGE_PROTOCOL  *LoadedImage;
-  EFI_DEVICE_PATH_PROTOCOL   *LoadedImageDevicePath;
-  UINTN                      NoHandles;
-  EFI_HANDLE                 *HandleBuffer;
-  UINTN                      Index;
+  EFI_STATUS  Status;
+  UINTN       NoHandles;
+  EFI_HANDLE  *HandleBuffer;
 
   DEBUG ((DEBUG_INFO, "MemoryProtectionCpuArchProtocolNotify:\n"));
   Status = CoreLocateProtocol (&gEfiCpuArchProtocolGuid, NULL, (VOID **)&gCpu);
@@ -815,27 +1056,7 @@ MemoryProtectionCpuArchProtocolNotify (
     goto Done;
   }
 
-  for (Index = 0; Index < NoHandles; Index++) {
-    Status = gBS->HandleProtocol (
-                    HandleBuffer[Index],
-                    &gEfiLoadedImageProtocolGuid,
-                    (VOID **)&LoadedImage
-                    );
-    if (EFI_ERROR (Status)) {
-      continue;
-    }
-
-    Status = gBS->HandleProtocol (
-                    HandleBuffer[Index],
-                    &gEfiLoadedImageDevicePathProtocolGuid,
-                    (VOID **)&LoadedImageDevicePath
-                    );
-    if (EFI_ERROR (Status)) {
-      LoadedImageDevicePath = NULL;
-    }
-
-    ProtectUefiImage (LoadedImage, LoadedImageDevicePath);
-  }
+  ProtectLoadedUefiImages (HandleBuffer, NoHandles);
 
   FreePool (HandleBuffer);
 
@@ -12,6 +12,11 @@
   The database is only created far enough to return the requested data from
   any given stream, or to determine that the requested data is not found.
 
+  GetSectionReference() returns a pointer to a section in the database
+  instead of a copy. The stream holding the section counts the references,
+  and a stream closed while it is referenced is only freed once the last
+  reference is released.
+
   If a GUIDed encapsulation is encountered, there are three possiblilites.
 
   1) A support protocol is found, in which the stream is simply processed with
@@ -82,6 +87,12 @@ typedef struct {
   // Authentication status is from GUIDed encapsulations.
   //
   UINT32        AuthenticationStatus;
+  //
+  // The number of references returned by GetSectionReference(). A stream
+  // closed while it is referenced is moved to mClosedStreamRoot.
+  //
+  UINTN         ReferenceCount;
+  BOOLEAN       FreeStreamBuffer;
 } CORE_SECTION_STREAM_NODE;
 
 #define NULL_STREAM_HANDLE  0
@@ -190,6 +201,11 @@ CustomGuidedSectionExtract (
 //
 LIST_ENTRY  mStreamRoot = INITIALIZE_LIST_HEAD_VARIABLE (mStreamRoot);
 
+//
+// The streams that were closed while they were referenced.
+//
+LIST_ENTRY  mClosedStreamRoot = INITIALIZE_LIST_HEAD_VARIABLE (mClosedStreamRoot);
+
 EFI_HANDLE  mSectionExtractionHandle = NULL;
 
 EFI_GUIDED_SECTION_EXTRACTION_PROTOCOL  mCustomGuidedSectionExtractionProtocol = {
@@ -385,6 +401,8 @@ OpenSectionStreamEx (
   NewStream->StreamLength = SectionStreamLength;
   InitializeListHead (&NewStream->Children);
   NewStream->AuthenticationStatus = AuthenticationStatus;
+  NewStream->ReferenceCount       = 0;
+  NewStream->FreeStreamBuffer     = FALSE;
 
   //
   // Add new stream to stream list
@@ -1179,6 +1197,113 @@ FindStreamNode (
   return EFI_NOT_FOUND;
 }
 
+/**
+  Worker function.  Locate a section in a section stream.
+
+  @param  StreamNode            The section stream to search.
+  @param  SectionType           A pointer to the type of section to search for,
+                                or NULL for the whole section stream.
+  @param  SectionDefinitionGuid If the section type is EFI_SECTION_GUID_DEFINED,
+                                then SectionDefinitionGuid indicates which of
+                                these types of sections to search for.
+  @param  SectionInstance       Indicates which instance of the requested
+                                section to return.
+  @param  SectionData           On return, the contents of the section.
+  @param  SectionSize           On return, the size of the contents.
+  @param  AuthenticationStatus  On return, the authentication status of the
+                                section.
+  @param  FoundStream           On return, the stream that holds the section.
+  @param  IsFfs3Fv              Indicates the FV format.
+
+  @retval EFI_SUCCESS           The section was found.
+  @retval others                The error returned by FindChildNode(), with
+                                EFI_ABORTED mapped to EFI_NOT_FOUND.
+
+**/
+STATIC
+EFI_STATUS
+LocateSection (
+  IN  CORE_SECTION_STREAM_NODE  *StreamNode,
+  IN  EFI_SECTION_TYPE          *SectionType,
+  IN  EFI_GUID                  *SectionDefinitionGuid,
+  IN  UINTN                     SectionInstance,
+  OUT UINT8                     **SectionData,
+  OUT UINTN                     *SectionSize,
+  OUT UINT32                    *AuthenticationStatus,
+  OUT CORE_SECTION_STREAM_NODE  **FoundStream,
+  IN  BOOLEAN                   IsFfs3Fv
+  )
+{
+  EFI_STATUS                 Status;
+  CORE_SECTION_CHILD_NODE    *ChildNode;
+  CORE_SECTION_STREAM_NODE   *ChildStreamNode;
+  UINT32                     ExtractedAuthenticationStatus;
+  UINTN                      Instance;
+  EFI_COMMON_SECTION_HEADER  *Section;
+
+  if (SectionType == NULL) {
+    //
+    // SectionType == NULL means return the WHOLE section stream...
+    //
+    *SectionSize          = StreamNode->StreamLength;
+    *SectionData          = StreamNode->StreamBuffer;
+    *AuthenticationStatus = StreamNode->AuthenticationStatus;
+    *FoundStream          = StreamNode;
+    return EFI_SUCCESS;
+  }
+
+  //
+  // There's a requested section type, so go find it and return it...
+  //
+  ChildStreamNode = NULL;
+  Instance        = SectionInstance + 1;
+  Status          = FindChildNode (
+                      StreamNode,
+                      *SectionType,
+                      &Instance,
+                      SectionDefinitionGuid,
+                      0,                        // encapsulation depth
+                      &ChildNode,
+                      &ChildStreamNode,
+                      &ExtractedAuthenticationStatus
+                      );
+  if (EFI_ERROR (Status)) {
+    if (Status == EFI_ABORTED) {
+      DEBUG ((
+        DEBUG_ERROR,
+        "%a: recursion aborted due to nesting depth\n",
+        __func__
+        ));
+      //
+      // Map "aborted" to "not found".
+      //
+      Status = EFI_NOT_FOUND;
+    }
+
+    return Status;
+  }
+
+  Section = (EFI_COMMON_SECTION_HEADER *)(ChildStreamNode->StreamBuffer + ChildNode->OffsetInStream);
+
+  if (IS_SECTION2 (Section)) {
+    ASSERT (SECTION2_SIZE (Section) > 0x00FFFFFF);
+    if (!IsFfs3Fv) {
+      DEBUG ((DEBUG_ERROR, "It is a FFS3 formatted section in a non-FFS3 formatted FV.\n"));
+      return EFI_NOT_FOUND;
+    }
+
+    *SectionSize = SECTION2_SIZE (Section) - sizeof (EFI_COMMON_SECTION_HEADER2);
+    *SectionData = (UINT8 *)Section + sizeof (EFI_COMMON_SECTION_HEADER2);
+  } else {
+    *SectionSize = SECTION_SIZE (Section) - sizeof (EFI_COMMON_SECTION_HEADER);
+    *SectionData = (UINT8 *)Section + sizeof (EFI_COMMON_SECTION_HEADER);
+  }
+
+  *AuthenticationStatus = ExtractedAuthenticationStatus;
+  *FoundStream          = ChildStreamNode;
+  return EFI_SUCCESS;
+}
+
 /**
   SEP member function.  Retrieves requested section from section stream.
 
@@ -1250,21 +1375,15 @@ GetSection (
   IN BOOLEAN           IsFfs3Fv
   )
 {
-  CORE_SECTION_STREAM_NODE   *StreamNode;
-  EFI_TPL                    OldTpl;
-  EFI_STATUS                 Status;
-  CORE_SECTION_CHILD_NODE    *ChildNode;
-  CORE_SECTION_STREAM_NODE   *ChildStreamNode;
-  UINTN                      CopySize;
-  UINT32                     ExtractedAuthenticationStatus;
-  UINTN                      Instance;
-  UINT8                      *CopyBuffer;
-  UINTN                      SectionSize;
-  EFI_COMMON_SECTION_HEADER  *Section;
+  CORE_SECTION_STREAM_NODE  *StreamNode;
+  CORE_SECTION_STREAM_NODE  *FoundStream;
+  EFI_TPL                   OldTpl;
+  EFI_STATUS                Status;
+  UINTN                     CopySize;
+  UINT8                     *CopyBuffer;
+  UINTN                     SectionSize;
 
-  ChildStreamNode = NULL;
-  OldTpl          = CoreRaiseTpl (TPL_NOTIFY);
-  Instance        = SectionInstance + 1;
+  OldTpl = CoreRaiseTpl (TPL_NOTIFY);
 
   //
   // Locate target stream
@@ -1278,61 +1397,19 @@ GetSection (
   //
   // Found the stream, now locate and return the appropriate section
   //
-  if (SectionType == NULL) {
-    //
-    // SectionType == NULL means return the WHOLE section stream...
-    //
-    CopySize              = StreamNode->StreamLength;
-    CopyBuffer            = StreamNode->StreamBuffer;
-    *AuthenticationStatus = StreamNode->AuthenticationStatus;
-  } else {
-    //
-    // There's a requested section type, so go find it and return it...
-    //
-    Status = FindChildNode (
-               StreamNode,
-               *SectionType,
-               &Instance,
-               SectionDefinitionGuid,
-               0,                             // encapsulation depth
-               &ChildNode,
-               &ChildStreamNode,
-               &ExtractedAuthenticationStatus
-               );
-    if (EFI_ERROR (Status)) {
-      if (Status == EFI_ABORTED) {
-        DEBUG ((
-          DEBUG_ERROR,
-          "%a: recursion aborted due to nesting depth\n",
-          __func__
-          ));
-        //
-        // Map "aborted" to "not found".
-        //
-        Status = EFI_NOT_FOUND;
-      }
-
-      goto GetSection_Done;
-    }
-
-    Section = (EFI_COMMON_SECTION_HEADER *)(ChildStreamNode->StreamBuffer + ChildNode->OffsetInStream);
-
-    if (IS_SECTION2 (Section)) {
-      ASSERT (SECTION2_SIZE (Section) > 0x00FFFFFF);
-      if (!IsFfs3Fv) {
-        DEBUG ((DEBUG_ERROR, "It is a FFS3 formatted section in a non-FFS3 formatted FV.\n"));
-        Status = EFI_NOT_FOUND;
-        goto GetSection_Done;
-      }
-
-      CopySize   = SECTION2_SIZE (Section) - sizeof (EFI_COMMON_SECTION_HEADER2);
-      CopyBuffer = (UINT8 *)Section + sizeof (EFI_COMMON_SECTION_HEADER2);
-    } else {
-      CopySize   = SECTION_SIZE (Section) - sizeof (EFI_COMMON_SECTION_HEADER);
-      CopyBuffer = (UINT8 *)Section + sizeof (EFI_COMMON_SECTION_HEADER);
-    }
-
-    *AuthenticationStatus = ExtractedAuthenticationStatus;
+  Status = LocateSection (
+             StreamNode,
+             SectionType,
+             SectionDefinitionGuid,
+             SectionInstance,
+             &CopyBuffer,
+             &CopySize,
+             AuthenticationStatus,
+             &FoundStream,
+             IsFfs3Fv
+             );
+  if (EFI_ERROR (Status)) {
+    goto GetSection_Done;
   }
 
   SectionSize = CopySize;
@@ -1364,6 +1441,86 @@ GetSection_Done:
   return Status;
 }
 
+/**
+  Retrieves a reference to the requested section of a section stream, instead
+  of a copy of it.
+
+  The section must not be modified. It stays valid until the reference is
+  released with ReleaseSectionReference(), even if the stream is closed.
+
+  @param  SectionStreamHandle   The section stream from which to extract the
+                                requested section.
+  @param  SectionType           A pointer to the type of section to search for,
+                                or NULL for the whole section stream.
+  @param  SectionDefinitionGuid If the section type is EFI_SECTION_GUID_DEFINED,
+                                then SectionDefinitionGuid indicates which of
+                                these types of sections to search for.
+  @param  SectionInstance       Indicates which instance of the requested
+                                section to return.
+  @param  Buffer                On return, the contents of the section.
+  @param  BufferSize            On return, the size of the contents.
+  @param  AuthenticationStatus  On return, the authentication status of the
+                                section, as returned by GetSection().
+  @param  ReferenceHandle       On return, the handle to pass to
+                                ReleaseSectionReference().
+  @param  IsFfs3Fv              Indicates the FV format.
+
+  @retval EFI_SUCCESS           The reference was returned.
+  @retval EFI_INVALID_PARAMETER The SectionStreamHandle does not exist.
+  @retval others                The errors returned by GetSection() when the
+                                section is not found.
+
+**/
+EFI_STATUS
+GetSectionReference (
+  IN  UINTN             SectionStreamHandle,
+  IN  EFI_SECTION_TYPE  *SectionType,
+  IN  EFI_GUID          *SectionDefinitionGuid,
+  IN  UINTN             SectionInstance,
+  OUT VOID              **Buffer,
+  OUT UINTN             *BufferSize,
+  OUT UINT32            *AuthenticationStatus,
+  OUT UINTN             *ReferenceHandle,
+  IN  BOOLEAN           IsFfs3Fv
+  )
+{
+  CORE_SECTION_STREAM_NODE  *StreamNode;
+  CORE_SECTION_STREAM_NODE  *FoundStream;
+  EFI_TPL                   OldTpl;
+  EFI_STATUS                Status;
+
+  OldTpl = CoreRaiseTpl (TPL_NOTIFY);
+
+  Status = FindStreamNode (SectionStreamHandle, &StreamNode);
+  if (EFI_ERROR (Status)) {
+    Status = EFI_INVALID_PARAMETER;
+  } else {
+    Status = LocateSection (
+               StreamNode,
+               SectionType,
+               SectionDefinitionGuid,
+               SectionInstance,
+               (UINT8 **)Buffer,
+               BufferSize,
+               AuthenticationStatus,
+               &FoundStream,
+               IsFfs3Fv
+               );
+    if (!EFI_ERROR (Status)) {
+      //
+      // The reference is held on the stream that holds the section, which may
+      // be an encapsulated stream that is closed independently of the stream
+      // that was searched.
+      //
+      FoundStream->ReferenceCount++;
+      *ReferenceHandle = FoundStream->StreamHandle;
+    }
+  }
+
+  CoreRestoreTpl (OldTpl);
+  return Status;
+}
+
 /**
   Worker function.  Destructor for child nodes.
 
@@ -1399,6 +1556,86 @@ FreeChildNode (
   CoreFreePool (ChildNode);
 }
 
+/**
+  Worker function.  Free a section stream and its children.
+
+  @param  StreamNode             The stream to free. It is not in any stream list.
+
+**/
+STATIC
+VOID
+FreeStreamNode (
+  IN CORE_SECTION_STREAM_NODE  *StreamNode
+  )
+{
+  LIST_ENTRY               *Link;
+  CORE_SECTION_CHILD_NODE  *ChildNode;
+
+  while (!IsListEmpty (&StreamNode->Children)) {
+    Link      = GetFirstNode (&StreamNode->Children);
+    ChildNode = CHILD_SECTION_NODE_FROM_LINK (Link);
+    FreeChildNode (ChildNode);
+  }
+
+  if (StreamNode->FreeStreamBuffer) {
+    CoreFreePool (StreamNode->StreamBuffer);
+  }
+
+  CoreFreePool (StreamNode);
+}
+
+/**
+  Release a reference returned by GetSectionReference().
+
+  @param  ReferenceHandle        The reference handle returned by
+                                 GetSectionReference().
+
+  @retval EFI_SUCCESS            The reference was released.
+  @retval EFI_INVALID_PARAMETER  ReferenceHandle does not refer to a referenced
+                                 stream.
+
+**/
+EFI_STATUS
+ReleaseSectionReference (
+  IN UINTN  ReferenceHandle
+  )
+{
+  CORE_SECTION_STREAM_NODE  *StreamNode;
+  LIST_ENTRY                *Link;
+  EFI_TPL                   OldTpl;
+  EFI_STATUS                Status;
+  BOOLEAN                   Closed;
+
+  OldTpl = CoreRaiseTpl (TPL_NOTIFY);
+
+  Closed = FALSE;
+  Status = FindStreamNode (ReferenceHandle, &StreamNode);
+  if (EFI_ERROR (Status)) {
+    for (Link = GetFirstNode (&mClosedStreamRoot); !IsNull (&mClosedStreamRoot, Link); Link = GetNextNode (&mClosedStreamRoot, Link)) {
+      StreamNode = STREAM_NODE_FROM_LINK (Link);
+      if (StreamNode->StreamHandle == ReferenceHandle) {
+        Closed = TRUE;
+        Status = EFI_SUCCESS;
+        break;
+      }
+    }
+  }
+
+  if (EFI_ERROR (Status) || (StreamNode->ReferenceCount == 0)) {
+    CoreRestoreTpl (OldTpl);
+    return EFI_INVALID_PARAMETER;
+  }
+
+  StreamNode->ReferenceCount--;
+  if ((StreamNode->ReferenceCount == 0) && Closed) {
+    RemoveEntryList (&StreamNode->Link);
+    FreeStreamNode (StreamNode);
+  }
+
+  CoreRestoreTpl (OldTpl);
+  return EFI_SUCCESS;
+}
+
 /**
   SEP member function.  Deletes an existing section stream
 
@@ -1422,8 +1659,6 @@ CloseSectionStream (
   CORE_SECTION_STREAM_NODE  *StreamNode;
   EFI_TPL                   OldTpl;
   EFI_STATUS                Status;
-  LIST_ENTRY                *Link;
-  CORE_SECTION_CHILD_NODE   *ChildNode;
 
   OldTpl = CoreRaiseTpl (TPL_NOTIFY);
 
@@ -1433,20 +1668,17 @@ CloseSectionStream (
   Status = FindStreamNode (StreamHandleToClose, &StreamNode);
   if (!EFI_ERROR (Status)) {
     //
-    // Found the stream, so close it
+    // Found the stream, so close it. A referenced stream is freed when its
+    // last reference is released.
     //
     RemoveEntryList (&StreamNode->Link);
-    while (!IsListEmpty (&StreamNode->Children)) {
-      Link      = GetFirstNode (&StreamNode->Children);
-      ChildNode = CHILD_SECTION_NODE_FROM_LINK (Link);
-      FreeChildNode (ChildNode);
-    }
-
-    if (FreeStreamBuffer) {
-      CoreFreePool (StreamNode->StreamBuffer);
+    StreamNode->FreeStreamBuffer = FreeStreamBuffer;
+    if (StreamNode->ReferenceCount != 0) {
+      InsertTailList (&mClosedStreamRoot, &StreamNode->Link);
+    } else {
+      FreeStreamNode (StreamNode);
     }
 
-    CoreFreePool (StreamNode);
     Status = EFI_SUCCESS;
   } else {
     Status = EFI_INVALID_PARAMETER;
@@ -0,0 +1,246 @@
+/** @file
+  Decode the chunks of a chunked GUIDed section in parallel on the APs.
+
+  The BSP looks up the decode handler and the output location of every chunk,
+  then the APs take the chunks from a shared queue and decode them. The APs
+  only run the decode handlers, they do not call any PEI service.
+
+Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DxeIpl.h"
+
+typedef struct {
+  CONST VOID                               *Section;
+  UINT8                                    *Output;
+  UINT32                                   OutputSize;
+  UINT8                                    *Scratch;
+  EXTRACT_GUIDED_SECTION_DECODE_HANDLER    Decode;
+  UINT32                                   AuthenticationStatus;
+  RETURN_STATUS                            Status;
+} DXE_IPL_SECTION_CHUNK;
+
+typedef struct {
+  DXE_IPL_SECTION_CHUNK    *Chunks;
+  UINT32                   ChunkCount;
+  volatile UINT32          NextChunk;
+} DXE_IPL_SECTION_CHUNK_QUEUE;
+
+/**
+  Decode the chunks of the queue until the queue is empty.
+
+  @param  Buffer  Pointer to the DXE_IPL_SECTION_CHUNK_QUEUE.
+
+**/
+VOID
+EFIAPI
+DxeIplDecodeSectionChunks (
+  IN OUT VOID  *Buffer
+  )
+{
+  DXE_IPL_SECTION_CHUNK_QUEUE  *Queue;
+  DXE_IPL_SECTION_CHUNK        *Chunk;
+  UINT32                       Index;
+  VOID                         *Output;
+
+  Queue = (DXE_IPL_SECTION_CHUNK_QUEUE *)Buffer;
+  for ( ; ;) {
+    Index = InterlockedIncrement (&Queue->NextChunk) - 1;
+    if (Index >= Queue->ChunkCount) {
+      break;
+    }
+
+    Chunk         = &Queue->Chunks[Index];
+    Output        = Chunk->Output;
+    Chunk->Status = Chunk->Decode (Chunk->Section, &Output, Chunk->Scratch, &Chunk->AuthenticationStatus);
+    if (!RETURN_ERROR (Chunk->Status) && (Output != Chunk->Output)) {
+      //
+      // Handlers that do not need processing return the data in place.
+      //
+      CopyMem (Chunk->Output, Output, Chunk->OutputSize);
+    }
+  }
+}
+
+/**
+  Decode a chunked GUIDed section into a caller allocated output buffer,
+  spreading the chunks over the APs.
+
+  @param  InputSection          The chunked GUIDed section.
+  @param  OutputBuffer          The buffer that receives the decoded data. It
+                                is large enough for the size returned by the
+                                GetInfo handler of the section.
+  @param  AuthenticationStatus  Returns the authentication status of the
+                                decoded data.
+
+  @retval EFI_SUCCESS           The section was decoded.
+  @retval EFI_UNSUPPORTED       The section is not a chunked section, or it
+                                cannot be decoded in parallel. The caller
+                                decodes it on the BSP instead.
+
+**/
+EFI_STATUS
+DxeIplChunkedSectionExtract (
+  IN  CONST VOID  *InputSection,
+  IN  VOID        *OutputBuffer,
+  OUT UINT32      *AuthenticationStatus
+  )
+{
+  EFI_STATUS                    Status;
+  CONST EFI_GUID                *SectionGuid;
+  EDKII_CHUNKED_SECTION_HEADER  *Header;
+  UINT32                        DataSize;
+  UINT32                        Offset;
+  UINT32                        ChunkSize;
+  UINT32                        Index;
+  DXE_IPL_SECTION_CHUNK         *Chunks;
+  DXE_IPL_SECTION_CHUNK_QUEUE   Queue;
+  UINT32                        ScratchSize;
+  UINT32                        MaxScratchSize;
+  UINT16                        Attribute;
+  UINT8                         *Output;
+  UINT8                         *Scratch;
+  EFI_PEI_MP_SERVICES_PPI       *MpServices;
+  UINTN                         NumberOfProcessors;
+  UINTN                         NumberOfEnabledProcessors;
+
+  if (IS_SECTION2 (InputSection)) {
+    SectionGuid = &((EFI_GUID_DEFINED_SECTION2 *)InputSection)->SectionDefinitionGuid;
+    Header      = (EDKII_CHUNKED_SECTION_HEADER *)((UINT8 *)InputSection + ((EFI_GUID_DEFINED_SECTION2 *)InputSection)->DataOffset);
+    DataSize    = SECTION2_SIZE (InputSection) - ((EFI_GUID_DEFINED_SECTION2 *)InputSection)->DataOffset;
+  } else {
+    SectionGuid = &((EFI_GUID_DEFINED_SECTION *)InputSection)->SectionDefinitionGuid;
+    Header      = (EDKII_CHUNKED_SECTION_HEADER *)((UINT8 *)InputSection + ((EFI_GUID_DEFINED_SECTION *)InputSection)->DataOffset);
+    DataSize    = SECTION_SIZE (InputSection) - ((EFI_GUID_DEFINED_SECTION *)InputSection)->DataOffset;
+  }
+
+  if (!CompareGuid (SectionGuid, &gEdkiiChunkedSectionGuid) ||
+      (DataSize < sizeof (EDKII_CHUNKED_SECTION_HEADER)) ||
+      (Header->Signature != EDKII_CHUNKED_SECTION_SIGNATURE) ||
+      (Header->ChunkCount < 2))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  Status = PeiServicesLocatePpi (&gEfiPeiMpServicesPpiGuid, 0, NULL, (VOID **)&MpServices);
+  if (EFI_ERROR (Status)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Status = MpServices->GetNumberOfProcessors (
+                         GetPeiServicesTablePointer (),
+                         MpServices,
+                         &NumberOfProcessors,
+                         &NumberOfEnabledProcessors
+                         );
+  if (EFI_ERROR (Status) || (NumberOfEnabledProcessors < 2)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Chunks = AllocateZeroPool (Header->ChunkCount * sizeof (DXE_IPL_SECTION_CHUNK));
+  if (Chunks == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Find the handler, the output location and the scratch size of each chunk.
+  //
+  Status         = EFI_UNSUPPORTED;
+  MaxScratchSize = 0;
+  Output         = OutputBuffer;
+  Offset         = sizeof (EDKII_CHUNKED_SECTION_HEADER);
+  for (Index = 0; Index < Header->ChunkCount; Index++) {
+    Offset = ALIGN_VALUE (Offset, 4);
+    if ((Offset > DataSize) || (DataSize - Offset < sizeof (EFI_COMMON_SECTION_HEADER2))) {
+      goto Done;
+    }
+
+    Chunks[Index].Section = (UINT8 *)Header + Offset;
+    if (IS_SECTION2 (Chunks[Index].Section)) {
+      ChunkSize   = SECTION2_SIZE (Chunks[Index].Section);
+      SectionGuid = &((EFI_GUID_DEFINED_SECTION2 *)Chunks[Index].Section)->SectionDefinitionGuid;
+    } else {
+      ChunkSize   = SECTION_SIZE (Chunks[Index].Section);
+      SectionGuid = &((EFI_GUID_DEFINED_SECTION *)Chunks[Index].Section)->SectionDefinitionGuid;
+    }
+
+    if ((ChunkSize < sizeof (EFI_GUID_DEFINED_SECTION)) || (ChunkSize > DataSize - Offset)) {
+      goto Done;
+    }
+
+    if (RETURN_ERROR (ExtractGuidedSectionGetHandlers (SectionGuid, NULL, &Chunks[Index].Decode)) ||
+        RETURN_ERROR (ExtractGuidedSectionGetInfo (Chunks[Index].Section, &Chunks[Index].OutputSize, &ScratchSize, &Attribute)))
+    {
+      goto Done;
+    }
+
+    Chunks[Index].Output = Output;
+    Output              += Chunks[Index].OutputSize;
+    MaxScratchSize       = MAX (MaxScratchSize, ScratchSize);
+    Offset              += ChunkSize;
+  }
+
+  if ((UINT64)(Output - (UINT8 *)OutputBuffer) != Header->DecodedSize) {
+    goto Done;
+  }
+
+  //
+  // Each chunk gets a scratch buffer of its own, so that the APs do not need
+  // to know which processor they are running on.
+  //
+  Scratch = NULL;
+  if (MaxScratchSize != 0) {
+    MaxScratchSize = ALIGN_VALUE (MaxScratchSize, 8);
+    Scratch        = AllocatePages (EFI_SIZE_TO_PAGES ((UINTN)MaxScratchSize * Header->ChunkCount));
+    if (Scratch == NULL) {
+      goto Done;
+    }
+
+    for (Index = 0; Index < Header->ChunkCount; Index++) {
+      Chunks[Index].Scratch = Scratch + (UINTN)MaxScratchSize * Index;
+    }
+  }
+
+  Queue.Chunks     = Chunks;
+  Queue.ChunkCount = Header->ChunkCount;
+  Queue.NextChunk  = 0;
+
+  Status = MpServices->StartupAllAPs (
+                         GetPeiServicesTablePointer (),
+                         MpServices,
+                         DxeIplDecodeSectionChunks,
+                         FALSE,
+                         0,
+                         &Queue
+                         );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "Decoding the chunked section on the APs failed - %r\n", Status));
+  }
+
+  //
+  // Decode on the BSP whatever the APs did not take.
+  //
+  DxeIplDecodeSectionChunks (&Queue);
+
+  *AuthenticationStatus = 0;
+  Status                = EFI_SUCCESS;
+  for (Index = 0; Index < Header->ChunkCount; Index++) {
+    if (RETURN_ERROR (Chunks[Index].Status)) {
+      DEBUG ((DEBUG_ERROR, "Decoding chunk %d of the chunked section failed - %r\n", Index, Chunks[Index].Status));
+      Status = EFI_UNSUPPORTED;
+      break;
+    }
+
+    *AuthenticationStatus |= Chunks[Index].AuthenticationStatus;
+  }
+
+  if (Scratch != NULL) {
+    FreePages (Scratch, EFI_SIZE_TO_PAGES ((UINTN)MaxScratchSize * Header->ChunkCount));
+  }
+
+Done:
+  FreePool (Chunks);
+  return Status;
+}
@@ -23,10 +23,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Ppi/RecoveryModule.h>
 #include <Ppi/CapsuleOnDisk.h>
 #include <Ppi/VectorHandoffInfo.h>
+#include <Ppi/MpServices.h>
 
 #include <Guid/MemoryTypeInformation.h>
 #include <Guid/MemoryAllocationHob.h>
 #include <Guid/FirmwareFileSystem2.h>
+#include <Guid/ChunkedSection.h>
 
 #include <Library/DebugLib.h>
 #include <Library/PeimEntryPoint.h>
@@ -42,6 +44,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/DebugAgentLib.h>
 #include <Library/PeiServicesTablePointerLib.h>
 #include <Library/PerformanceLib.h>
+#include <Library/SynchronizationLib.h>
 
 #define STACK_SIZE      0x20000
 #define BSP_STORE_SIZE  0x4000
@@ -198,6 +201,30 @@ CustomGuidedSectionExtract (
   OUT       UINT32                                 *AuthenticationStatus
   );
 
+/**
+  Decode a chunked GUIDed section into a caller allocated output buffer,
+  spreading the chunks over the APs.
+
+  @param  InputSection          The chunked GUIDed section.
+  @param  OutputBuffer          The buffer that receives the decoded data. It
+                                is large enough for the size returned by the
+                                GetInfo handler of the section.
+  @param  AuthenticationStatus  Returns the authentication status of the
+                                decoded data.
+
+  @retval EFI_SUCCESS           The section was decoded.
+  @retval EFI_UNSUPPORTED       The section is not a chunked section, or it
+                                cannot be decoded in parallel. The caller
+                                decodes it on the BSP instead.
+
+**/
+EFI_STATUS
+DxeIplChunkedSectionExtract (
+  IN  CONST VOID  *InputSection,
+  IN  VOID        *OutputBuffer,
+  OUT UINT32      *AuthenticationStatus
+  );
+
 /**
    Decompresses a section to the output buffer.
 
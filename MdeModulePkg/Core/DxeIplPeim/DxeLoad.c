@@ -628,6 +628,15 @@ CustomGuidedSectionExtract (
     }
 
     DEBUG ((DEBUG_INFO, "Customized Guided section Memory Size required is 0x%x and address is 0x%p\n", OutputBufferSize, *OutputBuffer));
+
+    //
+    // The chunks of a chunked section can be decoded on the APs.
+    //
+    Status = DxeIplChunkedSectionExtract (InputSection, *OutputBuffer, AuthenticationStatus);
+    if (!EFI_ERROR (Status)) {
+      *OutputSize = (UINTN)OutputBufferSize;
+      return EFI_SUCCESS;
+    }
   }
 
   Status = ExtractGuidedSectionDecode (
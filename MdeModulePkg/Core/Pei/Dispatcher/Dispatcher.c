@@ -120,6 +120,8 @@ DiscoverPeimsAndOrderWithApriori (
   CoreFileHandle->PeimCount = PeimCount;
   CoreFileHandle->PeimState = AllocateZeroPool (sizeof (UINT8) * PeimCount);
   ASSERT (CoreFileHandle->PeimState != NULL);
+  CoreFileHandle->PeimDepexFalse = AllocateZeroPool (sizeof (UINTN) * PeimCount);
+  ASSERT (CoreFileHandle->PeimDepexFalse != NULL);
   CoreFileHandle->FvFileHandles = AllocateZeroPool (sizeof (EFI_PEI_FILE_HANDLE) * PeimCount);
   ASSERT (CoreFileHandle->FvFileHandles != NULL);
 
@@ -1541,8 +1543,15 @@ PeiDispatcher (
         PeimFileHandle            = Private->CurrentFileHandle = Private->CurrentFvFileHandles[PeimCount];
 
         if (Private->Fv[FvCount].PeimState[PeimCount] == PEIM_STATE_NOT_DISPATCHED) {
-          if (!DepexSatisfied (Private, PeimFileHandle, PeimCount)) {
-            Private->PeimNeedingDispatch = TRUE;
+          //
+          // A DEPEX found FALSE stays FALSE until a PPI is installed, so
+          // don't evaluate it again before that.
+          //
+          if ((Private->Fv[FvCount].PeimDepexFalse[PeimCount] == Private->PpiData.InstallCount + 1) ||
+              !DepexSatisfied (Private, PeimFileHandle, PeimCount))
+          {
+            Private->Fv[FvCount].PeimDepexFalse[PeimCount] = Private->PpiData.InstallCount + 1;
+            Private->PeimNeedingDispatch                   = TRUE;
           } else {
             Status = CoreFvHandle->FvPpi->GetFileInfo (CoreFvHandle->FvPpi, PeimFileHandle, &FvFileInfo);
             ASSERT_EFI_ERROR (Status);
@@ -246,10 +246,12 @@ FileHandleToVolume (
 /**
   Given the input file pointer, search for the first matching file in the
   FFS volume as defined by SearchType. The search starts from FileHeader inside
-  the Firmware Volume defined by FwVolHeader.
+  the Firmware Volume defined by FwVolHeader, and walks the file headers.
   If SearchType is EFI_FV_FILETYPE_ALL, the first FFS file will return without check its file type.
   If SearchType is PEI_CORE_INTERNAL_FFS_FILE_DISPATCH_TYPE,
   the first PEIM, or COMBINED PEIM or FV file type FFS file will return.
+  If SearchType is PEI_CORE_INTERNAL_FFS_FILE_ANY_TYPE,
+  the first FFS file will return, even if it is a pad file.
 
   @param FvHandle        Pointer to the FV header of the volume to search
   @param FileName        File name
@@ -262,8 +264,9 @@ FileHandleToVolume (
   @retval EFI_SUCCESS    Success to search given file
 
 **/
+STATIC
 EFI_STATUS
-FindFileEx (
+FindFileInFv (
   IN  CONST EFI_PEI_FV_HANDLE    FvHandle,
   IN  CONST EFI_GUID             *FileName    OPTIONAL,
   IN        EFI_FV_FILETYPE      SearchType,
@@ -417,6 +420,9 @@ FindFileEx (
               }
             }
           }
+        } else if (SearchType == PEI_CORE_INTERNAL_FFS_FILE_ANY_TYPE) {
+          *FileHeader = FfsFileHeader;
+          return EFI_SUCCESS;
         } else if (((SearchType == FfsFileHeader->Type) || (SearchType == EFI_FV_FILETYPE_ALL)) &&
                    (FfsFileHeader->Type != EFI_FV_FILETYPE_FFS_PAD))
         {
@@ -455,6 +461,241 @@ FindFileEx (
   return EFI_NOT_FOUND;
 }
 
+/**
+  Build the table of the files of a firmware volume in a HOB.
+
+  The table holds the files that FindFileInFv() finds, so searching the table
+  gives the same result as walking the file headers. If the table cannot be
+  built, every search of the firmware volume walks its file headers.
+
+  @param CoreFvHandle    The PEI_CORE_FV_HANDLE of the firmware volume.
+
+**/
+STATIC
+VOID
+BuildFvFileTable (
+  IN PEI_CORE_FV_HANDLE  *CoreFvHandle
+  )
+{
+  EFI_STATUS                  Status;
+  EFI_FIRMWARE_VOLUME_HEADER  *FwVolHeader;
+  EFI_PEI_FILE_HANDLE         FileHandle;
+  EFI_FFS_FILE_HEADER         *FfsFileHeader;
+  EDKII_FV_FILE_TABLE         *FileTable;
+  EDKII_FV_FILE_TABLE_ENTRY   *Entry;
+  UINTN                       FileCount;
+  UINTN                       Size;
+
+  CoreFvHandle->FileTableBuilt = TRUE;
+
+  FwVolHeader = (EFI_FIRMWARE_VOLUME_HEADER *)CoreFvHandle->FvHandle;
+  FileCount   = 0;
+  FileHandle  = NULL;
+  while (TRUE) {
+    Status = FindFileInFv (CoreFvHandle->FvHandle, NULL, PEI_CORE_INTERNAL_FFS_FILE_ANY_TYPE, &FileHandle, NULL);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    FileCount++;
+  }
+
+  //
+  // The table must fit in a single GUID HOB.
+  //
+  Size = sizeof (EDKII_FV_FILE_TABLE) + FileCount * sizeof (EDKII_FV_FILE_TABLE_ENTRY);
+  if (Size > (0xFFF8 - sizeof (EFI_HOB_GUID_TYPE))) {
+    DEBUG ((DEBUG_INFO, "FV 0x%p has too many files (%d) for a file table\n", FwVolHeader, (UINT32)FileCount));
+    return;
+  }
+
+  FileTable = BuildGuidHob (&gEdkiiFvFileTableHobGuid, Size);
+  if (FileTable == NULL) {
+    return;
+  }
+
+  FileTable->FvBase    = (EFI_PHYSICAL_ADDRESS)(UINTN)FwVolHeader;
+  FileTable->FvLength  = FwVolHeader->FvLength;
+  FileTable->FileCount = (UINT32)FileCount;
+  FileTable->Reserved  = 0;
+
+  Entry      = (EDKII_FV_FILE_TABLE_ENTRY *)(FileTable + 1);
+  FileHandle = NULL;
+  while (TRUE) {
+    Status = FindFileInFv (CoreFvHandle->FvHandle, NULL, PEI_CORE_INTERNAL_FFS_FILE_ANY_TYPE, &FileHandle, NULL);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    FfsFileHeader = (EFI_FFS_FILE_HEADER *)FileHandle;
+    CopyGuid (&Entry->Name, &FfsFileHeader->Name);
+    Entry->Offset = (UINT32)((UINT8 *)FfsFileHeader - (UINT8 *)FwVolHeader);
+    Entry->Type   = FfsFileHeader->Type;
+    ZeroMem (Entry->Reserved, sizeof (Entry->Reserved));
+    Entry++;
+  }
+
+  ASSERT (Entry == (EDKII_FV_FILE_TABLE_ENTRY *)(FileTable + 1) + FileCount);
+
+  CoreFvHandle->FileTable = FileTable;
+}
+
+/**
+  Given the input file pointer, search for the first matching file in the
+  file table of a firmware volume. The search follows the same rules as
+  FindFileInFv(), but does not read the file headers of the firmware volume.
+
+  @param FvHandle        Pointer to the FV header of the volume to search
+  @param FileTable       The file table of the volume.
+  @param FileName        File name
+  @param SearchType      Filter to find only files of this type.
+                         Type EFI_FV_FILETYPE_ALL causes no filtering to be done.
+  @param FileHandle      This parameter must point to a valid FFS volume.
+  @param AprioriFile     Pointer to AprioriFile image in this FV if has
+
+  @return EFI_NOT_FOUND  No files matching the search criteria were found
+  @retval EFI_SUCCESS    Success to search given file
+
+**/
+STATIC
+EFI_STATUS
+FindFileInFileTable (
+  IN  CONST EFI_PEI_FV_HANDLE    FvHandle,
+  IN        EDKII_FV_FILE_TABLE  *FileTable,
+  IN  CONST EFI_GUID             *FileName    OPTIONAL,
+  IN        EFI_FV_FILETYPE      SearchType,
+  IN OUT    EFI_PEI_FILE_HANDLE  *FileHandle,
+  IN OUT    EFI_PEI_FILE_HANDLE  *AprioriFile  OPTIONAL
+  )
+{
+  EDKII_FV_FILE_TABLE_ENTRY  *Entry;
+  UINTN                      Index;
+  UINTN                      Low;
+  UINTN                      High;
+  UINTN                      Middle;
+  UINT32                     FileOffset;
+
+  Entry = (EDKII_FV_FILE_TABLE_ENTRY *)(FileTable + 1);
+
+  //
+  // If FileHandle is not specified (NULL) or FileName is not NULL,
+  // start with the first file in the firmware volume.  Otherwise,
+  // start from the file after FileHandle.
+  //
+  if ((*FileHandle == NULL) || (FileName != NULL)) {
+    Index = 0;
+  } else {
+    //
+    // The entries are sorted by offset, so look the file up by binary search.
+    //
+    FileOffset = (UINT32)((UINT8 *)*FileHandle - (UINT8 *)FvHandle);
+    Low        = 0;
+    High       = FileTable->FileCount;
+    while (Low < High) {
+      Middle = (Low + High) / 2;
+      if (Entry[Middle].Offset < FileOffset) {
+        Low = Middle + 1;
+      } else {
+        High = Middle;
+      }
+    }
+
+    if ((Low == FileTable->FileCount) || (Entry[Low].Offset != FileOffset)) {
+      //
+      // FileHandle is not a file of the table, so walk the file headers.
+      //
+      return FindFileInFv (FvHandle, FileName, SearchType, FileHandle, AprioriFile);
+    }
+
+    Index = Low + 1;
+  }
+
+  for ( ; Index < FileTable->FileCount; Index++) {
+    if (FileName != NULL) {
+      if (CompareGuid (&Entry[Index].Name, FileName)) {
+        break;
+      }
+    } else if (SearchType == PEI_CORE_INTERNAL_FFS_FILE_DISPATCH_TYPE) {
+      if ((Entry[Index].Type == EFI_FV_FILETYPE_PEIM) ||
+          (Entry[Index].Type == EFI_FV_FILETYPE_COMBINED_PEIM_DRIVER) ||
+          (Entry[Index].Type == EFI_FV_FILETYPE_FIRMWARE_VOLUME_IMAGE))
+      {
+        break;
+      } else if (AprioriFile != NULL) {
+        if (Entry[Index].Type == EFI_FV_FILETYPE_FREEFORM) {
+          if (CompareGuid (&Entry[Index].Name, &gPeiAprioriFileNameGuid)) {
+            *AprioriFile = (EFI_PEI_FILE_HANDLE)((UINT8 *)FvHandle + Entry[Index].Offset);
+          }
+        }
+      }
+    } else if (SearchType == PEI_CORE_INTERNAL_FFS_FILE_ANY_TYPE) {
+      break;
+    } else if (((SearchType == Entry[Index].Type) || (SearchType == EFI_FV_FILETYPE_ALL)) &&
+               (Entry[Index].Type != EFI_FV_FILETYPE_FFS_PAD))
+    {
+      break;
+    }
+  }
+
+  if (Index == FileTable->FileCount) {
+    *FileHandle = NULL;
+    return EFI_NOT_FOUND;
+  }
+
+  *FileHandle = (EFI_PEI_FILE_HANDLE)((UINT8 *)FvHandle + Entry[Index].Offset);
+  return EFI_SUCCESS;
+}
+
+/**
+  Given the input file pointer, search for the first matching file in the
+  FFS volume as defined by SearchType. The search starts from FileHeader inside
+  the Firmware Volume defined by FwVolHeader.
+  If SearchType is EFI_FV_FILETYPE_ALL, the first FFS file will return without check its file type.
+  If SearchType is PEI_CORE_INTERNAL_FFS_FILE_DISPATCH_TYPE,
+  the first PEIM, or COMBINED PEIM or FV file type FFS file will return.
+
+  If PcdPeiFvFileTable is TRUE, the first search of a firmware volume known to
+  the PEI Core builds a table of its files, and the later searches use the
+  table instead of walking the file headers.
+
+  @param FvHandle        Pointer to the FV header of the volume to search
+  @param FileName        File name
+  @param SearchType      Filter to find only files of this type.
+                         Type EFI_FV_FILETYPE_ALL causes no filtering to be done.
+  @param FileHandle      This parameter must point to a valid FFS volume.
+  @param AprioriFile     Pointer to AprioriFile image in this FV if has
+
+  @return EFI_NOT_FOUND  No files matching the search criteria were found
+  @retval EFI_SUCCESS    Success to search given file
+
+**/
+EFI_STATUS
+FindFileEx (
+  IN  CONST EFI_PEI_FV_HANDLE    FvHandle,
+  IN  CONST EFI_GUID             *FileName    OPTIONAL,
+  IN        EFI_FV_FILETYPE      SearchType,
+  IN OUT    EFI_PEI_FILE_HANDLE  *FileHandle,
+  IN OUT    EFI_PEI_FILE_HANDLE  *AprioriFile  OPTIONAL
+  )
+{
+  PEI_CORE_FV_HANDLE  *CoreFvHandle;
+
+  if (FeaturePcdGet (PcdPeiFvFileTable)) {
+    CoreFvHandle = FvHandleToCoreHandle (FvHandle);
+    if (CoreFvHandle != NULL) {
+      if (!CoreFvHandle->FileTableBuilt) {
+        BuildFvFileTable (CoreFvHandle);
+      }
+
+      if (CoreFvHandle->FileTable != NULL) {
+        return FindFileInFileTable (FvHandle, CoreFvHandle->FileTable, FileName, SearchType, FileHandle, AprioriFile);
+      }
+    }
+  }
+
+  return FindFileInFv (FvHandle, FileName, SearchType, FileHandle, AprioriFile);
+}
+
 /**
   Initialize PeiCore FV List.
 
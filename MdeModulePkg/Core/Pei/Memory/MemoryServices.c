@@ -167,8 +167,8 @@ MigrateMemoryPages (
 }
 
 /**
-  Migrate the base address in firmware volume allocation HOBs
-  from temporary memory to PEI installed memory.
+  Migrate the base address in firmware volume allocation HOBs and
+  firmware volume file table HOBs from temporary memory to PEI installed memory.
 
   @param[in] PrivateData      Pointer to PeiCore's private data structure.
   @param[in] OrgFvHandle      Address of FV Handle in temporary memory.
@@ -186,6 +186,7 @@ ConvertFvHob (
   EFI_HOB_FIRMWARE_VOLUME   *FirmwareVolumeHob;
   EFI_HOB_FIRMWARE_VOLUME2  *FirmwareVolume2Hob;
   EFI_HOB_FIRMWARE_VOLUME3  *FirmwareVolume3Hob;
+  EDKII_FV_FILE_TABLE       *FileTable;
 
   DEBUG ((DEBUG_INFO, "Converting FVs in FV HOB.\n"));
 
@@ -205,6 +206,13 @@ ConvertFvHob (
       if (FirmwareVolume3Hob->BaseAddress == OrgFvHandle) {
         FirmwareVolume3Hob->BaseAddress = FvHandle;
       }
+    } else if ((GET_HOB_TYPE (Hob) == EFI_HOB_TYPE_GUID_EXTENSION) &&
+               CompareGuid (&Hob.Guid->Name, &gEdkiiFvFileTableHobGuid))
+    {
+      FileTable = GET_GUID_HOB_DATA (Hob);
+      if (FileTable->FvBase == OrgFvHandle) {
+        FileTable->FvBase = FvHandle;
+      }
     }
   }
 }
@@ -46,6 +46,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Guid/FirmwareFileSystem3.h>
 #include <Guid/AprioriFileName.h>
 #include <Guid/MigratedFvInfo.h>
+#include <Guid/FvFileTable.h>
 
 ///
 /// It is an FFS type extension used for PeiFindFileEx. It indicates current
@@ -53,6 +54,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 ///
 #define PEI_CORE_INTERNAL_FFS_FILE_DISPATCH_TYPE  0xff
 
+///
+/// It is an FFS type extension used for PeiFindFileEx. It indicates current
+/// FFS searching is for any file, including pad files.
+///
+#define PEI_CORE_INTERNAL_FFS_FILE_ANY_TYPE  0xfe
+
 ///
 /// Pei Core private data structures
 ///
@@ -115,6 +122,11 @@ typedef struct {
   /// Notify List at callback level.
   ///
   PEI_DISPATCH_NOTIFY_LIST    DispatchNotifyList;
+  ///
+  /// Number of times a PPI was installed or reinstalled. A PEIM DEPEX can
+  /// only change its result when this changes.
+  ///
+  UINTN                       InstallCount;
 } PEI_PPI_DATABASE;
 
 //
@@ -142,11 +154,23 @@ typedef struct {
   //
   UINT8                          *PeimState;
   //
+  // Pointer to the buffer with the PeimCount number of Entries. An entry is
+  // PpiData.InstallCount + 1 as of the last time the DEPEX of the PEIM was
+  // found FALSE, or 0.
+  //
+  UINTN                          *PeimDepexFalse;
+  //
   // Pointer to the buffer with the PeimCount number of Entries.
   //
   EFI_PEI_FILE_HANDLE            *FvFileHandles;
   BOOLEAN                        ScanFv;
   UINT32                         AuthenticationStatus;
+  //
+  // Pointer to the table of the files of the FV in the HOB list, or NULL if
+  // there is none. FileTableBuilt is TRUE once building it has been tried.
+  //
+  EDKII_FV_FILE_TABLE            *FileTable;
+  BOOLEAN                        FileTableBuilt;
 } PEI_CORE_FV_HANDLE;
 
 typedef struct {
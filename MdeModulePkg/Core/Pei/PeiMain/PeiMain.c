@@ -238,9 +238,17 @@ PeiCore (
             OldCoreData->Fv[Index].PeimState = (UINT8 *)OldCoreData->Fv[Index].PeimState + OldCoreData->HeapOffset;
           }
 
+          if (OldCoreData->Fv[Index].PeimDepexFalse != NULL) {
+            OldCoreData->Fv[Index].PeimDepexFalse = (UINTN *)((UINT8 *)OldCoreData->Fv[Index].PeimDepexFalse + OldCoreData->HeapOffset);
+          }
+
           if (OldCoreData->Fv[Index].FvFileHandles != NULL) {
             OldCoreData->Fv[Index].FvFileHandles = (EFI_PEI_FILE_HANDLE *)((UINT8 *)OldCoreData->Fv[Index].FvFileHandles + OldCoreData->HeapOffset);
           }
+
+          if (OldCoreData->Fv[Index].FileTable != NULL) {
+            OldCoreData->Fv[Index].FileTable = (EDKII_FV_FILE_TABLE *)((UINT8 *)OldCoreData->Fv[Index].FileTable + OldCoreData->HeapOffset);
+          }
         }
 
         OldCoreData->TempFileGuid    = (EFI_GUID *)((UINT8 *)OldCoreData->TempFileGuid + OldCoreData->HeapOffset);
@@ -273,9 +281,17 @@ PeiCore (
             OldCoreData->Fv[Index].PeimState = (UINT8 *)OldCoreData->Fv[Index].PeimState - OldCoreData->HeapOffset;
           }
 
+          if (OldCoreData->Fv[Index].PeimDepexFalse != NULL) {
+            OldCoreData->Fv[Index].PeimDepexFalse = (UINTN *)((UINT8 *)OldCoreData->Fv[Index].PeimDepexFalse - OldCoreData->HeapOffset);
+          }
+
           if (OldCoreData->Fv[Index].FvFileHandles != NULL) {
             OldCoreData->Fv[Index].FvFileHandles = (EFI_PEI_FILE_HANDLE *)((UINT8 *)OldCoreData->Fv[Index].FvFileHandles - OldCoreData->HeapOffset);
           }
+
+          if (OldCoreData->Fv[Index].FileTable != NULL) {
+            OldCoreData->Fv[Index].FileTable = (EDKII_FV_FILE_TABLE *)((UINT8 *)OldCoreData->Fv[Index].FileTable - OldCoreData->HeapOffset);
+          }
         }
 
         OldCoreData->TempFileGuid    = (EFI_GUID *)((UINT8 *)OldCoreData->TempFileGuid - OldCoreData->HeapOffset);
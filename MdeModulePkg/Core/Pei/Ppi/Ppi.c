@@ -528,6 +528,8 @@ InternalPeiInstallPpi (
     PpiList++;
   }
 
+  PrivateData->PpiData.InstallCount++;
+
   //
   // Process any callback level notifies for newly installed PPIs.
   //
@@ -625,6 +627,7 @@ PeiReInstallPpi (
   //
   DEBUG ((DEBUG_INFO, "Reinstall PPI: %g\n", NewPpi->Guid));
   PrivateData->PpiData.PpiList.PpiPtrs[Index].Ppi = (EFI_PEI_PPI_DESCRIPTOR *)NewPpi;
+  PrivateData->PpiData.InstallCount++;
 
   //
   // Process any callback level notifies for the newly installed PPI.
@@ -243,6 +243,22 @@ IsPoolTypeToGuard (
   IN EFI_MEMORY_TYPE  MemoryType
   );
 
+/**
+  Check to see if a pool allocation of a type to guard should get Guard pages.
+
+  If PcdHeapGuardPoolSampleRate is N above 1, one in N of these allocations is
+  picked at random on average, and only while fewer than
+  PcdHeapGuardPoolSampleSlots guarded pools are not freed yet. Every one of
+  them is guarded otherwise.
+
+  @return TRUE  The pool allocation should be guarded.
+  @return FALSE The pool allocation should not be guarded.
+**/
+BOOLEAN
+IsPoolSampledToGuard (
+  VOID
+  );
+
 /**
   Check to see if the page at the given address should be guarded or not.
 
@@ -388,5 +404,6 @@ VerifyMemoryGuard (
   );
 
 extern BOOLEAN  mOnGuarding;
+extern UINTN    mPoolGuardSampledCount;
 
 #endif
@@ -87,6 +87,7 @@ SMM_CORE_SMI_HANDLERS  mSmmCoreSmiHandlers[] = {
   { SmmExitBootServicesHandler, &gEfiEventExitBootServicesGuid,     NULL, FALSE },
   { SmmReadyToBootHandler,      &gEfiEventReadyToBootGuid,          NULL, FALSE },
   { SmmEndOfDxeHandler,         &gEfiEndOfDxeEventGroupGuid,        NULL, TRUE  },
+  { SmmCommunicateBatchHandler, &gEdkiiMmCommunicateBatchGuid,      NULL, FALSE },
   { NULL,                       NULL,                               NULL, FALSE }
 };
 
@@ -610,6 +611,87 @@ SmmEndOfS3ResumeHandler (
   return Status;
 }
 
+/**
+  Software SMI handler that is called for a batch of communicate requests.
+  This function hands each request of the batch to the SMI handlers of its
+  GUID, in order.
+
+  @param  DispatchHandle  The unique handle assigned to this handler by SmiHandlerRegister().
+  @param  Context         Points to an optional handler context which was specified when the handler was registered.
+  @param  CommBuffer      A pointer to a collection of data in memory that will
+                          be conveyed from a non-SMM environment into an SMM environment.
+  @param  CommBufferSize  The size of the CommBuffer.
+
+  @return Status Code
+
+**/
+EFI_STATUS
+EFIAPI
+SmmCommunicateBatchHandler (
+  IN     EFI_HANDLE  DispatchHandle,
+  IN     CONST VOID  *Context         OPTIONAL,
+  IN OUT VOID        *CommBuffer      OPTIONAL,
+  IN OUT UINTN       *CommBufferSize  OPTIONAL
+  )
+{
+  EFI_STATUS                        Status;
+  EDKII_MM_COMMUNICATE_BATCH_ENTRY  *Entry;
+  UINT32                            NumberOfEntries;
+  UINT32                            Index;
+  UINTN                             BufferSize;
+  UINTN                             Offset;
+  UINT64                            EntryLength;
+  UINT64                            MessageLength;
+  UINTN                             DataSize;
+  EFI_GUID                          HeaderGuid;
+
+  if ((CommBuffer == NULL) || (CommBufferSize == NULL)) {
+    return EFI_SUCCESS;
+  }
+
+  //
+  // The communication buffer is outside SMRAM and may change under us, so
+  // each field is read once.
+  //
+  BufferSize = *CommBufferSize;
+  if (BufferSize < sizeof (EDKII_MM_COMMUNICATE_BATCH_HEADER)) {
+    return EFI_SUCCESS;
+  }
+
+  NumberOfEntries = ((EDKII_MM_COMMUNICATE_BATCH_HEADER *)CommBuffer)->NumberOfEntries;
+  Offset          = sizeof (EDKII_MM_COMMUNICATE_BATCH_HEADER);
+  for (Index = 0; Index < NumberOfEntries; Index++) {
+    if (BufferSize - Offset < sizeof (EDKII_MM_COMMUNICATE_BATCH_ENTRY)) {
+      break;
+    }
+
+    Entry         = (EDKII_MM_COMMUNICATE_BATCH_ENTRY *)((UINT8 *)CommBuffer + Offset);
+    EntryLength   = Entry->EntryLength;
+    MessageLength = Entry->MessageLength;
+    CopyGuid (&HeaderGuid, &Entry->HeaderGuid);
+    if ((EntryLength < sizeof (EDKII_MM_COMMUNICATE_BATCH_ENTRY)) ||
+        (EntryLength > BufferSize - Offset) ||
+        (MessageLength > EntryLength - sizeof (EDKII_MM_COMMUNICATE_BATCH_ENTRY)) ||
+        CompareGuid (&HeaderGuid, &gEdkiiMmCommunicateBatchGuid))
+    {
+      DEBUG ((DEBUG_ERROR, "SmmCommunicateBatchHandler: Entry %d is malformed\n", Index));
+      Entry->ReturnStatus = (UINT64)EFI_INVALID_PARAMETER;
+      break;
+    }
+
+    DataSize = (UINTN)MessageLength;
+    Status   = SmiManage (&HeaderGuid, NULL, Entry + 1, &DataSize);
+    if (DataSize <= MessageLength) {
+      Entry->MessageLength = DataSize;
+    }
+
+    Entry->ReturnStatus = (Status == EFI_SUCCESS) ? EFI_SUCCESS : (UINT64)EFI_NOT_FOUND;
+    Offset             += (UINTN)EntryLength;
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Determine if two buffers overlap in memory.
 
@@ -677,8 +759,10 @@ SmmEntryPoint (
   BOOLEAN                     IsOverUnderflow;
   VOID                        *CommunicationBuffer;
   UINTN                       BufferSize;
+  UINT64                      LatencyBegin;
 
   PERF_FUNCTION_BEGIN ();
+  LatencyBegin = SmiLatencyBegin ();
 
   //
   // Update SMST with contents of the SmmEntryContext structure
@@ -785,6 +869,7 @@ SmmEntryPoint (
     gSmmCorePrivate->InSmm = FALSE;
   }
 
+  SmiLatencyEnd (mSmiLatencyTotalRecord, LatencyBegin);
   PERF_FUNCTION_END ();
 }
 
@@ -922,6 +1007,11 @@ SmmMain (
   ASSERT (mFullSmramRanges != NULL);
   CopyMem (mFullSmramRanges, gSmmCorePrivate->SmramRanges, mFullSmramRangeCount * sizeof (EFI_SMRAM_DESCRIPTOR));
 
+  //
+  // Set up SMI latency accounting before any SMI entry is created.
+  //
+  SmmCoreInitializeSmiLatency ();
+
   //
   // Register all SMI Handlers required by the SMM Core
   //
@@ -958,5 +1048,7 @@ SmmMain (
 
   SmmCoreInitializeSmiHandlerProfile ();
 
+  SmmCoreInstallSmiHandlerAttribute ();
+
   return EFI_SUCCESS;
 }
@@ -28,6 +28,7 @@
 #include <Protocol/SmmReadyToBoot.h>
 #include <Protocol/SmmMemoryAttribute.h>
 #include <Protocol/SmmSxDispatch2.h>
+#include <Protocol/SmiHandlerAttribute.h>
 
 #include <Guid/Apriori.h>
 #include <Guid/EventGroup.h>
@@ -37,6 +38,9 @@
 #include <Guid/SmiHandlerProfile.h>
 #include <Guid/EndOfS3Resume.h>
 #include <Guid/S3SmmInitDone.h>
+#include <Guid/MmCommunicateBatch.h>
+#include <Guid/SmiLatency.h>
+#include <Guid/ZeroGuid.h>
 
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
@@ -76,11 +80,13 @@ typedef struct {
 #define SMI_ENTRY_SIGNATURE  SIGNATURE_32('s','m','i','e')
 
 typedef struct {
-  UINTN         Signature;
-  LIST_ENTRY    AllEntries; // All entries
+  UINTN                 Signature;
+  LIST_ENTRY            AllEntries;    // All entries
 
-  EFI_GUID      HandlerType; // Type of interrupt
-  LIST_ENTRY    SmiHandlers; // All handlers
+  EFI_GUID              HandlerType;   // Type of interrupt
+  LIST_ENTRY            SmiHandlers;   // All handlers
+  LIST_ENTRY            HashLink;      // Link on the SMI entry hash list of HandlerType
+  SMI_LATENCY_RECORD    *LatencyRecord; // SMI latency record of HandlerType, or NULL
 } SMI_ENTRY;
 
 #define SMI_HANDLER_SIGNATURE  SIGNATURE_32('s','m','i','h')
@@ -94,6 +100,7 @@ typedef struct {
   VOID                            *Context;    // for profile
   UINTN                           ContextSize; // for profile
   BOOLEAN                         ToRemove;    // To remove this SMI_HANDLER later
+  UINT64                          Attributes;  // EDKII_SMI_HANDLER_ATTRIBUTE_*
 } SMI_HANDLER;
 
 //
@@ -674,6 +681,87 @@ SmiHandlerUnRegister (
   IN  EFI_HANDLE  DispatchHandle
   );
 
+/**
+  Set the attributes of an SMI handler.
+
+  @param[in]  This            The EDKII_SMI_HANDLER_ATTRIBUTE_PROTOCOL instance.
+  @param[in]  DispatchHandle  The handle returned by SmiHandlerRegister().
+  @param[in]  Attributes      The EDKII_SMI_HANDLER_ATTRIBUTE_* bit mask.
+
+  @retval EFI_SUCCESS            The attributes were set.
+  @retval EFI_INVALID_PARAMETER  DispatchHandle does not refer to a valid
+                                 handler, or refers to a root SMI handler.
+  @retval EFI_UNSUPPORTED        Attributes has an unknown bit set.
+
+**/
+EFI_STATUS
+EFIAPI
+SmiHandlerSetAttributes (
+  IN EDKII_SMI_HANDLER_ATTRIBUTE_PROTOCOL  *This,
+  IN EFI_HANDLE                            DispatchHandle,
+  IN UINT64                                Attributes
+  );
+
+/**
+  Install the SMI Handler Attribute Protocol.
+
+**/
+VOID
+SmmCoreInstallSmiHandlerAttribute (
+  VOID
+  );
+
+/**
+  Initialize SMI latency accounting.
+**/
+VOID
+SmmCoreInitializeSmiLatency (
+  VOID
+  );
+
+/**
+  Returns the SMI latency record of a handler type, and creates it if it
+  does not exist yet.
+
+  @param  HandlerType  The handler type, or NULL for the root SMI handlers.
+
+  @return The SMI latency record, or NULL if SMI latency accounting is disabled
+          or there is no record left.
+
+**/
+SMI_LATENCY_RECORD *
+SmiLatencyGetRecord (
+  IN CONST EFI_GUID  *HandlerType  OPTIONAL
+  );
+
+/**
+  Returns the time stamp at which the accounting of an SMI, or of the SMI
+  handlers of a handler type, starts.
+
+  @return The time stamp, or 0 if SMI latency accounting is disabled.
+
+**/
+UINT64
+SmiLatencyBegin (
+  VOID
+  );
+
+/**
+  Accounts the time since a time stamp into an SMI latency record.
+
+  @param  Record  The SMI latency record, or NULL.
+  @param  Begin   The time stamp returned by SmiLatencyBegin().
+
+**/
+VOID
+SmiLatencyEnd (
+  IN SMI_LATENCY_RECORD  *Record  OPTIONAL,
+  IN UINT64              Begin
+  );
+
+extern SMI_ENTRY           mRootSmiEntry;
+extern SMI_LATENCY_RECORD  *mSmiLatencyTotalRecord;
+
 /**
   This function is the main entry point for an SMM handler dispatch
   or communicate-based callback.
@@ -852,6 +940,29 @@ SmmEndOfS3ResumeHandler (
   IN OUT UINTN       *CommBufferSize  OPTIONAL
   );
 
+/**
+  Software SMI handler that is called for a batch of communicate requests.
+  This function hands each request of the batch to the SMI handlers of its
+  GUID, in order.
+
+  @param  DispatchHandle  The unique handle assigned to this handler by SmiHandlerRegister().
+  @param  Context         Points to an optional handler context which was specified when the handler was registered.
+  @param  CommBuffer      A pointer to a collection of data in memory that will
+                          be conveyed from a non-SMM environment into an SMM environment.
+  @param  CommBufferSize  The size of the CommBuffer.
+
+  @return Status Code
+
+**/
+EFI_STATUS
+EFIAPI
+SmmCommunicateBatchHandler (
+  IN     EFI_HANDLE  DispatchHandle,
+  IN     CONST VOID  *Context         OPTIONAL,
+  IN OUT VOID        *CommBuffer      OPTIONAL,
+  IN OUT UINTN       *CommBufferSize  OPTIONAL
+  );
+
 /**
   Place holder function until all the SMM System Table Service are available.
 
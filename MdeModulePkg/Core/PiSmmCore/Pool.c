@@ -256,7 +256,7 @@ SmmInternalAllocatePool (
     return EFI_INVALID_PARAMETER;
   }
 
-  NeedGuard   = IsPoolTypeToGuard (PoolType);
+  NeedGuard   = IsPoolTypeToGuard (PoolType) && IsPoolSampledToGuard ();
   HasPoolTail = !(NeedGuard &&
                   ((PcdGet8 (PcdHeapGuardPropertyMask) & BIT7) == 0));
 
@@ -288,6 +288,7 @@ SmmInternalAllocatePool (
                                                NoPages,
                                                Size
                                                );
+      mPoolGuardSampledCount++;
     }
 
     PoolHdr            = (POOL_HEADER *)(UINTN)Address;
@@ -410,6 +411,7 @@ SmmInternalFreePool (
   }
 
   if (MemoryGuarded) {
+    mPoolGuardSampledCount--;
     Buffer = AdjustPoolHeadF ((EFI_PHYSICAL_ADDRESS)(UINTN)FreePoolHdr);
     return SmmInternalFreePages (
              (EFI_PHYSICAL_ADDRESS)(UINTN)Buffer,
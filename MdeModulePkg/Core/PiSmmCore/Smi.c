@@ -15,13 +15,66 @@ UINTN  mSmiManageCallingDepth = 0;
 
 LIST_ENTRY  mSmiEntryList = INITIALIZE_LIST_HEAD_VARIABLE (mSmiEntryList);
 
+//
+// The SMI entries are also linked on one of SMI_ENTRY_HASH_SIZE lists, picked
+// by the first 32 bits of their GUID, so that finding the entry of an SMI
+// does not walk all of them.
+//
+#define SMI_ENTRY_HASH_SIZE  64
+
+LIST_ENTRY  mSmiEntryHash[SMI_ENTRY_HASH_SIZE];
+BOOLEAN     mSmiEntryHashInitialized = FALSE;
+
+//
+// mSmiHandlerToRemove is set when SmiHandlerUnRegister() defers the removal of
+// a handler to SmiManage().
+//
+BOOLEAN  mSmiHandlerToRemove = FALSE;
+
 SMI_ENTRY  mRootSmiEntry = {
   SMI_ENTRY_SIGNATURE,
   INITIALIZE_LIST_HEAD_VARIABLE (mRootSmiEntry.AllEntries),
   { 0 },
   INITIALIZE_LIST_HEAD_VARIABLE (mRootSmiEntry.SmiHandlers),
+  INITIALIZE_LIST_HEAD_VARIABLE (mRootSmiEntry.HashLink),
+  NULL
+};
+
+EDKII_SMI_HANDLER_ATTRIBUTE_PROTOCOL  mSmiHandlerAttribute = {
+  SmiHandlerSetAttributes
 };
 
+//
+// Produced by the SMM CPU driver, located on the first BSP only SMI.
+//
+EDKII_SMM_CPU_AP_RELEASE_PROTOCOL  *mSmmCpuApRelease = NULL;
+
+/**
+  Returns the SMI entry hash list of a handler type.
+
+  @param  HandlerType            The type of the interrupt
+
+  @return The SMI entry hash list.
+
+**/
+LIST_ENTRY *
+SmmCoreGetSmiEntryHashList (
+  IN EFI_GUID  *HandlerType
+  )
+{
+  UINTN  Index;
+
+  if (!mSmiEntryHashInitialized) {
+    for (Index = 0; Index < SMI_ENTRY_HASH_SIZE; Index++) {
+      InitializeListHead (&mSmiEntryHash[Index]);
+    }
+
+    mSmiEntryHashInitialized = TRUE;
+  }
+
+  return &mSmiEntryHash[ReadUnaligned32 ((UINT32 *)HandlerType) % SMI_ENTRY_HASH_SIZE];
+}
+
 /**
   Finds the SMI entry for the requested handler type.
 
@@ -39,18 +92,20 @@ SmmCoreFindSmiEntry (
   )
 {
   LIST_ENTRY  *Link;
+  LIST_ENTRY  *HashList;
   SMI_ENTRY   *Item;
   SMI_ENTRY   *SmiEntry;
 
   //
-  // Search the SMI entry list for the matching GUID
+  // Search the SMI entry hash list for the matching GUID
   //
   SmiEntry = NULL;
-  for (Link = mSmiEntryList.ForwardLink;
-       Link != &mSmiEntryList;
+  HashList = SmmCoreGetSmiEntryHashList (HandlerType);
+  for (Link = HashList->ForwardLink;
+       Link != HashList;
        Link = Link->ForwardLink)
   {
-    Item = CR (Link, SMI_ENTRY, AllEntries, SMI_ENTRY_SIGNATURE);
+    Item = CR (Link, SMI_ENTRY, HashLink, SMI_ENTRY_SIGNATURE);
     if (CompareGuid (&Item->HandlerType, HandlerType)) {
       //
       // This is the SMI entry
@@ -73,11 +128,13 @@ SmmCoreFindSmiEntry (
       SmiEntry->Signature = SMI_ENTRY_SIGNATURE;
       CopyGuid ((VOID *)&SmiEntry->HandlerType, HandlerType);
       InitializeListHead (&SmiEntry->SmiHandlers);
+      SmiEntry->LatencyRecord = SmiLatencyGetRecord (HandlerType);
 
       //
-      // Add it to SMI entry list
+      // Add it to SMI entry list and hash list
       //
       InsertTailList (&mSmiEntryList, &SmiEntry->AllEntries);
+      InsertTailList (HashList, &SmiEntry->HashLink);
     }
   }
 
@@ -110,6 +167,7 @@ RemoveSmiHandler (
   if (SmiEntry != NULL) {
     if (IsListEmpty (&SmiEntry->SmiHandlers)) {
       RemoveEntryList (&SmiEntry->AllEntries);
+      RemoveEntryList (&SmiEntry->HashLink);
       FreePool (SmiEntry);
       return TRUE;
     }
@@ -118,6 +176,34 @@ RemoveSmiHandler (
   return FALSE;
 }
 
+/**
+  Let the APs leave SMM before a handler that needs only the BSP runs.
+
+  The APs stay in SMM if the SMM CPU driver does not support it.
+
+**/
+VOID
+SmiReleaseAps (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+
+  if (mSmmCpuApRelease == NULL) {
+    Status = SmmLocateProtocol (
+               &gEdkiiSmmCpuApReleaseProtocolGuid,
+               NULL,
+               (VOID **)&mSmmCpuApRelease
+               );
+    if (EFI_ERROR (Status)) {
+      mSmmCpuApRelease = NULL;
+      return;
+    }
+  }
+
+  mSmmCpuApRelease->ReleaseAps (mSmmCpuApRelease);
+}
+
 /**
   Manage SMI of a particular type.
 
@@ -149,6 +235,7 @@ SmiManage (
   EFI_STATUS   ReturnStatus;
   BOOLEAN      WillReturn;
   EFI_STATUS   Status;
+  UINT64       LatencyBegin;
 
   PERF_FUNCTION_BEGIN ();
   mSmiManageCallingDepth++;
@@ -174,11 +261,16 @@ SmiManage (
     }
   }
 
-  Head = &SmiEntry->SmiHandlers;
+  Head         = &SmiEntry->SmiHandlers;
+  LatencyBegin = SmiLatencyBegin ();
 
   for (Link = Head->ForwardLink; Link != Head; Link = Link->ForwardLink) {
     SmiHandler = CR (Link, SMI_HANDLER, Link, SMI_HANDLER_SIGNATURE);
 
+    if ((SmiHandler->Attributes & EDKII_SMI_HANDLER_ATTRIBUTE_BSP_ONLY) != 0) {
+      SmiReleaseAps ();
+    }
+
     Status = SmiHandler->Handler (
                            (EFI_HANDLE)SmiHandler,
                            Context,
@@ -254,6 +346,8 @@ SmiManage (
     }
   }
 
+  SmiLatencyEnd (SmiEntry->LatencyRecord, LatencyBegin);
+
   ASSERT (mSmiManageCallingDepth > 0);
   mSmiManageCallingDepth--;
 
@@ -263,7 +357,9 @@ SmiManage (
   // marked as ToRemove.
   // Note that SmiManage can be called recursively.
   //
-  if (mSmiManageCallingDepth == 0) {
+  if ((mSmiManageCallingDepth == 0) && mSmiHandlerToRemove) {
+    mSmiHandlerToRemove = FALSE;
+
     //
     // Go through all SmiHandler in root SMI handlers
     //
@@ -447,6 +543,7 @@ SmiHandlerUnRegister (
     // Do not delete or remove SmiHandler or SmiEntry now.
     // SmiManage will handle it later
     //
+    mSmiHandlerToRemove = TRUE;
     return EFI_SUCCESS;
   }
 
@@ -458,3 +555,80 @@ SmiHandlerUnRegister (
   RemoveSmiHandler (SmiHandler, (SmiEntry == &mRootSmiEntry) ? NULL : SmiEntry);
   return EFI_SUCCESS;
 }
+
+/**
+  Set the attributes of an SMI handler.
+
+  @param[in]  This            The EDKII_SMI_HANDLER_ATTRIBUTE_PROTOCOL instance.
+  @param[in]  DispatchHandle  The handle returned by SmiHandlerRegister().
+  @param[in]  Attributes      The EDKII_SMI_HANDLER_ATTRIBUTE_* bit mask.
+
+  @retval EFI_SUCCESS            The attributes were set.
+  @retval EFI_INVALID_PARAMETER  DispatchHandle does not refer to a valid
+                                 handler, or refers to a root SMI handler.
+  @retval EFI_UNSUPPORTED        Attributes has an unknown bit set.
+
+**/
+EFI_STATUS
+EFIAPI
+SmiHandlerSetAttributes (
+  IN EDKII_SMI_HANDLER_ATTRIBUTE_PROTOCOL  *This,
+  IN EFI_HANDLE                            DispatchHandle,
+  IN UINT64                                Attributes
+  )
+{
+  SMI_HANDLER  *SmiHandler;
+  SMI_ENTRY    *SmiEntry;
+  LIST_ENTRY   *EntryLink;
+  LIST_ENTRY   *HandlerLink;
+
+  if ((Attributes & ~(UINT64)EDKII_SMI_HANDLER_ATTRIBUTE_BSP_ONLY) != 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Only look for it in non-root SMI handlers
+  //
+  for ( EntryLink = GetFirstNode (&mSmiEntryList)
+        ; !IsNull (&mSmiEntryList, EntryLink)
+        ; EntryLink = GetNextNode (&mSmiEntryList, EntryLink)
+        )
+  {
+    SmiEntry = CR (EntryLink, SMI_ENTRY, AllEntries, SMI_ENTRY_SIGNATURE);
+    for ( HandlerLink = GetFirstNode (&SmiEntry->SmiHandlers)
+          ; !IsNull (&SmiEntry->SmiHandlers, HandlerLink)
+          ; HandlerLink = GetNextNode (&SmiEntry->SmiHandlers, HandlerLink)
+          )
+    {
+      SmiHandler = CR (HandlerLink, SMI_HANDLER, Link, SMI_HANDLER_SIGNATURE);
+      if ((EFI_HANDLE)SmiHandler == DispatchHandle) {
+        SmiHandler->Attributes = Attributes;
+        return EFI_SUCCESS;
+      }
+    }
+  }
+
+  return EFI_INVALID_PARAMETER;
+}
+
+/**
+  Install the SMI Handler Attribute Protocol.
+
+**/
+VOID
+SmmCoreInstallSmiHandlerAttribute (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  EFI_HANDLE  Handle;
+
+  Handle = NULL;
+  Status = SmmInstallProtocolInterface (
+             &Handle,
+             &gEdkiiSmiHandlerAttributeProtocolGuid,
+             EFI_NATIVE_INTERFACE,
+             &mSmiHandlerAttribute
+             );
+  ASSERT_EFI_ERROR (Status);
+}
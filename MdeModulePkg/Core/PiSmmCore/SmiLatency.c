@@ -0,0 +1,264 @@
+/** @file
+  SMI latency accounting.
+
+  The records are allocated when the SMM Core starts, so that accounting an
+  SMI neither allocates memory nor searches for its record: each SMI entry
+  keeps a pointer to the record of its handler type.
+
+Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "PiSmmCore.h"
+
+#define SMI_LATENCY_MAX_RECORDS  128
+
+SMI_LATENCY_RECORD  *mSmiLatencyRecords     = NULL;
+UINTN               mSmiLatencyRecordCount  = 0;
+SMI_LATENCY_RECORD  *mSmiLatencyTotalRecord = NULL;
+
+/**
+  Returns the SMI latency record of a handler type, and creates it if it
+  does not exist yet.
+
+  @param  HandlerType  The handler type, or NULL for the root SMI handlers.
+
+  @return The SMI latency record, or NULL if SMI latency accounting is disabled
+          or there is no record left.
+
+**/
+SMI_LATENCY_RECORD *
+SmiLatencyGetRecord (
+  IN CONST EFI_GUID  *HandlerType  OPTIONAL
+  )
+{
+  UINTN  Index;
+
+  if (mSmiLatencyRecords == NULL) {
+    return NULL;
+  }
+
+  if (HandlerType == NULL) {
+    HandlerType = &gZeroGuid;
+  }
+
+  for (Index = 0; Index < mSmiLatencyRecordCount; Index++) {
+    if (CompareGuid (&mSmiLatencyRecords[Index].HandlerType, HandlerType)) {
+      return &mSmiLatencyRecords[Index];
+    }
+  }
+
+  if (mSmiLatencyRecordCount == SMI_LATENCY_MAX_RECORDS) {
+    return NULL;
+  }
+
+  CopyGuid (&mSmiLatencyRecords[mSmiLatencyRecordCount].HandlerType, HandlerType);
+  return &mSmiLatencyRecords[mSmiLatencyRecordCount++];
+}
+
+/**
+  Returns the time stamp at which the accounting of an SMI, or of the SMI
+  handlers of a handler type, starts.
+
+  @return The time stamp, or 0 if SMI latency accounting is disabled.
+
+**/
+UINT64
+SmiLatencyBegin (
+  VOID
+  )
+{
+  if (mSmiLatencyRecords == NULL) {
+    return 0;
+  }
+
+  return AsmReadTsc ();
+}
+
+/**
+  Accounts the time since a time stamp into an SMI latency record.
+
+  @param  Record  The SMI latency record, or NULL.
+  @param  Begin   The time stamp returned by SmiLatencyBegin().
+
+**/
+VOID
+SmiLatencyEnd (
+  IN SMI_LATENCY_RECORD  *Record  OPTIONAL,
+  IN UINT64              Begin
+  )
+{
+  UINT64  Ticks;
+  INTN    Index;
+
+  if ((Record == NULL) || (Begin == 0)) {
+    return;
+  }
+
+  Ticks = AsmReadTsc () - Begin;
+  Index = HighBitSet64 (Ticks) - SMI_LATENCY_BUCKET_SHIFT;
+  if (Index < 0) {
+    Index = 0;
+  } else if (Index >= SMI_LATENCY_BUCKET_COUNT) {
+    Index = SMI_LATENCY_BUCKET_COUNT - 1;
+  }
+
+  Record->Count++;
+  Record->TotalTicks += Ticks;
+  Record->Bucket[Index]++;
+  if (Ticks > Record->MaxTicks) {
+    Record->MaxTicks = Ticks;
+  }
+}
+
+/**
+  SMI latency handler to get data by offset.
+
+  @param  GetDataByOffset  The parameter of SMI latency get data by offset.
+
+**/
+VOID
+SmiLatencyHandlerGetDataByOffset (
+  IN SMI_LATENCY_PARAMETER_GET_DATA_BY_OFFSET  *GetDataByOffset
+  )
+{
+  SMI_LATENCY_PARAMETER_GET_DATA_BY_OFFSET  Parameter;
+  UINT64                                    DataSize;
+
+  CopyMem (&Parameter, GetDataByOffset, sizeof (Parameter));
+
+  //
+  // Sanity check
+  //
+  if (!SmmIsBufferOutsideSmmValid ((UINTN)Parameter.DataBuffer, (UINTN)Parameter.DataSize)) {
+    DEBUG ((DEBUG_ERROR, "SmiLatencyHandlerGetDataByOffset: SMI latency get data in SMRAM or overflow!\n"));
+    GetDataByOffset->Header.ReturnStatus = (UINT64)(INT64)(INTN)EFI_ACCESS_DENIED;
+    return;
+  }
+
+  DataSize = mSmiLatencyRecordCount * sizeof (SMI_LATENCY_RECORD);
+  if (Parameter.DataOffset >= DataSize) {
+    Parameter.DataSize   = 0;
+    Parameter.DataOffset = DataSize;
+  } else {
+    if (DataSize - Parameter.DataOffset < Parameter.DataSize) {
+      Parameter.DataSize = DataSize - Parameter.DataOffset;
+    }
+
+    CopyMem (
+      (VOID *)(UINTN)Parameter.DataBuffer,
+      (UINT8 *)mSmiLatencyRecords + Parameter.DataOffset,
+      (UINTN)Parameter.DataSize
+      );
+    Parameter.DataOffset += Parameter.DataSize;
+  }
+
+  CopyMem (GetDataByOffset, &Parameter, sizeof (Parameter));
+  GetDataByOffset->Header.ReturnStatus = 0;
+}
+
+/**
+  Dispatch function for the SMI latency communicate requests.
+
+  Caution: This function may receive untrusted input.
+  Communicate buffer and buffer size are external input, so this function will do basic validation.
+
+  @param DispatchHandle  The unique handle assigned to this handler by SmiHandlerRegister().
+  @param Context         Points to an optional handler context which was specified when the
+                         handler was registered.
+  @param CommBuffer      A pointer to a collection of data in memory that will
+                         be conveyed from a non-SMM environment into an SMM environment.
+  @param CommBufferSize  The size of the CommBuffer.
+
+  @retval EFI_SUCCESS Command is handled successfully.
+**/
+EFI_STATUS
+EFIAPI
+SmiLatencyHandler (
+  IN EFI_HANDLE  DispatchHandle,
+  IN CONST VOID  *Context         OPTIONAL,
+  IN OUT VOID    *CommBuffer      OPTIONAL,
+  IN OUT UINTN   *CommBufferSize  OPTIONAL
+  )
+{
+  SMI_LATENCY_PARAMETER_HEADER  *ParameterHeader;
+  UINTN                         TempCommBufferSize;
+
+  //
+  // If input is invalid, stop processing this SMI
+  //
+  if ((CommBuffer == NULL) || (CommBufferSize == NULL)) {
+    return EFI_SUCCESS;
+  }
+
+  TempCommBufferSize = *CommBufferSize;
+
+  if (TempCommBufferSize < sizeof (SMI_LATENCY_PARAMETER_HEADER)) {
+    DEBUG ((DEBUG_ERROR, "SmiLatencyHandler: SMM communication buffer size invalid!\n"));
+    return EFI_SUCCESS;
+  }
+
+  if (!SmmIsBufferOutsideSmmValid ((UINTN)CommBuffer, TempCommBufferSize)) {
+    DEBUG ((DEBUG_ERROR, "SmiLatencyHandler: SMM communication buffer in SMRAM or overflow!\n"));
+    return EFI_SUCCESS;
+  }
+
+  ParameterHeader               = (SMI_LATENCY_PARAMETER_HEADER *)((UINTN)CommBuffer);
+  ParameterHeader->ReturnStatus = (UINT64)-1;
+
+  switch (ParameterHeader->Command) {
+    case SMI_LATENCY_COMMAND_GET_INFO:
+      if (TempCommBufferSize != sizeof (SMI_LATENCY_PARAMETER_GET_INFO)) {
+        DEBUG ((DEBUG_ERROR, "SmiLatencyHandler: SMM communication buffer size invalid!\n"));
+        return EFI_SUCCESS;
+      }
+
+      ((SMI_LATENCY_PARAMETER_GET_INFO *)(UINTN)CommBuffer)->DataSize = mSmiLatencyRecordCount * sizeof (SMI_LATENCY_RECORD);
+      ParameterHeader->ReturnStatus                                   = 0;
+      break;
+    case SMI_LATENCY_COMMAND_GET_DATA_BY_OFFSET:
+      if (TempCommBufferSize != sizeof (SMI_LATENCY_PARAMETER_GET_DATA_BY_OFFSET)) {
+        DEBUG ((DEBUG_ERROR, "SmiLatencyHandler: SMM communication buffer size invalid!\n"));
+        return EFI_SUCCESS;
+      }
+
+      SmiLatencyHandlerGetDataByOffset ((SMI_LATENCY_PARAMETER_GET_DATA_BY_OFFSET *)(UINTN)CommBuffer);
+      break;
+    default:
+      break;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Initialize SMI latency accounting.
+**/
+VOID
+SmmCoreInitializeSmiLatency (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  EFI_HANDLE  DispatchHandle;
+
+  if (!FeaturePcdGet (PcdSmiLatencyAccounting)) {
+    return;
+  }
+
+  mSmiLatencyRecords = AllocateZeroPool (SMI_LATENCY_MAX_RECORDS * sizeof (SMI_LATENCY_RECORD));
+  if (mSmiLatencyRecords == NULL) {
+    return;
+  }
+
+  //
+  // The first records are the ones of the whole SMIs and of the root SMI
+  // handlers.
+  //
+  mSmiLatencyTotalRecord      = SmiLatencyGetRecord (&gEdkiiSmiLatencyGuid);
+  mRootSmiEntry.LatencyRecord = SmiLatencyGetRecord (NULL);
+
+  Status = SmiHandlerRegister (SmiLatencyHandler, &gEdkiiSmiLatencyGuid, &DispatchHandle);
+  ASSERT_EFI_ERROR (Status);
+}
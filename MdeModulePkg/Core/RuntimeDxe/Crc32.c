@@ -15,6 +15,46 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Uefi.h>
 #include <Library/BaseLib.h>
 
+#define CRC32_POLYNOMIAL  0xEDB88320
+
+//
+// mCrc32Tables[0] is the usual byte-wise table. mCrc32Tables[N] gives the
+// CRC of a byte followed by N zero bytes, so that 8 bytes can be folded into
+// the CRC at once (slice-by-8).
+//
+UINT32  mCrc32Tables[8][256];
+
+/**
+  Build the tables used by RuntimeDriverCalculateCrc32().
+
+**/
+VOID
+RuntimeDriverInitializeCrc32Tables (
+  VOID
+  )
+{
+  UINTN   Index;
+  UINTN   Slice;
+  UINTN   Bit;
+  UINT32  Crc;
+
+  for (Index = 0; Index < 256; Index++) {
+    Crc = (UINT32)Index;
+    for (Bit = 0; Bit < 8; Bit++) {
+      Crc = (Crc >> 1) ^ (((Crc & 1) != 0) ? CRC32_POLYNOMIAL : 0);
+    }
+
+    mCrc32Tables[0][Index] = Crc;
+  }
+
+  for (Index = 0; Index < 256; Index++) {
+    for (Slice = 1; Slice < 8; Slice++) {
+      Crc                        = mCrc32Tables[Slice - 1][Index];
+      mCrc32Tables[Slice][Index] = (Crc >> 8) ^ mCrc32Tables[0][Crc & 0xFF];
+    }
+  }
+}
+
 /**
   Calculate CRC32 for target data.
 
@@ -35,10 +75,37 @@ RuntimeDriverCalculateCrc32 (
   OUT UINT32  *CrcOut
   )
 {
+  UINT8   *Ptr;
+  UINT32  Crc;
+  UINT32  High;
+
   if ((Data == NULL) || (DataSize == 0) || (CrcOut == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
 
-  *CrcOut = CalculateCrc32 (Data, DataSize);
+  Ptr = (UINT8 *)Data;
+  Crc = 0xFFFFFFFF;
+  while (DataSize >= 8) {
+    Crc ^= ReadUnaligned32 ((UINT32 *)Ptr);
+    High = ReadUnaligned32 ((UINT32 *)(Ptr + 4));
+    Crc  = mCrc32Tables[7][Crc & 0xFF] ^
+           mCrc32Tables[6][(Crc >> 8) & 0xFF] ^
+           mCrc32Tables[5][(Crc >> 16) & 0xFF] ^
+           mCrc32Tables[4][Crc >> 24] ^
+           mCrc32Tables[3][High & 0xFF] ^
+           mCrc32Tables[2][(High >> 8) & 0xFF] ^
+           mCrc32Tables[1][(High >> 16) & 0xFF] ^
+           mCrc32Tables[0][High >> 24];
+    Ptr      += 8;
+    DataSize -= 8;
+  }
+
+  while (DataSize > 0) {
+    Crc = (Crc >> 8) ^ mCrc32Tables[0][(UINT8)Crc ^ *Ptr];
+    Ptr++;
+    DataSize--;
+  }
+
+  *CrcOut = Crc ^ 0xFFFFFFFF;
   return EFI_SUCCESS;
 }
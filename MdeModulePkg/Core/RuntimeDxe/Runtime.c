@@ -414,6 +414,8 @@ RuntimeDriverInitialize (
   ASSERT_EFI_ERROR (Status);
   mMyImageBase = MyLoadedImage->ImageBase;
 
+  RuntimeDriverInitializeCrc32Tables ();
+
   //
   // Fill in the entries of the EFI Boot Services and EFI Runtime Services Tables
   //
@@ -0,0 +1,37 @@
+/** @file
+  GUID and data structure of the chunked GUIDed section.
+
+  The section data starts with an EDKII_CHUNKED_SECTION_HEADER, followed by
+  ChunkCount GUIDed sections, each aligned on a 4-byte boundary. Each of them
+  is typically an LZMA or a Brotli compressed section holding one chunk of the
+  original data. The chunks decode to consecutive parts of the output buffer
+  and can be decoded independently of each other.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef CHUNKED_SECTION_H_
+#define CHUNKED_SECTION_H_
+
+#define EDKII_CHUNKED_SECTION_GUID \
+  { 0x8c30ba09, 0xbc96, 0x4b7f, { 0xb2, 0x71, 0x8f, 0x8e, 0xbc, 0x12, 0x4f, 0x95 } }
+
+#define EDKII_CHUNKED_SECTION_SIGNATURE  SIGNATURE_32 ('C', 'H', 'N', 'K')
+
+typedef struct {
+  UINT32    Signature;
+  ///
+  /// Number of GUIDed sections following the header.
+  ///
+  UINT32    ChunkCount;
+  ///
+  /// Total size of the decoded data of all the chunks.
+  ///
+  UINT64    DecodedSize;
+} EDKII_CHUNKED_SECTION_HEADER;
+
+extern EFI_GUID  gEdkiiChunkedSectionGuid;
+
+#endif
@@ -0,0 +1,94 @@
+/** @file
+  GUIDs and data structures of the configuration tables in which the DXE Core
+  records a timeline of the boot services called by drivers, and the time
+  spent in Stall() by every caller.
+
+  The trace table is only installed if PcdDxeCoreTraceBufferSize is not zero.
+  Every record covers one call, with its start and end time, the CPU it ran on
+  and the return address of its caller, so that consumers can attribute it to
+  the calling image.
+
+  The stall table is only installed if PcdDxeCoreStallAccountingEntries is not
+  zero. It holds one entry per Stall() call site.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef DXE_CORE_TRACE_H_
+#define DXE_CORE_TRACE_H_
+
+#define EDKII_DXE_CORE_TRACE_TABLE_GUID \
+  { 0x56afb7d1, 0xa642, 0x46b6, { 0xa6, 0x0e, 0x36, 0xfe, 0x83, 0xaf, 0x56, 0xa9 } }
+
+#define EDKII_DXE_CORE_TRACE_SIGNATURE  SIGNATURE_32 ('D', 'C', 'T', 'R')
+
+//
+// Traced services, stored in EDKII_DXE_CORE_TRACE_RECORD.Service
+//
+#define EDKII_DXE_CORE_TRACE_CONNECT_CONTROLLER  1  // Argument = ControllerHandle
+#define EDKII_DXE_CORE_TRACE_LOCATE_PROTOCOL     2  // Guid = Protocol
+#define EDKII_DXE_CORE_TRACE_ALLOCATE_PAGES      3  // Argument = Pages
+#define EDKII_DXE_CORE_TRACE_FREE_PAGES          4  // Argument = Pages
+#define EDKII_DXE_CORE_TRACE_STALL               5  // Argument = Microseconds
+#define EDKII_DXE_CORE_TRACE_AP_PROCEDURE        6  // Caller = Procedure, Argument = Parameter
+
+///
+/// One traced call. Times are in nanoseconds from the performance counter.
+///
+typedef struct {
+  UINT64      StartTime;
+  UINT64      EndTime;
+  UINT64      Caller;
+  UINT64      Argument;
+  EFI_GUID    Guid;
+  UINT32      Service;
+  UINT32      CpuIndex;
+} EDKII_DXE_CORE_TRACE_RECORD;
+
+///
+/// Content of the DXE Core trace table. MaxRecords records follow the header.
+/// RecordCount keeps counting once the table is full, so that the number of
+/// dropped records is RecordCount - MaxRecords.
+///
+typedef struct {
+  UINT32    Signature;
+  UINT32    MaxRecords;
+  UINT32    RecordCount;
+  UINT32    Reserved;
+  // EDKII_DXE_CORE_TRACE_RECORD  Record[MaxRecords];
+} EDKII_DXE_CORE_TRACE_TABLE;
+
+#define EDKII_DXE_CORE_STALL_TABLE_GUID \
+  { 0x8d25eb47, 0x4097, 0x46a4, { 0xa9, 0xb1, 0x6e, 0x27, 0xb6, 0x62, 0x11, 0xd6 } }
+
+#define EDKII_DXE_CORE_STALL_SIGNATURE  SIGNATURE_32 ('D', 'C', 'S', 'T')
+
+///
+/// Stall() calls made from one return address.
+///
+typedef struct {
+  UINT64    Caller;
+  UINT64    Count;
+  UINT64    RequestedMicroseconds;
+  UINT64    ElapsedNanoseconds;
+} EDKII_DXE_CORE_STALL_ENTRY;
+
+///
+/// Content of the DXE Core stall table. MaxEntries entries follow the header,
+/// EntryCount of them are in use. Calls from a new call site once the table
+/// is full are only counted in DroppedCount.
+///
+typedef struct {
+  UINT32    Signature;
+  UINT32    MaxEntries;
+  UINT32    EntryCount;
+  UINT32    DroppedCount;
+  // EDKII_DXE_CORE_STALL_ENTRY  Entry[MaxEntries];
+} EDKII_DXE_CORE_STALL_TABLE;
+
+extern EFI_GUID  gEdkiiDxeCoreTraceTableGuid;
+extern EFI_GUID  gEdkiiDxeCoreStallTableGuid;
+
+#endif
@@ -0,0 +1,48 @@
+/** @file
+  GUID and data structure of the variable in which the DXE Core records the
+  order in which it dispatched the DXE drivers.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef DXE_DISPATCH_ORDER_H_
+#define DXE_DISPATCH_ORDER_H_
+
+//
+// Vendor GUID of the DXE dispatch order variable
+//
+#define EDKII_DXE_DISPATCH_ORDER_VARIABLE_GUID \
+  { 0xe89872fd, 0xe1d3, 0x43bf, { 0xb4, 0x26, 0xf7, 0x49, 0xee, 0x17, 0x90, 0xeb } }
+
+//
+// Name of the DXE dispatch order variable
+//
+#define EDKII_DXE_DISPATCH_ORDER_VARIABLE_NAME  L"DxeDispatchOrder"
+
+#define EDKII_DXE_DISPATCH_ORDER_SIGNATURE  SIGNATURE_32 ('D', 'D', 'O', 'R')
+
+///
+/// One dispatched driver. The driver is identified by a 32-bit fold of its
+/// file name GUID and the CRC32 of its dependency expression, so that a driver
+/// whose depex changed is not mistaken for the one that was recorded.
+///
+typedef struct {
+  UINT32    FileNameHash;
+  UINT32    DepexCrc;
+} EDKII_DXE_DISPATCH_ORDER_ENTRY;
+
+///
+/// Content of the DXE dispatch order variable. Count entries follow the header,
+/// in the order in which the drivers were started.
+///
+typedef struct {
+  UINT32    Signature;
+  UINT32    Count;
+  // EDKII_DXE_DISPATCH_ORDER_ENTRY  Entry[Count];
+} EDKII_DXE_DISPATCH_ORDER;
+
+extern EFI_GUID  gEdkiiDxeDispatchOrderVariableGuid;
+
+#endif
@@ -0,0 +1,45 @@
+/** @file
+  GUID and data structure of the HOB in which the PEI Core saves the table of
+  the files of a firmware volume, so that the table can be reused by the DXE
+  Core instead of walking the file headers of the firmware volume again.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef FV_FILE_TABLE_H_
+#define FV_FILE_TABLE_H_
+
+#define EDKII_FV_FILE_TABLE_HOB_GUID \
+  { 0x1ec2f7ba, 0xb29a, 0x4c3b, { 0xb8, 0xbd, 0x88, 0x89, 0xba, 0x2e, 0x5f, 0x26 } }
+
+///
+/// One file of the firmware volume. Only the files whose header and data
+/// checksums were found valid are in the table, in the order in which they
+/// are laid out in the firmware volume.
+///
+typedef struct {
+  EFI_GUID           Name;
+  ///
+  /// Offset of the file header from the start of the firmware volume.
+  ///
+  UINT32             Offset;
+  EFI_FV_FILETYPE    Type;
+  UINT8              Reserved[3];
+} EDKII_FV_FILE_TABLE_ENTRY;
+
+///
+/// Content of the HOB. FileCount entries follow the header.
+///
+typedef struct {
+  EFI_PHYSICAL_ADDRESS    FvBase;
+  UINT64                  FvLength;
+  UINT32                  FileCount;
+  UINT32                  Reserved;
+  // EDKII_FV_FILE_TABLE_ENTRY  Entry[FileCount];
+} EDKII_FV_FILE_TABLE;
+
+extern EFI_GUID  gEdkiiFvFileTableHobGuid;
+
+#endif
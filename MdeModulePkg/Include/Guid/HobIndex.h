@@ -0,0 +1,59 @@
+/** @file
+  GUID and data structures of the configuration table in which the DXE Core
+  publishes an index of the HOB list, so that HOB lookups by type or by GUID
+  do not need to walk the HOB list.
+
+  The table is only installed if PcdDxeCoreHobIndex is TRUE. It is used by the
+  DxeIndexedHobLib instance of the HobLib library class.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef HOB_INDEX_H_
+#define HOB_INDEX_H_
+
+#define EDKII_HOB_INDEX_TABLE_GUID \
+  { 0x320cebcf, 0x7d3b, 0x49b0, { 0x86, 0xe3, 0xe8, 0xc0, 0x9b, 0xc9, 0x5f, 0x5c } }
+
+#define EDKII_HOB_INDEX_SIGNATURE  SIGNATURE_32 ('H', 'O', 'B', 'I')
+
+///
+/// The HOBs of one type, or the GUID extension HOBs of one GUID.
+///
+typedef struct {
+  UINT16      HobType;
+  UINT16      Reserved;
+  ///
+  /// Index in EDKII_HOB_INDEX_TABLE.Hobs of the first HOB of the entry.
+  ///
+  UINT32      FirstHob;
+  UINT32      HobCount;
+  ///
+  /// The GUID of the HOBs if HobType is EFI_HOB_TYPE_GUID_EXTENSION, zero
+  /// otherwise.
+  ///
+  EFI_GUID    Name;
+} EDKII_HOB_INDEX_ENTRY;
+
+///
+/// The index. The entries are sorted by HobType, then by Name as compared by
+/// CompareMem(). The HOBs of each entry are in HOB list order, which is also
+/// ascending address order.
+///
+typedef struct {
+  UINT32                   Signature;
+  UINT32                   EntryCount;
+  ///
+  /// The HOB list the index was built for, and its end of HOB list HOB.
+  ///
+  VOID                     *HobList;
+  VOID                     *HobListEnd;
+  EDKII_HOB_INDEX_ENTRY    *Entries;
+  VOID                     **Hobs;
+} EDKII_HOB_INDEX_TABLE;
+
+extern EFI_GUID  gEdkiiHobIndexTableGuid;
+
+#endif
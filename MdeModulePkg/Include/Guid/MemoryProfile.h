@@ -179,6 +179,28 @@ typedef struct {
   // MEMORY_PROFILE_DESCRIPTOR     MemoryDescriptor[MemoryRangeCount];
 } MEMORY_PROFILE_MEMORY_RANGE;
 
+#define MEMORY_PROFILE_CALL_SITE_SIGNATURE  SIGNATURE_32 ('M','P','C','S')
+#define MEMORY_PROFILE_CALL_SITE_REVISION   0x0001
+
+//
+// Allocations of one memory type made from one CallerAddress, when the memory
+// profile only samples one in SampleRate allocations instead of recording
+// each of them. The counts and sizes only cover the sampled allocations;
+// multiply them by SampleRate to estimate the totals of the call site.
+// CurrentSize is the size of the sampled allocations not freed yet.
+//
+typedef struct {
+  MEMORY_PROFILE_COMMON_HEADER    Header;
+  PHYSICAL_ADDRESS                CallerAddress;
+  UINT32                          SampleRate;
+  EFI_MEMORY_TYPE                 MemoryType;
+  UINT64                          AllocCount;
+  UINT64                          AllocSize;
+  UINT64                          FreeCount;
+  UINT64                          CurrentSize;
+  UINT64                          PeakSize;
+} MEMORY_PROFILE_CALL_SITE;
+
 //
 // UEFI memory profile layout:
 // +--------------------------------+
@@ -196,6 +218,14 @@ typedef struct {
 // +--------------------------------+
 // | ALLOC_INFO(n, mn)              |
 // +--------------------------------+
+// | CALL_SITE(1)                   |
+// +--------------------------------+
+// | CALL_SITE(k)                   |
+// +--------------------------------+
+//
+// In sampling mode (PcdMemoryProfileSampleRate is not zero), the DRIVER_INFOs
+// carry no ALLOC_INFO and no usage, and the sampled allocations are summarized
+// in the CALL_SITE records instead. There is no CALL_SITE record otherwise.
 //
 
 typedef struct _EDKII_MEMORY_PROFILE_PROTOCOL EDKII_MEMORY_PROFILE_PROTOCOL;
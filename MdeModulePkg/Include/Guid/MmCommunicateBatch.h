@@ -0,0 +1,72 @@
+/** @file
+  GUID and data structures to send several MM communicate requests with one
+  SMI.
+
+  Each communicate request costs an SMI, and the cost of an SMI grows with
+  the number of processors that have to enter and leave SMM. A caller that
+  has several requests ready, for different handlers or for the same one,
+  can instead send one request to this GUID. Its data is an
+  EDKII_MM_COMMUNICATE_BATCH_HEADER followed by the requests, each an
+  EDKII_MM_COMMUNICATE_BATCH_ENTRY followed by the message data. The SMM Core
+  hands the requests to their handlers one after another, in order, and
+  stores the status and the updated message length of each in its entry.
+
+  An SMM Core that does not know this GUID fails the whole communicate
+  request with EFI_NOT_FOUND, so the caller can send the requests one by one.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef MM_COMMUNICATE_BATCH_H_
+#define MM_COMMUNICATE_BATCH_H_
+
+#define EDKII_MM_COMMUNICATE_BATCH_GUID \
+  { \
+    0x75d802c9, 0x9f4d, 0x484a, { 0x86, 0xb0, 0xab, 0xc3, 0x05, 0x0b, 0xfd, 0xa6 } \
+  }
+
+#pragma pack(1)
+
+typedef struct {
+  ///
+  /// The number of EDKII_MM_COMMUNICATE_BATCH_ENTRY that follow.
+  ///
+  UINT32    NumberOfEntries;
+  UINT32    Reserved;
+} EDKII_MM_COMMUNICATE_BATCH_HEADER;
+
+typedef struct {
+  ///
+  /// The size in bytes of the entry, this structure and the message data
+  /// included. It should be a multiple of 8 so that the next entry is
+  /// aligned.
+  ///
+  UINT64      EntryLength;
+  ///
+  /// Set by the SMM Core to EFI_SUCCESS if a handler processed the request,
+  /// to EFI_NOT_FOUND if no handler did, and to EFI_INVALID_PARAMETER if the
+  /// entry is malformed. The requests after a malformed entry are not
+  /// processed.
+  ///
+  UINT64      ReturnStatus;
+  ///
+  /// The GUID of the handler the request is for.
+  ///
+  EFI_GUID    HeaderGuid;
+  ///
+  /// On input, the size of the message data. On output, the size returned
+  /// by the handler.
+  ///
+  UINT64      MessageLength;
+  //
+  // UINT8    Data[MessageLength];
+  //
+} EDKII_MM_COMMUNICATE_BATCH_ENTRY;
+
+#pragma pack()
+
+extern EFI_GUID  gEdkiiMmCommunicateBatchGuid;
+
+#endif
@@ -0,0 +1,84 @@
+/** @file
+  Header file for SMI latency accounting definition.
+
+  When PcdSmiLatencyAccounting is TRUE, the SMM Core accounts the time spent
+  in every SMI, and in the SMI handlers of every handler type, into
+  histograms kept in SMRAM. The histograms are read with MM communicate
+  requests to gEdkiiSmiLatencyGuid.
+
+  Layout of the data:
+  +---------------------------+
+  | SMI_LATENCY_RECORD        |  Whole SMIs, HandlerType is gEdkiiSmiLatencyGuid.
+  +---------------------------+
+  | SMI_LATENCY_RECORD        |  Root SMI handlers, HandlerType is the zero GUID.
+  +---------------------------+
+  | SMI_LATENCY_RECORD        |  SMI handlers of one handler type.
+  +---------------------------+
+  | ...                       |
+  +---------------------------+
+
+Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef SMI_LATENCY_H_
+#define SMI_LATENCY_H_
+
+#define EDKII_SMI_LATENCY_GUID \
+  { \
+    0xc5336762, 0xcbeb, 0x4626, { 0xbf, 0x0a, 0x30, 0x90, 0x9a, 0xaf, 0x75, 0xbb } \
+  }
+
+//
+// The durations are measured in time stamp counter ticks. Bucket[Index]
+// counts the durations from 2^(Index + SMI_LATENCY_BUCKET_SHIFT) up to
+// 2^(Index + SMI_LATENCY_BUCKET_SHIFT + 1) ticks. The first and the last
+// buckets also count the shorter and the longer durations.
+//
+#define SMI_LATENCY_BUCKET_SHIFT  10
+#define SMI_LATENCY_BUCKET_COUNT  24
+
+typedef struct {
+  EFI_GUID    HandlerType;
+  UINT64      Count;
+  UINT64      TotalTicks;
+  UINT64      MaxTicks;
+  UINT64      Bucket[SMI_LATENCY_BUCKET_COUNT];
+} SMI_LATENCY_RECORD;
+
+//
+// SMI latency commands
+//
+#define SMI_LATENCY_COMMAND_GET_INFO            0x1
+#define SMI_LATENCY_COMMAND_GET_DATA_BY_OFFSET  0x2
+
+typedef struct {
+  UINT32    Command;
+  UINT32    DataLength;
+  UINT64    ReturnStatus;
+} SMI_LATENCY_PARAMETER_HEADER;
+
+typedef struct {
+  SMI_LATENCY_PARAMETER_HEADER    Header;
+  UINT64                          DataSize;
+} SMI_LATENCY_PARAMETER_GET_INFO;
+
+typedef struct {
+  SMI_LATENCY_PARAMETER_HEADER    Header;
+  //
+  // On input, data buffer size.
+  // On output, actual data buffer size copied.
+  //
+  UINT64                          DataSize;
+  PHYSICAL_ADDRESS                DataBuffer;
+  //
+  // On input, data buffer offset to copy.
+  // On output, next time data buffer offset to copy.
+  //
+  UINT64                          DataOffset;
+} SMI_LATENCY_PARAMETER_GET_DATA_BY_OFFSET;
+
+extern EFI_GUID  gEdkiiSmiLatencyGuid;
+
+#endif
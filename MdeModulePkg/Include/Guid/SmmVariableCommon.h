@@ -77,6 +77,10 @@ typedef struct {
 // The payload for this function is SMM_VARIABLE_COMMUNICATE_GET_RUNTIME_CACHE_INFO
 //
 #define SMM_VARIABLE_FUNCTION_GET_RUNTIME_CACHE_INFO  14
+//
+// The payload for this function is SMM_VARIABLE_COMMUNICATE_SET_VARIABLE_BATCH
+//
+#define SMM_VARIABLE_FUNCTION_SET_VARIABLE_BATCH  15
 
 ///
 /// Size of SMM communicate header, without including the payload.
@@ -138,6 +142,7 @@ typedef struct {
   VARIABLE_STORE_HEADER    *RuntimeHobCache;
   VARIABLE_STORE_HEADER    *RuntimeNvCache;
   VARIABLE_STORE_HEADER    *RuntimeVolatileCache;
+  UINT32                   *Sequence;
 } SMM_VARIABLE_COMMUNICATE_RUNTIME_VARIABLE_CACHE_CONTEXT;
 
 typedef struct {
@@ -147,4 +152,29 @@ typedef struct {
   BOOLEAN    AuthenticatedVariableUsage;
 } SMM_VARIABLE_COMMUNICATE_GET_RUNTIME_CACHE_INFO;
 
+///
+/// This structure is used to communicate with SMI handler by SetVariable batch.
+/// Count SMM_VARIABLE_COMMUNICATE_BATCH_ENTRY structures follow it, each of them
+/// starting at a UINTN aligned offset from the beginning of the payload.
+///
+typedef struct {
+  UINTN    Count;
+} SMM_VARIABLE_COMMUNICATE_SET_VARIABLE_BATCH;
+
+///
+/// One entry of SMM_VARIABLE_COMMUNICATE_SET_VARIABLE_BATCH. Name is followed by
+/// the variable data. Status is returned by SMI handler.
+///
+typedef struct {
+  EFI_STATUS    Status;
+  EFI_GUID      Guid;
+  UINTN         DataSize;
+  UINTN         NameSize;
+  UINT32        Attributes;
+  CHAR16        Name[1];
+} SMM_VARIABLE_COMMUNICATE_BATCH_ENTRY;
+
+#define SMM_VARIABLE_BATCH_ENTRY_SIZE(NameSize, DataSize) \
+  ALIGN_VALUE (OFFSET_OF (SMM_VARIABLE_COMMUNICATE_BATCH_ENTRY, Name) + (NameSize) + (DataSize), sizeof (UINTN))
+
 #endif // _SMM_VARIABLE_COMMON_H_
@@ -35,6 +35,12 @@ typedef struct {
   /// TRUE indicates all HOB variables have been flushed in flash.
   ///
   BOOLEAN    HobFlushComplete;
+  ///
+  /// Incremented before and after each update of the runtime cache, so it is odd
+  /// while an update is in progress. A reader that sees the same even value
+  /// before and after its lookup has read a consistent runtime cache.
+  ///
+  UINT32     Sequence;
 } CACHE_INFO_FLAG;
 
 typedef struct {
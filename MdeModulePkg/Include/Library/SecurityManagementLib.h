@@ -267,4 +267,60 @@ ExecuteSecurity2Handlers (
   IN  BOOLEAN                         BootPolicy
   );
 
+/**
+  Publish the PE/COFF Authenticode digest of the image currently being processed by
+  ExecuteSecurity2Handlers(), so that the security handlers which run after the
+  caller can reuse it instead of hashing the image again.
+
+  The digest is only kept until ExecuteSecurity2Handlers() returns.
+
+  @param[in]  FileBuffer     The image buffer passed to the security handler.
+  @param[in]  FileSize       The size of FileBuffer in bytes.
+  @param[in]  HashAlgorithm  The EFI_CERT_SHAxxx_GUID identifying the hash algorithm.
+  @param[in]  Digest         The Authenticode digest of the image.
+  @param[in]  DigestSize     The size of Digest in bytes.
+
+  @retval EFI_SUCCESS            The digest was recorded.
+  @retval EFI_INVALID_PARAMETER  FileBuffer, HashAlgorithm or Digest is NULL.
+  @retval EFI_NOT_READY          No security handler chain is being executed for FileBuffer.
+  @retval EFI_BAD_BUFFER_SIZE    DigestSize is too large to be recorded.
+  @retval EFI_OUT_OF_RESOURCES   The digests of too many algorithms were already recorded.
+**/
+EFI_STATUS
+EFIAPI
+SetSecurityImageDigest (
+  IN CONST VOID      *FileBuffer,
+  IN UINTN           FileSize,
+  IN CONST EFI_GUID  *HashAlgorithm,
+  IN CONST UINT8     *Digest,
+  IN UINTN           DigestSize
+  );
+
+/**
+  Retrieve the PE/COFF Authenticode digest of the image currently being processed by
+  ExecuteSecurity2Handlers(), as published earlier by another security handler with
+  SetSecurityImageDigest().
+
+  @param[in]      FileBuffer     The image buffer passed to the security handler.
+  @param[in]      FileSize       The size of FileBuffer in bytes.
+  @param[in]      HashAlgorithm  The EFI_CERT_SHAxxx_GUID identifying the hash algorithm.
+  @param[out]     Digest         The buffer receiving the digest.
+  @param[in,out]  DigestSize     On input, the size of Digest in bytes. On output,
+                                 the size of the returned digest.
+
+  @retval EFI_SUCCESS            The digest was returned.
+  @retval EFI_INVALID_PARAMETER  FileBuffer, HashAlgorithm, Digest or DigestSize is NULL.
+  @retval EFI_NOT_FOUND          No digest of this image was recorded for HashAlgorithm.
+  @retval EFI_BUFFER_TOO_SMALL   DigestSize is too small, it is updated with the required size.
+**/
+EFI_STATUS
+EFIAPI
+GetSecurityImageDigest (
+  IN CONST VOID      *FileBuffer,
+  IN UINTN           FileSize,
+  IN CONST EFI_GUID  *HashAlgorithm,
+  OUT UINT8          *Digest,
+  IN OUT UINTN       *DigestSize
+  );
+
 #endif
@@ -559,6 +559,27 @@ EfiBootManagerConnectAll (
   VOID
   );
 
+/**
+  Connect only the controllers a normal boot needs: the consoles named by
+  ConIn, ConOut and ErrOut, and the device of the boot option that will be
+  tried first (BootNext, otherwise the first active option in BootOrder).
+
+  EfiBootManagerConnectAll() is performed instead when the consoles or the
+  boot device cannot be connected, or when a key is pending on the console
+  input so that the user may be entering a hotkey or the setup menu.
+
+  @retval EFI_SUCCESS    Only the consoles and the boot device were connected.
+  @retval EFI_NOT_FOUND  A console or the boot device could not be connected,
+                         all controllers were connected instead.
+  @retval EFI_ABORTED    A key was pending, all controllers were connected
+                         instead.
+**/
+EFI_STATUS
+EFIAPI
+EfiBootManagerConnectMinimal (
+  VOID
+  );
+
 /**
   This function will create all handles associate with every device
   path node. If the handle associate with one device path node can not
@@ -0,0 +1,107 @@
+/** @file
+  EDK II Firmware Management Async Protocol.
+
+  An FMP instance whose device is updated independently of the other devices
+  of the platform, for example a device that takes the image over its own bus
+  and writes its own flash, installs this protocol on the handle of its
+  Firmware Management Protocol. The capsule library then starts the update of
+  the device and goes on with the other payloads of the capsule while the
+  device is busy.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __EDKII_FIRMWARE_MANAGEMENT_ASYNC_PROTOCOL_H__
+#define __EDKII_FIRMWARE_MANAGEMENT_ASYNC_PROTOCOL_H__
+
+#include <Protocol/FirmwareManagement.h>
+
+///
+/// EDK II Firmware Management Async Protocol GUID value
+///
+#define EDKII_FIRMWARE_MANAGEMENT_ASYNC_PROTOCOL_GUID \
+  { \
+    0x46bea74f, 0x25e9, 0x4714, { 0xba, 0x72, 0x97, 0x6b, 0x17, 0x46, 0x08, 0xf5 } \
+  }
+
+typedef struct _EDKII_FIRMWARE_MANAGEMENT_ASYNC_PROTOCOL EDKII_FIRMWARE_MANAGEMENT_ASYNC_PROTOCOL;
+
+/**
+  Start the update of the device with a new firmware image.
+
+  The parameters are checked as by the SetImage() service of the Firmware
+  Management Protocol on the same handle. The buffers of Image and VendorCode
+  must stay valid until PollImage() returns a status other than EFI_NOT_READY.
+
+  @param[in]  This         The EDKII_FIRMWARE_MANAGEMENT_ASYNC_PROTOCOL instance.
+  @param[in]  ImageIndex   The unique number identifying the firmware image.
+  @param[in]  Image        Points to the new image.
+  @param[in]  ImageSize    Size of the new image in bytes.
+  @param[in]  VendorCode   This enables vendor to implement vendor-specific
+                           firmware image update policy. NULL if the caller
+                           did not specify the policy or use the default policy.
+  @param[out] AbortReason  A pointer to a pointer to a null-terminated string
+                           providing more details for the aborted operation.
+                           The buffer is allocated by this function with
+                           AllocatePool(), and it is the caller's
+                           responsibility to free it with a call to FreePool().
+
+  @retval EFI_SUCCESS      The update was started. Its result is returned by
+                           PollImage().
+  @retval Others           The update could not be started. The status has the
+                           meaning of the same status returned by SetImage().
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_FIRMWARE_MANAGEMENT_ASYNC_START_IMAGE)(
+  IN  EDKII_FIRMWARE_MANAGEMENT_ASYNC_PROTOCOL  *This,
+  IN  UINT8                                     ImageIndex,
+  IN  CONST VOID                                *Image,
+  IN  UINTN                                     ImageSize,
+  IN  CONST VOID                                *VendorCode,
+  OUT CHAR16                                    **AbortReason
+  );
+
+/**
+  Check the progress of the update started by StartImage().
+
+  @param[in]  This         The EDKII_FIRMWARE_MANAGEMENT_ASYNC_PROTOCOL instance.
+  @param[out] Completion   The completion progress of the update, between 1
+                           and 100.
+  @param[out] AbortReason  A pointer to a pointer to a null-terminated string
+                           providing more details for the aborted operation.
+                           The buffer is allocated by this function with
+                           AllocatePool(), and it is the caller's
+                           responsibility to free it with a call to FreePool().
+
+  @retval EFI_NOT_READY    The update is still in progress.
+  @retval EFI_SUCCESS      The update is done.
+  @retval Others           The update failed. The status has the meaning of
+                           the same status returned by SetImage().
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_FIRMWARE_MANAGEMENT_ASYNC_POLL_IMAGE)(
+  IN  EDKII_FIRMWARE_MANAGEMENT_ASYNC_PROTOCOL  *This,
+  OUT UINTN                                     *Completion,
+  OUT CHAR16                                    **AbortReason
+  );
+
+///
+/// EDK II Firmware Management Async Protocol structure
+///
+struct _EDKII_FIRMWARE_MANAGEMENT_ASYNC_PROTOCOL {
+  EDKII_FIRMWARE_MANAGEMENT_ASYNC_START_IMAGE    StartImage;
+  EDKII_FIRMWARE_MANAGEMENT_ASYNC_POLL_IMAGE     PollImage;
+};
+
+///
+/// EDK II Firmware Management Async Protocol GUID variable.
+///
+extern EFI_GUID  gEdkiiFirmwareManagementAsyncProtocolGuid;
+
+#endif
@@ -0,0 +1,96 @@
+/** @file
+  EDK II HII Config Block Access Protocol.
+
+  The EFI_HII_CONFIG_ACCESS_PROTOCOL exchanges the settings of a driver as
+  <ConfigRequest> and <ConfigResp> strings, which encode every byte of a
+  buffer varstore as hex text that both the driver and the consumer have to
+  build and parse again. A driver may install this protocol on the driver
+  handle of its package list, next to the EFI_HII_CONFIG_ACCESS_PROTOCOL, to
+  give the Setup Browser access to its buffer varstores (EFI_IFR_VARSTORE) as
+  binary data.
+
+  The protocol is optional. A consumer uses the EFI_HII_CONFIG_ACCESS_PROTOCOL
+  when it is not installed or one of its services fails, so a driver still has
+  to produce the string based protocol for all its varstores.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef EDKII_HII_CONFIG_BLOCK_ACCESS_H_
+#define EDKII_HII_CONFIG_BLOCK_ACCESS_H_
+
+#define EDKII_HII_CONFIG_BLOCK_ACCESS_PROTOCOL_GUID \
+  { \
+    0x0a17f522, 0x9666, 0x4a1b, { 0x99, 0x5d, 0xc0, 0x5e, 0x75, 0x9e, 0xe4, 0xdd } \
+  }
+
+typedef struct _EDKII_HII_CONFIG_BLOCK_ACCESS_PROTOCOL EDKII_HII_CONFIG_BLOCK_ACCESS_PROTOCOL;
+
+/**
+  Read a range of the current settings of a buffer varstore.
+
+  @param[in]  This      The EDKII_HII_CONFIG_BLOCK_ACCESS_PROTOCOL instance.
+  @param[in]  Guid      The GUID of the varstore.
+  @param[in]  Name      The name of the varstore.
+  @param[in]  Offset    The offset of the range in the varstore.
+  @param[in]  Length    The length of the range in bytes.
+  @param[out] Buffer    The buffer that receives the range.
+
+  @retval EFI_SUCCESS            The range was read.
+  @retval EFI_NOT_FOUND          The driver has no buffer varstore with this
+                                 GUID and name.
+  @retval EFI_INVALID_PARAMETER  The range is not within the varstore.
+  @retval Others                 The settings could not be read.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_HII_CONFIG_BLOCK_ACCESS_EXTRACT)(
+  IN  EDKII_HII_CONFIG_BLOCK_ACCESS_PROTOCOL  *This,
+  IN  CONST EFI_GUID                          *Guid,
+  IN  CONST CHAR16                            *Name,
+  IN  UINTN                                   Offset,
+  IN  UINTN                                   Length,
+  OUT VOID                                    *Buffer
+  );
+
+/**
+  Apply new settings to a range of a buffer varstore, as the RouteConfig()
+  service of the EFI_HII_CONFIG_ACCESS_PROTOCOL would for a <ConfigResp>
+  holding this range.
+
+  @param[in]  This      The EDKII_HII_CONFIG_BLOCK_ACCESS_PROTOCOL instance.
+  @param[in]  Guid      The GUID of the varstore.
+  @param[in]  Name      The name of the varstore.
+  @param[in]  Offset    The offset of the range in the varstore.
+  @param[in]  Length    The length of the range in bytes.
+  @param[in]  Buffer    The new settings of the range.
+
+  @retval EFI_SUCCESS            The settings were applied.
+  @retval EFI_NOT_FOUND          The driver has no buffer varstore with this
+                                 GUID and name.
+  @retval EFI_INVALID_PARAMETER  The range is not within the varstore.
+  @retval Others                 The settings could not be applied.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_HII_CONFIG_BLOCK_ACCESS_ROUTE)(
+  IN EDKII_HII_CONFIG_BLOCK_ACCESS_PROTOCOL  *This,
+  IN CONST EFI_GUID                          *Guid,
+  IN CONST CHAR16                            *Name,
+  IN UINTN                                   Offset,
+  IN UINTN                                   Length,
+  IN CONST VOID                              *Buffer
+  );
+
+struct _EDKII_HII_CONFIG_BLOCK_ACCESS_PROTOCOL {
+  EDKII_HII_CONFIG_BLOCK_ACCESS_EXTRACT    ExtractBlock;
+  EDKII_HII_CONFIG_BLOCK_ACCESS_ROUTE      RouteBlock;
+};
+
+extern EFI_GUID  gEdkiiHiiConfigBlockAccessProtocolGuid;
+
+#endif
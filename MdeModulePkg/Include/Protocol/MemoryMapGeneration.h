@@ -0,0 +1,46 @@
+/** @file
+  EDK II Memory Map Generation Protocol.
+
+  The DXE Core produces this protocol to report a generation number of the UEFI
+  memory map. The number changes whenever the output of GetMemoryMap() may
+  change, so callers that keep a copy of the memory map can tell whether they
+  need to fetch it again.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __EDKII_MEMORY_MAP_GENERATION_H__
+#define __EDKII_MEMORY_MAP_GENERATION_H__
+
+#define EDKII_MEMORY_MAP_GENERATION_PROTOCOL_GUID \
+  { \
+    0x0f324580, 0xd035, 0x42d9, { 0xb6, 0x20, 0x7e, 0xaf, 0x9d, 0x13, 0x3d, 0x27 } \
+  }
+
+typedef struct _EDKII_MEMORY_MAP_GENERATION_PROTOCOL EDKII_MEMORY_MAP_GENERATION_PROTOCOL;
+
+/**
+  Return the current generation number of the UEFI memory map.
+
+  Two calls that return the same value are guaranteed to see the same memory
+  map from GetMemoryMap(). The value is never 0.
+
+  @param[in] This  The EDKII_MEMORY_MAP_GENERATION_PROTOCOL instance.
+
+  @return The current generation number of the memory map.
+**/
+typedef
+UINT64
+(EFIAPI *EDKII_MEMORY_MAP_GENERATION_GET)(
+  IN EDKII_MEMORY_MAP_GENERATION_PROTOCOL  *This
+  );
+
+struct _EDKII_MEMORY_MAP_GENERATION_PROTOCOL {
+  EDKII_MEMORY_MAP_GENERATION_GET    GetGeneration;
+};
+
+extern EFI_GUID  gEdkiiMemoryMapGenerationProtocolGuid;
+
+#endif
@@ -0,0 +1,78 @@
+/** @file
+  EDK II Network Checksum Offload Protocol.
+
+  A network stack layer produces this protocol on the handle it delivers
+  received packets from, to tell the layer above which checksums of those
+  packets the hardware has already verified. The layer above can then skip
+  verifying them in software. A producer with zero RxCapabilities never reports
+  a verified checksum.
+
+  The protocol is produced at each layer that forwards the information:
+
+  - A Simple Network Protocol driver installs it on its SNP handle. RxData is
+    the Buffer passed to the most recent successful call to
+    EFI_SIMPLE_NETWORK_PROTOCOL.Receive(), and the status must be queried
+    before Receive() is called again.
+  - The Managed Network driver installs it on its child handles. RxData is the
+    EFI_MANAGED_NETWORK_RECEIVE_DATA of a received token that has not been
+    recycled yet.
+  - The IPv4 driver installs it on its child handles. RxData is the
+    EFI_IP4_RECEIVE_DATA of a received token that has not been recycled yet.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef EDKII_NETWORK_CHECKSUM_OFFLOAD_H_
+#define EDKII_NETWORK_CHECKSUM_OFFLOAD_H_
+
+#define EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL_GUID \
+  { \
+    0xf71071d1, 0x8689, 0x4723, { 0x89, 0xad, 0x52, 0xbf, 0x0d, 0x40, 0xb1, 0x18 } \
+  }
+
+typedef struct _EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL;
+
+///
+/// The TCP or UDP checksum of the packet has been verified, or the packet did
+/// not need one. Packets failing the check are either dropped or reported
+/// without this flag.
+///
+#define EDKII_NETWORK_RX_CHECKSUM_L4_VALID  BIT0
+
+/**
+  Return which checksums of a received packet have already been verified.
+
+  @param[in]  This            The EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL
+                              instance.
+  @param[in]  RxData          The received packet, as described in the
+                              file header for each producer.
+  @param[out] ChecksumStatus  A combination of EDKII_NETWORK_RX_CHECKSUM_*
+                              flags. Zero if nothing was verified. Not
+                              modified on error.
+
+  @retval EFI_SUCCESS            ChecksumStatus was returned.
+  @retval EFI_INVALID_PARAMETER  RxData or ChecksumStatus is NULL.
+  @retval EFI_NOT_FOUND          RxData is not a packet the producer delivered
+                                 or it has been recycled.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_NETWORK_GET_RX_CHECKSUM_STATUS)(
+  IN  EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL  *This,
+  IN  VOID                                     *RxData,
+  OUT UINT32                                   *ChecksumStatus
+  );
+
+struct _EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL {
+  ///
+  /// The EDKII_NETWORK_RX_CHECKSUM_* flags the producer can report.
+  ///
+  UINT32                                  RxCapabilities;
+  EDKII_NETWORK_GET_RX_CHECKSUM_STATUS    GetRxChecksumStatus;
+};
+
+extern EFI_GUID  gEdkiiNetworkChecksumOffloadProtocolGuid;
+
+#endif
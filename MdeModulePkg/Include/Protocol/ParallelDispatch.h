@@ -0,0 +1,63 @@
+/** @file
+  EDK II Parallel Dispatch Protocol.
+
+  The DXE Core produces this protocol so that DXE drivers can hand slow
+  initialization work, such as polling hardware until it becomes ready, to
+  idle application processors while the DXE Dispatcher keeps starting other
+  drivers on the BSP. The DXE Dispatcher waits for all queued work to finish
+  before it reports that no more drivers can be dispatched.
+
+  Queued procedures run on an AP, or on the BSP if no AP is available, and
+  must follow the rules for EFI_AP_PROCEDURE: they must not call any UEFI Boot
+  Service or DXE Service, and must not touch data that the caller uses until
+  the work has completed.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef EDKII_PARALLEL_DISPATCH_H_
+#define EDKII_PARALLEL_DISPATCH_H_
+
+#include <Pi/PiMultiPhase.h>
+
+#define EDKII_PARALLEL_DISPATCH_PROTOCOL_GUID \
+  { \
+    0xe18f783c, 0x2d19, 0x4140, { 0x89, 0x07, 0x6a, 0x49, 0x80, 0xad, 0xb7, 0xe0 } \
+  }
+
+typedef struct _EDKII_PARALLEL_DISPATCH_PROTOCOL EDKII_PARALLEL_DISPATCH_PROTOCOL;
+
+/**
+  Queue a procedure to run in parallel with the DXE Dispatcher.
+
+  This function must be called at or below TPL_CALLBACK.
+
+  @param[in] This             The EDKII_PARALLEL_DISPATCH_PROTOCOL instance.
+  @param[in] Procedure        The procedure to run.
+  @param[in] Argument         The argument passed to Procedure.
+  @param[in] CompletionEvent  Optional event that is signaled on the BSP once
+                              Procedure has returned.
+
+  @retval EFI_SUCCESS            The procedure was queued.
+  @retval EFI_INVALID_PARAMETER  Procedure is NULL.
+  @retval EFI_OUT_OF_RESOURCES   There are not enough resources to queue the
+                                 procedure.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_PARALLEL_DISPATCH_QUEUE_PROCEDURE)(
+  IN EDKII_PARALLEL_DISPATCH_PROTOCOL  *This,
+  IN EFI_AP_PROCEDURE                  Procedure,
+  IN VOID                              *Argument OPTIONAL,
+  IN EFI_EVENT                         CompletionEvent OPTIONAL
+  );
+
+struct _EDKII_PARALLEL_DISPATCH_PROTOCOL {
+  EDKII_PARALLEL_DISPATCH_QUEUE_PROCEDURE    QueueProcedure;
+};
+
+extern EFI_GUID  gEdkiiParallelDispatchProtocolGuid;
+
+#endif
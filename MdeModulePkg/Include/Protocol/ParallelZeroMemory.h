@@ -0,0 +1,53 @@
+/** @file
+  EDK II Parallel Zero Memory Protocol.
+
+  Zeroing a large buffer on the BSP alone takes a long time on systems with a
+  lot of memory, for example when all free memory is cleared for a Memory
+  Overwrite Request. This protocol spreads the work over all enabled
+  processors.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef EDKII_PARALLEL_ZERO_MEMORY_H_
+#define EDKII_PARALLEL_ZERO_MEMORY_H_
+
+#define EDKII_PARALLEL_ZERO_MEMORY_PROTOCOL_GUID \
+  { \
+    0xd3bbd3ae, 0xe0f1, 0x4c57, { 0xab, 0x85, 0xbb, 0x63, 0x54, 0x05, 0xd1, 0x6b } \
+  }
+
+typedef struct _EDKII_PARALLEL_ZERO_MEMORY_PROTOCOL EDKII_PARALLEL_ZERO_MEMORY_PROTOCOL;
+
+/**
+  Fill a range of memory with zeros.
+
+  The range must be mapped and writable, and must not be used by anyone else
+  while it is cleared. Small ranges, and ranges cleared above TPL_CALLBACK,
+  are cleared on the calling processor only.
+
+  @param[in] This    The EDKII_PARALLEL_ZERO_MEMORY_PROTOCOL instance.
+  @param[in] Buffer  The start address of the range.
+  @param[in] Length  The length of the range in bytes.
+
+  @retval EFI_SUCCESS            The range was cleared.
+  @retval EFI_INVALID_PARAMETER  The range wraps around or is not addressable
+                                 by the processor.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_PARALLEL_ZERO_MEMORY)(
+  IN EDKII_PARALLEL_ZERO_MEMORY_PROTOCOL  *This,
+  IN EFI_PHYSICAL_ADDRESS                 Buffer,
+  IN UINT64                               Length
+  );
+
+struct _EDKII_PARALLEL_ZERO_MEMORY_PROTOCOL {
+  EDKII_PARALLEL_ZERO_MEMORY    ZeroMemory;
+};
+
+extern EFI_GUID  gEdkiiParallelZeroMemoryProtocolGuid;
+
+#endif
@@ -0,0 +1,96 @@
+/** @file
+  EDKII SMI Handler Attribute Protocol and EDKII SMM CPU AP Release Protocol.
+
+  The SMI Handler Attribute Protocol is produced by the SMM Core. It lets a
+  driver tell the SMM Core about the needs of a handler it registered with
+  SmiHandlerRegister().
+
+  The SMM CPU AP Release Protocol is produced by the SMM CPU driver. The SMM
+  Core uses it to let the APs leave SMM before the BSP is done with an SMI
+  that is handled by a handler needing only the BSP.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef SMI_HANDLER_ATTRIBUTE_H_
+#define SMI_HANDLER_ATTRIBUTE_H_
+
+#define EDKII_SMI_HANDLER_ATTRIBUTE_PROTOCOL_GUID \
+  { \
+    0x9c5dae1a, 0xd5d3, 0x4539, { 0x80, 0x63, 0xc0, 0x03, 0x40, 0xc6, 0xd2, 0xf4 } \
+  }
+
+#define EDKII_SMM_CPU_AP_RELEASE_PROTOCOL_GUID \
+  { \
+    0x055a0063, 0xec4a, 0x48b8, { 0xb4, 0xb0, 0x6b, 0x9b, 0xf2, 0x28, 0x7c, 0xe9 } \
+  }
+
+typedef struct _EDKII_SMI_HANDLER_ATTRIBUTE_PROTOCOL  EDKII_SMI_HANDLER_ATTRIBUTE_PROTOCOL;
+typedef struct _EDKII_SMM_CPU_AP_RELEASE_PROTOCOL     EDKII_SMM_CPU_AP_RELEASE_PROTOCOL;
+
+//
+// The handler only runs on the BSP and does not use the MP services, so the
+// APs may leave SMM as soon as the SMI is dispatched to the handler. Other
+// handlers that run later in the same SMI find the APs out of SMM.
+//
+#define EDKII_SMI_HANDLER_ATTRIBUTE_BSP_ONLY  BIT0
+
+/**
+  Set the attributes of an SMI handler.
+
+  Only handlers registered with a HandlerType can be given attributes, since
+  root SMI handlers run for every SMI.
+
+  @param[in]  This            The EDKII_SMI_HANDLER_ATTRIBUTE_PROTOCOL instance.
+  @param[in]  DispatchHandle  The handle returned by SmiHandlerRegister().
+  @param[in]  Attributes      The EDKII_SMI_HANDLER_ATTRIBUTE_* bit mask.
+
+  @retval EFI_SUCCESS            The attributes were set.
+  @retval EFI_INVALID_PARAMETER  DispatchHandle does not refer to a valid
+                                 handler, or refers to a root SMI handler.
+  @retval EFI_UNSUPPORTED        Attributes has an unknown bit set.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_SMI_HANDLER_SET_ATTRIBUTES)(
+  IN EDKII_SMI_HANDLER_ATTRIBUTE_PROTOCOL  *This,
+  IN EFI_HANDLE                            DispatchHandle,
+  IN UINT64                                Attributes
+  );
+
+struct _EDKII_SMI_HANDLER_ATTRIBUTE_PROTOCOL {
+  EDKII_SMI_HANDLER_SET_ATTRIBUTES    SetAttributes;
+};
+
+/**
+  Let the APs leave SMM before the BSP is done with the current SMI.
+
+  It must be called by the BSP. Once it succeeded, the MP services fail for the
+  rest of the SMI, as no AP is in SMM anymore.
+
+  @param[in]  This                The EDKII_SMM_CPU_AP_RELEASE_PROTOCOL instance.
+
+  @retval EFI_SUCCESS             The APs left SMM.
+  @retval EFI_ALREADY_STARTED     The APs already left SMM in the current SMI.
+  @retval EFI_NOT_READY           It was not called in an SMI.
+  @retval EFI_UNSUPPORTED         The APs have to stay in SMM till the BSP is
+                                  done with the current SMI.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_SMM_CPU_RELEASE_APS)(
+  IN EDKII_SMM_CPU_AP_RELEASE_PROTOCOL  *This
+  );
+
+struct _EDKII_SMM_CPU_AP_RELEASE_PROTOCOL {
+  EDKII_SMM_CPU_RELEASE_APS    ReleaseAps;
+};
+
+extern EFI_GUID  gEdkiiSmiHandlerAttributeProtocolGuid;
+extern EFI_GUID  gEdkiiSmmCpuApReleaseProtocolGuid;
+
+#endif
@@ -0,0 +1,78 @@
+/** @file
+  EDK II Timer Deadline Protocol.
+
+  A Timer Architectural Protocol driver may produce this protocol in addition to
+  EFI_TIMER_ARCH_PROTOCOL when it is able to deliver the timer interrupt at an
+  arbitrary point in time rather than at a fixed period. The DXE Core then tells
+  the driver when the next timer event is due, so that no timer interrupts need
+  to be taken while nothing is waiting for them.
+
+  All times are in 100ns units and are relative to the last call the driver made
+  to the EFI_TIMER_NOTIFY function registered through
+  EFI_TIMER_ARCH_PROTOCOL.RegisterHandler(). The Duration passed to that
+  function must be the time that actually elapsed since the previous call.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef EDKII_TIMER_DEADLINE_H_
+#define EDKII_TIMER_DEADLINE_H_
+
+#define EDKII_TIMER_DEADLINE_PROTOCOL_GUID \
+  { \
+    0x9597b8ad, 0x9674, 0x4592, { 0xa2, 0x51, 0xc4, 0x84, 0x1c, 0x8c, 0x5f, 0x06 } \
+  }
+
+typedef struct _EDKII_TIMER_DEADLINE_PROTOCOL EDKII_TIMER_DEADLINE_PROTOCOL;
+
+/**
+  Set the time at which the timer notify function must be called next.
+
+  The driver must call the notify function no later than Deadline, but may call
+  it earlier, for example because the hardware cannot represent the interval.
+  This function is called at TPL_HIGH_LEVEL.
+
+  @param[in] This      The EDKII_TIMER_DEADLINE_PROTOCOL instance.
+  @param[in] Deadline  The time, relative to the last call to the notify
+                       function, at which the next timer event is due.
+                       MAX_UINT64 if no timer event is pending.
+
+  @retval EFI_SUCCESS       The deadline was programmed.
+  @retval EFI_NOT_READY     The timer interrupt is currently disabled.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_TIMER_SET_DEADLINE)(
+  IN EDKII_TIMER_DEADLINE_PROTOCOL  *This,
+  IN UINT64                         Deadline
+  );
+
+/**
+  Return the time that elapsed since the last call to the notify function.
+
+  This function is called at TPL_HIGH_LEVEL.
+
+  @param[in]  This         The EDKII_TIMER_DEADLINE_PROTOCOL instance.
+  @param[out] ElapsedTime  The time elapsed since the last call to the notify
+                           function.
+
+  @retval EFI_SUCCESS            The elapsed time was returned.
+  @retval EFI_INVALID_PARAMETER  ElapsedTime is NULL.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_TIMER_GET_ELAPSED_TIME)(
+  IN  EDKII_TIMER_DEADLINE_PROTOCOL  *This,
+  OUT UINT64                         *ElapsedTime
+  );
+
+struct _EDKII_TIMER_DEADLINE_PROTOCOL {
+  EDKII_TIMER_SET_DEADLINE        SetDeadline;
+  EDKII_TIMER_GET_ELAPSED_TIME    GetElapsedTime;
+};
+
+extern EFI_GUID  gEdkiiTimerDeadlineProtocolGuid;
+
+#endif
@@ -0,0 +1,68 @@
+/** @file
+  Variable Batch Protocol is related to EDK II-specific implementation of variables
+  and intended for use as a means to submit a number of variable updates in a single
+  call, so that an SMM based variable driver can service all of them in one SMI.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __VARIABLE_BATCH_H__
+#define __VARIABLE_BATCH_H__
+
+#define EDKII_VARIABLE_BATCH_PROTOCOL_GUID \
+  { \
+    0x476dec3a, 0x7770, 0x4bce, { 0x85, 0xc2, 0xeb, 0x69, 0x92, 0xf3, 0x91, 0xf7 } \
+  }
+
+typedef struct _EDKII_VARIABLE_BATCH_PROTOCOL EDKII_VARIABLE_BATCH_PROTOCOL;
+
+///
+/// One variable update of a batch. The input fields have the same meaning as
+/// the parameters of EFI_SET_VARIABLE. Status receives the result of this update.
+///
+typedef struct {
+  CHAR16        *VariableName;
+  EFI_GUID      *VendorGuid;
+  UINT32        Attributes;
+  UINTN         DataSize;
+  VOID          *Data;
+  EFI_STATUS    Status;
+} EDKII_VARIABLE_BATCH_ENTRY;
+
+/**
+  Set a number of variables in one request.
+
+  The entries are processed in order and each of them is checked exactly as if it
+  was passed to SetVariable(), including the VarCheck and variable policy checks.
+  A failing entry does not stop the processing of the entries following it.
+
+  @param[in]      This          The EDKII_VARIABLE_BATCH_PROTOCOL instance.
+  @param[in]      EntryCount    Number of entries in Entries.
+  @param[in, out] Entries       The variable updates. On return, the Status field
+                                of each entry holds the result of that update.
+
+  @retval EFI_SUCCESS           All the variable updates succeeded.
+  @retval EFI_INVALID_PARAMETER EntryCount is 0 or Entries is NULL.
+  @retval Others                The Status of the first entry that failed.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_VARIABLE_BATCH_PROTOCOL_SET_VARIABLES)(
+  IN CONST EDKII_VARIABLE_BATCH_PROTOCOL  *This,
+  IN       UINTN                          EntryCount,
+  IN OUT   EDKII_VARIABLE_BATCH_ENTRY     *Entries
+  );
+
+///
+/// Variable Batch Protocol is related to EDK II-specific implementation of variables
+/// and intended for use as a means to submit a number of variable updates at once.
+///
+struct _EDKII_VARIABLE_BATCH_PROTOCOL {
+  EDKII_VARIABLE_BATCH_PROTOCOL_SET_VARIABLES    SetVariables;
+};
+
+extern EFI_GUID  gEdkiiVariableBatchProtocolGuid;
+
+#endif
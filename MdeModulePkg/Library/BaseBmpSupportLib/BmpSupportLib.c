@@ -343,81 +343,86 @@ TranslateBmpToGopBlt (
   BltBuffer = *GopBlt;
   for (Height = 0; Height < BmpHeader->PixelHeight; Height++) {
     Blt = &BltBuffer[(BmpHeader->PixelHeight - Height - 1) * BmpHeader->PixelWidth];
-    for (Width = 0; Width < BmpHeader->PixelWidth; Width++, Image++, Blt++) {
-      switch (BmpHeader->BitPerPixel) {
-        case 1:
-          //
-          // Translate 1-bit (2 colors) BMP to 24-bit color
-          //
-          for (Index = 0; Index < 8 && Width < BmpHeader->PixelWidth; Index++) {
-            Blt->Red   = BmpColorMap[((*Image) >> (7 - Index)) & 0x1].Red;
-            Blt->Green = BmpColorMap[((*Image) >> (7 - Index)) & 0x1].Green;
-            Blt->Blue  = BmpColorMap[((*Image) >> (7 - Index)) & 0x1].Blue;
-            Blt++;
-            Width++;
-          }
-
-          Blt--;
-          Width--;
-          break;
-
-        case 4:
-          //
-          // Translate 4-bit (16 colors) BMP Palette to 24-bit color
-          //
-          Index      = (*Image) >> 4;
-          Blt->Red   = BmpColorMap[Index].Red;
-          Blt->Green = BmpColorMap[Index].Green;
-          Blt->Blue  = BmpColorMap[Index].Blue;
-          if (Width < (BmpHeader->PixelWidth - 1)) {
-            Blt++;
-            Width++;
-            Index      = (*Image) & 0x0f;
+
+    //
+    // Logos are usually true color images, translate their rows without
+    // going through the per pixel switch below
+    //
+    if (BmpHeader->BitPerPixel == 24) {
+      for (Width = 0; Width < BmpHeader->PixelWidth; Width++, Image += 3, Blt++) {
+        Blt->Blue  = Image[0];
+        Blt->Green = Image[1];
+        Blt->Red   = Image[2];
+      }
+    } else if (BmpHeader->BitPerPixel == 32) {
+      //
+      // Ignore the final byte of each pixel
+      //
+      for (Width = 0; Width < BmpHeader->PixelWidth; Width++, Image += 4, Blt++) {
+        Blt->Blue  = Image[0];
+        Blt->Green = Image[1];
+        Blt->Red   = Image[2];
+      }
+    } else {
+      for (Width = 0; Width < BmpHeader->PixelWidth; Width++, Image++, Blt++) {
+        switch (BmpHeader->BitPerPixel) {
+          case 1:
+            //
+            // Translate 1-bit (2 colors) BMP to 24-bit color
+            //
+            for (Index = 0; Index < 8 && Width < BmpHeader->PixelWidth; Index++) {
+              Blt->Red   = BmpColorMap[((*Image) >> (7 - Index)) & 0x1].Red;
+              Blt->Green = BmpColorMap[((*Image) >> (7 - Index)) & 0x1].Green;
+              Blt->Blue  = BmpColorMap[((*Image) >> (7 - Index)) & 0x1].Blue;
+              Blt++;
+              Width++;
+            }
+
+            Blt--;
+            Width--;
+            break;
+
+          case 4:
+            //
+            // Translate 4-bit (16 colors) BMP Palette to 24-bit color
+            //
+            Index      = (*Image) >> 4;
             Blt->Red   = BmpColorMap[Index].Red;
             Blt->Green = BmpColorMap[Index].Green;
             Blt->Blue  = BmpColorMap[Index].Blue;
-          }
-
-          break;
-
-        case 8:
-          //
-          // Translate 8-bit (256 colors) BMP Palette to 24-bit color
-          //
-          Blt->Red   = BmpColorMap[*Image].Red;
-          Blt->Green = BmpColorMap[*Image].Green;
-          Blt->Blue  = BmpColorMap[*Image].Blue;
-          break;
-
-        case 24:
-          //
-          // It is 24-bit BMP.
-          //
-          Blt->Blue  = *Image++;
-          Blt->Green = *Image++;
-          Blt->Red   = *Image;
-          break;
-
-        case 32:
-          //
-          // Conver 32 bit to 24bit bmp - just ignore the final byte of each pixel
-          Blt->Blue  = *Image++;
-          Blt->Green = *Image++;
-          Blt->Red   = *Image++;
-          break;
-
-        default:
-          //
-          // Other bit format BMP is not supported.
-          //
-          if (IsAllocated) {
-            FreePool (*GopBlt);
-            *GopBlt = NULL;
-          }
-
-          DEBUG ((DEBUG_ERROR, "Bmp Bit format not supported.  0x%X\n", BmpHeader->BitPerPixel));
-          return RETURN_UNSUPPORTED;
-          break;
+            if (Width < (BmpHeader->PixelWidth - 1)) {
+              Blt++;
+              Width++;
+              Index      = (*Image) & 0x0f;
+              Blt->Red   = BmpColorMap[Index].Red;
+              Blt->Green = BmpColorMap[Index].Green;
+              Blt->Blue  = BmpColorMap[Index].Blue;
+            }
+
+            break;
+
+          case 8:
+            //
+            // Translate 8-bit (256 colors) BMP Palette to 24-bit color
+            //
+            Blt->Red   = BmpColorMap[*Image].Red;
+            Blt->Green = BmpColorMap[*Image].Green;
+            Blt->Blue  = BmpColorMap[*Image].Blue;
+            break;
+
+          default:
+            //
+            // Other bit format BMP is not supported.
+            //
+            if (IsAllocated) {
+              FreePool (*GopBlt);
+              *GopBlt = NULL;
+            }
+
+            DEBUG ((DEBUG_ERROR, "Bmp Bit format not supported.  0x%X\n", BmpHeader->BitPerPixel));
+            return RETURN_UNSUPPORTED;
+            break;
+        }
       }
     }
 
@@ -0,0 +1,334 @@
+/** @file
+  Chunked GUIDed Section Extraction Library.
+
+  It registers the handlers of the chunked GUIDed section, whose data is a
+  sequence of independently encoded GUIDed sections. Each of these chunks is
+  decoded through the handler registered for its own GUID, into consecutive
+  parts of the output buffer.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiPei.h>
+#include <Guid/ChunkedSection.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/ExtractGuidedSectionLib.h>
+
+/**
+  Get the data of a chunked section and check its header.
+
+  @param  InputSection  Buffer containing the chunked GUIDed section.
+  @param  Header        Returns the header of the section data.
+  @param  DataSize      Returns the size of the section data.
+
+  @retval RETURN_SUCCESS            The header of the section data is valid.
+  @retval RETURN_UNSUPPORTED        The GUID of InputSection is not the chunked
+                                    section GUID.
+  @retval RETURN_INVALID_PARAMETER  The header of the section data is invalid.
+
+**/
+STATIC
+RETURN_STATUS
+ChunkedSectionGetData (
+  IN  CONST VOID                    *InputSection,
+  OUT EDKII_CHUNKED_SECTION_HEADER  **Header,
+  OUT UINT32                        *DataSize
+  )
+{
+  if (IS_SECTION2 (InputSection)) {
+    if (!CompareGuid (
+           &gEdkiiChunkedSectionGuid,
+           &(((EFI_GUID_DEFINED_SECTION2 *)InputSection)->SectionDefinitionGuid)
+           ))
+    {
+      return RETURN_UNSUPPORTED;
+    }
+
+    *Header   = (EDKII_CHUNKED_SECTION_HEADER *)((UINT8 *)InputSection + ((EFI_GUID_DEFINED_SECTION2 *)InputSection)->DataOffset);
+    *DataSize = SECTION2_SIZE (InputSection) - ((EFI_GUID_DEFINED_SECTION2 *)InputSection)->DataOffset;
+  } else {
+    if (!CompareGuid (
+           &gEdkiiChunkedSectionGuid,
+           &(((EFI_GUID_DEFINED_SECTION *)InputSection)->SectionDefinitionGuid)
+           ))
+    {
+      return RETURN_UNSUPPORTED;
+    }
+
+    *Header   = (EDKII_CHUNKED_SECTION_HEADER *)((UINT8 *)InputSection + ((EFI_GUID_DEFINED_SECTION *)InputSection)->DataOffset);
+    *DataSize = SECTION_SIZE (InputSection) - ((EFI_GUID_DEFINED_SECTION *)InputSection)->DataOffset;
+  }
+
+  if ((*DataSize < sizeof (EDKII_CHUNKED_SECTION_HEADER)) ||
+      ((*Header)->Signature != EDKII_CHUNKED_SECTION_SIGNATURE) ||
+      ((*Header)->DecodedSize > MAX_UINT32))
+  {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  return RETURN_SUCCESS;
+}
+
+/**
+  Get the next chunk of a chunked section.
+
+  @param  Header    The header of the section data.
+  @param  DataSize  The size of the section data.
+  @param  Offset    On input, the offset of the end of the previous chunk
+                    from Header. On output, the offset of the end of the
+                    returned chunk.
+  @param  Chunk     Returns the GUIDed section of the chunk.
+
+  @retval RETURN_SUCCESS            The chunk is returned.
+  @retval RETURN_INVALID_PARAMETER  The chunk does not fit in the section data.
+
+**/
+STATIC
+RETURN_STATUS
+ChunkedSectionGetNextChunk (
+  IN     CONST EDKII_CHUNKED_SECTION_HEADER  *Header,
+  IN     UINT32                              DataSize,
+  IN OUT UINT32                              *Offset,
+  OUT    CONST VOID                          **Chunk
+  )
+{
+  UINT32  ChunkOffset;
+  UINT32  ChunkSize;
+
+  ChunkOffset = ALIGN_VALUE (*Offset, 4);
+  if ((ChunkOffset > DataSize) || (DataSize - ChunkOffset < sizeof (EFI_COMMON_SECTION_HEADER2))) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  *Chunk = (UINT8 *)Header + ChunkOffset;
+  if (IS_SECTION2 (*Chunk)) {
+    ChunkSize = SECTION2_SIZE (*Chunk);
+  } else {
+    ChunkSize = SECTION_SIZE (*Chunk);
+  }
+
+  if ((ChunkSize < sizeof (EFI_GUID_DEFINED_SECTION)) || (ChunkSize > DataSize - ChunkOffset)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  *Offset = ChunkOffset + ChunkSize;
+  return RETURN_SUCCESS;
+}
+
+/**
+  Examines a GUIDed section and returns the size of the decoded buffer and the
+  size of an scratch buffer required to actually decode the data in a GUIDed section.
+
+  Examines a GUIDed section specified by InputSection.
+  If GUID for InputSection does not match the GUID that this handler supports,
+  then RETURN_UNSUPPORTED is returned.
+  If the required information can not be retrieved from InputSection,
+  then RETURN_INVALID_PARAMETER is returned.
+  If the GUID of InputSection does match the GUID that this handler supports,
+  then the size required to hold the decoded buffer is returned in OututBufferSize,
+  the size of an optional scratch buffer is returned in ScratchSize, and the Attributes field
+  from EFI_GUID_DEFINED_SECTION header of InputSection is returned in SectionAttribute.
+
+  The scratch buffer is large enough for decoding any one of the chunks.
+
+  If InputSection is NULL, then ASSERT().
+  If OutputBufferSize is NULL, then ASSERT().
+  If ScratchBufferSize is NULL, then ASSERT().
+  If SectionAttribute is NULL, then ASSERT().
+
+  @param[in]  InputSection       A pointer to a GUIDed section of an FFS formatted file.
+  @param[out] OutputBufferSize   A pointer to the size, in bytes, of an output buffer required
+                                 if the buffer specified by InputSection were decoded.
+  @param[out] ScratchBufferSize  A pointer to the size, in bytes, required as scratch space
+                                 if the buffer specified by InputSection were decoded.
+  @param[out] SectionAttribute   A pointer to the attributes of the GUIDed section. See the Attributes
+                                 field of EFI_GUID_DEFINED_SECTION in the PI Specification.
+
+  @retval  RETURN_SUCCESS            The information about InputSection was returned.
+  @retval  RETURN_UNSUPPORTED        The section specified by InputSection does not match the GUID this handler supports.
+  @retval  RETURN_INVALID_PARAMETER  The information can not be retrieved from the section specified by InputSection.
+
+**/
+RETURN_STATUS
+EFIAPI
+ChunkedGuidedSectionGetInfo (
+  IN  CONST VOID  *InputSection,
+  OUT UINT32      *OutputBufferSize,
+  OUT UINT32      *ScratchBufferSize,
+  OUT UINT16      *SectionAttribute
+  )
+{
+  RETURN_STATUS                 Status;
+  EDKII_CHUNKED_SECTION_HEADER  *Header;
+  UINT32                        DataSize;
+  UINT32                        Offset;
+  UINT32                        Index;
+  CONST VOID                    *Chunk;
+  UINT32                        ChunkOutputSize;
+  UINT32                        ChunkScratchSize;
+  UINT16                        ChunkAttribute;
+  UINT64                        DecodedSize;
+
+  ASSERT (InputSection != NULL);
+  ASSERT (OutputBufferSize != NULL);
+  ASSERT (ScratchBufferSize != NULL);
+  ASSERT (SectionAttribute != NULL);
+
+  Status = ChunkedSectionGetData (InputSection, &Header, &DataSize);
+  if (RETURN_ERROR (Status)) {
+    return Status;
+  }
+
+  if (IS_SECTION2 (InputSection)) {
+    *SectionAttribute = ((EFI_GUID_DEFINED_SECTION2 *)InputSection)->Attributes;
+  } else {
+    *SectionAttribute = ((EFI_GUID_DEFINED_SECTION *)InputSection)->Attributes;
+  }
+
+  *ScratchBufferSize = 0;
+  DecodedSize        = 0;
+  Offset             = sizeof (EDKII_CHUNKED_SECTION_HEADER);
+  for (Index = 0; Index < Header->ChunkCount; Index++) {
+    Status = ChunkedSectionGetNextChunk (Header, DataSize, &Offset, &Chunk);
+    if (RETURN_ERROR (Status)) {
+      return Status;
+    }
+
+    Status = ExtractGuidedSectionGetInfo (Chunk, &ChunkOutputSize, &ChunkScratchSize, &ChunkAttribute);
+    if (RETURN_ERROR (Status)) {
+      return RETURN_INVALID_PARAMETER;
+    }
+
+    DecodedSize       += ChunkOutputSize;
+    *ScratchBufferSize = MAX (*ScratchBufferSize, ChunkScratchSize);
+  }
+
+  if (DecodedSize != Header->DecodedSize) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  *OutputBufferSize = (UINT32)DecodedSize;
+  return RETURN_SUCCESS;
+}
+
+/**
+  Decompress a chunked GUIDed section into a caller allocated output buffer.
+
+  Decodes the GUIDed section specified by InputSection.
+  If GUID for InputSection does not match the GUID that this handler supports, then RETURN_UNSUPPORTED is returned.
+  If the data in InputSection can not be decoded, then RETURN_INVALID_PARAMETER is returned.
+  If the GUID of InputSection does match the GUID that this handler supports, then InputSection
+  is decoded into the buffer specified by OutputBuffer and the authentication status of this
+  decode operation is returned in AuthenticationStatus.
+
+  The chunks are decoded one after the other, in the order in which they are
+  laid out in the section.
+
+  If InputSection is NULL, then ASSERT().
+  If OutputBuffer is NULL, then ASSERT().
+  If ScratchBuffer is NULL and this decode operation requires a scratch buffer, then ASSERT().
+  If AuthenticationStatus is NULL, then ASSERT().
+
+  @param[in]  InputSection  A pointer to a GUIDed section of an FFS formatted file.
+  @param[out] OutputBuffer  A pointer to a buffer that contains the result of a decode operation.
+  @param[out] ScratchBuffer A caller allocated buffer that may be required by this function
+                            as a scratch buffer to perform the decode operation.
+  @param[out] AuthenticationStatus
+                            A pointer to the authentication status of the decoded output buffer.
+                            See the definition of authentication status in the EFI_PEI_GUIDED_SECTION_EXTRACTION_PPI
+                            section of the PI Specification. EFI_AUTH_STATUS_PLATFORM_OVERRIDE must
+                            never be set by this handler.
+
+  @retval  RETURN_SUCCESS            The buffer specified by InputSection was decoded.
+  @retval  RETURN_UNSUPPORTED        The section specified by InputSection does not match the GUID this handler supports.
+  @retval  RETURN_INVALID_PARAMETER  The section specified by InputSection can not be decoded.
+
+**/
+RETURN_STATUS
+EFIAPI
+ChunkedGuidedSectionExtraction (
+  IN CONST  VOID    *InputSection,
+  OUT       VOID    **OutputBuffer,
+  IN        VOID    *ScratchBuffer         OPTIONAL,
+  OUT       UINT32  *AuthenticationStatus
+  )
+{
+  RETURN_STATUS                 Status;
+  EDKII_CHUNKED_SECTION_HEADER  *Header;
+  UINT32                        DataSize;
+  UINT32                        Offset;
+  UINT32                        Index;
+  CONST VOID                    *Chunk;
+  UINT32                        ChunkOutputSize;
+  UINT32                        ChunkScratchSize;
+  UINT16                        ChunkAttribute;
+  UINT32                        ChunkAuthenticationStatus;
+  UINT8                         *Output;
+  VOID                          *ChunkOutput;
+
+  ASSERT (OutputBuffer != NULL);
+  ASSERT (InputSection != NULL);
+  ASSERT (AuthenticationStatus != NULL);
+
+  Status = ChunkedSectionGetData (InputSection, &Header, &DataSize);
+  if (RETURN_ERROR (Status)) {
+    return Status;
+  }
+
+  *AuthenticationStatus = 0;
+  Output                = *OutputBuffer;
+  Offset                = sizeof (EDKII_CHUNKED_SECTION_HEADER);
+  for (Index = 0; Index < Header->ChunkCount; Index++) {
+    Status = ChunkedSectionGetNextChunk (Header, DataSize, &Offset, &Chunk);
+    if (RETURN_ERROR (Status)) {
+      return Status;
+    }
+
+    Status = ExtractGuidedSectionGetInfo (Chunk, &ChunkOutputSize, &ChunkScratchSize, &ChunkAttribute);
+    if (RETURN_ERROR (Status)) {
+      return RETURN_INVALID_PARAMETER;
+    }
+
+    ChunkOutput = Output;
+    Status      = ExtractGuidedSectionDecode (Chunk, &ChunkOutput, ScratchBuffer, &ChunkAuthenticationStatus);
+    if (RETURN_ERROR (Status)) {
+      return RETURN_INVALID_PARAMETER;
+    }
+
+    //
+    // Handlers that do not need processing return the data in place.
+    //
+    if (ChunkOutput != Output) {
+      CopyMem (Output, ChunkOutput, ChunkOutputSize);
+    }
+
+    *AuthenticationStatus |= ChunkAuthenticationStatus;
+    Output                += ChunkOutputSize;
+  }
+
+  return RETURN_SUCCESS;
+}
+
+/**
+  Register ChunkedGuidedSectionGetInfo and ChunkedGuidedSectionExtraction
+  handlers with gEdkiiChunkedSectionGuid.
+
+  @retval  RETURN_SUCCESS            Register successfully.
+  @retval  RETURN_OUT_OF_RESOURCES   No enough memory to store this handler.
+**/
+RETURN_STATUS
+EFIAPI
+ChunkedSectionExtractLibConstructor (
+  VOID
+  )
+{
+  return ExtractGuidedSectionRegisterHandlers (
+           &gEdkiiChunkedSectionGuid,
+           ChunkedGuidedSectionGetInfo,
+           ChunkedGuidedSectionExtraction
+           );
+}
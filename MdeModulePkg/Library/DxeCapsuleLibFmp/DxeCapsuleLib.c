@@ -40,8 +40,28 @@
 #include <Protocol/EsrtManagement.h>
 #include <Protocol/FirmwareManagement.h>
 #include <Protocol/FirmwareManagementProgress.h>
+#include <Protocol/FirmwareManagementAsync.h>
 #include <Protocol/DevicePath.h>
 
+//
+// The interval in microseconds at which the asynchronous FMP updates are polled
+//
+#define FMP_ASYNC_UPDATE_POLL_INTERVAL  100000
+
+//
+// An FMP update started through the EDK II Firmware Management Async Protocol
+//
+typedef struct {
+  LIST_ENTRY                                      Link;
+  EFI_HANDLE                                      Handle;
+  EDKII_FIRMWARE_MANAGEMENT_ASYNC_PROTOCOL        *FmpAsync;
+  EFI_FIRMWARE_MANAGEMENT_CAPSULE_IMAGE_HEADER    *ImageHeader;
+  UINTN                                           PayloadIndex;
+  BOOLEAN                                         ResetRequired;
+  BOOLEAN                                         Done;
+  UINTN                                           Completion;
+} FMP_ASYNC_UPDATE;
+
 EFI_SYSTEM_RESOURCE_TABLE  *mEsrtTable = NULL;
 
 BOOLEAN    mDxeCapsuleLibEndOfDxe      = FALSE;
@@ -912,6 +932,42 @@ GetFmpImageInfoDescriptorVer (
   return FmpImageInfoDescriptorVer;
 }
 
+/**
+  Get the image and the vendor code of an FMP payload.
+
+  @param[in]  ImageHeader   The payload image header.
+  @param[out] Image         The image of the payload.
+  @param[out] VendorCode    The vendor code of the payload, or NULL.
+**/
+VOID
+GetFmpImageData (
+  IN  EFI_FIRMWARE_MANAGEMENT_CAPSULE_IMAGE_HEADER  *ImageHeader,
+  OUT UINT8                                         **Image,
+  OUT VOID                                          **VendorCode
+  )
+{
+  if (ImageHeader->Version >= EFI_FIRMWARE_MANAGEMENT_CAPSULE_IMAGE_HEADER_INIT_VERSION) {
+    *Image = (UINT8 *)(ImageHeader + 1);
+  } else {
+    //
+    // If the EFI_FIRMWARE_MANAGEMENT_CAPSULE_IMAGE_HEADER is version 1,
+    // Header should exclude UpdateHardwareInstance field, and
+    // ImageCapsuleSupport field if version is 2.
+    //
+    if (ImageHeader->Version == 1) {
+      *Image = (UINT8 *)ImageHeader + OFFSET_OF (EFI_FIRMWARE_MANAGEMENT_CAPSULE_IMAGE_HEADER, UpdateHardwareInstance);
+    } else {
+      *Image = (UINT8 *)ImageHeader + OFFSET_OF (EFI_FIRMWARE_MANAGEMENT_CAPSULE_IMAGE_HEADER, ImageCapsuleSupport);
+    }
+  }
+
+  if (ImageHeader->UpdateVendorCodeSize == 0) {
+    *VendorCode = NULL;
+  } else {
+    *VendorCode = *Image + ImageHeader->UpdateImageSize;
+  }
+}
+
 /**
   Set FMP image data.
 
@@ -957,26 +1013,7 @@ SetFmpImageData (
     mFmpProgress = NULL;
   }
 
-  if (ImageHeader->Version >= EFI_FIRMWARE_MANAGEMENT_CAPSULE_IMAGE_HEADER_INIT_VERSION) {
-    Image = (UINT8 *)(ImageHeader + 1);
-  } else {
-    //
-    // If the EFI_FIRMWARE_MANAGEMENT_CAPSULE_IMAGE_HEADER is version 1,
-    // Header should exclude UpdateHardwareInstance field, and
-    // ImageCapsuleSupport field if version is 2.
-    //
-    if (ImageHeader->Version == 1) {
-      Image = (UINT8 *)ImageHeader + OFFSET_OF (EFI_FIRMWARE_MANAGEMENT_CAPSULE_IMAGE_HEADER, UpdateHardwareInstance);
-    } else {
-      Image = (UINT8 *)ImageHeader + OFFSET_OF (EFI_FIRMWARE_MANAGEMENT_CAPSULE_IMAGE_HEADER, ImageCapsuleSupport);
-    }
-  }
-
-  if (ImageHeader->UpdateVendorCodeSize == 0) {
-    VendorCode = NULL;
-  } else {
-    VendorCode = Image + ImageHeader->UpdateImageSize;
-  }
+  GetFmpImageData (ImageHeader, &Image, &VendorCode);
 
   AbortReason = NULL;
   DEBUG ((DEBUG_INFO, "Fmp->SetImage ...\n"));
@@ -1180,6 +1217,212 @@ RecordFmpCapsuleStatus (
   }
 }
 
+/**
+  Start an FMP update through the EDK II Firmware Management Async Protocol.
+
+  @param[in]  FmpAsync         The EDK II Firmware Management Async Protocol of the FMP handle.
+  @param[in]  Handle           A FMP handle.
+  @param[in]  ImageHeader      The payload image header.
+  @param[in]  PayloadIndex     The index of the payload.
+  @param[in]  ResetRequired    Whether the FMP instance requires a reset after the update.
+  @param[in]  AsyncUpdateList  The list of started asynchronous updates.
+
+  @retval EFI_SUCCESS           The update was started and added to AsyncUpdateList.
+  @retval EFI_OUT_OF_RESOURCES  Not enough memory.
+  @return The status of FmpAsync->StartImage.
+**/
+EFI_STATUS
+StartFmpImageDataAsync (
+  IN EDKII_FIRMWARE_MANAGEMENT_ASYNC_PROTOCOL      *FmpAsync,
+  IN EFI_HANDLE                                    Handle,
+  IN EFI_FIRMWARE_MANAGEMENT_CAPSULE_IMAGE_HEADER  *ImageHeader,
+  IN UINTN                                         PayloadIndex,
+  IN BOOLEAN                                       ResetRequired,
+  IN LIST_ENTRY                                    *AsyncUpdateList
+  )
+{
+  EFI_STATUS        Status;
+  FMP_ASYNC_UPDATE  *AsyncUpdate;
+  UINT8             *Image;
+  VOID              *VendorCode;
+  CHAR16            *AbortReason;
+
+  AsyncUpdate = AllocateZeroPool (sizeof (FMP_ASYNC_UPDATE));
+  if (AsyncUpdate == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  GetFmpImageData (ImageHeader, &Image, &VendorCode);
+
+  AbortReason = NULL;
+  DEBUG ((DEBUG_INFO, "FmpAsync->StartImage ...\n"));
+  DEBUG ((DEBUG_INFO, "ImageTypeId - %g, ", &ImageHeader->UpdateImageTypeId));
+  DEBUG ((DEBUG_INFO, "PayloadIndex - 0x%x, ", PayloadIndex));
+  DEBUG ((DEBUG_INFO, "ImageIndex - 0x%x\n", ImageHeader->UpdateImageIndex));
+
+  Status = FmpAsync->StartImage (
+                       FmpAsync,
+                       ImageHeader->UpdateImageIndex,
+                       Image,
+                       ImageHeader->UpdateImageSize,
+                       VendorCode,
+                       &AbortReason
+                       );
+  DEBUG ((DEBUG_INFO, "FmpAsync->StartImage - %r\n", Status));
+  if (AbortReason != NULL) {
+    DEBUG ((DEBUG_ERROR, "%s\n", AbortReason));
+    FreePool (AbortReason);
+  }
+
+  if (EFI_ERROR (Status)) {
+    FreePool (AsyncUpdate);
+    return Status;
+  }
+
+  AsyncUpdate->Handle        = Handle;
+  AsyncUpdate->FmpAsync      = FmpAsync;
+  AsyncUpdate->ImageHeader   = ImageHeader;
+  AsyncUpdate->PayloadIndex  = PayloadIndex;
+  AsyncUpdate->ResetRequired = ResetRequired;
+  InsertTailList (AsyncUpdateList, &AsyncUpdate->Link);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Return if an asynchronous FMP update of a handle is in progress.
+
+  @param[in] Handle           A FMP handle.
+  @param[in] AsyncUpdateList  The list of started asynchronous updates.
+
+  @retval TRUE  An update of the handle is in progress.
+  @retval FALSE No update of the handle is in progress.
+**/
+BOOLEAN
+IsFmpAsyncUpdatePending (
+  IN EFI_HANDLE  Handle,
+  IN LIST_ENTRY  *AsyncUpdateList
+  )
+{
+  LIST_ENTRY        *Link;
+  FMP_ASYNC_UPDATE  *AsyncUpdate;
+
+  for (Link = GetFirstNode (AsyncUpdateList); !IsNull (AsyncUpdateList, Link); Link = GetNextNode (AsyncUpdateList, Link)) {
+    AsyncUpdate = BASE_CR (Link, FMP_ASYNC_UPDATE, Link);
+    if (!AsyncUpdate->Done && (AsyncUpdate->Handle == Handle)) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Wait for all asynchronous FMP updates to finish, and record their status.
+
+  The progress bar shows the average completion of the updates.
+
+  @param[in]  CapsuleHeader    The capsule image header.
+  @param[in]  CapFileName      Capsule file name.
+  @param[in]  AsyncUpdateList  The list of started asynchronous updates. It
+                               is empty on return.
+  @param[out] ResetRequired    Indicates whether reset is required or not.
+**/
+VOID
+WaitFmpImageDataAsync (
+  IN  EFI_CAPSULE_HEADER  *CapsuleHeader,
+  IN  CHAR16              *CapFileName   OPTIONAL,
+  IN  LIST_ENTRY          *AsyncUpdateList,
+  OUT BOOLEAN             *ResetRequired OPTIONAL
+  )
+{
+  EFI_STATUS        Status;
+  LIST_ENTRY        *Link;
+  FMP_ASYNC_UPDATE  *AsyncUpdate;
+  CHAR16            *AbortReason;
+  UINTN             Completion;
+  UINTN             TotalCompletion;
+  UINTN             Count;
+  UINTN             LastCompletion;
+  BOOLEAN           Pending;
+  BOOLEAN           ProgressEnabled;
+
+  if (IsListEmpty (AsyncUpdateList)) {
+    return;
+  }
+
+  ProgressEnabled = !EFI_ERROR (UpdateImageProgress (0));
+  LastCompletion  = 0;
+
+  do {
+    Pending         = FALSE;
+    TotalCompletion = 0;
+    Count           = 0;
+    for (Link = GetFirstNode (AsyncUpdateList); !IsNull (AsyncUpdateList, Link); Link = GetNextNode (AsyncUpdateList, Link)) {
+      AsyncUpdate = BASE_CR (Link, FMP_ASYNC_UPDATE, Link);
+      Count++;
+      if (AsyncUpdate->Done) {
+        TotalCompletion += 100;
+        continue;
+      }
+
+      Completion  = 0;
+      AbortReason = NULL;
+      Status      = AsyncUpdate->FmpAsync->PollImage (AsyncUpdate->FmpAsync, &Completion, &AbortReason);
+      if (AbortReason != NULL) {
+        DEBUG ((DEBUG_ERROR, "%s\n", AbortReason));
+        FreePool (AbortReason);
+      }
+
+      if (Status == EFI_NOT_READY) {
+        AsyncUpdate->Completion = MIN (Completion, 100);
+        TotalCompletion        += AsyncUpdate->Completion;
+        Pending                 = TRUE;
+        continue;
+      }
+
+      DEBUG ((DEBUG_INFO, "FmpAsync->PollImage - %r (PayloadIndex - 0x%x)\n", Status, AsyncUpdate->PayloadIndex));
+      AsyncUpdate->Done = TRUE;
+      TotalCompletion  += 100;
+      if (!EFI_ERROR (Status) && (ResetRequired != NULL)) {
+        *ResetRequired |= AsyncUpdate->ResetRequired;
+      }
+
+      RecordFmpCapsuleStatus (
+        AsyncUpdate->Handle,
+        CapsuleHeader,
+        Status,
+        AsyncUpdate->PayloadIndex,
+        AsyncUpdate->ImageHeader,
+        CapFileName
+        );
+    }
+
+    //
+    // Only report a change of the progress, since each report also re-arms
+    // the watchdog timer and prints a debug message.
+    //
+    if (Pending) {
+      if (ProgressEnabled && (TotalCompletion / Count != LastCompletion)) {
+        LastCompletion = TotalCompletion / Count;
+        UpdateImageProgress (LastCompletion);
+      }
+
+      gBS->Stall (FMP_ASYNC_UPDATE_POLL_INTERVAL);
+    }
+  } while (Pending);
+
+  if (ProgressEnabled) {
+    UpdateImageProgress (100);
+  }
+
+  while (!IsListEmpty (AsyncUpdateList)) {
+    AsyncUpdate = BASE_CR (GetFirstNode (AsyncUpdateList), FMP_ASYNC_UPDATE, Link);
+    RemoveEntryList (&AsyncUpdate->Link);
+    FreePool (AsyncUpdate);
+  }
+}
+
 /**
   Process Firmware management protocol data capsule.
 
@@ -1190,6 +1433,12 @@ RecordFmpCapsuleStatus (
 
   This function need support nested FMP capsule.
 
+  A payload for an FMP instance that installs the EDK II Firmware Management
+  Async Protocol is only started, and the next payloads are processed while
+  the device updates. The function waits for these updates to finish before
+  it returns. A failed asynchronous update does not abort the payloads that
+  follow it, since they may already be in progress.
+
   @param[in]  CapsuleHeader         Points to a capsule header.
   @param[in]  CapFileName           Capsule file name.
   @param[out] ResetRequired         Indicates whether reset is required or not.
@@ -1221,6 +1470,8 @@ ProcessFmpCapsuleImage (
   UINTN                                         Index2;
   BOOLEAN                                       NotReady;
   BOOLEAN                                       Abort;
+  EDKII_FIRMWARE_MANAGEMENT_ASYNC_PROTOCOL      *FmpAsync;
+  LIST_ENTRY                                    AsyncUpdateList;
 
   if (!IsFmpCapsuleGuid (&CapsuleHeader->CapsuleGuid)) {
     return ProcessFmpCapsuleImage ((EFI_CAPSULE_HEADER *)((UINTN)CapsuleHeader + CapsuleHeader->HeaderSize), CapFileName, ResetRequired);
@@ -1280,6 +1531,8 @@ ProcessFmpCapsuleImage (
 
   DumpAllFmpInfo ();
 
+  InitializeListHead (&AsyncUpdateList);
+
   //
   // Check all the payload entry in capsule payload list
   //
@@ -1330,11 +1583,41 @@ ProcessFmpCapsuleImage (
         continue;
       }
 
-      Status = SetFmpImageData (
-                 HandleBuffer[Index2],
-                 ImageHeader,
-                 Index - FmpCapsuleHeader->EmbeddedDriverCount
-                 );
+      Status = gBS->HandleProtocol (
+                      HandleBuffer[Index2],
+                      &gEdkiiFirmwareManagementAsyncProtocolGuid,
+                      (VOID **)&FmpAsync
+                      );
+      if (!EFI_ERROR (Status)) {
+        //
+        // A device takes one update at a time
+        //
+        if (IsFmpAsyncUpdatePending (HandleBuffer[Index2], &AsyncUpdateList)) {
+          WaitFmpImageDataAsync (CapsuleHeader, CapFileName, &AsyncUpdateList, ResetRequired);
+        }
+
+        Status = StartFmpImageDataAsync (
+                   FmpAsync,
+                   HandleBuffer[Index2],
+                   ImageHeader,
+                   Index - FmpCapsuleHeader->EmbeddedDriverCount,
+                   ResetRequiredBuffer[Index2],
+                   &AsyncUpdateList
+                   );
+        if (!EFI_ERROR (Status)) {
+          //
+          // The status is recorded when the update finishes
+          //
+          continue;
+        }
+      } else {
+        Status = SetFmpImageData (
+                   HandleBuffer[Index2],
+                   ImageHeader,
+                   Index - FmpCapsuleHeader->EmbeddedDriverCount
+                   );
+      }
+
       if (Status != EFI_SUCCESS) {
         Abort = TRUE;
       } else {
@@ -1362,6 +1645,8 @@ ProcessFmpCapsuleImage (
     }
   }
 
+  WaitFmpImageDataAsync (CapsuleHeader, CapFileName, &AsyncUpdateList, ResetRequired);
+
   if (NotReady) {
     return EFI_NOT_READY;
   }
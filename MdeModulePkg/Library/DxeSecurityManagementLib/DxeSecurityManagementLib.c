@@ -8,6 +8,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include <PiDxe.h>
 #include <Protocol/LoadFile.h>
+#include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/DxeServicesLib.h>
 #include <Library/MemoryAllocationLib.h>
@@ -17,6 +18,13 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define SECURITY_HANDLER_TABLE_SIZE  0x10
 
+//
+// Image digests shared between the security handlers of one image, at most one per
+// SHA-1/SHA-256/SHA-384/SHA-512 and up to the SHA-512 digest size.
+//
+#define SECURITY_IMAGE_DIGEST_COUNT     4
+#define SECURITY_IMAGE_DIGEST_MAX_SIZE  64
+
 //
 // Secruity Operation on Image and none Image.
 //
@@ -36,6 +44,12 @@ typedef struct {
   SECURITY2_FILE_AUTHENTICATION_HANDLER    Security2Handler;
 } SECURITY2_INFO;
 
+typedef struct {
+  EFI_GUID    HashAlgorithm;
+  UINTN       DigestSize;
+  UINT8       Digest[SECURITY_IMAGE_DIGEST_MAX_SIZE];
+} SECURITY_IMAGE_DIGEST;
+
 UINT32         mCurrentAuthOperation       = 0;
 UINT32         mNumberOfSecurityHandler    = 0;
 UINT32         mMaxNumberOfSecurityHandler = 0;
@@ -46,6 +60,11 @@ UINT32          mNumberOfSecurity2Handler    = 0;
 UINT32          mMaxNumberOfSecurity2Handler = 0;
 SECURITY2_INFO  *mSecurity2Table             = NULL;
 
+CONST VOID             *mSecurityImageBuffer = NULL;
+UINTN                  mSecurityImageSize    = 0;
+UINTN                  mSecurityImageDigestCount;
+SECURITY_IMAGE_DIGEST  mSecurityImageDigest[SECURITY_IMAGE_DIGEST_COUNT];
+
 /**
   Reallocates more global memory to store the registered Handler list.
 
@@ -503,9 +522,17 @@ ExecuteSecurity2Handlers (
     return EFI_SUCCESS;
   }
 
+  //
+  // Start an empty image digest set which the handlers below may share.
+  //
+  mSecurityImageBuffer      = FileBuffer;
+  mSecurityImageSize        = FileSize;
+  mSecurityImageDigestCount = 0;
+
   //
   // Run security handler in same order to their registered list
   //
+  Status = EFI_SUCCESS;
   for (Index = 0; Index < mNumberOfSecurity2Handler; Index++) {
     //
     // If FileBuffer is not NULL, the input is Image, which will be handled by EFI_AUTH_IMAGE_OPERATION_MASK operation.
@@ -527,11 +554,136 @@ ExecuteSecurity2Handlers (
                                           BootPolicy
                                           );
         if (EFI_ERROR (Status)) {
-          return Status;
+          break;
         }
       }
     }
   }
 
+  //
+  // The image buffer may be freed and reused once the handlers are done, so the
+  // digests must not outlive this call.
+  //
+  mSecurityImageBuffer      = NULL;
+  mSecurityImageSize        = 0;
+  mSecurityImageDigestCount = 0;
+  ZeroMem (mSecurityImageDigest, sizeof (mSecurityImageDigest));
+
+  return Status;
+}
+
+/**
+  Publish the PE/COFF Authenticode digest of the image currently being processed by
+  ExecuteSecurity2Handlers(), so that the security handlers which run after the
+  caller can reuse it instead of hashing the image again.
+
+  The digest is only kept until ExecuteSecurity2Handlers() returns.
+
+  @param[in]  FileBuffer     The image buffer passed to the security handler.
+  @param[in]  FileSize       The size of FileBuffer in bytes.
+  @param[in]  HashAlgorithm  The EFI_CERT_SHAxxx_GUID identifying the hash algorithm.
+  @param[in]  Digest         The Authenticode digest of the image.
+  @param[in]  DigestSize     The size of Digest in bytes.
+
+  @retval EFI_SUCCESS            The digest was recorded.
+  @retval EFI_INVALID_PARAMETER  FileBuffer, HashAlgorithm or Digest is NULL.
+  @retval EFI_NOT_READY          No security handler chain is being executed for FileBuffer.
+  @retval EFI_BAD_BUFFER_SIZE    DigestSize is too large to be recorded.
+  @retval EFI_OUT_OF_RESOURCES   The digests of too many algorithms were already recorded.
+**/
+EFI_STATUS
+EFIAPI
+SetSecurityImageDigest (
+  IN CONST VOID      *FileBuffer,
+  IN UINTN           FileSize,
+  IN CONST EFI_GUID  *HashAlgorithm,
+  IN CONST UINT8     *Digest,
+  IN UINTN           DigestSize
+  )
+{
+  UINTN  Index;
+
+  if ((FileBuffer == NULL) || (HashAlgorithm == NULL) || (Digest == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if ((FileBuffer != mSecurityImageBuffer) || (FileSize != mSecurityImageSize)) {
+    return EFI_NOT_READY;
+  }
+
+  if ((DigestSize == 0) || (DigestSize > SECURITY_IMAGE_DIGEST_MAX_SIZE)) {
+    return EFI_BAD_BUFFER_SIZE;
+  }
+
+  for (Index = 0; Index < mSecurityImageDigestCount; Index++) {
+    if (CompareGuid (&mSecurityImageDigest[Index].HashAlgorithm, HashAlgorithm)) {
+      break;
+    }
+  }
+
+  if (Index == SECURITY_IMAGE_DIGEST_COUNT) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  CopyGuid (&mSecurityImageDigest[Index].HashAlgorithm, HashAlgorithm);
+  CopyMem (mSecurityImageDigest[Index].Digest, Digest, DigestSize);
+  mSecurityImageDigest[Index].DigestSize = DigestSize;
+  if (Index == mSecurityImageDigestCount) {
+    mSecurityImageDigestCount++;
+  }
+
   return EFI_SUCCESS;
 }
+
+/**
+  Retrieve the PE/COFF Authenticode digest of the image currently being processed by
+  ExecuteSecurity2Handlers(), as published earlier by another security handler with
+  SetSecurityImageDigest().
+
+  @param[in]      FileBuffer     The image buffer passed to the security handler.
+  @param[in]      FileSize       The size of FileBuffer in bytes.
+  @param[in]      HashAlgorithm  The EFI_CERT_SHAxxx_GUID identifying the hash algorithm.
+  @param[out]     Digest         The buffer receiving the digest.
+  @param[in,out]  DigestSize     On input, the size of Digest in bytes. On output,
+                                 the size of the returned digest.
+
+  @retval EFI_SUCCESS            The digest was returned.
+  @retval EFI_INVALID_PARAMETER  FileBuffer, HashAlgorithm, Digest or DigestSize is NULL.
+  @retval EFI_NOT_FOUND          No digest of this image was recorded for HashAlgorithm.
+  @retval EFI_BUFFER_TOO_SMALL   DigestSize is too small, it is updated with the required size.
+**/
+EFI_STATUS
+EFIAPI
+GetSecurityImageDigest (
+  IN CONST VOID      *FileBuffer,
+  IN UINTN           FileSize,
+  IN CONST EFI_GUID  *HashAlgorithm,
+  OUT UINT8          *Digest,
+  IN OUT UINTN       *DigestSize
+  )
+{
+  UINTN  Index;
+
+  if ((FileBuffer == NULL) || (HashAlgorithm == NULL) || (Digest == NULL) || (DigestSize == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if ((FileBuffer != mSecurityImageBuffer) || (FileSize != mSecurityImageSize)) {
+    return EFI_NOT_FOUND;
+  }
+
+  for (Index = 0; Index < mSecurityImageDigestCount; Index++) {
+    if (CompareGuid (&mSecurityImageDigest[Index].HashAlgorithm, HashAlgorithm)) {
+      if (*DigestSize < mSecurityImageDigest[Index].DigestSize) {
+        *DigestSize = mSecurityImageDigest[Index].DigestSize;
+        return EFI_BUFFER_TOO_SMALL;
+      }
+
+      CopyMem (Digest, mSecurityImageDigest[Index].Digest, mSecurityImageDigest[Index].DigestSize);
+      *DigestSize = mSecurityImageDigest[Index].DigestSize;
+      return EFI_SUCCESS;
+    }
+  }
+
+  return EFI_NOT_FOUND;
+}
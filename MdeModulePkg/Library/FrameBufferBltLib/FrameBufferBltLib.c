@@ -35,6 +35,104 @@ CONST EFI_PIXEL_BITMASK  mBgrPixelMasks = {
   0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000
 };
 
+/**
+  Convert a pixel of a BltBuffer to the pixel format of the frame buffer.
+
+  @param Configure     The frame buffer configuration.
+  @param Uint32        The EFI_GRAPHICS_OUTPUT_BLT_PIXEL as a UINT32.
+
+  @return The pixel in the format of the frame buffer.
+**/
+STATIC
+UINT32
+FrameBufferBltLibBltPixelToVideo (
+  IN CONST FRAME_BUFFER_CONFIGURE  *Configure,
+  IN UINT32                        Uint32
+  )
+{
+  return (UINT32)(
+                  (((Uint32 << Configure->PixelShl[0]) >> Configure->PixelShr[0]) &
+                   Configure->PixelMasks.RedMask) |
+                  (((Uint32 << Configure->PixelShl[1]) >> Configure->PixelShr[1]) &
+                   Configure->PixelMasks.GreenMask) |
+                  (((Uint32 << Configure->PixelShl[2]) >> Configure->PixelShr[2]) &
+                   Configure->PixelMasks.BlueMask)
+                  );
+}
+
+/**
+  Convert a pixel of the frame buffer to an EFI_GRAPHICS_OUTPUT_BLT_PIXEL.
+
+  @param Configure     The frame buffer configuration.
+  @param Uint32        The pixel in the format of the frame buffer.
+
+  @return The EFI_GRAPHICS_OUTPUT_BLT_PIXEL as a UINT32.
+**/
+STATIC
+UINT32
+FrameBufferBltLibVideoPixelToBlt (
+  IN CONST FRAME_BUFFER_CONFIGURE  *Configure,
+  IN UINT32                        Uint32
+  )
+{
+  return (UINT32)(
+                  (((Uint32 & Configure->PixelMasks.RedMask) >>
+                    Configure->PixelShl[0]) << Configure->PixelShr[0]) |
+                  (((Uint32 & Configure->PixelMasks.GreenMask) >>
+                    Configure->PixelShl[1]) << Configure->PixelShr[1]) |
+                  (((Uint32 & Configure->PixelMasks.BlueMask) >>
+                    Configure->PixelShl[2]) << Configure->PixelShr[2])
+                  );
+}
+
+/**
+  Convert a line of 32-bit pixels between the BltBuffer format and the
+  format of the frame buffer, without going through the line buffer.
+
+  The red and blue bytes of PixelRedGreenBlueReserved8BitPerColor pixels are
+  swapped, which is the same operation in both directions. The source and the
+  destination may be the same buffer. The pixels are written one by one in
+  ascending order, which keeps the write-combining buffers of a frame buffer
+  destination full.
+
+  @param Configure     The frame buffer configuration, with 4 bytes per pixel.
+  @param Destination   The converted pixels.
+  @param Source        The pixels to convert.
+  @param Width         The number of pixels.
+  @param ToVideo       TRUE to convert BltBuffer pixels to the frame buffer
+                       format, FALSE to convert frame buffer pixels.
+**/
+STATIC
+VOID
+FrameBufferBltLibConvertLine (
+  IN CONST FRAME_BUFFER_CONFIGURE  *Configure,
+  OUT UINT32                       *Destination,
+  IN CONST UINT32                  *Source,
+  IN UINTN                         Width,
+  IN BOOLEAN                       ToVideo
+  )
+{
+  UINTN   IndexX;
+  UINT32  Uint32;
+
+  ASSERT (Configure->BytesPerPixel == sizeof (UINT32));
+
+  if (Configure->PixelFormat == PixelRedGreenBlueReserved8BitPerColor) {
+    for (IndexX = 0; IndexX < Width; IndexX++) {
+      Uint32              = Source[IndexX];
+      Destination[IndexX] = (Uint32 & 0x0000ff00) | ((Uint32 >> 16) & 0xff) | ((Uint32 & 0xff) << 16);
+    }
+  } else if (ToVideo) {
+    for (IndexX = 0; IndexX < Width; IndexX++) {
+      Destination[IndexX] = FrameBufferBltLibBltPixelToVideo (Configure, Source[IndexX]);
+    }
+  } else {
+    for (IndexX = 0; IndexX < Width; IndexX++) {
+      Destination[IndexX] = FrameBufferBltLibVideoPixelToBlt (Configure, Source[IndexX]);
+    }
+  }
+}
+
 /**
   Initialize the bit mask in frame buffer configure.
 
@@ -235,15 +333,7 @@ FrameBufferBltLibVideoFill (
   WidthInBytes = Width * Configure->BytesPerPixel;
 
   Uint32   = *(UINT32 *)Color;
-  WideFill =
-    (UINT32)(
-             (((Uint32 << Configure->PixelShl[0]) >> Configure->PixelShr[0]) &
-              Configure->PixelMasks.RedMask) |
-             (((Uint32 << Configure->PixelShl[1]) >> Configure->PixelShr[1]) &
-              Configure->PixelMasks.GreenMask) |
-             (((Uint32 << Configure->PixelShl[2]) >> Configure->PixelShr[2]) &
-              Configure->PixelMasks.BlueMask)
-             );
+  WideFill = FrameBufferBltLibBltPixelToVideo (Configure, Uint32);
   DEBUG ((
     DEBUG_VERBOSE,
     "VideoFill: color=0x%x, wide-fill=0x%x\n",
@@ -315,6 +405,13 @@ FrameBufferBltLibVideoFill (
         if (SizeInBytes > 0) {
           CopyMem (Destination, &WideFill, SizeInBytes);
         }
+      } else if ((Configure->BytesPerPixel == sizeof (UINT32)) && (((UINTN)Destination & 3) == 0)) {
+        //
+        // 32-bit pixels at an odd X are not 8-byte aligned, fill them with
+        // 32-bit stores instead of going through the line buffer.
+        //
+        DEBUG ((DEBUG_VERBOSE, "VideoFill (32-bit)\n"));
+        SetMem32 (Destination, WidthInBytes, (UINT32)WideFill);
       } else {
         DEBUG ((DEBUG_VERBOSE, "VideoFill (not wide)\n"));
         if (!LineBufferReady) {
@@ -379,6 +476,7 @@ FrameBufferBltLibVideoToBltBuffer (
   UINT32                         Uint32;
   UINTN                          Offset;
   UINTN                          WidthInBytes;
+  BOOLEAN                        UseLineBuffer;
 
   //
   // Video to BltBuffer: Source is Video, destination is BltBuffer
@@ -406,6 +504,13 @@ FrameBufferBltLibVideoToBltBuffer (
 
   WidthInBytes = Width * Configure->BytesPerPixel;
 
+  //
+  // Pixels of 32 bits are read into the BltBuffer and converted in place.
+  // Smaller pixels are read into the line buffer first, as they are converted
+  // into larger ones.
+  //
+  UseLineBuffer = (BOOLEAN)(Configure->BytesPerPixel != sizeof (UINT32));
+
   //
   // Video to BltBuffer: Source is Video, destination is BltBuffer
   //
@@ -417,30 +522,33 @@ FrameBufferBltLibVideoToBltBuffer (
     Offset = Configure->BytesPerPixel * Offset;
     Source = Configure->FrameBuffer + Offset;
 
-    if (Configure->PixelFormat == PixelBlueGreenRedReserved8BitPerColor) {
-      Destination = (UINT8 *)BltBuffer + (DstY * Delta) + (DestinationX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-    } else {
+    if (UseLineBuffer) {
       Destination = Configure->LineBuffer;
+    } else {
+      Destination = (UINT8 *)BltBuffer + (DstY * Delta) + (DestinationX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
     }
 
+    //
+    // Read the frame buffer with a single CopyMem(), reads of video memory
+    // are slow.
+    //
     CopyMem (Destination, Source, WidthInBytes);
 
-    if (Configure->PixelFormat != PixelBlueGreenRedReserved8BitPerColor) {
-      for (IndexX = 0; IndexX < Width; IndexX++) {
-        Blt = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)
-              ((UINT8 *)BltBuffer + (DstY * Delta) +
-               (DestinationX + IndexX) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
-        Uint32         = *(UINT32 *)(Configure->LineBuffer + (IndexX * Configure->BytesPerPixel));
-        *(UINT32 *)Blt =
-          (UINT32)(
-                   (((Uint32 & Configure->PixelMasks.RedMask) >>
-                     Configure->PixelShl[0]) << Configure->PixelShr[0]) |
-                   (((Uint32 & Configure->PixelMasks.GreenMask) >>
-                     Configure->PixelShl[1]) << Configure->PixelShr[1]) |
-                   (((Uint32 & Configure->PixelMasks.BlueMask) >>
-                     Configure->PixelShl[2]) << Configure->PixelShr[2])
-                   );
-      }
+    if (Configure->PixelFormat == PixelBlueGreenRedReserved8BitPerColor) {
+      continue;
+    }
+
+    if (!UseLineBuffer) {
+      FrameBufferBltLibConvertLine (Configure, (UINT32 *)Destination, (UINT32 *)Destination, Width, FALSE);
+      continue;
+    }
+
+    for (IndexX = 0; IndexX < Width; IndexX++) {
+      Blt = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)
+            ((UINT8 *)BltBuffer + (DstY * Delta) +
+             (DestinationX + IndexX) * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+      Uint32         = *(UINT32 *)(Configure->LineBuffer + (IndexX * Configure->BytesPerPixel));
+      *(UINT32 *)Blt = FrameBufferBltLibVideoPixelToBlt (Configure, Uint32);
     }
   }
 
@@ -524,6 +632,13 @@ FrameBufferBltLibBufferToVideo (
 
     if (Configure->PixelFormat == PixelBlueGreenRedReserved8BitPerColor) {
       Source = (UINT8 *)BltBuffer + (SrcY * Delta) + SourceX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+    } else if (Configure->BytesPerPixel == sizeof (UINT32)) {
+      //
+      // Pixels of 32 bits are converted straight into the frame buffer.
+      //
+      Source = (UINT8 *)BltBuffer + (SrcY * Delta) + SourceX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+      FrameBufferBltLibConvertLine (Configure, (UINT32 *)Destination, (UINT32 *)Source, Width, TRUE);
+      continue;
     } else {
       for (IndexX = 0; IndexX < Width; IndexX++) {
         Blt =
@@ -534,14 +649,7 @@ FrameBufferBltLibBufferToVideo (
                                             );
         Uint32                                                                   = *(UINT32 *)Blt;
         *(UINT32 *)(Configure->LineBuffer + (IndexX * Configure->BytesPerPixel)) =
-          (UINT32)(
-                   (((Uint32 << Configure->PixelShl[0]) >> Configure->PixelShr[0]) &
-                    Configure->PixelMasks.RedMask) |
-                   (((Uint32 << Configure->PixelShl[1]) >> Configure->PixelShr[1]) &
-                    Configure->PixelMasks.GreenMask) |
-                   (((Uint32 << Configure->PixelShl[2]) >> Configure->PixelShr[2]) &
-                    Configure->PixelMasks.BlueMask)
-                   );
+          FrameBufferBltLibBltPixelToVideo (Configure, Uint32);
       }
 
       Source = Configure->LineBuffer;
@@ -619,12 +727,22 @@ FrameBufferBltLibVideoToVideo (
   Destination = Configure->FrameBuffer + Offset;
 
   LineStride = Configure->BytesPerPixel * Configure->PixelsPerScanLine;
+
+  //
+  // Full lines are contiguous, move them with a single CopyMem(), which
+  // handles the overlap of scrolling.
+  //
+  if ((SourceX == 0) && (DestinationX == 0) && (Width == Configure->PixelsPerScanLine)) {
+    CopyMem (Destination, Source, Height * LineStride);
+    return RETURN_SUCCESS;
+  }
+
   if (Destination > Source) {
     //
     // Copy from last line to avoid source is corrupted by copying
     //
-    Source      += Height * LineStride;
-    Destination += Height * LineStride;
+    Source      += (Height - 1) * LineStride;
+    Destination += (Height - 1) * LineStride;
     LineStride   = -LineStride;
   }
 
@@ -991,10 +991,168 @@ S3BootScriptCloseTable (
   ScriptTableInfo->Length      = (UINT8)sizeof (EFI_BOOT_SCRIPT_TABLE_HEADER);
   ScriptTableInfo->TableLength = 0;   // will be calculate at close the table
 
-  mS3BootScriptTablePtr->TableLength = sizeof (EFI_BOOT_SCRIPT_TABLE_HEADER);
+  mS3BootScriptTablePtr->TableLength     = sizeof (EFI_BOOT_SCRIPT_TABLE_HEADER);
+  mS3BootScriptTablePtr->LastWriteOffset = 0;
   return Buffer;
 }
 
+/**
+  Try to merge an I/O, memory or PCI configuration space write into the write
+  entry at the end of the boot script table.
+
+  Drivers often save the registers of a device one by one. When a write
+  continues the last entry, with the same opcode and width and at the address
+  following it, its data is appended to that entry and its count is increased,
+  so the table holds, and the resume replays, one entry instead of many.
+
+  Writes are only merged before SmmReadyToLock, when nothing but the boot time
+  copy of the table has to be updated.
+
+  @param OpCode   The opcode of the write.
+  @param Width    The width of the write operations.
+  @param Address  The base address of the write operations.
+  @param Count    The number of write operations to perform.
+  @param Buffer   The source buffer from which to write the data.
+
+  @retval TRUE    The write was merged into the last entry.
+  @retval FALSE   The write must be saved as a new entry.
+**/
+BOOLEAN
+S3BootScriptMergeWrite (
+  IN  UINT16                    OpCode,
+  IN  S3_BOOT_SCRIPT_LIB_WIDTH  Width,
+  IN  UINT64                    Address,
+  IN  UINTN                     Count,
+  IN  VOID                      *Buffer
+  )
+{
+  UINT8                      *LastEntry;
+  UINT8                      *Script;
+  UINT8                      WidthInByte;
+  UINTN                      DataLength;
+  EFI_BOOT_SCRIPT_MEM_WRITE  LastWrite;
+
+  //
+  // EFI_BOOT_SCRIPT_IO_WRITE and EFI_BOOT_SCRIPT_PCI_CONFIG_WRITE share the
+  // layout of EFI_BOOT_SCRIPT_MEM_WRITE.
+  //
+  if (mS3BootScriptTablePtr->SmmLocked ||
+      (mS3BootScriptTablePtr->TableBase == NULL) ||
+      (mS3BootScriptTablePtr->LastWriteOffset == 0) ||
+      (Width > S3BootScriptWidthUint64))
+  {
+    return FALSE;
+  }
+
+  LastEntry = mS3BootScriptTablePtr->TableBase + mS3BootScriptTablePtr->LastWriteOffset;
+  CopyMem ((VOID *)&LastWrite, LastEntry, sizeof (EFI_BOOT_SCRIPT_MEM_WRITE));
+  if ((LastWrite.OpCode != OpCode) ||
+      (LastWrite.Width != (UINT32)Width) ||
+      (mS3BootScriptTablePtr->LastWriteOffset + LastWrite.Length != mS3BootScriptTablePtr->TableLength))
+  {
+    return FALSE;
+  }
+
+  WidthInByte = (UINT8)(0x01 << (Width & 0x03));
+  DataLength  = WidthInByte * Count;
+  if ((LastWrite.Length + DataLength > MAX_UINT8) ||
+      (Address != LastWrite.Address + MultU64x32 (LastWrite.Count, WidthInByte)))
+  {
+    return FALSE;
+  }
+
+  if ((OpCode == EFI_BOOT_SCRIPT_PCI_CONFIG_WRITE_OPCODE) &&
+      (((Address & ~(UINT64)0xFF) != (LastWrite.Address & ~(UINT64)0xFF)) ||
+       ((Address & 0xFF) + DataLength > 0x100)))
+  {
+    //
+    // Do not let the register offset run into the next function.
+    //
+    return FALSE;
+  }
+
+  Script = S3BootScriptGetEntryAddAddress ((UINT8)DataLength);
+  if (Script == NULL) {
+    return FALSE;
+  }
+
+  //
+  // The table may have been reallocated.
+  //
+  LastEntry = mS3BootScriptTablePtr->TableBase + mS3BootScriptTablePtr->LastWriteOffset;
+  CopyMem ((VOID *)Script, Buffer, DataLength);
+  LastWrite.Length = (UINT8)(LastWrite.Length + DataLength);
+  LastWrite.Count  = (UINT32)(LastWrite.Count + Count);
+  CopyMem (LastEntry, (VOID *)&LastWrite, sizeof (EFI_BOOT_SCRIPT_MEM_WRITE));
+  mS3BootScriptTablePtr->LastMergedLength = (UINT8)DataLength;
+
+  SyncBootScript (LastEntry);
+
+  return TRUE;
+}
+
+/**
+  Split the data merged by the last write out of the entry it was merged into,
+  so that the last entry of the table is that write alone again.
+
+  @retval RETURN_SUCCESS           The last entry is the last write alone.
+  @retval RETURN_OUT_OF_RESOURCES  Not enough memory for the table do operation.
+**/
+RETURN_STATUS
+S3BootScriptSplitLastWrite (
+  VOID
+  )
+{
+  UINT8                      *LastEntry;
+  UINT8                      *Script;
+  UINT8                      MergedLength;
+  UINT8                      WidthInByte;
+  EFI_BOOT_SCRIPT_MEM_WRITE  LastWrite;
+
+  MergedLength = mS3BootScriptTablePtr->LastMergedLength;
+  if ((mS3BootScriptTablePtr->LastWriteOffset == 0) || (MergedLength == 0)) {
+    return RETURN_SUCCESS;
+  }
+
+  LastEntry = mS3BootScriptTablePtr->TableBase + mS3BootScriptTablePtr->LastWriteOffset;
+  CopyMem ((VOID *)&LastWrite, LastEntry, sizeof (EFI_BOOT_SCRIPT_MEM_WRITE));
+  if (mS3BootScriptTablePtr->LastWriteOffset + LastWrite.Length != mS3BootScriptTablePtr->TableLength) {
+    //
+    // Another entry was added after the write.
+    //
+    return RETURN_SUCCESS;
+  }
+
+  Script = S3BootScriptGetEntryAddAddress ((UINT8)sizeof (EFI_BOOT_SCRIPT_MEM_WRITE));
+  if (Script == NULL) {
+    return RETURN_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Move the merged data behind a header of its own.
+  //
+  LastEntry = mS3BootScriptTablePtr->TableBase + mS3BootScriptTablePtr->LastWriteOffset;
+  Script    = LastEntry + LastWrite.Length - MergedLength;
+  CopyMem (Script + sizeof (EFI_BOOT_SCRIPT_MEM_WRITE), Script, MergedLength);
+
+  WidthInByte      = (UINT8)(0x01 << (LastWrite.Width & 0x03));
+  LastWrite.Length = (UINT8)(LastWrite.Length - MergedLength);
+  LastWrite.Count  = LastWrite.Count - MergedLength / WidthInByte;
+  CopyMem (LastEntry, (VOID *)&LastWrite, sizeof (EFI_BOOT_SCRIPT_MEM_WRITE));
+
+  LastWrite.Address = LastWrite.Address + MultU64x32 (LastWrite.Count, WidthInByte);
+  LastWrite.Length  = (UINT8)(sizeof (EFI_BOOT_SCRIPT_MEM_WRITE) + MergedLength);
+  LastWrite.Count   = MergedLength / WidthInByte;
+  CopyMem (Script, (VOID *)&LastWrite, sizeof (EFI_BOOT_SCRIPT_MEM_WRITE));
+
+  mS3BootScriptTablePtr->LastWriteOffset  = 0;
+  mS3BootScriptTablePtr->LastMergedLength = 0;
+
+  SyncBootScript (LastEntry);
+
+  return RETURN_SUCCESS;
+}
+
 /**
   Save I/O write to boot script
 
@@ -1036,6 +1194,10 @@ S3BootScriptSaveIoWrite (
     return RETURN_OUT_OF_RESOURCES;
   }
 
+  if (S3BootScriptMergeWrite (EFI_BOOT_SCRIPT_IO_WRITE_OPCODE, Width, Address, Count, Buffer)) {
+    return RETURN_SUCCESS;
+  }
+
   Length = (UINT8)(sizeof (EFI_BOOT_SCRIPT_IO_WRITE) + (WidthInByte * Count));
 
   Script = S3BootScriptGetEntryAddAddress (Length);
@@ -1054,6 +1216,9 @@ S3BootScriptSaveIoWrite (
   CopyMem ((VOID *)Script, (VOID *)&ScriptIoWrite, sizeof (EFI_BOOT_SCRIPT_IO_WRITE));
   CopyMem ((VOID *)(Script + sizeof (EFI_BOOT_SCRIPT_IO_WRITE)), Buffer, WidthInByte * Count);
 
+  mS3BootScriptTablePtr->LastWriteOffset  = (UINT32)(Script - mS3BootScriptTablePtr->TableBase);
+  mS3BootScriptTablePtr->LastMergedLength = 0;
+
   SyncBootScript (Script);
 
   return RETURN_SUCCESS;
@@ -1153,6 +1318,10 @@ S3BootScriptSaveMemWrite (
     return RETURN_OUT_OF_RESOURCES;
   }
 
+  if (S3BootScriptMergeWrite (EFI_BOOT_SCRIPT_MEM_WRITE_OPCODE, Width, Address, Count, Buffer)) {
+    return RETURN_SUCCESS;
+  }
+
   Length = (UINT8)(sizeof (EFI_BOOT_SCRIPT_MEM_WRITE) + (WidthInByte * Count));
 
   Script = S3BootScriptGetEntryAddAddress (Length);
@@ -1172,6 +1341,9 @@ S3BootScriptSaveMemWrite (
   CopyMem ((VOID *)Script, (VOID *)&ScriptMemWrite, sizeof (EFI_BOOT_SCRIPT_MEM_WRITE));
   CopyMem ((VOID *)(Script + sizeof (EFI_BOOT_SCRIPT_MEM_WRITE)), Buffer, WidthInByte * Count);
 
+  mS3BootScriptTablePtr->LastWriteOffset  = (UINT32)(Script - mS3BootScriptTablePtr->TableBase);
+  mS3BootScriptTablePtr->LastMergedLength = 0;
+
   SyncBootScript (Script);
 
   return RETURN_SUCCESS;
@@ -1280,6 +1452,10 @@ S3BootScriptSavePciCfgWrite (
     return RETURN_OUT_OF_RESOURCES;
   }
 
+  if (S3BootScriptMergeWrite (EFI_BOOT_SCRIPT_PCI_CONFIG_WRITE_OPCODE, Width, Address, Count, Buffer)) {
+    return RETURN_SUCCESS;
+  }
+
   Length = (UINT8)(sizeof (EFI_BOOT_SCRIPT_PCI_CONFIG_WRITE) + (WidthInByte * Count));
 
   Script = S3BootScriptGetEntryAddAddress (Length);
@@ -1299,6 +1475,9 @@ S3BootScriptSavePciCfgWrite (
   CopyMem ((VOID *)Script, (VOID *)&ScriptPciWrite, sizeof (EFI_BOOT_SCRIPT_PCI_CONFIG_WRITE));
   CopyMem ((VOID *)(Script + sizeof (EFI_BOOT_SCRIPT_PCI_CONFIG_WRITE)), Buffer, WidthInByte * Count);
 
+  mS3BootScriptTablePtr->LastWriteOffset  = (UINT32)(Script - mS3BootScriptTablePtr->TableBase);
+  mS3BootScriptTablePtr->LastMergedLength = 0;
+
   SyncBootScript (Script);
 
   return RETURN_SUCCESS;
@@ -2293,6 +2472,16 @@ S3BootScriptMoveLastOpcode (
     return RETURN_OUT_OF_RESOURCES;
   }
 
+  //
+  // The opcode to move is the last one saved, even if it was merged into the
+  // entry before it.
+  //
+  if (RETURN_ERROR (S3BootScriptSplitLastWrite ())) {
+    return RETURN_OUT_OF_RESOURCES;
+  }
+
+  mS3BootScriptTablePtr->LastWriteOffset = 0;
+
   Script = mS3BootScriptTablePtr->TableBase;
 
   StartAddress = (UINTN)Script;
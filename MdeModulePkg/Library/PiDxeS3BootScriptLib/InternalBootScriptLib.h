@@ -75,6 +75,8 @@ typedef struct {
   UINT32     BootTimeScriptLength;  // Maintain boot time script length in LockBox after SmmReadyToLock in SMM.
   BOOLEAN    SmmLocked;             // Record if current state is after SmmReadyToLock
   BOOLEAN    BackFromS3;            // Indicate that the system is back from S3.
+  UINT32     LastWriteOffset;       // Offset of the last write entry that later writes may be merged into, or 0.
+  UINT8      LastMergedLength;      // Length of the data merged into that entry by the last write, or 0.
 } SCRIPT_TABLE_PRIVATE_DATA;
 
 typedef
@@ -23,8 +23,19 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 typedef struct {
   UINT64                  Signature;
   EFI_PHYSICAL_ADDRESS    LockBoxDataAddress;
+  //
+  // Below field is only used in SMM. It is the address of an array of
+  // SMM_LOCK_BOX_HASH_SIZE lists, which index the LockBoxes by GUID.
+  //
+  EFI_PHYSICAL_ADDRESS    LockBoxHashAddress;
 } SMM_LOCK_BOX_CONTEXT;
 
+#define SMM_LOCK_BOX_HASH_SIZE  32
+
+#define SMM_LOCK_BOX_HASH(Guid)                                                \
+  ((((UINT32 *)(Guid))[0] ^ ((UINT32 *)(Guid))[1] ^ ((UINT32 *)(Guid))[2] ^ \
+    ((UINT32 *)(Guid))[3]) % SMM_LOCK_BOX_HASH_SIZE)
+
 //
 // Below data structure is used for lockbox management
 //
@@ -39,6 +50,10 @@ typedef struct {
   UINT64                  Attributes;
   EFI_PHYSICAL_ADDRESS    SmramBuffer;
   LIST_ENTRY              Link;
+  //
+  // Below field is only used in SMM, PEI only follows Link.
+  //
+  LIST_ENTRY              HashLink;
 } SMM_LOCK_BOX_DATA;
 
 #pragma pack()
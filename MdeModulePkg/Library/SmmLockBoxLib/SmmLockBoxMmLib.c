@@ -26,6 +26,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 **/
 SMM_LOCK_BOX_CONTEXT  mSmmLockBoxContext;
 LIST_ENTRY            mLockBoxQueue = INITIALIZE_LIST_HEAD_VARIABLE (mLockBoxQueue);
+LIST_ENTRY            mLockBoxHash[SMM_LOCK_BOX_HASH_SIZE];
 
 BOOLEAN  mSmmConfigurationTableInstalled        = FALSE;
 VOID     *mSmmLockBoxRegistrationSmmEndOfDxe    = NULL;
@@ -201,6 +202,7 @@ SmmLockBoxMmConstructor (
 {
   EFI_STATUS            Status;
   SMM_LOCK_BOX_CONTEXT  *SmmLockBoxContext;
+  UINTN                 Index;
 
   DEBUG ((DEBUG_INFO, "SmmLockBoxSmmLib SmmLockBoxMmConstructor - Enter\n"));
 
@@ -259,6 +261,12 @@ SmmLockBoxMmConstructor (
 
   mSmmLockBoxContext.LockBoxDataAddress = (EFI_PHYSICAL_ADDRESS)(UINTN)&mLockBoxQueue;
 
+  for (Index = 0; Index < SMM_LOCK_BOX_HASH_SIZE; Index++) {
+    InitializeListHead (&mLockBoxHash[Index]);
+  }
+
+  mSmmLockBoxContext.LockBoxHashAddress = (EFI_PHYSICAL_ADDRESS)(UINTN)mLockBoxHash;
+
   Status = gMmst->MmInstallConfigurationTable (
                     gMmst,
                     &gEfiSmmLockBoxCommunicationGuid,
@@ -363,6 +371,29 @@ InternalGetLockBoxQueue (
   return (LIST_ENTRY *)(UINTN)SmmLockBoxContext->LockBoxDataAddress;
 }
 
+/**
+  This function return the SmmLockBox hash list a GUID belongs to.
+
+  @param Guid The guid to indentify the LockBox
+
+  @return SmmLockBox hash list address.
+**/
+LIST_ENTRY *
+InternalGetLockBoxHashList (
+  IN EFI_GUID  *Guid
+  )
+{
+  SMM_LOCK_BOX_CONTEXT  *SmmLockBoxContext;
+
+  SmmLockBoxContext = InternalGetSmmLockBoxContext ();
+  ASSERT (SmmLockBoxContext != NULL);
+  if (SmmLockBoxContext == NULL) {
+    return NULL;
+  }
+
+  return (LIST_ENTRY *)(UINTN)SmmLockBoxContext->LockBoxHashAddress + SMM_LOCK_BOX_HASH (Guid);
+}
+
 /**
   This function find LockBox by GUID.
 
@@ -377,19 +408,19 @@ InternalFindLockBoxByGuid (
 {
   LIST_ENTRY         *Link;
   SMM_LOCK_BOX_DATA  *LockBox;
-  LIST_ENTRY         *LockBoxQueue;
+  LIST_ENTRY         *HashList;
 
-  LockBoxQueue = InternalGetLockBoxQueue ();
-  ASSERT (LockBoxQueue != NULL);
+  HashList = InternalGetLockBoxHashList (Guid);
+  ASSERT (HashList != NULL);
 
-  for (Link = LockBoxQueue->ForwardLink;
-       Link != LockBoxQueue;
+  for (Link = HashList->ForwardLink;
+       Link != HashList;
        Link = Link->ForwardLink)
   {
     LockBox = BASE_CR (
                 Link,
                 SMM_LOCK_BOX_DATA,
-                Link
+                HashLink
                 );
     if (CompareGuid (&LockBox->Guid, Guid)) {
       return LockBox;
@@ -502,6 +533,7 @@ SaveLockBox (
   LockBoxQueue = InternalGetLockBoxQueue ();
   ASSERT (LockBoxQueue != NULL);
   InsertTailList (LockBoxQueue, &LockBox->Link);
+  InsertTailList (InternalGetLockBoxHashList (&LockBox->Guid), &LockBox->HashLink);
 
   //
   // Done
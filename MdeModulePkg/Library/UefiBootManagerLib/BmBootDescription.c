@@ -19,6 +19,13 @@ CHAR16        mBmUefiPrefix[] = L"UEFI ";
 
 LIST_ENTRY  mPlatformBootDescriptionHandlers = INITIALIZE_LIST_HEAD_VARIABLE (mPlatformBootDescriptionHandlers);
 
+//
+// Descriptions already built for a handle. Some of the core handlers talk to
+// the device (USB string descriptors, NVMe Identify), which adds up when the
+// boot options are refreshed several times on a system with many devices.
+//
+LIST_ENTRY  mBmBootDescriptionCache = INITIALIZE_LIST_HEAD_VARIABLE (mBmBootDescriptionCache);
+
 /**
   For a bootable Device path, return its boot type.
 
@@ -775,6 +782,11 @@ EfiBootManagerRegisterBootDescriptionHandler (
   Entry->Signature = BM_BOOT_DESCRIPTION_ENTRY_SIGNATURE;
   Entry->Handler   = Handler;
   InsertTailList (&mPlatformBootDescriptionHandlers, &Entry->Link);
+
+  //
+  // The new handler may give a better description for a handle seen before.
+  //
+  BmFreeBootDescriptionCache ();
   return EFI_SUCCESS;
 }
 
@@ -788,14 +800,36 @@ BM_GET_BOOT_DESCRIPTION  mBmBootDescriptionHandlers[] = {
 };
 
 /**
-  Return the boot description for the controller.
+  Free all the descriptions cached by BmGetBootDescription().
+**/
+VOID
+BmFreeBootDescriptionCache (
+  VOID
+  )
+{
+  LIST_ENTRY                       *Link;
+  BM_BOOT_DESCRIPTION_CACHE_ENTRY  *Entry;
+
+  while (!IsListEmpty (&mBmBootDescriptionCache)) {
+    Link  = GetFirstNode (&mBmBootDescriptionCache);
+    Entry = CR (Link, BM_BOOT_DESCRIPTION_CACHE_ENTRY, Link, BM_BOOT_DESCRIPTION_CACHE_ENTRY_SIGNATURE);
+    RemoveEntryList (Link);
+    FreePool (Entry->DevicePath);
+    FreePool (Entry->Description);
+    FreePool (Entry);
+  }
+}
+
+/**
+  Build the boot description for the controller.
 
   @param Handle                Controller handle.
 
   @return  The description string.
 **/
+STATIC
 CHAR16 *
-BmGetBootDescription (
+BmBuildBootDescription (
   IN EFI_HANDLE  Handle
   )
 {
@@ -848,6 +882,75 @@ BmGetBootDescription (
   return DefaultDescription;
 }
 
+/**
+  Return the boot description for the controller.
+
+  The description is built once for a handle and its device path, later calls
+  return a copy of the cached one.
+
+  @param Handle                Controller handle.
+
+  @return  The description string.
+**/
+CHAR16 *
+BmGetBootDescription (
+  IN EFI_HANDLE  Handle
+  )
+{
+  LIST_ENTRY                       *Link;
+  BM_BOOT_DESCRIPTION_CACHE_ENTRY  *Entry;
+  EFI_DEVICE_PATH_PROTOCOL         *DevicePath;
+  CHAR16                           *Description;
+  UINTN                            DevicePathSize;
+
+  DevicePath = DevicePathFromHandle (Handle);
+  if (DevicePath == NULL) {
+    return BmBuildBootDescription (Handle);
+  }
+
+  DevicePathSize = GetDevicePathSize (DevicePath);
+  for ( Link = GetFirstNode (&mBmBootDescriptionCache)
+        ; !IsNull (&mBmBootDescriptionCache, Link)
+        ; Link = GetNextNode (&mBmBootDescriptionCache, Link)
+        )
+  {
+    Entry = CR (Link, BM_BOOT_DESCRIPTION_CACHE_ENTRY, Link, BM_BOOT_DESCRIPTION_CACHE_ENTRY_SIGNATURE);
+    if ((Entry->Handle == Handle) &&
+        (GetDevicePathSize (Entry->DevicePath) == DevicePathSize) &&
+        (CompareMem (Entry->DevicePath, DevicePath, DevicePathSize) == 0))
+    {
+      Description = AllocateCopyPool (StrSize (Entry->Description), Entry->Description);
+      ASSERT (Description != NULL);
+      return Description;
+    }
+  }
+
+  Description = BmBuildBootDescription (Handle);
+
+  Entry = AllocatePool (sizeof (BM_BOOT_DESCRIPTION_CACHE_ENTRY));
+  if (Entry != NULL) {
+    Entry->Signature   = BM_BOOT_DESCRIPTION_CACHE_ENTRY_SIGNATURE;
+    Entry->Handle      = Handle;
+    Entry->DevicePath  = DuplicateDevicePath (DevicePath);
+    Entry->Description = AllocateCopyPool (StrSize (Description), Description);
+    if ((Entry->DevicePath != NULL) && (Entry->Description != NULL)) {
+      InsertTailList (&mBmBootDescriptionCache, &Entry->Link);
+    } else {
+      if (Entry->DevicePath != NULL) {
+        FreePool (Entry->DevicePath);
+      }
+
+      if (Entry->Description != NULL) {
+        FreePool (Entry->Description);
+      }
+
+      FreePool (Entry);
+    }
+  }
+
+  return Description;
+}
+
 /**
   Enumerate all boot option descriptions and append " 2"/" 3"/... to make
   unique description.
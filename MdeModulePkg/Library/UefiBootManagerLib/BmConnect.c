@@ -85,6 +85,134 @@ EfiBootManagerConnectAll (
   EfiBootManagerConnectAllDefaultConsoles ();
 }
 
+/**
+  Connect the device of the boot option that will be tried first: BootNext
+  if set, otherwise the first active option in BootOrder.
+
+  A short-form device path is not connected here, BmGetNextLoadOptionDevicePath()
+  expands it and connects what it needs when the option is booted.
+
+  @retval EFI_SUCCESS    The device was connected, or is connected at boot time.
+  @retval EFI_NOT_FOUND  There is no boot option, or its device could not be connected.
+**/
+EFI_STATUS
+BmConnectFirstBootOption (
+  VOID
+  )
+{
+  EFI_STATUS                    Status;
+  UINT16                        *BootNext;
+  CHAR16                        OptionName[BM_OPTION_NAME_LEN];
+  EFI_BOOT_MANAGER_LOAD_OPTION  BootNextOption;
+  EFI_BOOT_MANAGER_LOAD_OPTION  *BootOptions;
+  EFI_BOOT_MANAGER_LOAD_OPTION  *BootOption;
+  UINTN                         BootOptionCount;
+  UINTN                         Index;
+
+  BootOption      = NULL;
+  BootOptions     = NULL;
+  BootOptionCount = 0;
+
+  GetEfiGlobalVariable2 (EFI_BOOT_NEXT_VARIABLE_NAME, (VOID **)&BootNext, NULL);
+  if (BootNext != NULL) {
+    UnicodeSPrint (OptionName, sizeof (OptionName), L"%s%04x", mBmLoadOptionName[LoadOptionTypeBoot], *BootNext);
+    FreePool (BootNext);
+    Status = EfiBootManagerVariableToLoadOption (OptionName, &BootNextOption);
+    if (!EFI_ERROR (Status)) {
+      BootOption = &BootNextOption;
+    }
+  }
+
+  if (BootOption == NULL) {
+    BootOptions = EfiBootManagerGetLoadOptions (&BootOptionCount, LoadOptionTypeBoot);
+    for (Index = 0; Index < BootOptionCount; Index++) {
+      if ((BootOptions[Index].Attributes & LOAD_OPTION_ACTIVE) != 0) {
+        BootOption = &BootOptions[Index];
+        break;
+      }
+    }
+  }
+
+  if (BootOption == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  Status = EFI_SUCCESS;
+  if ((DevicePathType (BootOption->FilePath) == ACPI_DEVICE_PATH) ||
+      (DevicePathType (BootOption->FilePath) == HARDWARE_DEVICE_PATH))
+  {
+    Status = EfiBootManagerConnectDevicePath (BootOption->FilePath, NULL);
+  }
+
+  DEBUG ((DEBUG_INFO, "[Bds] Minimal connect: Boot%04x - %r\n", BootOption->OptionNumber, Status));
+
+  if (BootOption == &BootNextOption) {
+    EfiBootManagerFreeLoadOption (&BootNextOption);
+  } else {
+    EfiBootManagerFreeLoadOptions (BootOptions, BootOptionCount);
+  }
+
+  return EFI_ERROR (Status) ? EFI_NOT_FOUND : EFI_SUCCESS;
+}
+
+/**
+  Connect only the controllers a normal boot needs: the consoles named by
+  ConIn, ConOut and ErrOut, and the device of the boot option that will be
+  tried first (BootNext, otherwise the first active option in BootOrder).
+
+  EfiBootManagerConnectAll() is performed instead when the consoles or the
+  boot device cannot be connected, or when a key is pending on the console
+  input so that the user may be entering a hotkey or the setup menu.
+
+  @retval EFI_SUCCESS    Only the consoles and the boot device were connected.
+  @retval EFI_NOT_FOUND  A console or the boot device could not be connected,
+                         all controllers were connected instead.
+  @retval EFI_ABORTED    A key was pending, all controllers were connected
+                         instead.
+**/
+EFI_STATUS
+EFIAPI
+EfiBootManagerConnectMinimal (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  EFI_HANDLE  *HandleBuffer;
+  UINTN       HandleCount;
+
+  Status = EfiBootManagerConnectAllDefaultConsoles ();
+  if (!EFI_ERROR (Status)) {
+    Status = BmConnectFirstBootOption ();
+  }
+
+  if (!EFI_ERROR (Status) &&
+      (((gST->ConIn != NULL) && !EFI_ERROR (gBS->CheckEvent (gST->ConIn->WaitForKey))) ||
+       (mBmHotkeyBootOption.OptionNumber != LoadOptionNumberUnassigned)))
+  {
+    Status = EFI_ABORTED;
+  }
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "[Bds] Minimal connect falls back to connect all - %r\n", Status));
+    EfiBootManagerConnectAll ();
+    return Status;
+  }
+
+  //
+  // Record how much of the connect-all work was skipped.
+  //
+  DEBUG_CODE_BEGIN ();
+  Status = gBS->LocateHandleBuffer (AllHandles, NULL, NULL, &HandleCount, &HandleBuffer);
+  if (!EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "[Bds] Minimal connect skipped connect all over %d handles\n", HandleCount));
+    FreePool (HandleBuffer);
+  }
+
+  DEBUG_CODE_END ();
+
+  return EFI_SUCCESS;
+}
+
 /**
   This function will create all handles associate with every device
   path node. If the handle associate with one device path node can not
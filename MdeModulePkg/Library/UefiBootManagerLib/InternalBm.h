@@ -104,6 +104,11 @@ CHAR16 *
 #define BM_OPTION_NAME_LEN  sizeof ("PlatformRecovery####")
 extern CHAR16  *mBmLoadOptionName[];
 
+//
+// The boot option selected by a hotkey, waiting to be booted
+//
+extern EFI_BOOT_MANAGER_LOAD_OPTION  mBmHotkeyBootOption;
+
 //
 // Maximum number of reconnect retry to repair controller; it is to limit the
 // number of recursive call of BmRepairAllControllers.
@@ -145,6 +150,15 @@ typedef struct {
   EFI_BOOT_MANAGER_BOOT_DESCRIPTION_HANDLER    Handler;
 } BM_BOOT_DESCRIPTION_ENTRY;
 
+#define BM_BOOT_DESCRIPTION_CACHE_ENTRY_SIGNATURE  SIGNATURE_32 ('b', 'm', 'd', 'c')
+typedef struct {
+  UINT32                      Signature;
+  LIST_ENTRY                  Link;
+  EFI_HANDLE                  Handle;
+  EFI_DEVICE_PATH_PROTOCOL    *DevicePath;
+  CHAR16                      *Description;
+} BM_BOOT_DESCRIPTION_CACHE_ENTRY;
+
 /**
   Repair all the controllers according to the Driver Health status queried.
 
@@ -367,6 +381,14 @@ BmGetBootDescription (
   IN EFI_HANDLE  Handle
   );
 
+/**
+  Free all the descriptions cached by BmGetBootDescription().
+**/
+VOID
+BmFreeBootDescriptionCache (
+  VOID
+  );
+
 /**
   Enumerate all boot option descriptions and append " 2"/" 3"/... to make
   unique description.
@@ -0,0 +1,86 @@
+/** @file
+  Implements for functions declared in ZstdDecUefiSupport.h
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+#include <ZstdDecUefiSupport.h>
+
+/**
+  Copies bytes between buffers.
+**/
+VOID *
+memcpy (
+  OUT VOID       *Dest,
+  IN  CONST VOID *Src,
+  IN  size_t     Count
+  )
+{
+  return CopyMem (Dest, Src, Count);
+}
+
+/**
+  Copies bytes between buffers that may overlap.
+**/
+VOID *
+memmove (
+  OUT VOID       *Dest,
+  IN  CONST VOID *Src,
+  IN  size_t     Count
+  )
+{
+  return CopyMem (Dest, Src, Count);
+}
+
+/**
+  Sets buffers to a specified character.
+**/
+VOID *
+memset (
+  OUT VOID    *Dest,
+  IN  int     Ch,
+  IN  size_t  Count
+  )
+{
+  return SetMem (Dest, Count, (UINT8)Ch);
+}
+
+/**
+  Dummy malloc function for compiler.
+
+  The decompression context lives in the scratch buffer, so ZSTD never
+  allocates memory.
+**/
+VOID *
+malloc (
+  IN size_t  Size
+  )
+{
+  ASSERT (FALSE);
+  return NULL;
+}
+
+/**
+  Dummy calloc function for compiler.
+**/
+VOID *
+calloc (
+  IN size_t  Count,
+  IN size_t  Size
+  )
+{
+  ASSERT (FALSE);
+  return NULL;
+}
+
+/**
+  Dummy free function for compiler.
+**/
+VOID
+free (
+  IN VOID  *Ptr
+  )
+{
+  ASSERT (FALSE);
+}
@@ -0,0 +1,102 @@
+/** @file
+  ZSTD UEFI header file for definitions
+
+  Allows ZSTD code to build under UEFI (edk2) build environment
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __ZSTD_DECOMPRESS_UEFI_SUP_H__
+#define __ZSTD_DECOMPRESS_UEFI_SUP_H__
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+
+//
+// ZSTD defines RETURN_ERROR() and BITn macros of its own. Every ZSTD source
+// file includes this file before them, and ZSTD has no use for the Base.h
+// ones.
+//
+#undef RETURN_ERROR
+#undef BIT7
+#undef BIT6
+#undef BIT5
+#undef BIT4
+#undef BIT1
+#undef BIT0
+
+#define CHAR_BIT    8
+#define SCHAR_MIN   MIN_INT8
+#define SCHAR_MAX   MAX_INT8
+#define UCHAR_MAX   MAX_UINT8
+#define SHRT_MIN    MIN_INT16
+#define SHRT_MAX    MAX_INT16
+#define USHRT_MAX   MAX_UINT16
+#define INT_MIN     MIN_INT32
+#define INT_MAX     MAX_INT32
+#define UINT_MAX    MAX_UINT32
+#define LLONG_MIN   MIN_INT64
+#define LLONG_MAX   MAX_INT64
+#define ULLONG_MAX  MAX_UINT64
+#define SIZE_MAX    MAX_UINTN
+
+#define offsetof(Type, Field)  OFFSET_OF (Type, Field)
+
+typedef INT8    int8_t;
+typedef INT16   int16_t;
+typedef INT32   int32_t;
+typedef INT64   int64_t;
+typedef UINT8   uint8_t;
+typedef UINT16  uint16_t;
+typedef UINT32  uint32_t;
+typedef UINT64  uint64_t;
+typedef INTN    intptr_t;
+typedef UINTN   uintptr_t;
+typedef INTN    ptrdiff_t;
+typedef UINTN   size_t;
+
+//
+// The compiler may turn structure copies and ZSTD_memcpy() into calls to
+// these functions, so they have to be real functions and not macros.
+//
+VOID *
+memcpy (
+  OUT VOID       *Dest,
+  IN  CONST VOID *Src,
+  IN  size_t     Count
+  );
+
+VOID *
+memmove (
+  OUT VOID       *Dest,
+  IN  CONST VOID *Src,
+  IN  size_t     Count
+  );
+
+VOID *
+memset (
+  OUT VOID    *Dest,
+  IN  int     Ch,
+  IN  size_t  Count
+  );
+
+VOID *
+malloc (
+  IN size_t  Size
+  );
+
+VOID *
+calloc (
+  IN size_t  Count,
+  IN size_t  Size
+  );
+
+VOID
+free (
+  IN VOID  *Ptr
+  );
+
+#endif
@@ -0,0 +1,125 @@
+/** @file
+  Zstandard Decompress interfaces
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+#include <ZstdDecompressLibInternal.h>
+
+/**
+  Given a Zstandard compressed source buffer, this function retrieves the size
+  of the uncompressed buffer and the size of the scratch buffer required
+  to decompress the compressed source buffer.
+
+  Retrieves the size of the uncompressed buffer from the frame header of the
+  compressed source buffer, and returns the size of the scratch buffer in
+  which the decompression context is built.
+  This function does not need to allocate any memory.
+
+  @param  Source          The source buffer containing the compressed data.
+  @param  SourceSize      The size, in bytes, of the source buffer.
+  @param  DestinationSize A pointer to the size, in bytes, of the uncompressed buffer
+                          that will be generated when the compressed buffer specified
+                          by Source and SourceSize is decompressed.
+  @param  ScratchSize     A pointer to the size, in bytes, of the scratch buffer that
+                          is required to decompress the compressed buffer specified
+                          by Source and SourceSize.
+
+  @retval EFI_SUCCESS     The size of the uncompressed data was returned
+                          in DestinationSize and the size of the scratch
+                          buffer was returned in ScratchSize.
+  @retval EFI_INVALID_PARAMETER
+                          The frame header does not hold the size of the
+                          uncompressed data, or the size is too large.
+**/
+EFI_STATUS
+EFIAPI
+ZstdUefiDecompressGetInfo (
+  IN  CONST VOID  *Source,
+  IN  UINT32      SourceSize,
+  OUT UINT32      *DestinationSize,
+  OUT UINT32      *ScratchSize
+  )
+{
+  unsigned long long  ContentSize;
+
+  ASSERT (Source != NULL);
+  ASSERT (DestinationSize != NULL);
+  ASSERT (ScratchSize != NULL);
+
+  ContentSize = ZSTD_getFrameContentSize (Source, SourceSize);
+  if ((ContentSize == ZSTD_CONTENTSIZE_UNKNOWN) ||
+      (ContentSize == ZSTD_CONTENTSIZE_ERROR) ||
+      (ContentSize > MAX_UINT32))
+  {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  *DestinationSize = (UINT32)ContentSize;
+  *ScratchSize     = (UINT32)ZSTD_estimateDCtxSize ();
+  return EFI_SUCCESS;
+}
+
+/**
+  Decompresses a Zstandard compressed source buffer.
+
+  Extracts decompressed data to its original form.
+  If the compressed source data specified by Source is successfully decompressed
+  into Destination, then EFI_SUCCESS is returned. If the compressed source data
+  specified by Source is not in a valid compressed data format,
+  then EFI_INVALID_PARAMETER is returned.
+
+  The whole frame is decoded in one pass straight into Destination, so no
+  window buffer is needed besides the decompression context in Scratch.
+
+  @param  Source      The source buffer containing the compressed data.
+  @param  SourceSize  The size of source buffer.
+  @param  Destination The destination buffer to store the decompressed data
+  @param  Scratch     A temporary scratch buffer that is used to perform the decompression.
+                      This is an optional parameter that may be NULL if the
+                      required scratch buffer size is 0.
+
+  @retval EFI_SUCCESS Decompression completed successfully, and
+                      the uncompressed buffer is returned in Destination.
+  @retval EFI_INVALID_PARAMETER
+                      The source buffer specified by Source is corrupted
+                      (not in a valid compressed format).
+**/
+EFI_STATUS
+EFIAPI
+ZstdUefiDecompress (
+  IN CONST VOID  *Source,
+  IN UINTN       SourceSize,
+  IN OUT VOID    *Destination,
+  IN OUT VOID    *Scratch
+  )
+{
+  unsigned long long  ContentSize;
+  ZSTD_DCtx           *DCtx;
+  size_t              Result;
+
+  ASSERT (Source != NULL);
+  ASSERT (Destination != NULL);
+  ASSERT (Scratch != NULL);
+
+  ContentSize = ZSTD_getFrameContentSize (Source, SourceSize);
+  if ((ContentSize == ZSTD_CONTENTSIZE_UNKNOWN) ||
+      (ContentSize == ZSTD_CONTENTSIZE_ERROR) ||
+      (ContentSize > MAX_UINT32))
+  {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  DCtx = ZSTD_initStaticDCtx (Scratch, ZSTD_estimateDCtxSize ());
+  if (DCtx == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Result = ZSTD_decompressDCtx (DCtx, Destination, (size_t)ContentSize, Source, SourceSize);
+  if (ZSTD_isError (Result) || (Result != ContentSize)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  return EFI_SUCCESS;
+}
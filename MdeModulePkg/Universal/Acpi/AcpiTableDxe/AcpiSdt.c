@@ -25,6 +25,12 @@ EFI_ACPI_SDT_PROTOCOL  mAcpiSdtProtocolTemplate = {
   FindPath
 };
 
+//
+// Changed by SetOption(), so that namespace indexes built before the change
+// are rebuilt by the next FindPath().
+//
+UINTN  mAmlNameSpaceGeneration = 0;
+
 /**
   This function returns ACPI Table instance.
 
@@ -489,6 +495,7 @@ SdtOpenSdtTable (
   AmlHandle->Size            = Table->Table->Length - sizeof (EFI_ACPI_SDT_HEADER);
   AmlHandle->AmlByteEncoding = NULL;
   AmlHandle->Modified        = FALSE;
+  AmlHandle->NameSpace       = NULL;
 
   //
   // return the ACPI handle
@@ -565,6 +572,7 @@ SdtOpenEx (
   AmlHandle->Buffer          = Buffer;
   AmlHandle->AmlByteEncoding = AmlByteEncoding;
   AmlHandle->Modified        = FALSE;
+  AmlHandle->NameSpace       = NULL;
 
   AmlHandle->Size = AmlGetObjectSize (AmlByteEncoding, Buffer, BufferSize);
   if (AmlHandle->Size == 0) {
@@ -615,6 +623,29 @@ Open (
   return SdtOpenEx (Buffer, MaxSize, Handle);
 }
 
+/**
+  Free the namespace index of a root handle.
+
+  @param[in]    NameSpace   The namespace index to free.
+**/
+VOID
+SdtFreeNameSpace (
+  IN EFI_AML_NAMESPACE  *NameSpace
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < NameSpace->Count; Index++) {
+    AmlDestructNodeList (NameSpace->Entry[Index].NodeList);
+  }
+
+  if (NameSpace->Entry != NULL) {
+    FreePool (NameSpace->Entry);
+  }
+
+  FreePool (NameSpace);
+}
+
 /**
   Close an ACPI handle.
 
@@ -656,6 +687,10 @@ Close (
     }
   }
 
+  if (AmlHandle->NameSpace != NULL) {
+    SdtFreeNameSpace (AmlHandle->NameSpace);
+  }
+
   FreePool (AmlHandle);
 
   return EFI_SUCCESS;
@@ -800,6 +835,7 @@ SetOption (
   //
   CopyMem (OrgData, Data, DataSize);
   AmlHandle->Modified = TRUE;
+  mAmlNameSpaceGeneration++;
 
   return EFI_SUCCESS;
 }
@@ -929,10 +965,94 @@ SdtDuplicateHandle (
   DstAmlHandle = AllocatePool (sizeof (*DstAmlHandle));
   ASSERT (DstAmlHandle != NULL);
   CopyMem (DstAmlHandle, (VOID *)AmlHandle, sizeof (*DstAmlHandle));
+  DstAmlHandle->NameSpace = NULL;
 
   return DstAmlHandle;
 }
 
+/**
+  Build the namespace index of a root handle.
+
+  The namespace tree of every top-level object of the table is built once, so
+  that the following FindPath() calls from the root handle do not parse the
+  table again.
+
+  @param[in]    AmlHandle   The root handle.
+
+  @return The namespace index, or NULL if the table could not be parsed or
+          memory could not be allocated.
+**/
+EFI_AML_NAMESPACE *
+SdtCreateNameSpace (
+  IN EFI_AML_HANDLE  *AmlHandle
+  )
+{
+  EFI_AML_NAMESPACE        *NameSpace;
+  EFI_AML_NAMESPACE_ENTRY  *Entry;
+  EFI_ACPI_HANDLE          ChildHandle;
+  EFI_ACPI_HANDLE          PreviousHandle;
+  EFI_AML_HANDLE           *AmlChildHandle;
+  EFI_AML_NODE_LIST        *NodeList;
+  EFI_STATUS               Status;
+  UINTN                    Capacity;
+
+  NameSpace = AllocateZeroPool (sizeof (*NameSpace));
+  if (NameSpace == NULL) {
+    return NULL;
+  }
+
+  NameSpace->Generation = mAmlNameSpaceGeneration;
+  Capacity              = 0;
+  ChildHandle           = NULL;
+  while (TRUE) {
+    PreviousHandle = ChildHandle;
+    Status         = GetChild ((EFI_ACPI_HANDLE)AmlHandle, &ChildHandle);
+    if (PreviousHandle != NULL) {
+      FreePool (PreviousHandle);
+    }
+
+    if (EFI_ERROR (Status)) {
+      goto Error;
+    }
+
+    if (ChildHandle == NULL) {
+      return NameSpace;
+    }
+
+    if (NameSpace->Count == Capacity) {
+      Entry = ReallocatePool (
+                Capacity * sizeof (*Entry),
+                (Capacity + 16) * sizeof (*Entry),
+                NameSpace->Entry
+                );
+      if (Entry == NULL) {
+        goto FreeChild;
+      }
+
+      NameSpace->Entry = Entry;
+      Capacity        += 16;
+    }
+
+    AmlChildHandle = (EFI_AML_HANDLE *)ChildHandle;
+    Status         = AmlCreateNameSpace (AmlChildHandle, &NodeList);
+    if (EFI_ERROR (Status)) {
+      goto FreeChild;
+    }
+
+    Entry           = &NameSpace->Entry[NameSpace->Count];
+    Entry->Buffer   = AmlChildHandle->Buffer;
+    Entry->Size     = AmlChildHandle->Size;
+    Entry->NodeList = NodeList;
+    NameSpace->Count++;
+  }
+
+FreeChild:
+  FreePool (ChildHandle);
+Error:
+  SdtFreeNameSpace (NameSpace);
+  return NULL;
+}
+
 /**
   Returns the handle of the ACPI object representing the specified ACPI path
 
@@ -951,10 +1071,12 @@ SdtFindPathFromRoot (
   OUT   EFI_ACPI_HANDLE  *HandleOut
   )
 {
-  EFI_ACPI_HANDLE  ChildHandle;
-  EFI_AML_HANDLE   *AmlHandle;
-  EFI_STATUS       Status;
-  VOID             *Buffer;
+  EFI_ACPI_HANDLE    ChildHandle;
+  EFI_AML_HANDLE     *AmlHandle;
+  EFI_STATUS         Status;
+  VOID               *Buffer;
+  EFI_AML_NAMESPACE  *NameSpace;
+  UINTN              Index;
 
   Buffer    = NULL;
   AmlHandle = (EFI_AML_HANDLE *)HandleIn;
@@ -971,7 +1093,40 @@ SdtFindPathFromRoot (
   }
 
   //
-  // Let children find it.
+  // Search the namespace index of the table, rebuilding it if an object
+  // was changed since it was built.
+  //
+  if ((AmlHandle->NameSpace != NULL) && (AmlHandle->NameSpace->Generation != mAmlNameSpaceGeneration)) {
+    SdtFreeNameSpace (AmlHandle->NameSpace);
+    AmlHandle->NameSpace = NULL;
+  }
+
+  if (AmlHandle->NameSpace == NULL) {
+    AmlHandle->NameSpace = SdtCreateNameSpace (AmlHandle);
+  }
+
+  NameSpace = AmlHandle->NameSpace;
+  if (NameSpace != NULL) {
+    for (Index = 0; Index < NameSpace->Count; Index++) {
+      Buffer = AmlFindPathInNameSpace (NameSpace->Entry[Index].NodeList, AmlPath, TRUE);
+      if (Buffer != NULL) {
+        Status = SdtOpenEx (
+                   Buffer,
+                   (UINTN)NameSpace->Entry[Index].Buffer + NameSpace->Entry[Index].Size - (UINTN)Buffer,
+                   HandleOut
+                   );
+        if (!EFI_ERROR (Status)) {
+          return EFI_SUCCESS;
+        }
+      }
+    }
+
+    *HandleOut = NULL;
+    return EFI_SUCCESS;
+  }
+
+  //
+  // The table could not be indexed. Let children find it.
   //
   ChildHandle = NULL;
   while (TRUE) {
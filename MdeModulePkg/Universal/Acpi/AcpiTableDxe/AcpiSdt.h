@@ -79,6 +79,29 @@ struct _EFI_AML_NODE_LIST {
 #define EFI_AML_HANDLE_SIGNATURE       SIGNATURE_32 ('E', 'A', 'H', 'S')
 #define EFI_AML_ROOT_HANDLE_SIGNATURE  SIGNATURE_32 ('E', 'A', 'R', 'H')
 
+//
+// AML Namespace Index definition.
+//
+//  Buffer and Size describe a top-level object of the table.
+//  NodeList is the namespace tree of that object.
+//
+typedef struct {
+  UINT8                *Buffer;
+  UINTN                Size;
+  EFI_AML_NODE_LIST    *NodeList;
+} EFI_AML_NAMESPACE_ENTRY;
+
+//
+//  Generation is the value of mAmlNameSpaceGeneration when the index was
+//  built. SetOption() changes it, so that FindPath() rebuilds the index.
+//  Entry is the list of top-level objects, in table order.
+//
+typedef struct {
+  UINTN                      Generation;
+  UINTN                      Count;
+  EFI_AML_NAMESPACE_ENTRY    *Entry;
+} EFI_AML_NAMESPACE;
+
 //
 // AML Handle Entry definition.
 //
@@ -86,6 +109,9 @@ struct _EFI_AML_NODE_LIST {
 //  Buffer is the ACPI node buffer pointer, the first/second bytes are opcode.
 //         This buffer should not be freed.
 //  Size is the total size of this ACPI node buffer.
+//  NameSpace is the namespace index of a root handle, built by the first
+//         FindPath() from it and freed when it is closed. It is always NULL
+//         for other handles.
 //
 typedef struct {
   UINT32               Signature;
@@ -93,6 +119,7 @@ typedef struct {
   UINTN                Size;
   AML_BYTE_ENCODING    *AmlByteEncoding;
   BOOLEAN              Modified;
+  EFI_AML_NAMESPACE    *NameSpace;
 } EFI_AML_HANDLE;
 
 typedef UINT32 AML_OP_PARSE_INDEX;
@@ -543,6 +570,52 @@ AmlFindPath (
   IN    BOOLEAN         FromRoot
   );
 
+/**
+  Build the namespace tree of an ACPI object.
+
+  @param[in]    AmlHandle            AML handle of the object.
+  @param[out]   AmlRootNodeList      On return, points to the root node of the
+                                     tree. The caller frees it with
+                                     AmlDestructNodeList().
+
+  @retval EFI_SUCCESS           Success
+  @retval EFI_INVALID_PARAMETER AmlHandle does not refer to a valid ACPI object.
+**/
+EFI_STATUS
+AmlCreateNameSpace (
+  IN    EFI_AML_HANDLE     *AmlHandle,
+  OUT   EFI_AML_NODE_LIST  **AmlRootNodeList
+  );
+
+/**
+  Find an ACPI AML path in a namespace tree built by AmlCreateNameSpace().
+
+  @param[in]    AmlRootNodeList  The root node of the tree.
+  @param[in]    AmlPath          Points to the ACPI AML path.
+  @param[in]    FromRoot         TRUE means to find AML path from \ (Root) Node.
+                                 FALSE means to find AML path from the object
+                                 the tree was built for.
+
+  @return       The ACPI object which represents AmlPath, or NULL if it is not
+                found.
+**/
+VOID *
+AmlFindPathInNameSpace (
+  IN    EFI_AML_NODE_LIST  *AmlRootNodeList,
+  IN    UINT8              *AmlPath,
+  IN    BOOLEAN            FromRoot
+  );
+
+/**
+  Destruct node list
+
+  @param[in]    AmlParentNodeList    AML parent node list.
+**/
+VOID
+AmlDestructNodeList (
+  IN EFI_AML_NODE_LIST  *AmlParentNodeList
+  );
+
 /**
   Print AML NameString.
 
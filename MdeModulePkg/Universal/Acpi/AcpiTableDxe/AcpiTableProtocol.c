@@ -344,9 +344,10 @@ ReallocateAcpiTableBuffer (
 
   CopyMem (&TempPrivateData, AcpiTableInstance, sizeof (EFI_ACPI_TABLE_INSTANCE));
   //
-  // Enlarge the max table number from mEfiAcpiMaxNumTables to mEfiAcpiMaxNumTables + EFI_ACPI_MAX_NUM_TABLES
+  // Double the max table number, so that installing many tables one at a time (e.g. the
+  // SSDTs of a dynamic tables platform) moves the RSDT/XSDT a logarithmic number of times.
   //
-  NewMaxTableNumber = mEfiAcpiMaxNumTables + EFI_ACPI_MAX_NUM_TABLES;
+  NewMaxTableNumber = mEfiAcpiMaxNumTables + MAX (mEfiAcpiMaxNumTables, EFI_ACPI_MAX_NUM_TABLES);
   //
   // Create RSDT, XSDT structures and allocate buffers.
   //
@@ -1147,7 +1148,10 @@ AddTableToList (
     }
   }
 
-  ChecksumCommonTables (AcpiTableInstance);
+  //
+  // The RSDP/RSDT/XSDT checksums are left to PublishTables (), which every caller runs once
+  // it is done adding tables and which has to checksum them again after reordering the FADT.
+  //
   return EFI_SUCCESS;
 }
 
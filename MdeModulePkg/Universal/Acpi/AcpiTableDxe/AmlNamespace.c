@@ -501,61 +501,75 @@ AmlDumpNodeInfo (
 }
 
 /**
-  Returns the handle of the ACPI object representing the specified ACPI AML path
+  Build the namespace tree of an ACPI object.
 
-  @param[in]    AmlHandle   Points to the handle of the object representing the starting point for the path search.
-  @param[in]    AmlPath     Points to the ACPI AML path.
-  @param[out]   Buffer      On return, points to the ACPI object which represents AcpiPath, relative to
-                            HandleIn.
-  @param[in]    FromRoot    TRUE means to find AML path from \ (Root) Node.
-                            FALSE means to find AML path from this Node (The HandleIn).
+  @param[in]    AmlHandle            AML handle of the object.
+  @param[out]   AmlRootNodeList      On return, points to the root node of the
+                                     tree. The caller frees it with
+                                     AmlDestructNodeList().
 
   @retval EFI_SUCCESS           Success
-  @retval EFI_INVALID_PARAMETER HandleIn does not refer to a valid ACPI object.
+  @retval EFI_INVALID_PARAMETER AmlHandle does not refer to a valid ACPI object.
 **/
 EFI_STATUS
-AmlFindPath (
-  IN    EFI_AML_HANDLE  *AmlHandle,
-  IN    UINT8           *AmlPath,
-  OUT   VOID            **Buffer,
-  IN    BOOLEAN         FromRoot
+AmlCreateNameSpace (
+  IN    EFI_AML_HANDLE     *AmlHandle,
+  OUT   EFI_AML_NODE_LIST  **AmlRootNodeList
   )
 {
-  EFI_AML_NODE_LIST  *AmlRootNodeList;
+  EFI_AML_NODE_LIST  *RootNodeList;
   EFI_STATUS         Status;
-  EFI_AML_NODE_LIST  *AmlNodeList;
   UINT8              RootNameSeg[AML_NAME_SEG_SIZE];
-  EFI_AML_NODE_LIST  *CurrentAmlNodeList;
-  LIST_ENTRY         *CurrentLink;
-
-  //
-  // 1. create tree
-  //
 
   //
   // Create root handle
   //
-  RootNameSeg[0]  = AML_ROOT_CHAR;
-  RootNameSeg[1]  = 0;
-  AmlRootNodeList = AmlCreateNode (RootNameSeg, NULL, AmlHandle->AmlByteEncoding);
+  RootNameSeg[0] = AML_ROOT_CHAR;
+  RootNameSeg[1] = 0;
+  RootNodeList   = AmlCreateNode (RootNameSeg, NULL, AmlHandle->AmlByteEncoding);
 
   Status = AmlConstructNodeList (
              AmlHandle,
-             AmlRootNodeList, // Root
-             AmlRootNodeList  // Parent
+             RootNodeList, // Root
+             RootNodeList  // Parent
              );
   if (EFI_ERROR (Status)) {
+    AmlDestructNodeList (RootNodeList);
     return EFI_INVALID_PARAMETER;
   }
 
   DEBUG_CODE_BEGIN ();
   DEBUG ((DEBUG_ERROR, "AcpiSdt: NameSpace:\n"));
-  AmlDumpNodeInfo (AmlRootNodeList, 0);
+  AmlDumpNodeInfo (RootNodeList, 0);
   DEBUG_CODE_END ();
 
-  //
-  // 2. Search the node in the tree
-  //
+  *AmlRootNodeList = RootNodeList;
+  return EFI_SUCCESS;
+}
+
+/**
+  Find an ACPI AML path in a namespace tree built by AmlCreateNameSpace().
+
+  @param[in]    AmlRootNodeList  The root node of the tree.
+  @param[in]    AmlPath          Points to the ACPI AML path.
+  @param[in]    FromRoot         TRUE means to find AML path from \ (Root) Node.
+                                 FALSE means to find AML path from the object
+                                 the tree was built for.
+
+  @return       The ACPI object which represents AmlPath, or NULL if it is not
+                found.
+**/
+VOID *
+AmlFindPathInNameSpace (
+  IN    EFI_AML_NODE_LIST  *AmlRootNodeList,
+  IN    UINT8              *AmlPath,
+  IN    BOOLEAN            FromRoot
+  )
+{
+  EFI_AML_NODE_LIST  *AmlNodeList;
+  EFI_AML_NODE_LIST  *CurrentAmlNodeList;
+  LIST_ENTRY         *CurrentLink;
+
   if (FromRoot) {
     //
     // Search from Root
@@ -599,16 +613,54 @@ AmlFindPath (
     AmlNodeList = NULL;
   }
 
-  *Buffer = NULL;
-  Status  = EFI_SUCCESS;
   if ((AmlNodeList != NULL) && (AmlNodeList->Buffer != NULL)) {
-    *Buffer = AmlNodeList->Buffer;
+    return AmlNodeList->Buffer;
+  }
+
+  return NULL;
+}
+
+/**
+  Returns the handle of the ACPI object representing the specified ACPI AML path
+
+  @param[in]    AmlHandle   Points to the handle of the object representing the starting point for the path search.
+  @param[in]    AmlPath     Points to the ACPI AML path.
+  @param[out]   Buffer      On return, points to the ACPI object which represents AcpiPath, relative to
+                            HandleIn.
+  @param[in]    FromRoot    TRUE means to find AML path from \ (Root) Node.
+                            FALSE means to find AML path from this Node (The HandleIn).
+
+  @retval EFI_SUCCESS           Success
+  @retval EFI_INVALID_PARAMETER HandleIn does not refer to a valid ACPI object.
+**/
+EFI_STATUS
+AmlFindPath (
+  IN    EFI_AML_HANDLE  *AmlHandle,
+  IN    UINT8           *AmlPath,
+  OUT   VOID            **Buffer,
+  IN    BOOLEAN         FromRoot
+  )
+{
+  EFI_AML_NODE_LIST  *AmlRootNodeList;
+  EFI_STATUS         Status;
+
+  //
+  // 1. create tree
+  //
+  Status = AmlCreateNameSpace (AmlHandle, &AmlRootNodeList);
+  if (EFI_ERROR (Status)) {
+    return EFI_INVALID_PARAMETER;
   }
 
+  //
+  // 2. Search the node in the tree
+  //
+  *Buffer = AmlFindPathInNameSpace (AmlRootNodeList, AmlPath, FromRoot);
+
   //
   // 3. free the tree
   //
   AmlDestructNodeList (AmlRootNodeList);
 
-  return Status;
+  return EFI_SUCCESS;
 }
@@ -10,7 +10,7 @@
   into memory.
 
 (C) Copyright 2014 Hewlett-Packard Development Company, L.P.<BR>
-Copyright (c) 2011 - 2018, Intel Corporation. All rights reserved.<BR>
+Copyright (c) 2011 - 2024, Intel Corporation. All rights reserved.<BR>
 SPDX-License-Identifier: BSD-2-Clause-Patent
 
 **/
@@ -1195,10 +1195,58 @@ CapsuleDataCoalesce (
 
   PrivateDataPtr = (EFI_CAPSULE_PEIM_PRIVATE_DATA *)NewCapsuleBase;
 
+  //
+  // Plan the copy before anything is written. The blocks are copied in order
+  // to consecutive destinations, so a block is only overwritten before it is
+  // copied if its data overlaps the destinations of the blocks before it,
+  // from NewCapsuleBase to its own destination. Relocate these blocks now,
+  // each at most once. A block that only overlaps its own destination is
+  // moved by CopyMem() directly, and a block that is already at its
+  // destination is not copied at all. Note that the block descriptors were
+  // coalesced when they were relocated, so we can just ++ the pointer.
+  //
+  for (TempBlockDesc = BlockList; TempBlockDesc->Length != 0; TempBlockDesc++) {
+    if (TempBlockDesc == BlockList) {
+      DestLength = sizeof (EFI_CAPSULE_PEIM_PRIVATE_DATA) + (CapsuleNumber - 1) * sizeof (UINT64);
+    } else {
+      DestLength = (UINTN)TempBlockDesc->Length;
+    }
+
+    if ((DestPtr != (UINT8 *)NewCapsuleBase) &&
+        IsOverlapped (
+          (UINT8 *)NewCapsuleBase,
+          (UINTN)DestPtr - (UINTN)NewCapsuleBase,
+          (UINT8 *)(UINTN)TempBlockDesc->Union.DataBlock,
+          (UINTN)TempBlockDesc->Length
+          ))
+    {
+      //
+      // Relocate the block
+      //
+      RelocPtr = FindFreeMem (BlockList, FreeMemBase, FreeMemSize, (UINTN)TempBlockDesc->Length);
+      if (RelocPtr == NULL) {
+        return EFI_BUFFER_TOO_SMALL;
+      }
+
+      CopyMem ((VOID *)RelocPtr, (VOID *)(UINTN)TempBlockDesc->Union.DataBlock, (UINTN)TempBlockDesc->Length);
+      DEBUG ((
+        DEBUG_INFO,
+        "Capsule reloc data block from 0x%8X to 0x%8X with size 0x%8X\n",
+        (UINTN)TempBlockDesc->Union.DataBlock,
+        (UINTN)RelocPtr,
+        (UINTN)TempBlockDesc->Length
+        ));
+
+      TempBlockDesc->Union.DataBlock = (EFI_PHYSICAL_ADDRESS)(UINTN)RelocPtr;
+    }
+
+    DestPtr += DestLength;
+  }
+
+  DestPtr = (UINT8 *)NewCapsuleBase;
+
   //
   // Move all the blocks to the top (high) of memory.
-  // Relocate all the obstructing blocks. Note that the block descriptors
-  // were coalesced when they were relocated, so we can just ++ the pointer.
   //
   CurrentBlockDesc = BlockList;
   while ((CurrentBlockDesc->Length != 0) || (CurrentBlockDesc->Union.ContinuationPointer != (EFI_PHYSICAL_ADDRESS)(UINTN)NULL)) {
@@ -1214,48 +1262,7 @@ CapsuleDataCoalesce (
     }
 
     //
-    // See if any of the remaining capsule blocks are in the way
-    //
-    TempBlockDesc = CurrentBlockDesc;
-    while (TempBlockDesc->Length != 0) {
-      //
-      // Is this block in the way of where we want to copy the current descriptor to?
-      //
-      if (IsOverlapped (
-            (UINT8 *)DestPtr,
-            (UINTN)DestLength,
-            (UINT8 *)(UINTN)TempBlockDesc->Union.DataBlock,
-            (UINTN)TempBlockDesc->Length
-            ))
-      {
-        //
-        // Relocate the block
-        //
-        RelocPtr = FindFreeMem (BlockList, FreeMemBase, FreeMemSize, (UINTN)TempBlockDesc->Length);
-        if (RelocPtr == NULL) {
-          return EFI_BUFFER_TOO_SMALL;
-        }
-
-        CopyMem ((VOID *)RelocPtr, (VOID *)(UINTN)TempBlockDesc->Union.DataBlock, (UINTN)TempBlockDesc->Length);
-        DEBUG ((
-          DEBUG_INFO,
-          "Capsule reloc data block from 0x%8X to 0x%8X with size 0x%8X\n",
-          (UINTN)TempBlockDesc->Union.DataBlock,
-          (UINTN)RelocPtr,
-          (UINTN)TempBlockDesc->Length
-          ));
-
-        TempBlockDesc->Union.DataBlock = (EFI_PHYSICAL_ADDRESS)(UINTN)RelocPtr;
-      }
-
-      //
-      // Next descriptor
-      //
-      TempBlockDesc++;
-    }
-
-    //
-    // Ok, we made it through. Copy the block.
+    // Copy the block.
     // we just support greping one capsule from the lists of block descs list.
     //
     CapsuleTimes++;
@@ -1294,7 +1301,10 @@ CapsuleDataCoalesce (
       //
       ASSERT (CurrentBlockDesc->Length <= SizeLeft);
 
-      CopyMem ((VOID *)DestPtr, (VOID *)(UINTN)(CurrentBlockDesc->Union.DataBlock), (UINTN)CurrentBlockDesc->Length);
+      if ((UINTN)DestPtr != (UINTN)CurrentBlockDesc->Union.DataBlock) {
+        CopyMem ((VOID *)DestPtr, (VOID *)(UINTN)(CurrentBlockDesc->Union.DataBlock), (UINTN)CurrentBlockDesc->Length);
+      }
+
       DEBUG ((
         DEBUG_INFO,
         "Capsule coalesce block no.0x%lX from 0x%lX to 0x%lX with size 0x%lX\n",
@@ -3688,12 +3688,15 @@ ConSplitterTextInWaitForKey (
 
   //
   // If any physical console input device has key input, signal the event.
+  // The devices after the first one with input are not polled, the event
+  // is signaled already.
   //
   for (Index = 0; Index < Private->CurrentNumberOfConsoles; Index++) {
     Status = gBS->CheckEvent (Private->TextInList[Index]->WaitForKey);
     if (!EFI_ERROR (Status)) {
       gBS->SignalEvent (Event);
       Private->KeyEventSignalState = TRUE;
+      break;
     }
   }
 }
@@ -4343,6 +4346,7 @@ ConSplitterSimplePointerWaitForInput (
     if (!EFI_ERROR (Status)) {
       gBS->SignalEvent (Event);
       Private->InputEventSignalState = TRUE;
+      break;
     }
   }
 }
@@ -4558,6 +4562,7 @@ ConSplitterAbsolutePointerWaitForInput (
     if (!EFI_ERROR (Status)) {
       gBS->SignalEvent (Event);
       Private->AbsoluteInputEventSignalState = TRUE;
+      break;
     }
   }
 }
@@ -36,7 +36,8 @@ GRAPHICS_CONSOLE_DEV  mGraphicsConsoleDevTemplate = {
     FALSE
   },
   (GRAPHICS_CONSOLE_MODE_DATA *)NULL,
-  (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)NULL
+  (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)NULL,
+  (GRAPHICS_CONSOLE_CELL *)NULL
 };
 
 GRAPHICS_CONSOLE_MODE_DATA  mGraphicsConsoleModeData[] = {
@@ -56,6 +57,13 @@ EFI_HII_FONT_PROTOCOL      *mHiiFont;
 EFI_HII_HANDLE             mHiiHandle;
 VOID                       *mHiiRegistration;
 
+//
+// Glyphs are rendered into a scratch image larger than one cell, so that
+// characters that do not fit in a narrow cell can be told apart.
+//
+GRAPHICS_CONSOLE_GLYPH         *mGlyphCache;
+EFI_GRAPHICS_OUTPUT_BLT_PIXEL  mGlyphScratch[2 * EFI_GLYPH_HEIGHT][2 * EFI_GLYPH_WIDTH];
+
 EFI_GUID  mFontPackageListGuid = {
   0xf5f219d3, 0x7006, 0x4648, { 0xac, 0x8d, 0xd6, 0x1d, 0xfb, 0x7b, 0xc6, 0xad }
 };
@@ -660,6 +668,10 @@ Error:
       FreePool (Private->LineBuffer);
     }
 
+    if (Private->TextCells != NULL) {
+      FreePool (Private->TextCells);
+    }
+
     if (Private->ModeData != NULL) {
       FreePool (Private->ModeData);
     }
@@ -748,6 +760,10 @@ GraphicsConsoleControllerDriverStop (
       FreePool (Private->LineBuffer);
     }
 
+    if (Private->TextCells != NULL) {
+      FreePool (Private->TextCells);
+    }
+
     if (Private->ModeData != NULL) {
       FreePool (Private->ModeData);
     }
@@ -1024,37 +1040,7 @@ GraphicsConsoleConOutOutputString (
       //
       if (This->Mode->CursorRow == (INT32)(MaxRow - 1)) {
         if (GraphicsOutput != NULL) {
-          //
-          // Scroll Screen Up One Row
-          //
-          GraphicsOutput->Blt (
-                            GraphicsOutput,
-                            NULL,
-                            EfiBltVideoToVideo,
-                            DeltaX,
-                            DeltaY + EFI_GLYPH_HEIGHT,
-                            DeltaX,
-                            DeltaY,
-                            Width,
-                            Height,
-                            Delta
-                            );
-
-          //
-          // Print Blank Line at last line
-          //
-          GraphicsOutput->Blt (
-                            GraphicsOutput,
-                            &Background,
-                            EfiBltVideoFill,
-                            0,
-                            0,
-                            DeltaX,
-                            DeltaY + Height,
-                            Width,
-                            EFI_GLYPH_HEIGHT,
-                            Delta
-                            );
+          ScrollUpOneRow (This, &Background);
         } else if (FeaturePcdGet (PcdUgaConsumeSupport)) {
           //
           // Scroll Screen Up One Row
@@ -1372,6 +1358,10 @@ GraphicsConsoleConOutSetMode (
     FlushCursor (This);
 
     FreePool (Private->LineBuffer);
+    if (Private->TextCells != NULL) {
+      FreePool (Private->TextCells);
+      Private->TextCells = NULL;
+    }
   }
 
   //
@@ -1474,6 +1464,16 @@ GraphicsConsoleConOutSetMode (
   //
   This->Mode->Mode = (INT32)ModeNumber;
 
+  //
+  // Describe the character cells of the new mode, the display was cleared to
+  // black. Without the description, the glyph cache and the scroll redraw are
+  // not used.
+  //
+  if (GraphicsOutput != NULL) {
+    Private->TextCells = AllocatePool (sizeof (GRAPHICS_CONSOLE_CELL) * ModeData->Columns * ModeData->Rows);
+    ResetTextCells (Private, EFI_TEXT_ATTR (EFI_LIGHTGRAY, EFI_BLACK));
+  }
+
   //
   // Move the text cursor to the upper left hand corner of the display and flush it
   //
@@ -1591,6 +1591,9 @@ GraphicsConsoleConOutClearScreen (
                                ModeData->GopHeight,
                                0
                                );
+    if (!EFI_ERROR (Status)) {
+      ResetTextCells (Private, This->Mode->Attribute);
+    }
   } else if (FeaturePcdGet (PcdUgaConsumeSupport)) {
     Status = UgaDraw->Blt (
                         UgaDraw,
@@ -1784,9 +1787,42 @@ DrawUnicodeWeightAtCursorN (
   EFI_UGA_DRAW_PROTOCOL  *UgaDraw;
   EFI_HII_ROW_INFO       *RowInfoArray;
   UINTN                  RowInfoArraySize;
+  GRAPHICS_CONSOLE_CELL  *Cells;
+  UINTN                  MaxColumn;
+  UINTN                  Index;
 
   Private = GRAPHICS_CONSOLE_CON_OUT_DEV_FROM_THIS (This);
-  Blt     = (EFI_IMAGE_OUTPUT *)AllocateZeroPool (sizeof (EFI_IMAGE_OUTPUT));
+
+  MaxColumn = Private->ModeData[This->Mode->Mode].Columns;
+  Cells     = NULL;
+  if (Private->TextCells != NULL) {
+    Cells = &Private->TextCells[This->Mode->CursorRow * MaxColumn + This->Mode->CursorColumn];
+  }
+
+  if ((Cells != NULL) && ((This->Mode->Attribute & EFI_WIDE_ATTRIBUTE) == 0)) {
+    //
+    // Narrow characters that all have a cached glyph are drawn with one blt.
+    // Otherwise the HII Font protocol draws the string, skipping the characters
+    // without a glyph.
+    //
+    for (Index = 0; Index < Count; Index++) {
+      if (GetCachedGlyph (UnicodeWeight[Index], (UINT8)(This->Mode->Attribute & 0x7F)) == NULL) {
+        break;
+      }
+    }
+
+    if (Index == Count) {
+      for (Index = 0; Index < Count; Index++) {
+        Cells[Index].Char      = UnicodeWeight[Index];
+        Cells[Index].Attribute = (UINT8)(This->Mode->Attribute & 0x7F);
+        Cells[Index].Valid     = TRUE;
+      }
+
+      return DrawCellsAtRow (This, This->Mode->CursorRow, This->Mode->CursorColumn, Cells, Count);
+    }
+  }
+
+  Blt = (EFI_IMAGE_OUTPUT *)AllocateZeroPool (sizeof (EFI_IMAGE_OUTPUT));
   if (Blt == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
@@ -1835,6 +1871,16 @@ DrawUnicodeWeightAtCursorN (
                          NULL,
                          NULL
                          );
+
+    //
+    // What was drawn is not known. Glyphs wider than a cell may have been drawn
+    // up to the end of the row.
+    //
+    if (Cells != NULL) {
+      for (Index = 0; This->Mode->CursorColumn + Index < MaxColumn; Index++) {
+        Cells[Index].Valid = FALSE;
+      }
+    }
   } else if (FeaturePcdGet (PcdUgaConsumeSupport)) {
     //
     // If Graphics Output protocol cannot be found and PcdUgaConsumeSupport enabled,
@@ -1911,6 +1957,320 @@ DrawUnicodeWeightAtCursorN (
   return Status;
 }
 
+/**
+  Get the bitmap of a narrow character from the glyph cache, rendering it
+  with the HII Font protocol on a miss.
+
+  @param  Char                  The character.
+  @param  Attribute             The text attribute the character is drawn with.
+
+  @return The glyph cache entry of the character, or NULL if the character
+          does not render into exactly one narrow glyph cell.
+
+**/
+GRAPHICS_CONSOLE_GLYPH *
+GetCachedGlyph (
+  IN  CHAR16  Char,
+  IN  UINT8   Attribute
+  )
+{
+  EFI_STATUS              Status;
+  GRAPHICS_CONSOLE_GLYPH  *Glyph;
+  EFI_IMAGE_OUTPUT        Image;
+  EFI_IMAGE_OUTPUT        *Blt;
+  EFI_FONT_DISPLAY_INFO   FontInfo;
+  CHAR16                  String[2];
+  EFI_HII_ROW_INFO        *RowInfoArray;
+  UINTN                   RowInfoArraySize;
+  UINTN                   Line;
+
+  if (mGlyphCache == NULL) {
+    mGlyphCache = AllocateZeroPool (sizeof (GRAPHICS_CONSOLE_GLYPH) * GRAPHICS_CONSOLE_GLYPH_CACHE_SIZE);
+    if (mGlyphCache == NULL) {
+      return NULL;
+    }
+  }
+
+  Glyph = &mGlyphCache[(Char ^ ((UINTN)Attribute << 2)) & (GRAPHICS_CONSOLE_GLYPH_CACHE_SIZE - 1)];
+  if (Glyph->Valid && (Glyph->Char == Char) && (Glyph->Attribute == Attribute)) {
+    return Glyph;
+  }
+
+  Glyph->Valid = FALSE;
+
+  ZeroMem (&FontInfo, sizeof (FontInfo));
+  FontInfo.ForegroundColor = mGraphicsEfiColors[Attribute & 0x0f];
+  FontInfo.BackgroundColor = mGraphicsEfiColors[Attribute >> 4];
+
+  Image.Width        = 2 * EFI_GLYPH_WIDTH;
+  Image.Height       = 2 * EFI_GLYPH_HEIGHT;
+  Image.Image.Bitmap = &mGlyphScratch[0][0];
+  Blt                = &Image;
+
+  String[0] = Char;
+  String[1] = CHAR_NULL;
+
+  RowInfoArray     = NULL;
+  RowInfoArraySize = 0;
+  Status           = mHiiFont->StringToImage (
+                                 mHiiFont,
+                                 EFI_HII_IGNORE_IF_NO_GLYPH | EFI_HII_IGNORE_LINE_BREAK,
+                                 String,
+                                 &FontInfo,
+                                 &Blt,
+                                 0,
+                                 0,
+                                 &RowInfoArray,
+                                 &RowInfoArraySize,
+                                 NULL
+                                 );
+  if ((Status == EFI_SUCCESS) && (RowInfoArraySize == 1) &&
+      (RowInfoArray[0].LineWidth == EFI_GLYPH_WIDTH) && (RowInfoArray[0].LineHeight == EFI_GLYPH_HEIGHT))
+  {
+    for (Line = 0; Line < EFI_GLYPH_HEIGHT; Line++) {
+      CopyMem (Glyph->Bitmap[Line], mGlyphScratch[Line], sizeof (Glyph->Bitmap[Line]));
+    }
+
+    Glyph->Char      = Char;
+    Glyph->Attribute = Attribute;
+    Glyph->Valid     = TRUE;
+  }
+
+  if (RowInfoArray != NULL) {
+    FreePool (RowInfoArray);
+  }
+
+  return Glyph->Valid ? Glyph : NULL;
+}
+
+/**
+  Draw a run of character cells of the current row from their descriptions,
+  with a single blt.
+
+  Cells whose glyph cannot be taken from the glyph cache are filled with
+  their background color and are no longer Valid.
+
+  @param  This                  Protocol instance pointer.
+  @param  Row                   The row of the cells.
+  @param  Column                The column of the first cell.
+  @param  Cells                 The descriptions of the cells to draw.
+  @param  Count                 The number of cells to draw.
+
+  @retval EFI_SUCCESS           The cells were drawn.
+  @retval other                 The error returned by the Graphics Output
+                                protocol.
+
+**/
+EFI_STATUS
+DrawCellsAtRow (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL  *This,
+  IN  UINTN                            Row,
+  IN  UINTN                            Column,
+  IN  GRAPHICS_CONSOLE_CELL            *Cells,
+  IN  UINTN                            Count
+  )
+{
+  GRAPHICS_CONSOLE_DEV           *Private;
+  GRAPHICS_CONSOLE_MODE_DATA     *ModeData;
+  GRAPHICS_CONSOLE_GLYPH         *Glyph;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  *Pixel;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL  Background;
+  UINTN                          Width;
+  UINTN                          Index;
+  UINTN                          Line;
+  UINTN                          X;
+
+  Private  = GRAPHICS_CONSOLE_CON_OUT_DEV_FROM_THIS (This);
+  ModeData = &Private->ModeData[This->Mode->Mode];
+  Width    = Count * EFI_GLYPH_WIDTH;
+
+  for (Index = 0; Index < Count; Index++) {
+    Glyph = NULL;
+    if (Cells[Index].Valid && (Cells[Index].Char != CHAR_NULL)) {
+      Glyph = GetCachedGlyph (Cells[Index].Char, Cells[Index].Attribute);
+      if (Glyph == NULL) {
+        Cells[Index].Valid = FALSE;
+      }
+    }
+
+    Background = mGraphicsEfiColors[Cells[Index].Attribute >> 4];
+    Pixel      = &Private->LineBuffer[Index * EFI_GLYPH_WIDTH];
+    for (Line = 0; Line < EFI_GLYPH_HEIGHT; Line++, Pixel += Width) {
+      if (Glyph != NULL) {
+        CopyMem (Pixel, Glyph->Bitmap[Line], sizeof (Glyph->Bitmap[Line]));
+      } else {
+        for (X = 0; X < EFI_GLYPH_WIDTH; X++) {
+          Pixel[X] = Background;
+        }
+      }
+    }
+  }
+
+  return Private->GraphicsOutput->Blt (
+                                    Private->GraphicsOutput,
+                                    Private->LineBuffer,
+                                    EfiBltBufferToVideo,
+                                    0,
+                                    0,
+                                    Column * EFI_GLYPH_WIDTH + ModeData->DeltaX,
+                                    Row * EFI_GLYPH_HEIGHT + ModeData->DeltaY,
+                                    Width,
+                                    EFI_GLYPH_HEIGHT,
+                                    Width * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                                    );
+}
+
+/**
+  Scroll the text window of a Graphics Output protocol device up one row and
+  blank its last row.
+
+  If PcdGraphicsConsoleRedrawScroll is TRUE and what the console drew on the
+  whole window is known, only the cells that change are redrawn. Otherwise the
+  window is moved with a video to video blt.
+
+  @param  This                  Protocol instance pointer.
+  @param  Background            The color of the new last row.
+
+**/
+VOID
+ScrollUpOneRow (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL  *This,
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL    *Background
+  )
+{
+  GRAPHICS_CONSOLE_DEV          *Private;
+  GRAPHICS_CONSOLE_MODE_DATA    *ModeData;
+  EFI_GRAPHICS_OUTPUT_PROTOCOL  *GraphicsOutput;
+  GRAPHICS_CONSOLE_CELL         *Cells;
+  GRAPHICS_CONSOLE_CELL         *OldRow;
+  GRAPHICS_CONSOLE_CELL         *NewRow;
+  UINTN                         MaxColumn;
+  UINTN                         MaxRow;
+  UINTN                         Row;
+  UINTN                         First;
+  UINTN                         Last;
+  UINTN                         Index;
+  BOOLEAN                       Redraw;
+
+  Private        = GRAPHICS_CONSOLE_CON_OUT_DEV_FROM_THIS (This);
+  ModeData       = &Private->ModeData[This->Mode->Mode];
+  GraphicsOutput = Private->GraphicsOutput;
+  Cells          = Private->TextCells;
+  MaxColumn      = ModeData->Columns;
+  MaxRow         = ModeData->Rows;
+
+  //
+  // The rows that move up must be known to be redrawn.
+  //
+  Redraw = FALSE;
+  if (FeaturePcdGet (PcdGraphicsConsoleRedrawScroll) && (Cells != NULL)) {
+    for (Index = MaxColumn; Index < MaxColumn * MaxRow; Index++) {
+      if (!Cells[Index].Valid) {
+        break;
+      }
+    }
+
+    Redraw = (BOOLEAN)(Index == MaxColumn * MaxRow);
+  }
+
+  if (Redraw) {
+    //
+    // Redraw the span of each row that differs from the row below it
+    //
+    for (Row = 0; Row + 1 < MaxRow; Row++) {
+      OldRow = &Cells[Row * MaxColumn];
+      NewRow = OldRow + MaxColumn;
+      for (First = 0; First < MaxColumn; First++) {
+        if (CompareMem (&OldRow[First], &NewRow[First], sizeof (GRAPHICS_CONSOLE_CELL)) != 0) {
+          break;
+        }
+      }
+
+      if (First == MaxColumn) {
+        continue;
+      }
+
+      for (Last = MaxColumn; Last > First + 1; Last--) {
+        if (CompareMem (&OldRow[Last - 1], &NewRow[Last - 1], sizeof (GRAPHICS_CONSOLE_CELL)) != 0) {
+          break;
+        }
+      }
+
+      DrawCellsAtRow (This, Row, First, &NewRow[First], Last - First);
+    }
+  } else {
+    //
+    // Scroll Screen Up One Row
+    //
+    GraphicsOutput->Blt (
+                      GraphicsOutput,
+                      NULL,
+                      EfiBltVideoToVideo,
+                      ModeData->DeltaX,
+                      ModeData->DeltaY + EFI_GLYPH_HEIGHT,
+                      ModeData->DeltaX,
+                      ModeData->DeltaY,
+                      MaxColumn * EFI_GLYPH_WIDTH,
+                      (MaxRow - 1) * EFI_GLYPH_HEIGHT,
+                      MaxColumn * EFI_GLYPH_WIDTH * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                      );
+  }
+
+  //
+  // Print Blank Line at last line
+  //
+  GraphicsOutput->Blt (
+                    GraphicsOutput,
+                    Background,
+                    EfiBltVideoFill,
+                    0,
+                    0,
+                    ModeData->DeltaX,
+                    ModeData->DeltaY + (MaxRow - 1) * EFI_GLYPH_HEIGHT,
+                    MaxColumn * EFI_GLYPH_WIDTH,
+                    EFI_GLYPH_HEIGHT,
+                    MaxColumn * EFI_GLYPH_WIDTH * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                    );
+
+  if (Cells != NULL) {
+    CopyMem (Cells, &Cells[MaxColumn], (MaxRow - 1) * MaxColumn * sizeof (GRAPHICS_CONSOLE_CELL));
+    for (Index = (MaxRow - 1) * MaxColumn; Index < MaxRow * MaxColumn; Index++) {
+      Cells[Index].Char      = CHAR_NULL;
+      Cells[Index].Attribute = (UINT8)(This->Mode->Attribute & 0x70);
+      Cells[Index].Valid     = TRUE;
+    }
+  }
+}
+
+/**
+  Set all the character cells of the current mode to the background color of
+  Attribute.
+
+  @param  Private               Graphics Console device instance.
+  @param  Attribute             The text attribute of the background.
+
+**/
+VOID
+ResetTextCells (
+  IN  GRAPHICS_CONSOLE_DEV  *Private,
+  IN  UINTN                 Attribute
+  )
+{
+  GRAPHICS_CONSOLE_MODE_DATA  *ModeData;
+  UINTN                       Index;
+
+  if (Private->TextCells == NULL) {
+    return;
+  }
+
+  ModeData = &Private->ModeData[Private->SimpleTextOutputMode.Mode];
+  for (Index = 0; Index < ModeData->Columns * ModeData->Rows; Index++) {
+    Private->TextCells[Index].Char      = CHAR_NULL;
+    Private->TextCells[Index].Attribute = (UINT8)(Attribute & 0x70);
+    Private->TextCells[Index].Valid     = TRUE;
+  }
+}
+
 /**
   Flush the cursor on the screen.
 
@@ -2106,6 +2466,13 @@ RegisterFontPackage (
                  );
   ASSERT (mHiiHandle != NULL);
   FreePool (Package);
+
+  //
+  // The glyphs may come from the new font from now on
+  //
+  if (mGlyphCache != NULL) {
+    ZeroMem (mGlyphCache, sizeof (GRAPHICS_CONSOLE_GLYPH) * GRAPHICS_CONSOLE_GLYPH_CACHE_SIZE);
+  }
 }
 
 /**
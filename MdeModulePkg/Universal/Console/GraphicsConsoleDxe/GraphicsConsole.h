@@ -56,6 +56,31 @@ typedef struct {
   UINT32    GopModeNumber;
 } GRAPHICS_CONSOLE_MODE_DATA;
 
+//
+// What the console drew in one character cell. A cell with Char set to
+// CHAR_NULL is filled with the background color of Attribute. Cells that
+// were not drawn from the glyph cache are not Valid, as their pixels are
+// unknown.
+//
+typedef struct {
+  CHAR16     Char;
+  UINT8      Attribute;
+  BOOLEAN    Valid;
+} GRAPHICS_CONSOLE_CELL;
+
+//
+// Glyph cache entry, the rendered bitmap of a narrow character drawn with
+// one text attribute.
+//
+#define GRAPHICS_CONSOLE_GLYPH_CACHE_SIZE  256
+
+typedef struct {
+  CHAR16                           Char;
+  UINT8                            Attribute;
+  BOOLEAN                          Valid;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL    Bitmap[EFI_GLYPH_HEIGHT][EFI_GLYPH_WIDTH];
+} GRAPHICS_CONSOLE_GLYPH;
+
 typedef struct {
   UINTN                              Signature;
   EFI_GRAPHICS_OUTPUT_PROTOCOL       *GraphicsOutput;
@@ -64,6 +89,7 @@ typedef struct {
   EFI_SIMPLE_TEXT_OUTPUT_MODE        SimpleTextOutputMode;
   GRAPHICS_CONSOLE_MODE_DATA         *ModeData;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL      *LineBuffer;
+  GRAPHICS_CONSOLE_CELL              *TextCells;
 } GRAPHICS_CONSOLE_DEV;
 
 #define GRAPHICS_CONSOLE_CON_OUT_DEV_FROM_THIS(a) \
@@ -538,6 +564,82 @@ DrawUnicodeWeightAtCursorN (
   IN  UINTN                            Count
   );
 
+/**
+  Get the bitmap of a narrow character from the glyph cache, rendering it
+  with the HII Font protocol on a miss.
+
+  @param  Char                  The character.
+  @param  Attribute             The text attribute the character is drawn with.
+
+  @return The glyph cache entry of the character, or NULL if the character
+          does not render into exactly one narrow glyph cell.
+
+**/
+GRAPHICS_CONSOLE_GLYPH *
+GetCachedGlyph (
+  IN  CHAR16  Char,
+  IN  UINT8   Attribute
+  );
+
+/**
+  Draw a run of character cells of the current row from their descriptions,
+  with a single blt.
+
+  Cells whose glyph cannot be taken from the glyph cache are filled with
+  their background color and are no longer Valid.
+
+  @param  This                  Protocol instance pointer.
+  @param  Row                   The row of the cells.
+  @param  Column                The column of the first cell.
+  @param  Cells                 The descriptions of the cells to draw.
+  @param  Count                 The number of cells to draw.
+
+  @retval EFI_SUCCESS           The cells were drawn.
+  @retval other                 The error returned by the Graphics Output
+                                protocol.
+
+**/
+EFI_STATUS
+DrawCellsAtRow (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL  *This,
+  IN  UINTN                            Row,
+  IN  UINTN                            Column,
+  IN  GRAPHICS_CONSOLE_CELL            *Cells,
+  IN  UINTN                            Count
+  );
+
+/**
+  Scroll the text window of a Graphics Output protocol device up one row and
+  blank its last row.
+
+  If PcdGraphicsConsoleRedrawScroll is TRUE and what the console drew on the
+  whole window is known, only the cells that change are redrawn. Otherwise the
+  window is moved with a video to video blt.
+
+  @param  This                  Protocol instance pointer.
+  @param  Background            The color of the new last row.
+
+**/
+VOID
+ScrollUpOneRow (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL  *This,
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL    *Background
+  );
+
+/**
+  Set all the character cells of the current mode to the background color of
+  Attribute.
+
+  @param  Private               Graphics Console device instance.
+  @param  Attribute             The text attribute of the background.
+
+**/
+VOID
+ResetTextCells (
+  IN  GRAPHICS_CONSOLE_DEV  *Private,
+  IN  UINTN                 Attribute
+  );
+
 /**
   Flush the cursor on the screen.
 
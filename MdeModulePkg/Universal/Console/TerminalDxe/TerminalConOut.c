@@ -80,10 +80,50 @@ CHAR16  mSetCursorPositionString[] = { ESC, '[', '0', '0', ';', '0', '0', 'H', 0
 CHAR16  mCursorForwardString[]     = { ESC, '[', '0', '0', 'C', 0 };
 CHAR16  mCursorBackwardString[]    = { ESC, '[', '0', '0', 'D', 0 };
 
+//
+// The bytes of one OutputString() call are collected in a buffer of this
+// size and handed to the serial device in as few writes as possible.
+//
+#define TERMINAL_OUTPUT_BUFFER_SIZE  128
+
 //
 // Body of the ConOut functions
 //
 
+/**
+  Write the bytes collected by TerminalConOutOutputString() to the serial device.
+
+  @param  TerminalDevice  The terminal device.
+  @param  Buffer          The collected bytes.
+  @param  Length          On input, the number of collected bytes. Set to 0 on return.
+
+  @retval EFI_SUCCESS     The bytes were written, or there were none.
+  @retval Others          The serial device failed to write the bytes.
+
+**/
+STATIC
+EFI_STATUS
+TerminalFlushOutput (
+  IN     TERMINAL_DEV  *TerminalDevice,
+  IN     CHAR8         *Buffer,
+  IN OUT UINTN         *Length
+  )
+{
+  EFI_STATUS  Status;
+
+  if (*Length == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Status = TerminalDevice->SerialIo->Write (
+                                       TerminalDevice->SerialIo,
+                                       Length,
+                                       Buffer
+                                       );
+  *Length = 0;
+  return Status;
+}
+
 /**
   Implements EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL.Reset().
 
@@ -175,22 +215,23 @@ TerminalConOutOutputString (
   EFI_SIMPLE_TEXT_OUTPUT_MODE  *Mode;
   UINTN                        MaxColumn;
   UINTN                        MaxRow;
-  UINTN                        Length;
   UTF8_CHAR                    Utf8Char;
   CHAR8                        GraphicChar;
   CHAR8                        AsciiChar;
   EFI_STATUS                   Status;
   UINT8                        ValidBytes;
-  CHAR8                        CrLfStr[2];
+  CHAR8                        OutputBuffer[TERMINAL_OUTPUT_BUFFER_SIZE];
+  UINTN                        OutputLength;
   //
   //  flag used to indicate whether condition happens which will cause
   //  return EFI_WARN_UNKNOWN_GLYPH
   //
   BOOLEAN  Warning;
 
-  ValidBytes = 0;
-  Warning    = FALSE;
-  AsciiChar  = 0;
+  ValidBytes   = 0;
+  Warning      = FALSE;
+  AsciiChar    = 0;
+  OutputLength = 0;
 
   //
   //  get Terminal device data structure pointer.
@@ -214,6 +255,17 @@ TerminalConOutOutputString (
           );
 
   for ( ; *WString != CHAR_NULL; WString++) {
+    //
+    // Leave room for the longest sequence one character may produce: a UTF-8
+    // character, or a character followed by CR LF.
+    //
+    if (OutputLength > sizeof (OutputBuffer) - sizeof (UTF8_CHAR) - 2) {
+      Status = TerminalFlushOutput (TerminalDevice, OutputBuffer, &OutputLength);
+      if (EFI_ERROR (Status)) {
+        goto OutputError;
+      }
+    }
+
     switch (TerminalDevice->TerminalType) {
       case TerminalTypePcAnsi:
       case TerminalTypeVt100:
@@ -251,32 +303,13 @@ TerminalConOutOutputString (
           GraphicChar = AsciiChar;
         }
 
-        Length = 1;
-
-        Status = TerminalDevice->SerialIo->Write (
-                                             TerminalDevice->SerialIo,
-                                             &Length,
-                                             &GraphicChar
-                                             );
-
-        if (EFI_ERROR (Status)) {
-          goto OutputError;
-        }
-
+        OutputBuffer[OutputLength++] = GraphicChar;
         break;
 
       case TerminalTypeVtUtf8:
         UnicodeToUtf8 (*WString, &Utf8Char, &ValidBytes);
-        Length = ValidBytes;
-        Status = TerminalDevice->SerialIo->Write (
-                                             TerminalDevice->SerialIo,
-                                             &Length,
-                                             (UINT8 *)&Utf8Char
-                                             );
-        if (EFI_ERROR (Status)) {
-          goto OutputError;
-        }
-
+        CopyMem (&OutputBuffer[OutputLength], &Utf8Char, ValidBytes);
+        OutputLength += ValidBytes;
         break;
     }
 
@@ -322,20 +355,8 @@ TerminalConOutOutputString (
             // the driver, but only if we're not in the middle of
             // printing an escape sequence.
             //
-            CrLfStr[0] = '\r';
-            CrLfStr[1] = '\n';
-
-            Length = sizeof (CrLfStr);
-
-            Status = TerminalDevice->SerialIo->Write (
-                                                 TerminalDevice->SerialIo,
-                                                 &Length,
-                                                 CrLfStr
-                                                 );
-
-            if (EFI_ERROR (Status)) {
-              goto OutputError;
-            }
+            OutputBuffer[OutputLength++] = '\r';
+            OutputBuffer[OutputLength++] = '\n';
           }
         }
 
@@ -343,6 +364,11 @@ TerminalConOutOutputString (
     }
   }
 
+  Status = TerminalFlushOutput (TerminalDevice, OutputBuffer, &OutputLength);
+  if (EFI_ERROR (Status)) {
+    goto OutputError;
+  }
+
   if (Warning) {
     return EFI_WARN_UNKNOWN_GLYPH;
   }
@@ -48,6 +48,263 @@ DISK_IO_PRIVATE_DATA  gDiskIoPrivateDataTemplate = {
   }
 };
 
+/**
+  Free the block cache of the Disk IO instance.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoFreeBlockCache (
+  IN DISK_IO_PRIVATE_DATA  *Instance
+  )
+{
+  if (Instance->CacheEntries != NULL) {
+    FreePool (Instance->CacheEntries);
+    Instance->CacheEntries = NULL;
+  }
+
+  if (Instance->CacheBuffer != NULL) {
+    FreePool (Instance->CacheBuffer);
+    Instance->CacheBuffer = NULL;
+  }
+
+  Instance->CacheBlockCount = 0;
+  InitializeListHead (&Instance->CacheLruList);
+}
+
+/**
+  Allocate the block cache of the Disk IO instance, sized by PcdDiskIoBlockCacheSize.
+  The block cache is optional; it stays disabled if it cannot be allocated.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIoInitializeBlockCache (
+  IN DISK_IO_PRIVATE_DATA  *Instance
+  )
+{
+  UINTN                Index;
+  UINTN                BlockCount;
+  UINT32               BlockSize;
+  DISK_IO_CACHE_ENTRY  *Entry;
+
+  InitializeListHead (&Instance->CacheLruList);
+  for (Index = 0; Index < DISK_IO_CACHE_HASH_SIZE; Index++) {
+    InitializeListHead (&Instance->CacheHash[Index]);
+  }
+
+  Instance->CacheBlockCount = 0;
+  BlockCount                = PcdGet32 (PcdDiskIoBlockCacheSize);
+  BlockSize                 = Instance->BlockIo->Media->BlockSize;
+  if ((BlockCount == 0) || (BlockSize == 0)) {
+    return;
+  }
+
+  Instance->CacheEntries = AllocateZeroPool (BlockCount * sizeof (DISK_IO_CACHE_ENTRY));
+  Instance->CacheBuffer  = AllocatePool (BlockCount * BlockSize);
+  if ((Instance->CacheEntries == NULL) || (Instance->CacheBuffer == NULL)) {
+    DEBUG ((DEBUG_WARN, "DiskIo: No enough memory for the block cache, disable it\n"));
+    DiskIoFreeBlockCache (Instance);
+    return;
+  }
+
+  for (Index = 0; Index < BlockCount; Index++) {
+    Entry            = &Instance->CacheEntries[Index];
+    Entry->Signature = DISK_IO_CACHE_ENTRY_SIGNATURE;
+    Entry->Data      = Instance->CacheBuffer + Index * BlockSize;
+    InsertTailList (&Instance->CacheLruList, &Entry->LruLink);
+  }
+
+  Instance->CacheMediaId    = Instance->BlockIo->Media->MediaId;
+  Instance->CacheBlockCount = BlockCount;
+}
+
+/**
+  Invalidate the cached blocks in the range [Lba, Lba + BlockCount).
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+  @param Lba          The first block to invalidate.
+  @param BlockCount   The number of blocks to invalidate. MAX_UINT64 invalidates the whole cache.
+**/
+VOID
+DiskIoInvalidateBlockCache (
+  IN DISK_IO_PRIVATE_DATA  *Instance,
+  IN UINT64                Lba,
+  IN UINT64                BlockCount
+  )
+{
+  UINTN                Index;
+  DISK_IO_CACHE_ENTRY  *Entry;
+
+  for (Index = 0; Index < Instance->CacheBlockCount; Index++) {
+    Entry = &Instance->CacheEntries[Index];
+    if (Entry->Valid && (Entry->Lba >= Lba) && (Entry->Lba - Lba < BlockCount)) {
+      RemoveEntryList (&Entry->HashLink);
+      Entry->Valid = FALSE;
+      //
+      // Invalid entries are reused first
+      //
+      RemoveEntryList (&Entry->LruLink);
+      InsertTailList (&Instance->CacheLruList, &Entry->LruLink);
+    }
+  }
+}
+
+/**
+  Find a block in the block cache and make it the most recently used one.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+  @param Lba          The block to find.
+
+  @return The cache entry holding the block, or NULL if the block is not cached.
+**/
+DISK_IO_CACHE_ENTRY *
+DiskIoLookupBlockCache (
+  IN DISK_IO_PRIVATE_DATA  *Instance,
+  IN UINT64                Lba
+  )
+{
+  LIST_ENTRY           *Bucket;
+  LIST_ENTRY           *Link;
+  DISK_IO_CACHE_ENTRY  *Entry;
+
+  Bucket = &Instance->CacheHash[(UINTN)(Lba & (DISK_IO_CACHE_HASH_SIZE - 1))];
+  for (Link = GetFirstNode (Bucket); !IsNull (Bucket, Link); Link = GetNextNode (Bucket, Link)) {
+    Entry = DISK_IO_CACHE_ENTRY_FROM_HASH_LINK (Link);
+    if (Entry->Lba == Lba) {
+      RemoveEntryList (&Entry->LruLink);
+      InsertHeadList (&Instance->CacheLruList, &Entry->LruLink);
+      return Entry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Copy a block into the block cache, replacing the least recently used block.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+  @param Lba          The block number.
+  @param Data         The block data.
+**/
+VOID
+DiskIoInsertBlockCache (
+  IN DISK_IO_PRIVATE_DATA  *Instance,
+  IN UINT64                Lba,
+  IN UINT8                 *Data
+  )
+{
+  DISK_IO_CACHE_ENTRY  *Entry;
+
+  Entry = DISK_IO_CACHE_ENTRY_FROM_LRU_LINK (GetPreviousNode (&Instance->CacheLruList, &Instance->CacheLruList));
+  if (Entry->Valid) {
+    RemoveEntryList (&Entry->HashLink);
+  }
+
+  Entry->Lba   = Lba;
+  Entry->Valid = TRUE;
+  CopyMem (Entry->Data, Data, Instance->BlockIo->Media->BlockSize);
+  InsertHeadList (&Instance->CacheHash[(UINTN)(Lba & (DISK_IO_CACHE_HASH_SIZE - 1))], &Entry->HashLink);
+  RemoveEntryList (&Entry->LruLink);
+  InsertHeadList (&Instance->CacheLruList, &Entry->LruLink);
+}
+
+/**
+  Read a small range of bytes through the block cache. Runs of adjacent
+  blocks missing from the cache are read with one BlockIo request.
+
+  @param Instance    Pointer to the DISK_IO_PRIVATE_DATA.
+  @param MediaId     ID of the medium to read.
+  @param Offset      The starting byte offset on the logical block I/O device to read from.
+  @param BufferSize  The size in bytes of Buffer. The number of bytes to read from the device.
+  @param Buffer      A pointer to the destination buffer for the data.
+
+  @retval EFI_SUCCESS    The data was read correctly from the device.
+  @retval EFI_NOT_FOUND  The request cannot be served from the block cache.
+  @retval others         The status returned by BlockIo ReadBlocks.
+**/
+EFI_STATUS
+DiskIoCachedRead (
+  IN DISK_IO_PRIVATE_DATA  *Instance,
+  IN UINT32                MediaId,
+  IN UINT64                Offset,
+  IN UINTN                 BufferSize,
+  OUT UINT8                *Buffer
+  )
+{
+  EFI_STATUS             Status;
+  EFI_BLOCK_IO_PROTOCOL  *BlockIo;
+  DISK_IO_CACHE_ENTRY    *Entry;
+  UINT32                 BlockSize;
+  UINT32                 UnderRun;
+  UINT64                 Lba;
+  UINT64                 LastLba;
+  UINTN                  Count;
+  UINTN                  MaxCount;
+  UINTN                  Index;
+  UINTN                  Length;
+  UINT8                  *Data;
+
+  BlockIo   = Instance->BlockIo;
+  BlockSize = BlockIo->Media->BlockSize;
+  Lba       = DivU64x32Remainder (Offset, BlockSize, &UnderRun);
+  LastLba   = DivU64x32 (Offset + BufferSize - 1, BlockSize);
+
+  if ((LastLba - Lba >= MIN (DISK_IO_CACHE_MAX_REQUEST_BLOCKS, Instance->CacheBlockCount)) ||
+      !BlockIo->Media->MediaPresent || (MediaId != BlockIo->Media->MediaId))
+  {
+    //
+    // Leave large requests and error handling to the regular path
+    //
+    return EFI_NOT_FOUND;
+  }
+
+  if (Instance->CacheMediaId != BlockIo->Media->MediaId) {
+    DiskIoInvalidateBlockCache (Instance, 0, MAX_UINT64);
+    Instance->CacheMediaId = BlockIo->Media->MediaId;
+  }
+
+  MaxCount = PcdGet32 (PcdDiskIoDataBufferBlockNum);
+  while (Lba <= LastLba) {
+    Entry = DiskIoLookupBlockCache (Instance, Lba);
+    if (Entry != NULL) {
+      Data  = Entry->Data;
+      Count = 1;
+    } else {
+      //
+      // Read all the adjacent missing blocks at once
+      //
+      for (Count = 1; (Lba + Count <= LastLba) && (Count < MaxCount); Count++) {
+        if (DiskIoLookupBlockCache (Instance, Lba + Count) != NULL) {
+          break;
+        }
+      }
+
+      Data   = Instance->SharedWorkingBuffer;
+      Status = BlockIo->ReadBlocks (BlockIo, MediaId, Lba, Count * BlockSize, Data);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      for (Index = 0; Index < Count; Index++) {
+        DiskIoInsertBlockCache (Instance, Lba + Index, Data + Index * BlockSize);
+      }
+    }
+
+    for (Index = 0; Index < Count; Index++, Lba++) {
+      Length = MIN (BlockSize - UnderRun, BufferSize);
+      CopyMem (Buffer, Data + Index * BlockSize + UnderRun, Length);
+      Buffer     += Length;
+      BufferSize -= Length;
+      UnderRun    = 0;
+    }
+  }
+
+  ASSERT (BufferSize == 0);
+  return EFI_SUCCESS;
+}
+
 /**
   Test to see if this driver supports ControllerHandle.
 
@@ -186,6 +443,25 @@ DiskIoDriverBindingStart (
     goto ErrorExit;
   }
 
+  DiskIoInitializeBlockCache (Instance);
+
+  InitializeListHead (&Instance->PendingSubtasks);
+  if (Instance->BlockIo2 != NULL) {
+    Instance->MaxOutstandingSubtasks = PcdGet32 (PcdDiskIo2MaxOutstandingRequests);
+    if (Instance->MaxOutstandingSubtasks != 0) {
+      Status = gBS->CreateEvent (
+                      EVT_NOTIFY_SIGNAL,
+                      TPL_CALLBACK,
+                      DiskIo2OnDispatchPendingSubtasks,
+                      Instance,
+                      &Instance->DispatchEvent
+                      );
+      if (EFI_ERROR (Status)) {
+        goto ErrorExit;
+      }
+    }
+  }
+
   //
   // Install protocol interfaces for the Disk IO device.
   //
@@ -217,6 +493,11 @@ ErrorExit:
     }
 
     if (Instance != NULL) {
+      if (Instance->DispatchEvent != NULL) {
+        gBS->CloseEvent (Instance->DispatchEvent);
+      }
+
+      DiskIoFreeBlockCache (Instance);
       FreePool (Instance);
     }
 
@@ -293,9 +574,11 @@ DiskIoDriverBindingStop (
 
   if (DiskIo2 != NULL) {
     //
-    // Call BlockIo2::Reset() to terminate any in-flight non-blocking I/O requests
+    // Drop the non-blocking I/O requests that are not submitted yet, then
+    // call BlockIo2::Reset() to terminate any in-flight non-blocking I/O requests
     //
     ASSERT (Instance->BlockIo2 != NULL);
+    DiskIo2AbortPendingSubtasks (Instance);
     Status = Instance->BlockIo2->Reset (Instance->BlockIo2, FALSE);
     if (EFI_ERROR (Status)) {
       return Status;
@@ -329,6 +612,10 @@ DiskIoDriverBindingStop (
       Instance->SharedWorkingBuffer,
       EFI_SIZE_TO_PAGES (PcdGet32 (PcdDiskIoDataBufferBlockNum) * Instance->BlockIo->Media->BlockSize)
       );
+    DiskIoFreeBlockCache (Instance);
+    if (Instance->DispatchEvent != NULL) {
+      gBS->CloseEvent (Instance->DispatchEvent);
+    }
 
     Status = gBS->CloseProtocol (
                     ControllerHandle,
@@ -398,6 +685,187 @@ DiskIoDestroySubtask (
   return Link;
 }
 
+/**
+  Issue a non-blocking subtask to BlockIo2.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+  @param Subtask      The non-blocking subtask.
+
+  @return The status returned by ReadBlocksEx() or WriteBlocksEx().
+**/
+EFI_STATUS
+DiskIo2IssueSubtask (
+  IN DISK_IO_PRIVATE_DATA  *Instance,
+  IN DISK_IO_SUBTASK       *Subtask
+  )
+{
+  EFI_BLOCK_IO2_PROTOCOL  *BlockIo2;
+  UINT32                  BlockSize;
+
+  BlockIo2  = Instance->BlockIo2;
+  BlockSize = Instance->BlockIo->Media->BlockSize;
+
+  if (Subtask->Write) {
+    return BlockIo2->WriteBlocksEx (
+                       BlockIo2,
+                       Subtask->MediaId,
+                       Subtask->Lba,
+                       &Subtask->BlockIo2Token,
+                       (Subtask->Length % BlockSize == 0) ? Subtask->Length : BlockSize,
+                       (Subtask->WorkingBuffer != NULL) ? Subtask->WorkingBuffer : Subtask->Buffer
+                       );
+  }
+
+  return BlockIo2->ReadBlocksEx (
+                     BlockIo2,
+                     Subtask->MediaId,
+                     Subtask->Lba,
+                     &Subtask->BlockIo2Token,
+                     (Subtask->Length % BlockSize == 0) ? Subtask->Length : BlockSize,
+                     (Subtask->WorkingBuffer != NULL) ? Subtask->WorkingBuffer : Subtask->Buffer
+                     );
+}
+
+/**
+  Submit a non-blocking subtask to BlockIo2, or queue it when the number of
+  outstanding subtasks of the instance reaches PcdDiskIo2MaxOutstandingRequests.
+  Queued subtasks are submitted in order as the outstanding ones complete.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+  @param MediaId      ID of the medium to access.
+  @param Subtask      The non-blocking subtask.
+
+  @retval EFI_SUCCESS The subtask was submitted or queued.
+  @return Others      The status returned by ReadBlocksEx() or WriteBlocksEx().
+**/
+EFI_STATUS
+DiskIo2SubmitSubtask (
+  IN DISK_IO_PRIVATE_DATA  *Instance,
+  IN UINT32                MediaId,
+  IN DISK_IO_SUBTASK       *Subtask
+  )
+{
+  EFI_STATUS  Status;
+  EFI_TPL     OldTpl;
+
+  Subtask->MediaId = MediaId;
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  if ((Instance->MaxOutstandingSubtasks != 0) &&
+      ((Instance->OutstandingSubtasks >= Instance->MaxOutstandingSubtasks) || !IsListEmpty (&Instance->PendingSubtasks)))
+  {
+    InsertTailList (&Instance->PendingSubtasks, &Subtask->PendingLink);
+    gBS->RestoreTPL (OldTpl);
+    return EFI_SUCCESS;
+  }
+
+  Instance->OutstandingSubtasks++;
+  gBS->RestoreTPL (OldTpl);
+
+  Status = DiskIo2IssueSubtask (Instance, Subtask);
+  if (EFI_ERROR (Status)) {
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    Instance->OutstandingSubtasks--;
+    gBS->RestoreTPL (OldTpl);
+  }
+
+  return Status;
+}
+
+/**
+  Submit the queued subtasks while the number of outstanding subtasks is below
+  PcdDiskIo2MaxOutstandingRequests. Subtasks of cancelled or failed tasks are
+  dropped instead. Must be called at or below TPL_CALLBACK.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIo2DispatchPendingSubtasks (
+  IN DISK_IO_PRIVATE_DATA  *Instance
+  )
+{
+  EFI_STATUS       Status;
+  EFI_TPL          OldTpl;
+  DISK_IO_SUBTASK  *Subtask;
+
+  while (TRUE) {
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    if (IsListEmpty (&Instance->PendingSubtasks) ||
+        (Instance->OutstandingSubtasks >= Instance->MaxOutstandingSubtasks))
+    {
+      gBS->RestoreTPL (OldTpl);
+      break;
+    }
+
+    Subtask = CR (GetFirstNode (&Instance->PendingSubtasks), DISK_IO_SUBTASK, PendingLink, DISK_IO_SUBTASK_SIGNATURE);
+    RemoveEntryList (&Subtask->PendingLink);
+    if (Subtask->Task->Token == NULL) {
+      DiskIoDestroySubtask (Instance, Subtask);
+      gBS->RestoreTPL (OldTpl);
+      continue;
+    }
+
+    Instance->OutstandingSubtasks++;
+    gBS->RestoreTPL (OldTpl);
+
+    Status = DiskIo2IssueSubtask (Instance, Subtask);
+    if (EFI_ERROR (Status)) {
+      //
+      // Complete the subtask with the error, as if BlockIo2 did it.
+      //
+      Subtask->BlockIo2Token.TransactionStatus = Status;
+      gBS->SignalEvent (Subtask->BlockIo2Token.Event);
+    }
+  }
+}
+
+/**
+  The callback to submit the queued subtasks once outstanding subtasks complete.
+
+  @param  Event                 Event whose notification function is being invoked.
+  @param  Context               The pointer to the notification function's context,
+                                which points to the DISK_IO_PRIVATE_DATA instance.
+**/
+VOID
+EFIAPI
+DiskIo2OnDispatchPendingSubtasks (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  DiskIo2DispatchPendingSubtasks ((DISK_IO_PRIVATE_DATA *)Context);
+}
+
+/**
+  Drop the subtasks waiting to be submitted to BlockIo2, and signal the tokens
+  of their tasks with EFI_ABORTED.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIo2AbortPendingSubtasks (
+  IN DISK_IO_PRIVATE_DATA  *Instance
+  )
+{
+  EFI_TPL          OldTpl;
+  DISK_IO_SUBTASK  *Subtask;
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  while (!IsListEmpty (&Instance->PendingSubtasks)) {
+    Subtask = CR (GetFirstNode (&Instance->PendingSubtasks), DISK_IO_SUBTASK, PendingLink, DISK_IO_SUBTASK_SIGNATURE);
+    RemoveEntryList (&Subtask->PendingLink);
+    if (Subtask->Task->Token != NULL) {
+      Subtask->Task->Token->TransactionStatus = EFI_ABORTED;
+      gBS->SignalEvent (Subtask->Task->Token->Event);
+      Subtask->Task->Token = NULL;
+    }
+
+    DiskIoDestroySubtask (Instance, Subtask);
+  }
+
+  gBS->RestoreTPL (OldTpl);
+}
+
 /**
   The callback for the BlockIo2 ReadBlocksEx/WriteBlocksEx.
   @param  Event                 Event whose notification function is being invoked.
@@ -434,6 +902,12 @@ DiskIo2OnReadWriteComplete (
 
   DiskIoDestroySubtask (Instance, Subtask);
 
+  ASSERT (Instance->OutstandingSubtasks > 0);
+  Instance->OutstandingSubtasks--;
+  if (!IsListEmpty (&Instance->PendingSubtasks)) {
+    gBS->SignalEvent (Instance->DispatchEvent);
+  }
+
   if (EFI_ERROR (TransactionStatus) || IsListEmpty (&Task->Subtasks)) {
     if (Task->Token != NULL) {
       //
@@ -839,7 +1313,6 @@ DiskIo2ReadWriteDisk (
 {
   EFI_STATUS              Status;
   EFI_BLOCK_IO_PROTOCOL   *BlockIo;
-  EFI_BLOCK_IO2_PROTOCOL  *BlockIo2;
   EFI_BLOCK_IO_MEDIA      *Media;
   LIST_ENTRY              *Link;
   LIST_ENTRY              *NextLink;
@@ -854,16 +1327,17 @@ DiskIo2ReadWriteDisk (
 
   Task     = NULL;
   BlockIo  = Instance->BlockIo;
-  BlockIo2 = Instance->BlockIo2;
   Media    = BlockIo->Media;
   Status   = EFI_SUCCESS;
   Blocking = (BOOLEAN)((Token == NULL) || (Token->Event == NULL));
 
   if (Blocking) {
     //
-    // Wait till pending async task is completed.
+    // Wait till pending async task is completed. The queued subtasks are
+    // submitted here as well, in case the caller blocks their dispatch event.
     //
     while (!DiskIo2RemoveCompletedTask (Instance)) {
+      DiskIo2DispatchPendingSubtasks (Instance);
     }
 
     SubtasksPtr = &Subtasks;
@@ -886,6 +1360,29 @@ DiskIo2ReadWriteDisk (
     SubtasksPtr = &Task->Subtasks;
   }
 
+  if ((Instance->CacheBlockCount != 0) && (BufferSize != 0) && (Media->BlockSize != 0)) {
+    SubtaskPerformTpl = gBS->RaiseTPL (TPL_CALLBACK);
+    if (Write) {
+      //
+      // The block cache is write-through, drop the blocks being overwritten
+      //
+      DiskIoInvalidateBlockCache (
+        Instance,
+        DivU64x32 (Offset, Media->BlockSize),
+        DivU64x32 (Offset + BufferSize - 1, Media->BlockSize) - DivU64x32 (Offset, Media->BlockSize) + 1
+        );
+    } else if (Blocking) {
+      Status = DiskIoCachedRead (Instance, MediaId, Offset, BufferSize, Buffer);
+    }
+
+    gBS->RestoreTPL (SubtaskPerformTpl);
+    if (Blocking && !Write && (Status != EFI_NOT_FOUND)) {
+      return Status;
+    }
+
+    Status = EFI_SUCCESS;
+  }
+
   InitializeListHead (SubtasksPtr);
   if (!DiskIoCreateSubtaskList (Instance, Write, Offset, BufferSize, Buffer, Blocking, Instance->SharedWorkingBuffer, SubtasksPtr)) {
     if (Task != NULL) {
@@ -929,14 +1426,7 @@ DiskIo2ReadWriteDisk (
                             (Subtask->WorkingBuffer != NULL) ? Subtask->WorkingBuffer : Subtask->Buffer
                             );
       } else {
-        Status = BlockIo2->WriteBlocksEx (
-                             BlockIo2,
-                             MediaId,
-                             Subtask->Lba,
-                             &Subtask->BlockIo2Token,
-                             (Subtask->Length % Media->BlockSize == 0) ? Subtask->Length : Media->BlockSize,
-                             (Subtask->WorkingBuffer != NULL) ? Subtask->WorkingBuffer : Subtask->Buffer
-                             );
+        Status = DiskIo2SubmitSubtask (Instance, MediaId, Subtask);
       }
     } else {
       //
@@ -954,14 +1444,7 @@ DiskIo2ReadWriteDisk (
           CopyMem (Subtask->Buffer, Subtask->WorkingBuffer + Subtask->Offset, Subtask->Length);
         }
       } else {
-        Status = BlockIo2->ReadBlocksEx (
-                             BlockIo2,
-                             MediaId,
-                             Subtask->Lba,
-                             &Subtask->BlockIo2Token,
-                             (Subtask->Length % Media->BlockSize == 0) ? Subtask->Length : Media->BlockSize,
-                             (Subtask->WorkingBuffer != NULL) ? Subtask->WorkingBuffer : Subtask->Buffer
-                             );
+        Status = DiskIo2SubmitSubtask (Instance, MediaId, Subtask);
       }
     }
 
@@ -24,6 +24,25 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/MemoryAllocationLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 
+//
+// Number of hash buckets of the block cache, and the largest blocking read
+// in blocks which is served through the block cache.
+//
+#define DISK_IO_CACHE_HASH_SIZE           64
+#define DISK_IO_CACHE_MAX_REQUEST_BLOCKS  16
+
+#define DISK_IO_CACHE_ENTRY_SIGNATURE  SIGNATURE_32 ('d', 'i', 'c', 'e')
+typedef struct {
+  UINT32        Signature;
+  LIST_ENTRY    LruLink;                    /// < link in the LRU list, most recently used first
+  LIST_ENTRY    HashLink;                   /// < link in the hash bucket, when Valid
+  BOOLEAN       Valid;
+  UINT64        Lba;
+  UINT8         *Data;
+} DISK_IO_CACHE_ENTRY;
+#define DISK_IO_CACHE_ENTRY_FROM_LRU_LINK(a)   CR (a, DISK_IO_CACHE_ENTRY, LruLink, DISK_IO_CACHE_ENTRY_SIGNATURE)
+#define DISK_IO_CACHE_ENTRY_FROM_HASH_LINK(a)  CR (a, DISK_IO_CACHE_ENTRY, HashLink, DISK_IO_CACHE_ENTRY_SIGNATURE)
+
 #define DISK_IO_PRIVATE_DATA_SIGNATURE  SIGNATURE_32 ('d', 's', 'k', 'I')
 typedef struct {
   UINT32                    Signature;
@@ -37,6 +56,25 @@ typedef struct {
 
   EFI_LOCK                  TaskQueueLock;
   LIST_ENTRY                TaskQueue;
+
+  //
+  // Optional write-through block cache for small blocking reads
+  //
+  UINTN                     CacheBlockCount;
+  DISK_IO_CACHE_ENTRY       *CacheEntries;
+  UINT8                     *CacheBuffer;
+  UINT32                    CacheMediaId;
+  LIST_ENTRY                CacheLruList;
+  LIST_ENTRY                CacheHash[DISK_IO_CACHE_HASH_SIZE];
+
+  //
+  // Non-blocking subtasks submitted to BlockIo2, and the subtasks waiting
+  // for one of them to complete when PcdDiskIo2MaxOutstandingRequests is reached
+  //
+  UINT32                    MaxOutstandingSubtasks;
+  UINT32                    OutstandingSubtasks;
+  LIST_ENTRY                PendingSubtasks;
+  EFI_EVENT                 DispatchEvent;
 } DISK_IO_PRIVATE_DATA;
 #define DISK_IO_PRIVATE_DATA_FROM_DISK_IO(a)   CR (a, DISK_IO_PRIVATE_DATA, DiskIo,  DISK_IO_PRIVATE_DATA_SIGNATURE)
 #define DISK_IO_PRIVATE_DATA_FROM_DISK_IO2(a)  CR (a, DISK_IO_PRIVATE_DATA, DiskIo2, DISK_IO_PRIVATE_DATA_SIGNATURE)
@@ -80,6 +118,8 @@ typedef struct {
   //
   DISK_IO2_TASK          *Task;
   EFI_BLOCK_IO2_TOKEN    BlockIo2Token;
+  UINT32                 MediaId;
+  LIST_ENTRY             PendingLink;     /// < link in PendingSubtasks of the instance
 } DISK_IO_SUBTASK;
 
 //
@@ -335,6 +375,31 @@ DiskIo2FlushDiskEx (
   IN OUT EFI_DISK_IO2_TOKEN  *Token
   );
 
+/**
+  Drop the subtasks waiting to be submitted to BlockIo2, and signal the tokens
+  of their tasks with EFI_ABORTED.
+
+  @param Instance     Pointer to the DISK_IO_PRIVATE_DATA.
+**/
+VOID
+DiskIo2AbortPendingSubtasks (
+  IN DISK_IO_PRIVATE_DATA  *Instance
+  );
+
+/**
+  The callback to submit the queued subtasks once outstanding subtasks complete.
+
+  @param  Event                 Event whose notification function is being invoked.
+  @param  Context               The pointer to the notification function's context,
+                                which points to the DISK_IO_PRIVATE_DATA instance.
+**/
+VOID
+EFIAPI
+DiskIo2OnDispatchPendingSubtasks (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  );
+
 //
 // EFI Component Name Functions
 //
@@ -273,6 +273,10 @@ UdfOpen (
     (VOID *)&NewPrivFileData->ReadDirInfo,
     sizeof (UDF_READ_DIRECTORY_INFO)
     );
+  ZeroMem (
+    (VOID *)&NewPrivFileData->ReadAheadInfo,
+    sizeof (UDF_READ_AHEAD_INFO)
+    );
 
   *NewHandle = &NewPrivFileData->FileIo;
 
@@ -296,6 +300,87 @@ Error_Invalid_Params:
   return Status;
 }
 
+/**
+  Read data of a normal file through the read-ahead buffer of the file.
+
+  Boot loaders often read a file in small pieces. Filling the buffer with
+  UDF_READ_AHEAD_SIZE bytes at once saves both the seek through the
+  allocation descriptors and a round trip to the media for most of them.
+
+  @param[in]      PrivFsData    Private file system data.
+  @param[in, out] PrivFileData  Private data of the file, the file position is
+                                moved past the data read.
+  @param[out]     Buffer        The buffer in which data is read.
+  @param[in, out] BufferSize    On input size of buffer, on output amount of
+                                data in buffer.
+
+  @retval EFI_SUCCESS          Data was read.
+  @retval EFI_OUT_OF_RESOURCES The read-ahead buffer could not be allocated.
+  @retval other                The data could not be read from the media.
+
+**/
+STATIC
+EFI_STATUS
+ReadFileDataAhead (
+  IN      PRIVATE_UDF_SIMPLE_FS_DATA  *PrivFsData,
+  IN OUT  PRIVATE_UDF_FILE_DATA       *PrivFileData,
+  OUT     VOID                        *Buffer,
+  IN OUT  UINT64                      *BufferSize
+  )
+{
+  EFI_STATUS           Status;
+  UDF_READ_AHEAD_INFO  *ReadAheadInfo;
+  UINT64               Position;
+  UINT64               Length;
+  UINT64               End;
+
+  ReadAheadInfo = &PrivFileData->ReadAheadInfo;
+  Position      = PrivFileData->FilePosition;
+  End           = ReadAheadInfo->Position + ReadAheadInfo->Length;
+
+  if ((Position < ReadAheadInfo->Position) || (Position >= End) ||
+      ((Position + *BufferSize > End) && (End < PrivFileData->FileSize)))
+  {
+    if (ReadAheadInfo->Data == NULL) {
+      ReadAheadInfo->Data = AllocatePool (UDF_READ_AHEAD_SIZE);
+      if (ReadAheadInfo->Data == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+    }
+
+    ReadAheadInfo->Length = 0;
+    Length                = UDF_READ_AHEAD_SIZE;
+    Status                = ReadFileData (
+                              PrivFsData->BlockIo,
+                              PrivFsData->DiskIo,
+                              &PrivFsData->Volume,
+                              _PARENT_FILE (PrivFileData),
+                              PrivFileData->FileSize,
+                              &Position,
+                              ReadAheadInfo->Data,
+                              &Length
+                              );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    ReadAheadInfo->Position = PrivFileData->FilePosition;
+    ReadAheadInfo->Length   = (UINTN)Length;
+    Position                = PrivFileData->FilePosition;
+    End                     = ReadAheadInfo->Position + ReadAheadInfo->Length;
+  }
+
+  *BufferSize = MIN (*BufferSize, End - Position);
+  CopyMem (
+    Buffer,
+    (UINT8 *)ReadAheadInfo->Data + (UINTN)(Position - ReadAheadInfo->Position),
+    (UINTN)*BufferSize
+    );
+  PrivFileData->FilePosition += *BufferSize;
+
+  return EFI_SUCCESS;
+}
+
 /**
   Read data from the file.
 
@@ -377,16 +462,21 @@ UdfRead (
 
     BufferSizeUint64 = *BufferSize;
 
-    Status = ReadFileData (
-               BlockIo,
-               DiskIo,
-               Volume,
-               Parent,
-               PrivFileData->FileSize,
-               &PrivFileData->FilePosition,
-               Buffer,
-               &BufferSizeUint64
-               );
+    if (BufferSizeUint64 < UDF_READ_AHEAD_SIZE) {
+      Status = ReadFileDataAhead (PrivFsData, PrivFileData, Buffer, &BufferSizeUint64);
+    } else {
+      Status = ReadFileData (
+                 BlockIo,
+                 DiskIo,
+                 Volume,
+                 Parent,
+                 PrivFileData->FileSize,
+                 &PrivFileData->FilePosition,
+                 Buffer,
+                 &BufferSizeUint64
+                 );
+    }
+
     ASSERT (BufferSizeUint64 <= MAX_UINTN);
     *BufferSize = (UINTN)BufferSizeUint64;
   } else if (IS_FID_DIRECTORY_FILE (Parent->FileIdentifierDesc)) {
@@ -570,6 +660,10 @@ UdfClose (
     if (PrivFileData->ReadDirInfo.DirectoryData != NULL) {
       FreePool (PrivFileData->ReadDirInfo.DirectoryData);
     }
+
+    if (PrivFileData->ReadAheadInfo.Data != NULL) {
+      FreePool (PrivFileData->ReadAheadInfo.Data);
+    }
   }
 
   FreePool ((VOID *)PrivFileData);
@@ -114,6 +114,12 @@ typedef enum {
 #define UDF_FILENAME_LENGTH  128
 #define UDF_PATH_LENGTH      512
 
+//
+// Reads of a file smaller than UDF_READ_AHEAD_SIZE are served from a buffer
+// filled with that much data of the file at once.
+//
+#define UDF_READ_AHEAD_SIZE  SIZE_64KB
+
 #define GET_FID_FROM_ADS(_Data, _Offs) \
   ((UDF_FILE_IDENTIFIER_DESCRIPTOR *)((UINT8 *)(_Data) + (_Offs)))
 
@@ -331,6 +337,12 @@ typedef struct {
   UINT64    FidOffset;
 } UDF_READ_DIRECTORY_INFO;
 
+typedef struct {
+  VOID      *Data;
+  UINT64    Position;
+  UINTN     Length;
+} UDF_READ_AHEAD_INFO;
+
 #define PRIVATE_UDF_FILE_DATA_SIGNATURE  SIGNATURE_32 ('U', 'd', 'f', 'f')
 
 #define PRIVATE_UDF_FILE_DATA_FROM_THIS(a) \
@@ -347,6 +359,7 @@ typedef struct {
   UDF_FILE_INFO                      *Root;
   UDF_FILE_INFO                      File;
   UDF_READ_DIRECTORY_INFO            ReadDirInfo;
+  UDF_READ_AHEAD_INFO                ReadAheadInfo;
   EFI_SIMPLE_FILE_SYSTEM_PROTOCOL    *SimpleFs;
   EFI_FILE_PROTOCOL                  FileIo;
   CHAR16                             AbsoluteFileName[UDF_PATH_LENGTH];
@@ -645,6 +645,23 @@ EbcDebuggerHookExecuteEnd (
   return;
 }
 
+/**
+
+  The hook in EbcExecute, before running the instructions.
+  The debugger needs the hooks of every instruction, so the instructions
+  always run one by one.
+
+  @retval FALSE  The instructions must run one by one.
+
+**/
+BOOLEAN
+EbcDebuggerHookAllowBlocks (
+  VOID
+  )
+{
+  return FALSE;
+}
+
 /**
 
   The hook in ExecuteCALL, before move IP.
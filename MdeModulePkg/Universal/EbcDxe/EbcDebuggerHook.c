@@ -10,6 +10,8 @@
 
 **/
 
+#include <Library/PcdLib.h>
+
 #include "EbcDebuggerHook.h"
 
 /**
@@ -116,6 +118,22 @@ EbcDebuggerHookExecuteEnd (
   return;
 }
 
+/**
+
+  The hook in EbcExecute, before running the instructions.
+
+  @retval TRUE   The instructions may run in decoded blocks.
+  @retval FALSE  The instructions must run one by one.
+
+**/
+BOOLEAN
+EbcDebuggerHookAllowBlocks (
+  VOID
+  )
+{
+  return FeaturePcdGet (PcdEbcBlockTranslation);
+}
+
 /**
 
   The hook in ExecuteCALL, before move IP.
@@ -115,6 +115,19 @@ EbcDebuggerHookExecuteEnd (
   IN VM_CONTEXT  *VmPtr
   );
 
+/**
+  The hook in EbcExecute, before running the instructions.
+
+  @retval TRUE   The instructions may run in decoded blocks, which skip the
+                 hooks in EbcExecute.
+  @retval FALSE  The instructions must run one by one.
+
+**/
+BOOLEAN
+EbcDebuggerHookAllowBlocks (
+  VOID
+  );
+
 /**
   The hook in ExecuteCALL, before move IP.
 
@@ -1341,6 +1341,718 @@ CONST VM_TABLE_ENTRY  mVmOpcodeTable[] = {
 //
 CONST UINT8  mJMPLen[] = { 2, 2, 6, 10 };
 
+//
+// Block translation.
+//
+// A basic block of EBC instructions is decoded once into an array of
+// EBC_BLOCK_OP, which EbcExecuteBlock() then runs without going through the
+// main loop of EbcExecute() for every instruction. The register to register
+// data manipulations, moves and compares, and JMP8, get an operation of their
+// own with their operands decoded. The other instructions run through the
+// opcode table, with the same memory fences as in EbcExecute(). A block ends
+// after a BREAK, JMP, JMP8, CALL or RET, or before an invalid instruction.
+//
+// The blocks are cached by the address of their first instruction until an
+// EBC image is unloaded.
+//
+#define EBC_BLOCK_MAX_OPS           32
+#define EBC_BLOCK_CACHE_SIZE        512
+#define EBC_BLOCK_CACHE_INDEX(Ip)  (((UINTN)(Ip) >> 1) & (EBC_BLOCK_CACHE_SIZE - 1))
+
+#define EBC_BLOCK_OP_64BIT     BIT0
+#define EBC_BLOCK_OP_SIGNED    BIT1
+#define EBC_BLOCK_OP_OPERAND2  BIT2
+
+typedef struct _EBC_BLOCK_OP EBC_BLOCK_OP;
+
+typedef
+VOID
+(*EBC_BLOCK_OP_FUNCTION) (
+  IN VM_CONTEXT          *VmPtr,
+  IN CONST EBC_BLOCK_OP  *Op
+  );
+
+struct _EBC_BLOCK_OP {
+  EBC_BLOCK_OP_FUNCTION       Function;
+  DATA_MANIP_EXEC_FUNCTION    DataManip;
+  UINT64                      Immediate;
+  UINT64                      Mask;
+  UINT8                       Opcode;
+  UINT8                       Length;
+  UINT8                       Operand1;
+  UINT8                       Operand2;
+  UINT8                       Flags;
+};
+
+typedef struct _EBC_BLOCK EBC_BLOCK;
+struct _EBC_BLOCK {
+  EBC_BLOCK       *Next;
+  VMIP            Start;
+  UINTN           OpCount;
+  EBC_BLOCK_OP    Op[1];
+};
+
+EBC_BLOCK  *mEbcBlockCache[EBC_BLOCK_CACHE_SIZE];
+
+//
+// The blocks flushed while EBC code was running, freed when it returns.
+//
+EBC_BLOCK  *mEbcBlockFreeList = NULL;
+UINTN      mEbcExecuteDepth   = 0;
+
+/**
+  Run an instruction of a block through the opcode table.
+
+  @param  VmPtr             A pointer to a VM context.
+  @param  Op                The operation of the instruction.
+
+**/
+STATIC
+VOID
+EbcBlockOpInterpret (
+  IN VM_CONTEXT          *VmPtr,
+  IN CONST EBC_BLOCK_OP  *Op
+  )
+{
+  MemoryFence ();
+  mVmOpcodeTable[Op->Opcode & OPCODE_M_OPCODE].ExecuteFunction (VmPtr);
+  MemoryFence ();
+}
+
+/**
+  Run a data manipulation instruction with direct operands.
+
+  @param  VmPtr             A pointer to a VM context.
+  @param  Op                The operation of the instruction.
+
+**/
+STATIC
+VOID
+EbcBlockOpDataManip (
+  IN VM_CONTEXT          *VmPtr,
+  IN CONST EBC_BLOCK_OP  *Op
+  )
+{
+  UINT64  Op1;
+  UINT64  Op2;
+
+  Op1 = (UINT64)VmPtr->Gpr[Op->Operand1];
+  Op2 = (UINT64)VmPtr->Gpr[Op->Operand2] + Op->Immediate;
+  if ((Op->Flags & EBC_BLOCK_OP_64BIT) == 0) {
+    if ((Op->Flags & EBC_BLOCK_OP_SIGNED) != 0) {
+      Op1 = (UINT64)(INT64)((INT32)Op1);
+      Op2 = (UINT64)(INT64)((INT32)Op2);
+    } else {
+      Op1 = (UINT64)((UINT32)Op1);
+      Op2 = (UINT64)((UINT32)Op2);
+    }
+  }
+
+  //
+  // The data manipulation functions look at the opcode, the IP must still
+  // point to the instruction.
+  //
+  Op2 = Op->DataManip (VmPtr, Op1, Op2);
+  if ((Op->Flags & EBC_BLOCK_OP_64BIT) == 0) {
+    Op2 &= 0xFFFFFFFF;
+  }
+
+  VmPtr->Gpr[Op->Operand1] = Op2;
+  VmPtr->Ip               += Op->Length;
+}
+
+/**
+  Run a MOVxx instruction with direct operands.
+
+  @param  VmPtr             A pointer to a VM context.
+  @param  Op                The operation of the instruction.
+
+**/
+STATIC
+VOID
+EbcBlockOpMoveRegister (
+  IN VM_CONTEXT          *VmPtr,
+  IN CONST EBC_BLOCK_OP  *Op
+  )
+{
+  VmPtr->Gpr[Op->Operand1] = ((UINT64)VmPtr->Gpr[Op->Operand2] + Op->Immediate) & Op->Mask;
+  VmPtr->Ip               += Op->Length;
+}
+
+/**
+  Run a MOVI instruction to a register.
+
+  @param  VmPtr             A pointer to a VM context.
+  @param  Op                The operation of the instruction.
+
+**/
+STATIC
+VOID
+EbcBlockOpMoveImmediate (
+  IN VM_CONTEXT          *VmPtr,
+  IN CONST EBC_BLOCK_OP  *Op
+  )
+{
+  VmPtr->Gpr[Op->Operand1] = Op->Immediate;
+  VmPtr->Ip               += Op->Length;
+}
+
+/**
+  Run a CMP instruction with a direct operand 2, or a CMPI instruction with a
+  direct operand 1.
+
+  The opcode of the operation is the one of the CMP instruction, and the
+  immediate data of CMPI instructions is already extended as ExecuteCMPI()
+  does.
+
+  @param  VmPtr             A pointer to a VM context.
+  @param  Op                The operation of the instruction.
+
+**/
+STATIC
+VOID
+EbcBlockOpCompare (
+  IN VM_CONTEXT          *VmPtr,
+  IN CONST EBC_BLOCK_OP  *Op
+  )
+{
+  UINT64   Op1;
+  UINT64   Op2;
+  BOOLEAN  Flag;
+
+  Op1 = (UINT64)VmPtr->Gpr[Op->Operand1];
+  Op2 = Op->Immediate;
+  if ((Op->Flags & EBC_BLOCK_OP_OPERAND2) != 0) {
+    Op2 += (UINT64)VmPtr->Gpr[Op->Operand2];
+  }
+
+  if ((Op->Flags & EBC_BLOCK_OP_64BIT) == 0) {
+    Op1 = (UINT64)((UINT32)Op1);
+    Op2 = (UINT64)((UINT32)Op2);
+    if (Op->Opcode <= OPCODE_CMPGTE) {
+      Op1 = (UINT64)(INT64)((INT32)Op1);
+      Op2 = (UINT64)(INT64)((INT32)Op2);
+    }
+  }
+
+  switch (Op->Opcode) {
+    case OPCODE_CMPEQ:
+      Flag = (BOOLEAN)(Op1 == Op2);
+      break;
+
+    case OPCODE_CMPLTE:
+      Flag = (BOOLEAN)((INT64)Op1 <= (INT64)Op2);
+      break;
+
+    case OPCODE_CMPGTE:
+      Flag = (BOOLEAN)((INT64)Op1 >= (INT64)Op2);
+      break;
+
+    case OPCODE_CMPULTE:
+      Flag = (BOOLEAN)(Op1 <= Op2);
+      break;
+
+    default:
+      Flag = (BOOLEAN)(Op1 >= Op2);
+      break;
+  }
+
+  if (Flag) {
+    VMFLAG_SET (VmPtr, VMFLAGS_CC);
+  } else {
+    VMFLAG_CLEAR (VmPtr, (UINT64)VMFLAGS_CC);
+  }
+
+  VmPtr->Ip += Op->Length;
+}
+
+/**
+  Run a JMP8 instruction.
+
+  @param  VmPtr             A pointer to a VM context.
+  @param  Op                The operation of the instruction.
+
+**/
+STATIC
+VOID
+EbcBlockOpJMP8 (
+  IN VM_CONTEXT          *VmPtr,
+  IN CONST EBC_BLOCK_OP  *Op
+  )
+{
+  if ((Op->Opcode & CONDITION_M_CONDITIONAL) != 0) {
+    if ((UINT8)(((Op->Opcode & JMP_M_CS) != 0) ? 1 : 0) != (UINT8)VMFLAG_ISSET (VmPtr, VMFLAGS_CC)) {
+      VmPtr->Ip += 2;
+      return;
+    }
+  }
+
+  VmPtr->Ip += (INTN)(INT64)Op->Immediate + 2;
+}
+
+/**
+  Decode an instruction into the operation of a block.
+
+  @param  VmPtr             A pointer to a VM context. The IP points to the
+                            first instruction of the block.
+  @param  Offset            The offset of the instruction from the IP.
+  @param  Op                The operation to fill.
+
+  @retval TRUE              The instruction was decoded.
+  @retval FALSE             The instruction is invalid, it is left to the
+                            interpreter.
+
+**/
+STATIC
+BOOLEAN
+EbcTranslateInstruction (
+  IN  VM_CONTEXT    *VmPtr,
+  IN  UINT32        Offset,
+  OUT EBC_BLOCK_OP  *Op
+  )
+{
+  UINT8   Opcode;
+  UINT8   OpcMasked;
+  UINT8   Operands;
+  UINT32  Size;
+  UINT32  IndexSize;
+  INT64   Index64Op2;
+  INT64   ImmData64;
+
+  Opcode    = *(VmPtr->Ip + Offset);
+  OpcMasked = (UINT8)(Opcode & OPCODE_M_OPCODE);
+  Operands  = *(VmPtr->Ip + Offset + 1);
+
+  if (mVmOpcodeTable[OpcMasked].ExecuteFunction == NULL) {
+    return FALSE;
+  }
+
+  ZeroMem (Op, sizeof (EBC_BLOCK_OP));
+  Op->Function = EbcBlockOpInterpret;
+  Op->Opcode   = Opcode;
+  Op->Operand1 = (UINT8)OPERAND1_REGNUM (Operands);
+  Op->Operand2 = (UINT8)OPERAND2_REGNUM (Operands);
+
+  switch (OpcMasked) {
+    case OPCODE_BREAK:
+    case OPCODE_JMP:
+    case OPCODE_CALL:
+    case OPCODE_RET:
+      //
+      // The last instruction of the block, its length is not needed.
+      //
+      break;
+
+    case OPCODE_JMP8:
+      Op->Function  = EbcBlockOpJMP8;
+      Op->Immediate = (UINT64)(INT64)(VmReadImmed8 (VmPtr, Offset + 1) * 2);
+      Op->Length    = 2;
+      break;
+
+    case OPCODE_CMPEQ:
+    case OPCODE_CMPLTE:
+    case OPCODE_CMPGTE:
+    case OPCODE_CMPULTE:
+    case OPCODE_CMPUGTE:
+      Op->Length = ((Opcode & OPCODE_M_IMMDATA) != 0) ? 4 : 2;
+      if (!OPERAND2_INDIRECT (Operands)) {
+        Op->Function = EbcBlockOpCompare;
+        Op->Opcode   = OpcMasked;
+        Op->Flags    = EBC_BLOCK_OP_OPERAND2;
+        if ((Opcode & OPCODE_M_64BIT) != 0) {
+          Op->Flags |= EBC_BLOCK_OP_64BIT;
+        }
+
+        if ((Opcode & OPCODE_M_IMMDATA) != 0) {
+          Op->Immediate = (UINT64)(INT64)VmReadImmed16 (VmPtr, Offset + 2);
+        }
+      }
+
+      break;
+
+    case OPCODE_NOT:
+    case OPCODE_NEG:
+    case OPCODE_ADD:
+    case OPCODE_SUB:
+    case OPCODE_MUL:
+    case OPCODE_MULU:
+    case OPCODE_DIV:
+    case OPCODE_DIVU:
+    case OPCODE_MOD:
+    case OPCODE_MODU:
+    case OPCODE_AND:
+    case OPCODE_OR:
+    case OPCODE_XOR:
+    case OPCODE_SHL:
+    case OPCODE_SHR:
+    case OPCODE_ASHR:
+    case OPCODE_EXTNDB:
+    case OPCODE_EXTNDW:
+    case OPCODE_EXTNDD:
+      Op->Length = ((Opcode & DATAMANIP_M_IMMDATA) != 0) ? 4 : 2;
+      if (!OPERAND1_INDIRECT (Operands) && !OPERAND2_INDIRECT (Operands)) {
+        Op->Function  = EbcBlockOpDataManip;
+        Op->DataManip = mDataManipDispatchTable[OpcMasked - OPCODE_NOT];
+        if ((Opcode & DATAMANIP_M_64) != 0) {
+          Op->Flags |= EBC_BLOCK_OP_64BIT;
+        }
+
+        if (mVmOpcodeTable[OpcMasked].ExecuteFunction == ExecuteSignedDataManip) {
+          Op->Flags |= EBC_BLOCK_OP_SIGNED;
+        }
+
+        if ((Opcode & DATAMANIP_M_IMMDATA) != 0) {
+          Op->Immediate = (UINT64)(INT64)VmReadImmed16 (VmPtr, Offset + 2);
+        }
+      }
+
+      break;
+
+    case OPCODE_MOVBW:
+    case OPCODE_MOVWW:
+    case OPCODE_MOVDW:
+    case OPCODE_MOVQW:
+    case OPCODE_MOVBD:
+    case OPCODE_MOVWD:
+    case OPCODE_MOVDD:
+    case OPCODE_MOVQD:
+    case OPCODE_MOVQQ:
+    case OPCODE_MOVNW:
+    case OPCODE_MOVND:
+      if ((OpcMasked <= OPCODE_MOVQW) || (OpcMasked == OPCODE_MOVNW)) {
+        IndexSize = sizeof (UINT16);
+      } else if ((OpcMasked <= OPCODE_MOVQD) || (OpcMasked == OPCODE_MOVND)) {
+        IndexSize = sizeof (UINT32);
+      } else {
+        IndexSize = sizeof (UINT64);
+      }
+
+      Size = 2;
+      if ((Opcode & OPCODE_M_IMMED_OP1) != 0) {
+        Size += IndexSize;
+      }
+
+      Index64Op2 = 0;
+      if ((Opcode & OPCODE_M_IMMED_OP2) != 0) {
+        if (IndexSize == sizeof (UINT16)) {
+          Index64Op2 = VmReadIndex16 (VmPtr, Offset + Size);
+        } else if (IndexSize == sizeof (UINT32)) {
+          Index64Op2 = VmReadIndex32 (VmPtr, Offset + Size);
+        } else {
+          Index64Op2 = VmReadIndex64 (VmPtr, Offset + Size);
+        }
+
+        Size += IndexSize;
+      }
+
+      Op->Length = (UINT8)Size;
+
+      //
+      // ExecuteMOVxx() raises an exception for a direct operand 1 with an
+      // index, leave it to the interpreter.
+      //
+      if (!OPERAND1_INDIRECT (Operands) && !OPERAND2_INDIRECT (Operands) &&
+          ((Opcode & OPCODE_M_IMMED_OP1) == 0))
+      {
+        Op->Function  = EbcBlockOpMoveRegister;
+        Op->Immediate = (UINT64)Index64Op2;
+        if ((OpcMasked == OPCODE_MOVBW) || (OpcMasked == OPCODE_MOVBD)) {
+          Op->Mask = 0xFF;
+        } else if ((OpcMasked == OPCODE_MOVWW) || (OpcMasked == OPCODE_MOVWD)) {
+          Op->Mask = 0xFFFF;
+        } else if ((OpcMasked == OPCODE_MOVDW) || (OpcMasked == OPCODE_MOVDD)) {
+          Op->Mask = 0xFFFFFFFF;
+        } else if ((OpcMasked == OPCODE_MOVNW) || (OpcMasked == OPCODE_MOVND)) {
+          Op->Mask = (UINT64) ~0 >> (64 - 8 * sizeof (UINTN));
+        } else {
+          Op->Mask = (UINT64) ~0;
+        }
+      }
+
+      break;
+
+    case OPCODE_MOVSNW:
+    case OPCODE_MOVSND:
+      IndexSize = (OpcMasked == OPCODE_MOVSNW) ? sizeof (UINT16) : sizeof (UINT32);
+      Size      = 2;
+      if ((Opcode & OPCODE_M_IMMED_OP1) != 0) {
+        Size += IndexSize;
+      }
+
+      if ((Opcode & OPCODE_M_IMMED_OP2) != 0) {
+        Size += IndexSize;
+      }
+
+      Op->Length = (UINT8)Size;
+      break;
+
+    case OPCODE_LOADSP:
+    case OPCODE_STORESP:
+      Op->Length = 2;
+      break;
+
+    case OPCODE_PUSH:
+    case OPCODE_POP:
+    case OPCODE_PUSHN:
+    case OPCODE_POPN:
+      Op->Length = ((Opcode & PUSHPOP_M_IMMDATA) != 0) ? 4 : 2;
+      break;
+
+    case OPCODE_CMPIEQ:
+    case OPCODE_CMPILTE:
+    case OPCODE_CMPIGTE:
+    case OPCODE_CMPIULTE:
+    case OPCODE_CMPIUGTE:
+      Size = 2;
+      if ((Operands & OPERAND_M_CMPI_INDEX) != 0) {
+        Size += sizeof (UINT16);
+      }
+
+      if ((Opcode & OPCODE_M_CMPI32_DATA) != 0) {
+        ImmData64 = (INT64)VmReadImmed32 (VmPtr, Offset + Size);
+        Size     += sizeof (UINT32);
+      } else {
+        ImmData64 = (INT64)VmReadImmed16 (VmPtr, Offset + Size);
+        Size     += sizeof (UINT16);
+      }
+
+      Op->Length = (UINT8)Size;
+      if (!OPERAND1_INDIRECT (Operands) && ((Operands & OPERAND_M_CMPI_INDEX) == 0)) {
+        Op->Function  = EbcBlockOpCompare;
+        Op->Opcode    = (UINT8)(OpcMasked - OPCODE_CMPIEQ + OPCODE_CMPEQ);
+        Op->Immediate = (UINT64)ImmData64;
+        if ((Opcode & OPCODE_M_CMPI64) != 0) {
+          Op->Flags |= EBC_BLOCK_OP_64BIT;
+          //
+          // The unsigned 64-bit compares of ExecuteCMPI() zero-extend the
+          // immediate data from 32 bits.
+          //
+          if (Op->Opcode >= OPCODE_CMPULTE) {
+            Op->Immediate = (UINT64)((UINT32)ImmData64);
+          }
+        }
+      }
+
+      break;
+
+    case OPCODE_MOVI:
+    case OPCODE_MOVIN:
+    case OPCODE_MOVREL:
+      Size = 2;
+      if ((Operands & MOVI_M_IMMDATA) != 0) {
+        Size += sizeof (UINT16);
+      }
+
+      if ((Opcode & MOVI_M_DATAWIDTH) == MOVI_DATAWIDTH16) {
+        ImmData64 = (INT64)VmReadImmed16 (VmPtr, Offset + Size);
+        Size     += sizeof (UINT16);
+      } else if ((Opcode & MOVI_M_DATAWIDTH) == MOVI_DATAWIDTH32) {
+        ImmData64 = (INT64)VmReadImmed32 (VmPtr, Offset + Size);
+        Size     += sizeof (UINT32);
+      } else if ((Opcode & MOVI_M_DATAWIDTH) == MOVI_DATAWIDTH64) {
+        ImmData64 = (INT64)VmReadImmed64 (VmPtr, Offset + Size);
+        Size     += sizeof (UINT64);
+      } else {
+        return FALSE;
+      }
+
+      Op->Length = (UINT8)Size;
+      if ((OpcMasked == OPCODE_MOVI) && !OPERAND1_INDIRECT (Operands) && ((Operands & MOVI_M_IMMDATA) == 0)) {
+        Op->Function = EbcBlockOpMoveImmediate;
+        if ((Operands & MOVI_M_MOVEWIDTH) == MOVI_MOVEWIDTH8) {
+          Op->Immediate = (UINT64)ImmData64 & 0x000000FF;
+        } else if ((Operands & MOVI_M_MOVEWIDTH) == MOVI_MOVEWIDTH16) {
+          Op->Immediate = (UINT64)ImmData64 & 0x0000FFFF;
+        } else if ((Operands & MOVI_M_MOVEWIDTH) == MOVI_MOVEWIDTH32) {
+          Op->Immediate = (UINT64)ImmData64 & 0x00000000FFFFFFFF;
+        } else {
+          Op->Immediate = (UINT64)ImmData64;
+        }
+      }
+
+      break;
+
+    default:
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+  Decode the block of instructions at the IP and add it to the cache.
+
+  @param  VmPtr             A pointer to a VM context.
+
+  @return The block, which has no operation if the first instruction is
+          invalid, or NULL if it could not be allocated.
+
+**/
+STATIC
+EBC_BLOCK *
+EbcTranslateBlock (
+  IN VM_CONTEXT  *VmPtr
+  )
+{
+  EBC_BLOCK_OP  Op[EBC_BLOCK_MAX_OPS];
+  EBC_BLOCK     *Block;
+  UINTN         OpCount;
+  UINT32        Offset;
+  UINTN         Index;
+  EFI_TPL       OldTpl;
+
+  Offset = 0;
+  for (OpCount = 0; OpCount < EBC_BLOCK_MAX_OPS; ) {
+    if (!EbcTranslateInstruction (VmPtr, Offset, &Op[OpCount])) {
+      break;
+    }
+
+    OpCount++;
+    if ((Op[OpCount - 1].Opcode & OPCODE_M_OPCODE) <= OPCODE_RET) {
+      break;
+    }
+
+    Offset += Op[OpCount - 1].Length;
+  }
+
+  Block = AllocatePool (OFFSET_OF (EBC_BLOCK, Op) + MAX (OpCount, 1) * sizeof (EBC_BLOCK_OP));
+  if (Block == NULL) {
+    return NULL;
+  }
+
+  Block->Start   = VmPtr->Ip;
+  Block->OpCount = OpCount;
+  CopyMem (Block->Op, Op, OpCount * sizeof (EBC_BLOCK_OP));
+
+  Index  = EBC_BLOCK_CACHE_INDEX (Block->Start);
+  OldTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  Block->Next            = mEbcBlockCache[Index];
+  mEbcBlockCache[Index] = Block;
+  gBS->RestoreTPL (OldTpl);
+
+  return Block;
+}
+
+/**
+  Run the block of instructions at the IP.
+
+  The block stops early if an instruction does not continue with the next
+  one, or stops the VM.
+
+  @param  VmPtr             A pointer to a VM context.
+  @param  CanTranslate      TRUE if a block that is not in the cache yet may
+                            be decoded.
+
+  @retval TRUE              At least one instruction was run.
+  @retval FALSE             There is no block at the IP, the next instruction
+                            must be run by the interpreter.
+
+**/
+STATIC
+BOOLEAN
+EbcExecuteBlock (
+  IN VM_CONTEXT  *VmPtr,
+  IN BOOLEAN     CanTranslate
+  )
+{
+  EBC_BLOCK           *Block;
+  CONST EBC_BLOCK_OP  *Op;
+  CONST EBC_BLOCK_OP  *LastOp;
+  VMIP                NextIp;
+
+  for (Block = mEbcBlockCache[EBC_BLOCK_CACHE_INDEX (VmPtr->Ip)]; Block != NULL; Block = Block->Next) {
+    if (Block->Start == VmPtr->Ip) {
+      break;
+    }
+  }
+
+  if ((Block == NULL) && CanTranslate) {
+    Block = EbcTranslateBlock (VmPtr);
+  }
+
+  if ((Block == NULL) || (Block->OpCount == 0)) {
+    return FALSE;
+  }
+
+  Op     = Block->Op;
+  LastOp = &Block->Op[Block->OpCount - 1];
+  for ( ; Op != LastOp; Op++) {
+    NextIp = VmPtr->Ip + Op->Length;
+    Op->Function (VmPtr, Op);
+    if ((VmPtr->Ip != NextIp) || ((VmPtr->StopFlags & STOPFLAG_APP_DONE) != 0)) {
+      return TRUE;
+    }
+  }
+
+  LastOp->Function (VmPtr, LastOp);
+  return TRUE;
+}
+
+/**
+  Free the blocks flushed from the cache.
+
+**/
+STATIC
+VOID
+EbcFreeBlocks (
+  VOID
+  )
+{
+  EBC_BLOCK  *Block;
+  EBC_BLOCK  *NextBlock;
+  EFI_TPL    OldTpl;
+
+  OldTpl            = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  Block             = mEbcBlockFreeList;
+  mEbcBlockFreeList = NULL;
+  gBS->RestoreTPL (OldTpl);
+
+  for ( ; Block != NULL; Block = NextBlock) {
+    NextBlock = Block->Next;
+    FreePool (Block);
+  }
+}
+
+/**
+  Flush the cache of decoded blocks of instructions. It must be called when
+  EBC code is unloaded.
+
+  The blocks are freed once no EBC code is running anymore, as the code that
+  unloads an image may itself run from a block.
+
+**/
+VOID
+EbcFlushBlockCache (
+  VOID
+  )
+{
+  EBC_BLOCK  *Block;
+  UINTN      Index;
+  EFI_TPL    OldTpl;
+
+  OldTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  for (Index = 0; Index < EBC_BLOCK_CACHE_SIZE; Index++) {
+    Block = mEbcBlockCache[Index];
+    if (Block == NULL) {
+      continue;
+    }
+
+    while (Block->Next != NULL) {
+      Block = Block->Next;
+    }
+
+    Block->Next           = mEbcBlockFreeList;
+    mEbcBlockFreeList     = mEbcBlockCache[Index];
+    mEbcBlockCache[Index] = NULL;
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  if (mEbcExecuteDepth == 0) {
+    EbcFreeBlocks ();
+  }
+}
+
 /**
   Given a pointer to a new VM context, execute one or more instructions. This
   function is only used for test purposes via the EBC VM test protocol.
@@ -1423,11 +2135,15 @@ EbcExecute (
   UINT8                             StackCorrupted;
   EFI_STATUS                        Status;
   EFI_EBC_SIMPLE_DEBUGGER_PROTOCOL  *EbcSimpleDebugger;
+  BOOLEAN                           UseBlocks;
+  BOOLEAN                           CanTranslate;
+  EFI_TPL                           OldTpl;
 
   mVmPtr            = VmPtr;
   EbcSimpleDebugger = NULL;
   Status            = EFI_SUCCESS;
   StackCorrupted    = 0;
+  mEbcExecuteDepth++;
 
   //
   // Make sure the magic value has been put on the stack before we got here.
@@ -1453,6 +2169,18 @@ EbcExecute (
 
   DEBUG_CODE_END ();
 
+  //
+  // The blocks skip the debugger, and may only be decoded where memory may be
+  // allocated.
+  //
+  UseBlocks    = (BOOLEAN)(EbcDebuggerHookAllowBlocks () && (EbcSimpleDebugger == NULL));
+  CanTranslate = FALSE;
+  if (UseBlocks) {
+    OldTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+    gBS->RestoreTPL (OldTpl);
+    CanTranslate = (BOOLEAN)(OldTpl <= TPL_NOTIFY);
+  }
+
   //
   // Save the start IP for debug. For example, if we take an exception we
   // can print out the location of the exception relative to the entry point,
@@ -1467,46 +2195,52 @@ EbcExecute (
   VmPtr->StopFlags = 0;
   while ((VmPtr->StopFlags & STOPFLAG_APP_DONE) == 0) {
     //
-    // If we've found a simple debugger protocol, call it
+    // Run the block of instructions at the IP if there is one, the checks
+    // below are then done once for the whole block.
     //
-    DEBUG_CODE_BEGIN ();
-    if (EbcSimpleDebugger != NULL) {
-      EbcSimpleDebugger->Debugger (EbcSimpleDebugger, VmPtr);
-    }
+    if (!UseBlocks || VMFLAG_ISSET (VmPtr, VMFLAGS_STEP) || !EbcExecuteBlock (VmPtr, CanTranslate)) {
+      //
+      // If we've found a simple debugger protocol, call it
+      //
+      DEBUG_CODE_BEGIN ();
+      if (EbcSimpleDebugger != NULL) {
+        EbcSimpleDebugger->Debugger (EbcSimpleDebugger, VmPtr);
+      }
 
-    DEBUG_CODE_END ();
+      DEBUG_CODE_END ();
 
-    //
-    // Use the opcode bits to index into the opcode dispatch table. If the
-    // function pointer is null then generate an exception.
-    //
-    ExecFunc = (UINTN)mVmOpcodeTable[(*VmPtr->Ip & OPCODE_M_OPCODE)].ExecuteFunction;
-    if (ExecFunc == (UINTN)NULL) {
-      EbcDebugSignalException (EXCEPT_EBC_INVALID_OPCODE, EXCEPTION_FLAG_FATAL, VmPtr);
-      Status = EFI_UNSUPPORTED;
-      goto Done;
-    }
+      //
+      // Use the opcode bits to index into the opcode dispatch table. If the
+      // function pointer is null then generate an exception.
+      //
+      ExecFunc = (UINTN)mVmOpcodeTable[(*VmPtr->Ip & OPCODE_M_OPCODE)].ExecuteFunction;
+      if (ExecFunc == (UINTN)NULL) {
+        EbcDebugSignalException (EXCEPT_EBC_INVALID_OPCODE, EXCEPTION_FLAG_FATAL, VmPtr);
+        Status = EFI_UNSUPPORTED;
+        goto Done;
+      }
 
-    EbcDebuggerHookExecuteStart (VmPtr);
+      EbcDebuggerHookExecuteStart (VmPtr);
 
-    //
-    // The EBC VM is a strongly ordered processor, so perform a fence operation before
-    // and after each instruction is executed.
-    //
-    MemoryFence ();
+      //
+      // The EBC VM is a strongly ordered processor, so perform a fence operation before
+      // and after each instruction is executed.
+      //
+      MemoryFence ();
 
-    mVmOpcodeTable[(*VmPtr->Ip & OPCODE_M_OPCODE)].ExecuteFunction (VmPtr);
+      mVmOpcodeTable[(*VmPtr->Ip & OPCODE_M_OPCODE)].ExecuteFunction (VmPtr);
 
-    MemoryFence ();
+      MemoryFence ();
 
-    EbcDebuggerHookExecuteEnd (VmPtr);
+      EbcDebuggerHookExecuteEnd (VmPtr);
 
-    //
-    // If the step flag is set, signal an exception and continue. We don't
-    // clear it here. Assuming the debugger is responsible for clearing it.
-    //
-    if (VMFLAG_ISSET (VmPtr, VMFLAGS_STEP)) {
-      EbcDebugSignalException (EXCEPT_EBC_STEP, EXCEPTION_FLAG_NONE, VmPtr);
+      //
+      // If the step flag is set, signal an exception and continue. We don't
+      // clear it here. Assuming the debugger is responsible for clearing it.
+      //
+      if (VMFLAG_ISSET (VmPtr, VMFLAGS_STEP)) {
+        EbcDebugSignalException (EXCEPT_EBC_STEP, EXCEPTION_FLAG_NONE, VmPtr);
+      }
     }
 
     //
@@ -1526,6 +2260,11 @@ EbcExecute (
 Done:
   mVmPtr = NULL;
 
+  mEbcExecuteDepth--;
+  if ((mEbcExecuteDepth == 0) && (mEbcBlockFreeList != NULL) && CanTranslate) {
+    EbcFreeBlocks ();
+  }
+
   return Status;
 }
 
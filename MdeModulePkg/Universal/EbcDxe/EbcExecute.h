@@ -128,4 +128,14 @@ EbcExecuteInstructions (
   IN OUT UINTN                 *InstructionCount
   );
 
+/**
+  Flush the cache of decoded blocks of instructions. It must be called when
+  EBC code is unloaded.
+
+**/
+VOID
+EbcFlushBlockCache (
+  VOID
+  );
+
 #endif // ifndef _EBC_EXECUTE_H_
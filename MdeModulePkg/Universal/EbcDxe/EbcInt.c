@@ -1217,6 +1217,11 @@ EbcUnloadImage (
   //
   FreePool (ImageList);
 
+  //
+  // The decoded blocks may point into the image.
+  //
+  EbcFlushBlockCache ();
+
   EbcDebuggerHookEbcUnloadImage (ImageHandle);
 
   return EFI_SUCCESS;
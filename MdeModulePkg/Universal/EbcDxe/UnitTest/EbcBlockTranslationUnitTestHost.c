@@ -0,0 +1,473 @@
+/** @file
+  Unit tests of the EBC block translation.
+
+  Every program runs once through EbcExecute(), which decodes its blocks, once
+  more from the block cache, and once instruction by instruction through
+  EbcExecuteInstructions(). The three runs must leave the same registers,
+  flags and memory.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UnitTestLib.h>
+
+#include "../EbcInt.h"
+#include "../EbcExecute.h"
+
+#define UNIT_TEST_APP_NAME     "EBC Block Translation Unit Test"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+#define EBC_TEST_STACK_SIZE   0x1000
+#define EBC_TEST_MEMORY_SIZE  0x40
+
+typedef struct {
+  CONST UINT8    *Code;
+  UINTN          CodeSize;
+} EBC_TEST_PROGRAM;
+
+typedef struct {
+  VM_CONTEXT    Vm;
+  UINTN         ExceptionCount;
+  UINT8         Memory[EBC_TEST_MEMORY_SIZE];
+} EBC_TEST_RESULT;
+
+//
+// Loop that mixes 64-bit data manipulations, moves through memory and a
+// conditional JMP8 back to the start of the loop.
+//
+//    MOVIqq    R1, 0x0123456789ABCDEF
+//    MOVIqw    R2, 100
+//    MOVIqw    R3, 1
+//  Loop:
+//    ADD64     R1, R2
+//    XOR64     R3, R1
+//    SHL64     R3, R7 3
+//    MOVqq     @R6, R3
+//    MOVqq     R4, @R6
+//    DIVU64    R4, R2
+//    SUB64     R2, R7 1
+//    CMPI64wEQ R2, 0
+//    JMP8cc    Loop
+//    RET
+//
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8  mEbcTestLoop[] = {
+  0xF7, 0x31, 0xEF, 0xCD, 0xAB, 0x89, 0x67, 0x45, 0x23, 0x01,
+  0x77, 0x32, 0x64, 0x00,
+  0x77, 0x33, 0x01, 0x00,
+  0x4C, 0x21,
+  0x56, 0x13,
+  0xD7, 0x73, 0x03, 0x00,
+  0x28, 0x3E,
+  0x28, 0xE4,
+  0x51, 0x24,
+  0xCD, 0x72, 0x01, 0x00,
+  0x6D, 0x02, 0x00, 0x00,
+  0x82, 0xF4,
+  0x04, 0x00
+};
+
+//
+// 32-bit data manipulations, sign and zero extensions, the MOV variants with
+// indexes, compares of every kind and instructions left to the interpreter.
+//
+//    MOVIdd    R1, 0x80000001
+//    MOVIqw    R2, -5
+//    NEG32     R3, R2
+//    MUL32     R1, R2
+//    ASHR32    R1, R7 4
+//    EXTNDB64  R5, R1
+//    MOVbw     R4, R1
+//    MOVww     R4, R1(+4)
+//    MOVnw     R5, R2
+//    MOVdd     R2, R1(+16)
+//    PUSH64    R1
+//    POP64     R7
+//    CMP32lte  R1, R3
+//    JMP8cs    +1
+//    MOVIqw    R7, 0x1234
+//    CMPI32dugte R4, 0xFFFF
+//    JMP8cc    +1
+//    NOT64     R7, R4
+//    CMP64ugte R5, R2 3
+//    RET
+//
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8  mEbcTestMixed[] = {
+  0xB7, 0x21, 0x01, 0x00, 0x00, 0x80,
+  0x77, 0x32, 0xFB, 0xFF,
+  0x0B, 0x23,
+  0x0E, 0x21,
+  0x99, 0x71, 0x04, 0x00,
+  0x5A, 0x15,
+  0x1D, 0x14,
+  0x5E, 0x14, 0x04, 0x00,
+  0x32, 0x25,
+  0x63, 0x12, 0x10, 0x00, 0x00, 0x00,
+  0x6B, 0x01,
+  0x6C, 0x07,
+  0x06, 0x31,
+  0xC2, 0x01,
+  0x77, 0x37, 0x34, 0x12,
+  0xB1, 0x04, 0xFF, 0xFF, 0x00, 0x00,
+  0x82, 0x01,
+  0x4A, 0x47,
+  0xC9, 0x25, 0x03, 0x00,
+  0x04, 0x00
+};
+
+//
+// Division by zero in the middle of a block, the block must stop right after
+// the fatal exception.
+//
+//    MOVIqw    R1, 7
+//    MOVIqw    R2, 0
+//    DIVU64    R1, R2
+//    MOVIqw    R3, 9
+//    RET
+//
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8  mEbcTestDivideByZero[] = {
+  0x77, 0x31, 0x07, 0x00,
+  0x77, 0x32, 0x00, 0x00,
+  0x51, 0x21,
+  0x77, 0x33, 0x09, 0x00,
+  0x04, 0x00
+};
+
+EBC_TEST_PROGRAM  mEbcTestLoopProgram         = { mEbcTestLoop, sizeof (mEbcTestLoop) };
+EBC_TEST_PROGRAM  mEbcTestMixedProgram        = { mEbcTestMixed, sizeof (mEbcTestMixed) };
+EBC_TEST_PROGRAM  mEbcTestDivideByZeroProgram = { mEbcTestDivideByZero, sizeof (mEbcTestDivideByZero) };
+
+VM_CONTEXT  *mVmPtr = NULL;
+UINTN       mEbcTestExceptionCount;
+EFI_TPL     mEbcTestTpl = TPL_APPLICATION;
+
+/**
+  Mock of RaiseTPL().
+
+  @param[in]  NewTpl  The new TPL.
+
+  @return The previous TPL.
+
+**/
+EFI_TPL
+EFIAPI
+MockRaiseTpl (
+  IN EFI_TPL  NewTpl
+  )
+{
+  EFI_TPL  OldTpl;
+
+  OldTpl      = mEbcTestTpl;
+  mEbcTestTpl = NewTpl;
+  return OldTpl;
+}
+
+/**
+  Mock of RestoreTPL().
+
+  @param[in]  OldTpl  The TPL to restore.
+
+**/
+VOID
+EFIAPI
+MockRestoreTpl (
+  IN EFI_TPL  OldTpl
+  )
+{
+  mEbcTestTpl = OldTpl;
+}
+
+/**
+  Mock of LocateProtocol(), no EBC debugger is installed.
+
+  @retval EFI_NOT_FOUND  Always.
+
+**/
+EFI_STATUS
+EFIAPI
+MockLocateProtocol (
+  IN  EFI_GUID  *Protocol,
+  IN  VOID      *Registration OPTIONAL,
+  OUT VOID      **Interface
+  )
+{
+  return EFI_NOT_FOUND;
+}
+
+EFI_BOOT_SERVICES  mMockBootServices = {
+  .RaiseTPL       = MockRaiseTpl,
+  .RestoreTPL     = MockRestoreTpl,
+  .LocateProtocol = MockLocateProtocol
+};
+
+EFI_BOOT_SERVICES  *gBS = &mMockBootServices;
+
+/**
+  Stub of the exception handler of EbcInt.c, a fatal exception stops the VM.
+
+  @param  ExceptionType    The exception type.
+  @param  ExceptionFlags   The exception flags.
+  @param  VmPtr            A pointer to the VM context.
+
+  @retval EFI_SUCCESS      Always.
+
+**/
+EFI_STATUS
+EbcDebugSignalException (
+  IN EFI_EXCEPTION_TYPE  ExceptionType,
+  IN EXCEPTION_FLAGS     ExceptionFlags,
+  IN VM_CONTEXT          *VmPtr
+  )
+{
+  mEbcTestExceptionCount++;
+  if ((ExceptionFlags & EXCEPTION_FLAG_FATAL) != 0) {
+    VmPtr->StopFlags |= STOPFLAG_APP_DONE;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Stub of the thunk creation, the test programs do not use CALLEX.
+
+  @retval EFI_UNSUPPORTED  Always.
+
+**/
+EFI_STATUS
+EbcCreateThunks (
+  IN EFI_HANDLE  ImageHandle,
+  IN VOID        *EbcEntryPoint,
+  OUT VOID       **Thunk,
+  IN  UINT32     Flags
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+/**
+  Stub of the native call, the test programs do not use CALLEX.
+
+**/
+VOID
+EbcLLCALLEX (
+  IN VM_CONTEXT  *VmPtr,
+  IN UINTN       FuncAddr,
+  IN UINTN       NewStackPointer,
+  IN VOID        *FramePtr,
+  IN UINT8       Size
+  )
+{
+}
+
+/**
+  Run a test program.
+
+  @param[in]   Program    The program to run.
+  @param[in]   Stack      A stack of EBC_TEST_STACK_SIZE bytes.
+  @param[in]   InBlocks   TRUE to run the program with EbcExecute(), FALSE to
+                          run it instruction by instruction.
+  @param[out]  Result     The state of the VM when the program stopped.
+
+**/
+VOID
+EbcTestRun (
+  IN  EBC_TEST_PROGRAM  *Program,
+  IN  UINT8             *Stack,
+  IN  BOOLEAN           InBlocks,
+  OUT EBC_TEST_RESULT   *Result
+  )
+{
+  VM_CONTEXT  *VmPtr;
+  UINTN       Count;
+
+  ZeroMem (Result, sizeof (*Result));
+  VmPtr = &Result->Vm;
+
+  //
+  // The RET at the top of the stack stops the VM.
+  //
+  *(UINTN *)Stack        = (UINTN)VM_STACK_KEY_VALUE;
+  VmPtr->StackMagicPtr   = (UINTN *)Stack;
+  VmPtr->StackTop        = Stack;
+  VmPtr->Gpr[0]          = (UINT64)(UINTN)(Stack + EBC_TEST_STACK_SIZE - 16);
+  VmPtr->StackRetAddr    = VmPtr->Gpr[0];
+  VmPtr->Gpr[6]          = (UINT64)(UINTN)Result->Memory;
+  VmPtr->Ip              = (VMIP)Program->Code;
+  VmPtr->LowStackTop     = 0;
+  VmPtr->HighStackBottom = 0;
+
+  mEbcTestExceptionCount = 0;
+  if (InBlocks) {
+    EbcExecute (VmPtr);
+  } else {
+    while ((VmPtr->StopFlags & STOPFLAG_APP_DONE) == 0) {
+      Count = 1;
+      EbcExecuteInstructions (NULL, VmPtr, &Count);
+    }
+  }
+
+  Result->ExceptionCount = mEbcTestExceptionCount;
+}
+
+/**
+  Check that a program gives the same results in blocks, from the block
+  cache, and instruction by instruction.
+
+  @param[in]  Context  The EBC_TEST_PROGRAM to run.
+
+  @retval UNIT_TEST_PASSED               The results are the same.
+  @retval UNIT_TEST_ERROR_TEST_FAILED    The results differ.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+EbcTestCompare (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EBC_TEST_PROGRAM  *Program;
+  UINT8             *Stack;
+  EBC_TEST_RESULT   *Results;
+  UINTN             Run;
+  UINTN             Index;
+
+  Program = (EBC_TEST_PROGRAM *)Context;
+  Stack   = AllocateZeroPool (EBC_TEST_STACK_SIZE);
+  Results = AllocateZeroPool (3 * sizeof (EBC_TEST_RESULT));
+  UT_ASSERT_NOT_NULL (Stack);
+  UT_ASSERT_NOT_NULL (Results);
+
+  EbcTestRun (Program, Stack, FALSE, &Results[0]);
+  EbcTestRun (Program, Stack, TRUE, &Results[1]);
+  EbcTestRun (Program, Stack, TRUE, &Results[2]);
+
+  for (Run = 1; Run < 3; Run++) {
+    for (Index = 1; Index < ARRAY_SIZE (Results[0].Vm.Gpr); Index++) {
+      if (Index != 6) {
+        UT_ASSERT_EQUAL (Results[Run].Vm.Gpr[Index], Results[0].Vm.Gpr[Index]);
+      }
+    }
+
+    UT_ASSERT_EQUAL (Results[Run].Vm.Gpr[0], Results[0].Vm.Gpr[0]);
+    UT_ASSERT_EQUAL (Results[Run].Vm.Flags, Results[0].Vm.Flags);
+    UT_ASSERT_EQUAL ((UINTN)Results[Run].Vm.Ip, (UINTN)Results[0].Vm.Ip);
+    UT_ASSERT_EQUAL (Results[Run].ExceptionCount, Results[0].ExceptionCount);
+    UT_ASSERT_MEM_EQUAL (Results[Run].Memory, Results[0].Memory, EBC_TEST_MEMORY_SIZE);
+  }
+
+  FreePool (Results);
+  FreePool (Stack);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check that a program still gives the same results after the block cache
+  was flushed.
+
+  @param[in]  Context  The EBC_TEST_PROGRAM to run.
+
+  @retval UNIT_TEST_PASSED               The results are the same.
+  @retval UNIT_TEST_ERROR_TEST_FAILED    The results differ.
+
+**/
+UNIT_TEST_STATUS
+EFIAPI
+EbcTestFlush (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EbcFlushBlockCache ();
+  return EbcTestCompare (Context);
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the EBC block
+  translation and run them.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      BlockTranslationTests;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  Framework = NULL;
+
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&BlockTranslationTests, Framework, "EBC Block Translation Tests", "EbcDxe.BlockTranslation", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for the EBC Block Translation Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // --------------Suite-----------Description--------------Name----------Function--------Pre---Post-------------------Context-----------
+  //
+  AddTestCase (BlockTranslationTests, "64-bit loop through memory", "Loop", EbcTestCompare, NULL, NULL, &mEbcTestLoopProgram);
+  AddTestCase (BlockTranslationTests, "32-bit operations, moves and compares", "Mixed", EbcTestCompare, NULL, NULL, &mEbcTestMixedProgram);
+  AddTestCase (BlockTranslationTests, "Division by zero in a block", "DivideByZero", EbcTestCompare, NULL, NULL, &mEbcTestDivideByZeroProgram);
+  AddTestCase (BlockTranslationTests, "Loop after a flush of the block cache", "Flush", EbcTestFlush, NULL, NULL, &mEbcTestLoopProgram);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+///
+/// Avoid ECC error for function name that starts with lower case letter
+///
+#define EbcBlockTranslationUnitTestMain  main
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param[in] Argc  Number of arguments
+  @param[in] Argv  Array of pointers to arguments
+
+  @retval 0      Success
+  @retval other  Error
+**/
+INT32
+EbcBlockTranslationUnitTestMain (
+  IN INT32  Argc,
+  IN CHAR8  *Argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
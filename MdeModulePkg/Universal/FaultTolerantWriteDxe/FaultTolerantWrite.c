@@ -331,6 +331,7 @@ FtwWrite (
   UINT8                               *MyBuffer;
   UINTN                               SpareBufferSize;
   UINT8                               *SpareBuffer;
+  BOOLEAN                             SpareErased;
   UINTN                               Index;
   UINT8                               *Ptr;
   EFI_PHYSICAL_ADDRESS                FvbPhysicalAddress;
@@ -526,15 +527,24 @@ FtwWrite (
     Ptr += MyLength;
   }
 
+  //
+  // The spare block is left erased by the previous write, so back to back
+  // writes need neither erase it first nor program its erased content back
+  // at the end.
+  //
+  SpareErased = IsErasedFlashBuffer (SpareBuffer, SpareBufferSize);
+
   //
   // Write the memory buffer to spare block
   // Do not assume Spare Block and Target Block have same block size
   //
-  Status = FtwEraseSpareBlock (FtwDevice);
-  if (EFI_ERROR (Status)) {
-    FreePool (MyBuffer);
-    FreePool (SpareBuffer);
-    return EFI_ABORTED;
+  if (!SpareErased) {
+    Status = FtwEraseSpareBlock (FtwDevice);
+    if (EFI_ERROR (Status)) {
+      FreePool (MyBuffer);
+      FreePool (SpareBuffer);
+      return EFI_ABORTED;
+    }
   }
 
   Ptr = MyBuffer;
@@ -605,7 +615,7 @@ FtwWrite (
   }
 
   Ptr = SpareBuffer;
-  for (Index = 0; Index < FtwDevice->NumberOfSpareBlock; Index += 1) {
+  for (Index = 0; (!SpareErased) && (Index < FtwDevice->NumberOfSpareBlock); Index += 1) {
     MyLength = FtwDevice->SpareBlockSize;
     Status   = FtwDevice->FtwBackupFvb->Write (
                                           FtwDevice->FtwBackupFvb,
@@ -801,6 +801,15 @@ GetStringIdFromString (
   ASSERT (StringPackage != NULL && KeywordValue != NULL && StringId != NULL);
   ASSERT (StringPackage->Signature == HII_STRING_PACKAGE_SIGNATURE);
 
+  //
+  // Look the keyword up in the hash table of the string package, which is
+  // built once, rather than comparing it with every string.
+  //
+  Status = FindStringIdFromText (StringPackage, KeywordValue, StringId);
+  if (Status != EFI_UNSUPPORTED) {
+    return Status;
+  }
+
   CurrentStringId = 1;
   Status          = EFI_SUCCESS;
   String          = NULL;
@@ -1465,6 +1474,101 @@ IsStorageOpCode (
   return FALSE;
 }
 
+/**
+  Compare two entries of the prompt index of a form package, by prompt and
+  then by offset.
+
+  @param  Buffer1                The first HII_IFR_PROMPT_INDEX_ENTRY.
+  @param  Buffer2                The second HII_IFR_PROMPT_INDEX_ENTRY.
+
+  @retval 0                      Buffer1 equal to Buffer2.
+  @return <0                     Buffer1 is less than Buffer2.
+  @return >0                     Buffer1 is greater than Buffer2.
+
+**/
+INTN
+EFIAPI
+ComparePromptIndexEntry (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  CONST HII_IFR_PROMPT_INDEX_ENTRY  *Entry1;
+  CONST HII_IFR_PROMPT_INDEX_ENTRY  *Entry2;
+
+  Entry1 = (CONST HII_IFR_PROMPT_INDEX_ENTRY *)Buffer1;
+  Entry2 = (CONST HII_IFR_PROMPT_INDEX_ENTRY *)Buffer2;
+
+  if (Entry1->Prompt != Entry2->Prompt) {
+    return (Entry1->Prompt < Entry2->Prompt) ? -1 : 1;
+  }
+
+  if (Entry1->Offset != Entry2->Offset) {
+    return (Entry1->Offset < Entry2->Offset) ? -1 : 1;
+  }
+
+  return 0;
+}
+
+/**
+  Build the index of the statements of a form package by prompt string id.
+
+  The form data of a package does not change while it is in the database, so
+  the index lives as long as the package. If memory runs out, no index is
+  built.
+
+  @param  FormPackage            The input form package.
+
+**/
+VOID
+BuildPromptIndex (
+  IN HII_IFR_PACKAGE_INSTANCE  *FormPackage
+  )
+{
+  HII_IFR_PROMPT_INDEX_ENTRY  *PromptIndex;
+  HII_IFR_PROMPT_INDEX_ENTRY  Swap;
+  UINTN                       Count;
+  UINT32                      Offset;
+  EFI_IFR_OP_HEADER           *OpCodeHeader;
+  EFI_IFR_STATEMENT_HEADER    *StatementHeader;
+  UINT32                      FormDataLen;
+
+  FormDataLen = FormPackage->FormPkgHdr.Length - sizeof (EFI_HII_PACKAGE_HEADER);
+
+  Count = 0;
+  for (Offset = 0; Offset < FormDataLen; Offset += OpCodeHeader->Length) {
+    OpCodeHeader = (EFI_IFR_OP_HEADER *)(FormPackage->IfrData + Offset);
+    if (OpCodeHeader->Length == 0) {
+      return;
+    }
+
+    if (IsStatementOpCode (OpCodeHeader->OpCode)) {
+      Count++;
+    }
+  }
+
+  PromptIndex = AllocatePool (MAX (Count, 1) * sizeof (HII_IFR_PROMPT_INDEX_ENTRY));
+  if (PromptIndex == NULL) {
+    return;
+  }
+
+  Count = 0;
+  for (Offset = 0; Offset < FormDataLen; Offset += OpCodeHeader->Length) {
+    OpCodeHeader = (EFI_IFR_OP_HEADER *)(FormPackage->IfrData + Offset);
+    if (IsStatementOpCode (OpCodeHeader->OpCode)) {
+      StatementHeader           = (EFI_IFR_STATEMENT_HEADER *)(OpCodeHeader + 1);
+      PromptIndex[Count].Prompt = StatementHeader->Prompt;
+      PromptIndex[Count].Offset = Offset;
+      Count++;
+    }
+  }
+
+  QuickSort (PromptIndex, Count, sizeof (HII_IFR_PROMPT_INDEX_ENTRY), ComparePromptIndexEntry, &Swap);
+
+  FormPackage->PromptIndex      = PromptIndex;
+  FormPackage->PromptIndexCount = Count;
+}
+
 /**
   Base on the prompt string id to find the question.
 
@@ -1485,9 +1589,38 @@ FindQuestionFromStringId (
   EFI_IFR_STATEMENT_HEADER  *StatementHeader;
   EFI_IFR_OP_HEADER         *OpCodeHeader;
   UINT32                    FormDataLen;
+  UINTN                     Low;
+  UINTN                     High;
+  UINTN                     Middle;
 
   ASSERT (FormPackage != NULL);
 
+  if (FormPackage->PromptIndex == NULL) {
+    BuildPromptIndex (FormPackage);
+  }
+
+  if (FormPackage->PromptIndex != NULL) {
+    //
+    // Find the first statement with this prompt in the sorted index.
+    //
+    Low  = 0;
+    High = FormPackage->PromptIndexCount;
+    while (Low < High) {
+      Middle = Low + (High - Low) / 2;
+      if (FormPackage->PromptIndex[Middle].Prompt < KeywordStrId) {
+        Low = Middle + 1;
+      } else {
+        High = Middle;
+      }
+    }
+
+    if ((Low < FormPackage->PromptIndexCount) && (FormPackage->PromptIndex[Low].Prompt == KeywordStrId)) {
+      return FormPackage->IfrData + FormPackage->PromptIndex[Low].Offset;
+    }
+
+    return NULL;
+  }
+
   FormDataLen = FormPackage->FormPkgHdr.Length - sizeof (EFI_HII_PACKAGE_HEADER);
   Offset      = 0;
   while (Offset < FormDataLen) {
@@ -1304,6 +1304,10 @@ RemoveFormPackages (
 
     RemoveEntryList (&Package->IfrEntry);
     PackageList->PackageListHdr.PackageLength -= Package->FormPkgHdr.Length;
+    if (Package->PromptIndex != NULL) {
+      FreePool (Package->PromptIndex);
+    }
+
     FreePool (Package->IfrData);
     FreePool (Package);
     //
@@ -1536,6 +1540,7 @@ AdjustStringPackage (
       // Append a EFI_HII_SIBT_END block to the end.
       //
       *BlockPtr = EFI_HII_SIBT_END;
+      InvalidateStringIndex (StringPackage);
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock                  = StringBlock;
       StringPackage->StringPkgHdr->Header.Length += Skip2BlockSize;
@@ -1676,6 +1681,7 @@ RemoveStringPackages (
 
     RemoveEntryList (&Package->StringEntry);
     PackageList->PackageListHdr.PackageLength -= Package->StringPkgHdr->Header.Length;
+    InvalidateStringIndex (Package);
     FreePool (Package->StringBlock);
     FreePool (Package->StringPkgHdr);
     //
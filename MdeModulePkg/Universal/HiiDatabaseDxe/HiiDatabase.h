@@ -150,6 +150,28 @@ typedef struct {
 // String Package definitions
 //
 #define HII_STRING_PACKAGE_SIGNATURE  SIGNATURE_32 ('h','i','s','p')
+
+//
+// Where the string block of a string id is. A BlockOffset of
+// HII_STRING_INDEX_NOT_INDEXED means the string blocks have to be parsed to
+// find the string id, as for a duplicate or skipped one.
+//
+#define HII_STRING_INDEX_NOT_INDEXED  MAX_UINT32
+
+typedef struct {
+  UINT32    BlockOffset;                               // offset of the string block in StringBlock
+  UINT32    TextOffset;                                // offset of the string text in the string block
+} HII_STRING_INDEX_ENTRY;
+
+//
+// Entry of the hash table of the string texts of a string package. Entries
+// with a StringId of 0 are free.
+//
+typedef struct {
+  UINT32           Hash;
+  EFI_STRING_ID    StringId;
+} HII_STRING_HASH_ENTRY;
+
 typedef struct _HII_STRING_PACKAGE_INSTANCE {
   UINTN                         Signature;
   EFI_HII_STRING_PACKAGE_HDR    *StringPkgHdr;
@@ -158,17 +180,31 @@ typedef struct _HII_STRING_PACKAGE_INSTANCE {
   LIST_ENTRY                    FontInfoList;          // local font info list
   UINT8                         FontId;
   EFI_STRING_ID                 MaxStringId;           // record StringId
+  HII_STRING_INDEX_ENTRY        *StringIndex;          // built on first lookup, indexed by StringId
+  HII_STRING_HASH_ENTRY         *StringHash;           // built on first lookup by text
+  UINTN                         StringHashSize;        // number of entries of StringHash, a power of 2
 } HII_STRING_PACKAGE_INSTANCE;
 
 //
 // Form Package definitions
 //
 #define HII_IFR_PACKAGE_SIGNATURE  SIGNATURE_32 ('h','f','r','p')
+
+//
+// The offset in IfrData of a statement with a given prompt.
+//
+typedef struct {
+  EFI_STRING_ID    Prompt;
+  UINT32           Offset;
+} HII_IFR_PROMPT_INDEX_ENTRY;
+
 typedef struct _HII_IFR_PACKAGE_INSTANCE {
-  UINTN                     Signature;
-  EFI_HII_PACKAGE_HEADER    FormPkgHdr;
-  UINT8                     *IfrData;
-  LIST_ENTRY                IfrEntry;
+  UINTN                         Signature;
+  EFI_HII_PACKAGE_HEADER        FormPkgHdr;
+  UINT8                         *IfrData;
+  LIST_ENTRY                    IfrEntry;
+  HII_IFR_PROMPT_INDEX_ENTRY    *PromptIndex;          // built on first lookup, sorted by Prompt
+  UINTN                         PromptIndexCount;
 } HII_IFR_PACKAGE_INSTANCE;
 
 //
@@ -535,6 +571,38 @@ FindStringBlock (
   OUT EFI_STRING_ID                *StartStringId OPTIONAL
   );
 
+/**
+  Free the string id index of a string package. It must be called whenever
+  the string blocks or the MaxStringId of the package change.
+
+  @param  StringPackage           Hii string package instance.
+
+**/
+VOID
+InvalidateStringIndex (
+  IN HII_STRING_PACKAGE_INSTANCE  *StringPackage
+  );
+
+/**
+  Find the first string id of a string package whose text is String.
+
+  @param  StringPackage           Hii string package instance.
+  @param  String                  The string text to look for.
+  @param  StringId                The string id found.
+
+  @retval EFI_SUCCESS             The string was found.
+  @retval EFI_NOT_FOUND           No string id of the package has this text.
+  @retval EFI_UNSUPPORTED         The string blocks of the package could not be
+                                  indexed; the caller has to parse them.
+
+**/
+EFI_STATUS
+FindStringIdFromText (
+  IN  HII_STRING_PACKAGE_INSTANCE  *StringPackage,
+  IN  CONST CHAR16                 *String,
+  OUT EFI_STRING_ID                *StringId
+  );
+
 /**
   Parse all glyph blocks to find a glyph block specified by CharValue.
   If CharValue = (CHAR16) (-1), collect all default character cell information
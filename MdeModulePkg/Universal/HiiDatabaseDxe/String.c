@@ -225,6 +225,386 @@ GetStringFontInfo (
   return EFI_NOT_FOUND;
 }
 
+/**
+  Free the string id index of a string package. It must be called whenever
+  the string blocks or the MaxStringId of the package change.
+
+  @param  StringPackage           Hii string package instance.
+
+**/
+VOID
+InvalidateStringIndex (
+  IN HII_STRING_PACKAGE_INSTANCE  *StringPackage
+  )
+{
+  if (StringPackage->StringIndex != NULL) {
+    FreePool (StringPackage->StringIndex);
+    StringPackage->StringIndex = NULL;
+  }
+
+  if (StringPackage->StringHash != NULL) {
+    FreePool (StringPackage->StringHash);
+    StringPackage->StringHash     = NULL;
+    StringPackage->StringHashSize = 0;
+  }
+}
+
+/**
+  Parse all string blocks once to record where the string block and the
+  string text of each string id of the package are, so that looking up a
+  string does not need to parse the string blocks before it.
+
+  String ids of duplicate or skip blocks, and the ones after a string block
+  that is not known, are not indexed; FindStringBlock() still finds them by
+  parsing the string blocks. If memory runs out, no index is built.
+
+  @param  StringPackage           Hii string package instance.
+
+**/
+STATIC
+VOID
+BuildStringIndex (
+  IN HII_STRING_PACKAGE_INSTANCE  *StringPackage
+  )
+{
+  HII_STRING_INDEX_ENTRY   *StringIndex;
+  UINT8                    *BlockHdr;
+  UINT8                    *StringTextPtr;
+  EFI_STRING_ID            CurrentStringId;
+  UINTN                    Index;
+  UINTN                    StringSize;
+  UINT16                   StringCount;
+  UINT16                   SkipCount;
+  UINT8                    Length8;
+  UINT32                   Length32;
+  EFI_HII_SIBT_EXT2_BLOCK  Ext2;
+  BOOLEAN                  Scsu;
+
+  ASSERT (StringPackage->StringIndex == NULL);
+
+  StringIndex = AllocatePool (((UINTN)StringPackage->MaxStringId + 1) * sizeof (HII_STRING_INDEX_ENTRY));
+  if (StringIndex == NULL) {
+    return;
+  }
+
+  SetMem (StringIndex, ((UINTN)StringPackage->MaxStringId + 1) * sizeof (HII_STRING_INDEX_ENTRY), 0xFF);
+  StringPackage->StringIndex = StringIndex;
+
+  CurrentStringId = 1;
+  BlockHdr        = StringPackage->StringBlock;
+  while (*BlockHdr != EFI_HII_SIBT_END) {
+    StringCount = 1;
+    Scsu        = FALSE;
+    switch (*BlockHdr) {
+      case EFI_HII_SIBT_STRING_SCSU:
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_STRING_BLOCK);
+        Scsu          = TRUE;
+        break;
+
+      case EFI_HII_SIBT_STRING_SCSU_FONT:
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRING_SCSU_FONT_BLOCK) - sizeof (UINT8);
+        Scsu          = TRUE;
+        break;
+
+      case EFI_HII_SIBT_STRINGS_SCSU:
+        CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK), sizeof (UINT16));
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRINGS_SCSU_BLOCK) - sizeof (UINT8);
+        Scsu          = TRUE;
+        break;
+
+      case EFI_HII_SIBT_STRINGS_SCSU_FONT:
+        CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT16));
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRINGS_SCSU_FONT_BLOCK) - sizeof (UINT8);
+        Scsu          = TRUE;
+        break;
+
+      case EFI_HII_SIBT_STRING_UCS2:
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_STRING_BLOCK);
+        break;
+
+      case EFI_HII_SIBT_STRING_UCS2_FONT:
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRING_UCS2_FONT_BLOCK) - sizeof (CHAR16);
+        break;
+
+      case EFI_HII_SIBT_STRINGS_UCS2:
+        CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK), sizeof (UINT16));
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRINGS_UCS2_BLOCK) - sizeof (CHAR16);
+        break;
+
+      case EFI_HII_SIBT_STRINGS_UCS2_FONT:
+        CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT16));
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRINGS_UCS2_FONT_BLOCK) - sizeof (CHAR16);
+        break;
+
+      case EFI_HII_SIBT_DUPLICATE:
+        BlockHdr += sizeof (EFI_HII_SIBT_DUPLICATE_BLOCK);
+        CurrentStringId++;
+        continue;
+
+      case EFI_HII_SIBT_SKIP1:
+        SkipCount       = (UINT16)(*(BlockHdr + sizeof (EFI_HII_STRING_BLOCK)));
+        CurrentStringId = (UINT16)(CurrentStringId + SkipCount);
+        BlockHdr       += sizeof (EFI_HII_SIBT_SKIP1_BLOCK);
+        continue;
+
+      case EFI_HII_SIBT_SKIP2:
+        CopyMem (&SkipCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK), sizeof (UINT16));
+        CurrentStringId = (UINT16)(CurrentStringId + SkipCount);
+        BlockHdr       += sizeof (EFI_HII_SIBT_SKIP2_BLOCK);
+        continue;
+
+      case EFI_HII_SIBT_EXT1:
+        CopyMem (&Length8, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT8));
+        BlockHdr += Length8;
+        continue;
+
+      case EFI_HII_SIBT_EXT2:
+        CopyMem (&Ext2, BlockHdr, sizeof (EFI_HII_SIBT_EXT2_BLOCK));
+        BlockHdr += Ext2.Length;
+        continue;
+
+      case EFI_HII_SIBT_EXT4:
+        CopyMem (&Length32, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT32));
+        BlockHdr += Length32;
+        continue;
+
+      default:
+        return;
+    }
+
+    for (Index = 0; Index < StringCount; Index++) {
+      if ((CurrentStringId <= StringPackage->MaxStringId) &&
+          (StringIndex[CurrentStringId].BlockOffset == HII_STRING_INDEX_NOT_INDEXED))
+      {
+        StringIndex[CurrentStringId].BlockOffset = (UINT32)(BlockHdr - StringPackage->StringBlock);
+        StringIndex[CurrentStringId].TextOffset  = (UINT32)(StringTextPtr - BlockHdr);
+      }
+
+      if (Scsu) {
+        StringSize = AsciiStrSize ((CHAR8 *)StringTextPtr);
+      } else {
+        GetUnicodeStringTextOrSize (NULL, StringTextPtr, &StringSize);
+      }
+
+      StringTextPtr += StringSize;
+      CurrentStringId++;
+    }
+
+    BlockHdr = StringTextPtr;
+  }
+}
+
+/**
+  Get the text of a string id found in the index of its string package.
+
+  @param  StringPackage           Hii string package instance.
+  @param  StringId                An indexed string id of the package.
+  @param  Ascii                   Return TRUE for a SCSU string text, FALSE for
+                                  a UCS2 one.
+
+  @return The string text, which may not be aligned.
+
+**/
+STATIC
+UINT8 *
+GetIndexedStringText (
+  IN  HII_STRING_PACKAGE_INSTANCE  *StringPackage,
+  IN  EFI_STRING_ID                StringId,
+  OUT BOOLEAN                      *Ascii
+  )
+{
+  UINT8  *BlockHdr;
+
+  BlockHdr = StringPackage->StringBlock + StringPackage->StringIndex[StringId].BlockOffset;
+  *Ascii   = (BOOLEAN)((*BlockHdr == EFI_HII_SIBT_STRING_SCSU) ||
+                       (*BlockHdr == EFI_HII_SIBT_STRING_SCSU_FONT) ||
+                       (*BlockHdr == EFI_HII_SIBT_STRINGS_SCSU) ||
+                       (*BlockHdr == EFI_HII_SIBT_STRINGS_SCSU_FONT));
+
+  return BlockHdr + StringPackage->StringIndex[StringId].TextOffset;
+}
+
+/**
+  Hash a string text. SCSU and UCS2 texts of the same characters have the
+  same hash.
+
+  @param  Text                    The string text, which may not be aligned.
+  @param  Ascii                   TRUE for a SCSU string text, FALSE for a UCS2
+                                  one.
+
+  @return The hash of the string text.
+
+**/
+STATIC
+UINT32
+HashStringText (
+  IN CONST UINT8  *Text,
+  IN BOOLEAN      Ascii
+  )
+{
+  UINT32  Hash;
+  CHAR16  Char;
+
+  //
+  // FNV-1a of the characters.
+  //
+  Hash = 0x811C9DC5;
+  while (TRUE) {
+    Char = Ascii ? *Text : ReadUnaligned16 ((UINT16 *)Text);
+    if (Char == 0) {
+      break;
+    }
+
+    Hash  = (Hash ^ Char) * 0x01000193;
+    Text += Ascii ? sizeof (CHAR8) : sizeof (CHAR16);
+  }
+
+  return Hash;
+}
+
+/**
+  Build the hash table of the string texts of a string package, from the
+  index of its string ids.
+
+  @param  StringPackage           Hii string package instance.
+
+**/
+STATIC
+VOID
+BuildStringHash (
+  IN HII_STRING_PACKAGE_INSTANCE  *StringPackage
+  )
+{
+  HII_STRING_HASH_ENTRY  *StringHash;
+  UINTN                  Count;
+  UINTN                  Size;
+  UINTN                  Slot;
+  UINT32                 Hash;
+  UINT8                  *Text;
+  BOOLEAN                Ascii;
+  EFI_STRING_ID          StringId;
+
+  ASSERT (StringPackage->StringHash == NULL);
+
+  if (StringPackage->StringIndex == NULL) {
+    BuildStringIndex (StringPackage);
+    if (StringPackage->StringIndex == NULL) {
+      return;
+    }
+  }
+
+  Count = 0;
+  for (StringId = 1; StringId <= StringPackage->MaxStringId && StringId != 0; StringId++) {
+    if (StringPackage->StringIndex[StringId].BlockOffset != HII_STRING_INDEX_NOT_INDEXED) {
+      Count++;
+    }
+  }
+
+  //
+  // Keep the table at most half full, so that probing stays short.
+  //
+  Size = 1;
+  while (Size < Count * 2) {
+    Size <<= 1;
+  }
+
+  StringHash = AllocateZeroPool (Size * sizeof (HII_STRING_HASH_ENTRY));
+  if (StringHash == NULL) {
+    return;
+  }
+
+  for (StringId = 1; StringId <= StringPackage->MaxStringId && StringId != 0; StringId++) {
+    if (StringPackage->StringIndex[StringId].BlockOffset == HII_STRING_INDEX_NOT_INDEXED) {
+      continue;
+    }
+
+    Text = GetIndexedStringText (StringPackage, StringId, &Ascii);
+    Hash = HashStringText (Text, Ascii);
+    Slot = Hash & (Size - 1);
+    while (StringHash[Slot].StringId != 0) {
+      Slot = (Slot + 1) & (Size - 1);
+    }
+
+    StringHash[Slot].Hash     = Hash;
+    StringHash[Slot].StringId = StringId;
+  }
+
+  StringPackage->StringHash     = StringHash;
+  StringPackage->StringHashSize = Size;
+}
+
+/**
+  Find the first string id of a string package whose text is String.
+
+  @param  StringPackage           Hii string package instance.
+  @param  String                  The string text to look for.
+  @param  StringId                The string id found.
+
+  @retval EFI_SUCCESS             The string was found.
+  @retval EFI_NOT_FOUND           No string id of the package has this text.
+  @retval EFI_UNSUPPORTED         The string blocks of the package could not be
+                                  indexed; the caller has to parse them.
+
+**/
+EFI_STATUS
+FindStringIdFromText (
+  IN  HII_STRING_PACKAGE_INSTANCE  *StringPackage,
+  IN  CONST CHAR16                 *String,
+  OUT EFI_STRING_ID                *StringId
+  )
+{
+  UINTN          Slot;
+  UINT32         Hash;
+  UINT8          *Text;
+  BOOLEAN        Ascii;
+  UINTN          Index;
+  CHAR16         Char;
+  EFI_STRING_ID  Found;
+
+  ASSERT (StringPackage != NULL && String != NULL && StringId != NULL);
+
+  if (StringPackage->StringHash == NULL) {
+    BuildStringHash (StringPackage);
+    if (StringPackage->StringHash == NULL) {
+      return EFI_UNSUPPORTED;
+    }
+  }
+
+  //
+  // The string blocks are parsed in string id order, so the first match is
+  // the one with the lowest string id.
+  //
+  Found = 0;
+  Hash  = HashStringText ((CONST UINT8 *)String, FALSE);
+  Slot  = Hash & (StringPackage->StringHashSize - 1);
+  while (StringPackage->StringHash[Slot].StringId != 0) {
+    if ((StringPackage->StringHash[Slot].Hash == Hash) &&
+        ((Found == 0) || (StringPackage->StringHash[Slot].StringId < Found)))
+    {
+      Text = GetIndexedStringText (StringPackage, StringPackage->StringHash[Slot].StringId, &Ascii);
+      for (Index = 0; ; Index++) {
+        Char = Ascii ? Text[Index] : ReadUnaligned16 ((UINT16 *)Text + Index);
+        if ((Char != String[Index]) || (Char == 0)) {
+          break;
+        }
+      }
+
+      if (Char == String[Index]) {
+        Found = StringPackage->StringHash[Slot].StringId;
+      }
+    }
+
+    Slot = (Slot + 1) & (StringPackage->StringHashSize - 1);
+  }
+
+  if (Found == 0) {
+    return EFI_NOT_FOUND;
+  }
+
+  *StringId = Found;
+  return EFI_SUCCESS;
+}
+
 /**
   Parse all string blocks to find a String block specified by StringId.
   If StringId = (EFI_STRING_ID) (-1), find out all EFI_HII_SIBT_FONT blocks
@@ -295,6 +675,25 @@ FindStringBlock (
     if (StringId > StringPackage->MaxStringId) {
       return EFI_NOT_FOUND;
     }
+
+    //
+    // Look the string up in the index of the package. The first id of a skip
+    // block, output in StartStringId, is only known by parsing.
+    //
+    if (StartStringId == NULL) {
+      if (StringPackage->StringIndex == NULL) {
+        BuildStringIndex (StringPackage);
+      }
+
+      if ((StringPackage->StringIndex != NULL) &&
+          (StringPackage->StringIndex[StringId].BlockOffset != HII_STRING_INDEX_NOT_INDEXED))
+      {
+        *StringBlockAddr  = StringPackage->StringBlock + StringPackage->StringIndex[StringId].BlockOffset;
+        *BlockType        = **StringBlockAddr;
+        *StringTextOffset = StringPackage->StringIndex[StringId].TextOffset;
+        return EFI_SUCCESS;
+      }
+    }
   } else {
     ASSERT (Private != NULL && Private->Signature == HII_DATABASE_PRIVATE_DATA_SIGNATURE);
     if ((StringId == 0) && (LastStringId != NULL)) {
@@ -853,6 +1252,7 @@ InsertLackStringBlock (
     *BlockType = EFI_HII_SIBT_STRING_UCS2;
   }
 
+  InvalidateStringIndex (StringPackage);
   FreePool (StringPackage->StringBlock);
   StringPackage->StringBlock                  = StringBlock;
   StringPackage->StringPkgHdr->Header.Length += NewBlockSize - OldBlockSize;
@@ -1024,6 +1424,7 @@ SetStringWorker (
         );
 
       ZeroMem (StringPackage->StringBlock, OldBlockSize);
+      InvalidateStringIndex (StringPackage);
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock                  = Block;
       StringPackage->StringPkgHdr->Header.Length += (UINT32)(BlockSize - OldBlockSize);
@@ -1058,6 +1459,7 @@ SetStringWorker (
         );
 
       ZeroMem (StringPackage->StringBlock, OldBlockSize);
+      InvalidateStringIndex (StringPackage);
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock                  = Block;
       StringPackage->StringPkgHdr->Header.Length += (UINT32)(BlockSize - OldBlockSize);
@@ -1110,6 +1512,7 @@ SetStringWorker (
   CopyMem (BlockPtr, StringPackage->StringBlock, OldBlockSize);
 
   ZeroMem (StringPackage->StringBlock, OldBlockSize);
+  InvalidateStringIndex (StringPackage);
   FreePool (StringPackage->StringBlock);
   StringPackage->StringBlock                  = Block;
   StringPackage->StringPkgHdr->Header.Length += Ext2.Length;
@@ -1298,6 +1701,7 @@ HiiNewString (
       //
       *BlockPtr = EFI_HII_SIBT_END;
       ZeroMem (StringPackage->StringBlock, OldBlockSize);
+      InvalidateStringIndex (StringPackage);
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock                     = StringBlock;
       StringPackage->StringPkgHdr->Header.Length    += Ucs2BlockSize;
@@ -1434,6 +1838,7 @@ HiiNewString (
     //
     *BlockPtr = EFI_HII_SIBT_END;
     ZeroMem (StringPackage->StringBlock, OldBlockSize);
+    InvalidateStringIndex (StringPackage);
     FreePool (StringPackage->StringBlock);
     StringPackage->StringBlock                     = StringBlock;
     StringPackage->StringPkgHdr->Header.Length    += Ucs2BlockSize;
@@ -1477,6 +1882,7 @@ HiiNewString (
       //
       *BlockPtr = EFI_HII_SIBT_END;
       ZeroMem (StringPackage->StringBlock, OldBlockSize);
+      InvalidateStringIndex (StringPackage);
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock                     = StringBlock;
       StringPackage->StringPkgHdr->Header.Length    += Ucs2FontBlockSize;
@@ -1539,6 +1945,7 @@ HiiNewString (
       //
       *BlockPtr = EFI_HII_SIBT_END;
       ZeroMem (StringPackage->StringBlock, OldBlockSize);
+      InvalidateStringIndex (StringPackage);
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock                     = StringBlock;
       StringPackage->StringPkgHdr->Header.Length    += FontBlockSize + Ucs2FontBlockSize;
@@ -1577,12 +1984,14 @@ Done:
     {
       StringPackage              = CR (Link, HII_STRING_PACKAGE_INSTANCE, StringEntry, HII_STRING_PACKAGE_SIGNATURE);
       StringPackage->MaxStringId = *StringId;
+      InvalidateStringIndex (StringPackage);
     }
   } else if (NewStringPackageCreated) {
     //
     // Free the allocated new string Package when new string can't be added.
     //
     RemoveEntryList (&StringPackage->StringEntry);
+    InvalidateStringIndex (StringPackage);
     FreePool (StringPackage->StringBlock);
     FreePool (StringPackage->StringPkgHdr);
     FreePool (StringPackage);
@@ -2074,42 +2483,21 @@ HiiCompareLanguage (
   )
 {
   UINTN  Index;
-  UINTN  StrLen;
-  CHAR8  *Lan1;
-  CHAR8  *Lan2;
-
-  //
-  // Convert to lower to compare.
-  //
-  StrLen = AsciiStrSize (Language1);
-  Lan1   = AllocateZeroPool (StrLen);
-  ASSERT (Lan1 != NULL);
-  AsciiStrCpyS (Lan1, StrLen / sizeof (CHAR8), Language1);
-  AsciiHiiToLower (Lan1);
-
-  StrLen = AsciiStrSize (Language2);
-  Lan2   = AllocateZeroPool (StrLen);
-  ASSERT (Lan2 != NULL);
-  AsciiStrCpyS (Lan2, StrLen / sizeof (CHAR8), Language2);
-  AsciiHiiToLower (Lan2);
 
   //
-  // Compare the Primary Language in Language1 to Language2
+  // Compare the Primary Language in Language1 to Language2, ignoring the case.
+  // It is called for every string package of every lookup, so the characters
+  // are compared in place rather than on lower case copies of the names.
   //
-  for (Index = 0; Lan1[Index] != 0 && Lan1[Index] != ';'; Index++) {
-    if (Lan1[Index] != Lan2[Index]) {
+  for (Index = 0; Language1[Index] != 0 && Language1[Index] != ';'; Index++) {
+    if (AsciiCharToUpper (Language1[Index]) != AsciiCharToUpper (Language2[Index])) {
       //
       // Return FALSE if any characters are different.
       //
-      FreePool (Lan1);
-      FreePool (Lan2);
       return FALSE;
     }
   }
 
-  FreePool (Lan1);
-  FreePool (Lan2);
-
   //
   // Only return TRUE if Language2[Index] is a Null-terminator which means
   // the Primary Language in Language1 is the same length as Language2.  If
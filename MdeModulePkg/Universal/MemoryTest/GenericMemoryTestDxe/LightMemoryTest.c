@@ -361,6 +361,49 @@ WriteMemory (
   return EFI_SUCCESS;
 }
 
+/**
+  Report an uncorrectable memory error found by the memory test.
+
+  @param[in] Address  The address the error was found at.
+
+  @retval EFI_SUCCESS           The error was reported.
+  @retval EFI_OUT_OF_RESOURCES  The status code data could not be allocated.
+
+**/
+EFI_STATUS
+ReportMemoryTestError (
+  IN  EFI_PHYSICAL_ADDRESS  Address
+  )
+{
+  EFI_MEMORY_EXTENDED_ERROR_DATA  *ExtendedErrorData;
+
+  ExtendedErrorData = AllocateZeroPool (sizeof (EFI_MEMORY_EXTENDED_ERROR_DATA));
+  if (ExtendedErrorData == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  ExtendedErrorData->DataHeader.HeaderSize = (UINT16)sizeof (EFI_STATUS_CODE_DATA);
+  ExtendedErrorData->DataHeader.Size       = (UINT16)(sizeof (EFI_MEMORY_EXTENDED_ERROR_DATA) - sizeof (EFI_STATUS_CODE_DATA));
+  ExtendedErrorData->Granularity           = EFI_MEMORY_ERROR_DEVICE;
+  ExtendedErrorData->Operation             = EFI_MEMORY_OPERATION_READ;
+  ExtendedErrorData->Syndrome              = 0x0;
+  ExtendedErrorData->Address               = Address;
+  ExtendedErrorData->Resolution            = 0x40;
+
+  REPORT_STATUS_CODE_EX (
+    EFI_ERROR_CODE,
+    EFI_COMPUTING_UNIT_MEMORY | EFI_CU_MEMORY_EC_UNCORRECTABLE,
+    0,
+    &gEfiGenericMemTestProtocolGuid,
+    NULL,
+    (UINT8 *)ExtendedErrorData + sizeof (EFI_STATUS_CODE_DATA),
+    ExtendedErrorData->DataHeader.Size
+    );
+
+  FreePool (ExtendedErrorData);
+  return EFI_SUCCESS;
+}
+
 /**
   Verify the range of physical memory which covered by memory test pattern.
 
@@ -382,12 +425,10 @@ VerifyMemory (
   IN  UINT64                       Size
   )
 {
-  EFI_PHYSICAL_ADDRESS            Address;
-  INTN                            ErrorFound;
-  EFI_MEMORY_EXTENDED_ERROR_DATA  *ExtendedErrorData;
+  EFI_PHYSICAL_ADDRESS  Address;
+  INTN                  ErrorFound;
 
-  Address           = Start;
-  ExtendedErrorData = NULL;
+  Address = Start;
 
   //
   // Add 4G memory address check for IA32 platform
@@ -412,29 +453,10 @@ VerifyMemory (
       //
       // Report uncorrectable errors
       //
-      ExtendedErrorData = AllocateZeroPool (sizeof (EFI_MEMORY_EXTENDED_ERROR_DATA));
-      if (ExtendedErrorData == NULL) {
+      if (EFI_ERROR (ReportMemoryTestError (Address))) {
         return EFI_OUT_OF_RESOURCES;
       }
 
-      ExtendedErrorData->DataHeader.HeaderSize = (UINT16)sizeof (EFI_STATUS_CODE_DATA);
-      ExtendedErrorData->DataHeader.Size       = (UINT16)(sizeof (EFI_MEMORY_EXTENDED_ERROR_DATA) - sizeof (EFI_STATUS_CODE_DATA));
-      ExtendedErrorData->Granularity           = EFI_MEMORY_ERROR_DEVICE;
-      ExtendedErrorData->Operation             = EFI_MEMORY_OPERATION_READ;
-      ExtendedErrorData->Syndrome              = 0x0;
-      ExtendedErrorData->Address               = Address;
-      ExtendedErrorData->Resolution            = 0x40;
-
-      REPORT_STATUS_CODE_EX (
-        EFI_ERROR_CODE,
-        EFI_COMPUTING_UNIT_MEMORY | EFI_CU_MEMORY_EC_UNCORRECTABLE,
-        0,
-        &gEfiGenericMemTestProtocolGuid,
-        NULL,
-        (UINT8 *)ExtendedErrorData + sizeof (EFI_STATUS_CODE_DATA),
-        ExtendedErrorData->DataHeader.Size
-        );
-
       return EFI_DEVICE_ERROR;
     }
 
@@ -522,6 +544,10 @@ InitializeMemoryTest (
       break;
   }
 
+  if (FeaturePcdGet (PcdGenericMemoryTestParallel)) {
+    InitializeParallelMemoryTest (Private);
+  }
+
   //
   // This is the first time we construct the non-tested memory range, if no
   // extended memory found, we know the system have not any extended memory
@@ -618,12 +644,23 @@ GenPerformMemoryTest (
         );
 
       //
-      // The software memory test (R/W/V) perform here. It will detect the
-      // memory mis-compare error.
+      // The parallel test records the bad pages and goes on with the test.
       //
-      WriteMemory (Private, mCurrentAddress, BlockBoundary);
+      Status = EFI_UNSUPPORTED;
+      if (FeaturePcdGet (PcdGenericMemoryTestParallel)) {
+        Status = ParallelRangeTest (Private, mCurrentAddress, BlockBoundary, ErrorOut);
+      }
+
+      if (Status == EFI_UNSUPPORTED) {
+        //
+        // The software memory test (R/W/V) perform here. It will detect the
+        // memory mis-compare error.
+        //
+        WriteMemory (Private, mCurrentAddress, BlockBoundary);
+
+        Status = VerifyMemory (Private, mCurrentAddress, BlockBoundary);
+      }
 
-      Status = VerifyMemory (Private, mCurrentAddress, BlockBoundary);
       if (EFI_ERROR (Status)) {
         //
         // If perform here, means there is mis-compare error, and no agent can
@@ -702,6 +739,10 @@ GenMemoryTestFinished (
   //
   UpdateMemoryMap (Private);
 
+  if (FeaturePcdGet (PcdGenericMemoryTestParallel)) {
+    FinishParallelMemoryTest ();
+  }
+
   //
   // we need to free all the memory allocate
   //
@@ -13,6 +13,7 @@
 #include <Guid/StatusCodeDataTypeId.h>
 #include <Protocol/GenericMemoryTest.h>
 #include <Protocol/Cpu.h>
+#include <Protocol/MpService.h>
 
 #include <Library/DebugLib.h>
 #include <Library/UefiDriverEntryPoint.h>
@@ -23,6 +24,10 @@
 #include <Library/BaseMemoryLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/UefiBootServicesTableLib.h>
+#include <Library/PcdLib.h>
+#include <Library/TimerLib.h>
+#include <Library/SynchronizationLib.h>
+#include <Library/CacheMaintenanceLib.h>
 
 //
 // Some global define
@@ -43,6 +48,21 @@
 #define QUICK_SPAN_SIZE   (TEST_BLOCK_SIZE >> 2)
 #define SPARSE_SPAN_SIZE  (TEST_BLOCK_SIZE >> 4)
 
+//
+// In the parallel test every processor takes TEST_BLOCK_SIZE slices of the
+// block under test until none is left. A block holds
+// PARALLEL_TEST_SLICES_PER_CPU slices per processor, so that a slow processor
+// does not hold the others back. Up to PARALLEL_TEST_MAX_SLICE_ERRORS bad
+// pages are recorded per slice; the whole slice is reported bad beyond that.
+//
+#define PARALLEL_TEST_SLICES_PER_CPU    4
+#define PARALLEL_TEST_MAX_SLICE_ERRORS  16
+
+//
+// GenericMemoryTestMonoPattern read as one UINT64
+//
+#define PARALLEL_TEST_PATTERN  0xa5a5a5a55a5a5a5aULL
+
 //
 // This structure records every nontested memory range parsed through GCD
 // service.
@@ -118,6 +138,34 @@ typedef struct {
   EFI_GENERIC_MEMORY_TEST_PRIVATE_SIGNATURE \
   )
 
+//
+// One slice of the block tested in parallel, and the bad pages found in it.
+// ErrorCount is above PARALLEL_TEST_MAX_SLICE_ERRORS if the whole slice is bad.
+//
+typedef struct {
+  EFI_PHYSICAL_ADDRESS    Start;
+  UINT64                  Length;
+  UINTN                   ErrorCount;
+  EFI_PHYSICAL_ADDRESS    ErrorPage[PARALLEL_TEST_MAX_SLICE_ERRORS];
+} PARALLEL_TEST_SLICE;
+
+typedef struct {
+  GENERIC_MEMORY_TEST_PRIVATE    *Private;
+  PARALLEL_TEST_SLICE            *Slices;
+  UINT32                         SliceCount;
+  volatile UINT32                NextSlice;
+} PARALLEL_TEST_CONTEXT;
+
+//
+// A memory range found bad by the parallel test
+//
+typedef struct {
+  EFI_PHYSICAL_ADDRESS    Start;
+  UINT64                  Length;
+} PARALLEL_TEST_BAD_RANGE;
+
+extern UINT32  GenericMemoryTestMonoPattern[GENERIC_CACHELINE_SIZE / 4];
+
 //
 // Function Prototypes
 //
@@ -252,6 +300,71 @@ DirectRangeTest (
   IN  UINT64                       Capabilities
   );
 
+/**
+  Report an uncorrectable memory error found by the memory test.
+
+  @param[in] Address  The address the error was found at.
+
+  @retval EFI_SUCCESS           The error was reported.
+  @retval EFI_OUT_OF_RESOURCES  The status code data could not be allocated.
+
+**/
+EFI_STATUS
+ReportMemoryTestError (
+  IN  EFI_PHYSICAL_ADDRESS  Address
+  );
+
+/**
+  Prepare the parallel memory test if PcdGenericMemoryTestParallel is set.
+
+  The block size of the test is grown so that all processors are kept busy.
+  The test stays on the BSP if the MP services are not available.
+
+  @param[in] Private  Point to generic memory test driver's private data.
+
+**/
+VOID
+InitializeParallelMemoryTest (
+  IN  GENERIC_MEMORY_TEST_PRIVATE  *Private
+  );
+
+/**
+  Test a range of memory on all processors.
+
+  Bad pages are reported and recorded, they are marked unusable once the
+  tested memory is added to the memory map, so a bad page does not stop the
+  memory test.
+
+  @param[in]  Private   Point to generic memory test driver's private data.
+  @param[in]  Start     The memory range's start address.
+  @param[in]  Size      The memory range's size.
+  @param[out] ErrorOut  TRUE if bad pages were found in the range.
+
+  @retval EFI_SUCCESS      The range was tested.
+  @retval EFI_UNSUPPORTED  The parallel test is not enabled, the range has to
+                           be tested with WriteMemory() and VerifyMemory().
+
+**/
+EFI_STATUS
+ParallelRangeTest (
+  IN  GENERIC_MEMORY_TEST_PRIVATE  *Private,
+  IN  EFI_PHYSICAL_ADDRESS         Start,
+  IN  UINT64                       Size,
+  OUT BOOLEAN                      *ErrorOut
+  );
+
+/**
+  Mark the bad ranges found by the parallel test as unusable memory, report
+  the throughput of the test and free its resources.
+
+  It must be called after the tested memory was added to the memory map.
+
+**/
+VOID
+FinishParallelMemoryTest (
+  VOID
+  );
+
 /**
   Initialize the generic memory test.
 
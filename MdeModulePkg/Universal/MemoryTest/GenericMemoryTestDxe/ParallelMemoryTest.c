@@ -0,0 +1,412 @@
+/** @file
+  Parallel version of the R/W/V memory test.
+
+  The block under test is cut into TEST_BLOCK_SIZE slices that the BSP and the
+  APs take one by one. The processors only touch the memory under test and
+  their own slice descriptor, the bad pages are reported and recorded by the
+  BSP once the whole block is tested. The recorded ranges are allocated as
+  EfiUnusableMemory at the end of the test, so that no bad page is handed out
+  while the rest of the memory is still usable.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "LightMemoryTest.h"
+
+EFI_MP_SERVICES_PROTOCOL  *mMpService;
+EFI_EVENT                 mParallelTestEvent;
+PARALLEL_TEST_CONTEXT     mParallelTest;
+UINTN                     mParallelTestMaxSlices;
+UINTN                     mParallelTestCpuCount;
+UINT64                    mParallelTestBytes;
+UINT64                    mParallelTestTime;
+
+PARALLEL_TEST_BAD_RANGE  *mBadRanges;
+UINTN                    mBadRangeCount;
+UINTN                    mBadRangeMax;
+
+/**
+  Record a bad page of a slice.
+
+  @param[in, out] Slice    The slice the page belongs to.
+  @param[in]      Address  The address the error was found at.
+
+  @retval TRUE   The page was recorded.
+  @retval FALSE  The slice has too many bad pages, it is bad as a whole.
+
+**/
+STATIC
+BOOLEAN
+RecordSliceError (
+  IN OUT PARALLEL_TEST_SLICE  *Slice,
+  IN     EFI_PHYSICAL_ADDRESS  Address
+  )
+{
+  if (Slice->ErrorCount == PARALLEL_TEST_MAX_SLICE_ERRORS) {
+    Slice->ErrorCount++;
+    return FALSE;
+  }
+
+  Slice->ErrorPage[Slice->ErrorCount++] = Address & ~(EFI_PHYSICAL_ADDRESS)EFI_PAGE_MASK;
+  return TRUE;
+}
+
+/**
+  Write and verify the memory test pattern in a slice.
+
+  It runs on the BSP and on the APs, so it must not call any boot service.
+
+  @param[in]      Private  Point to generic memory test driver's private data.
+  @param[in, out] Slice    The slice to test.
+
+**/
+STATIC
+VOID
+TestSlice (
+  IN     GENERIC_MEMORY_TEST_PRIVATE  *Private,
+  IN OUT PARALLEL_TEST_SLICE          *Slice
+  )
+{
+  EFI_PHYSICAL_ADDRESS  Address;
+  EFI_PHYSICAL_ADDRESS  End;
+  volatile UINT64       *Pointer;
+
+  Slice->ErrorCount = 0;
+  End               = Slice->Start + Slice->Length;
+
+  //
+  // Add 4G memory address check for IA32 platform
+  // NOTE: Without page table, there is no way to use memory above 4G.
+  //
+  if (End > MAX_ADDRESS) {
+    return;
+  }
+
+  if (Private->CoverageSpan == GENERIC_CACHELINE_SIZE) {
+    //
+    // Every byte is covered, fill the whole slice at once. The BaseMemoryLib
+    // instances for processors with SIMD support use non-temporal stores for
+    // large buffers, so the pattern does not go through the caches.
+    //
+    SetMem64 ((VOID *)(UINTN)Slice->Start, (UINTN)Slice->Length, PARALLEL_TEST_PATTERN);
+  } else {
+    for (Address = Slice->Start; Address < End; Address += Private->CoverageSpan) {
+      CopyMem ((VOID *)(UINTN)Address, Private->MonoPattern, Private->MonoTestSize);
+    }
+  }
+
+  WriteBackInvalidateDataCacheRange ((VOID *)(UINTN)Slice->Start, (UINTN)Slice->Length);
+
+  if (Private->CoverageSpan == GENERIC_CACHELINE_SIZE) {
+    Pointer = (volatile UINT64 *)(UINTN)Slice->Start;
+    while ((UINTN)Pointer < End) {
+      if (*Pointer == PARALLEL_TEST_PATTERN) {
+        Pointer++;
+        continue;
+      }
+
+      if (!RecordSliceError (Slice, (UINTN)Pointer)) {
+        return;
+      }
+
+      //
+      // Go on with the next page
+      //
+      Pointer = (volatile UINT64 *)(((UINTN)Pointer & ~(UINTN)EFI_PAGE_MASK) + EFI_PAGE_SIZE);
+    }
+  } else {
+    for (Address = Slice->Start; Address < End; Address += Private->CoverageSpan) {
+      if (CompareMem ((VOID *)(UINTN)Address, Private->MonoPattern, Private->MonoTestSize) != 0) {
+        if (!RecordSliceError (Slice, Address)) {
+          return;
+        }
+      }
+    }
+  }
+}
+
+/**
+  Test slices of the current block until none is left.
+
+  @param[in] Buffer  Pointer to the PARALLEL_TEST_CONTEXT.
+
+**/
+STATIC
+VOID
+EFIAPI
+ParallelTestProcedure (
+  IN VOID  *Buffer
+  )
+{
+  PARALLEL_TEST_CONTEXT  *Context;
+  UINT32                 Index;
+
+  Context = (PARALLEL_TEST_CONTEXT *)Buffer;
+  while (TRUE) {
+    Index = InterlockedIncrement (&Context->NextSlice) - 1;
+    if (Index >= Context->SliceCount) {
+      break;
+    }
+
+    TestSlice (Context->Private, &Context->Slices[Index]);
+  }
+}
+
+/**
+  Add a range to the bad memory ranges.
+
+  @param[in] Start   The start address of the range.
+  @param[in] Length  The length of the range.
+
+**/
+STATIC
+VOID
+AddBadRange (
+  IN EFI_PHYSICAL_ADDRESS  Start,
+  IN UINT64                Length
+  )
+{
+  PARALLEL_TEST_BAD_RANGE  *Ranges;
+
+  if ((mBadRangeCount != 0) &&
+      (mBadRanges[mBadRangeCount - 1].Start + mBadRanges[mBadRangeCount - 1].Length == Start))
+  {
+    mBadRanges[mBadRangeCount - 1].Length += Length;
+    return;
+  }
+
+  if (mBadRangeCount == mBadRangeMax) {
+    Ranges = ReallocatePool (
+               mBadRangeMax * sizeof (PARALLEL_TEST_BAD_RANGE),
+               (mBadRangeMax + 64) * sizeof (PARALLEL_TEST_BAD_RANGE),
+               mBadRanges
+               );
+    if (Ranges == NULL) {
+      DEBUG ((DEBUG_ERROR, "%a: Bad range 0x%lx-0x%lx can not be recorded\n", __func__, Start, Start + Length - 1));
+      return;
+    }
+
+    mBadRanges    = Ranges;
+    mBadRangeMax += 64;
+  }
+
+  mBadRanges[mBadRangeCount].Start  = Start;
+  mBadRanges[mBadRangeCount].Length = Length;
+  mBadRangeCount++;
+}
+
+/**
+  Prepare the parallel memory test if PcdGenericMemoryTestParallel is set.
+
+  The block size of the test is grown so that all processors are kept busy.
+  The test stays on the BSP if the MP services are not available.
+
+  @param[in] Private  Point to generic memory test driver's private data.
+
+**/
+VOID
+InitializeParallelMemoryTest (
+  IN  GENERIC_MEMORY_TEST_PRIVATE  *Private
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       NumberOfProcessors;
+  UINTN       NumberOfEnabledProcessors;
+
+  if (mParallelTest.Slices != NULL) {
+    FreePool (mParallelTest.Slices);
+    mParallelTest.Slices = NULL;
+  }
+
+  NumberOfEnabledProcessors = 1;
+  Status                    = gBS->LocateProtocol (&gEfiMpServiceProtocolGuid, NULL, (VOID **)&mMpService);
+  if (!EFI_ERROR (Status)) {
+    Status = mMpService->GetNumberOfProcessors (mMpService, &NumberOfProcessors, &NumberOfEnabledProcessors);
+    if (EFI_ERROR (Status)) {
+      NumberOfEnabledProcessors = 1;
+    }
+  } else {
+    mMpService = NULL;
+  }
+
+  if ((mMpService != NULL) && (mParallelTestEvent == NULL)) {
+    Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &mParallelTestEvent);
+    if (EFI_ERROR (Status)) {
+      mMpService = NULL;
+    }
+  }
+
+  mParallelTestMaxSlices = NumberOfEnabledProcessors * PARALLEL_TEST_SLICES_PER_CPU;
+  mParallelTest.Slices   = AllocateZeroPool (mParallelTestMaxSlices * sizeof (PARALLEL_TEST_SLICE));
+  if (mParallelTest.Slices == NULL) {
+    return;
+  }
+
+  mParallelTest.Private = Private;
+  mParallelTestCpuCount = NumberOfEnabledProcessors;
+  mParallelTestBytes    = 0;
+  mParallelTestTime     = 0;
+  Private->BdsBlockSize = MultU64x32 (TEST_BLOCK_SIZE, (UINT32)mParallelTestMaxSlices);
+
+  DEBUG ((DEBUG_INFO, "%a: Memory test on %d processors\n", __func__, NumberOfEnabledProcessors));
+}
+
+/**
+  Test a range of memory on all processors.
+
+  Bad pages are reported and recorded, they are marked unusable once the
+  tested memory is added to the memory map, so a bad page does not stop the
+  memory test.
+
+  @param[in]  Private   Point to generic memory test driver's private data.
+  @param[in]  Start     The memory range's start address.
+  @param[in]  Size      The memory range's size.
+  @param[out] ErrorOut  TRUE if bad pages were found in the range.
+
+  @retval EFI_SUCCESS      The range was tested.
+  @retval EFI_UNSUPPORTED  The parallel test is not enabled, the range has to
+                           be tested with WriteMemory() and VerifyMemory().
+
+**/
+EFI_STATUS
+ParallelRangeTest (
+  IN  GENERIC_MEMORY_TEST_PRIVATE  *Private,
+  IN  EFI_PHYSICAL_ADDRESS         Start,
+  IN  UINT64                       Size,
+  OUT BOOLEAN                      *ErrorOut
+  )
+{
+  EFI_STATUS            Status;
+  EFI_PHYSICAL_ADDRESS  Address;
+  PARALLEL_TEST_SLICE   *Slice;
+  UINT32                Index;
+  UINTN                 ErrorIndex;
+  UINT64                StartTime;
+
+  if (mParallelTest.Slices == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  mParallelTest.SliceCount = 0;
+  for (Address = Start; Address < Start + Size; Address += TEST_BLOCK_SIZE) {
+    ASSERT (mParallelTest.SliceCount < mParallelTestMaxSlices);
+    Slice         = &mParallelTest.Slices[mParallelTest.SliceCount++];
+    Slice->Start  = Address;
+    Slice->Length = MIN (TEST_BLOCK_SIZE, Start + Size - Address);
+  }
+
+  mParallelTest.NextSlice = 0;
+  StartTime               = GetPerformanceCounter ();
+
+  //
+  // The BSP takes its share of the slices while the APs run. If the APs can
+  // not be started, the BSP tests all the slices.
+  //
+  Status = EFI_NOT_STARTED;
+  if ((mMpService != NULL) && (mParallelTestCpuCount > 1)) {
+    Status = mMpService->StartupAllAPs (
+                           mMpService,
+                           ParallelTestProcedure,
+                           FALSE,
+                           mParallelTestEvent,
+                           0,
+                           &mParallelTest,
+                           NULL
+                           );
+  }
+
+  ParallelTestProcedure (&mParallelTest);
+
+  if (!EFI_ERROR (Status)) {
+    while (gBS->CheckEvent (mParallelTestEvent) == EFI_NOT_READY) {
+      CpuPause ();
+    }
+  }
+
+  mParallelTestTime  += GetTimeInNanoSecond (GetPerformanceCounter () - StartTime);
+  mParallelTestBytes += Size;
+
+  for (Index = 0; Index < mParallelTest.SliceCount; Index++) {
+    Slice = &mParallelTest.Slices[Index];
+    if (Slice->ErrorCount == 0) {
+      continue;
+    }
+
+    *ErrorOut = TRUE;
+    if (Slice->ErrorCount > PARALLEL_TEST_MAX_SLICE_ERRORS) {
+      DEBUG ((DEBUG_ERROR, "%a: Memory 0x%lx-0x%lx is bad\n", __func__, Slice->Start, Slice->Start + Slice->Length - 1));
+      ReportMemoryTestError (Slice->Start);
+      AddBadRange (Slice->Start, Slice->Length);
+      continue;
+    }
+
+    for (ErrorIndex = 0; ErrorIndex < Slice->ErrorCount; ErrorIndex++) {
+      DEBUG ((DEBUG_ERROR, "%a: Memory page 0x%lx is bad\n", __func__, Slice->ErrorPage[ErrorIndex]));
+      ReportMemoryTestError (Slice->ErrorPage[ErrorIndex]);
+      AddBadRange (Slice->ErrorPage[ErrorIndex], EFI_PAGE_SIZE);
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Mark the bad ranges found by the parallel test as unusable memory, report
+  the throughput of the test and free its resources.
+
+  It must be called after the tested memory was added to the memory map.
+
+**/
+VOID
+FinishParallelMemoryTest (
+  VOID
+  )
+{
+  EFI_STATUS            Status;
+  UINTN                 Index;
+  EFI_PHYSICAL_ADDRESS  Address;
+  UINT64                Milliseconds;
+
+  for (Index = 0; Index < mBadRangeCount; Index++) {
+    Address = mBadRanges[Index].Start;
+    Status  = gBS->AllocatePages (
+                     AllocateAddress,
+                     EfiUnusableMemory,
+                     EFI_SIZE_TO_PAGES ((UINTN)mBadRanges[Index].Length),
+                     &Address
+                     );
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "%a: Bad memory 0x%lx-0x%lx can not be reserved - %r\n", __func__, mBadRanges[Index].Start, mBadRanges[Index].Start + mBadRanges[Index].Length - 1, Status));
+    }
+  }
+
+  if (mParallelTestBytes != 0) {
+    Milliseconds = MAX (DivU64x32 (mParallelTestTime, 1000000), 1);
+    DEBUG ((
+      DEBUG_INFO,
+      "%a: Tested %ld MB in %ld ms (%ld MB/s) on %d processors, %d bad ranges\n",
+      __func__,
+      RShiftU64 (mParallelTestBytes, 20),
+      Milliseconds,
+      DivU64x64Remainder (MultU64x32 (RShiftU64 (mParallelTestBytes, 20), 1000), Milliseconds, NULL),
+      mParallelTestCpuCount,
+      mBadRangeCount
+      ));
+  }
+
+  if (mBadRanges != NULL) {
+    FreePool (mBadRanges);
+    mBadRanges = NULL;
+  }
+
+  mBadRangeCount = 0;
+  mBadRangeMax   = 0;
+
+  if (mParallelTest.Slices != NULL) {
+    FreePool (mParallelTest.Slices);
+    mParallelTest.Slices = NULL;
+  }
+}
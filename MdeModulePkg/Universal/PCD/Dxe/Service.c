@@ -25,6 +25,8 @@ UINT32  mDxeGuidTableSize;
 
 BOOLEAN  mPeiExMapTableEmpty;
 BOOLEAN  mDxeExMapTableEmpty;
+BOOLEAN  mPeiExMapTableSorted;
+BOOLEAN  mDxeExMapTableSorted;
 BOOLEAN  mPeiDatabaseEmpty;
 
 LIST_ENTRY  *mCallbackFnTable;
@@ -36,6 +38,12 @@ PEI_PCD_DATABASE  *mPeiPcdDbBinary = NULL;
 UINTN             mDxePcdDbSize    = 0;
 DXE_PCD_DATABASE  *mDxePcdDbBinary = NULL;
 
+//
+// Buffer reused by GetHiiVariable() for the variables of HII type PCDs.
+//
+UINT8  *mHiiVariableBuffer    = NULL;
+UINTN  mHiiVariableBufferSize = 0;
+
 /**
   Get Local Token Number by Token Number.
 
@@ -479,13 +487,11 @@ GetWorker (
 
           //
           // If the operation is successful, we copy the data
-          // to the default value buffer in the PCD Database.
-          // So that we can free the Data allocated in GetHiiVariable.
+          // to the default value buffer in the PCD Database,
+          // as the buffer of GetHiiVariable is reused by the next read.
           //
           CopyMem (VaraiableDefaultBuffer, Data + VariableHead->Offset, GetSize);
         }
-
-        FreePool (Data);
       }
 
       RetPtr = (VOID *)VaraiableDefaultBuffer;
@@ -933,6 +939,15 @@ BuildPcdDxeDataBase (
   mDxeExMapTableEmpty = (mPcdDatabase.DxeDb->ExTokenCount == 0) ? TRUE : FALSE;
   mPeiDatabaseEmpty   = (mPeiLocalTokenCount == 0) ? TRUE : FALSE;
 
+  mPeiExMapTableSorted = IsExMapTableSorted (
+                           (DYNAMICEX_MAPPING *)((UINT8 *)mPcdDatabase.PeiDb + mPcdDatabase.PeiDb->ExMapTableOffset),
+                           mPcdDatabase.PeiDb->ExTokenCount
+                           );
+  mDxeExMapTableSorted = IsExMapTableSorted (
+                           (DYNAMICEX_MAPPING *)((UINT8 *)mPcdDatabase.DxeDb + mPcdDatabase.DxeDb->ExMapTableOffset),
+                           mPcdDatabase.DxeDb->ExTokenCount
+                           );
+
   TmpTokenSpaceBufferCount = mPcdDatabase.PeiDb->ExTokenCount + mPcdDatabase.DxeDb->ExTokenCount;
   TmpTokenSpaceBuffer      = (EFI_GUID **)AllocateZeroPool (TmpTokenSpaceBufferCount * sizeof (EFI_GUID *));
 
@@ -955,6 +970,9 @@ BuildPcdDxeDataBase (
 /**
   Get Variable which contains HII type PCD entry.
 
+  The variable is read into a buffer owned by the PCD driver, which is reused
+  by the next call, so the caller must not free it.
+
   @param VariableGuid    Variable's guid
   @param VariableName    Variable's unicode name string
   @param VariableData    Variable's data pointer,
@@ -972,40 +990,46 @@ GetHiiVariable (
 {
   UINTN       Size;
   EFI_STATUS  Status;
-  UINT8       *Buffer;
-
-  Size   = 0;
-  Buffer = NULL;
 
   //
-  // Firstly get the real size of HII variable
+  // Read the variable into the buffer left from the previous HII type PCD,
+  // only get the real size of the variable when it does not fit.
   //
+  Size   = mHiiVariableBufferSize;
   Status = gRT->GetVariable (
                   (UINT16 *)VariableName,
                   VariableGuid,
                   NULL,
                   &Size,
-                  Buffer
+                  mHiiVariableBuffer
                   );
 
   //
   // Allocate buffer to hold whole variable data according to variable size.
   //
   if (Status == EFI_BUFFER_TOO_SMALL) {
-    Buffer = (UINT8 *)AllocatePool (Size);
+    if (mHiiVariableBuffer != NULL) {
+      FreePool (mHiiVariableBuffer);
+    }
 
-    ASSERT (Buffer != NULL);
+    mHiiVariableBuffer = (UINT8 *)AllocatePool (Size);
+
+    ASSERT (mHiiVariableBuffer != NULL);
+    mHiiVariableBufferSize = (mHiiVariableBuffer == NULL) ? 0 : Size;
 
     Status = gRT->GetVariable (
                     VariableName,
                     VariableGuid,
                     NULL,
                     &Size,
-                    Buffer
+                    mHiiVariableBuffer
                     );
 
     ASSERT (Status == EFI_SUCCESS);
-    *VariableData = Buffer;
+  }
+
+  if (Status == EFI_SUCCESS) {
+    *VariableData = mHiiVariableBuffer;
     *VariableSize = Size;
   } else {
     //
@@ -1568,6 +1592,100 @@ SetHiiVariable (
   return Status;
 }
 
+/**
+  Check whether an ExMap table is sorted by token space guid index and token
+  number. The build tools sort the table, but a PCD database built by an older
+  version of the tools may not be sorted.
+
+  @param ExMap           The ExMap table.
+  @param ExTokenCount    The number of entries in the ExMap table.
+
+  @retval TRUE           The table is sorted, so it can be binary searched.
+  @retval FALSE          The table is not sorted.
+
+**/
+BOOLEAN
+IsExMapTableSorted (
+  IN CONST DYNAMICEX_MAPPING  *ExMap,
+  IN UINTN                    ExTokenCount
+  )
+{
+  UINTN  Index;
+
+  for (Index = 1; Index < ExTokenCount; Index++) {
+    if ((ExMap[Index - 1].ExGuidIndex > ExMap[Index].ExGuidIndex) ||
+        ((ExMap[Index - 1].ExGuidIndex == ExMap[Index].ExGuidIndex) &&
+         (ExMap[Index - 1].ExTokenNumber >= ExMap[Index].ExTokenNumber)))
+    {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Search an ExMap table for a dynamic-ex PCD.
+
+  @param ExMap           The ExMap table.
+  @param ExTokenCount    The number of entries in the ExMap table.
+  @param Sorted          Whether the table is sorted by token space guid index
+                         and token number.
+  @param GuidIndex       Index of the token space guid in the guid table.
+  @param ExTokenNumber   Dynamic-ex PCD token number.
+
+  @return Token Number for dynamic-ex PCD, or PCD_INVALID_TOKEN_NUMBER if it is
+          not in the table.
+
+**/
+UINTN
+SearchExMapTable (
+  IN CONST DYNAMICEX_MAPPING  *ExMap,
+  IN UINTN                    ExTokenCount,
+  IN BOOLEAN                  Sorted,
+  IN UINTN                    GuidIndex,
+  IN UINT32                   ExTokenNumber
+  )
+{
+  UINTN  Index;
+  UINTN  Low;
+  UINTN  High;
+
+  if (Sorted) {
+    Low  = 0;
+    High = ExTokenCount;
+    while (Low < High) {
+      Index = Low + (High - Low) / 2;
+      if ((ExMap[Index].ExGuidIndex < GuidIndex) ||
+          ((ExMap[Index].ExGuidIndex == GuidIndex) && (ExMap[Index].ExTokenNumber < ExTokenNumber)))
+      {
+        Low = Index + 1;
+      } else {
+        High = Index;
+      }
+    }
+
+    if ((Low < ExTokenCount) &&
+        (ExMap[Low].ExGuidIndex == GuidIndex) &&
+        (ExMap[Low].ExTokenNumber == ExTokenNumber))
+    {
+      return ExMap[Low].TokenNumber;
+    }
+
+    return PCD_INVALID_TOKEN_NUMBER;
+  }
+
+  for (Index = 0; Index < ExTokenCount; Index++) {
+    if ((ExTokenNumber == ExMap[Index].ExTokenNumber) &&
+        (GuidIndex == ExMap[Index].ExGuidIndex))
+    {
+      return ExMap[Index].TokenNumber;
+    }
+  }
+
+  return PCD_INVALID_TOKEN_NUMBER;
+}
+
 /**
   Get Token Number according to dynamic-ex PCD's {token space guid:token number}
 
@@ -1587,7 +1705,7 @@ GetExPcdTokenNumber (
   IN UINT32          ExTokenNumber
   )
 {
-  UINT32             Index;
+  UINTN              TokenNumber;
   DYNAMICEX_MAPPING  *ExMap;
   EFI_GUID           *GuidTable;
   EFI_GUID           *MatchGuid;
@@ -1602,12 +1720,9 @@ GetExPcdTokenNumber (
     if (MatchGuid != NULL) {
       MatchGuidIdx = MatchGuid - GuidTable;
 
-      for (Index = 0; Index < mPcdDatabase.PeiDb->ExTokenCount; Index++) {
-        if ((ExTokenNumber == ExMap[Index].ExTokenNumber) &&
-            (MatchGuidIdx == ExMap[Index].ExGuidIndex))
-        {
-          return ExMap[Index].TokenNumber;
-        }
+      TokenNumber = SearchExMapTable (ExMap, mPcdDatabase.PeiDb->ExTokenCount, mPeiExMapTableSorted, MatchGuidIdx, ExTokenNumber);
+      if (TokenNumber != PCD_INVALID_TOKEN_NUMBER) {
+        return TokenNumber;
       }
     }
   }
@@ -1624,12 +1739,9 @@ GetExPcdTokenNumber (
 
   MatchGuidIdx = MatchGuid - GuidTable;
 
-  for (Index = 0; Index < mPcdDatabase.DxeDb->ExTokenCount; Index++) {
-    if ((ExTokenNumber == ExMap[Index].ExTokenNumber) &&
-        (MatchGuidIdx == ExMap[Index].ExGuidIndex))
-    {
-      return ExMap[Index].TokenNumber;
-    }
+  TokenNumber = SearchExMapTable (ExMap, mPcdDatabase.DxeDb->ExTokenCount, mDxeExMapTableSorted, MatchGuidIdx, ExTokenNumber);
+  if (TokenNumber != PCD_INVALID_TOKEN_NUMBER) {
+    return TokenNumber;
   }
 
   DEBUG ((DEBUG_ERROR, "%a: Failed to find PCD with GUID: %g and token number: %d\n", __func__, Guid, ExTokenNumber));
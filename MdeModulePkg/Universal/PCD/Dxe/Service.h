@@ -959,6 +959,9 @@ ExGetWorker (
 /**
   Get Variable which contains HII type PCD entry.
 
+  The variable is read into a buffer owned by the PCD driver, which is reused
+  by the next call, so the caller must not free it.
+
   @param VariableGuid    Variable's guid
   @param VariableName    Variable's unicode name string
   @param VariableData    Variable's data pointer,
@@ -1054,6 +1057,47 @@ BuildPcdDxeDataBase (
   VOID
   );
 
+/**
+  Check whether an ExMap table is sorted by token space guid index and token
+  number. The build tools sort the table, but a PCD database built by an older
+  version of the tools may not be sorted.
+
+  @param ExMap           The ExMap table.
+  @param ExTokenCount    The number of entries in the ExMap table.
+
+  @retval TRUE           The table is sorted, so it can be binary searched.
+  @retval FALSE          The table is not sorted.
+
+**/
+BOOLEAN
+IsExMapTableSorted (
+  IN CONST DYNAMICEX_MAPPING  *ExMap,
+  IN UINTN                    ExTokenCount
+  );
+
+/**
+  Search an ExMap table for a dynamic-ex PCD.
+
+  @param ExMap           The ExMap table.
+  @param ExTokenCount    The number of entries in the ExMap table.
+  @param Sorted          Whether the table is sorted by token space guid index
+                         and token number.
+  @param GuidIndex       Index of the token space guid in the guid table.
+  @param ExTokenNumber   Dynamic-ex PCD token number.
+
+  @return Token Number for dynamic-ex PCD, or PCD_INVALID_TOKEN_NUMBER if it is
+          not in the table.
+
+**/
+UINTN
+SearchExMapTable (
+  IN CONST DYNAMICEX_MAPPING  *ExMap,
+  IN UINTN                    ExTokenCount,
+  IN BOOLEAN                  Sorted,
+  IN UINTN                    GuidIndex,
+  IN UINT32                   ExTokenNumber
+  );
+
 /**
   Get Token Number according to dynamic-ex PCD's {token space guid:token number}
 
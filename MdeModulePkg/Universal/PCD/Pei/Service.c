@@ -979,6 +979,8 @@ GetExPcdTokenNumber (
   )
 {
   UINT32             Index;
+  UINT32             Low;
+  UINT32             High;
   DYNAMICEX_MAPPING  *ExMap;
   EFI_GUID           *GuidTable;
   EFI_GUID           *MatchGuid;
@@ -999,6 +1001,34 @@ GetExPcdTokenNumber (
 
   MatchGuidIdx = MatchGuid - GuidTable;
 
+  //
+  // The build tools sort the ExMap table by token space guid index and token
+  // number, so binary search it first.
+  //
+  Low  = 0;
+  High = PeiPcdDb->ExTokenCount;
+  while (Low < High) {
+    Index = Low + (High - Low) / 2;
+    if ((ExMap[Index].ExGuidIndex < MatchGuidIdx) ||
+        ((ExMap[Index].ExGuidIndex == MatchGuidIdx) && (ExMap[Index].ExTokenNumber < ExTokenNumber)))
+    {
+      Low = Index + 1;
+    } else {
+      High = Index;
+    }
+  }
+
+  if ((Low < PeiPcdDb->ExTokenCount) &&
+      (ExTokenNumber == ExMap[Low].ExTokenNumber) &&
+      (MatchGuidIdx == ExMap[Low].ExGuidIndex))
+  {
+    return ExMap[Low].TokenNumber;
+  }
+
+  //
+  // The table of a database built by an older version of the tools may not be
+  // sorted.
+  //
   for (Index = 0; Index < PeiPcdDb->ExTokenCount; Index++) {
     if ((ExTokenNumber == ExMap[Index].ExTokenNumber) &&
         (MatchGuidIdx == ExMap[Index].ExGuidIndex))
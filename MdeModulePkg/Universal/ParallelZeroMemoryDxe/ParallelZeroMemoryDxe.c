@@ -0,0 +1,216 @@
+/** @file
+  Produce the EDK II Parallel Zero Memory Protocol on top of the MP Services
+  Protocol.
+
+  A large range is cut into chunks that the BSP and the APs take one by one
+  until none is left. The chunks are cleared with ZeroMem(), so the range is
+  written with the stores of the BaseMemoryLib instance the driver is built
+  with, non-temporal ones for the instances that use them.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiDxe.h>
+
+#include <Protocol/MpService.h>
+#include <Protocol/ParallelZeroMemory.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/SynchronizationLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+//
+// Ranges below PARALLEL_ZERO_MIN_LENGTH are not worth waking up the APs.
+//
+#define PARALLEL_ZERO_CHUNK_SIZE  SIZE_2MB
+#define PARALLEL_ZERO_MIN_LENGTH  SIZE_16MB
+
+typedef struct {
+  EFI_PHYSICAL_ADDRESS    Start;
+  EFI_PHYSICAL_ADDRESS    End;
+  UINT32                  ChunkCount;
+  volatile UINT32         NextChunk;
+} PARALLEL_ZERO_CONTEXT;
+
+EFI_MP_SERVICES_PROTOCOL  *mMpService;
+UINTN                     mNumberOfEnabledProcessors;
+
+/**
+  Clear chunks of the range until none is left.
+
+  @param[in] Buffer  Pointer to the PARALLEL_ZERO_CONTEXT.
+
+**/
+STATIC
+VOID
+EFIAPI
+ParallelZeroProcedure (
+  IN VOID  *Buffer
+  )
+{
+  PARALLEL_ZERO_CONTEXT  *Context;
+  UINT32                 Index;
+  EFI_PHYSICAL_ADDRESS   ChunkStart;
+  EFI_PHYSICAL_ADDRESS   ChunkEnd;
+
+  Context = (PARALLEL_ZERO_CONTEXT *)Buffer;
+  while (TRUE) {
+    Index = InterlockedIncrement (&Context->NextChunk) - 1;
+    if (Index >= Context->ChunkCount) {
+      break;
+    }
+
+    //
+    // All chunks but the first and the last one are aligned on
+    // PARALLEL_ZERO_CHUNK_SIZE.
+    //
+    ChunkStart = (Context->Start & ~((EFI_PHYSICAL_ADDRESS)PARALLEL_ZERO_CHUNK_SIZE - 1)) +
+                 MultU64x32 (PARALLEL_ZERO_CHUNK_SIZE, Index);
+    ChunkEnd   = ChunkStart + PARALLEL_ZERO_CHUNK_SIZE;
+    ChunkStart = MAX (ChunkStart, Context->Start);
+    ChunkEnd   = MIN (ChunkEnd, Context->End);
+
+    ZeroMem ((VOID *)(UINTN)ChunkStart, (UINTN)(ChunkEnd - ChunkStart));
+  }
+}
+
+/**
+  Fill a range of memory with zeros.
+
+  The range must be mapped and writable, and must not be used by anyone else
+  while it is cleared. Small ranges, and ranges cleared above TPL_CALLBACK,
+  are cleared on the calling processor only.
+
+  @param[in] This    The EDKII_PARALLEL_ZERO_MEMORY_PROTOCOL instance.
+  @param[in] Buffer  The start address of the range.
+  @param[in] Length  The length of the range in bytes.
+
+  @retval EFI_SUCCESS            The range was cleared.
+  @retval EFI_INVALID_PARAMETER  The range wraps around or is not addressable
+                                 by the processor.
+**/
+EFI_STATUS
+EFIAPI
+ParallelZeroMemory (
+  IN EDKII_PARALLEL_ZERO_MEMORY_PROTOCOL  *This,
+  IN EFI_PHYSICAL_ADDRESS                 Buffer,
+  IN UINT64                               Length
+  )
+{
+  EFI_STATUS             Status;
+  EFI_TPL                OldTpl;
+  EFI_EVENT              Event;
+  PARALLEL_ZERO_CONTEXT  Context;
+
+  if (Length == 0) {
+    return EFI_SUCCESS;
+  }
+
+  if ((Length - 1 > MAX_ADDRESS) || (Buffer > MAX_ADDRESS - (Length - 1))) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  //
+  // The completion of non-blocking MP services calls is checked from a timer
+  // event, so the APs can only be waited for at or below TPL_CALLBACK.
+  //
+  OldTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  gBS->RestoreTPL (OldTpl);
+
+  if ((Length < PARALLEL_ZERO_MIN_LENGTH) || (OldTpl > TPL_CALLBACK) || (mNumberOfEnabledProcessors < 2)) {
+    ZeroMem ((VOID *)(UINTN)Buffer, (UINTN)Length);
+    return EFI_SUCCESS;
+  }
+
+  Context.Start      = Buffer;
+  Context.End        = Buffer + Length;
+  Context.ChunkCount = (UINT32)DivU64x32 (
+                                 ALIGN_VALUE (Context.End, PARALLEL_ZERO_CHUNK_SIZE) -
+                                 (Context.Start & ~((EFI_PHYSICAL_ADDRESS)PARALLEL_ZERO_CHUNK_SIZE - 1)),
+                                 PARALLEL_ZERO_CHUNK_SIZE
+                                 );
+  Context.NextChunk = 0;
+
+  Event  = NULL;
+  Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &Event);
+  if (!EFI_ERROR (Status)) {
+    //
+    // If the APs are busy, for example because a caller at TPL_CALLBACK
+    // interrupted another clear, the BSP clears the whole range.
+    //
+    Status = mMpService->StartupAllAPs (
+                           mMpService,
+                           ParallelZeroProcedure,
+                           FALSE,
+                           Event,
+                           0,
+                           &Context,
+                           NULL
+                           );
+  }
+
+  ParallelZeroProcedure (&Context);
+
+  if (!EFI_ERROR (Status)) {
+    while (gBS->CheckEvent (Event) == EFI_NOT_READY) {
+      CpuPause ();
+    }
+  }
+
+  if (Event != NULL) {
+    gBS->CloseEvent (Event);
+  }
+
+  return EFI_SUCCESS;
+}
+
+EDKII_PARALLEL_ZERO_MEMORY_PROTOCOL  mParallelZeroMemory = {
+  ParallelZeroMemory
+};
+
+/**
+  The entry point of the Parallel Zero Memory driver.
+
+  @param[in] ImageHandle  The firmware allocated handle for the EFI image.
+  @param[in] SystemTable  A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS     The protocol was installed.
+  @retval Others          The MP Services Protocol is not usable, or the
+                          protocol could not be installed.
+
+**/
+EFI_STATUS
+EFIAPI
+ParallelZeroMemoryEntryPoint (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       NumberOfProcessors;
+  EFI_HANDLE  Handle;
+
+  Status = gBS->LocateProtocol (&gEfiMpServiceProtocolGuid, NULL, (VOID **)&mMpService);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = mMpService->GetNumberOfProcessors (mMpService, &NumberOfProcessors, &mNumberOfEnabledProcessors);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  DEBUG ((DEBUG_INFO, "%a: Zeroing memory on %d processors\n", __func__, mNumberOfEnabledProcessors));
+
+  Handle = NULL;
+  return gBS->InstallMultipleProtocolInterfaces (
+                &Handle,
+                &gEdkiiParallelZeroMemoryProtocolGuid,
+                &mParallelZeroMemory,
+                NULL
+                );
+}
@@ -51,6 +51,15 @@ CheckConfigAccess (
     FormSet->ConfigAccess = NULL;
   }
 
+  Status = gBS->HandleProtocol (
+                  FormSet->DriverHandle,
+                  &gEdkiiHiiConfigBlockAccessProtocolGuid,
+                  (VOID **)&FormSet->ConfigBlockAccess
+                  );
+  if (EFI_ERROR (Status)) {
+    FormSet->ConfigBlockAccess = NULL;
+  }
+
   return EFI_SUCCESS;
 }
 
@@ -1566,6 +1566,179 @@ BufferToValue (
   return Status;
 }
 
+/**
+  Read the current settings of a buffer storage with the Config Block Access
+  Protocol of the Configuration Driver.
+
+  @param  FormSet                FormSet data structure.
+  @param  Storage                The storage to fill the EditBuffer of.
+
+  @retval EFI_SUCCESS            The EditBuffer was filled.
+  @retval EFI_UNSUPPORTED        The driver has no Config Block Access Protocol,
+                                 or Storage is not a buffer storage.
+  @retval Others                 The error returned by ExtractBlock().
+
+**/
+EFI_STATUS
+ExtractStorageBlock (
+  IN FORM_BROWSER_FORMSET  *FormSet,
+  IN BROWSER_STORAGE       *Storage
+  )
+{
+  if ((FormSet->ConfigBlockAccess == NULL) || (Storage->Type != EFI_HII_VARSTORE_BUFFER)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  return FormSet->ConfigBlockAccess->ExtractBlock (
+                                       FormSet->ConfigBlockAccess,
+                                       &Storage->Guid,
+                                       Storage->Name,
+                                       0,
+                                       Storage->Size,
+                                       Storage->EditBuffer
+                                       );
+}
+
+/**
+  Send the settings of the Request Elements of a buffer storage to the
+  Configuration Driver with its Config Block Access Protocol. Adjacent
+  Request Elements are sent together.
+
+  @param  FormSet                FormSet data structure.
+  @param  Storage                The storage to send the EditBuffer of.
+  @param  ConfigRequest          The <ConfigRequest> of the settings to send.
+
+  @retval EFI_SUCCESS            The settings were applied by the driver.
+  @retval EFI_UNSUPPORTED        The driver has no Config Block Access Protocol,
+                                 or Storage is not a buffer storage.
+  @retval EFI_INVALID_PARAMETER  A Request Element is not within the storage.
+  @retval Others                 The error returned by RouteBlock().
+
+**/
+EFI_STATUS
+RouteStorageBlocks (
+  IN FORM_BROWSER_FORMSET  *FormSet,
+  IN BROWSER_STORAGE       *Storage,
+  IN CHAR16                *ConfigRequest
+  )
+{
+  EFI_STATUS  Status;
+  CHAR16      *StringPtr;
+  UINTN       Offset;
+  UINTN       Width;
+  UINTN       RangeStart;
+  UINTN       RangeEnd;
+
+  if ((FormSet->ConfigBlockAccess == NULL) || (Storage->Type != EFI_HII_VARSTORE_BUFFER)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Offset     = 0;
+  Width      = 0;
+  RangeStart = 0;
+  RangeEnd   = 0;
+
+  //
+  // The Request Elements of buffer storages are "&OFFSET=<Number>&WIDTH=<Number>".
+  //
+  StringPtr = StrStr (ConfigRequest, L"&OFFSET=");
+  while (TRUE) {
+    if (StringPtr != NULL) {
+      StringPtr += StrLen (L"&OFFSET=");
+      Offset     = StrHexToUintn (StringPtr);
+      StringPtr  = StrStr (StringPtr, L"&WIDTH=");
+      if (StringPtr == NULL) {
+        return EFI_INVALID_PARAMETER;
+      }
+
+      StringPtr += StrLen (L"&WIDTH=");
+      Width      = StrHexToUintn (StringPtr);
+      if ((Offset > Storage->Size) || (Width > Storage->Size - Offset)) {
+        return EFI_INVALID_PARAMETER;
+      }
+
+      if ((RangeEnd != RangeStart) && (Offset == RangeEnd)) {
+        RangeEnd += Width;
+        StringPtr = StrStr (StringPtr, L"&OFFSET=");
+        continue;
+      }
+    }
+
+    if (RangeEnd != RangeStart) {
+      Status = FormSet->ConfigBlockAccess->RouteBlock (
+                                             FormSet->ConfigBlockAccess,
+                                             &Storage->Guid,
+                                             Storage->Name,
+                                             RangeStart,
+                                             RangeEnd - RangeStart,
+                                             Storage->EditBuffer + RangeStart
+                                             );
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+    }
+
+    if (StringPtr == NULL) {
+      break;
+    }
+
+    RangeStart = Offset;
+    RangeEnd   = Offset + Width;
+    StringPtr  = StrStr (StringPtr, L"&OFFSET=");
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Request the current settings of a storage from the Configuration Driver.
+
+  Buffer and Name/Value storages belong to the driver that installed the
+  package list of the formset, whose ConfigAccess protocol is known already.
+  It is called directly for them, rather than through the Config Routing
+  Protocol, which has to parse the IFR of the package lists to find the
+  driver and to add the default settings to the <ConfigAltResp>. Only the
+  <ConfigResp> at the start of Result is used by the callers.
+
+  @param  FormSet                FormSet data structure.
+  @param  Storage                The storage of ConfigRequest.
+  @param  ConfigRequest          The <ConfigRequest> to send to the driver.
+  @param  Progress               On return, points to the first character of
+                                 ConfigRequest that failed, if any.
+  @param  Result                 On return, the <ConfigAltResp> of the driver.
+
+  @retval EFI_SUCCESS            The settings are returned in Result.
+  @retval Others                 The error returned by ExtractConfig().
+
+**/
+EFI_STATUS
+ExtractStorageConfig (
+  IN  FORM_BROWSER_FORMSET  *FormSet,
+  IN  BROWSER_STORAGE       *Storage,
+  IN  EFI_STRING            ConfigRequest,
+  OUT EFI_STRING            *Progress,
+  OUT EFI_STRING            *Result
+  )
+{
+  if ((FormSet->ConfigAccess != NULL) &&
+      ((Storage->Type == EFI_HII_VARSTORE_BUFFER) || (Storage->Type == EFI_HII_VARSTORE_NAME_VALUE)))
+  {
+    return FormSet->ConfigAccess->ExtractConfig (
+                                    FormSet->ConfigAccess,
+                                    ConfigRequest,
+                                    Progress,
+                                    Result
+                                    );
+  }
+
+  return mHiiConfigRouting->ExtractConfig (
+                              mHiiConfigRouting,
+                              ConfigRequest,
+                              Progress,
+                              Result
+                              );
+}
+
 /**
   Get Question's current Value.
 
@@ -1836,12 +2009,7 @@ GetQuestionValue (
     //
     // Request current settings from Configuration Driver
     //
-    Status = mHiiConfigRouting->ExtractConfig (
-                                  mHiiConfigRouting,
-                                  ConfigRequest,
-                                  &Progress,
-                                  &Result
-                                  );
+    Status = ExtractStorageConfig (FormSet, Question->Storage, ConfigRequest, &Progress, &Result);
     FreePool (ConfigRequest);
     if (EFI_ERROR (Status)) {
       return Status;
@@ -3377,6 +3545,15 @@ SubmitForForm (
       continue;
     }
 
+    //
+    // Send the settings as binary if the driver supports it. Otherwise, or
+    // if it fails, send them as a <ConfigResp>, which reports where it failed.
+    //
+    if (!EFI_ERROR (RouteStorageBlocks (FormSet, Storage, ConfigInfo->ConfigRequest))) {
+      SynchronizeStorage (ConfigInfo->Storage, ConfigInfo->ConfigRequest, TRUE);
+      continue;
+    }
+
     //
     // 1. Prepare <ConfigResp>
     //
@@ -3546,6 +3723,15 @@ SubmitForFormSet (
       continue;
     }
 
+    //
+    // Send the settings as binary if the driver supports it. Otherwise, or
+    // if it fails, send them as a <ConfigResp>, which reports where it failed.
+    //
+    if (!EFI_ERROR (RouteStorageBlocks (FormSet, Storage, FormSetStorage->ConfigRequest))) {
+      SynchronizeStorage (Storage, FormSetStorage->ConfigRequest, TRUE);
+      continue;
+    }
+
     //
     // 1. Prepare <ConfigResp>
     //
@@ -5642,16 +5828,12 @@ LoadStorage (
     if (EFI_ERROR (Status)) {
       ExtractDefault (FormSet, NULL, EFI_HII_DEFAULT_CLASS_STANDARD, FormSetLevel, GetDefaultForStorage, Storage->BrowserStorage, TRUE, TRUE);
     }
-  } else {
+  } else if (EFI_ERROR (ExtractStorageBlock (FormSet, Storage->BrowserStorage))) {
     //
-    // Request current settings from Configuration Driver
+    // Request current settings from Configuration Driver, as a <ConfigResp>
+    // if it cannot return them as binary.
     //
-    Status = mHiiConfigRouting->ExtractConfig (
-                                  mHiiConfigRouting,
-                                  ConfigRequest,
-                                  &Progress,
-                                  &Result
-                                  );
+    Status = ExtractStorageConfig (FormSet, Storage->BrowserStorage, ConfigRequest, &Progress, &Result);
 
     //
     // If get value fail, extract default from IFR binary
@@ -6049,6 +6231,19 @@ InitializeFormSet (
     FormSet->ConfigAccess = NULL;
   }
 
+  //
+  // The Config Block Access Protocol is optional, the settings of buffer
+  // storages are exchanged as strings through ConfigAccess without it.
+  //
+  Status = gBS->HandleProtocol (
+                  DriverHandle,
+                  &gEdkiiHiiConfigBlockAccessProtocolGuid,
+                  (VOID **)&FormSet->ConfigBlockAccess
+                  );
+  if (EFI_ERROR (Status)) {
+    FormSet->ConfigBlockAccess = NULL;
+  }
+
   //
   // Parse the IFR binary OpCodes
   //
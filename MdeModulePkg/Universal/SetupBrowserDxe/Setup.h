@@ -20,6 +20,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Protocol/DevicePath.h>
 #include <Protocol/UnicodeCollation.h>
 #include <Protocol/HiiConfigAccess.h>
+#include <Protocol/HiiConfigBlockAccess.h>
 #include <Protocol/HiiConfigRouting.h>
 #include <Protocol/HiiDatabase.h>
 #include <Protocol/HiiString.h>
@@ -431,40 +432,41 @@ typedef struct {
 #define FORM_BROWSER_FORMSET_SIGNATURE  SIGNATURE_32 ('F', 'B', 'F', 'S')
 
 typedef struct {
-  UINTN                             Signature;
-  LIST_ENTRY                        Link;
-  LIST_ENTRY                        SaveFailLink;
-
-  EFI_HII_HANDLE                    HiiHandle;    // unique id for formset.
-  EFI_HANDLE                        DriverHandle;
-  EFI_HII_CONFIG_ACCESS_PROTOCOL    *ConfigAccess;
-  EFI_DEVICE_PATH_PROTOCOL          *DevicePath;
-
-  UINTN                             IfrBinaryLength;
-  UINT8                             *IfrBinaryData;
-
-  BOOLEAN                           QuestionInited; // Have finished question initilization?
-  EFI_GUID                          Guid;
-  EFI_STRING_ID                     FormSetTitle;
-  EFI_STRING_ID                     Help;
-  UINT8                             NumberOfClassGuid;
-  EFI_GUID                          ClassGuid[3];       // Up to three ClassGuid
-  UINT16                            Class;              // Tiano extended Class code
-  UINT16                            SubClass;           // Tiano extended Subclass code
-  EFI_IMAGE_ID                      ImageId;
-  EFI_IFR_OP_HEADER                 *OpCode;            // mainly for formset op to get ClassGuid
-
-  FORM_BROWSER_STATEMENT            *StatementBuffer;   // Buffer for all Statements and Questions
-  EXPRESSION_OPCODE                 *ExpressionBuffer;  // Buffer for all Expression OpCode
-  FORM_BROWSER_FORM                 *SaveFailForm;      // The form which failed to save.
-  FORM_BROWSER_STATEMENT            *SaveFailStatement; // The Statement which failed to save.
-
-  LIST_ENTRY                        StatementListOSF;        // Statement list out side of the form.
-  LIST_ENTRY                        StorageListHead;         // Storage list (FORMSET_STORAGE)
-  LIST_ENTRY                        SaveFailStorageListHead; // Storage list for the save fail storage.
-  LIST_ENTRY                        DefaultStoreListHead;    // DefaultStore list (FORMSET_DEFAULTSTORE)
-  LIST_ENTRY                        FormListHead;            // Form list (FORM_BROWSER_FORM)
-  LIST_ENTRY                        ExpressionListHead;      // List of Expressions (FORM_EXPRESSION)
+  UINTN                                     Signature;
+  LIST_ENTRY                                Link;
+  LIST_ENTRY                                SaveFailLink;
+
+  EFI_HII_HANDLE                            HiiHandle;    // unique id for formset.
+  EFI_HANDLE                                DriverHandle;
+  EFI_HII_CONFIG_ACCESS_PROTOCOL            *ConfigAccess;
+  EDKII_HII_CONFIG_BLOCK_ACCESS_PROTOCOL    *ConfigBlockAccess;
+  EFI_DEVICE_PATH_PROTOCOL                  *DevicePath;
+
+  UINTN                                     IfrBinaryLength;
+  UINT8                                     *IfrBinaryData;
+
+  BOOLEAN                                   QuestionInited; // Have finished question initilization?
+  EFI_GUID                                  Guid;
+  EFI_STRING_ID                             FormSetTitle;
+  EFI_STRING_ID                             Help;
+  UINT8                                     NumberOfClassGuid;
+  EFI_GUID                                  ClassGuid[3];       // Up to three ClassGuid
+  UINT16                                    Class;              // Tiano extended Class code
+  UINT16                                    SubClass;           // Tiano extended Subclass code
+  EFI_IMAGE_ID                              ImageId;
+  EFI_IFR_OP_HEADER                         *OpCode;            // mainly for formset op to get ClassGuid
+
+  FORM_BROWSER_STATEMENT                    *StatementBuffer;   // Buffer for all Statements and Questions
+  EXPRESSION_OPCODE                         *ExpressionBuffer;  // Buffer for all Expression OpCode
+  FORM_BROWSER_FORM                         *SaveFailForm;      // The form which failed to save.
+  FORM_BROWSER_STATEMENT                    *SaveFailStatement; // The Statement which failed to save.
+
+  LIST_ENTRY                                StatementListOSF;        // Statement list out side of the form.
+  LIST_ENTRY                                StorageListHead;         // Storage list (FORMSET_STORAGE)
+  LIST_ENTRY                                SaveFailStorageListHead; // Storage list for the save fail storage.
+  LIST_ENTRY                                DefaultStoreListHead;    // DefaultStore list (FORMSET_DEFAULTSTORE)
+  LIST_ENTRY                                FormListHead;            // Form list (FORM_BROWSER_FORM)
+  LIST_ENTRY                                ExpressionListHead;      // List of Expressions (FORM_EXPRESSION)
 } FORM_BROWSER_FORMSET;
 #define FORM_BROWSER_FORMSET_FROM_LINK(a)  CR (a, FORM_BROWSER_FORMSET, Link, FORM_BROWSER_FORMSET_SIGNATURE)
 
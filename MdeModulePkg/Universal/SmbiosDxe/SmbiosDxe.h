@@ -27,6 +27,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <UniversalPayload/SmbiosTable.h>
 
 #define SMBIOS_INSTANCE_SIGNATURE  SIGNATURE_32 ('S', 'B', 'i', 's')
+
+//
+// One bit for each possible SMBIOS handle.
+//
+#define SMBIOS_HANDLE_BITMAP_SIZE  ((MAX_UINT16 + 1) / 8)
+
 typedef struct {
   UINT32                 Signature;
   EFI_HANDLE             Handle;
@@ -43,9 +49,14 @@ typedef struct {
   //
   LIST_ENTRY             DataListHead;
   //
-  // List of allocated SMBIOS handle.
+  // Bitmap of allocated SMBIOS handles, so that checking and assigning a
+  // handle does not depend on the number of records.
   //
-  LIST_ENTRY             AllocatedHandleListHead;
+  UINT8                  AllocatedHandleBitmap[SMBIOS_HANDLE_BITMAP_SIZE];
+  //
+  // No handle below this one is free.
+  //
+  EFI_SMBIOS_HANDLE      FreeHandleHint;
 } SMBIOS_INSTANCE;
 
 #define SMBIOS_INSTANCE_FROM_THIS(this)  CR (this, SMBIOS_INSTANCE, Smbios, SMBIOS_INSTANCE_SIGNATURE)
@@ -85,22 +96,6 @@ typedef struct {
 
 #define SMBIOS_ENTRY_FROM_LINK(link)  CR (link, EFI_SMBIOS_ENTRY, Link, EFI_SMBIOS_ENTRY_SIGNATURE)
 
-//
-// Private data to contain the Smbios handle that already allocated.
-//
-#define SMBIOS_HANDLE_ENTRY_SIGNATURE  SIGNATURE_32 ('S', 'h', 'r', 'd')
-
-typedef struct {
-  UINT32               Signature;
-  LIST_ENTRY           Link;
-  //
-  // Filter driver will register what record guid filter should be used.
-  //
-  EFI_SMBIOS_HANDLE    SmbiosHandle;
-} SMBIOS_HANDLE_ENTRY;
-
-#define SMBIOS_HANDLE_ENTRY_FROM_LINK(link)  CR (link, SMBIOS_HANDLE_ENTRY, Link, SMBIOS_HANDLE_ENTRY_SIGNATURE)
-
 typedef struct {
   EFI_SMBIOS_TABLE_HEADER    Header;
   UINT8                      Tailing[2];
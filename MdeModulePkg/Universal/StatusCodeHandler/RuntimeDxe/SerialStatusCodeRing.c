@@ -0,0 +1,244 @@
+/** @file
+  Memory ring that defers serial status code output.
+
+  Producers claim a ring entry with a compare-exchange on the head index and
+  publish it by advancing the entry sequence number, so reporting never takes
+  a lock and never touches the serial port. A single consumer, serialized by
+  a drain flag, writes the published entries to the serial port later.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "StatusCodeHandlerRuntimeDxe.h"
+
+SERIAL_STATUS_CODE_RING_ENTRY  *mSerialStatusCodeRing = NULL;
+UINT32                         mSerialStatusCodeRingMask;
+volatile UINT32                mSerialStatusCodeRingHead;
+UINT32                         mSerialStatusCodeRingTail;
+volatile UINT32                mSerialStatusCodeRingDropped;
+volatile UINT32                mSerialStatusCodeRingDraining;
+EFI_EVENT                      mSerialStatusCodeRingDrainEvent = NULL;
+
+/**
+  Timer notification that writes the pending ring entries to the serial port.
+
+  @param  Event         Event whose notification function is being invoked.
+  @param  Context       Pointer to the notification function's context, which is
+                        always zero in current implementation.
+
+**/
+VOID
+EFIAPI
+SerialStatusCodeRingDrainNotify (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  SerialStatusCodeRingDrain ();
+}
+
+/**
+  Allocate the serial status code ring and start the timer that drains it.
+
+  The ring is only created if PcdStatusCodeSerialRingEntries is not zero. The
+  number of entries is rounded down to a power of two.
+
+  @retval EFI_SUCCESS           The ring is ready, or it is disabled.
+  @retval EFI_OUT_OF_RESOURCES  The ring could not be allocated.
+  @retval others                Errors from gBS->CreateEvent() or gBS->SetTimer().
+
+**/
+EFI_STATUS
+SerialStatusCodeRingInitialize (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  UINT32      Count;
+  UINT32      Index;
+
+  Count = PcdGet32 (PcdStatusCodeSerialRingEntries);
+  if (Count == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Count = GetPowerOfTwo32 (Count);
+
+  mSerialStatusCodeRing = AllocatePool (Count * sizeof (SERIAL_STATUS_CODE_RING_ENTRY));
+  if (mSerialStatusCodeRing == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Entry N is free for the producer that claims head index N once its
+  // sequence number equals N.
+  //
+  for (Index = 0; Index < Count; Index++) {
+    mSerialStatusCodeRing[Index].Sequence = Index;
+  }
+
+  mSerialStatusCodeRingMask     = Count - 1;
+  mSerialStatusCodeRingHead     = 0;
+  mSerialStatusCodeRingTail     = 0;
+  mSerialStatusCodeRingDropped  = 0;
+  mSerialStatusCodeRingDraining = 0;
+
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  SerialStatusCodeRingDrainNotify,
+                  NULL,
+                  &mSerialStatusCodeRingDrainEvent
+                  );
+  if (EFI_ERROR (Status)) {
+    FreePool (mSerialStatusCodeRing);
+    mSerialStatusCodeRing = NULL;
+    return Status;
+  }
+
+  return gBS->SetTimer (
+                mSerialStatusCodeRingDrainEvent,
+                TimerPeriodic,
+                SERIAL_STATUS_CODE_RING_DRAIN_PERIOD
+                );
+}
+
+/**
+  Try to copy one message into the next free ring entry.
+
+  @param  Buffer   The message to queue.
+  @param  Length   The number of characters in Buffer.
+
+  @retval TRUE     The message was queued.
+  @retval FALSE    The ring is full.
+
+**/
+STATIC
+BOOLEAN
+SerialStatusCodeRingPush (
+  IN CONST CHAR8  *Buffer,
+  IN UINTN        Length
+  )
+{
+  SERIAL_STATUS_CODE_RING_ENTRY  *Entry;
+  UINT32                         Head;
+  INT32                          Distance;
+
+  do {
+    Head     = mSerialStatusCodeRingHead;
+    Entry    = &mSerialStatusCodeRing[Head & mSerialStatusCodeRingMask];
+    Distance = (INT32)(Entry->Sequence - Head);
+    if (Distance < 0) {
+      //
+      // The consumer has not released this entry yet.
+      //
+      return FALSE;
+    }
+
+    if (Distance > 0) {
+      //
+      // Another producer claimed this index, retry with the new head.
+      //
+      continue;
+    }
+  } while (InterlockedCompareExchange32 (&mSerialStatusCodeRingHead, Head, Head + 1) != Head);
+
+  Entry->Length = (UINT32)MIN (Length, sizeof (Entry->Buffer));
+  CopyMem (Entry->Buffer, Buffer, Entry->Length);
+
+  //
+  // Publish the entry to the consumer only after its contents are visible.
+  //
+  MemoryFence ();
+  Entry->Sequence = Head + 1;
+
+  return TRUE;
+}
+
+/**
+  Queue a formatted status code message for later output to the serial port.
+
+  If the ring is full, it is drained in place, unless another drain is already
+  running. The message is dropped and counted if there is still no free entry.
+
+  @param  Buffer   The message to queue.
+  @param  Length   The number of characters in Buffer.
+
+**/
+VOID
+SerialStatusCodeRingWrite (
+  IN CONST CHAR8  *Buffer,
+  IN UINTN        Length
+  )
+{
+  if (SerialStatusCodeRingPush (Buffer, Length)) {
+    return;
+  }
+
+  SerialStatusCodeRingDrain ();
+
+  if (!SerialStatusCodeRingPush (Buffer, Length)) {
+    InterlockedIncrement (&mSerialStatusCodeRingDropped);
+  }
+}
+
+/**
+  Write every published ring entry to the serial port, in reporting order.
+
+  Only one caller drains at a time. A caller that finds a drain in progress
+  returns immediately, because the running drain will pick up its entries.
+
+**/
+VOID
+SerialStatusCodeRingDrain (
+  VOID
+  )
+{
+  SERIAL_STATUS_CODE_RING_ENTRY  *Entry;
+  UINT32                         Dropped;
+  UINTN                          CharCount;
+  CHAR8                          Buffer[MAX_DEBUG_MESSAGE_LENGTH];
+
+  if (mSerialStatusCodeRing == NULL) {
+    return;
+  }
+
+  if (InterlockedCompareExchange32 (&mSerialStatusCodeRingDraining, 0, 1) != 0) {
+    return;
+  }
+
+  for ( ; ;) {
+    Entry = &mSerialStatusCodeRing[mSerialStatusCodeRingTail & mSerialStatusCodeRingMask];
+    if (Entry->Sequence != mSerialStatusCodeRingTail + 1) {
+      break;
+    }
+
+    MemoryFence ();
+    SerialPortWrite ((UINT8 *)Entry->Buffer, Entry->Length);
+
+    //
+    // Hand the entry back to producers for the next lap of the ring.
+    //
+    MemoryFence ();
+    Entry->Sequence = mSerialStatusCodeRingTail + mSerialStatusCodeRingMask + 1;
+    mSerialStatusCodeRingTail++;
+  }
+
+  do {
+    Dropped = mSerialStatusCodeRingDropped;
+  } while (InterlockedCompareExchange32 (&mSerialStatusCodeRingDropped, Dropped, 0) != Dropped);
+
+  if (Dropped != 0) {
+    CharCount = AsciiSPrint (
+                  Buffer,
+                  sizeof (Buffer),
+                  "\n\r<%d status codes dropped>\n\r",
+                  Dropped
+                  );
+    SerialPortWrite ((UINT8 *)Buffer, CharCount);
+  }
+
+  InterlockedCompareExchange32 (&mSerialStatusCodeRingDraining, 1, 0);
+}
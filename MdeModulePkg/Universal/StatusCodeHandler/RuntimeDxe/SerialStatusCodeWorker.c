@@ -149,10 +149,21 @@ SerialStatusCodeReportWorker (
                   );
   }
 
-  //
-  // Call SerialPort Lib function to do print.
-  //
-  SerialPortWrite ((UINT8 *)Buffer, CharCount);
+  if (mSerialStatusCodeRing != NULL) {
+    //
+    // Queue the message. An error code, ASSERT() included, may be followed
+    // by a dead loop, so it and everything before it are written out now.
+    //
+    SerialStatusCodeRingWrite (Buffer, CharCount);
+    if ((CodeType & EFI_STATUS_CODE_TYPE_MASK) == EFI_ERROR_CODE) {
+      SerialStatusCodeRingDrain ();
+    }
+  } else {
+    //
+    // Call SerialPort Lib function to do print.
+    //
+    SerialPortWrite ((UINT8 *)Buffer, CharCount);
+  }
 
   //
   // If register an unregister function of gEfiEventExitBootServicesGuid,
@@ -162,6 +173,10 @@ SerialStatusCodeReportWorker (
   if (((CodeType & EFI_STATUS_CODE_TYPE_MASK) == EFI_PROGRESS_CODE) &&
       (Value == (EFI_SOFTWARE_EFI_BOOT_SERVICE | EFI_SW_BS_PC_EXIT_BOOT_SERVICES)))
   {
+    //
+    // The timer is stopped by now, flush what is still queued.
+    //
+    SerialStatusCodeRingDrain ();
     UnregisterSerialBootTimeHandlers ();
   }
 
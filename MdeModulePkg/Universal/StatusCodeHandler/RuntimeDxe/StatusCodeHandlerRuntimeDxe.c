@@ -80,6 +80,9 @@ InitializationDispatcherWorker (
     //
     Status = SerialPortInitialize ();
     ASSERT_EFI_ERROR (Status);
+
+    Status = SerialStatusCodeRingInitialize ();
+    ASSERT_EFI_ERROR (Status);
   }
 
   if (PcdGetBool (PcdStatusCodeUseMemory)) {
@@ -17,6 +17,7 @@
 #include <Guid/StatusCodeDataTypeDebug.h>
 #include <Guid/EventGroup.h>
 
+#include <Library/BaseLib.h>
 #include <Library/SynchronizationLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
@@ -35,7 +36,24 @@
 //
 #define MAX_DEBUG_MESSAGE_LENGTH  0x100
 
+//
+// Interval, in 100ns units, at which the serial status code ring is drained: 10ms.
+//
+#define SERIAL_STATUS_CODE_RING_DRAIN_PERIOD  100000
+
+//
+// One formatted message in the serial status code ring. Sequence equals the
+// head index that may claim the entry while it is free, and that index plus
+// one once the message is published.
+//
+typedef struct {
+  volatile UINT32    Sequence;
+  UINT32             Length;
+  CHAR8              Buffer[MAX_DEBUG_MESSAGE_LENGTH];
+} SERIAL_STATUS_CODE_RING_ENTRY;
+
 extern RUNTIME_MEMORY_STATUSCODE_HEADER  *mRtMemoryStatusCodeTable;
+extern SERIAL_STATUS_CODE_RING_ENTRY     *mSerialStatusCodeRing;
 
 /**
   Locates Serial I/O Protocol as initialization for serial status code worker.
@@ -77,6 +95,50 @@ SerialStatusCodeReportWorker (
   IN EFI_STATUS_CODE_DATA   *Data OPTIONAL
   );
 
+/**
+  Allocate the serial status code ring and start the timer that drains it.
+
+  The ring is only created if PcdStatusCodeSerialRingEntries is not zero. The
+  number of entries is rounded down to a power of two.
+
+  @retval EFI_SUCCESS           The ring is ready, or it is disabled.
+  @retval EFI_OUT_OF_RESOURCES  The ring could not be allocated.
+  @retval others                Errors from gBS->CreateEvent() or gBS->SetTimer().
+
+**/
+EFI_STATUS
+SerialStatusCodeRingInitialize (
+  VOID
+  );
+
+/**
+  Queue a formatted status code message for later output to the serial port.
+
+  If the ring is full, it is drained in place, unless another drain is already
+  running. The message is dropped and counted if there is still no free entry.
+
+  @param  Buffer   The message to queue.
+  @param  Length   The number of characters in Buffer.
+
+**/
+VOID
+SerialStatusCodeRingWrite (
+  IN CONST CHAR8  *Buffer,
+  IN UINTN        Length
+  );
+
+/**
+  Write every published ring entry to the serial port, in reporting order.
+
+  Only one caller drains at a time. A caller that finds a drain in progress
+  returns immediately, because the running drain will pick up its entries.
+
+**/
+VOID
+SerialStatusCodeRingDrain (
+  VOID
+  );
+
 /**
   Initialize runtime memory status code table as initialization for runtime memory status code worker
 
@@ -92,6 +92,11 @@ GetLbaAndOffsetByAddress (
   volume block device. The destination is specified by parameter
   VariableBase. Fault Tolerant Write protocol is used for writing.
 
+  Only the span from the first to the last byte that differs from the
+  current store content is written, so the blocks a reclaim leaves
+  unchanged, such as the leading live variables and the erased tail,
+  are neither erased nor programmed again.
+
   @param  VariableBase   Base address of variable to write
   @param  VariableBuffer Point to the variable data buffer.
 
@@ -111,6 +116,10 @@ FtwVariableSpace (
   EFI_LBA                            VarLba;
   UINTN                              VarOffset;
   UINTN                              FtwBufferSize;
+  UINTN                              WriteStart;
+  UINTN                              WriteEnd;
+  UINT8                              *Current;
+  UINT8                              *New;
   EFI_FAULT_TOLERANT_WRITE_PROTOCOL  *FtwProtocol;
 
   //
@@ -129,28 +138,47 @@ FtwVariableSpace (
     return Status;
   }
 
+  FtwBufferSize = ((VARIABLE_STORE_HEADER *)((UINTN)VariableBase))->Size;
+  ASSERT (FtwBufferSize == VariableBuffer->Size);
+
+  //
+  // Find the span that differs from the memory mapped store.
+  //
+  Current  = (UINT8 *)(UINTN)VariableBase;
+  New      = (UINT8 *)VariableBuffer;
+  WriteEnd = FtwBufferSize;
+  while ((WriteEnd > 0) && (Current[WriteEnd - 1] == New[WriteEnd - 1])) {
+    WriteEnd--;
+  }
+
+  if (WriteEnd == 0) {
+    return EFI_SUCCESS;
+  }
+
+  WriteStart = 0;
+  while (Current[WriteStart] == New[WriteStart]) {
+    WriteStart++;
+  }
+
   //
   // Get LBA and Offset by address.
   //
-  Status = GetLbaAndOffsetByAddress (VariableBase, &VarLba, &VarOffset);
+  Status = GetLbaAndOffsetByAddress (VariableBase + WriteStart, &VarLba, &VarOffset);
   if (EFI_ERROR (Status)) {
     return EFI_ABORTED;
   }
 
-  FtwBufferSize = ((VARIABLE_STORE_HEADER *)((UINTN)VariableBase))->Size;
-  ASSERT (FtwBufferSize == VariableBuffer->Size);
-
   //
   // FTW write record.
   //
   Status = FtwProtocol->Write (
                           FtwProtocol,
-                          VarLba,                // LBA
-                          VarOffset,             // Offset
-                          FtwBufferSize,         // NumBytes
-                          NULL,                  // PrivateData NULL
-                          FvbHandle,             // Fvb Handle
-                          (VOID *)VariableBuffer // write buffer
+                          VarLba,                 // LBA
+                          VarOffset,              // Offset
+                          WriteEnd - WriteStart,  // NumBytes
+                          NULL,                   // PrivateData NULL
+                          FvbHandle,              // Fvb Handle
+                          New + WriteStart        // write buffer
                           );
 
   return Status;
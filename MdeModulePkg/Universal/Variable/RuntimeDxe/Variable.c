@@ -818,6 +818,11 @@ Done:
     Status = DoneStatus;
   }
 
+  //
+  // The variables have been moved, index the store again on the next lookup.
+  //
+  ResetVariableIndex (IsVolatile ? (VARIABLE_STORE_HEADER *)(UINTN)VariableBase : mNvVariableCache);
+
   return Status;
 }
 
@@ -3192,7 +3197,40 @@ VariableServiceQueryVariableInfo (
 }
 
 /**
-  This function reclaims variable storage if free size is below the threshold.
+  Get the percentage of the NV variable store taken by deleted variables.
+
+  @return The fragmentation of the NV variable store, in percent.
+
+**/
+UINTN
+GetNvVariableStoreFragmentation (
+  VOID
+  )
+{
+  VARIABLE_HEADER  *Variable;
+  VARIABLE_HEADER  *NextVariable;
+  UINTN            DeletedSize;
+  BOOLEAN          AuthFormat;
+
+  AuthFormat  = mVariableModuleGlobal->VariableGlobal.AuthFormat;
+  DeletedSize = 0;
+  for ( Variable = GetStartPointer (mNvVariableCache)
+        ; IsValidVariableHeader (Variable, GetEndPointer (mNvVariableCache))
+        ; Variable = NextVariable
+        )
+  {
+    NextVariable = GetNextVariablePtr (Variable, AuthFormat);
+    if ((Variable->State != VAR_ADDED) && (Variable->State != (VAR_IN_DELETED_TRANSITION & VAR_ADDED))) {
+      DeletedSize += (UINTN)NextVariable - (UINTN)Variable;
+    }
+  }
+
+  return DeletedSize * 100 / (mNvVariableCache->Size - sizeof (VARIABLE_STORE_HEADER));
+}
+
+/**
+  This function reclaims variable storage if free size is below the threshold,
+  or if the fragmentation of the store is above PcdVariableReclaimFragmentationThreshold.
 
   Caution: This function may be invoked at SMM mode.
   Care must be taken to make sure not security issue.
@@ -3206,6 +3244,7 @@ ReclaimForOS (
   EFI_STATUS      Status;
   UINTN           RemainingCommonRuntimeVariableSpace;
   UINTN           RemainingHwErrVariableSpace;
+  UINTN           Fragmentation;
   STATIC BOOLEAN  Reclaimed;
 
   //
@@ -3227,13 +3266,25 @@ ReclaimForOS (
 
   RemainingHwErrVariableSpace = PcdGet32 (PcdHwErrStorageSize) - mVariableModuleGlobal->HwErrVariableTotalSize;
 
+  //
+  // Reclaim a store fragmented above the threshold while still at boot time,
+  // instead of within a runtime SetVariable() once it runs out of space.
+  //
+  Fragmentation = 0;
+  if (PcdGet8 (PcdVariableReclaimFragmentationThreshold) != 0) {
+    Fragmentation = GetNvVariableStoreFragmentation ();
+    DEBUG ((DEBUG_INFO, "Variable driver: NV variable store fragmentation %d%%\n", (UINT32)Fragmentation));
+  }
+
   //
   // Check if the free area is below a threshold.
   //
   if (((RemainingCommonRuntimeVariableSpace < mVariableModuleGlobal->MaxVariableSize) ||
        (RemainingCommonRuntimeVariableSpace < mVariableModuleGlobal->MaxAuthVariableSize)) ||
       ((PcdGet32 (PcdHwErrStorageSize) != 0) &&
-       (RemainingHwErrVariableSpace < PcdGet32 (PcdMaxHardwareErrorVariableSize))))
+       (RemainingHwErrVariableSpace < PcdGet32 (PcdMaxHardwareErrorVariableSize))) ||
+      ((PcdGet8 (PcdVariableReclaimFragmentationThreshold) != 0) &&
+       (Fragmentation >= PcdGet8 (PcdVariableReclaimFragmentationThreshold))))
   {
     Status = Reclaim (
                mVariableModuleGlobal->VariableGlobal.NonVolatileVariableBase,
@@ -3397,6 +3448,7 @@ FlushHobVariableToFlash (
         *(mVariableModuleGlobal->VariableGlobal.VariableRuntimeCacheContext.HobFlushComplete) = TRUE;
       }
 
+      DestroyVariableIndex (VariableStoreHeader);
       if (!AtRuntime ()) {
         FreePool ((VOID *)VariableStoreHeader);
       }
@@ -3796,6 +3848,20 @@ VariableCommonInitialize (
   VolatileVariableStore->Reserved  = 0;
   VolatileVariableStore->Reserved1 = 0;
 
+  //
+  // Index the variable stores for the variable lookups. The lookups just walk
+  // the stores if there is no memory for the index.
+  //
+  CreateVariableIndex (VariableStoreTypeVolatile, VolatileVariableStore, mVariableModuleGlobal->VariableGlobal.AuthFormat);
+  CreateVariableIndex (VariableStoreTypeNv, mNvVariableCache, mVariableModuleGlobal->VariableGlobal.AuthFormat);
+  if (mVariableModuleGlobal->VariableGlobal.HobVariableBase != 0) {
+    CreateVariableIndex (
+      VariableStoreTypeHob,
+      (VARIABLE_STORE_HEADER *)(UINTN)mVariableModuleGlobal->VariableGlobal.HobVariableBase,
+      mVariableModuleGlobal->VariableGlobal.AuthFormat
+      );
+  }
+
   return EFI_SUCCESS;
 }
 
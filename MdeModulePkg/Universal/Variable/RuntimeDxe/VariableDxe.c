@@ -11,8 +11,10 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 **/
 
 #include "Variable.h"
+#include "VariableParsing.h"
 
 #include <Protocol/VariablePolicy.h>
+#include <Protocol/VariableBatch.h>
 #include <Library/VariablePolicyLib.h>
 
 EFI_STATUS
@@ -21,6 +23,14 @@ ProtocolIsVariablePolicyEnabled (
   OUT BOOLEAN  *State
   );
 
+EFI_STATUS
+EFIAPI
+VariableBatchSetVariables (
+  IN CONST EDKII_VARIABLE_BATCH_PROTOCOL  *This,
+  IN       UINTN                          EntryCount,
+  IN OUT   EDKII_VARIABLE_BATCH_ENTRY     *Entries
+  );
+
 EFI_HANDLE                      mHandle                      = NULL;
 EFI_EVENT                       mVirtualAddressChangeEvent   = NULL;
 VOID                            *mFtwRegistration            = NULL;
@@ -42,6 +52,7 @@ EDKII_VAR_CHECK_PROTOCOL        mVarCheck = {
   VarCheckVariablePropertySet,
   VarCheckVariablePropertyGet
 };
+EDKII_VARIABLE_BATCH_PROTOCOL   mVariableBatch = { VariableBatchSetVariables };
 
 /**
   Some Secure Boot Policy Variable may update following other variable changes(SecureBoot follows PK change, etc).
@@ -267,6 +278,11 @@ VariableClassAddressChangeEvent (
   EfiConvertPointer (0x0, (VOID **)&mVariableModuleGlobal);
   EfiConvertPointer (0x0, (VOID **)&mNvVariableCache);
   EfiConvertPointer (0x0, (VOID **)&mNvFvHeaderCache);
+  for (Index = 0; Index < VariableStoreTypeMax; Index++) {
+    EfiConvertPointer (0x0, (VOID **)&mVariableIndex[Index].Store);
+    EfiConvertPointer (0x0, (VOID **)&mVariableIndex[Index].Buckets);
+    EfiConvertPointer (0x0, (VOID **)&mVariableIndex[Index].Entries);
+  }
 
   if (mAuthContextOut.AddressPointer != NULL) {
     for (Index = 0; Index < mAuthContextOut.AddressPointerCount; Index++) {
@@ -521,6 +537,51 @@ ProtocolIsVariablePolicyEnabled (
   return EFI_SUCCESS;
 }
 
+/**
+  Set a number of variables in one request.
+
+  @param[in]      This          The EDKII_VARIABLE_BATCH_PROTOCOL instance.
+  @param[in]      EntryCount    Number of entries in Entries.
+  @param[in, out] Entries       The variable updates. On return, the Status field
+                                of each entry holds the result of that update.
+
+  @retval EFI_SUCCESS           All the variable updates succeeded.
+  @retval EFI_INVALID_PARAMETER EntryCount is 0 or Entries is NULL.
+  @retval Others                The Status of the first entry that failed.
+
+**/
+EFI_STATUS
+EFIAPI
+VariableBatchSetVariables (
+  IN CONST EDKII_VARIABLE_BATCH_PROTOCOL  *This,
+  IN       UINTN                          EntryCount,
+  IN OUT   EDKII_VARIABLE_BATCH_ENTRY     *Entries
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Index;
+
+  if ((EntryCount == 0) || (Entries == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Status = EFI_SUCCESS;
+  for (Index = 0; Index < EntryCount; Index++) {
+    Entries[Index].Status = VariableServiceSetVariable (
+                              Entries[Index].VariableName,
+                              Entries[Index].VendorGuid,
+                              Entries[Index].Attributes,
+                              Entries[Index].DataSize,
+                              Entries[Index].Data
+                              );
+    if (EFI_ERROR (Entries[Index].Status) && !EFI_ERROR (Status)) {
+      Status = Entries[Index].Status;
+    }
+  }
+
+  return Status;
+}
+
 /**
   Variable Driver main entry point. The Variable driver places the 4 EFI
   runtime services in the EFI System Table and installs arch protocols
@@ -563,6 +624,14 @@ VariableServiceInitialize (
                   );
   ASSERT_EFI_ERROR (Status);
 
+  Status = gBS->InstallMultipleProtocolInterfaces (
+                  &mHandle,
+                  &gEdkiiVariableBatchProtocolGuid,
+                  &mVariableBatch,
+                  NULL
+                  );
+  ASSERT_EFI_ERROR (Status);
+
   SystemTable->RuntimeServices->GetVariable         = VariableServiceGetVariable;
   SystemTable->RuntimeServices->GetNextVariableName = VariableServiceGetNextVariableName;
   SystemTable->RuntimeServices->SetVariable         = VariableServiceSetVariable;
@@ -9,6 +9,11 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include "VariableParsing.h"
 
+//
+// Hash index of the volatile, HOB and non-volatile variable stores.
+//
+VARIABLE_INDEX  mVariableIndex[VariableStoreTypeMax];
+
 /**
 
   This code checks if variable header is valid or not.
@@ -445,6 +450,214 @@ VariableCompareTimeStampInternal (
   return (BOOLEAN)(FirstTime->Second <= SecondTime->Second);
 }
 
+/**
+  Compute the hash of a variable name and vendor GUID for the variable index.
+
+  @param[in]  VariableName      Name of the variable.
+  @param[in]  NameSize          Maximum size in bytes of VariableName.
+  @param[in]  VendorGuid        Vendor GUID of the variable.
+
+  @return The hash value.
+
+**/
+UINT32
+GetVariableIndexHash (
+  IN  CHAR16    *VariableName,
+  IN  UINTN     NameSize,
+  IN  EFI_GUID  *VendorGuid
+  )
+{
+  UINT32  Hash;
+  UINTN   Index;
+
+  //
+  // FNV-1a over the name characters, then the first GUID field.
+  //
+  Hash = 0x811C9DC5;
+  for (Index = 0; (Index < NameSize / sizeof (CHAR16)) && (VariableName[Index] != 0); Index++) {
+    Hash = (Hash ^ VariableName[Index]) * 0x01000193;
+  }
+
+  return (Hash ^ ReadUnaligned32 (&VendorGuid->Data1)) * 0x01000193;
+}
+
+/**
+  Get the hash index covering a variable store.
+
+  @param[in]  StartPtr          Start pointer of the variable store.
+  @param[in]  AuthFormat        TRUE indicates authenticated variables are used.
+                                FALSE indicates authenticated variables are not used.
+
+  @return The variable index, or NULL if the store is not indexed.
+
+**/
+VARIABLE_INDEX *
+GetVariableIndex (
+  IN  VARIABLE_HEADER  *StartPtr,
+  IN  BOOLEAN          AuthFormat
+  )
+{
+  UINTN  Type;
+
+  for (Type = 0; Type < VariableStoreTypeMax; Type++) {
+    if ((mVariableIndex[Type].Store != NULL) &&
+        (GetStartPointer (mVariableIndex[Type].Store) == StartPtr) &&
+        (mVariableIndex[Type].AuthFormat == AuthFormat))
+    {
+      return &mVariableIndex[Type];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Add the variables appended to the store since the last lookup to the index.
+
+  @param[in, out]  VarIndex     The variable index.
+  @param[in]       EndPtr       End pointer of the variable store.
+
+**/
+VOID
+SyncVariableIndex (
+  IN OUT VARIABLE_INDEX   *VarIndex,
+  IN     VARIABLE_HEADER  *EndPtr
+  )
+{
+  VARIABLE_HEADER       *Variable;
+  VARIABLE_INDEX_ENTRY  *Entry;
+  UINT32                Bucket;
+
+  Variable = (VARIABLE_HEADER *)((UINTN)VarIndex->Store + VarIndex->IndexedOffset);
+  while (IsValidVariableHeader (Variable, EndPtr) && (VarIndex->EntryCount < VarIndex->MaxEntryCount)) {
+    Entry         = &VarIndex->Entries[VarIndex->EntryCount];
+    Entry->Hash   = GetVariableIndexHash (
+                      GetVariableNamePtr (Variable, VarIndex->AuthFormat),
+                      NameSizeOfVariable (Variable, VarIndex->AuthFormat),
+                      GetVendorGuidPtr (Variable, VarIndex->AuthFormat)
+                      );
+    Entry->Offset = VarIndex->IndexedOffset;
+    Bucket        = Entry->Hash & (VarIndex->BucketCount - 1);
+    Entry->Next   = VarIndex->Buckets[Bucket];
+    VarIndex->EntryCount++;
+    VarIndex->Buckets[Bucket] = VarIndex->EntryCount;
+
+    Variable                = GetNextVariablePtr (Variable, VarIndex->AuthFormat);
+    VarIndex->IndexedOffset = (UINT32)((UINTN)Variable - (UINTN)VarIndex->Store);
+  }
+}
+
+/**
+  Check whether a variable matches a lookup of FindVariableEx().
+
+  @param[in]  Variable          Pointer to the variable header.
+  @param[in]  VariableName      Name of the variable to be found.
+  @param[in]  VendorGuid        Vendor GUID to be found.
+  @param[in]  IgnoreRtCheck     Ignore EFI_VARIABLE_RUNTIME_ACCESS attribute
+                                check at runtime when searching variable.
+  @param[in]  AuthFormat        TRUE indicates authenticated variables are used.
+                                FALSE indicates authenticated variables are not used.
+
+  @retval TRUE                  The variable is ADDED or IN_DELETED_TRANSITION and matches.
+  @retval FALSE                 The variable doesn't match.
+
+**/
+BOOLEAN
+IsMatchedVariable (
+  IN  VARIABLE_HEADER  *Variable,
+  IN  CHAR16           *VariableName,
+  IN  EFI_GUID         *VendorGuid,
+  IN  BOOLEAN          IgnoreRtCheck,
+  IN  BOOLEAN          AuthFormat
+  )
+{
+  if ((Variable->State != VAR_ADDED) && (Variable->State != (VAR_IN_DELETED_TRANSITION & VAR_ADDED))) {
+    return FALSE;
+  }
+
+  if (!IgnoreRtCheck && AtRuntime () && ((Variable->Attributes & EFI_VARIABLE_RUNTIME_ACCESS) == 0)) {
+    return FALSE;
+  }
+
+  if (!CompareGuid (VendorGuid, GetVendorGuidPtr (Variable, AuthFormat))) {
+    return FALSE;
+  }
+
+  ASSERT (NameSizeOfVariable (Variable, AuthFormat) != 0);
+  return (BOOLEAN)(CompareMem (VariableName, GetVariableNamePtr (Variable, AuthFormat), NameSizeOfVariable (Variable, AuthFormat)) == 0);
+}
+
+/**
+  Look up a variable in the hash index of its store, with the same result as
+  walking the indexed part of the store in FindVariableEx().
+
+  @param[in, out]  VarIndex           The variable index.
+  @param[in]       VariableName       Name of the variable to be found.
+  @param[in]       VendorGuid         Vendor GUID to be found.
+  @param[in]       IgnoreRtCheck      Ignore EFI_VARIABLE_RUNTIME_ACCESS attribute
+                                      check at runtime when searching variable.
+  @param[in, out]  PtrTrack           Variable Track Pointer structure that contains Variable Information.
+  @param[out]      InDeletedVariable  The last matched IN_DELETED_TRANSITION variable if no ADDED
+                                      one is indexed.
+
+  @retval TRUE                        The ADDED variable is found and PtrTrack is updated.
+  @retval FALSE                       The ADDED variable is not in the indexed part of the store.
+
+**/
+BOOLEAN
+FindVariableInIndex (
+  IN OUT VARIABLE_INDEX          *VarIndex,
+  IN     CHAR16                  *VariableName,
+  IN     EFI_GUID                *VendorGuid,
+  IN     BOOLEAN                 IgnoreRtCheck,
+  IN OUT VARIABLE_POINTER_TRACK  *PtrTrack,
+  OUT    VARIABLE_HEADER         **InDeletedVariable
+  )
+{
+  UINT32                Hash;
+  UINT32                Next;
+  VARIABLE_INDEX_ENTRY  *Entry;
+  VARIABLE_HEADER       *Variable;
+  VARIABLE_HEADER       *AddedVariable;
+
+  SyncVariableIndex (VarIndex, PtrTrack->EndPtr);
+
+  //
+  // A bucket chains its entries from the highest offset to the lowest. Take the
+  // first ADDED variable in store order, and the last IN_DELETED_TRANSITION one
+  // before it, as walking the store would.
+  //
+  Hash               = GetVariableIndexHash (VariableName, StrSize (VariableName), VendorGuid);
+  AddedVariable      = NULL;
+  *InDeletedVariable = NULL;
+  for (Next = VarIndex->Buckets[Hash & (VarIndex->BucketCount - 1)]; Next != 0; Next = Entry->Next) {
+    Entry = &VarIndex->Entries[Next - 1];
+    if (Entry->Hash != Hash) {
+      continue;
+    }
+
+    Variable = (VARIABLE_HEADER *)((UINTN)VarIndex->Store + Entry->Offset);
+    if (!IsMatchedVariable (Variable, VariableName, VendorGuid, IgnoreRtCheck, VarIndex->AuthFormat)) {
+      continue;
+    }
+
+    if (Variable->State == VAR_ADDED) {
+      AddedVariable      = Variable;
+      *InDeletedVariable = NULL;
+    } else if ((*InDeletedVariable == NULL) && ((AddedVariable == NULL) || (Variable < AddedVariable))) {
+      *InDeletedVariable = Variable;
+    }
+  }
+
+  if (AddedVariable == NULL) {
+    return FALSE;
+  }
+
+  PtrTrack->CurrPtr                = AddedVariable;
+  PtrTrack->InDeletedTransitionPtr = *InDeletedVariable;
+  return TRUE;
+}
+
 /**
   Find the variable in the specified variable store.
 
@@ -469,6 +682,8 @@ FindVariableEx (
   )
 {
   VARIABLE_HEADER  *InDeletedVariable;
+  VARIABLE_HEADER  *ScanStartPtr;
+  VARIABLE_INDEX   *VarIndex;
   VOID             *Point;
 
   PtrTrack->InDeletedTransitionPtr = NULL;
@@ -477,8 +692,24 @@ FindVariableEx (
   // Find the variable by walk through HOB, volatile and non-volatile variable store.
   //
   InDeletedVariable = NULL;
+  ScanStartPtr      = PtrTrack->StartPtr;
+
+  //
+  // Look up a named variable in the hash index of the store first, only the
+  // variables the index has no room for are left to walk through.
+  //
+  if (VariableName[0] != 0) {
+    VarIndex = GetVariableIndex (PtrTrack->StartPtr, AuthFormat);
+    if (VarIndex != NULL) {
+      if (FindVariableInIndex (VarIndex, VariableName, VendorGuid, IgnoreRtCheck, PtrTrack, &InDeletedVariable)) {
+        return EFI_SUCCESS;
+      }
 
-  for ( PtrTrack->CurrPtr = PtrTrack->StartPtr
+      ScanStartPtr = (VARIABLE_HEADER *)((UINTN)VarIndex->Store + VarIndex->IndexedOffset);
+    }
+  }
+
+  for ( PtrTrack->CurrPtr = ScanStartPtr
         ; IsValidVariableHeader (PtrTrack->CurrPtr, PtrTrack->EndPtr)
         ; PtrTrack->CurrPtr = GetNextVariablePtr (PtrTrack->CurrPtr, AuthFormat)
         )
@@ -518,6 +749,119 @@ FindVariableEx (
   return (PtrTrack->CurrPtr  == NULL) ? EFI_NOT_FOUND : EFI_SUCCESS;
 }
 
+/**
+  Create the hash index of a variable store, so that FindVariableEx() can look
+  up a variable by name and GUID without walking the store.
+
+  @param[in]  Type              The type of the variable store.
+  @param[in]  Store             Pointer to the variable store header.
+  @param[in]  AuthFormat        TRUE indicates authenticated variables are used.
+                                FALSE indicates authenticated variables are not used.
+
+  @retval EFI_SUCCESS           The index is created.
+  @retval EFI_OUT_OF_RESOURCES  No enough memory for the index.
+
+**/
+EFI_STATUS
+CreateVariableIndex (
+  IN  VARIABLE_STORE_TYPE    Type,
+  IN  VARIABLE_STORE_HEADER  *Store,
+  IN  BOOLEAN                AuthFormat
+  )
+{
+  VARIABLE_INDEX  *VarIndex;
+  UINT32          MaxEntryCount;
+  UINT32          BucketCount;
+
+  ASSERT (Type < VariableStoreTypeMax);
+  VarIndex = &mVariableIndex[Type];
+  DestroyVariableIndex (VarIndex->Store);
+
+  //
+  // Size the index for a store full of variables with short names and data. If
+  // the store holds more, the variables past the last entry are still found by
+  // walking the store.
+  //
+  MaxEntryCount = Store->Size / (UINT32)(GetVariableHeaderSize (AuthFormat) + VARIABLE_INDEX_MIN_PAYLOAD_SIZE);
+  BucketCount   = (UINT32)GetPowerOfTwo32 (MAX (MaxEntryCount, 2) - 1) << 1;
+
+  VarIndex->Buckets = AllocateRuntimeZeroPool (BucketCount * sizeof (UINT32));
+  VarIndex->Entries = AllocateRuntimePool (MaxEntryCount * sizeof (VARIABLE_INDEX_ENTRY));
+  if ((VarIndex->Buckets == NULL) || (VarIndex->Entries == NULL)) {
+    if (VarIndex->Buckets != NULL) {
+      FreePool (VarIndex->Buckets);
+    }
+
+    if (VarIndex->Entries != NULL) {
+      FreePool (VarIndex->Entries);
+    }
+
+    ZeroMem (VarIndex, sizeof (VARIABLE_INDEX));
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  VarIndex->AuthFormat    = AuthFormat;
+  VarIndex->BucketCount   = BucketCount;
+  VarIndex->MaxEntryCount = MaxEntryCount;
+  VarIndex->EntryCount    = 0;
+  VarIndex->IndexedOffset = (UINT32)((UINTN)GetStartPointer (Store) - (UINTN)Store);
+  VarIndex->Store         = Store;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Drop all the entries of the hash index of a variable store. It must be called
+  whenever variables are moved in the store, for example by reclaim.
+
+  @param[in]  Store             Pointer to the variable store header.
+
+**/
+VOID
+ResetVariableIndex (
+  IN  VARIABLE_STORE_HEADER  *Store
+  )
+{
+  UINTN           Type;
+  VARIABLE_INDEX  *VarIndex;
+
+  for (Type = 0; Type < VariableStoreTypeMax; Type++) {
+    VarIndex = &mVariableIndex[Type];
+    if ((Store != NULL) && (VarIndex->Store == Store)) {
+      ZeroMem (VarIndex->Buckets, VarIndex->BucketCount * sizeof (UINT32));
+      VarIndex->EntryCount    = 0;
+      VarIndex->IndexedOffset = (UINT32)((UINTN)GetStartPointer (Store) - (UINTN)Store);
+    }
+  }
+}
+
+/**
+  Stop indexing a variable store, and free the index at boot time.
+
+  @param[in]  Store             Pointer to the variable store header.
+
+**/
+VOID
+DestroyVariableIndex (
+  IN  VARIABLE_STORE_HEADER  *Store
+  )
+{
+  UINTN           Type;
+  VARIABLE_INDEX  *VarIndex;
+
+  for (Type = 0; Type < VariableStoreTypeMax; Type++) {
+    VarIndex = &mVariableIndex[Type];
+    if ((Store != NULL) && (VarIndex->Store == Store)) {
+      VarIndex->Store = NULL;
+      if (!AtRuntime ()) {
+        FreePool (VarIndex->Buckets);
+        FreePool (VarIndex->Entries);
+        ZeroMem (VarIndex, sizeof (VARIABLE_INDEX));
+      }
+    }
+  }
+}
+
 /**
   This code finds the next available variable.
 
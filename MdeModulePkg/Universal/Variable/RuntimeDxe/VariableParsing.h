@@ -13,6 +13,39 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Guid/ImageAuthentication.h>
 #include "Variable.h"
 
+///
+/// One variable in the hash index of a variable store.
+///
+typedef struct {
+  UINT32    Hash;
+  UINT32    Offset;                 ///< Offset of the variable header from the store header.
+  UINT32    Next;                   ///< Index + 1 of the next entry in the bucket, 0 ends the chain.
+} VARIABLE_INDEX_ENTRY;
+
+///
+/// Name and GUID hash index over the variables of a variable store. The variables
+/// before IndexedOffset are indexed; the ones appended past it are added on the
+/// next lookup.
+///
+typedef struct {
+  VARIABLE_STORE_HEADER    *Store;
+  BOOLEAN                  AuthFormat;
+  UINT32                   IndexedOffset;
+  UINT32                   BucketCount;
+  UINT32                   *Buckets;
+  UINT32                   EntryCount;
+  UINT32                   MaxEntryCount;
+  VARIABLE_INDEX_ENTRY     *Entries;
+} VARIABLE_INDEX;
+
+extern VARIABLE_INDEX  mVariableIndex[VariableStoreTypeMax];
+
+//
+// The smallest name and data size in bytes a variable store is sized in the
+// index for.
+//
+#define VARIABLE_INDEX_MIN_PAYLOAD_SIZE  16
+
 /**
 
   This code checks if variable header is valid or not.
@@ -280,6 +313,49 @@ FindVariableEx (
   IN     BOOLEAN                 AuthFormat
   );
 
+/**
+  Create the hash index of a variable store, so that FindVariableEx() can look
+  up a variable by name and GUID without walking the store.
+
+  @param[in]  Type              The type of the variable store.
+  @param[in]  Store             Pointer to the variable store header.
+  @param[in]  AuthFormat        TRUE indicates authenticated variables are used.
+                                FALSE indicates authenticated variables are not used.
+
+  @retval EFI_SUCCESS           The index is created.
+  @retval EFI_OUT_OF_RESOURCES  No enough memory for the index.
+
+**/
+EFI_STATUS
+CreateVariableIndex (
+  IN  VARIABLE_STORE_TYPE    Type,
+  IN  VARIABLE_STORE_HEADER  *Store,
+  IN  BOOLEAN                AuthFormat
+  );
+
+/**
+  Drop all the entries of the hash index of a variable store. It must be called
+  whenever variables are moved in the store, for example by reclaim.
+
+  @param[in]  Store             Pointer to the variable store header.
+
+**/
+VOID
+ResetVariableIndex (
+  IN  VARIABLE_STORE_HEADER  *Store
+  );
+
+/**
+  Stop indexing a variable store, and free the index at boot time.
+
+  @param[in]  Store             Pointer to the variable store header.
+
+**/
+VOID
+DestroyVariableIndex (
+  IN  VARIABLE_STORE_HEADER  *Store
+  );
+
 /**
   This code finds the next available variable.
 
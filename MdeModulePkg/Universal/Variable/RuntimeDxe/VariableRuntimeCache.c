@@ -42,6 +42,14 @@ FlushPendingRuntimeVariableCacheUpdates (
   }
 
   if (*(VariableRuntimeCacheContext->PendingUpdate)) {
+    if (VariableRuntimeCacheContext->Sequence != NULL) {
+      //
+      // An odd sequence tells the runtime cache readers that an update is in progress.
+      //
+      *(VariableRuntimeCacheContext->Sequence) += 1;
+      MemoryFence ();
+    }
+
     if ((VariableRuntimeCacheContext->VariableRuntimeHobCache.Store != NULL) &&
         (mVariableModuleGlobal->VariableGlobal.HobVariableBase > 0))
     {
@@ -88,6 +96,11 @@ FlushPendingRuntimeVariableCacheUpdates (
     VariableRuntimeCacheContext->VariableRuntimeVolatileCache.PendingUpdateLength = 0;
     VariableRuntimeCacheContext->VariableRuntimeVolatileCache.PendingUpdateOffset = 0;
     *(VariableRuntimeCacheContext->PendingUpdate)                                 = FALSE;
+
+    if (VariableRuntimeCacheContext->Sequence != NULL) {
+      MemoryFence ();
+      *(VariableRuntimeCacheContext->Sequence) += 1;
+    }
   }
 
   return EFI_SUCCESS;
@@ -96,10 +109,12 @@ FlushPendingRuntimeVariableCacheUpdates (
 /**
   Synchronizes the runtime variable caches with all pending updates outside runtime.
 
-  Ensures all conditions are met to maintain coherency for runtime cache updates. This function will attempt
-  to write the given update (and any other pending updates) if the ReadLock is available. Otherwise, the
-  update is added as a pending update for the given variable store and it will be flushed to the runtime cache
-  at the next opportunity the ReadLock is available.
+  Ensures all conditions are met to maintain coherency for runtime cache updates. Only the given range of the
+  variable store is copied. When the runtime cache sequence is available, the update (and any other pending
+  updates) is written right away and a reader interrupted by it retries its lookup. Otherwise, this function
+  will attempt to write the update if the ReadLock is available, or the update is added as a pending update
+  for the given variable store and it will be flushed to the runtime cache at the next opportunity the
+  ReadLock is available.
 
   @param[in] VariableRuntimeCache Variable runtime cache structure for the runtime cache being synchronized.
   @param[in] Offset               Offset in bytes to apply the update.
@@ -150,7 +165,9 @@ SynchronizeRuntimeVariableCache (
 
   *(mVariableModuleGlobal->VariableGlobal.VariableRuntimeCacheContext.PendingUpdate) = TRUE;
 
-  if (*(mVariableModuleGlobal->VariableGlobal.VariableRuntimeCacheContext.ReadLock) == FALSE) {
+  if ((mVariableModuleGlobal->VariableGlobal.VariableRuntimeCacheContext.Sequence != NULL) ||
+      (*(mVariableModuleGlobal->VariableGlobal.VariableRuntimeCacheContext.ReadLock) == FALSE))
+  {
     return FlushPendingRuntimeVariableCacheUpdates ();
   }
 
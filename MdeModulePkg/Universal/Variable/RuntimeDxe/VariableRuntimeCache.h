@@ -27,10 +27,12 @@ FlushPendingRuntimeVariableCacheUpdates (
 /**
   Synchronizes the runtime variable caches with all pending updates outside runtime.
 
-  Ensures all conditions are met to maintain coherency for runtime cache updates. This function will attempt
-  to write the given update (and any other pending updates) if the ReadLock is available. Otherwise, the
-  update is added as a pending update for the given variable store and it will be flushed to the runtime cache
-  at the next opportunity the ReadLock is available.
+  Ensures all conditions are met to maintain coherency for runtime cache updates. Only the given range of the
+  variable store is copied. When the runtime cache sequence is available, the update (and any other pending
+  updates) is written right away and a reader interrupted by it retries its lookup. Otherwise, this function
+  will attempt to write the update if the ReadLock is available, or the update is added as a pending update
+  for the given variable store and it will be flushed to the runtime cache at the next opportunity the
+  ReadLock is available.
 
   @param[in] VariableRuntimeCache Variable runtime cache structure for the runtime cache being synchronized.
   @param[in] Offset               Offset in bytes to apply the update.
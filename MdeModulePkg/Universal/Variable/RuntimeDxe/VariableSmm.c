@@ -25,6 +25,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Protocol/SmmFaultTolerantWrite.h>
 #include <Protocol/MmEndOfDxe.h>
 #include <Protocol/SmmVarCheck.h>
+#include <Protocol/SmiHandlerAttribute.h>
 
 #include <Library/MmServicesTableLib.h>
 #include <Library/VariablePolicyLib.h>
@@ -467,6 +468,8 @@ SmmVariableHandler (
   SMM_VARIABLE_COMMUNICATE_GET_PAYLOAD_SIZE                *GetPayloadSize;
   SMM_VARIABLE_COMMUNICATE_RUNTIME_VARIABLE_CACHE_CONTEXT  *RuntimeVariableCacheContext;
   SMM_VARIABLE_COMMUNICATE_GET_RUNTIME_CACHE_INFO          *GetRuntimeCacheInfo;
+  SMM_VARIABLE_COMMUNICATE_SET_VARIABLE_BATCH              *SetVariableBatch;
+  SMM_VARIABLE_COMMUNICATE_BATCH_ENTRY                     *BatchEntry;
   SMM_VARIABLE_COMMUNICATE_LOCK_VARIABLE                   *VariableToLock;
   SMM_VARIABLE_COMMUNICATE_VAR_CHECK_VARIABLE_PROPERTY     *CommVariableProperty;
   VARIABLE_INFO_ENTRY                                      *VariableInfo;
@@ -476,6 +479,9 @@ SmmVariableHandler (
   UINTN                                                    NameBufferSize;
   UINTN                                                    CommBufferPayloadSize;
   UINTN                                                    TempCommBufferSize;
+  UINTN                                                    BatchIndex;
+  UINTN                                                    BatchOffset;
+  EFI_STATUS                                               BatchStatus;
 
   //
   // If input is invalid, stop processing this SMI
@@ -665,6 +671,86 @@ SmmVariableHandler (
                  );
       break;
 
+    case SMM_VARIABLE_FUNCTION_SET_VARIABLE_BATCH:
+      if (CommBufferPayloadSize < sizeof (SMM_VARIABLE_COMMUNICATE_SET_VARIABLE_BATCH)) {
+        DEBUG ((DEBUG_ERROR, "SetVariableBatch: SMM communication buffer size invalid!\n"));
+        return EFI_SUCCESS;
+      }
+
+      //
+      // Copy the input communicate buffer payload to pre-allocated SMM variable buffer payload.
+      // The status of each entry is returned in the original communicate buffer.
+      //
+      CopyMem (mVariableBufferPayload, SmmVariableFunctionHeader->Data, CommBufferPayloadSize);
+      SetVariableBatch = (SMM_VARIABLE_COMMUNICATE_SET_VARIABLE_BATCH *)mVariableBufferPayload;
+      BatchOffset      = sizeof (SMM_VARIABLE_COMMUNICATE_SET_VARIABLE_BATCH);
+      Status           = EFI_SUCCESS;
+      for (BatchIndex = 0; BatchIndex < SetVariableBatch->Count; BatchIndex++) {
+        if ((BatchOffset > CommBufferPayloadSize) ||
+            (CommBufferPayloadSize - BatchOffset < OFFSET_OF (SMM_VARIABLE_COMMUNICATE_BATCH_ENTRY, Name)))
+        {
+          DEBUG ((DEBUG_ERROR, "SetVariableBatch: Entry exceed communication buffer size limit!\n"));
+          Status = EFI_ACCESS_DENIED;
+          goto EXIT;
+        }
+
+        BatchEntry = (SMM_VARIABLE_COMMUNICATE_BATCH_ENTRY *)(mVariableBufferPayload + BatchOffset);
+        if ((BatchEntry->DataSize > CommBufferPayloadSize) || (BatchEntry->NameSize > CommBufferPayloadSize)) {
+          //
+          // Prevent InfoSize overflow happen
+          //
+          Status = EFI_ACCESS_DENIED;
+          goto EXIT;
+        }
+
+        InfoSize = OFFSET_OF (SMM_VARIABLE_COMMUNICATE_BATCH_ENTRY, Name)
+                   + BatchEntry->DataSize + BatchEntry->NameSize;
+
+        //
+        // SMRAM range check already covered before
+        // Data buffer should not contain SMM range
+        //
+        if (InfoSize > CommBufferPayloadSize - BatchOffset) {
+          DEBUG ((DEBUG_ERROR, "SetVariableBatch: Data size exceed communication buffer size limit!\n"));
+          Status = EFI_ACCESS_DENIED;
+          goto EXIT;
+        }
+
+        //
+        // The VariableSpeculationBarrier() call here is to ensure the previous
+        // range/content checks for the CommBuffer have been completed before the
+        // subsequent consumption of the CommBuffer content.
+        //
+        VariableSpeculationBarrier ();
+        if ((BatchEntry->NameSize < sizeof (CHAR16)) || (BatchEntry->Name[BatchEntry->NameSize/sizeof (CHAR16) - 1] != L'\0')) {
+          //
+          // Make sure VariableName is A Null-terminated string.
+          //
+          BatchStatus = EFI_ACCESS_DENIED;
+        } else {
+          //
+          // Each entry goes through the same VarCheck and variable policy checks
+          // as a single SetVariable() request.
+          //
+          BatchStatus = VariableServiceSetVariable (
+                          BatchEntry->Name,
+                          &BatchEntry->Guid,
+                          BatchEntry->Attributes,
+                          BatchEntry->DataSize,
+                          (UINT8 *)BatchEntry->Name + BatchEntry->NameSize
+                          );
+        }
+
+        ((SMM_VARIABLE_COMMUNICATE_BATCH_ENTRY *)(SmmVariableFunctionHeader->Data + BatchOffset))->Status = BatchStatus;
+        if (EFI_ERROR (BatchStatus) && !EFI_ERROR (Status)) {
+          Status = BatchStatus;
+        }
+
+        BatchOffset += ALIGN_VALUE (InfoSize, sizeof (UINTN));
+      }
+
+      break;
+
     case SMM_VARIABLE_FUNCTION_QUERY_VARIABLE_INFO:
       if (CommBufferPayloadSize < sizeof (SMM_VARIABLE_COMMUNICATE_QUERY_VARIABLE_INFO)) {
         DEBUG ((DEBUG_ERROR, "QueryVariableInfo: SMM communication buffer size invalid!\n"));
@@ -840,7 +926,8 @@ SmmVariableHandler (
           (RuntimeVariableCacheContext->RuntimeNvCache == NULL) ||
           (RuntimeVariableCacheContext->PendingUpdate == NULL) ||
           (RuntimeVariableCacheContext->ReadLock == NULL) ||
-          (RuntimeVariableCacheContext->HobFlushComplete == NULL))
+          (RuntimeVariableCacheContext->HobFlushComplete == NULL) ||
+          (RuntimeVariableCacheContext->Sequence == NULL))
       {
         DEBUG ((DEBUG_ERROR, "InitRuntimeVariableCacheContext: Required runtime cache buffer is NULL!\n"));
         Status = EFI_ACCESS_DENIED;
@@ -924,6 +1011,16 @@ SmmVariableHandler (
         goto EXIT;
       }
 
+      if (!VariableSmmIsNonPrimaryBufferValid (
+             (UINTN)RuntimeVariableCacheContext->Sequence,
+             sizeof (*(RuntimeVariableCacheContext->Sequence))
+             ))
+      {
+        DEBUG ((DEBUG_ERROR, "InitRuntimeVariableCacheContext: Runtime cache sequence buffer in SMRAM or overflow!\n"));
+        Status = EFI_ACCESS_DENIED;
+        goto EXIT;
+      }
+
       VariableCacheContext                                     = &mVariableModuleGlobal->VariableGlobal.VariableRuntimeCacheContext;
       VariableCacheContext->VariableRuntimeHobCache.Store      = RuntimeVariableCacheContext->RuntimeHobCache;
       VariableCacheContext->VariableRuntimeVolatileCache.Store = RuntimeVariableCacheContext->RuntimeVolatileCache;
@@ -931,6 +1028,7 @@ SmmVariableHandler (
       VariableCacheContext->PendingUpdate                      = RuntimeVariableCacheContext->PendingUpdate;
       VariableCacheContext->ReadLock                           = RuntimeVariableCacheContext->ReadLock;
       VariableCacheContext->HobFlushComplete                   = RuntimeVariableCacheContext->HobFlushComplete;
+      VariableCacheContext->Sequence                           = RuntimeVariableCacheContext->Sequence;
 
       // Set up the intial pending request since the RT cache needs to be in sync with SMM cache
       VariableCacheContext->VariableRuntimeHobCache.PendingUpdateOffset = 0;
@@ -956,6 +1054,7 @@ SmmVariableHandler (
       *(VariableCacheContext->PendingUpdate)    = TRUE;
       *(VariableCacheContext->ReadLock)         = FALSE;
       *(VariableCacheContext->HobFlushComplete) = FALSE;
+      *(VariableCacheContext->Sequence)         = 0;
 
       Status = EFI_SUCCESS;
       break;
@@ -1152,10 +1251,11 @@ MmVariableServiceInitialize (
   VOID
   )
 {
-  EFI_STATUS  Status;
-  EFI_HANDLE  VariableHandle;
-  VOID        *SmmFtwRegistration;
-  VOID        *SmmEndOfDxeRegistration;
+  EFI_STATUS                            Status;
+  EFI_HANDLE                            VariableHandle;
+  VOID                                  *SmmFtwRegistration;
+  VOID                                  *SmmEndOfDxeRegistration;
+  EDKII_SMI_HANDLER_ATTRIBUTE_PROTOCOL  *SmiHandlerAttribute;
 
   //
   // Variable initialize.
@@ -1201,6 +1301,15 @@ MmVariableServiceInitialize (
   Status         = gMmst->MmiHandlerRegister (SmmVariableHandler, &gEfiSmmVariableProtocolGuid, &VariableHandle);
   ASSERT_EFI_ERROR (Status);
 
+  //
+  // The variable services only run on BSP, so the APs may leave SMM early if
+  // the SMM Core and the SMM CPU driver support it.
+  //
+  Status = gMmst->MmLocateProtocol (&gEdkiiSmiHandlerAttributeProtocolGuid, NULL, (VOID **)&SmiHandlerAttribute);
+  if (!EFI_ERROR (Status)) {
+    SmiHandlerAttribute->SetAttributes (SmiHandlerAttribute, VariableHandle, EDKII_SMI_HANDLER_ATTRIBUTE_BSP_ONLY);
+  }
+
   //
   // Notify the variable wrapper driver the variable service is ready
   //
@@ -25,6 +25,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Protocol/SmmVariable.h>
 #include <Protocol/VariableLock.h>
 #include <Protocol/VarCheck.h>
+#include <Protocol/VariableBatch.h>
 
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiRuntimeServicesTableLib.h>
@@ -57,6 +58,7 @@ BOOLEAN                         mVariableAuthFormat;
 EFI_LOCK                        mVariableServicesLock;
 EDKII_VARIABLE_LOCK_PROTOCOL    mVariableLock;
 EDKII_VAR_CHECK_PROTOCOL        mVarCheck;
+EDKII_VARIABLE_BATCH_PROTOCOL   mVariableBatch;
 VARIABLE_RUNTIME_CACHE_INFO     mVariableRtCacheInfo;
 BOOLEAN                         mIsRuntimeCacheEnabled = FALSE;
 
@@ -513,6 +515,57 @@ CheckForRuntimeCacheSync (
   }
 }
 
+/**
+  Returns the runtime cache sequence to validate a runtime cache lookup against.
+
+  SMM always completes an update of the runtime cache before the interrupted code resumes. An odd
+  sequence can only be seen by a processor that was not pulled into SMM for the update.
+
+  @param[in] CacheInfoFlag  The runtime cache information flags.
+
+  @return The even runtime cache sequence at the start of the lookup.
+
+**/
+UINT32
+BeginRuntimeCacheRead (
+  IN CACHE_INFO_FLAG  *CacheInfoFlag
+  )
+{
+  UINT32  Sequence;
+
+  while (TRUE) {
+    Sequence = *(volatile UINT32 *)&CacheInfoFlag->Sequence;
+    if ((Sequence & BIT0) == 0) {
+      break;
+    }
+
+    CpuPause ();
+  }
+
+  MemoryFence ();
+  return Sequence;
+}
+
+/**
+  Checks whether SMM updated the runtime cache since BeginRuntimeCacheRead ().
+
+  @param[in] CacheInfoFlag  The runtime cache information flags.
+  @param[in] Sequence       The sequence returned by BeginRuntimeCacheRead ().
+
+  @retval TRUE              The runtime cache was updated, the lookup must be retried.
+  @retval FALSE             The lookup was done on a consistent runtime cache.
+
+**/
+BOOLEAN
+RetryRuntimeCacheRead (
+  IN CACHE_INFO_FLAG  *CacheInfoFlag,
+  IN UINT32           Sequence
+  )
+{
+  MemoryFence ();
+  return (BOOLEAN)(*(volatile UINT32 *)&CacheInfoFlag->Sequence != Sequence);
+}
+
 /**
   Finds the given variable in a runtime cache variable store.
 
@@ -542,20 +595,23 @@ FindVariableInRuntimeCache (
 {
   EFI_STATUS              Status;
   UINTN                   TempDataSize;
+  UINT32                  TempAttributes;
+  UINT32                  Sequence;
+  UINT8                   *DataPtr;
   VARIABLE_POINTER_TRACK  RtPtrTrack;
   VARIABLE_STORE_TYPE     StoreType;
   VARIABLE_STORE_HEADER   *VariableStoreList[VariableStoreTypeMax];
   CACHE_INFO_FLAG         *CacheInfoFlag;
 
-  Status        = EFI_NOT_FOUND;
-  CacheInfoFlag = (CACHE_INFO_FLAG *)(UINTN)mVariableRtCacheInfo.CacheInfoFlagBuffer;
+  Status         = EFI_NOT_FOUND;
+  TempDataSize   = 0;
+  TempAttributes = 0;
+  CacheInfoFlag  = (CACHE_INFO_FLAG *)(UINTN)mVariableRtCacheInfo.CacheInfoFlagBuffer;
 
   if ((VariableName == NULL) || (VendorGuid == NULL) || (DataSize == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
 
-  ZeroMem (&RtPtrTrack, sizeof (RtPtrTrack));
-
   //
   // The UEFI specification restricts Runtime Services callers from invoking the same or certain other Runtime Service
   // functions prior to completion and return from a previous Runtime Service call. These restrictions prevent
@@ -577,56 +633,66 @@ FindVariableInRuntimeCache (
     VariableStoreList[VariableStoreTypeHob]      = (VARIABLE_STORE_HEADER *)(UINTN)mVariableRtCacheInfo.RuntimeHobCacheBuffer;
     VariableStoreList[VariableStoreTypeNv]       = (VARIABLE_STORE_HEADER *)(UINTN)mVariableRtCacheInfo.RuntimeNvCacheBuffer;
 
-    for (StoreType = (VARIABLE_STORE_TYPE)0; StoreType < VariableStoreTypeMax; StoreType++) {
-      if (VariableStoreList[StoreType] == NULL) {
-        continue;
-      }
+    //
+    // SMM may update the runtime cache while the lookup is in progress. The lookup is
+    // repeated until it was done without an update in between.
+    //
+    do {
+      Sequence = BeginRuntimeCacheRead (CacheInfoFlag);
+      Status   = EFI_NOT_FOUND;
+      ZeroMem (&RtPtrTrack, sizeof (RtPtrTrack));
+
+      for (StoreType = (VARIABLE_STORE_TYPE)0; StoreType < VariableStoreTypeMax; StoreType++) {
+        if (VariableStoreList[StoreType] == NULL) {
+          continue;
+        }
 
-      RtPtrTrack.StartPtr = GetStartPointer (VariableStoreList[StoreType]);
-      RtPtrTrack.EndPtr   = GetEndPointer (VariableStoreList[StoreType]);
-      RtPtrTrack.Volatile = (BOOLEAN)(StoreType == VariableStoreTypeVolatile);
+        RtPtrTrack.StartPtr = GetStartPointer (VariableStoreList[StoreType]);
+        RtPtrTrack.EndPtr   = GetEndPointer (VariableStoreList[StoreType]);
+        RtPtrTrack.Volatile = (BOOLEAN)(StoreType == VariableStoreTypeVolatile);
 
-      Status = FindVariableEx (VariableName, VendorGuid, FALSE, &RtPtrTrack, mVariableAuthFormat);
-      if (!EFI_ERROR (Status)) {
-        break;
+        Status = FindVariableEx (VariableName, VendorGuid, FALSE, &RtPtrTrack, mVariableAuthFormat);
+        if (!EFI_ERROR (Status)) {
+          break;
+        }
       }
-    }
 
-    if (!EFI_ERROR (Status)) {
-      //
-      // Get data size
-      //
-      TempDataSize = DataSizeOfVariable (RtPtrTrack.CurrPtr, mVariableAuthFormat);
-      ASSERT (TempDataSize != 0);
-
-      if (*DataSize >= TempDataSize) {
-        if (Data == NULL) {
-          Status = EFI_INVALID_PARAMETER;
-          goto Done;
+      if (!EFI_ERROR (Status)) {
+        //
+        // Get data size. A variable interrupted by an update may not lie within its store.
+        //
+        TempDataSize   = DataSizeOfVariable (RtPtrTrack.CurrPtr, mVariableAuthFormat);
+        TempAttributes = RtPtrTrack.CurrPtr->Attributes;
+        DataPtr        = GetVariableDataPtr (RtPtrTrack.CurrPtr, mVariableAuthFormat);
+        if ((TempDataSize == 0) || ((UINTN)DataPtr > (UINTN)RtPtrTrack.EndPtr) ||
+            (TempDataSize > (UINTN)RtPtrTrack.EndPtr - (UINTN)DataPtr))
+        {
+          Status = EFI_NOT_FOUND;
+        } else if (*DataSize >= TempDataSize) {
+          if (Data == NULL) {
+            Status = EFI_INVALID_PARAMETER;
+          } else {
+            CopyMem (Data, DataPtr, TempDataSize);
+            Status = EFI_SUCCESS;
+          }
+        } else {
+          Status = EFI_BUFFER_TOO_SMALL;
         }
+      }
+    } while (RetryRuntimeCacheRead (CacheInfoFlag, Sequence));
 
-        CopyMem (Data, GetVariableDataPtr (RtPtrTrack.CurrPtr, mVariableAuthFormat), TempDataSize);
-        *DataSize = TempDataSize;
+    if ((Status == EFI_SUCCESS) || (Status == EFI_BUFFER_TOO_SMALL)) {
+      *DataSize = TempDataSize;
+      if (Attributes != NULL) {
+        *Attributes = TempAttributes;
+      }
 
+      if (Status == EFI_SUCCESS) {
         UpdateVariableInfo (VariableName, VendorGuid, RtPtrTrack.Volatile, TRUE, FALSE, FALSE, TRUE, &mVariableInfo);
-
-        Status = EFI_SUCCESS;
-        goto Done;
-      } else {
-        *DataSize = TempDataSize;
-        Status    = EFI_BUFFER_TOO_SMALL;
-        goto Done;
       }
     }
   }
 
-Done:
-  if ((Status == EFI_SUCCESS) || (Status == EFI_BUFFER_TOO_SMALL)) {
-    if ((Attributes != NULL) && (RtPtrTrack.CurrPtr != NULL)) {
-      *Attributes = RtPtrTrack.CurrPtr->Attributes;
-    }
-  }
-
   CacheInfoFlag->ReadLock = FALSE;
 
   return Status;
@@ -839,11 +905,16 @@ GetNextVariableNameInRuntimeCache (
 {
   EFI_STATUS             Status;
   UINTN                  VarNameSize;
+  UINTN                  KeyNameSize;
+  CHAR16                 *KeyName;
+  EFI_GUID               KeyGuid;
+  UINT32                 Sequence;
   VARIABLE_HEADER        *VariablePtr;
   VARIABLE_STORE_HEADER  *VariableStoreHeader[VariableStoreTypeMax];
   CACHE_INFO_FLAG        *CacheInfoFlag;
 
   Status        = EFI_NOT_FOUND;
+  VarNameSize   = 0;
   CacheInfoFlag = (CACHE_INFO_FLAG *)(UINTN)mVariableRtCacheInfo.CacheInfoFlagBuffer;
 
   //
@@ -867,28 +938,54 @@ GetNextVariableNameInRuntimeCache (
     VariableStoreHeader[VariableStoreTypeHob]      = (VARIABLE_STORE_HEADER *)(UINTN)mVariableRtCacheInfo.RuntimeHobCacheBuffer;
     VariableStoreHeader[VariableStoreTypeNv]       = (VARIABLE_STORE_HEADER *)(UINTN)mVariableRtCacheInfo.RuntimeNvCacheBuffer;
 
-    Status =  VariableServiceGetNextVariableInternal (
-                VariableName,
-                VendorGuid,
-                VariableStoreHeader,
-                &VariablePtr,
-                mVariableAuthFormat
-                );
-    if (!EFI_ERROR (Status)) {
-      VarNameSize = NameSizeOfVariable (VariablePtr, mVariableAuthFormat);
-      ASSERT (VarNameSize != 0);
-      if (VarNameSize <= *VariableNameSize) {
-        CopyMem (VariableName, GetVariableNamePtr (VariablePtr, mVariableAuthFormat), VarNameSize);
-        CopyMem (VendorGuid, GetVendorGuidPtr (VariablePtr, mVariableAuthFormat), sizeof (EFI_GUID));
-        Status = EFI_SUCCESS;
-      } else {
-        Status = EFI_BUFFER_TOO_SMALL;
+    //
+    // VariableName and VendorGuid are both the key of the lookup and its result. The key is
+    // kept in the communicate buffer, which is idle while the variable services lock is held,
+    // so that the lookup can be repeated if SMM updates the runtime cache in between.
+    //
+    KeyNameSize = StrSize (VariableName);
+    if (KeyNameSize > mVariableBufferSize) {
+      Status = EFI_INVALID_PARAMETER;
+      goto Done;
+    }
+
+    KeyName = (CHAR16 *)mVariableBuffer;
+    CopyMem (KeyName, VariableName, KeyNameSize);
+    CopyGuid (&KeyGuid, VendorGuid);
+
+    do {
+      Sequence = BeginRuntimeCacheRead (CacheInfoFlag);
+      Status   = VariableServiceGetNextVariableInternal (
+                   KeyName,
+                   &KeyGuid,
+                   VariableStoreHeader,
+                   &VariablePtr,
+                   mVariableAuthFormat
+                   );
+      if (!EFI_ERROR (Status)) {
+        VarNameSize = NameSizeOfVariable (VariablePtr, mVariableAuthFormat);
+        if ((VarNameSize == 0) || (VarNameSize > mVariableBufferPayloadSize)) {
+          //
+          // The variable was interrupted by an update of the runtime cache.
+          //
+          Status = EFI_NOT_FOUND;
+        } else if (VarNameSize <= *VariableNameSize) {
+          CopyMem (VariableName, GetVariableNamePtr (VariablePtr, mVariableAuthFormat), VarNameSize);
+          CopyMem (VendorGuid, GetVendorGuidPtr (VariablePtr, mVariableAuthFormat), sizeof (EFI_GUID));
+          Status = EFI_SUCCESS;
+        } else {
+          Status = EFI_BUFFER_TOO_SMALL;
+        }
       }
+    } while (RetryRuntimeCacheRead (CacheInfoFlag, Sequence));
 
+    if ((Status == EFI_SUCCESS) || (Status == EFI_BUFFER_TOO_SMALL)) {
       *VariableNameSize = VarNameSize;
     }
   }
 
+Done:
+
   CacheInfoFlag->ReadLock = FALSE;
 
   return Status;
@@ -1184,6 +1281,176 @@ Done:
   return Status;
 }
 
+/**
+  Set a number of variables in one request.
+
+  The entries are packed into as few SMM communicate buffers as possible, so
+  that the SMM variable driver services many of them in a single SMI.
+  Each entry is checked individually by the SMM variable driver.
+
+  Caution: This function may receive untrusted input.
+  The data size and data are external input, so this function will validate it carefully to avoid buffer overflow.
+
+  @param[in]      This          The EDKII_VARIABLE_BATCH_PROTOCOL instance.
+  @param[in]      EntryCount    Number of entries in Entries.
+  @param[in, out] Entries       The variable updates. On return, the Status field
+                                of each entry holds the result of that update.
+
+  @retval EFI_SUCCESS           All the variable updates succeeded.
+  @retval EFI_INVALID_PARAMETER EntryCount is 0 or Entries is NULL.
+  @retval Others                The Status of the first entry that failed.
+
+**/
+EFI_STATUS
+EFIAPI
+VariableBatchSetVariables (
+  IN CONST EDKII_VARIABLE_BATCH_PROTOCOL  *This,
+  IN       UINTN                          EntryCount,
+  IN OUT   EDKII_VARIABLE_BATCH_ENTRY     *Entries
+  )
+{
+  EFI_STATUS                                   Status;
+  SMM_VARIABLE_COMMUNICATE_SET_VARIABLE_BATCH  *SetVariableBatch;
+  SMM_VARIABLE_COMMUNICATE_BATCH_ENTRY         *BatchEntry;
+  EDKII_VARIABLE_BATCH_ENTRY                   *Entry;
+  UINTN                                        PayloadSize;
+  UINTN                                        VariableNameSize;
+  UINTN                                        EntrySize;
+  UINTN                                        First;
+  UINTN                                        Last;
+  UINTN                                        Index;
+
+  if ((EntryCount == 0) || (Entries == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  for (Index = 0; Index < EntryCount; Index++) {
+    Entry = &Entries[Index];
+    if ((Entry->VariableName == NULL) || (Entry->VariableName[0] == 0) || (Entry->VendorGuid == NULL) ||
+        ((Entry->DataSize != 0) && (Entry->Data == NULL)))
+    {
+      Entry->Status = EFI_INVALID_PARAMETER;
+      continue;
+    }
+
+    //
+    // If VariableName or DataSize exceeds SMM payload limit, the entry can not be sent.
+    //
+    VariableNameSize = StrSize (Entry->VariableName);
+    if ((VariableNameSize > mVariableBufferPayloadSize) || (Entry->DataSize > mVariableBufferPayloadSize) ||
+        (SMM_VARIABLE_BATCH_ENTRY_SIZE (VariableNameSize, Entry->DataSize) >
+         mVariableBufferPayloadSize - sizeof (SMM_VARIABLE_COMMUNICATE_SET_VARIABLE_BATCH)))
+    {
+      Entry->Status = EFI_INVALID_PARAMETER;
+      continue;
+    }
+
+    Entry->Status = EFI_NOT_STARTED;
+  }
+
+  AcquireLockOnlyAtBootTime (&mVariableServicesLock);
+
+  for (First = 0; First < EntryCount; First = Last) {
+    //
+    // Find the entries that fit into one communicate buffer.
+    //
+    PayloadSize = sizeof (SMM_VARIABLE_COMMUNICATE_SET_VARIABLE_BATCH);
+    for (Last = First; Last < EntryCount; Last++) {
+      Entry = &Entries[Last];
+      if (Entry->Status != EFI_NOT_STARTED) {
+        continue;
+      }
+
+      EntrySize = SMM_VARIABLE_BATCH_ENTRY_SIZE (StrSize (Entry->VariableName), Entry->DataSize);
+      if (EntrySize > mVariableBufferPayloadSize - PayloadSize) {
+        break;
+      }
+
+      PayloadSize += EntrySize;
+    }
+
+    if (PayloadSize == sizeof (SMM_VARIABLE_COMMUNICATE_SET_VARIABLE_BATCH)) {
+      continue;
+    }
+
+    //
+    // Init the communicate buffer. The buffer data size is:
+    // SMM_COMMUNICATE_HEADER_SIZE + SMM_VARIABLE_COMMUNICATE_HEADER_SIZE + PayloadSize.
+    //
+    Status = InitCommunicateBuffer ((VOID **)&SetVariableBatch, PayloadSize, SMM_VARIABLE_FUNCTION_SET_VARIABLE_BATCH);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    ASSERT (SetVariableBatch != NULL);
+
+    SetVariableBatch->Count = 0;
+    BatchEntry              = (SMM_VARIABLE_COMMUNICATE_BATCH_ENTRY *)(SetVariableBatch + 1);
+    for (Index = First; Index < Last; Index++) {
+      Entry = &Entries[Index];
+      if (Entry->Status != EFI_NOT_STARTED) {
+        continue;
+      }
+
+      CopyGuid (&BatchEntry->Guid, Entry->VendorGuid);
+      BatchEntry->Status     = EFI_NOT_STARTED;
+      BatchEntry->DataSize   = Entry->DataSize;
+      BatchEntry->NameSize   = StrSize (Entry->VariableName);
+      BatchEntry->Attributes = Entry->Attributes;
+      CopyMem (BatchEntry->Name, Entry->VariableName, BatchEntry->NameSize);
+      CopyMem ((UINT8 *)BatchEntry->Name + BatchEntry->NameSize, Entry->Data, Entry->DataSize);
+
+      SetVariableBatch->Count++;
+      BatchEntry = (SMM_VARIABLE_COMMUNICATE_BATCH_ENTRY *)((UINT8 *)BatchEntry +
+                                                            SMM_VARIABLE_BATCH_ENTRY_SIZE (BatchEntry->NameSize, BatchEntry->DataSize));
+    }
+
+    //
+    // Send data to SMM.
+    //
+    Status = SendCommunicateBuffer (PayloadSize);
+
+    //
+    // Collect the status of each entry. An entry the SMM side did not get to
+    // takes the status of the whole request.
+    //
+    BatchEntry = (SMM_VARIABLE_COMMUNICATE_BATCH_ENTRY *)(SetVariableBatch + 1);
+    for (Index = First; Index < Last; Index++) {
+      Entry = &Entries[Index];
+      if (Entry->Status != EFI_NOT_STARTED) {
+        continue;
+      }
+
+      Entry->Status = BatchEntry->Status;
+      if ((Entry->Status == EFI_NOT_STARTED) && EFI_ERROR (Status)) {
+        Entry->Status = Status;
+      }
+
+      BatchEntry = (SMM_VARIABLE_COMMUNICATE_BATCH_ENTRY *)((UINT8 *)BatchEntry +
+                                                            SMM_VARIABLE_BATCH_ENTRY_SIZE (BatchEntry->NameSize, BatchEntry->DataSize));
+    }
+  }
+
+  ReleaseLockOnlyAtBootTime (&mVariableServicesLock);
+
+  Status = EFI_SUCCESS;
+  for (Index = 0; Index < EntryCount; Index++) {
+    Entry = &Entries[Index];
+    if (!EFI_ERROR (Entry->Status)) {
+      if (!EfiAtRuntime ()) {
+        SecureBootHook (
+          Entry->VariableName,
+          Entry->VendorGuid
+          );
+      }
+    } else if (!EFI_ERROR (Status)) {
+      Status = Entry->Status;
+    }
+  }
+
+  return Status;
+}
+
 /**
   This code returns information about the EFI variables.
 
@@ -1634,6 +1901,7 @@ SendRuntimeVariableCacheContextToSmm (
   SmmRuntimeVarCacheContext->PendingUpdate        = &((CACHE_INFO_FLAG *)(UINTN)mVariableRtCacheInfo.CacheInfoFlagBuffer)->PendingUpdate;
   SmmRuntimeVarCacheContext->ReadLock             = &((CACHE_INFO_FLAG *)(UINTN)mVariableRtCacheInfo.CacheInfoFlagBuffer)->ReadLock;
   SmmRuntimeVarCacheContext->HobFlushComplete     = &((CACHE_INFO_FLAG *)(UINTN)mVariableRtCacheInfo.CacheInfoFlagBuffer)->HobFlushComplete;
+  SmmRuntimeVarCacheContext->Sequence             = &((CACHE_INFO_FLAG *)(UINTN)mVariableRtCacheInfo.CacheInfoFlagBuffer)->Sequence;
 
   //
   // Send data to SMM.
@@ -1752,6 +2020,15 @@ SmmVariableReady (
                                                      );
   ASSERT_EFI_ERROR (Status);
 
+  mVariableBatch.SetVariables = VariableBatchSetVariables;
+  Status                      = gBS->InstallMultipleProtocolInterfaces (
+                                       &mHandle,
+                                       &gEdkiiVariableBatchProtocolGuid,
+                                       &mVariableBatch,
+                                       NULL
+                                       );
+  ASSERT_EFI_ERROR (Status);
+
   gBS->CloseEvent (Event);
 }
 
@@ -0,0 +1,594 @@
+/** @file
+  Base Debug library instance base on Serial Port library.
+  It sends tokenized debug messages to serial port device.
+
+  DebugPrint() does not format its message. It writes a record made of the
+  CRC32 of the format string and the raw arguments, and a host decoder,
+  BaseTools/Scripts/DecodeTokenizedDebugLog.py, finds the format string in the
+  build output by its CRC32 and formats the message. A record is:
+
+    UINT8   TOKENIZED_DEBUG_RECORD_SYNC
+    UINT32  CRC32 of the format string, without its Null terminator
+    UINT16  Number of argument bytes that follow
+    UINT8   Arguments[]
+
+  Each argument is encoded in format string order, little endian:
+    '*' width or precision, %p and %r   8 bytes
+    %d, %u, %x and %X                   4 bytes, 8 bytes with 'l' or 'L'
+    %c                                  2 bytes
+    %g                                  16 bytes, all zero for a NULL GUID
+    %t                                  6 bytes: Year, Month, Day, Hour, Minute
+    %a, %s and %S                       UINT8 length, then ASCII characters
+  %r is sent with bit 63 set for an error status, whatever MAX_BIT is. A
+  record truncated to MAX_DEBUG_MESSAGE_LENGTH bytes drops its last arguments.
+
+  ASSERT() messages are still formatted and sent as text.
+
+  NOTE: If the Serial Port library enables hardware flow control, then a call
+  to DebugPrint() or DebugAssert() may hang if writes to the serial port are
+  being blocked.  This may occur if a key(s) are pressed in a terminal emulator
+  used to monitor the DEBUG() and ASSERT() messages.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Base.h>
+#include <Library/DebugLib.h>
+#include <Library/BaseLib.h>
+#include <Library/PrintLib.h>
+#include <Library/PcdLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/SerialPortLib.h>
+#include <Library/DebugPrintErrorLevelLib.h>
+
+//
+// Define the maximum debug and assert message length that this library supports
+//
+#define MAX_DEBUG_MESSAGE_LENGTH  0x100
+
+//
+// First byte of a tokenized record. It is not printable, so records can be
+// told apart from text written to the same serial port by other modules.
+//
+#define TOKENIZED_DEBUG_RECORD_SYNC  0xFE
+
+//
+// Size of the record header: sync byte, format string CRC32, argument bytes.
+//
+#define TOKENIZED_DEBUG_RECORD_HEADER_SIZE  (sizeof (UINT8) + sizeof (UINT32) + sizeof (UINT16))
+
+//
+// VA_LIST can not initialize to NULL for all compiler, so we use this to
+// indicate a null VA_LIST
+//
+VA_LIST  mVaListNull;
+
+/**
+  The constructor function initialize the Serial Port Library
+
+  @retval EFI_SUCCESS   The constructor always returns RETURN_SUCCESS.
+
+**/
+RETURN_STATUS
+EFIAPI
+BaseDebugLibSerialPortConstructor (
+  VOID
+  )
+{
+  return SerialPortInitialize ();
+}
+
+/**
+  Prints a debug message to the debug output device if the specified error level is enabled.
+
+  If any bit in ErrorLevel is also set in DebugPrintErrorLevelLib function
+  GetDebugPrintErrorLevel (), then print the message specified by Format and the
+  associated variable argument list to the debug output device.
+
+  If Format is NULL, then ASSERT().
+
+  @param  ErrorLevel  The error level of the debug message.
+  @param  Format      Format string for the debug message to print.
+  @param  ...         Variable argument list whose contents are accessed
+                      based on the format string specified by Format.
+
+**/
+VOID
+EFIAPI
+DebugPrint (
+  IN  UINTN        ErrorLevel,
+  IN  CONST CHAR8  *Format,
+  ...
+  )
+{
+  VA_LIST  Marker;
+
+  VA_START (Marker, Format);
+  DebugVPrint (ErrorLevel, Format, Marker);
+  VA_END (Marker);
+}
+
+/**
+  Appends an argument to a tokenized record.
+
+  @param  Buffer    The record buffer, MAX_DEBUG_MESSAGE_LENGTH bytes long.
+  @param  Offset    On input, the offset in Buffer where the argument is
+                    appended. On output, the offset that follows it.
+  @param  Argument  The argument bytes, or NULL to append zeros.
+  @param  Size      The number of bytes in Argument.
+
+  @retval TRUE      The argument was appended.
+  @retval FALSE     The argument does not fit in the record.
+
+**/
+STATIC
+BOOLEAN
+TokenizedDebugAppend (
+  IN OUT UINT8       *Buffer,
+  IN OUT UINTN       *Offset,
+  IN     CONST VOID  *Argument OPTIONAL,
+  IN     UINTN       Size
+  )
+{
+  if (Size > MAX_DEBUG_MESSAGE_LENGTH - *Offset) {
+    return FALSE;
+  }
+
+  if (Argument == NULL) {
+    ZeroMem (&Buffer[*Offset], Size);
+  } else {
+    CopyMem (&Buffer[*Offset], Argument, Size);
+  }
+
+  *Offset += Size;
+  return TRUE;
+}
+
+/**
+  Appends a string argument to a tokenized record, as a length byte followed
+  by ASCII characters. A Unicode string keeps the low byte of each character.
+  The string is shortened to what fits in the record.
+
+  @param  Buffer    The record buffer, MAX_DEBUG_MESSAGE_LENGTH bytes long.
+  @param  Offset    On input, the offset in Buffer where the argument is
+                    appended. On output, the offset that follows it.
+  @param  String    The Null-terminated string, or NULL.
+  @param  Unicode   TRUE if String is a Unicode string.
+
+  @retval TRUE      The argument was appended.
+  @retval FALSE     Not even the length byte fits in the record.
+
+**/
+STATIC
+BOOLEAN
+TokenizedDebugAppendString (
+  IN OUT UINT8        *Buffer,
+  IN OUT UINTN        *Offset,
+  IN     CONST CHAR8  *String,
+  IN     BOOLEAN      Unicode
+  )
+{
+  UINTN  Length;
+  UINTN  Step;
+
+  if (*Offset >= MAX_DEBUG_MESSAGE_LENGTH) {
+    return FALSE;
+  }
+
+  if (String == NULL) {
+    String  = "<null string>";
+    Unicode = FALSE;
+  }
+
+  Step = Unicode ? sizeof (CHAR16) : sizeof (CHAR8);
+  for (Length = 0; Length < MIN (MAX_UINT8, MAX_DEBUG_MESSAGE_LENGTH - *Offset - 1); Length++) {
+    if ((String[Length * Step] == '\0') && (!Unicode || (String[Length * Step + 1] == '\0'))) {
+      break;
+    }
+
+    Buffer[*Offset + 1 + Length] = (UINT8)String[Length * Step];
+  }
+
+  Buffer[*Offset] = (UINT8)Length;
+  *Offset        += 1 + Length;
+  return TRUE;
+}
+
+/**
+  Prints a debug message to the debug output device if the specified
+  error level is enabled base on Null-terminated format string and a
+  VA_LIST argument list or a BASE_LIST argument list.
+
+  If any bit in ErrorLevel is also set in DebugPrintErrorLevelLib function
+  GetDebugPrintErrorLevel (), then send a tokenized record of the message
+  specified by Format and the associated variable argument list to the debug
+  output device.
+
+  If Format is NULL, then ASSERT().
+
+  @param  ErrorLevel      The error level of the debug message.
+  @param  Format          Format string for the debug message to print.
+  @param  VaListMarker    VA_LIST marker for the variable argument list.
+  @param  BaseListMarker  BASE_LIST marker for the variable argument list.
+
+**/
+VOID
+DebugPrintMarker (
+  IN  UINTN        ErrorLevel,
+  IN  CONST CHAR8  *Format,
+  IN  VA_LIST      VaListMarker,
+  IN  BASE_LIST    BaseListMarker
+  )
+{
+  UINT8        Buffer[MAX_DEBUG_MESSAGE_LENGTH];
+  CONST CHAR8  *Walker;
+  UINTN        Offset;
+  BOOLEAN      Fits;
+  BOOLEAN      Long;
+  UINT32       FormatId;
+  UINT16       ArgumentSize;
+  UINT64       Value;
+  UINT32       Value32;
+  UINT16       Character;
+  CONST CHAR8  *String;
+  VOID         *Pointer;
+
+  //
+  // If Format is NULL, then ASSERT().
+  //
+  ASSERT (Format != NULL);
+
+  //
+  // Check driver debug mask value and global mask
+  //
+  if ((ErrorLevel & GetDebugPrintErrorLevel ()) == 0) {
+    return;
+  }
+
+  //
+  // Encode the arguments in the order the format string consumes them. A
+  // record whose next argument does not fit is sent with the arguments that
+  // did, and the decoder reports the missing ones.
+  //
+  Offset = TOKENIZED_DEBUG_RECORD_HEADER_SIZE;
+  Fits   = TRUE;
+  for (Walker = Format; Fits && *Walker != '\0'; Walker++) {
+    if (*Walker != '%') {
+      continue;
+    }
+
+    //
+    // Skip flags, width and precision, sending the '*' values.
+    //
+    Long = FALSE;
+    for (Walker++; Fits && *Walker != '\0'; Walker++) {
+      if ((*Walker == 'l') || (*Walker == 'L')) {
+        Long = TRUE;
+      } else if (*Walker == '*') {
+        Value = (BaseListMarker == NULL) ? VA_ARG (VaListMarker, UINTN) : BASE_ARG (BaseListMarker, UINTN);
+        Fits  = TokenizedDebugAppend (Buffer, &Offset, &Value, sizeof (Value));
+      } else if ((*Walker != '.') && (*Walker != '-') && (*Walker != '+') && (*Walker != ' ') &&
+                 (*Walker != ',') && ((*Walker < '0') || (*Walker > '9')))
+      {
+        break;
+      }
+    }
+
+    if (!Fits) {
+      break;
+    }
+
+    switch (*Walker) {
+      case 'p':
+        Value = (UINTN)((BaseListMarker == NULL) ? VA_ARG (VaListMarker, VOID *) : BASE_ARG (BaseListMarker, VOID *));
+        Fits  = TokenizedDebugAppend (Buffer, &Offset, &Value, sizeof (Value));
+        break;
+
+      case 'X':
+      case 'x':
+      case 'u':
+      case 'd':
+        if (Long) {
+          Value = (BaseListMarker == NULL) ? VA_ARG (VaListMarker, UINT64) : BASE_ARG (BaseListMarker, UINT64);
+          Fits  = TokenizedDebugAppend (Buffer, &Offset, &Value, sizeof (Value));
+        } else {
+          Value32 = (BaseListMarker == NULL) ? VA_ARG (VaListMarker, int) : BASE_ARG (BaseListMarker, int);
+          Fits    = TokenizedDebugAppend (Buffer, &Offset, &Value32, sizeof (Value32));
+        }
+
+        break;
+
+      case 's':
+      case 'S':
+      case 'a':
+        String = (BaseListMarker == NULL) ? VA_ARG (VaListMarker, CHAR8 *) : BASE_ARG (BaseListMarker, CHAR8 *);
+        Fits   = TokenizedDebugAppendString (Buffer, &Offset, String, (BOOLEAN)(*Walker != 'a'));
+        break;
+
+      case 'c':
+        Character = (UINT16)((BaseListMarker == NULL) ? VA_ARG (VaListMarker, UINTN) : BASE_ARG (BaseListMarker, UINTN));
+        Fits      = TokenizedDebugAppend (Buffer, &Offset, &Character, sizeof (Character));
+        break;
+
+      case 'g':
+        Pointer = (BaseListMarker == NULL) ? VA_ARG (VaListMarker, GUID *) : BASE_ARG (BaseListMarker, GUID *);
+        Fits    = TokenizedDebugAppend (Buffer, &Offset, Pointer, sizeof (GUID));
+        break;
+
+      case 't':
+        //
+        // Year, Month, Day, Hour and Minute are the first six bytes of EFI_TIME.
+        //
+        Pointer = (BaseListMarker == NULL) ? VA_ARG (VaListMarker, VOID *) : BASE_ARG (BaseListMarker, VOID *);
+        Fits    = TokenizedDebugAppend (Buffer, &Offset, Pointer, 6);
+        break;
+
+      case 'r':
+        Value = (BaseListMarker == NULL) ? VA_ARG (VaListMarker, RETURN_STATUS) : BASE_ARG (BaseListMarker, RETURN_STATUS);
+        if (RETURN_ERROR (Value)) {
+          Value = (Value & ~(UINT64)MAX_BIT) | BIT63;
+        }
+
+        Fits = TokenizedDebugAppend (Buffer, &Offset, &Value, sizeof (Value));
+        break;
+
+      case '\0':
+        //
+        // The format string ends in the middle of a conversion.
+        //
+        Walker--;
+        break;
+
+      default:
+        //
+        // '%%' and unknown conversions consume no argument.
+        //
+        break;
+    }
+  }
+
+  FormatId     = CalculateCrc32 ((VOID *)Format, AsciiStrLen (Format));
+  ArgumentSize = (UINT16)(Offset - TOKENIZED_DEBUG_RECORD_HEADER_SIZE);
+  Buffer[0]    = TOKENIZED_DEBUG_RECORD_SYNC;
+  CopyMem (&Buffer[1], &FormatId, sizeof (FormatId));
+  CopyMem (&Buffer[1 + sizeof (FormatId)], &ArgumentSize, sizeof (ArgumentSize));
+
+  //
+  // Send the record to a Serial Port
+  //
+  SerialPortWrite (Buffer, Offset);
+}
+
+/**
+  Prints a debug message to the debug output device if the specified
+  error level is enabled.
+
+  If any bit in ErrorLevel is also set in DebugPrintErrorLevelLib function
+  GetDebugPrintErrorLevel (), then print the message specified by Format and
+  the associated variable argument list to the debug output device.
+
+  If Format is NULL, then ASSERT().
+
+  @param  ErrorLevel    The error level of the debug message.
+  @param  Format        Format string for the debug message to print.
+  @param  VaListMarker  VA_LIST marker for the variable argument list.
+
+**/
+VOID
+EFIAPI
+DebugVPrint (
+  IN  UINTN        ErrorLevel,
+  IN  CONST CHAR8  *Format,
+  IN  VA_LIST      VaListMarker
+  )
+{
+  DebugPrintMarker (ErrorLevel, Format, VaListMarker, NULL);
+}
+
+/**
+  Prints a debug message to the debug output device if the specified
+  error level is enabled.
+  This function use BASE_LIST which would provide a more compatible
+  service than VA_LIST.
+
+  If any bit in ErrorLevel is also set in DebugPrintErrorLevelLib function
+  GetDebugPrintErrorLevel (), then print the message specified by Format and
+  the associated variable argument list to the debug output device.
+
+  If Format is NULL, then ASSERT().
+
+  @param  ErrorLevel      The error level of the debug message.
+  @param  Format          Format string for the debug message to print.
+  @param  BaseListMarker  BASE_LIST marker for the variable argument list.
+
+**/
+VOID
+EFIAPI
+DebugBPrint (
+  IN  UINTN        ErrorLevel,
+  IN  CONST CHAR8  *Format,
+  IN  BASE_LIST    BaseListMarker
+  )
+{
+  DebugPrintMarker (ErrorLevel, Format, mVaListNull, BaseListMarker);
+}
+
+/**
+  Prints an assert message containing a filename, line number, and description.
+  This may be followed by a breakpoint or a dead loop.
+
+  Print a message of the form "ASSERT <FileName>(<LineNumber>): <Description>\n"
+  to the debug output device.  If DEBUG_PROPERTY_ASSERT_BREAKPOINT_ENABLED bit of
+  PcdDebugProperyMask is set then CpuBreakpoint() is called. Otherwise, if
+  DEBUG_PROPERTY_ASSERT_DEADLOOP_ENABLED bit of PcdDebugProperyMask is set then
+  CpuDeadLoop() is called.  If neither of these bits are set, then this function
+  returns immediately after the message is printed to the debug output device.
+  DebugAssert() must actively prevent recursion.  If DebugAssert() is called while
+  processing another DebugAssert(), then DebugAssert() must return immediately.
+
+  If FileName is NULL, then a <FileName> string of "(NULL) Filename" is printed.
+  If Description is NULL, then a <Description> string of "(NULL) Description" is printed.
+
+  @param  FileName     The pointer to the name of the source file that generated the assert condition.
+  @param  LineNumber   The line number in the source file that generated the assert condition
+  @param  Description  The pointer to the description of the assert condition.
+
+**/
+VOID
+EFIAPI
+DebugAssert (
+  IN CONST CHAR8  *FileName,
+  IN UINTN        LineNumber,
+  IN CONST CHAR8  *Description
+  )
+{
+  CHAR8  Buffer[MAX_DEBUG_MESSAGE_LENGTH];
+
+  //
+  // Generate the ASSERT() message in Ascii format
+  //
+  AsciiSPrint (Buffer, sizeof (Buffer), "ASSERT [%a] %a(%d): %a\n", gEfiCallerBaseName, FileName, LineNumber, Description);
+
+  //
+  // Send the print string to the Console Output device
+  //
+  SerialPortWrite ((UINT8 *)Buffer, AsciiStrLen (Buffer));
+
+  //
+  // Generate a Breakpoint, DeadLoop, or NOP based on PCD settings
+  //
+  if ((PcdGet8 (PcdDebugPropertyMask) & DEBUG_PROPERTY_ASSERT_BREAKPOINT_ENABLED) != 0) {
+    CpuBreakpoint ();
+  } else if ((PcdGet8 (PcdDebugPropertyMask) & DEBUG_PROPERTY_ASSERT_DEADLOOP_ENABLED) != 0) {
+    CpuDeadLoop ();
+  }
+}
+
+/**
+  Fills a target buffer with PcdDebugClearMemoryValue, and returns the target buffer.
+
+  This function fills Length bytes of Buffer with the value specified by
+  PcdDebugClearMemoryValue, and returns Buffer.
+
+  If Buffer is NULL, then ASSERT().
+  If Length is greater than (MAX_ADDRESS - Buffer + 1), then ASSERT().
+
+  @param   Buffer  The pointer to the target buffer to be filled with PcdDebugClearMemoryValue.
+  @param   Length  The number of bytes in Buffer to fill with zeros PcdDebugClearMemoryValue.
+
+  @return  Buffer  The pointer to the target buffer filled with PcdDebugClearMemoryValue.
+
+**/
+VOID *
+EFIAPI
+DebugClearMemory (
+  OUT VOID  *Buffer,
+  IN UINTN  Length
+  )
+{
+  //
+  // If Buffer is NULL, then ASSERT().
+  //
+  ASSERT (Buffer != NULL);
+
+  //
+  // SetMem() checks for the the ASSERT() condition on Length and returns Buffer
+  //
+  return SetMem (Buffer, Length, PcdGet8 (PcdDebugClearMemoryValue));
+}
+
+/**
+  Returns TRUE if ASSERT() macros are enabled.
+
+  This function returns TRUE if the DEBUG_PROPERTY_DEBUG_ASSERT_ENABLED bit of
+  PcdDebugProperyMask is set.  Otherwise FALSE is returned.
+
+  @retval  TRUE    The DEBUG_PROPERTY_DEBUG_ASSERT_ENABLED bit of PcdDebugProperyMask is set.
+  @retval  FALSE   The DEBUG_PROPERTY_DEBUG_ASSERT_ENABLED bit of PcdDebugProperyMask is clear.
+
+**/
+BOOLEAN
+EFIAPI
+DebugAssertEnabled (
+  VOID
+  )
+{
+  return (BOOLEAN)((PcdGet8 (PcdDebugPropertyMask) & DEBUG_PROPERTY_DEBUG_ASSERT_ENABLED) != 0);
+}
+
+/**
+  Returns TRUE if DEBUG() macros are enabled.
+
+  This function returns TRUE if the DEBUG_PROPERTY_DEBUG_PRINT_ENABLED bit of
+  PcdDebugProperyMask is set.  Otherwise FALSE is returned.
+
+  @retval  TRUE    The DEBUG_PROPERTY_DEBUG_PRINT_ENABLED bit of PcdDebugProperyMask is set.
+  @retval  FALSE   The DEBUG_PROPERTY_DEBUG_PRINT_ENABLED bit of PcdDebugProperyMask is clear.
+
+**/
+BOOLEAN
+EFIAPI
+DebugPrintEnabled (
+  VOID
+  )
+{
+  return (BOOLEAN)((PcdGet8 (PcdDebugPropertyMask) & DEBUG_PROPERTY_DEBUG_PRINT_ENABLED) != 0);
+}
+
+/**
+  Returns TRUE if DEBUG_CODE() macros are enabled.
+
+  This function returns TRUE if the DEBUG_PROPERTY_DEBUG_CODE_ENABLED bit of
+  PcdDebugProperyMask is set.  Otherwise FALSE is returned.
+
+  @retval  TRUE    The DEBUG_PROPERTY_DEBUG_CODE_ENABLED bit of PcdDebugProperyMask is set.
+  @retval  FALSE   The DEBUG_PROPERTY_DEBUG_CODE_ENABLED bit of PcdDebugProperyMask is clear.
+
+**/
+BOOLEAN
+EFIAPI
+DebugCodeEnabled (
+  VOID
+  )
+{
+  return (BOOLEAN)((PcdGet8 (PcdDebugPropertyMask) & DEBUG_PROPERTY_DEBUG_CODE_ENABLED) != 0);
+}
+
+/**
+  Returns TRUE if DEBUG_CLEAR_MEMORY() macro is enabled.
+
+  This function returns TRUE if the DEBUG_PROPERTY_CLEAR_MEMORY_ENABLED bit of
+  PcdDebugProperyMask is set.  Otherwise FALSE is returned.
+
+  @retval  TRUE    The DEBUG_PROPERTY_CLEAR_MEMORY_ENABLED bit of PcdDebugProperyMask is set.
+  @retval  FALSE   The DEBUG_PROPERTY_CLEAR_MEMORY_ENABLED bit of PcdDebugProperyMask is clear.
+
+**/
+BOOLEAN
+EFIAPI
+DebugClearMemoryEnabled (
+  VOID
+  )
+{
+  return (BOOLEAN)((PcdGet8 (PcdDebugPropertyMask) & DEBUG_PROPERTY_CLEAR_MEMORY_ENABLED) != 0);
+}
+
+/**
+  Returns TRUE if any one of the bit is set both in ErrorLevel and PcdFixedDebugPrintErrorLevel.
+
+  This function compares the bit mask of ErrorLevel and PcdFixedDebugPrintErrorLevel.
+
+  @retval  TRUE    Current ErrorLevel is supported.
+  @retval  FALSE   Current ErrorLevel is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+DebugPrintLevelEnabled (
+  IN  CONST UINTN  ErrorLevel
+  )
+{
+  return (BOOLEAN)((ErrorLevel & PcdGet32 (PcdFixedDebugPrintErrorLevel)) != 0);
+}
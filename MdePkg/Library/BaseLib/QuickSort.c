@@ -8,6 +8,252 @@
 
 #include "BaseLibInternals.h"
 
+//
+// Partitions of at most this many elements are sorted by insertion
+//
+#define QUICK_SORT_INSERTION_THRESHOLD  8
+
+/**
+  Swap two elements of a buffer.
+
+  @param[in, out] Buffer            The buffer of elements.
+  @param[in]      IndexA            The index of the first element.
+  @param[in]      IndexB            The index of the second element.
+  @param[in]      ElementSize       Size of an element in bytes.
+  @param[out]     BufferOneElement  Buffer of ElementSize bytes used for the swap.
+**/
+STATIC
+VOID
+QuickSortSwap (
+  IN OUT UINT8  *Buffer,
+  IN     UINTN  IndexA,
+  IN     UINTN  IndexB,
+  IN     UINTN  ElementSize,
+  OUT    VOID   *BufferOneElement
+  )
+{
+  CopyMem (BufferOneElement, Buffer + IndexA * ElementSize, ElementSize);
+  CopyMem (Buffer + IndexA * ElementSize, Buffer + IndexB * ElementSize, ElementSize);
+  CopyMem (Buffer + IndexB * ElementSize, BufferOneElement, ElementSize);
+}
+
+/**
+  Move an element down a max-heap until both its children compare lower.
+
+  @param[in, out] Buffer            The buffer holding the heap.
+  @param[in]      Root              The index of the element to move down.
+  @param[in]      HeapSize          The number of elements in the heap.
+  @param[in]      ElementSize       Size of an element in bytes.
+  @param[in]      CompareFunction   The function to compare two elements.
+  @param[out]     BufferOneElement  Buffer of ElementSize bytes used for swapping.
+**/
+STATIC
+VOID
+QuickSortSiftDown (
+  IN OUT UINT8              *Buffer,
+  IN     UINTN              Root,
+  IN     UINTN              HeapSize,
+  IN     UINTN              ElementSize,
+  IN     BASE_SORT_COMPARE  CompareFunction,
+  OUT    VOID               *BufferOneElement
+  )
+{
+  UINTN  Child;
+
+  while ((Child = 2 * Root + 1) < HeapSize) {
+    if ((Child + 1 < HeapSize) &&
+        (CompareFunction (Buffer + Child * ElementSize, Buffer + (Child + 1) * ElementSize) < 0))
+    {
+      Child++;
+    }
+
+    if (CompareFunction (Buffer + Root * ElementSize, Buffer + Child * ElementSize) >= 0) {
+      return;
+    }
+
+    QuickSortSwap (Buffer, Root, Child, ElementSize, BufferOneElement);
+    Root = Child;
+  }
+}
+
+/**
+  Sort a buffer with heapsort.
+
+  Used when quicksort keeps picking bad pivots, so that sorting any input
+  takes O(n log n) comparisons.
+
+  @param[in, out] Buffer            The buffer of elements.
+  @param[in]      Count             The number of elements in Buffer.
+  @param[in]      ElementSize       Size of an element in bytes.
+  @param[in]      CompareFunction   The function to compare two elements.
+  @param[out]     BufferOneElement  Buffer of ElementSize bytes used for swapping.
+**/
+STATIC
+VOID
+QuickSortHeapSort (
+  IN OUT UINT8              *Buffer,
+  IN     UINTN              Count,
+  IN     UINTN              ElementSize,
+  IN     BASE_SORT_COMPARE  CompareFunction,
+  OUT    VOID               *BufferOneElement
+  )
+{
+  UINTN  Index;
+
+  for (Index = Count / 2; Index > 0; Index--) {
+    QuickSortSiftDown (Buffer, Index - 1, Count, ElementSize, CompareFunction, BufferOneElement);
+  }
+
+  for (Index = Count - 1; Index > 0; Index--) {
+    QuickSortSwap (Buffer, 0, Index, ElementSize, BufferOneElement);
+    QuickSortSiftDown (Buffer, 0, Index, ElementSize, CompareFunction, BufferOneElement);
+  }
+}
+
+/**
+  Sort a small buffer with insertion sort.
+
+  @param[in, out] Buffer            The buffer of elements.
+  @param[in]      Count             The number of elements in Buffer.
+  @param[in]      ElementSize       Size of an element in bytes.
+  @param[in]      CompareFunction   The function to compare two elements.
+  @param[out]     BufferOneElement  Buffer of ElementSize bytes used for moving
+                                    elements.
+**/
+STATIC
+VOID
+QuickSortInsertionSort (
+  IN OUT UINT8              *Buffer,
+  IN     UINTN              Count,
+  IN     UINTN              ElementSize,
+  IN     BASE_SORT_COMPARE  CompareFunction,
+  OUT    VOID               *BufferOneElement
+  )
+{
+  UINTN  Index;
+  UINTN  Hole;
+
+  for (Index = 1; Index < Count; Index++) {
+    Hole = Index;
+    while ((Hole > 0) &&
+           (CompareFunction (Buffer + (Hole - 1) * ElementSize, Buffer + Index * ElementSize) > 0))
+    {
+      Hole--;
+    }
+
+    if (Hole != Index) {
+      CopyMem (BufferOneElement, Buffer + Index * ElementSize, ElementSize);
+      CopyMem (Buffer + (Hole + 1) * ElementSize, Buffer + Hole * ElementSize, (Index - Hole) * ElementSize);
+      CopyMem (Buffer + Hole * ElementSize, BufferOneElement, ElementSize);
+    }
+  }
+}
+
+/**
+  Sort a buffer with quicksort, falling back to heapsort once DepthLimit
+  partitions did not split the buffer well enough.
+
+  @param[in, out] Buffer            The buffer of elements.
+  @param[in]      Count             The number of elements in Buffer.
+  @param[in]      ElementSize       Size of an element in bytes.
+  @param[in]      CompareFunction   The function to compare two elements.
+  @param[out]     BufferOneElement  Buffer of ElementSize bytes used for swapping.
+  @param[in]      DepthLimit        The number of partitions left before
+                                    switching to heapsort.
+**/
+STATIC
+VOID
+QuickSortWorker (
+  IN OUT UINT8              *Buffer,
+  IN     UINTN              Count,
+  IN     UINTN              ElementSize,
+  IN     BASE_SORT_COMPARE  CompareFunction,
+  OUT    VOID               *BufferOneElement,
+  IN     UINTN              DepthLimit
+  )
+{
+  UINT8  *Pivot;
+  UINTN  Middle;
+  UINTN  LoopCount;
+  UINTN  NextSwapLocation;
+
+  while (Count > QUICK_SORT_INSERTION_THRESHOLD) {
+    if (DepthLimit == 0) {
+      QuickSortHeapSort (Buffer, Count, ElementSize, CompareFunction, BufferOneElement);
+      return;
+    }
+
+    DepthLimit--;
+
+    //
+    // Pick the median of the first, middle and last elements as the pivot
+    // and move it to the end, so that sorted and reverse sorted input, like
+    // memory maps and other address ordered lists, split evenly
+    //
+    Middle = Count / 2;
+    if (CompareFunction (Buffer + Middle * ElementSize, Buffer) < 0) {
+      QuickSortSwap (Buffer, Middle, 0, ElementSize, BufferOneElement);
+    }
+
+    if (CompareFunction (Buffer + (Count - 1) * ElementSize, Buffer) < 0) {
+      QuickSortSwap (Buffer, Count - 1, 0, ElementSize, BufferOneElement);
+    }
+
+    if (CompareFunction (Buffer + Middle * ElementSize, Buffer + (Count - 1) * ElementSize) < 0) {
+      QuickSortSwap (Buffer, Middle, Count - 1, ElementSize, BufferOneElement);
+    }
+
+    Pivot = Buffer + (Count - 1) * ElementSize;
+
+    //
+    // Now get the pivot such that all on "left" are below it
+    // and everything "right" are above it
+    //
+    NextSwapLocation = 0;
+    for (LoopCount = 0; LoopCount < Count - 1; LoopCount++) {
+      //
+      // if the element is less than or equal to the pivot
+      //
+      if (CompareFunction (Buffer + LoopCount * ElementSize, Pivot) <= 0) {
+        if (NextSwapLocation != LoopCount) {
+          QuickSortSwap (Buffer, NextSwapLocation, LoopCount, ElementSize, BufferOneElement);
+        }
+
+        NextSwapLocation++;
+      }
+    }
+
+    //
+    // swap pivot to it's final position (NextSwapLocation)
+    //
+    if (NextSwapLocation != Count - 1) {
+      QuickSortSwap (Buffer, NextSwapLocation, Count - 1, ElementSize, BufferOneElement);
+    }
+
+    //
+    // Recurse on the smaller partial list and continue with the larger one,
+    // which keeps the recursion depth logarithmic
+    //
+    if (NextSwapLocation < Count - NextSwapLocation - 1) {
+      QuickSortWorker (Buffer, NextSwapLocation, ElementSize, CompareFunction, BufferOneElement, DepthLimit);
+      Buffer += (NextSwapLocation + 1) * ElementSize;
+      Count  -= NextSwapLocation + 1;
+    } else {
+      QuickSortWorker (
+        Buffer + (NextSwapLocation + 1) * ElementSize,
+        Count - NextSwapLocation - 1,
+        ElementSize,
+        CompareFunction,
+        BufferOneElement,
+        DepthLimit
+        );
+      Count = NextSwapLocation;
+    }
+  }
+
+  QuickSortInsertionSort (Buffer, Count, ElementSize, CompareFunction, BufferOneElement);
+}
+
 /**
   This function is identical to perform QuickSort,
   except that is uses the pre-allocated buffer so the in place sorting does not need to
@@ -41,10 +287,6 @@ QuickSort (
   OUT VOID                    *BufferOneElement
   )
 {
-  VOID   *Pivot;
-  UINTN  LoopCount;
-  UINTN  NextSwapLocation;
-
   ASSERT (BufferToSort     != NULL);
   ASSERT (CompareFunction  != NULL);
   ASSERT (BufferOneElement != NULL);
@@ -54,64 +296,12 @@ QuickSort (
     return;
   }
 
-  NextSwapLocation = 0;
-
-  //
-  // pick a pivot (we choose last element)
-  //
-  Pivot = ((UINT8 *)BufferToSort + ((Count - 1) * ElementSize));
-
-  //
-  // Now get the pivot such that all on "left" are below it
-  // and everything "right" are above it
-  //
-  for (LoopCount = 0; LoopCount < Count -1; LoopCount++) {
-    //
-    // if the element is less than or equal to the pivot
-    //
-    if (CompareFunction ((VOID *)((UINT8 *)BufferToSort + ((LoopCount) * ElementSize)), Pivot) <= 0) {
-      //
-      // swap
-      //
-      CopyMem (BufferOneElement, (UINT8 *)BufferToSort + (NextSwapLocation * ElementSize), ElementSize);
-      CopyMem ((UINT8 *)BufferToSort + (NextSwapLocation * ElementSize), (UINT8 *)BufferToSort + ((LoopCount) * ElementSize), ElementSize);
-      CopyMem ((UINT8 *)BufferToSort + ((LoopCount)*ElementSize), BufferOneElement, ElementSize);
-
-      //
-      // increment NextSwapLocation
-      //
-      NextSwapLocation++;
-    }
-  }
-
-  //
-  // swap pivot to it's final position (NextSwapLocation)
-  //
-  CopyMem (BufferOneElement, Pivot, ElementSize);
-  CopyMem (Pivot, (UINT8 *)BufferToSort + (NextSwapLocation * ElementSize), ElementSize);
-  CopyMem ((UINT8 *)BufferToSort + (NextSwapLocation * ElementSize), BufferOneElement, ElementSize);
-
-  //
-  // Now recurse on 2 partial lists.  neither of these will have the 'pivot' element
-  // IE list is sorted left half, pivot element, sorted right half...
-  //
-  if (NextSwapLocation >= 2) {
-    QuickSort (
-      BufferToSort,
-      NextSwapLocation,
-      ElementSize,
-      CompareFunction,
-      BufferOneElement
-      );
-  }
-
-  if ((Count - NextSwapLocation - 1) >= 2) {
-    QuickSort (
-      (UINT8 *)BufferToSort + (NextSwapLocation + 1) * ElementSize,
-      Count - NextSwapLocation - 1,
-      ElementSize,
-      CompareFunction,
-      BufferOneElement
-      );
-  }
+  QuickSortWorker (
+    BufferToSort,
+    Count,
+    ElementSize,
+    CompareFunction,
+    BufferOneElement,
+    2 * ((UINTN)HighBitSet64 (Count) + 1)
+    );
 }
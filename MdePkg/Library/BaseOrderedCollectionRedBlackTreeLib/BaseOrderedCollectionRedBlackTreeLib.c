@@ -10,6 +10,10 @@
 
   The implementation is also useful as a fast priority queue.
 
+  Nodes released by Delete() are kept on a short per-tree free list and reused
+  by Insert(), so that trees with a high insert / delete churn, such as maps
+  of in-flight requests, do not call the pool allocator for every element.
+
   Copyright (C) 2014, Red Hat, Inc.
   Copyright (c) 2014, Intel Corporation. All rights reserved.<BR>
 
@@ -35,10 +39,17 @@ typedef ORDERED_COLLECTION_ENTRY         RED_BLACK_TREE_NODE;
 typedef ORDERED_COLLECTION_USER_COMPARE  RED_BLACK_TREE_USER_COMPARE;
 typedef ORDERED_COLLECTION_KEY_COMPARE   RED_BLACK_TREE_KEY_COMPARE;
 
+//
+// The maximum number of released nodes that a tree keeps for reuse.
+//
+#define RED_BLACK_TREE_MAX_FREE_NODES  32
+
 struct ORDERED_COLLECTION {
   RED_BLACK_TREE_NODE            *Root;
   RED_BLACK_TREE_USER_COMPARE    UserStructCompare;
   RED_BLACK_TREE_KEY_COMPARE     KeyCompare;
+  RED_BLACK_TREE_NODE            *FreeNodes;     // linked through Parent
+  UINTN                          FreeNodeCount;
 };
 
 struct ORDERED_COLLECTION_ENTRY {
@@ -121,6 +132,8 @@ OrderedCollectionInit (
   Tree->Root              = NULL;
   Tree->UserStructCompare = UserStructCompare;
   Tree->KeyCompare        = KeyCompare;
+  Tree->FreeNodes         = NULL;
+  Tree->FreeNodeCount     = 0;
 
   if (FeaturePcdGet (PcdValidateOrderedCollection)) {
     RedBlackTreeValidate (Tree);
@@ -154,7 +167,8 @@ OrderedCollectionIsEmpty (
 
   Read-write operation.
 
-  Release occurs via MemoryAllocationLib's FreePool() function.
+  Release occurs via MemoryAllocationLib's FreePool() function, both for the
+  tree and for the released nodes it kept for reuse.
 
   It is the caller's responsibility to delete all nodes from the tree before
   calling this function.
@@ -167,7 +181,16 @@ OrderedCollectionUninit (
   IN RED_BLACK_TREE  *Tree
   )
 {
+  RED_BLACK_TREE_NODE  *Node;
+
   ASSERT (OrderedCollectionIsEmpty (Tree));
+
+  while (Tree->FreeNodes != NULL) {
+    Node            = Tree->FreeNodes;
+    Tree->FreeNodes = Node->Parent;
+    FreePool (Node);
+  }
+
   FreePool (Tree);
 }
 
@@ -523,8 +546,9 @@ RedBlackTreeRotateLeft (
 
   Read-write operation.
 
-  This function allocates the new tree node with MemoryAllocationLib's
-  AllocatePool() function.
+  This function takes the new tree node from the nodes that Tree keeps for
+  reuse, or allocates it with MemoryAllocationLib's AllocatePool() function
+  if there are none.
 
   @param[in,out] Tree        The tree to insert UserStruct into.
 
@@ -621,12 +645,18 @@ OrderedCollectionInsert (
   }
 
   //
-  // no collision, allocate a new node
+  // no collision, reuse a released node or allocate a new one
   //
-  Tmp = AllocatePool (sizeof *Tmp);
-  if (Tmp == NULL) {
-    Status = RETURN_OUT_OF_RESOURCES;
-    goto Done;
+  if (Tree->FreeNodes != NULL) {
+    Tmp             = Tree->FreeNodes;
+    Tree->FreeNodes = Tmp->Parent;
+    Tree->FreeNodeCount--;
+  } else {
+    Tmp = AllocatePool (sizeof *Tmp);
+    if (Tmp == NULL) {
+      Status = RETURN_OUT_OF_RESOURCES;
+      goto Done;
+    }
   }
 
   if (Node != NULL) {
@@ -884,8 +914,10 @@ NodeIsNullOrBlack (
                              Node argument (typically used for simplicity in
                              loops that empty the tree completely).
 
-                             Node is released with MemoryAllocationLib's
-                             FreePool() function.
+                             Node is kept by Tree for reuse by a later
+                             OrderedCollectionInsert(), or released with
+                             MemoryAllocationLib's FreePool() function if Tree
+                             already keeps enough nodes.
 
                              Existing RED_BLACK_TREE_NODE pointers (ie.
                              iterators) *different* from Node remain valid. For
@@ -1111,7 +1143,13 @@ OrderedCollectionDelete (
     }
   }
 
-  FreePool (Node);
+  if (Tree->FreeNodeCount < RED_BLACK_TREE_MAX_FREE_NODES) {
+    Node->Parent    = Tree->FreeNodes;
+    Tree->FreeNodes = Node;
+    Tree->FreeNodeCount++;
+  } else {
+    FreePool (Node);
+  }
 
   //
   // If the node that we unlinked from its original spot (ie. Node itself, or
@@ -108,8 +108,13 @@ AcquireSpinLock (
   INT64   Cycle;
   INT64   Delta;
 
+  //
+  // While the lock is held, waiting processors only read it, and try the
+  // locked compare exchange again once it reads released. This keeps them
+  // from taking the cache line away from the owner on every iteration.
+  //
   if (PcdGet32 (PcdSpinLockTimeout) == 0) {
-    while (!AcquireSpinLockOrFail (SpinLock)) {
+    while ((*SpinLock == SPIN_LOCK_ACQUIRED) || !AcquireSpinLockOrFail (SpinLock)) {
       CpuPause ();
     }
   } else if (!AcquireSpinLockOrFail (SpinLock)) {
@@ -143,7 +148,7 @@ AcquireSpinLock (
 
     Cycle++;
 
-    while (!AcquireSpinLockOrFail (SpinLock)) {
+    while ((*SpinLock == SPIN_LOCK_ACQUIRED) || !AcquireSpinLockOrFail (SpinLock)) {
       CpuPause ();
       Previous = Current;
       Current  = GetPerformanceCounter ();
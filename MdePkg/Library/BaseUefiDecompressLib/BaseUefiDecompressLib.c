@@ -25,16 +25,24 @@ FillBuf (
   )
 {
   //
-  // Left shift NumOfBits of bits in advance
-  //
-  Sd->mBitBuf = (UINT32)LShiftU64 (((UINT64)Sd->mBitBuf), NumOfBits);
+  // Left shift NumOfBits of bits in advance. This runs for every code that
+  // is decoded, so shift natively instead of through LShiftU64(); only the
+  // initial fill shifts by the full width of mBitBuf.
+  //
+  if (NumOfBits < BITBUFSIZ) {
+    Sd->mBitBuf <<= NumOfBits;
+  } else {
+    Sd->mBitBuf = 0;
+  }
 
   //
   // Copy data needed in bytes into mSbuBitBuf
   //
   while (NumOfBits > Sd->mBitCount) {
-    NumOfBits    = (UINT16)(NumOfBits - Sd->mBitCount);
-    Sd->mBitBuf |= (UINT32)LShiftU64 (((UINT64)Sd->mSubBitBuf), NumOfBits);
+    NumOfBits = (UINT16)(NumOfBits - Sd->mBitCount);
+    if (NumOfBits < BITBUFSIZ) {
+      Sd->mBitBuf |= Sd->mSubBitBuf << NumOfBits;
+    }
 
     if (Sd->mCompSize > 0) {
       //
@@ -558,6 +566,7 @@ Decode (
 {
   UINT16  BytesRemain;
   UINT32  DataIdx;
+  UINT32  Count;
   UINT16  CharC;
 
   BytesRemain = (UINT16)(-1);
@@ -606,6 +615,26 @@ Decode (
       //
       BytesRemain--;
 
+      if ((DataIdx < Sd->mOutBuf) && (Sd->mOutBuf < Sd->mOrigSize)) {
+        //
+        // The string lies before mOutBuf, so only the end of mDstBase bounds
+        // the copy and the per byte checks below can be skipped. A string
+        // overlapping the bytes being written repeats itself, so it is still
+        // copied forward one byte at a time.
+        //
+        Count = MIN ((UINT32)BytesRemain + 1, Sd->mOrigSize - Sd->mOutBuf);
+        if (Count <= Sd->mOutBuf - DataIdx) {
+          CopyMem (&Sd->mDstBase[Sd->mOutBuf], &Sd->mDstBase[DataIdx], Count);
+          Sd->mOutBuf += Count;
+        } else {
+          while (Count-- > 0) {
+            Sd->mDstBase[Sd->mOutBuf++] = Sd->mDstBase[DataIdx++];
+          }
+        }
+
+        BytesRemain = (UINT16)(-1);
+      }
+
       while ((INT16)(BytesRemain) >= 0) {
         if (Sd->mOutBuf >= Sd->mOrigSize) {
           goto Done;
@@ -39,8 +39,16 @@ UefiDevicePathLibCatPrint (
   VA_END (Args);
 
   if ((Str->Count + (Count + 1)) * sizeof (CHAR16) > Str->Capacity) {
-    Str->Capacity = (Str->Count + (Count + 1) * 2) * sizeof (CHAR16);
-    Str->Str      = ReallocatePool (
+    //
+    // Grow the buffer geometrically, a device path is printed in many small
+    // pieces and growing it by the size of each piece reallocates it for
+    // almost every node.
+    //
+    Str->Capacity = MAX (
+                      (Str->Count + (Count + 1) * 2) * sizeof (CHAR16),
+                      MAX (Str->Capacity * 2, POOL_PRINT_MIN_CAPACITY)
+                      );
+    Str->Str = ReallocatePool (
                       Str->Count * sizeof (CHAR16),
                       Str->Capacity,
                       Str->Str
@@ -2442,6 +2450,7 @@ UefiDevicePathLibConvertDevicePathToText (
   POOL_PRINT                Str;
   EFI_DEVICE_PATH_PROTOCOL  *Node;
   EFI_DEVICE_PATH_PROTOCOL  *AlignedNode;
+  UINTN                     AlignedNodeSize;
   UINTN                     Index;
   DEVICE_PATH_TO_TEXT       ToText;
 
@@ -2450,6 +2459,8 @@ UefiDevicePathLibConvertDevicePathToText (
   }
 
   ZeroMem (&Str, sizeof (Str));
+  AlignedNode     = NULL;
+  AlignedNodeSize = 0;
 
   //
   // Process each device path node
@@ -2480,12 +2491,29 @@ UefiDevicePathLibConvertDevicePathToText (
       }
     }
 
-    AlignedNode = AllocateCopyPool (DevicePathNodeLength (Node), Node);
+    //
+    // Copy the node to an aligned buffer that is reused for all the nodes
+    // and only grows for a node larger than all the previous ones
+    //
+    if (DevicePathNodeLength (Node) > AlignedNodeSize) {
+      if (AlignedNode != NULL) {
+        FreePool (AlignedNode);
+      }
+
+      AlignedNodeSize = DevicePathNodeLength (Node);
+      AlignedNode     = AllocatePool (AlignedNodeSize);
+      if (AlignedNode == NULL) {
+        AlignedNodeSize = 0;
+        break;
+      }
+    }
+
+    CopyMem (AlignedNode, Node, DevicePathNodeLength (Node));
+
     //
     // Print this node of the device path
     //
     ToText (&Str, AlignedNode, DisplayOnly, AllowShortcuts);
-    FreePool (AlignedNode);
 
     //
     // Next device path node
@@ -2493,6 +2521,10 @@ UefiDevicePathLibConvertDevicePathToText (
     Node = NextDevicePathNode (Node);
   }
 
+  if (AlignedNode != NULL) {
+    FreePool (AlignedNode);
+  }
+
   if (Str.Str == NULL) {
     return AllocateZeroPool (sizeof (CHAR16));
   } else {
@@ -32,6 +32,11 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define IS_SLASH(a)          ((a) == L'/')
 #define IS_NULL(a)           ((a) == L'\0')
 
+//
+// Initial size in bytes of the buffer of a POOL_PRINT
+//
+#define POOL_PRINT_MIN_CAPACITY  (64 * sizeof (CHAR16))
+
 //
 // Private Data structure
 //
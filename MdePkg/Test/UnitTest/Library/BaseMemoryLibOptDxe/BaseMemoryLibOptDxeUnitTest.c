@@ -0,0 +1,465 @@
+/** @file
+  Unit tests and benchmarks of the X64 CopyMem, SetMem, ZeroMem and CompareMem
+  implementations in BaseMemoryLibOptDxe.
+
+  Every test runs once per vector level the processor supports, so the SSE2,
+  AVX2 and AVX-512 paths are all checked against a byte-wise reference. The
+  benchmark suite reports the TSC ticks per KB of each path.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_APP_NAME     "BaseMemoryLibOptDxe Unit Test Application"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+//
+// Large enough to cover the non-temporal store paths.
+//
+#define TEST_BUFFER_SIZE  (SIZE_4MB + SIZE_4KB)
+
+//
+// Vector level cached by X64/MemLibVector.nasm. Lowering it forces the
+// narrower paths; InternalMemVectorLevel still checks XCR0 on each call.
+//
+extern UINT8  mMemLibVectorLevel;
+
+#define MEM_VECTOR_NONE     0
+#define MEM_VECTOR_AVX512   2
+#define MEM_VECTOR_UNKNOWN  0xFF
+
+STATIC CONST UINTN  mTestSizes[] = {
+  1,          15,          16,          31,         63,         64,         255,
+  511,        512,         513,         1000,       SIZE_4KB,   SIZE_4KB + 1,
+  SIZE_64KB + 33,          SIZE_1MB - 1, SIZE_1MB,  SIZE_1MB + 63,
+  SIZE_2MB + 7,            SIZE_4MB + 65
+};
+
+STATIC CONST UINTN  mBenchmarkSizes[] = {
+  SIZE_4KB, SIZE_64KB, SIZE_1MB, SIZE_2MB
+};
+
+STATIC UINT8  *mSource;
+STATIC UINT8  *mDestination;
+STATIC UINT8  *mExpected;
+STATIC UINT8  mSupportedLevel;
+
+/**
+  Fill a buffer with a pattern that differs between calls.
+
+  @param[out] Buffer  The buffer to fill.
+  @param[in]  Length  The size of the buffer.
+  @param[in]  Seed    The seed of the pattern.
+**/
+STATIC
+VOID
+FillPattern (
+  OUT UINT8  *Buffer,
+  IN  UINTN  Length,
+  IN  UINT32 Seed
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < Length; Index++) {
+    Seed          = Seed * 1103515245 + 12345;
+    Buffer[Index] = (UINT8)(Seed >> 16);
+  }
+}
+
+/**
+  Byte-wise reference copy that handles overlapping buffers.
+
+  @param[out] Destination  The target of the copy.
+  @param[in]  Source       The source of the copy.
+  @param[in]  Length       The number of bytes to copy.
+**/
+STATIC
+VOID
+ReferenceCopy (
+  OUT UINT8        *Destination,
+  IN  CONST UINT8  *Source,
+  IN  UINTN        Length
+  )
+{
+  UINTN  Index;
+
+  if (Destination < Source) {
+    for (Index = 0; Index < Length; Index++) {
+      Destination[Index] = Source[Index];
+    }
+  } else {
+    for (Index = Length; Index > 0; Index--) {
+      Destination[Index - 1] = Source[Index - 1];
+    }
+  }
+}
+
+/**
+  Return TRUE if two buffers hold the same bytes, without using BaseMemoryLib.
+
+  @param[in] Buffer1  The first buffer.
+  @param[in] Buffer2  The second buffer.
+  @param[in] Length   The number of bytes to compare.
+**/
+STATIC
+BOOLEAN
+ReferenceEqual (
+  IN CONST UINT8  *Buffer1,
+  IN CONST UINT8  *Buffer2,
+  IN UINTN        Length
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < Length; Index++) {
+    if (Buffer1[Index] != Buffer2[Index]) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Allocate the test buffers and probe the vector level of the processor.
+
+  @param[in] Context  Unused.
+
+  @retval UNIT_TEST_PASSED                        The buffers were allocated.
+  @retval UNIT_TEST_ERROR_PREREQUISITE_NOT_MET    The buffers could not be allocated.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+AllocateTestBuffers (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  mSource      = AllocatePool (TEST_BUFFER_SIZE + 64);
+  mDestination = AllocatePool (TEST_BUFFER_SIZE + 64);
+  mExpected    = AllocatePool (TEST_BUFFER_SIZE + 64);
+  if ((mSource == NULL) || (mDestination == NULL) || (mExpected == NULL)) {
+    return UNIT_TEST_ERROR_PREREQUISITE_NOT_MET;
+  }
+
+  //
+  // A copy above the vector threshold probes and caches the processor level.
+  //
+  mMemLibVectorLevel = MEM_VECTOR_UNKNOWN;
+  CopyMem (mDestination, mSource, SIZE_4KB);
+  mSupportedLevel = mMemLibVectorLevel;
+  if (mSupportedLevel > MEM_VECTOR_AVX512) {
+    mSupportedLevel = MEM_VECTOR_NONE;
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Free the test buffers and restore the probed vector level.
+
+  @param[in] Context  Unused.
+**/
+STATIC
+VOID
+EFIAPI
+FreeTestBuffers (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  mMemLibVectorLevel = mSupportedLevel;
+  FreePool (mSource);
+  FreePool (mDestination);
+  FreePool (mExpected);
+}
+
+/**
+  Check CopyMem with every size, misaligned and overlapping buffers.
+
+  @param[in] Context  Unused.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+CopyMemTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINT8  Level;
+  UINTN  SizeIndex;
+  UINTN  Offset;
+  UINTN  Length;
+  VOID   *Result;
+
+  for (Level = MEM_VECTOR_NONE; Level <= mSupportedLevel; Level++) {
+    mMemLibVectorLevel = Level;
+    for (SizeIndex = 0; SizeIndex < ARRAY_SIZE (mTestSizes); SizeIndex++) {
+      Length = mTestSizes[SizeIndex];
+      for (Offset = 0; Offset < 64; Offset += 21) {
+        FillPattern (mSource, TEST_BUFFER_SIZE + 64, (UINT32)(Length + Offset));
+        FillPattern (mDestination, TEST_BUFFER_SIZE + 64, (UINT32)Offset);
+        ReferenceCopy (mExpected, mDestination, TEST_BUFFER_SIZE + 64);
+
+        Result = CopyMem (mDestination + Offset, mSource + 63 - Offset, Length);
+        ReferenceCopy (mExpected + Offset, mSource + 63 - Offset, Length);
+        UT_ASSERT_EQUAL ((UINTN)Result, (UINTN)(mDestination + Offset));
+        UT_ASSERT_TRUE (ReferenceEqual (mDestination, mExpected, TEST_BUFFER_SIZE + 64));
+
+        //
+        // Overlapping copies in both directions.
+        //
+        if (Length + Offset <= TEST_BUFFER_SIZE) {
+          CopyMem (mDestination + Offset, mDestination, Length);
+          ReferenceCopy (mExpected + Offset, mExpected, Length);
+          UT_ASSERT_TRUE (ReferenceEqual (mDestination, mExpected, TEST_BUFFER_SIZE + 64));
+
+          CopyMem (mDestination, mDestination + Offset, Length);
+          ReferenceCopy (mExpected, mExpected + Offset, Length);
+          UT_ASSERT_TRUE (ReferenceEqual (mDestination, mExpected, TEST_BUFFER_SIZE + 64));
+        }
+      }
+    }
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check SetMem and ZeroMem with every size and misaligned buffers.
+
+  @param[in] Context  Unused.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+SetMemTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINT8  Level;
+  UINTN  SizeIndex;
+  UINTN  Offset;
+  UINTN  Length;
+  UINTN  Index;
+  VOID   *Result;
+
+  for (Level = MEM_VECTOR_NONE; Level <= mSupportedLevel; Level++) {
+    mMemLibVectorLevel = Level;
+    for (SizeIndex = 0; SizeIndex < ARRAY_SIZE (mTestSizes); SizeIndex++) {
+      Length = mTestSizes[SizeIndex];
+      for (Offset = 0; Offset < 64; Offset += 21) {
+        FillPattern (mDestination, TEST_BUFFER_SIZE + 64, (UINT32)Length);
+        ReferenceCopy (mExpected, mDestination, TEST_BUFFER_SIZE + 64);
+
+        Result = SetMem (mDestination + Offset, Length, 0xA5);
+        for (Index = 0; Index < Length; Index++) {
+          mExpected[Offset + Index] = 0xA5;
+        }
+
+        UT_ASSERT_EQUAL ((UINTN)Result, (UINTN)(mDestination + Offset));
+        UT_ASSERT_TRUE (ReferenceEqual (mDestination, mExpected, TEST_BUFFER_SIZE + 64));
+
+        Result = ZeroMem (mDestination + Offset, Length);
+        for (Index = 0; Index < Length; Index++) {
+          mExpected[Offset + Index] = 0;
+        }
+
+        UT_ASSERT_EQUAL ((UINTN)Result, (UINTN)(mDestination + Offset));
+        UT_ASSERT_TRUE (ReferenceEqual (mDestination, mExpected, TEST_BUFFER_SIZE + 64));
+      }
+    }
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check CompareMem on equal buffers and on a difference at every block offset.
+
+  @param[in] Context  Unused.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+CompareMemTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINT8  Level;
+  UINTN  SizeIndex;
+  UINTN  Length;
+  UINTN  Position;
+
+  for (Level = MEM_VECTOR_NONE; Level <= mSupportedLevel; Level++) {
+    mMemLibVectorLevel = Level;
+    for (SizeIndex = 0; SizeIndex < ARRAY_SIZE (mTestSizes); SizeIndex++) {
+      Length = mTestSizes[SizeIndex];
+      FillPattern (mSource, Length + 1, (UINT32)Length);
+      ReferenceCopy (mDestination + 1, mSource, Length);
+      UT_ASSERT_EQUAL (CompareMem (mSource, mDestination + 1, Length), 0);
+
+      for (Position = Length - 1; ; Position = Position * 3 / 4) {
+        mDestination[1 + Position] = (UINT8)(mSource[Position] + 1);
+        UT_ASSERT_EQUAL (
+          CompareMem (mSource, mDestination + 1, Length),
+          (INTN)mSource[Position] - (INTN)mDestination[1 + Position]
+          );
+        UT_ASSERT_EQUAL (
+          CompareMem (mDestination + 1, mSource, Length),
+          (INTN)mDestination[1 + Position] - (INTN)mSource[Position]
+          );
+        mDestination[1 + Position] = mSource[Position];
+        if (Position == 0) {
+          break;
+        }
+      }
+    }
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Report the TSC ticks per KB of each memory function at each vector level.
+
+  @param[in] Context  Unused.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+BenchmarkTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINT8   Level;
+  UINTN   SizeIndex;
+  UINTN   Length;
+  UINTN   Iterations;
+  UINTN   Index;
+  UINT64  Start;
+  UINT64  Copy;
+  UINT64  Set;
+  UINT64  Compare;
+
+  FillPattern (mSource, TEST_BUFFER_SIZE, 1);
+  for (Level = MEM_VECTOR_NONE; Level <= mSupportedLevel; Level++) {
+    mMemLibVectorLevel = Level;
+    for (SizeIndex = 0; SizeIndex < ARRAY_SIZE (mBenchmarkSizes); SizeIndex++) {
+      Length     = mBenchmarkSizes[SizeIndex];
+      Iterations = SIZE_64MB / Length;
+
+      Start = AsmReadTsc ();
+      for (Index = 0; Index < Iterations; Index++) {
+        CopyMem (mDestination, mSource + 1, Length);
+      }
+
+      Copy  = AsmReadTsc () - Start;
+      Start = AsmReadTsc ();
+      for (Index = 0; Index < Iterations; Index++) {
+        SetMem (mDestination, Length, 0x5A);
+      }
+
+      Set = AsmReadTsc () - Start;
+      CopyMem (mDestination, mSource, Length);
+      Start = AsmReadTsc ();
+      for (Index = 0; Index < Iterations; Index++) {
+        CompareMem (mDestination, mSource, Length);
+      }
+
+      Compare = AsmReadTsc () - Start;
+      UT_LOG_INFO (
+        "Level %d, %8ld bytes: CopyMem %ld, SetMem %ld, CompareMem %ld ticks/KB\n",
+        Level,
+        (UINT64)Length,
+        DivU64x32 (Copy, SIZE_64KB),
+        DivU64x32 (Set, SIZE_64KB),
+        DivU64x32 (Compare, SIZE_64KB)
+        );
+    }
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  BaseMemoryLibOptDxe and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Fw;
+  UNIT_TEST_SUITE_HANDLE      MemTests;
+  UNIT_TEST_SUITE_HANDLE      BenchmarkTests;
+
+  Fw = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Fw, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&MemTests, Fw, "CopyMem, SetMem, ZeroMem and CompareMem", "BaseMemoryLibOptDxe.Mem", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for MemTests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  // --------------Suite-----Description--------------------Class Name----Function--------Pre------------------Post-------------Context-----------
+  AddTestCase (MemTests, "CopyMem matches reference", "CopyMem", CopyMemTest, AllocateTestBuffers, FreeTestBuffers, NULL);
+  AddTestCase (MemTests, "SetMem and ZeroMem match reference", "SetMem", SetMemTest, AllocateTestBuffers, FreeTestBuffers, NULL);
+  AddTestCase (MemTests, "CompareMem matches reference", "CompareMem", CompareMemTest, AllocateTestBuffers, FreeTestBuffers, NULL);
+
+  Status = CreateUnitTestSuite (&BenchmarkTests, Fw, "Memory function throughput", "BaseMemoryLibOptDxe.Benchmark", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for BenchmarkTests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (BenchmarkTests, "Ticks per KB at each vector level", "Benchmark", BenchmarkTest, AllocateTestBuffers, FreeTestBuffers, NULL);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Fw);
+
+EXIT:
+  if (Fw) {
+    FreeUnitTestFramework (Fw);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
@@ -379,6 +379,8 @@ DnsUnload (
       FreePool (ItemCache4);
     }
 
+    FreeDnsNegativeCache (&mDriverData->Dns4NegativeCacheList);
+
     while (!IsListEmpty (&mDriverData->Dns4ServerList)) {
       Entry = NetListRemoveHead (&mDriverData->Dns4ServerList);
       ASSERT (Entry != NULL);
@@ -395,6 +397,8 @@ DnsUnload (
       FreePool (ItemCache6);
     }
 
+    FreeDnsNegativeCache (&mDriverData->Dns6NegativeCacheList);
+
     while (!IsListEmpty (&mDriverData->Dns6ServerList)) {
       Entry = NetListRemoveHead (&mDriverData->Dns6ServerList);
       ASSERT (Entry != NULL);
@@ -489,8 +493,10 @@ DnsDriverEntryPoint (
   }
 
   InitializeListHead (&mDriverData->Dns4CacheList);
+  InitializeListHead (&mDriverData->Dns4NegativeCacheList);
   InitializeListHead (&mDriverData->Dns4ServerList);
   InitializeListHead (&mDriverData->Dns6CacheList);
+  InitializeListHead (&mDriverData->Dns6NegativeCacheList);
   InitializeListHead (&mDriverData->Dns6ServerList);
 
   return Status;
@@ -35,9 +35,11 @@ struct _DNS_DRIVER_DATA {
   EFI_EVENT     Timer;                 /// Ticking timer for DNS cache update.
 
   LIST_ENTRY    Dns4CacheList;
+  LIST_ENTRY    Dns4NegativeCacheList; /// Names that have no A record.
   LIST_ENTRY    Dns4ServerList;
 
   LIST_ENTRY    Dns6CacheList;
+  LIST_ENTRY    Dns6NegativeCacheList; /// Names that have no AAAA record.
   LIST_ENTRY    Dns6ServerList;
 };
 
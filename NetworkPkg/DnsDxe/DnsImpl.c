@@ -942,6 +942,114 @@ UpdateDns6Cache (
   return EFI_SUCCESS;
 }
 
+/**
+  Look up a host name in a shared negative cache list.
+
+  @param  NegativeCacheList  The Dns4 or Dns6 negative cache list.
+  @param  HostName           The host name to look up.
+
+  @return The recorded negative cache entry, or NULL if there is none.
+
+**/
+DNS_NEGATIVE_CACHE *
+FindDnsNegativeCache (
+  IN LIST_ENTRY  *NegativeCacheList,
+  IN CHAR16      *HostName
+  )
+{
+  LIST_ENTRY          *Entry;
+  DNS_NEGATIVE_CACHE  *Item;
+
+  NET_LIST_FOR_EACH (Entry, NegativeCacheList) {
+    Item = NET_LIST_USER_STRUCT (Entry, DNS_NEGATIVE_CACHE, AllCacheLink);
+    if (StrCmp (HostName, Item->HostName) == 0) {
+      return Item;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Record or drop a negative answer in a shared negative cache list.
+
+  A name that is already recorded gets its timeout refreshed. A Timeout of
+  zero removes the name from the list, which is done once a query for it is
+  answered with addresses again.
+
+  @param  NegativeCacheList  The Dns4 or Dns6 negative cache list.
+  @param  HostName           The host name that has no addresses.
+  @param  Status             Status the negative answer completed the token with.
+  @param  Timeout            Seconds to keep the entry, or 0 to remove it.
+
+  @retval EFI_SUCCESS           The negative cache was updated.
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate the new entry.
+
+**/
+EFI_STATUS
+UpdateDnsNegativeCache (
+  IN LIST_ENTRY  *NegativeCacheList,
+  IN CHAR16      *HostName,
+  IN EFI_STATUS  Status,
+  IN UINT32      Timeout
+  )
+{
+  DNS_NEGATIVE_CACHE  *Item;
+
+  Item = FindDnsNegativeCache (NegativeCacheList, HostName);
+  if (Timeout == 0) {
+    if (Item != NULL) {
+      RemoveEntryList (&Item->AllCacheLink);
+      FreePool (Item->HostName);
+      FreePool (Item);
+    }
+
+    return EFI_SUCCESS;
+  }
+
+  if (Item == NULL) {
+    Item = AllocateZeroPool (sizeof (DNS_NEGATIVE_CACHE));
+    if (Item == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Item->HostName = AllocateCopyPool (StrSize (HostName), HostName);
+    if (Item->HostName == NULL) {
+      FreePool (Item);
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    InsertTailList (NegativeCacheList, &Item->AllCacheLink);
+  }
+
+  Item->Status  = Status;
+  Item->Timeout = Timeout;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Free all the entries of a negative cache list.
+
+  @param  NegativeCacheList  The Dns4 or Dns6 negative cache list.
+
+**/
+VOID
+FreeDnsNegativeCache (
+  IN LIST_ENTRY  *NegativeCacheList
+  )
+{
+  LIST_ENTRY          *Entry;
+  DNS_NEGATIVE_CACHE  *Item;
+
+  while (!IsListEmpty (NegativeCacheList)) {
+    Entry = NetListRemoveHead (NegativeCacheList);
+    Item  = NET_LIST_USER_STRUCT (Entry, DNS_NEGATIVE_CACHE, AllCacheLink);
+    FreePool (Item->HostName);
+    FreePool (Item);
+  }
+}
+
 /**
   Add Dns4 ServerIp to common list of addresses of all configured DNSv4 server.
 
@@ -1108,6 +1216,78 @@ IsValidDnsResponse (
   return FALSE;
 }
 
+/**
+  Get how long a negative answer may be cached.
+
+  Per RFC 2308 section 5, the time is the lesser of the TTL of the SOA record
+  in the authority section and its MINIMUM field. Answers that carry no SOA
+  record are not cached.
+
+  @param  DnsHeader             The DNS header, already in host byte order.
+  @param  Authority             Start of the authority section.
+  @param  Length                Remaining length of the packet from Authority.
+
+  @return The negative cache time in seconds, or 0 if it must not be cached.
+
+**/
+UINT32
+GetDnsNegativeTtl (
+  IN DNS_HEADER  *DnsHeader,
+  IN UINT8       *Authority,
+  IN UINT32      Length
+  )
+{
+  DNS_ANSWER_SECTION  *Section;
+  UINT32              Offset;
+  UINT32              Minimum;
+
+  //
+  // The authority section directly follows the question only if there are no answers.
+  //
+  if ((DnsHeader->AnswersNum != 0) || (DnsHeader->AuthorityNum < 1)) {
+    return 0;
+  }
+
+  //
+  // Skip the owner name, which ends with the root label or a compression pointer.
+  //
+  Offset = 0;
+  while (Offset < Length) {
+    if ((Authority[Offset] & 0xC0) == 0xC0) {
+      Offset += sizeof (UINT16);
+      break;
+    }
+
+    if (Authority[Offset] == 0) {
+      Offset++;
+      break;
+    }
+
+    Offset += Authority[Offset] + 1;
+  }
+
+  if ((Offset > Length) || (Length - Offset < sizeof (DNS_ANSWER_SECTION))) {
+    return 0;
+  }
+
+  Section = (DNS_ANSWER_SECTION *)(Authority + Offset);
+  Offset += sizeof (DNS_ANSWER_SECTION);
+
+  //
+  // SOA RDATA is two domain names followed by five 32-bit fields, MINIMUM last.
+  //
+  if ((NTOHS (Section->Type) != DNS_TYPE_SOA) ||
+      (NTOHS (Section->DataLength) < 2 + 5 * sizeof (UINT32)) ||
+      (NTOHS (Section->DataLength) > Length - Offset))
+  {
+    return 0;
+  }
+
+  Minimum = NTOHL (ReadUnaligned32 ((UINT32 *)(Authority + Offset + NTOHS (Section->DataLength) - sizeof (UINT32))));
+
+  return MIN (MIN (NTOHL (Section->Ttl), Minimum), DNS_NEGATIVE_CACHE_MAX_TTL);
+}
+
 /**
   Parse Dns Response.
 
@@ -1158,6 +1338,7 @@ ParseDnsResponse (
 
   EFI_STATUS  Status;
   UINT32      RemainingLength;
+  UINT32      NegativeTtl;
 
   EFI_TPL  OldTpl;
 
@@ -1292,6 +1473,24 @@ ParseDnsResponse (
       Status = EFI_DEVICE_ERROR;
     }
 
+    //
+    // Remember names that do not exist or have no address of the queried type,
+    // so that retries from other children are answered without a round trip.
+    //
+    if ((DnsHeader->Flags.Bits.QR == DNS_FLAGS_QR_RESPONSE) &&
+        ((DnsHeader->Flags.Bits.RCode == DNS_FLAGS_RCODE_NAME_ERROR) ||
+         (DnsHeader->Flags.Bits.RCode == DNS_FLAGS_RCODE_NO_ERROR)))
+    {
+      NegativeTtl = GetDnsNegativeTtl (DnsHeader, (UINT8 *)QuerySection + sizeof (*QuerySection), RemainingLength);
+      if (NegativeTtl != 0) {
+        if ((Dns4TokenEntry != NULL) && !Dns4TokenEntry->GeneralLookUp) {
+          UpdateDnsNegativeCache (&mDriverData->Dns4NegativeCacheList, Dns4TokenEntry->QueryHostName, Status, NegativeTtl);
+        } else if ((Dns6TokenEntry != NULL) && !Dns6TokenEntry->GeneralLookUp) {
+          UpdateDnsNegativeCache (&mDriverData->Dns6NegativeCacheList, Dns6TokenEntry->QueryHostName, Status, NegativeTtl);
+        }
+      }
+    }
+
     goto ON_COMPLETE;
   }
 
@@ -1646,6 +1845,9 @@ ParseDnsResponse (
     } else {
       if (QuerySection->Type == DNS_TYPE_A) {
         Dns4TokenEntry->Token->RspData.H2AData->IpCount = IpCount;
+        if (IpCount != 0) {
+          UpdateDnsNegativeCache (&mDriverData->Dns4NegativeCacheList, Dns4TokenEntry->QueryHostName, EFI_SUCCESS, 0);
+        }
       } else {
         Status = EFI_UNSUPPORTED;
         goto ON_EXIT;
@@ -1659,6 +1861,9 @@ ParseDnsResponse (
     } else {
       if (QuerySection->Type == DNS_TYPE_AAAA) {
         Dns6TokenEntry->Token->RspData.H2AData->IpCount = IpCount;
+        if (IpCount != 0) {
+          UpdateDnsNegativeCache (&mDriverData->Dns6NegativeCacheList, Dns6TokenEntry->QueryHostName, EFI_SUCCESS, 0);
+        }
       } else {
         Status = EFI_UNSUPPORTED;
         goto ON_EXIT;
@@ -2221,10 +2426,13 @@ DnsOnTimerUpdate (
   IN VOID       *Context
   )
 {
-  LIST_ENTRY  *Entry;
-  LIST_ENTRY  *Next;
-  DNS4_CACHE  *Item4;
-  DNS6_CACHE  *Item6;
+  LIST_ENTRY          *Entry;
+  LIST_ENTRY          *Next;
+  DNS4_CACHE          *Item4;
+  DNS6_CACHE          *Item6;
+  LIST_ENTRY          *NegativeCacheList[2];
+  DNS_NEGATIVE_CACHE  *NegativeItem;
+  UINTN               Index;
 
   Item4 = NULL;
   Item6 = NULL;
@@ -2272,4 +2480,20 @@ DnsOnTimerUpdate (
       Entry = Entry->ForwardLink;
     }
   }
+
+  //
+  // Age the negative caches of both versions.
+  //
+  NegativeCacheList[0] = &mDriverData->Dns4NegativeCacheList;
+  NegativeCacheList[1] = &mDriverData->Dns6NegativeCacheList;
+  for (Index = 0; Index < ARRAY_SIZE (NegativeCacheList); Index++) {
+    NET_LIST_FOR_EACH_SAFE (Entry, Next, NegativeCacheList[Index]) {
+      NegativeItem = NET_LIST_USER_STRUCT (Entry, DNS_NEGATIVE_CACHE, AllCacheLink);
+      if (--NegativeItem->Timeout == 0) {
+        RemoveEntryList (&NegativeItem->AllCacheLink);
+        FreePool (NegativeItem->HostName);
+        FreePool (NegativeItem);
+      }
+    }
+  }
 }
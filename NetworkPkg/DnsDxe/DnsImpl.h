@@ -83,6 +83,13 @@ extern EFI_DNS6_PROTOCOL             mDns6Protocol;
 
 #define DNS_TIME_TO_GETMAP  5
 
+//
+// Upper bound in seconds for how long a negative answer is cached, so a
+// name that is provisioned while the platform boots is not hidden for the
+// full SOA minimum (RFC 2308 allows up to three hours).
+//
+#define DNS_NEGATIVE_CACHE_MAX_TTL  300
+
 #pragma pack(1)
 
 typedef union _DNS_FLAGS DNS_FLAGS;
@@ -97,6 +104,13 @@ typedef struct {
   EFI_DNS6_CACHE_ENTRY    DnsCache;
 } DNS6_CACHE;
 
+typedef struct {
+  LIST_ENTRY    AllCacheLink;
+  CHAR16        *HostName;
+  EFI_STATUS    Status;       /// Status the original answer completed with.
+  UINT32        Timeout;
+} DNS_NEGATIVE_CACHE;
+
 typedef struct {
   LIST_ENTRY          AllServerLink;
   EFI_IPv4_ADDRESS    Dns4ServerIp;
@@ -515,6 +529,56 @@ UpdateDns6Cache (
   IN EFI_DNS6_CACHE_ENTRY  DnsCacheEntry
   );
 
+/**
+  Record or drop a negative answer in a shared negative cache list.
+
+  A name that is already recorded gets its timeout refreshed. A Timeout of
+  zero removes the name from the list, which is done once a query for it is
+  answered with addresses again.
+
+  @param  NegativeCacheList  The Dns4 or Dns6 negative cache list.
+  @param  HostName           The host name that has no addresses.
+  @param  Status             Status the negative answer completed the token with.
+  @param  Timeout            Seconds to keep the entry, or 0 to remove it.
+
+  @retval EFI_SUCCESS           The negative cache was updated.
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate the new entry.
+
+**/
+EFI_STATUS
+UpdateDnsNegativeCache (
+  IN LIST_ENTRY  *NegativeCacheList,
+  IN CHAR16      *HostName,
+  IN EFI_STATUS  Status,
+  IN UINT32      Timeout
+  );
+
+/**
+  Look up a host name in a shared negative cache list.
+
+  @param  NegativeCacheList  The Dns4 or Dns6 negative cache list.
+  @param  HostName           The host name to look up.
+
+  @return The recorded negative cache entry, or NULL if there is none.
+
+**/
+DNS_NEGATIVE_CACHE *
+FindDnsNegativeCache (
+  IN LIST_ENTRY  *NegativeCacheList,
+  IN CHAR16      *HostName
+  );
+
+/**
+  Free all the entries of a negative cache list.
+
+  @param  NegativeCacheList  The Dns4 or Dns6 negative cache list.
+
+**/
+VOID
+FreeDnsNegativeCache (
+  IN LIST_ENTRY  *NegativeCacheList
+  );
+
 /**
   Add Dns4 ServerIp to common list of addresses of all configured DNSv4 server.
 
@@ -342,10 +342,11 @@ Dns4HostNameToIp (
 
   EFI_DNS4_CONFIG_DATA  *ConfigData;
 
-  UINTN       Index;
-  DNS4_CACHE  *Item;
-  LIST_ENTRY  *Entry;
-  LIST_ENTRY  *Next;
+  UINTN               Index;
+  DNS4_CACHE          *Item;
+  DNS_NEGATIVE_CACHE  *NegativeItem;
+  LIST_ENTRY          *Entry;
+  LIST_ENTRY          *Next;
 
   CHAR8  *QueryName;
 
@@ -450,6 +451,22 @@ Dns4HostNameToIp (
       Status = Token->Status;
       goto ON_EXIT;
     }
+
+    //
+    // A recent answer said the name has no address, report it again until it times out.
+    //
+    NegativeItem = FindDnsNegativeCache (&mDriverData->Dns4NegativeCacheList, HostName);
+    if (NegativeItem != NULL) {
+      Token->Status = NegativeItem->Status;
+
+      if (Token->Event != NULL) {
+        gBS->SignalEvent (Token->Event);
+        DispatchDpc ();
+      }
+
+      Status = Token->Status;
+      goto ON_EXIT;
+    }
   }
 
   //
@@ -1188,10 +1205,11 @@ Dns6HostNameToIp (
 
   EFI_DNS6_CONFIG_DATA  *ConfigData;
 
-  UINTN       Index;
-  DNS6_CACHE  *Item;
-  LIST_ENTRY  *Entry;
-  LIST_ENTRY  *Next;
+  UINTN               Index;
+  DNS6_CACHE          *Item;
+  DNS_NEGATIVE_CACHE  *NegativeItem;
+  LIST_ENTRY          *Entry;
+  LIST_ENTRY          *Next;
 
   CHAR8  *QueryName;
 
@@ -1296,6 +1314,22 @@ Dns6HostNameToIp (
       Status = Token->Status;
       goto ON_EXIT;
     }
+
+    //
+    // A recent answer said the name has no address, report it again until it times out.
+    //
+    NegativeItem = FindDnsNegativeCache (&mDriverData->Dns6NegativeCacheList, HostName);
+    if (NegativeItem != NULL) {
+      Token->Status = NegativeItem->Status;
+
+      if (Token->Event != NULL) {
+        gBS->SignalEvent (Token->Event);
+        DispatchDpc ();
+      }
+
+      Status = Token->Status;
+      goto ON_EXIT;
+    }
   }
 
   //
@@ -597,17 +597,19 @@ HttpBootHttpIoCallback (
 }
 
 /**
-  Create a HttpIo instance for the file download.
+  Create and configure a HttpIo instance on the boot NIC.
 
   @param[in]    Private        The pointer to the driver's private data.
+  @param[out]   HttpIo         The HttpIo instance to be created.
 
   @retval EFI_SUCCESS          Successfully created.
   @retval Others               Failed to create HttpIo.
 
 **/
 EFI_STATUS
-HttpBootCreateHttpIo (
-  IN     HTTP_BOOT_PRIVATE_DATA  *Private
+HttpBootConfigureHttpIo (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  OUT    HTTP_IO                 *HttpIo
   )
 {
   HTTP_IO_CONFIG_DATA  ConfigData;
@@ -643,8 +645,28 @@ HttpBootCreateHttpIo (
              &ConfigData,
              HttpBootHttpIoCallback,
              (VOID *)Private,
-             &Private->HttpIo
+             HttpIo
              );
+  return Status;
+}
+
+/**
+  Create a HttpIo instance for the file download.
+
+  @param[in]    Private        The pointer to the driver's private data.
+
+  @retval EFI_SUCCESS          Successfully created.
+  @retval Others               Failed to create HttpIo.
+
+**/
+EFI_STATUS
+HttpBootCreateHttpIo (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = HttpBootConfigureHttpIo (Private, &Private->HttpIo);
   if (EFI_ERROR (Status)) {
     return Status;
   }
@@ -901,6 +923,524 @@ HttpBootGetBootFileCallback (
   return EFI_SUCCESS;
 }
 
+/**
+  Parse a "Content-Range: bytes <first>-<last>/<length>" response header value.
+
+  @param[in]   Value           The field value of the Content-Range header.
+  @param[out]  FirstByte       The first byte position of the returned range.
+  @param[out]  LastByte        The last byte position of the returned range.
+  @param[out]  CompleteLength  The complete length of the selected representation.
+
+  @retval EFI_SUCCESS            The header value is parsed successfully.
+  @retval EFI_UNSUPPORTED        The header value is not a satisfied byte range.
+
+**/
+EFI_STATUS
+HttpBootParseContentRange (
+  IN     CHAR8  *Value,
+  OUT    UINTN  *FirstByte,
+  OUT    UINTN  *LastByte,
+  OUT    UINTN  *CompleteLength
+  )
+{
+  CHAR8  *EndPointer;
+
+  if (AsciiStrnCmp (Value, "bytes ", 6) != 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (RETURN_ERROR (AsciiStrDecimalToUintnS (Value + 6, &EndPointer, FirstByte)) || (*EndPointer != '-')) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (RETURN_ERROR (AsciiStrDecimalToUintnS (EndPointer + 1, &EndPointer, LastByte)) || (*EndPointer != '/')) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (RETURN_ERROR (AsciiStrDecimalToUintnS (EndPointer + 1, &EndPointer, CompleteLength))) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if ((*FirstByte > *LastByte) || (*LastByte >= *CompleteLength)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Build the HTTP headers of a byte range request for the boot file:
+    Host
+    Accept
+    User-Agent
+    [Authorization]
+    Range
+    [If-Match]|[If-Unmodified-Since]
+
+  @param[in]   Private         The pointer to the driver's private data.
+  @param[in]   FirstByte       The first byte position of the requested range.
+  @param[in]   LastByte        The last byte position of the requested range.
+  @param[out]  HttpIoHeader    The created headers. Caller must free it with HttpIoFreeHeader().
+
+  @retval EFI_SUCCESS            The headers are built successfully.
+  @retval EFI_OUT_OF_RESOURCES   Could not allocate needed resources.
+  @retval EFI_UNSUPPORTED        The authentication scheme is not supported.
+  @retval Others                 Unexpected error happened.
+
+**/
+EFI_STATUS
+HttpBootBuildRangeHeader (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN     UINTN                   FirstByte,
+  IN     UINTN                   LastByte,
+  OUT    HTTP_IO_HEADER          **HttpIoHeader
+  )
+{
+  EFI_STATUS      Status;
+  HTTP_IO_HEADER  *Header;
+  UINTN           HeadersCount;
+  CHAR8           *HostName;
+  CHAR8           BaseAuthValue[80];
+  CHAR8           RangeValue[64];
+
+  HeadersCount = 4;
+  if (Private->AuthData != NULL) {
+    HeadersCount++;
+  }
+
+  if (Private->LastModifiedOrEtag != NULL) {
+    HeadersCount++;
+  }
+
+  Header = HttpIoCreateHeader (HeadersCount);
+  if (Header == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  HostName = NULL;
+  Status   = HttpUrlGetHostName (
+               Private->BootFileUri,
+               Private->BootFileUriParser,
+               &HostName
+               );
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  Status = HttpIoSetHeader (Header, HTTP_HEADER_HOST, HostName);
+  FreePool (HostName);
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  Status = HttpIoSetHeader (Header, HTTP_HEADER_ACCEPT, "*/*");
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  Status = HttpIoSetHeader (Header, HTTP_HEADER_USER_AGENT, HTTP_USER_AGENT_EFI_HTTP_BOOT);
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  if (Private->AuthData != NULL) {
+    if ((Private->AuthScheme != NULL) && (CompareMem (Private->AuthScheme, "Basic", 5) != 0)) {
+      Status = EFI_UNSUPPORTED;
+      goto ON_ERROR;
+    }
+
+    AsciiSPrint (BaseAuthValue, sizeof (BaseAuthValue), "%a %a", "Basic", Private->AuthData);
+    Status = HttpIoSetHeader (Header, HTTP_HEADER_AUTHORIZATION, BaseAuthValue);
+    if (EFI_ERROR (Status)) {
+      goto ON_ERROR;
+    }
+  }
+
+  AsciiSPrint (RangeValue, sizeof (RangeValue), "bytes=%lu-%lu", (UINT64)FirstByte, (UINT64)LastByte);
+  Status = HttpIoSetHeader (Header, "Range", RangeValue);
+  if (EFI_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  //
+  // Make sure all the ranges come from the same representation that the HEAD
+  // request reported the size of.
+  //
+  if (Private->LastModifiedOrEtag != NULL) {
+    if (Private->LastModifiedOrEtag[0] == '"') {
+      Status = HttpIoSetHeader (Header, HTTP_HEADER_IF_MATCH, Private->LastModifiedOrEtag);
+    } else {
+      Status = HttpIoSetHeader (Header, HTTP_HEADER_IF_UNMODIFIED_SINCE, Private->LastModifiedOrEtag);
+    }
+
+    if (EFI_ERROR (Status)) {
+      goto ON_ERROR;
+    }
+  }
+
+  *HttpIoHeader = Header;
+  return EFI_SUCCESS;
+
+ON_ERROR:
+  HttpIoFreeHeader (Header);
+  return Status;
+}
+
+/**
+  Queue a response token on the connection of a parallel range download.
+
+  @param[in]   Connection      The connection to receive on.
+  @param[in]   RecvMsgHeader   TRUE to receive the response message header, FALSE to
+                               receive the message-body into the current range.
+  @param[in]   Buffer          The memory buffer the boot file is loaded in.
+
+  @retval EFI_SUCCESS          The response token is queued.
+  @retval Others               Failed to queue the response token.
+
+**/
+EFI_STATUS
+HttpBootRangeQueueResponse (
+  IN     HTTP_BOOT_RANGE_CONNECTION  *Connection,
+  IN     BOOLEAN                     RecvMsgHeader,
+  IN     UINT8                       *Buffer
+  )
+{
+  HTTP_IO  *HttpIo;
+  UINTN    Offset;
+
+  HttpIo                         = &Connection->HttpIo;
+  HttpIo->RspToken.Status        = EFI_NOT_READY;
+  HttpIo->RspMessage.HeaderCount = 0;
+  HttpIo->RspMessage.Headers     = NULL;
+  if (RecvMsgHeader) {
+    HttpIo->RspMessage.Data.Response = &Connection->ResponseData;
+    HttpIo->RspMessage.BodyLength    = 0;
+    HttpIo->RspMessage.Body          = NULL;
+  } else {
+    Offset                           = Connection->FirstByte + Connection->ReceivedSize;
+    HttpIo->RspMessage.Data.Response = NULL;
+    HttpIo->RspMessage.BodyLength    = Connection->LastByte + 1 - Offset;
+    HttpIo->RspMessage.Body          = Buffer + Offset;
+  }
+
+  HttpIo->IsRxDone = FALSE;
+  gBS->SetTimer (HttpIo->TimeoutEvent, TimerRelative, HttpIo->Timeout * TICKS_PER_MS);
+
+  return HttpIo->Http->Response (HttpIo->Http, &HttpIo->RspToken);
+}
+
+/**
+  Advance the state machine of one connection of a parallel range download
+  without blocking.
+
+  @param[in]       Private       The pointer to the driver's private data.
+  @param[in]       Connection    The connection to process.
+  @param[in]       RequestData   The GET request of the boot file.
+  @param[in]       ChunkSize     The size of each range request.
+  @param[out]      Buffer        The memory buffer to load the boot file in.
+  @param[in, out]  NextByte      The first byte of the file not yet requested.
+  @param[in, out]  LoadedSize    The number of bytes loaded in Buffer so far.
+
+  @retval EFI_SUCCESS            The connection is progressing or idle.
+  @retval EFI_TIMEOUT            The connection timed out.
+  @retval EFI_UNSUPPORTED        The server did not answer with the requested range.
+  @retval Others                 Unexpected error happened.
+
+**/
+EFI_STATUS
+HttpBootRangeProcess (
+  IN     HTTP_BOOT_PRIVATE_DATA      *Private,
+  IN     HTTP_BOOT_RANGE_CONNECTION  *Connection,
+  IN     EFI_HTTP_REQUEST_DATA       *RequestData,
+  IN     UINTN                       ChunkSize,
+  OUT    UINT8                       *Buffer,
+  IN OUT UINTN                       *NextByte,
+  IN OUT UINTN                       *LoadedSize
+  )
+{
+  EFI_STATUS       Status;
+  HTTP_IO          *HttpIo;
+  EFI_HTTP_HEADER  *Header;
+  UINTN            FirstByte;
+  UINTN            LastByte;
+  UINTN            CompleteLength;
+  BOOLEAN          Done;
+
+  HttpIo = &Connection->HttpIo;
+
+  if (Connection->State == HttpBootRangeIdle) {
+    if (*NextByte >= Private->BootFileSize) {
+      return EFI_SUCCESS;
+    }
+
+    Connection->FirstByte    = *NextByte;
+    Connection->LastByte     = MIN (Private->BootFileSize - *NextByte, ChunkSize) + *NextByte - 1;
+    Connection->ReceivedSize = 0;
+    *NextByte                = Connection->LastByte + 1;
+
+    Status = HttpBootBuildRangeHeader (
+               Private,
+               Connection->FirstByte,
+               Connection->LastByte,
+               &Connection->HttpIoHeader
+               );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    HttpIo->ReqToken.Status         = EFI_NOT_READY;
+    HttpIo->ReqMessage.Data.Request = RequestData;
+    HttpIo->ReqMessage.HeaderCount  = Connection->HttpIoHeader->HeaderCount;
+    HttpIo->ReqMessage.Headers      = Connection->HttpIoHeader->Headers;
+    HttpIo->ReqMessage.BodyLength   = 0;
+    HttpIo->ReqMessage.Body         = NULL;
+
+    if (HttpIo->Callback != NULL) {
+      Status = HttpIo->Callback (HttpIoRequest, HttpIo->ReqToken.Message, HttpIo->Context);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+    }
+
+    HttpIo->IsTxDone = FALSE;
+    gBS->SetTimer (HttpIo->TimeoutEvent, TimerRelative, HttpIo->Timeout * TICKS_PER_MS);
+    Status = HttpIo->Http->Request (HttpIo->Http, &HttpIo->ReqToken);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Connection->State = HttpBootRangeSendRequest;
+    return EFI_SUCCESS;
+  }
+
+  //
+  // A token is pending on this connection, check whether it is completed.
+  //
+  Done = (Connection->State == HttpBootRangeSendRequest) ? HttpIo->IsTxDone : HttpIo->IsRxDone;
+  if (!Done) {
+    if (!EFI_ERROR (gBS->CheckEvent (HttpIo->TimeoutEvent))) {
+      return EFI_TIMEOUT;
+    }
+
+    HttpIo->Http->Poll (HttpIo->Http);
+    return EFI_SUCCESS;
+  }
+
+  gBS->SetTimer (HttpIo->TimeoutEvent, TimerCancel, 0);
+
+  switch (Connection->State) {
+    case HttpBootRangeSendRequest:
+      HttpIoFreeHeader (Connection->HttpIoHeader);
+      Connection->HttpIoHeader = NULL;
+      if (EFI_ERROR (HttpIo->ReqToken.Status)) {
+        return HttpIo->ReqToken.Status;
+      }
+
+      Status = HttpBootRangeQueueResponse (Connection, TRUE, Buffer);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      Connection->State = HttpBootRangeRecvHeader;
+      break;
+
+    case HttpBootRangeRecvHeader:
+      if (EFI_ERROR (HttpIo->RspToken.Status) && (HttpIo->RspToken.Status != EFI_HTTP_ERROR)) {
+        return HttpIo->RspToken.Status;
+      }
+
+      if (HttpIo->Callback != NULL) {
+        Status = HttpIo->Callback (HttpIoResponse, HttpIo->RspToken.Message, HttpIo->Context);
+        if (EFI_ERROR (Status)) {
+          HttpFreeHeaderFields (HttpIo->RspMessage.Headers, HttpIo->RspMessage.HeaderCount);
+          return Status;
+        }
+      }
+
+      //
+      // The server must return exactly the requested range of the same file,
+      // otherwise let the caller download the file in a single stream.
+      //
+      Status = EFI_UNSUPPORTED;
+      Header = HttpFindHeader (
+                 HttpIo->RspMessage.HeaderCount,
+                 HttpIo->RspMessage.Headers,
+                 HTTP_HEADER_CONTENT_RANGE
+                 );
+      if ((Connection->ResponseData.StatusCode == HTTP_STATUS_206_PARTIAL_CONTENT) && (Header != NULL)) {
+        Status = HttpBootParseContentRange (Header->FieldValue, &FirstByte, &LastByte, &CompleteLength);
+        if (!EFI_ERROR (Status) &&
+            ((FirstByte != Connection->FirstByte) || (LastByte != Connection->LastByte) ||
+             (CompleteLength != Private->BootFileSize)))
+        {
+          Status = EFI_UNSUPPORTED;
+        }
+      }
+
+      HttpFreeHeaderFields (HttpIo->RspMessage.Headers, HttpIo->RspMessage.HeaderCount);
+      if (EFI_ERROR (Status)) {
+        DEBUG ((
+          DEBUG_WARN | DEBUG_INFO,
+          "HttpBootRangeProcess: Range %lu-%lu not served, status code %d.\n",
+          (UINT64)Connection->FirstByte,
+          (UINT64)Connection->LastByte,
+          Connection->ResponseData.StatusCode
+          ));
+        return Status;
+      }
+
+      Status = HttpBootRangeQueueResponse (Connection, FALSE, Buffer);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      Connection->State = HttpBootRangeRecvBody;
+      break;
+
+    case HttpBootRangeRecvBody:
+      if (EFI_ERROR (HttpIo->RspToken.Status)) {
+        return HttpIo->RspToken.Status;
+      }
+
+      Connection->ReceivedSize += HttpIo->RspMessage.BodyLength;
+      *LoadedSize              += HttpIo->RspMessage.BodyLength;
+      if (Private->HttpBootCallback != NULL) {
+        Status = Private->HttpBootCallback->Callback (
+                                              Private->HttpBootCallback,
+                                              HttpBootHttpEntityBody,
+                                              TRUE,
+                                              (UINT32)HttpIo->RspMessage.BodyLength,
+                                              HttpIo->RspMessage.Body
+                                              );
+        if (EFI_ERROR (Status)) {
+          return Status;
+        }
+      }
+
+      if (Connection->FirstByte + Connection->ReceivedSize > Connection->LastByte) {
+        Connection->State = HttpBootRangeIdle;
+        break;
+      }
+
+      Status = HttpBootRangeQueueResponse (Connection, FALSE, Buffer);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+
+      break;
+
+    default:
+      ASSERT (FALSE);
+      return EFI_DEVICE_ERROR;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Download the boot file as concurrent HTTP byte range requests, each issued on
+  its own HTTP child instance and received directly into the right offset of
+  Buffer.
+
+  @param[in]   Private         The pointer to the driver's private data.
+  @param[in]   Url             The URL of the boot file.
+  @param[out]  Buffer          The memory buffer to transfer the file to, at least
+                               Private->BootFileSize bytes.
+
+  @retval EFI_SUCCESS          The whole file was loaded.
+  @retval EFI_UNSUPPORTED      The server does not support byte range requests.
+  @retval Others               The parallel download failed, the caller should
+                               download the file in a single stream.
+
+**/
+EFI_STATUS
+HttpBootGetBootFileByRange (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN     CHAR16                  *Url,
+  OUT    UINT8                   *Buffer
+  )
+{
+  EFI_STATUS                  Status;
+  HTTP_BOOT_RANGE_CONNECTION  *Connections;
+  UINTN                       Count;
+  UINTN                       Index;
+  UINTN                       ChunkSize;
+  UINTN                       NextByte;
+  UINTN                       LoadedSize;
+  EFI_HTTP_REQUEST_DATA       RequestData;
+
+  Count     = MIN (PcdGet8 (PcdHttpBootRangeConnections), HTTP_BOOT_RANGE_MAX_CONNECTIONS);
+  ChunkSize = PcdGet32 (PcdHttpBootRangeChunkSize);
+  if ((Count < 2) || (ChunkSize == 0)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Connections = AllocateZeroPool (Count * sizeof (HTTP_BOOT_RANGE_CONNECTION));
+  if (Connections == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Use as many HTTP children as could be created.
+  //
+  for (Index = 0; Index < Count; Index++) {
+    Status = HttpBootConfigureHttpIo (Private, &Connections[Index].HttpIo);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+
+  Count = Index;
+  if (Count == 0) {
+    goto ON_EXIT;
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "HttpBootGetBootFileByRange: Loading %lu bytes over %d connections.\n",
+    (UINT64)Private->BootFileSize,
+    (UINT32)Count
+    ));
+
+  RequestData.Method = HttpMethodGet;
+  RequestData.Url    = Url;
+  NextByte           = 0;
+  LoadedSize         = 0;
+  Status             = EFI_SUCCESS;
+  while (LoadedSize < Private->BootFileSize) {
+    for (Index = 0; Index < Count; Index++) {
+      Status = HttpBootRangeProcess (
+                 Private,
+                 &Connections[Index],
+                 &RequestData,
+                 ChunkSize,
+                 Buffer,
+                 &NextByte,
+                 &LoadedSize
+                 );
+      if (EFI_ERROR (Status)) {
+        goto ON_EXIT;
+      }
+    }
+  }
+
+ON_EXIT:
+  for (Index = 0; Index < Count; Index++) {
+    if (Connections[Index].State != HttpBootRangeIdle) {
+      Connections[Index].HttpIo.Http->Cancel (Connections[Index].HttpIo.Http, NULL);
+    }
+
+    if (Connections[Index].HttpIoHeader != NULL) {
+      HttpIoFreeHeader (Connections[Index].HttpIoHeader);
+    }
+
+    HttpIoDestroyIo (&Connections[Index].HttpIo);
+  }
+
+  FreePool (Connections);
+  return Status;
+}
+
 /**
   This function download the boot file by using UEFI HTTP protocol.
 
@@ -992,6 +1532,33 @@ HttpBootGetBootFile (
     }
   }
 
+  //
+  // A large file of known size may be loaded as concurrent byte ranges. If the
+  // server doesn't serve ranges or any of them fails, fall back to the single
+  // stream download below.
+  //
+  if (!HeaderOnly && (Buffer != NULL) &&
+      (Private->PartialTransferredSize == 0) &&
+      (Private->BootFileSize != 0) &&
+      (*BufferSize >= Private->BootFileSize) &&
+      (PcdGet8 (PcdHttpBootRangeConnections) > 1) &&
+      (Private->BootFileSize > PcdGet32 (PcdHttpBootRangeChunkSize)))
+  {
+    Status = HttpBootGetBootFileByRange (Private, Url, Buffer);
+    if (!EFI_ERROR (Status)) {
+      *BufferSize = Private->BootFileSize;
+      *ImageType  = Private->ImageType;
+      FreePool (Url);
+      return EFI_SUCCESS;
+    }
+
+    DEBUG ((
+      DEBUG_WARN | DEBUG_INFO,
+      "HttpBootGetBootFile: Range download failed (%r), loading in a single stream.\n",
+      Status
+      ));
+  }
+
   // Check if this is a previous download that has failed and need to be resumed
   if ((!HeaderOnly) &&
       (Private->PartialTransferredSize > 0) &&
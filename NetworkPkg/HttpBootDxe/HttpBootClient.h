@@ -13,6 +13,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define HTTP_BOOT_BLOCK_SIZE                   32000
 #define HTTP_USER_AGENT_EFI_HTTP_BOOT          "UefiHttpBoot/1.0"
 #define HTTP_BOOT_AUTHENTICATION_INFO_MAX_LEN  255
+#define HTTP_BOOT_RANGE_MAX_CONNECTIONS        16
 
 //
 // Record the data length and start address of a data block.
@@ -58,6 +59,30 @@ typedef struct {
   HTTP_BOOT_PRIVATE_DATA     *Private;
 } HTTP_BOOT_CALLBACK_DATA;
 
+//
+// State of a connection used by the parallel range download.
+//
+typedef enum {
+  HttpBootRangeIdle,
+  HttpBootRangeSendRequest,
+  HttpBootRangeRecvHeader,
+  HttpBootRangeRecvBody
+} HTTP_BOOT_RANGE_STATE;
+
+//
+// One HTTP child instance of the parallel range download, and the byte
+// range of the boot file it is loading.
+//
+typedef struct {
+  HTTP_IO                   HttpIo;
+  HTTP_BOOT_RANGE_STATE     State;
+  HTTP_IO_HEADER            *HttpIoHeader;
+  EFI_HTTP_RESPONSE_DATA    ResponseData;
+  UINTN                     FirstByte;
+  UINTN                     LastByte;
+  UINTN                     ReceivedSize;
+} HTTP_BOOT_RANGE_CONNECTION;
+
 /**
   Discover all the boot information for boot file.
 
@@ -72,6 +97,22 @@ HttpBootDiscoverBootInfo (
   IN OUT HTTP_BOOT_PRIVATE_DATA  *Private
   );
 
+/**
+  Create and configure a HttpIo instance on the boot NIC.
+
+  @param[in]    Private        The pointer to the driver's private data.
+  @param[out]   HttpIo         The HttpIo instance to be created.
+
+  @retval EFI_SUCCESS          Successfully created.
+  @retval Others               Failed to create HttpIo.
+
+**/
+EFI_STATUS
+HttpBootConfigureHttpIo (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  OUT    HTTP_IO                 *HttpIo
+  );
+
 /**
   Create a HttpIo instance for the file download.
 
@@ -121,6 +162,29 @@ HttpBootGetBootFile (
   OUT HTTP_BOOT_IMAGE_TYPE       *ImageType
   );
 
+/**
+  Download the boot file as concurrent HTTP byte range requests, each issued on
+  its own HTTP child instance and received directly into the right offset of
+  Buffer.
+
+  @param[in]   Private         The pointer to the driver's private data.
+  @param[in]   Url             The URL of the boot file.
+  @param[out]  Buffer          The memory buffer to transfer the file to, at least
+                               Private->BootFileSize bytes.
+
+  @retval EFI_SUCCESS          The whole file was loaded.
+  @retval EFI_UNSUPPORTED      The server does not support byte range requests.
+  @retval Others               The parallel download failed, the caller should
+                               download the file in a single stream.
+
+**/
+EFI_STATUS
+HttpBootGetBootFileByRange (
+  IN     HTTP_BOOT_PRIVATE_DATA  *Private,
+  IN     CHAR16                  *Url,
+  OUT    UINT8                   *Buffer
+  );
+
 /**
   Clean up all cached data.
 
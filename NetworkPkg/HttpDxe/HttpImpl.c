@@ -1415,23 +1415,24 @@ HttpResponseWorker (
       HttpMsg->BodyLength = HttpInstance->NextMsg - (CHAR8 *)HttpMsg->Body;
     }
 
+    //
+    // Keep the decrypted record as the cache of the data not yet returned, rather
+    // than copying that data into a new buffer.
+    //
     HttpInstance->CacheLen = Fragment.Len - HttpMsg->BodyLength;
     if (HttpInstance->CacheLen != 0) {
       if (HttpInstance->CacheBody != NULL) {
         FreePool (HttpInstance->CacheBody);
       }
 
-      HttpInstance->CacheBody = AllocateZeroPool (HttpInstance->CacheLen);
-      if (HttpInstance->CacheBody == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
-        goto Error2;
-      }
-
-      CopyMem (HttpInstance->CacheBody, Fragment.Bulk + HttpMsg->BodyLength, HttpInstance->CacheLen);
-      HttpInstance->CacheOffset = 0;
+      HttpInstance->CacheBody   = (CHAR8 *)Fragment.Bulk;
+      HttpInstance->CacheLen    = Fragment.Len;
+      HttpInstance->CacheOffset = HttpMsg->BodyLength;
       if (HttpInstance->NextMsg != NULL) {
-        HttpInstance->NextMsg = HttpInstance->CacheBody;
+        HttpInstance->NextMsg = HttpInstance->CacheBody + HttpInstance->CacheOffset;
       }
+
+      Fragment.Bulk = NULL;
     }
 
     if (Fragment.Bulk != NULL) {
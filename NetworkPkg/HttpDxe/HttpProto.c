@@ -1088,6 +1088,7 @@ HttpConfigureTcp4 (
   Tcp4Option->KeepAliveInterval   = HTTP_KEEP_ALIVE_INTERVAL;
   Tcp4Option->EnableNagle         = TRUE;
   Tcp4Option->EnableWindowScaling = TRUE;
+  Tcp4Option->EnableSelectiveAck  = TRUE;
   Tcp4CfgData->ControlOption      = Tcp4Option;
 
   if ((HttpInstance->State == HTTP_STATE_TCP_CONNECTED) ||
@@ -1172,6 +1173,7 @@ HttpConfigureTcp6 (
   Tcp6Option->KeepAliveInterval   = HTTP_KEEP_ALIVE_INTERVAL;
   Tcp6Option->EnableNagle         = TRUE;
   Tcp6Option->EnableWindowScaling = TRUE;
+  Tcp6Option->EnableSelectiveAck  = TRUE;
 
   if ((HttpInstance->State == HTTP_STATE_TCP_CONNECTED) ||
       (HttpInstance->State == HTTP_STATE_TCP_CLOSED))
@@ -1596,10 +1596,19 @@ TlsProcessMessage (
     BufferSize += FragmentTable[Index].FragmentLength;
   }
 
+  //
+  // A single processed fragment is handed out as is, there is nothing to gather.
+  //
+  if (FragmentCount == 1) {
+    Fragment->Len  = BufferSize;
+    Fragment->Bulk = FragmentTable[0].FragmentBuffer;
+    goto ON_EXIT;
+  }
+
   //
   // Allocate buffer for processed data.
   //
-  Buffer = AllocateZeroPool (BufferSize);
+  Buffer = AllocatePool (BufferSize);
   if (Buffer == NULL) {
     Status = EFI_OUT_OF_RESOURCES;
     goto ON_EXIT;
@@ -1701,7 +1710,7 @@ HttpsReceive (
   }
 
   BufferInSize = Pdu->TotalSize;
-  BufferIn     = AllocateZeroPool (BufferInSize);
+  BufferIn     = AllocatePool (BufferInSize);
   if (BufferIn == NULL) {
     Status = EFI_OUT_OF_RESOURCES;
     NetbufFree (Pdu);
@@ -1811,19 +1820,12 @@ HttpsReceive (
     //
     ASSERT (((TLS_RECORD_HEADER *)(TempFragment.Bulk))->ContentType == TlsContentTypeApplicationData);
 
-    BufferInSize = ((TLS_RECORD_HEADER *)(TempFragment.Bulk))->Length;
-    BufferIn     = AllocateZeroPool (BufferInSize);
-    if (BufferIn == NULL) {
-      Status = EFI_OUT_OF_RESOURCES;
-      return Status;
-    }
-
-    CopyMem (BufferIn, TempFragment.Bulk + TLS_RECORD_HEADER_LENGTH, BufferInSize);
-
     //
-    // Free the buffer in TempFragment.
+    // Strip the record header in place, the decrypted buffer itself is returned.
     //
-    FreePool (TempFragment.Bulk);
+    BufferInSize = ((TLS_RECORD_HEADER *)(TempFragment.Bulk))->Length;
+    BufferIn     = TempFragment.Bulk;
+    CopyMem (BufferIn, BufferIn + TLS_RECORD_HEADER_LENGTH, BufferInSize);
   } else if ((RecordHeader.ContentType == TlsContentTypeAlert) &&
              (RecordHeader.Version.Major == 0x03) &&
              ((RecordHeader.Version.Minor == TLS10_PROTOCOL_VERSION_MINOR) ||
@@ -90,8 +90,8 @@ IScsiExtScsiPassThruFunction (
     return EFI_INVALID_PARAMETER;
   }
 
-  Status = IScsiExecuteScsiCommand (This, Target, Lun, Packet);
-  if ((Status != EFI_SUCCESS) && (Status != EFI_NOT_READY)) {
+  Status = IScsiExecuteScsiCommand (This, Target, Lun, Packet, Event);
+  if ((Status != EFI_SUCCESS) && (Status != EFI_NOT_READY) && (Status != EFI_BAD_BUFFER_SIZE)) {
     //
     // Try to reinstate the session and re-execute the Scsi command.
     //
@@ -100,7 +100,7 @@ IScsiExtScsiPassThruFunction (
       return EFI_DEVICE_ERROR;
     }
 
-    Status = IScsiExecuteScsiCommand (This, Target, Lun, Packet);
+    Status = IScsiExecuteScsiCommand (This, Target, Lun, Packet, Event);
   }
 
   return Status;
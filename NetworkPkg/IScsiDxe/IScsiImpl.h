@@ -107,6 +107,13 @@ struct _ISCSI_SESSION {
 
   LIST_ENTRY                     TcbList;
 
+  //
+  // Completes the non-blocking SCSI commands. ConnBusy is set while a
+  // command is using the connection outside of the poll timer.
+  //
+  EFI_EVENT                      TaskPollEvent;
+  BOOLEAN                        ConnBusy;
+
   //
   // Session-wide parameters
   //
@@ -1283,6 +1283,36 @@ IScsiNbufExtFree (
 {
 }
 
+/**
+  Find the task control block of an outstanding SCSI command by its initiator
+  task tag.
+
+  @param[in]  Session           The iSCSI session.
+  @param[in]  InitiatorTaskTag  The initiator task tag in host byte order.
+
+  @return The task control block, or NULL if no outstanding command has the tag.
+
+**/
+ISCSI_TCB *
+IScsiFindTcb (
+  IN ISCSI_SESSION  *Session,
+  IN UINT32         InitiatorTaskTag
+  )
+{
+  LIST_ENTRY  *Entry;
+  ISCSI_TCB   *Tcb;
+
+  NET_LIST_FOR_EACH (Entry, &Session->TcbList) {
+    Tcb = NET_LIST_USER_STRUCT (Entry, ISCSI_TCB, Link);
+
+    if (Tcb->InitiatorTaskTag == InitiatorTaskTag) {
+      return Tcb;
+    }
+  }
+
+  return NULL;
+}
+
 /**
   Receive an iSCSI response PDU. An iSCSI response PDU contains an iSCSI PDU header and
   an optional data segment. The two parts will be put into two blocks of buffers in the
@@ -1293,6 +1323,8 @@ IScsiNbufExtFree (
   @param[out] Pdu          The received iSCSI pdu.
   @param[in]  Context      The context used to describe information on the caller provided
                            buffer to receive data segment of the iSCSI pdu. It is optional.
+                           If it is NULL, the data segment of an iSCSI SCSI data PDU is
+                           received into the buffer of the SCSI command it belongs to.
   @param[in]  HeaderDigest Whether there will be header digest received.
   @param[in]  DataDigest   Whether there will be data digest.
   @param[in]  TimeoutEvent The timeout event. It is optional.
@@ -1324,6 +1356,7 @@ IScsiReceivePdu (
   UINT32        FragmentCount;
   NET_BUF       *DataSeg;
   UINT32        PadAndCRC32[2];
+  ISCSI_TCB     *Tcb;
 
   NbufList = AllocatePool (sizeof (LIST_ENTRY));
   if (NbufList == NULL) {
@@ -1388,6 +1421,13 @@ IScsiReceivePdu (
       // To reduce memory copy overhead, try to use the buffer described by Context
       // if the PDU is an iSCSI SCSI data.
       //
+      if (Context == NULL) {
+        Tcb = IScsiFindTcb (Conn->Session, NTOHL (((ISCSI_BASIC_HEADER *)Header)->InitiatorTaskTag));
+        if (Tcb != NULL) {
+          Context = &Tcb->InBufferContext;
+        }
+      }
+
       InDataOffset = ISCSI_GET_BUFFER_OFFSET (Header);
       if ((Context == NULL) || ((InDataOffset + Len) > Context->InDataLen)) {
         Status = EFI_PROTOCOL_ERROR;
@@ -2841,7 +2881,7 @@ IScsiOnScsiRspRcvd (
   Process the received NOP In PDU.
 
   @param[in]  Pdu            The NOP In PDU received.
-  @param[in]  Tcb            The task control block.
+  @param[in]  Conn           The connection the PDU is received on.
 
   @retval EFI_SUCCESS        The NOP In PDU is processed and the related sequence
                              numbers are updated.
@@ -2850,8 +2890,8 @@ IScsiOnScsiRspRcvd (
 **/
 EFI_STATUS
 IScsiOnNopInRcvd (
-  IN NET_BUF    *Pdu,
-  IN ISCSI_TCB  *Tcb
+  IN NET_BUF           *Pdu,
+  IN ISCSI_CONNECTION  *Conn
   )
 {
   ISCSI_NOP_IN  *NopInHdr;
@@ -2867,21 +2907,316 @@ IScsiOnNopInRcvd (
   NopInHdr->MaxCmdSN = NTOHL (NopInHdr->MaxCmdSN);
 
   if (NopInHdr->InitiatorTaskTag == ISCSI_RESERVED_TAG) {
-    if (NopInHdr->StatSN != Tcb->Conn->ExpStatSN) {
+    if (NopInHdr->StatSN != Conn->ExpStatSN) {
       return EFI_PROTOCOL_ERROR;
     }
   } else {
-    Status = IScsiCheckSN (&Tcb->Conn->ExpStatSN, NopInHdr->StatSN);
+    Status = IScsiCheckSN (&Conn->ExpStatSN, NopInHdr->StatSN);
     if (EFI_ERROR (Status)) {
       return Status;
     }
   }
 
-  IScsiUpdateCmdSN (Tcb->Conn->Session, NopInHdr->MaxCmdSN, NopInHdr->ExpCmdSN);
+  IScsiUpdateCmdSN (Conn->Session, NopInHdr->MaxCmdSN, NopInHdr->ExpCmdSN);
 
   return EFI_SUCCESS;
 }
 
+/**
+  Complete a non-blocking SCSI command. A failure is reported through the
+  host adapter status of the request packet, then the event of the caller
+  is signaled and the task control block is destroyed.
+
+  @param[in]  Tcb            The task control block of the completed command.
+
+**/
+VOID
+IScsiCompleteAsyncTcb (
+  IN ISCSI_TCB  *Tcb
+  )
+{
+  ASSERT (Tcb->Event != NULL);
+
+  if (EFI_ERROR (Tcb->Status) && (Tcb->Status != EFI_BAD_BUFFER_SIZE)) {
+    if (Tcb->Status == EFI_TIMEOUT) {
+      Tcb->Packet->HostAdapterStatus = EFI_EXT_SCSI_STATUS_HOST_ADAPTER_TIMEOUT_COMMAND;
+    } else {
+      Tcb->Packet->HostAdapterStatus = EFI_EXT_SCSI_STATUS_HOST_ADAPTER_OTHER;
+    }
+  }
+
+  gBS->SignalEvent (Tcb->Event);
+  IScsiDelTcb (Tcb);
+}
+
+/**
+  Fail all the outstanding non-blocking SCSI commands of the session.
+
+  @param[in]  Session        The iSCSI session.
+  @param[in]  Status         The error to complete the commands with.
+
+**/
+VOID
+IScsiAbortAsyncTcbs (
+  IN ISCSI_SESSION  *Session,
+  IN EFI_STATUS     Status
+  )
+{
+  LIST_ENTRY  *Entry;
+  LIST_ENTRY  *Next;
+  ISCSI_TCB   *Tcb;
+
+  NET_LIST_FOR_EACH_SAFE (Entry, Next, &Session->TcbList) {
+    Tcb = NET_LIST_USER_STRUCT (Entry, ISCSI_TCB, Link);
+
+    if (Tcb->Event != NULL) {
+      Tcb->Completed = TRUE;
+      Tcb->Status    = Status;
+      IScsiCompleteAsyncTcb (Tcb);
+    }
+  }
+}
+
+/**
+  Check whether the session has non-blocking SCSI commands outstanding.
+
+  @param[in]  Session        The iSCSI session.
+  @param[out] Timeout        The timeout to wait for a PDU of these commands,
+                             0 if any of them has no timeout. Optional.
+
+  @retval TRUE               There are non-blocking commands outstanding.
+  @retval FALSE              There is no non-blocking command outstanding.
+
+**/
+BOOLEAN
+IScsiHasAsyncTcb (
+  IN  ISCSI_SESSION  *Session,
+  OUT UINT64         *Timeout OPTIONAL
+  )
+{
+  LIST_ENTRY  *Entry;
+  ISCSI_TCB   *Tcb;
+  BOOLEAN     Found;
+  UINT64      Longest;
+
+  Found   = FALSE;
+  Longest = 0;
+
+  NET_LIST_FOR_EACH (Entry, &Session->TcbList) {
+    Tcb = NET_LIST_USER_STRUCT (Entry, ISCSI_TCB, Link);
+
+    if ((Tcb->Event == NULL) || Tcb->Completed) {
+      continue;
+    }
+
+    if (Tcb->Packet->Timeout == 0) {
+      Longest = MAX_UINT64;
+    } else if (Longest != MAX_UINT64) {
+      Longest = MAX (Longest, MultU64x32 (Tcb->Packet->Timeout, 4));
+    }
+
+    Found = TRUE;
+  }
+
+  if (Timeout != NULL) {
+    *Timeout = (Longest == MAX_UINT64) ? 0 : Longest;
+  }
+
+  return Found;
+}
+
+/**
+  Deliver a PDU received in the full feature phase to the SCSI command it
+  belongs to. The command is marked completed when its status is received
+  or the PDU can't be processed for it. A completed non-blocking command is
+  signaled and destroyed.
+
+  @param[in]  Conn           The connection the PDU is received on.
+  @param[in]  Pdu            The received PDU.
+
+  @retval EFI_SUCCESS        The PDU is delivered.
+  @retval EFI_PROTOCOL_ERROR The PDU doesn't belong to any outstanding command, or it
+                             breaks the sequence numbers of the connection.
+
+**/
+EFI_STATUS
+IScsiDispatchPdu (
+  IN ISCSI_CONNECTION  *Conn,
+  IN NET_BUF           *Pdu
+  )
+{
+  ISCSI_BASIC_HEADER  *PduHdr;
+  ISCSI_TCB           *Tcb;
+  EFI_STATUS          Status;
+
+  PduHdr = (ISCSI_BASIC_HEADER *)NetbufGetByte (Pdu, 0, NULL);
+  if (PduHdr == NULL) {
+    return EFI_PROTOCOL_ERROR;
+  }
+
+  switch (ISCSI_GET_OPCODE (PduHdr)) {
+    case ISCSI_OPCODE_NOP_IN:
+      return IScsiOnNopInRcvd (Pdu, Conn);
+
+    case ISCSI_OPCODE_VENDOR_T0:
+    case ISCSI_OPCODE_VENDOR_T1:
+    case ISCSI_OPCODE_VENDOR_T2:
+      //
+      // These messages are vendor specific. Skip them.
+      //
+      return EFI_SUCCESS;
+
+    case ISCSI_OPCODE_SCSI_DATA_IN:
+    case ISCSI_OPCODE_R2T:
+    case ISCSI_OPCODE_SCSI_RSP:
+      break;
+
+    default:
+      return EFI_PROTOCOL_ERROR;
+  }
+
+  Tcb = IScsiFindTcb (Conn->Session, NTOHL (PduHdr->InitiatorTaskTag));
+  if ((Tcb == NULL) || Tcb->Completed) {
+    return EFI_PROTOCOL_ERROR;
+  }
+
+  switch (ISCSI_GET_OPCODE (PduHdr)) {
+    case ISCSI_OPCODE_SCSI_DATA_IN:
+      Status = IScsiOnDataInRcvd (Pdu, Tcb, Tcb->Packet);
+      break;
+
+    case ISCSI_OPCODE_R2T:
+      Status = IScsiOnR2TRcvd (Pdu, Tcb, Tcb->Lun, Tcb->Packet);
+      break;
+
+    default:
+      Status = IScsiOnScsiRspRcvd (Pdu, Tcb, Tcb->Packet);
+      break;
+  }
+
+  if (EFI_ERROR (Status) || Tcb->StatusXferd) {
+    Tcb->Completed = TRUE;
+    Tcb->Status    = Status;
+
+    if (Tcb->Event != NULL) {
+      IScsiCompleteAsyncTcb (Tcb);
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Receive and deliver PDUs until the SCSI command of Tcb completes or, if Tcb
+  is NULL, until no non-blocking SCSI command is outstanding.
+
+  @param[in]  Conn           The connection to receive the PDUs from.
+  @param[in]  Tcb            The task control block to wait for. Optional.
+  @param[in]  Timeout        The timeout to wait for each PDU, 0 for no timeout.
+
+  @retval EFI_SUCCESS        The commands waited for are completed.
+  @retval Others             Failed to receive or deliver a PDU.
+
+**/
+EFI_STATUS
+IScsiProcessPdus (
+  IN ISCSI_CONNECTION  *Conn,
+  IN ISCSI_TCB         *Tcb      OPTIONAL,
+  IN UINT64            Timeout
+  )
+{
+  EFI_STATUS  Status;
+  EFI_EVENT   TimeoutEvent;
+  NET_BUF     *Pdu;
+
+  Status       = EFI_SUCCESS;
+  TimeoutEvent = NULL;
+
+  while ((Tcb != NULL) ? !Tcb->Completed : IScsiHasAsyncTcb (Conn->Session, NULL)) {
+    //
+    // Start the timeout timer.
+    //
+    if (Timeout != 0) {
+      Status = gBS->SetTimer (Conn->TimeoutEvent, TimerRelative, Timeout);
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+
+      TimeoutEvent = Conn->TimeoutEvent;
+    }
+
+    //
+    // Try to receive PDU from target.
+    //
+    Status = IScsiReceivePdu (Conn, &Pdu, NULL, FALSE, FALSE, TimeoutEvent);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    Status = IScsiDispatchPdu (Conn, Pdu);
+    NetbufFree (Pdu);
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+
+  if (TimeoutEvent != NULL) {
+    gBS->SetTimer (TimeoutEvent, TimerCancel, 0);
+  }
+
+  return Status;
+}
+
+/**
+  The periodic timer callback that receives the responses of the non-blocking
+  SCSI commands. If the connection fails, all of them are completed with the error.
+
+  @param[in]  Event          The poll timer event.
+  @param[in]  Context        The iSCSI session.
+
+**/
+VOID
+EFIAPI
+IScsiOnTaskPoll (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  ISCSI_SESSION     *Session;
+  ISCSI_CONNECTION  *Conn;
+  EFI_STATUS        Status;
+  UINT64            Timeout;
+
+  Session = (ISCSI_SESSION *)Context;
+
+  //
+  // Leave the connection alone while a command at a lower TPL is using it;
+  // that command delivers the PDUs of the non-blocking commands as well.
+  //
+  if (Session->ConnBusy || (Session->State != SESSION_STATE_LOGGED_IN) ||
+      !IScsiHasAsyncTcb (Session, &Timeout))
+  {
+    return;
+  }
+
+  Conn = NET_LIST_USER_STRUCT_S (
+           Session->Conns.ForwardLink,
+           ISCSI_CONNECTION,
+           Link,
+           ISCSI_CONNECTION_SIGNATURE
+           );
+
+  Session->ConnBusy = TRUE;
+
+  Status = IScsiProcessPdus (Conn, NULL, Timeout);
+  if (EFI_ERROR (Status)) {
+    IScsiAbortAsyncTcbs (Session, Status);
+  }
+
+  Session->ConnBusy = FALSE;
+}
+
 /**
   Execute the SCSI command issued through the EXT SCSI PASS THRU protocol.
 
@@ -2890,9 +3225,12 @@ IScsiOnNopInRcvd (
   @param[in]       Lun       The LUN.
   @param[in, out]  Packet    The request packet containing IO request, SCSI command
                              buffer and buffers to read/write.
+  @param[in]       Event     If not NULL, the command is only sent to the target and
+                             Event is signaled when it completes. If NULL, the call
+                             blocks until the command completes.
 
   @retval EFI_SUCCESS          The SCSI command is executed and the result is updated to
-                               the Packet.
+                               the Packet, or the non-blocking command is queued.
   @retval EFI_DEVICE_ERROR     Session state was not as required.
   @retval EFI_OUT_OF_RESOURCES Failed to allocate memory.
   @retval EFI_PROTOCOL_ERROR   There is no such data in the net buffer.
@@ -2905,32 +3243,56 @@ IScsiExecuteScsiCommand (
   IN EFI_EXT_SCSI_PASS_THRU_PROTOCOL                 *PassThru,
   IN UINT8                                           *Target,
   IN UINT64                                          Lun,
-  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet
+  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet,
+  IN EFI_EVENT                                       Event     OPTIONAL
   )
 {
-  EFI_STATUS               Status;
-  ISCSI_DRIVER_DATA        *Private;
-  ISCSI_SESSION            *Session;
-  EFI_EVENT                TimeoutEvent;
-  ISCSI_CONNECTION         *Conn;
-  ISCSI_TCB                *Tcb;
-  NET_BUF                  *Pdu;
-  ISCSI_XFER_CONTEXT       *XferContext;
-  UINT8                    *Data;
-  ISCSI_IN_BUFFER_CONTEXT  InBufferContext;
-  UINT64                   Timeout;
-  UINT8                    *PduHdr;
+  EFI_STATUS          Status;
+  ISCSI_DRIVER_DATA   *Private;
+  ISCSI_SESSION       *Session;
+  ISCSI_CONNECTION    *Conn;
+  ISCSI_TCB           *Tcb;
+  NET_BUF             *Pdu;
+  ISCSI_XFER_CONTEXT  *XferContext;
+  UINT8               *Data;
+  UINT64              Timeout;
+  UINT8               *PduHdr;
 
-  Private      = ISCSI_DRIVER_DATA_FROM_EXT_SCSI_PASS_THRU (PassThru);
-  Session      = Private->Session;
-  Status       = EFI_SUCCESS;
-  Tcb          = NULL;
-  TimeoutEvent = NULL;
-  Timeout      = 0;
+  Private = ISCSI_DRIVER_DATA_FROM_EXT_SCSI_PASS_THRU (PassThru);
+  Session = Private->Session;
+  Status  = EFI_SUCCESS;
+  Tcb     = NULL;
+  Timeout = 0;
 
   if (Session->State != SESSION_STATE_LOGGED_IN) {
-    Status = EFI_DEVICE_ERROR;
-    goto ON_EXIT;
+    return EFI_DEVICE_ERROR;
+  }
+
+  if (Session->ConnBusy) {
+    //
+    // A command issued at a lower TPL is using the connection.
+    //
+    return EFI_NOT_READY;
+  }
+
+  if ((Event != NULL) && (Session->TaskPollEvent == NULL)) {
+    Status = gBS->CreateEvent (
+                    EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                    TPL_CALLBACK,
+                    IScsiOnTaskPoll,
+                    Session,
+                    &Session->TaskPollEvent
+                    );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Status = gBS->SetTimer (Session->TaskPollEvent, TimerPeriodic, ISCSI_TASK_POLL_PERIOD);
+    if (EFI_ERROR (Status)) {
+      gBS->CloseEvent (Session->TaskPollEvent);
+      Session->TaskPollEvent = NULL;
+      return Status;
+    }
   }
 
   Conn = NET_LIST_USER_STRUCT_S (
@@ -2944,11 +3306,19 @@ IScsiExecuteScsiCommand (
     Timeout = MultU64x32 (Packet->Timeout, 4);
   }
 
+  Session->ConnBusy = TRUE;
+
   Status = IScsiNewTcb (Conn, &Tcb);
   if (EFI_ERROR (Status)) {
     goto ON_EXIT;
   }
 
+  Tcb->Lun                       = Lun;
+  Tcb->Packet                    = Packet;
+  Tcb->Event                     = Event;
+  Tcb->InBufferContext.InData    = (UINT8 *)Packet->InDataBuffer;
+  Tcb->InBufferContext.InDataLen = Packet->InTransferLength;
+
   //
   // Encapsulate the SCSI request packet into an iSCSI SCSI Command PDU.
   //
@@ -3001,84 +3371,32 @@ IScsiExecuteScsiCommand (
     }
   }
 
-  InBufferContext.InData    = (UINT8 *)Packet->InDataBuffer;
-  InBufferContext.InDataLen = Packet->InTransferLength;
-
-  while (!Tcb->StatusXferd) {
-    //
-    // Start the timeout timer.
-    //
-    if (Timeout != 0) {
-      Status = gBS->SetTimer (Conn->TimeoutEvent, TimerRelative, Timeout);
-      if (EFI_ERROR (Status)) {
-        goto ON_EXIT;
-      }
-
-      TimeoutEvent = Conn->TimeoutEvent;
-    }
-
+  if (Event != NULL) {
     //
-    // Try to receive PDU from target.
+    // The command is queued. Its responses are received by the poll timer, or
+    // by a blocking command issued in the meantime, and Event is signaled then.
     //
-    Status = IScsiReceivePdu (Conn, &Pdu, &InBufferContext, FALSE, FALSE, TimeoutEvent);
-    if (EFI_ERROR (Status)) {
-      goto ON_EXIT;
-    }
-
-    PduHdr = NetbufGetByte (Pdu, 0, NULL);
-    if (PduHdr == NULL) {
-      Status = EFI_PROTOCOL_ERROR;
-      NetbufFree (Pdu);
-      goto ON_EXIT;
-    }
-
-    switch (ISCSI_GET_OPCODE (PduHdr)) {
-      case ISCSI_OPCODE_SCSI_DATA_IN:
-        Status = IScsiOnDataInRcvd (Pdu, Tcb, Packet);
-        break;
-
-      case ISCSI_OPCODE_R2T:
-        Status = IScsiOnR2TRcvd (Pdu, Tcb, Lun, Packet);
-        break;
-
-      case ISCSI_OPCODE_SCSI_RSP:
-        Status = IScsiOnScsiRspRcvd (Pdu, Tcb, Packet);
-        break;
-
-      case ISCSI_OPCODE_NOP_IN:
-        Status = IScsiOnNopInRcvd (Pdu, Tcb);
-        break;
-
-      case ISCSI_OPCODE_VENDOR_T0:
-      case ISCSI_OPCODE_VENDOR_T1:
-      case ISCSI_OPCODE_VENDOR_T2:
-        //
-        // These messages are vendor specific. Skip them.
-        //
-        break;
-
-      default:
-        Status = EFI_PROTOCOL_ERROR;
-        break;
-    }
-
-    NetbufFree (Pdu);
+    Tcb = NULL;
+    goto ON_EXIT;
+  }
 
-    if (EFI_ERROR (Status)) {
-      break;
-    }
+  //
+  // Receive the responses to this command. The PDUs of the queued non-blocking
+  // commands are delivered on the way.
+  //
+  Status = IScsiProcessPdus (Conn, Tcb, Timeout);
+  if (!EFI_ERROR (Status)) {
+    Status = Tcb->Status;
   }
 
 ON_EXIT:
 
-  if (TimeoutEvent != NULL) {
-    gBS->SetTimer (TimeoutEvent, TimerCancel, 0);
-  }
-
   if (Tcb != NULL) {
     IScsiDelTcb (Tcb);
   }
 
+  Session->ConnBusy = FALSE;
+
   return Status;
 }
 
@@ -3133,6 +3451,9 @@ IScsiSessionInit (
 
     InitializeListHead (&Session->Conns);
     InitializeListHead (&Session->TcbList);
+
+    Session->TaskPollEvent = NULL;
+    Session->ConnBusy      = FALSE;
   }
 
   Session->Tsih = 0;
@@ -3145,8 +3466,8 @@ IScsiSessionInit (
   Session->MaxConnections       = ISCSI_MAX_CONNS_PER_SESSION;
   Session->InitialR2T           = FALSE;
   Session->ImmediateData        = TRUE;
-  Session->MaxBurstLength       = 262144;
-  Session->FirstBurstLength     = MAX_RECV_DATA_SEG_LEN_IN_FFP;
+  Session->MaxBurstLength       = ISCSI_MAX_BURST_LENGTH;
+  Session->FirstBurstLength     = ISCSI_FIRST_BURST_LENGTH;
   Session->DefaultTime2Wait     = 2;
   Session->DefaultTime2Retain   = 20;
   Session->MaxOutstandingR2T    = DEFAULT_MAX_OUTSTANDING_R2T;
@@ -3170,6 +3491,16 @@ IScsiSessionAbort (
   ISCSI_CONNECTION  *Conn;
   EFI_GUID          *ProtocolGuid;
 
+  //
+  // The queued non-blocking commands are lost with the connection.
+  //
+  if (Session->TaskPollEvent != NULL) {
+    gBS->CloseEvent (Session->TaskPollEvent);
+    Session->TaskPollEvent = NULL;
+  }
+
+  IScsiAbortAsyncTcbs (Session, EFI_ABORTED);
+
   if (Session->State != SESSION_STATE_LOGGED_IN) {
     return;
   }
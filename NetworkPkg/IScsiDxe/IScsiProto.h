@@ -28,9 +28,21 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define ISCSI_MAX_CONNS_PER_SESSION  1
 
 #define DEFAULT_MAX_RECV_DATA_SEG_LEN  8192
-#define MAX_RECV_DATA_SEG_LEN_IN_FFP   65536
+#define MAX_RECV_DATA_SEG_LEN_IN_FFP   262144
 #define DEFAULT_MAX_OUTSTANDING_R2T    1
 
+//
+// Burst lengths offered in the login negotiation. MaxBurstLength is the
+// largest multiple of 1024 below the 2^24 limit of RFC 7143.
+//
+#define ISCSI_MAX_BURST_LENGTH    16776192
+#define ISCSI_FIRST_BURST_LENGTH  MAX_RECV_DATA_SEG_LEN_IN_FFP
+
+//
+// The period of the timer that completes the non-blocking SCSI commands.
+//
+#define ISCSI_TASK_POLL_PERIOD  EFI_TIMER_PERIOD_MILLISECONDS (1)
+
 #define ISCSI_VERSION_MAX  0x00
 #define ISCSI_VERSION_MIN  0x00
 
@@ -611,6 +623,17 @@ typedef struct _ISCSI_TCB {
   ISCSI_XFER_CONTEXT    XferContext;
 
   ISCSI_CONNECTION      *Conn;
+
+  //
+  // The SCSI request carried by this task. Event is signaled when a
+  // non-blocking request completes; it is NULL for a blocking request.
+  //
+  UINT64                                        Lun;
+  EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET    *Packet;
+  ISCSI_IN_BUFFER_CONTEXT                       InBufferContext;
+  EFI_EVENT                                     Event;
+  BOOLEAN                                       Completed;
+  EFI_STATUS                                    Status;
 } ISCSI_TCB;
 
 typedef struct _ISCSI_KEY_VALUE_PAIR {
@@ -977,9 +1000,12 @@ IScsiNormalizeName (
   @param[in]       Lun       The LUN.
   @param[in, out]  Packet    The request packet containing IO request, SCSI command
                              buffer and buffers to read/write.
+  @param[in]       Event     If not NULL, the command is only sent to the target and
+                             Event is signaled when it completes. If NULL, the call
+                             blocks until the command completes.
 
   @retval EFI_SUCCESS          The SCSI command is executed and the result is updated to
-                               the Packet.
+                               the Packet, or the non-blocking command is queued.
   @retval EFI_DEVICE_ERROR     Session state was not as required.
   @retval EFI_OUT_OF_RESOURCES Failed to allocate memory.
   @retval EFI_NOT_READY        The target can not accept new commands.
@@ -991,7 +1017,8 @@ IScsiExecuteScsiCommand (
   IN EFI_EXT_SCSI_PASS_THRU_PROTOCOL                 *PassThru,
   IN UINT8                                           *Target,
   IN UINT64                                          Lun,
-  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet
+  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet,
+  IN EFI_EVENT                                       Event     OPTIONAL
   );
 
 /**
@@ -12,6 +12,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include <Protocol/Ip4.h>
 #include <Protocol/Ip6.h>
+#include <Protocol/NetworkChecksumOffload.h>
 
 #include <Library/NetLib.h>
 
@@ -154,15 +155,17 @@ typedef union {
 /// The IP session for an IP receive packet.
 ///
 typedef struct _EFI_NET_SESSION_DATA {
-  EFI_IP_ADDRESS     Source;        ///< Source IP of the received packet.
-  EFI_IP_ADDRESS     Dest;          ///< Destination IP of the received packet.
-  IP_IO_IP_HEADER    IpHdr;         ///< IP header of the received packet.
-  UINT32             IpHdrLen;      ///< IP header length of the received packet.
-                                    ///< For IPv6, it includes the IP6 header
-                                    ///< length and extension header length. For
-                                    ///< IPv4, it includes the IP4 header length
-                                    ///< and options length.
-  UINT8              IpVersion;     ///< The IP version of the received packet.
+  EFI_IP_ADDRESS     Source;         ///< Source IP of the received packet.
+  EFI_IP_ADDRESS     Dest;           ///< Destination IP of the received packet.
+  IP_IO_IP_HEADER    IpHdr;          ///< IP header of the received packet.
+  UINT32             IpHdrLen;       ///< IP header length of the received packet.
+                                     ///< For IPv6, it includes the IP6 header
+                                     ///< length and extension header length. For
+                                     ///< IPv4, it includes the IP4 header length
+                                     ///< and options length.
+  UINT8              IpVersion;      ///< The IP version of the received packet.
+  UINT32             ChecksumStatus; ///< EDKII_NETWORK_RX_CHECKSUM_* flags for the
+                                     ///< checksums the NIC already verified.
 } EFI_NET_SESSION_DATA;
 
 /**
@@ -214,47 +217,53 @@ typedef struct _IP_IO {
   ///
   /// The node used to link this IpIo to the active IpIo list.
   ///
-  LIST_ENTRY                   Entry;
+  LIST_ENTRY                                 Entry;
 
   ///
   /// The list used to maintain the IP instance for different sending purpose.
   ///
-  LIST_ENTRY                   IpList;
+  LIST_ENTRY                                 IpList;
 
-  EFI_HANDLE                   Controller;
-  EFI_HANDLE                   Image;
-  EFI_HANDLE                   ChildHandle;
+  EFI_HANDLE                                 Controller;
+  EFI_HANDLE                                 Image;
+  EFI_HANDLE                                 ChildHandle;
   //
   // The IP instance consumed by this IP_IO
   //
-  IP_IO_IP_PROTOCOL            Ip;
-  BOOLEAN                      IsConfigured;
+  IP_IO_IP_PROTOCOL                          Ip;
+  BOOLEAN                                    IsConfigured;
+
+  ///
+  /// The optional checksum offload protocol on ChildHandle, NULL if the
+  /// NIC does not verify received checksums.
+  ///
+  EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL    *ChecksumOffload;
 
   ///
   /// Some ip configuration data can be changed.
   ///
-  UINT8                        Protocol;
+  UINT8                                      Protocol;
 
   ///
   /// Token and event used to get data from IP.
   ///
-  IP_IO_IP_COMPLETION_TOKEN    RcvToken;
+  IP_IO_IP_COMPLETION_TOKEN                  RcvToken;
 
   ///
   /// List entry used to link the token passed to IP_IO.
   ///
-  LIST_ENTRY                   PendingSndList;
+  LIST_ENTRY                                 PendingSndList;
 
   //
   // User interface used to get notify from IP_IO
   //
-  VOID                         *RcvdContext;     ///< See IP_IO_OPEN_DATA::RcvdContext.
-  VOID                         *SndContext;      ///< See IP_IO_OPEN_DATA::SndContext.
-  PKT_RCVD_NOTIFY              PktRcvdNotify;    ///< See IP_IO_OPEN_DATA::PktRcvdNotify.
-  PKT_SENT_NOTIFY              PktSentNotify;    ///< See IP_IO_OPEN_DATA::PktSentNotify.
-  UINT8                        IpVersion;
-  IP4_ADDR                     StationIp;
-  IP4_ADDR                     SubnetMask;
+  VOID                                       *RcvdContext;     ///< See IP_IO_OPEN_DATA::RcvdContext.
+  VOID                                       *SndContext;      ///< See IP_IO_OPEN_DATA::SndContext.
+  PKT_RCVD_NOTIFY                            PktRcvdNotify;    ///< See IP_IO_OPEN_DATA::PktRcvdNotify.
+  PKT_SENT_NOTIFY                            PktSentNotify;    ///< See IP_IO_OPEN_DATA::PktSentNotify.
+  UINT8                                      IpVersion;
+  IP4_ADDR                                   StationIp;
+  IP4_ADDR                                   SubnetMask;
 } IP_IO;
 
 ///
@@ -1076,6 +1076,127 @@ NetMapIterate (
   IN VOID              *Arg      OPTIONAL
   );
 
+//
+// Longest-prefix-match trie: the IP drivers share it to find the most
+// specific route to a destination without scanning every route entry.
+// Prefixes and addresses are byte arrays in network byte order; bit 0
+// is the most significant bit of the first byte.
+//
+typedef struct _NET_ROUTE_TRIE_NODE NET_ROUTE_TRIE_NODE;
+
+struct _NET_ROUTE_TRIE_NODE {
+  NET_ROUTE_TRIE_NODE    *Child[2];
+  VOID                   *Value;
+};
+
+typedef struct {
+  NET_ROUTE_TRIE_NODE    *Root;
+  UINTN                  Count;
+} NET_ROUTE_TRIE;
+
+#define NET_ROUTE_TRIE_MAX_PREFIX  128
+
+/**
+  Initialize an empty route trie.
+
+  If Trie is NULL, then ASSERT().
+
+  @param[out]  Trie                 The route trie to initialize.
+
+**/
+VOID
+EFIAPI
+NetRouteTrieInit (
+  OUT NET_ROUTE_TRIE  *Trie
+  );
+
+/**
+  Release all the nodes of the route trie. The values stored in the trie
+  are not touched; they remain owned by the caller.
+
+  If Trie is NULL, then ASSERT().
+
+  @param[in, out]  Trie             The route trie to clean up.
+
+**/
+VOID
+EFIAPI
+NetRouteTrieClean (
+  IN OUT NET_ROUTE_TRIE  *Trie
+  );
+
+/**
+  Associate Value with the prefix Prefix/PrefixLength. If the prefix is
+  already in the trie, its value is replaced.
+
+  If Trie, Prefix or Value is NULL, then ASSERT().
+  If PrefixLength is greater than NET_ROUTE_TRIE_MAX_PREFIX, then ASSERT().
+
+  @param[in, out]  Trie             The route trie to insert the prefix into.
+  @param[in]       Prefix           The prefix in network byte order.
+  @param[in]       PrefixLength     The number of significant bits in Prefix.
+  @param[in]       Value            The opaque value to store for the prefix.
+
+  @retval EFI_SUCCESS               The value is stored for the prefix.
+  @retval EFI_OUT_OF_RESOURCES      Failed to allocate memory for the trie nodes.
+
+**/
+EFI_STATUS
+EFIAPI
+NetRouteTrieInsert (
+  IN OUT NET_ROUTE_TRIE  *Trie,
+  IN     CONST UINT8     *Prefix,
+  IN     UINT8           PrefixLength,
+  IN     VOID            *Value
+  );
+
+/**
+  Remove the prefix Prefix/PrefixLength from the trie and release the
+  nodes that no longer lead to any prefix.
+
+  If Trie or Prefix is NULL, then ASSERT().
+  If PrefixLength is greater than NET_ROUTE_TRIE_MAX_PREFIX, then ASSERT().
+
+  @param[in, out]  Trie             The route trie to remove the prefix from.
+  @param[in]       Prefix           The prefix in network byte order.
+  @param[in]       PrefixLength     The number of significant bits in Prefix.
+
+  @return The value that was stored for the prefix, or NULL if the prefix
+          is not in the trie.
+
+**/
+VOID *
+EFIAPI
+NetRouteTrieRemove (
+  IN OUT NET_ROUTE_TRIE  *Trie,
+  IN     CONST UINT8     *Prefix,
+  IN     UINT8           PrefixLength
+  );
+
+/**
+  Find the longest prefix in the trie that matches Address.
+
+  If Trie or Address is NULL, then ASSERT().
+  If AddressLength is greater than NET_ROUTE_TRIE_MAX_PREFIX, then ASSERT().
+
+  @param[in]   Trie                 The route trie to search.
+  @param[in]   Address              The address in network byte order.
+  @param[in]   AddressLength        The number of bits in Address.
+  @param[out]  PrefixLength         The length of the matching prefix. Optional.
+
+  @return The value stored for the longest matching prefix, or NULL if no
+          prefix matches Address.
+
+**/
+VOID *
+EFIAPI
+NetRouteTrieLookup (
+  IN  NET_ROUTE_TRIE  *Trie,
+  IN  CONST UINT8     *Address,
+  IN  UINT8           AddressLength,
+  OUT UINT8           *PrefixLength OPTIONAL
+  );
+
 //
 // Helper functions to implement driver binding and service binding protocols.
 //
@@ -22,6 +22,11 @@ typedef struct _IP4_SERVICE    IP4_SERVICE;
 #define IP4_LINK_MULTICAST  0x00000002
 #define IP4_LINK_PROMISC    0x00000004
 
+//
+// The NIC has verified the TCP/UDP checksum of the frame.
+//
+#define IP4_LINK_L4_CHECKSUM_VALID  0x00000008
+
 //
 // IP4 address cast type classification. Keep it true that any
 // type bigger than or equal to LOCAL_BROADCAST is broadcast.
@@ -120,7 +120,7 @@ Ip4Config2OnPolicyChanged (
   //
   // Create new default interface and route table.
   //
-  IpIf = Ip4CreateInterface (IpSb->Mnp, IpSb->Controller, IpSb->Image);
+  IpIf = Ip4CreateInterface (IpSb->Mnp, IpSb->MnpChecksumOffload, IpSb->Controller, IpSb->Image);
   if (IpIf == NULL) {
     return;
   }
@@ -495,7 +495,7 @@ Ip4Config2SetDefaultAddr (
     //
     // Create new default interface and route table.
     //
-    IpIf = Ip4CreateInterface (IpSb->Mnp, IpSb->Controller, IpSb->Image);
+    IpIf = Ip4CreateInterface (IpSb->Mnp, IpSb->MnpChecksumOffload, IpSb->Controller, IpSb->Image);
     if (IpIf == NULL) {
       return EFI_OUT_OF_RESOURCES;
     }
@@ -1343,7 +1343,7 @@ Ip4Config2SetManualAddress (
     //
     // Create new default interface and route table.
     //
-    IpIf = Ip4CreateInterface (IpSb->Mnp, IpSb->Controller, IpSb->Image);
+    IpIf = Ip4CreateInterface (IpSb->Mnp, IpSb->MnpChecksumOffload, IpSb->Controller, IpSb->Image);
     if (IpIf == NULL) {
       return EFI_OUT_OF_RESOURCES;
     }
@@ -234,6 +234,8 @@ Ip4CreateService (
   IpSb->MnpChildHandle = NULL;
   IpSb->Mnp            = NULL;
 
+  IpSb->MnpChecksumOffload = NULL;
+
   IpSb->MnpConfigData.ReceivedQueueTimeoutValue = 0;
   IpSb->MnpConfigData.TransmitQueueTimeoutValue = 0;
   IpSb->MnpConfigData.ProtocolTypeFilter        = IP4_ETHER_PROTO;
@@ -327,6 +329,22 @@ Ip4CreateService (
     goto ON_ERROR;
   }
 
+  //
+  // The checksum offload protocol is optional, it is only present when
+  // the underlying SNP driver can validate received checksums.
+  //
+  Status = gBS->OpenProtocol (
+                  IpSb->MnpChildHandle,
+                  &gEdkiiNetworkChecksumOffloadProtocolGuid,
+                  (VOID **)&IpSb->MnpChecksumOffload,
+                  ImageHandle,
+                  Controller,
+                  EFI_OPEN_PROTOCOL_GET_PROTOCOL
+                  );
+  if (EFI_ERROR (Status)) {
+    IpSb->MnpChecksumOffload = NULL;
+  }
+
   Status = Ip4ServiceConfigMnp (IpSb, TRUE);
 
   if (EFI_ERROR (Status)) {
@@ -352,7 +370,7 @@ Ip4CreateService (
     goto ON_ERROR;
   }
 
-  IpSb->DefaultInterface = Ip4CreateInterface (IpSb->Mnp, Controller, ImageHandle);
+  IpSb->DefaultInterface = Ip4CreateInterface (IpSb->Mnp, IpSb->MnpChecksumOffload, Controller, ImageHandle);
 
   if (IpSb->DefaultInterface == NULL) {
     Status = EFI_OUT_OF_RESOURCES;
@@ -454,6 +472,8 @@ Ip4CleanService (
       IpSb->Mnp = NULL;
     }
 
+    IpSb->MnpChecksumOffload = NULL;
+
     NetLibDestroyServiceChild (
       IpSb->Controller,
       IpSb->Image,
@@ -774,7 +794,7 @@ Ip4DriverBindingStop (
     Ip4FreeInterface (IpSb->DefaultInterface, NULL);
     Ip4FreeRouteTable (IpSb->DefaultRouteTable);
 
-    IpIf = Ip4CreateInterface (IpSb->Mnp, IpSb->Controller, IpSb->Image);
+    IpIf = Ip4CreateInterface (IpSb->Mnp, IpSb->MnpChecksumOffload, IpSb->Controller, IpSb->Image);
     if (IpIf == NULL) {
       goto ON_ERROR;
     }
@@ -869,12 +889,14 @@ Ip4ServiceBindingCreateChild (
   Ip4InitProtocol (IpSb, IpInstance);
 
   //
-  // Install Ip4 onto ChildHandle
+  // Install Ip4 and the checksum offload protocol onto ChildHandle
   //
   Status = gBS->InstallMultipleProtocolInterfaces (
                   ChildHandle,
                   &gEfiIp4ProtocolGuid,
                   &IpInstance->Ip4Proto,
+                  &gEdkiiNetworkChecksumOffloadProtocolGuid,
+                  &IpInstance->ChecksumOffload,
                   NULL
                   );
 
@@ -900,6 +922,8 @@ Ip4ServiceBindingCreateChild (
            *ChildHandle,
            &gEfiIp4ProtocolGuid,
            &IpInstance->Ip4Proto,
+           &gEdkiiNetworkChecksumOffloadProtocolGuid,
+           &IpInstance->ChecksumOffload,
            NULL
            );
 
@@ -1035,10 +1059,13 @@ Ip4ServiceBindingDestroyChild (
   // that means there is a resource leak.
   //
   gBS->RestoreTPL (OldTpl);
-  Status = gBS->UninstallProtocolInterface (
+  Status = gBS->UninstallMultipleProtocolInterfaces (
                   ChildHandle,
                   &gEfiIp4ProtocolGuid,
-                  &IpInstance->Ip4Proto
+                  &IpInstance->Ip4Proto,
+                  &gEdkiiNetworkChecksumOffloadProtocolGuid,
+                  &IpInstance->ChecksumOffload,
+                  NULL
                   );
   OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
   if (EFI_ERROR (Status)) {
@@ -1052,6 +1079,8 @@ Ip4ServiceBindingDestroyChild (
            &ChildHandle,
            &gEfiIp4ProtocolGuid,
            Ip4,
+           &gEdkiiNetworkChecksumOffloadProtocolGuid,
+           &IpInstance->ChecksumOffload,
            NULL
            );
 
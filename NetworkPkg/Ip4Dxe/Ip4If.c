@@ -466,6 +466,8 @@ Ip4CancelFrames (
 
   @param[in]  Mnp               The shared MNP child of this IP4 service binding
                                 instance.
+  @param[in]  ChecksumOffload   The checksum offload protocol of the MNP child,
+                                NULL if it has none.
   @param[in]  Controller        The controller this IP4 service binding instance
                                 is installed. Most like the UNDI handle.
   @param[in]  ImageHandle       This driver's image handle.
@@ -475,9 +477,10 @@ Ip4CancelFrames (
 **/
 IP4_INTERFACE *
 Ip4CreateInterface (
-  IN  EFI_MANAGED_NETWORK_PROTOCOL  *Mnp,
-  IN  EFI_HANDLE                    Controller,
-  IN  EFI_HANDLE                    ImageHandle
+  IN  EFI_MANAGED_NETWORK_PROTOCOL             *Mnp,
+  IN  EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL  *ChecksumOffload OPTIONAL,
+  IN  EFI_HANDLE                               Controller,
+  IN  EFI_HANDLE                               ImageHandle
   )
 {
   IP4_INTERFACE            *Interface;
@@ -501,11 +504,12 @@ Ip4CreateInterface (
   Interface->SubnetMask = IP4_ALLZERO_ADDRESS;
   Interface->Configured = FALSE;
 
-  Interface->Controller = Controller;
-  Interface->Image      = ImageHandle;
-  Interface->Mnp        = Mnp;
-  Interface->Arp        = NULL;
-  Interface->ArpHandle  = NULL;
+  Interface->Controller      = Controller;
+  Interface->Image           = ImageHandle;
+  Interface->Mnp             = Mnp;
+  Interface->ChecksumOffload = ChecksumOffload;
+  Interface->Arp             = NULL;
+  Interface->ArpHandle       = NULL;
 
   InitializeListHead (&Interface->ArpQues);
   InitializeListHead (&Interface->SentFrames);
@@ -1219,6 +1223,7 @@ Ip4OnFrameReceivedDpc (
   NET_FRAGMENT                          Netfrag;
   NET_BUF                               *Packet;
   UINT32                                Flag;
+  UINT32                                ChecksumStatus;
 
   Token = (IP4_LINK_RX_TOKEN *)Context;
   NET_CHECK_SIGNATURE (Token, IP4_FRAME_RX_SIGNATURE);
@@ -1261,6 +1266,18 @@ Ip4OnFrameReceivedDpc (
   Flag |= (MnpRxData->MulticastFlag ? IP4_LINK_MULTICAST : 0);
   Flag |= (MnpRxData->PromiscuousFlag ? IP4_LINK_PROMISC : 0);
 
+  if (Token->Interface->ChecksumOffload != NULL) {
+    ChecksumStatus = 0;
+    Token->Interface->ChecksumOffload->GetRxChecksumStatus (
+                                         Token->Interface->ChecksumOffload,
+                                         MnpRxData,
+                                         &ChecksumStatus
+                                         );
+    if ((ChecksumStatus & EDKII_NETWORK_RX_CHECKSUM_L4_VALID) != 0) {
+      Flag |= IP4_LINK_L4_CHECKSUM_VALID;
+    }
+  }
+
   Token->CallBack (Token->IpInstance, Packet, EFI_SUCCESS, Flag, Token->Context);
 }
 
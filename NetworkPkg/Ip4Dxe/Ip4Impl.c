@@ -544,6 +544,11 @@ Ip4InitProtocol (
   IpInstance->InDestroy = FALSE;
   IpInstance->Service   = IpSb;
 
+  IpInstance->ChecksumOffload.GetRxChecksumStatus = Ip4GetRxChecksumStatus;
+  if (IpSb->MnpChecksumOffload != NULL) {
+    IpInstance->ChecksumOffload.RxCapabilities = IpSb->MnpChecksumOffload->RxCapabilities;
+  }
+
   InitializeListHead (&IpInstance->Link);
   NetMapInit (&IpInstance->RxTokens);
   NetMapInit (&IpInstance->TxTokens);
@@ -643,7 +648,7 @@ Ip4ConfigProtocol (
     if (IpIf != NULL) {
       NET_GET_REF (IpIf);
     } else {
-      IpIf = Ip4CreateInterface (IpSb->Mnp, IpSb->Controller, IpSb->Image);
+      IpIf = Ip4CreateInterface (IpSb->Mnp, IpSb->MnpChecksumOffload, IpSb->Controller, IpSb->Image);
 
       if (IpIf == NULL) {
         goto ON_ERROR;
@@ -2309,3 +2314,47 @@ Ip4TimerReconfigChecking (
     }
   }
 }
+
+/**
+  Return which checksums of a received packet the NIC has already verified.
+
+  @param[in]  This            Pointer to the
+                              EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL instance.
+  @param[in]  RxData          Pointer to the EFI_IP4_RECEIVE_DATA of a
+                              received token that has not been recycled.
+  @param[out] ChecksumStatus  A combination of EDKII_NETWORK_RX_CHECKSUM_*
+                              flags.
+
+  @retval EFI_SUCCESS            ChecksumStatus was returned.
+  @retval EFI_INVALID_PARAMETER  RxData or ChecksumStatus is NULL.
+  @retval EFI_NOT_FOUND          RxData was not delivered by this instance.
+
+**/
+EFI_STATUS
+EFIAPI
+Ip4GetRxChecksumStatus (
+  IN  EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL  *This,
+  IN  VOID                                     *RxData,
+  OUT UINT32                                   *ChecksumStatus
+  )
+{
+  IP4_PROTOCOL     *IpInstance;
+  IP4_RXDATA_WRAP  *Wrap;
+
+  if ((This == NULL) || (RxData == NULL) || (ChecksumStatus == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  IpInstance = IP4_INSTANCE_FROM_CHECKSUM_OFFLOAD (This);
+  Wrap       = BASE_CR (RxData, IP4_RXDATA_WRAP, RxData);
+  if (Wrap->IpInstance != IpInstance) {
+    return EFI_NOT_FOUND;
+  }
+
+  *ChecksumStatus = 0;
+  if ((IP4_GET_CLIP_INFO (Wrap->Packet)->LinkFlag & IP4_LINK_L4_CHECKSUM_VALID) != 0) {
+    *ChecksumStatus = EDKII_NETWORK_RX_CHECKSUM_L4_VALID;
+  }
+
+  return EFI_SUCCESS;
+}
@@ -18,6 +18,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Protocol/Ip4Config2.h>
 #include <Protocol/Arp.h>
 #include <Protocol/ManagedNetwork.h>
+#include <Protocol/NetworkChecksumOffload.h>
 #include <Protocol/Dhcp4.h>
 #include <Protocol/HiiConfigRouting.h>
 #include <Protocol/HiiConfigAccess.h>
@@ -120,107 +121,112 @@ typedef struct {
 } IP4_RXDATA_WRAP;
 
 struct _IP4_PROTOCOL {
-  UINT32                 Signature;
+  UINT32                                     Signature;
 
-  EFI_IP4_PROTOCOL       Ip4Proto;
-  EFI_HANDLE             Handle;
-  INTN                   State;
+  EFI_IP4_PROTOCOL                           Ip4Proto;
+  EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL    ChecksumOffload;
+  EFI_HANDLE                                 Handle;
+  INTN                                       State;
 
-  BOOLEAN                InDestroy;
+  BOOLEAN                                    InDestroy;
 
-  IP4_SERVICE            *Service;
-  LIST_ENTRY             Link;          // Link to all the IP protocol from the service
+  IP4_SERVICE                                *Service;
+  LIST_ENTRY                                 Link;          // Link to all the IP protocol from the service
 
   //
   // User's transmit/receive tokens, and received/delivered packets
   //
-  NET_MAP                RxTokens;
-  NET_MAP                TxTokens;      // map between (User's Token, IP4_TXTOKE_WRAP)
-  LIST_ENTRY             Received;      // Received but not delivered packet
-  LIST_ENTRY             Delivered;     // Delivered and to be recycled packets
-  EFI_LOCK               RecycleLock;
+  NET_MAP                                    RxTokens;
+  NET_MAP                                    TxTokens;      // map between (User's Token, IP4_TXTOKE_WRAP)
+  LIST_ENTRY                                 Received;      // Received but not delivered packet
+  LIST_ENTRY                                 Delivered;     // Delivered and to be recycled packets
+  EFI_LOCK                                   RecycleLock;
 
   //
   // Instance's address and route tables. There are two route tables.
   // RouteTable is used by the IP4 driver to route packet. EfiRouteTable
   // is used to communicate the current route info to the upper layer.
   //
-  IP4_INTERFACE          *Interface;
-  LIST_ENTRY             AddrLink;      // Ip instances with the same IP address.
-  IP4_ROUTE_TABLE        *RouteTable;
+  IP4_INTERFACE                              *Interface;
+  LIST_ENTRY                                 AddrLink;      // Ip instances with the same IP address.
+  IP4_ROUTE_TABLE                            *RouteTable;
 
-  EFI_IP4_ROUTE_TABLE    *EfiRouteTable;
-  UINT32                 EfiRouteCount;
+  EFI_IP4_ROUTE_TABLE                        *EfiRouteTable;
+  UINT32                                     EfiRouteCount;
 
   //
   // IGMP data for this instance
   //
-  IP4_ADDR               *Groups;       // stored in network byte order
-  UINT32                 GroupCount;
+  IP4_ADDR                                   *Groups;       // stored in network byte order
+  UINT32                                     GroupCount;
 
-  EFI_IP4_CONFIG_DATA    ConfigData;
+  EFI_IP4_CONFIG_DATA                        ConfigData;
 };
 
 struct _IP4_SERVICE {
-  UINT32                             Signature;
-  EFI_SERVICE_BINDING_PROTOCOL       ServiceBinding;
-  INTN                               State;
+  UINT32                                     Signature;
+  EFI_SERVICE_BINDING_PROTOCOL               ServiceBinding;
+  INTN                                       State;
 
   //
   // List of all the IP instances and interfaces, and default
   // interface and route table and caches.
   //
-  UINTN                              NumChildren;
-  LIST_ENTRY                         Children;
+  UINTN                                      NumChildren;
+  LIST_ENTRY                                 Children;
 
-  LIST_ENTRY                         Interfaces;
+  LIST_ENTRY                                 Interfaces;
 
-  IP4_INTERFACE                      *DefaultInterface;
-  IP4_ROUTE_TABLE                    *DefaultRouteTable;
+  IP4_INTERFACE                              *DefaultInterface;
+  IP4_ROUTE_TABLE                            *DefaultRouteTable;
 
   //
   // Ip reassemble utilities, and IGMP data
   //
-  IP4_ASSEMBLE_TABLE                 Assemble;
-  IGMP_SERVICE_DATA                  IgmpCtrl;
+  IP4_ASSEMBLE_TABLE                         Assemble;
+  IGMP_SERVICE_DATA                          IgmpCtrl;
 
   //
   // Low level protocol used by this service instance
   //
-  EFI_HANDLE                         Image;
-  EFI_HANDLE                         Controller;
+  EFI_HANDLE                                 Image;
+  EFI_HANDLE                                 Controller;
 
-  EFI_HANDLE                         MnpChildHandle;
-  EFI_MANAGED_NETWORK_PROTOCOL       *Mnp;
+  EFI_HANDLE                                 MnpChildHandle;
+  EFI_MANAGED_NETWORK_PROTOCOL               *Mnp;
+  EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL    *MnpChecksumOffload;
 
-  EFI_MANAGED_NETWORK_CONFIG_DATA    MnpConfigData;
-  EFI_SIMPLE_NETWORK_MODE            SnpMode;
+  EFI_MANAGED_NETWORK_CONFIG_DATA            MnpConfigData;
+  EFI_SIMPLE_NETWORK_MODE                    SnpMode;
 
-  EFI_EVENT                          Timer;
-  EFI_EVENT                          ReconfigCheckTimer;
-  EFI_EVENT                          ReconfigEvent;
+  EFI_EVENT                                  Timer;
+  EFI_EVENT                                  ReconfigCheckTimer;
+  EFI_EVENT                                  ReconfigEvent;
 
-  BOOLEAN                            Reconfig;
+  BOOLEAN                                    Reconfig;
 
   //
   // Underlying media present status.
   //
-  BOOLEAN                            MediaPresent;
+  BOOLEAN                                    MediaPresent;
 
   //
   // IPv4 Configuration II Protocol instance
   //
-  IP4_CONFIG2_INSTANCE               Ip4Config2Instance;
+  IP4_CONFIG2_INSTANCE                       Ip4Config2Instance;
 
-  CHAR16                             *MacString;
+  CHAR16                                     *MacString;
 
-  UINT32                             MaxPacketSize;
-  UINT32                             OldMaxPacketSize; ///< The MTU before IPsec enable.
+  UINT32                                     MaxPacketSize;
+  UINT32                                     OldMaxPacketSize; ///< The MTU before IPsec enable.
 };
 
 #define IP4_INSTANCE_FROM_PROTOCOL(Ip4) \
           CR ((Ip4), IP4_PROTOCOL, Ip4Proto, IP4_PROTOCOL_SIGNATURE)
 
+#define IP4_INSTANCE_FROM_CHECKSUM_OFFLOAD(This) \
+          CR ((This), IP4_PROTOCOL, ChecksumOffload, IP4_PROTOCOL_SIGNATURE)
+
 #define IP4_SERVICE_FROM_PROTOCOL(Sb)   \
           CR ((Sb), IP4_SERVICE, ServiceBinding, IP4_SERVICE_SIGNATURE)
 
@@ -407,6 +413,29 @@ Ip4FreeTxToken (
   IN VOID  *Context
   );
 
+/**
+  Return which checksums of a received packet the NIC has already verified.
+
+  @param[in]  This            Pointer to the
+                              EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL instance.
+  @param[in]  RxData          Pointer to the EFI_IP4_RECEIVE_DATA of a
+                              received token that has not been recycled.
+  @param[out] ChecksumStatus  A combination of EDKII_NETWORK_RX_CHECKSUM_*
+                              flags.
+
+  @retval EFI_SUCCESS            ChecksumStatus was returned.
+  @retval EFI_INVALID_PARAMETER  RxData or ChecksumStatus is NULL.
+  @retval EFI_NOT_FOUND          RxData was not delivered by this instance.
+
+**/
+EFI_STATUS
+EFIAPI
+Ip4GetRxChecksumStatus (
+  IN  EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL  *This,
+  IN  VOID                                     *RxData,
+  OUT UINT32                                   *ChecksumStatus
+  );
+
 extern EFI_IPSEC2_PROTOCOL  *mIpSec;
 extern BOOLEAN              mIpSec2Installed;
 
@@ -417,6 +417,12 @@ Ip4Reassemble (
       sizeof (*IP4_GET_CLIP_INFO (NewPacket))
       );
 
+    //
+    // The link layer only checked the L4 checksum of the fragment it
+    // received, which says nothing about the reassembled payload.
+    //
+    IP4_GET_CLIP_INFO (NewPacket)->LinkFlag &= ~IP4_LINK_L4_CHECKSUM_VALID;
+
     return NewPacket;
   }
 
@@ -660,6 +666,12 @@ Ip4IpSecProcessPacket (
         IP4_GET_CLIP_INFO (IpSecWrap->Packet),
         sizeof (IP4_CLIP_INFO)
         );
+
+      //
+      // The payload was rewritten by IPsec, so the link layer's checksum
+      // verdict no longer applies to it.
+      //
+      IP4_GET_CLIP_INFO (Packet)->LinkFlag &= ~IP4_LINK_L4_CHECKSUM_VALID;
     }
 
     *Netbuf = Packet;
@@ -194,6 +194,7 @@ Ip4CreateRouteTable (
     InitializeListHead (&(RtTable->RouteArea[Index]));
   }
 
+  NetRouteTrieInit (&RtTable->Trie);
   RtTable->Next = NULL;
 
   Ip4InitRouteCache (&RtTable->Cache);
@@ -235,6 +236,7 @@ Ip4FreeRouteTable (
     }
   }
 
+  NetRouteTrieClean (&RtTable->Trie);
   Ip4CleanRouteCache (&RtTable->Cache);
 
   FreePool (RtTable);
@@ -273,6 +275,48 @@ Ip4PurgeRouteCache (
   }
 }
 
+/**
+  Update the route trie entry of the prefix Dest/Netmask after the route
+  entries of that prefix have changed. The trie refers to the first
+  route entry with the prefix in its route area, which is the one the
+  linear search used to return. If there is no such route entry left,
+  the prefix is removed from the trie.
+
+  @param[in, out]  RtTable      The route table to update.
+  @param[in]       Dest         The destination of the network.
+  @param[in]       Netmask      The netmask of the destination.
+
+  @retval EFI_SUCCESS           The route trie is updated.
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate memory for the route trie.
+
+**/
+EFI_STATUS
+Ip4UpdateRouteTrie (
+  IN OUT IP4_ROUTE_TABLE  *RtTable,
+  IN     IP4_ADDR         Dest,
+  IN     IP4_ADDR         Netmask
+  )
+{
+  LIST_ENTRY       *Entry;
+  IP4_ROUTE_ENTRY  *RtEntry;
+  IP4_ADDR         Prefix;
+  UINT8            Length;
+
+  Length = (UINT8)NetGetMaskLength (Netmask);
+  Prefix = HTONL (Dest & Netmask);
+
+  NET_LIST_FOR_EACH (Entry, &(RtTable->RouteArea[Length])) {
+    RtEntry = NET_LIST_USER_STRUCT (Entry, IP4_ROUTE_ENTRY, Link);
+
+    if (IP4_NET_EQUAL (RtEntry->Dest, Dest, Netmask)) {
+      return NetRouteTrieInsert (&RtTable->Trie, (UINT8 *)&Prefix, Length, RtEntry);
+    }
+  }
+
+  NetRouteTrieRemove (&RtTable->Trie, (UINT8 *)&Prefix, Length);
+  return EFI_SUCCESS;
+}
+
 /**
   Add a route entry to the route table. All the IP4_ADDRs are in
   host byte order.
@@ -298,6 +342,7 @@ Ip4AddRoute (
   LIST_ENTRY       *Head;
   LIST_ENTRY       *Entry;
   IP4_ROUTE_ENTRY  *RtEntry;
+  EFI_STATUS       Status;
 
   //
   // All the route entries with the same netmask length are
@@ -330,6 +375,14 @@ Ip4AddRoute (
   }
 
   InsertHeadList (Head, &RtEntry->Link);
+
+  Status = Ip4UpdateRouteTrie (RtTable, Dest, Netmask);
+  if (EFI_ERROR (Status)) {
+    RemoveEntryList (&RtEntry->Link);
+    Ip4FreeRouteEntry (RtEntry);
+    return Status;
+  }
+
   RtTable->TotalNum++;
 
   return EFI_SUCCESS;
@@ -371,6 +424,12 @@ Ip4DelRoute (
       RemoveEntryList (Entry);
       Ip4FreeRouteEntry (RtEntry);
 
+      //
+      // Removing the prefix from the trie or pointing it to an existing
+      // entry never allocates, so this can't fail.
+      //
+      Ip4UpdateRouteTrie (RtTable, Dest, Netmask);
+
       RtTable->TotalNum--;
       return EFI_SUCCESS;
     }
@@ -419,11 +478,11 @@ Ip4FindRouteCache (
 }
 
 /**
-  Search the route table for a most specific match to the Dst. It searches
-  from the longest route area (mask length == 32) to the shortest route area
-  (default routes). In each route area, it will first search the instance's
-  route table, then the default route table. This is required by the following
-  requirements:
+  Search the route table for a most specific match to the Dst. It looks up
+  the longest matching prefix in the route trie of the instance's route
+  table and of the default route table. If both have a match of the same
+  length, the instance's route entry is used. This is required by the
+  following requirements:
   1. IP search the route table for a most specific match
   2. The local route entries have precedence over the default route entry.
 
@@ -440,27 +499,31 @@ Ip4FindRouteEntry (
   IN IP4_ADDR         Dst
   )
 {
-  LIST_ENTRY       *Entry;
   IP4_ROUTE_ENTRY  *RtEntry;
+  IP4_ROUTE_ENTRY  *Match;
   IP4_ROUTE_TABLE  *Table;
-  INTN             Index;
+  IP4_ADDR         Address;
+  UINT8            Length;
+  UINT8            MatchLength;
 
-  RtEntry = NULL;
+  RtEntry     = NULL;
+  MatchLength = 0;
+  Address     = HTONL (Dst);
 
-  for (Index = IP4_MASK_MAX; Index >= 0; Index--) {
-    for (Table = RtTable; Table != NULL; Table = Table->Next) {
-      NET_LIST_FOR_EACH (Entry, &Table->RouteArea[Index]) {
-        RtEntry = NET_LIST_USER_STRUCT (Entry, IP4_ROUTE_ENTRY, Link);
+  for (Table = RtTable; Table != NULL; Table = Table->Next) {
+    Match = NetRouteTrieLookup (&Table->Trie, (UINT8 *)&Address, IP4_MASK_MAX, &Length);
 
-        if (IP4_NET_EQUAL (RtEntry->Dest, Dst, RtEntry->Netmask)) {
-          NET_GET_REF (RtEntry);
-          return RtEntry;
-        }
-      }
+    if ((Match != NULL) && ((RtEntry == NULL) || (Length > MatchLength))) {
+      RtEntry     = Match;
+      MatchLength = Length;
     }
   }
 
-  return NULL;
+  if (RtEntry != NULL) {
+    NET_GET_REF (RtEntry);
+  }
+
+  return RtEntry;
 }
 
 /**
@@ -72,12 +72,17 @@ typedef struct {
 /// together in one route area. For example, RouteArea[0] contains
 /// the default routes. A route table also contains a route cache.
 ///
+/// The Trie indexes the first route entry of each distinct prefix in
+/// the route areas, so the most specific route is found without
+/// walking every route area.
+///
 typedef struct _IP4_ROUTE_TABLE IP4_ROUTE_TABLE;
 
 struct _IP4_ROUTE_TABLE {
   INTN               RefCnt;
   UINT32             TotalNum;
   LIST_ENTRY         RouteArea[IP4_MASK_NUM];
+  NET_ROUTE_TRIE     Trie;
   IP4_ROUTE_TABLE    *Next;
   IP4_ROUTE_CACHE    Cache;
 };
@@ -244,8 +244,11 @@ Ip6CreatePrefixListEntry (
     }
 
     RtEntry->Flag = IP6_DIRECT_ROUTE;
-    InsertHeadList (&IpSb->RouteTable->RouteArea[PrefixLength], &RtEntry->Link);
-    IpSb->RouteTable->TotalNum++;
+    if (EFI_ERROR (Ip6InsertRouteEntry (IpSb->RouteTable, RtEntry))) {
+      Ip6FreeRouteEntry (RtEntry);
+      FreePool (PrefixEntry);
+      return NULL;
+    }
   }
 
   //
@@ -719,8 +722,11 @@ Ip6CreateDefaultRouter (
     return NULL;
   }
 
-  InsertHeadList (&IpSb->RouteTable->RouteArea[0], &RtEntry->Link);
-  IpSb->RouteTable->TotalNum++;
+  if (EFI_ERROR (Ip6InsertRouteEntry (IpSb->RouteTable, RtEntry))) {
+    Ip6FreeRouteEntry (RtEntry);
+    FreePool (Entry);
+    return NULL;
+  }
 
   InsertTailList (&IpSb->DefaultRouterList, &Entry->Link);
 
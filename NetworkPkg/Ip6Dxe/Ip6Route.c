@@ -96,11 +96,48 @@ Ip6FreeRouteEntry (
 }
 
 /**
-  Search the route table for a most specific match to the Dst. It searches
-  from the longest route area (prefix length == 128) to the shortest route area
-  (default routes). In each route area, it will first search the instance's
-  route table, then the default route table. This is required per the following
-  requirements:
+  Update the route trie entry of the prefix Destination/PrefixLength after the
+  route entries of that prefix have changed. The trie refers to the first route
+  entry with the prefix in its route area, which is the one the linear search
+  used to return. If there is no such route entry left, the prefix is removed
+  from the trie.
+
+  @param[in, out]  RtTable        The route table to update.
+  @param[in]       Destination    The destination of the network.
+  @param[in]       PrefixLength   The PrefixLength of the destination.
+
+  @retval EFI_SUCCESS           The route trie is updated.
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate memory for the route trie.
+
+**/
+EFI_STATUS
+Ip6UpdateRouteTrie (
+  IN OUT IP6_ROUTE_TABLE  *RtTable,
+  IN EFI_IPv6_ADDRESS     *Destination,
+  IN UINT8                PrefixLength
+  )
+{
+  LIST_ENTRY       *Entry;
+  IP6_ROUTE_ENTRY  *RtEntry;
+
+  NET_LIST_FOR_EACH (Entry, &RtTable->RouteArea[PrefixLength]) {
+    RtEntry = NET_LIST_USER_STRUCT (Entry, IP6_ROUTE_ENTRY, Link);
+
+    if (NetIp6IsNetEqual (Destination, &RtEntry->Destination, PrefixLength)) {
+      return NetRouteTrieInsert (&RtTable->Trie, Destination->Addr, PrefixLength, RtEntry);
+    }
+  }
+
+  NetRouteTrieRemove (&RtTable->Trie, Destination->Addr, PrefixLength);
+  return EFI_SUCCESS;
+}
+
+/**
+  Search the route table for a most specific match to the Dst. When searching
+  by Destination, it looks up the longest matching prefix in the route trie.
+  When searching by NextHop, it searches from the longest route area (prefix
+  length == 128) to the shortest route area (default routes). This is required
+  per the following requirements:
   1. IP search the route table for a most specific match.
   2. The local route entries have precedence over the default route entry.
 
@@ -127,22 +164,22 @@ Ip6FindRouteEntry (
 
   ASSERT (Destination != NULL || NextHop != NULL);
 
-  RtEntry = NULL;
+  if (Destination != NULL) {
+    RtEntry = NetRouteTrieLookup (&RtTable->Trie, Destination->Addr, IP6_PREFIX_MAX, NULL);
+    if (RtEntry != NULL) {
+      NET_GET_REF (RtEntry);
+    }
+
+    return RtEntry;
+  }
 
   for (Index = IP6_PREFIX_MAX; Index >= 0; Index--) {
     NET_LIST_FOR_EACH (Entry, &RtTable->RouteArea[Index]) {
       RtEntry = NET_LIST_USER_STRUCT (Entry, IP6_ROUTE_ENTRY, Link);
 
-      if (Destination != NULL) {
-        if (NetIp6IsNetEqual (Destination, &RtEntry->Destination, RtEntry->PrefixLength)) {
-          NET_GET_REF (RtEntry);
-          return RtEntry;
-        }
-      } else if (NextHop != NULL) {
-        if (NetIp6IsNetEqual (NextHop, &RtEntry->NextHop, RtEntry->PrefixLength)) {
-          NET_GET_REF (RtEntry);
-          return RtEntry;
-        }
+      if (NetIp6IsNetEqual (NextHop, &RtEntry->NextHop, RtEntry->PrefixLength)) {
+        NET_GET_REF (RtEntry);
+        return RtEntry;
       }
     }
   }
@@ -342,6 +379,8 @@ Ip6CreateRouteTable (
     InitializeListHead (&RtTable->RouteArea[Index]);
   }
 
+  NetRouteTrieInit (&RtTable->Trie);
+
   for (Index = 0; Index < IP6_ROUTE_CACHE_HASH_SIZE; Index++) {
     InitializeListHead (&RtTable->Cache.CacheBucket[Index]);
     RtTable->Cache.CacheNum[Index] = 0;
@@ -385,6 +424,8 @@ Ip6CleanRouteTable (
     }
   }
 
+  NetRouteTrieClean (&RtTable->Trie);
+
   for (Index = 0; Index < IP6_ROUTE_CACHE_HASH_SIZE; Index++) {
     NET_LIST_FOR_EACH_SAFE (Entry, Next, &RtTable->Cache.CacheBucket[Index]) {
       RtCacheEntry = NET_LIST_USER_STRUCT (Entry, IP6_ROUTE_CACHE_ENTRY, Link);
@@ -429,6 +470,37 @@ Ip6PurgeRouteCache (
   }
 }
 
+/**
+  Insert a created route entry into the route area of its prefix length
+  and index it in the route trie.
+
+  @param[in, out]  RtTable        Route table to insert the route entry to.
+  @param[in]       RtEntry        The route entry to insert.
+
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate memory for the route trie.
+  @retval EFI_SUCCESS           The route entry was inserted successfully.
+
+**/
+EFI_STATUS
+Ip6InsertRouteEntry (
+  IN OUT IP6_ROUTE_TABLE  *RtTable,
+  IN IP6_ROUTE_ENTRY      *RtEntry
+  )
+{
+  EFI_STATUS  Status;
+
+  InsertHeadList (&RtTable->RouteArea[RtEntry->PrefixLength], &RtEntry->Link);
+
+  Status = Ip6UpdateRouteTrie (RtTable, &RtEntry->Destination, RtEntry->PrefixLength);
+  if (EFI_ERROR (Status)) {
+    RemoveEntryList (&RtEntry->Link);
+    return Status;
+  }
+
+  RtTable->TotalNum++;
+  return EFI_SUCCESS;
+}
+
 /**
   Add a route entry to the route table. It is the help function for EfiIp6Routes.
 
@@ -453,6 +525,7 @@ Ip6AddRoute (
   LIST_ENTRY       *ListHead;
   LIST_ENTRY       *Entry;
   IP6_ROUTE_ENTRY  *Route;
+  EFI_STATUS       Status;
 
   ListHead = &RtTable->RouteArea[PrefixLength];
 
@@ -482,8 +555,11 @@ Ip6AddRoute (
     Route->Flag = IP6_DIRECT_ROUTE;
   }
 
-  InsertHeadList (ListHead, &Route->Link);
-  RtTable->TotalNum++;
+  Status = Ip6InsertRouteEntry (RtTable, Route);
+  if (EFI_ERROR (Status)) {
+    Ip6FreeRouteEntry (Route);
+    return Status;
+  }
 
   return EFI_SUCCESS;
 }
@@ -510,11 +586,12 @@ Ip6DelRoute (
   IN EFI_IPv6_ADDRESS     *GatewayAddress
   )
 {
-  LIST_ENTRY       *ListHead;
-  LIST_ENTRY       *Entry;
-  LIST_ENTRY       *Next;
-  IP6_ROUTE_ENTRY  *Route;
-  UINT32           TotalNum;
+  LIST_ENTRY        *ListHead;
+  LIST_ENTRY        *Entry;
+  LIST_ENTRY        *Next;
+  IP6_ROUTE_ENTRY   *Route;
+  EFI_IPv6_ADDRESS  Prefix;
+  UINT32            TotalNum;
 
   ListHead = &RtTable->RouteArea[PrefixLength];
   TotalNum = RtTable->TotalNum;
@@ -531,9 +608,16 @@ Ip6DelRoute (
     }
 
     Ip6PurgeRouteCache (&RtTable->Cache, (UINTN)Route);
+    IP6_COPY_ADDRESS (&Prefix, &Route->Destination);
     RemoveEntryList (Entry);
     Ip6FreeRouteEntry (Route);
 
+    //
+    // Removing the prefix from the trie or pointing it to an existing
+    // entry never allocates, so this can't fail.
+    //
+    Ip6UpdateRouteTrie (RtTable, &Prefix, PrefixLength);
+
     ASSERT (RtTable->TotalNum > 0);
     RtTable->TotalNum--;
   }
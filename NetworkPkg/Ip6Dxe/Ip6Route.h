@@ -52,11 +52,16 @@ typedef struct {
 // together in one route area. For example, RouteArea[0] contains
 // the default routes. A route table also contains a route cache.
 //
+// The Trie indexes the first route entry of each distinct prefix in
+// the route areas, so the most specific route is found without
+// walking every route area.
+//
 
 typedef struct _IP6_ROUTE_TABLE {
   INTN               RefCnt;
   UINT32             TotalNum;
   LIST_ENTRY         RouteArea[IP6_PREFIX_NUM];
+  NET_ROUTE_TRIE     Trie;
   IP6_ROUTE_CACHE    Cache;
 } IP6_ROUTE_TABLE;
 
@@ -228,6 +233,23 @@ Ip6FreeRouteEntry (
   IN OUT IP6_ROUTE_ENTRY  *RtEntry
   );
 
+/**
+  Insert a created route entry into the route area of its prefix length
+  and index it in the route trie.
+
+  @param[in, out]  RtTable        Route table to insert the route entry to.
+  @param[in]       RtEntry        The route entry to insert.
+
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate memory for the route trie.
+  @retval EFI_SUCCESS           The route entry was inserted successfully.
+
+**/
+EFI_STATUS
+Ip6InsertRouteEntry (
+  IN OUT IP6_ROUTE_TABLE  *RtTable,
+  IN IP6_ROUTE_ENTRY      *RtEntry
+  );
+
 /**
   Add a route entry to the route table. It is the help function for EfiIp6Routes.
 
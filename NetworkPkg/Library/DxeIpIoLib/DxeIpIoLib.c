@@ -1092,6 +1092,15 @@ IpIoListenHandlerDpc (
     Session.IpHdr.Ip4Hdr   = RxData->Ip4RxData.Header;
     Session.IpHdrLen       = RxData->Ip4RxData.HeaderLength;
     Session.IpVersion      = IP_VERSION_4;
+    Session.ChecksumStatus = 0;
+
+    if ((EFI_SUCCESS == Status) && (IpIo->ChecksumOffload != NULL)) {
+      IpIo->ChecksumOffload->GetRxChecksumStatus (
+                               IpIo->ChecksumOffload,
+                               &RxData->Ip4RxData,
+                               &Session.ChecksumStatus
+                               );
+    }
   } else {
     ASSERT (RxData->Ip6RxData.Header != NULL);
     if (!NetIp6IsValidUnicast (&RxData->Ip6RxData.Header->SourceAddress)) {
@@ -1138,9 +1147,10 @@ IpIoListenHandlerDpc (
       &RxData->Ip6RxData.Header->DestinationAddress,
       sizeof (EFI_IPv6_ADDRESS)
       );
-    Session.IpHdr.Ip6Hdr = RxData->Ip6RxData.Header;
-    Session.IpHdrLen     = RxData->Ip6RxData.HeaderLength;
-    Session.IpVersion    = IP_VERSION_6;
+    Session.IpHdr.Ip6Hdr   = RxData->Ip6RxData.Header;
+    Session.IpHdrLen       = RxData->Ip6RxData.HeaderLength;
+    Session.IpVersion      = IP_VERSION_6;
+    Session.ChecksumStatus = 0;
   }
 
   if (EFI_SUCCESS == Status) {
@@ -1269,6 +1279,20 @@ IpIoCreate (
     goto ReleaseIpIo;
   }
 
+  if (IpVersion == IP_VERSION_4) {
+    Status = gBS->OpenProtocol (
+                    IpIo->ChildHandle,
+                    &gEdkiiNetworkChecksumOffloadProtocolGuid,
+                    (VOID **)&IpIo->ChecksumOffload,
+                    Image,
+                    Controller,
+                    EFI_OPEN_PROTOCOL_GET_PROTOCOL
+                    );
+    if (EFI_ERROR (Status)) {
+      IpIo->ChecksumOffload = NULL;
+    }
+  }
+
   return IpIo;
 
 ReleaseIpIo:
@@ -1829,6 +1829,283 @@ NetMapIterate (
   return EFI_SUCCESS;
 }
 
+/**
+  Get the bit at position Index of Bits, counting from the most significant
+  bit of the first byte.
+
+  @param[in]  Bits                  The byte array in network byte order.
+  @param[in]  Index                 The bit position.
+
+  @return The value of the bit, 0 or 1.
+
+**/
+UINTN
+NetRouteTrieGetBit (
+  IN CONST UINT8  *Bits,
+  IN UINTN        Index
+  )
+{
+  return (Bits[Index / 8] >> (7 - (Index % 8))) & 1;
+}
+
+/**
+  Initialize an empty route trie.
+
+  If Trie is NULL, then ASSERT().
+
+  @param[out]  Trie                 The route trie to initialize.
+
+**/
+VOID
+EFIAPI
+NetRouteTrieInit (
+  OUT NET_ROUTE_TRIE  *Trie
+  )
+{
+  ASSERT (Trie != NULL);
+
+  Trie->Root  = NULL;
+  Trie->Count = 0;
+}
+
+/**
+  Release all the nodes of the route trie. The values stored in the trie
+  are not touched; they remain owned by the caller.
+
+  If Trie is NULL, then ASSERT().
+
+  @param[in, out]  Trie             The route trie to clean up.
+
+**/
+VOID
+EFIAPI
+NetRouteTrieClean (
+  IN OUT NET_ROUTE_TRIE  *Trie
+  )
+{
+  NET_ROUTE_TRIE_NODE  *Node;
+  NET_ROUTE_TRIE_NODE  *Next;
+
+  ASSERT (Trie != NULL);
+
+  //
+  // Rotate the left children up so the nodes can be released one by
+  // one along the right spine without recursion or an explicit stack.
+  //
+  Node = Trie->Root;
+
+  while (Node != NULL) {
+    if (Node->Child[0] != NULL) {
+      Next           = Node->Child[0];
+      Node->Child[0] = Next->Child[1];
+      Next->Child[1] = Node;
+    } else {
+      Next = Node->Child[1];
+      FreePool (Node);
+    }
+
+    Node = Next;
+  }
+
+  Trie->Root  = NULL;
+  Trie->Count = 0;
+}
+
+/**
+  Associate Value with the prefix Prefix/PrefixLength. If the prefix is
+  already in the trie, its value is replaced.
+
+  If Trie, Prefix or Value is NULL, then ASSERT().
+  If PrefixLength is greater than NET_ROUTE_TRIE_MAX_PREFIX, then ASSERT().
+
+  @param[in, out]  Trie             The route trie to insert the prefix into.
+  @param[in]       Prefix           The prefix in network byte order.
+  @param[in]       PrefixLength     The number of significant bits in Prefix.
+  @param[in]       Value            The opaque value to store for the prefix.
+
+  @retval EFI_SUCCESS               The value is stored for the prefix.
+  @retval EFI_OUT_OF_RESOURCES      Failed to allocate memory for the trie nodes.
+
+**/
+EFI_STATUS
+EFIAPI
+NetRouteTrieInsert (
+  IN OUT NET_ROUTE_TRIE  *Trie,
+  IN     CONST UINT8     *Prefix,
+  IN     UINT8           PrefixLength,
+  IN     VOID            *Value
+  )
+{
+  NET_ROUTE_TRIE_NODE  **Slot;
+  UINTN                Index;
+
+  ASSERT ((Trie != NULL) && (Prefix != NULL) && (Value != NULL));
+  ASSERT (PrefixLength <= NET_ROUTE_TRIE_MAX_PREFIX);
+
+  Slot  = &Trie->Root;
+  Index = 0;
+
+  while (TRUE) {
+    if (*Slot == NULL) {
+      *Slot = AllocateZeroPool (sizeof (NET_ROUTE_TRIE_NODE));
+      if (*Slot == NULL) {
+        //
+        // The nodes created so far lead to no value, they are released by
+        // the next NetRouteTrieRemove or NetRouteTrieClean.
+        //
+        return EFI_OUT_OF_RESOURCES;
+      }
+    }
+
+    if (Index == PrefixLength) {
+      break;
+    }
+
+    Slot = &(*Slot)->Child[NetRouteTrieGetBit (Prefix, Index)];
+    Index++;
+  }
+
+  if ((*Slot)->Value == NULL) {
+    Trie->Count++;
+  }
+
+  (*Slot)->Value = Value;
+  return EFI_SUCCESS;
+}
+
+/**
+  Remove the prefix Prefix/PrefixLength from the trie and release the
+  nodes that no longer lead to any prefix.
+
+  If Trie or Prefix is NULL, then ASSERT().
+  If PrefixLength is greater than NET_ROUTE_TRIE_MAX_PREFIX, then ASSERT().
+
+  @param[in, out]  Trie             The route trie to remove the prefix from.
+  @param[in]       Prefix           The prefix in network byte order.
+  @param[in]       PrefixLength     The number of significant bits in Prefix.
+
+  @return The value that was stored for the prefix, or NULL if the prefix
+          is not in the trie.
+
+**/
+VOID *
+EFIAPI
+NetRouteTrieRemove (
+  IN OUT NET_ROUTE_TRIE  *Trie,
+  IN     CONST UINT8     *Prefix,
+  IN     UINT8           PrefixLength
+  )
+{
+  NET_ROUTE_TRIE_NODE  **Path[NET_ROUTE_TRIE_MAX_PREFIX + 1];
+  NET_ROUTE_TRIE_NODE  *Node;
+  VOID                 *Value;
+  UINTN                Index;
+
+  ASSERT ((Trie != NULL) && (Prefix != NULL));
+  ASSERT (PrefixLength <= NET_ROUTE_TRIE_MAX_PREFIX);
+
+  //
+  // Record the slot of every node on the way down so the empty nodes
+  // can be pruned bottom up.
+  //
+  Path[0] = &Trie->Root;
+
+  for (Index = 0; Index < PrefixLength; Index++) {
+    if (*Path[Index] == NULL) {
+      return NULL;
+    }
+
+    Path[Index + 1] = &(*Path[Index])->Child[NetRouteTrieGetBit (Prefix, Index)];
+  }
+
+  Node = *Path[PrefixLength];
+  if ((Node == NULL) || (Node->Value == NULL)) {
+    return NULL;
+  }
+
+  Value       = Node->Value;
+  Node->Value = NULL;
+  Trie->Count--;
+
+  Index = PrefixLength;
+
+  while (TRUE) {
+    Node = *Path[Index];
+    if ((Node->Value != NULL) || (Node->Child[0] != NULL) || (Node->Child[1] != NULL)) {
+      break;
+    }
+
+    FreePool (Node);
+    *Path[Index] = NULL;
+
+    if (Index == 0) {
+      break;
+    }
+
+    Index--;
+  }
+
+  return Value;
+}
+
+/**
+  Find the longest prefix in the trie that matches Address.
+
+  If Trie or Address is NULL, then ASSERT().
+  If AddressLength is greater than NET_ROUTE_TRIE_MAX_PREFIX, then ASSERT().
+
+  @param[in]   Trie                 The route trie to search.
+  @param[in]   Address              The address in network byte order.
+  @param[in]   AddressLength        The number of bits in Address.
+  @param[out]  PrefixLength         The length of the matching prefix. Optional.
+
+  @return The value stored for the longest matching prefix, or NULL if no
+          prefix matches Address.
+
+**/
+VOID *
+EFIAPI
+NetRouteTrieLookup (
+  IN  NET_ROUTE_TRIE  *Trie,
+  IN  CONST UINT8     *Address,
+  IN  UINT8           AddressLength,
+  OUT UINT8           *PrefixLength OPTIONAL
+  )
+{
+  NET_ROUTE_TRIE_NODE  *Node;
+  VOID                 *Value;
+  UINTN                Index;
+  UINTN                Length;
+
+  ASSERT ((Trie != NULL) && (Address != NULL));
+  ASSERT (AddressLength <= NET_ROUTE_TRIE_MAX_PREFIX);
+
+  Node   = Trie->Root;
+  Value  = NULL;
+  Length = 0;
+  Index  = 0;
+
+  while (Node != NULL) {
+    if (Node->Value != NULL) {
+      Value  = Node->Value;
+      Length = Index;
+    }
+
+    if (Index == AddressLength) {
+      break;
+    }
+
+    Node = Node->Child[NetRouteTrieGetBit (Address, Index)];
+    Index++;
+  }
+
+  if ((Value != NULL) && (PrefixLength != NULL)) {
+    *PrefixLength = (UINT8)Length;
+  }
+
+  return Value;
+}
+
 /**
   This is the default unload handle for all the network drivers.
 
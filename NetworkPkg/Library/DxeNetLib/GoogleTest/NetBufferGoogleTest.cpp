@@ -0,0 +1,183 @@
+/** @file
+  Tests for the checksum functions in NetBuffer.c.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <gtest/gtest.h>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/DebugLib.h>
+  #include <Library/NetLib.h>
+}
+
+/////////////////////////////////////////////////////////////////////////
+// Defines
+///////////////////////////////////////////////////////////////////////
+
+#define CHECKSUM_BUFFER_SIZE  (MAX_UINT16 + 16)
+
+////////////////////////////////////////////////////////////////////////
+// Helper Functions
+////////////////////////////////////////////////////////////////////////
+
+//
+// The 16-bit at a time sum NetblockChecksum used before it was widened,
+// kept as the reference the optimized version must match.
+//
+static UINT16
+ReferenceChecksum (
+  IN UINT8   *Bulk,
+  IN UINT32  Len
+  )
+{
+  UINT32  Sum;
+
+  Sum = 0;
+
+  if (Len % 2 != 0) {
+    Sum += *(Bulk + Len - 1);
+  }
+
+  while (Len > 1) {
+    Sum  += ReadUnaligned16 ((UINT16 *)Bulk);
+    Bulk += 2;
+    Len  -= 2;
+  }
+
+  while ((Sum >> 16) != 0) {
+    Sum = (Sum & 0xffff) + (Sum >> 16);
+  }
+
+  return (UINT16)Sum;
+}
+
+static VOID
+EFIAPI
+ChecksumTestExtFree (
+  IN VOID  *Arg
+  )
+{
+}
+
+////////////////////////////////////////////////////////////////////////
+// NetblockChecksum Tests
+////////////////////////////////////////////////////////////////////////
+
+class NetblockChecksumTest : public ::testing::Test {
+protected:
+  UINT8 *Buffer;
+
+  virtual void
+  SetUp (
+    )
+  {
+    UINT32  Seed;
+    UINT32  Index;
+
+    Buffer = new UINT8[CHECKSUM_BUFFER_SIZE];
+    Seed   = 0x12345678;
+    for (Index = 0; Index < CHECKSUM_BUFFER_SIZE; Index++) {
+      Seed          = Seed * 1103515245 + 12345;
+      Buffer[Index] = (UINT8)(Seed >> 16);
+    }
+  }
+
+  virtual void
+  TearDown (
+    )
+  {
+    delete[] Buffer;
+  }
+};
+
+// Test Description:
+// The worked example from RFC 1071 section 3 sums to 0xddf2 in network order.
+TEST_F (NetblockChecksumTest, Rfc1071Example) {
+  UINT8  Data[] = { 0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7 };
+
+  EXPECT_EQ (NTOHS (NetblockChecksum (Data, sizeof (Data))), 0xddf2);
+}
+
+// Test Description:
+// An empty block sums to zero.
+TEST_F (NetblockChecksumTest, EmptyBlockIsZero) {
+  EXPECT_EQ (NetblockChecksum (Buffer, 0), 0);
+}
+
+// Test Description:
+// Every alignment and every short length matches the reference sum.
+TEST_F (NetblockChecksumTest, MatchesReferenceForAllAlignments) {
+  UINT32  Offset;
+  UINT32  Len;
+
+  for (Offset = 0; Offset < 8; Offset++) {
+    for (Len = 0; Len <= 512; Len++) {
+      ASSERT_EQ (NetblockChecksum (Buffer + Offset, Len), ReferenceChecksum (Buffer + Offset, Len)) << "Offset " << Offset << " Len " << Len;
+    }
+  }
+}
+
+// Test Description:
+// A maximum sized IP datagram matches the reference sum.
+TEST_F (NetblockChecksumTest, MatchesReferenceForLargeBlocks) {
+  UINT32  Offset;
+
+  for (Offset = 0; Offset < 8; Offset++) {
+    EXPECT_EQ (NetblockChecksum (Buffer + Offset, MAX_UINT16), ReferenceChecksum (Buffer + Offset, MAX_UINT16));
+    EXPECT_EQ (NetblockChecksum (Buffer + Offset, 1500), ReferenceChecksum (Buffer + Offset, 1500));
+  }
+}
+
+// Test Description:
+// All-ones data carries on every addition and must still fold to 0xffff.
+TEST_F (NetblockChecksumTest, AllOnesFoldsCorrectly) {
+  UINT32  Offset;
+
+  SetMem (Buffer, CHECKSUM_BUFFER_SIZE, 0xff);
+  for (Offset = 0; Offset < 8; Offset++) {
+    EXPECT_EQ (NetblockChecksum (Buffer + Offset, MAX_UINT16 - 1), 0xffff);
+    EXPECT_EQ (NetblockChecksum (Buffer + Offset, MAX_UINT16), ReferenceChecksum (Buffer + Offset, MAX_UINT16));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////
+// NetbufChecksum Tests
+////////////////////////////////////////////////////////////////////////
+
+class NetbufChecksumTest : public NetblockChecksumTest {
+};
+
+// Test Description:
+// The checksum of a fragmented NET_BUF equals that of the linear data,
+// including fragments with odd lengths and odd start addresses.
+TEST_F (NetbufChecksumTest, FragmentsMatchLinearData) {
+  NET_FRAGMENT  Fragment[4];
+  NET_BUF       *Nbuf;
+  UINT32        Total;
+  UINT32        Index;
+
+  Fragment[0].Bulk = Buffer + 1;
+  Fragment[0].Len  = 13;
+  Fragment[1].Bulk = Buffer + 1 + 13;
+  Fragment[1].Len  = 1;
+  Fragment[2].Bulk = Buffer + 1 + 14;
+  Fragment[2].Len  = 1400;
+  Fragment[3].Bulk = Buffer + 1 + 1414;
+  Fragment[3].Len  = 87;
+
+  Total = 0;
+  for (Index = 0; Index < ARRAY_SIZE (Fragment); Index++) {
+    Total += Fragment[Index].Len;
+  }
+
+  Nbuf = NetbufFromExt (Fragment, ARRAY_SIZE (Fragment), 0, 0, ChecksumTestExtFree, NULL);
+  ASSERT_NE (Nbuf, nullptr);
+
+  EXPECT_EQ (NetbufChecksum (Nbuf), ReferenceChecksum (Buffer + 1, Total));
+
+  NetbufFree (Nbuf);
+}
@@ -14,6 +14,124 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/MemoryAllocationLib.h>
 
+//
+// Released single block NET_BUF and NET_VECTOR structures are kept for reuse,
+// so that the NetbufAlloc() / NetbufFree() pair of every packet does not go
+// through the pool allocator.
+//
+// The network stack only runs on the BSP, and a callback at a higher TPL
+// completes before the code that it interrupted resumes. A caller that
+// interrupts another one while it updates a cache finds mNetbufCacheBusy set,
+// and uses the pool directly.
+//
+#define NET_BUF_CACHE_SIZE  32
+
+typedef struct {
+  UINTN    Count;
+  VOID     *Buffer[NET_BUF_CACHE_SIZE];
+} NET_BUF_CACHE;
+
+STATIC volatile BOOLEAN        mNetbufCacheBusy = FALSE;
+STATIC volatile NET_BUF_CACHE  mNetbufCache;
+STATIC volatile NET_BUF_CACHE  mNetVectorCache;
+
+/**
+  Take a zeroed buffer from a cache, or allocate one if the cache is empty.
+
+  @param[in]  Cache              The cache to take the buffer from.
+  @param[in]  Size               The size of the buffers in the cache.
+
+  @return                        Pointer to the zeroed buffer, or NULL if the
+                                 allocation failed due to resource limit.
+
+**/
+STATIC
+VOID *
+NetbufCacheAllocate (
+  IN volatile NET_BUF_CACHE  *Cache,
+  IN UINTN                   Size
+  )
+{
+  VOID  *Buffer;
+
+  Buffer = NULL;
+  if (!mNetbufCacheBusy) {
+    mNetbufCacheBusy = TRUE;
+    if (Cache->Count > 0) {
+      Cache->Count--;
+      Buffer = Cache->Buffer[Cache->Count];
+    }
+
+    mNetbufCacheBusy = FALSE;
+  }
+
+  if (Buffer == NULL) {
+    return AllocateZeroPool (Size);
+  }
+
+  return ZeroMem (Buffer, Size);
+}
+
+/**
+  Return a buffer to a cache, or free it if the cache is full.
+
+  @param[in]  Cache              The cache to return the buffer to.
+  @param[in]  Buffer             The buffer to release.
+
+**/
+STATIC
+VOID
+NetbufCacheFree (
+  IN volatile NET_BUF_CACHE  *Cache,
+  IN VOID                    *Buffer
+  )
+{
+  if (!mNetbufCacheBusy) {
+    mNetbufCacheBusy = TRUE;
+    if (Cache->Count < NET_BUF_CACHE_SIZE) {
+      Cache->Buffer[Cache->Count] = Buffer;
+      Cache->Count++;
+      Buffer = NULL;
+    }
+
+    mNetbufCacheBusy = FALSE;
+  }
+
+  if (Buffer != NULL) {
+    FreePool (Buffer);
+  }
+}
+
+/**
+  Release the NET_BUF and NET_VECTOR structures kept for reuse when the image
+  is unloaded.
+
+  @param[in]  ImageHandle        The firmware allocated handle for the EFI image.
+  @param[in]  SystemTable        A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS            Always.
+
+**/
+EFI_STATUS
+EFIAPI
+NetbufCacheDestructor (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  while (mNetbufCache.Count > 0) {
+    mNetbufCache.Count--;
+    FreePool (mNetbufCache.Buffer[mNetbufCache.Count]);
+  }
+
+  while (mNetVectorCache.Count > 0) {
+    mNetVectorCache.Count--;
+    FreePool (mNetVectorCache.Buffer[mNetVectorCache.Count]);
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Allocate and build up the sketch for a NET_BUF.
 
@@ -40,9 +158,14 @@ NetbufAllocStruct (
   ASSERT (BlockOpNum >= 1);
 
   //
-  // Allocate three memory blocks.
+  // Allocate three memory blocks. Single block structures come from the
+  // caches when available.
   //
-  Nbuf = AllocateZeroPool (NET_BUF_SIZE (BlockOpNum));
+  if (BlockOpNum == 1) {
+    Nbuf = NetbufCacheAllocate (&mNetbufCache, NET_BUF_SIZE (1));
+  } else {
+    Nbuf = AllocateZeroPool (NET_BUF_SIZE (BlockOpNum));
+  }
 
   if (Nbuf == NULL) {
     return NULL;
@@ -54,7 +177,11 @@ NetbufAllocStruct (
   InitializeListHead (&Nbuf->List);
 
   if (BlockNum != 0) {
-    Vector = AllocateZeroPool (NET_VECTOR_SIZE (BlockNum));
+    if (BlockNum == 1) {
+      Vector = NetbufCacheAllocate (&mNetVectorCache, NET_VECTOR_SIZE (1));
+    } else {
+      Vector = AllocateZeroPool (NET_VECTOR_SIZE (BlockNum));
+    }
 
     if (Vector == NULL) {
       goto FreeNbuf;
@@ -70,7 +197,12 @@ NetbufAllocStruct (
 
 FreeNbuf:
 
-  FreePool (Nbuf);
+  if (BlockOpNum == 1) {
+    NetbufCacheFree (&mNetbufCache, Nbuf);
+  } else {
+    FreePool (Nbuf);
+  }
+
   return NULL;
 }
 
@@ -175,7 +307,11 @@ NetbufFreeVector (
     }
   }
 
-  FreePool (Vector);
+  if (Vector->BlockNum == 1) {
+    NetbufCacheFree (&mNetVectorCache, Vector);
+  } else {
+    FreePool (Vector);
+  }
 }
 
 /**
@@ -208,7 +344,11 @@ NetbufFree (
     // all the sharing of Nbuf increse Vector's RefCnt by one
     //
     NetbufFreeVector (Nbuf->Vector);
-    FreePool (Nbuf);
+    if (Nbuf->BlockOpNum == 1) {
+      NetbufCacheFree (&mNetbufCache, Nbuf);
+    } else {
+      FreePool (Nbuf);
+    }
   }
 }
 
@@ -234,7 +374,11 @@ NetbufClone (
 
   NET_CHECK_SIGNATURE (Nbuf, NET_BUF_SIGNATURE);
 
-  Clone = AllocatePool (NET_BUF_SIZE (Nbuf->BlockOpNum));
+  if (Nbuf->BlockOpNum == 1) {
+    Clone = NetbufCacheAllocate (&mNetbufCache, NET_BUF_SIZE (1));
+  } else {
+    Clone = AllocatePool (NET_BUF_SIZE (Nbuf->BlockOpNum));
+  }
 
   if (Clone == NULL) {
     return NULL;
@@ -1604,6 +1748,13 @@ NetbufQueFlush (
 /**
   Compute the checksum for a bulk of data.
 
+  The data is summed four bytes at a time into a 64-bit accumulator, so
+  the carries only need to be folded once at the end. The one's complement
+  sum does not depend on the byte order of the words it adds, so the result
+  equals that of summing the data 16 bits at a time. A buffer starting on
+  an odd address is summed from its second byte with aligned loads and the
+  result is swapped back, as described in RFC 1071.
+
   @param[in]   Bulk                  Pointer to the data.
   @param[in]   Len                   Length of the data, in bytes.
 
@@ -1617,28 +1768,74 @@ NetblockChecksum (
   IN UINT32  Len
   )
 {
-  register UINT32  Sum;
+  UINT64   Sum;
+  BOOLEAN  Odd;
 
   Sum = 0;
+  Odd = FALSE;
+
+  if (Len == 0) {
+    return 0;
+  }
 
   //
-  // Add left-over byte, if any
+  // For an odd start address, add the first byte as the high half of a
+  // word and swap the folded sum back at the end.
   //
-  if (Len % 2 != 0) {
-    Sum += *(Bulk + Len - 1);
+  if (((UINTN)Bulk & 0x01) != 0) {
+    Odd  = TRUE;
+    Sum  = (UINT64)(*Bulk) << 8;
+    Bulk++;
+    Len--;
   }
 
-  while (Len > 1) {
+  if ((Len >= 2) && (((UINTN)Bulk & 0x02) != 0)) {
     Sum  += *(UINT16 *)Bulk;
     Bulk += 2;
     Len  -= 2;
   }
 
   //
-  // Fold 32-bit sum to 16 bits
+  // The 32-bit words are added without carry. A UINT64 can absorb a
+  // carry for every word of a buffer up to 16GB, well beyond MAX_UINT32.
+  //
+  while (Len >= 16) {
+    Sum  += (UINT64)((UINT32 *)Bulk)[0] + ((UINT32 *)Bulk)[1]
+            + ((UINT32 *)Bulk)[2] + ((UINT32 *)Bulk)[3];
+    Bulk += 16;
+    Len  -= 16;
+  }
+
+  while (Len >= 4) {
+    Sum  += *(UINT32 *)Bulk;
+    Bulk += 4;
+    Len  -= 4;
+  }
+
+  if (Len >= 2) {
+    Sum  += *(UINT16 *)Bulk;
+    Bulk += 2;
+    Len  -= 2;
+  }
+
+  //
+  // Add left-over byte, if any
+  //
+  if (Len != 0) {
+    Sum += *Bulk;
+  }
+
+  //
+  // Fold 64-bit sum to 16 bits
   //
-  while ((Sum >> 16) != 0) {
-    Sum = (Sum & 0xffff) + (Sum >> 16);
+  Sum = (Sum & 0xffffffff) + (Sum >> 32);
+  Sum = (Sum & 0xffffffff) + (Sum >> 32);
+  Sum = (Sum & 0xffff) + (Sum >> 16);
+  Sum = (Sum & 0xffff) + (Sum >> 16);
+  Sum = (Sum & 0xffff) + (Sum >> 16);
+
+  if (Odd) {
+    return SwapBytes16 ((UINT16)Sum);
   }
 
   return (UINT16)Sum;
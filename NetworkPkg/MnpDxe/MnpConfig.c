@@ -457,6 +457,21 @@ MnpInitializeDeviceData (
   SnpMode            = Snp->Mode;
   MnpDeviceData->Snp = Snp;
 
+  //
+  // The SNP driver may also report which checksums the NIC has verified.
+  //
+  Status = gBS->OpenProtocol (
+                  ControllerHandle,
+                  &gEdkiiNetworkChecksumOffloadProtocolGuid,
+                  (VOID **)&MnpDeviceData->ChecksumOffload,
+                  ImageHandle,
+                  ControllerHandle,
+                  EFI_OPEN_PROTOCOL_GET_PROTOCOL
+                  );
+  if (EFI_ERROR (Status)) {
+    MnpDeviceData->ChecksumOffload = NULL;
+  }
+
   //
   // Initialize the lists.
   //
@@ -981,6 +996,14 @@ MnpInitializeInstanceData (
   //
   CopyMem (&Instance->ManagedNetwork, &mMnpProtocolTemplate, sizeof (Instance->ManagedNetwork));
 
+  //
+  // Pass on the checksum offload capabilities of the SNP driver, if any.
+  //
+  Instance->ChecksumOffload.GetRxChecksumStatus = MnpGetRxChecksumStatus;
+  if (MnpServiceData->MnpDeviceData->ChecksumOffload != NULL) {
+    Instance->ChecksumOffload.RxCapabilities = MnpServiceData->MnpDeviceData->ChecksumOffload->RxCapabilities;
+  }
+
   //
   // Copy the default config data.
   //
@@ -463,6 +463,8 @@ MnpServiceBindingCreateChild (
                   ChildHandle,
                   &gEfiManagedNetworkProtocolGuid,
                   &Instance->ManagedNetwork,
+                  &gEdkiiNetworkChecksumOffloadProtocolGuid,
+                  &Instance->ChecksumOffload,
                   NULL
                   );
   if (EFI_ERROR (Status)) {
@@ -510,6 +512,8 @@ ErrorExit:
              Instance->Handle,
              &gEfiManagedNetworkProtocolGuid,
              &Instance->ManagedNetwork,
+             &gEdkiiNetworkChecksumOffloadProtocolGuid,
+             &Instance->ChecksumOffload,
              NULL
              );
     }
@@ -606,6 +610,8 @@ MnpServiceBindingDestroyChild (
                   ChildHandle,
                   &gEfiManagedNetworkProtocolGuid,
                   &Instance->ManagedNetwork,
+                  &gEdkiiNetworkChecksumOffloadProtocolGuid,
+                  &Instance->ChecksumOffload,
                   NULL
                   );
   if (EFI_ERROR (Status)) {
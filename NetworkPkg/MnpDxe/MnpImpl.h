@@ -25,6 +25,11 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define MNP_MAX_RCVD_PACKET_QUE_SIZE  256
 
+//
+// Largest number of packets received from SNP by one poll.
+//
+#define MNP_RX_BATCH_SIZE  64
+
 #define MNP_RECEIVE_UNICAST    0x01
 #define MNP_RECEIVE_BROADCAST  0x02
 
@@ -41,31 +46,40 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
   MNP_INSTANCE_DATA_SIGNATURE \
   )
 
+#define MNP_INSTANCE_DATA_FROM_CHECKSUM_OFFLOAD(a) \
+  CR ( \
+  (a), \
+  MNP_INSTANCE_DATA, \
+  ChecksumOffload, \
+  MNP_INSTANCE_DATA_SIGNATURE \
+  )
+
 typedef struct {
-  UINT32                             Signature;
+  UINT32                                     Signature;
 
-  MNP_SERVICE_DATA                   *MnpServiceData;
+  MNP_SERVICE_DATA                           *MnpServiceData;
 
-  EFI_HANDLE                         Handle;
+  EFI_HANDLE                                 Handle;
 
-  LIST_ENTRY                         InstEntry;
+  LIST_ENTRY                                 InstEntry;
 
-  EFI_MANAGED_NETWORK_PROTOCOL       ManagedNetwork;
+  EFI_MANAGED_NETWORK_PROTOCOL               ManagedNetwork;
+  EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL    ChecksumOffload;
 
-  BOOLEAN                            Configured;
-  BOOLEAN                            Destroyed;
+  BOOLEAN                                    Configured;
+  BOOLEAN                                    Destroyed;
 
-  LIST_ENTRY                         GroupCtrlBlkList;
+  LIST_ENTRY                                 GroupCtrlBlkList;
 
-  NET_MAP                            RxTokenMap;
+  NET_MAP                                    RxTokenMap;
 
-  LIST_ENTRY                         RxDeliveredPacketQueue;
-  LIST_ENTRY                         RcvdPacketQueue;
-  UINTN                              RcvdPacketQueueSize;
+  LIST_ENTRY                                 RxDeliveredPacketQueue;
+  LIST_ENTRY                                 RcvdPacketQueue;
+  UINTN                                      RcvdPacketQueueSize;
 
-  EFI_MANAGED_NETWORK_CONFIG_DATA    ConfigData;
+  EFI_MANAGED_NETWORK_CONFIG_DATA            ConfigData;
 
-  UINT8                              ReceiveFilter;
+  UINT8                                      ReceiveFilter;
 } MNP_INSTANCE_DATA;
 
 typedef struct {
@@ -85,6 +99,7 @@ typedef struct {
   EFI_MANAGED_NETWORK_RECEIVE_DATA    RxData;
   NET_BUF                             *Nbuf;
   UINT64                              TimeoutTick;
+  UINT32                              ChecksumStatus;
 } MNP_RXDATA_WRAP;
 
 #define MNP_TX_BUF_WRAP_SIGNATURE  SIGNATURE_32 ('M', 'T', 'B', 'W')
@@ -430,6 +445,23 @@ MnpReceivePacket (
   IN OUT MNP_DEVICE_DATA  *MnpDeviceData
   );
 
+/**
+  Receive and deliver the packets pending in the SNP driver, at most
+  MNP_RX_BATCH_SIZE of them, so that one poll drains a burst of frames.
+
+  @param[in, out]  MnpDeviceData        Pointer to the mnp device context data.
+
+  @retval EFI_SUCCESS           At least one packet was received.
+  @retval EFI_NOT_STARTED       The simple network protocol is not started.
+  @retval EFI_NOT_READY         No packet received.
+  @retval EFI_DEVICE_ERROR      An unexpected error occurs.
+
+**/
+EFI_STATUS
+MnpReceivePacketBatch (
+  IN OUT MNP_DEVICE_DATA  *MnpDeviceData
+  );
+
 /**
   Allocate a free NET_BUF from MnpDeviceData->FreeNbufQue. If there is none
   in the queue, first try to allocate some and add them into the queue, then
@@ -879,6 +911,29 @@ MnpPoll (
   IN EFI_MANAGED_NETWORK_PROTOCOL  *This
   );
 
+/**
+  Return which checksums of a received packet the NIC has already verified.
+
+  @param[in]  This            Pointer to the
+                              EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL instance.
+  @param[in]  RxData          Pointer to the EFI_MANAGED_NETWORK_RECEIVE_DATA
+                              of a received token that has not been recycled.
+  @param[out] ChecksumStatus  A combination of EDKII_NETWORK_RX_CHECKSUM_*
+                              flags.
+
+  @retval EFI_SUCCESS            ChecksumStatus was returned.
+  @retval EFI_INVALID_PARAMETER  RxData or ChecksumStatus is NULL.
+  @retval EFI_NOT_FOUND          RxData was not delivered by this instance.
+
+**/
+EFI_STATUS
+EFIAPI
+MnpGetRxChecksumStatus (
+  IN  EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL  *This,
+  IN  VOID                                     *RxData,
+  OUT UINT32                                   *ChecksumStatus
+  );
+
 /**
   Configure the Snp receive filters according to the instances' receive filter
   settings.
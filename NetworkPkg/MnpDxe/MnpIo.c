@@ -748,12 +748,15 @@ MnpWrapRxData (
   @param[in]  MnpServiceData    Pointer to the mnp service context data.
   @param[in]  Nbuf              Pointer to the net buffer representing the received
                                 packet.
+  @param[in]  ChecksumStatus    The EDKII_NETWORK_RX_CHECKSUM_* flags the SNP
+                                driver reported for the packet.
 
 **/
 VOID
 MnpEnqueuePacket (
   IN MNP_SERVICE_DATA  *MnpServiceData,
-  IN NET_BUF           *Nbuf
+  IN NET_BUF           *Nbuf,
+  IN UINT32            ChecksumStatus
   )
 {
   LIST_ENTRY                        *Entry;
@@ -805,6 +808,8 @@ MnpEnqueuePacket (
       RxDataWrap->Nbuf = Nbuf;
       NET_GET_REF (RxDataWrap->Nbuf);
 
+      RxDataWrap->ChecksumStatus = ChecksumStatus;
+
       //
       // Queue the packet into the instance queue.
       //
@@ -839,6 +844,7 @@ MnpReceivePacket (
   MNP_SERVICE_DATA             *MnpServiceData;
   UINT16                       VlanId;
   BOOLEAN                      IsVlanPacket;
+  UINT32                       ChecksumStatus;
 
   NET_CHECK_SIGNATURE (MnpDeviceData, MNP_DEVICE_DATA_SIGNATURE);
 
@@ -903,6 +909,19 @@ MnpReceivePacket (
     return EFI_DEVICE_ERROR;
   }
 
+  //
+  // Ask the SNP driver before the next Receive() which checksums the NIC
+  // has verified. ChecksumStatus is left untouched on error.
+  //
+  ChecksumStatus = 0;
+  if (MnpDeviceData->ChecksumOffload != NULL) {
+    MnpDeviceData->ChecksumOffload->GetRxChecksumStatus (
+                                      MnpDeviceData->ChecksumOffload,
+                                      BufPtr,
+                                      &ChecksumStatus
+                                      );
+  }
+
   Trimmed = 0;
   if (Nbuf->TotalSize != BufLen) {
     //
@@ -941,7 +960,7 @@ MnpReceivePacket (
   //
   // Enqueue the packet to the matched instances.
   //
-  MnpEnqueuePacket (MnpServiceData, Nbuf);
+  MnpEnqueuePacket (MnpServiceData, Nbuf, ChecksumStatus);
 
   if (Nbuf->RefCnt > 2) {
     //
@@ -985,6 +1004,37 @@ EXIT:
   return Status;
 }
 
+/**
+  Receive and deliver the packets pending in the SNP driver, at most
+  MNP_RX_BATCH_SIZE of them, so that one poll drains a burst of frames.
+
+  @param[in, out]  MnpDeviceData        Pointer to the mnp device context data.
+
+  @retval EFI_SUCCESS           At least one packet was received.
+  @retval EFI_NOT_STARTED       The simple network protocol is not started.
+  @retval EFI_NOT_READY         No packet received.
+  @retval EFI_DEVICE_ERROR      An unexpected error occurs.
+
+**/
+EFI_STATUS
+MnpReceivePacketBatch (
+  IN OUT MNP_DEVICE_DATA  *MnpDeviceData
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Index;
+
+  Status = MnpReceivePacket (MnpDeviceData);
+
+  for (Index = 1; !EFI_ERROR (Status) && (Index < MNP_RX_BATCH_SIZE); Index++) {
+    if (EFI_ERROR (MnpReceivePacket (MnpDeviceData))) {
+      break;
+    }
+  }
+
+  return Status;
+}
+
 /**
   Remove the received packets if timeout occurs.
 
@@ -1106,7 +1156,7 @@ MnpSystemPoll (
   //
   // Try to receive packets from Snp.
   //
-  MnpReceivePacket (MnpDeviceData);
+  MnpReceivePacketBatch (MnpDeviceData);
 
   //
   // Dispatch the DPC queued by the NotifyFunction of rx token's events.
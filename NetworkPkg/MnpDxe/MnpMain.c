@@ -773,7 +773,7 @@ MnpPoll (
   //
   // Try to receive packets.
   //
-  Status = MnpReceivePacket (Instance->MnpServiceData->MnpDeviceData);
+  Status = MnpReceivePacketBatch (Instance->MnpServiceData->MnpDeviceData);
 
   //
   // Dispatch the DPC queued by the NotifyFunction of rx token's events.
@@ -785,3 +785,43 @@ ON_EXIT:
 
   return Status;
 }
+
+/**
+  Return which checksums of a received packet the NIC has already verified.
+
+  @param[in]  This            Pointer to the
+                              EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL instance.
+  @param[in]  RxData          Pointer to the EFI_MANAGED_NETWORK_RECEIVE_DATA
+                              of a received token that has not been recycled.
+  @param[out] ChecksumStatus  A combination of EDKII_NETWORK_RX_CHECKSUM_*
+                              flags.
+
+  @retval EFI_SUCCESS            ChecksumStatus was returned.
+  @retval EFI_INVALID_PARAMETER  RxData or ChecksumStatus is NULL.
+  @retval EFI_NOT_FOUND          RxData was not delivered by this instance.
+
+**/
+EFI_STATUS
+EFIAPI
+MnpGetRxChecksumStatus (
+  IN  EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL  *This,
+  IN  VOID                                     *RxData,
+  OUT UINT32                                   *ChecksumStatus
+  )
+{
+  MNP_INSTANCE_DATA  *Instance;
+  MNP_RXDATA_WRAP    *RxDataWrap;
+
+  if ((This == NULL) || (RxData == NULL) || (ChecksumStatus == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Instance   = MNP_INSTANCE_DATA_FROM_CHECKSUM_OFFLOAD (This);
+  RxDataWrap = BASE_CR (RxData, MNP_RXDATA_WRAP, RxData);
+  if (RxDataWrap->Instance != Instance) {
+    return EFI_NOT_FOUND;
+  }
+
+  *ChecksumStatus = RxDataWrap->ChecksumStatus;
+  return EFI_SUCCESS;
+}
@@ -476,7 +476,7 @@ Mtftp4ParseOption (
 
       Value = NetStringToU32 (This->ValueStr);
 
-      if (Value < 1) {
+      if ((Value < 1) || (Value > 65535)) {
         return EFI_INVALID_PARAMETER;
       }
 
@@ -220,9 +220,12 @@ Mtftp6ParseExtensionOption (
         return EFI_UNSUPPORTED;
       }
 
+      //
+      // windowsize option, valid value is between [1, 65535]
+      //
       Value = (UINT32)AsciiStrDecimalToUintn ((CHAR8 *)Opt->ValueStr);
 
-      if ((Value < 1)) {
+      if ((Value < 1) || (Value > 65535)) {
         return EFI_INVALID_PARAMETER;
       }
 
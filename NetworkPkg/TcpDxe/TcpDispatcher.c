@@ -118,7 +118,7 @@ Tcp4GetMode (
       Option->EnableTimeStamp     = (BOOLEAN)(!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_NO_TS));
       Option->EnableWindowScaling = (BOOLEAN)(!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_NO_WS));
 
-      Option->EnableSelectiveAck     = FALSE;
+      Option->EnableSelectiveAck     = (BOOLEAN)(!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_NO_SACK));
       Option->EnablePathMtuDiscovery = FALSE;
     }
   }
@@ -195,7 +195,7 @@ Tcp6GetMode (
       Option->EnableTimeStamp     = (BOOLEAN)(!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_NO_TS));
       Option->EnableWindowScaling = (BOOLEAN)(!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_NO_WS));
 
-      Option->EnableSelectiveAck     = FALSE;
+      Option->EnableSelectiveAck     = (BOOLEAN)(!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_NO_SACK));
       Option->EnablePathMtuDiscovery = FALSE;
     }
   }
@@ -610,7 +610,7 @@ TcpConfigurePcb (
       Sk,
       (UINT32)(TCP_COMP_VAL (
                  TCP_RCV_BUF_SIZE_MIN,
-                 TCP_RCV_BUF_SIZE,
+                 TCP_RCV_BUF_SIZE_MAX,
                  TCP_RCV_BUF_SIZE,
                  Option->ReceiveBufferSize
                  )
@@ -620,7 +620,7 @@ TcpConfigurePcb (
       Sk,
       (UINT32)(TCP_COMP_VAL (
                  TCP_SND_BUF_SIZE_MIN,
-                 TCP_SND_BUF_SIZE,
+                 TCP_SND_BUF_SIZE_MAX,
                  TCP_SND_BUF_SIZE,
                  Option->SendBufferSize
                  )
@@ -703,6 +703,10 @@ TcpConfigurePcb (
     if (!Option->EnableWindowScaling) {
       TCP_SET_FLG (Tcb->CtrlFlag, TCP_CTRL_NO_WS);
     }
+
+    if (!Option->EnableSelectiveAck) {
+      TCP_SET_FLG (Tcb->CtrlFlag, TCP_CTRL_NO_SACK);
+    }
   }
 
   //
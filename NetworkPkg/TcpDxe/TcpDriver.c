@@ -42,6 +42,14 @@ EFI_TCP6_PROTOCOL  gTcp6ProtocolTemplate = {
   Tcp6Poll
 };
 
+//
+// The buffer must fit in the largest window that can be advertised.
+//
+STATIC_ASSERT (
+  TCP_RCV_BUF_SIZE_MAX <= ((UINT32)TCP_OPTION_MAX_WIN << TCP_OPTION_MAX_WS),
+  "PcdTcpMaxBufferSize is beyond the reach of the window scale option"
+  );
+
 SOCK_INIT_DATA  mTcpDefaultSockData = {
   SockStream,
   SO_CLOSED,
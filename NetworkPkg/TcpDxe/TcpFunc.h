@@ -279,6 +279,84 @@ TcpInstallDevicePath (
   IN SOCKET  *Sock
   );
 
+/**
+  Update the SACK scoreboard on an acceptable ACK: forget the data
+  covered by the cumulative acknowledgement, and record the blocks
+  reported in the SACK option.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Ack      The acknowledge sequence number of the segment.
+  @param[in]       Option   Pointer to the options of the segment.
+
+**/
+VOID
+TcpSackUpdate (
+  IN OUT TCP_CB      *Tcb,
+  IN     TCP_SEQNO   Ack,
+  IN     TCP_OPTION  *Option
+  );
+
+/**
+  Find the first hole in the SACK scoreboard at or after Seq. Only the
+  holes below the highest selectively acknowledged data are reported,
+  the data above it may still be in flight.
+
+  @param[in]       Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in, out]  Seq      On input, where to start the search. On output,
+                            the start of the hole found.
+
+  @retval TRUE     A hole is found.
+  @retval FALSE    There is no hole after Seq.
+
+**/
+BOOLEAN
+TcpSackNextHole (
+  IN     TCP_CB     *Tcb,
+  IN OUT TCP_SEQNO  *Seq
+  );
+
+/**
+  Limit a retransmission from Seq so that it stops at the next data
+  the peer has selectively acknowledged.
+
+  @param[in]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Seq      The sequence number to retransmit from.
+  @param[in]  Len      The length the caller intends to retransmit.
+
+  @return The length to retransmit.
+
+**/
+UINT32
+TcpSackTrimLen (
+  IN TCP_CB     *Tcb,
+  IN TCP_SEQNO  Seq,
+  IN UINT32     Len
+  );
+
+/**
+  Cut the slow start threshold on a loss event, by the congestion
+  control algorithm selected with PcdTcpCongestionControl.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+
+**/
+VOID
+TcpCongestionReduce (
+  IN OUT TCP_CB  *Tcb
+  );
+
+/**
+  Open the congestion window by RFC8312 CUBIC, on an ACK of new data
+  received in congestion avoidance.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+
+**/
+VOID
+TcpCubicCongestionAvoid (
+  IN OUT TCP_CB  *Tcb
+  );
+
 //
 // Functions in TcpOutput.c
 //
@@ -473,12 +551,14 @@ TcpIcmpInput (
 /**
   Process the received TCP segments.
 
-  @param[in]  Nbuf     Buffer that contains received TCP segment without an IP header.
-  @param[in]  Src      Source address of the segment, or the peer's IP address.
-  @param[in]  Dst      Destination address of the segment, or the local end's IP
-                       address.
-  @param[in]  Version  IP_VERSION_4 indicates IP4 stack, IP_VERSION_6 indicates
-                       IP6 stack.
+  @param[in]  Nbuf            Buffer that contains received TCP segment without an IP header.
+  @param[in]  Src             Source address of the segment, or the peer's IP address.
+  @param[in]  Dst             Destination address of the segment, or the local end's IP
+                              address.
+  @param[in]  Version         IP_VERSION_4 indicates IP4 stack, IP_VERSION_6 indicates
+                              IP6 stack.
+  @param[in]  ChecksumStatus  EDKII_NETWORK_RX_CHECKSUM_* flags for the checksums
+                              the NIC has already verified.
 
   @retval 0        The segment processed successfully. It is either accepted or
                    discarded. But no connection is reset by the segment.
@@ -490,7 +570,8 @@ TcpInput (
   IN NET_BUF         *Nbuf,
   IN EFI_IP_ADDRESS  *Src,
   IN EFI_IP_ADDRESS  *Dst,
-  IN UINT8           Version
+  IN UINT8           Version,
+  IN UINT32          ChecksumStatus
   );
 
 //
@@ -42,8 +42,12 @@ TcpFastRecover (
   IN     TCP_SEG  *Seg
   )
 {
-  UINT32  FlightSize;
-  UINT32  Acked;
+  UINT32     FlightSize;
+  UINT32     Acked;
+  TCP_SEQNO  Hole;
+  BOOLEAN    Sack;
+
+  Sack = TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SACK);
 
   //
   // Step 1: Three duplicate ACKs and not in fast recovery
@@ -52,10 +56,8 @@ TcpFastRecover (
     //
     // Step 1A: Invoking fast retransmission.
     //
-    FlightSize = TCP_SUB_SEQ (Tcb->SndNxt, Tcb->SndUna);
-
-    Tcb->Ssthresh = MAX (FlightSize >> 1, (UINT32)(2 * Tcb->SndMss));
-    Tcb->Recover  = Tcb->SndNxt;
+    TcpCongestionReduce (Tcb);
+    Tcb->Recover = Tcb->SndNxt;
 
     Tcb->CongestState = TCP_CONGEST_RECOVER;
     TCP_CLEAR_FLG (Tcb->CtrlFlag, TCP_CTRL_RTT_ON);
@@ -63,6 +65,7 @@ TcpFastRecover (
     //
     // Step 2: Entering fast retransmission
     //
+    Tcb->SackRetxmitNxt = Tcb->SndUna;
     TcpRetransmit (Tcb, Tcb->SndUna);
     Tcb->CWnd = Tcb->Ssthresh + 3 * Tcb->SndMss;
 
@@ -87,7 +90,21 @@ TcpFastRecover (
     // Step 4 is skipped here only to be executed later
     // by TcpToSendData
     //
-    Tcb->CWnd += Tcb->SndMss;
+    // With SACK, the segment that left the network is
+    // replaced by the next hole below the highest SACKed
+    // data instead, in the spirit of RFC6675.
+    //
+    Hole = Tcb->SackRetxmitNxt;
+    if (TCP_SEQ_LT (Hole, Tcb->SndUna)) {
+      Hole = Tcb->SndUna;
+    }
+
+    if (Sack && TcpSackNextHole (Tcb, &Hole)) {
+      TcpRetransmit (Tcb, Hole);
+    } else {
+      Tcb->CWnd += Tcb->SndMss;
+    }
+
     DEBUG (
       (DEBUG_NET,
        "TcpFastRecover: received another duplicated ACK (%d) for TCB %p\n",
@@ -119,9 +136,19 @@ TcpFastRecover (
       //
       // Step 5 - Partial ACK:
       // fast retransmit the first unacknowledge field
-      // , then deflate the CWnd
+      // , then deflate the CWnd. With SACK, skip it if
+      // it is already retransmitted, and repair the next
+      // hole instead.
       //
-      TcpRetransmit (Tcb, Seg->Ack);
+      if (!Sack || TCP_SEQ_GEQ (Seg->Ack, Tcb->SackRetxmitNxt)) {
+        TcpRetransmit (Tcb, Seg->Ack);
+      } else {
+        Hole = Tcb->SackRetxmitNxt;
+        if (TcpSackNextHole (Tcb, &Hole)) {
+          TcpRetransmit (Tcb, Hole);
+        }
+      }
+
       Acked = TCP_SUB_SEQ (Seg->Ack, Tcb->SndUna);
 
       //
@@ -563,6 +590,11 @@ TcpQueueData (
   Seg  = TCPSEG_NETBUF (Nbuf);
   Head = &Tcb->RcvQue;
 
+  //
+  // Remember the latest segment, it leads the SACK option.
+  //
+  Tcb->RcvSackRecent = Seg->Seq;
+
   //
   // Fast path to process normal case. That is,
   // no out-of-order segments are received.
@@ -694,12 +726,14 @@ TcpAdjustSndQue (
 /**
   Process the received TCP segments.
 
-  @param[in]  Nbuf     Buffer that contains received a TCP segment without an IP header.
-  @param[in]  Src      Source address of the segment, or the peer's IP address.
-  @param[in]  Dst      Destination address of the segment, or the local end's IP
-                       address.
-  @param[in]  Version  IP_VERSION_4 indicates IP4 stack. IP_VERSION_6 indicates
-                       IP6 stack.
+  @param[in]  Nbuf            Buffer that contains received a TCP segment without an IP header.
+  @param[in]  Src             Source address of the segment, or the peer's IP address.
+  @param[in]  Dst             Destination address of the segment, or the local end's IP
+                              address.
+  @param[in]  Version         IP_VERSION_4 indicates IP4 stack. IP_VERSION_6 indicates
+                              IP6 stack.
+  @param[in]  ChecksumStatus  EDKII_NETWORK_RX_CHECKSUM_* flags for the checksums
+                              the NIC has already verified.
 
   @retval 0        Segment  processed successfully. It is either accepted or
                    discarded. However, no connection is reset by the segment.
@@ -711,7 +745,8 @@ TcpInput (
   IN NET_BUF         *Nbuf,
   IN EFI_IP_ADDRESS  *Src,
   IN EFI_IP_ADDRESS  *Dst,
-  IN UINT8           Version
+  IN UINT8           Version,
+  IN UINT32          ChecksumStatus
   )
 {
   TCP_CB      *Tcb;
@@ -749,17 +784,22 @@ TcpInput (
     goto DISCARD;
   }
 
-  if (Version == IP_VERSION_4) {
-    Checksum = NetPseudoHeadChecksum (Src->Addr[0], Dst->Addr[0], 6, 0);
-  } else {
-    Checksum = NetIp6PseudoHeadChecksum (&Src->v6, &Dst->v6, 6, 0);
-  }
+  //
+  // Skip the software checksum if the NIC has already verified it.
+  //
+  if ((ChecksumStatus & EDKII_NETWORK_RX_CHECKSUM_L4_VALID) == 0) {
+    if (Version == IP_VERSION_4) {
+      Checksum = NetPseudoHeadChecksum (Src->Addr[0], Dst->Addr[0], 6, 0);
+    } else {
+      Checksum = NetIp6PseudoHeadChecksum (&Src->v6, &Dst->v6, 6, 0);
+    }
 
-  Checksum = TcpChecksum (Nbuf, Checksum);
+    Checksum = TcpChecksum (Nbuf, Checksum);
 
-  if (Checksum != 0) {
-    DEBUG ((DEBUG_ERROR, "TcpInput: received a checksum error packet\n"));
-    goto DISCARD;
+    if (Checksum != 0) {
+      DEBUG ((DEBUG_ERROR, "TcpInput: received a checksum error packet\n"));
+      goto DISCARD;
+    }
   }
 
   if (TCP_FLG_ON (Head->Flag, TCP_FLG_SYN)) {
@@ -1213,6 +1253,13 @@ TcpInput (
     TcpSetTimer (Tcb, TCP_TIMER_REXMIT, Tcb->Rto);
   }
 
+  //
+  // Update the SACK scoreboard before it is used by the fast recovery.
+  //
+  if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SACK)) {
+    TcpSackUpdate (Tcb, Seg->Ack, &Option);
+  }
+
   //
   // Count duplicate acks.
   //
@@ -1235,6 +1282,8 @@ TcpInput (
     if (TCP_SEQ_GT (Seg->Ack, Tcb->SndUna)) {
       if (Tcb->CWnd < Tcb->Ssthresh) {
         Tcb->CWnd += Tcb->SndMss;
+      } else if (FixedPcdGet8 (PcdTcpCongestionControl) == TCP_CONGEST_CTRL_CUBIC) {
+        TcpCubicCongestionAvoid (Tcb);
       } else {
         Tcb->CWnd += MAX (Tcb->SndMss * Tcb->SndMss / Tcb->CWnd, 1);
       }
@@ -33,7 +33,13 @@ TcpRxCallback (
   )
 {
   if (EFI_SUCCESS == Status) {
-    TcpInput (Pkt, &NetSession->Source, &NetSession->Dest, NetSession->IpVersion);
+    TcpInput (
+      Pkt,
+      &NetSession->Source,
+      &NetSession->Dest,
+      NetSession->IpVersion,
+      NetSession->ChecksumStatus
+      );
   } else {
     TcpIcmpInput (
       Pkt,
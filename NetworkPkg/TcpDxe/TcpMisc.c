@@ -191,6 +191,9 @@ TcpInitTcbPeer (
 
   Tcb->CWnd = Tcb->SndMss;
 
+  Tcb->CubicWMax    = 0;
+  Tcb->CubicEpochOn = FALSE;
+
   Tcb->Irs    = Seg->Seq;
   Tcb->RcvNxt = Tcb->Irs + 1;
 
@@ -221,6 +224,14 @@ TcpInitTcbPeer (
     //
     Tcb->SndMss -= TCP_OPTION_TS_ALIGNED_LEN;
   }
+
+  if (TCP_FLG_ON (Opt->Flag, TCP_OPTION_RCVD_SACK_PERM) && !TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_NO_SACK)) {
+    TCP_SET_FLG (Tcb->CtrlFlag, TCP_CTRL_SACK);
+  } else {
+    TCP_CLEAR_FLG (Tcb->CtrlFlag, TCP_CTRL_SACK);
+  }
+
+  Tcb->SackNum = 0;
 }
 
 /**
@@ -1244,3 +1255,380 @@ TcpInstallDevicePath (
 
   return Status;
 }
+
+/**
+  Insert a block into the SACK scoreboard, merging it with the
+  blocks it overlaps or touches.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Start    The first sequence number of the block.
+  @param[in]       End      The sequence number following the block.
+
+**/
+VOID
+TcpSackInsert (
+  IN OUT TCP_CB     *Tcb,
+  IN     TCP_SEQNO  Start,
+  IN     TCP_SEQNO  End
+  )
+{
+  UINT8  Index;
+  UINT8  Last;
+
+  //
+  // Find the first block that doesn't end before Start.
+  //
+  for (Index = 0; Index < Tcb->SackNum; Index++) {
+    if (TCP_SEQ_GEQ (Tcb->SackBlock[Index].End, Start)) {
+      break;
+    }
+  }
+
+  //
+  // Absorb all the blocks overlapping with [Start, End).
+  //
+  for (Last = Index; Last < Tcb->SackNum; Last++) {
+    if (TCP_SEQ_GT (Tcb->SackBlock[Last].Start, End)) {
+      break;
+    }
+
+    if (TCP_SEQ_LT (Tcb->SackBlock[Last].Start, Start)) {
+      Start = Tcb->SackBlock[Last].Start;
+    }
+
+    if (TCP_SEQ_GT (Tcb->SackBlock[Last].End, End)) {
+      End = Tcb->SackBlock[Last].End;
+    }
+  }
+
+  if (Index == Last) {
+    //
+    // A new hole is described. When the scoreboard is full, the
+    // highest block is dropped: the retransmission only needs
+    // to know about the holes at the front.
+    //
+    if (Tcb->SackNum == TCP_SACK_MAX_BLOCK) {
+      if (Index == Tcb->SackNum) {
+        return;
+      }
+
+      Tcb->SackNum--;
+    }
+
+    CopyMem (
+      &Tcb->SackBlock[Index + 1],
+      &Tcb->SackBlock[Index],
+      (Tcb->SackNum - Index) * sizeof (TCP_SACK_BLOCK)
+      );
+    Tcb->SackNum++;
+  } else if (Last - Index > 1) {
+    CopyMem (
+      &Tcb->SackBlock[Index + 1],
+      &Tcb->SackBlock[Last],
+      (Tcb->SackNum - Last) * sizeof (TCP_SACK_BLOCK)
+      );
+    Tcb->SackNum = (UINT8)(Tcb->SackNum - (Last - Index - 1));
+  }
+
+  Tcb->SackBlock[Index].Start = Start;
+  Tcb->SackBlock[Index].End   = End;
+}
+
+/**
+  Update the SACK scoreboard on an acceptable ACK: forget the data
+  covered by the cumulative acknowledgement, and record the blocks
+  reported in the SACK option.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]       Ack      The acknowledge sequence number of the segment.
+  @param[in]       Option   Pointer to the options of the segment.
+
+**/
+VOID
+TcpSackUpdate (
+  IN OUT TCP_CB      *Tcb,
+  IN     TCP_SEQNO   Ack,
+  IN     TCP_OPTION  *Option
+  )
+{
+  TCP_SEQNO  Start;
+  TCP_SEQNO  End;
+  UINT8      Index;
+  UINT8      Cur;
+
+  Cur = 0;
+  for (Index = 0; Index < Tcb->SackNum; Index++) {
+    if (TCP_SEQ_LEQ (Tcb->SackBlock[Index].End, Ack)) {
+      continue;
+    }
+
+    Tcb->SackBlock[Cur].Start = Tcb->SackBlock[Index].Start;
+    Tcb->SackBlock[Cur].End   = Tcb->SackBlock[Index].End;
+
+    if (TCP_SEQ_LT (Tcb->SackBlock[Cur].Start, Ack)) {
+      Tcb->SackBlock[Cur].Start = Ack;
+    }
+
+    Cur++;
+  }
+
+  Tcb->SackNum = Cur;
+
+  if (!TCP_FLG_ON (Option->Flag, TCP_OPTION_RCVD_SACK)) {
+    return;
+  }
+
+  for (Index = 0; Index < Option->SackNum; Index++) {
+    Start = Option->SackBlock[Index].Start;
+    End   = Option->SackBlock[Index].End;
+
+    //
+    // Ignore the bogus blocks, and those not above the cumulative
+    // ACK such as the duplicate reports of RFC2883.
+    //
+    if (TCP_SEQ_GEQ (Start, End) || TCP_SEQ_LEQ (End, Ack) || TCP_SEQ_GT (End, Tcb->SndNxt)) {
+      continue;
+    }
+
+    if (TCP_SEQ_LT (Start, Ack)) {
+      Start = Ack;
+    }
+
+    TcpSackInsert (Tcb, Start, End);
+  }
+}
+
+/**
+  Find the first hole in the SACK scoreboard at or after Seq. Only the
+  holes below the highest selectively acknowledged data are reported,
+  the data above it may still be in flight.
+
+  @param[in]       Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in, out]  Seq      On input, where to start the search. On output,
+                            the start of the hole found.
+
+  @retval TRUE     A hole is found.
+  @retval FALSE    There is no hole after Seq.
+
+**/
+BOOLEAN
+TcpSackNextHole (
+  IN     TCP_CB     *Tcb,
+  IN OUT TCP_SEQNO  *Seq
+  )
+{
+  UINT8  Index;
+
+  for (Index = 0; Index < Tcb->SackNum; Index++) {
+    if (TCP_SEQ_LEQ (Tcb->SackBlock[Index].End, *Seq)) {
+      continue;
+    }
+
+    if (TCP_SEQ_LT (*Seq, Tcb->SackBlock[Index].Start)) {
+      return TRUE;
+    }
+
+    *Seq = Tcb->SackBlock[Index].End;
+  }
+
+  return FALSE;
+}
+
+/**
+  Limit a retransmission from Seq so that it stops at the next data
+  the peer has selectively acknowledged.
+
+  @param[in]  Tcb      Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Seq      The sequence number to retransmit from.
+  @param[in]  Len      The length the caller intends to retransmit.
+
+  @return The length to retransmit.
+
+**/
+UINT32
+TcpSackTrimLen (
+  IN TCP_CB     *Tcb,
+  IN TCP_SEQNO  Seq,
+  IN UINT32     Len
+  )
+{
+  UINT8  Index;
+
+  for (Index = 0; Index < Tcb->SackNum; Index++) {
+    if (TCP_SEQ_LT (Seq, Tcb->SackBlock[Index].Start)) {
+      return MIN (Len, TCP_SUB_SEQ (Tcb->SackBlock[Index].Start, Seq));
+    }
+  }
+
+  return Len;
+}
+
+/**
+  Compute the integer cube root of a 64-bit value.
+
+  @param[in]  Value    The value to compute the cube root of.
+
+  @return The largest integer whose cube does not exceed Value.
+
+**/
+UINT32
+TcpCubeRoot (
+  IN UINT64  Value
+  )
+{
+  UINT64  Root;
+  UINT64  Trial;
+  INTN    Shift;
+
+  Root = 0;
+
+  for (Shift = 63; Shift >= 0; Shift -= 3) {
+    Root  = LShiftU64 (Root, 1);
+    Trial = MultU64x64 (MultU64x32 (Root, 3), Root + 1) + 1;
+
+    if (RShiftU64 (Value, (UINTN)Shift) >= Trial) {
+      Value -= LShiftU64 (Trial, (UINTN)Shift);
+      Root++;
+    }
+  }
+
+  return (UINT32)Root;
+}
+
+/**
+  Cut the slow start threshold on a loss event, by the congestion
+  control algorithm selected with PcdTcpCongestionControl.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+
+**/
+VOID
+TcpCongestionReduce (
+  IN OUT TCP_CB  *Tcb
+  )
+{
+  UINT32  FlightSize;
+
+  //
+  // FlightSize is the amount of data that has
+  // been sent but not yet ACKed.
+  //
+  FlightSize = TCP_SUB_SEQ (Tcb->SndNxt, Tcb->SndUna);
+
+  if (FixedPcdGet8 (PcdTcpCongestionControl) != TCP_CONGEST_CTRL_CUBIC) {
+    Tcb->Ssthresh = MAX (FlightSize >> 1, (UINT32)(2 * Tcb->SndMss));
+    return;
+  }
+
+  //
+  // CUBIC remembers where the window was cut at the first loss of
+  // an event. If the window didn't even grow back to the previous
+  // WMax, other flows are competing, so release more bandwidth by
+  // the fast convergence of RFC8312 section 4.6: WMax * (1 + 0.7) / 2.
+  //
+  if (Tcb->CongestState == TCP_CONGEST_OPEN) {
+    if (Tcb->CWnd < Tcb->CubicWMax) {
+      Tcb->CubicWMax = (UINT32)DivU64x32 (MultU64x32 (Tcb->CWnd, 17), 20);
+    } else {
+      Tcb->CubicWMax = Tcb->CWnd;
+    }
+  }
+
+  Tcb->CubicEpochOn = FALSE;
+
+  //
+  // The multiplicative decrease factor of CUBIC is 0.7.
+  //
+  Tcb->Ssthresh = MAX ((UINT32)DivU64x32 (MultU64x32 (FlightSize, 7), 10), (UINT32)(2 * Tcb->SndMss));
+}
+
+/**
+  Open the congestion window by RFC8312 CUBIC, on an ACK of new data
+  received in congestion avoidance. The time is counted in TCP ticks,
+  so with the scaling constant C = 0.4 and the window in bytes:
+  W(t) = (t - K)^3 * 2 * SndMss / 625 + Origin.
+
+  @param[in, out]  Tcb      Pointer to the TCP_CB of this TCP instance.
+
+**/
+VOID
+TcpCubicCongestionAvoid (
+  IN OUT TCP_CB  *Tcb
+  )
+{
+  UINT32  Elapsed;
+  UINT32  Delta;
+  UINT64  Offset;
+  UINT64  Target;
+  UINT32  MssSquare;
+
+  MssSquare = (UINT32)Tcb->SndMss * Tcb->SndMss;
+
+  //
+  // Start a new epoch on the first ACK after a window cut.
+  //
+  if (!Tcb->CubicEpochOn) {
+    Tcb->CubicEpochOn = TRUE;
+    Tcb->CubicEpoch   = mTcpTick;
+    Tcb->CubicWEst    = Tcb->CWnd;
+
+    if (Tcb->CWnd < Tcb->CubicWMax) {
+      Tcb->CubicK = TcpCubeRoot (
+                      DivU64x32 (
+                        MultU64x32 (Tcb->CubicWMax - Tcb->CWnd, 625),
+                        2 * (UINT32)Tcb->SndMss
+                        )
+                      );
+      Tcb->CubicOrigin = Tcb->CubicWMax;
+    } else {
+      Tcb->CubicK      = 0;
+      Tcb->CubicOrigin = Tcb->CWnd;
+    }
+  }
+
+  //
+  // Aim at the window of one RTT later: W(t + RTT).
+  //
+  Elapsed = TCP_SUB_TIME (mTcpTick, Tcb->CubicEpoch) + (Tcb->SRtt >> TCP_RTT_SHIFT);
+
+  if (Elapsed >= Tcb->CubicK) {
+    Delta = Elapsed - Tcb->CubicK;
+  } else {
+    Delta = Tcb->CubicK - Elapsed;
+  }
+
+  Delta  = MIN (Delta, TCP_CUBIC_MAX_DELTA);
+  Offset = DivU64x32 (
+             MultU64x32 (MultU64x32 (MultU64x32 (Delta, Delta), Delta), 2 * (UINT32)Tcb->SndMss),
+             625
+             );
+
+  if (Elapsed >= Tcb->CubicK) {
+    Target = Tcb->CubicOrigin + Offset;
+  } else if (Offset < Tcb->CubicOrigin) {
+    Target = Tcb->CubicOrigin - Offset;
+  } else {
+    Target = 0;
+  }
+
+  //
+  // Don't fall behind the window standard TCP would have in the same
+  // time, which grows by 3 * (1 - 0.7) / (1 + 0.7) = 9/17 SndMss per RTT.
+  //
+  Tcb->CubicWEst += (UINT32)DivU64x32 (MultU64x32 (MssSquare, 9), Tcb->CWnd) / 17;
+  if (Target < Tcb->CubicWEst) {
+    Target = Tcb->CubicWEst;
+  }
+
+  //
+  // Grow by (Target - CWnd) / CWnd segments per ACK, and at most to
+  // 1.5 * CWnd in an RTT. Probe slowly while above the target.
+  //
+  Target = MIN (Target, (UINT64)Tcb->CWnd + (Tcb->CWnd >> 1));
+
+  if (Target > Tcb->CWnd) {
+    Tcb->CWnd += MAX ((UINT32)DivU64x32 (MultU64x32 (Target - Tcb->CWnd, Tcb->SndMss), Tcb->CWnd), 1);
+  } else {
+    Tcb->CWnd += MAX (MssSquare / Tcb->CWnd / 100, 1);
+  }
+}
@@ -160,6 +160,28 @@ TcpSynBuildOption (
     TcpPutUint32 (Data, TCP_OPTION_WS_FAST | TcpComputeScale (Tcb));
   }
 
+  //
+  // Build SACK permitted option, only when configured
+  // to use SACK, and either we are doing active open
+  // or the peer has offered SACK in its SYN.
+  //
+  if (!TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_NO_SACK) &&
+      (!TCP_FLG_ON (TCPSEG_NETBUF (Nbuf)->Flag, TCP_FLG_ACK) ||
+       TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SACK))
+      )
+  {
+    Data = NetbufAllocSpace (
+             Nbuf,
+             TCP_OPTION_SACK_PERM_ALIGNED_LEN,
+             NET_BUF_HEAD
+             );
+
+    ASSERT (Data != NULL);
+
+    Len += TCP_OPTION_SACK_PERM_ALIGNED_LEN;
+    TcpPutUint32 (Data, TCP_OPTION_SACK_PERM_FAST);
+  }
+
   //
   // Build the MSS option.
   //
@@ -172,6 +194,109 @@ TcpSynBuildOption (
   return Len;
 }
 
+/**
+  Build the SACK option from the out-of-order data held in the
+  reassemble queue. The block holding the most recently received
+  segment is reported first, as required by RFC2018 section 4.
+
+  @param[in]  Tcb     Pointer to the TCP_CB of this TCP instance.
+  @param[in]  Nbuf    Pointer to the buffer to store the option.
+  @param[in]  Room    The option space left in the segment, in bytes.
+
+  @return             The length of the SACK option, 0 if none is built.
+
+**/
+UINT16
+TcpSackBuildOption (
+  IN TCP_CB   *Tcb,
+  IN NET_BUF  *Nbuf,
+  IN UINT16   Room
+  )
+{
+  TCP_SACK_BLOCK  Block[TCP_OPTION_MAX_SACK_BLOCK];
+  LIST_ENTRY      *Entry;
+  TCP_SEG         *Seg;
+  TCP_SEQNO       Start;
+  TCP_SEQNO       End;
+  UINT8           *Data;
+  UINT8           Max;
+  UINT8           Num;
+  UINT8           Index;
+  BOOLEAN         Found;
+
+  if (Room < TCP_OPTION_SACK_ALIGNED_LEN (1)) {
+    return 0;
+  }
+
+  Max = (UINT8)MIN ((Room - TCP_OPTION_SACK_ALIGNED_LEN (0)) / 8, TCP_OPTION_MAX_SACK_BLOCK);
+
+  //
+  // Slot 0 is reserved for the block holding RcvSackRecent,
+  // the others are filled in the order of sequence number.
+  //
+  Num   = 1;
+  Found = FALSE;
+  Entry = Tcb->RcvQue.ForwardLink;
+
+  while (Entry != &Tcb->RcvQue) {
+    Seg   = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List));
+    Start = Seg->Seq;
+    End   = Seg->End;
+
+    //
+    // Coalesce the adjacent segments into one block.
+    //
+    for (Entry = Entry->ForwardLink; Entry != &Tcb->RcvQue; Entry = Entry->ForwardLink) {
+      Seg = TCPSEG_NETBUF (NET_LIST_USER_STRUCT (Entry, NET_BUF, List));
+      if (Seg->Seq != End) {
+        break;
+      }
+
+      End = Seg->End;
+    }
+
+    if (TCP_SEQ_LEQ (End, Tcb->RcvNxt)) {
+      continue;
+    }
+
+    if (!Found && TCP_SEQ_LEQ (Start, Tcb->RcvSackRecent) && TCP_SEQ_LT (Tcb->RcvSackRecent, End)) {
+      Block[0].Start = Start;
+      Block[0].End   = End;
+      Found          = TRUE;
+    } else if (Num < Max) {
+      Block[Num].Start = Start;
+      Block[Num].End   = End;
+      Num++;
+    }
+  }
+
+  if (!Found) {
+    Num--;
+    CopyMem (&Block[0], &Block[1], Num * sizeof (TCP_SACK_BLOCK));
+  }
+
+  if (Num == 0) {
+    return 0;
+  }
+
+  Data = NetbufAllocSpace (
+           Nbuf,
+           TCP_OPTION_SACK_ALIGNED_LEN (Num),
+           NET_BUF_HEAD
+           );
+
+  ASSERT (Data != NULL);
+
+  TcpPutUint32 (Data, TCP_OPTION_SACK_FAST | TCP_OPTION_SACK_LEN (Num));
+
+  for (Index = 0; Index < Num; Index++) {
+    TcpPutUint32 (Data + 4 + 8 * Index, Block[Index].Start);
+    TcpPutUint32 (Data + 8 + 8 * Index, Block[Index].End);
+  }
+
+  return TCP_OPTION_SACK_ALIGNED_LEN (Num);
+}
+
 /**
   Build the TCP option in synchronized states.
 
@@ -214,6 +339,20 @@ TcpBuildOption (
     TcpPutUint32 (Data + 8, Tcb->TsRecent);
   }
 
+  //
+  // Build the SACK option if out-of-order data is queued. It
+  // is only carried by pure ACKs, so that it never pushes a
+  // data segment beyond the MSS.
+  //
+  if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SACK) &&
+      !TCP_FLG_ON (TCPSEG_NETBUF (Nbuf)->Flag, TCP_FLG_RST) &&
+      (Nbuf->TotalSize == 0) &&
+      !IsListEmpty (&Tcb->RcvQue)
+      )
+  {
+    Len = (UINT16)(Len + TcpSackBuildOption (Tcb, Nbuf, (UINT16)(TCP_OPTION_MAX_LEN - Len)));
+  }
+
   return Len;
 }
 
@@ -239,6 +378,7 @@ TcpParseOption (
   UINT8  Cur;
   UINT8  Type;
   UINT8  Len;
+  UINT8  Index;
 
   ASSERT ((Tcp != NULL) && (Option != NULL));
 
@@ -311,6 +451,38 @@ TcpParseOption (
         Cur += TCP_OPTION_TS_LEN;
         break;
 
+      case TCP_OPTION_SACK_PERM:
+        Len = Head[Cur + 1];
+
+        if ((Len != TCP_OPTION_SACK_PERM_LEN) || (TotalLen - Cur < TCP_OPTION_SACK_PERM_LEN)) {
+          return -1;
+        }
+
+        TCP_SET_FLG (Option->Flag, TCP_OPTION_RCVD_SACK_PERM);
+
+        Cur += TCP_OPTION_SACK_PERM_LEN;
+        break;
+
+      case TCP_OPTION_SACK:
+        Len = Head[Cur + 1];
+
+        if ((Len < TCP_OPTION_SACK_LEN (1)) || (Len > TCP_OPTION_SACK_LEN (TCP_OPTION_MAX_SACK_BLOCK)) ||
+            (((Len - TCP_OPTION_SACK_LEN (0)) % 8) != 0) || (TotalLen - Cur < Len))
+        {
+          return -1;
+        }
+
+        Option->SackNum = (UINT8)((Len - TCP_OPTION_SACK_LEN (0)) / 8);
+        for (Index = 0; Index < Option->SackNum; Index++) {
+          Option->SackBlock[Index].Start = TcpGetUint32 (&Head[Cur + 2 + 8 * Index]);
+          Option->SackBlock[Index].End   = TcpGetUint32 (&Head[Cur + 6 + 8 * Index]);
+        }
+
+        TCP_SET_FLG (Option->Flag, TCP_OPTION_RCVD_SACK);
+
+        Cur = (UINT8)(Cur + Len);
+        break;
+
       case TCP_OPTION_NOP:
         Cur++;
         break;
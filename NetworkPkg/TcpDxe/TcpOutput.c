@@ -296,7 +296,7 @@ TcpTransmitSegment (
     Len = TcpBuildOption (Tcb, Nbuf);
   }
 
-  ASSERT ((Len % 4 == 0) && (Len <= 40));
+  ASSERT ((Len % 4 == 0) && (Len <= TCP_OPTION_MAX_LEN));
 
   Len += sizeof (TCP_HEAD);
 
@@ -675,6 +675,13 @@ TcpRetransmit (
 
   Len = MIN (Len, Tcb->SndMss);
 
+  //
+  // Don't resend the data the peer has selectively ACKed.
+  //
+  if (TCP_FLG_ON (Tcb->CtrlFlag, TCP_CTRL_SACK)) {
+    Len = TcpSackTrimLen (Tcb, Seq, Len);
+  }
+
   Nbuf = TcpGetSegmentSndQue (Tcb, Seq, Len);
   if (Nbuf == NULL) {
     return -1;
@@ -692,6 +699,10 @@ TcpRetransmit (
     Tcb->RetxmitSeqMax = Seq;
   }
 
+  if (TCP_SEQ_GT (TCPSEG_NETBUF (Nbuf)->End, Tcb->SackRetxmitNxt)) {
+    Tcb->SackRetxmitNxt = TCPSEG_NETBUF (Nbuf)->End;
+  }
+
   //
   // The retransmitted buffer may be on the SndQue,
   // trim TCP head because all the buffers on SndQue
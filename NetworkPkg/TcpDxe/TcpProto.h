@@ -52,6 +52,13 @@
 #define TCP_CONGEST_LOSS     2      ///< Retxmit because of retxmit time out.
 #define TCP_CONGEST_OPEN     3      ///< TCP is opening its congestion window.
 
+//
+// Congestion avoidance algorithms selected by PcdTcpCongestionControl.
+//
+#define TCP_CONGEST_CTRL_NEWRENO  0   ///< RFC5681 additive increase.
+#define TCP_CONGEST_CTRL_CUBIC    1   ///< RFC8312 CUBIC.
+#define TCP_CUBIC_MAX_DELTA       0x3FFF  ///< Cap of |t - K| in ticks, keeps W(t) in 64 bits.
+
 //
 // TCP control flags
 //
@@ -70,6 +77,8 @@
 #define TCP_CTRL_TIMER_ON      0x1000   ///< At least one of the timer is on.
 #define TCP_CTRL_RTT_ON        0x2000   ///< The RTT measurement is on.
 #define TCP_CTRL_ACK_NOW       0x4000   ///< Send the ACK now, don't delay.
+#define TCP_CTRL_NO_SACK       0x8000   ///< Disable selective acknowledgement.
+#define TCP_CTRL_SACK          0x10000  ///< Both ends agreed on SACK in syn.
 
 //
 // Timer related values
@@ -109,10 +118,12 @@
 //
 // Value ranges for some control option
 //
-#define TCP_RCV_BUF_SIZE          (2 * 1024 * 1024)
+#define TCP_RCV_BUF_SIZE          FixedPcdGet32 (PcdTcpReceiveBufferSize)
 #define TCP_RCV_BUF_SIZE_MIN      (8 * 1024)
-#define TCP_SND_BUF_SIZE          (2 * 1024 * 1024)
+#define TCP_RCV_BUF_SIZE_MAX      FixedPcdGet32 (PcdTcpMaxBufferSize)
+#define TCP_SND_BUF_SIZE          FixedPcdGet32 (PcdTcpSendBufferSize)
 #define TCP_SND_BUF_SIZE_MIN      (8 * 1024)
+#define TCP_SND_BUF_SIZE_MAX      FixedPcdGet32 (PcdTcpMaxBufferSize)
 #define TCP_BACKLOG               10
 #define TCP_BACKLOG_MIN           5
 #define TCP_MAX_LOSS_MIN          6
@@ -204,6 +215,11 @@
 
 #define TCP_MAX_WIN  0xFFFFU
 
+//
+// The number of peer-reported SACK blocks remembered by the sender.
+//
+#define TCP_SACK_MAX_BLOCK  8
+
 ///
 /// TCP segmentation data.
 ///
@@ -216,6 +232,15 @@ typedef struct _TCP_SEG {
   UINT32       Wnd;  ///< TCP window size field.
 } TCP_SEG;
 
+///
+/// A block of sequence space held by the peer, as reported by
+/// the SACK option. Start is inclusive and End is exclusive.
+///
+typedef struct _TCP_SACK_BLOCK {
+  TCP_SEQNO    Start; ///< The first sequence number of the block.
+  TCP_SEQNO    End;   ///< The sequence number following the block.
+} TCP_SACK_BLOCK;
+
 ///
 /// Network endpoint, IP plus Port structure.
 ///
@@ -312,6 +337,25 @@ struct _TCP_CONTROL_BLOCK {
   //
   TCP_SEQNO           RetxmitSeqMax;     ///< Max Seq number in previous retransmission.
 
+  //
+  // RFC2018 selective acknowledgement. The scoreboard is
+  // kept sorted by sequence number and never overlaps.
+  //
+  TCP_SACK_BLOCK      SackBlock[TCP_SACK_MAX_BLOCK]; ///< Data the peer has selectively ACKed.
+  UINT8               SackNum;                       ///< Number of valid blocks in SackBlock.
+  TCP_SEQNO           SackRetxmitNxt;                ///< Next byte to retransmit in SACK recovery.
+  TCP_SEQNO           RcvSackRecent;                 ///< Seq of the latest queued segment.
+
+  //
+  // RFC8312 CUBIC congestion avoidance, times are in ticks.
+  //
+  UINT32              CubicWMax;    ///< CWnd just before the last window reduction.
+  UINT32              CubicOrigin;  ///< Origin point of the cubic function.
+  UINT32              CubicK;       ///< Time for the cubic function to reach CubicOrigin.
+  UINT32              CubicEpoch;   ///< When the current avoidance epoch started.
+  UINT32              CubicWEst;    ///< Estimated Reno window, for the TCP-friendly region.
+  BOOLEAN             CubicEpochOn; ///< If TRUE, an avoidance epoch is in progress.
+
   //
   // configuration parameters, for EFI_TCP4_PROTOCOL specification
   //
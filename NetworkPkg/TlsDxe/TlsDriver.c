@@ -30,6 +30,10 @@ TlsCleanInstance (
       TlsFree (Instance->TlsConn);
     }
 
+    if (Instance->HostName != NULL) {
+      FreePool (Instance->HostName);
+    }
+
     FreePool (Instance);
   }
 }
@@ -86,6 +90,8 @@ TlsCleanService (
   )
 {
   if (Service != NULL) {
+    TlsFreeSessionCache (Service);
+
     if (Service->TlsCtx != NULL) {
       TlsCtxFree (Service->TlsCtx);
     }
@@ -132,6 +138,8 @@ TlsCreateService (
   TlsService->TlsChildrenNum = 0;
   InitializeListHead (&TlsService->TlsChildrenList);
   TlsService->ImageHandle = Image;
+  InitializeListHead (&TlsService->SessionCache);
+  TlsService->SessionCacheCount = 0;
 
   *Service = TlsService;
 
@@ -483,6 +491,12 @@ TlsServiceBindingDestroyChild (
   RemoveEntryList (&TlsInstance->Link);
   TlsService->TlsChildrenNum--;
 
+  //
+  // Keep the session, including any ticket received from the server, so that the
+  // next connection to the same host can resume it.
+  //
+  TlsSaveSession (TlsInstance);
+
   gBS->RestoreTPL (OldTpl);
 
   TlsCleanInstance (TlsInstance);
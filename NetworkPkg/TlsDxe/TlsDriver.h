@@ -26,6 +26,13 @@
 
 #define TLS_INSTANCE_SIGNATURE  SIGNATURE_32 ('T', 'L', 'S', 'I')
 
+#define TLS_SESSION_CACHE_SIGNATURE  SIGNATURE_32 ('T', 'L', 'S', 'C')
+
+//
+// Maximum number of resumable sessions kept by one TLS service.
+//
+#define TLS_SESSION_CACHE_MAX  8
+
 ///
 /// TLS Service Data
 ///
@@ -55,8 +62,26 @@ struct _TLS_SERVICE {
   // created for the connections.
   //
   VOID                            *TlsCtx;
+
+  //
+  // Resumable sessions of earlier connections, at most one per verified host name,
+  // in least recently stored order.
+  //
+  LIST_ENTRY                      SessionCache;
+  UINTN                           SessionCacheCount;
 };
 
+///
+/// Resumable TLS session of the host verified with HostName and VerifyFlags.
+///
+typedef struct {
+  UINT32        Signature;
+  LIST_ENTRY    Link;
+  CHAR8         *HostName;
+  UINT32        VerifyFlags;
+  VOID          *Session;
+} TLS_SESSION_CACHE_ENTRY;
+
 struct _TLS_INSTANCE {
   UINT32                            Signature;
   LIST_ENTRY                        Link;
@@ -76,6 +101,12 @@ struct _TLS_INSTANCE {
   // per established connection.
   //
   VOID                              *TlsConn;
+
+  //
+  // Peer identity set through EfiTlsVerifyHost, used to resume and store sessions.
+  //
+  CHAR8                             *HostName;
+  UINT32                            VerifyFlags;
 };
 
 #define TLS_SERVICE_FROM_THIS(a)   \
@@ -87,6 +118,9 @@ struct _TLS_INSTANCE {
 #define TLS_INSTANCE_FROM_CONFIGURATION(a)  \
   CR (a, TLS_INSTANCE, TlsConfig, TLS_INSTANCE_SIGNATURE)
 
+#define TLS_SESSION_CACHE_ENTRY_FROM_LINK(a)  \
+  CR (a, TLS_SESSION_CACHE_ENTRY, Link, TLS_SESSION_CACHE_SIGNATURE)
+
 /**
   Release all the resources used by the TLS instance.
 
@@ -348,3 +348,161 @@ ERROR:
 
   return Status;
 }
+
+/**
+  Find the session cache entry for a host name and verify flags.
+
+  @param[in]  Service        The TLS service data.
+  @param[in]  HostName       The verified host name.
+  @param[in]  VerifyFlags    The host name verification flags.
+
+  @return  Pointer to the entry, or NULL if no session is stored for the host.
+
+**/
+TLS_SESSION_CACHE_ENTRY *
+TlsFindSessionCacheEntry (
+  IN     TLS_SERVICE  *Service,
+  IN     CHAR8        *HostName,
+  IN     UINT32       VerifyFlags
+  )
+{
+  LIST_ENTRY               *Entry;
+  TLS_SESSION_CACHE_ENTRY  *CacheEntry;
+
+  NET_LIST_FOR_EACH (Entry, &Service->SessionCache) {
+    CacheEntry = TLS_SESSION_CACHE_ENTRY_FROM_LINK (Entry);
+    if ((CacheEntry->VerifyFlags == VerifyFlags) && (AsciiStrCmp (CacheEntry->HostName, HostName) == 0)) {
+      return CacheEntry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Remove a session cache entry and release its resources.
+
+  @param[in]  Service        The TLS service data.
+  @param[in]  CacheEntry     The entry to remove.
+
+**/
+VOID
+TlsRemoveSessionCacheEntry (
+  IN     TLS_SERVICE              *Service,
+  IN     TLS_SESSION_CACHE_ENTRY  *CacheEntry
+  )
+{
+  RemoveEntryList (&CacheEntry->Link);
+  Service->SessionCacheCount--;
+
+  TlsFreeSession (CacheEntry->Session);
+  FreePool (CacheEntry->HostName);
+  FreePool (CacheEntry);
+}
+
+/**
+  Offer the session stored for the verified host of the TLS instance to the server.
+
+  Nothing is done if the instance is not a client, has no verified host name, or
+  no session is stored for it.
+
+  @param[in]  TlsInstance    The pointer to the TLS instance.
+
+**/
+VOID
+TlsResumeSession (
+  IN     TLS_INSTANCE  *TlsInstance
+  )
+{
+  TLS_SESSION_CACHE_ENTRY  *CacheEntry;
+
+  if ((TlsInstance->HostName == NULL) || (TlsGetConnectionEnd (TlsInstance->TlsConn) != EfiTlsClient)) {
+    return;
+  }
+
+  CacheEntry = TlsFindSessionCacheEntry (TlsInstance->Service, TlsInstance->HostName, TlsInstance->VerifyFlags);
+  if (CacheEntry == NULL) {
+    return;
+  }
+
+  if (EFI_ERROR (TlsSetSession (TlsInstance->TlsConn, CacheEntry->Session))) {
+    //
+    // The stored session no longer suits this connection, a full handshake is done.
+    //
+    TlsRemoveSessionCacheEntry (TlsInstance->Service, CacheEntry);
+  }
+}
+
+/**
+  Store the session of the TLS instance in its TLS service for later resumption.
+
+  The session replaces any session stored for the same host name and verify flags.
+  Nothing is done if the instance is not a client, has no verified host name, or
+  has no resumable session.
+
+  @param[in]  TlsInstance    The pointer to the TLS instance.
+
+**/
+VOID
+TlsSaveSession (
+  IN     TLS_INSTANCE  *TlsInstance
+  )
+{
+  TLS_SERVICE              *Service;
+  TLS_SESSION_CACHE_ENTRY  *CacheEntry;
+  VOID                     *Session;
+
+  if ((TlsInstance->HostName == NULL) || (TlsInstance->TlsSessionState == EfiTlsSessionError) ||
+      (TlsGetConnectionEnd (TlsInstance->TlsConn) != EfiTlsClient))
+  {
+    return;
+  }
+
+  Session = TlsGetSession (TlsInstance->TlsConn);
+  if (Session == NULL) {
+    return;
+  }
+
+  Service    = TlsInstance->Service;
+  CacheEntry = TlsFindSessionCacheEntry (Service, TlsInstance->HostName, TlsInstance->VerifyFlags);
+  if (CacheEntry != NULL) {
+    TlsRemoveSessionCacheEntry (Service, CacheEntry);
+  } else if (Service->SessionCacheCount == TLS_SESSION_CACHE_MAX) {
+    TlsRemoveSessionCacheEntry (Service, TLS_SESSION_CACHE_ENTRY_FROM_LINK (GetFirstNode (&Service->SessionCache)));
+  }
+
+  CacheEntry = AllocateZeroPool (sizeof (TLS_SESSION_CACHE_ENTRY));
+  if (CacheEntry == NULL) {
+    TlsFreeSession (Session);
+    return;
+  }
+
+  CacheEntry->HostName = AllocateCopyPool (AsciiStrSize (TlsInstance->HostName), TlsInstance->HostName);
+  if (CacheEntry->HostName == NULL) {
+    FreePool (CacheEntry);
+    TlsFreeSession (Session);
+    return;
+  }
+
+  CacheEntry->Signature   = TLS_SESSION_CACHE_SIGNATURE;
+  CacheEntry->VerifyFlags = TlsInstance->VerifyFlags;
+  CacheEntry->Session     = Session;
+  InsertTailList (&Service->SessionCache, &CacheEntry->Link);
+  Service->SessionCacheCount++;
+}
+
+/**
+  Release all sessions stored in the TLS service.
+
+  @param[in]  Service        The TLS service data.
+
+**/
+VOID
+TlsFreeSessionCache (
+  IN     TLS_SERVICE  *Service
+  )
+{
+  while (!IsListEmpty (&Service->SessionCache)) {
+    TlsRemoveSessionCacheEntry (Service, TLS_SESSION_CACHE_ENTRY_FROM_LINK (GetFirstNode (&Service->SessionCache)));
+  }
+}
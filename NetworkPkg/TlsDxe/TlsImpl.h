@@ -86,6 +86,46 @@ TlsDecryptPacket (
   IN     UINT32                 *FragmentCount
   );
 
+/**
+  Offer the session stored for the verified host of the TLS instance to the server.
+
+  Nothing is done if the instance is not a client, has no verified host name, or
+  no session is stored for it.
+
+  @param[in]  TlsInstance    The pointer to the TLS instance.
+
+**/
+VOID
+TlsResumeSession (
+  IN     TLS_INSTANCE  *TlsInstance
+  );
+
+/**
+  Store the session of the TLS instance in its TLS service for later resumption.
+
+  The session replaces any session stored for the same host name and verify flags.
+  Nothing is done if the instance is not a client, has no verified host name, or
+  has no resumable session.
+
+  @param[in]  TlsInstance    The pointer to the TLS instance.
+
+**/
+VOID
+TlsSaveSession (
+  IN     TLS_INSTANCE  *TlsInstance
+  );
+
+/**
+  Release all sessions stored in the TLS service.
+
+  @param[in]  Service        The TLS service data.
+
+**/
+VOID
+TlsFreeSessionCache (
+  IN     TLS_SERVICE  *Service
+  );
+
 /**
   Set TLS session data.
 
@@ -187,7 +187,24 @@ TlsSetSessionData (
       }
 
       Status = TlsSetVerifyHost (Instance->TlsConn, TlsVerifyHost->Flags, TlsVerifyHost->HostName);
+      if (EFI_ERROR (Status)) {
+        goto ON_EXIT;
+      }
+
+      //
+      // Remember the verified host, sessions are only resumed with the same identity.
+      //
+      if (Instance->HostName != NULL) {
+        FreePool (Instance->HostName);
+      }
 
+      Instance->HostName = AllocateCopyPool (AsciiStrSize (TlsVerifyHost->HostName), TlsVerifyHost->HostName);
+      if (Instance->HostName == NULL) {
+        Status = EFI_OUT_OF_RESOURCES;
+        goto ON_EXIT;
+      }
+
+      Instance->VerifyFlags = TlsVerifyHost->Flags;
       break;
     case EfiTlsSessionID:
       if (DataSize != sizeof (EFI_TLS_SESSION_ID)) {
@@ -485,8 +502,10 @@ TlsBuildResponsePacket (
     switch (Instance->TlsSessionState) {
       case EfiTlsSessionNotStarted:
         //
-        // ClientHello.
+        // Offer a session stored for the same host, then ClientHello.
         //
+        TlsResumeSession (Instance);
+
         Status = TlsDoHandshake (
                    Instance->TlsConn,
                    NULL,
@@ -513,6 +532,8 @@ TlsBuildResponsePacket (
         //
         // TLS session will be closed and response packet needs to be CloseNotify.
         //
+        TlsSaveSession (Instance);
+
         Status = TlsCloseNotify (
                    Instance->TlsConn,
                    Buffer,
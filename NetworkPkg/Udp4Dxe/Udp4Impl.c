@@ -1601,9 +1601,11 @@ Udp4Demultiplex (
   Udp4Header = (EFI_UDP_HEADER *)NetbufGetByte (Packet, 0, NULL);
   ASSERT (Udp4Header != NULL);
 
-  if (Udp4Header->Checksum != 0) {
+  if ((Udp4Header->Checksum != 0) &&
+      ((NetSession->ChecksumStatus & EDKII_NETWORK_RX_CHECKSUM_L4_VALID) == 0))
+  {
     //
-    // check the checksum.
+    // check the checksum, unless the NIC has already verified it.
     //
     HeadSum = NetPseudoHeadChecksum (
                 NetSession->Source.Addr[0],
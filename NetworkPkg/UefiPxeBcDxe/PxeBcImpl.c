@@ -852,6 +852,7 @@ EfiPxeBcMtftp (
   EFI_STATUS                   Status;
   EFI_PXE_BASE_CODE_IP_FILTER  IpFilter;
   UINTN                        WindowSize;
+  UINT64                       RequestedSize;
 
   if ((This == NULL) ||
       (Filename == NULL) ||
@@ -881,6 +882,9 @@ EfiPxeBcMtftp (
   // Get PcdPxeTftpWindowSize.
   //
   WindowSize = (UINTN)PcdGet64 (PcdPxeTftpWindowSize);
+  if (Private->TftpWindowSizeFailed) {
+    WindowSize = 1;
+  }
 
   if (Mode->UsingIpv6) {
     if (!NetIp6IsValidUnicast (&ServerIp->v6)) {
@@ -925,87 +929,108 @@ EfiPxeBcMtftp (
     Private->Udp4Read->Configure (Private->Udp4Read, NULL);
   }
 
-  Mode->TftpErrorReceived = FALSE;
-  Mode->IcmpErrorReceived = FALSE;
+  RequestedSize = *BufferSize;
 
-  switch (Operation) {
-    case EFI_PXE_BASE_CODE_TFTP_GET_FILE_SIZE:
-      //
-      // Send TFTP request to get file size.
-      //
-      Status = PxeBcTftpGetFileSize (
-                 Private,
-                 Config,
-                 Filename,
-                 BlockSize,
-                 (WindowSize > 1) ? &WindowSize : NULL,
-                 BufferSize
-                 );
+  do {
+    *BufferSize             = RequestedSize;
+    Mode->TftpErrorReceived = FALSE;
+    Mode->IcmpErrorReceived = FALSE;
 
-      break;
+    switch (Operation) {
+      case EFI_PXE_BASE_CODE_TFTP_GET_FILE_SIZE:
+        //
+        // Send TFTP request to get file size.
+        //
+        Status = PxeBcTftpGetFileSize (
+                   Private,
+                   Config,
+                   Filename,
+                   BlockSize,
+                   (WindowSize > 1) ? &WindowSize : NULL,
+                   BufferSize
+                   );
 
-    case EFI_PXE_BASE_CODE_TFTP_READ_FILE:
-      //
-      // Send TFTP request to read file.
-      //
-      Status = PxeBcTftpReadFile (
-                 Private,
-                 Config,
-                 Filename,
-                 BlockSize,
-                 (WindowSize > 1) ? &WindowSize : NULL,
-                 BufferPtr,
-                 BufferSize,
-                 DontUseBuffer
-                 );
+        break;
 
-      break;
+      case EFI_PXE_BASE_CODE_TFTP_READ_FILE:
+        //
+        // Send TFTP request to read file.
+        //
+        Status = PxeBcTftpReadFile (
+                   Private,
+                   Config,
+                   Filename,
+                   BlockSize,
+                   (WindowSize > 1) ? &WindowSize : NULL,
+                   BufferPtr,
+                   BufferSize,
+                   DontUseBuffer
+                   );
 
-    case EFI_PXE_BASE_CODE_TFTP_WRITE_FILE:
-      //
-      // Send TFTP request to write file.
-      //
-      Status = PxeBcTftpWriteFile (
-                 Private,
-                 Config,
-                 Filename,
-                 Overwrite,
-                 BlockSize,
-                 BufferPtr,
-                 BufferSize
-                 );
+        break;
 
-      break;
+      case EFI_PXE_BASE_CODE_TFTP_WRITE_FILE:
+        //
+        // Send TFTP request to write file.
+        //
+        Status = PxeBcTftpWriteFile (
+                   Private,
+                   Config,
+                   Filename,
+                   Overwrite,
+                   BlockSize,
+                   BufferPtr,
+                   BufferSize
+                   );
 
-    case EFI_PXE_BASE_CODE_TFTP_READ_DIRECTORY:
-      //
-      // Send TFTP request to read directory.
-      //
-      Status = PxeBcTftpReadDirectory (
-                 Private,
-                 Config,
-                 Filename,
-                 BlockSize,
-                 (WindowSize > 1) ? &WindowSize : NULL,
-                 BufferPtr,
-                 BufferSize,
-                 DontUseBuffer
-                 );
+        break;
 
-      break;
+      case EFI_PXE_BASE_CODE_TFTP_READ_DIRECTORY:
+        //
+        // Send TFTP request to read directory.
+        //
+        Status = PxeBcTftpReadDirectory (
+                   Private,
+                   Config,
+                   Filename,
+                   BlockSize,
+                   (WindowSize > 1) ? &WindowSize : NULL,
+                   BufferPtr,
+                   BufferSize,
+                   DontUseBuffer
+                   );
 
-    case EFI_PXE_BASE_CODE_MTFTP_GET_FILE_SIZE:
-    case EFI_PXE_BASE_CODE_MTFTP_READ_FILE:
-    case EFI_PXE_BASE_CODE_MTFTP_READ_DIRECTORY:
-      Status = EFI_UNSUPPORTED;
+        break;
 
-      break;
+      case EFI_PXE_BASE_CODE_MTFTP_GET_FILE_SIZE:
+      case EFI_PXE_BASE_CODE_MTFTP_READ_FILE:
+      case EFI_PXE_BASE_CODE_MTFTP_READ_DIRECTORY:
+        Status = EFI_UNSUPPORTED;
 
-    default:
-      Status = EFI_INVALID_PARAMETER;
+        break;
+
+      default:
+        Status = EFI_INVALID_PARAMETER;
+
+        break;
+    }
 
+    //
+    // Servers that do not support windowsize may deny the request, and some paths
+    // lose blocks of a window. Retry such a read once in lock-step, and keep using
+    // lock-step on this interface.
+    //
+    if ((WindowSize <= 1) || (Operation == EFI_PXE_BASE_CODE_TFTP_WRITE_FILE) ||
+        ((Status != EFI_TIMEOUT) &&
+         ((Status != EFI_TFTP_ERROR) || (Mode->TftpError.ErrorCode != EFI_MTFTP4_ERRORCODE_REQUEST_DENIED))))
+    {
       break;
-  }
+    }
+
+    DEBUG ((DEBUG_WARN, "PXE: TFTP windowsize %d failed with %r, retry in lock-step.\n", WindowSize, Status));
+    Private->TftpWindowSizeFailed = TRUE;
+    WindowSize                    = 1;
+  } while (TRUE);
 
   if (Status == EFI_ICMP_ERROR) {
     Mode->IcmpErrorReceived = TRUE;
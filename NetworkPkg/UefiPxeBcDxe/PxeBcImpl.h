@@ -166,6 +166,12 @@ struct _PXEBC_PRIVATE_DATA {
   BOOLEAN                                      IsProxyRecved;
   BOOLEAN                                      IsDoDiscover;
 
+  //
+  // Set once a TFTP server or path failed a windowed download, later downloads
+  // on this interface are done in lock-step.
+  //
+  BOOLEAN                                      TftpWindowSizeFailed;
+
   EFI_IP_ADDRESS                               TmpStationIp;
   EFI_IP_ADDRESS                               StationIp;
   EFI_IP_ADDRESS                               SubnetMask;
@@ -72,6 +72,7 @@ typedef struct {
 // Bits in VIRTIO_NET_REQ.Flags
 //
 #define VIRTIO_NET_HDR_F_NEEDS_CSUM  BIT0
+#define VIRTIO_NET_HDR_F_DATA_VALID  BIT1
 
 //
 // Types/Bits for VIRTIO_NET_REQ.GsoType
@@ -388,7 +388,8 @@ AcceptMemoryForAPsStack (
 }
 
 /**
-  BSP and APs work togeter to accept memory which is under the address of 4G.
+  BSP and APs work togeter to accept memory which is under the address of
+  PcdLazyAcceptMemoryStart.
 
   @param[in] VmmHobList           The Hoblist pass the firmware
   @param[in] CpusNum              Number of vCPUs
@@ -415,12 +416,13 @@ AcceptMemory (
   EFI_PHYSICAL_ADDRESS  AcceptMemoryEndAddress;
 
   Status                 = EFI_SUCCESS;
-  AcceptMemoryEndAddress = BASE_4GB;
+  AcceptMemoryEndAddress = FixedPcdGet64 (PcdLazyAcceptMemoryStart);
+  ASSERT (AcceptMemoryEndAddress >= BASE_4GB);
 
   ASSERT (VmmHobList != NULL);
   Hob.Raw = (UINT8 *)VmmHobList;
 
-  DEBUG ((DEBUG_INFO, "AcceptMemory under address of 4G\n"));
+  DEBUG ((DEBUG_INFO, "AcceptMemory under address of 0x%llx\n", AcceptMemoryEndAddress));
 
   //
   // Parse the HOB list until end of list or matching type is found.
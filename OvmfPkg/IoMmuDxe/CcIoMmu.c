@@ -532,7 +532,7 @@ IoMmuAllocateBuffer (
   VOID                  *StashBuffer;
   UINTN                 CommonBufferPages;
   COMMON_BUFFER_HEADER  *CommonBufferHeader;
-  UINT32                ReservedMemBitmap;
+  UINT64                ReservedMemBitmap;
 
   DEBUG ((
     DEBUG_VERBOSE,
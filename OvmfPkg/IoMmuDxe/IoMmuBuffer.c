@@ -20,20 +20,19 @@ extern BOOLEAN  mReservedSharedMemSupported;
 
 #define SIZE_OF_MEM_RANGE(MemRange)  (MemRange->HeaderSize + MemRange->DataSize)
 
-#define RESERVED_MEM_BITMAP_4K_MASK    0xf
-#define RESERVED_MEM_BITMAP_32K_MASK   0xff0
-#define RESERVED_MEM_BITMAP_128K_MASK  0x3000
-#define RESERVED_MEM_BITMAP_1M_MASK    0x40000
-#define RESERVED_MEM_BITMAP_2M_MASK    0x180000
-#define RESERVED_MEM_BITMAP_MASK       0x1fffff
+//
+// The number of bits in mReservedMemBitmap, ie. the maximum number of pieces
+// of reserved memory.
+//
+#define RESERVED_MEM_BITMAP_BITS  64
 
 /**
  * mReservedMemRanges describes the layout of the reserved memory.
  * The reserved memory consists of disfferent size of memory region.
  * The pieces of memory with the same size are managed by one entry
  * in the mReservedMemRanges. All the pieces of memories are managed by
- * mReservedMemBitmap which is a UINT32. It means it can manage at most
- * 32 pieces of memory. Because of the layout of CommonBuffer
+ * mReservedMemBitmap which is a UINT64. It means it can manage at most
+ * 64 pieces of memory. Because of the layout of CommonBuffer
  * (1-page header + n-page data), a piece of reserved memory consists of
  * 2 parts: Header + Data.
  *
@@ -41,11 +40,12 @@ extern BOOLEAN  mReservedSharedMemSupported;
  * are designed to manage the reserved memory.
  *
  * Use the second entry of mReservedMemRanges as an example.
- * { RESERVED_MEM_BITMAP_32K_MASK,  4,  8, SIZE_32KB,  SIZE_4KB, 0 },
- * - RESERVED_MEM_BITMAP_32K_MASK is 0xff0. It means bit4-11 in mReservedMemBitmap
- *   is reserved for 32K size memory.
- * - 4 is the shift of mReservedMemBitmap.
- * - 8 means there are 8 pieces of 32K size memory.
+ * { 0, 0, 8, SIZE_32KB,  SIZE_4KB, 0 },
+ * - The bitmap mask and the shift in mReservedMemBitmap are computed by
+ *   CalcuateReservedMemSize(). With one copy of the layout, bit4-11 in
+ *   mReservedMemBitmap are reserved for 32K size memory.
+ * - 8 means there are 8 pieces of 32K size memory. The count is multiplied by
+ *   PcdIoMmuReservedSharedMemCopies.
  * - SIZE_32KB indicates the size of Data part.
  * - SIZE_4KB is the size of Header part.
  * - 0 is the start address of this memory range which will be populated when
@@ -62,17 +62,17 @@ extern BOOLEAN  mReservedSharedMemSupported;
  * memory allocation as before.
  */
 STATIC IOMMU_RESERVED_MEM_RANGE  mReservedMemRanges[] = {
-  { RESERVED_MEM_BITMAP_4K_MASK,   0,  4, SIZE_4KB,   SIZE_4KB, 0 },
-  { RESERVED_MEM_BITMAP_32K_MASK,  4,  8, SIZE_32KB,  SIZE_4KB, 0 },
-  { RESERVED_MEM_BITMAP_128K_MASK, 12, 2, SIZE_128KB, SIZE_4KB, 0 },
-  { RESERVED_MEM_BITMAP_1M_MASK,   14, 1, SIZE_1MB,   SIZE_4KB, 0 },
-  { RESERVED_MEM_BITMAP_2M_MASK,   15, 2, SIZE_2MB,   SIZE_4KB, 0 },
+  { 0, 0, 4, SIZE_4KB,   SIZE_4KB, 0 },
+  { 0, 0, 8, SIZE_32KB,  SIZE_4KB, 0 },
+  { 0, 0, 2, SIZE_128KB, SIZE_4KB, 0 },
+  { 0, 0, 1, SIZE_1MB,   SIZE_4KB, 0 },
+  { 0, 0, 2, SIZE_2MB,   SIZE_4KB, 0 },
 };
 
 //
 // Bitmap of the allocation of reserved memory.
 //
-STATIC UINT32  mReservedMemBitmap = 0;
+STATIC volatile UINT64  mReservedMemBitmap = 0;
 
 //
 // Start address of the reserved memory region.
@@ -87,6 +87,10 @@ STATIC UINT32  mReservedSharedMemSize = 0;
 /**
  * Calculate the size of reserved memory.
  *
+ * On the first call, the number of slots of each memory range is multiplied
+ * by PcdIoMmuReservedSharedMemCopies, and the bits of mReservedMemBitmap are
+ * distributed over the memory ranges.
+ *
  * @retval UINT32   Size of the reserved memory
  */
 STATIC
@@ -96,14 +100,33 @@ CalcuateReservedMemSize (
   )
 {
   UINT32                    Index;
+  UINT32                    Copies;
+  UINT32                    Shift;
   IOMMU_RESERVED_MEM_RANGE  *MemRange;
 
   if (mReservedSharedMemSize != 0) {
     return mReservedSharedMemSize;
   }
 
+  Shift = 0;
   for (Index = 0; Index < ARRAY_SIZE (mReservedMemRanges); Index++) {
-    MemRange                = &mReservedMemRanges[Index];
+    Shift += mReservedMemRanges[Index].Slots;
+  }
+
+  Copies = PcdGet8 (PcdIoMmuReservedSharedMemCopies);
+  if ((Copies == 0) || (Copies * Shift > RESERVED_MEM_BITMAP_BITS)) {
+    DEBUG ((DEBUG_WARN, "%a: invalid PcdIoMmuReservedSharedMemCopies %u\n", __func__, Copies));
+    Copies = MAX (1, MIN (Copies, RESERVED_MEM_BITMAP_BITS / Shift));
+  }
+
+  Shift = 0;
+  for (Index = 0; Index < ARRAY_SIZE (mReservedMemRanges); Index++) {
+    MemRange             = &mReservedMemRanges[Index];
+    MemRange->Slots     *= Copies;
+    MemRange->Shift      = Shift;
+    MemRange->BitmapMask = LShiftU64 (LShiftU64 (1, MemRange->Slots) - 1, Shift);
+    Shift               += MemRange->Slots;
+
     mReservedSharedMemSize += (SIZE_OF_MEM_RANGE (MemRange) * MemRange->Slots);
   }
 
@@ -115,7 +138,7 @@ CalcuateReservedMemSize (
  * used in the DMA operation.
  *
  * The pre-alloc memory contains pieces of memory regions with different size. The
- * allocation of the shared memory regions are indicated by a 32-bit bitmap (mReservedMemBitmap).
+ * allocation of the shared memory regions are indicated by a 64-bit bitmap (mReservedMemBitmap).
  *
  * The memory regions are consumed by IoMmuAllocateBuffer (in which CommonBuffer is allocated) and
  * IoMmuMap (in which bounce buffer is allocated).
@@ -269,12 +292,12 @@ InternalAllocateBuffer (
   IN  EFI_ALLOCATE_TYPE        Type,
   IN  EFI_MEMORY_TYPE          MemoryType,
   IN  UINTN                    Pages,
-  OUT UINT32                   *ReservedMemBit,
+  OUT UINT64                   *ReservedMemBit,
   IN OUT EFI_PHYSICAL_ADDRESS  *PhysicalAddress
   )
 {
-  UINT32                    MemBitmap;
-  UINT32                    ReservedMemBitmap;
+  UINT64                    MemBitmap;
+  UINT64                    ReservedMemBitmap;
   UINT8                     Index;
   IOMMU_RESERVED_MEM_RANGE  *MemRange;
   UINTN                     PagesOfLastMemRange;
@@ -319,10 +342,10 @@ InternalAllocateBuffer (
       goto LegacyAllocateBuffer;
     }
 
-    MemBitmap = (ReservedMemBitmap & MemRange->BitmapMask) >> MemRange->Shift;
+    MemBitmap = RShiftU64 (ReservedMemBitmap & MemRange->BitmapMask, MemRange->Shift);
 
     for (Index = 0; Index < MemRange->Slots; Index++) {
-      if ((MemBitmap & (UINT8)(1<<Index)) == 0) {
+      if ((MemBitmap & LShiftU64 (1, Index)) == 0) {
         break;
       }
     }
@@ -330,8 +353,8 @@ InternalAllocateBuffer (
     ASSERT (Index != MemRange->Slots);
 
     *PhysicalAddress = MemRange->StartAddressOfMemRange + Index * SIZE_OF_MEM_RANGE (MemRange) + MemRange->HeaderSize;
-    *ReservedMemBit  = (UINT32)(1 << (Index + MemRange->Shift));
-  } while (ReservedMemBitmap != InterlockedCompareExchange32 (
+    *ReservedMemBit  = LShiftU64 (1, Index + MemRange->Shift);
+  } while (ReservedMemBitmap != InterlockedCompareExchange64 (
                                   &mReservedMemBitmap,
                                   ReservedMemBitmap,
                                   ReservedMemBitmap | *ReservedMemBit
@@ -339,7 +362,7 @@ InternalAllocateBuffer (
 
   DEBUG ((
     DEBUG_VERBOSE,
-    "%a: range-size: %lx, start-address=0x%llx, pages=0x%llx, bits=0x%lx, bitmap: %lx => %lx\n",
+    "%a: range-size: %lx, start-address=0x%llx, pages=0x%llx, bits=0x%llx, bitmap: %llx => %llx\n",
     __func__,
     MemRange->DataSize,
     *PhysicalAddress,
@@ -397,14 +420,14 @@ IoMmuAllocateBounceBuffer (
 STATIC
 VOID
 ClearReservedMemBit (
-  IN  UINT32  ReservedMemBit
+  IN  UINT64  ReservedMemBit
   )
 {
-  UINT32  ReservedMemBitmap;
+  UINT64  ReservedMemBitmap;
 
   do {
     ReservedMemBitmap = mReservedMemBitmap;
-  } while (ReservedMemBitmap != InterlockedCompareExchange32 (
+  } while (ReservedMemBitmap != InterlockedCompareExchange64 (
                                   &mReservedMemBitmap,
                                   ReservedMemBitmap,
                                   ReservedMemBitmap & ~ReservedMemBit
@@ -432,7 +455,7 @@ IoMmuFreeBounceBuffer (
       MapInfo->PlainTextAddress,
       MapInfo->ReservedMemBitmap,
       mReservedMemBitmap,
-      mReservedMemBitmap & ((UINT32)(~MapInfo->ReservedMemBitmap))
+      mReservedMemBitmap & ~MapInfo->ReservedMemBitmap
       ));
     ClearReservedMemBit (MapInfo->ReservedMemBitmap);
     MapInfo->PlainTextAddress  = 0;
@@ -458,7 +481,7 @@ IoMmuAllocateCommonBuffer (
   IN EFI_MEMORY_TYPE        MemoryType,
   IN UINTN                  CommonBufferPages,
   OUT EFI_PHYSICAL_ADDRESS  *PhysicalAddress,
-  OUT UINT32                *ReservedMemBitmap
+  OUT UINT64                *ReservedMemBitmap
   )
 {
   EFI_STATUS  Status;
@@ -509,7 +532,7 @@ IoMmuFreeCommonBuffer (
     (UINT64)(UINTN)CommonBufferHeader + SIZE_4KB,
     CommonBufferHeader->ReservedMemBitmap,
     mReservedMemBitmap,
-    mReservedMemBitmap & ((UINT32)(~CommonBufferHeader->ReservedMemBitmap))
+    mReservedMemBitmap & ~CommonBufferHeader->ReservedMemBitmap
     ));
 
   ClearReservedMemBit (CommonBufferHeader->ReservedMemBitmap);
@@ -24,7 +24,7 @@ typedef struct {
   UINTN                    NumberOfPages;
   EFI_PHYSICAL_ADDRESS     CryptedAddress;
   EFI_PHYSICAL_ADDRESS     PlainTextAddress;
-  UINT32                   ReservedMemBitmap;
+  UINT64                   ReservedMemBitmap;
 } MAP_INFO;
 
 #define COMMON_BUFFER_SIG  SIGNATURE_64 ('C', 'M', 'N', 'B', 'U', 'F', 'F', 'R')
@@ -50,7 +50,7 @@ typedef struct {
   //
   // Bitmap of reserved memory
   //
-  UINT32    ReservedMemBitmap;
+  UINT64    ReservedMemBitmap;
 
   //
   // Followed by the actual common buffer, starting at the next page.
@@ -68,7 +68,7 @@ typedef struct {
 //     |-----------------------------------------|
 //
 typedef struct {
-  UINT32                  BitmapMask;
+  UINT64                  BitmapMask;
   UINT32                  Shift;
   UINT32                  Slots;
   UINT32                  DataSize;
@@ -82,7 +82,7 @@ typedef struct {
  * used in the DMA operation.
  *
  * The pre-alloc memory contains pieces of memory regions with different size. The
- * allocation of the shared memory regions are indicated by a 32-bit bitmap (mReservedMemBitmap).
+ * allocation of the shared memory regions are indicated by a 64-bit bitmap (mReservedMemBitmap).
  *
  * The memory regions are consumed by IoMmuAllocateBuffer (in which CommonBuffer is allocated) and
  * IoMmuMap (in which bounce buffer is allocated).
@@ -158,7 +158,7 @@ IoMmuAllocateCommonBuffer (
   IN EFI_MEMORY_TYPE        MemoryType,
   IN UINTN                  CommonBufferPages,
   OUT EFI_PHYSICAL_ADDRESS  *PhysicalAddress,
-  OUT UINT32                *ReservedMemBitmap
+  OUT UINT64                *ReservedMemBitmap
   );
 
 /**
@@ -49,10 +49,11 @@ BuildResourceDescriptorHobForUnacceptedMemory (
   PhysicalEnd       = PhysicalStart + ResourceLength;
 
   //
-  // In the first stage of lazy-accept, all the memory under 4G will be accepted.
-  // The memory above 4G will not be accepted.
+  // In the first stage of lazy-accept, all the memory under
+  // PcdLazyAcceptMemoryStart has been accepted by SEC. The memory above it
+  // will not be accepted.
   //
-  MaxAcceptedMemoryAddress = BASE_4GB;
+  MaxAcceptedMemoryAddress = FixedPcdGet64 (PcdLazyAcceptMemoryStart);
 
   if (PhysicalEnd <= MaxAcceptedMemoryAddress) {
     //
@@ -65,6 +66,19 @@ BuildResourceDescriptorHobForUnacceptedMemory (
     // This memory region hasn't been accepted.
     // So keep the ResourceType and ResourceAttribute unchange.
     //
+  } else {
+    //
+    // The part below MaxAcceptedMemoryAddress has been accepted, the rest
+    // hasn't.
+    //
+    BuildResourceDescriptorHob (
+      EFI_RESOURCE_SYSTEM_MEMORY,
+      ResourceAttribute | (EFI_RESOURCE_ATTRIBUTE_PRESENT | EFI_RESOURCE_ATTRIBUTE_INITIALIZED | EFI_RESOURCE_ATTRIBUTE_TESTED),
+      PhysicalStart,
+      MaxAcceptedMemoryAddress - PhysicalStart
+      );
+    PhysicalStart  = MaxAcceptedMemoryAddress;
+    ResourceLength = PhysicalEnd - PhysicalStart;
   }
 
   BuildResourceDescriptorHob (
@@ -368,6 +368,73 @@ UnmapFwCfgDmaDataBuffer (
   }
 }
 
+//
+// The largest transfer that is bounced through one mapping when SEV or TDX
+// is enabled. IoMmuDxe serves mappings of up to 2MB from its reserved shared
+// memory, so larger transfers are split rather than making IoMmuDxe change
+// the encryption state of a bounce buffer as large as the transfer.
+//
+#define FW_CFG_DMA_MAX_MAPPED_CHUNK  SIZE_2MB
+
+/**
+  Start a DMA transfer and wait for it to complete.
+
+  @param[in] Access      The FW_CFG_DMA_ACCESS to use, visible to the host.
+  @param[in] Size        Size in bytes to transfer or skip.
+  @param[in] DataBuffer  Device address of the data. Ignored if Control is
+                         FW_CFG_DMA_CTL_SKIP.
+  @param[in] Control     FW_CFG_DMA_CTL_WRITE, FW_CFG_DMA_CTL_READ or
+                         FW_CFG_DMA_CTL_SKIP.
+**/
+STATIC
+VOID
+InternalQemuFwCfgDmaTransfer (
+  IN volatile FW_CFG_DMA_ACCESS  *Access,
+  IN UINT32                      Size,
+  IN VOID                        *DataBuffer,
+  IN UINT32                      Control
+  )
+{
+  UINT32  AccessHigh, AccessLow;
+  UINT32  Status;
+
+  Access->Control = SwapBytes32 (Control);
+  Access->Length  = SwapBytes32 (Size);
+  Access->Address = SwapBytes64 ((UINTN)DataBuffer);
+
+  //
+  // Delimit the transfer from (a) modifications to Access, (b) in case of a
+  // write, from writes to Buffer by the caller.
+  //
+  MemoryFence ();
+
+  //
+  // Start the transfer.
+  //
+  AccessHigh = (UINT32)RShiftU64 ((UINTN)Access, 32);
+  AccessLow  = (UINT32)(UINTN)Access;
+  IoWrite32 (FW_CFG_IO_DMA_ADDRESS, SwapBytes32 (AccessHigh));
+  IoWrite32 (FW_CFG_IO_DMA_ADDRESS + 4, SwapBytes32 (AccessLow));
+
+  //
+  // Don't look at Access.Control before starting the transfer.
+  //
+  MemoryFence ();
+
+  //
+  // Wait for the transfer to complete.
+  //
+  do {
+    Status = SwapBytes32 (Access->Control);
+    ASSERT ((Status & FW_CFG_DMA_CTL_ERROR) == 0);
+  } while (Status != 0);
+
+  //
+  // After a read, the caller will want to use Buffer.
+  //
+  MemoryFence ();
+}
+
 /**
   Transfer an array of bytes, or skip a number of bytes, using the DMA
   interface.
@@ -391,11 +458,10 @@ InternalQemuFwCfgDmaBytes (
   )
 {
   volatile FW_CFG_DMA_ACCESS  LocalAccess;
-  volatile FW_CFG_DMA_ACCESS  *Access;
-  UINT32                      AccessHigh, AccessLow;
-  UINT32                      Status;
+  VOID                        *AccessBuffer;
   VOID                        *AccessMapping, *DataMapping;
-  VOID                        *DataBuffer;
+  EFI_PHYSICAL_ADDRESS        DataBufferAddress;
+  UINT32                      ChunkSize;
 
   ASSERT (
     Control == FW_CFG_DMA_CTL_WRITE || Control == FW_CFG_DMA_CTL_READ ||
@@ -406,89 +472,42 @@ InternalQemuFwCfgDmaBytes (
     return;
   }
 
-  Access        = &LocalAccess;
-  AccessMapping = NULL;
-  DataMapping   = NULL;
-  DataBuffer    = Buffer;
+  if (!MemEncryptSevIsEnabled () && !MemEncryptTdxIsEnabled ()) {
+    InternalQemuFwCfgDmaTransfer (&LocalAccess, Size, Buffer, Control);
+    return;
+  }
 
   //
   // When SEV or TDX is enabled, map Buffer to DMA address before issuing the DMA
-  // request
+  // request. The DMA Access buffer is shared by all the chunks.
   //
-  if (MemEncryptSevIsEnabled () || MemEncryptTdxIsEnabled ()) {
-    VOID                  *AccessBuffer;
-    EFI_PHYSICAL_ADDRESS  DataBufferAddress;
-
-    //
-    // Allocate DMA Access buffer
-    //
-    AllocFwCfgDmaAccessBuffer (&AccessBuffer, &AccessMapping);
+  AllocFwCfgDmaAccessBuffer (&AccessBuffer, &AccessMapping);
 
-    Access = AccessBuffer;
+  if (Control == FW_CFG_DMA_CTL_SKIP) {
+    InternalQemuFwCfgDmaTransfer (AccessBuffer, Size, NULL, Control);
+  } else {
+    while (Size > 0) {
+      ChunkSize = MIN (Size, FW_CFG_DMA_MAX_MAPPED_CHUNK);
 
-    //
-    // Map actual data buffer
-    //
-    if (Control != FW_CFG_DMA_CTL_SKIP) {
+      //
+      // Map actual data buffer
+      //
       MapFwCfgDmaDataBuffer (
         Control == FW_CFG_DMA_CTL_WRITE,
         Buffer,
-        Size,
+        ChunkSize,
         &DataBufferAddress,
         &DataMapping
         );
 
-      DataBuffer = (VOID *)(UINTN)DataBufferAddress;
-    }
-  }
-
-  Access->Control = SwapBytes32 (Control);
-  Access->Length  = SwapBytes32 (Size);
-  Access->Address = SwapBytes64 ((UINTN)DataBuffer);
-
-  //
-  // Delimit the transfer from (a) modifications to Access, (b) in case of a
-  // write, from writes to Buffer by the caller.
-  //
-  MemoryFence ();
-
-  //
-  // Start the transfer.
-  //
-  AccessHigh = (UINT32)RShiftU64 ((UINTN)Access, 32);
-  AccessLow  = (UINT32)(UINTN)Access;
-  IoWrite32 (FW_CFG_IO_DMA_ADDRESS, SwapBytes32 (AccessHigh));
-  IoWrite32 (FW_CFG_IO_DMA_ADDRESS + 4, SwapBytes32 (AccessLow));
-
-  //
-  // Don't look at Access.Control before starting the transfer.
-  //
-  MemoryFence ();
-
-  //
-  // Wait for the transfer to complete.
-  //
-  do {
-    Status = SwapBytes32 (Access->Control);
-    ASSERT ((Status & FW_CFG_DMA_CTL_ERROR) == 0);
-  } while (Status != 0);
+      InternalQemuFwCfgDmaTransfer (AccessBuffer, ChunkSize, (VOID *)(UINTN)DataBufferAddress, Control);
 
-  //
-  // After a read, the caller will want to use Buffer.
-  //
-  MemoryFence ();
+      UnmapFwCfgDmaDataBuffer (DataMapping);
 
-  //
-  // If Access buffer was dynamically allocated then free it.
-  //
-  if (AccessMapping != NULL) {
-    FreeFwCfgDmaAccessBuffer ((VOID *)Access, AccessMapping);
+      Buffer = (UINT8 *)Buffer + ChunkSize;
+      Size  -= ChunkSize;
+    }
   }
 
-  //
-  // If DataBuffer was mapped then unmap it.
-  //
-  if (DataMapping != NULL) {
-    UnmapFwCfgDmaDataBuffer (DataMapping);
-  }
+  FreeFwCfgDmaAccessBuffer (AccessBuffer, AccessMapping);
 }
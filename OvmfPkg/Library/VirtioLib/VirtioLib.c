@@ -17,6 +17,13 @@
 
 #include <Library/VirtioLib.h>
 
+//
+// Number of times VirtioFlush() re-reads the used ring index before it starts
+// stalling between the reads. Reading the ring is a plain memory access,
+// while every stall reads the ACPI PM timer, which traps to the hypervisor.
+//
+#define VIRTIO_FLUSH_SPIN_COUNT  1024
+
 /**
 
   Configure a virtio ring.
@@ -264,6 +271,9 @@ VirtioAppendDesc (
                           from device-specific request structures linked by the
                           descriptor chain.
 
+  The device is not notified if it set VRING_USED_F_NO_NOTIFY in the used
+  ring; such a device polls the available ring on its own.
+
   @return              Error code from VirtIo->SetQueueNotify() if it fails.
 
   @retval EFI_SUCCESS  Otherwise, the host processed all descriptors.
@@ -282,6 +292,7 @@ VirtioFlush (
   UINT16      NextAvailIdx;
   UINT16      LastUsedIdx;
   EFI_STATUS  Status;
+  UINTN       SpinCount;
   UINTN       PollPeriodUsecs;
 
   //
@@ -308,12 +319,16 @@ VirtioFlush (
 
   //
   // virtio-0.9.5, 2.4.1.4 Notifying the Device -- gratuitous notifications are
-  // OK.
+  // OK, but each one traps to the hypervisor, so skip it if the device asked
+  // for none. The index update above must be visible before the flag is read;
+  // a device that clears the flag re-checks the available ring afterwards.
   //
   MemoryFence ();
-  Status = VirtIo->SetQueueNotify (VirtIo, VirtQueueId);
-  if (EFI_ERROR (Status)) {
-    return Status;
+  if ((*Ring->Used.Flags & VRING_USED_F_NO_NOTIFY) == 0) {
+    Status = VirtIo->SetQueueNotify (VirtIo, VirtQueueId);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
   }
 
   //
@@ -322,11 +337,20 @@ VirtioFlush (
   // condition we use for polling is greatly simplified and relies on the
   // synchronous, lock-step progress.
   //
-  // Keep slowing down until we reach a poll period of slightly above 1 ms.
+  // Short requests usually complete while we spin on the index. After that,
+  // keep slowing down until we reach a poll period of slightly above 1 ms.
   //
+  SpinCount       = 0;
   PollPeriodUsecs = 1;
   MemoryFence ();
   while (*Ring->Used.Idx != NextAvailIdx) {
+    if (SpinCount < VIRTIO_FLUSH_SPIN_COUNT) {
+      SpinCount++;
+      CpuPause ();
+      MemoryFence ();
+      continue;
+    }
+
     gBS->Stall (PollPeriodUsecs); // calls AcpiTimerLib::MicroSecondDelay
 
     if (PollPeriodUsecs < 1024) {
@@ -43,10 +43,125 @@ EFI_TIMER_NOTIFY  mTimerNotifyFunction;
 //
 volatile UINT64  mTimerPeriod = 0;
 
+//
+// The Timer Deadline Protocol that this driver produces when
+// PcdLocalApicTimerTickless is enabled
+//
+EDKII_TIMER_DEADLINE_PROTOCOL  mTimerDeadline = {
+  TimerDriverSetDeadline,
+  TimerDriverGetElapsedTime
+};
+
+//
+// State of the timer when it runs in one-shot (tickless) mode. The deadline is
+// the time, relative to the last call to the notify function, at which the DXE
+// Core needs the next call. mTimerElapsedCount holds the counts that elapsed
+// before the timer was last restarted with mTimerInitialCount.
+//
+UINT64  mTimerDeadlineTime  = MAX_UINT64;
+UINT64  mTimerElapsedCount  = 0;
+UINT32  mTimerInitialCount  = 0;
+UINT64  mTimerMaximumPeriod = 0;
+
 //
 // Worker Functions
 //
 
+/**
+  Convert a number of local APIC timer counts to 100 ns units.
+
+  @param Count    The number of timer counts.
+
+  @return The time in 100 ns units.
+**/
+STATIC
+UINT64
+TimerCountToPeriod (
+  IN UINT64  Count
+  )
+{
+  return DivU64x32 (MultU64x32 (Count, 10000000), PcdGet32 (PcdFSBClock));
+}
+
+/**
+  Return the number of local APIC timer counts since the last call to the
+  notify function.
+
+  @return The number of elapsed timer counts.
+**/
+STATIC
+UINT64
+TimerElapsedCount (
+  VOID
+  )
+{
+  return mTimerElapsedCount + (mTimerInitialCount - GetApicTimerCurrentCount ());
+}
+
+/**
+  Start the local APIC timer in one-shot mode so that it expires at the
+  current deadline, or after the longest interval it supports.
+**/
+STATIC
+VOID
+TimerStartOneShot (
+  VOID
+  )
+{
+  UINT64  Elapsed;
+  UINT64  Interval;
+
+  Elapsed = TimerCountToPeriod (mTimerElapsedCount);
+  if (mTimerDeadlineTime <= Elapsed) {
+    Interval = 0;
+  } else {
+    Interval = MIN (mTimerDeadlineTime - Elapsed, mTimerMaximumPeriod);
+  }
+
+  mTimerInitialCount = (UINT32)MAX (
+                                 DivU64x32 (MultU64x32 (Interval, PcdGet32 (PcdFSBClock)), 10000000),
+                                 1
+                                 );
+  InitializeApicTimer (1, mTimerInitialCount, FALSE, LOCAL_APIC_TIMER_VECTOR);
+}
+
+/**
+  Account for the time that elapsed since the last call to the notify function
+  and restart the one-shot timer for the next deadline.
+
+  @return The time elapsed since the last call to the notify function, in
+          100 ns units.
+**/
+STATIC
+UINT64
+TimerRestartOneShot (
+  VOID
+  )
+{
+  UINT64  Elapsed;
+
+  Elapsed            = TimerCountToPeriod (TimerElapsedCount ());
+  mTimerElapsedCount = 0;
+
+  //
+  // Once the deadline is reached, fall back to the configured period until
+  // the DXE Core sets the next one
+  //
+  if (mTimerDeadlineTime != MAX_UINT64) {
+    if (mTimerDeadlineTime > Elapsed) {
+      mTimerDeadlineTime -= Elapsed;
+    } else {
+      mTimerDeadlineTime = mTimerPeriod;
+    }
+  }
+
+  if (mTimerPeriod != 0) {
+    TimerStartOneShot ();
+  }
+
+  return Elapsed;
+}
+
 /**
   Interrupt Handler.
 
@@ -62,16 +177,23 @@ TimerInterruptHandler (
 {
   STATIC NESTED_INTERRUPT_STATE  NestedInterruptState;
   EFI_TPL                        OriginalTPL;
+  UINT64                         Duration;
 
   OriginalTPL = NestedInterruptRaiseTPL ();
 
   SendApicEoi ();
 
+  if (FeaturePcdGet (PcdLocalApicTimerTickless)) {
+    Duration = TimerRestartOneShot ();
+  } else {
+    Duration = mTimerPeriod;
+  }
+
   if (mTimerNotifyFunction != NULL) {
     //
     // @bug : This does not handle missed timer interrupts
     //
-    mTimerNotifyFunction (mTimerPeriod);
+    mTimerNotifyFunction (Duration);
   }
 
   NestedInterruptRestoreTPL (OriginalTPL, SystemContext, &NestedInterruptState);
@@ -195,10 +317,22 @@ TimerDriverSetTimerPeriod (
       TimerPeriod = 429496730;
     }
 
-    //
-    // Program the timer with the new count value
-    //
-    InitializeApicTimer (DivideValue, (UINT32)TimerCount, TRUE, LOCAL_APIC_TIMER_VECTOR);
+    if (FeaturePcdGet (PcdLocalApicTimerTickless)) {
+      //
+      // Run the timer in one-shot mode, expiring after one period until the
+      // DXE Core sets a deadline
+      //
+      mTimerElapsedCount  = 0;
+      mTimerDeadlineTime  = TimerPeriod;
+      mTimerMaximumPeriod = TimerCountToPeriod (MAX_UINT32);
+      mTimerPeriod        = TimerPeriod;
+      TimerStartOneShot ();
+    } else {
+      //
+      // Program the timer with the new count value
+      //
+      InitializeApicTimer (DivideValue, (UINT32)TimerCount, TRUE, LOCAL_APIC_TIMER_VECTOR);
+    }
 
     //
     // Enable timer interrupt
@@ -270,6 +404,7 @@ TimerDriverGenerateSoftInterrupt (
   )
 {
   EFI_TPL  OriginalTPL;
+  UINT64   Duration;
 
   if (GetApicTimerInterruptState ()) {
     //
@@ -277,11 +412,17 @@ TimerDriverGenerateSoftInterrupt (
     //
     OriginalTPL = gBS->RaiseTPL (TPL_HIGH_LEVEL);
 
+    if (FeaturePcdGet (PcdLocalApicTimerTickless)) {
+      Duration = TimerRestartOneShot ();
+    } else {
+      Duration = mTimerPeriod;
+    }
+
     if (mTimerNotifyFunction != NULL) {
       //
       // @bug : This does not handle missed timer interrupts
       //
-      mTimerNotifyFunction (mTimerPeriod);
+      mTimerNotifyFunction (Duration);
     }
 
     gBS->RestoreTPL (OriginalTPL);
@@ -292,6 +433,71 @@ TimerDriverGenerateSoftInterrupt (
   return EFI_SUCCESS;
 }
 
+/**
+  Set the time at which the timer notify function must be called next.
+
+  @param This            The EDKII_TIMER_DEADLINE_PROTOCOL instance.
+  @param Deadline        The time, in 100 ns units relative to the last call to
+                         the notify function, at which the next timer event is
+                         due. MAX_UINT64 if no timer event is pending.
+
+  @retval EFI_SUCCESS    The deadline was programmed.
+  @retval EFI_NOT_READY  The timer interrupt is currently disabled.
+
+**/
+EFI_STATUS
+EFIAPI
+TimerDriverSetDeadline (
+  IN EDKII_TIMER_DEADLINE_PROTOCOL  *This,
+  IN UINT64                         Deadline
+  )
+{
+  if (mTimerPeriod == 0) {
+    return EFI_NOT_READY;
+  }
+
+  //
+  // Keep the counts that elapsed so far, and restart the timer for the
+  // remaining time to the new deadline
+  //
+  mTimerElapsedCount = TimerElapsedCount ();
+  mTimerDeadlineTime = Deadline;
+  TimerStartOneShot ();
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Return the time that elapsed since the last call to the notify function.
+
+  @param This            The EDKII_TIMER_DEADLINE_PROTOCOL instance.
+  @param ElapsedTime     The time elapsed since the last call to the notify
+                         function, in 100 ns units.
+
+  @retval EFI_SUCCESS            The elapsed time was returned.
+  @retval EFI_INVALID_PARAMETER  ElapsedTime is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+TimerDriverGetElapsedTime (
+  IN  EDKII_TIMER_DEADLINE_PROTOCOL  *This,
+  OUT UINT64                         *ElapsedTime
+  )
+{
+  if (ElapsedTime == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (mTimerPeriod == 0) {
+    *ElapsedTime = 0;
+  } else {
+    *ElapsedTime = TimerCountToPeriod (TimerElapsedCount ());
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Initialize the Timer Architectural Protocol driver
 
@@ -361,5 +567,19 @@ TimerDriverInitialize (
                   );
   ASSERT_EFI_ERROR (Status);
 
+  //
+  // Let the DXE Core program the next deadline instead of taking
+  // periodic ticks
+  //
+  if (FeaturePcdGet (PcdLocalApicTimerTickless)) {
+    Status = gBS->InstallMultipleProtocolInterfaces (
+                    &mTimerHandle,
+                    &gEdkiiTimerDeadlineProtocolGuid,
+                    &mTimerDeadline,
+                    NULL
+                    );
+    ASSERT_EFI_ERROR (Status);
+  }
+
   return Status;
 }
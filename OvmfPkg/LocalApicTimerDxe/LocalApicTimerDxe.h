@@ -14,6 +14,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include <Protocol/Cpu.h>
 #include <Protocol/Timer.h>
+#include <Protocol/TimerDeadline.h>
 
 #include <Register/LocalApic.h>
 
@@ -175,4 +176,43 @@ TimerDriverGenerateSoftInterrupt (
   )
 ;
 
+/**
+  Set the time at which the timer notify function must be called next.
+
+  @param This            The EDKII_TIMER_DEADLINE_PROTOCOL instance.
+  @param Deadline        The time, in 100 ns units relative to the last call to
+                         the notify function, at which the next timer event is
+                         due. MAX_UINT64 if no timer event is pending.
+
+  @retval EFI_SUCCESS    The deadline was programmed.
+  @retval EFI_NOT_READY  The timer interrupt is currently disabled.
+
+**/
+EFI_STATUS
+EFIAPI
+TimerDriverSetDeadline (
+  IN EDKII_TIMER_DEADLINE_PROTOCOL  *This,
+  IN UINT64                         Deadline
+  )
+;
+
+/**
+  Return the time that elapsed since the last call to the notify function.
+
+  @param This            The EDKII_TIMER_DEADLINE_PROTOCOL instance.
+  @param ElapsedTime     The time elapsed since the last call to the notify
+                         function, in 100 ns units.
+
+  @retval EFI_SUCCESS            The elapsed time was returned.
+  @retval EFI_INVALID_PARAMETER  ElapsedTime is NULL.
+
+**/
+EFI_STATUS
+EFIAPI
+TimerDriverGetElapsedTime (
+  IN  EDKII_TIMER_DEADLINE_PROTOCOL  *This,
+  OUT UINT64                         *ElapsedTime
+  )
+;
+
 #endif
@@ -127,6 +127,8 @@ AmdSevSnpInitialize (
   EFI_HOB_RESOURCE_DESCRIPTOR  *ResourceHob;
   UINT64                       HvFeatures;
   EFI_STATUS                   PcdStatus;
+  EFI_PHYSICAL_ADDRESS         LazyAcceptStart;
+  EFI_PHYSICAL_ADDRESS         ResourceEnd;
 
   if (!MemEncryptSevSnpIsEnabled ()) {
     return;
@@ -141,18 +143,33 @@ AmdSevSnpInitialize (
   ASSERT_RETURN_ERROR (PcdStatus);
 
   //
-  // Iterate through the system RAM and validate it.
+  // Iterate through the system RAM and validate it. The system RAM at and
+  // above PcdLazyAcceptMemoryStart is left to be accepted on demand.
   //
+  LazyAcceptStart = FixedPcdGet64 (PcdLazyAcceptMemoryStart);
+  ASSERT (LazyAcceptStart >= SIZE_4GB);
+
   for (Hob.Raw = GetHobList (); !END_OF_HOB_LIST (Hob); Hob.Raw = GET_NEXT_HOB (Hob)) {
     if ((Hob.Raw != NULL) && (GET_HOB_TYPE (Hob) == EFI_HOB_TYPE_RESOURCE_DESCRIPTOR)) {
       ResourceHob = Hob.ResourceDescriptor;
 
       if (ResourceHob->ResourceType == EFI_RESOURCE_SYSTEM_MEMORY) {
-        if (ResourceHob->PhysicalStart >= SIZE_4GB) {
+        if (ResourceHob->PhysicalStart >= LazyAcceptStart) {
           ResourceHob->ResourceType = EFI_RESOURCE_MEMORY_UNACCEPTED;
           continue;
         }
 
+        ResourceEnd = ResourceHob->PhysicalStart + ResourceHob->ResourceLength;
+        if (ResourceEnd > LazyAcceptStart) {
+          BuildResourceDescriptorHob (
+            EFI_RESOURCE_MEMORY_UNACCEPTED,
+            ResourceHob->ResourceAttribute,
+            LazyAcceptStart,
+            ResourceEnd - LazyAcceptStart
+            );
+          ResourceHob->ResourceLength = LazyAcceptStart - ResourceHob->PhysicalStart;
+        }
+
         MemEncryptSevSnpPreValidateSystemRam (
           ResourceHob->PhysicalStart,
           EFI_SIZE_TO_PAGES ((UINTN)ResourceHob->ResourceLength)
@@ -14,20 +14,31 @@
 
 #include "QemuFlash.h"
 
-#define WRITE_BYTE_CMD           0x10
-#define BLOCK_ERASE_CMD          0x20
-#define CLEAR_STATUS_CMD         0x50
-#define READ_STATUS_CMD          0x70
-#define READ_DEVID_CMD           0x90
-#define BLOCK_ERASE_CONFIRM_CMD  0xd0
-#define READ_ARRAY_CMD           0xff
+#define WRITE_BYTE_CMD            0x10
+#define BLOCK_ERASE_CMD           0x20
+#define CLEAR_STATUS_CMD          0x50
+#define READ_STATUS_CMD           0x70
+#define READ_DEVID_CMD            0x90
+#define CFI_QUERY_CMD             0x98
+#define BLOCK_ERASE_CONFIRM_CMD   0xd0
+#define WRITE_BUFFER_CONFIRM_CMD  0xd0
+#define WRITE_BUFFER_CMD          0xe8
+#define READ_ARRAY_CMD            0xff
 
 #define CLEARED_ARRAY_STATUS  0x00
 
+//
+// Offsets into the CFI query data of a byte wide device.
+//
+#define CFI_QUERY_QRY_OFFSET               0x10
+#define CFI_QUERY_MAX_WRITE_BUFFER_OFFSET  0x2a
+#define CFI_QUERY_MAX_WRITE_BUFFER_LIMIT   8
+
 UINT8  *mFlashBase;
 
-STATIC UINTN  mFdBlockSize  = 0;
-STATIC UINTN  mFdBlockCount = 0;
+STATIC UINTN  mFdBlockSize     = 0;
+STATIC UINTN  mFdBlockCount    = 0;
+STATIC UINTN  mWriteBufferSize = 0;
 
 STATIC
 volatile UINT8 *
@@ -136,6 +147,54 @@ QemuFlashDetected (
   return FlashDetected;
 }
 
+/**
+  Determine the size of the write buffer of the QEMU flash device from its CFI
+  query data.
+
+  The word count of the write to buffer command is a single byte on a byte wide
+  device, so the buffer size is capped at 256 bytes.
+
+  @return  The size of the write buffer in bytes, or 0 if the device does not
+           report one and has to be programmed one byte at a time.
+
+**/
+STATIC
+UINTN
+QemuFlashGetWriteBufferSize (
+  VOID
+  )
+{
+  volatile UINT8  *Ptr;
+  UINT8           MaxWriteBuffer;
+
+  //
+  // The CFI query data can only be read back with plain reads, which cannot
+  // be done under SEV-ES (see QemuFlashDetected()).
+  //
+  if (MemEncryptSevEsIsEnabled ()) {
+    return 0;
+  }
+
+  Ptr = QemuFlashPtr (0, 0);
+  QemuFlashPtrWrite (Ptr, CFI_QUERY_CMD);
+  if ((Ptr[CFI_QUERY_QRY_OFFSET] != 'Q') ||
+      (Ptr[CFI_QUERY_QRY_OFFSET + 1] != 'R') ||
+      (Ptr[CFI_QUERY_QRY_OFFSET + 2] != 'Y'))
+  {
+    MaxWriteBuffer = 0;
+  } else {
+    MaxWriteBuffer = Ptr[CFI_QUERY_MAX_WRITE_BUFFER_OFFSET];
+  }
+
+  QemuFlashPtrWrite (Ptr, READ_ARRAY_CMD);
+
+  if (MaxWriteBuffer == 0) {
+    return 0;
+  }
+
+  return (UINTN)1 << MIN (MaxWriteBuffer, CFI_QUERY_MAX_WRITE_BUFFER_LIMIT);
+}
+
 /**
   Read from QEMU Flash
 
@@ -194,6 +253,8 @@ QemuFlashWrite (
 {
   volatile UINT8  *Ptr;
   UINTN           Loop;
+  UINTN           Count;
+  UINTN           Index;
 
   //
   // Only write to the first 64k. We don't bother saving the FTW Spare
@@ -207,11 +268,33 @@ QemuFlashWrite (
   // Program flash
   //
   Ptr = QemuFlashPtr (Lba, Offset);
-  for (Loop = 0; Loop < *NumBytes; Loop++) {
-    QemuFlashPtrWrite (Ptr, WRITE_BYTE_CMD);
-    QemuFlashPtrWrite (Ptr, Buffer[Loop]);
+  if (mWriteBufferSize == 0) {
+    for (Loop = 0; Loop < *NumBytes; Loop++) {
+      QemuFlashPtrWrite (Ptr, WRITE_BYTE_CMD);
+      QemuFlashPtrWrite (Ptr, Buffer[Loop]);
 
-    Ptr++;
+      Ptr++;
+    }
+  } else {
+    //
+    // Every access to the flash device traps to the VMM, so program it through
+    // the write buffer: one command per chunk instead of one per byte. A chunk
+    // must not cross a write buffer boundary.
+    //
+    for (Loop = 0; Loop < *NumBytes; Loop += Count) {
+      Count = mWriteBufferSize - ((UINTN)Ptr & (mWriteBufferSize - 1));
+      Count = MIN (Count, *NumBytes - Loop);
+
+      QemuFlashPtrWrite (Ptr, WRITE_BUFFER_CMD);
+      QemuFlashPtrWrite (Ptr, (UINT8)(Count - 1));
+      for (Index = 0; Index < Count; Index++) {
+        QemuFlashPtrWrite (Ptr + Index, Buffer[Loop + Index]);
+      }
+
+      QemuFlashPtrWrite (Ptr, WRITE_BUFFER_CONFIRM_CMD);
+
+      Ptr += Count;
+    }
   }
 
   //
@@ -278,5 +361,8 @@ QemuFlashInitialize (
     return EFI_WRITE_PROTECTED;
   }
 
+  mWriteBufferSize = QemuFlashGetWriteBufferSize ();
+  DEBUG ((DEBUG_INFO, "QEMU Flash: Write buffer size %d\n", mWriteBufferSize));
+
   return EFI_SUCCESS;
 }
@@ -71,6 +71,19 @@ STATIC KERNEL_BLOB  mKernelBlob[KernelBlobTypeMax] = {
 
 STATIC UINT64  mTotalBlobBytes;
 
+STATIC
+VOID
+ReadBlob (
+  IN  CONST KERNEL_BLOB  *Blob,
+  OUT UINT8              *Buffer
+  );
+
+STATIC
+EFI_STATUS
+FetchDeferredBlob (
+  IN OUT KERNEL_BLOB  *Blob
+  );
+
 //
 // Device path for the handle that incorporates our "EFI stub filesystem".
 //
@@ -355,9 +368,10 @@ StubFileRead (
   OUT VOID              *Buffer
   )
 {
-  STUB_FILE          *StubFile;
-  CONST KERNEL_BLOB  *Blob;
-  UINT64             Left;
+  STUB_FILE    *StubFile;
+  KERNEL_BLOB  *Blob;
+  UINT64       Left;
+  EFI_STATUS   Status;
 
   StubFile = STUB_FILE_FROM_FILE (This);
 
@@ -365,8 +379,6 @@ StubFileRead (
   // Scanning the root directory?
   //
   if (StubFile->BlobType == KernelBlobTypeMax) {
-    EFI_STATUS  Status;
-
     if (StubFile->Position == KernelBlobTypeMax) {
       //
       // Scanning complete.
@@ -396,6 +408,11 @@ StubFileRead (
     return EFI_DEVICE_ERROR;
   }
 
+  Status = FetchDeferredBlob (Blob);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
   Left = Blob->Size - StubFile->Position;
   if (*BufferSize > Left) {
     *BufferSize = (UINTN)Left;
@@ -884,6 +901,7 @@ InitrdLoadFile2 (
   )
 {
   CONST KERNEL_BLOB  *InitrdBlob = &mKernelBlob[KernelBlobTypeInitrd];
+  EFI_STATUS         Status;
 
   ASSERT (InitrdBlob->Size > 0);
 
@@ -906,7 +924,20 @@ InitrdLoadFile2 (
     return EFI_BUFFER_TOO_SMALL;
   }
 
-  CopyMem (Buffer, InitrdBlob->Data, InitrdBlob->Size);
+  if (InitrdBlob->Data != NULL) {
+    CopyMem (Buffer, InitrdBlob->Data, InitrdBlob->Size);
+  } else {
+    //
+    // The initrd has not been fetched. Read it from fw_cfg directly into the
+    // caller's buffer, and verify it there.
+    //
+    ReadBlob (InitrdBlob, Buffer);
+    Status = VerifyBlob (InitrdBlob->Name, Buffer, InitrdBlob->Size, EFI_SUCCESS);
+    if (EFI_ERROR (Status)) {
+      ZeroMem (Buffer, InitrdBlob->Size);
+      return Status;
+    }
+  }
 
   *BufferSize = InitrdBlob->Size;
   return EFI_SUCCESS;
@@ -921,30 +952,19 @@ STATIC CONST EFI_LOAD_FILE2_PROTOCOL  mInitrdLoadFile2 = {
 //
 
 /**
-  Populate a blob in mKernelBlob.
+  Read the size of a blob in mKernelBlob from fw_cfg.
 
-  param[in,out] Blob  Pointer to the KERNEL_BLOB element in mKernelBlob that is
-                      to be filled from fw_cfg.
-
-  @retval EFI_SUCCESS           Blob has been populated. If fw_cfg reported a
-                                size of zero for the blob, then Blob->Data has
-                                been left unchanged.
-
-  @retval EFI_OUT_OF_RESOURCES  Failed to allocate memory for Blob->Data.
+  param[in,out] Blob  Pointer to the KERNEL_BLOB element in mKernelBlob whose
+                      size is to be read from fw_cfg.
 **/
 STATIC
-EFI_STATUS
-FetchBlob (
+VOID
+FetchBlobSize (
   IN OUT KERNEL_BLOB  *Blob
   )
 {
-  UINT32  Left;
-  UINTN   Idx;
-  UINT8   *ChunkData;
+  UINTN  Idx;
 
-  //
-  // Read blob size.
-  //
   Blob->Size = 0;
   for (Idx = 0; Idx < ARRAY_SIZE (Blob->FwCfgItem); Idx++) {
     if (Blob->FwCfgItem[Idx].SizeKey == 0) {
@@ -955,25 +975,26 @@ FetchBlob (
     Blob->FwCfgItem[Idx].Size = QemuFwCfgRead32 ();
     Blob->Size               += Blob->FwCfgItem[Idx].Size;
   }
+}
 
-  if (Blob->Size == 0) {
-    return EFI_SUCCESS;
-  }
+/**
+  Read the contents of a blob in mKernelBlob from fw_cfg.
 
-  //
-  // Read blob.
-  //
-  Blob->Data = AllocatePool (Blob->Size);
-  if (Blob->Data == NULL) {
-    DEBUG ((
-      DEBUG_ERROR,
-      "%a: failed to allocate %Ld bytes for \"%s\"\n",
-      __func__,
-      (INT64)Blob->Size,
-      Blob->Name
-      ));
-    return EFI_OUT_OF_RESOURCES;
-  }
+  param[in]  Blob    Pointer to the KERNEL_BLOB element in mKernelBlob whose
+                     size has been read with FetchBlobSize().
+  param[out] Buffer  The buffer to read the blob into, at least Blob->Size
+                     bytes large.
+**/
+STATIC
+VOID
+ReadBlob (
+  IN  CONST KERNEL_BLOB  *Blob,
+  OUT UINT8              *Buffer
+  )
+{
+  UINT32  Left;
+  UINTN   Idx;
+  UINT8   *ChunkData;
 
   DEBUG ((
     DEBUG_INFO,
@@ -983,7 +1004,7 @@ FetchBlob (
     Blob->Name
     ));
 
-  ChunkData = Blob->Data;
+  ChunkData = Buffer;
   for (Idx = 0; Idx < ARRAY_SIZE (Blob->FwCfgItem); Idx++) {
     if (Blob->FwCfgItem[Idx].DataKey == 0) {
       break;
@@ -1010,10 +1031,83 @@ FetchBlob (
 
     ChunkData += Blob->FwCfgItem[Idx].Size;
   }
+}
+
+/**
+  Populate a blob in mKernelBlob.
+
+  param[in,out] Blob  Pointer to the KERNEL_BLOB element in mKernelBlob that is
+                      to be filled from fw_cfg. Its size must have been read
+                      with FetchBlobSize().
+
+  @retval EFI_SUCCESS           Blob has been populated. If fw_cfg reported a
+                                size of zero for the blob, then Blob->Data has
+                                been left unchanged.
 
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate memory for Blob->Data.
+**/
+STATIC
+EFI_STATUS
+FetchBlob (
+  IN OUT KERNEL_BLOB  *Blob
+  )
+{
+  if (Blob->Size == 0) {
+    return EFI_SUCCESS;
+  }
+
+  //
+  // Read blob.
+  //
+  Blob->Data = AllocatePool (Blob->Size);
+  if (Blob->Data == NULL) {
+    DEBUG ((
+      DEBUG_ERROR,
+      "%a: failed to allocate %Ld bytes for \"%s\"\n",
+      __func__,
+      (INT64)Blob->Size,
+      Blob->Name
+      ));
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  ReadBlob (Blob, Blob->Data);
   return EFI_SUCCESS;
 }
 
+/**
+  Populate and verify a blob in mKernelBlob whose fetching was deferred by
+  the entry point.
+
+  param[in,out] Blob  Pointer to the KERNEL_BLOB element in mKernelBlob.
+
+  @retval EFI_SUCCESS  Blob has been populated, or it was populated already,
+                       or it is empty.
+
+  @return              Error codes from FetchBlob() or VerifyBlob().
+**/
+STATIC
+EFI_STATUS
+FetchDeferredBlob (
+  IN OUT KERNEL_BLOB  *Blob
+  )
+{
+  EFI_STATUS  Status;
+
+  if ((Blob->Data != NULL) || (Blob->Size == 0)) {
+    return EFI_SUCCESS;
+  }
+
+  Status = FetchBlob (Blob);
+  Status = VerifyBlob (Blob->Name, Blob->Data, Blob->Size, Status);
+  if (EFI_ERROR (Status) && (Blob->Data != NULL)) {
+    FreePool (Blob->Data);
+    Blob->Data = NULL;
+  }
+
+  return Status;
+}
+
 //
 // The entry point of the feature.
 //
@@ -1057,10 +1151,18 @@ QemuKernelLoaderFsDxeEntrypoint (
   }
 
   //
-  // Fetch all blobs.
+  // Fetch all blobs. A non-empty initrd is only fetched when it is read,
+  // through LoadFile2 directly into the buffer of the caller, or through the
+  // file system. This saves holding and copying a large initrd in memory.
   //
   for (BlobType = 0; BlobType < KernelBlobTypeMax; ++BlobType) {
     CurrentBlob = &mKernelBlob[BlobType];
+    FetchBlobSize (CurrentBlob);
+    if ((BlobType == KernelBlobTypeInitrd) && (CurrentBlob->Size > 0)) {
+      mTotalBlobBytes += CurrentBlob->Size;
+      continue;
+    }
+
     FetchStatus = FetchBlob (CurrentBlob);
 
     Status = VerifyBlob (
@@ -582,9 +582,12 @@ NorFlashWriteSingleBlock (
     return EFI_BAD_BUFFER_SIZE;
   }
 
-  // Pick 4 * P30_MAX_BUFFER_SIZE_IN_BYTES (== 512 bytes) as a good
-  // start for word operations as opposed to erasing the block and
-  // writing the data regardless if an erase is really needed.
+  // Program the update in place with buffered writes, and only fall back
+  // to erasing and rewriting the whole block if some bits have to go from
+  // 0 to 1. Each access to the device traps to the VMM, so this is much
+  // cheaper than an erase for any update that fits in the block, e.g.
+  // variables appended to the store or the FTW spare block being filled
+  // after it has been erased.
   //
   // Many NV variable updates are small enough for a a single
   // P30_MAX_BUFFER_SIZE_IN_BYTES block write.  In case the update is
@@ -612,78 +615,67 @@ NorFlashWriteSingleBlock (
   Start = Offset & ~BOUNDARY_OF_32_WORDS;
   End   = ALIGN_VALUE (Offset + *NumBytes, P30_MAX_BUFFER_SIZE_IN_BYTES);
 
-  if ((End - Start) <= (4 * P30_MAX_BUFFER_SIZE_IN_BYTES)) {
-    // Check to see if we need to erase before programming the data into NOR.
-    // If the destination bits are only changing from 1s to 0s we can just write.
-    // After a block is erased all bits in the block is set to 1.
-    // If any byte requires us to erase we just give up and rewrite all of it.
+  // Check to see if we need to erase before programming the data into NOR.
+  // If the destination bits are only changing from 1s to 0s we can just write.
+  // After a block is erased all bits in the block is set to 1.
+  // If any byte requires us to erase we just give up and rewrite all of it.
+
+  // Read the old version of the data into the shadow buffer
+  Status = NorFlashRead (
+             Instance,
+             Lba,
+             Start,
+             End - Start,
+             Instance->ShadowBuffer
+             );
+  if (EFI_ERROR (Status)) {
+    return EFI_DEVICE_ERROR;
+  }
 
-    // Read the old version of the data into the shadow buffer
-    Status = NorFlashRead (
-               Instance,
-               Lba,
-               Start,
-               End - Start,
-               Instance->ShadowBuffer
-               );
-    if (EFI_ERROR (Status)) {
-      return EFI_DEVICE_ERROR;
+  // Make OrigData point to the start of the old version of the data inside
+  // the word aligned buffer
+  OrigData = Instance->ShadowBuffer + (Offset & BOUNDARY_OF_32_WORDS);
+
+  // Update the buffer containing the old version of the data with the new
+  // contents, while checking whether the old version had any bits cleared
+  // that we want to set. In that case, we will need to erase the block first.
+  for (CurOffset = 0; CurOffset < *NumBytes; CurOffset++) {
+    if (~(UINT32)OrigData[CurOffset] & (UINT32)Buffer[CurOffset]) {
+      Status = NorFlashWriteSingleBlockWithErase (
+                 Instance,
+                 Lba,
+                 Offset,
+                 NumBytes,
+                 Buffer
+                 );
+      return Status;
     }
 
-    // Make OrigData point to the start of the old version of the data inside
-    // the word aligned buffer
-    OrigData = Instance->ShadowBuffer + (Offset & BOUNDARY_OF_32_WORDS);
-
-    // Update the buffer containing the old version of the data with the new
-    // contents, while checking whether the old version had any bits cleared
-    // that we want to set. In that case, we will need to erase the block first.
-    for (CurOffset = 0; CurOffset < *NumBytes; CurOffset++) {
-      if (~(UINT32)OrigData[CurOffset] & (UINT32)Buffer[CurOffset]) {
-        Status = NorFlashWriteSingleBlockWithErase (
-                   Instance,
-                   Lba,
-                   Offset,
-                   NumBytes,
-                   Buffer
-                   );
-        return Status;
-      }
+    OrigData[CurOffset] = Buffer[CurOffset];
+  }
 
-      OrigData[CurOffset] = Buffer[CurOffset];
-    }
+  //
+  // Write the updated buffer to NOR.
+  //
+  BlockAddress = GET_NOR_BLOCK_ADDRESS (Instance->RegionBaseAddress, Lba, BlockSize);
 
-    //
-    // Write the updated buffer to NOR.
-    //
-    BlockAddress = GET_NOR_BLOCK_ADDRESS (Instance->RegionBaseAddress, Lba, BlockSize);
+  // Unlock the block if we have to
+  Status = NorFlashUnlockSingleBlockIfNecessary (Instance, BlockAddress);
+  if (EFI_ERROR (Status)) {
+    goto Exit;
+  }
 
-    // Unlock the block if we have to
-    Status = NorFlashUnlockSingleBlockIfNecessary (Instance, BlockAddress);
+  Count = (End - Start) / P30_MAX_BUFFER_SIZE_IN_BYTES;
+  for (Index = 0; Index < Count; Index++) {
+    Status = NorFlashWriteBuffer (
+               Instance,
+               BlockAddress + Start + Index * P30_MAX_BUFFER_SIZE_IN_BYTES,
+               P30_MAX_BUFFER_SIZE_IN_BYTES,
+               Instance->ShadowBuffer + Index * P30_MAX_BUFFER_SIZE_IN_BYTES
+               );
     if (EFI_ERROR (Status)) {
       goto Exit;
     }
-
-    Count = (End - Start) / P30_MAX_BUFFER_SIZE_IN_BYTES;
-    for (Index = 0; Index < Count; Index++) {
-      Status = NorFlashWriteBuffer (
-                 Instance,
-                 BlockAddress + Start + Index * P30_MAX_BUFFER_SIZE_IN_BYTES,
-                 P30_MAX_BUFFER_SIZE_IN_BYTES,
-                 Instance->ShadowBuffer + Index * P30_MAX_BUFFER_SIZE_IN_BYTES
-                 );
-      if (EFI_ERROR (Status)) {
-        goto Exit;
-      }
-    }
-  } else {
-    Status = NorFlashWriteSingleBlockWithErase (
-               Instance,
-               Lba,
-               Offset,
-               NumBytes,
-               Buffer
-               );
-    return Status;
   }
 
 Exit:
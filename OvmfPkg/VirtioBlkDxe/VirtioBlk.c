@@ -6,9 +6,9 @@
 
   - No attach/detach (ie. removable media).
 
-  - Although the non-blocking interfaces of EFI_BLOCK_IO2_PROTOCOL could be a
-    good match for multiple in-flight virtio-blk requests, we stick to
-    synchronous requests and EFI_BLOCK_IO_PROTOCOL for now.
+  - A single virtqueue. EFI_BLOCK_IO2_PROTOCOL requests are kept in flight on
+    it concurrently, and EFI_BLOCK_IO_PROTOCOL requests poll for their own
+    completion.
 
   Copyright (C) 2012, Red Hat, Inc.
   Copyright (c) 2012 - 2018, Intel Corporation. All rights reserved.<BR>
@@ -177,209 +177,119 @@ VerifyReadWriteRequest (
 
 /**
 
-  Format a read / write / flush request as three consecutive virtio
-  descriptors, push them to the host, and poll for the response.
+  Complete a request: report its status to the caller, and release it if it
+  was submitted through EFI_BLOCK_IO2_PROTOCOL.
 
-  This is the main workhorse function. Two use cases are supported, read/write
-  and flush. The function may only be called after the request parameters have
-  been verified by
-  - specific checks in ReadBlocks() / WriteBlocks() / FlushBlocks(), and
-  - VerifyReadWriteRequest() (for read/write only).
-
-  Parameters handled commonly:
-
-    @param[in] Dev             The virtio-blk device the request is targeted
-                               at.
-
-  Flush request:
+  Must be called at TPL_NOTIFY.
 
-    @param[in] Lba             Must be zero.
+  @param[in] Request  The request to complete. The request must not be on any
+                      list, and must not occupy a slot.
 
-    @param[in] BufferSize      Must be zero.
-
-    @param[in out] Buffer      Ignored by the function.
+  @param[in] Status   The completion status of the request.
 
-    @param[in] RequestIsWrite  Must be TRUE.
+**/
+STATIC
+VOID
+CompleteRequest (
+  IN VBLK_REQUEST  *Request,
+  IN EFI_STATUS    Status
+  )
+{
+  if (Request->Token == NULL) {
+    Request->Status = Status;
+    Request->Done   = TRUE;
+    return;
+  }
 
-  Read/Write request:
+  Request->Token->TransactionStatus = Status;
+  gBS->SignalEvent (Request->Token->Event);
+  FreePool (Request);
+}
 
-    @param[in] Lba             Logical Block Address: number of logical blocks
-                               to skip from the beginning of the device.
+/**
 
-    @param[in] BufferSize      Size of buffer to transfer, in bytes. The caller
-                               is responsible to ensure this parameter is
-                               positive.
+  Format a read / write / flush request as up to three consecutive virtio
+  descriptors in a free slot, and push them to the available ring. The host is
+  not notified; that is left to the caller.
 
-    @param[in out] Buffer      The guest side area to read data from the device
-                               into, or write data to the device from.
+  Must be called at TPL_NOTIFY.
 
-    @param[in] RequestIsWrite  TRUE iff data transfer goes from guest to
-                               device.
+  @param[in out] Dev      The virtio-blk device the request is targeted at.
 
-  Return values are common to both use cases, and are appropriate to be
-  forwarded by the EFI_BLOCK_IO_PROTOCOL functions (ReadBlocks(),
-  WriteBlocks(), FlushBlocks()).
+  @param[in]     Slot     The free slot to use.
 
+  @param[in]     Request  The request to submit.
 
-  @retval EFI_SUCCESS          Transfer complete.
+  @retval EFI_SUCCESS       The request has been made available to the host.
 
-  @retval EFI_DEVICE_ERROR     Failed to notify host side via VirtIo write, or
-                               unable to parse host response, or host response
-                               is not VIRTIO_BLK_S_OK or failed to map Buffer
-                               for a bus master operation.
+  @retval EFI_DEVICE_ERROR  Failed to map the data buffer for a bus master
+                            operation.
 
 **/
 STATIC
 EFI_STATUS
-EFIAPI
-SynchronousRequest (
-  IN              VBLK_DEV  *Dev,
-  IN              EFI_LBA   Lba,
-  IN              UINTN     BufferSize,
-  IN OUT volatile VOID      *Buffer,
-  IN              BOOLEAN   RequestIsWrite
+SubmitRequest (
+  IN OUT VBLK_DEV      *Dev,
+  IN     UINT16        Slot,
+  IN     VBLK_REQUEST  *Request
   )
 {
-  UINT32                   BlockSize;
-  volatile VIRTIO_BLK_REQ  *Request;
+  volatile VIRTIO_BLK_REQ  *Header;
   volatile UINT8           *HostStatus;
-  VOID                     *HostStatusBuffer;
-  DESC_INDICES             Indices;
-  VOID                     *RequestMapping;
-  VOID                     *StatusMapping;
-  VOID                     *BufferMapping;
   EFI_PHYSICAL_ADDRESS     BufferDeviceAddress;
-  EFI_PHYSICAL_ADDRESS     HostStatusDeviceAddress;
-  EFI_PHYSICAL_ADDRESS     RequestDeviceAddress;
+  DESC_INDICES             Indices;
+  UINT16                   AvailIdx;
   EFI_STATUS               Status;
-  EFI_STATUS               UnmapStatus;
-
-  BlockSize = Dev->BlockIoMedia.BlockSize;
-
-  //
-  // Set BufferMapping and BufferDeviceAddress to suppress incorrect
-  // compiler/analyzer warnings.
-  //
-  BufferMapping       = NULL;
-  BufferDeviceAddress = 0;
-
-  //
-  // ensured by VirtioBlkInit()
-  //
-  ASSERT (BlockSize > 0);
-  ASSERT (BlockSize % 512 == 0);
 
-  //
-  // ensured by contract above, plus VerifyReadWriteRequest()
-  //
-  ASSERT (BufferSize % BlockSize == 0);
-
-  Request = AllocateZeroPool (sizeof (*Request));
-  if (Request == NULL) {
-    return EFI_DEVICE_ERROR;
-  }
-
-  //
-  // Prepare virtio-blk request header, setting zero size for flush.
-  // IO Priority is homogeneously 0.
-  //
-  Request->Type = RequestIsWrite ?
-                  (BufferSize == 0 ? VIRTIO_BLK_T_FLUSH : VIRTIO_BLK_T_OUT) :
-                  VIRTIO_BLK_T_IN;
-  Request->IoPrio = 0;
-  Request->Sector = MultU64x32 (Lba, BlockSize / 512);
-
-  //
-  // Host status is bi-directional (we preset with a value and expect the
-  // device to update it). Allocate a host status buffer which can be mapped
-  // to access equally by both processor and the device.
-  //
-  Status = Dev->VirtIo->AllocateSharedPages (
-                          Dev->VirtIo,
-                          EFI_SIZE_TO_PAGES (sizeof *HostStatus),
-                          &HostStatusBuffer
-                          );
-  if (EFI_ERROR (Status)) {
-    Status = EFI_DEVICE_ERROR;
-    goto FreeBlkRequest;
-  }
-
-  HostStatus = HostStatusBuffer;
-
-  //
-  // Map virtio-blk request header (must be done after request header is
-  // populated)
-  //
-  Status = VirtioMapAllBytesInSharedBuffer (
-             Dev->VirtIo,
-             VirtioOperationBusMasterRead,
-             (VOID *)Request,
-             sizeof (*Request),
-             &RequestDeviceAddress,
-             &RequestMapping
-             );
-  if (EFI_ERROR (Status)) {
-    Status = EFI_DEVICE_ERROR;
-    goto FreeHostStatusBuffer;
-  }
+  Header     = (VIRTIO_BLK_REQ *)((UINT8 *)Dev->Shared + VBLK_SHARED_HEADER_OFFSET (Slot));
+  HostStatus = (UINT8 *)Dev->Shared + VBLK_SHARED_STATUS_OFFSET (Slot);
 
   //
   // Map data buffer
   //
-  if (BufferSize > 0) {
+  Request->BufferMapping = NULL;
+  BufferDeviceAddress    = 0;
+  if (Request->BufferSize > 0) {
     Status = VirtioMapAllBytesInSharedBuffer (
                Dev->VirtIo,
-               (RequestIsWrite ?
+               (Request->RequestIsWrite ?
                 VirtioOperationBusMasterRead :
                 VirtioOperationBusMasterWrite),
-               (VOID *)Buffer,
-               BufferSize,
+               Request->Buffer,
+               Request->BufferSize,
                &BufferDeviceAddress,
-               &BufferMapping
+               &Request->BufferMapping
                );
     if (EFI_ERROR (Status)) {
-      Status = EFI_DEVICE_ERROR;
-      goto UnmapRequestBuffer;
+      return EFI_DEVICE_ERROR;
     }
   }
 
   //
-  // preset a host status for ourselves that we do not accept as success
+  // Prepare virtio-blk request header, setting zero size for flush.
+  // IO Priority is homogeneously 0.
   //
-  *HostStatus = VIRTIO_BLK_S_IOERR;
+  Header->Type = Request->RequestIsWrite ?
+                 (Request->BufferSize == 0 ? VIRTIO_BLK_T_FLUSH : VIRTIO_BLK_T_OUT) :
+                 VIRTIO_BLK_T_IN;
+  Header->IoPrio = 0;
+  Header->Sector = MultU64x32 (Request->Lba, Dev->BlockIoMedia.BlockSize / 512);
 
   //
-  // Map the Status Buffer with VirtioOperationBusMasterCommonBuffer so that
-  // both processor and device can access it.
+  // preset a host status for ourselves that we do not accept as success
   //
-  Status = VirtioMapAllBytesInSharedBuffer (
-             Dev->VirtIo,
-             VirtioOperationBusMasterCommonBuffer,
-             HostStatusBuffer,
-             sizeof *HostStatus,
-             &HostStatusDeviceAddress,
-             &StatusMapping
-             );
-  if (EFI_ERROR (Status)) {
-    Status = EFI_DEVICE_ERROR;
-    goto UnmapDataBuffer;
-  }
-
-  VirtioPrepare (&Dev->Ring, &Indices);
+  *HostStatus = VIRTIO_BLK_S_IOERR;
 
-  //
-  // ensured by VirtioBlkInit() -- this predicate, in combination with the
-  // lock-step progress, ensures we don't have to track free descriptors.
-  //
-  ASSERT (Dev->Ring.QueueSize >= 3);
+  Indices.HeadDescIdx = (UINT16)(Slot * 3);
+  Indices.NextDescIdx = Indices.HeadDescIdx;
 
   //
   // virtio-blk header in first desc
   //
   VirtioAppendDesc (
     &Dev->Ring,
-    RequestDeviceAddress,
-    sizeof (*Request),
+    Dev->SharedAddress + VBLK_SHARED_HEADER_OFFSET (Slot),
+    sizeof (VIRTIO_BLK_REQ),
     VRING_DESC_F_NEXT,
     &Indices
     );
@@ -387,16 +297,17 @@ SynchronousRequest (
   //
   // data buffer for read/write in second desc
   //
-  if (BufferSize > 0) {
+  if (Request->BufferSize > 0) {
     //
     // From virtio-0.9.5, 2.3.2 Descriptor Table:
     // "no descriptor chain may be more than 2^32 bytes long in total".
     //
-    // The predicate is ensured by the call contract above (for flush), or
-    // VerifyReadWriteRequest() (for read/write). It also implies that
-    // converting BufferSize to UINT32 will not truncate it.
+    // The predicate is ensured by the call contract of SynchronousRequest()
+    // and QueueRequest() (for flush), or VerifyReadWriteRequest() (for
+    // read/write). It also implies that converting BufferSize to UINT32 will
+    // not truncate it.
     //
-    ASSERT (BufferSize <= SIZE_1GB);
+    ASSERT (Request->BufferSize <= SIZE_1GB);
 
     //
     // VRING_DESC_F_WRITE is interpreted from the host's point of view.
@@ -404,8 +315,8 @@ SynchronousRequest (
     VirtioAppendDesc (
       &Dev->Ring,
       BufferDeviceAddress,
-      (UINT32)BufferSize,
-      VRING_DESC_F_NEXT | (RequestIsWrite ? 0 : VRING_DESC_F_WRITE),
+      (UINT32)Request->BufferSize,
+      VRING_DESC_F_NEXT | (Request->RequestIsWrite ? 0 : VRING_DESC_F_WRITE),
       &Indices
       );
   }
@@ -415,56 +326,378 @@ SynchronousRequest (
   //
   VirtioAppendDesc (
     &Dev->Ring,
-    HostStatusDeviceAddress,
+    Dev->SharedAddress + VBLK_SHARED_STATUS_OFFSET (Slot),
     sizeof *HostStatus,
     VRING_DESC_F_WRITE,
     &Indices
     );
 
   //
-  // virtio-blk's only virtqueue is #0, called "requestq" (see Appendix D).
+  // virtio-0.9.5, 2.4.1.2 Updating the Available Ring, and 2.4.1.3 Updating
+  // the Index Field. There are never more chains in flight than the ring has
+  // entries, as each one takes three descriptors.
   //
-  if ((VirtioFlush (
-         Dev->VirtIo,
-         0,
-         &Dev->Ring,
-         &Indices,
-         NULL
-         ) == EFI_SUCCESS) &&
-      (*HostStatus == VIRTIO_BLK_S_OK))
-  {
-    Status = EFI_SUCCESS;
-  } else {
-    Status = EFI_DEVICE_ERROR;
+  AvailIdx                                             = *Dev->Ring.Avail.Idx;
+  Dev->Ring.Avail.Ring[AvailIdx % Dev->Ring.QueueSize] = Indices.HeadDescIdx;
+  MemoryFence ();
+  *Dev->Ring.Avail.Idx = (UINT16)(AvailIdx + 1);
+
+  Dev->Slots[Slot] = Request;
+  Dev->InFlight++;
+  return EFI_SUCCESS;
+}
+
+/**
+
+  Reap the requests the host has completed, then submit as many waiting
+  requests as there are free slots, and notify the host about them.
+
+  A flush request is only submitted once no other request is in flight, as
+  the host only flushes writes that have completed. The requests queued after
+  it wait for it.
+
+  Must be called at TPL_NOTIFY.
+
+  @param[in out] Dev  The virtio-blk device whose requests to process.
+
+**/
+STATIC
+VOID
+ProcessRequests (
+  IN OUT VBLK_DEV  *Dev
+  )
+{
+  volatile CONST VRING_USED_ELEM  *UsedElem;
+  VBLK_REQUEST                    *Request;
+  UINT16                          Slot;
+  UINT8                           HostStatus;
+  EFI_STATUS                      Status;
+  EFI_STATUS                      UnmapStatus;
+  BOOLEAN                         Submitted;
+
+  //
+  // virtio-0.9.5, 2.4.2 Receiving Used Buffers From the Device
+  //
+  MemoryFence ();
+  while (Dev->LastUsedIdx != *Dev->Ring.Used.Idx) {
+    MemoryFence ();
+    UsedElem = &Dev->Ring.Used.UsedElem[Dev->LastUsedIdx % Dev->Ring.QueueSize];
+    Dev->LastUsedIdx++;
+
+    Slot = (UINT16)(UsedElem->Id / 3);
+    if ((UsedElem->Id % 3 != 0) || (Slot >= Dev->SlotCount) ||
+        (Dev->Slots[Slot] == NULL))
+    {
+      ASSERT (FALSE);
+      continue;
+    }
+
+    Request          = Dev->Slots[Slot];
+    Dev->Slots[Slot] = NULL;
+    Dev->InFlight--;
+
+    HostStatus = *((UINT8 *)Dev->Shared + VBLK_SHARED_STATUS_OFFSET (Slot));
+    Status     = (HostStatus == VIRTIO_BLK_S_OK) ? EFI_SUCCESS : EFI_DEVICE_ERROR;
+
+    if (Request->BufferMapping != NULL) {
+      UnmapStatus = Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Request->BufferMapping);
+      if (EFI_ERROR (UnmapStatus) && !Request->RequestIsWrite && !EFI_ERROR (Status)) {
+        //
+        // Data from the bus master may not reach the caller; fail the request.
+        //
+        Status = EFI_DEVICE_ERROR;
+      }
+    }
+
+    CompleteRequest (Request, Status);
   }
 
-  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, StatusMapping);
+  Submitted = FALSE;
+  Slot      = 0;
+  while (!IsListEmpty (&Dev->PendingRequests)) {
+    Request = VBLK_REQUEST_FROM_LINK (GetFirstNode (&Dev->PendingRequests));
+    if ((Request->BufferSize == 0) && (Dev->InFlight > 0)) {
+      break;
+    }
 
-UnmapDataBuffer:
-  if (BufferSize > 0) {
-    UnmapStatus = Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, BufferMapping);
-    if (EFI_ERROR (UnmapStatus) && !RequestIsWrite && !EFI_ERROR (Status)) {
-      //
-      // Data from the bus master may not reach the caller; fail the request.
-      //
-      Status = EFI_DEVICE_ERROR;
+    while ((Slot < Dev->SlotCount) && (Dev->Slots[Slot] != NULL)) {
+      Slot++;
+    }
+
+    if (Slot == Dev->SlotCount) {
+      break;
+    }
+
+    RemoveEntryList (&Request->Link);
+    Status = SubmitRequest (Dev, Slot, Request);
+    if (EFI_ERROR (Status)) {
+      CompleteRequest (Request, Status);
+      continue;
     }
+
+    Submitted = TRUE;
+  }
+
+  //
+  // virtio-0.9.5, 2.4.1.4 Notifying the Device -- unless the host asked us
+  // not to.
+  //
+  MemoryFence ();
+  if (Submitted && ((*Dev->Ring.Used.Flags & VRING_USED_F_NO_NOTIFY) == 0)) {
+    Dev->VirtIo->SetQueueNotify (Dev->VirtIo, 0);
   }
+}
 
-UnmapRequestBuffer:
-  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, RequestMapping);
+/**
 
-FreeHostStatusBuffer:
-  Dev->VirtIo->FreeSharedPages (
-                 Dev->VirtIo,
-                 EFI_SIZE_TO_PAGES (sizeof *HostStatus),
-                 HostStatusBuffer
-                 );
+  Timer notification function that reaps and submits the requests of a
+  virtio-blk device.
 
-FreeBlkRequest:
-  FreePool ((VOID *)Request);
+  @param[in] Event    Event whose notification function is being invoked.
 
-  return Status;
+  @param[in] Context  Pointer to the VBLK_DEV structure.
+
+**/
+STATIC
+VOID
+EFIAPI
+VirtioBlkTimer (
+  IN  EFI_EVENT  Event,
+  IN  VOID       *Context
+  )
+{
+  ProcessRequests (Context);
+}
+
+/**
+
+  Fail the requests that wait for a slot, and wait until the requests in
+  flight complete.
+
+  @param[in out] Dev  The virtio-blk device whose requests to abort.
+
+**/
+STATIC
+VOID
+AbortRequests (
+  IN OUT VBLK_DEV  *Dev
+  )
+{
+  VBLK_REQUEST  *Request;
+  EFI_TPL       OldTpl;
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+
+  while (!IsListEmpty (&Dev->PendingRequests)) {
+    Request = VBLK_REQUEST_FROM_LINK (GetFirstNode (&Dev->PendingRequests));
+    RemoveEntryList (&Request->Link);
+    CompleteRequest (Request, EFI_ABORTED);
+  }
+
+  ProcessRequests (Dev);
+  while (Dev->InFlight > 0) {
+    gBS->Stall (1000);
+    ProcessRequests (Dev);
+  }
+
+  gBS->RestoreTPL (OldTpl);
+}
+
+/**
+
+  Queue a read / write / flush request for a free slot, and submit it right
+  away if possible. The function may only be called after the request
+  parameters have been verified by
+  - specific checks in ReadBlocks() / WriteBlocks() / FlushBlocks() and their
+    EFI_BLOCK_IO2_PROTOCOL counterparts, and
+  - VerifyReadWriteRequest() (for read/write only).
+
+  @param[in out] Dev      The virtio-blk device the request is targeted at.
+
+  @param[in]     Request  The request to queue, with its Lba, BufferSize,
+                          Buffer, RequestIsWrite and Token fields set. For a
+                          flush, BufferSize must be zero and RequestIsWrite
+                          must be TRUE.
+
+**/
+STATIC
+VOID
+QueueRequest (
+  IN OUT VBLK_DEV      *Dev,
+  IN     VBLK_REQUEST  *Request
+  )
+{
+  EFI_TPL  OldTpl;
+
+  Request->Signature = VBLK_REQUEST_SIG;
+  Request->Done      = FALSE;
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  InsertTailList (&Dev->PendingRequests, &Request->Link);
+  ProcessRequests (Dev);
+  gBS->RestoreTPL (OldTpl);
+}
+
+/**
+
+  Submit a read / write / flush request, and poll for the response.
+
+  The request is queued behind the asynchronous requests that wait for a free
+  slot. The function may only be called after the request parameters have
+  been verified by
+  - specific checks in ReadBlocks() / WriteBlocks() / FlushBlocks(), and
+  - VerifyReadWriteRequest() (for read/write only).
+
+  Parameters handled commonly:
+
+    @param[in] Dev             The virtio-blk device the request is targeted
+                               at.
+
+  Flush request:
+
+    @param[in] Lba             Must be zero.
+
+    @param[in] BufferSize      Must be zero.
+
+    @param[in out] Buffer      Ignored by the function.
+
+    @param[in] RequestIsWrite  Must be TRUE.
+
+  Read/Write request:
+
+    @param[in] Lba             Logical Block Address: number of logical blocks
+                               to skip from the beginning of the device.
+
+    @param[in] BufferSize      Size of buffer to transfer, in bytes. The caller
+                               is responsible to ensure this parameter is
+                               positive.
+
+    @param[in out] Buffer      The guest side area to read data from the device
+                               into, or write data to the device from.
+
+    @param[in] RequestIsWrite  TRUE iff data transfer goes from guest to
+                               device.
+
+  Return values are common to both use cases, and are appropriate to be
+  forwarded by the EFI_BLOCK_IO_PROTOCOL functions (ReadBlocks(),
+  WriteBlocks(), FlushBlocks()).
+
+
+  @retval EFI_SUCCESS          Transfer complete.
+
+  @retval EFI_DEVICE_ERROR     Unable to parse host response, or host response
+                               is not VIRTIO_BLK_S_OK or failed to map Buffer
+                               for a bus master operation.
+
+  @retval EFI_ABORTED          The request was aborted by a reset of the
+                               device.
+
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+SynchronousRequest (
+  IN              VBLK_DEV  *Dev,
+  IN              EFI_LBA   Lba,
+  IN              UINTN     BufferSize,
+  IN OUT volatile VOID      *Buffer,
+  IN              BOOLEAN   RequestIsWrite
+  )
+{
+  VBLK_REQUEST  Request;
+  UINTN         PollPeriodUsecs;
+  EFI_TPL       OldTpl;
+
+  //
+  // ensured by VirtioBlkInit()
+  //
+  ASSERT (Dev->BlockIoMedia.BlockSize > 0);
+  ASSERT (Dev->BlockIoMedia.BlockSize % 512 == 0);
+
+  //
+  // ensured by contract above, plus VerifyReadWriteRequest()
+  //
+  ASSERT (BufferSize % Dev->BlockIoMedia.BlockSize == 0);
+
+  ZeroMem (&Request, sizeof Request);
+  Request.Lba            = Lba;
+  Request.BufferSize     = BufferSize;
+  Request.Buffer         = (VOID *)Buffer;
+  Request.RequestIsWrite = RequestIsWrite;
+  QueueRequest (Dev, &Request);
+
+  //
+  // Keep slowing down until we reach a poll period of slightly above 1 ms.
+  //
+  PollPeriodUsecs = 1;
+  OldTpl          = gBS->RaiseTPL (TPL_NOTIFY);
+  while (!Request.Done) {
+    gBS->RestoreTPL (OldTpl);
+    gBS->Stall (PollPeriodUsecs);
+    if (PollPeriodUsecs < 1024) {
+      PollPeriodUsecs *= 2;
+    }
+
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    ProcessRequests (Dev);
+  }
+
+  gBS->RestoreTPL (OldTpl);
+
+  return Request.Status;
+}
+
+/**
+
+  Submit a read / write / flush request on behalf of EFI_BLOCK_IO2_PROTOCOL.
+  The request is performed synchronously if Token is NULL, or Token->Event is
+  NULL.
+
+  The parameters are those of SynchronousRequest(), plus:
+
+  @param[in out] Token  The EFI_BLOCK_IO2_TOKEN of the caller.
+
+  @retval EFI_SUCCESS           The request has been queued (asynchronous
+                                case), or completed successfully (synchronous
+                                case).
+
+  @retval EFI_OUT_OF_RESOURCES  The request could not be queued due to a lack
+                                of resources.
+
+  @return                       Error codes from SynchronousRequest().
+
+**/
+STATIC
+EFI_STATUS
+AsynchronousRequest (
+  IN     VBLK_DEV             *Dev,
+  IN     EFI_LBA              Lba,
+  IN     UINTN                BufferSize,
+  IN OUT VOID                 *Buffer,
+  IN     BOOLEAN              RequestIsWrite,
+  IN OUT EFI_BLOCK_IO2_TOKEN  *Token
+  )
+{
+  VBLK_REQUEST  *Request;
+
+  if ((Token == NULL) || (Token->Event == NULL)) {
+    return SynchronousRequest (Dev, Lba, BufferSize, Buffer, RequestIsWrite);
+  }
+
+  Request = AllocateZeroPool (sizeof *Request);
+  if (Request == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Request->Lba             = Lba;
+  Request->BufferSize      = BufferSize;
+  Request->Buffer          = Buffer;
+  Request->RequestIsWrite  = RequestIsWrite;
+  Request->Token           = Token;
+  Token->TransactionStatus = EFI_NOT_READY;
+  QueueRequest (Dev, Request);
+
+  return EFI_SUCCESS;
 }
 
 /**
@@ -611,6 +844,185 @@ VirtioBlkFlushBlocks (
          EFI_SUCCESS;
 }
 
+//
+// UEFI Spec 2.3.1 + Errata C, 12.9 EFI Block I/O 2 Protocol
+// Driver Writer's Guide for UEFI 2.3.1 v1.01,
+//   24.3 Block I/O 2 Protocol Implementations
+//
+EFI_STATUS
+EFIAPI
+VirtioBlkResetEx (
+  IN EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN BOOLEAN                 ExtendedVerification
+  )
+{
+  //
+  // If we managed to initialize and install the driver, then the device is
+  // working correctly. Only the pending requests need to be aborted.
+  //
+  AbortRequests (VIRTIO_BLK_FROM_BLOCK_IO2 (This));
+  return EFI_SUCCESS;
+}
+
+/**
+
+  ReadBlocksEx() operation for virtio-blk.
+
+  See
+  - UEFI Spec 2.3.1 + Errata C, 12.9 EFI Block I/O 2 Protocol,
+    EFI_BLOCK_IO2_PROTOCOL.ReadBlocksEx().
+  - Driver Writer's Guide for UEFI 2.3.1 v1.01, 24.2.2. ReadBlocks() and
+    ReadBlocksEx() Implementation.
+
+  Parameter checks and conformant return values are implemented in
+  VerifyReadWriteRequest() and AsynchronousRequest().
+
+**/
+EFI_STATUS
+EFIAPI
+VirtioBlkReadBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN     UINT32                  MediaId,
+  IN     EFI_LBA                 Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token,
+  IN     UINTN                   BufferSize,
+  OUT    VOID                    *Buffer
+  )
+{
+  VBLK_DEV    *Dev;
+  EFI_STATUS  Status;
+
+  if (BufferSize == 0) {
+    if ((Token != NULL) && (Token->Event != NULL)) {
+      Token->TransactionStatus = EFI_SUCCESS;
+      gBS->SignalEvent (Token->Event);
+    }
+
+    return EFI_SUCCESS;
+  }
+
+  Dev    = VIRTIO_BLK_FROM_BLOCK_IO2 (This);
+  Status = VerifyReadWriteRequest (
+             &Dev->BlockIoMedia,
+             Lba,
+             BufferSize,
+             FALSE               // RequestIsWrite
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return AsynchronousRequest (
+           Dev,
+           Lba,
+           BufferSize,
+           Buffer,
+           FALSE,      // RequestIsWrite
+           Token
+           );
+}
+
+/**
+
+  WriteBlocksEx() operation for virtio-blk.
+
+  See
+  - UEFI Spec 2.3.1 + Errata C, 12.9 EFI Block I/O 2 Protocol,
+    EFI_BLOCK_IO2_PROTOCOL.WriteBlocksEx().
+  - Driver Writer's Guide for UEFI 2.3.1 v1.01, 24.2.3 WriteBlocks() and
+    WriteBlockEx() Implementation.
+
+  Parameter checks and conformant return values are implemented in
+  VerifyReadWriteRequest() and AsynchronousRequest().
+
+**/
+EFI_STATUS
+EFIAPI
+VirtioBlkWriteBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN     UINT32                  MediaId,
+  IN     EFI_LBA                 Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token,
+  IN     UINTN                   BufferSize,
+  IN     VOID                    *Buffer
+  )
+{
+  VBLK_DEV    *Dev;
+  EFI_STATUS  Status;
+
+  if (BufferSize == 0) {
+    if ((Token != NULL) && (Token->Event != NULL)) {
+      Token->TransactionStatus = EFI_SUCCESS;
+      gBS->SignalEvent (Token->Event);
+    }
+
+    return EFI_SUCCESS;
+  }
+
+  Dev    = VIRTIO_BLK_FROM_BLOCK_IO2 (This);
+  Status = VerifyReadWriteRequest (
+             &Dev->BlockIoMedia,
+             Lba,
+             BufferSize,
+             TRUE                // RequestIsWrite
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return AsynchronousRequest (
+           Dev,
+           Lba,
+           BufferSize,
+           Buffer,
+           TRUE,       // RequestIsWrite
+           Token
+           );
+}
+
+/**
+
+  FlushBlocksEx() operation for virtio-blk.
+
+  See
+  - UEFI Spec 2.3.1 + Errata C, 12.9 EFI Block I/O 2 Protocol,
+    EFI_BLOCK_IO2_PROTOCOL.FlushBlocksEx().
+  - Driver Writer's Guide for UEFI 2.3.1 v1.01, 24.2.4 FlushBlocks() and
+    FlushBlocksEx() Implementation.
+
+  The flush is submitted only after the requests queued before it have
+  completed. Without write-caching, we do nothing, successfully.
+
+**/
+EFI_STATUS
+EFIAPI
+VirtioBlkFlushBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token
+  )
+{
+  VBLK_DEV  *Dev;
+
+  Dev = VIRTIO_BLK_FROM_BLOCK_IO2 (This);
+  if (!Dev->BlockIoMedia.WriteCaching) {
+    if ((Token != NULL) && (Token->Event != NULL)) {
+      Token->TransactionStatus = EFI_SUCCESS;
+      gBS->SignalEvent (Token->Event);
+    }
+
+    return EFI_SUCCESS;
+  }
+
+  return AsynchronousRequest (
+           Dev,
+           0,      // Lba
+           0,      // BufferSize
+           NULL,   // Buffer
+           TRUE,   // RequestIsWrite
+           Token
+           );
+}
+
 /**
 
   Device probe function for this driver.
@@ -858,7 +1270,7 @@ VirtioBlkInit (
   }
 
   if (QueueSize < 3) {
-    // SynchronousRequest() uses at most three descriptors
+    // SubmitRequest() uses at most three descriptors
     Status = EFI_UNSUPPORTED;
     goto Failed;
   }
@@ -918,13 +1330,49 @@ VirtioBlkInit (
     }
   }
 
+  //
+  // Allocate and map the request headers and host status bytes of all slots
+  // once; they are bi-directional, so both processor and device access them.
+  //
+  Status = Dev->VirtIo->AllocateSharedPages (
+                          Dev->VirtIo,
+                          VBLK_SHARED_PAGES,
+                          &Dev->Shared
+                          );
+  if (EFI_ERROR (Status)) {
+    goto UnmapQueue;
+  }
+
+  Status = VirtioMapAllBytesInSharedBuffer (
+             Dev->VirtIo,
+             VirtioOperationBusMasterCommonBuffer,
+             Dev->Shared,
+             EFI_PAGES_TO_SIZE (VBLK_SHARED_PAGES),
+             &Dev->SharedAddress,
+             &Dev->SharedMap
+             );
+  if (EFI_ERROR (Status)) {
+    goto FreeShared;
+  }
+
+  ZeroMem (Dev->Shared, EFI_PAGES_TO_SIZE (VBLK_SHARED_PAGES));
+  Dev->SlotCount   = (UINT16)MIN (QueueSize / 3, VBLK_MAX_SLOTS);
+  Dev->InFlight    = 0;
+  Dev->LastUsedIdx = 0;
+  InitializeListHead (&Dev->PendingRequests);
+
+  //
+  // We're going to poll the answers, the host should not send interrupts.
+  //
+  *Dev->Ring.Avail.Flags = (UINT16)VRING_AVAIL_F_NO_INTERRUPT;
+
   //
   // step 6 -- initialization complete
   //
   NextDevStat |= VSTAT_DRIVER_OK;
   Status       = Dev->VirtIo->SetDeviceStatus (Dev->VirtIo, NextDevStat);
   if (EFI_ERROR (Status)) {
-    goto UnmapQueue;
+    goto UnmapShared;
   }
 
   //
@@ -950,6 +1398,12 @@ VirtioBlkInit (
                                          BlockSize / 512
                                          ) - 1;
 
+  Dev->BlockIo2.Media         = &Dev->BlockIoMedia;
+  Dev->BlockIo2.Reset         = &VirtioBlkResetEx;
+  Dev->BlockIo2.ReadBlocksEx  = &VirtioBlkReadBlocksEx;
+  Dev->BlockIo2.WriteBlocksEx = &VirtioBlkWriteBlocksEx;
+  Dev->BlockIo2.FlushBlocksEx = &VirtioBlkFlushBlocksEx;
+
   DEBUG ((
     DEBUG_INFO,
     "%a: LbaSize=0x%x[B] NumBlocks=0x%Lx[Lba]\n",
@@ -982,6 +1436,12 @@ VirtioBlkInit (
 
   return EFI_SUCCESS;
 
+UnmapShared:
+  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Dev->SharedMap);
+
+FreeShared:
+  Dev->VirtIo->FreeSharedPages (Dev->VirtIo, VBLK_SHARED_PAGES, Dev->Shared);
+
 UnmapQueue:
   Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Dev->RingMap);
 
@@ -1021,10 +1481,14 @@ VirtioBlkUninit (
   //
   Dev->VirtIo->SetDeviceStatus (Dev->VirtIo, 0);
 
+  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Dev->SharedMap);
+  Dev->VirtIo->FreeSharedPages (Dev->VirtIo, VBLK_SHARED_PAGES, Dev->Shared);
+
   Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Dev->RingMap);
   VirtioRingUninit (Dev->VirtIo, &Dev->Ring);
 
   SetMem (&Dev->BlockIo, sizeof Dev->BlockIo, 0x00);
+  SetMem (&Dev->BlockIo2, sizeof Dev->BlockIo2, 0x00);
   SetMem (&Dev->BlockIoMedia, sizeof Dev->BlockIoMedia, 0x00);
 }
 
@@ -1135,21 +1599,46 @@ VirtioBlkDriverBindingStart (
   }
 
   //
-  // Setup complete, attempt to export the driver instance's BlockIo interface.
+  // Start reaping the asynchronous requests.
+  //
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_NOTIFY,
+                  &VirtioBlkTimer,
+                  Dev,
+                  &Dev->Timer
+                  );
+  if (EFI_ERROR (Status)) {
+    goto CloseExitBoot;
+  }
+
+  Status = gBS->SetTimer (Dev->Timer, TimerPeriodic, VBLK_ASYNC_TIMER);
+  if (EFI_ERROR (Status)) {
+    goto CloseTimer;
+  }
+
+  //
+  // Setup complete, attempt to export the driver instance's BlockIo and
+  // BlockIo2 interfaces.
   //
   Dev->Signature = VBLK_SIG;
-  Status         = gBS->InstallProtocolInterface (
+  Status         = gBS->InstallMultipleProtocolInterfaces (
                           &DeviceHandle,
                           &gEfiBlockIoProtocolGuid,
-                          EFI_NATIVE_INTERFACE,
-                          &Dev->BlockIo
+                          &Dev->BlockIo,
+                          &gEfiBlockIo2ProtocolGuid,
+                          &Dev->BlockIo2,
+                          NULL
                           );
   if (EFI_ERROR (Status)) {
-    goto CloseExitBoot;
+    goto CloseTimer;
   }
 
   return EFI_SUCCESS;
 
+CloseTimer:
+  gBS->CloseEvent (Dev->Timer);
+
 CloseExitBoot:
   gBS->CloseEvent (Dev->ExitBoot);
 
@@ -1222,15 +1711,24 @@ VirtioBlkDriverBindingStop (
   //
   // Handle Stop() requests for in-use driver instances gracefully.
   //
-  Status = gBS->UninstallProtocolInterface (
+  Status = gBS->UninstallMultipleProtocolInterfaces (
                   DeviceHandle,
                   &gEfiBlockIoProtocolGuid,
-                  &Dev->BlockIo
+                  &Dev->BlockIo,
+                  &gEfiBlockIo2ProtocolGuid,
+                  &Dev->BlockIo2,
+                  NULL
                   );
   if (EFI_ERROR (Status)) {
     return Status;
   }
 
+  //
+  // Wait for the requests in flight, so that their buffers get unmapped.
+  //
+  AbortRequests (Dev);
+  gBS->CloseEvent (Dev->Timer);
+
   gBS->CloseEvent (Dev->ExitBoot);
 
   VirtioBlkUninit (Dev);
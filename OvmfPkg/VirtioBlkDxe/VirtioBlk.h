@@ -13,6 +13,7 @@
 #define _VIRTIO_BLK_DXE_H_
 
 #include <Protocol/BlockIo.h>
+#include <Protocol/BlockIo2.h>
 #include <Protocol/ComponentName.h>
 #include <Protocol/DriverBinding.h>
 
@@ -20,6 +21,39 @@
 
 #define VBLK_SIG  SIGNATURE_32 ('V', 'B', 'L', 'K')
 
+//
+// Maximum number of requests in flight on the virtqueue. Each one takes three
+// consecutive descriptors, starting at descriptor #(3 * slot).
+//
+#define VBLK_MAX_SLOTS  64
+
+//
+// Period of the timer that reaps asynchronous requests, in 100ns units.
+//
+#define VBLK_ASYNC_TIMER  EFI_TIMER_PERIOD_MILLISECONDS (1)
+
+#define VBLK_REQUEST_SIG  SIGNATURE_32 ('V', 'B', 'R', 'Q')
+
+//
+// A read / write / flush request, either waiting for a free slot on
+// VBLK_DEV.PendingRequests, or in flight in VBLK_DEV.Slots.
+//
+typedef struct {
+  UINT32                 Signature;
+  LIST_ENTRY             Link;
+  EFI_LBA                Lba;
+  UINTN                  BufferSize;
+  VOID                   *Buffer;
+  BOOLEAN                RequestIsWrite;
+  EFI_BLOCK_IO2_TOKEN    *Token;            // NULL for blocking requests
+  VOID                   *BufferMapping;
+  BOOLEAN                Done;              // blocking requests only
+  EFI_STATUS             Status;            // blocking requests only
+} VBLK_REQUEST;
+
+#define VBLK_REQUEST_FROM_LINK(LinkPointer) \
+        CR (LinkPointer, VBLK_REQUEST, Link, VBLK_REQUEST_SIG)
+
 typedef struct {
   //
   // Parts of this structure are initialized / torn down in various functions
@@ -35,11 +69,32 @@ typedef struct {
   EFI_BLOCK_IO_PROTOCOL     BlockIo;           // VirtioBlkInit       1
   EFI_BLOCK_IO_MEDIA        BlockIoMedia;      // VirtioBlkInit       1
   VOID                      *RingMap;          // VirtioRingMap       2
+  EFI_BLOCK_IO2_PROTOCOL    BlockIo2;          // VirtioBlkInit       1
+  VOID                      *Shared;           // VirtioBlkInit       1
+  VOID                      *SharedMap;        // VirtioBlkInit       1
+  EFI_PHYSICAL_ADDRESS      SharedAddress;     // VirtioBlkInit       1
+  UINT16                    SlotCount;         // VirtioBlkInit       1
+  UINT16                    InFlight;          // VirtioBlkInit       1
+  UINT16                    LastUsedIdx;       // VirtioBlkInit       1
+  VBLK_REQUEST              *Slots[VBLK_MAX_SLOTS]; // VirtioBlkInit       1
+  LIST_ENTRY                PendingRequests;   // VirtioBlkInit       1
+  EFI_EVENT                 Timer;             // DriverBindingStart  0
 } VBLK_DEV;
 
 #define VIRTIO_BLK_FROM_BLOCK_IO(BlockIoPointer) \
         CR (BlockIoPointer, VBLK_DEV, BlockIo, VBLK_SIG)
 
+#define VIRTIO_BLK_FROM_BLOCK_IO2(BlockIo2Pointer) \
+        CR (BlockIo2Pointer, VBLK_DEV, BlockIo2, VBLK_SIG)
+
+//
+// The request headers of all slots, followed by the host status bytes of all
+// slots, live in a single buffer that is shared with the device.
+//
+#define VBLK_SHARED_HEADER_OFFSET(Slot)  ((Slot) * sizeof (VIRTIO_BLK_REQ))
+#define VBLK_SHARED_STATUS_OFFSET(Slot)  (VBLK_MAX_SLOTS * sizeof (VIRTIO_BLK_REQ) + (Slot))
+#define VBLK_SHARED_PAGES                EFI_SIZE_TO_PAGES (VBLK_SHARED_STATUS_OFFSET (VBLK_MAX_SLOTS))
+
 /**
 
   Device probe function for this driver.
@@ -103,7 +158,8 @@ VirtioBlkDriverBindingSupported (
 
   @retval EFI_SUCCESS           Driver instance has been created and
                                 initialized  for the virtio-blk device, it
-                                is now accessible via EFI_BLOCK_IO_PROTOCOL.
+                                is now accessible via EFI_BLOCK_IO_PROTOCOL
+                                and EFI_BLOCK_IO2_PROTOCOL.
 
   @retval EFI_OUT_OF_RESOURCES  Memory allocation failed.
 
@@ -244,6 +300,47 @@ VirtioBlkFlushBlocks (
   IN EFI_BLOCK_IO_PROTOCOL  *This
   );
 
+//
+// UEFI Spec 2.3.1 + Errata C, 12.9 EFI Block I/O 2 Protocol
+// Driver Writer's Guide for UEFI 2.3.1 v1.01,
+//   24.3 Block I/O 2 Protocol Implementations
+//
+EFI_STATUS
+EFIAPI
+VirtioBlkResetEx (
+  IN EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN BOOLEAN                 ExtendedVerification
+  );
+
+EFI_STATUS
+EFIAPI
+VirtioBlkReadBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN     UINT32                  MediaId,
+  IN     EFI_LBA                 Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token,
+  IN     UINTN                   BufferSize,
+  OUT    VOID                    *Buffer
+  );
+
+EFI_STATUS
+EFIAPI
+VirtioBlkWriteBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN     UINT32                  MediaId,
+  IN     EFI_LBA                 Lba,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token,
+  IN     UINTN                   BufferSize,
+  IN     VOID                    *Buffer
+  );
+
+EFI_STATUS
+EFIAPI
+VirtioBlkFlushBlocksEx (
+  IN     EFI_BLOCK_IO2_PROTOCOL  *This,
+  IN OUT EFI_BLOCK_IO2_TOKEN     *Token
+  );
+
 //
 // The purpose of the following scaffolding (EFI_COMPONENT_NAME_PROTOCOL and
 // EFI_COMPONENT_NAME2_PROTOCOL implementation) is to format the driver's name
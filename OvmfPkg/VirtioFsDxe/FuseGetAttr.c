@@ -6,6 +6,8 @@
   SPDX-License-Identifier: BSD-2-Clause-Patent
 **/
 
+#include <Library/BaseLib.h> // MultU64x32()
+
 #include "VirtioFsDxe.h"
 
 /**
@@ -26,7 +28,12 @@
   @param[out] FuseAttr     The VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE object
                            describing the properties of the inode.
 
-  @retval EFI_SUCCESS  FuseAttr has been filled in.
+  @param[out] AttrValid    The time, in 100ns units, for which the Virtio
+                           Filesystem device allows FuseAttr to be cached. Zero
+                           means that FuseAttr must not be cached.
+
+  @retval EFI_SUCCESS  FuseAttr (and AttrValid, if requested) have been filled
+                       in.
 
   @return              The "errno" value mapped to an EFI_STATUS code, if the
                        Virtio Filesystem device explicitly reported an error.
@@ -39,7 +46,8 @@ EFI_STATUS
 VirtioFsFuseGetAttr (
   IN OUT VIRTIO_FS                        *VirtioFs,
   IN     UINT64                           NodeId,
-  OUT VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  *FuseAttr
+  OUT VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  *FuseAttr,
+  OUT UINT64                              *AttrValid OPTIONAL
   )
 {
   VIRTIO_FS_FUSE_REQUEST           CommonReq;
@@ -124,5 +132,17 @@ VirtioFsFuseGetAttr (
     Status = VirtioFsErrnoToEfiStatus (CommonResp.Error);
   }
 
+  if (!EFI_ERROR (Status) && (AttrValid != NULL)) {
+    //
+    // Convert the timeout to 100ns units, saturating it at about 58000 years.
+    //
+    if (GetAttrResp.AttrValid > DivU64x32 (MAX_UINT64, 10000000) - 1) {
+      *AttrValid = MAX_UINT64;
+    } else {
+      *AttrValid = MultU64x32 (GetAttrResp.AttrValid, 10000000) +
+                   GetAttrResp.AttrValidNsec / 100;
+    }
+  }
+
   return Status;
 }
@@ -6,11 +6,12 @@
   SPDX-License-Identifier: BSD-2-Clause-Patent
 **/
 
-#include <Library/BaseLib.h>             // StrLen()
-#include <Library/BaseMemoryLib.h>       // CopyMem()
-#include <Library/MemoryAllocationLib.h> // AllocatePool()
-#include <Library/TimeBaseLib.h>         // EpochToEfiTime()
-#include <Library/VirtioLib.h>           // Virtio10WriteFeatures()
+#include <Library/BaseLib.h>                  // StrLen()
+#include <Library/BaseMemoryLib.h>            // CopyMem()
+#include <Library/MemoryAllocationLib.h>      // AllocatePool()
+#include <Library/TimeBaseLib.h>              // EpochToEfiTime()
+#include <Library/UefiBootServicesTableLib.h> // gBS
+#include <Library/VirtioLib.h>                // Virtio10WriteFeatures()
 
 #include "VirtioFsDxe.h"
 
@@ -2061,6 +2062,112 @@ FreeDestSuffix16:
   return Status;
 }
 
+/**
+  Fetch the attributes of an open file, from the attribute cache of the file
+  if the cached attributes have not expired yet.
+
+  @param[in,out] VirtioFsFile  The VIRTIO_FS_FILE whose attributes should be
+                               retrieved. On output, the attribute cache of the
+                               file may have been refreshed.
+
+  @param[out] FuseAttr         The VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE object
+                               describing the properties of the file.
+
+  @retval EFI_SUCCESS  FuseAttr has been filled in.
+
+  @return              Error codes propagated from VirtioFsFuseGetAttr().
+**/
+EFI_STATUS
+VirtioFsGetFileAttr (
+  IN OUT VIRTIO_FS_FILE                   *VirtioFsFile,
+  OUT VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  *FuseAttr
+  )
+{
+  EFI_STATUS  Status;
+  UINT64      AttrValid;
+
+  if (VirtioFsFile->CachedAttrValid &&
+      (gBS->CheckEvent (VirtioFsFile->CachedAttrTimer) == EFI_NOT_READY))
+  {
+    CopyMem (FuseAttr, &VirtioFsFile->CachedAttr, sizeof *FuseAttr);
+    return EFI_SUCCESS;
+  }
+
+  VirtioFsFile->CachedAttrValid = FALSE;
+
+  Status = VirtioFsFuseGetAttr (
+             VirtioFsFile->OwnerFs,
+             VirtioFsFile->NodeId,
+             FuseAttr,
+             &AttrValid
+             );
+  if (EFI_ERROR (Status) || (AttrValid == 0)) {
+    return Status;
+  }
+
+  //
+  // The Virtio Filesystem device allows caching the attributes. Failing to
+  // arm the expiry timer only means that they are not cached.
+  //
+  if (VirtioFsFile->CachedAttrTimer == NULL) {
+    if (EFI_ERROR (
+          gBS->CreateEvent (
+                 EVT_TIMER,
+                 TPL_CALLBACK,
+                 NULL,
+                 NULL,
+                 &VirtioFsFile->CachedAttrTimer
+                 )
+          ))
+    {
+      VirtioFsFile->CachedAttrTimer = NULL;
+      return EFI_SUCCESS;
+    }
+  }
+
+  if (!EFI_ERROR (
+         gBS->SetTimer (
+                VirtioFsFile->CachedAttrTimer,
+                TimerRelative,
+                AttrValid
+                )
+         ))
+  {
+    CopyMem (&VirtioFsFile->CachedAttr, FuseAttr, sizeof *FuseAttr);
+    VirtioFsFile->CachedAttrValid = TRUE;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Drop the cached attributes and the read-ahead data of every file open on the
+  Virtio Filesystem that refers to a given inode. This function must be called
+  after the inode is modified.
+
+  @param[in,out] VirtioFs  The Virtio Filesystem whose open files should be
+                           checked.
+
+  @param[in] NodeId        The inode number of the modified file.
+**/
+VOID
+VirtioFsInvalidateFileCaches (
+  IN OUT VIRTIO_FS  *VirtioFs,
+  IN     UINT64     NodeId
+  )
+{
+  LIST_ENTRY      *Entry;
+  VIRTIO_FS_FILE  *VirtioFsFile;
+
+  BASE_LIST_FOR_EACH (Entry, &VirtioFs->OpenFiles) {
+    VirtioFsFile = VIRTIO_FS_FILE_FROM_OPEN_FILES_ENTRY (Entry);
+    if (VirtioFsFile->NodeId == NodeId) {
+      VirtioFsFile->CachedAttrValid = FALSE;
+      VirtioFsFile->ReadAheadFill   = 0;
+    }
+  }
+}
+
 /**
   Convert select fields of a VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE object to
   corresponding fields in EFI_FILE_INFO.
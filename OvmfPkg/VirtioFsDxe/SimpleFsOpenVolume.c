@@ -82,6 +82,11 @@ VirtioFsOpenVolume (
   VirtioFsFile->SingleFileInfoSize     = 0;
   VirtioFsFile->NumFileInfo            = 0;
   VirtioFsFile->NextFileInfo           = 0;
+  VirtioFsFile->CachedAttrValid        = FALSE;
+  VirtioFsFile->CachedAttrTimer        = NULL;
+  VirtioFsFile->ReadAhead              = NULL;
+  VirtioFsFile->ReadAheadOffset        = 0;
+  VirtioFsFile->ReadAheadFill          = 0;
 
   //
   // One more file open for the filesystem.
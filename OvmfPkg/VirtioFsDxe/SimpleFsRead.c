@@ -378,32 +378,89 @@ ReadRegularFile (
   VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  FuseAttr;
   UINTN                               Transferred;
   UINTN                               Left;
+  UINT32                              ReadAheadSize;
 
   VirtioFs = VirtioFsFile->OwnerFs;
   //
   // The UEFI spec forbids reads that start beyond the end of the file.
   //
-  Status = VirtioFsFuseGetAttr (VirtioFs, VirtioFsFile->NodeId, &FuseAttr);
+  Status = VirtioFsGetFileAttr (VirtioFsFile, &FuseAttr);
   if (EFI_ERROR (Status) || (VirtioFsFile->FilePosition > FuseAttr.Size)) {
     return EFI_DEVICE_ERROR;
   }
 
+  ReadAheadSize = MIN (VirtioFs->MaxRead, VIRTIO_FS_FILE_MAX_READ_AHEAD);
+
   Status      = EFI_SUCCESS;
   Transferred = 0;
   Left        = *BufferSize;
   while (Left > 0) {
+    UINT64  Position;
     UINT32  ReadSize;
 
+    Position = VirtioFsFile->FilePosition + Transferred;
+
+    //
+    // Serve as much as possible from the read-ahead buffer.
+    //
+    if ((Position >= VirtioFsFile->ReadAheadOffset) &&
+        (Position - VirtioFsFile->ReadAheadOffset < VirtioFsFile->ReadAheadFill))
+    {
+      ReadSize = (UINT32)MIN (
+                           VirtioFsFile->ReadAheadOffset + VirtioFsFile->ReadAheadFill - Position,
+                           Left
+                           );
+      CopyMem (
+        (UINT8 *)Buffer + Transferred,
+        VirtioFsFile->ReadAhead + (UINTN)(Position - VirtioFsFile->ReadAheadOffset),
+        ReadSize
+        );
+      Transferred += ReadSize;
+      Left        -= ReadSize;
+      continue;
+    }
+
+    //
+    // Refill the read-ahead buffer if the rest of the request is smaller than
+    // the buffer. If the buffer cannot be allocated, read directly.
+    //
+    if (Left < ReadAheadSize) {
+      if (VirtioFsFile->ReadAhead == NULL) {
+        VirtioFsFile->ReadAhead = AllocatePool (ReadAheadSize);
+      }
+
+      if (VirtioFsFile->ReadAhead != NULL) {
+        VirtioFsFile->ReadAheadFill = 0;
+        ReadSize                    = ReadAheadSize;
+        Status                      = VirtioFsFuseReadFileOrDir (
+                                        VirtioFs,
+                                        VirtioFsFile->NodeId,
+                                        VirtioFsFile->FuseHandle,
+                                        FALSE, // IsDir
+                                        Position,
+                                        &ReadSize,
+                                        VirtioFsFile->ReadAhead
+                                        );
+        if (EFI_ERROR (Status) || (ReadSize == 0)) {
+          break;
+        }
+
+        VirtioFsFile->ReadAheadOffset = Position;
+        VirtioFsFile->ReadAheadFill   = ReadSize;
+        continue;
+      }
+    }
+
     //
-    // FUSE_READ cannot express a >=4GB buffer size.
+    // Honor the read buffer size limit.
     //
-    ReadSize = (UINT32)MIN ((UINTN)MAX_UINT32, Left);
+    ReadSize = (UINT32)MIN ((UINTN)VirtioFs->MaxRead, Left);
     Status   = VirtioFsFuseReadFileOrDir (
                  VirtioFs,
                  VirtioFsFile->NodeId,
                  VirtioFsFile->FuseHandle,
                  FALSE,                                  // IsDir
-                 VirtioFsFile->FilePosition + Transferred,
+                 Position,
                  &ReadSize,
                  (UINT8 *)Buffer + Transferred
                  );
@@ -383,7 +383,7 @@ UpdateAttributes (
   // Fetch the current attributes first, so we can build the difference between
   // them and NewFileInfo.
   //
-  Status = VirtioFsFuseGetAttr (VirtioFs, VirtioFsFile->NodeId, &FuseAttr);
+  Status = VirtioFsFuseGetAttr (VirtioFs, VirtioFsFile->NodeId, &FuseAttr, NULL);
   if (EFI_ERROR (Status)) {
     return Status;
   }
@@ -507,6 +507,7 @@ SetFileInfo (
   // Update any attributes requested.
   //
   Status = UpdateAttributes (VirtioFsFile, FileInfo);
+  VirtioFsInvalidateFileCaches (VirtioFsFile->OwnerFs, VirtioFsFile->NodeId);
   //
   // The UEFI spec does not speak about partial failure in
   // EFI_FILE_PROTOCOL.SetInfo(); we won't try to roll back the rename (if
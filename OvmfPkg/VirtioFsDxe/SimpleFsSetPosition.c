@@ -19,7 +19,6 @@ VirtioFsSimpleFileSetPosition (
   )
 {
   VIRTIO_FS_FILE                      *VirtioFsFile;
-  VIRTIO_FS                           *VirtioFs;
   EFI_STATUS                          Status;
   VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  FuseAttr;
 
@@ -59,8 +58,7 @@ VirtioFsSimpleFileSetPosition (
   //
   // Caller is requesting a seek to EOF.
   //
-  VirtioFs = VirtioFsFile->OwnerFs;
-  Status   = VirtioFsFuseGetAttr (VirtioFs, VirtioFsFile->NodeId, &FuseAttr);
+  Status = VirtioFsGetFileAttr (VirtioFsFile, &FuseAttr);
   if (EFI_ERROR (Status)) {
     return Status;
   }
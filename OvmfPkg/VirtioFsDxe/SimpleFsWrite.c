@@ -68,6 +68,7 @@ VirtioFsSimpleFileWrite (
 
   *BufferSize                 = Transferred;
   VirtioFsFile->FilePosition += Transferred;
+  VirtioFsInvalidateFileCaches (VirtioFs, VirtioFsFile->NodeId);
   //
   // According to the UEFI spec,
   //
@@ -52,6 +52,11 @@
 //
 #define VIRTIO_FS_FILE_MAX_FILE_INFO  256
 
+//
+// Maximum size of the read-ahead buffer of a regular file, VIRTIO_FS_FILE.ReadAhead.
+//
+#define VIRTIO_FS_FILE_MAX_READ_AHEAD  SIZE_1MB
+
 //
 // Filesystem label encoded in UCS-2, transformed from the UTF-8 representation
 // in "VIRTIO_FS_CONFIG.Tag", and NUL-terminated. Only the printable ASCII code
@@ -79,6 +84,7 @@ typedef struct {
   VOID                               *RingMap;  // VirtioRingMap       2
   UINT64                             RequestId; // FuseInitSession     1
   UINT32                             MaxWrite;  // FuseInitSession     1
+  UINT32                             MaxRead;   // FuseInitSession     1
   EFI_EVENT                          ExitBoot;  // DriverBindingStart  0
   LIST_ENTRY                         OpenFiles; // DriverBindingStart  0
   EFI_SIMPLE_FILE_SYSTEM_PROTOCOL    SimpleFs;  // DriverBindingStart  0
@@ -174,6 +180,23 @@ typedef struct {
   UINTN    SingleFileInfoSize;
   UINTN    NumFileInfo;
   UINTN    NextFileInfo;
+  //
+  // Attributes of the file, cached for as long as the Virtio Filesystem device
+  // allowed in the FUSE_GETATTR response. CachedAttrTimer is signaled when the
+  // cached attributes expire.
+  //
+  VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE    CachedAttr;
+  BOOLEAN                               CachedAttrValid;
+  EFI_EVENT                             CachedAttrTimer;
+  //
+  // Read-ahead buffer for a regular file. Reads that are smaller than the
+  // buffer are served from it, so that a caller reading a file in small pieces
+  // does not send a FUSE_READ request for every piece. ReadAheadFill bytes of
+  // the file, starting at ReadAheadOffset, are valid in ReadAhead.
+  //
+  UINT8     *ReadAhead;
+  UINT64    ReadAheadOffset;
+  UINT32    ReadAheadFill;
 } VIRTIO_FS_FILE;
 
 #define VIRTIO_FS_FILE_FROM_SIMPLE_FILE(SimpleFileReference) \
@@ -270,6 +293,18 @@ VirtioFsComposeRenameDestination (
   OUT BOOLEAN    *RootEscape
   );
 
+EFI_STATUS
+VirtioFsGetFileAttr (
+  IN OUT VIRTIO_FS_FILE                   *VirtioFsFile,
+  OUT VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  *FuseAttr
+  );
+
+VOID
+VirtioFsInvalidateFileCaches (
+  IN OUT VIRTIO_FS  *VirtioFs,
+  IN     UINT64     NodeId
+  );
+
 EFI_STATUS
 VirtioFsFuseAttrToEfiFileInfo (
   IN     VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  *FuseAttr,
@@ -331,7 +366,8 @@ EFI_STATUS
 VirtioFsFuseGetAttr (
   IN OUT VIRTIO_FS                        *VirtioFs,
   IN     UINT64                           NodeId,
-  OUT VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  *FuseAttr
+  OUT VIRTIO_FS_FUSE_ATTRIBUTES_RESPONSE  *FuseAttr,
+  OUT UINT64                              *AttrValid OPTIONAL
   );
 
 EFI_STATUS
@@ -9,6 +9,7 @@
 
 **/
 
+#include <Library/UefiBootServicesTableLib.h>
 #include <Library/VirtioLib.h>
 
 #include "VirtioGpu.h"
@@ -356,6 +357,15 @@ VirtioGpuExitBoot (
 
   DEBUG ((DEBUG_VERBOSE, "%a: Context=0x%p\n", __func__, Context));
   VgpuDev = Context;
+
+  //
+  // Make sure no batched display update is submitted to the reset device.
+  //
+  if ((VgpuDev->Child != NULL) && (VgpuDev->Child->FlushTimer != NULL)) {
+    gBS->SetTimer (VgpuDev->Child->FlushTimer, TimerCancel, 0);
+    VgpuDev->Child->Damaged = FALSE;
+  }
+
   VgpuDev->VirtIo->SetDeviceStatus (VgpuDev->VirtIo, 0);
 }
 
@@ -9,8 +9,10 @@
 
 **/
 
+#include <Library/BaseLib.h>
 #include <Library/DevicePathLib.h>
 #include <Library/MemoryAllocationLib.h>
+#include <Library/PcdLib.h>
 #include <Library/PrintLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiLib.h>
@@ -331,6 +333,7 @@ InitVgpuGop (
   CHAR16               *Name;
   EFI_TPL              OldTpl;
   VOID                 *ParentVirtIo;
+  UINT32               FlushRate;
 
   VgpuGop = AllocateZeroPool (sizeof *VgpuGop);
   if (VgpuGop == NULL) {
@@ -433,6 +436,24 @@ InitVgpuGop (
     goto CloseVirtIoByChild;
   }
 
+  //
+  // Set up the timer that batches the display updates, if requested.
+  //
+  FlushRate = PcdGet32 (PcdVirtioGpuFlushRate);
+  if (FlushRate != 0) {
+    VgpuGop->FlushPeriod = DivU64x32 (EFI_TIMER_PERIOD_SECONDS (1), FlushRate);
+    Status               = gBS->CreateEvent (
+                                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                                  TPL_NOTIFY,
+                                  GopFlushDamage,
+                                  VgpuGop,
+                                  &VgpuGop->FlushTimer
+                                  );
+    if (EFI_ERROR (Status)) {
+      goto UninitGop;
+    }
+  }
+
   //
   // Install the Graphics Output Protocol on the child handle.
   //
@@ -443,7 +464,7 @@ InitVgpuGop (
                   &VgpuGop->Gop
                   );
   if (EFI_ERROR (Status)) {
-    goto UninitGop;
+    goto CloseFlushTimer;
   }
 
   //
@@ -453,6 +474,11 @@ InitVgpuGop (
   ParentBus->Child = VgpuGop;
   return EFI_SUCCESS;
 
+CloseFlushTimer:
+  if (VgpuGop->FlushTimer != NULL) {
+    gBS->CloseEvent (VgpuGop->FlushTimer);
+  }
+
 UninitGop:
   ReleaseGopResources (VgpuGop, TRUE /* DisableHead */);
 
@@ -523,6 +549,14 @@ UninitVgpuGop (
                    );
   ASSERT_EFI_ERROR (Status);
 
+  //
+  // Drop the display updates not submitted yet, the resource goes away.
+  //
+  if (VgpuGop->FlushTimer != NULL) {
+    Status = gBS->CloseEvent (VgpuGop->FlushTimer);
+    ASSERT_EFI_ERROR (Status);
+  }
+
   //
   // Uninitialize VgpuGop->Gop.
   //
@@ -10,6 +10,7 @@
 
 #include <Library/MemoryAllocationLib.h>
 #include <Library/PcdLib.h>
+#include <Library/UefiBootServicesTableLib.h>
 
 #include "VirtioGpu.h"
 
@@ -139,6 +140,68 @@ ReleaseGopResources (
   VgpuGop->ResourceId = 0;
 }
 
+/**
+  Submit the damaged rectangle of the display to the host, and flush it to
+  head (scanout) #0.
+
+  This is the notification function of VGPU_GOP.FlushTimer, and it must be
+  called at TPL_NOTIFY.
+
+  @param[in] Event    Event whose notification function is being invoked.
+
+  @param[in] Context  Pointer to the associated VGPU_GOP object.
+**/
+VOID
+EFIAPI
+GopFlushDamage (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  VGPU_GOP    *VgpuGop;
+  UINT32      Width;
+  UINT32      Height;
+  UINT64      ResourceOffset;
+  EFI_STATUS  Status;
+
+  VgpuGop = Context;
+  if (!VgpuGop->Damaged) {
+    return;
+  }
+
+  VgpuGop->Damaged = FALSE;
+  Width            = VgpuGop->DamageRight - VgpuGop->DamageLeft;
+  Height           = VgpuGop->DamageBottom - VgpuGop->DamageTop;
+  ResourceOffset   = sizeof (UINT32) *
+                     ((UINT64)VgpuGop->DamageTop *
+                      VgpuGop->GopModeInfo.HorizontalResolution +
+                      VgpuGop->DamageLeft);
+
+  Status = VirtioGpuTransferToHost2d (
+             VgpuGop->ParentBus,   // VgpuDev
+             VgpuGop->DamageLeft,  // X
+             VgpuGop->DamageTop,   // Y
+             Width,                // Width
+             Height,               // Height
+             ResourceOffset,       // Offset
+             VgpuGop->ResourceId   // ResourceId
+             );
+  if (!EFI_ERROR (Status)) {
+    Status = VirtioGpuResourceFlush (
+               VgpuGop->ParentBus,   // VgpuDev
+               VgpuGop->DamageLeft,  // X
+               VgpuGop->DamageTop,   // Y
+               Width,                // Width
+               Height,               // Height
+               VgpuGop->ResourceId   // ResourceId
+               );
+  }
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: %r\n", __func__, Status));
+  }
+}
+
 //
 // The resolutions supported by this driver.
 //
@@ -355,6 +418,7 @@ GopSetMode (
   VOID                                  *NewBackingStoreMap;
   UINTN                                 SizeOfInfo;
   EFI_GRAPHICS_OUTPUT_MODE_INFORMATION  *GopModeInfo;
+  EFI_TPL                               OldTpl;
 
   EFI_STATUS  Status;
   EFI_STATUS  Status2;
@@ -371,6 +435,15 @@ GopSetMode (
 
   VgpuGop = VGPU_GOP_FROM_GOP (This);
 
+  //
+  // Submit the pending updates of the current resource, so that they are not
+  // lost if we have to keep it. Once Damaged is FALSE, FlushTimer sends no
+  // commands that could interfere with ours.
+  //
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  GopFlushDamage (NULL, VgpuGop);
+  gBS->RestoreTPL (OldTpl);
+
   //
   // Distinguish the first (internal) call from the other (protocol consumer)
   // calls.
@@ -566,6 +639,7 @@ GopBlt (
   UINTN       Y;
   UINTN       ResourceOffset;
   EFI_STATUS  Status;
+  EFI_TPL     OldTpl;
 
   VgpuGop           = VGPU_GOP_FROM_GOP (This);
   CurrentHorizontal = VgpuGop->GopModeInfo.HorizontalResolution;
@@ -731,6 +805,34 @@ GopBlt (
       return EFI_INVALID_PARAMETER;
   }
 
+  //
+  // If updates are batched, add the updated area to the damaged rectangle,
+  // and arm FlushTimer to submit it if it was empty.
+  //
+  if (VgpuGop->FlushTimer != NULL) {
+    if ((Width == 0) || (Height == 0)) {
+      return EFI_SUCCESS;
+    }
+
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    if (!VgpuGop->Damaged) {
+      VgpuGop->Damaged      = TRUE;
+      VgpuGop->DamageLeft   = (UINT32)DestinationX;
+      VgpuGop->DamageTop    = (UINT32)DestinationY;
+      VgpuGop->DamageRight  = (UINT32)(DestinationX + Width);
+      VgpuGop->DamageBottom = (UINT32)(DestinationY + Height);
+      gBS->SetTimer (VgpuGop->FlushTimer, TimerRelative, VgpuGop->FlushPeriod);
+    } else {
+      VgpuGop->DamageLeft   = MIN (VgpuGop->DamageLeft, (UINT32)DestinationX);
+      VgpuGop->DamageTop    = MIN (VgpuGop->DamageTop, (UINT32)DestinationY);
+      VgpuGop->DamageRight  = MAX (VgpuGop->DamageRight, (UINT32)(DestinationX + Width));
+      VgpuGop->DamageBottom = MAX (VgpuGop->DamageBottom, (UINT32)(DestinationY + Height));
+    }
+
+    gBS->RestoreTPL (OldTpl);
+    return EFI_SUCCESS;
+  }
+
   //
   // For operations that wrote to the display, submit the updated area to the
   // host -- update the host resource from guest memory.
@@ -157,6 +157,26 @@ struct VGPU_GOP_STRUCT {
   //
   UINT32                                  NativeXRes;
   UINT32                                  NativeYRes;
+
+  //
+  // One-shot timer that submits the damaged rectangle to the host, armed by
+  // the first Blt() that writes to the display after the last submission.
+  // NULL if PcdVirtioGpuFlushRate is zero, in which case Blt() submits every
+  // update itself. FlushPeriod is in 100ns units.
+  //
+  EFI_EVENT                               FlushTimer;
+  UINT64                                  FlushPeriod;
+
+  //
+  // Bounding rectangle of the display updates not yet submitted to the host,
+  // valid if Damaged is TRUE. DamageRight and DamageBottom are exclusive.
+  // Only accessed at TPL_NOTIFY.
+  //
+  BOOLEAN                                 Damaged;
+  UINT32                                  DamageLeft;
+  UINT32                                  DamageTop;
+  UINT32                                  DamageRight;
+  UINT32                                  DamageBottom;
 };
 
 //
@@ -407,6 +427,24 @@ ReleaseGopResources (
   IN     BOOLEAN   DisableHead
   );
 
+/**
+  Submit the damaged rectangle of the display to the host, and flush it to
+  head (scanout) #0.
+
+  This is the notification function of VGPU_GOP.FlushTimer, and it must be
+  called at TPL_NOTIFY.
+
+  @param[in] Event    Event whose notification function is being invoked.
+
+  @param[in] Context  Pointer to the associated VGPU_GOP object.
+**/
+VOID
+EFIAPI
+GopFlushDamage (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  );
+
 //
 // Template for initializing VGPU_GOP.Gop.
 //
@@ -0,0 +1,61 @@
+/** @file
+
+  Implementation of the EDK II Network Checksum Offload Protocol member
+  function.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Library/UefiBootServicesTableLib.h>
+
+#include "VirtioNet.h"
+
+/**
+  Return which checksums of the frame most recently returned by
+  VirtioNetReceive() the device has validated.
+
+  @param[in]  This            The EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL
+                              instance.
+  @param[in]  RxData          The Buffer passed to the most recent successful
+                              call to VirtioNetReceive().
+  @param[out] ChecksumStatus  A combination of EDKII_NETWORK_RX_CHECKSUM_*
+                              flags.
+
+  @retval EFI_SUCCESS            ChecksumStatus was returned.
+  @retval EFI_INVALID_PARAMETER  RxData or ChecksumStatus is NULL.
+  @retval EFI_NOT_FOUND          RxData is not the most recently received
+                                 frame.
+**/
+EFI_STATUS
+EFIAPI
+VirtioNetGetRxChecksumStatus (
+  IN  EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL  *This,
+  IN  VOID                                     *RxData,
+  OUT UINT32                                   *ChecksumStatus
+  )
+{
+  VNET_DEV    *Dev;
+  EFI_TPL     OldTpl;
+  EFI_STATUS  Status;
+
+  if ((This == NULL) || (RxData == NULL) || (ChecksumStatus == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Dev    = VIRTIO_NET_FROM_CHECKSUM_OFFLOAD (This);
+  OldTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  if ((Dev->Snm.State != EfiSimpleNetworkInitialized) ||
+      (RxData != Dev->RxLastBuffer))
+  {
+    Status = EFI_NOT_FOUND;
+  } else {
+    *ChecksumStatus = Dev->RxLastChecksumStatus;
+    Status          = EFI_SUCCESS;
+  }
+
+  gBS->RestoreTPL (OldTpl);
+  return Status;
+}
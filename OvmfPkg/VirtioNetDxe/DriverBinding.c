@@ -223,6 +223,9 @@ VirtioNetSnpPopulate (
   Dev->Snm.MacAddressChangeable = FALSE;
   Dev->Snm.MultipleTxSupported  = TRUE;
 
+  Dev->ChecksumOffload.RxCapabilities      = EDKII_NETWORK_RX_CHECKSUM_L4_VALID;
+  Dev->ChecksumOffload.GetRxChecksumStatus = &VirtioNetGetRxChecksumStatus;
+
   ASSERT (SIZE_OF_VNET (Mac) <= sizeof (EFI_MAC_ADDRESS));
 
   Status = VirtioNetGetFeatures (
@@ -531,6 +534,8 @@ VirtioNetDriverBindingStart (
                   &Dev->MacHandle,
                   &gEfiSimpleNetworkProtocolGuid,
                   &Dev->Snp,
+                  &gEdkiiNetworkChecksumOffloadProtocolGuid,
+                  &Dev->ChecksumOffload,
                   &gEfiDevicePathProtocolGuid,
                   Dev->MacDevicePath,
                   NULL
@@ -562,6 +567,8 @@ UninstallMultiple:
          Dev->MacHandle,
          &gEfiDevicePathProtocolGuid,
          Dev->MacDevicePath,
+         &gEdkiiNetworkChecksumOffloadProtocolGuid,
+         &Dev->ChecksumOffload,
          &gEfiSimpleNetworkProtocolGuid,
          &Dev->Snp,
          NULL
@@ -675,6 +682,8 @@ VirtioNetDriverBindingStop (
              Dev->MacHandle,
              &gEfiDevicePathProtocolGuid,
              Dev->MacDevicePath,
+             &gEdkiiNetworkChecksumOffloadProtocolGuid,
+             &Dev->ChecksumOffload,
              &gEfiSimpleNetworkProtocolGuid,
              &Dev->Snp,
              NULL
@@ -14,6 +14,7 @@
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/MemoryAllocationLib.h>
+#include <Library/PcdLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 
 #include "VirtioNet.h"
@@ -214,9 +215,10 @@ VirtioNetInitTx (
 
   //
   // In VirtIo 1.0, the NumBuffers field is mandatory. In 0.9.5, it depends on
-  // VIRTIO_NET_F_MRG_RXBUF, which we never negotiate.
+  // VIRTIO_NET_F_MRG_RXBUF.
   //
-  TxSharedReqSize = (Dev->VirtIo->Revision < VIRTIO_SPEC_REVISION (1, 0, 0)) ?
+  TxSharedReqSize = ((Dev->VirtIo->Revision < VIRTIO_SPEC_REVISION (1, 0, 0)) &&
+                     !Dev->RxMergeable) ?
                     sizeof (Dev->TxSharedReq->V0_9_5) :
                     sizeof *Dev->TxSharedReq;
 
@@ -294,7 +296,7 @@ FreeTxFreeStack:
     packet data into,
   - select polling over RX interrupt,
   - fully populate the RX queue with a static pattern of virtio descriptor
-    chains.
+    chains (or single descriptors, with VIRTIO_NET_F_MRG_RXBUF).
 
   @param[in,out] Dev       The VNET_DEV driver instance about to enter the
                            EfiSimpleNetworkInitialized state.
@@ -316,6 +318,7 @@ VirtioNetInitRx (
   UINTN                 VirtioNetReqSize;
   UINTN                 RxBufSize;
   UINT16                RxAlwaysPending;
+  UINT16                DescPerPkt;
   UINTN                 PktIdx;
   UINT16                DescIdx;
   UINTN                 NumBytes;
@@ -324,26 +327,33 @@ VirtioNetInitRx (
 
   //
   // In VirtIo 1.0, the NumBuffers field is mandatory. In 0.9.5, it depends on
-  // VIRTIO_NET_F_MRG_RXBUF, which we never negotiate.
+  // VIRTIO_NET_F_MRG_RXBUF.
   //
-  VirtioNetReqSize = (Dev->VirtIo->Revision < VIRTIO_SPEC_REVISION (1, 0, 0)) ?
+  VirtioNetReqSize = ((Dev->VirtIo->Revision < VIRTIO_SPEC_REVISION (1, 0, 0)) &&
+                      !Dev->RxMergeable) ?
                      sizeof (VIRTIO_NET_REQ) :
                      sizeof (VIRTIO_1_0_NET_REQ);
 
   //
-  // For each incoming packet we must supply two descriptors:
-  // - the recipient for the virtio-net request header, plus
-  // - the recipient for the network data (which consists of Ethernet header
-  //   and Ethernet payload).
+  // Each incoming packet needs room for the virtio-net request header, plus
+  // the network data (which consists of Ethernet header and Ethernet
+  // payload). Without VIRTIO_NET_F_MRG_RXBUF, we must supply two descriptors
+  // per packet, one for each part. With it, a single descriptor covers both.
   //
   RxBufSize = VirtioNetReqSize +
               (Dev->Snm.MediaHeaderSize + Dev->Snm.MaxPacketSize);
+  DescPerPkt = Dev->RxMergeable ? 1 : 2;
 
   //
-  // Limit the number of pending RX packets if the queue is big. The division
-  // by two is due to the above "two descriptors per packet" trait.
+  // Limit the number of pending RX packets if the queue is big.
   //
-  RxAlwaysPending = (UINT16)MIN (Dev->RxRing.QueueSize / 2, VNET_MAX_PENDING);
+  RxAlwaysPending = (UINT16)MIN (
+                              Dev->RxRing.QueueSize / DescPerPkt,
+                              PcdGet16 (PcdVirtioNetRxRingSize)
+                              );
+  if (RxAlwaysPending == 0) {
+    RxAlwaysPending = 1;
+  }
 
   //
   // The RxBuf is shared between guest and hypervisor, use
@@ -385,6 +395,11 @@ VirtioNetInitRx (
   Dev->RxLastUsed = *Dev->RxRing.Used.Idx;
   ASSERT (Dev->RxLastUsed == 0);
 
+  Dev->RxMaxPending        = RxAlwaysPending;
+  Dev->RxPendingNotify      = 0;
+  Dev->RxLastBuffer         = NULL;
+  Dev->RxLastChecksumStatus = 0;
+
   //
   // virtio-0.9.5, 2.4.2 Receiving Used Buffers From the Device:
   // the host should not send interrupts, we'll poll in VirtioNetReceive()
@@ -393,8 +408,9 @@ VirtioNetInitRx (
   *Dev->RxRing.Avail.Flags = (UINT16)VRING_AVAIL_F_NO_INTERRUPT;
 
   //
-  // now set up a separate, two-part descriptor chain for each RX packet, and
-  // link each chain into (from) the available ring as well
+  // now set up a separate descriptor chain for each RX packet -- two-part, or
+  // a single descriptor for mergeable buffers --, and link each chain into
+  // (from) the available ring as well
   //
   DescIdx            = 0;
   RxBufDeviceAddress = Dev->RxBufDeviceBase;
@@ -405,6 +421,14 @@ VirtioNetInitRx (
     //
     Dev->RxRing.Avail.Ring[PktIdx] = DescIdx;
 
+    if (Dev->RxMergeable) {
+      Dev->RxRing.Desc[DescIdx].Addr  = RxBufDeviceAddress;
+      Dev->RxRing.Desc[DescIdx].Len   = (UINT32)RxBufSize;
+      Dev->RxRing.Desc[DescIdx].Flags = VRING_DESC_F_WRITE;
+      RxBufDeviceAddress             += Dev->RxRing.Desc[DescIdx++].Len;
+      continue;
+    }
+
     //
     // virtio-0.9.5, 2.4.1.1 Placing Buffers into the Descriptor Table
     //
@@ -557,8 +581,17 @@ VirtioNetInitialize (
     !!(Features & VIRTIO_NET_F_STATUS)
     );
 
+  //
+  // VIRTIO_NET_F_GUEST_CSUM lets the device tell us which Rx packets have had
+  // their checksums validated; see VirtioNetReceive(). We don't negotiate any
+  // of the receive offloads that depend on it.
+  //
+  // VIRTIO_NET_F_MRG_RXBUF lets us post each Rx buffer as a single
+  // descriptor, which doubles the number of packets the Rx queue can hold.
+  //
   Features &= VIRTIO_NET_F_MAC | VIRTIO_NET_F_STATUS | VIRTIO_F_VERSION_1 |
-              VIRTIO_F_IOMMU_PLATFORM;
+              VIRTIO_F_IOMMU_PLATFORM | VIRTIO_NET_F_GUEST_CSUM |
+              VIRTIO_NET_F_MRG_RXBUF;
 
   //
   // In virtio-1.0, feature negotiation is expected to complete before queue
@@ -614,6 +647,12 @@ VirtioNetInitialize (
     goto ReleaseTxRing;
   }
 
+  //
+  // The request header layout depends on VIRTIO_NET_F_MRG_RXBUF in both
+  // directions, so record it before setting up the queues.
+  //
+  Dev->RxMergeable = (BOOLEAN)((Features & VIRTIO_NET_F_MRG_RXBUF) != 0);
+
   Status = VirtioNetInitTx (Dev);
   if (EFI_ERROR (Status)) {
     goto AbortDevice;
@@ -627,7 +666,8 @@ VirtioNetInitialize (
     goto ReleaseTxAux;
   }
 
-  Dev->Snm.State = EfiSimpleNetworkInitialized;
+  Dev->RxChecksumOffload = (BOOLEAN)((Features & VIRTIO_NET_F_GUEST_CSUM) != 0);
+  Dev->Snm.State         = EfiSimpleNetworkInitialized;
   gBS->RestoreTPL (OldTpl);
   return EFI_SUCCESS;
 
@@ -3,7 +3,7 @@
   Implementation of the SNP.Receive() function and its private helpers if any.
 
   Copyright (C) 2013, Red Hat, Inc.
-  Copyright (c) 2006 - 2013, Intel Corporation. All rights reserved.<BR>
+  Copyright (c) 2006 - 2024, Intel Corporation. All rights reserved.<BR>
 
   SPDX-License-Identifier: BSD-2-Clause-Patent
 
@@ -15,6 +15,136 @@
 
 #include "VirtioNet.h"
 
+/**
+  Work out the checksum status of a received frame from its virtio-net header.
+
+  With VIRTIO_NET_F_GUEST_CSUM negotiated, the device may set
+  VIRTIO_NET_HDR_F_DATA_VALID after validating the checksum of the packet, or
+  VIRTIO_NET_HDR_F_NEEDS_CSUM for a packet that originates from the host and
+  carries only a partial checksum. The latter would fail verification in the
+  upper layers, so the checksum is completed here (virtio-0.9.5, Appendix C,
+  Packet Reception).
+
+  @param[in]     Dev     The VNET_DEV the frame was received on.
+  @param[in]     RxHdr   The virtio-net request header of the frame.
+  @param[in,out] Frame   The frame, starting with the media header.
+  @param[in]     RxLen   The length of Frame in bytes.
+
+  @return  A combination of EDKII_NETWORK_RX_CHECKSUM_* flags.
+**/
+STATIC
+UINT32
+VirtioNetRxChecksumStatus (
+  IN     VNET_DEV        *Dev,
+  IN     VIRTIO_NET_REQ  *RxHdr,
+  IN OUT UINT8           *Frame,
+  IN     UINT32          RxLen
+  )
+{
+  UINT32  Sum;
+  UINT32  Index;
+  UINT32  CsumStart;
+  UINT32  CsumField;
+
+  if (!Dev->RxChecksumOffload) {
+    return 0;
+  }
+
+  if ((RxHdr->Flags & VIRTIO_NET_HDR_F_NEEDS_CSUM) != 0) {
+    CsumStart = RxHdr->CsumStart;
+    CsumField = CsumStart + RxHdr->CsumOffset;
+    if ((CsumStart >= RxLen) || (CsumField > RxLen - sizeof (UINT16))) {
+      return 0;
+    }
+
+    //
+    // The checksum field holds the pseudo-header sum; fold in the rest of the
+    // packet from CsumStart, in network byte order.
+    //
+    Sum = 0;
+    for (Index = CsumStart; Index + 1 < RxLen; Index += 2) {
+      Sum += (UINT32)((Frame[Index] << 8) | Frame[Index + 1]);
+    }
+
+    if (Index < RxLen) {
+      Sum += (UINT32)(Frame[Index] << 8);
+    }
+
+    while ((Sum >> 16) != 0) {
+      Sum = (Sum & 0xffff) + (Sum >> 16);
+    }
+
+    Sum                  = ~Sum & 0xffff;
+    Frame[CsumField]     = (UINT8)(Sum >> 8);
+    Frame[CsumField + 1] = (UINT8)Sum;
+    return EDKII_NETWORK_RX_CHECKSUM_L4_VALID;
+  }
+
+  if ((RxHdr->Flags & VIRTIO_NET_HDR_F_DATA_VALID) != 0) {
+    return EDKII_NETWORK_RX_CHECKSUM_L4_VALID;
+  }
+
+  return 0;
+}
+
+/**
+  Return the Rx descriptors of a packet to the device.
+
+  The descriptors are made available right away, so the device never runs
+  short of buffers. The device is only notified once per batch though, or when
+  the guest has caught up with the Used Ring, as every notification costs a
+  VM exit.
+
+  @param[in,out] Dev      The VNET_DEV the packet was received on.
+  @param[in]     NumUsed  The number of Used Ring Elements, starting at
+                          Dev->RxLastUsed, that the packet took up.
+
+  @return  Status codes from VIRTIO_DEVICE_PROTOCOL.SetQueueNotify().
+**/
+STATIC
+EFI_STATUS
+VirtioNetRecycleRxDesc (
+  IN OUT VNET_DEV  *Dev,
+  IN     UINT16    NumUsed
+  )
+{
+  UINT16  AvailIdx;
+  UINT16  Index;
+  UINT16  UsedElemIdx;
+
+  //
+  // virtio-0.9.5, 2.4.1 Supplying Buffers to The Device
+  //
+  AvailIdx = *Dev->RxRing.Avail.Idx;
+  for (Index = 0; Index < NumUsed; ++Index) {
+    UsedElemIdx                                                = Dev->RxLastUsed++ % Dev->RxRing.QueueSize;
+    Dev->RxRing.Avail.Ring[AvailIdx++ % Dev->RxRing.QueueSize] =
+      (UINT16)Dev->RxRing.Used.UsedElem[UsedElemIdx].Id;
+  }
+
+  MemoryFence ();
+  *Dev->RxRing.Avail.Idx = AvailIdx;
+
+  Dev->RxPendingNotify += NumUsed;
+  MemoryFence ();
+  if ((Dev->RxLastUsed != *Dev->RxRing.Used.Idx) &&
+      (Dev->RxPendingNotify < Dev->RxMaxPending / 2))
+  {
+    return EFI_SUCCESS;
+  }
+
+  Dev->RxPendingNotify = 0;
+
+  //
+  // virtio-0.9.5, 2.4.1.4 Notifying the Device
+  //
+  if ((*Dev->RxRing.Used.Flags & VRING_USED_F_NO_NOTIFY) != 0) {
+    return EFI_SUCCESS;
+  }
+
+  return Dev->VirtIo->SetQueueNotify (Dev->VirtIo, VIRTIO_NET_Q_RX);
+}
+
 /**
   Receives a packet from a network interface.
 
@@ -64,18 +194,22 @@ VirtioNetReceive (
   OUT UINT16                      *Protocol   OPTIONAL
   )
 {
-  VNET_DEV    *Dev;
-  EFI_TPL     OldTpl;
-  EFI_STATUS  Status;
-  UINT16      RxCurUsed;
-  UINT16      UsedElemIdx;
-  UINT32      DescIdx;
-  UINT32      RxLen;
-  UINTN       OrigBufferSize;
-  UINT8       *RxPtr;
-  UINT16      AvailIdx;
-  EFI_STATUS  NotifyStatus;
-  UINTN       RxBufOffset;
+  VNET_DEV        *Dev;
+  EFI_TPL         OldTpl;
+  EFI_STATUS      Status;
+  UINT16          RxCurUsed;
+  UINT16          UsedElemIdx;
+  UINT32          DescIdx;
+  UINT32          RxLen;
+  UINT32          RxHdrLen;
+  UINT32          ChunkLen;
+  UINT16          NumUsed;
+  UINT16          Index;
+  UINTN           OrigBufferSize;
+  UINT8           *RxPtr;
+  UINT8           *Dest;
+  EFI_STATUS      NotifyStatus;
+  VIRTIO_NET_REQ  *RxHdr;
 
   if ((This == NULL) || (BufferSize == NULL) || (Buffer == NULL)) {
     return EFI_INVALID_PARAMETER;
@@ -109,16 +243,48 @@ VirtioNetReceive (
   UsedElemIdx = Dev->RxLastUsed % Dev->RxRing.QueueSize;
   DescIdx     = Dev->RxRing.Used.UsedElem[UsedElemIdx].Id;
   RxLen       = Dev->RxRing.Used.UsedElem[UsedElemIdx].Len;
-
-  //
-  // the virtio-net request header must be complete; we skip it
-  //
-  ASSERT (RxLen >= Dev->RxRing.Desc[DescIdx].Len);
-  RxLen -= Dev->RxRing.Desc[DescIdx].Len;
-  //
-  // the host must not have filled in more data than requested
-  //
-  ASSERT (RxLen <= Dev->RxRing.Desc[DescIdx + 1].Len);
+  RxHdr       = (VIRTIO_NET_REQ *)(Dev->RxBuf +
+                                   (UINTN)(Dev->RxRing.Desc[DescIdx].Addr -
+                                           Dev->RxBufDeviceBase));
+  NumUsed = 1;
+
+  if (Dev->RxMergeable) {
+    //
+    // virtio-0.9.5, Appendix C, Packet Reception: the header and the packet
+    // data share the buffer, and the packet may continue in NumBuffers - 1
+    // further buffers. The device publishes all of them at once.
+    //
+    RxHdrLen = sizeof (VIRTIO_1_0_NET_REQ);
+    NumUsed  = ((VIRTIO_1_0_NET_REQ *)RxHdr)->NumBuffers;
+    if ((NumUsed == 0) || (NumUsed > (UINT16)(RxCurUsed - Dev->RxLastUsed))) {
+      NumUsed = 1;
+      Status  = EFI_DEVICE_ERROR;
+      goto RecycleDesc; // drop malformed packet
+    }
+
+    ASSERT (RxLen >= RxHdrLen);
+    ASSERT (RxLen <= Dev->RxRing.Desc[DescIdx].Len);
+    RxLen -= RxHdrLen;
+    for (Index = 1; Index < NumUsed; ++Index) {
+      UsedElemIdx = (Dev->RxLastUsed + Index) % Dev->RxRing.QueueSize;
+      ASSERT (
+        Dev->RxRing.Used.UsedElem[UsedElemIdx].Len <=
+        Dev->RxRing.Desc[Dev->RxRing.Used.UsedElem[UsedElemIdx].Id].Len
+        );
+      RxLen += Dev->RxRing.Used.UsedElem[UsedElemIdx].Len;
+    }
+  } else {
+    //
+    // the virtio-net request header must be complete; we skip it
+    //
+    RxHdrLen = Dev->RxRing.Desc[DescIdx].Len;
+    ASSERT (RxLen >= RxHdrLen);
+    RxLen -= RxHdrLen;
+    //
+    // the host must not have filled in more data than requested
+    //
+    ASSERT (RxLen <= Dev->RxRing.Desc[DescIdx + 1].Len);
+  }
 
   OrigBufferSize = *BufferSize;
   *BufferSize    = RxLen;
@@ -137,11 +303,46 @@ VirtioNetReceive (
     *HeaderSize = Dev->Snm.MediaHeaderSize;
   }
 
-  RxBufOffset = (UINTN)(Dev->RxRing.Desc[DescIdx + 1].Addr -
-                        Dev->RxBufDeviceBase);
-  RxPtr = Dev->RxBuf + RxBufOffset;
-  CopyMem (Buffer, RxPtr, RxLen);
+  if (Dev->RxMergeable) {
+    UsedElemIdx = Dev->RxLastUsed % Dev->RxRing.QueueSize;
+    ChunkLen    = Dev->RxRing.Used.UsedElem[UsedElemIdx].Len - RxHdrLen;
+    Dest        = Buffer;
+    CopyMem (Dest, (UINT8 *)RxHdr + RxHdrLen, ChunkLen);
+    Dest += ChunkLen;
+    for (Index = 1; Index < NumUsed; ++Index) {
+      UsedElemIdx = (Dev->RxLastUsed + Index) % Dev->RxRing.QueueSize;
+      DescIdx     = Dev->RxRing.Used.UsedElem[UsedElemIdx].Id;
+      ChunkLen    = Dev->RxRing.Used.UsedElem[UsedElemIdx].Len;
+      CopyMem (
+        Dest,
+        Dev->RxBuf + (UINTN)(Dev->RxRing.Desc[DescIdx].Addr -
+                             Dev->RxBufDeviceBase),
+        ChunkLen
+        );
+      Dest += ChunkLen;
+    }
+  } else {
+    CopyMem (
+      Buffer,
+      Dev->RxBuf + (UINTN)(Dev->RxRing.Desc[DescIdx + 1].Addr -
+                           Dev->RxBufDeviceBase),
+      RxLen
+      );
+  }
+
+  Dev->RxLastBuffer         = Buffer;
+  Dev->RxLastChecksumStatus = VirtioNetRxChecksumStatus (
+                                Dev,
+                                RxHdr,
+                                Buffer,
+                                RxLen
+                                );
 
+  //
+  // Parse the media header from the caller's copy, as a merged packet is not
+  // contiguous in the Rx buffers.
+  //
+  RxPtr = Buffer;
   if (DestAddr != NULL) {
     CopyMem (DestAddr, RxPtr, SIZE_OF_VNET (Mac));
   }
@@ -158,25 +359,10 @@ VirtioNetReceive (
     *Protocol = (UINT16)((RxPtr[0] << 8) | RxPtr[1]);
   }
 
-  RxPtr += sizeof (UINT16);
-
   Status = EFI_SUCCESS;
 
 RecycleDesc:
-  ++Dev->RxLastUsed;
-
-  //
-  // virtio-0.9.5, 2.4.1 Supplying Buffers to The Device
-  //
-  AvailIdx                                                   = *Dev->RxRing.Avail.Idx;
-  Dev->RxRing.Avail.Ring[AvailIdx++ % Dev->RxRing.QueueSize] =
-    (UINT16)DescIdx;
-
-  MemoryFence ();
-  *Dev->RxRing.Avail.Idx = AvailIdx;
-
-  MemoryFence ();
-  NotifyStatus = Dev->VirtIo->SetQueueNotify (Dev->VirtIo, VIRTIO_NET_Q_RX);
+  NotifyStatus = VirtioNetRecycleRxDesc (Dev, NumUsed);
   if (!EFI_ERROR (Status)) {
     // earlier error takes precedence
     Status = NotifyStatus;
@@ -173,8 +173,16 @@ VirtioNetTransmit (
   MemoryFence ();
   *Dev->TxRing.Avail.Idx = AvailIdx;
 
+  //
+  // virtio-0.9.5, 2.4.1.4 Notifying the Device -- while the device is still
+  // working through the Tx queue it asks for no notifications and picks up
+  // this frame on its own, so back-to-back frames only trap to the
+  // hypervisor once the device has gone idle.
+  //
   MemoryFence ();
-  Status = Dev->VirtIo->SetQueueNotify (Dev->VirtIo, VIRTIO_NET_Q_TX);
+  if ((*Dev->TxRing.Used.Flags & VRING_USED_F_NO_NOTIFY) == 0) {
+    Status = Dev->VirtIo->SetQueueNotify (Dev->VirtIo, VIRTIO_NET_Q_TX);
+  }
 
 Exit:
   gBS->RestoreTPL (OldTpl);
@@ -19,13 +19,15 @@
 #include <Protocol/ComponentName2.h>
 #include <Protocol/DevicePath.h>
 #include <Protocol/DriverBinding.h>
+#include <Protocol/NetworkChecksumOffload.h>
 #include <Protocol/SimpleNetwork.h>
 #include <Library/OrderedCollectionLib.h>
 
 #define VNET_SIG  SIGNATURE_32 ('V', 'N', 'E', 'T')
 
 //
-// maximum number of pending packets, separately for each direction
+// maximum number of pending TX packets; the RX limit is
+// PcdVirtioNetRxRingSize
 //
 #define VNET_MAX_PENDING  64
 
@@ -69,33 +71,40 @@ typedef struct {
   //
   //                          field              init function
   //                          ------------------ ------------------------------
-  UINT32                         Signature;      // VirtioNetDriverBindingStart
-  VIRTIO_DEVICE_PROTOCOL         *VirtIo;        // VirtioNetDriverBindingStart
-  EFI_SIMPLE_NETWORK_PROTOCOL    Snp;            // VirtioNetSnpPopulate
-  EFI_SIMPLE_NETWORK_MODE        Snm;            // VirtioNetSnpPopulate
-  EFI_EVENT                      ExitBoot;       // VirtioNetSnpPopulate
-  EFI_DEVICE_PATH_PROTOCOL       *MacDevicePath; // VirtioNetDriverBindingStart
-  EFI_HANDLE                     MacHandle;      // VirtioNetDriverBindingStart
-
-  VRING                          RxRing;          // VirtioNetInitRing
-  VOID                           *RxRingMap;      // VirtioRingMap and
-                                                  // VirtioNetInitRing
-  UINT8                          *RxBuf;          // VirtioNetInitRx
-  UINT16                         RxLastUsed;      // VirtioNetInitRx
-  UINTN                          RxBufNrPages;    // VirtioNetInitRx
-  EFI_PHYSICAL_ADDRESS           RxBufDeviceBase; // VirtioNetInitRx
-  VOID                           *RxBufMap;       // VirtioNetInitRx
-
-  VRING                          TxRing;           // VirtioNetInitRing
-  VOID                           *TxRingMap;       // VirtioRingMap and
-                                                   // VirtioNetInitRing
-  UINT16                         TxMaxPending;     // VirtioNetInitTx
-  UINT16                         TxCurPending;     // VirtioNetInitTx
-  UINT16                         *TxFreeStack;     // VirtioNetInitTx
-  VIRTIO_1_0_NET_REQ             *TxSharedReq;     // VirtioNetInitTx
-  VOID                           *TxSharedReqMap;  // VirtioNetInitTx
-  UINT16                         TxLastUsed;       // VirtioNetInitTx
-  ORDERED_COLLECTION             *TxBufCollection; // VirtioNetInitTx
+  UINT32                                     Signature;       // VirtioNetDriverBindingStart
+  VIRTIO_DEVICE_PROTOCOL                     *VirtIo;         // VirtioNetDriverBindingStart
+  EFI_SIMPLE_NETWORK_PROTOCOL                Snp;             // VirtioNetSnpPopulate
+  EFI_SIMPLE_NETWORK_MODE                    Snm;             // VirtioNetSnpPopulate
+  EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL    ChecksumOffload; // VirtioNetSnpPopulate
+  EFI_EVENT                                  ExitBoot;        // VirtioNetSnpPopulate
+  EFI_DEVICE_PATH_PROTOCOL                   *MacDevicePath;  // VirtioNetDriverBindingStart
+  EFI_HANDLE                                 MacHandle;       // VirtioNetDriverBindingStart
+
+  VRING                                      RxRing;               // VirtioNetInitRing
+  VOID                                       *RxRingMap;           // VirtioRingMap and
+                                                                   // VirtioNetInitRing
+  UINT8                                      *RxBuf;               // VirtioNetInitRx
+  UINT16                                     RxLastUsed;           // VirtioNetInitRx
+  UINTN                                      RxBufNrPages;         // VirtioNetInitRx
+  EFI_PHYSICAL_ADDRESS                       RxBufDeviceBase;      // VirtioNetInitRx
+  VOID                                       *RxBufMap;            // VirtioNetInitRx
+  BOOLEAN                                    RxChecksumOffload;    // VirtioNetInitialize
+  BOOLEAN                                    RxMergeable;          // VirtioNetInitialize
+  UINT16                                     RxMaxPending;         // VirtioNetInitRx
+  UINT16                                     RxPendingNotify;      // VirtioNetInitRx
+  VOID                                       *RxLastBuffer;        // VirtioNetInitRx
+  UINT32                                     RxLastChecksumStatus; // VirtioNetInitRx
+
+  VRING                                      TxRing;           // VirtioNetInitRing
+  VOID                                       *TxRingMap;       // VirtioRingMap and
+                                                               // VirtioNetInitRing
+  UINT16                                     TxMaxPending;     // VirtioNetInitTx
+  UINT16                                     TxCurPending;     // VirtioNetInitTx
+  UINT16                                     *TxFreeStack;     // VirtioNetInitTx
+  VIRTIO_1_0_NET_REQ                         *TxSharedReq;     // VirtioNetInitTx
+  VOID                                       *TxSharedReqMap;  // VirtioNetInitTx
+  UINT16                                     TxLastUsed;       // VirtioNetInitTx
+  ORDERED_COLLECTION                         *TxBufCollection; // VirtioNetInitTx
 } VNET_DEV;
 
 //
@@ -111,6 +120,9 @@ typedef struct {
 #define VIRTIO_NET_FROM_SNP(SnpPointer) \
         CR (SnpPointer, VNET_DEV, Snp, VNET_SIG)
 
+#define VIRTIO_NET_FROM_CHECKSUM_OFFLOAD(ChecksumOffloadPointer) \
+        CR (ChecksumOffloadPointer, VNET_DEV, ChecksumOffload, VNET_SIG)
+
 #define VIRTIO_CFG_WRITE(Dev, Field, Value)  ((Dev)->VirtIo->WriteDevice (  \
                                                 (Dev)->VirtIo,              \
                                                 OFFSET_OF_VNET (Field),     \
@@ -252,6 +264,17 @@ VirtioNetReceive (
   OUT UINT16                      *Protocol   OPTIONAL
   );
 
+//
+// member function implementing the EDK II Network Checksum Offload Protocol
+//
+EFI_STATUS
+EFIAPI
+VirtioNetGetRxChecksumStatus (
+  IN  EDKII_NETWORK_CHECKSUM_OFFLOAD_PROTOCOL  *This,
+  IN  VOID                                     *RxData,
+  OUT UINT32                                   *ChecksumStatus
+  );
+
 //
 // utility functions shared by various SNP member functions
 //
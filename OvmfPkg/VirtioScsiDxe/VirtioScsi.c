@@ -7,16 +7,16 @@
 
   - No hotplug / hot-unplug.
 
-  - Although EFI_EXT_SCSI_PASS_THRU_PROTOCOL.PassThru() could be a good match
-    for multiple in-flight virtio-scsi requests, we stick to synchronous
-    requests for now.
+  - EFI_EXT_SCSI_PASS_THRU_PROTOCOL.PassThru() supports non-blocking
+    requests. Up to a quarter of the request queue size requests can be in
+    flight; a timer completes the non-blocking ones.
 
   - Timeouts are not supported for EFI_EXT_SCSI_PASS_THRU_PROTOCOL.PassThru().
 
   - Only one channel is supported. (At the time of this writing, host-side
     virtio-scsi supports a single channel too.)
 
-  - Only one request queue is used (for the one synchronous request).
+  - Only one request queue is used.
 
   - The ResetChannel() and ResetTargetLun() functions of
     EFI_EXT_SCSI_PASS_THRU_PROTOCOL are not supported (which is allowed by the
@@ -35,6 +35,7 @@
 **/
 
 #include <IndustryStandard/VirtioScsi.h>
+#include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/MemoryAllocationLib.h>
@@ -412,63 +413,108 @@ ReportHostAdapterError (
 }
 
 //
-// The next seven functions implement EFI_EXT_SCSI_PASS_THRU_PROTOCOL
-// for the virtio-scsi HBA. Refer to UEFI Spec 2.3.1 + Errata C, sections
-// - 14.1 SCSI Driver Model Overview,
-// - 14.7 Extended SCSI Pass Thru Protocol.
+// Every request occupies its own group of VSCSI_DESC_PER_REQ descriptors in
+// the request queue: the request header, "dataout", the response header and
+// "datain". Group N starts at descriptor N * VSCSI_DESC_PER_REQ, hence the
+// head descriptor index that the host returns in the used ring identifies the
+// request.
+//
+#define VSCSI_DESC_PER_REQ  4
+
+//
+// Polling period for the completion of non-blocking requests.
+//
+#define VSCSI_ASYNC_TIMER  EFI_TIMER_PERIOD_MILLISECONDS (1)
+
+//
+// A request from preparation until the host has processed it and its buffers
+// have been released.
 //
+struct _VSCSI_REQ {
+  EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET    *Packet;
+  EFI_EVENT                                     CallerEvent;
+  volatile VIRTIO_SCSI_REQ                      *Request;
+  VOID                                          *RequestMapping;
+  EFI_PHYSICAL_ADDRESS                          RequestDeviceAddress;
+  volatile VIRTIO_SCSI_RESP                     *Response;
+  VOID                                          *ResponseMapping;
+  EFI_PHYSICAL_ADDRESS                          ResponseDeviceAddress;
+  VOID                                          *InDataBuffer;
+  UINTN                                         InDataNumPages;
+  VOID                                          *InDataMapping;
+  EFI_PHYSICAL_ADDRESS                          InDataDeviceAddress;
+  BOOLEAN                                       OutDataBufferIsMapped;
+  VOID                                          *OutDataMapping;
+  EFI_PHYSICAL_ADDRESS                          OutDataDeviceAddress;
+  //
+  // The fields below are protected by TPL_NOTIFY once the request has been
+  // submitted.
+  //
+  BOOLEAN                                       Abandoned;
+  BOOLEAN                                       Completed;
+  EFI_STATUS                                    Status;
+};
+
+/**
+
+  Allocate and map the buffers of a virtio-scsi request for an Extended SCSI
+  Pass Thru Protocol packet.
+
+  @param[in] Dev          The virtio-scsi host device the packet targets.
 
+  @param[in] Target       The SCSI target controlled by the virtio-scsi host
+                          device.
+
+  @param[in] Lun          The Logical Unit Number under the SCSI target.
+
+  @param[in out] Packet   The Extended SCSI Pass Thru Protocol packet to
+                          translate. On failure this parameter relays error
+                          contents.
+
+  @param[in] CallerEvent  The event to signal when the host has processed the
+                          request, or NULL for a blocking request.
+
+  @param[out] Req         On success, the prepared request, to be released
+                          with ReleaseRequest().
+
+
+  @retval EFI_SUCCESS  The request has been prepared.
+
+  @return              Otherwise, status codes meant for direct forwarding by
+                       the EFI_EXT_SCSI_PASS_THRU_PROTOCOL.PassThru()
+                       implementation.
+
+**/
+STATIC
 EFI_STATUS
-EFIAPI
-VirtioScsiPassThru (
-  IN     EFI_EXT_SCSI_PASS_THRU_PROTOCOL             *This,
-  IN     UINT8                                       *Target,
+PrepareRequest (
+  IN     VSCSI_DEV                                   *Dev,
+  IN     UINT16                                      Target,
   IN     UINT64                                      Lun,
   IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet,
-  IN     EFI_EVENT                                   Event   OPTIONAL
+  IN     EFI_EVENT                                   CallerEvent,
+  OUT    VSCSI_REQ                                   **Req
   )
 {
-  VSCSI_DEV                  *Dev;
-  UINT16                     TargetValue;
-  EFI_STATUS                 Status;
-  volatile VIRTIO_SCSI_REQ   *Request;
-  volatile VIRTIO_SCSI_RESP  *Response;
-  VOID                       *ResponseBuffer;
-  DESC_INDICES               Indices;
-  VOID                       *RequestMapping;
-  VOID                       *ResponseMapping;
-  VOID                       *InDataMapping;
-  VOID                       *OutDataMapping;
-  EFI_PHYSICAL_ADDRESS       RequestDeviceAddress;
-  EFI_PHYSICAL_ADDRESS       ResponseDeviceAddress;
-  EFI_PHYSICAL_ADDRESS       InDataDeviceAddress;
-  EFI_PHYSICAL_ADDRESS       OutDataDeviceAddress;
-  VOID                       *InDataBuffer;
-  UINTN                      InDataNumPages;
-  BOOLEAN                    OutDataBufferIsMapped;
-
-  //
-  // Set InDataMapping,OutDataMapping,InDataDeviceAddress and OutDataDeviceAddress to
-  // suppress incorrect compiler/analyzer warnings.
-  //
-  InDataMapping        = NULL;
-  OutDataMapping       = NULL;
-  InDataDeviceAddress  = 0;
-  OutDataDeviceAddress = 0;
-
-  Request = AllocateZeroPool (sizeof (*Request));
-  if (Request == NULL) {
+  VSCSI_REQ   *NewReq;
+  EFI_STATUS  Status;
+  VOID        *ResponseBuffer;
+
+  NewReq = AllocateZeroPool (sizeof *NewReq);
+  if (NewReq == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
 
-  Dev = VIRTIO_SCSI_FROM_PASS_THRU (This);
-  CopyMem (&TargetValue, Target, sizeof TargetValue);
+  NewReq->Packet      = Packet;
+  NewReq->CallerEvent = CallerEvent;
 
-  InDataBuffer          = NULL;
-  OutDataBufferIsMapped = FALSE;
-  InDataNumPages        = 0;
+  NewReq->Request = AllocateZeroPool (sizeof (*NewReq->Request));
+  if (NewReq->Request == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto FreeReq;
+  }
 
-  Status = PopulateRequest (Dev, TargetValue, Lun, Packet, Request);
+  Status = PopulateRequest (Dev, Target, Lun, Packet, NewReq->Request);
   if (EFI_ERROR (Status)) {
     goto FreeScsiRequest;
   }
@@ -479,10 +525,10 @@ VirtioScsiPassThru (
   Status = VirtioMapAllBytesInSharedBuffer (
              Dev->VirtIo,
              VirtioOperationBusMasterRead,
-             (VOID *)Request,
-             sizeof (*Request),
-             &RequestDeviceAddress,
-             &RequestMapping
+             (VOID *)NewReq->Request,
+             sizeof (*NewReq->Request),
+             &NewReq->RequestDeviceAddress,
+             &NewReq->RequestMapping
              );
   if (EFI_ERROR (Status)) {
     Status = ReportHostAdapterError (Packet);
@@ -508,26 +554,27 @@ VirtioScsiPassThru (
     // the Virtio request is successful then we copy the data from temporary
     // buffer into Packet->InDataBuffer.
     //
-    InDataNumPages = EFI_SIZE_TO_PAGES ((UINTN)Packet->InTransferLength);
-    Status         = Dev->VirtIo->AllocateSharedPages (
-                                    Dev->VirtIo,
-                                    InDataNumPages,
-                                    &InDataBuffer
-                                    );
+    NewReq->InDataNumPages = EFI_SIZE_TO_PAGES ((UINTN)Packet->InTransferLength);
+    Status                 = Dev->VirtIo->AllocateSharedPages (
+                                            Dev->VirtIo,
+                                            NewReq->InDataNumPages,
+                                            &NewReq->InDataBuffer
+                                            );
     if (EFI_ERROR (Status)) {
-      Status = ReportHostAdapterError (Packet);
+      NewReq->InDataBuffer = NULL;
+      Status               = ReportHostAdapterError (Packet);
       goto UnmapRequestBuffer;
     }
 
-    ZeroMem (InDataBuffer, Packet->InTransferLength);
+    ZeroMem (NewReq->InDataBuffer, Packet->InTransferLength);
 
     Status = VirtioMapAllBytesInSharedBuffer (
                Dev->VirtIo,
                VirtioOperationBusMasterCommonBuffer,
-               InDataBuffer,
+               NewReq->InDataBuffer,
                Packet->InTransferLength,
-               &InDataDeviceAddress,
-               &InDataMapping
+               &NewReq->InDataDeviceAddress,
+               &NewReq->InDataMapping
                );
     if (EFI_ERROR (Status)) {
       Status = ReportHostAdapterError (Packet);
@@ -544,15 +591,15 @@ VirtioScsiPassThru (
                VirtioOperationBusMasterRead,
                Packet->OutDataBuffer,
                Packet->OutTransferLength,
-               &OutDataDeviceAddress,
-               &OutDataMapping
+               &NewReq->OutDataDeviceAddress,
+               &NewReq->OutDataMapping
                );
     if (EFI_ERROR (Status)) {
       Status = ReportHostAdapterError (Packet);
       goto UnmapInDataBuffer;
     }
 
-    OutDataBufferIsMapped = TRUE;
+    NewReq->OutDataBufferIsMapped = TRUE;
   }
 
   //
@@ -562,7 +609,7 @@ VirtioScsiPassThru (
   //
   Status = Dev->VirtIo->AllocateSharedPages (
                           Dev->VirtIo,
-                          EFI_SIZE_TO_PAGES (sizeof *Response),
+                          EFI_SIZE_TO_PAGES (sizeof *NewReq->Response),
                           &ResponseBuffer
                           );
   if (EFI_ERROR (Status)) {
@@ -570,14 +617,14 @@ VirtioScsiPassThru (
     goto UnmapOutDataBuffer;
   }
 
-  Response = ResponseBuffer;
+  NewReq->Response = ResponseBuffer;
 
-  ZeroMem ((VOID *)Response, sizeof (*Response));
+  ZeroMem ((VOID *)NewReq->Response, sizeof (*NewReq->Response));
 
   //
   // preset a host status for ourselves that we do not accept as success
   //
-  Response->Response = VIRTIO_SCSI_S_FAILURE;
+  NewReq->Response->Response = VIRTIO_SCSI_S_FAILURE;
 
   //
   // Map the response buffer with BusMasterCommonBuffer so that response
@@ -587,30 +634,155 @@ VirtioScsiPassThru (
              Dev->VirtIo,
              VirtioOperationBusMasterCommonBuffer,
              ResponseBuffer,
-             sizeof (*Response),
-             &ResponseDeviceAddress,
-             &ResponseMapping
+             sizeof (*NewReq->Response),
+             &NewReq->ResponseDeviceAddress,
+             &NewReq->ResponseMapping
              );
   if (EFI_ERROR (Status)) {
     Status = ReportHostAdapterError (Packet);
     goto FreeResponseBuffer;
   }
 
-  VirtioPrepare (&Dev->Ring, &Indices);
+  *Req = NewReq;
+  return EFI_SUCCESS;
 
-  //
-  // ensured by VirtioScsiInit() -- this predicate, in combination with the
-  // lock-step progress, ensures we don't have to track free descriptors.
-  //
-  ASSERT (Dev->Ring.QueueSize >= 4);
+FreeResponseBuffer:
+  Dev->VirtIo->FreeSharedPages (
+                 Dev->VirtIo,
+                 EFI_SIZE_TO_PAGES (sizeof *NewReq->Response),
+                 ResponseBuffer
+                 );
+
+UnmapOutDataBuffer:
+  if (NewReq->OutDataBufferIsMapped) {
+    Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, NewReq->OutDataMapping);
+  }
+
+UnmapInDataBuffer:
+  if (NewReq->InDataBuffer != NULL) {
+    Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, NewReq->InDataMapping);
+  }
+
+FreeInDataBuffer:
+  if (NewReq->InDataBuffer != NULL) {
+    Dev->VirtIo->FreeSharedPages (
+                   Dev->VirtIo,
+                   NewReq->InDataNumPages,
+                   NewReq->InDataBuffer
+                   );
+  }
+
+UnmapRequestBuffer:
+  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, NewReq->RequestMapping);
+
+FreeScsiRequest:
+  FreePool ((VOID *)NewReq->Request);
+
+FreeReq:
+  FreePool (NewReq);
+
+  return Status;
+}
+
+/**
+
+  Unmap and free the buffers of a request prepared with PrepareRequest(), and
+  the request itself.
+
+  @param[in] Dev  The virtio-scsi host device the request was prepared for.
+
+  @param[in] Req  The request to release. The host must not own any of the
+                  request's buffers.
+
+**/
+STATIC
+VOID
+ReleaseRequest (
+  IN VSCSI_DEV  *Dev,
+  IN VSCSI_REQ  *Req
+  )
+{
+  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Req->ResponseMapping);
+  Dev->VirtIo->FreeSharedPages (
+                 Dev->VirtIo,
+                 EFI_SIZE_TO_PAGES (sizeof *Req->Response),
+                 (VOID *)Req->Response
+                 );
+
+  if (Req->OutDataBufferIsMapped) {
+    Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Req->OutDataMapping);
+  }
+
+  if (Req->InDataBuffer != NULL) {
+    Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Req->InDataMapping);
+    Dev->VirtIo->FreeSharedPages (
+                   Dev->VirtIo,
+                   Req->InDataNumPages,
+                   Req->InDataBuffer
+                   );
+  }
+
+  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Req->RequestMapping);
+  FreePool ((VOID *)Req->Request);
+  FreePool (Req);
+}
+
+/**
+
+  Submit a prepared request to the host, in the descriptor group of a free
+  slot of the request queue.
+
+  The function must be called at TPL_NOTIFY.
+
+  @param[in,out] Dev  The virtio-scsi host device.
+
+  @param[in] Req      The request to submit. If Req->CallerEvent is not NULL,
+                      or if notifying the host fails, ReapRequests() takes
+                      ownership of the request.
+
+
+  @retval EFI_SUCCESS    The request has been submitted.
+
+  @retval EFI_NOT_READY  All slots are in use; the request has not been
+                         submitted.
+
+  @return                Error codes from VirtIo->SetQueueNotify(). The
+                         request has been abandoned to the host, and is
+                         released once the host returns it.
+
+**/
+STATIC
+EFI_STATUS
+SubmitRequest (
+  IN OUT VSCSI_DEV  *Dev,
+  IN     VSCSI_REQ  *Req
+  )
+{
+  UINT16        Slot;
+  DESC_INDICES  Indices;
+  UINT16        NextAvailIdx;
+  EFI_STATUS    Status;
+
+  for (Slot = 0; Slot < Dev->SlotCount; ++Slot) {
+    if (Dev->InFlight[Slot] == NULL) {
+      break;
+    }
+  }
+
+  if (Slot == Dev->SlotCount) {
+    return EFI_NOT_READY;
+  }
+
+  Indices.HeadDescIdx = (UINT16)(Slot * VSCSI_DESC_PER_REQ);
+  Indices.NextDescIdx = Indices.HeadDescIdx;
 
   //
   // enqueue Request
   //
   VirtioAppendDesc (
     &Dev->Ring,
-    RequestDeviceAddress,
-    sizeof (*Request),
+    Req->RequestDeviceAddress,
+    sizeof (*Req->Request),
     VRING_DESC_F_NEXT,
     &Indices
     );
@@ -618,11 +790,11 @@ VirtioScsiPassThru (
   //
   // enqueue "dataout" if any
   //
-  if (Packet->OutTransferLength > 0) {
+  if (Req->Packet->OutTransferLength > 0) {
     VirtioAppendDesc (
       &Dev->Ring,
-      OutDataDeviceAddress,
-      Packet->OutTransferLength,
+      Req->OutDataDeviceAddress,
+      Req->Packet->OutTransferLength,
       VRING_DESC_F_NEXT,
       &Indices
       );
@@ -633,83 +805,262 @@ VirtioScsiPassThru (
   //
   VirtioAppendDesc (
     &Dev->Ring,
-    ResponseDeviceAddress,
-    sizeof *Response,
-    VRING_DESC_F_WRITE | (Packet->InTransferLength > 0 ? VRING_DESC_F_NEXT : 0),
+    Req->ResponseDeviceAddress,
+    sizeof *Req->Response,
+    VRING_DESC_F_WRITE | (Req->Packet->InTransferLength > 0 ?
+                          VRING_DESC_F_NEXT : 0),
     &Indices
     );
 
   //
   // enqueue "datain" if any, to be written by the host
   //
-  if (Packet->InTransferLength > 0) {
+  if (Req->Packet->InTransferLength > 0) {
     VirtioAppendDesc (
       &Dev->Ring,
-      InDataDeviceAddress,
-      Packet->InTransferLength,
+      Req->InDataDeviceAddress,
+      Req->Packet->InTransferLength,
       VRING_DESC_F_WRITE,
       &Indices
       );
   }
 
-  // If kicking the host fails, we must fake a host adapter error.
-  // EFI_NOT_READY would save us the effort, but it would also suggest that the
-  // caller retry.
+  Dev->InFlight[Slot] = Req;
+
   //
-  if (VirtioFlush (
-        Dev->VirtIo,
-        VIRTIO_SCSI_REQUEST_QUEUE,
-        &Dev->Ring,
-        &Indices,
-        NULL
-        ) != EFI_SUCCESS)
-  {
-    Status = ReportHostAdapterError (Packet);
-    goto UnmapResponseBuffer;
-  }
+  // virtio-0.9.5, 2.4.1.2 Updating the Available Ring, and 2.4.1.3 Updating
+  // the Index Field. We poll the used ring; the host should not send an
+  // interrupt.
+  //
+  *Dev->Ring.Avail.Flags = (UINT16)VRING_AVAIL_F_NO_INTERRUPT;
+  NextAvailIdx           = *Dev->Ring.Avail.Idx;
+  Dev->Ring.Avail.Ring[NextAvailIdx++ % Dev->Ring.QueueSize] =
+    Indices.HeadDescIdx;
+  MemoryFence ();
+  *Dev->Ring.Avail.Idx = NextAvailIdx;
 
-  Status = ParseResponse (Packet, Response);
+  //
+  // virtio-0.9.5, 2.4.1.4 Notifying the Device
+  //
+  MemoryFence ();
+  Status = EFI_SUCCESS;
+  if ((*Dev->Ring.Used.Flags & VRING_USED_F_NO_NOTIFY) == 0) {
+    Status = Dev->VirtIo->SetQueueNotify (
+                            Dev->VirtIo,
+                            VIRTIO_SCSI_REQUEST_QUEUE
+                            );
+  }
 
   //
-  // If virtio request was successful and it was a CPU read request then we
-  // have used an intermediate buffer. Copy the data from intermediate buffer
-  // to the final buffer.
+  // The request is on the ring either way. If the host could not be
+  // notified, it may still pick up the request later (for example when the
+  // next request is submitted); the buffers must stay mapped until then.
   //
-  if (InDataBuffer != NULL) {
-    CopyMem (Packet->InDataBuffer, InDataBuffer, Packet->InTransferLength);
+  if (EFI_ERROR (Status)) {
+    Req->Abandoned = TRUE;
   }
 
-UnmapResponseBuffer:
-  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, ResponseMapping);
+  if ((Req->CallerEvent != NULL) || Req->Abandoned) {
+    if (Dev->PendingCount++ == 0) {
+      gBS->SetTimer (Dev->Timer, TimerPeriodic, VSCSI_ASYNC_TIMER);
+    }
+  }
 
-FreeResponseBuffer:
-  Dev->VirtIo->FreeSharedPages (
-                 Dev->VirtIo,
-                 EFI_SIZE_TO_PAGES (sizeof *Response),
-                 ResponseBuffer
-                 );
+  return Status;
+}
 
-UnmapOutDataBuffer:
-  if (OutDataBufferIsMapped) {
-    Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, OutDataMapping);
+/**
+
+  Complete the requests that the host has processed.
+
+  Blocking requests are only marked as completed, for VirtioScsiPassThru() to
+  pick up. Non-blocking requests are finished here: the caller's packet is
+  updated, the caller's event is signaled, and the request is released.
+
+  @param[in,out] Dev  The virtio-scsi host device.
+
+**/
+STATIC
+VOID
+ReapRequests (
+  IN OUT VSCSI_DEV  *Dev
+  )
+{
+  EFI_TPL                         OldTpl;
+  volatile CONST VRING_USED_ELEM  *UsedElem;
+  UINT32                          HeadDescIdx;
+  UINT32                          Slot;
+  VSCSI_REQ                       *Req;
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+
+  //
+  // virtio-0.9.5, 2.4.2 Receiving Used Buffers From the Device
+  //
+  MemoryFence ();
+  while (Dev->LastUsedIdx != *Dev->Ring.Used.Idx) {
+    MemoryFence ();
+    UsedElem    = &Dev->Ring.Used.UsedElem[Dev->LastUsedIdx++ % Dev->Ring.QueueSize];
+    HeadDescIdx = UsedElem->Id;
+    Slot        = HeadDescIdx / VSCSI_DESC_PER_REQ;
+    if ((HeadDescIdx % VSCSI_DESC_PER_REQ != 0) ||
+        (Slot >= Dev->SlotCount) ||
+        (Dev->InFlight[Slot] == NULL))
+    {
+      DEBUG ((
+        DEBUG_ERROR,
+        "%a: unexpected used descriptor %u\n",
+        __func__,
+        HeadDescIdx
+        ));
+      continue;
+    }
+
+    Req                 = Dev->InFlight[Slot];
+    Dev->InFlight[Slot] = NULL;
+
+    if (!Req->Abandoned) {
+      Req->Status = ParseResponse (Req->Packet, Req->Response);
+
+      //
+      // If virtio request was successful and it was a CPU read request then
+      // we have used an intermediate buffer. Copy the data from intermediate
+      // buffer to the final buffer.
+      //
+      if (Req->InDataBuffer != NULL) {
+        CopyMem (
+          Req->Packet->InDataBuffer,
+          Req->InDataBuffer,
+          Req->Packet->InTransferLength
+          );
+      }
+
+      if (Req->CallerEvent == NULL) {
+        Req->Completed = TRUE;
+        continue;
+      }
+
+      gBS->SignalEvent (Req->CallerEvent);
+    }
+
+    ReleaseRequest (Dev, Req);
+    if (--Dev->PendingCount == 0) {
+      gBS->SetTimer (Dev->Timer, TimerCancel, 0);
+    }
   }
 
-UnmapInDataBuffer:
-  if (InDataBuffer != NULL) {
-    Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, InDataMapping);
+  gBS->RestoreTPL (OldTpl);
+}
+
+/**
+
+  Timer notification function for the completion of non-blocking requests.
+
+  @param[in] Event    The timer event.
+
+  @param[in] Context  The virtio-scsi host device.
+
+**/
+STATIC
+VOID
+EFIAPI
+VirtioScsiAsyncTimer (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  ReapRequests (Context);
+}
+
+//
+// The next seven functions implement EFI_EXT_SCSI_PASS_THRU_PROTOCOL
+// for the virtio-scsi HBA. Refer to UEFI Spec 2.3.1 + Errata C, sections
+// - 14.1 SCSI Driver Model Overview,
+// - 14.7 Extended SCSI Pass Thru Protocol.
+//
+
+EFI_STATUS
+EFIAPI
+VirtioScsiPassThru (
+  IN     EFI_EXT_SCSI_PASS_THRU_PROTOCOL             *This,
+  IN     UINT8                                       *Target,
+  IN     UINT64                                      Lun,
+  IN OUT EFI_EXT_SCSI_PASS_THRU_SCSI_REQUEST_PACKET  *Packet,
+  IN     EFI_EVENT                                   Event   OPTIONAL
+  )
+{
+  VSCSI_DEV   *Dev;
+  UINT16      TargetValue;
+  EFI_STATUS  Status;
+  VSCSI_REQ   *Req;
+  EFI_TPL     OldTpl;
+  UINTN       PollPeriodUsecs;
+
+  Dev = VIRTIO_SCSI_FROM_PASS_THRU (This);
+  CopyMem (&TargetValue, Target, sizeof TargetValue);
+
+  Status = PrepareRequest (Dev, TargetValue, Lun, Packet, Event, &Req);
+  if (EFI_ERROR (Status)) {
+    return Status;
   }
 
-FreeInDataBuffer:
-  if (InDataBuffer != NULL) {
-    Dev->VirtIo->FreeSharedPages (Dev->VirtIo, InDataNumPages, InDataBuffer);
+  //
+  // Keep slowing down until we reach a poll period of slightly above 1 ms.
+  //
+  PollPeriodUsecs = 1;
+  while (TRUE) {
+    OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+    Status = SubmitRequest (Dev, Req);
+    gBS->RestoreTPL (OldTpl);
+
+    if (Status != EFI_NOT_READY) {
+      break;
+    }
+
+    //
+    // All slots are taken by earlier requests. A non-blocking caller may
+    // retry later; a blocking caller waits for a slot.
+    //
+    if (Event != NULL) {
+      ReleaseRequest (Dev, Req);
+      return EFI_NOT_READY;
+    }
+
+    gBS->Stall (PollPeriodUsecs);
+    if (PollPeriodUsecs < 1024) {
+      PollPeriodUsecs *= 2;
+    }
+
+    ReapRequests (Dev);
   }
 
-UnmapRequestBuffer:
-  Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, RequestMapping);
+  //
+  // If kicking the host fails, we must fake a host adapter error.
+  // EFI_NOT_READY would save us the effort, but it would also suggest that the
+  // caller retry.
+  //
+  if (EFI_ERROR (Status)) {
+    return ReportHostAdapterError (Packet);
+  }
 
-FreeScsiRequest:
-  FreePool ((VOID *)Request);
+  if (Event != NULL) {
+    return EFI_SUCCESS;
+  }
+
+  PollPeriodUsecs = 1;
+  ReapRequests (Dev);
+  while (!Req->Completed) {
+    gBS->Stall (PollPeriodUsecs); // calls AcpiTimerLib::MicroSecondDelay
+
+    if (PollPeriodUsecs < 1024) {
+      PollPeriodUsecs *= 2;
+    }
+
+    ReapRequests (Dev);
+  }
 
+  Status = Req->Status;
+  ReleaseRequest (Dev, Req);
   return Status;
 }
 
@@ -1063,16 +1414,36 @@ VirtioScsiInit (
   }
 
   //
-  // VirtioScsiPassThru() uses at most four descriptors
+  // VirtioScsiPassThru() uses at most four descriptors per request
   //
-  if (QueueSize < 4) {
+  if (QueueSize < VSCSI_DESC_PER_REQ) {
     Status = EFI_UNSUPPORTED;
     goto Failed;
   }
 
+  Dev->SlotCount    = QueueSize / VSCSI_DESC_PER_REQ;
+  Dev->LastUsedIdx  = 0;
+  Dev->PendingCount = 0;
+  Dev->InFlight     = AllocateZeroPool (Dev->SlotCount * sizeof *Dev->InFlight);
+  if (Dev->InFlight == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Failed;
+  }
+
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_NOTIFY,
+                  VirtioScsiAsyncTimer,
+                  Dev,
+                  &Dev->Timer
+                  );
+  if (EFI_ERROR (Status)) {
+    goto FreeInFlight;
+  }
+
   Status = VirtioRingInit (Dev->VirtIo, QueueSize, &Dev->Ring);
   if (EFI_ERROR (Status)) {
-    goto Failed;
+    goto CloseTimer;
   }
 
   //
@@ -1172,7 +1543,8 @@ VirtioScsiInit (
   // SCSI Pass Thru Protocol.
   //
   Dev->PassThruMode.Attributes = EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_PHYSICAL |
-                                 EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_LOGICAL;
+                                 EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_LOGICAL |
+                                 EFI_EXT_SCSI_PASS_THRU_ATTRIBUTES_NONBLOCKIO;
 
   //
   // no restriction on transfer buffer alignment
@@ -1187,6 +1559,12 @@ UnmapQueue:
 ReleaseQueue:
   VirtioRingUninit (Dev->VirtIo, &Dev->Ring);
 
+CloseTimer:
+  gBS->CloseEvent (Dev->Timer);
+
+FreeInFlight:
+  FreePool (Dev->InFlight);
+
 Failed:
   //
   // Notify the host about our failure to setup: virtio-0.9.5, 2.2.2.1 Device
@@ -1210,6 +1588,9 @@ VirtioScsiUninit (
   IN OUT VSCSI_DEV  *Dev
   )
 {
+  UINT16     Slot;
+  VSCSI_REQ  *Req;
+
   //
   // Reset the virtual device -- see virtio-0.9.5, 2.2.2.1 Device Status. When
   // VIRTIO_CFG_WRITE() returns, the host will have learned to stay away from
@@ -1222,6 +1603,35 @@ VirtioScsiUninit (
   Dev->MaxLun         = 0;
   Dev->MaxSectors     = 0;
 
+  //
+  // The host has forgotten about the requests still in flight; fail them.
+  //
+  gBS->CloseEvent (Dev->Timer);
+  for (Slot = 0; Slot < Dev->SlotCount; ++Slot) {
+    Req = Dev->InFlight[Slot];
+    if (Req == NULL) {
+      continue;
+    }
+
+    Dev->InFlight[Slot] = NULL;
+    if (!Req->Abandoned) {
+      Req->Status = ReportHostAdapterError (Req->Packet);
+      if (Req->CallerEvent == NULL) {
+        Req->Completed = TRUE;
+        continue;
+      }
+
+      gBS->SignalEvent (Req->CallerEvent);
+    }
+
+    ReleaseRequest (Dev, Req);
+  }
+
+  FreePool (Dev->InFlight);
+  Dev->InFlight     = NULL;
+  Dev->SlotCount    = 0;
+  Dev->PendingCount = 0;
+
   Dev->VirtIo->UnmapSharedBuffer (Dev->VirtIo, Dev->RingMap);
   VirtioRingUninit (Dev->VirtIo, &Dev->Ring);
 
@@ -34,6 +34,8 @@
 
 #define VSCSI_SIG  SIGNATURE_32 ('V', 'S', 'C', 'S')
 
+typedef struct _VSCSI_REQ VSCSI_REQ;
+
 typedef struct {
   //
   // Parts of this structure are initialized / torn down in various functions
@@ -53,6 +55,11 @@ typedef struct {
   EFI_EXT_SCSI_PASS_THRU_PROTOCOL    PassThru;       // VirtioScsiInit      1
   EFI_EXT_SCSI_PASS_THRU_MODE        PassThruMode;   // VirtioScsiInit      1
   VOID                               *RingMap;       // VirtioRingMap       2
+  UINT16                             SlotCount;      // VirtioScsiInit      1
+  UINT16                             LastUsedIdx;    // VirtioScsiInit      1
+  UINTN                              PendingCount;   // VirtioScsiInit      1
+  VSCSI_REQ                          **InFlight;     // VirtioScsiInit      1
+  EFI_EVENT                          Timer;          // VirtioScsiInit      1
 } VSCSI_DEV;
 
 #define VIRTIO_SCSI_FROM_PASS_THRU(PassThruPointer) \
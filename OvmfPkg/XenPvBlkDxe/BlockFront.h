@@ -11,6 +11,12 @@
 #include <IndustryStandard/Xen/event_channel.h>
 #include <IndustryStandard/Xen/io/blkif.h>
 
+//
+// Number of requests of a single BlockIo read or write that are queued on
+// the ring at the same time. A single page ring holds 32 requests.
+//
+#define XEN_BLOCK_FRONT_MAX_IN_FLIGHT  16
+
 typedef struct _XEN_BLOCK_FRONT_DEVICE  XEN_BLOCK_FRONT_DEVICE;
 typedef struct _XEN_BLOCK_FRONT_IO      XEN_BLOCK_FRONT_IO;
 
@@ -73,10 +73,14 @@ XenPvBlkDxeBlockIoReadWriteBlocks (
   IN     BOOLEAN                IsWrite
   )
 {
-  XEN_BLOCK_FRONT_IO  IoData;
-  EFI_BLOCK_IO_MEDIA  *Media = This->Media;
-  UINTN               Sector;
-  EFI_STATUS          Status;
+  XEN_BLOCK_FRONT_IO      IoData[XEN_BLOCK_FRONT_MAX_IN_FLIGHT];
+  XEN_BLOCK_FRONT_IO      *Io;
+  XEN_BLOCK_FRONT_DEVICE  *Dev;
+  EFI_BLOCK_IO_MEDIA      *Media = This->Media;
+  UINTN                   Sector;
+  UINTN                   Index;
+  UINTN                   Count;
+  EFI_STATUS              Status;
 
   if (Buffer == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -150,38 +154,79 @@ XenPvBlkDxeBlockIoReadWriteBlocks (
     return Status;
   }
 
-  IoData.Dev = XEN_BLOCK_FRONT_FROM_BLOCK_IO (This);
-  Sector     = (UINTN)MultU64x32 (Lba, Media->BlockSize / 512);
+  Dev    = XEN_BLOCK_FRONT_FROM_BLOCK_IO (This);
+  Sector = (UINTN)MultU64x32 (Lba, Media->BlockSize / 512);
+  Count  = 0;
+  Status = EFI_SUCCESS;
+
+  //
+  // Keep up to XEN_BLOCK_FRONT_MAX_IN_FLIGHT requests on the ring, so the
+  // backend works on the next part of the buffer while the previous one is
+  // being completed. A request slot is only reused once its request is done.
+  //
+  while ((BufferSize > 0) && !EFI_ERROR (Status)) {
+    Io = &IoData[Count % XEN_BLOCK_FRONT_MAX_IN_FLIGHT];
+    if (Count >= XEN_BLOCK_FRONT_MAX_IN_FLIGHT) {
+      while (Io->Status == EFI_ALREADY_STARTED) {
+        XenPvBlockAsyncIoPoll (Dev);
+      }
+
+      Status = Io->Status;
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+    }
 
-  while (BufferSize > 0) {
     if (((UINTN)Buffer & EFI_PAGE_MASK) == 0) {
-      IoData.Size = MIN (
-                      BLKIF_MAX_SEGMENTS_PER_REQUEST * EFI_PAGE_SIZE,
-                      BufferSize
-                      );
+      Io->Size = MIN (
+                   BLKIF_MAX_SEGMENTS_PER_REQUEST * EFI_PAGE_SIZE,
+                   BufferSize
+                   );
     } else {
-      IoData.Size = MIN (
-                      (BLKIF_MAX_SEGMENTS_PER_REQUEST - 1) * EFI_PAGE_SIZE,
-                      BufferSize
-                      );
+      Io->Size = MIN (
+                   (BLKIF_MAX_SEGMENTS_PER_REQUEST - 1) * EFI_PAGE_SIZE,
+                   BufferSize
+                   );
     }
 
-    IoData.Buffer = Buffer;
-    IoData.Sector = Sector;
-    BufferSize   -= IoData.Size;
-    Buffer        = (VOID *)((UINTN)Buffer + IoData.Size);
-    Sector       += IoData.Size / 512;
-    Status        = XenPvBlockIo (&IoData, IsWrite);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((
-        DEBUG_ERROR,
-        "XenPvBlkDxe: Error during %a operation.\n",
-        IsWrite ? "write" : "read"
-        ));
-      return Status;
+    Io->Dev    = Dev;
+    Io->Buffer = Buffer;
+    Io->Sector = Sector;
+    BufferSize = BufferSize - Io->Size;
+    Buffer     = (VOID *)((UINTN)Buffer + Io->Size);
+    Sector    += Io->Size / 512;
+
+    //
+    // Status value that correspond to an IO in progress.
+    //
+    Io->Status = EFI_ALREADY_STARTED;
+    XenPvBlockAsyncIo (Io, IsWrite);
+    Count++;
+  }
+
+  //
+  // The ring refers to the requests on the stack, so wait for all of them
+  // even after an error.
+  //
+  for (Index = 0; Index < MIN (Count, XEN_BLOCK_FRONT_MAX_IN_FLIGHT); Index++) {
+    while (IoData[Index].Status == EFI_ALREADY_STARTED) {
+      XenPvBlockAsyncIoPoll (Dev);
+    }
+
+    if (!EFI_ERROR (Status)) {
+      Status = IoData[Index].Status;
     }
   }
 
+  if (EFI_ERROR (Status)) {
+    DEBUG ((
+      DEBUG_ERROR,
+      "XenPvBlkDxe: Error during %a operation.\n",
+      IsWrite ? "write" : "read"
+      ));
+    return Status;
+  }
+
   return EFI_SUCCESS;
 }
 
@@ -33,6 +33,31 @@
 UINTN  mPrmHandlerCount;
 UINTN  mPrmModuleCount;
 
+/**
+  Compares the GUIDs of two PRM handler information structures.
+
+  @param[in]  Buffer1                     A pointer to the first PRM_HANDLER_INFORMATION_STRUCT.
+  @param[in]  Buffer2                     A pointer to the second PRM_HANDLER_INFORMATION_STRUCT.
+
+  @retval <0                              The GUID of Buffer1 sorts before the GUID of Buffer2.
+  @retval 0                               The GUIDs are identical.
+  @retval >0                              The GUID of Buffer1 sorts after the GUID of Buffer2.
+
+**/
+INTN
+EFIAPI
+PrmHandlerInfoStructCompare (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  return CompareMem (
+           &((CONST PRM_HANDLER_INFORMATION_STRUCT *)Buffer1)->Identifier,
+           &((CONST PRM_HANDLER_INFORMATION_STRUCT *)Buffer2)->Identifier,
+           sizeof (GUID)
+           );
+}
+
 /**
   Processes a list of PRM context entries to build a PRM ACPI table.
 
@@ -71,7 +96,8 @@ ProcessPrmModules (
   UINTN                 HandlerIndex;
   UINT32                PrmAcpiDescriptionTableBufferSize;
 
-  UINT64  HandlerPhysicalAddress;
+  UINT64                          HandlerPhysicalAddress;
+  PRM_HANDLER_INFORMATION_STRUCT  HandlerInfoStructBuffer;
 
   DEBUG ((DEBUG_INFO, "%a %a - Entry.\n", _DBGMSGID_, __func__));
 
@@ -232,6 +258,18 @@ ProcessPrmModules (
       }
     }
 
+    //
+    // Keep the handlers of the module sorted by GUID so a handler can be found in the
+    // PRMT with a binary search instead of a walk over all of the handlers.
+    //
+    QuickSort (
+      CurrentModuleInfoStruct->HandlerInfoStructure,
+      CurrentModuleInfoStruct->HandlerCount,
+      sizeof (PRM_HANDLER_INFORMATION_STRUCT),
+      PrmHandlerInfoStructCompare,
+      &HandlerInfoStructBuffer
+      );
+
     CurrentModuleInfoStruct = (PRM_MODULE_INFORMATION_STRUCT *)((UINTN)CurrentModuleInfoStruct + CurrentModuleInfoStruct->StructureLength);
   }
 
@@ -945,4 +945,144 @@ JsonGetType (
   IN EDKII_JSON_VALUE  JsonValue
   );
 
+///
+///  Type of the tokens returned by JsonReaderNext().
+///
+typedef enum {
+  EdkiiJsonTokenObjectStart,
+  EdkiiJsonTokenObjectEnd,
+  EdkiiJsonTokenArrayStart,
+  EdkiiJsonTokenArrayEnd,
+  EdkiiJsonTokenKey,
+  EdkiiJsonTokenString,
+  EdkiiJsonTokenNumber,
+  EdkiiJsonTokenTrue,
+  EdkiiJsonTokenFalse,
+  EdkiiJsonTokenNull
+} EDKII_JSON_TOKEN_TYPE;
+
+///
+///  A token of the JSON text read by JsonReaderNext(). Text points into the
+///  JSON text. For a key or a string, it is the text between the quotes with
+///  the escape sequences left as they are. Depth is the number of objects and
+///  arrays the token is in, so the root object and its end are at depth 0.
+///
+typedef struct {
+  EDKII_JSON_TOKEN_TYPE    Type;
+  CONST CHAR8              *Text;
+  UINTN                    Length;
+  UINTN                    Depth;
+} EDKII_JSON_TOKEN;
+
+#define EDKII_JSON_READER_MAX_DEPTH  32
+
+///
+///  State of a JSON pull reader. The members are private to JsonLib.
+///
+typedef struct {
+  CONST CHAR8    *Buffer;
+  UINTN          BufferLen;
+  UINTN          Position;
+  UINTN          Depth;
+  UINTN          State;
+  CHAR8          Containers[EDKII_JSON_READER_MAX_DEPTH];
+} EDKII_JSON_READER;
+
+/**
+  Initialize a pull reader on a JSON text.
+
+  The reader returns the tokens of the text one by one without allocating
+  memory, so a large payload such as a Redfish collection can be walked
+  through, and only the values of interest loaded with JsonReaderLoadValue().
+  The buffer must stay valid while the reader is used.
+
+  @param[out]  Reader        The reader to initialize.
+  @param[in]   Buffer        The JSON text. It does not need to be NULL terminated.
+  @param[in]   BufferLen     The length of the JSON text.
+
+  @retval      EFI_SUCCESS            The reader is initialized.
+  @retval      EFI_INVALID_PARAMETER  Reader or Buffer is NULL.
+**/
+EFI_STATUS
+EFIAPI
+JsonReaderInit (
+  OUT EDKII_JSON_READER  *Reader,
+  IN  CONST CHAR8        *Buffer,
+  IN  UINTN              BufferLen
+  );
+
+/**
+  Read the next token of the JSON text.
+
+  @param[in, out]  Reader     The reader initialized by JsonReaderInit().
+  @param[out]      Token      The token read.
+
+  @retval      EFI_SUCCESS            The token is returned.
+  @retval      EFI_END_OF_FILE        The whole JSON text was read.
+  @retval      EFI_INVALID_PARAMETER  Reader or Token is NULL.
+  @retval      EFI_COMPROMISED_DATA   The JSON text is malformed. The reader
+                                      cannot be used anymore.
+  @retval      EFI_UNSUPPORTED        The objects and arrays are nested deeper
+                                      than EDKII_JSON_READER_MAX_DEPTH.
+**/
+EFI_STATUS
+EFIAPI
+JsonReaderNext (
+  IN OUT EDKII_JSON_READER  *Reader,
+  OUT    EDKII_JSON_TOKEN   *Token
+  );
+
+/**
+  Skip the value that starts with the given token. For an object or an
+  array, the tokens up to its end are read. For other values, nothing is
+  read.
+
+  @param[in, out]  Reader     The reader that returned Token.
+  @param[in]       Token      The first token of the value to skip.
+
+  @retval      EFI_SUCCESS            The value is skipped.
+  @retval      Others                 The error returned by JsonReaderNext().
+**/
+EFI_STATUS
+EFIAPI
+JsonReaderSkipValue (
+  IN OUT EDKII_JSON_READER  *Reader,
+  IN     EDKII_JSON_TOKEN   *Token
+  );
+
+/**
+  Load the value that starts with the given token to a JSON value, and
+  skip it in the reader.
+
+  Caller needs to cleanup the value by calling JsonValueFree().
+
+  @param[in, out]  Reader     The reader that returned Token.
+  @param[in]       Token      The first token of the value to load. It must
+                              not be a key or the end of an object or array.
+
+  @retval      EDKII_JSON_VALUE  NULL means fail to load the value.
+**/
+EDKII_JSON_VALUE
+EFIAPI
+JsonReaderLoadValue (
+  IN OUT EDKII_JSON_READER  *Reader,
+  IN     EDKII_JSON_TOKEN   *Token
+  );
+
+/**
+  Check whether the token is the given key.
+
+  @param[in]   Token      The token to check.
+  @param[in]   Key        The NULL terminated key, without escape sequences.
+
+  @retval      TRUE       The token is a key equal to Key.
+  @retval      FALSE      The token is not a key, or another key.
+**/
+BOOLEAN
+EFIAPI
+JsonReaderIsKey (
+  IN EDKII_JSON_TOKEN  *Token,
+  IN CONST CHAR8       *Key
+  );
+
 #endif
@@ -283,6 +283,44 @@ EFI_STATUS
   OUT REDFISH_RESPONSE             *Response
   );
 
+/**
+  Perform HTTP GET to get a list of redfish resources, for example the
+  members of a collection, with cache mechanism supported. The requests are
+  sent one after another on the connection of Service. Once the Redfish
+  service cannot be reached, the resources that are not cached are not
+  requested anymore. It's caller's responsibility to free each Response
+  by calling FreeResponse ().
+
+  @param[in]  This          Pointer to EDKII_REDFISH_HTTP_PROTOCOL instance.
+  @param[in]  Service       Redfish service instance to perform HTTP GET.
+  @param[in]  Count         Number of entries in Uris, Responses and Statuses.
+  @param[in]  Uris          Target resource URIs.
+  @param[out] Responses     HTTP responses from redfish service, one for
+                            each URI.
+  @param[out] Statuses      Status of each GET. EFI_ABORTED means the
+                            resource was not requested because the Redfish
+                            service could not be reached.
+  @param[in]  UseCache      If it is TRUE, this function will search for
+                            cache first. If it is FALSE, this function
+                            will query Redfish URI directly.
+
+  @retval     EFI_SUCCESS            All resources are returned successfully.
+  @retval     EFI_INVALID_PARAMETER  One of the parameters is invalid.
+  @retval     Others                 The status of the first GET that failed.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *REDFISH_HTTP_GET_RESOURCES)(
+  IN  EDKII_REDFISH_HTTP_PROTOCOL  *This,
+  IN  REDFISH_SERVICE              Service,
+  IN  UINTN                        Count,
+  IN  EFI_STRING                   *Uris,
+  OUT REDFISH_RESPONSE             *Responses,
+  OUT EFI_STATUS                   *Statuses,
+  IN  BOOLEAN                      UseCache
+  );
+
 ///
 /// Definition of _EDKII_REDFISH_HTTP_PROTOCOL.
 ///
@@ -299,9 +337,10 @@ struct _EDKII_REDFISH_HTTP_PROTOCOL {
   REDFISH_HTTP_FREE_REQUEST       FreeRequest;
   REDFISH_HTTP_FREE_RESPONSE      FreeResponse;
   REDFISH_HTTP_EXPIRE_RESPONSE    ExpireResponse;
+  REDFISH_HTTP_GET_RESOURCES      GetResources;
 };
 
-#define EDKII_REDFISH_HTTP_PROTOCOL_REVISION  0x00001000
+#define EDKII_REDFISH_HTTP_PROTOCOL_REVISION  0x00001001
 
 extern EFI_GUID  gEdkIIRedfishHttpProtocolGuid;
 
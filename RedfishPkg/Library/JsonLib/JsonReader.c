@@ -0,0 +1,521 @@
+/** @file
+  A pull reader for JSON text.
+
+  JsonLoadBuffer() builds the whole JSON value of a payload in memory. The
+  reader below returns the tokens of the text one by one instead, so a large
+  payload can be walked through and only the values of interest loaded.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+
+    SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/JsonLib.h>
+
+//
+// What the reader expects next.
+//
+#define JSON_READER_VALUE         0     // A value.
+#define JSON_READER_VALUE_OR_END  1     // A value or the end of an array.
+#define JSON_READER_KEY           2     // A key.
+#define JSON_READER_KEY_OR_END    3     // A key or the end of an object.
+#define JSON_READER_COLON         4     // The colon after a key.
+#define JSON_READER_COMMA_OR_END  5     // A comma or the end of the container.
+#define JSON_READER_DONE          6     // Nothing, the root value was read.
+#define JSON_READER_ERROR         7     // Nothing, the text is malformed.
+
+/**
+  Skip the white spaces of the JSON text.
+
+  @param[in, out]  Reader     The reader.
+**/
+STATIC
+VOID
+JsonReaderSkipSpaces (
+  IN OUT EDKII_JSON_READER  *Reader
+  )
+{
+  CHAR8  Char;
+
+  while (Reader->Position < Reader->BufferLen) {
+    Char = Reader->Buffer[Reader->Position];
+    if ((Char != ' ') && (Char != '\t') && (Char != '\n') && (Char != '\r')) {
+      break;
+    }
+
+    Reader->Position++;
+  }
+}
+
+/**
+  Scan a string. Reader->Position is on the opening quote.
+
+  @param[in, out]  Reader     The reader.
+  @param[out]      Token      The token receiving the string.
+
+  @retval      TRUE       The string is returned.
+  @retval      FALSE      The string is malformed.
+**/
+STATIC
+BOOLEAN
+JsonReaderScanString (
+  IN OUT EDKII_JSON_READER  *Reader,
+  OUT    EDKII_JSON_TOKEN   *Token
+  )
+{
+  UINTN  Start;
+  UINTN  Index;
+  CHAR8  Char;
+
+  Start = ++Reader->Position;
+  while (Reader->Position < Reader->BufferLen) {
+    Char = Reader->Buffer[Reader->Position];
+    if (Char == '"') {
+      Token->Text   = Reader->Buffer + Start;
+      Token->Length = Reader->Position - Start;
+      Reader->Position++;
+      return TRUE;
+    }
+
+    if ((UINT8)Char < ' ') {
+      return FALSE;
+    }
+
+    Reader->Position++;
+    if (Char != '\\') {
+      continue;
+    }
+
+    if (Reader->Position >= Reader->BufferLen) {
+      return FALSE;
+    }
+
+    Char = Reader->Buffer[Reader->Position++];
+    if (Char == 'u') {
+      if (Reader->BufferLen - Reader->Position < 4) {
+        return FALSE;
+      }
+
+      for (Index = 0; Index < 4; Index++) {
+        Char = Reader->Buffer[Reader->Position++];
+        if (!(((Char >= '0') && (Char <= '9')) || ((Char >= 'a') && (Char <= 'f')) || ((Char >= 'A') && (Char <= 'F')))) {
+          return FALSE;
+        }
+      }
+    } else if ((Char != '"') && (Char != '\\') && (Char != '/') && (Char != 'b') &&
+               (Char != 'f') && (Char != 'n') && (Char != 'r') && (Char != 't'))
+    {
+      return FALSE;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Scan the digits of a number.
+
+  @param[in, out]  Reader     The reader.
+
+  @return The number of digits scanned.
+**/
+STATIC
+UINTN
+JsonReaderScanDigits (
+  IN OUT EDKII_JSON_READER  *Reader
+  )
+{
+  UINTN  Start;
+
+  Start = Reader->Position;
+  while ((Reader->Position < Reader->BufferLen) &&
+         (Reader->Buffer[Reader->Position] >= '0') && (Reader->Buffer[Reader->Position] <= '9'))
+  {
+    Reader->Position++;
+  }
+
+  return Reader->Position - Start;
+}
+
+/**
+  Scan a number, a literal or the start of an object or array.
+
+  @param[in, out]  Reader     The reader.
+  @param[out]      Token      The token receiving the value.
+
+  @retval      TRUE       The value is returned.
+  @retval      FALSE      The value is malformed.
+**/
+STATIC
+BOOLEAN
+JsonReaderScanValue (
+  IN OUT EDKII_JSON_READER  *Reader,
+  OUT    EDKII_JSON_TOKEN   *Token
+  )
+{
+  CONST CHAR8  *Text;
+  CONST CHAR8  *Literal;
+  UINTN        Start;
+
+  Text    = Reader->Buffer + Reader->Position;
+  Start   = Reader->Position;
+  Literal = NULL;
+
+  switch (*Text) {
+    case '"':
+      Token->Type = EdkiiJsonTokenString;
+      return JsonReaderScanString (Reader, Token);
+
+    case '{':
+    case '[':
+      Token->Type   = (*Text == '{') ? EdkiiJsonTokenObjectStart : EdkiiJsonTokenArrayStart;
+      Token->Text   = Text;
+      Token->Length = 1;
+      Reader->Position++;
+      return TRUE;
+
+    case 't':
+      Token->Type = EdkiiJsonTokenTrue;
+      Literal     = "true";
+      break;
+
+    case 'f':
+      Token->Type = EdkiiJsonTokenFalse;
+      Literal     = "false";
+      break;
+
+    case 'n':
+      Token->Type = EdkiiJsonTokenNull;
+      Literal     = "null";
+      break;
+
+    default:
+      //
+      // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+      //
+      Token->Type = EdkiiJsonTokenNumber;
+      Token->Text = Text;
+      if (*Text == '-') {
+        Reader->Position++;
+      }
+
+      if ((Reader->Position < Reader->BufferLen) && (Reader->Buffer[Reader->Position] == '0')) {
+        Reader->Position++;
+      } else if (JsonReaderScanDigits (Reader) == 0) {
+        return FALSE;
+      }
+
+      if ((Reader->Position < Reader->BufferLen) && (Reader->Buffer[Reader->Position] == '.')) {
+        Reader->Position++;
+        if (JsonReaderScanDigits (Reader) == 0) {
+          return FALSE;
+        }
+      }
+
+      if ((Reader->Position < Reader->BufferLen) &&
+          ((Reader->Buffer[Reader->Position] == 'e') || (Reader->Buffer[Reader->Position] == 'E')))
+      {
+        Reader->Position++;
+        if ((Reader->Position < Reader->BufferLen) &&
+            ((Reader->Buffer[Reader->Position] == '+') || (Reader->Buffer[Reader->Position] == '-')))
+        {
+          Reader->Position++;
+        }
+
+        if (JsonReaderScanDigits (Reader) == 0) {
+          return FALSE;
+        }
+      }
+
+      Token->Length = Reader->Position - Start;
+      return TRUE;
+  }
+
+  //
+  // true, false or null.
+  //
+  Token->Text   = Text;
+  Token->Length = AsciiStrLen (Literal);
+  if ((Reader->BufferLen - Start < Token->Length) || (CompareMem (Text, Literal, Token->Length) != 0)) {
+    return FALSE;
+  }
+
+  Reader->Position += Token->Length;
+  return TRUE;
+}
+
+/**
+  Initialize a pull reader on a JSON text.
+
+  The reader returns the tokens of the text one by one without allocating
+  memory, so a large payload such as a Redfish collection can be walked
+  through, and only the values of interest loaded with JsonReaderLoadValue().
+  The buffer must stay valid while the reader is used.
+
+  @param[out]  Reader        The reader to initialize.
+  @param[in]   Buffer        The JSON text. It does not need to be NULL terminated.
+  @param[in]   BufferLen     The length of the JSON text.
+
+  @retval      EFI_SUCCESS            The reader is initialized.
+  @retval      EFI_INVALID_PARAMETER  Reader or Buffer is NULL.
+**/
+EFI_STATUS
+EFIAPI
+JsonReaderInit (
+  OUT EDKII_JSON_READER  *Reader,
+  IN  CONST CHAR8        *Buffer,
+  IN  UINTN              BufferLen
+  )
+{
+  if ((Reader == NULL) || (Buffer == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  ZeroMem (Reader, sizeof (EDKII_JSON_READER));
+  Reader->Buffer    = Buffer;
+  Reader->BufferLen = BufferLen;
+  Reader->State     = JSON_READER_VALUE;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Read the next token of the JSON text.
+
+  @param[in, out]  Reader     The reader initialized by JsonReaderInit().
+  @param[out]      Token      The token read.
+
+  @retval      EFI_SUCCESS            The token is returned.
+  @retval      EFI_END_OF_FILE        The whole JSON text was read.
+  @retval      EFI_INVALID_PARAMETER  Reader or Token is NULL.
+  @retval      EFI_COMPROMISED_DATA   The JSON text is malformed. The reader
+                                      cannot be used anymore.
+  @retval      EFI_UNSUPPORTED        The objects and arrays are nested deeper
+                                      than EDKII_JSON_READER_MAX_DEPTH.
+**/
+EFI_STATUS
+EFIAPI
+JsonReaderNext (
+  IN OUT EDKII_JSON_READER  *Reader,
+  OUT    EDKII_JSON_TOKEN   *Token
+  )
+{
+  CHAR8  Char;
+
+  if ((Reader == NULL) || (Token == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  while (TRUE) {
+    JsonReaderSkipSpaces (Reader);
+
+    if (Reader->State == JSON_READER_ERROR) {
+      return EFI_COMPROMISED_DATA;
+    }
+
+    if (Reader->State == JSON_READER_DONE) {
+      if (Reader->Position < Reader->BufferLen) {
+        Reader->State = JSON_READER_ERROR;
+        return EFI_COMPROMISED_DATA;
+      }
+
+      return EFI_END_OF_FILE;
+    }
+
+    if (Reader->Position >= Reader->BufferLen) {
+      Reader->State = JSON_READER_ERROR;
+      return EFI_COMPROMISED_DATA;
+    }
+
+    Char         = Reader->Buffer[Reader->Position];
+    Token->Depth = Reader->Depth;
+
+    //
+    // The end of an object or array.
+    //
+    if (((Char == '}') && ((Reader->State == JSON_READER_KEY_OR_END) || (Reader->State == JSON_READER_COMMA_OR_END))) ||
+        ((Char == ']') && ((Reader->State == JSON_READER_VALUE_OR_END) || (Reader->State == JSON_READER_COMMA_OR_END))))
+    {
+      if ((Reader->Depth == 0) || (Reader->Containers[Reader->Depth - 1] != ((Char == '}') ? '{' : '['))) {
+        break;
+      }
+
+      Reader->Depth--;
+      Token->Type   = (Char == '}') ? EdkiiJsonTokenObjectEnd : EdkiiJsonTokenArrayEnd;
+      Token->Text   = Reader->Buffer + Reader->Position;
+      Token->Length = 1;
+      Token->Depth  = Reader->Depth;
+      Reader->Position++;
+      Reader->State = (Reader->Depth == 0) ? JSON_READER_DONE : JSON_READER_COMMA_OR_END;
+      return EFI_SUCCESS;
+    }
+
+    switch (Reader->State) {
+      case JSON_READER_COMMA_OR_END:
+        if (Char != ',') {
+          break;
+        }
+
+        Reader->Position++;
+        Reader->State = (Reader->Containers[Reader->Depth - 1] == '{') ? JSON_READER_KEY : JSON_READER_VALUE;
+        continue;
+
+      case JSON_READER_COLON:
+        if (Char != ':') {
+          break;
+        }
+
+        Reader->Position++;
+        Reader->State = JSON_READER_VALUE;
+        continue;
+
+      case JSON_READER_KEY:
+      case JSON_READER_KEY_OR_END:
+        if ((Char != '"') || !JsonReaderScanString (Reader, Token)) {
+          break;
+        }
+
+        Token->Type   = EdkiiJsonTokenKey;
+        Reader->State = JSON_READER_COLON;
+        return EFI_SUCCESS;
+
+      case JSON_READER_VALUE:
+      case JSON_READER_VALUE_OR_END:
+        if (!JsonReaderScanValue (Reader, Token)) {
+          break;
+        }
+
+        if ((Token->Type == EdkiiJsonTokenObjectStart) || (Token->Type == EdkiiJsonTokenArrayStart)) {
+          if (Reader->Depth >= EDKII_JSON_READER_MAX_DEPTH) {
+            Reader->State = JSON_READER_ERROR;
+            return EFI_UNSUPPORTED;
+          }
+
+          Reader->Containers[Reader->Depth++] = *Token->Text;
+          Reader->State                       = (*Token->Text == '{') ? JSON_READER_KEY_OR_END : JSON_READER_VALUE_OR_END;
+        } else {
+          Reader->State = (Reader->Depth == 0) ? JSON_READER_DONE : JSON_READER_COMMA_OR_END;
+        }
+
+        return EFI_SUCCESS;
+
+      default:
+        break;
+    }
+
+    break;
+  }
+
+  Reader->State = JSON_READER_ERROR;
+  return EFI_COMPROMISED_DATA;
+}
+
+/**
+  Skip the value that starts with the given token. For an object or an
+  array, the tokens up to its end are read. For other values, nothing is
+  read.
+
+  @param[in, out]  Reader     The reader that returned Token.
+  @param[in]       Token      The first token of the value to skip.
+
+  @retval      EFI_SUCCESS            The value is skipped.
+  @retval      Others                 The error returned by JsonReaderNext().
+**/
+EFI_STATUS
+EFIAPI
+JsonReaderSkipValue (
+  IN OUT EDKII_JSON_READER  *Reader,
+  IN     EDKII_JSON_TOKEN   *Token
+  )
+{
+  EFI_STATUS        Status;
+  EDKII_JSON_TOKEN  Next;
+
+  if ((Reader == NULL) || (Token == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if ((Token->Type != EdkiiJsonTokenObjectStart) && (Token->Type != EdkiiJsonTokenArrayStart)) {
+    return EFI_SUCCESS;
+  }
+
+  do {
+    Status = JsonReaderNext (Reader, &Next);
+    if (EFI_ERROR (Status)) {
+      return (Status == EFI_END_OF_FILE) ? EFI_COMPROMISED_DATA : Status;
+    }
+  } while ((Next.Depth != Token->Depth) ||
+           ((Next.Type != EdkiiJsonTokenObjectEnd) && (Next.Type != EdkiiJsonTokenArrayEnd)));
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Load the value that starts with the given token to a JSON value, and
+  skip it in the reader.
+
+  Caller needs to cleanup the value by calling JsonValueFree().
+
+  @param[in, out]  Reader     The reader that returned Token.
+  @param[in]       Token      The first token of the value to load. It must
+                              not be a key or the end of an object or array.
+
+  @retval      EDKII_JSON_VALUE  NULL means fail to load the value.
+**/
+EDKII_JSON_VALUE
+EFIAPI
+JsonReaderLoadValue (
+  IN OUT EDKII_JSON_READER  *Reader,
+  IN     EDKII_JSON_TOKEN   *Token
+  )
+{
+  CONST CHAR8  *Start;
+  UINTN        Length;
+
+  if ((Reader == NULL) || (Token == NULL) ||
+      (Token->Type == EdkiiJsonTokenKey) || (Token->Type == EdkiiJsonTokenObjectEnd) || (Token->Type == EdkiiJsonTokenArrayEnd))
+  {
+    return NULL;
+  }
+
+  Start  = Token->Text;
+  Length = Token->Length;
+  if (Token->Type == EdkiiJsonTokenString) {
+    Start--;
+    Length += 2;
+  } else if ((Token->Type == EdkiiJsonTokenObjectStart) || (Token->Type == EdkiiJsonTokenArrayStart)) {
+    if (EFI_ERROR (JsonReaderSkipValue (Reader, Token))) {
+      return NULL;
+    }
+
+    Length = Reader->Buffer + Reader->Position - Start;
+  }
+
+  return JsonLoadBuffer (Start, Length, EDKII_JSON_DECODE_ANY, NULL);
+}
+
+/**
+  Check whether the token is the given key.
+
+  @param[in]   Token      The token to check.
+  @param[in]   Key        The NULL terminated key, without escape sequences.
+
+  @retval      TRUE       The token is a key equal to Key.
+  @retval      FALSE      The token is not a key, or another key.
+**/
+BOOLEAN
+EFIAPI
+JsonReaderIsKey (
+  IN EDKII_JSON_TOKEN  *Token,
+  IN CONST CHAR8       *Key
+  )
+{
+  if ((Token == NULL) || (Key == NULL) || (Token->Type != EdkiiJsonTokenKey)) {
+    return FALSE;
+  }
+
+  return (BOOLEAN)((AsciiStrLen (Key) == Token->Length) && (CompareMem (Token->Text, Key, Token->Length) == 0));
+}
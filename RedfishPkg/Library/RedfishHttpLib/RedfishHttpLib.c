@@ -206,6 +206,84 @@ RedfishHttpGetResource (
                                  );
 }
 
+/**
+  Get a list of redfish resources, for example the members of a collection,
+  with cache mechanism supported. Once the Redfish service cannot be
+  reached, the resources that are not cached are not requested anymore.
+  It's caller's responsibility to free each Response by calling
+  RedfishHttpFreeResponse ().
+
+  @param[in]  Service       Redfish service instance to perform HTTP GET.
+  @param[in]  Count         Number of entries in Uris, Responses and Statuses.
+  @param[in]  Uris          Target resource URIs.
+  @param[out] Responses     HTTP responses from redfish service, one for
+                            each URI.
+  @param[out] Statuses      Status of each GET. EFI_ABORTED means the
+                            resource was not requested because the Redfish
+                            service could not be reached.
+  @param[in]  UseCache      If it is TRUE, this function will search for
+                            cache first. If it is FALSE, this function
+                            will query Redfish URI directly.
+
+  @retval     EFI_SUCCESS            All resources are returned successfully.
+  @retval     EFI_INVALID_PARAMETER  One of the parameters is invalid.
+  @retval     Others                 The status of the first GET that failed.
+
+**/
+EFI_STATUS
+RedfishHttpGetResources (
+  IN  REDFISH_SERVICE   Service,
+  IN  UINTN             Count,
+  IN  EFI_STRING        *Uris,
+  OUT REDFISH_RESPONSE  *Responses,
+  OUT EFI_STATUS        *Statuses,
+  IN  BOOLEAN           UseCache
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Index;
+
+  if (mRedfishHttpProtocol == NULL) {
+    return EFI_NOT_READY;
+  }
+
+  if (mRedfishHttpProtocol->Version >= EDKII_REDFISH_HTTP_PROTOCOL_REVISION) {
+    return mRedfishHttpProtocol->GetResources (
+                                   mRedfishHttpProtocol,
+                                   Service,
+                                   Count,
+                                   Uris,
+                                   Responses,
+                                   Statuses,
+                                   UseCache
+                                   );
+  }
+
+  //
+  // The protocol has no GetResources () before revision 0x00001001.
+  //
+  if ((Uris == NULL) || (Responses == NULL) || (Statuses == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Status = EFI_SUCCESS;
+  for (Index = 0; Index < Count; Index++) {
+    Statuses[Index] = mRedfishHttpProtocol->GetResource (
+                                              mRedfishHttpProtocol,
+                                              Service,
+                                              Uris[Index],
+                                              NULL,
+                                              &Responses[Index],
+                                              UseCache
+                                              );
+    if (EFI_ERROR (Statuses[Index]) && !EFI_ERROR (Status)) {
+      Status = Statuses[Index];
+    }
+  }
+
+  return Status;
+}
+
 /**
   Perform HTTP PATCH to send redfish resource to given resource URI.
   It's caller's responsibility to free Response by calling RedfishHttpFreeResponse ().
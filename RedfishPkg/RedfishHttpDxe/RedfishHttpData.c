@@ -385,6 +385,14 @@ ReleaseHttpCacheData (
     FreePool (Data->Response);
   }
 
+  if (Data->ETag != NULL) {
+    FreePool (Data->ETag);
+  }
+
+  if (Data->Body != NULL) {
+    FreePool (Data->Body);
+  }
+
   FreePool (Data);
 
   return EFI_SUCCESS;
@@ -408,6 +416,7 @@ NewHttpCacheData (
 {
   REDFISH_HTTP_CACHE_DATA  *NewData;
   UINTN                    Size;
+  EFI_HTTP_HEADER          *ETagHeader;
 
   if (IS_EMPTY_STRING (Uri) || (Response == NULL)) {
     return NULL;
@@ -425,6 +434,20 @@ NewHttpCacheData (
     goto ON_ERROR;
   }
 
+  //
+  // Keep the entity tag of the resource so that the Redfish service can be
+  // asked to send the resource only if it changed.
+  //
+  if ((Response->Payload != NULL) && (Response->StatusCode != NULL) && (*Response->StatusCode == HTTP_STATUS_200_OK)) {
+    ETagHeader = HttpFindHeader (Response->HeaderCount, Response->Headers, HTTP_HEADER_ETAG);
+    if ((ETagHeader != NULL) && !IS_EMPTY_STRING (ETagHeader->FieldValue)) {
+      NewData->ETag = ASCII_STR_DUPLICATE (ETagHeader->FieldValue);
+      if (NewData->ETag == NULL) {
+        goto ON_ERROR;
+      }
+    }
+  }
+
   NewData->Response = Response;
   NewData->HitCount = 1;
 
@@ -553,6 +576,10 @@ DeleteHttpCacheData (
   RemoveEntryList (&Data->List);
   --List->Count;
 
+  if (Data->ETag != NULL) {
+    List->Modified = TRUE;
+  }
+
   return ReleaseHttpCacheData (Data);
 }
 
@@ -578,17 +605,31 @@ AddHttpCacheData (
   REDFISH_HTTP_CACHE_DATA  *OldData;
   REDFISH_HTTP_CACHE_DATA  *UnusedData;
   REDFISH_RESPONSE         *NewResponse;
+  EFI_HTTP_HEADER          *ETagHeader;
+  BOOLEAN                  Modified;
+  BOOLEAN                  SameETag;
 
   if ((List == NULL) || IS_EMPTY_STRING (Uri) || (Response == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
 
   //
-  // If same cache data exist, replace it with latest one.
+  // If same cache data exist, replace it with latest one. The stored cache
+  // does not need an update when the resource has the same ETag.
   //
-  OldData = FindHttpCacheData (&List->Head, Uri);
+  SameETag = FALSE;
+  OldData  = FindHttpCacheData (&List->Head, Uri);
   if (OldData != NULL) {
+    if (OldData->ETag != NULL) {
+      ETagHeader = HttpFindHeader (Response->HeaderCount, Response->Headers, HTTP_HEADER_ETAG);
+      SameETag   = (ETagHeader != NULL) && (ETagHeader->FieldValue != NULL) && (AsciiStrCmp (OldData->ETag, ETagHeader->FieldValue) == 0);
+    }
+
+    Modified = List->Modified;
     DeleteHttpCacheData (List, OldData);
+    if (SameETag) {
+      List->Modified = Modified;
+    }
   }
 
   //
@@ -620,11 +661,89 @@ AddHttpCacheData (
   InsertTailList (&List->Head, &NewData->List);
   ++List->Count;
 
+  if ((NewData->ETag != NULL) && !SameETag) {
+    List->Modified = TRUE;
+  }
+
   DEBUG ((REDFISH_HTTP_CACHE_DEBUG, "%a: cache(%d/%d) %s\n", __func__, List->Count, List->Capacity, NewData->Uri));
 
   return EFI_SUCCESS;
 }
 
+/**
+  Create the response of a cache data restored from the previous boot, once
+  the Redfish service confirmed that its ETag is still current.
+
+  @param[in]      Service   Redfish service the cache data is checked with.
+  @param[in,out]  Data      Cache data restored from the previous boot.
+
+  @retval EFI_SUCCESS            Data->Response is created.
+  @retval EFI_COMPROMISED_DATA   The stored payload is not valid JSON.
+  @retval Others                 Fail to create the response.
+
+**/
+EFI_STATUS
+RestoreHttpCacheData (
+  IN     REDFISH_SERVICE_PRIVATE  *Service,
+  IN OUT REDFISH_HTTP_CACHE_DATA  *Data
+  )
+{
+  EFI_STATUS        Status;
+  REDFISH_RESPONSE  *Response;
+  EDKII_JSON_VALUE  JsonValue;
+
+  if ((Service == NULL) || (Data == NULL) || (Data->ETag == NULL) || (Data->Body == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  JsonValue = JsonLoadString (Data->Body, 0, NULL);
+  if (JsonValue == NULL) {
+    return EFI_COMPROMISED_DATA;
+  }
+
+  Status   = EFI_OUT_OF_RESOURCES;
+  Response = AllocateZeroPool (sizeof (REDFISH_RESPONSE));
+  if (Response == NULL) {
+    goto ON_RELEASE;
+  }
+
+  Response->StatusCode = AllocateZeroPool (sizeof (EFI_HTTP_STATUS_CODE));
+  Response->Headers    = AllocateZeroPool (sizeof (EFI_HTTP_HEADER));
+  Response->Payload    = CreateRedfishPayload (Service, JsonValue);
+  if ((Response->StatusCode == NULL) || (Response->Headers == NULL) || (Response->Payload == NULL)) {
+    goto ON_RELEASE;
+  }
+
+  *Response->StatusCode = HTTP_STATUS_200_OK;
+  Status                = HttpSetFieldNameAndValue (Response->Headers, HTTP_HEADER_ETAG, Data->ETag);
+  if (EFI_ERROR (Status)) {
+    goto ON_RELEASE;
+  }
+
+  Response->HeaderCount = 1;
+
+  Data->Response = Response;
+  Response       = NULL;
+  FreePool (Data->Body);
+  Data->Body = NULL;
+
+ON_RELEASE:
+
+  if (Response != NULL) {
+    if ((Response->Headers != NULL) && (Response->HeaderCount == 0)) {
+      FreePool (Response->Headers);
+      Response->Headers = NULL;
+    }
+
+    ReleaseRedfishResponse (Response);
+    FreePool (Response);
+  }
+
+  JsonValueFree (JsonValue);
+
+  return Status;
+}
+
 /**
   Release all cache from list.
 
@@ -16,6 +16,7 @@
 #define REDFISH_HTTP_CACHE_SIGNATURE    SIGNATURE_32 ('r', 'f', 'c', 'h')
 #define REDFISH_HTTP_SERVICE_SIGNATURE  SIGNATURE_32 ('r', 'f', 's', 'v')
 #define REDFISH_HTTP_PAYLOAD_SIGNATURE  SIGNATURE_32 ('r', 'f', 'p', 'l')
+#define REDFISH_HTTP_STORE_SIGNATURE    SIGNATURE_32 ('r', 'f', 'c', 's')
 #define REDFISH_HTTP_BASIC_AUTH_STR     "Basic "
 
 ///
@@ -42,12 +43,18 @@ typedef struct {
 ///
 /// Definition of REDFISH_HTTP_CACHE_DATA
 ///
+/// A cache data restored from the previous boot has no Response until the
+/// Redfish service confirms that ETag is still current. Its payload is kept
+/// in Body as JSON text till then.
+///
 typedef struct {
   UINT32              Signature;
   LIST_ENTRY          List;
   EFI_STRING          Uri;
   UINTN               HitCount;
   REDFISH_RESPONSE    *Response;
+  CHAR8               *ETag;
+  CHAR8               *Body;
 } REDFISH_HTTP_CACHE_DATA;
 
 #define REDFISH_HTTP_CACHE_FROM_LIST(a)  CR (a, REDFISH_HTTP_CACHE_DATA, List, REDFISH_HTTP_CACHE_SIGNATURE)
@@ -59,8 +66,30 @@ typedef struct {
   LIST_ENTRY    Head;
   UINTN         Count;
   UINTN         Capacity;
+  BOOLEAN       Modified;     ///< The cache data with ETag changed since it was last stored.
 } REDFISH_HTTP_CACHE_LIST;
 
+///
+/// Definition of REDFISH_HTTP_STORE_HEADER. The cache data with ETag is
+/// stored in variables across boots as this header followed by Count
+/// REDFISH_HTTP_STORE_RECORD.
+///
+typedef struct {
+  UINT32    Signature;
+  UINT32    Size;             ///< The size of the store, header included.
+  UINT32    Count;
+} REDFISH_HTTP_STORE_HEADER;
+
+///
+/// Definition of REDFISH_HTTP_STORE_RECORD. The record is followed by the
+/// NULL terminated URI, ETag and JSON text of the payload.
+///
+typedef struct {
+  UINT32    UriSize;
+  UINT32    ETagSize;
+  UINT32    BodySize;
+} REDFISH_HTTP_STORE_RECORD;
+
 ///
 /// Definition of REDFISH_HTTP_RETRY_SETTING
 ///
@@ -81,6 +110,7 @@ typedef struct {
   EFI_HANDLE                            ImageHandle;
   BOOLEAN                               CacheDisabled;
   EFI_EVENT                             NotifyEvent;
+  EFI_EVENT                             ReadyToBootEvent;
   REDFISH_HTTP_CACHE_LIST               CacheList;
   EDKII_REDFISH_HTTP_PROTOCOL           Protocol;
   EDKII_REDFISH_CREDENTIAL2_PROTOCOL    *CredentialProtocol;
@@ -153,6 +183,77 @@ AddHttpCacheData (
   IN  REDFISH_RESPONSE         *Response
   );
 
+/**
+  Release REDFISH_HTTP_CACHE_DATA resource
+
+  @param[in]    Data    Pointer to REDFISH_HTTP_CACHE_DATA instance
+
+  @retval EFI_SUCCESS             REDFISH_HTTP_CACHE_DATA is released successfully.
+  @retval EFI_INVALID_PARAMETER   Data is NULL
+
+**/
+EFI_STATUS
+ReleaseHttpCacheData (
+  IN REDFISH_HTTP_CACHE_DATA  *Data
+  );
+
+/**
+  Create the response of a cache data restored from the previous boot, once
+  the Redfish service confirmed that its ETag is still current.
+
+  @param[in]      Service   Redfish service the cache data is checked with.
+  @param[in,out]  Data      Cache data restored from the previous boot.
+
+  @retval EFI_SUCCESS            Data->Response is created.
+  @retval EFI_COMPROMISED_DATA   The stored payload is not valid JSON.
+  @retval Others                 Fail to create the response.
+
+**/
+EFI_STATUS
+RestoreHttpCacheData (
+  IN     REDFISH_SERVICE_PRIVATE  *Service,
+  IN OUT REDFISH_HTTP_CACHE_DATA  *Data
+  );
+
+/**
+  Restore the cache data stored in the previous boot to the cache list.
+
+  @param[in]  List      Target cache list.
+  @param[in]  MaxSize   The maximum size of the store.
+
+  @retval EFI_SUCCESS             The stored cache data is restored.
+  @retval EFI_NOT_FOUND           Nothing is stored.
+  @retval EFI_COMPROMISED_DATA    The store is malformed. The cache data
+                                  before the malformed one is restored.
+  @retval Others                  Fail to read the store.
+
+**/
+EFI_STATUS
+LoadHttpCacheList (
+  IN REDFISH_HTTP_CACHE_LIST  *List,
+  IN UINTN                    MaxSize
+  );
+
+/**
+  Store the cache data with ETag in the cache list for the next boot.
+
+  Nothing is written when no cache data with ETag changed since the store
+  was restored or last written. Cache data that does not fit in MaxSize is
+  left out.
+
+  @param[in]  List      The cache list to store.
+  @param[in]  MaxSize   The maximum size of the store.
+
+  @retval EFI_SUCCESS             The cache data is stored.
+  @retval Others                  Fail to write the store.
+
+**/
+EFI_STATUS
+StoreHttpCacheList (
+  IN REDFISH_HTTP_CACHE_LIST  *List,
+  IN UINTN                    MaxSize
+  );
+
 /**
   Delete a cache data by given cache instance.
 
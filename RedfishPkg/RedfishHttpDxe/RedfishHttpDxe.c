@@ -556,6 +556,128 @@ RedfishJsonInRedfishPayload (
   return Payload->JsonValue;
 }
 
+/**
+  Perform HTTP GET to Get redfish resource from Redfish service, and retry
+  when the service is not ready.
+
+  @param[in]  Private       Pointer to driver private data.
+  @param[in]  Service       Redfish service instance to perform HTTP GET.
+  @param[in]  Uri           Target resource URI.
+  @param[in]  Request       Additional request context. This is optional.
+  @param[out] Response      HTTP response from redfish service.
+  @param[out] RetryCount    The number of requests sent.
+
+  @retval     EFI_SUCCESS     Resource is returned successfully.
+  @retval     Others          Errors occur.
+
+**/
+STATIC
+EFI_STATUS
+HttpGetWithRetry (
+  IN  REDFISH_HTTP_CACHE_PRIVATE  *Private,
+  IN  REDFISH_SERVICE             Service,
+  IN  EFI_STRING                  Uri,
+  IN  REDFISH_REQUEST             *Request OPTIONAL,
+  OUT REDFISH_RESPONSE            *Response,
+  OUT UINTN                       *RetryCount
+  )
+{
+  EFI_STATUS  Status;
+
+  *RetryCount = 0;
+  do {
+    *RetryCount += 1;
+    Status       = HttpSendReceive (
+                     Service,
+                     Uri,
+                     HttpMethodGet,
+                     Request,
+                     Response
+                     );
+    DEBUG ((REDFISH_HTTP_CACHE_DEBUG_REQUEST, "%a: HTTP request: %s :%r\n", __func__, Uri, Status));
+    if (!EFI_ERROR (Status) || (*RetryCount >= Private->RetrySetting.MaximumRetryGet)) {
+      break;
+    }
+
+    //
+    // Retry when BMC is not ready.
+    //
+    if ((Response->StatusCode != NULL)) {
+      DEBUG_CODE (
+        DumpRedfishResponse (NULL, DEBUG_ERROR, Response);
+        );
+
+      if (!RedfishRetryRequired (Response->StatusCode)) {
+        break;
+      }
+
+      //
+      // Release response for next round of request.
+      //
+      ReleaseRedfishResponse (Response);
+    }
+
+    DEBUG ((DEBUG_WARN, "%a: RedfishGetByUriEx failed, retry (%d/%d)\n", __func__, *RetryCount, Private->RetrySetting.MaximumRetryGet));
+    if (Private->RetrySetting.RetryWait > 0) {
+      gBS->Stall (Private->RetrySetting.RetryWait);
+    }
+  } while (TRUE);
+
+  return Status;
+}
+
+/**
+  Add If-None-Match header with given ETag to the request, unless the caller
+  already set one.
+
+  @param[in]  Request             Request context from caller. This is optional.
+  @param[in]  ETag                The ETag of the cached resource.
+  @param[out] ConditionalRequest  The conditional request. The headers are
+                                  shared with Request. Only the header
+                                  array must be freed by caller.
+
+  @retval     EFI_SUCCESS         ConditionalRequest is built.
+  @retval     EFI_UNSUPPORTED     Request has If-None-Match header already.
+  @retval     Others              Errors occur.
+
+**/
+STATIC
+EFI_STATUS
+BuildConditionalRequest (
+  IN  REDFISH_REQUEST  *Request OPTIONAL,
+  IN  CHAR8            *ETag,
+  OUT REDFISH_REQUEST  *ConditionalRequest
+  )
+{
+  UINTN  HeaderCount;
+
+  ZeroMem (ConditionalRequest, sizeof (REDFISH_REQUEST));
+  HeaderCount = 0;
+  if (Request != NULL) {
+    if (HttpFindHeader (Request->HeaderCount, Request->Headers, HTTP_HEADER_IF_NONE_MATCH) != NULL) {
+      return EFI_UNSUPPORTED;
+    }
+
+    CopyMem (ConditionalRequest, Request, sizeof (REDFISH_REQUEST));
+    HeaderCount = Request->HeaderCount;
+  }
+
+  ConditionalRequest->Headers = AllocateZeroPool ((HeaderCount + 1) * sizeof (EFI_HTTP_HEADER));
+  if (ConditionalRequest->Headers == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  if (HeaderCount > 0) {
+    CopyMem (ConditionalRequest->Headers, Request->Headers, HeaderCount * sizeof (EFI_HTTP_HEADER));
+  }
+
+  ConditionalRequest->Headers[HeaderCount].FieldName  = HTTP_HEADER_IF_NONE_MATCH;
+  ConditionalRequest->Headers[HeaderCount].FieldValue = ETag;
+  ConditionalRequest->HeaderCount                     = HeaderCount + 1;
+
+  return EFI_SUCCESS;
+}
+
 /**
   Perform HTTP GET to Get redfish resource from given resource URI with
   cache mechanism supported. It's caller's responsibility to free Response
@@ -568,7 +690,9 @@ RedfishJsonInRedfishPayload (
   @param[out] Response      HTTP response from redfish service.
   @param[in]  UseCache      If it is TRUE, this function will search for
                             cache first. If it is FALSE, this function
-                            will query Redfish URI directly.
+                            will query Redfish URI directly. The cached
+                            response is still returned when the Redfish
+                            service confirms that its ETag is current.
 
   @retval     EFI_SUCCESS     Resource is returned successfully.
   @retval     Others          Errors occur.
@@ -589,6 +713,8 @@ RedfishGetResource (
   REDFISH_HTTP_CACHE_DATA     *CacheData;
   UINTN                       RetryCount;
   REDFISH_HTTP_CACHE_PRIVATE  *Private;
+  REDFISH_REQUEST             ConditionalRequest;
+  BOOLEAN                     Conditional;
 
   if ((This == NULL) || (Service == NULL) || (Response == NULL) || IS_EMPTY_STRING (Uri)) {
     return EFI_INVALID_PARAMETER;
@@ -596,73 +722,77 @@ RedfishGetResource (
 
   DEBUG ((REDFISH_HTTP_CACHE_DEBUG, "%a: Get URI: %s cache: %a\n", __func__, Uri, (UseCache ? "true" : "false")));
 
-  Private    = REDFISH_HTTP_CACHE_PRIVATE_FROM_THIS (This);
-  CacheData  = NULL;
-  RetryCount = 0;
+  Private     = REDFISH_HTTP_CACHE_PRIVATE_FROM_THIS (This);
+  CacheData   = NULL;
+  RetryCount  = 0;
+  Conditional = FALSE;
   ZeroMem (Response, sizeof (REDFISH_RESPONSE));
 
   if (Private->CacheDisabled) {
     UseCache = FALSE;
     DEBUG ((REDFISH_HTTP_CACHE_DEBUG, "%a: cache is disabled by PCD!\n", __func__));
+  } else {
+    CacheData = FindHttpCacheData (&Private->CacheList.Head, Uri);
   }
 
   //
-  // Search for cache list.
+  // Search for cache list. A cache data restored from the previous boot is
+  // used only after the Redfish service confirms that it is current.
   //
-  if (UseCache) {
-    CacheData = FindHttpCacheData (&Private->CacheList.Head, Uri);
-    if (CacheData != NULL) {
-      DEBUG ((REDFISH_HTTP_CACHE_DEBUG_REQUEST, "%a: cache hit! %s\n", __func__, Uri));
+  if (UseCache && (CacheData != NULL) && (CacheData->Response != NULL)) {
+    DEBUG ((REDFISH_HTTP_CACHE_DEBUG_REQUEST, "%a: cache hit! %s\n", __func__, Uri));
 
-      //
-      // Copy cached response to caller's buffer.
-      //
-      Status               = CopyRedfishResponse (CacheData->Response, Response);
-      CacheData->HitCount += 1;
-      return Status;
+    //
+    // Copy cached response to caller's buffer.
+    //
+    Status               = CopyRedfishResponse (CacheData->Response, Response);
+    CacheData->HitCount += 1;
+    return Status;
+  }
+
+  //
+  // Ask Redfish service to send the resource only if it has changed since
+  // it was cached.
+  //
+  if ((CacheData != NULL) && (CacheData->ETag != NULL)) {
+    Status = BuildConditionalRequest (Request, CacheData->ETag, &ConditionalRequest);
+    if (!EFI_ERROR (Status)) {
+      Conditional = TRUE;
     }
   }
 
   //
   // Get resource from redfish service.
   //
-  do {
-    RetryCount += 1;
-    Status      = HttpSendReceive (
-                    Service,
-                    Uri,
-                    HttpMethodGet,
-                    Request,
-                    Response
-                    );
-    DEBUG ((REDFISH_HTTP_CACHE_DEBUG_REQUEST, "%a: HTTP request: %s :%r\n", __func__, Uri, Status));
-    if (!EFI_ERROR (Status) || (RetryCount >= Private->RetrySetting.MaximumRetryGet)) {
-      break;
-    }
+  Status = HttpGetWithRetry (Private, Service, Uri, (Conditional ? &ConditionalRequest : Request), Response, &RetryCount);
 
-    //
-    // Retry when BMC is not ready.
-    //
-    if ((Response->StatusCode != NULL)) {
-      DEBUG_CODE (
-        DumpRedfishResponse (NULL, DEBUG_ERROR, Response);
-        );
+  if (Conditional) {
+    FreePool (ConditionalRequest.Headers);
 
-      if (!RedfishRetryRequired (Response->StatusCode)) {
-        break;
-      }
+    if ((Response->StatusCode != NULL) && (*Response->StatusCode == HTTP_STATUS_304_NOT_MODIFIED)) {
+      DEBUG ((REDFISH_HTTP_CACHE_DEBUG_REQUEST, "%a: not modified: %s\n", __func__, Uri));
+      ReleaseRedfishResponse (Response);
 
-      //
-      // Release response for next round of request.
-      //
-      This->FreeResponse (This, Response);
-    }
+      if (CacheData->Response == NULL) {
+        Status = RestoreHttpCacheData ((REDFISH_SERVICE_PRIVATE *)Service, CacheData);
+        if (EFI_ERROR (Status)) {
+          //
+          // Drop the stored cache data and get the resource again.
+          //
+          DEBUG ((DEBUG_WARN, "%a: cannot restore cache of %s: %r\n", __func__, Uri, Status));
+          DeleteHttpCacheData (&Private->CacheList, CacheData);
+          CacheData = NULL;
+          Status    = HttpGetWithRetry (Private, Service, Uri, Request, Response, &RetryCount);
+        }
+      }
 
-    DEBUG ((DEBUG_WARN, "%a: RedfishGetByUriEx failed, retry (%d/%d)\n", __func__, RetryCount, Private->RetrySetting.MaximumRetryGet));
-    if (Private->RetrySetting.RetryWait > 0) {
-      gBS->Stall (Private->RetrySetting.RetryWait);
+      if (CacheData != NULL) {
+        Status               = CopyRedfishResponse (CacheData->Response, Response);
+        CacheData->HitCount += 1;
+        return Status;
+      }
     }
-  } while (TRUE);
+  }
 
   if (EFI_ERROR (Status)) {
     DEBUG_CODE (
@@ -696,6 +826,106 @@ ON_RELEASE:
   return Status;
 }
 
+/**
+  Perform HTTP GET to get a list of redfish resources, for example the
+  members of a collection, with cache mechanism supported. The requests are
+  sent one after another on the connection of Service. Once the Redfish
+  service cannot be reached, the resources that are not cached are not
+  requested anymore. It's caller's responsibility to free each Response
+  by calling FreeResponse ().
+
+  @param[in]  This          Pointer to EDKII_REDFISH_HTTP_PROTOCOL instance.
+  @param[in]  Service       Redfish service instance to perform HTTP GET.
+  @param[in]  Count         Number of entries in Uris, Responses and Statuses.
+  @param[in]  Uris          Target resource URIs.
+  @param[out] Responses     HTTP responses from redfish service, one for
+                            each URI.
+  @param[out] Statuses      Status of each GET. EFI_ABORTED means the
+                            resource was not requested because the Redfish
+                            service could not be reached.
+  @param[in]  UseCache      If it is TRUE, this function will search for
+                            cache first. If it is FALSE, this function
+                            will query Redfish URI directly.
+
+  @retval     EFI_SUCCESS            All resources are returned successfully.
+  @retval     EFI_INVALID_PARAMETER  One of the parameters is invalid.
+  @retval     Others                 The status of the first GET that failed.
+
+**/
+EFI_STATUS
+EFIAPI
+RedfishGetResources (
+  IN  EDKII_REDFISH_HTTP_PROTOCOL  *This,
+  IN  REDFISH_SERVICE              Service,
+  IN  UINTN                        Count,
+  IN  EFI_STRING                   *Uris,
+  OUT REDFISH_RESPONSE             *Responses,
+  OUT EFI_STATUS                   *Statuses,
+  IN  BOOLEAN                      UseCache
+  )
+{
+  EFI_STATUS                  Status;
+  REDFISH_HTTP_CACHE_PRIVATE  *Private;
+  REDFISH_HTTP_CACHE_DATA     *CacheData;
+  BOOLEAN                     Unreachable;
+  UINTN                       Index;
+
+  if ((This == NULL) || (Service == NULL) || (Uris == NULL) || (Responses == NULL) || (Statuses == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  for (Index = 0; Index < Count; Index++) {
+    if (IS_EMPTY_STRING (Uris[Index])) {
+      return EFI_INVALID_PARAMETER;
+    }
+  }
+
+  DEBUG ((REDFISH_HTTP_CACHE_DEBUG, "%a: Get %d URIs cache: %a\n", __func__, Count, (UseCache ? "true" : "false")));
+
+  Private     = REDFISH_HTTP_CACHE_PRIVATE_FROM_THIS (This);
+  Status      = EFI_SUCCESS;
+  Unreachable = FALSE;
+  for (Index = 0; Index < Count; Index++) {
+    ZeroMem (&Responses[Index], sizeof (REDFISH_RESPONSE));
+
+    //
+    // Without a connection to Redfish service, only the cached responses
+    // can be returned. Do not wait for every remaining URI to time out.
+    //
+    if (Unreachable) {
+      CacheData = NULL;
+      if (UseCache && !Private->CacheDisabled) {
+        CacheData = FindHttpCacheData (&Private->CacheList.Head, Uris[Index]);
+      }
+
+      if ((CacheData == NULL) || (CacheData->Response == NULL)) {
+        Statuses[Index] = EFI_ABORTED;
+        if (!EFI_ERROR (Status)) {
+          Status = EFI_ABORTED;
+        }
+
+        continue;
+      }
+    }
+
+    Statuses[Index] = RedfishGetResource (This, Service, Uris[Index], NULL, &Responses[Index], UseCache);
+    if (EFI_ERROR (Statuses[Index])) {
+      if (!EFI_ERROR (Status)) {
+        Status = Statuses[Index];
+      }
+
+      //
+      // No HTTP status code means the request did not reach Redfish service.
+      //
+      if (Responses[Index].StatusCode == NULL) {
+        Unreachable = TRUE;
+      }
+    }
+  }
+
+  return Status;
+}
+
 /**
   This function free resources in Request. Request is no longer available
   after this function returns successfully.
@@ -1267,7 +1497,8 @@ EDKII_REDFISH_HTTP_PROTOCOL  mEdkIIRedfishHttpProtocol = {
   RedfishDeleteResource,
   RedfishFreeRequest,
   RedfishFreeResponse,
-  RedfishExpireResponse
+  RedfishExpireResponse,
+  RedfishGetResources
 };
 
 /**
@@ -1289,6 +1520,10 @@ RedfishHttpDriverUnload (
     return EFI_SUCCESS;
   }
 
+  if (mRedfishHttpCachePrivate->ReadyToBootEvent != NULL) {
+    gBS->CloseEvent (mRedfishHttpCachePrivate->ReadyToBootEvent);
+  }
+
   if (!IsListEmpty (&mRedfishHttpCachePrivate->CacheList.Head)) {
     ReleaseCacheList (&mRedfishHttpCachePrivate->CacheList);
   }
@@ -1344,6 +1579,35 @@ CredentialProtocolInstalled (
   gBS->CloseEvent (Event);
 }
 
+/**
+  Store the cache for the next boot when the platform is ready to boot.
+
+  @param[in] Event    Event whose notification function is being invoked.
+  @param[in] Context  Pointer to the notification function's context.
+
+**/
+VOID
+EFIAPI
+RedfishHttpReadyToBoot (
+  IN  EFI_EVENT  Event,
+  IN  VOID       *Context
+  )
+{
+  EFI_STATUS                  Status;
+  REDFISH_HTTP_CACHE_PRIVATE  *Private;
+
+  Private = (REDFISH_HTTP_CACHE_PRIVATE *)Context;
+  if (Private->Signature != REDFISH_HTTP_DRIVER_SIGNATURE) {
+    DEBUG ((DEBUG_ERROR, "%a: signature check failure\n", __func__));
+    return;
+  }
+
+  Status = StoreHttpCacheList (&Private->CacheList, PcdGet32 (PcdHttpCacheStoreSize));
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: failed to store cache: %r\n", __func__, Status));
+  }
+}
+
 /**
   Main entry for this driver.
 
@@ -1393,6 +1657,22 @@ RedfishHttpEntryPoint (
   mRedfishHttpCachePrivate->RetrySetting.MaximumRetryDelete = PcdGet16 (PcdHttpDeleteRetry);
   mRedfishHttpCachePrivate->RetrySetting.RetryWait          = PcdGet16 (PcdHttpRetryWaitInSecond) * 1000000U;
 
+  //
+  // Restore the cache stored in the previous boot.
+  //
+  if (!mRedfishHttpCachePrivate->CacheDisabled && (PcdGet32 (PcdHttpCacheStoreSize) > 0)) {
+    LoadHttpCacheList (&mRedfishHttpCachePrivate->CacheList, PcdGet32 (PcdHttpCacheStoreSize));
+    Status = EfiCreateEventReadyToBootEx (
+               TPL_CALLBACK,
+               RedfishHttpReadyToBoot,
+               mRedfishHttpCachePrivate,
+               &mRedfishHttpCachePrivate->ReadyToBootEvent
+               );
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "%a: failed to create ready to boot event: %r\n", __func__, Status));
+    }
+  }
+
   //
   // Install the gEdkIIRedfishHttpProtocolGuid onto Handle.
   //
@@ -21,6 +21,7 @@
 #include <Library/HttpLib.h>
 #include <Library/JsonLib.h>
 #include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiRuntimeServicesTableLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/RedfishDebugLib.h>
 #include <Library/ReportStatusCodeLib.h>
@@ -41,4 +42,13 @@
 #define REDFISH_HTTP_CACHE_DEBUG_DUMP     DEBUG_MANAGEABILITY
 #define REDFISH_HTTP_CACHE_DEBUG_REQUEST  DEBUG_MANAGEABILITY
 
+//
+// The stored cache is split in variables named L"RedfishHttpCache0000",
+// L"RedfishHttpCache0001" and so on, of REDFISH_HTTP_STORE_VARIABLE_SIZE
+// bytes but the last one.
+//
+#define REDFISH_HTTP_STORE_VARIABLE_NAME         L"RedfishHttpCache"
+#define REDFISH_HTTP_STORE_VARIABLE_NAME_LENGTH  24
+#define REDFISH_HTTP_STORE_VARIABLE_SIZE         SIZE_4KB
+
 #endif
@@ -0,0 +1,360 @@
+/** @file
+  Keep the Redfish HTTP cache across boots.
+
+  The cache data with ETag is stored in non-volatile variables when the
+  platform is ready to boot, and restored when the driver starts. A restored
+  cache data is only used after the Redfish service answered a conditional
+  GET request with 304 Not Modified, so a resource that changed in between is
+  always fetched again.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "RedfishHttpData.h"
+
+/**
+  Build the name of the variable holding the given part of the store.
+
+  @param[in]   Index     The index of the part of the store.
+  @param[out]  Name      Buffer receiving the variable name.
+
+**/
+STATIC
+VOID
+GetStoreVariableName (
+  IN  UINTN   Index,
+  OUT CHAR16  Name[REDFISH_HTTP_STORE_VARIABLE_NAME_LENGTH]
+  )
+{
+  UnicodeSPrint (
+    Name,
+    REDFISH_HTTP_STORE_VARIABLE_NAME_LENGTH * sizeof (CHAR16),
+    L"%s%04x",
+    REDFISH_HTTP_STORE_VARIABLE_NAME,
+    Index
+    );
+}
+
+/**
+  Add a cache data from the store to the cache list.
+
+  @param[in]  List      Target cache list.
+  @param[in]  Record    The record in the store.
+  @param[in]  Strings   The URI, ETag and payload following the record.
+
+  @retval EFI_SUCCESS             Cache data is added, or the URI is already
+                                  in the list.
+  @retval EFI_COMPROMISED_DATA    The record is malformed.
+  @retval EFI_OUT_OF_RESOURCES    No memory available.
+
+**/
+STATIC
+EFI_STATUS
+AddStoredHttpCacheData (
+  IN REDFISH_HTTP_CACHE_LIST    *List,
+  IN REDFISH_HTTP_STORE_RECORD  *Record,
+  IN UINT8                      *Strings
+  )
+{
+  REDFISH_HTTP_CACHE_DATA  *NewData;
+
+  if ((Record->UriSize < 2 * sizeof (CHAR16)) || ((Record->UriSize % sizeof (CHAR16)) != 0) ||
+      (Record->ETagSize < 2) || (Record->BodySize < 2))
+  {
+    return EFI_COMPROMISED_DATA;
+  }
+
+  NewData = AllocateZeroPool (sizeof (REDFISH_HTTP_CACHE_DATA));
+  if (NewData == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  NewData->Signature = REDFISH_HTTP_CACHE_SIGNATURE;
+  NewData->Uri       = AllocateCopyPool (Record->UriSize, Strings);
+  NewData->ETag      = AllocateCopyPool (Record->ETagSize, Strings + Record->UriSize);
+  NewData->Body      = AllocateCopyPool (Record->BodySize, Strings + Record->UriSize + Record->ETagSize);
+  if ((NewData->Uri == NULL) || (NewData->ETag == NULL) || (NewData->Body == NULL)) {
+    ReleaseHttpCacheData (NewData);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  if ((NewData->Uri[Record->UriSize / sizeof (CHAR16) - 1] != L'\0') ||
+      (NewData->ETag[Record->ETagSize - 1] != '\0') ||
+      (NewData->Body[Record->BodySize - 1] != '\0'))
+  {
+    ReleaseHttpCacheData (NewData);
+    return EFI_COMPROMISED_DATA;
+  }
+
+  if (FindHttpCacheData (&List->Head, NewData->Uri) != NULL) {
+    ReleaseHttpCacheData (NewData);
+    return EFI_SUCCESS;
+  }
+
+  //
+  // A restored cache data has not been hit in this boot, so it is the first
+  // to retire when the list is full.
+  //
+  NewData->HitCount = 0;
+  InsertTailList (&List->Head, &NewData->List);
+  ++List->Count;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Restore the cache data stored in the previous boot to the cache list.
+
+  @param[in]  List      Target cache list.
+  @param[in]  MaxSize   The maximum size of the store.
+
+  @retval EFI_SUCCESS             The stored cache data is restored.
+  @retval EFI_NOT_FOUND           Nothing is stored.
+  @retval EFI_COMPROMISED_DATA    The store is malformed. The cache data
+                                  before the malformed one is restored.
+  @retval Others                  Fail to read the store.
+
+**/
+EFI_STATUS
+LoadHttpCacheList (
+  IN REDFISH_HTTP_CACHE_LIST  *List,
+  IN UINTN                    MaxSize
+  )
+{
+  EFI_STATUS                 Status;
+  UINT8                      *Store;
+  UINTN                      Size;
+  UINTN                      DataSize;
+  UINTN                      Index;
+  UINTN                      Offset;
+  UINTN                      StringSize;
+  CHAR16                     Name[REDFISH_HTTP_STORE_VARIABLE_NAME_LENGTH];
+  REDFISH_HTTP_STORE_HEADER  Header;
+  REDFISH_HTTP_STORE_RECORD  Record;
+
+  if ((List == NULL) || (MaxSize < sizeof (REDFISH_HTTP_STORE_HEADER))) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Store = AllocatePool (MaxSize);
+  if (Store == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Every part but the last one fills a whole variable.
+  //
+  Size   = 0;
+  Status = EFI_SUCCESS;
+  for (Index = 0; Size < MaxSize; Index++) {
+    GetStoreVariableName (Index, Name);
+    DataSize = MIN (REDFISH_HTTP_STORE_VARIABLE_SIZE, MaxSize - Size);
+    Status   = gRT->GetVariable (Name, &gEfiRedfishVariableGuid, NULL, &DataSize, Store + Size);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    Size += DataSize;
+    if (DataSize < REDFISH_HTTP_STORE_VARIABLE_SIZE) {
+      break;
+    }
+  }
+
+  //
+  // A part larger than expected is left from a store with another layout.
+  //
+  if (Status == EFI_BUFFER_TOO_SMALL) {
+    Status = EFI_COMPROMISED_DATA;
+  }
+
+  if (EFI_ERROR (Status) && ((Status != EFI_NOT_FOUND) || (Index == 0))) {
+    goto ON_RELEASE;
+  }
+
+  Status = EFI_COMPROMISED_DATA;
+  if (Size < sizeof (Header)) {
+    goto ON_RELEASE;
+  }
+
+  CopyMem (&Header, Store, sizeof (Header));
+  if ((Header.Signature != REDFISH_HTTP_STORE_SIGNATURE) || (Header.Size != Size)) {
+    goto ON_RELEASE;
+  }
+
+  Status = EFI_SUCCESS;
+  Offset = sizeof (Header);
+  for (Index = 0; (Index < Header.Count) && (List->Count < List->Capacity); Index++) {
+    if (Size - Offset < sizeof (Record)) {
+      Status = EFI_COMPROMISED_DATA;
+      break;
+    }
+
+    CopyMem (&Record, Store + Offset, sizeof (Record));
+    Offset    += sizeof (Record);
+    StringSize = (UINTN)Record.UriSize + Record.ETagSize + Record.BodySize;
+    if (Size - Offset < StringSize) {
+      Status = EFI_COMPROMISED_DATA;
+      break;
+    }
+
+    Status = AddStoredHttpCacheData (List, &Record, Store + Offset);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    Offset += StringSize;
+  }
+
+  DEBUG ((REDFISH_HTTP_CACHE_DEBUG, "%a: restored %d cache data: %r\n", __func__, List->Count, Status));
+
+ON_RELEASE:
+
+  //
+  // Replace a malformed store when the platform is ready to boot.
+  //
+  if (Status == EFI_COMPROMISED_DATA) {
+    DEBUG ((DEBUG_WARN, "%a: the stored cache is malformed\n", __func__));
+    List->Modified = TRUE;
+  }
+
+  FreePool (Store);
+
+  return Status;
+}
+
+/**
+  Store the cache data with ETag in the cache list for the next boot.
+
+  Nothing is written when no cache data with ETag changed since the store
+  was restored or last written. Cache data that does not fit in MaxSize is
+  left out.
+
+  @param[in]  List      The cache list to store.
+  @param[in]  MaxSize   The maximum size of the store.
+
+  @retval EFI_SUCCESS             The cache data is stored.
+  @retval Others                  Fail to write the store.
+
+**/
+EFI_STATUS
+StoreHttpCacheList (
+  IN REDFISH_HTTP_CACHE_LIST  *List,
+  IN UINTN                    MaxSize
+  )
+{
+  EFI_STATUS                 Status;
+  UINT8                      *Store;
+  LIST_ENTRY                 *Link;
+  REDFISH_HTTP_CACHE_DATA    *Data;
+  REDFISH_PAYLOAD_PRIVATE    *Payload;
+  CHAR8                      *Body;
+  UINTN                      Offset;
+  UINTN                      Index;
+  UINTN                      DataSize;
+  CHAR16                     Name[REDFISH_HTTP_STORE_VARIABLE_NAME_LENGTH];
+  REDFISH_HTTP_STORE_HEADER  Header;
+  REDFISH_HTTP_STORE_RECORD  Record;
+
+  if ((List == NULL) || (MaxSize < sizeof (REDFISH_HTTP_STORE_HEADER))) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (!List->Modified) {
+    return EFI_SUCCESS;
+  }
+
+  Store = AllocateZeroPool (MaxSize);
+  if (Store == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Header.Signature = REDFISH_HTTP_STORE_SIGNATURE;
+  Header.Count     = 0;
+  Offset           = sizeof (Header);
+
+  for (Link = GetFirstNode (&List->Head); !IsNull (&List->Head, Link); Link = GetNextNode (&List->Head, Link)) {
+    Data = REDFISH_HTTP_CACHE_FROM_LIST (Link);
+    if (Data->ETag == NULL) {
+      continue;
+    }
+
+    //
+    // The payload of a cache data restored from the previous boot is still
+    // in JSON text if it was not used in this boot.
+    //
+    Body = Data->Body;
+    if (Body == NULL) {
+      Payload = (REDFISH_PAYLOAD_PRIVATE *)Data->Response->Payload;
+      if ((Payload == NULL) || (Payload->JsonValue == NULL)) {
+        continue;
+      }
+
+      Body = JsonDumpString (Payload->JsonValue, EDKII_JSON_COMPACT);
+      if (Body == NULL) {
+        continue;
+      }
+    }
+
+    Record.UriSize  = (UINT32)StrSize (Data->Uri);
+    Record.ETagSize = (UINT32)AsciiStrSize (Data->ETag);
+    Record.BodySize = (UINT32)AsciiStrSize (Body);
+    DataSize        = sizeof (Record) + Record.UriSize + Record.ETagSize + Record.BodySize;
+    if (DataSize <= MaxSize - Offset) {
+      CopyMem (Store + Offset, &Record, sizeof (Record));
+      Offset += sizeof (Record);
+      CopyMem (Store + Offset, Data->Uri, Record.UriSize);
+      Offset += Record.UriSize;
+      CopyMem (Store + Offset, Data->ETag, Record.ETagSize);
+      Offset += Record.ETagSize;
+      CopyMem (Store + Offset, Body, Record.BodySize);
+      Offset += Record.BodySize;
+      Header.Count++;
+    } else {
+      DEBUG ((REDFISH_HTTP_CACHE_DEBUG, "%a: no room for %s\n", __func__, Data->Uri));
+    }
+
+    if (Body != Data->Body) {
+      FreePool (Body);
+    }
+  }
+
+  Header.Size = (UINT32)Offset;
+  CopyMem (Store, &Header, sizeof (Header));
+
+  //
+  // Write the store in parts that fit in a variable, then delete the parts
+  // left from a larger store.
+  //
+  Status = EFI_SUCCESS;
+  for (Index = 0; Index * REDFISH_HTTP_STORE_VARIABLE_SIZE < Offset; Index++) {
+    GetStoreVariableName (Index, Name);
+    DataSize = MIN (REDFISH_HTTP_STORE_VARIABLE_SIZE, Offset - Index * REDFISH_HTTP_STORE_VARIABLE_SIZE);
+    Status   = gRT->SetVariable (
+                      Name,
+                      &gEfiRedfishVariableGuid,
+                      EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS,
+                      DataSize,
+                      Store + Index * REDFISH_HTTP_STORE_VARIABLE_SIZE
+                      );
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "%a: cannot write %s: %r\n", __func__, Name, Status));
+      break;
+    }
+  }
+
+  if (!EFI_ERROR (Status)) {
+    do {
+      GetStoreVariableName (Index++, Name);
+    } while (!EFI_ERROR (gRT->SetVariable (Name, &gEfiRedfishVariableGuid, 0, 0, NULL)));
+
+    DEBUG ((REDFISH_HTTP_CACHE_DEBUG, "%a: stored %d cache data in %d bytes\n", __func__, Header.Count, Offset));
+    List->Modified = FALSE;
+  }
+
+  FreePool (Store);
+
+  return Status;
+}
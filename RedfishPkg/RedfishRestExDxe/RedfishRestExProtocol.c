@@ -86,16 +86,6 @@ RedfishRestExSendReceive (
 
   Instance = RESTEX_INSTANCE_FROM_THIS (This);
 
-  //
-  // Check Media Status.
-  //
-  MediaPresent = TRUE;
-  NetLibDetectMedia (Instance->Service->ControllerHandle, &MediaPresent);
-  if (!MediaPresent) {
-    DEBUG ((DEBUG_REDFISH_NETWORK, "RedfishRestExSendReceive(): No MediaPresent.\n"));
-    return EFI_NO_MEDIA;
-  }
-
   DEBUG ((DEBUG_REDFISH_NETWORK, "\nRedfishRestExSendReceive():\n"));
   DEBUG ((DEBUG_REDFISH_NETWORK, "*** Perform HTTP Request Method - %d, URL: %s\n", RequestMessage->Data.Request->Method, RequestMessage->Data.Request->Url));
 
@@ -190,8 +180,17 @@ ReSendRequest:;
 
   if (EFI_ERROR (Status)) {
     //
-    // Communication failure happens. Reset the session.
+    // Communication failure happens. Reset the session. The media status
+    // is checked only here, so that requests on a working connection do
+    // not poll the network device each time.
     //
+    MediaPresent = TRUE;
+    NetLibDetectMedia (Instance->Service->ControllerHandle, &MediaPresent);
+    if (!MediaPresent) {
+      DEBUG ((DEBUG_REDFISH_NETWORK, "RedfishRestExSendReceive(): No MediaPresent.\n"));
+      Status = EFI_NO_MEDIA;
+    }
+
     ResetHttpTslSession (Instance);
     goto ON_EXIT;
   }
@@ -266,6 +265,8 @@ ReSendRequest:;
     DEBUG ((DEBUG_MANAGEABILITY, "HTTP_STATUS_201_CREATED\n"));
   } else if (ResponseData->Response.StatusCode == HTTP_STATUS_202_ACCEPTED) {
     DEBUG ((DEBUG_MANAGEABILITY, "HTTP_STATUS_202_ACCEPTED\n"));
+  } else if (ResponseData->Response.StatusCode == HTTP_STATUS_304_NOT_MODIFIED) {
+    DEBUG ((DEBUG_MANAGEABILITY, "HTTP_STATUS_304_NOT_MODIFIED\n"));
   } else if (ResponseData->Response.StatusCode == HTTP_STATUS_413_REQUEST_ENTITY_TOO_LARGE) {
     DEBUG ((DEBUG_REDFISH_NETWORK, "HTTP_STATUS_413_REQUEST_ENTITY_TOO_LARGE\n"));
 
@@ -93,6 +93,90 @@ InstallPreHashFvPpi (
   ASSERT_EFI_ERROR (Status);
 }
 
+/**
+  Hash the FVs of the context until none is left.
+
+  This may run on the BSP and on the APs at the same time.
+
+  @param[in]  Buffer              Pointer to the FV_HASH_CONTEXT.
+**/
+STATIC
+VOID
+EFIAPI
+HashFvProcedure (
+  IN VOID  *Buffer
+  )
+{
+  FV_HASH_CONTEXT  *Context;
+  UINT32           FvIndex;
+
+  Context = (FV_HASH_CONTEXT *)Buffer;
+  while (TRUE) {
+    FvIndex = InterlockedIncrement (&Context->NextFv) - 1;
+    if (FvIndex >= Context->FvNumber) {
+      break;
+    }
+
+    if (Context->FvBuffer[FvIndex] == NULL) {
+      continue;
+    }
+
+    if (!Context->AlgInfo->HashAll (
+                             Context->FvBuffer[FvIndex],
+                             (UINTN)Context->FvLength[FvIndex],
+                             Context->FvHashValue + FvIndex * Context->AlgInfo->HashSize
+                             ))
+    {
+      Context->HashFailed = TRUE;
+    }
+  }
+}
+
+/**
+  Hash all FVs of the context.
+
+  If PcdFvReportParallelHash is TRUE and there is more than one FV, the FVs
+  are spread over the APs. Whatever is left is hashed on the BSP.
+
+  @param[in, out]  Context        Pointer to the FV_HASH_CONTEXT.
+  @param[in]       HashedFvCount  Number of FVs to hash in the context.
+**/
+STATIC
+VOID
+HashFvs (
+  IN OUT FV_HASH_CONTEXT  *Context,
+  IN     UINTN            HashedFvCount
+  )
+{
+  EFI_STATUS               Status;
+  EFI_PEI_MP_SERVICES_PPI  *MpServices;
+
+  Context->NextFv     = 0;
+  Context->HashFailed = FALSE;
+
+  if (PcdGetBool (PcdFvReportParallelHash) && (HashedFvCount > 1)) {
+    Status = PeiServicesLocatePpi (
+               &gEfiPeiMpServicesPpiGuid,
+               0,
+               NULL,
+               (VOID **)&MpServices
+               );
+    if (!EFI_ERROR (Status)) {
+      Status = MpServices->StartupAllAPs (
+                             GetPeiServicesTablePointer (),
+                             MpServices,
+                             HashFvProcedure,
+                             FALSE,
+                             0,
+                             Context
+                             );
+      DEBUG ((DEBUG_INFO, "Hashed FVs on APs (%r)\r\n", Status));
+    }
+  }
+
+  HashFvProcedure (Context);
+}
+
 /**
   Calculate and verify hash value for given FV.
 
@@ -121,6 +205,8 @@ VerifyHashedFv (
   VOID                                  *FvBuffer;
   EDKII_PEI_FIRMWARE_VOLUME_SHADOW_PPI  *FvShadowPpi;
   EFI_STATUS                            Status;
+  FV_HASH_CONTEXT                       Context;
+  UINTN                                 HashedFvCount;
 
   if ((HashInfo == NULL) ||
       (HashInfo->HashSize == 0) ||
@@ -150,6 +236,13 @@ VerifyHashedFv (
   HashValue = AllocateZeroPool (AlgInfo->HashSize * (FvNumber + 1));
   ASSERT (HashValue != NULL);
 
+  Context.AlgInfo     = AlgInfo;
+  Context.FvNumber    = FvNumber;
+  Context.FvBuffer    = AllocateZeroPool (sizeof (VOID *) * FvNumber);
+  Context.FvLength    = AllocateZeroPool (sizeof (UINT64) * FvNumber);
+  Context.FvHashValue = AllocateZeroPool (AlgInfo->HashSize * FvNumber);
+  ASSERT (Context.FvBuffer != NULL && Context.FvLength != NULL && Context.FvHashValue != NULL);
+
   Status = PeiServicesLocatePpi (
              &gEdkiiPeiFirmwareVolumeShadowPpiGuid,
              0,
@@ -161,9 +254,9 @@ VerifyHashedFv (
   }
 
   //
-  // Calculate hash value for each FV first.
+  // Copy each FV to memory first.
   //
-  FvHashValue = HashValue;
+  HashedFvCount = 0;
   for (FvIndex = 0; FvIndex < FvNumber; ++FvIndex) {
     //
     // Not meant for verified boot and/or measured boot?
@@ -221,9 +314,25 @@ VerifyHashedFv (
         );
     }
 
-    if (!AlgInfo->HashAll (FvBuffer, (UINTN)FvInfo[FvIndex].Length, FvHashValue)) {
-      Status = EFI_ABORTED;
-      goto Done;
+    Context.FvBuffer[FvIndex] = FvBuffer;
+    Context.FvLength[FvIndex] = FvInfo[FvIndex].Length;
+    HashedFvCount++;
+  }
+
+  //
+  // Calculate hash value for each FV, then report them in order.
+  //
+  HashFvs (&Context, HashedFvCount);
+  if (Context.HashFailed) {
+    Status = EFI_ABORTED;
+    goto Done;
+  }
+
+  FvHashValue = HashValue;
+  for (FvIndex = 0; FvIndex < FvNumber; ++FvIndex) {
+    FvBuffer = Context.FvBuffer[FvIndex];
+    if (FvBuffer == NULL) {
+      continue;
     }
 
     //
@@ -235,7 +344,7 @@ VerifyHashedFv (
         (UINTN)FvInfo[FvIndex].Length,
         HashInfo->HashAlgoId,
         HashInfo->HashSize,
-        FvHashValue
+        Context.FvHashValue + FvIndex * AlgInfo->HashSize
         );
     }
 
@@ -243,6 +352,7 @@ VerifyHashedFv (
     // Don't keep the hash value of current FV if we don't need to verify it.
     //
     if ((FvInfo[FvIndex].Flag & HASHED_FV_FLAG_VERIFIED_BOOT) != 0) {
+      CopyMem (FvHashValue, Context.FvHashValue + FvIndex * AlgInfo->HashSize, AlgInfo->HashSize);
       FvHashValue += AlgInfo->HashSize;
     }
 
@@ -265,6 +375,9 @@ VerifyHashedFv (
   }
 
 Done:
+  FreePool (Context.FvHashValue);
+  FreePool (Context.FvLength);
+  FreePool (Context.FvBuffer);
   FreePool (HashValue);
   return Status;
 }
@@ -15,8 +15,11 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include <Ppi/FirmwareVolumeInfoStoredHashFv.h>
 #include <Ppi/FirmwareVolumeShadowPpi.h>
+#include <Ppi/MpServices.h>
 
 #include <Library/PeiServicesLib.h>
+#include <Library/PeiServicesTablePointerLib.h>
+#include <Library/SynchronizationLib.h>
 #include <Library/PcdLib.h>
 #include <Library/HobLib.h>
 #include <Library/DebugLib.h>
@@ -119,4 +122,18 @@ typedef struct {
   HASH_ALL_METHOD       HashAll;
 } HASH_ALG_INFO;
 
+//
+// The FVs to hash, shared by all processors that hash them. Each FV is
+// hashed as a whole by one processor, into its own slot of FvHashValue.
+//
+typedef struct {
+  CONST HASH_ALG_INFO    *AlgInfo;
+  UINTN                  FvNumber;
+  VOID                   **FvBuffer;
+  UINT64                 *FvLength;
+  UINT8                  *FvHashValue;
+  volatile UINT32        NextFv;
+  volatile BOOLEAN       HashFailed;
+} FV_HASH_CONTEXT;
+
 #endif //__FV_REPORT_PEI_H__
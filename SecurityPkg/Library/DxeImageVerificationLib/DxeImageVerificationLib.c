@@ -36,6 +36,25 @@ UINT8  *mImageBase = NULL;
 UINT8  mImageDigest[MAX_DIGEST_SIZE];
 UINTN  mImageDigestSize;
 
+//
+// Signatures already verified during this boot. Each entry is a SHA-256 digest over
+// the Authenticode hash and the PKCS#7 signed data, and the whole cache is dropped
+// whenever the contents of db, dbx or dbt change.
+//
+UINT8  mVerifiedCache[VERIFIED_CACHE_ENTRIES][SHA256_DIGEST_SIZE];
+UINTN  mVerifiedCacheCount = 0;
+UINTN  mVerifiedCacheNext  = 0;
+UINT8  mVerifiedCacheGeneration[SHA256_DIGEST_SIZE];
+
+//
+// Hash signatures of db and dbx, sorted for binary search. They are built on first
+// use and share the generation of the verified signature cache above.
+//
+SIGNATURE_HASH_CACHE  mSignatureHashCache[SIGNATURE_HASH_CACHE_ENTRIES];
+UINTN                 mSignatureHashCacheCount = 0;
+BOOLEAN               mSignatureHashCacheValid = FALSE;
+UINTN                 mSignatureHashSortSize;
+
 //
 // Notify string for authorization UI.
 //
@@ -305,6 +324,7 @@ HashPeImage (
   UINTN                     Pos;
   UINT32                    CertSize;
   UINT32                    NumberOfRvaAndSizes;
+  UINTN                     DigestSize;
 
   HashCtx       = NULL;
   SectionHeader = NULL;
@@ -347,7 +367,18 @@ HashPeImage (
   }
 
   mHashTypeStr = mHash[HashAlg].Name;
-  CtxSize      = mHash[HashAlg].GetContextSize ();
+
+  //
+  // Reuse the digest if another security handler already hashed this image.
+  //
+  DigestSize = mImageDigestSize;
+  if (!EFI_ERROR (GetSecurityImageDigest (mImageBase, mImageSize, &mCertType, mImageDigest, &DigestSize)) &&
+      (DigestSize == mImageDigestSize))
+  {
+    return TRUE;
+  }
+
+  CtxSize = mHash[HashAlg].GetContextSize ();
 
   HashCtx = AllocatePool (CtxSize);
   if (HashCtx == NULL) {
@@ -592,6 +623,9 @@ HashPeImage (
   }
 
   Status = mHash[HashAlg].HashFinal (HashCtx, mImageDigest);
+  if (Status) {
+    SetSecurityImageDigest (mImageBase, mImageSize, &mCertType, mImageDigest, mImageDigestSize);
+  }
 
 Done:
   if (HashCtx != NULL) {
@@ -965,6 +999,176 @@ Done:
   return Status;
 }
 
+/**
+  Compare the signature data of two hash signature entries.
+
+  Entries holding the same value are ordered by their position in the database, so
+  that a lookup returns the same entry as a linear walk of the database would.
+
+  @param[in] Buffer1  Pointer to the first EFI_SIGNATURE_DATA pointer.
+  @param[in] Buffer2  Pointer to the second EFI_SIGNATURE_DATA pointer.
+
+  @retval <0  The first entry sorts before the second one.
+  @retval 0   Both entries are the same.
+  @retval >0  The first entry sorts after the second one.
+
+**/
+INTN
+EFIAPI
+CompareSignatureHashEntry (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  EFI_SIGNATURE_DATA  *Entry1;
+  EFI_SIGNATURE_DATA  *Entry2;
+  INTN                Result;
+
+  Entry1 = *(EFI_SIGNATURE_DATA **)Buffer1;
+  Entry2 = *(EFI_SIGNATURE_DATA **)Buffer2;
+
+  Result = CompareMem (Entry1->SignatureData, Entry2->SignatureData, mSignatureHashSortSize);
+  if (Result != 0) {
+    return Result;
+  }
+
+  if ((UINTN)Entry1 < (UINTN)Entry2) {
+    return -1;
+  }
+
+  return ((UINTN)Entry1 > (UINTN)Entry2) ? 1 : 0;
+}
+
+/**
+  Release all sorted hash signature caches.
+
+**/
+VOID
+FreeSignatureHashCache (
+  VOID
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < mSignatureHashCacheCount; Index++) {
+    if (mSignatureHashCache[Index].Data != NULL) {
+      FreePool (mSignatureHashCache[Index].Data);
+    }
+
+    if (mSignatureHashCache[Index].Entries != NULL) {
+      FreePool (mSignatureHashCache[Index].Entries);
+    }
+  }
+
+  ZeroMem (mSignatureHashCache, sizeof (mSignatureHashCache));
+  mSignatureHashCacheCount = 0;
+}
+
+/**
+  Get the sorted hash signatures of one type in a signature database, building them
+  from the database on first use.
+
+  @param[in]  VariableName   Name of database variable.
+  @param[in]  CertType       Pointer to hash algorithm.
+  @param[in]  SignatureSize  Size of the hash signature.
+
+  @return  Pointer to the cache, or NULL if none could be built and the database must
+           be searched directly.
+
+**/
+SIGNATURE_HASH_CACHE *
+GetSignatureHashCache (
+  IN  CHAR16    *VariableName,
+  IN  EFI_GUID  *CertType,
+  IN  UINTN     SignatureSize
+  )
+{
+  SIGNATURE_HASH_CACHE  *Cache;
+  EFI_SIGNATURE_LIST    *CertList;
+  EFI_SIGNATURE_DATA    *Cert;
+  EFI_SIGNATURE_DATA    *Swap;
+  EFI_STATUS            Status;
+  UINTN                 DataSize;
+  UINTN                 Index;
+  UINTN                 CertCount;
+  UINTN                 Total;
+
+  if (!mSignatureHashCacheValid) {
+    return NULL;
+  }
+
+  for (Index = 0; Index < mSignatureHashCacheCount; Index++) {
+    Cache = &mSignatureHashCache[Index];
+    if ((Cache->SignatureSize == SignatureSize) && CompareGuid (&Cache->CertType, CertType) &&
+        (StrCmp (Cache->VariableName, VariableName) == 0))
+    {
+      return Cache;
+    }
+  }
+
+  if (mSignatureHashCacheCount == SIGNATURE_HASH_CACHE_ENTRIES) {
+    return NULL;
+  }
+
+  Cache = &mSignatureHashCache[mSignatureHashCacheCount];
+  ZeroMem (Cache, sizeof (*Cache));
+  Cache->VariableName  = VariableName;
+  Cache->SignatureSize = SignatureSize;
+  Cache->EntrySize     = (UINT32)(sizeof (EFI_SIGNATURE_DATA) - 1 + SignatureSize);
+  CopyGuid (&Cache->CertType, CertType);
+
+  Status = GetVariable2 (VariableName, &gEfiImageSecurityDatabaseGuid, (VOID **)&Cache->Data, &DataSize);
+  if (Status == EFI_NOT_FOUND) {
+    //
+    // No database, nothing can be found in it.
+    //
+    mSignatureHashCacheCount++;
+    return Cache;
+  }
+
+  if (EFI_ERROR (Status)) {
+    return NULL;
+  }
+
+  //
+  // Collect pointers to all entries of the requested type, in database order.
+  //
+  if (DataSize < Cache->EntrySize) {
+    mSignatureHashCacheCount++;
+    return Cache;
+  }
+
+  Cache->Entries = AllocatePool ((DataSize / Cache->EntrySize) * sizeof (EFI_SIGNATURE_DATA *));
+  if (Cache->Entries == NULL) {
+    FreePool (Cache->Data);
+    Cache->Data = NULL;
+    return NULL;
+  }
+
+  Total    = 0;
+  CertList = (EFI_SIGNATURE_LIST *)Cache->Data;
+  while ((DataSize > 0) && (DataSize >= CertList->SignatureListSize)) {
+    if ((CertList->SignatureSize == Cache->EntrySize) && (CompareGuid (&CertList->SignatureType, CertType))) {
+      CertCount = (CertList->SignatureListSize - sizeof (EFI_SIGNATURE_LIST) - CertList->SignatureHeaderSize) / CertList->SignatureSize;
+      Cert      = (EFI_SIGNATURE_DATA *)((UINT8 *)CertList + sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureHeaderSize);
+      for (Index = 0; Index < CertCount; Index++) {
+        Cache->Entries[Total++] = Cert;
+        Cert                    = (EFI_SIGNATURE_DATA *)((UINT8 *)Cert + CertList->SignatureSize);
+      }
+    }
+
+    DataSize -= CertList->SignatureListSize;
+    CertList  = (EFI_SIGNATURE_LIST *)((UINT8 *)CertList + CertList->SignatureListSize);
+  }
+
+  Cache->Count           = Total;
+  mSignatureHashSortSize = SignatureSize;
+  QuickSort (Cache->Entries, Cache->Count, sizeof (EFI_SIGNATURE_DATA *), CompareSignatureHashEntry, &Swap);
+
+  mSignatureHashCacheCount++;
+  return Cache;
+}
+
 /**
   Check whether signature is in specified database.
 
@@ -987,18 +1191,54 @@ IsSignatureFoundInDatabase (
   OUT BOOLEAN   *IsFound
   )
 {
-  EFI_STATUS          Status;
-  EFI_SIGNATURE_LIST  *CertList;
-  EFI_SIGNATURE_DATA  *Cert;
-  UINTN               DataSize;
-  UINT8               *Data;
-  UINTN               Index;
-  UINTN               CertCount;
+  EFI_STATUS            Status;
+  EFI_SIGNATURE_LIST    *CertList;
+  EFI_SIGNATURE_DATA    *Cert;
+  UINTN                 DataSize;
+  UINT8                 *Data;
+  UINTN                 Index;
+  UINTN                 CertCount;
+  SIGNATURE_HASH_CACHE  *Cache;
+  UINTN                 Low;
+  UINTN                 High;
+  UINTN                 Middle;
+  INTN                  Result;
+
+  *IsFound = FALSE;
+
+  //
+  // Binary search the sorted hash signatures of the database when they are available.
+  //
+  Cache = GetSignatureHashCache (VariableName, CertType, SignatureSize);
+  if (Cache != NULL) {
+    Low  = 0;
+    High = Cache->Count;
+    while (Low < High) {
+      Middle = Low + (High - Low) / 2;
+      Result = CompareMem (Cache->Entries[Middle]->SignatureData, Signature, SignatureSize);
+      if (Result < 0) {
+        Low = Middle + 1;
+      } else {
+        High = Middle;
+      }
+    }
+
+    if ((Low < Cache->Count) && (CompareMem (Cache->Entries[Low]->SignatureData, Signature, SignatureSize) == 0)) {
+      *IsFound = TRUE;
+      //
+      // Entries in UEFI_IMAGE_SECURITY_DATABASE that are used to validate image should be measured
+      //
+      if (StrCmp (VariableName, EFI_IMAGE_SECURITY_DATABASE) == 0) {
+        SecureBootHook (VariableName, &gEfiImageSecurityDatabaseGuid, Cache->EntrySize, Cache->Entries[Low]);
+      }
+    }
+
+    return EFI_SUCCESS;
+  }
 
   //
   // Read signature database variable.
   //
-  *IsFound = FALSE;
   Data     = NULL;
   DataSize = 0;
   Status   = gRT->GetVariable (VariableName, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, NULL);
@@ -1606,6 +1846,169 @@ Done:
   return VerifyStatus;
 }
 
+/**
+  Hash the current contents of the image security databases and flush the verified
+  signature cache if they differ from the contents it was built against.
+
+  The sorted hash signature caches follow the same generation and are released here
+  as well.
+
+  @retval TRUE   The verified signature cache may be used.
+  @retval FALSE  The databases could not be read, the cache must not be used.
+
+**/
+BOOLEAN
+RefreshVerifiedCache (
+  VOID
+  )
+{
+  CHAR16      *VarNames[3];
+  UINTN       Index;
+  VOID        *Data;
+  UINTN       DataSize;
+  UINT64      Size;
+  VOID        *HashCtx;
+  UINT8       Digest[SHA256_DIGEST_SIZE];
+  BOOLEAN     Result;
+  EFI_STATUS  Status;
+
+  VarNames[0] = EFI_IMAGE_SECURITY_DATABASE;
+  VarNames[1] = EFI_IMAGE_SECURITY_DATABASE1;
+  VarNames[2] = EFI_IMAGE_SECURITY_DATABASE2;
+
+  HashCtx = AllocatePool (Sha256GetContextSize ());
+  if (HashCtx == NULL) {
+    return FALSE;
+  }
+
+  Result = Sha256Init (HashCtx);
+  for (Index = 0; Result && (Index < ARRAY_SIZE (VarNames)); Index++) {
+    Data     = NULL;
+    DataSize = 0;
+    Status   = GetVariable2 (VarNames[Index], &gEfiImageSecurityDatabaseGuid, &Data, &DataSize);
+    if (Status == EFI_NOT_FOUND) {
+      DataSize = 0;
+    } else if (EFI_ERROR (Status)) {
+      Result = FALSE;
+      break;
+    }
+
+    Size   = DataSize;
+    Result = Sha256Update (HashCtx, &Size, sizeof (Size));
+    if (Result && (DataSize != 0)) {
+      Result = Sha256Update (HashCtx, Data, DataSize);
+    }
+
+    if (Data != NULL) {
+      FreePool (Data);
+    }
+  }
+
+  if (Result) {
+    Result = Sha256Final (HashCtx, Digest);
+  }
+
+  FreePool (HashCtx);
+
+  mSignatureHashCacheValid = Result;
+  if (!Result) {
+    return FALSE;
+  }
+
+  if (CompareMem (Digest, mVerifiedCacheGeneration, sizeof (Digest)) != 0) {
+    CopyMem (mVerifiedCacheGeneration, Digest, sizeof (Digest));
+    mVerifiedCacheCount = 0;
+    mVerifiedCacheNext  = 0;
+    FreeSignatureHashCache ();
+  }
+
+  return TRUE;
+}
+
+/**
+  Compute the verified signature cache key of the current image and signature.
+
+  The key covers the hash algorithm, the Authenticode hash of the image held in
+  mImageDigest and the complete signed data, so a cache hit implies the very same
+  signature over the very same image content.
+
+  @param[in]  AuthData      Pointer to the Authenticode signature retrieved from signed image.
+  @param[in]  AuthDataSize  Size of the Authenticode signature in bytes.
+  @param[out] Key           Buffer of SHA256_DIGEST_SIZE bytes receiving the key.
+
+  @retval TRUE   The key was computed.
+  @retval FALSE  The key could not be computed.
+
+**/
+BOOLEAN
+GetVerifiedCacheKey (
+  IN  UINT8  *AuthData,
+  IN  UINTN  AuthDataSize,
+  OUT UINT8  *Key
+  )
+{
+  VOID     *HashCtx;
+  BOOLEAN  Result;
+
+  HashCtx = AllocatePool (Sha256GetContextSize ());
+  if (HashCtx == NULL) {
+    return FALSE;
+  }
+
+  Result = Sha256Init (HashCtx) &&
+           Sha256Update (HashCtx, &mCertType, sizeof (mCertType)) &&
+           Sha256Update (HashCtx, mImageDigest, mImageDigestSize) &&
+           Sha256Update (HashCtx, AuthData, AuthDataSize) &&
+           Sha256Final (HashCtx, Key);
+
+  FreePool (HashCtx);
+  return Result;
+}
+
+/**
+  Check whether a signature has already been verified during this boot.
+
+  @param[in]  Key  Cache key returned by GetVerifiedCacheKey().
+
+  @retval TRUE   The signature was verified against the current db/dbx/dbt.
+  @retval FALSE  The signature is not in the cache.
+
+**/
+BOOLEAN
+IsVerifiedCacheHit (
+  IN CONST UINT8  *Key
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < mVerifiedCacheCount; Index++) {
+    if (CompareMem (mVerifiedCache[Index], Key, SHA256_DIGEST_SIZE) == 0) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Remember a signature that passed the dbx and db checks. Once the cache is full the
+  oldest entry is replaced.
+
+  @param[in]  Key  Cache key returned by GetVerifiedCacheKey().
+
+**/
+VOID
+AddVerifiedCacheEntry (
+  IN CONST UINT8  *Key
+  )
+{
+  CopyMem (mVerifiedCache[mVerifiedCacheNext], Key, SHA256_DIGEST_SIZE);
+  mVerifiedCacheNext = (mVerifiedCacheNext + 1) % VERIFIED_CACHE_ENTRIES;
+  if (mVerifiedCacheCount < VERIFIED_CACHE_ENTRIES) {
+    mVerifiedCacheCount++;
+  }
+}
+
 /**
   Provide verification service for signed images, which include both signature validation
   and platform policy control. For signature types, both UEFI WIN_CERTIFICATE_UEFI_GUID and
@@ -1692,6 +2095,9 @@ DxeImageVerificationHandler (
   BOOLEAN                       IsFound;
   UINT8                         HashAlg;
   BOOLEAN                       IsFoundInDatabase;
+  BOOLEAN                       CacheValid;
+  BOOLEAN                       CacheKeyValid;
+  UINT8                         CacheKey[SHA256_DIGEST_SIZE];
 
   SignatureList     = NULL;
   SignatureListSize = 0;
@@ -1835,6 +2241,12 @@ DxeImageVerificationHandler (
     }
   }
 
+  //
+  // Results of earlier images, and the sorted hash signatures of db and dbx, are reused
+  // as long as the security databases are unchanged.
+  //
+  CacheValid = RefreshVerifiedCache ();
+
   //
   // Start Image Validation.
   //
@@ -1961,21 +2373,30 @@ DxeImageVerificationHandler (
       continue;
     }
 
-    //
-    // Check the digital signature against the revoked certificate in forbidden database (dbx).
-    //
-    if (IsForbiddenByDbx (AuthData, AuthDataSize)) {
-      Action     = EFI_IMAGE_EXECUTION_AUTH_SIG_FAILED;
-      IsVerified = FALSE;
-      break;
-    }
+    CacheKeyValid = CacheValid && GetVerifiedCacheKey (AuthData, AuthDataSize, CacheKey);
+    if (CacheKeyValid && IsVerifiedCacheHit (CacheKey)) {
+      DEBUG ((DEBUG_INFO, "DxeImageVerificationLib: Image signature was verified earlier in this boot.\n"));
+      IsVerified = TRUE;
+    } else {
+      //
+      // Check the digital signature against the revoked certificate in forbidden database (dbx).
+      //
+      if (IsForbiddenByDbx (AuthData, AuthDataSize)) {
+        Action     = EFI_IMAGE_EXECUTION_AUTH_SIG_FAILED;
+        IsVerified = FALSE;
+        break;
+      }
 
-    //
-    // Check the digital signature against the valid certificate in allowed database (db).
-    //
-    if (!IsVerified) {
-      if (IsAllowedByDb (AuthData, AuthDataSize)) {
-        IsVerified = TRUE;
+      //
+      // Check the digital signature against the valid certificate in allowed database (db).
+      //
+      if (!IsVerified) {
+        if (IsAllowedByDb (AuthData, AuthDataSize)) {
+          IsVerified = TRUE;
+          if (CacheKeyValid) {
+            AddVerifiedCacheEntry (CacheKey);
+          }
+        }
       }
     }
 
@@ -73,6 +73,30 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 // Set max digest size as SHA512 Output (64 bytes) by far
 //
 #define MAX_DIGEST_SIZE  SHA512_DIGEST_SIZE
+
+//
+// Number of signatures remembered as verified against db/dbx/dbt during this boot.
+//
+#define VERIFIED_CACHE_ENTRIES  64
+
+//
+// Number of (database, hash algorithm) pairs whose hash signatures are kept sorted
+// for binary search.
+//
+#define SIGNATURE_HASH_CACHE_ENTRIES  8
+
+//
+// Sorted view of the hash signatures of one type found in a signature database.
+//
+typedef struct {
+  CHAR16                *VariableName;
+  EFI_GUID              CertType;
+  UINTN                 SignatureSize;
+  UINT32                EntrySize;
+  UINT8                 *Data;
+  UINTN                 Count;
+  EFI_SIGNATURE_DATA    **Entries;
+} SIGNATURE_HASH_CACHE;
 //
 //
 // PKCS7 Certificate definition
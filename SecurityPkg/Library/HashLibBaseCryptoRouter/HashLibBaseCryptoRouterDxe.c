@@ -30,6 +30,13 @@ UINTN           mHashInterfaceCount = 0;
 UINT32  mSupportedHashMaskLast    = 0;
 UINT32  mSupportedHashMaskCurrent = 0;
 
+//
+// The active PCR banks only change across a TPM reset, so they are queried
+// from the TPM once and not for every extend of an NV index.
+//
+BOOLEAN  mActivePcrBanksValid = FALSE;
+UINT32   mActivePcrBanks      = 0;
+
 /**
   Check mismatch of supported HashMask between modules
   that may link different HashInstanceLib instances.
@@ -230,9 +237,13 @@ HashCompleteAndExtend (
                DigestList
                );
   } else {
-    Status = Tpm2GetCapabilitySupportedAndActivePcrs (&TpmHashAlgorithmBitmap, &ActivePcrBanks);
-    ASSERT_EFI_ERROR (Status);
-    ActivePcrBanks = ActivePcrBanks & mSupportedHashMaskCurrent;
+    if (!mActivePcrBanksValid) {
+      Status = Tpm2GetCapabilitySupportedAndActivePcrs (&TpmHashAlgorithmBitmap, &mActivePcrBanks);
+      ASSERT_EFI_ERROR (Status);
+      mActivePcrBanksValid = !EFI_ERROR (Status);
+    }
+
+    ActivePcrBanks = mActivePcrBanks & mSupportedHashMaskCurrent;
     ZeroMem (&TcgPcrEvent2Digest, sizeof (TcgPcrEvent2Digest));
     BufferPtr         = CopyDigestListToBuffer (&TcgPcrEvent2Digest, DigestList, ActivePcrBanks);
     DigestListBinSize = (UINT32)((UINT8 *)BufferPtr - (UINT8 *)&TcgPcrEvent2Digest);
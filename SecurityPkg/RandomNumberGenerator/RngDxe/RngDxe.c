@@ -138,7 +138,16 @@ RngGetBytes (
   UINT64   TempRand[2];
 
   while (Length > 0) {
-    IsRandom = GetRandomNumber128 (TempRand);
+    //
+    // Requests of up to 8 bytes, and such tails of larger ones, only need
+    // half of a 128-bit random number.
+    //
+    if (Length <= sizeof (TempRand[0])) {
+      IsRandom = GetRandomNumber64 (&TempRand[0]);
+    } else {
+      IsRandom = GetRandomNumber128 (TempRand);
+    }
+
     if (!IsRandom) {
       return EFI_NOT_READY;
     }
@@ -4,6 +4,8 @@
   This driver initialize MemoryOverwriteRequestControl variable. It
   will clear MOR_CLEAR_MEMORY_BIT bit if it is set. It will also do TPer Reset for
   those encrypted drives through EFI_STORAGE_SECURITY_COMMAND_PROTOCOL at EndOfDxe.
+  If PcdMorClearFreeMemory is set, it clears the free memory at EndOfDxe when
+  MOR_CLEAR_MEMORY_BIT is set.
 
 Copyright (c) 2009 - 2018, Intel Corporation. All rights reserved.<BR>
 SPDX-License-Identifier: BSD-2-Clause-Patent
@@ -293,6 +295,108 @@ TPerResetAtEndOfDxe (
   FreePool (HandleBuffer);
 }
 
+/**
+  Notification function of END_OF_DXE that clears the free memory.
+
+  Every free memory range is allocated while it is cleared, so that no
+  callback can allocate it in the meantime. Large ranges are cleared by all
+  processors if the EDKII_PARALLEL_ZERO_MEMORY_PROTOCOL is available.
+
+  @param[in] Event      Event whose notification function is being invoked.
+  @param[in] Context    Pointer to the notification function's context.
+
+**/
+VOID
+EFIAPI
+ClearMemoryAtEndOfDxe (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  EFI_STATUS                           Status;
+  EDKII_PARALLEL_ZERO_MEMORY_PROTOCOL  *ParallelZeroMemory;
+  EFI_MEMORY_DESCRIPTOR                *MemoryMap;
+  EFI_MEMORY_DESCRIPTOR                *Entry;
+  UINTN                                MemoryMapSize;
+  UINTN                                MapKey;
+  UINTN                                DescriptorSize;
+  UINT32                               DescriptorVersion;
+  EFI_PHYSICAL_ADDRESS                 Address;
+  UINT64                               Length;
+  UINT64                               Cleared;
+
+  gBS->CloseEvent (Event);
+
+  Status = gBS->LocateProtocol (&gEdkiiParallelZeroMemoryProtocolGuid, NULL, (VOID **)&ParallelZeroMemory);
+  if (EFI_ERROR (Status)) {
+    ParallelZeroMemory = NULL;
+  }
+
+  MemoryMap     = NULL;
+  MemoryMapSize = 0;
+  do {
+    Status = gBS->GetMemoryMap (&MemoryMapSize, MemoryMap, &MapKey, &DescriptorSize, &DescriptorVersion);
+    if (Status == EFI_BUFFER_TOO_SMALL) {
+      if (MemoryMap != NULL) {
+        FreePool (MemoryMap);
+      }
+
+      //
+      // Leave room for the descriptors that allocating the map adds.
+      //
+      MemoryMapSize += 4 * DescriptorSize;
+      MemoryMap      = AllocatePool (MemoryMapSize);
+      if (MemoryMap == NULL) {
+        Status = EFI_OUT_OF_RESOURCES;
+      }
+    }
+  } while (Status == EFI_BUFFER_TOO_SMALL);
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "TcgMor: Get memory map failure, Status = %r\n", Status));
+    if (MemoryMap != NULL) {
+      FreePool (MemoryMap);
+    }
+
+    return;
+  }
+
+  Cleared = 0;
+  for (Entry = MemoryMap;
+       (UINTN)Entry < (UINTN)MemoryMap + MemoryMapSize;
+       Entry = NEXT_MEMORY_DESCRIPTOR (Entry, DescriptorSize))
+  {
+    if (Entry->Type != EfiConventionalMemory) {
+      continue;
+    }
+
+    Length = EFI_PAGES_TO_SIZE (Entry->NumberOfPages);
+    if (Entry->PhysicalStart + Length - 1 > MAX_ADDRESS) {
+      continue;
+    }
+
+    Address = Entry->PhysicalStart;
+    Status  = gBS->AllocatePages (AllocateAddress, EfiBootServicesData, (UINTN)Entry->NumberOfPages, &Address);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "TcgMor: Memory 0x%lx-0x%lx is not cleared, Status = %r\n", Entry->PhysicalStart, Entry->PhysicalStart + Length - 1, Status));
+      continue;
+    }
+
+    if (ParallelZeroMemory != NULL) {
+      ParallelZeroMemory->ZeroMemory (ParallelZeroMemory, Address, Length);
+    } else {
+      ZeroMem ((VOID *)(UINTN)Address, (UINTN)Length);
+    }
+
+    gBS->FreePages (Address, (UINTN)Entry->NumberOfPages);
+    Cleared += Length;
+  }
+
+  FreePool (MemoryMap);
+
+  DEBUG ((DEBUG_INFO, "TcgMor: Cleared 0x%lx bytes of free memory\n", Cleared));
+}
+
 /**
   Entry Point for TCG MOR Control driver.
 
@@ -368,6 +472,21 @@ MorDriverEntryPoint (
     if (EFI_ERROR (Status)) {
       return Status;
     }
+
+    if (FeaturePcdGet (PcdMorClearFreeMemory) && (MOR_CLEAR_MEMORY_VALUE (mMorControl) != 0x0)) {
+      DEBUG ((DEBUG_INFO, "TcgMor: Create EndofDxe Event for Mor memory clearing!\n"));
+      Status = gBS->CreateEventEx (
+                      EVT_NOTIFY_SIGNAL,
+                      TPL_CALLBACK,
+                      ClearMemoryAtEndOfDxe,
+                      NULL,
+                      &gEfiEndOfDxeEventGroupGuid,
+                      &Event
+                      );
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+    }
   }
 
   return Status;
@@ -19,9 +19,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/DebugLib.h>
 #include <Library/UefiLib.h>
 #include <Library/MemoryAllocationLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/PcdLib.h>
 
 #include <Protocol/StorageSecurityCommand.h>
 #include <Protocol/BlockIo.h>
+#include <Protocol/ParallelZeroMemory.h>
 
 //
 // Supported Security Protocols List Description.
@@ -1715,6 +1715,14 @@ ShellConvertVariables (
 
   /// @todo update this to handle the %0 - %9 for scripting only (borrow from line 1256 area) ? ? ?
 
+  //
+  // Environment variables, script substitutions and escaped percent signs all
+  // need a '%', so most lines have nothing to convert.
+  //
+  if (StrStr (OriginalCommandLine, L"%") == NULL) {
+    return (AllocateCopyPool (NewSize, OriginalCommandLine));
+  }
+
   //
   // calculate the size required for the post-conversion string...
   //
@@ -1799,6 +1807,10 @@ ShellConvertVariables (
       ((ItemSize+(2*sizeof (CHAR16)))/sizeof (CHAR16)),
       L"%"
       );
+    if (StrStr (NewCommandLine1, ItemTemp) == NULL) {
+      continue;
+    }
+
     ShellCopySearchAndReplace (NewCommandLine1, NewCommandLine2, NewSize, ItemTemp, EfiShellGetEnv (MasterEnvList), TRUE, FALSE);
     StrCpyS (NewCommandLine1, NewSize/sizeof (CHAR16), NewCommandLine2);
   }
@@ -85,6 +85,8 @@ STATIC CONST SHELL_PARAM_ITEM  ParamList[] = {
   { L"-c", TypeValue }, // -c   Display cumulative data.
   { L"-n", TypeValue }, // -n # Number of records to display for A and R
   { L"-t", TypeValue }, // -t # Threshold of interest
+  { L"-j", TypeValue }, // -j   Export timeline to a JSON file
+  { L"-d", TypeFlag  }, // -d   Display Stall() time by caller
   { NULL,  TypeMax   }
 };
 
@@ -686,7 +688,9 @@ RunDp (
   BOOLEAN        RawMode;
   BOOLEAN        ExcludeMode;
   BOOLEAN        CumulativeMode;
+  BOOLEAN        StallMode;
   CONST CHAR16   *CustomCumulativeToken;
+  CONST CHAR16   *ExportFile;
   PERF_CUM_DATA  *CustomCumulativeData;
   UINTN          NameSize;
   SHELL_STATUS   ShellStatus;
@@ -700,7 +704,9 @@ RunDp (
   RawMode              = FALSE;
   ExcludeMode          = FALSE;
   CumulativeMode       = FALSE;
+  StallMode            = FALSE;
   CustomCumulativeData = NULL;
+  ExportFile           = NULL;
   ShellStatus          = SHELL_SUCCESS;
 
   //
@@ -731,6 +737,7 @@ RunDp (
   ExcludeMode    = ShellCommandLineGetFlag (ParamPackage, L"-x");
   mShowId        = ShellCommandLineGetFlag (ParamPackage, L"-i");
   CumulativeMode = ShellCommandLineGetFlag (ParamPackage, L"-c");
+  StallMode      = ShellCommandLineGetFlag (ParamPackage, L"-d");
 
   if (AllMode && RawMode) {
     ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_DP_CONFLICT_ARG), mDpHiiHandle, L"-A", L"-R");
@@ -810,6 +817,14 @@ RunDp (
     }
   }
 
+  if (ShellCommandLineGetFlag (ParamPackage, L"-j")) {
+    ExportFile = ShellCommandLineGetValue (ParamPackage, L"-j");
+    if (ExportFile == NULL) {
+      ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_DP_TOO_FEW), mDpHiiHandle);
+      return SHELL_INVALID_PARAMETER;
+    }
+  }
+
   //
   // DP dump performance data by parsing FPDT table in ACPI table.
   // Folloing 3 steps are to get the measurement form the FPDT table.
@@ -842,6 +857,18 @@ RunDp (
     goto Done;
   }
 
+  //
+  // Export the timeline instead of displaying the measurements.
+  //
+  if (ExportFile != NULL) {
+    Status = DpExportTimeline (ExportFile);
+    if (EFI_ERROR (Status)) {
+      ShellStatus = SHELL_DEVICE_ERROR;
+    }
+
+    goto Done;
+  }
+
   //
   // Initialize the pre-defined cumulative data.
   //
@@ -910,13 +937,23 @@ RunDp (
   ****                      Default is 0 for All and Raw mode
   ****                      Default is DEFAULT_THRESHOLD for "Cooked" mode
   ****    n Number2Display  Used by All and Raw mode.  Otherwise ignored.
+  ****    d Stall       --  c, A, R and S options are ignored
   ****    A All         --  R and S options are ignored
   ****    R Raw         --  S option is ignored
   ****    s Summary     --  Modifies "Cooked" output only
   ****    Cooked (Default)
   ****************************************************************************/
   GatherStatistics (CustomCumulativeData);
-  if (CumulativeMode) {
+  if (StallMode) {
+    Status = ProcessStalls ();
+    if (Status == EFI_ABORTED) {
+      ShellStatus = SHELL_ABORTED;
+      goto Done;
+    } else if (EFI_ERROR (Status)) {
+      ShellStatus = SHELL_OUT_OF_RESOURCES;
+      goto Done;
+    }
+  } else if (CumulativeMode) {
     ProcessCumulative (CustomCumulativeData);
   } else if (AllMode) {
     Status = DumpAllTrace (Number2Display, ExcludeMode);
@@ -0,0 +1,510 @@
+/** @file
+  Timeline export for the Dp utility.
+
+  Writes the FPDT measurements and the DXE Core boot service trace, if it was
+  enabled with PcdDxeCoreTraceBufferSize, to a file in the Chrome trace event
+  JSON format, which chrome://tracing and Perfetto can open. Boot service
+  calls are attributed to the image that contains their caller and placed on
+  the timeline of the CPU that made them.
+
+  The file also carries a bootSummary object with the phase durations and the
+  slowest modules, so that scripts comparing boots do not have to rebuild
+  them from the events.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/PrintLib.h>
+#include <Library/HiiLib.h>
+
+#include <Guid/DxeCoreTrace.h>
+
+#include "Dp.h"
+#include "Literals.h"
+#include "DpInternal.h"
+
+#define DP_EXPORT_LINE_LENGTH  512
+
+//
+// Number of modules listed in the bootSummary object
+//
+#define DP_EXPORT_TOP_MODULES  20
+
+STATIC CONST CHAR8  *mDpExportServiceName[] = {
+  "Unknown",
+  "ConnectController",
+  "LocateProtocol",
+  "AllocatePages",
+  "FreePages",
+  "Stall",
+  "ApProcedure"
+};
+
+STATIC CONST CHAR8  *mDpExportArgumentName[] = {
+  "argument",
+  "controller",
+  "argument",
+  "pages",
+  "pages",
+  "microseconds",
+  "parameter"
+};
+
+STATIC CHAR8  mDpExportLine[DP_EXPORT_LINE_LENGTH];
+
+/**
+  Format a line of the export file and write it.
+
+  @param[in]  File      The export file.
+  @param[in]  Format    ASCII format string.
+  @param[in]  ...       The arguments of Format.
+
+  @retval EFI_SUCCESS   The line was written.
+  @retval others        The error returned by ShellWriteFile().
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+DpExportWrite (
+  IN SHELL_FILE_HANDLE  File,
+  IN CONST CHAR8        *Format,
+  ...
+  )
+{
+  VA_LIST  Marker;
+  UINTN    Size;
+
+  VA_START (Marker, Format);
+  Size = AsciiVSPrint (mDpExportLine, sizeof (mDpExportLine), Format, Marker);
+  VA_END (Marker);
+
+  return ShellWriteFile (File, &Size, mDpExportLine);
+}
+
+/**
+  Replace the characters that would need escaping in a JSON string.
+
+  @param[in, out]  Name   The Unicode string to clean up in place.
+**/
+STATIC
+VOID
+DpExportSanitize (
+  IN OUT CHAR16  *Name
+  )
+{
+  for ( ; *Name != L'\0'; Name++) {
+    if ((*Name == L'"') || (*Name == L'\\') || (*Name < L' ')) {
+      *Name = L'_';
+    }
+  }
+}
+
+/**
+  Split a time in nanoseconds into the microseconds and the remaining
+  nanoseconds that the export file expresses it with.
+
+  @param[in]   Time          The time in nanoseconds.
+  @param[out]  Nanoseconds   The nanoseconds below one microsecond.
+
+  @return The whole microseconds of Time.
+**/
+STATIC
+UINT64
+DpExportMicroseconds (
+  IN  UINT64  Time,
+  OUT UINT32  *Nanoseconds
+  )
+{
+  return DivU64x32Remainder (Time, 1000, Nanoseconds);
+}
+
+/**
+  Write the FPDT measurements as complete events on the BSP timeline.
+
+  @param[in]  File      The export file.
+  @param[in]  First     TRUE if no event was written yet.
+
+  @retval EFI_SUCCESS   The measurements were written.
+  @retval others        The error returned by ShellWriteFile().
+**/
+STATIC
+EFI_STATUS
+DpExportMeasurements (
+  IN     SHELL_FILE_HANDLE  File,
+  IN OUT BOOLEAN            *First
+  )
+{
+  EFI_STATUS          Status;
+  UINTN               Index;
+  MEASUREMENT_RECORD  *Measurement;
+  UINT64              Start;
+  UINT64              Duration;
+  UINT32              StartNs;
+  UINT32              DurationNs;
+
+  for (Index = 0; Index < mMeasurementNum; Index++) {
+    Measurement = &mMeasurementList[Index];
+    if (Measurement->EndTimeStamp == 0) {
+      continue;
+    }
+
+    Start    = DpExportMicroseconds (Measurement->StartTimeStamp, &StartNs);
+    Duration = DpExportMicroseconds (GetDuration (Measurement), &DurationNs);
+
+    AsciiStrToUnicodeStrS (Measurement->Token, mUnicodeToken, ARRAY_SIZE (mUnicodeToken));
+    AsciiStrToUnicodeStrS (Measurement->Module, mGaugeString, ARRAY_SIZE (mGaugeString));
+    DpExportSanitize (mUnicodeToken);
+    DpExportSanitize (mGaugeString);
+
+    Status = DpExportWrite (
+               File,
+               "%a{\"name\":\"%s\",\"cat\":\"fpdt\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":%ld.%03d,\"dur\":%ld.%03d,\"args\":{\"module\":\"%s\"}}",
+               *First ? "" : ",\n",
+               mUnicodeToken,
+               Start,
+               StartNs,
+               Duration,
+               DurationNs,
+               mGaugeString
+               );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    *First = FALSE;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Write the DXE Core trace records as complete events on the timeline of the
+  CPU that made them.
+
+  @param[in]  File      The export file.
+  @param[in]  First     TRUE if no event was written yet.
+
+  @retval EFI_SUCCESS   The records were written.
+  @retval others        The error returned by ShellWriteFile().
+**/
+STATIC
+EFI_STATUS
+DpExportTraceRecords (
+  IN     SHELL_FILE_HANDLE  File,
+  IN OUT BOOLEAN            *First
+  )
+{
+  EFI_STATUS                   Status;
+  EDKII_DXE_CORE_TRACE_TABLE   *Table;
+  EDKII_DXE_CORE_TRACE_RECORD  *Record;
+  DP_LOADED_IMAGE              *Images;
+  DP_LOADED_IMAGE              *Image;
+  UINTN                        ImageCount;
+  UINTN                        ImageIndex;
+  UINT32                       Count;
+  UINT32                       Index;
+  UINT32                       Service;
+  CONST CHAR16                 *Name;
+  UINT64                       Start;
+  UINT64                       Duration;
+  UINT32                       StartNs;
+  UINT32                       DurationNs;
+
+  Status = EfiGetSystemConfigurationTable (&gEdkiiDxeCoreTraceTableGuid, (VOID **)&Table);
+  if (EFI_ERROR (Status) || (Table == NULL) || (Table->Signature != EDKII_DXE_CORE_TRACE_SIGNATURE)) {
+    ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_DP_TRACE_NOT_FOUND), mDpHiiHandle);
+    return EFI_SUCCESS;
+  }
+
+  //
+  // The trace keeps running while it is exported, take a snapshot of the count.
+  //
+  Count = MIN (Table->RecordCount, Table->MaxRecords);
+  if (Table->RecordCount > Table->MaxRecords) {
+    ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_DP_TRACE_DROPPED), mDpHiiHandle, Table->RecordCount - Table->MaxRecords);
+  }
+
+  Images = DpGetLoadedImages (&ImageCount);
+  for (ImageIndex = 0; ImageIndex < ImageCount; ImageIndex++) {
+    DpExportSanitize (Images[ImageIndex].Name);
+  }
+
+  Record = (EDKII_DXE_CORE_TRACE_RECORD *)(Table + 1);
+  Status = EFI_SUCCESS;
+
+  for (Index = 0; Index < Count; Index++, Record++) {
+    if (Record->EndTime == 0) {
+      continue;
+    }
+
+    Image = DpFindLoadedImage (Images, ImageCount, Record->Caller);
+    Name  = (Image != NULL) ? Image->Name : L"Unknown";
+
+    Service = Record->Service;
+    if (Service >= ARRAY_SIZE (mDpExportServiceName)) {
+      Service = 0;
+    }
+
+    Start    = DpExportMicroseconds (Record->StartTime, &StartNs);
+    Duration = DpExportMicroseconds (Record->EndTime - Record->StartTime, &DurationNs);
+
+    if (Record->Service == EDKII_DXE_CORE_TRACE_LOCATE_PROTOCOL) {
+      Status = DpExportWrite (
+                 File,
+                 "%a{\"name\":\"%a\",\"cat\":\"trace\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%ld.%03d,\"dur\":%ld.%03d,\"args\":{\"image\":\"%s\",\"protocol\":\"%g\"}}",
+                 *First ? "" : ",\n",
+                 mDpExportServiceName[Service],
+                 Record->CpuIndex,
+                 Start,
+                 StartNs,
+                 Duration,
+                 DurationNs,
+                 Name,
+                 &Record->Guid
+                 );
+    } else {
+      Status = DpExportWrite (
+                 File,
+                 "%a{\"name\":\"%a\",\"cat\":\"trace\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%ld.%03d,\"dur\":%ld.%03d,\"args\":{\"image\":\"%s\",\"%a\":\"0x%lx\"}}",
+                 *First ? "" : ",\n",
+                 mDpExportServiceName[Service],
+                 Record->CpuIndex,
+                 Start,
+                 StartNs,
+                 Duration,
+                 DurationNs,
+                 Name,
+                 mDpExportArgumentName[Service],
+                 Record->Argument
+                 );
+    }
+
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+
+    *First = FALSE;
+  }
+
+  SHELL_FREE_NON_NULL (Images);
+  return Status;
+}
+
+/**
+  Write the duration of a boot phase as a member of the bootSummary object.
+
+  @param[in]  File      The export file.
+  @param[in]  Name      The name of the member.
+  @param[in]  Duration  The duration of the phase in nanoseconds.
+
+  @retval EFI_SUCCESS   The member was written.
+  @retval others        The error returned by ShellWriteFile().
+**/
+STATIC
+EFI_STATUS
+DpExportPhase (
+  IN SHELL_FILE_HANDLE  File,
+  IN CONST CHAR8        *Name,
+  IN UINT64             Duration
+  )
+{
+  UINT64  Microseconds;
+  UINT32  Nanoseconds;
+
+  Microseconds = DpExportMicroseconds (Duration, &Nanoseconds);
+  return DpExportWrite (File, "\"%a\":%ld.%03d,", Name, Microseconds, Nanoseconds);
+}
+
+/**
+  Write the bootSummary object: the SEC, PEI, DXE and BDS phase durations
+  and the PEIMs and DXE images that took the longest to dispatch or start,
+  all in microseconds.
+
+  @param[in]  File      The export file.
+
+  @retval EFI_SUCCESS   The summary was written.
+  @retval others        The error returned by ShellWriteFile().
+**/
+STATIC
+EFI_STATUS
+DpExportSummary (
+  IN SHELL_FILE_HANDLE  File
+  )
+{
+  EFI_STATUS          Status;
+  MEASUREMENT_RECORD  *Measurement;
+  MEASUREMENT_RECORD  *Top[DP_EXPORT_TOP_MODULES];
+  UINTN               TopCount;
+  UINTN               Index;
+  UINTN               Slot;
+  UINT64              SecTime;
+  UINT64              PeiTime;
+  UINT64              DxeTime;
+  UINT64              BdsTime;
+  UINT64              Duration;
+  UINT32              DurationNs;
+
+  SecTime  = 0;
+  PeiTime  = 0;
+  DxeTime  = 0;
+  BdsTime  = 0;
+  TopCount = 0;
+
+  for (Index = 0; Index < mMeasurementNum; Index++) {
+    Measurement = &mMeasurementList[Index];
+    if (Measurement->EndTimeStamp == 0) {
+      continue;
+    }
+
+    if (AsciiStrCmp (Measurement->Token, ALit_SEC) == 0) {
+      SecTime = GetDuration (Measurement);
+    } else if (AsciiStrCmp (Measurement->Token, ALit_PEI) == 0) {
+      PeiTime = GetDuration (Measurement);
+    } else if (AsciiStrCmp (Measurement->Token, ALit_DXE) == 0) {
+      DxeTime = GetDuration (Measurement);
+    } else if (AsciiStrCmp (Measurement->Token, ALit_BDS) == 0) {
+      BdsTime = GetDuration (Measurement);
+    } else if ((AsciiStrCmp (Measurement->Token, ALit_PEIM) == 0) ||
+               (AsciiStrCmp (Measurement->Token, ALit_START_IMAGE) == 0))
+    {
+      //
+      // Keep the slowest modules in Top, sorted by decreasing duration
+      //
+      Duration = GetDuration (Measurement);
+      for (Slot = TopCount; (Slot > 0) && (GetDuration (Top[Slot - 1]) < Duration); Slot--) {
+        if (Slot < DP_EXPORT_TOP_MODULES) {
+          Top[Slot] = Top[Slot - 1];
+        }
+      }
+
+      if (Slot < DP_EXPORT_TOP_MODULES) {
+        Top[Slot] = Measurement;
+        TopCount  = MIN (TopCount + 1, DP_EXPORT_TOP_MODULES);
+      }
+    }
+  }
+
+  //
+  // Like ProcessPhases(), count SEC from the end of the reset
+  //
+  if (SecTime > mResetEnd) {
+    SecTime -= mResetEnd;
+  }
+
+  Status = DpExportWrite (File, ",\n\"bootSummary\":{");
+  if (!EFI_ERROR (Status)) {
+    Status = DpExportPhase (File, "sec", SecTime);
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = DpExportPhase (File, "pei", PeiTime);
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = DpExportPhase (File, "dxe", DxeTime);
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = DpExportPhase (File, "bds", BdsTime);
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = DpExportWrite (File, "\"topModules\":[");
+  }
+
+  for (Index = 0; (Index < TopCount) && !EFI_ERROR (Status); Index++) {
+    AsciiStrToUnicodeStrS (Top[Index]->Token, mUnicodeToken, ARRAY_SIZE (mUnicodeToken));
+    AsciiStrToUnicodeStrS (Top[Index]->Module, mGaugeString, ARRAY_SIZE (mGaugeString));
+    DpExportSanitize (mUnicodeToken);
+    DpExportSanitize (mGaugeString);
+
+    Duration = DpExportMicroseconds (GetDuration (Top[Index]), &DurationNs);
+    Status   = DpExportWrite (
+                 File,
+                 "%a\n{\"module\":\"%s\",\"token\":\"%s\",\"dur\":%ld.%03d}",
+                 (Index == 0) ? "" : ",",
+                 mGaugeString,
+                 mUnicodeToken,
+                 Duration,
+                 DurationNs
+                 );
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = DpExportWrite (File, "]}");
+  }
+
+  return Status;
+}
+
+/**
+  Export the FPDT measurements and the DXE Core boot service trace to a file
+  in the Chrome trace event JSON format.
+
+  @param[in]  FileName    The name of the file to create. An existing file is
+                          replaced.
+
+  @retval EFI_SUCCESS     The file was written.
+  @retval others          The file could not be created or written.
+**/
+EFI_STATUS
+DpExportTimeline (
+  IN CONST CHAR16  *FileName
+  )
+{
+  EFI_STATUS         Status;
+  SHELL_FILE_HANDLE  File;
+  BOOLEAN            First;
+
+  if (!EFI_ERROR (ShellFileExists (FileName))) {
+    ShellDeleteFileByName (FileName);
+  }
+
+  Status = ShellOpenFileByName (
+             FileName,
+             &File,
+             EFI_FILE_MODE_CREATE | EFI_FILE_MODE_WRITE | EFI_FILE_MODE_READ,
+             0
+             );
+  if (EFI_ERROR (Status)) {
+    ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_DP_EXPORT_FAIL), mDpHiiHandle, FileName, Status);
+    return Status;
+  }
+
+  First  = TRUE;
+  Status = DpExportWrite (File, "{\"traceEvents\":[\n");
+  if (!EFI_ERROR (Status)) {
+    Status = DpExportMeasurements (File, &First);
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = DpExportTraceRecords (File, &First);
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = DpExportWrite (File, "\n]");
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = DpExportSummary (File);
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = DpExportWrite (File, ",\"displayTimeUnit\":\"ns\"}\n");
+  }
+
+  ShellCloseFile (&File);
+
+  if (EFI_ERROR (Status)) {
+    ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_DP_EXPORT_FAIL), mDpHiiHandle, FileName, Status);
+  } else {
+    ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_DP_EXPORT_DONE), mDpHiiHandle, FileName);
+  }
+
+  return Status;
+}
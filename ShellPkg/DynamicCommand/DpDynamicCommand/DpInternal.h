@@ -16,6 +16,15 @@
 
 #define DP_GAUGE_STRING_LENGTH  36
 
+///
+/// Address range and name of a loaded image.
+///
+typedef struct {
+  UINT64    Base;
+  UINT64    Size;
+  CHAR16    Name[DP_GAUGE_STRING_LENGTH + 1];
+} DP_LOADED_IMAGE;
+
 //
 /// Module-Global Variables
 ///@{
@@ -312,4 +321,60 @@ ProcessCumulative (
   IN PERF_CUM_DATA  *CustomCumulativeData OPTIONAL
   );
 
+/**
+  Collect the address range and name of every loaded image.
+
+  @param[out]  ImageCount   The number of images returned.
+
+  @return The images, or NULL. The caller frees the buffer.
+**/
+DP_LOADED_IMAGE *
+DpGetLoadedImages (
+  OUT UINTN  *ImageCount
+  );
+
+/**
+  Find the loaded image that contains an address.
+
+  @param[in]  Images        The images returned by DpGetLoadedImages().
+  @param[in]  ImageCount    The number of images.
+  @param[in]  Address       The address to look up.
+
+  @return The image that contains Address, or NULL.
+**/
+DP_LOADED_IMAGE *
+DpFindLoadedImage (
+  IN DP_LOADED_IMAGE  *Images,
+  IN UINTN            ImageCount,
+  IN UINT64           Address
+  );
+
+/**
+  Gather and print the Stall() time accounted by the DXE Core, per calling
+  image and per call site.
+
+  @retval EFI_SUCCESS           The operation was successful.
+  @retval EFI_ABORTED           The user aborts the operation.
+  @retval EFI_OUT_OF_RESOURCES  There is not enough memory to sort the call sites.
+**/
+EFI_STATUS
+ProcessStalls (
+  VOID
+  );
+
+/**
+  Export the FPDT measurements and the DXE Core boot service trace to a file
+  in the Chrome trace event JSON format.
+
+  @param[in]  FileName    The name of the file to create. An existing file is
+                          replaced.
+
+  @retval EFI_SUCCESS     The file was written.
+  @retval others          The file could not be created or written.
+**/
+EFI_STATUS
+DpExportTimeline (
+  IN CONST CHAR16  *FileName
+  );
+
 #endif
@@ -17,6 +17,8 @@
 #include <Library/HiiLib.h>
 #include <Library/PcdLib.h>
 
+#include <Guid/DxeCoreTrace.h>
+
 #include "Dp.h"
 #include "Literals.h"
 #include "DpInternal.h"
@@ -1048,3 +1050,178 @@ ProcessCumulative (
       );
   }
 }
+
+/**
+  Compare two Stall() accounting entries by elapsed time, longest first.
+
+  @param[in]  Buffer1   The first EDKII_DXE_CORE_STALL_ENTRY.
+  @param[in]  Buffer2   The second EDKII_DXE_CORE_STALL_ENTRY.
+
+  @retval <0    Buffer1 stalled longer than Buffer2.
+  @retval 0     Both stalled for the same time.
+  @retval >0    Buffer1 stalled shorter than Buffer2.
+**/
+STATIC
+INTN
+EFIAPI
+CompareStallEntries (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  UINT64  Elapsed1;
+  UINT64  Elapsed2;
+
+  Elapsed1 = ((CONST EDKII_DXE_CORE_STALL_ENTRY *)Buffer1)->ElapsedNanoseconds;
+  Elapsed2 = ((CONST EDKII_DXE_CORE_STALL_ENTRY *)Buffer2)->ElapsedNanoseconds;
+  if (Elapsed1 > Elapsed2) {
+    return -1;
+  }
+
+  return (Elapsed1 < Elapsed2) ? 1 : 0;
+}
+
+/**
+  Gather and print the Stall() time accounted by the DXE Core, per calling
+  image and per call site.
+
+  The DXE Core only accounts Stall() if PcdDxeCoreStallAccountingEntries is not
+  zero. Delays made through TimerLib are not seen by the DXE Core.
+
+  @retval EFI_SUCCESS           The operation was successful.
+  @retval EFI_ABORTED           The user aborts the operation.
+  @retval EFI_OUT_OF_RESOURCES  There is not enough memory to sort the call sites.
+**/
+EFI_STATUS
+ProcessStalls (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  EDKII_DXE_CORE_STALL_TABLE  *Table;
+  EDKII_DXE_CORE_STALL_ENTRY  *Sites;
+  EDKII_DXE_CORE_STALL_ENTRY  *Totals;
+  DP_LOADED_IMAGE             *Images;
+  DP_LOADED_IMAGE             *Image;
+  UINTN                       ImageCount;
+  UINTN                       ImageIndex;
+  UINTN                       SiteCount;
+  UINTN                       Index;
+  EFI_STRING                  StringPtr;
+  EFI_STRING                  StringPtrUnknown;
+
+  Status = EfiGetSystemConfigurationTable (&gEdkiiDxeCoreStallTableGuid, (VOID **)&Table);
+  if (EFI_ERROR (Status) || (Table == NULL) || (Table->Signature != EDKII_DXE_CORE_STALL_SIGNATURE)) {
+    ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_DP_STALL_NOT_FOUND), mDpHiiHandle);
+    return EFI_SUCCESS;
+  }
+
+  //
+  // Entries keep being added while DP runs, work on a snapshot.
+  //
+  SiteCount = MIN (Table->EntryCount, Table->MaxEntries);
+  Sites     = AllocateCopyPool (MAX (SiteCount, 1) * sizeof (EDKII_DXE_CORE_STALL_ENTRY), Table + 1);
+  Images    = DpGetLoadedImages (&ImageCount);
+  Totals    = AllocateZeroPool ((ImageCount + 1) * sizeof (EDKII_DXE_CORE_STALL_ENTRY));
+  if ((Sites == NULL) || (Totals == NULL)) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Done;
+  }
+
+  //
+  // Add up the call sites of every image. Totals[ImageCount] collects the
+  // call sites that are not in any loaded image.
+  //
+  for (Index = 0; Index < SiteCount; Index++) {
+    Image      = DpFindLoadedImage (Images, ImageCount, Sites[Index].Caller);
+    ImageIndex = (Image != NULL) ? (UINTN)(Image - Images) : ImageCount;
+
+    Totals[ImageIndex].Caller                 = ImageIndex;
+    Totals[ImageIndex].Count                 += Sites[Index].Count;
+    Totals[ImageIndex].RequestedMicroseconds += Sites[Index].RequestedMicroseconds;
+    Totals[ImageIndex].ElapsedNanoseconds    += Sites[Index].ElapsedNanoseconds;
+  }
+
+  PerformQuickSort (Totals, ImageCount + 1, sizeof (EDKII_DXE_CORE_STALL_ENTRY), CompareStallEntries);
+  PerformQuickSort (Sites, SiteCount, sizeof (EDKII_DXE_CORE_STALL_ENTRY), CompareStallEntries);
+
+  StringPtrUnknown = HiiGetString (mDpHiiHandle, STRING_TOKEN (STR_ALIT_UNKNOWN), NULL);
+  StringPtr        = HiiGetString (mDpHiiHandle, STRING_TOKEN (STR_DP_SECTION_STALL_IMAGES), NULL);
+  ShellPrintHiiEx (
+    -1,
+    -1,
+    NULL,
+    STRING_TOKEN (STR_DP_SECTION_HEADER),
+    mDpHiiHandle,
+    (StringPtr == NULL) ? StringPtrUnknown : StringPtr
+    );
+  SHELL_FREE_NON_NULL (StringPtr);
+
+  ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_DP_STALL_IMAGE_SECTION), mDpHiiHandle);
+  ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_DP_DASHES), mDpHiiHandle);
+
+  for (Index = 0; Index <= ImageCount; Index++) {
+    if (Totals[Index].Count == 0) {
+      continue;
+    }
+
+    ImageIndex = (UINTN)Totals[Index].Caller;
+    ShellPrintHiiEx (
+      -1,
+      -1,
+      NULL,
+      STRING_TOKEN (STR_DP_STALL_IMAGE_VARS),
+      mDpHiiHandle,
+      (ImageIndex < ImageCount) ? Images[ImageIndex].Name : StringPtrUnknown,
+      Totals[Index].Count,
+      Totals[Index].RequestedMicroseconds,
+      DurationInMicroSeconds (Totals[Index].ElapsedNanoseconds)
+      );
+  }
+
+  StringPtr = HiiGetString (mDpHiiHandle, STRING_TOKEN (STR_DP_SECTION_STALL_SITES), NULL);
+  ShellPrintHiiEx (
+    -1,
+    -1,
+    NULL,
+    STRING_TOKEN (STR_DP_SECTION_HEADER),
+    mDpHiiHandle,
+    (StringPtr == NULL) ? StringPtrUnknown : StringPtr
+    );
+  SHELL_FREE_NON_NULL (StringPtr);
+
+  ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_DP_STALL_SITE_SECTION), mDpHiiHandle);
+  ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_DP_DASHES), mDpHiiHandle);
+
+  for (Index = 0; Index < SiteCount; Index++) {
+    Image = DpFindLoadedImage (Images, ImageCount, Sites[Index].Caller);
+    ShellPrintHiiEx (
+      -1,
+      -1,
+      NULL,
+      STRING_TOKEN (STR_DP_STALL_SITE_VARS),
+      mDpHiiHandle,
+      (Image != NULL) ? Image->Name : StringPtrUnknown,
+      (Image != NULL) ? Sites[Index].Caller - Image->Base : Sites[Index].Caller,
+      Sites[Index].Count,
+      Sites[Index].RequestedMicroseconds,
+      DurationInMicroSeconds (Sites[Index].ElapsedNanoseconds)
+      );
+    if (ShellGetExecutionBreakFlag ()) {
+      Status = EFI_ABORTED;
+      break;
+    }
+  }
+
+  if (Table->DroppedCount != 0) {
+    ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_DP_STALL_DROPPED), mDpHiiHandle, Table->DroppedCount);
+  }
+
+  SHELL_FREE_NON_NULL (StringPtrUnknown);
+
+Done:
+  SHELL_FREE_NON_NULL (Sites);
+  SHELL_FREE_NON_NULL (Totals);
+  SHELL_FREE_NON_NULL (Images);
+  return Status;
+}
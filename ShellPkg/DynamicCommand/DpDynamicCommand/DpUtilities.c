@@ -425,3 +425,76 @@ GetCumulativeItem (
   // If the for loop exits, Token was not found.
   return -1;   // Indicate failure
 }
+
+/**
+  Collect the address range and name of every loaded image.
+
+  @param[out]  ImageCount   The number of images returned.
+
+  @return The images, or NULL. The caller frees the buffer.
+**/
+DP_LOADED_IMAGE *
+DpGetLoadedImages (
+  OUT UINTN  *ImageCount
+  )
+{
+  EFI_STATUS                 Status;
+  EFI_HANDLE                 *HandleBuffer;
+  UINTN                      HandleCount;
+  UINTN                      Index;
+  EFI_LOADED_IMAGE_PROTOCOL  *LoadedImage;
+  DP_LOADED_IMAGE            *Images;
+
+  *ImageCount = 0;
+
+  Status = gBS->LocateHandleBuffer (ByProtocol, &gEfiLoadedImageProtocolGuid, NULL, &HandleCount, &HandleBuffer);
+  if (EFI_ERROR (Status)) {
+    return NULL;
+  }
+
+  Images = AllocateZeroPool (HandleCount * sizeof (DP_LOADED_IMAGE));
+  if (Images != NULL) {
+    for (Index = 0; Index < HandleCount; Index++) {
+      Status = gBS->HandleProtocol (HandleBuffer[Index], &gEfiLoadedImageProtocolGuid, (VOID **)&LoadedImage);
+      if (EFI_ERROR (Status)) {
+        continue;
+      }
+
+      DpGetNameFromHandle (HandleBuffer[Index]);
+      Images[*ImageCount].Base = (UINT64)(UINTN)LoadedImage->ImageBase;
+      Images[*ImageCount].Size = LoadedImage->ImageSize;
+      StrnCpyS (Images[*ImageCount].Name, ARRAY_SIZE (Images[*ImageCount].Name), mGaugeString, DP_GAUGE_STRING_LENGTH);
+      (*ImageCount)++;
+    }
+  }
+
+  FreePool (HandleBuffer);
+  return Images;
+}
+
+/**
+  Find the loaded image that contains an address.
+
+  @param[in]  Images        The images returned by DpGetLoadedImages().
+  @param[in]  ImageCount    The number of images.
+  @param[in]  Address       The address to look up.
+
+  @return The image that contains Address, or NULL.
+**/
+DP_LOADED_IMAGE *
+DpFindLoadedImage (
+  IN DP_LOADED_IMAGE  *Images,
+  IN UINTN            ImageCount,
+  IN UINT64           Address
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < ImageCount; Index++) {
+    if ((Address >= Images[Index].Base) && (Address - Images[Index].Base < Images[Index].Size)) {
+      return &Images[Index];
+    }
+  }
+
+  return NULL;
+}
@@ -11,6 +11,12 @@
 #include <Guid/FileSystemInfo.h>
 #include <Guid/FileSystemVolumeLabelInfo.h>
 
+//
+// Files are copied in chunks of up to this size, so that large files do not
+// take one read and one write per PcdShellFileOperationSize bytes.
+//
+#define CP_MAX_BUFFER_SIZE  SIZE_1MB
+
 /**
   Function to take a list of files to copy and a destination location and do
   the verification and copying of those files to that location.  This function
@@ -61,6 +67,7 @@ CopySingleFile (
 {
   VOID                  *Response;
   UINTN                 ReadSize;
+  UINTN                 BufferSize;
   SHELL_FILE_HANDLE     SourceHandle;
   SHELL_FILE_HANDLE     DestHandle;
   EFI_STATUS            Status;
@@ -179,6 +186,13 @@ CopySingleFile (
     ShellGetFileSize (SourceHandle, &SourceFileSize);
     ShellGetFileSize (DestHandle, &DestFileSize);
 
+    //
+    // Use a buffer large enough for the whole file, within the limits of
+    // PcdShellFileOperationSize and CP_MAX_BUFFER_SIZE.
+    //
+    BufferSize = (UINTN)MIN (SourceFileSize, CP_MAX_BUFFER_SIZE);
+    BufferSize = MAX (BufferSize, PcdGet32 (PcdShellFileOperationSize));
+
     //
     // if the destination file already exists then it will be replaced, meaning the sourcefile effectively needs less storage space
     //
@@ -225,13 +239,19 @@ CopySingleFile (
       //
       // copy data between files
       //
-      Buffer = AllocateZeroPool (ReadSize);
+      Buffer = AllocatePool (BufferSize);
+      if ((Buffer == NULL) && (BufferSize > PcdGet32 (PcdShellFileOperationSize))) {
+        BufferSize = PcdGet32 (PcdShellFileOperationSize);
+        Buffer     = AllocatePool (BufferSize);
+      }
+
       if (Buffer == NULL) {
         ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_GEN_OUT_MEM), gShellLevel2HiiHandle, CmdName);
         return SHELL_OUT_OF_RESOURCES;
       }
 
-      while (ReadSize == PcdGet32 (PcdShellFileOperationSize) && !EFI_ERROR (Status)) {
+      ReadSize = BufferSize;
+      while (ReadSize == BufferSize && !EFI_ERROR (Status)) {
         Status = ShellReadFile (SourceHandle, &ReadSize, Buffer);
         if (!EFI_ERROR (Status)) {
           Status = ShellWriteFile (DestHandle, &ReadSize, Buffer);
@@ -246,6 +266,8 @@ CopySingleFile (
           break;
         }
       }
+
+      FreePool (Buffer);
     }
 
     SHELL_FREE_NON_NULL (DestVolumeInfo);
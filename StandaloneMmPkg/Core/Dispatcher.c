@@ -134,17 +134,39 @@ MmLoadImage (
     return Status;
   }
 
-  PageCount = (UINTN)EFI_SIZE_TO_PAGES ((UINTN)ImageContext.ImageSize + ImageContext.SectionAlignment);
-  DstBuffer = (UINTN)(-1);
-
-  Status = MmAllocatePages (
-             AllocateMaxAddress,
-             EfiRuntimeServicesCode,
-             PageCount,
-             &DstBuffer
-             );
+  //
+  // If the build linked the image at an address in free MMRAM, load it there so
+  // that it needs no relocation. Otherwise load it anywhere and relocate it.
+  //
+  Status = EFI_NOT_FOUND;
+  if (FeaturePcdGet (PcdMmLoadImageAtLinkedAddress) &&
+      (ImageContext.ImageAddress != 0) &&
+      ((ImageContext.ImageAddress & (MAX (ImageContext.SectionAlignment, EFI_PAGE_SIZE) - 1)) == 0))
+  {
+    PageCount = (UINTN)EFI_SIZE_TO_PAGES ((UINTN)ImageContext.ImageSize);
+    DstBuffer = ImageContext.ImageAddress;
+
+    Status = MmAllocatePages (
+               AllocateAddress,
+               EfiRuntimeServicesCode,
+               PageCount,
+               &DstBuffer
+               );
+  }
+
   if (EFI_ERROR (Status)) {
-    return Status;
+    PageCount = (UINTN)EFI_SIZE_TO_PAGES ((UINTN)ImageContext.ImageSize + ImageContext.SectionAlignment);
+    DstBuffer = (UINTN)(-1);
+
+    Status = MmAllocatePages (
+               AllocateMaxAddress,
+               EfiRuntimeServicesCode,
+               PageCount,
+               &DstBuffer
+               );
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
   }
 
   ImageContext.ImageAddress = (EFI_PHYSICAL_ADDRESS)DstBuffer;
@@ -25,6 +25,7 @@ typedef struct {
 
   EFI_GUID      HandlerType; // Type of interrupt
   LIST_ENTRY    MmiHandlers; // All handlers
+  LIST_ENTRY    HashLink;    // Link on the MMI entry hash list of HandlerType
 } MMI_ENTRY;
 
 #define MMI_HANDLER_SIGNATURE  SIGNATURE_32('m','m','i','h')
@@ -45,6 +46,22 @@ UINTN  mMmiManageCallingDepth = 0;
 LIST_ENTRY  mRootMmiHandlerList = INITIALIZE_LIST_HEAD_VARIABLE (mRootMmiHandlerList);
 LIST_ENTRY  mMmiEntryList       = INITIALIZE_LIST_HEAD_VARIABLE (mMmiEntryList);
 
+//
+// The MMI entries are also linked on one of MMI_ENTRY_HASH_SIZE lists, picked
+// by the first 32 bits of their GUID, so that finding the entry of an MMI
+// does not walk all of them.
+//
+#define MMI_ENTRY_HASH_SIZE  64
+
+LIST_ENTRY  mMmiEntryHash[MMI_ENTRY_HASH_SIZE];
+BOOLEAN     mMmiEntryHashInitialized = FALSE;
+
+//
+// mMmiHandlerToRemove is set when MmiHandlerUnRegister() defers the removal of
+// a handler to MmiManage().
+//
+BOOLEAN  mMmiHandlerToRemove = FALSE;
+
 /**
   Remove MmiHandler and free the memory it used.
   If MmiEntry is empty, remove MmiEntry and free the memory it used.
@@ -71,6 +88,7 @@ RemoveMmiHandler (
   if (MmiEntry != NULL) {
     if (IsListEmpty (&MmiEntry->MmiHandlers)) {
       RemoveEntryList (&MmiEntry->AllEntries);
+      RemoveEntryList (&MmiEntry->HashLink);
       FreePool (MmiEntry);
       return TRUE;
     }
@@ -79,6 +97,32 @@ RemoveMmiHandler (
   return FALSE;
 }
 
+/**
+  Returns the MMI entry hash list of a handler type.
+
+  @param  HandlerType            The type of the interrupt
+
+  @return The MMI entry hash list.
+
+**/
+LIST_ENTRY *
+MmCoreGetMmiEntryHashList (
+  IN EFI_GUID  *HandlerType
+  )
+{
+  UINTN  Index;
+
+  if (!mMmiEntryHashInitialized) {
+    for (Index = 0; Index < MMI_ENTRY_HASH_SIZE; Index++) {
+      InitializeListHead (&mMmiEntryHash[Index]);
+    }
+
+    mMmiEntryHashInitialized = TRUE;
+  }
+
+  return &mMmiEntryHash[ReadUnaligned32 ((UINT32 *)HandlerType) % MMI_ENTRY_HASH_SIZE];
+}
+
 /**
   Finds the MMI entry for the requested handler type.
 
@@ -96,18 +140,20 @@ MmCoreFindMmiEntry (
   )
 {
   LIST_ENTRY  *Link;
+  LIST_ENTRY  *HashList;
   MMI_ENTRY   *Item;
   MMI_ENTRY   *MmiEntry;
 
   //
-  // Search the MMI entry list for the matching GUID
+  // Search the MMI entry hash list for the matching GUID
   //
   MmiEntry = NULL;
-  for (Link = mMmiEntryList.ForwardLink;
-       Link != &mMmiEntryList;
+  HashList = MmCoreGetMmiEntryHashList (HandlerType);
+  for (Link = HashList->ForwardLink;
+       Link != HashList;
        Link = Link->ForwardLink)
   {
-    Item = CR (Link, MMI_ENTRY, AllEntries, MMI_ENTRY_SIGNATURE);
+    Item = CR (Link, MMI_ENTRY, HashLink, MMI_ENTRY_SIGNATURE);
     if (CompareGuid (&Item->HandlerType, HandlerType)) {
       //
       // This is the MMI entry
@@ -132,9 +178,10 @@ MmCoreFindMmiEntry (
       InitializeListHead (&MmiEntry->MmiHandlers);
 
       //
-      // Add it to MMI entry list
+      // Add it to MMI entry list and hash list
       //
       InsertTailList (&mMmiEntryList, &MmiEntry->AllEntries);
+      InsertTailList (HashList, &MmiEntry->HashLink);
     }
   }
 
@@ -283,7 +330,9 @@ MmiManage (
   // marked as ToRemove.
   // Note that MmiManage can be called recursively.
   //
-  if (mMmiManageCallingDepth == 0) {
+  if ((mMmiManageCallingDepth == 0) && mMmiHandlerToRemove) {
+    mMmiHandlerToRemove = FALSE;
+
     //
     // Go through all MmiHandler in root Mmi handlers
     //
@@ -436,6 +485,7 @@ MmiHandlerUnRegister (
     // This function is called from MmiManage()
     // Do not delete or remove MmiHandler or MmiEntry now.
     //
+    mMmiHandlerToRemove = TRUE;
     return EFI_SUCCESS;
   }
 
@@ -21,6 +21,13 @@ BOOLEAN     mIsFlushingGCD;
 BOOLEAN     mIsAllocatingPageTable = FALSE;
 UINT64      mTimerPeriod           = 0;
 
+//
+// Nesting depth of the cache attribute batches, and the MTRR settings that
+// the batch changes are recorded in.
+//
+UINTN          mCacheAttributeBatchDepth = 0;
+MTRR_SETTINGS  mCacheAttributeBatchMtrrs;
+
 EFI_CPU_ARCH_PROTOCOL  gCpu = {
   CpuFlushCpuDataCache,
   CpuEnableInterrupt,
@@ -281,6 +288,107 @@ SetMtrrsFromBuffer (
   MtrrSetAllMtrrs (Buffer);
 }
 
+/**
+  Program the MTRRs of all APs with the MTRR settings of the BSP.
+
+  @param[in] MtrrSettings  The MTRR settings of the BSP.
+**/
+STATIC
+VOID
+SyncMtrrsWithAllAps (
+  IN MTRR_SETTINGS  *MtrrSettings
+  )
+{
+  EFI_STATUS                MpStatus;
+  EFI_MP_SERVICES_PROTOCOL  *MpService;
+
+  MpStatus = gBS->LocateProtocol (
+                    &gEfiMpServiceProtocolGuid,
+                    NULL,
+                    (VOID **)&MpService
+                    );
+  if (!EFI_ERROR (MpStatus)) {
+    MpStatus = MpService->StartupAllAPs (
+                            MpService,          // This
+                            SetMtrrsFromBuffer, // Procedure
+                            FALSE,              // SingleThread
+                            NULL,               // WaitEvent
+                            0,                  // TimeoutInMicrosecsond
+                            MtrrSettings,       // ProcedureArgument
+                            NULL                // FailedCpuList
+                            );
+    ASSERT (MpStatus == EFI_SUCCESS || MpStatus == EFI_NOT_STARTED);
+  }
+}
+
+/**
+  Start a batch of cache attribute changes.
+
+  @param[in]  This              The EDKII_CPU_CACHE_ATTRIBUTE_BATCH_PROTOCOL instance.
+
+  @retval EFI_SUCCESS           The batch was started.
+  @retval EFI_UNSUPPORTED       The processor does not support MTRRs.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+CpuCacheAttributeBatchBegin (
+  IN EDKII_CPU_CACHE_ATTRIBUTE_BATCH_PROTOCOL  *This
+  )
+{
+  if (!IsMtrrSupported ()) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (mCacheAttributeBatchDepth == 0) {
+    MtrrGetAllMtrrs (&mCacheAttributeBatchMtrrs);
+  }
+
+  mCacheAttributeBatchDepth++;
+  return EFI_SUCCESS;
+}
+
+/**
+  End a batch of cache attribute changes. The changes are applied to all
+  processors when the outermost batch ends.
+
+  @param[in]  This              The EDKII_CPU_CACHE_ATTRIBUTE_BATCH_PROTOCOL instance.
+
+  @retval EFI_SUCCESS           The batch ended.
+  @retval EFI_NOT_STARTED       No batch was started.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+CpuCacheAttributeBatchEnd (
+  IN EDKII_CPU_CACHE_ATTRIBUTE_BATCH_PROTOCOL  *This
+  )
+{
+  MTRR_SETTINGS  MtrrSettings;
+
+  if (mCacheAttributeBatchDepth == 0) {
+    return EFI_NOT_STARTED;
+  }
+
+  mCacheAttributeBatchDepth--;
+  if (mCacheAttributeBatchDepth != 0) {
+    return EFI_SUCCESS;
+  }
+
+  MtrrGetAllMtrrs (&MtrrSettings);
+  if (CompareMem (&MtrrSettings, &mCacheAttributeBatchMtrrs, sizeof (MtrrSettings)) != 0) {
+    MtrrSetAllMtrrs (&mCacheAttributeBatchMtrrs);
+    SyncMtrrsWithAllAps (&mCacheAttributeBatchMtrrs);
+  }
+
+  return EFI_SUCCESS;
+}
+
+EDKII_CPU_CACHE_ATTRIBUTE_BATCH_PROTOCOL  mCpuCacheAttributeBatch = {
+  CpuCacheAttributeBatchBegin,
+  CpuCacheAttributeBatchEnd
+};
+
 /**
   Implementation of SetMemoryAttributes() service of CPU Architecture Protocol.
 
@@ -315,14 +423,12 @@ CpuSetMemoryAttributes (
   IN UINT64                 Attributes
   )
 {
-  RETURN_STATUS             Status;
-  MTRR_MEMORY_CACHE_TYPE    CacheType;
-  EFI_STATUS                MpStatus;
-  EFI_MP_SERVICES_PROTOCOL  *MpService;
-  MTRR_SETTINGS             MtrrSettings;
-  UINT64                    CacheAttributes;
-  UINT64                    MemoryAttributes;
-  MTRR_MEMORY_CACHE_TYPE    CurrentCacheType;
+  RETURN_STATUS           Status;
+  MTRR_MEMORY_CACHE_TYPE  CacheType;
+  MTRR_SETTINGS           MtrrSettings;
+  UINT64                  CacheAttributes;
+  UINT64                  MemoryAttributes;
+  MTRR_MEMORY_CACHE_TYPE  CurrentCacheType;
 
   //
   // If this function is called because GCD SetMemorySpaceAttributes () is called
@@ -387,43 +493,42 @@ CpuSetMemoryAttributes (
         return EFI_INVALID_PARAMETER;
     }
 
-    CurrentCacheType = MtrrGetMemoryAttribute (BaseAddress);
-    if (CurrentCacheType != CacheType) {
+    if (mCacheAttributeBatchDepth != 0) {
       //
-      // call MTRR library function
+      // Only record the change, the MTRRs are programmed when the batch ends.
       //
-      Status = MtrrSetMemoryAttribute (
+      Status = MtrrSetMemoryAttributeInMtrrSettings (
+                 &mCacheAttributeBatchMtrrs,
                  BaseAddress,
                  Length,
                  CacheType
                  );
-
-      if (!RETURN_ERROR (Status)) {
-        MpStatus = gBS->LocateProtocol (
-                          &gEfiMpServiceProtocolGuid,
-                          NULL,
-                          (VOID **)&MpService
-                          );
+      if (RETURN_ERROR (Status)) {
+        return Status;
+      }
+    } else {
+      CurrentCacheType = MtrrGetMemoryAttribute (BaseAddress);
+      if (CurrentCacheType != CacheType) {
         //
-        // Synchronize the update with all APs
+        // call MTRR library function
         //
-        if (!EFI_ERROR (MpStatus)) {
+        Status = MtrrSetMemoryAttribute (
+                   BaseAddress,
+                   Length,
+                   CacheType
+                   );
+
+        if (!RETURN_ERROR (Status)) {
+          //
+          // Synchronize the update with all APs
+          //
           MtrrGetAllMtrrs (&MtrrSettings);
-          MpStatus = MpService->StartupAllAPs (
-                                  MpService,          // This
-                                  SetMtrrsFromBuffer, // Procedure
-                                  FALSE,              // SingleThread
-                                  NULL,               // WaitEvent
-                                  0,                  // TimeoutInMicrosecsond
-                                  &MtrrSettings,      // ProcedureArgument
-                                  NULL                // FailedCpuList
-                                  );
-          ASSERT (MpStatus == EFI_SUCCESS || MpStatus == EFI_NOT_STARTED);
+          SyncMtrrsWithAllAps (&MtrrSettings);
         }
-      }
 
-      if (EFI_ERROR (Status)) {
-        return Status;
+        if (EFI_ERROR (Status)) {
+          return Status;
+        }
       }
     }
   }
@@ -1029,6 +1134,8 @@ InitializeCpu (
                   &mCpuHandle,
                   &gEfiCpuArchProtocolGuid,
                   &gCpu,
+                  &gEdkiiCpuCacheAttributeBatchProtocolGuid,
+                  &mCpuCacheAttributeBatch,
                   NULL
                   );
   ASSERT_EFI_ERROR (Status);
@@ -117,6 +117,52 @@ typedef struct {
   IA32_MAP_ATTRIBUTE    Attribute;
 } IA32_MAP_ENTRY;
 
+/**
+  Create or update page table to map multiple linear address ranges with their attributes.
+
+  All ranges are mapped in one call, so that the caller allocates the page table buffer and flushes the TLB
+  once instead of once per range. The ranges are mapped in the order of Map, sorting them by linear address
+  lets neighbouring ranges reuse the page tables created for the previous one.
+
+  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
+                                 If not pointer to NULL, the value it points to won't be changed in this function.
+  @param[in]      PagingMode     The paging mode.
+  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
+  @param[in, out] BufferSize     The buffer size.
+                                 On return, the remaining buffer size.
+                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
+                                 BufferSize in the second call to this API.
+  @param[in]      Map            The linear address ranges and their attributes.
+                                 All non-reserved fields in IA32_MAP_ATTRIBUTE are supported to set in the page table.
+  @param[in]      MapCount       The number of entries in Map.
+  @param[in]      Mask           The mask used for the attribute of every range. The corresponding field in an attribute is
+                                 ignored if that in Mask is 0.
+  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
+                                 If the output IsModified is FALSE, there is possibility that the page table is changed by hardware. It is ok
+                                 because page table can be changed by hardware anytime, and caller don't need to Flush TLB.
+
+  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
+  @retval RETURN_INVALID_PARAMETER  PageTable, BufferSize or Mask is NULL, or Map is NULL while MapCount is not 0.
+  @retval RETURN_INVALID_PARAMETER  A range of Map is not valid for PageTableMap().
+  @retval RETURN_INVALID_PARAMETER  *BufferSize is not multiple of 4KB.
+  @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
+                                    BufferSize is updated to indicate the expected buffer size, which may be larger than
+                                    the size that is finally used when several ranges share a new page table.
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully or MapCount is 0.
+**/
+RETURN_STATUS
+EFIAPI
+PageTableMapRanges (
+  IN OUT UINTN               *PageTable  OPTIONAL,
+  IN     PAGING_MODE         PagingMode,
+  IN     VOID                *Buffer,
+  IN OUT UINTN               *BufferSize,
+  IN     IA32_MAP_ENTRY      *Map,
+  IN     UINTN               MapCount,
+  IN     IA32_MAP_ATTRIBUTE  *Mask,
+  OUT    BOOLEAN             *IsModified   OPTIONAL
+  );
+
 /**
   Parse page table.
 
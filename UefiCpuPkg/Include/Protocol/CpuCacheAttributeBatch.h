@@ -0,0 +1,70 @@
+/** @file
+  EDKII CPU Cache Attribute Batch Protocol definition.
+
+  The protocol is produced by the CPU driver. It lets a driver that changes the
+  cache attributes of many memory ranges, for example with
+  gDS->SetMemorySpaceAttributes(), have all the MTRR changes applied at once.
+  Each change otherwise disables and flushes the caches of all processors.
+
+  Copyright (c) 2024, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef CPU_CACHE_ATTRIBUTE_BATCH_H_
+#define CPU_CACHE_ATTRIBUTE_BATCH_H_
+
+#define EDKII_CPU_CACHE_ATTRIBUTE_BATCH_PROTOCOL_GUID \
+  { \
+    0xd11b3ed9, 0x59f4, 0x42c3, { 0xb0, 0x01, 0x9e, 0x5f, 0x5e, 0x39, 0xce, 0x42 } \
+  }
+
+typedef struct _EDKII_CPU_CACHE_ATTRIBUTE_BATCH_PROTOCOL EDKII_CPU_CACHE_ATTRIBUTE_BATCH_PROTOCOL;
+
+/**
+  Start a batch of cache attribute changes.
+
+  Until the batch ends, the cache attribute changes made through
+  EFI_CPU_ARCH_PROTOCOL.SetMemoryAttributes() are checked and recorded, but
+  the MTRRs of the processors are not programmed. The other memory attributes
+  are applied immediately. Batches may be nested, the changes are applied when
+  the outermost batch ends.
+
+  @param[in]  This              The EDKII_CPU_CACHE_ATTRIBUTE_BATCH_PROTOCOL instance.
+
+  @retval EFI_SUCCESS           The batch was started.
+  @retval EFI_UNSUPPORTED       The processor does not support MTRRs.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_CPU_CACHE_ATTRIBUTE_BATCH_BEGIN)(
+  IN EDKII_CPU_CACHE_ATTRIBUTE_BATCH_PROTOCOL  *This
+  );
+
+/**
+  End a batch of cache attribute changes.
+
+  When the outermost batch ends, the MTRRs of all processors are programmed
+  with the recorded changes, with one cache flush per processor.
+
+  @param[in]  This              The EDKII_CPU_CACHE_ATTRIBUTE_BATCH_PROTOCOL instance.
+
+  @retval EFI_SUCCESS           The batch ended.
+  @retval EFI_NOT_STARTED       No batch was started.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_CPU_CACHE_ATTRIBUTE_BATCH_END)(
+  IN EDKII_CPU_CACHE_ATTRIBUTE_BATCH_PROTOCOL  *This
+  );
+
+struct _EDKII_CPU_CACHE_ATTRIBUTE_BATCH_PROTOCOL {
+  EDKII_CPU_CACHE_ATTRIBUTE_BATCH_BEGIN    Begin;
+  EDKII_CPU_CACHE_ATTRIBUTE_BATCH_END      End;
+};
+
+extern EFI_GUID  gEdkiiCpuCacheAttributeBatchProtocolGuid;
+
+#endif
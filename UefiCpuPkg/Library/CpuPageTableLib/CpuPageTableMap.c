@@ -648,51 +648,37 @@ PageTableLibMapInLevel (
 }
 
 /**
-  Create or update page table to map [LinearAddress, LinearAddress + Length) with specified attribute.
+  Create or update page table to map the linear address ranges in Map with their attributes.
+
+  The ranges are mapped in the order of Map. The required buffer size is computed for all the ranges
+  before any of them is mapped.
 
   @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
-                                 If not pointer to NULL, the value it points to won't be changed in this function.
   @param[in]      PagingMode     The paging mode.
   @param[in]      Buffer         The free buffer to be used for page table creation/updating.
-  @param[in, out] BufferSize     The buffer size.
-                                 On return, the remaining buffer size.
-                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
-                                 BufferSize in the second call to this API.
-  @param[in]      LinearAddress  The start of the linear address range.
-  @param[in]      Length         The length of the linear address range.
-  @param[in]      Attribute      The attribute of the linear address range.
-                                 All non-reserved fields in IA32_MAP_ATTRIBUTE are supported to set in the page table.
-                                 Page table entries that map the linear address range are reset to 0 before set to the new attribute
-                                 when a new physical base address is set.
-  @param[in]      Mask           The mask used for attribute. The corresponding field in Attribute is ignored if that in Mask is 0.
-  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
-                                 If the output IsModified is FALSE, there is possibility that the page table is changed by hardware. It is ok
-                                 because page table can be changed by hardware anytime, and caller don't need to Flush TLB.
+  @param[in, out] BufferSize     The buffer size. On return, the remaining buffer size.
+  @param[in]      Map            The linear address ranges and their attributes.
+  @param[in]      MapCount       The number of entries in Map.
+  @param[in]      Mask           The mask used for the attribute of every range.
+  @param[out]     IsModified     TRUE means page table is modified by software or hardware.
 
   @retval RETURN_UNSUPPORTED        PagingMode is not supported.
-  @retval RETURN_INVALID_PARAMETER  PageTable, BufferSize, Attribute or Mask is NULL.
-  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 0 but some other attributes are provided.
-  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 1 but some other attributes are not provided.
-  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
-  @retval RETURN_INVALID_PARAMETER  For present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
-  @retval RETURN_INVALID_PARAMETER  *BufferSize is not multiple of 4KB.
+  @retval RETURN_INVALID_PARAMETER  A parameter or a range is invalid.
   @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
                                     BufferSize is updated to indicate the expected buffer size.
-                                    Caller may still get RETURN_BUFFER_TOO_SMALL with the new BufferSize.
-  @retval RETURN_SUCCESS            PageTable is created/updated successfully or the input Length is 0.
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully.
 **/
+STATIC
 RETURN_STATUS
-EFIAPI
-PageTableMap (
-  IN OUT UINTN               *PageTable  OPTIONAL,
+PageTableLibMapRanges (
+  IN OUT UINTN               *PageTable,
   IN     PAGING_MODE         PagingMode,
   IN     VOID                *Buffer,
   IN OUT UINTN               *BufferSize,
-  IN     UINT64              LinearAddress,
-  IN     UINT64              Length,
-  IN     IA32_MAP_ATTRIBUTE  *Attribute,
+  IN     IA32_MAP_ENTRY      *Map,
+  IN     UINTN               MapCount,
   IN     IA32_MAP_ATTRIBUTE  *Mask,
-  OUT    BOOLEAN             *IsModified   OPTIONAL
+  OUT    BOOLEAN             *IsModified
   )
 {
   RETURN_STATUS       Status;
@@ -702,15 +688,11 @@ PageTableMap (
   IA32_PAGE_LEVEL     MaxLevel;
   IA32_PAGE_LEVEL     MaxLeafLevel;
   IA32_MAP_ATTRIBUTE  ParentAttribute;
-  BOOLEAN             LocalIsModified;
   UINTN               Index;
+  UINTN               MapIndex;
   IA32_PAGING_ENTRY   *PagingEntry;
   UINT8               BufferInStack[SIZE_4KB - 1 + MAX_PAE_PDPTE_NUM * sizeof (IA32_PAGING_ENTRY)];
 
-  if (Length == 0) {
-    return RETURN_SUCCESS;
-  }
-
   if ((PagingMode == Paging32bit) || (PagingMode >= PagingModeMax)) {
     //
     // 32bit paging is never supported.
@@ -718,10 +700,6 @@ PageTableMap (
     return RETURN_UNSUPPORTED;
   }
 
-  if ((PageTable == NULL) || (BufferSize == NULL) || (Attribute == NULL) || (Mask == NULL)) {
-    return RETURN_INVALID_PARAMETER;
-  }
-
   if (*BufferSize % SIZE_4KB != 0) {
     //
     // BufferSize should be multiple of 4K.
@@ -729,34 +707,36 @@ PageTableMap (
     return RETURN_INVALID_PARAMETER;
   }
 
-  if (((UINTN)LinearAddress % SIZE_4KB != 0) || ((UINTN)Length % SIZE_4KB != 0)) {
-    //
-    // LinearAddress and Length should be multiple of 4K.
-    //
-    return RETURN_INVALID_PARAMETER;
-  }
-
   if ((*BufferSize != 0) && (Buffer == NULL)) {
     return RETURN_INVALID_PARAMETER;
   }
 
-  //
-  // If to map [LinearAddress, LinearAddress + Length] as non-present,
-  // all attributes except Present should not be provided.
-  //
-  if ((Attribute->Bits.Present == 0) && (Mask->Bits.Present == 1) && (Mask->Uint64 > 1)) {
-    return RETURN_INVALID_PARAMETER;
-  }
-
   MaxLeafLevel     = (IA32_PAGE_LEVEL)(UINT8)PagingMode;
   MaxLevel         = (IA32_PAGE_LEVEL)(UINT8)(PagingMode >> 8);
   MaxLinearAddress = (PagingMode == PagingPae) ? LShiftU64 (1, 32) : LShiftU64 (1, 12 + MaxLevel * 9);
 
-  if ((LinearAddress > MaxLinearAddress) || (Length > MaxLinearAddress - LinearAddress)) {
+  for (MapIndex = 0; MapIndex < MapCount; MapIndex++) {
+    if (((UINTN)Map[MapIndex].LinearAddress % SIZE_4KB != 0) || ((UINTN)Map[MapIndex].Length % SIZE_4KB != 0)) {
+      //
+      // LinearAddress and Length should be multiple of 4K.
+      //
+      return RETURN_INVALID_PARAMETER;
+    }
+
     //
-    // Maximum linear address is (1 << 32), (1 << 48) or (1 << 57)
+    // If to map [LinearAddress, LinearAddress + Length] as non-present,
+    // all attributes except Present should not be provided.
     //
-    return RETURN_INVALID_PARAMETER;
+    if ((Map[MapIndex].Attribute.Bits.Present == 0) && (Mask->Bits.Present == 1) && (Mask->Uint64 > 1)) {
+      return RETURN_INVALID_PARAMETER;
+    }
+
+    if ((Map[MapIndex].LinearAddress > MaxLinearAddress) || (Map[MapIndex].Length > MaxLinearAddress - Map[MapIndex].LinearAddress)) {
+      //
+      // Maximum linear address is (1 << 32), (1 << 48) or (1 << 57)
+      //
+      return RETURN_INVALID_PARAMETER;
+    }
   }
 
   TopPagingEntry.Uintn = *PageTable;
@@ -782,10 +762,6 @@ PageTableMap (
     TopPagingEntry.Pce.Nx             = 0;
   }
 
-  if (IsModified == NULL) {
-    IsModified = &LocalIsModified;
-  }
-
   *IsModified = FALSE;
 
   ParentAttribute.Uint64                       = 0;
@@ -797,26 +773,34 @@ PageTableMap (
 
   //
   // Query the required buffer size without modifying the page table.
+  // Each range is queried against the original page table, so the sum is an upper bound when
+  // several ranges need the same new page table.
   //
   RequiredSize = 0;
-  Status       = PageTableLibMapInLevel (
-                   &TopPagingEntry,
-                   &ParentAttribute,
-                   FALSE,
-                   NULL,
-                   &RequiredSize,
-                   MaxLevel,
-                   MaxLeafLevel,
-                   LinearAddress,
-                   Length,
-                   0,
-                   Attribute,
-                   Mask,
-                   IsModified
-                   );
-  ASSERT (*IsModified == FALSE);
-  if (RETURN_ERROR (Status)) {
-    return Status;
+  for (MapIndex = 0; MapIndex < MapCount; MapIndex++) {
+    if (Map[MapIndex].Length == 0) {
+      continue;
+    }
+
+    Status = PageTableLibMapInLevel (
+               &TopPagingEntry,
+               &ParentAttribute,
+               FALSE,
+               NULL,
+               &RequiredSize,
+               MaxLevel,
+               MaxLeafLevel,
+               Map[MapIndex].LinearAddress,
+               Map[MapIndex].Length,
+               0,
+               &Map[MapIndex].Attribute,
+               Mask,
+               IsModified
+               );
+    ASSERT (*IsModified == FALSE);
+    if (RETURN_ERROR (Status)) {
+      return Status;
+    }
   }
 
   RequiredSize = -RequiredSize;
@@ -833,23 +817,33 @@ PageTableMap (
   //
   // Update the page table when the supplied buffer is sufficient.
   //
-  Status = PageTableLibMapInLevel (
-             &TopPagingEntry,
-             &ParentAttribute,
-             TRUE,
-             Buffer,
-             (INTN *)BufferSize,
-             MaxLevel,
-             MaxLeafLevel,
-             LinearAddress,
-             Length,
-             0,
-             Attribute,
-             Mask,
-             IsModified
-             );
-
-  if (!RETURN_ERROR (Status)) {
+  Status = RETURN_SUCCESS;
+  for (MapIndex = 0; MapIndex < MapCount; MapIndex++) {
+    if (Map[MapIndex].Length == 0) {
+      continue;
+    }
+
+    Status = PageTableLibMapInLevel (
+               &TopPagingEntry,
+               &ParentAttribute,
+               TRUE,
+               Buffer,
+               (INTN *)BufferSize,
+               MaxLevel,
+               MaxLeafLevel,
+               Map[MapIndex].LinearAddress,
+               Map[MapIndex].Length,
+               0,
+               &Map[MapIndex].Attribute,
+               Mask,
+               IsModified
+               );
+    if (RETURN_ERROR (Status)) {
+      break;
+    }
+  }
+
+  if (!RETURN_ERROR (Status) && (TopPagingEntry.Uintn != 0)) {
     PagingEntry = (IA32_PAGING_ENTRY *)(UINTN)(TopPagingEntry.Uintn & IA32_PE_BASE_ADDRESS_MASK_40);
 
     if (PagingMode == PagingPae) {
@@ -881,3 +875,143 @@ PageTableMap (
 
   return Status;
 }
+
+/**
+  Create or update page table to map [LinearAddress, LinearAddress + Length) with specified attribute.
+
+  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
+                                 If not pointer to NULL, the value it points to won't be changed in this function.
+  @param[in]      PagingMode     The paging mode.
+  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
+  @param[in, out] BufferSize     The buffer size.
+                                 On return, the remaining buffer size.
+                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
+                                 BufferSize in the second call to this API.
+  @param[in]      LinearAddress  The start of the linear address range.
+  @param[in]      Length         The length of the linear address range.
+  @param[in]      Attribute      The attribute of the linear address range.
+                                 All non-reserved fields in IA32_MAP_ATTRIBUTE are supported to set in the page table.
+                                 Page table entries that map the linear address range are reset to 0 before set to the new attribute
+                                 when a new physical base address is set.
+  @param[in]      Mask           The mask used for attribute. The corresponding field in Attribute is ignored if that in Mask is 0.
+  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
+                                 If the output IsModified is FALSE, there is possibility that the page table is changed by hardware. It is ok
+                                 because page table can be changed by hardware anytime, and caller don't need to Flush TLB.
+
+  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
+  @retval RETURN_INVALID_PARAMETER  PageTable, BufferSize, Attribute or Mask is NULL.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 1 but some other attributes are not provided.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  For present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  *BufferSize is not multiple of 4KB.
+  @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
+                                    BufferSize is updated to indicate the expected buffer size.
+                                    Caller may still get RETURN_BUFFER_TOO_SMALL with the new BufferSize.
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully or the input Length is 0.
+**/
+RETURN_STATUS
+EFIAPI
+PageTableMap (
+  IN OUT UINTN               *PageTable  OPTIONAL,
+  IN     PAGING_MODE         PagingMode,
+  IN     VOID                *Buffer,
+  IN OUT UINTN               *BufferSize,
+  IN     UINT64              LinearAddress,
+  IN     UINT64              Length,
+  IN     IA32_MAP_ATTRIBUTE  *Attribute,
+  IN     IA32_MAP_ATTRIBUTE  *Mask,
+  OUT    BOOLEAN             *IsModified   OPTIONAL
+  )
+{
+  IA32_MAP_ENTRY  Map;
+  BOOLEAN         LocalIsModified;
+
+  if (Length == 0) {
+    return RETURN_SUCCESS;
+  }
+
+  if ((PagingMode == Paging32bit) || (PagingMode >= PagingModeMax)) {
+    //
+    // 32bit paging is never supported.
+    //
+    return RETURN_UNSUPPORTED;
+  }
+
+  if ((PageTable == NULL) || (BufferSize == NULL) || (Attribute == NULL) || (Mask == NULL)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  if (IsModified == NULL) {
+    IsModified = &LocalIsModified;
+  }
+
+  Map.LinearAddress    = LinearAddress;
+  Map.Length           = Length;
+  Map.Attribute.Uint64 = Attribute->Uint64;
+
+  return PageTableLibMapRanges (PageTable, PagingMode, Buffer, BufferSize, &Map, 1, Mask, IsModified);
+}
+
+/**
+  Create or update page table to map multiple linear address ranges with their attributes.
+
+  All ranges are mapped in one call, so that the caller allocates the page table buffer and flushes the TLB
+  once instead of once per range. The ranges are mapped in the order of Map, sorting them by linear address
+  lets neighbouring ranges reuse the page tables created for the previous one.
+
+  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
+                                 If not pointer to NULL, the value it points to won't be changed in this function.
+  @param[in]      PagingMode     The paging mode.
+  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
+  @param[in, out] BufferSize     The buffer size.
+                                 On return, the remaining buffer size.
+                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
+                                 BufferSize in the second call to this API.
+  @param[in]      Map            The linear address ranges and their attributes.
+                                 All non-reserved fields in IA32_MAP_ATTRIBUTE are supported to set in the page table.
+  @param[in]      MapCount       The number of entries in Map.
+  @param[in]      Mask           The mask used for the attribute of every range. The corresponding field in an attribute is
+                                 ignored if that in Mask is 0.
+  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
+                                 If the output IsModified is FALSE, there is possibility that the page table is changed by hardware. It is ok
+                                 because page table can be changed by hardware anytime, and caller don't need to Flush TLB.
+
+  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
+  @retval RETURN_INVALID_PARAMETER  PageTable, BufferSize or Mask is NULL, or Map is NULL while MapCount is not 0.
+  @retval RETURN_INVALID_PARAMETER  A range of Map is not valid for PageTableMap().
+  @retval RETURN_INVALID_PARAMETER  *BufferSize is not multiple of 4KB.
+  @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
+                                    BufferSize is updated to indicate the expected buffer size, which may be larger than
+                                    the size that is finally used when several ranges share a new page table.
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully or MapCount is 0.
+**/
+RETURN_STATUS
+EFIAPI
+PageTableMapRanges (
+  IN OUT UINTN               *PageTable  OPTIONAL,
+  IN     PAGING_MODE         PagingMode,
+  IN     VOID                *Buffer,
+  IN OUT UINTN               *BufferSize,
+  IN     IA32_MAP_ENTRY      *Map,
+  IN     UINTN               MapCount,
+  IN     IA32_MAP_ATTRIBUTE  *Mask,
+  OUT    BOOLEAN             *IsModified   OPTIONAL
+  )
+{
+  BOOLEAN  LocalIsModified;
+
+  if (MapCount == 0) {
+    return RETURN_SUCCESS;
+  }
+
+  if ((PageTable == NULL) || (BufferSize == NULL) || (Map == NULL) || (Mask == NULL)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  if (IsModified == NULL) {
+    IsModified = &LocalIsModified;
+  }
+
+  return PageTableLibMapRanges (PageTable, PagingMode, Buffer, BufferSize, Map, MapCount, Mask, IsModified);
+}
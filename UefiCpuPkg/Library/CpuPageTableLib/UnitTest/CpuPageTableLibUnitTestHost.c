@@ -821,6 +821,121 @@ TestCaseToCheckMapMaskAndAttr (
   return UNIT_TEST_PASSED;
 }
 
+/**
+  Check that multiple ranges are mapped with their own attributes in one call
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestCaseMapRanges (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN               PageTable;
+  PAGING_MODE         PagingMode;
+  VOID                *Buffer;
+  UINTN               PageTableBufferSize;
+  IA32_MAP_ATTRIBUTE  MapAttribute;
+  IA32_MAP_ATTRIBUTE  MapMask;
+  IA32_MAP_ENTRY      Ranges[3];
+  IA32_MAP_ENTRY      *Map;
+  UINTN               MapCount;
+  UINTN               Index;
+  BOOLEAN             IsModified;
+  RETURN_STATUS       Status;
+  UNIT_TEST_STATUS    TestStatus;
+
+  PagingMode                  = Paging4Level;
+  PageTableBufferSize         = 0;
+  PageTable                   = 0;
+  Buffer                      = NULL;
+  MapAttribute.Uint64         = 0;
+  MapMask.Uint64              = MAX_UINT64;
+  MapAttribute.Bits.Present   = 1;
+  MapAttribute.Bits.ReadWrite = 1;
+
+  //
+  // Create Page table to cover [0,4M] with 2M pages
+  //
+  Status = PageTableMap (&PageTable, PagingMode, Buffer, &PageTableBufferSize, (UINT64)0, (UINT64)SIZE_2MB * 2, &MapAttribute, &MapMask, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  Buffer = AllocatePages (EFI_SIZE_TO_PAGES (PageTableBufferSize));
+  Status = PageTableMap (&PageTable, PagingMode, Buffer, &PageTableBufferSize, (UINT64)0, (UINT64)SIZE_2MB * 2, &MapAttribute, &MapMask, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+
+  //
+  // Map [4K,8K] and [12K,16K] read-only, and [2M,4M] again read-write, in one call.
+  // Only the read-write bit is changed.
+  //
+  MapMask.Uint64         = 0;
+  MapMask.Bits.ReadWrite = 1;
+  ZeroMem (Ranges, sizeof (Ranges));
+  Ranges[0].LinearAddress            = SIZE_4KB;
+  Ranges[0].Length                   = SIZE_4KB;
+  Ranges[1].LinearAddress            = SIZE_4KB * 3;
+  Ranges[1].Length                   = SIZE_4KB;
+  Ranges[2].LinearAddress            = SIZE_2MB;
+  Ranges[2].Length                   = SIZE_2MB;
+  Ranges[2].Attribute.Bits.ReadWrite = 1;
+
+  PageTableBufferSize = 0;
+  Status              = PageTableMapRanges (&PageTable, PagingMode, NULL, &PageTableBufferSize, Ranges, ARRAY_SIZE (Ranges), &MapMask, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  //
+  // Both read-only ranges are in the same 2M page, which is split once.
+  // The query is an upper bound, so it may count the split twice.
+  //
+  UT_ASSERT_TRUE (PageTableBufferSize >= SIZE_4KB);
+  UT_ASSERT_TRUE (PageTableBufferSize <= SIZE_4KB * 2);
+  Buffer = AllocatePages (EFI_SIZE_TO_PAGES (PageTableBufferSize));
+  Status = PageTableMapRanges (&PageTable, PagingMode, Buffer, &PageTableBufferSize, Ranges, ARRAY_SIZE (Ranges), &MapMask, &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (IsModified, TRUE);
+  TestStatus = IsPageTableValid (PageTable, PagingMode);
+  if (TestStatus != UNIT_TEST_PASSED) {
+    return TestStatus;
+  }
+
+  //
+  // The page table should now describe [0,4K] RW, [4K,8K] RO, [8K,12K] RW, [12K,16K] RO and [16K,4M] RW.
+  //
+  MapCount = 0;
+  Status   = PageTableParse (PageTable, PagingMode, NULL, &MapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  Map    = AllocatePages (EFI_SIZE_TO_PAGES (MapCount * sizeof (IA32_MAP_ENTRY)));
+  Status = PageTableParse (PageTable, PagingMode, Map, &MapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (MapCount, 5);
+  for (Index = 0; Index < MapCount; Index++) {
+    UT_ASSERT_EQUAL (Map[Index].Attribute.Bits.ReadWrite, (Index % 2 == 0) ? 1 : 0);
+  }
+
+  UT_ASSERT_EQUAL (Map[1].LinearAddress, SIZE_4KB);
+  UT_ASSERT_EQUAL (Map[3].LinearAddress, SIZE_4KB * 3);
+  UT_ASSERT_EQUAL (Map[4].LinearAddress + Map[4].Length, (UINT64)SIZE_2MB * 2);
+
+  //
+  // Mapping the same ranges again should change nothing.
+  //
+  PageTableBufferSize = 0;
+  Status              = PageTableMapRanges (&PageTable, PagingMode, NULL, &PageTableBufferSize, Ranges, ARRAY_SIZE (Ranges), &MapMask, &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (IsModified, FALSE);
+
+  return UNIT_TEST_PASSED;
+}
+
 /**
   Initialize the unit test framework, suite, and unit tests for the
   sample unit tests and run the unit tests.
@@ -872,6 +987,7 @@ UefiTestMain (
   AddTestCase (ManualTestCase, "Check if the parent entry has different Nx attribute", "Manual Test Case6", TestCaseManualChangeNx, NULL, NULL, NULL);
   AddTestCase (ManualTestCase, "Check if the needed size is expected", "Manual Test Case7", TestCaseManualSizeNotMatch, NULL, NULL, NULL);
   AddTestCase (ManualTestCase, "Check MapMask when creating new page table or mapping not-present range", "Manual Test Case8", TestCaseToCheckMapMaskAndAttr, NULL, NULL, NULL);
+  AddTestCase (ManualTestCase, "Check mapping multiple ranges in one call", "Manual Test Case9", TestCaseMapRanges, NULL, NULL, NULL);
   //
   // Populate the Random Test Cases.
   //
@@ -18,6 +18,7 @@
 #include <Register/Amd/Ghcb.h>
 
 #include <Protocol/Timer.h>
+#include <Guid/DxeCoreTrace.h>
 
 #define  AP_SAFE_STACK_SIZE  128
 
@@ -27,6 +28,11 @@ EFI_EVENT         mMpInitExitBootServicesEvent = NULL;
 EFI_EVENT         mLegacyBootEvent             = NULL;
 volatile BOOLEAN  mStopCheckAllApsStatus       = TRUE;
 
+//
+// DXE Core trace table that AP functions are recorded in, if it is installed
+//
+EDKII_DXE_CORE_TRACE_TABLE  *mApTraceTable = NULL;
+
 //
 // Begin wakeup buffer allocation below 0x88000
 //
@@ -47,6 +53,46 @@ EnableDebugAgent (
   InitializeDebugAgent (DEBUG_AGENT_INIT_DXE_AP, NULL, NULL);
 }
 
+/**
+  Record an AP function that has returned in the DXE Core trace table.
+
+  @param[in] ProcessorNumber  The handle number of the processor that ran Procedure.
+  @param[in] Procedure        The AP function.
+  @param[in] Parameter        The parameter passed to Procedure.
+  @param[in] StartCounter     The performance counter value at which Procedure was called.
+**/
+VOID
+TraceApProcedure (
+  IN UINTN             ProcessorNumber,
+  IN EFI_AP_PROCEDURE  Procedure,
+  IN VOID              *Parameter,
+  IN UINT64            StartCounter
+  )
+{
+  UINT64                       EndCounter;
+  UINT32                       Index;
+  EDKII_DXE_CORE_TRACE_RECORD  *Record;
+
+  if (mApTraceTable == NULL) {
+    return;
+  }
+
+  EndCounter = GetPerformanceCounter ();
+  Index      = InterlockedIncrement (&mApTraceTable->RecordCount) - 1;
+  if (Index >= mApTraceTable->MaxRecords) {
+    return;
+  }
+
+  Record            = (EDKII_DXE_CORE_TRACE_RECORD *)(mApTraceTable + 1) + Index;
+  Record->StartTime = GetTimeInNanoSecond (StartCounter);
+  Record->EndTime   = GetTimeInNanoSecond (EndCounter);
+  Record->Caller    = (UINT64)(UINTN)Procedure;
+  Record->Argument  = (UINT64)(UINTN)Parameter;
+  Record->Service   = EDKII_DXE_CORE_TRACE_AP_PROCEDURE;
+  Record->CpuIndex  = (UINT32)ProcessorNumber;
+  ZeroMem (&Record->Guid, sizeof (Record->Guid));
+}
+
 /**
   Get the pointer to CPU MP Data structure.
 
@@ -437,6 +483,11 @@ MpInitChangeApLoopCallback (
 {
   CPU_MP_DATA  *CpuMpData;
 
+  //
+  // The trace table is boot services data, stop recording into it.
+  //
+  mApTraceTable = NULL;
+
   CpuMpData                  = GetCpuMpData ();
   CpuMpData->PmCodeSegment   = GetProtectedModeCS ();
   CpuMpData->Pm16CodeSegment = GetProtectedMode16CS ();
@@ -482,6 +533,11 @@ InitMpGlobalData (
 
   SaveCpuMpData (CpuMpData);
 
+  Status = EfiGetSystemConfigurationTable (&gEdkiiDxeCoreTraceTableGuid, (VOID **)&mApTraceTable);
+  if (EFI_ERROR (Status)) {
+    mApTraceTable = NULL;
+  }
+
   if (CpuMpData->CpuCount == 1) {
     //
     // If only BSP exists, return
@@ -8,6 +8,64 @@
 
 #include "MpLib.h"
 
+/**
+  Find the entry of the microcode cache for the signature and platform ID of
+  the processor, or claim a new entry for them.
+
+  @param[in]   CpuMpData       The pointer to CPU MP Data structure.
+  @param[in]   MicrocodeCpuId  The signature and platform ID of the processor.
+  @param[out]  Claimed         TRUE if the processor claimed the entry. It
+                               then has to search the microcode patches and
+                               publish the result in the entry.
+
+  @return The entry, or NULL if there is no cache or it is full.
+**/
+STATIC
+MICROCODE_CACHE_ENTRY *
+GetMicrocodeCacheEntry (
+  IN  CPU_MP_DATA                 *CpuMpData,
+  IN  EDKII_PEI_MICROCODE_CPU_ID  *MicrocodeCpuId,
+  OUT BOOLEAN                     *Claimed
+  )
+{
+  MICROCODE_CACHE_ENTRY  *Entry;
+  UINT32                 Index;
+
+  *Claimed = FALSE;
+  Entry    = (MICROCODE_CACHE_ENTRY *)(UINTN)CpuMpData->MicrocodeCache;
+  for (Index = 0; Index < CpuMpData->MicrocodeCacheCount; Index++, Entry++) {
+    if ((Entry->State == MICROCODE_CACHE_EMPTY) &&
+        (InterlockedCompareExchange32 ((UINT32 *)&Entry->State, MICROCODE_CACHE_EMPTY, MICROCODE_CACHE_CLAIMED) == MICROCODE_CACHE_EMPTY))
+    {
+      Entry->ProcessorSignature = MicrocodeCpuId->ProcessorSignature;
+      Entry->PlatformId         = MicrocodeCpuId->PlatformId;
+      MemoryFence ();
+      Entry->State = MICROCODE_CACHE_SEARCHING;
+      *Claimed     = TRUE;
+      return Entry;
+    }
+
+    //
+    // Another processor claimed the entry, wait for it to set the key.
+    //
+    while (Entry->State == MICROCODE_CACHE_CLAIMED) {
+      CpuPause ();
+    }
+
+    if ((Entry->ProcessorSignature == MicrocodeCpuId->ProcessorSignature) &&
+        (Entry->PlatformId == MicrocodeCpuId->PlatformId))
+    {
+      while (Entry->State != MICROCODE_CACHE_READY) {
+        CpuPause ();
+      }
+
+      return Entry;
+    }
+  }
+
+  return NULL;
+}
+
 /**
   Detect whether specified processor can find matching microcode patch and load it.
 
@@ -29,6 +87,8 @@ MicrocodeDetect (
   CPU_MICROCODE_HEADER        *LatestMicrocode;
   UINT32                      ThreadId;
   EDKII_PEI_MICROCODE_CPU_ID  MicrocodeCpuId;
+  MICROCODE_CACHE_ENTRY       *Cache;
+  BOOLEAN                     Claimed;
 
   if (CpuMpData->MicrocodePatchRegionSize == 0) {
     //
@@ -45,6 +105,15 @@ MicrocodeDetect (
     return;
   }
 
+  if (CpuMpData->CpuData[ProcessorNumber].MicrocodeEntryAddr != 0) {
+    //
+    // The microcode patch was detected in the previous phase.
+    //
+    LatestMicrocode = (CPU_MICROCODE_HEADER *)(UINTN)CpuMpData->CpuData[ProcessorNumber].MicrocodeEntryAddr;
+    LatestRevision  = LatestMicrocode->UpdateRevision;
+    goto LoadMicrocode;
+  }
+
   GetProcessorMicrocodeCpuId (&MicrocodeCpuId);
 
   if (ProcessorNumber != (UINTN)CpuMpData->BspNumber) {
@@ -63,6 +132,20 @@ MicrocodeDetect (
     }
   }
 
+  //
+  // Only the first core with a given signature and platform ID searches the
+  // microcode patches, the other cores wait for its result.
+  //
+  Cache = NULL;
+  if (ProcessorNumber != (UINTN)CpuMpData->BspNumber) {
+    Cache = GetMicrocodeCacheEntry (CpuMpData, &MicrocodeCpuId, &Claimed);
+    if ((Cache != NULL) && !Claimed) {
+      LatestMicrocode = (CPU_MICROCODE_HEADER *)(UINTN)Cache->MicrocodeEntryAddr;
+      LatestRevision  = (LatestMicrocode == NULL) ? 0 : LatestMicrocode->UpdateRevision;
+      goto LoadMicrocode;
+    }
+  }
+
   //
   // BSP or AP which is different from BSP runs here
   // Use 0 as the starting revision to search for microcode because MicrocodePatchInfo HOB needs
@@ -92,6 +175,12 @@ MicrocodeDetect (
     Microcode = (CPU_MICROCODE_HEADER *)(((UINTN)Microcode) + GetMicrocodeLength (Microcode));
   } while ((UINTN)Microcode < MicrocodeEnd);
 
+  if (Cache != NULL) {
+    Cache->MicrocodeEntryAddr = (UINTN)LatestMicrocode;
+    MemoryFence ();
+    Cache->State = MICROCODE_CACHE_READY;
+  }
+
 LoadMicrocode:
   if (LatestRevision != 0) {
     //
@@ -384,3 +473,106 @@ GetMicrocodePatchInfoFromHob (
 
   return TRUE;
 }
+
+/**
+  Take the microcode patch detected for each processor in the previous phase
+  from the microcode patch information cache HOB, so that the processors do
+  not search the microcode patches again.
+
+  It must only be called if the processors have the same handle numbers as in
+  the previous phase.
+
+  @param[in, out]  CpuMpData    The pointer to CPU MP Data structure.
+**/
+VOID
+GetProcessorMicrocodeFromHob (
+  IN OUT CPU_MP_DATA  *CpuMpData
+  )
+{
+  EFI_HOB_GUID_TYPE          *GuidHob;
+  EDKII_MICROCODE_PATCH_HOB  *MicrocodePathHob;
+  UINTN                      Index;
+
+  GuidHob = GetFirstGuidHob (&gEdkiiMicrocodePatchHobGuid);
+  if (GuidHob == NULL) {
+    return;
+  }
+
+  MicrocodePathHob = GET_GUID_HOB_DATA (GuidHob);
+  if ((MicrocodePathHob->ProcessorCount != CpuMpData->CpuCount) ||
+      (MicrocodePathHob->MicrocodePatchAddress != CpuMpData->MicrocodePatchAddress))
+  {
+    return;
+  }
+
+  for (Index = 0; Index < CpuMpData->CpuCount; Index++) {
+    if (MicrocodePathHob->ProcessorSpecificPatchOffset[Index] < CpuMpData->MicrocodePatchRegionSize) {
+      CpuMpData->CpuData[Index].MicrocodeEntryAddr = CpuMpData->MicrocodePatchAddress +
+                                                     MicrocodePathHob->ProcessorSpecificPatchOffset[Index];
+    }
+  }
+}
+
+/**
+  Allocate the cache of the detected microcode patches, which the APs share
+  while they detect their microcode patches in parallel.
+
+  @param[in, out]  CpuMpData    The pointer to CPU MP Data structure.
+**/
+VOID
+AllocateMicrocodeCache (
+  IN OUT CPU_MP_DATA  *CpuMpData
+  )
+{
+  CPU_INFO_IN_HOB        *CpuInfoInHob;
+  MICROCODE_CACHE_ENTRY  *Cache;
+  UINT32                 PackageCount;
+  UINT32                 Package;
+  UINTN                  Index;
+
+  CpuMpData->MicrocodeCache      = 0;
+  CpuMpData->MicrocodeCacheCount = 0;
+
+  if (CpuMpData->MicrocodePatchRegionSize == 0) {
+    return;
+  }
+
+  //
+  // Packages rarely mix more than one signature and platform ID, so one entry
+  // per package is plenty. The APs that do not find room search on their own.
+  //
+  CpuInfoInHob = (CPU_INFO_IN_HOB *)(UINTN)CpuMpData->CpuInfoInHob;
+  PackageCount = 0;
+  for (Index = 0; Index < CpuMpData->CpuCount; Index++) {
+    GetProcessorLocationByApicId (CpuInfoInHob[Index].InitialApicId, &Package, NULL, NULL);
+    PackageCount = MAX (PackageCount, Package + 1);
+  }
+
+  Cache = AllocateZeroPool (PackageCount * sizeof (MICROCODE_CACHE_ENTRY));
+  if (Cache == NULL) {
+    //
+    // Each AP searches the microcode patches on its own.
+    //
+    return;
+  }
+
+  CpuMpData->MicrocodeCache      = (UINTN)Cache;
+  CpuMpData->MicrocodeCacheCount = PackageCount;
+}
+
+/**
+  Free the cache of the detected microcode patches.
+
+  @param[in, out]  CpuMpData    The pointer to CPU MP Data structure.
+**/
+VOID
+FreeMicrocodeCache (
+  IN OUT CPU_MP_DATA  *CpuMpData
+  )
+{
+  if (CpuMpData->MicrocodeCache != 0) {
+    FreePool ((VOID *)(UINTN)CpuMpData->MicrocodeCache);
+    CpuMpData->MicrocodeCache      = 0;
+    CpuMpData->MicrocodeCacheCount = 0;
+  }
+}
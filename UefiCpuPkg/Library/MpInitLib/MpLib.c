@@ -743,6 +743,7 @@ ApWakeupFunction (
   UINTN             CurrentApicMode;
   AP_STACK_DATA     *ApStackData;
   UINT32            OriginalValue;
+  UINT64            StartCounter;
 
   //
   // AP's local APIC settings will be lost after received INIT IPI
@@ -818,7 +819,9 @@ ApWakeupFunction (
           //
           // Invoke AP function here
           //
+          StartCounter = GetPerformanceCounter ();
           Procedure (Parameter);
+          TraceApProcedure (ProcessorNumber, Procedure, Parameter, StartCounter);
           CpuInfoInHob = (CPU_INFO_IN_HOB *)(UINTN)CpuMpData->CpuInfoInHob;
           if (CpuMpData->SwitchBspFlag) {
             //
@@ -2359,6 +2362,12 @@ MpInitLibInitialize (
     // the microcode patches data has not been loaded into memory yet
     //
     ShadowMicrocodeUpdatePatch (CpuMpData);
+  } else if (FirstMpHandOff != NULL) {
+    //
+    // The processors keep the handle numbers of the previous phase, which
+    // already detected their microcode patches.
+    //
+    GetProcessorMicrocodeFromHob (CpuMpData);
   }
 
   //
@@ -2374,6 +2383,7 @@ MpInitLibInitialize (
   // Wakeup APs to do some AP initialize sync (Microcode & MTRR)
   //
   if (CpuMpData->CpuCount > 1) {
+    AllocateMicrocodeCache (CpuMpData);
     WakeUpAP (CpuMpData, TRUE, 0, ApInitializeSync, CpuMpData, TRUE);
     //
     // Wait for all APs finished initialization
@@ -2382,6 +2392,8 @@ MpInitLibInitialize (
       CpuPause ();
     }
 
+    FreeMicrocodeCache (CpuMpData);
+
     for (Index = 0; Index < CpuMpData->CpuCount; Index++) {
       SetApState (&CpuMpData->CpuData[Index], CpuStateIdle);
     }
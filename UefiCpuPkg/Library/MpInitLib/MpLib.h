@@ -79,6 +79,27 @@ typedef struct {
   UINTN    Size;
 } MICROCODE_PATCH_INFO;
 
+//
+// State of a MICROCODE_CACHE_ENTRY
+//
+#define MICROCODE_CACHE_EMPTY      0
+#define MICROCODE_CACHE_CLAIMED    1
+#define MICROCODE_CACHE_SEARCHING  2
+#define MICROCODE_CACHE_READY      3
+
+//
+// Microcode patch found for a processor signature and platform ID by the
+// first core that searched the microcode patches for them. The other cores
+// with the same signature and platform ID use it instead of searching again.
+// ProcessorSignature and PlatformId are valid from the SEARCHING state on.
+//
+typedef struct {
+  volatile UINT32    State;
+  UINT32             ProcessorSignature;
+  UINT8              PlatformId;
+  UINT64             MicrocodeEntryAddr;
+} MICROCODE_CACHE_ENTRY;
+
 //
 // CPU volatile registers around INIT-SIPI-SIPI
 //
@@ -307,6 +328,12 @@ struct _CPU_MP_DATA {
   BOOLEAN                          TimerInterruptState;
   UINT64                           MicrocodePatchAddress;
   UINT64                           MicrocodePatchRegionSize;
+  //
+  // MICROCODE_CACHE_ENTRY array, only valid while the APs detect their
+  // microcode patches.
+  //
+  UINT64                           MicrocodeCache;
+  UINT32                           MicrocodeCacheCount;
 
   //
   // Whether need to use Init-Sipi-Sipi to wake up the APs.
@@ -795,6 +822,42 @@ GetMicrocodePatchInfoFromHob (
   UINT64  *RegionSize
   );
 
+/**
+  Take the microcode patch detected for each processor in the previous phase
+  from the microcode patch information cache HOB, so that the processors do
+  not search the microcode patches again.
+
+  It must only be called if the processors have the same handle numbers as in
+  the previous phase.
+
+  @param[in, out]  CpuMpData    The pointer to CPU MP Data structure.
+**/
+VOID
+GetProcessorMicrocodeFromHob (
+  IN OUT CPU_MP_DATA  *CpuMpData
+  );
+
+/**
+  Allocate the cache of the detected microcode patches, which the APs share
+  while they detect their microcode patches in parallel.
+
+  @param[in, out]  CpuMpData    The pointer to CPU MP Data structure.
+**/
+VOID
+AllocateMicrocodeCache (
+  IN OUT CPU_MP_DATA  *CpuMpData
+  );
+
+/**
+  Free the cache of the detected microcode patches.
+
+  @param[in, out]  CpuMpData    The pointer to CPU MP Data structure.
+**/
+VOID
+FreeMicrocodeCache (
+  IN OUT CPU_MP_DATA  *CpuMpData
+  );
+
 /**
   Detect whether Mwait-monitor feature is supported.
 
@@ -815,6 +878,22 @@ EnableDebugAgent (
   VOID
   );
 
+/**
+  Record an AP function that has returned, if the phase keeps a trace of them.
+
+  @param[in] ProcessorNumber  The handle number of the processor that ran Procedure.
+  @param[in] Procedure        The AP function.
+  @param[in] Parameter        The parameter passed to Procedure.
+  @param[in] StartCounter     The performance counter value at which Procedure was called.
+**/
+VOID
+TraceApProcedure (
+  IN UINTN             ProcessorNumber,
+  IN EFI_AP_PROCEDURE  Procedure,
+  IN VOID              *Parameter,
+  IN UINT64            StartCounter
+  );
+
 /**
   Find the current Processor number by APIC ID.
 
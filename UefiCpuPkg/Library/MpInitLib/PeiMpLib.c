@@ -87,6 +87,24 @@ EnableDebugAgent (
 {
 }
 
+/**
+  Record an AP function that has returned. The PEI phase keeps no trace.
+
+  @param[in] ProcessorNumber  The handle number of the processor that ran Procedure.
+  @param[in] Procedure        The AP function.
+  @param[in] Parameter        The parameter passed to Procedure.
+  @param[in] StartCounter     The performance counter value at which Procedure was called.
+**/
+VOID
+TraceApProcedure (
+  IN UINTN             ProcessorNumber,
+  IN EFI_AP_PROCEDURE  Procedure,
+  IN VOID              *Parameter,
+  IN UINT64            StartCounter
+  )
+{
+}
+
 /**
   Get pointer to CPU MP Data structure.
   For BSP, the pointer is retrieved from HOB.
@@ -27,6 +27,13 @@ EDKII_SMM_CPU_RENDEZVOUS_PROTOCOL  mSmmCpuRendezvousService = {
   SmmCpuRendezvous
 };
 
+//
+// EDKII SMM CPU AP Release Protocol instance
+//
+EDKII_SMM_CPU_AP_RELEASE_PROTOCOL  mSmmCpuApReleaseService = {
+  SmmReleaseApsEarly
+};
+
 /**
   Gets processor information on the requested processor at the instant this call is made.
 
@@ -394,6 +401,17 @@ InitializeSmmCpuServices (
                     &mSmmCpuRendezvousService
                     );
   ASSERT_EFI_ERROR (Status);
+  if (EFI_ERROR (Status) || !FeaturePcdGet (PcdCpuSmmApEarlyRelease)) {
+    return Status;
+  }
+
+  Status = gMmst->MmInstallProtocolInterface (
+                    &Handle,
+                    &gEdkiiSmmCpuApReleaseProtocolGuid,
+                    EFI_NATIVE_INTERFACE,
+                    &mSmmCpuApReleaseService
+                    );
+  ASSERT_EFI_ERROR (Status);
   return Status;
 }
 
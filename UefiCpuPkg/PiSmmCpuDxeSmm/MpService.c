@@ -29,14 +29,57 @@ MM_COMPLETION                mSmmStartupThisApToken;
 //
 UINT32  *mPackageFirstThreadIndex = NULL;
 
+//
+// With the hierarchical SMI rendezvous, the AP specified by mPackageLeader[PackageIndex] releases
+// the other mPackageMemberCount[PackageIndex] APs of the package and reports them to BSP.
+// The package leaders are elected by BSP every time it releases all APs.
+//
+BOOLEAN  mSmmHierarchicalRendezvous = FALSE;
+UINT32   mPackageCount              = 0;
+UINT32   *mPackageLeader            = NULL;
+UINT32   *mPackageMemberCount       = NULL;
+UINTN    mPackageLeaderCount        = 0;
+
+/**
+  Used for BSP to elect the package leaders of the hierarchical SMI rendezvous
+  among the present APs. The first present AP of each package is its leader.
+
+**/
+VOID
+ElectPackageLeaders (
+  VOID
+  )
+{
+  UINTN   Index;
+  UINT32  PackageIndex;
+
+  SetMem32 (mPackageLeader, sizeof (UINT32) * mPackageCount, MAX_UINT32);
+  ZeroMem (mPackageMemberCount, sizeof (UINT32) * mPackageCount);
+  mPackageLeaderCount = 0;
+
+  for (Index = 0; Index < mMaxNumberOfCpus; Index++) {
+    if (!IsPresentAp (Index)) {
+      continue;
+    }
+
+    PackageIndex = gSmmCpuPrivate->ProcessorInfo[Index].Location.Package;
+    if (mPackageLeader[PackageIndex] == MAX_UINT32) {
+      mPackageLeader[PackageIndex] = (UINT32)Index;
+      mPackageLeaderCount++;
+    } else {
+      mPackageMemberCount[PackageIndex]++;
+    }
+  }
+}
+
 /**
-  Used for BSP to release all APs.
+  Used for BSP to release each present AP directly.
   Performs an atomic compare exchange operation to release semaphore
   for each AP.
 
 **/
 VOID
-ReleaseAllAPs (
+ReleaseEachAp (
   VOID
   )
 {
@@ -49,6 +92,33 @@ ReleaseAllAPs (
   }
 }
 
+/**
+  Used for BSP to release all APs for a step of the SMI rendezvous.
+
+  With the hierarchical SMI rendezvous, only the package leaders are released
+  by BSP, and each of them releases the other APs of its package.
+
+**/
+VOID
+ReleaseAllAPs (
+  VOID
+  )
+{
+  UINTN  Index;
+
+  if (!mSmmHierarchicalRendezvous) {
+    ReleaseEachAp ();
+    return;
+  }
+
+  ElectPackageLeaders ();
+  for (Index = 0; Index < mPackageCount; Index++) {
+    if (mPackageLeader[Index] != MAX_UINT32) {
+      SmmCpuSyncReleaseOneAp (mSmmMpSyncData->SyncContext, mPackageLeader[Index], gSmmCpuPrivate->SmmCoreEntryContext.CurrentlyExecutingCpu);
+    }
+  }
+}
+
 /**
   Check whether the index of CPU perform the package level register
   programming during System Management Mode initialization.
@@ -87,6 +157,92 @@ IsPackageFirstThread (
   return (BOOLEAN)(mPackageFirstThreadIndex[PackageIndex] == CpuIndex);
 }
 
+/**
+  Used for AP released by ReleaseAllAPs() to release the other APs of its
+  package, if it is their package leader.
+
+  @param[in] CpuIndex   AP processor Index.
+
+**/
+VOID
+ReleasePackageAps (
+  IN UINTN  CpuIndex
+  )
+{
+  UINTN   Index;
+  UINT32  PackageIndex;
+
+  if (!mSmmHierarchicalRendezvous) {
+    return;
+  }
+
+  PackageIndex = gSmmCpuPrivate->ProcessorInfo[CpuIndex].Location.Package;
+  if (mPackageLeader[PackageIndex] != CpuIndex) {
+    return;
+  }
+
+  //
+  // The other APs of the package all come after their leader. They are still
+  // present, as they are not released yet.
+  //
+  for (Index = CpuIndex + 1; Index < mMaxNumberOfCpus; Index++) {
+    if (IsPresentAp (Index) && (gSmmCpuPrivate->ProcessorInfo[Index].Location.Package == PackageIndex)) {
+      SmmCpuSyncReleaseOneAp (mSmmMpSyncData->SyncContext, Index, CpuIndex);
+    }
+  }
+}
+
+/**
+  Used for AP to signal BSP once it is done with the step BSP released it for.
+
+  With the hierarchical SMI rendezvous, the other APs of the package signal
+  their package leader instead, and the leader signals BSP once for all of them.
+
+  @param[in] CpuIndex   AP processor Index.
+  @param[in] BspIndex   BSP processor Index.
+
+**/
+VOID
+ApReleaseBsp (
+  IN UINTN  CpuIndex,
+  IN UINTN  BspIndex
+  )
+{
+  UINT32  PackageIndex;
+
+  if (mSmmHierarchicalRendezvous) {
+    PackageIndex = gSmmCpuPrivate->ProcessorInfo[CpuIndex].Location.Package;
+    if (mPackageLeader[PackageIndex] != CpuIndex) {
+      SmmCpuSyncReleaseBsp (mSmmMpSyncData->SyncContext, CpuIndex, mPackageLeader[PackageIndex]);
+      return;
+    }
+
+    SmmCpuSyncWaitForAPs (mSmmMpSyncData->SyncContext, mPackageMemberCount[PackageIndex], CpuIndex);
+  }
+
+  SmmCpuSyncReleaseBsp (mSmmMpSyncData->SyncContext, CpuIndex, BspIndex);
+}
+
+/**
+  Used for BSP to wait for all APs it released with ReleaseAllAPs().
+
+  @param[in] ApCount    Number of APs in this SMI.
+  @param[in] BspIndex   BSP processor Index.
+
+**/
+VOID
+BspWaitForAPs (
+  IN UINTN  ApCount,
+  IN UINTN  BspIndex
+  )
+{
+  if (mSmmHierarchicalRendezvous) {
+    SmmCpuSyncWaitForAPs (mSmmMpSyncData->SyncContext, mPackageLeaderCount, BspIndex);
+  } else {
+    SmmCpuSyncWaitForAPs (mSmmMpSyncData->SyncContext, ApCount, BspIndex);
+  }
+}
+
 /**
   Returns the Number of SMM Delayed & Blocked & Disabled Thread Count.
 
@@ -505,6 +661,10 @@ BSPHandler (
   // If Traditional Sync Mode or need to configure MTRRs: gather all available APs.
   //
   if ((SyncMode == MmCpuSyncModeTradition) || SmmCpuFeaturesNeedConfigureMtrrs ()) {
+    PERF_CODE (
+      MpPerfBegin (CpuIndex, SMM_MP_PERF_PROCEDURE_ID (SmmRendezvousArrival));
+      );
+
     //
     // Wait for APs to arrive
     //
@@ -524,6 +684,10 @@ BSPHandler (
     //
     SmmCpuSyncWaitForAPs (mSmmMpSyncData->SyncContext, ApCount, CpuIndex);
 
+    PERF_CODE (
+      MpPerfEnd (CpuIndex, SMM_MP_PERF_PROCEDURE_ID (SmmRendezvousArrival));
+      );
+
     if (SmmCpuFeaturesNeedConfigureMtrrs ()) {
       //
       // Signal all APs it's time for backup MTRRs
@@ -543,7 +707,7 @@ BSPHandler (
       //
       // Wait for all APs to complete their MTRR saving
       //
-      SmmCpuSyncWaitForAPs (mSmmMpSyncData->SyncContext, ApCount, CpuIndex);
+      BspWaitForAPs (ApCount, CpuIndex);
 
       //
       // Let all processors program SMM MTRRs together
@@ -560,7 +724,7 @@ BSPHandler (
       //
       // Wait for all APs to complete their MTRR programming
       //
-      SmmCpuSyncWaitForAPs (mSmmMpSyncData->SyncContext, ApCount, CpuIndex);
+      BspWaitForAPs (ApCount, CpuIndex);
     }
   }
 
@@ -595,6 +759,8 @@ BSPHandler (
   // will run through freely.
   //
   if ((SyncMode != MmCpuSyncModeTradition) && !SmmCpuFeaturesNeedConfigureMtrrs ()) {
+    ASSERT (!mSmmMpSyncData->ApsReleasedEarly);
+
     //
     // Lock door for late coming CPU checkin and retrieve the Arrived number of APs
     //
@@ -622,16 +788,21 @@ BSPHandler (
   }
 
   //
-  // Notify all APs to exit
+  // Notify all APs to exit, unless SmmReleaseApsEarly() already let them leave SMM.
   //
-  *mSmmMpSyncData->InsideSmm = FALSE;
-  ReleaseAllAPs ();
+  if (!mSmmMpSyncData->ApsReleasedEarly) {
+    PERF_CODE (
+      MpPerfBegin (CpuIndex, SMM_MP_PERF_PROCEDURE_ID (SmmRendezvousRelease));
+      );
+    *mSmmMpSyncData->InsideSmm = FALSE;
+    ReleaseAllAPs ();
+  }
 
   if (SmmCpuFeaturesNeedConfigureMtrrs ()) {
     //
     // Wait for all APs the readiness to program MTRRs
     //
-    SmmCpuSyncWaitForAPs (mSmmMpSyncData->SyncContext, ApCount, CpuIndex);
+    BspWaitForAPs (ApCount, CpuIndex);
 
     //
     // Signal APs to restore MTRRs
@@ -649,7 +820,7 @@ BSPHandler (
     //
     // Wait for all APs to complete their pending tasks including MTRR programming if needed.
     //
-    SmmCpuSyncWaitForAPs (mSmmMpSyncData->SyncContext, ApCount, CpuIndex);
+    BspWaitForAPs (ApCount, CpuIndex);
 
     //
     // Signal APs to Reset states/semaphore for this processor
@@ -679,7 +850,12 @@ BSPHandler (
   // Gather APs to exit SMM synchronously. Note the Present flag is cleared by now but
   // WaitForAllAps does not depend on the Present flag.
   //
-  SmmCpuSyncWaitForAPs (mSmmMpSyncData->SyncContext, ApCount, CpuIndex);
+  if (!mSmmMpSyncData->ApsReleasedEarly) {
+    BspWaitForAPs (ApCount, CpuIndex);
+    PERF_CODE (
+      MpPerfEnd (CpuIndex, SMM_MP_PERF_PROCEDURE_ID (SmmRendezvousRelease));
+      );
+  }
 
   //
   // At this point, all APs should have exited from APHandler().
@@ -687,6 +863,7 @@ BSPHandler (
   // Any SMM MP performance logging after this point will be migrated in next SMI.
   //
   PERF_CODE (
+    MpPerfReportRendezvous (CpuIndex, ApCount + 1, mSmmHierarchicalRendezvous);
     MigrateMpPerf (gSmmCpuPrivate->SmmCoreEntryContext.NumberOfCpus, CpuIndex);
     );
 
@@ -708,10 +885,80 @@ BSPHandler (
   SmmCpuSyncContextReset (mSmmMpSyncData->SyncContext);
   *mSmmMpSyncData->AllCpusInSync            = FALSE;
   mSmmMpSyncData->AllApArrivedWithException = FALSE;
+  mSmmMpSyncData->ApsReleasedEarly          = FALSE;
 
   PERF_FUNCTION_END ();
 }
 
+/**
+  Let the APs leave SMM before BSP is done with the current SMI.
+
+  It is only supported in the Traditional sync mode, in which all APs have
+  checked in and the door is locked before the SMI handlers run, and only if
+  the APs have nothing left to do with BSP on the way out of SMM. The APs
+  finish their pending non-blocking procedures before they leave.
+
+  @param[in]  This                  A pointer to the EDKII_SMM_CPU_AP_RELEASE_PROTOCOL instance.
+
+  @retval EFI_SUCCESS               The APs left SMM.
+  @retval EFI_ALREADY_STARTED       The APs already left SMM in the current SMI.
+  @retval EFI_NOT_READY             It was not called in an SMI.
+  @retval EFI_UNSUPPORTED           The APs have to stay in SMM till BSP is done
+                                    with the current SMI.
+
+**/
+EFI_STATUS
+EFIAPI
+SmmReleaseApsEarly (
+  IN  EDKII_SMM_CPU_AP_RELEASE_PROTOCOL  *This
+  )
+{
+  UINTN  BspIndex;
+  UINTN  ApCount;
+
+  if (mSmmMpSyncData->ApsReleasedEarly) {
+    return EFI_ALREADY_STARTED;
+  }
+
+  if (!(*mSmmMpSyncData->InsideSmm)) {
+    return EFI_NOT_READY;
+  }
+
+  if ((mSmmMpSyncData->EffectiveSyncMode != MmCpuSyncModeTradition) ||
+      SmmCpuFeaturesNeedConfigureMtrrs () ||
+      mSmmDebugAgentSupport ||
+      IsRemainingTasksPending ())
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  BspIndex = gSmmCpuPrivate->SmmCoreEntryContext.CurrentlyExecutingCpu;
+  ApCount  = SmmCpuSyncGetArrivedCpuCount (mSmmMpSyncData->SyncContext) - 1;
+
+  WaitForAllAPsNotBusy (TRUE);
+
+  PERF_CODE (
+    MpPerfBegin (BspIndex, SMM_MP_PERF_PROCEDURE_ID (SmmRendezvousRelease));
+    );
+
+  //
+  // The APs no longer wait for AllCpusInSync once they see ApsReleasedEarly,
+  // and the MP services see them as not present once they left.
+  //
+  mSmmMpSyncData->ApsReleasedEarly          = TRUE;
+  mSmmMpSyncData->AllApArrivedWithException = FALSE;
+  *mSmmMpSyncData->InsideSmm                = FALSE;
+  ReleaseAllAPs ();
+
+  BspWaitForAPs (ApCount, BspIndex);
+
+  PERF_CODE (
+    MpPerfEnd (BspIndex, SMM_MP_PERF_PROCEDURE_ID (SmmRendezvousRelease));
+    );
+
+  return EFI_SUCCESS;
+}
+
 /**
   SMI handler for AP.
 
@@ -813,6 +1060,7 @@ APHandler (
     // Wait for the signal from BSP to backup MTRRs
     //
     SmmCpuSyncWaitForBsp (mSmmMpSyncData->SyncContext, CpuIndex, BspIndex);
+    ReleasePackageAps (CpuIndex);
 
     //
     // Backup OS MTRRs
@@ -822,12 +1070,13 @@ APHandler (
     //
     // Signal BSP the completion of this AP
     //
-    SmmCpuSyncReleaseBsp (mSmmMpSyncData->SyncContext, CpuIndex, BspIndex);
+    ApReleaseBsp (CpuIndex, BspIndex);
 
     //
     // Wait for BSP's signal to program MTRRs
     //
     SmmCpuSyncWaitForBsp (mSmmMpSyncData->SyncContext, CpuIndex, BspIndex);
+    ReleasePackageAps (CpuIndex);
 
     //
     // Replace OS MTRRs with SMI MTRRs
@@ -837,7 +1086,7 @@ APHandler (
     //
     // Signal BSP the completion of this AP
     //
-    SmmCpuSyncReleaseBsp (mSmmMpSyncData->SyncContext, CpuIndex, BspIndex);
+    ApReleaseBsp (CpuIndex, BspIndex);
   }
 
   while (TRUE) {
@@ -850,6 +1099,7 @@ APHandler (
     // Check if BSP wants to exit SMM
     //
     if (!(*mSmmMpSyncData->InsideSmm)) {
+      ReleasePackageAps (CpuIndex);
       break;
     }
 
@@ -884,12 +1134,13 @@ APHandler (
     //
     // Notify BSP the readiness of this AP to program MTRRs
     //
-    SmmCpuSyncReleaseBsp (mSmmMpSyncData->SyncContext, CpuIndex, BspIndex);
+    ApReleaseBsp (CpuIndex, BspIndex);
 
     //
     // Wait for the signal from BSP to program MTRRs
     //
     SmmCpuSyncWaitForBsp (mSmmMpSyncData->SyncContext, CpuIndex, BspIndex);
+    ReleasePackageAps (CpuIndex);
 
     //
     // Restore OS MTRRs
@@ -902,12 +1153,13 @@ APHandler (
     //
     // Notify BSP the readiness of this AP to Reset states/semaphore for this processor
     //
-    SmmCpuSyncReleaseBsp (mSmmMpSyncData->SyncContext, CpuIndex, BspIndex);
+    ApReleaseBsp (CpuIndex, BspIndex);
 
     //
     // Wait for the signal from BSP to Reset states/semaphore for this processor
     //
     SmmCpuSyncWaitForBsp (mSmmMpSyncData->SyncContext, CpuIndex, BspIndex);
+    ReleasePackageAps (CpuIndex);
   }
 
   //
@@ -918,7 +1170,7 @@ APHandler (
   //
   // Notify BSP the readiness of this AP to exit SMM
   //
-  SmmCpuSyncReleaseBsp (mSmmMpSyncData->SyncContext, CpuIndex, BspIndex);
+  ApReleaseBsp (CpuIndex, BspIndex);
 }
 
 /**
@@ -1320,7 +1572,11 @@ InternalSmmStartupAllAPs (
     }
   }
 
-  ReleaseAllAPs ();
+  //
+  // APs pick up their procedure on their own, so they are released directly
+  // rather than through their package leader.
+  //
+  ReleaseEachAp ();
 
   if (Token == NULL) {
     //
@@ -1691,9 +1947,11 @@ SmiRendezvous (
     }
 
     //
-    // Wait for BSP's signal to exit SMI
+    // Wait for BSP's signal to exit SMI, unless BSP let APs leave SMM early.
+    // An AP that comes back before BSP is done fails to check in, since the
+    // door is still locked.
     //
-    while (*mSmmMpSyncData->AllCpusInSync) {
+    while (*mSmmMpSyncData->AllCpusInSync && !mSmmMpSyncData->ApsReleasedEarly) {
       CpuPause ();
     }
   }
@@ -1759,6 +2017,22 @@ InitPackageFirstThreadIndexInfo (
   // Set default CpuIndex to (UINT32)-1, which means not specified yet.
   //
   SetMem32 (mPackageFirstThreadIndex, sizeof (UINT32) * PackageCount, (UINT32)-1);
+
+  //
+  // The hierarchical SMI rendezvous only pays off with more than one package. The
+  // package leaders are elected among the processors known now, so it cannot be
+  // used with CPU hot-plug.
+  //
+  if (FeaturePcdGet (PcdCpuSmmHierarchicalRendezvous) && !FeaturePcdGet (PcdCpuHotPlugSupport) && (PackageCount > 1)) {
+    mPackageLeader      = (UINT32 *)AllocatePool (sizeof (UINT32) * PackageCount);
+    mPackageMemberCount = (UINT32 *)AllocatePool (sizeof (UINT32) * PackageCount);
+    if ((mPackageLeader != NULL) && (mPackageMemberCount != NULL)) {
+      mPackageCount              = PackageCount;
+      mSmmHierarchicalRendezvous = TRUE;
+    }
+  }
+
+  DEBUG ((DEBUG_INFO, "SMI rendezvous: %d package(s), hierarchical - %d\n", PackageCount, mSmmHierarchicalRendezvous));
 }
 
 /**
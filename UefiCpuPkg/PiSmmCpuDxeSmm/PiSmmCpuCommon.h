@@ -21,6 +21,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Protocol/SmmMemoryAttribute.h>
 #include <Protocol/MmMp.h>
 #include <Protocol/SmmVariable.h>
+#include <Protocol/SmiHandlerAttribute.h>
 
 #include <Guid/AcpiS3Context.h>
 #include <Guid/MemoryAttributesTable.h>
@@ -412,6 +413,7 @@ typedef struct {
   volatile BOOLEAN             SwitchBsp;
   volatile BOOLEAN             *CandidateBsp;
   volatile BOOLEAN             AllApArrivedWithException;
+  volatile BOOLEAN             ApsReleasedEarly;
   EFI_AP_PROCEDURE             StartupProcedure;
   VOID                         *StartupProcArgs;
   SMM_CPU_SYNC_CONTEXT         *SyncContext;
@@ -849,6 +851,18 @@ PerformRemainingTasks (
   VOID
   );
 
+/**
+  Check whether PerformRemainingTasks() still has tasks to perform.
+
+  @retval TRUE   The remaining tasks are pending.
+  @retval FALSE  There is no remaining task.
+
+**/
+BOOLEAN
+IsRemainingTasksPending (
+  VOID
+  );
+
 /**
   Perform the pre tasks.
 
@@ -1558,6 +1572,24 @@ SmmCpuRendezvous (
   IN  BOOLEAN                            BlockingMode
   );
 
+/**
+  Let the APs leave SMM before BSP is done with the current SMI.
+
+  @param[in]  This                  A pointer to the EDKII_SMM_CPU_AP_RELEASE_PROTOCOL instance.
+
+  @retval EFI_SUCCESS               The APs left SMM.
+  @retval EFI_ALREADY_STARTED       The APs already left SMM in the current SMI.
+  @retval EFI_NOT_READY             It was not called in an SMI.
+  @retval EFI_UNSUPPORTED           The APs have to stay in SMM till BSP is done
+                                    with the current SMI.
+
+**/
+EFI_STATUS
+EFIAPI
+SmmReleaseApsEarly (
+  IN  EDKII_SMM_CPU_AP_RELEASE_PROTOCOL  *This
+  );
+
 /**
   Insure when this function returns, no AP will execute normal mode code before entering SMM, except SMI disabled APs.
 
@@ -38,6 +38,21 @@ IsSmmProfileEnabled (
   return FeaturePcdGet (PcdCpuSmmProfileEnable);
 }
 
+/**
+  Check whether PerformRemainingTasks() still has tasks to perform.
+
+  @retval TRUE   The remaining tasks are pending.
+  @retval FALSE  There is no remaining task.
+
+**/
+BOOLEAN
+IsRemainingTasksPending (
+  VOID
+  )
+{
+  return mSmmReadyToLock;
+}
+
 /**
   Perform the remaining tasks.
 
@@ -42,6 +42,21 @@ IsSmmProfileEnabled (
   return TRUE;
 }
 
+/**
+  Check whether PerformRemainingTasks() still has tasks to perform.
+
+  @retval TRUE   The remaining tasks are pending.
+  @retval FALSE  There is no remaining task.
+
+**/
+BOOLEAN
+IsRemainingTasksPending (
+  VOID
+  )
+{
+  return !mRemainingTasksDone;
+}
+
 /**
   Perform the remaining tasks.
 
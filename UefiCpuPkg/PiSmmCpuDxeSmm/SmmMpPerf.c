@@ -68,6 +68,55 @@ MigrateMpPerf (
   ZeroMem (mSmmMpProcedurePerformance, NumberofCpus * sizeof (*mSmmMpProcedurePerformance));
 }
 
+/**
+  Report the BSP's SMI rendezvous latency of the current SMI.
+
+  The arrival is only measured when BSP waits for all APs to arrive, the
+  release covers the last release of all APs till they all left APHandler().
+
+  @param BspIndex        The index of the BSP.
+  @param CpuCount        Number of processors in the SMI rendezvous.
+  @param Hierarchical    TRUE if the hierarchical SMI rendezvous is used.
+**/
+VOID
+MpPerfReportRendezvous (
+  IN UINTN    BspIndex,
+  IN UINTN    CpuCount,
+  IN BOOLEAN  Hierarchical
+  )
+{
+  SMM_PERF_AP_PROCEDURE_PERFORMANCE  *Performance;
+  UINT64                             Arrival;
+  UINT64                             Release;
+
+  Performance = &mSmmMpProcedurePerformance[BspIndex];
+  Arrival     = 0;
+  Release     = 0;
+
+  if (Performance->Begin[SMM_MP_PERF_PROCEDURE_ID (SmmRendezvousArrival)] != 0) {
+    Arrival = GetTimeInNanoSecond (
+                Performance->End[SMM_MP_PERF_PROCEDURE_ID (SmmRendezvousArrival)] -
+                Performance->Begin[SMM_MP_PERF_PROCEDURE_ID (SmmRendezvousArrival)]
+                );
+  }
+
+  if (Performance->Begin[SMM_MP_PERF_PROCEDURE_ID (SmmRendezvousRelease)] != 0) {
+    Release = GetTimeInNanoSecond (
+                Performance->End[SMM_MP_PERF_PROCEDURE_ID (SmmRendezvousRelease)] -
+                Performance->Begin[SMM_MP_PERF_PROCEDURE_ID (SmmRendezvousRelease)]
+                );
+  }
+
+  DEBUG ((
+    DEBUG_VERBOSE,
+    "SMI rendezvous (%a): %d CPUs, arrival %ld ns, release %ld ns\n",
+    Hierarchical ? "hierarchical" : "flat",
+    CpuCount,
+    Arrival,
+    Release
+    ));
+}
+
 /**
   Save the performance counter value before running the MP procedure.
 
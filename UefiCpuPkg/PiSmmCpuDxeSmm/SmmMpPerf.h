@@ -18,6 +18,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
   _(SmmRendezvousEntry), \
   _(PlatformValidSmi), \
   _(SmmRendezvousExit), \
+  _(SmmRendezvousArrival), \
+  _(SmmRendezvousRelease), \
   _(SmmMpProcedureMax) // Add new entries above this line
 
 //
@@ -56,6 +58,20 @@ MigrateMpPerf (
   UINTN  BspIndex
   );
 
+/**
+  Report the BSP's SMI rendezvous latency of the current SMI.
+
+  @param BspIndex        The index of the BSP.
+  @param CpuCount        Number of processors in the SMI rendezvous.
+  @param Hierarchical    TRUE if the hierarchical SMI rendezvous is used.
+**/
+VOID
+MpPerfReportRendezvous (
+  UINTN    BspIndex,
+  UINTN    CpuCount,
+  BOOLEAN  Hierarchical
+  );
+
 /**
   Save the performance counter value before running the MP procedure.
 
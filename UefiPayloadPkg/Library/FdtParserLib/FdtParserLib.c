@@ -61,8 +61,6 @@ typedef enum {
 
 extern VOID                         *mHobList;
 UNIVERSAL_PAYLOAD_PCI_ROOT_BRIDGES  *mPciRootBridgeInfo = NULL;
-INT32                               mNode[0x500]        = { 0 };
-UINT32                              mNodeIndex          = 0;
 UPL_PCI_SEGMENT_INFO_HOB            *mUplPciSegmentInfoHob;
 
 /**
@@ -89,57 +87,19 @@ HobConstructor (
   IN VOID  *EfiFreeMemoryTop
   );
 
-/**
-  It will record the memory node initialized.
-
-  @param[in]  Node           memory node is going to parsing..
-**/
-VOID
-RecordMemoryNode (
-  INT32  Node
-  )
-{
-  DEBUG ((DEBUG_INFO, "\n RecordMemoryNode  %x , mNodeIndex :%x  \n", Node, mNodeIndex));
-  mNode[mNodeIndex] = Node;
-  mNodeIndex++;
-}
-
-/**
-  Check the memory node if initialized.
-
-  @param[in]  Node           memory node is going to parsing..
-
-  @return TRUE               memory node was initialized. don't parse it again.
-  @return FALSE              memory node wasn't initialized , go to parse it.
-**/
-BOOLEAN
-CheckMemoryNodeIfInit (
-  INT32  Node
-  )
-{
-  UINT32  i;
-
-  for (i = 0; i < mNodeIndex; i++) {
-    if (mNode[i] == Node) {
-      return TRUE;
-    }
-  }
-
-  return FALSE;
-}
-
 /**
   It will check device node from FDT.
 
+  Only the nodes directly below the root node are passed in, so the "memory@"
+  sub nodes of the reserved-memory node are never taken for system memory.
+
   @param[in]  NodeString        Device node name string.
-  @param[in]  Depth             Check layer of Device node , only parse the 1st layer
 
   @return FDT_NODE_TYPE         what type of the device node.
 **/
 FDT_NODE_TYPE
 CheckNodeType (
-  CHAR8  *NodeString,
-  INT32  Depth
+  CHAR8  *NodeString
   )
 {
   DEBUG ((DEBUG_INFO, "\n CheckNodeType  %a   \n", NodeString));
@@ -256,8 +216,6 @@ ParseReservedMemory (
       DEBUG ((DEBUG_INFO, "  %016lX  %016lX", StartAddress, NumberOfBytes));
     }
 
-    RecordMemoryNode (SubNode);
-
     if (AsciiStrnCmp (NodePtr->Name, "mmio@", AsciiStrLen ("mmio@")) == 0) {
       DEBUG ((DEBUG_INFO, "  MemoryMappedIO"));
       BuildMemoryAllocationHob (StartAddress, NumberOfBytes, EfiMemoryMappedIO);
@@ -795,7 +753,6 @@ ParseDtb (
   VOID                  *Fdt;
   INT32                 Node;
   INT32                 Property;
-  INT32                 Depth;
   FDT_NODE_HEADER       *NodePtr;
   CONST FDT_PROPERTY    *PropertyPtr;
   CONST CHAR8           *TempStr;
@@ -826,7 +783,6 @@ ParseDtb (
   UINT8                 NumberOfRbSegNumAlreadyAssigned;
 
   Fdt               = FdtBase;
-  Depth             = 0;
   MinimalNeededSize = FixedPcdGet32 (PcdSystemMemoryUefiRegionSize);
   IsHobConstructed  = FALSE;
   NewHobList        = 0;
@@ -842,9 +798,14 @@ ParseDtb (
   DEBUG ((DEBUG_INFO, "Start parsing DTB data\n"));
   DEBUG ((DEBUG_INFO, "MinimalNeededSize :%x\n", MinimalNeededSize));
 
-  for (Node = FdtNextNode (Fdt, 0, &Depth); Node >= 0; Node = FdtNextNode (Fdt, Node, &Depth)) {
+  //
+  // All the nodes parsed below are children of the root node. Walk only those,
+  // instead of every node of the tree, so the sub nodes of reserved-memory,
+  // which can be many on systems with a large memory map, are skipped.
+  //
+  for (Node = FdtFirstSubnode (Fdt, 0); Node >= 0; Node = FdtNextSubnode (Fdt, Node)) {
     NodePtr = (FDT_NODE_HEADER *)((CONST CHAR8 *)Fdt + Node + Fdt32ToCpu (((FDT_HEADER *)Fdt)->OffsetDtStruct));
-    DEBUG ((DEBUG_INFO, "\n   Node(%08x)  %a   Depth %x", Node, NodePtr->Name, Depth));
+    DEBUG ((DEBUG_INFO, "\n   Node(%08x)  %a", Node, NodePtr->Name));
     // memory node
     if (AsciiStrnCmp (NodePtr->Name, "memory@", AsciiStrLen ("memory@")) == 0) {
       for (Property = FdtFirstPropertyOffset (Fdt, Node); Property >= 0; Property = FdtNextPropertyOffset (Fdt, Property)) {
@@ -900,12 +861,11 @@ ParseDtb (
   }
 
   index = RootBridgeCount - 1;
-  Depth = 0;
-  for (Node = FdtNextNode (Fdt, 0, &Depth); Node >= 0; Node = FdtNextNode (Fdt, Node, &Depth)) {
+  for (Node = FdtFirstSubnode (Fdt, 0); Node >= 0; Node = FdtNextSubnode (Fdt, Node)) {
     NodePtr = (FDT_NODE_HEADER *)((CONST CHAR8 *)Fdt + Node + Fdt32ToCpu (((FDT_HEADER *)Fdt)->OffsetDtStruct));
-    DEBUG ((DEBUG_INFO, "\n   Node(%08x)  %a   Depth %x", Node, NodePtr->Name, Depth));
+    DEBUG ((DEBUG_INFO, "\n   Node(%08x)  %a", Node, NodePtr->Name));
 
-    NodeType = CheckNodeType (NodePtr->Name, Depth);
+    NodeType = CheckNodeType (NodePtr->Name);
     DEBUG ((DEBUG_INFO, "NodeType :0x%x\n", NodeType));
     switch (NodeType) {
       case ReservedMemory:
@@ -914,12 +874,7 @@ ParseDtb (
         break;
       case Memory:
         DEBUG ((DEBUG_INFO, "ParseMemory\n"));
-        if (!CheckMemoryNodeIfInit (Node)) {
-          ParseMemory (Fdt, Node);
-        } else {
-          DEBUG ((DEBUG_INFO, "Memory has initialized\n"));
-        }
-
+        ParseMemory (Fdt, Node);
         break;
       case FrameBuffer:
         DEBUG ((DEBUG_INFO, "ParseFrameBuffer\n"));
@@ -343,6 +343,25 @@ CreatNewHobForHoblist (
   // Try to find Resource Descriptor HOB that contains Hob range EfiMemoryBottom..EfiMemoryTop
   //
   PhitResourceHob = FindResourceDescriptorByRange (Hob.Raw, Hob.HandoffInformationTable->EfiMemoryBottom, Hob.HandoffInformationTable->EfiMemoryTop);
+  if ((PhitResourceHob != NULL) &&
+      (Hob.HandoffInformationTable->EfiFreeMemoryTop - Hob.HandoffInformationTable->EfiFreeMemoryBottom >= MinimalNeededSize))
+  {
+    //
+    // Boot loader's Hob list is in an available Resource Descriptor and has enough free memory for the payload,
+    // so keep using it in place instead of copying every hob into a new list. Only the hobs that are not needed
+    // are marked unused.
+    //
+    DEBUG ((DEBUG_INFO, "Reuse boot loader hob list in place\n"));
+    for (Hob.Raw = GET_NEXT_HOB (Hob); !END_OF_HOB_LIST (Hob); Hob.Raw = GET_NEXT_HOB (Hob)) {
+      if (!IsHobNeed (Hob)) {
+        Hob.Header->HobType = EFI_HOB_TYPE_UNUSED;
+      }
+    }
+
+    mHobList = (VOID *)BootloaderParameter;
+    return;
+  }
+
   if (PhitResourceHob == NULL) {
     //
     // Boot loader's Phit Hob is not in an available Resource Descriptor, find another Resource Descriptor for new Phit Hob